@@ -134,7 +134,7 @@ void args_default(prog_args_t* args)
   args->rf_freq                            = -1.0;
   args->rf_nof_rx_ant                      = 1;
   args->enable_cfo_ref                     = false;
-  args->estimator_alg                      = "interpolate";
+  args->estimator_alg                      = "auto";
   args->enable_256qam                      = false;
 #ifdef ENABLE_AGC_DEFAULT
   args->rf_gain = -1.0;
@@ -177,7 +177,7 @@ void usage(prog_args_t* args, char* prog)
   printf("\t-l Force N_id_2 [Default best]\n");
   printf("\t-C Disable CFO correction [Default %s]\n", args->disable_cfo ? "Disabled" : "Enabled");
   printf("\t-F Enable RS-based CFO correction [Default %s]\n", !args->enable_cfo_ref ? "Disabled" : "Enabled");
-  printf("\t-R Channel estimates algorithm (average, interpolate, wiener) [Default %s]\n", args->estimator_alg);
+  printf("\t-R Channel estimates algorithm (average, interpolate, wiener, auto) [Default %s]\n", args->estimator_alg);
   printf("\t-t Add time offset [Default %d]\n", args->time_offset);
   printf("\t-T Set TDD special subframe configuration [Default %d]\n", args->tdd_special_sf);
   printf("\t-G Set TDD uplink/downlink configuration [Default %d]\n", args->sf_config);
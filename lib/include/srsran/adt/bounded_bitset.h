@@ -244,6 +244,50 @@ public:
     return find_first_reversed_(startpos, endpos, value);
   }
 
+  /// Finds the first run of at least "len" consecutive bits equal to "value" within [startpos, endpos). The runs are
+  /// skipped a word at a time, so the cost depends on the number of runs rather than on the number of bits.
+  /// \return start position of the run, or -1 if there is no such run
+  int find_first_fit(size_t len, size_t startpos, size_t endpos, bool value = true) const noexcept
+  {
+    assert_range_bounds_(startpos, endpos);
+    while (startpos + len <= endpos) {
+      int pos = find_lowest(startpos, endpos, value);
+      if (pos < 0 or pos + len > endpos) {
+        return -1;
+      }
+      int brk = find_lowest(pos, pos + len, not value);
+      if (brk < 0) {
+        return pos;
+      }
+      startpos = brk + 1;
+    }
+    return -1;
+  }
+
+  /// Finds the shortest run of at least "len" consecutive bits equal to "value" within [startpos, endpos). If there
+  /// is none, the longest run is picked instead. Ties are resolved in favour of the lowest position.
+  /// \return start position of the run, or -1 if no bit in the range is equal to "value"
+  int find_best_fit(size_t len, size_t startpos, size_t endpos, bool value = true) const noexcept
+  {
+    assert_range_bounds_(startpos, endpos);
+    int    best_pos = -1;
+    size_t best_len = 0;
+    for (int pos = find_lowest(startpos, endpos, value); pos >= 0;) {
+      int    stop    = find_lowest(pos, endpos, not value);
+      size_t run_len = (stop < 0 ? endpos : stop) - pos;
+      bool   fits    = run_len >= len;
+      if (best_pos < 0 or (fits and (best_len < len or run_len < best_len)) or (not fits and run_len > best_len)) {
+        best_pos = pos;
+        best_len = run_len;
+      }
+      if (best_len == len or stop < 0) {
+        break;
+      }
+      pos = find_lowest(stop, endpos, value);
+    }
+    return best_pos;
+  }
+
   bool all() const noexcept
   {
     const size_t nw = nof_words_();
@@ -299,6 +343,35 @@ public:
     return result;
   }
 
+  /// Counts the bits set within [startpos, endpos), with one popcount per word
+  size_t count(size_t startpos, size_t endpos) const noexcept
+  {
+    assert_range_bounds_(startpos, endpos);
+    if (startpos == endpos) {
+      return 0;
+    }
+    if (reversed) {
+      size_t first = get_bitidx_(endpos - 1);
+      endpos       = get_bitidx_(startpos) + 1;
+      startpos     = first;
+    }
+
+    size_t startword = startpos / bits_per_word;
+    size_t lastword  = (endpos - 1) / bits_per_word;
+    size_t result    = 0;
+    for (size_t i = startword; i <= lastword; ++i) {
+      word_t w = buffer[i];
+      if (i == startword) {
+        w &= mask_lsb_zeros<word_t>(startpos % bits_per_word);
+      }
+      if (i == lastword) {
+        w &= mask_lsb_ones<word_t>((endpos - 1) % bits_per_word + 1);
+      }
+      result += __builtin_popcountll(w);
+    }
+    return result;
+  }
+
   bool operator==(const bounded_bitset<N, reversed>& other) const noexcept
   {
     if (size() != other.size()) {
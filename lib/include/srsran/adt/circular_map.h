@@ -26,6 +26,7 @@
 #include "expected.h"
 #include "srsran/support/srsran_assert.h"
 #include <array>
+#include <vector>
 
 namespace srsran {
 
@@ -125,8 +126,13 @@ public:
     size_t                              idx = 0;
   };
 
-  static_circular_map() { std::fill(present.begin(), present.end(), false); }
-  static_circular_map(const static_circular_map<K, T, N>& other) : present(other.present), count(other.count)
+  static_circular_map()
+  {
+    std::fill(present.begin(), present.end(), false);
+    std::fill(generations.begin(), generations.end(), 0);
+  }
+  static_circular_map(const static_circular_map<K, T, N>& other) :
+    present(other.present), generations(other.generations), count(other.count)
   {
     for (size_t idx = 0; idx < other.capacity(); ++idx) {
       if (present[idx]) {
@@ -134,7 +140,8 @@ public:
       }
     }
   }
-  static_circular_map(static_circular_map<K, T, N>&& other) noexcept : present(other.present), count(other.count)
+  static_circular_map(static_circular_map<K, T, N>&& other) noexcept :
+    present(other.present), generations(other.generations), count(other.count)
   {
     for (size_t idx = 0; idx < other.capacity(); ++idx) {
       if (present[idx]) {
@@ -152,16 +159,18 @@ public:
     for (size_t idx = 0; idx < other.capacity(); ++idx) {
       copy_if_present_helper(buffer[idx], other.buffer[idx], present[idx], other.present[idx]);
     }
-    count   = other.count;
-    present = other.present;
+    count       = other.count;
+    present     = other.present;
+    generations = other.generations;
   }
   static_circular_map& operator=(static_circular_map<K, T, N>&& other) noexcept
   {
     for (size_t idx = 0; idx < other.capacity(); ++idx) {
       move_if_present_helper(buffer[idx], other.buffer[idx], present[idx], other.present[idx]);
     }
-    count   = other.count;
-    present = other.present;
+    count       = other.count;
+    present     = other.present;
+    generations = other.generations;
     other.clear();
     return *this;
   }
@@ -180,6 +189,7 @@ public:
     }
     buffer[idx].template emplace(id, obj);
     present[idx] = true;
+    generations[idx]++;
     count++;
     return true;
   }
@@ -191,6 +201,7 @@ public:
     }
     buffer[idx].template emplace(id, std::move(obj));
     present[idx] = true;
+    generations[idx]++;
     count++;
     return iterator(this, idx);
   }
@@ -256,6 +267,10 @@ public:
   bool   has_space(K id) { return not present[id % N]; }
   size_t capacity() const { return N; }
 
+  /// Number of insertions in the slot of the given ID. A task that saves it along with the ID can detect whether the
+  /// object was removed and the slot reused, even for the same ID, before the task runs
+  uint32_t generation(K id) const { return generations[id % N]; }
+
   iterator       begin() { return iterator(this, 0); }
   iterator       end() { return iterator(this, N); }
   const_iterator begin() const { return const_iterator(this, 0); }
@@ -282,9 +297,126 @@ private:
 
   std::array<detail::type_storage<obj_t>, N> buffer;
   std::array<bool, N>                        present;
+  std::array<uint32_t, N>                    generations;
   size_t                                     count = 0;
 };
 
+/**
+ * Circular map whose capacity is set at runtime. The objects are kept in place in preallocated slots, so the insertion,
+ * lookup and removal are O(1) and do not allocate. The keys inserted at the same time must fall within a window of
+ * capacity() consecutive values, otherwise they compete for the same slot
+ * @tparam K type of ID/key
+ * @tparam T object being inserted, which must be default constructible. Erased objects are reset to T{}
+ */
+template <typename K, typename T>
+class dyn_circular_map
+{
+  static_assert(std::is_integral<K>::value and std::is_unsigned<K>::value, "Map key must be an unsigned integer");
+
+public:
+  explicit dyn_circular_map(size_t capacity = 0) { set_size(capacity); }
+
+  /// Resizes the map, which loses its objects
+  void set_size(size_t capacity)
+  {
+    clear();
+    keys.assign(capacity, 0);
+    objs.clear();
+    objs.resize(capacity);
+    present.assign(capacity, false);
+  }
+
+  bool contains(K id) const { return capacity() > 0 and present[id % capacity()] and keys[id % capacity()] == id; }
+  bool has_space(K id) const { return not present[id % capacity()]; }
+
+  bool insert(K id, T&& obj)
+  {
+    size_t idx = id % capacity();
+    if (present[idx]) {
+      return false;
+    }
+    keys[idx]    = id;
+    objs[idx]    = std::move(obj);
+    present[idx] = true;
+    count++;
+    return true;
+  }
+
+  bool erase(K id)
+  {
+    if (not contains(id)) {
+      return false;
+    }
+    size_t idx   = id % capacity();
+    objs[idx]    = T{};
+    present[idx] = false;
+    count--;
+    return true;
+  }
+
+  /// Moves the object out of the map. The ID must be present
+  T pop(K id)
+  {
+    srsran_assert(contains(id), "Accessing non-existent ID=%zd", (size_t)id);
+    T obj = std::move(objs[id % capacity()]);
+    erase(id);
+    return obj;
+  }
+
+  void clear()
+  {
+    for (size_t idx = 0; idx < capacity() and count > 0; ++idx) {
+      if (present[idx]) {
+        objs[idx]    = T{};
+        present[idx] = false;
+        count--;
+      }
+    }
+  }
+
+  T& operator[](K id)
+  {
+    srsran_assert(contains(id), "Accessing non-existent ID=%zd", (size_t)id);
+    return objs[id % capacity()];
+  }
+  const T& operator[](K id) const
+  {
+    srsran_assert(contains(id), "Accessing non-existent ID=%zd", (size_t)id);
+    return objs[id % capacity()];
+  }
+
+  size_t size() const { return count; }
+  bool   empty() const { return count == 0; }
+  bool   full() const { return count == capacity(); }
+  size_t capacity() const { return present.size(); }
+
+  /// Calls func(id, obj) for the present objects, in the order of their slots
+  template <typename F>
+  void for_each(F&& func)
+  {
+    for (size_t idx = 0; idx < capacity(); ++idx) {
+      if (present[idx]) {
+        func(keys[idx], objs[idx]);
+      }
+    }
+  }
+  template <typename F>
+  void for_each(F&& func) const
+  {
+    for (size_t idx = 0; idx < capacity(); ++idx) {
+      if (present[idx]) {
+        func(keys[idx], objs[idx]);
+      }
+    }
+  }
+
+private:
+  std::vector<K>    keys;
+  std::vector<T>    objs;
+  std::vector<bool> present;
+  size_t            count = 0;
+};
+
 /**
  * Operates like a circular map, but automatically assigns the ID/key to inserted objects in a monotonically
  * increasing way. The assigned IDs are not necessarily contiguous, as they are selected based on the available slots
@@ -24,6 +24,8 @@
 
 #include "memblock_cache.h"
 #include "srsran/adt/circular_buffer.h"
+#include <atomic>
+#include <cinttypes>
 #include <thread>
 
 namespace srsran {
@@ -39,6 +41,8 @@ namespace srsran {
  * Note: Taking into account the usage of thread_local, this class is made a singleton
  * Note2: No considerations were made regarding false sharing between threads. It is assumed that the blocks are big
  *        enough to fill a cache line.
+ * Note3: The blocks are allocated in a single segment that is not written at construction beyond the free list links,
+ *        so most of each block is first touched, and placed in the NUMA node of, the thread that first uses it.
  * @tparam NofObjects number of objects in the pool
  * @tparam ObjSize object size
  */
@@ -59,14 +63,14 @@ class concurrent_fixed_memory_pool
   {
     srsran_assert(nof_objects_ > batch_steal_size, "A positive pool size must be provided");
 
-    std::lock_guard<std::mutex> lock(mutex);
-    allocated_blocks.resize(nof_objects_);
-    for (std::unique_ptr<obj_storage_t>& b : allocated_blocks) {
-      b.reset(new obj_storage_t());
-      srsran_assert(b.get() != nullptr, "Failed to instantiate fixed memory pool");
-      central_mem_cache.push(static_cast<void*>(b.get()));
+    // Default initialization, the blocks are not zeroed
+    segment.reset(new obj_storage_t[nof_objects_]);
+    srsran_assert(segment != nullptr, "Failed to instantiate fixed memory pool");
+    nof_blocks = nof_objects_;
+    for (size_t i = 0; i != nof_blocks; ++i) {
+      central_mem_cache.push(static_cast<void*>(&segment[i]));
     }
-    local_growth_thres = allocated_blocks.size() / 16;
+    local_growth_thres = nof_blocks / 16;
     local_growth_thres = local_growth_thres < batch_steal_size ? batch_steal_size : local_growth_thres;
   }
 
@@ -78,11 +82,7 @@ public:
   concurrent_fixed_memory_pool& operator=(const concurrent_fixed_memory_pool&) = delete;
   concurrent_fixed_memory_pool& operator=(concurrent_fixed_memory_pool&&) = delete;
 
-  ~concurrent_fixed_memory_pool()
-  {
-    std::lock_guard<std::mutex> lock(mutex);
-    allocated_blocks.clear();
-  }
+  ~concurrent_fixed_memory_pool() = default;
 
   static concurrent_fixed_memory_pool<ObjSize, DebugSanitizeAddress>* get_instance(size_t size = 4096)
   {
@@ -90,7 +90,21 @@ public:
     return &pool;
   }
 
-  size_t size() { return allocated_blocks.size(); }
+  size_t size() { return nof_blocks; }
+
+  /// Counters of the accesses to the central cache, which is the only point of contention between threads.
+  struct pool_stats {
+    uint64_t nof_central_pops;   ///< Batches taken from the central cache by depleted thread caches.
+    uint64_t nof_central_pushes; ///< Batches returned to the central cache by full thread caches.
+    uint64_t nof_alloc_failures; ///< Allocations that found no block left.
+  };
+
+  pool_stats get_stats() const
+  {
+    return {stats.nof_central_pops.load(std::memory_order_relaxed),
+            stats.nof_central_pushes.load(std::memory_order_relaxed),
+            stats.nof_alloc_failures.load(std::memory_order_relaxed)};
+  }
 
   void* allocate_node(size_t sz)
   {
@@ -99,16 +113,21 @@ public:
 
     void* node = worker_ctxt->cache.try_pop();
     if (node == nullptr) {
-      // fill the thread local cache enough for this and next allocations
+      // fill the thread local cache enough for this and next allocations. The blocks are not zeroed, as blocks
+      // reused from the local cache are not either
       std::array<void*, batch_steal_size> popped_blocks;
       size_t                              n = central_mem_cache.try_pop(popped_blocks);
       for (size_t i = 0; i < n; ++i) {
-        new (popped_blocks[i]) obj_storage_t();
-        worker_ctxt->cache.push(static_cast<void*>(popped_blocks[i]));
+        worker_ctxt->cache.push(popped_blocks[i]);
       }
+      stats.nof_central_pops.fetch_add(1, std::memory_order_relaxed);
       node = worker_ctxt->cache.try_pop();
     }
 
+    if (node == nullptr) {
+      stats.nof_alloc_failures.fetch_add(1, std::memory_order_relaxed);
+    }
+
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
     if (node == nullptr) {
       print_error("Error allocating buffer in pool of ObjSize=%zd", ObjSize);
@@ -124,10 +143,10 @@ public:
     obj_storage_t* block_ptr   = static_cast<obj_storage_t*>(p);
 
     if (DebugSanitizeAddress) {
-      std::lock_guard<std::mutex> lock(mutex);
-      srsran_assert(std::any_of(allocated_blocks.begin(),
-                                allocated_blocks.end(),
-                                [block_ptr](const std::unique_ptr<obj_storage_t>& b) { return b.get() == block_ptr; }),
+      srsran_assert(block_ptr >= &segment[0] and block_ptr < &segment[nof_blocks] and
+                        (reinterpret_cast<uintptr_t>(block_ptr) - reinterpret_cast<uintptr_t>(&segment[0])) %
+                                sizeof(obj_storage_t) ==
+                            0,
                     "Error deallocating block with address 0x%lx",
                     (long unsigned)block_ptr);
     }
@@ -138,6 +157,7 @@ public:
     if (worker_ctxt->cache.size() >= local_growth_thres) {
       // if local cache reached max capacity, send half of the blocks to central cache
       central_mem_cache.steal_blocks(worker_ctxt->cache, worker_ctxt->cache.size() / 2);
+      stats.nof_central_pushes.fetch_add(1, std::memory_order_relaxed);
     }
   }
 
@@ -153,16 +173,17 @@ public:
 
   void print_all_buffers()
   {
-    auto*  worker     = get_worker_cache();
-    size_t tot_blocks = 0;
-    {
-      std::lock_guard<std::mutex> lock(mutex);
-      tot_blocks = allocated_blocks.size();
-    }
+    auto*      worker = get_worker_cache();
+    pool_stats s      = get_stats();
     printf("There are %zd/%zd buffers in shared block container. This thread contains %zd in its local cache\n",
            central_mem_cache.size(),
-           tot_blocks,
+           nof_blocks,
            worker->cache.size());
+    printf("The shared block container was accessed %" PRIu64 " times to refill and %" PRIu64
+           " times to drain the thread caches, %" PRIu64 " allocations failed\n",
+           s.nof_central_pops,
+           s.nof_central_pushes,
+           s.nof_alloc_failures);
   }
 
 private:
@@ -198,9 +219,16 @@ private:
   size_t                local_growth_thres = 0;
   srslog::basic_logger* logger             = nullptr;
 
-  concurrent_free_memblock_list                central_mem_cache;
-  std::mutex                                   mutex;
-  std::vector<std::unique_ptr<obj_storage_t> > allocated_blocks;
+  struct atomic_pool_stats {
+    std::atomic<uint64_t> nof_central_pops{0};
+    std::atomic<uint64_t> nof_central_pushes{0};
+    std::atomic<uint64_t> nof_alloc_failures{0};
+  };
+
+  concurrent_free_memblock_list    central_mem_cache;
+  std::unique_ptr<obj_storage_t[]> segment;
+  size_t                           nof_blocks = 0;
+  atomic_pool_stats                stats;
 };
 
 } // namespace srsran
@@ -0,0 +1,115 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SPSC_QUEUE_H
+#define SRSRAN_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Bounded lock-free queue for a single producer and a single consumer thread. Only try_push() may be called from the
+ * producer, while try_pop(), front() and apply_first() may only be called from the consumer. The resize must happen
+ * while neither side uses the queue
+ * @tparam T type of the elements, which must be default constructible and movable
+ */
+template <typename T>
+class spsc_queue
+{
+public:
+  explicit spsc_queue(size_t capacity = 128) { set_size(capacity); }
+  spsc_queue(const spsc_queue&) = delete;
+  spsc_queue& operator=(const spsc_queue&) = delete;
+
+  void set_size(size_t capacity)
+  {
+    // One slot is kept free to tell a full queue from an empty one
+    slots.clear();
+    slots.resize(capacity + 1);
+    head.store(0, std::memory_order_relaxed);
+    tail.store(0, std::memory_order_relaxed);
+  }
+
+  /// Moves the element into the queue. When the queue is full, the element is left untouched and false is returned
+  bool try_push(T&& t)
+  {
+    size_t tail_idx = tail.load(std::memory_order_relaxed);
+    size_t next_idx = next(tail_idx);
+    if (next_idx == head.load(std::memory_order_acquire)) {
+      return false;
+    }
+    slots[tail_idx] = std::move(t);
+    tail.store(next_idx, std::memory_order_release);
+    return true;
+  }
+
+  bool try_pop(T& t)
+  {
+    size_t head_idx = head.load(std::memory_order_relaxed);
+    if (head_idx == tail.load(std::memory_order_acquire)) {
+      return false;
+    }
+    t = std::move(slots[head_idx]);
+    head.store(next(head_idx), std::memory_order_release);
+    return true;
+  }
+
+  /// Element at the front of the queue. The queue must not be empty
+  T& front() { return slots[head.load(std::memory_order_relaxed)]; }
+
+  /// Calls func over the queued elements, in order, until it returns true. The elements may be modified in place
+  template <typename F>
+  bool apply_first(const F& func)
+  {
+    size_t tail_idx = tail.load(std::memory_order_acquire);
+    for (size_t idx = head.load(std::memory_order_relaxed); idx != tail_idx; idx = next(idx)) {
+      if (func(slots[idx])) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Number of elements. From the threads other than the consumer and the producer, it is only an estimate
+  size_t size() const
+  {
+    size_t head_idx = head.load(std::memory_order_acquire);
+    size_t tail_idx = tail.load(std::memory_order_acquire);
+    return tail_idx >= head_idx ? tail_idx - head_idx : tail_idx + slots.size() - head_idx;
+  }
+  bool   empty() const { return size() == 0; }
+  bool   full() const { return size() == max_size(); }
+  size_t max_size() const { return slots.size() - 1; }
+
+private:
+  size_t next(size_t idx) const { return idx + 1 == slots.size() ? 0 : idx + 1; }
+
+  std::vector<T>      slots;
+  std::atomic<size_t> head{0}; ///< Written by the consumer
+  std::atomic<size_t> tail{0}; ///< Written by the producer
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_SPSC_QUEUE_H
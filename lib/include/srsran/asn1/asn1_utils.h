@@ -29,6 +29,8 @@
 #include <cmath>
 #include <cstdint>
 #include <limits>
+#include <memory>
+#include <new>
 #include <string>
 
 namespace asn1 {
@@ -187,6 +189,82 @@ public:
 /*********************
   function helpers
 *********************/
+/************************
+      decode arena
+************************/
+
+/**
+ * Bump allocator for the storage of the dyn_arrays of decoded messages. While a decode_arena_scope is alive, the
+ * dyn_arrays allocated by the calling thread take their storage from the arena, so that unpacking a whole PDU takes
+ * no heap allocation. The storage is only reclaimed by reset(), once all the arrays allocated from the arena are gone.
+ * When the arena runs out of space, the dyn_arrays fall back to the heap.
+ */
+class decode_arena
+{
+public:
+  explicit decode_arena(size_t capacity = ASN_64K) : buffer(new uint8_t[capacity]), cap(capacity) {}
+  decode_arena(const decode_arena&) = delete;
+  decode_arena& operator=(const decode_arena&) = delete;
+
+  void* allocate(size_t nof_bytes, size_t alignment)
+  {
+    size_t offset = (used + alignment - 1) & ~(alignment - 1);
+    if (offset + nof_bytes > cap) {
+      return nullptr;
+    }
+    used = offset + nof_bytes;
+    nof_live++;
+    return buffer.get() + offset;
+  }
+  void deallocate() { nof_live--; }
+
+  /// Rewinds the arena. Returns false, leaving the arena untouched, while arrays allocated from it are still alive
+  bool reset()
+  {
+    if (nof_live > 0) {
+      return false;
+    }
+    used = 0;
+    return true;
+  }
+
+  size_t size() const { return used; }
+  size_t capacity() const { return cap; }
+  size_t nof_live_arrays() const { return nof_live; }
+
+  /// Arena installed in the calling thread, or null when the dyn_arrays are allocated in the heap
+  static decode_arena* current() { return current_ref(); }
+
+private:
+  friend class decode_arena_scope;
+  static decode_arena*& current_ref()
+  {
+    static thread_local decode_arena* arena = nullptr;
+    return arena;
+  }
+
+  std::unique_ptr<uint8_t[]> buffer;
+  size_t                     cap;
+  size_t                     used     = 0;
+  size_t                     nof_live = 0;
+};
+
+/// Installs an arena for the dyn_arrays allocated by the calling thread, until the end of the scope
+class decode_arena_scope
+{
+public:
+  explicit decode_arena_scope(decode_arena& arena) : prev(decode_arena::current_ref())
+  {
+    decode_arena::current_ref() = &arena;
+  }
+  decode_arena_scope(const decode_arena_scope&) = delete;
+  decode_arena_scope& operator=(const decode_arena_scope&) = delete;
+  ~decode_arena_scope() { decode_arena::current_ref() = prev; }
+
+private:
+  decode_arena* prev;
+};
+
 template <class T>
 class dyn_array
 {
@@ -196,14 +274,14 @@ public:
   using const_iterator = const T*;
 
   dyn_array() = default;
-  explicit dyn_array(uint32_t new_size) : size_(new_size), cap_(new_size) { data_ = new T[size_]; }
+  explicit dyn_array(uint32_t new_size) : size_(new_size), cap_(new_size) { data_ = allocate(cap_); }
   dyn_array(const dyn_array<T>& other) : dyn_array(&other[0], other.size_) {}
   dyn_array(const T* ptr, uint32_t nof_items)
   {
     size_ = nof_items;
     cap_  = nof_items;
     if (ptr != NULL) {
-      data_ = new T[cap_];
+      data_ = allocate(cap_);
       std::copy(ptr, ptr + size_, data_);
     } else {
       data_ = NULL;
@@ -212,7 +290,7 @@ public:
   ~dyn_array()
   {
     if (data_ != NULL) {
-      delete[] data_;
+      release(data_, cap_, arena_);
     }
   }
   uint32_t      size() const { return size_; }
@@ -238,10 +316,12 @@ public:
       return;
     }
 
-    T* old_data = data_;
-    cap_        = new_size > new_cap ? new_size : new_cap;
+    T*            old_data  = data_;
+    uint32_t      old_cap   = cap_;
+    decode_arena* old_arena = arena_;
+    cap_                    = new_size > new_cap ? new_size : new_cap;
     if (cap_ > 0) {
-      data_ = new T[cap_];
+      data_ = allocate(cap_);
       if (old_data != NULL) {
         srsran_assert(cap_ > size_, "Old size larger than new capacity in dyn_array\n");
         std::copy(&old_data[0], &old_data[size_], data_);
@@ -251,7 +331,7 @@ public:
     }
     size_ = new_size;
     if (old_data != NULL) {
-      delete[] old_data;
+      release(old_data, old_cap, old_arena);
     }
   }
   iterator erase(iterator it)
@@ -286,9 +366,39 @@ public:
   const_iterator end() const { return &data_[size()]; }
 
 private:
-  T*       data_ = nullptr;
-  uint32_t size_ = 0;
-  uint32_t cap_  = 0;
+  /// Allocates the storage from the arena of the calling thread, if any, and from the heap otherwise
+  T* allocate(uint32_t nof_items)
+  {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported by decode_arena");
+    decode_arena* arena = decode_arena::current();
+    void*         mem   = arena != nullptr ? arena->allocate(nof_items * sizeof(T), alignof(T)) : nullptr;
+    if (mem == nullptr) {
+      arena_ = nullptr;
+      return new T[nof_items];
+    }
+    arena_ = arena;
+    T* ptr = static_cast<T*>(mem);
+    for (uint32_t i = 0; i < nof_items; ++i) {
+      new (&ptr[i]) T();
+    }
+    return ptr;
+  }
+  static void release(T* ptr, uint32_t nof_items, decode_arena* arena)
+  {
+    if (arena == nullptr) {
+      delete[] ptr;
+      return;
+    }
+    for (uint32_t i = 0; i < nof_items; ++i) {
+      ptr[i].~T();
+    }
+    arena->deallocate();
+  }
+
+  T*            data_  = nullptr;
+  uint32_t      size_  = 0;
+  uint32_t      cap_   = 0;
+  decode_arena* arena_ = nullptr;
 };
 
 template <class T, uint32_t MAX_N>
@@ -1874,6 +1984,54 @@ public:
   }
 };
 
+/**
+ * Index of the protocol IEs of an S1AP or NGAP PDU, built in a single pass that skips over the IE values. The IEs of
+ * interest can then be unpacked one by one, and octet strings accessed in place, without unpacking the whole PDU.
+ * The indexed buffer must outlive the index.
+ */
+class protocol_ie_index
+{
+public:
+  static const uint32_t max_nof_ies = 32;
+
+  struct ie_t {
+    uint32_t       id;
+    const uint8_t* value; ///< Contents of the IE open type
+    uint32_t       len;
+  };
+
+  SRSASN_CODE index(const uint8_t* buf, uint32_t len);
+
+  /// 0 for initiatingMessage, 1 for successfulOutcome and 2 for unsuccessfulOutcome
+  uint8_t     pdu_type() const { return type; }
+  uint16_t    proc_code() const { return proc; }
+  bool        ext() const { return ext_; }
+  uint32_t    nof_ies() const { return nof_ies_; }
+  const ie_t& ie(uint32_t idx) const { return ies[idx]; }
+  const ie_t* find_ie(uint32_t id) const;
+
+  template <class T>
+  SRSASN_CODE unpack_ie(uint32_t id, T& value) const
+  {
+    const ie_t* ie = find_ie(id);
+    if (ie == nullptr) {
+      return SRSASN_ERROR_DECODE_FAIL;
+    }
+    cbit_ref bref(ie->value, ie->len);
+    return value.unpack(bref);
+  }
+
+  /// Locates the octets of an OCTET STRING IE within the indexed buffer, without copying them
+  SRSASN_CODE get_octstring_ie(uint32_t id, const uint8_t*& data, uint32_t& len) const;
+
+private:
+  uint8_t                       type     = 0;
+  uint16_t                      proc     = 0;
+  bool                          ext_     = false;
+  uint32_t                      nof_ies_ = 0;
+  std::array<ie_t, max_nof_ies> ies;
+};
+
 } // namespace asn1
 
 #endif // SRSASN_COMMON_UTILS_H
@@ -2588,6 +2588,34 @@ LIBLTE_ERROR_ENUM liblte_mme_pack_attach_request_msg(LIBLTE_MME_ATTACH_REQUEST_M
 LIBLTE_ERROR_ENUM liblte_mme_unpack_attach_request_msg(LIBLTE_BYTE_MSG_STRUCT*               msg,
                                                        LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT* attach_req);
 
+/*********************************************************************
+    Message Name: Attach Request (view)
+
+    Description: Compact form of the Attach Request with the IEs used
+                 by the network. The message is parsed in place with
+                 bounds checking, only the present IEs are touched and
+                 the ESM message container is not copied.
+
+    Document Reference: 24.301 v10.2.0 Section 8.2.4
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+typedef struct {
+  LIBLTE_MME_NAS_KEY_SET_ID_STRUCT        nas_ksi;
+  LIBLTE_MME_EPS_MOBILE_ID_STRUCT         eps_mobile_id;
+  LIBLTE_MME_UE_NETWORK_CAPABILITY_STRUCT ue_network_cap;
+  LIBLTE_MME_MS_NETWORK_CAPABILITY_STRUCT ms_network_cap;
+  const uint8*                            esm_msg; // Points into the parsed message
+  uint32                                  esm_msg_len;
+  uint8                                   eps_attach_type;
+  bool                                    ms_network_cap_present;
+} LIBLTE_MME_ATTACH_REQUEST_VIEW_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_mme_parse_attach_request_msg(const uint8*                           msg,
+                                                      uint32                                 msg_len,
+                                                      LIBLTE_MME_ATTACH_REQUEST_VIEW_STRUCT* attach_req);
+
 /*********************************************************************
     Message Name: Authentication Failure
 
@@ -3924,6 +3952,38 @@ LIBLTE_ERROR_ENUM
 liblte_mme_unpack_pdn_connectivity_request_msg(LIBLTE_BYTE_MSG_STRUCT*                         msg,
                                                LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT* pdn_con_req);
 
+/*********************************************************************
+    Message Name: PDN Connectivity Request (view)
+
+    Description: Compact form of the PDN Connectivity Request. The
+                 APN and the Protocol Configuration Options are not
+                 decoded, they point into the parsed message.
+
+    Document Reference: 24.301 v10.2.0 Section 8.3.20
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+typedef struct {
+  const uint8*                           apn;                // Value of the APN IE, pointing into the parsed message
+  const uint8*                           protocol_cnfg_opts; // Value of the PCO IE, pointing into the parsed message
+  uint32                                 apn_len;
+  uint32                                 protocol_cnfg_opts_len;
+  LIBLTE_MME_ESM_INFO_TRANSFER_FLAG_ENUM esm_info_transfer_flag;
+  uint8                                  eps_bearer_id;
+  uint8                                  proc_transaction_id;
+  uint8                                  pdn_type;
+  uint8                                  request_type;
+  bool                                   esm_info_transfer_flag_present;
+  bool                                   apn_present;
+  bool                                   protocol_cnfg_opts_present;
+} LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_VIEW_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM
+liblte_mme_parse_pdn_connectivity_request_msg(const uint8*                                     msg,
+                                              uint32                                           msg_len,
+                                              LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_VIEW_STRUCT* pdn_con_req);
+
 /*********************************************************************
     Message Name: PDN Disconnect Reject
 
@@ -66,6 +66,15 @@ public:
 
   bool set_five_qi(uint32_t eps_bearer_id, uint16_t five_qi);
 
+  /// Calls f(radio_bearer) for each registered EPS bearer
+  template <typename F>
+  void for_each_bearer(F&& f) const
+  {
+    for (const auto& bearer : bearers) {
+      f(bearer.second);
+    }
+  }
+
 private:
   using eps_rb_map_t = std::map<uint32_t, radio_bearer_t>;
 
@@ -162,6 +171,15 @@ public:
   radio_bearer_t get_lcid_bearer(uint16_t rnti, uint32_t lcid) const;
   bool           set_five_qi(uint16_t rnti, uint32_t eps_bearer_id, uint16_t five_qi);
 
+  /// Calls f(rnti, radio_bearer) for each registered EPS bearer of all users
+  template <typename F>
+  void for_each_bearer(F&& f) const
+  {
+    for (const auto& user : users_map) {
+      user.second.for_each_bearer([&user, &f](const radio_bearer_t& rb) { f(user.first, rb); });
+    }
+  }
+
 private:
   srslog::basic_logger& logger;
 
@@ -56,6 +56,15 @@ struct buffer_latency_calc {
 
   std::chrono::high_resolution_clock::time_point get_timestamp() const { return tp; }
 
+  bool has_timestamp() const
+  {
+#ifdef ENABLE_TIMESTAMP
+    return timestamp_is_set;
+#else
+    return false;
+#endif
+  }
+
   void set_timestamp()
   {
 #ifdef ENABLE_TIMESTAMP
@@ -101,7 +110,8 @@ public:
 
   struct buffer_metadata_t {
     uint32_t            pdcp_sn = 0;
-    buffer_latency_calc tp;
+    buffer_latency_calc tp;       // Ingress into the stack, e.g. GTP-U in the eNB
+    buffer_latency_calc queue_tp; // Entry into the RLC TX queue
   } md;
 
   byte_buffer_t() : msg(&buffer[SRSRAN_BUFFER_HEADER_OFFSET])
@@ -100,8 +100,12 @@ public:
   /// NOTE: This method is not thread safe.
   static void configure(srslog::log_channel& c, asn1_output_format asn1_format);
 
+  /// Returns true if a log channel was configured, so that callers can skip formatting the event arguments otherwise.
+  static bool is_enabled() { return enabled; }
+
 private:
   static std::unique_ptr<event_logger_interface> pimpl;
+  static bool                                    enabled;
 };
 
 } // namespace srsenb
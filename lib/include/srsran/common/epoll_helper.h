@@ -26,13 +26,16 @@
 #ifndef SRSRAN_EPOLL_HELPER_H
 #define SRSRAN_EPOLL_HELPER_H
 
+#include "srsran/config.h"
 #include <atomic>
+#include <cstring>
 #include <functional>
 #include <signal.h>
 #include <sys/epoll.h>
 #include <sys/signalfd.h>
 #include <sys/timerfd.h>
 #include <unistd.h>
+#include <vector>
 
 ///< A virtual interface to handle epoll events (used by timer and port handler)
 class epoll_handler
@@ -62,6 +62,7 @@ struct rf_args_t {
   std::string device_args;
   std::string time_adv_nsamples;
   std::string continuous_tx;
+  uint32_t    tx_queue_size = 0; // Number of transmissions queued for the Tx thread, 0 transmits from the caller
 
   std::array<rf_args_band_t, SRSRAN_MAX_CARRIERS> ch_rx_bands;
   std::array<rf_args_band_t, SRSRAN_MAX_CARRIERS> ch_tx_bands;
@@ -0,0 +1,73 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_LATENCY_HIST_H
+#define SRSRAN_LATENCY_HIST_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace srsran {
+
+/// Number of bins of the packet latency histograms. Bin 0 counts the latencies below 1 us and bin i > 0 the ones in
+/// [2^(i-1), 2^i) us, so that the last bin starts at ~262 ms and also counts any larger latency.
+constexpr uint32_t latency_hist_len = 20;
+
+/// Returns the bin of a latency in the packet latency histograms.
+inline uint32_t latency_hist_bin(std::chrono::microseconds latency)
+{
+  uint64_t us  = latency.count() > 0 ? static_cast<uint64_t>(latency.count()) : 0;
+  uint32_t bin = us ? 64U - static_cast<uint32_t>(__builtin_clzll(us)) : 0;
+  return bin < latency_hist_len ? bin : latency_hist_len - 1;
+}
+
+/// Packet latency histogram filled by one thread and read by the metrics thread without locks.
+class latency_hist
+{
+public:
+  void push(std::chrono::microseconds latency)
+  {
+    bins[latency_hist_bin(latency)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Copies the counts into a metrics histogram of latency_hist_len bins.
+  void read(uint32_t* hist) const
+  {
+    for (uint32_t i = 0; i != latency_hist_len; ++i) {
+      hist[i] = bins[i].load(std::memory_order_relaxed);
+    }
+  }
+
+  void reset()
+  {
+    for (auto& bin : bins) {
+      bin.store(0, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  std::atomic<uint32_t> bins[latency_hist_len] = {};
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_LATENCY_HIST_H
@@ -25,6 +25,8 @@
 #include "srsran/common/common.h"
 #include "srsran/common/mac_pcap_base.h"
 #include "srsran/srsran.h"
+#include <sys/uio.h>
+#include <vector>
 
 namespace srsran {
 class mac_pcap : public mac_pcap_base
@@ -36,11 +38,19 @@ public:
   uint32_t close();
 
 private:
-  void write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu);
+  void write_pdu(const srsran::mac_pcap_base::pcap_pdu_t& pdu, const uint8_t* payload) override;
+  void flush_pdus() override;
 
-  FILE*       pcap_file = nullptr;
-  uint32_t    dlt       = 0; // The DLT used for the PCAP file
-  std::string filename;
+  // The records of a batch are gathered in iovecs, pointing to their headers and to the payloads in the capture
+  // rings, and written with one writev call
+  static const uint32_t max_batch_pdus   = 256;
+  static const uint32_t max_header_bytes = sizeof(pcaprec_hdr_t) + PCAP_CONTEXT_HEADER_MAX;
+
+  FILE*                     pcap_file = nullptr;
+  uint32_t                  dlt       = 0; // The DLT used for the PCAP file
+  std::string               filename;
+  std::vector<struct iovec> iovs;
+  std::vector<uint8_t>      headers;
 };
 } // namespace srsran
 
@@ -27,9 +27,12 @@
 #include "srsran/common/common.h"
 #include "srsran/common/pcap.h"
 #include "srsran/common/threads.h"
+#include "srsran/phy/utils/ringbuffer_mirror.h"
 #include "srsran/srslog/srslog.h"
+#include <array>
 #include <mutex>
 #include <stdint.h>
+#include <sys/time.h>
 #include <thread>
 
 namespace srsran {
@@ -49,6 +52,9 @@ public:
 
   void set_ue_id(uint16_t ue_id);
 
+  /// Truncates the captured PDUs to snaplen bytes, 0 captures the whole PDUs.
+  void set_snaplen(uint32_t snaplen);
+
   // EUTRA
   void
   write_ul_crnti(uint8_t* pdu, uint32_t pdu_len_bytes, uint16_t crnti, uint32_t reTX, uint32_t tti, uint8_t cc_idx);
@@ -97,23 +103,28 @@ public:
   // clang-format on
 
 protected:
+  /// Captured PDU. It is stored in the capture rings followed by its payload.
   typedef struct {
     // Different PCAP context for both RATs
     srsran::srsran_rat_t  rat;
     MAC_Context_Info_t    context;
     mac_nr_context_info_t context_nr;
-    unique_byte_buffer_t  pdu;
+    struct timeval        timestamp;
+    uint32_t              len;      ///< Number of captured payload bytes
+    uint32_t              orig_len; ///< Length of the PDU before the truncation to the snaplen
   } pcap_pdu_t;
 
-  virtual void write_pdu(pcap_pdu_t& pdu) = 0;
+  /// Writes a captured PDU from the writer thread. The payload stays valid until flush_pdus() returns.
+  virtual void write_pdu(const pcap_pdu_t& pdu, const uint8_t* payload) = 0;
+  /// Called after writing each batch of PDUs.
+  virtual void flush_pdus() {}
   void         run_thread() final;
 
-  std::mutex                              mutex;
-  srslog::basic_logger&                   logger;
-  std::atomic<bool>                       running = {false};
-  static_blocking_queue<pcap_pdu_t, 1024> queue;
-  uint16_t                                ue_id                = 0;
-  int                                     emergency_handler_id = -1;
+  std::mutex            mutex;
+  srslog::basic_logger& logger;
+  std::atomic<bool>     running              = {false};
+  uint16_t              ue_id                = 0;
+  int                   emergency_handler_id = -1;
 
 private:
   void pack_and_queue(uint8_t* payload,
@@ -134,6 +145,21 @@ private:
                          uint8_t  harqid,
                          uint8_t  direction,
                          uint8_t  rnti_type);
+  bool     capture(pcap_pdu_t& pdu, const uint8_t* payload, uint32_t payload_len);
+  uint32_t write_captured_pdus();
+
+  // Each thread writing PDUs is bound to one capture ring, a ring is only shared when there are more threads than
+  // rings. The writer thread drains all of them in batches.
+  static const uint32_t nof_rings     = 16;
+  static const uint32_t ring_capacity = 1024 * 1024;
+
+  struct capture_ring_t {
+    srsran_ringbuffer_mirror_t buffer = {};
+    std::atomic_flag           busy   = ATOMIC_FLAG_INIT;
+  };
+
+  std::array<capture_ring_t, nof_rings> rings;
+  std::atomic<uint32_t>                 snaplen = {0};
 };
 
 } // namespace srsran
@@ -41,9 +41,10 @@ public:
   uint32_t close();
 
 private:
-  void write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu);
-  void write_mac_lte_pdu_to_net(srsran::mac_pcap_base::pcap_pdu_t& pdu);
-  void write_mac_nr_pdu_to_net(srsran::mac_pcap_base::pcap_pdu_t& pdu);
+  void write_pdu(const srsran::mac_pcap_base::pcap_pdu_t& pdu, const uint8_t* payload) override;
+  void write_mac_lte_pdu_to_net(const srsran::mac_pcap_base::pcap_pdu_t& pdu, const uint8_t* payload);
+  void write_mac_nr_pdu_to_net(const srsran::mac_pcap_base::pcap_pdu_t& pdu, const uint8_t* payload);
+  void send_to_net(const uint8_t* context, uint32_t context_len, const uint8_t* payload, uint32_t len);
 
   srsran::unique_socket socket;
   struct sockaddr_in    client_addr;
@@ -29,12 +29,15 @@
 #define SRSRAN_MULTIQUEUE_H
 
 #include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/detail/type_storage.h"
 #include "srsran/adt/move_callback.h"
 #include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <mutex>
 #include <queue>
+#include <thread>
 #include <vector>
 
 namespace srsran {
@@ -53,40 +56,45 @@ namespace srsran {
 template <typename myobj>
 class multiqueue_handler
 {
+  /// Bounded lock-free queue. Any thread may push or pop, although in practice the only poppers are the consumer
+  /// and the thread deactivating the port. Each slot carries a turn counter, which is even while the slot is free and
+  /// odd while it holds an object, so that the ring works for any capacity.
+  /// Only blocked pushers (the queue is full) and the deactivation of the port take q_mutex.
   class input_port_impl
   {
+    struct slot_t {
+      std::atomic<size_t>                 turn{0};
+      srsran::detail::type_storage<myobj> obj;
+    };
+
   public:
-    input_port_impl(uint32_t cap, multiqueue_handler<myobj>* parent_) : buffer(cap), parent(parent_) {}
+    input_port_impl(uint32_t cap, multiqueue_handler<myobj>* parent_) :
+      cap_(std::max(cap, 1u)), slots(new slot_t[std::max(cap, 1u)]), parent(parent_)
+    {}
     input_port_impl(const input_port_impl&) = delete;
     input_port_impl(input_port_impl&&)      = delete;
     input_port_impl& operator=(const input_port_impl&) = delete;
     input_port_impl& operator=(input_port_impl&&) = delete;
     ~input_port_impl() { deactivate_blocking(); }
 
-    size_t capacity() const { return buffer.max_size(); }
+    size_t capacity() const { return cap_; }
     size_t size() const
     {
-      std::lock_guard<std::mutex> lock(q_mutex);
-      return buffer.size();
-    }
-    bool active() const
-    {
-      std::lock_guard<std::mutex> lock(q_mutex);
-      return active_;
+      size_t head = head_pos.load(std::memory_order_acquire);
+      size_t tail = tail_pos.load(std::memory_order_acquire);
+      return tail > head ? tail - head : 0;
     }
+    bool active() const { return active_.load(std::memory_order_acquire); }
     void set_active(bool val)
     {
-      std::unique_lock<std::mutex> lock(q_mutex);
-      if (val == active_) {
+      if (active_.exchange(val) == val) {
         // no-op
         return;
       }
-      active_ = val;
-
-      if (not active_) {
-        buffer.clear();
-        lock.unlock();
+      if (not val) {
+        clear_();
         // unlock blocked pushing threads
+        std::lock_guard<std::mutex> lock(q_mutex);
         cv_full.notify_all();
       }
     }
@@ -95,11 +103,11 @@ class multiqueue_handler
     {
       set_active(false);
 
-      // wait for all the pushers to unlock
-      std::unique_lock<std::mutex> lock(q_mutex);
-      while (nof_waiting > 0) {
-        cv_exit.wait(lock);
+      // wait for all the pushers to leave, and discard what they may have pushed meanwhile
+      while (nof_pushing.load() > 0) {
+        std::this_thread::yield();
       }
+      clear_();
     }
 
     template <typename T>
@@ -120,65 +128,113 @@ class multiqueue_handler
 
     bool try_pop(myobj& obj)
     {
-      std::unique_lock<std::mutex> lock(q_mutex);
-      return pop_(lock, obj);
-    }
-
-    bool try_pop(myobj& obj, bool& try_lock_success)
-    {
-      std::unique_lock<std::mutex> lock(q_mutex, std::try_to_lock);
-      try_lock_success = lock.owns_lock();
-      return try_lock_success ? pop_(lock, obj) : false;
+      size_t  pos = head_pos.load(std::memory_order_relaxed);
+      slot_t* slot;
+      while (true) {
+        slot          = &slots[pos % cap_];
+        intptr_t diff = static_cast<intptr_t>(slot->turn.load(std::memory_order_acquire) - (2 * (pos / cap_) + 1));
+        if (diff == 0) {
+          if (head_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+            break;
+          }
+        } else if (diff < 0) {
+          // empty
+          return false;
+        } else {
+          pos = head_pos.load(std::memory_order_relaxed);
+        }
+      }
+      obj = std::move(slot->obj.get());
+      slot->obj.destroy();
+      slot->turn.store(2 * (pos / cap_) + 2, std::memory_order_release);
+
+      // pair with the fence of the blocked pushers
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (nof_waiting.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(q_mutex);
+        cv_full.notify_one();
+      }
+      return true;
     }
 
   private:
     template <typename T>
     bool push_(T* o, bool blocking) noexcept
     {
-      std::unique_lock<std::mutex> lock(q_mutex);
-      if (not blocking) {
-        // non-blocking case
-        if (not active_ or buffer.full()) {
-          return false;
+      // pushers are counted, so that the port is not deactivated while they write to it
+      nof_pushing.fetch_add(1);
+      bool ret = false;
+      if (active_.load()) {
+        ret = try_emplace_(o);
+        if (not ret and blocking) {
+          ret = wait_emplace_(o);
         }
-      } else {
-        // blocking case
-        while (active_ and buffer.full()) {
-          nof_waiting++;
-          cv_full.wait(lock);
-          nof_waiting--;
+        if (ret) {
+          parent->notify_consumer_();
         }
-        if (not active_) {
-          lock.unlock();
-          cv_exit.notify_one();
+      }
+      nof_pushing.fetch_sub(1);
+      return ret;
+    }
+
+    template <typename T>
+    bool try_emplace_(T* o)
+    {
+      size_t  pos = tail_pos.load(std::memory_order_relaxed);
+      slot_t* slot;
+      while (true) {
+        slot          = &slots[pos % cap_];
+        intptr_t diff = static_cast<intptr_t>(slot->turn.load(std::memory_order_acquire) - 2 * (pos / cap_));
+        if (diff == 0) {
+          if (tail_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+            break;
+          }
+        } else if (diff < 0) {
+          // full
           return false;
+        } else {
+          pos = tail_pos.load(std::memory_order_relaxed);
         }
       }
-      buffer.push(std::forward<T>(*o));
+      slot->obj.emplace(std::forward<T>(*o));
+      slot->turn.store(2 * (pos / cap_) + 1, std::memory_order_release);
       return true;
     }
 
-    bool pop_(std::unique_lock<std::mutex>& lock, myobj& obj)
+    template <typename T>
+    bool wait_emplace_(T* o)
     {
-      if (buffer.empty()) {
-        return false;
+      std::unique_lock<std::mutex> lock(q_mutex);
+      nof_waiting.fetch_add(1);
+      // pair with the fence of the popper, so that either it sees this pusher waiting or this pusher sees the slot free
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      bool ret = false;
+      while (active_.load() and not(ret = try_emplace_(o))) {
+        cv_full.wait(lock);
       }
-      obj = std::move(buffer.top());
-      buffer.pop();
-      if (nof_waiting > 0) {
-        lock.unlock();
-        cv_full.notify_one();
+      nof_waiting.fetch_sub(1);
+      return ret;
+    }
+
+    void clear_()
+    {
+      myobj obj;
+      while (try_pop(obj)) {
       }
-      return true;
     }
 
+    const size_t               cap_;
+    std::unique_ptr<slot_t[]>  slots;
     multiqueue_handler<myobj>* parent = nullptr;
-
-    mutable std::mutex                 q_mutex;
-    srsran::dyn_circular_buffer<myobj> buffer;
-    std::condition_variable            cv_full, cv_exit;
-    bool                               active_     = true;
-    int                                nof_waiting = 0;
+    std::atomic<bool>          active_{true};
+    std::atomic<int>           nof_pushing{0}, nof_waiting{0};
+    char                       pad0[64];
+    std::atomic<size_t>        tail_pos{0};
+    char                       pad1[64];
+    std::atomic<size_t>        head_pos{0};
+    char                       pad2[64];
+    std::mutex                 q_mutex;
+    std::condition_variable    cv_full;
   };
 
 public:
@@ -234,6 +290,12 @@ public:
       // signal deactivation to pushing threads in a non-blocking way
       q.set_active(false);
     }
+    {
+      // wake up the consumer
+      std::lock_guard<std::mutex> park_lock(park_mutex);
+      consumer_parked = false;
+      park_cv.notify_one();
+    }
     while (consumer_state) {
       cv_exit.wait(lock);
     }
@@ -289,15 +351,23 @@ public:
   bool wait_pop(myobj* value)
   {
     std::unique_lock<std::mutex> lock(mutex);
-    consumer_state = true;
+    consumer_state     = true;
+    uint32_t nof_spins = 0;
     while (running) {
       if (round_robin_pop_(value)) {
         consumer_state = false;
         return true;
       }
-      lock.unlock();
-      std::this_thread::sleep_for(std::chrono::microseconds(100));
-      lock.lock();
+      if (nof_spins < nof_spins_before_park) {
+        // new tasks usually arrive in bursts, so spin for a while before going to sleep
+        nof_spins++;
+        lock.unlock();
+        std::this_thread::yield();
+        lock.lock();
+      } else {
+        nof_spins = 0;
+        park_(lock);
+      }
     }
     consumer_state = false;
     lock.unlock();
@@ -312,34 +382,75 @@ public:
   }
 
 private:
+  /// Number of pop attempts of wait_pop() before it goes to sleep.
+  static const uint32_t nof_spins_before_park = 64;
+
   bool round_robin_pop_(myobj* value)
   {
     // Round-robin for all queues
-    auto     q_it  = queues.begin() + spin_idx;
-    uint32_t count = 0;
-    for (; count < queues.size(); ++count, ++q_it) {
+    auto q_it = queues.begin() + spin_idx;
+    for (uint32_t count = 0; count < queues.size(); ++count, ++q_it) {
       if (q_it == queues.end()) {
         q_it = queues.begin(); // wrap-around
       }
-      bool try_lock_success = true;
-      if (q_it->try_pop(*value, try_lock_success)) {
+      if (q_it->try_pop(*value)) {
         spin_idx = (spin_idx + count + 1) % queues.size();
         return true;
       }
-      if (not try_lock_success) {
-        // restart RR search, as there was a collision with a producer
-        count = 0;
+    }
+    return false;
+  }
+
+  bool has_pending_() const
+  {
+    for (const auto& q : queues) {
+      if (q.size() > 0) {
+        return true;
       }
     }
     return false;
   }
 
+  /// Puts the consumer to sleep until a task is pushed or the multiqueue is stopped.
+  /// NOTE: must be called with the mutex held.
+  void park_(std::unique_lock<std::mutex>& lock)
+  {
+    std::unique_lock<std::mutex> park_lock(park_mutex);
+    consumer_parked.store(true);
+    // pair with the fence of the pushers, so that either they see the consumer parked or it sees their tasks
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (has_pending_()) {
+      consumer_parked.store(false);
+      return;
+    }
+    lock.unlock();
+    while (consumer_parked.load()) {
+      park_cv.wait(park_lock);
+    }
+    park_lock.unlock();
+    lock.lock();
+  }
+
+  /// Called by the pushers after every push. Only the first push after the consumer is parked pays for the wake up.
+  void notify_consumer_()
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumer_parked.load(std::memory_order_relaxed) and consumer_parked.exchange(false)) {
+      std::lock_guard<std::mutex> lock(park_mutex);
+      park_cv.notify_one();
+    }
+  }
+
   mutable std::mutex          mutex;
   std::condition_variable     cv_exit;
   uint32_t                    spin_idx = 0;
   bool                        running = true, consumer_state = false;
   std::deque<input_port_impl> queues;
   uint32_t                    default_capacity = 0;
+
+  std::mutex              park_mutex;
+  std::condition_variable park_cv;
+  std::atomic<bool>       consumer_parked{false};
 };
 
 template <typename T>
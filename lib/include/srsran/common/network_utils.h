@@ -22,6 +22,8 @@
 #ifndef SRSRAN_RX_SOCKET_HANDLER_H
 #define SRSRAN_RX_SOCKET_HANDLER_H
 
+#include "srsran/adt/bounded_vector.h"
+#include "srsran/adt/circular_buffer.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/multiqueue.h"
 #include "srsran/common/threads.h"
@@ -91,6 +93,7 @@ public:
   bool sctp_subscribe_to_events();
   bool sctp_set_rto_opts(int rto_max);
   bool sctp_set_init_msg_opts(int max_init_attempts, int max_init_timeo);
+  bool sctp_set_nof_streams(int nof_streams);
   int  get_socket() const { return sockfd; };
 
 protected:
@@ -102,6 +105,10 @@ namespace net_utils {
 
 bool sctp_init_socket(unique_socket* socket, net_utils::socket_type socktype, const char* bind_addr_str, int bind_port);
 
+/// Spreads the UE-associated signalling over the outbound streams of an association, keeping stream 0 for the non
+/// UE-associated signalling. A given UE always maps to the same stream.
+uint16_t sctp_ue_stream_id(uint32_t ue_id, int nof_ostreams);
+
 } // namespace net_utils
 
 /****************************
@@ -132,7 +139,8 @@ protected:
 };
 
 /**
- * Description - Instantiates a thread that will block waiting for IO from multiple sockets, via a select
+ * Description - Instantiates a thread that will block waiting for IO from multiple sockets, via an epoll instance.
+ *               All the sockets that are ready are handled in a single wake-up of the thread.
  *               The user can register their own (socket fd, data handler) in this class via the
  *               add_socket_handler(fd, task) API or its other variants
  */
@@ -153,22 +161,25 @@ public:
 
 private:
   const int thread_prio = 65;
+  /// Maximum number of ready fds handled per wake-up of the thread
+  static const int max_events = 64;
 
-  // used to unlock select
+  // used to unlock epoll_wait
   struct ctrl_cmd_t {
-    enum class cmd_id_t { EXIT, NEW_FD, RM_FD };
+    enum class cmd_id_t { EXIT, RM_FD };
     cmd_id_t cmd;
     int      new_fd;
     bool     signal_rm_complete;
     ctrl_cmd_t() { bzero(this, sizeof(ctrl_cmd_t)); }
   };
-  std::map<int, recv_callback_t>::iterator remove_socket_unprotected(int fd, fd_set* total_fd_set, int* max_fd);
+  std::map<int, recv_callback_t>::iterator remove_socket_unprotected(int fd);
 
   // state
   std::mutex                     socket_mutex;
   std::map<int, recv_callback_t> active_sockets;
   std::atomic<bool>              running   = {false};
   int                            pipefd[2] = {-1, -1};
+  int                            epoll_fd  = -1;
   std::vector<int>               rem_fd_tmp_list;
   std::condition_variable        rem_cvar;
 };
@@ -180,6 +191,17 @@ using sctp_recv_callback_t =
 /// Function signature for SDU byte buffers received from any sockaddr_in-based socket
 using recvfrom_callback_t = srsran::move_callback<void(srsran::unique_byte_buffer_t, const sockaddr_in&)>;
 
+/// Datagrams received from a socket in a single system call, along with their source addresses
+struct datagram_batch {
+  static const size_t max_size = 32;
+
+  srsran::bounded_vector<srsran::unique_byte_buffer_t, max_size> pdus;
+  srsran::bounded_vector<sockaddr_in, max_size>                  addrs;
+};
+
+/// Function signature for the batches of datagrams received from any sockaddr_in-based socket
+using recvfrom_batch_callback_t = srsran::move_callback<void(datagram_batch&)>;
+
 /**
  * Helper function that creates a callback that is called when a SCTP socket has data, and does the following tasks:
  * 1. receive SDU byte buffer from SCTP socket and associated metadata - sockaddr_in, sctp_sndrcvinfo, flags
@@ -200,6 +222,83 @@ make_sctp_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& q
 socket_manager_itf::recv_callback_t
 make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue, recvfrom_callback_t rx_callback);
 
+/**
+ * Similar to make_sdu_handler, but reads all the datagrams pending in the socket, up to datagram_batch::max_size, with
+ * a single recvmmsg() call into a ring of pool buffers, and dispatches them into the "queue" as a single task
+ */
+socket_manager_itf::recv_callback_t make_batch_sdu_handler(srslog::basic_logger&      logger,
+                                                           srsran::task_queue_handle& queue,
+                                                           recvfrom_batch_callback_t  rx_callback);
+
+/**
+ * Aggregates the datagrams sent over a sockaddr_in-based socket, so that they are handed to the kernel with a single
+ * sendmmsg() call when flush() is called or when datagram_batch::max_size datagrams are pending
+ */
+class datagram_tx_batch
+{
+public:
+  explicit datagram_tx_batch(srslog::basic_logger& logger_) : logger(logger_) {}
+
+  void   set_fd(int fd_) { fd = fd_; }
+  void   push(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr);
+  void   flush();
+  size_t size() const { return pending.pdus.size(); }
+  bool   empty() const { return pending.pdus.empty(); }
+
+private:
+  srslog::basic_logger& logger;
+  int                   fd = -1;
+  datagram_batch        pending;
+};
+
+/**
+ * Sends the messages of a SCTP association from a dedicated thread, so that the caller never blocks on the socket.
+ * The messages pushed by the caller are handed over to the thread in batches, by flush() or once max_batch_size
+ * messages are pending, and the thread sends each batch with a single sendmmsg() call.
+ */
+class sctp_tx_worker final : public thread
+{
+public:
+  static const size_t max_batch_size = 32;
+
+  sctp_tx_worker(srslog::basic_logger& logger_, std::string thread_name);
+  ~sctp_tx_worker() final;
+
+  void stop();
+
+  /// Sets the connected socket, destination address and PPID of the messages
+  void set_socket(int fd_, const sockaddr_in& dest_addr_, uint32_t ppid_);
+  /// Discards the pending messages and waits for the batch being sent, so that the socket can be closed
+  void clear_socket();
+
+  void push(srsran::unique_byte_buffer_t pdu, uint16_t stream_id);
+  void flush();
+  bool empty() const { return pending.pdus.empty(); }
+
+private:
+  static const size_t max_nof_batches = 64;
+
+  struct batch_t {
+    srsran::bounded_vector<srsran::unique_byte_buffer_t, max_batch_size> pdus;
+    srsran::bounded_vector<uint16_t, max_batch_size>                     stream_ids;
+  };
+
+  void run_thread() override;
+  void send_batch(batch_t& batch, int fd_, const sockaddr_in& dest_addr_, uint32_t ppid_);
+
+  srslog::basic_logger& logger;
+  batch_t               pending; ///< Filled by the caller, not shared with the thread
+
+  std::mutex                           mutex;
+  std::condition_variable              cvar;
+  srsran::dyn_circular_buffer<batch_t> queue;
+  bool                                 running   = true;
+  bool                                 sending   = false;
+  int                                  fd        = -1;
+  sockaddr_in                          dest_addr = {};
+  uint32_t                             ppid      = 0;
+};
+
 inline socket_manager& get_rx_io_manager()
 {
   static socket_manager io;
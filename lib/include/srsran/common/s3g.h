@@ -39,8 +39,8 @@
 #include <string.h>
 
 typedef struct {
-  uint32_t* lfsr;
-  uint32_t* fsm;
+  uint32_t lfsr[16];
+  uint32_t fsm[3];
 } S3G_STATE;
 
 /* Initialization.
@@ -95,10 +95,16 @@ void s3g_generate_keystream(S3G_STATE* state, uint32_t n, uint32_t* ks);
  * Input dir:1 bit, direction of transmission (in the LSB).
  * Input data: length number of bits, input bit stream.
  * Input length: 64 bit Length, i.e., the number of bits to be MAC'd.
- * Output : 32 bit block used as MAC
+ * Output mac: 32 bit block used as MAC
  * Generates 32-bit MAC using UIA2 algorithm as defined in Section 4.
  */
 
-uint8_t* s3g_f9(const uint8_t* key, uint32_t count, uint32_t fresh, uint32_t dir, uint8_t* data, uint64_t length);
+void s3g_f9(const uint8_t* key,
+            uint32_t       count,
+            uint32_t       fresh,
+            uint32_t       dir,
+            const uint8_t* data,
+            uint64_t       length,
+            uint8_t*       mac);
 
 #endif // SRSRAN_S3G_H
\ No newline at end of file
@@ -29,6 +29,7 @@
 #include "srsran/common/common.h"
 #include "srsran/srslog/srslog.h"
 
+#include <memory>
 #include <vector>
 
 #define AKA_RAND_LEN 16
@@ -110,6 +111,38 @@ struct k_gnb_context_t {
   as_key_t sk_gnb;
 };
 
+/// AES-128 key schedule and CMAC subkeys of an EEA2/EIA2 key. They are expanded once when the key is configured,
+/// instead of once per message
+class security_aes_key_t
+{
+public:
+  security_aes_key_t();
+  ~security_aes_key_t();
+
+  void set_key(const uint8_t* key);
+  bool is_set() const { return ctx != nullptr; }
+
+private:
+  struct aes_ctx_t;
+
+  friend uint8_t security_128_eia2(const security_aes_key_t& key,
+                                   uint32_t                  count,
+                                   uint32_t                  bearer,
+                                   uint8_t                   direction,
+                                   const uint8_t*            msg,
+                                   uint32_t                  msg_len,
+                                   uint8_t*                  mac);
+  friend uint8_t security_128_eea2(const security_aes_key_t& key,
+                                   uint32_t                  count,
+                                   uint8_t                   bearer,
+                                   uint8_t                   direction,
+                                   const uint8_t*            msg,
+                                   uint32_t                  msg_len,
+                                   uint8_t*                  msg_out);
+
+  std::unique_ptr<aes_ctx_t> ctx;
+};
+
 struct as_security_config_t {
   as_key_t                    k_rrc_int;
   as_key_t                    k_rrc_enc;
@@ -272,6 +305,15 @@ uint8_t security_128_eia2(const uint8_t* key,
                           uint32_t       msg_len,
                           uint8_t*       mac);
 
+/// EIA2 with a pre-expanded key. The message is processed in place, without being copied
+uint8_t security_128_eia2(const security_aes_key_t& key,
+                          uint32_t                  count,
+                          uint32_t                  bearer,
+                          uint8_t                   direction,
+                          const uint8_t*            msg,
+                          uint32_t                  msg_len,
+                          uint8_t*                  mac);
+
 uint8_t security_128_eia3(const uint8_t* key,
                           uint32_t       count,
                           uint32_t       bearer,
@@ -301,6 +343,15 @@ uint8_t security_128_eea2(uint8_t* key,
                           uint32_t msg_len,
                           uint8_t* msg_out);
 
+/// EEA2 with a pre-expanded key. msg_out may be the same buffer as msg
+uint8_t security_128_eea2(const security_aes_key_t& key,
+                          uint32_t                  count,
+                          uint8_t                   bearer,
+                          uint8_t                   direction,
+                          const uint8_t*            msg,
+                          uint32_t                  msg_len,
+                          uint8_t*                  msg_out);
+
 uint8_t security_128_eea3(uint8_t* key,
                           uint32_t count,
                           uint8_t  bearer,
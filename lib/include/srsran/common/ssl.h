@@ -30,6 +30,16 @@ typedef mbedtls_aes_context aes_context;
 #define AES_ENCRYPT 1
 #define AES_DECRYPT 0
 
+inline void aes_init(aes_context* ctx)
+{
+  mbedtls_aes_init(ctx);
+}
+
+inline void aes_free(aes_context* ctx)
+{
+  mbedtls_aes_free(ctx);
+}
+
 inline int aes_setkey_enc(aes_context* ctx, const unsigned char* key, unsigned int keysize)
 {
   return mbedtls_aes_setkey_enc(ctx, key, keysize);
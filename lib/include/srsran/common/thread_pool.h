@@ -55,6 +55,7 @@ public:
     worker();
     ~worker() = default;
     void     setup(uint32_t id, thread_pool* parent, uint32_t prio = 0, uint32_t mask = 255);
+    void     setup(uint32_t id, thread_pool* parent, uint32_t prio, const std::string& cpu_list);
     void     stop();
     uint32_t get_id();
     void     release();
@@ -75,6 +76,7 @@ public:
 
   thread_pool(uint32_t nof_workers_, std::string id_ = "");
   void        init_worker(uint32_t id, worker*, uint32_t prio = 0, uint32_t mask = 255);
+  void        init_worker(uint32_t id, worker*, uint32_t prio, const std::string& cpu_list);
   void        stop();
   worker*     wait_worker_id(uint32_t id);
   worker*     wait_worker(uint32_t tti);
@@ -101,11 +103,25 @@ private:
   std::vector<std::condition_variable> cvar_worker = {};
 };
 
+/// Metrics of a task_thread_pool. The task counters are cumulative since the pool was created.
+struct task_thread_pool_metrics_t {
+  uint64_t              nof_tasks         = 0; ///< Tasks run by the workers
+  uint64_t              nof_stolen_tasks  = 0; ///< Tasks run by another worker than the one they were queued to
+  uint32_t              nof_pending_tasks = 0;
+  std::vector<uint32_t> queue_len;             ///< Tasks waiting in the queues of each worker
+};
+
+/// Pool of workers for background tasks. Every worker has its own queues, so producers and workers do not contend on
+/// a single queue: other threads push into the inbox of one worker, picked round robin or by an affinity key, and the
+/// tasks pushed from a task of the pool go into the lock-free Chase-Lev deque of the worker running it. A worker
+/// takes its tasks from the deque, then refills it from its inbox, and once both are empty it steals from the other
+/// workers. The affinity is therefore a hint, a busy worker gives its tasks away to the idle ones.
 class task_thread_pool
 {
-  using task_t                             = srsran::move_callback<void(), default_move_callback_buffer_size, true>;
-  static constexpr uint32_t max_task_shift = 14;
-  static constexpr uint32_t max_task_num   = 1u << max_task_shift;
+  using task_t                            = srsran::move_callback<void(), default_move_callback_buffer_size, true>;
+  static constexpr uint32_t inbox_size    = 4096;
+  static constexpr uint32_t deque_size    = 1024;
+  static constexpr uint32_t min_nof_slots = 16; ///< Workers that set_nof_workers() can reach after the creation
 
 public:
   task_thread_pool(uint32_t nof_workers = 1, bool start_deferred = false, int32_t prio_ = -1, uint32_t mask_ = 255);
@@ -119,38 +135,94 @@ public:
   void start(int32_t prio_ = -1, uint32_t mask_ = 255);
   void set_nof_workers(uint32_t nof_workers);
 
-  void     push_task(task_t&& task);
-  uint32_t nof_pending_tasks() const;
-  size_t   nof_workers() const { return workers.size(); }
+  void push_task(task_t&& task);
+  /// Pushes a task to the worker given by the affinity key, e.g. a RNTI, so that the tasks sharing a key run in the
+  /// same worker, and in push order, as long as that worker keeps up with them.
+  void push_task(uint32_t affinity_key, task_t&& task);
+
+  uint32_t                   nof_pending_tasks() const;
+  size_t                     nof_workers() const { return nof_active.load(std::memory_order_acquire); }
+  task_thread_pool_metrics_t get_metrics() const;
 
 private:
+  /// Bounded Chase-Lev deque. Only the owner worker pushes, at the bottom, while the owner and the thieves take from
+  /// the top with a CAS, so that the tasks leave in push order. A slot is only reused once the task it held has been
+  /// moved out.
+  class task_deque
+  {
+  public:
+    explicit task_deque(uint32_t size_) : slots(size_), mask(size_ - 1) {}
+
+    bool     push(task_t&& task);
+    bool     pop(task_t& task);
+    uint32_t size() const;
+
+  private:
+    struct slot_t {
+      task_t            task;
+      std::atomic<bool> busy{false};
+    };
+
+    std::vector<slot_t>   slots;
+    const uint64_t        mask;
+    std::atomic<uint64_t> top{0};
+    std::atomic<uint64_t> bottom{0};
+  };
+
   class worker_t : public thread
   {
   public:
     explicit worker_t(task_thread_pool* parent_, uint32_t id);
+    void     launch();
     void     stop();
-    bool     is_running() const { return running; }
+    void     wake_up();
     uint32_t id() const { return id_; }
 
     void run_thread() override;
 
-  private:
-    bool wait_task(task_t* task);
+    bool     belongs_to(const task_thread_pool* pool) const { return parent == pool; }
+    bool     push_inbox(task_t&& task);
+    bool     pop_inbox(task_t& task, bool refill_deque);
+    uint32_t queue_len() const;
 
-    task_thread_pool* parent  = nullptr;
-    uint32_t          id_     = 0;
-    bool              running = false;
+    task_deque            deque;
+    std::atomic<bool>     sleeping{false};
+    std::atomic<uint64_t> nof_tasks{0};
+    std::atomic<uint64_t> nof_stolen_tasks{0};
+
+  private:
+    bool find_task(task_t& task);
+    bool wait_task(task_t& task);
+
+    task_thread_pool* parent   = nullptr;
+    uint32_t          id_      = 0;
+    bool              launched = false;
+
+    std::mutex                          inbox_mutex;
+    srsran::dyn_circular_buffer<task_t> inbox;
+    std::atomic<uint32_t>               inbox_len{0};
+    std::mutex                          sleep_mutex;
+    std::condition_variable             cv_sleep;
   };
 
+  void push_task_to(uint32_t worker_idx, task_t&& task, bool keep_affinity);
+  void wake_up_worker(uint32_t preferred_idx, bool keep_affinity);
+
+  /// Worker of a task_thread_pool running in the calling thread, if any.
+  static thread_local worker_t* current_worker;
+
   int32_t               prio = -1;
   uint32_t              mask = 255;
   srslog::basic_logger& logger;
 
-  srsran::dyn_circular_buffer<task_t>     pending_tasks;
+  // The worker slots are allocated upfront, so that the workers can steal from each other while set_nof_workers()
+  // adds new ones.
   std::vector<std::unique_ptr<worker_t> > workers;
-  mutable std::mutex                      queue_mutex;
-  std::condition_variable                 cv_empty;
-  bool                                    running = false;
+  std::atomic<uint32_t>                   nof_active{0};
+  std::atomic<uint32_t>                   next_worker{0};
+  std::atomic<int32_t>                    nof_queued{0};
+  std::atomic<bool>                       running{false};
+  mutable std::mutex                      state_mutex;
 };
 
 /// Class used to create a single worker with an input task queue with a single reader
@@ -39,6 +39,13 @@ bool threads_new_rt(pthread_t* thread, void* (*start_routine)(void*), void* arg)
 bool threads_new_rt_prio(pthread_t* thread, void* (*start_routine)(void*), void* arg, int prio_offset);
 bool threads_new_rt_cpu(pthread_t* thread, void* (*start_routine)(void*), void* arg, int cpu, int prio_offset);
 bool threads_new_rt_mask(pthread_t* thread, void* (*start_routine)(void*), void* arg, int mask, int prio_offset);
+bool threads_new_rt_cpu_list(pthread_t* thread,
+                             void* (*start_routine)(void*),
+                             void*       arg,
+                             const char* cpu_list,
+                             int         prio_offset);
+int  threads_parse_cpu_list(const char* cpu_list, uint32_t* cpus, uint32_t max_cpus);
+bool threads_set_self_cpu_list(const char* cpu_list);
 void threads_print_self();
 
 #ifdef __cplusplus
@@ -49,6 +56,25 @@ void threads_print_self();
 
 namespace srsran {
 
+/**
+ * Selects the CPU of a pool thread from a CPU list like "2,4-7", so that each thread of the pool runs on a CPU of its
+ * own. The CPUs isolated with isolcpus are not load balanced by the kernel, hence binding all the pool threads to the
+ * whole list would leave them on the same CPU.
+ *
+ * @param cpu_list CPUs of the pool
+ * @param idx index of the thread in the pool, it wraps around the list
+ * @return the selected CPU as a list, cpu_list itself if it is empty or invalid
+ */
+inline std::string select_cpu(const std::string& cpu_list, uint32_t idx)
+{
+  uint32_t cpus[CPU_SETSIZE];
+  int      nof_cpus = threads_parse_cpu_list(cpu_list.c_str(), cpus, CPU_SETSIZE);
+  if (nof_cpus <= 0) {
+    return cpu_list;
+  }
+  return std::to_string(cpus[idx % (uint32_t)nof_cpus]);
+}
+
 class thread
 {
 public:
@@ -79,6 +105,12 @@ public:
     return threads_new_rt_mask(&_thread, thread_function_entry, this, mask, prio);
   }
 
+  // Binds the thread to the CPUs of a list like "2,4-7", an empty list lets the OS schedule it on any CPU
+  bool start_cpu_list(int prio, const std::string& cpu_list)
+  {
+    return threads_new_rt_cpu_list(&_thread, thread_function_entry, this, cpu_list.c_str(), prio);
+  }
+
   void print_priority() { threads_print_self(); }
 
   void set_name(const std::string& name_)
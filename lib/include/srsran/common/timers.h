@@ -56,20 +56,24 @@ public:
  *   This deque will only grow in size. Erased timers are just tagged in the deque as empty, and can be reused for the
  *   creation of new timers. To avoid unnecessary runtime allocations, the user can set an initial capacity.
  * - free_list - intrusive forward linked list to keep track of the empty timers and speed up new timer creation.
- * - A large circular vector of size WHEEL_SIZE which works as a time wheel, storing and circularly indexing the
- *   currently running timers by their respective timeout value.
- *   For a number of running timers N, and uniform distribution of timeout values, the step_all() complexity
- *   should be O(N/WHEEL_SIZE). Thus, the performance should improve with a larger WHEEL_SIZE, at the expense of more
- *   used memory.
+ * - time_wheel - hierarchical time wheel storing the currently running timers. The first level has WHEEL_SIZE
+ *   slots of one tic, and each of the upper levels has LEVEL_SIZE slots, each spanning a full turn of the level below.
+ *   A timer is stored in the lowest level that can hold its timeout. When a level completes a turn, the timers of the
+ *   next slot of the level above are moved down (cascaded). Thus, run(), stop() and the expiry of a timer are O(1),
+ *   and step_all() only visits the timers that expire in the current tic, plus the cascaded ones.
  */
 class timer_handler
 {
   using tic_diff_t                      = uint32_t;
   using tic_t                           = uint32_t;
   constexpr static uint32_t INVALID_ID  = std::numeric_limits<uint32_t>::max();
-  constexpr static size_t   WHEEL_SHIFT = 16U;
+  constexpr static size_t   WHEEL_SHIFT = 8U;
   constexpr static size_t   WHEEL_SIZE  = 1U << WHEEL_SHIFT;
   constexpr static size_t   WHEEL_MASK  = WHEEL_SIZE - 1U;
+  constexpr static size_t   LEVEL_SHIFT = 6U;
+  constexpr static size_t   LEVEL_SIZE  = 1U << LEVEL_SHIFT;
+  constexpr static size_t   LEVEL_MASK  = LEVEL_SIZE - 1U;
+  constexpr static size_t   NOF_LEVELS  = 5U; ///< 8 + 4 * 6 bits cover the full range of tic_t
 
   constexpr static uint64_t   STOPPED_FLAG       = 0U;
   constexpr static uint64_t   RUNNING_FLAG       = static_cast<uint64_t>(1U) << 63U;
@@ -91,6 +95,7 @@ class timer_handler
     timer_handler& parent;
     // writes protected by backend lock
     bool                                  allocated = false;
+    uint16_t                              wheel_pos = 0; ///< position in time_wheel while running
     std::atomic<uint64_t>                 state{0}; ///< read can be without lock, thus writes must be atomic
     srsran::move_callback<void(uint32_t)> callback;
 
@@ -234,7 +239,7 @@ public:
 
   explicit timer_handler(uint32_t capacity = 64)
   {
-    time_wheel.resize(WHEEL_SIZE);
+    time_wheel.resize(WHEEL_SIZE + (NOF_LEVELS - 1) * LEVEL_SIZE);
     // Pre-reserve timers
     while (timer_list.size() < capacity) {
       timer_list.emplace_back(*this, timer_list.size());
@@ -250,25 +255,26 @@ public:
   {
     std::unique_lock<std::mutex> lock(mutex);
     uint32_t                     cur_time_local = cur_time.load(std::memory_order_relaxed) + 1;
-    auto&                        wheel_list     = time_wheel[cur_time_local & WHEEL_MASK];
+    wheel_time                                  = cur_time_local;
+    cascade_(cur_time_local);
 
-    for (auto it = wheel_list.begin(); it != wheel_list.end();) {
-      timer_impl& timer = timer_list[it->id];
-      ++it;
-      if (decode_timeout(timer.state.load(std::memory_order_relaxed)) == cur_time_local) {
-        // stop timer (callback has to see the timer has already expired)
-        stop_timer_(timer, true);
+    // All the timers in the slot expire in this tic. Timers started by the callbacks are never placed in this slot
+    auto& wheel_list = time_wheel[cur_time_local & WHEEL_MASK];
+    while (not wheel_list.empty()) {
+      timer_impl& timer = wheel_list.front();
 
-        // Call callback if configured
-        if (not timer.callback.is_empty()) {
-          // unlock mutex. It can happen that the callback tries to run a timer too
-          lock.unlock();
+      // stop timer (callback has to see the timer has already expired)
+      stop_timer_(timer, true);
 
-          timer.callback(timer.id);
+      // Call callback if configured
+      if (not timer.callback.is_empty()) {
+        // unlock mutex. It can happen that the callback tries to run or stop a timer too
+        lock.unlock();
 
-          // Lock again to keep protecting the wheel
-          lock.lock();
-        }
+        timer.callback(timer.id);
+
+        // Lock again to keep protecting the wheel
+        lock.lock();
       }
     }
 
@@ -313,7 +319,7 @@ public:
     timer.run();
   }
 
-  // useful for testing
+  // useful for testing. Size of the first level of the wheel
   static size_t get_wheel_size() { return WHEEL_SIZE; }
 
 private:
@@ -355,11 +361,12 @@ private:
     uint64_t timer_old_state = timer.state.load(std::memory_order_relaxed);
     duration_                = duration_ == 0 ? decode_duration(timer_old_state) : duration_;
     uint32_t new_timeout     = cur_time.load(std::memory_order_relaxed) + duration_;
-    size_t   new_wheel_pos   = new_timeout & WHEEL_MASK;
+    // A timer started by a callback with a timeout in the tic being stepped goes to the next tic
+    uint16_t new_wheel_pos =
+        get_wheel_pos_(new_timeout == wheel_time ? new_timeout + 1 : new_timeout, wheel_time);
 
-    uint32_t old_timeout = decode_timeout(timer_old_state);
-    bool     was_running = decode_is_running(timer_old_state);
-    if (was_running and (old_timeout & WHEEL_MASK) == new_wheel_pos) {
+    bool was_running = decode_is_running(timer_old_state);
+    if (was_running and timer.wheel_pos == new_wheel_pos) {
       // If no change in timer wheel position. Just update absolute timeout
       timer.state.store(encode_state(RUNNING_FLAG, duration_, new_timeout), std::memory_order_relaxed);
       return;
@@ -367,12 +374,13 @@ private:
 
     // Stop timer if it was running, removing it from wheel in the process
     if (was_running) {
-      time_wheel[old_timeout & WHEEL_MASK].pop(&timer);
+      time_wheel[timer.wheel_pos].pop(&timer);
       nof_timers_running_--;
     }
 
     // Insert timer in wheel
     time_wheel[new_wheel_pos].push_front(&timer);
+    timer.wheel_pos = new_wheel_pos;
     timer.state.store(encode_state(RUNNING_FLAG, duration_, new_timeout), std::memory_order_relaxed);
     nof_timers_running_++;
   }
@@ -387,14 +395,47 @@ private:
 
     // If already running, need to disconnect it from previous wheel
     uint32_t old_timeout = decode_timeout(timer_old_state);
-    time_wheel[old_timeout & WHEEL_MASK].pop(&timer);
+    time_wheel[timer.wheel_pos].pop(&timer);
     uint64_t new_state =
         encode_state(expiry ? EXPIRED_FLAG : STOPPED_FLAG, decode_duration(timer_old_state), old_timeout);
     timer.state.store(new_state, std::memory_order_relaxed);
     nof_timers_running_--;
   }
 
+  /// Returns the position in time_wheel of a timer with the given timeout, when the wheel is at the tic now.
+  static uint16_t get_wheel_pos_(tic_t timeout, tic_t now)
+  {
+    tic_diff_t delta = timeout - now;
+    if (delta < WHEEL_SIZE) {
+      return timeout & WHEEL_MASK;
+    }
+    size_t level = 1, shift = WHEEL_SHIFT;
+    for (; level < NOF_LEVELS - 1; ++level, shift += LEVEL_SHIFT) {
+      if (delta < (static_cast<tic_diff_t>(1U) << (shift + LEVEL_SHIFT))) {
+        break;
+      }
+    }
+    return WHEEL_SIZE + (level - 1) * LEVEL_SIZE + ((timeout >> shift) & LEVEL_MASK);
+  }
+
+  /// Moves the timers of the upper levels down, for every level whose lower level completes a turn in the tic now.
+  void cascade_(tic_t now)
+  {
+    size_t shift = WHEEL_SHIFT;
+    for (size_t level = 1; level < NOF_LEVELS and (now & ((static_cast<tic_t>(1U) << shift) - 1U)) == 0;
+         ++level, shift += LEVEL_SHIFT) {
+      auto& level_list = time_wheel[WHEEL_SIZE + (level - 1) * LEVEL_SIZE + ((now >> shift) & LEVEL_MASK)];
+      while (not level_list.empty()) {
+        timer_impl& timer = level_list.front();
+        level_list.pop_front();
+        timer.wheel_pos = get_wheel_pos_(decode_timeout(timer.state.load(std::memory_order_relaxed)), now);
+        time_wheel[timer.wheel_pos].push_front(&timer);
+      }
+    }
+  }
+
   std::atomic<tic_t> cur_time{0};
+  tic_t              wheel_time          = 0; ///< tic of the last step of the wheel, protected by mutex
   size_t             nof_timers_running_ = 0, nof_free_timers = 0;
   // using a deque to maintain reference validity on emplace_back. Also, this deque will only grow.
   std::deque<timer_impl>                                         timer_list;
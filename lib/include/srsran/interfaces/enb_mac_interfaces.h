@@ -20,7 +20,9 @@
  */
 
 #include "srsenb/hdr/stack/mac/sched_interface.h"
+#include "srsran/adt/span.h"
 #include "srsran/interfaces/rrc_interface_types.h"
+#include <cmath>
 
 #ifndef SRSRAN_ENB_MAC_INTERFACES_H
 #define SRSRAN_ENB_MAC_INTERFACES_H
@@ -35,6 +37,8 @@ struct mac_args_t {
   uint32_t                      nof_prealloc_ues; ///< Number of UE resources to pre-allocate at eNB startup
   uint32_t                      max_nof_kos;
   int                           rlf_min_ul_snr_estim;
+  uint32_t nof_ul_pdu_workers; ///< Number of threads processing the UL MAC PDUs, sharded by UE (0 for the stack thread)
+  bool     softbuffers_on_demand; ///< Allocate the soft-buffer code blocks as the scheduled TBS requires them
 };
 
 /* Interface PHY -> MAC */
@@ -169,6 +173,29 @@ public:
    */
   virtual int ta_info(uint32_t tti, uint16_t rnti, float ta_us) = 0;
 
+  /**
+   * Measurements of a UE in a TTI. The fields that were not measured are left to their default value
+   */
+  struct ue_meas_t {
+    uint16_t     rnti   = SRSRAN_INVALID_RNTI;
+    uint32_t     cc_idx = 0;     ///< eNb Cell/Carrier of the measurement
+    ul_channel_t ch     = PUSCH; ///< UL channel where the SNR was measured
+    float        snr_db = NAN;   ///< UL SNR in dB
+    float        ta_us  = NAN;   ///< Time alignment in microseconds
+    int32_t      cqi    = -1;    ///< Wideband Channel Quality Information
+  };
+
+  /**
+   * PHY callback for giving MAC the SNR, TA and wideband CQI measurements of all the UEs processed in a TTI at once.
+   * It is equivalent to calling snr_info(), ta_info() and cqi_info() for each measurement, but the UE database is only
+   * accessed once for the whole batch
+   *
+   * @param tti The measurements were made
+   * @param meas The measurements of the TTI, in the order they were taken
+   * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR* if an error occurs
+   */
+  virtual int meas_info(uint32_t tti, srsran::const_span<ue_meas_t> meas) = 0;
+
   /**
    * PHY callback for giving MAC the HARQ DL ACK/NACK feedback information for a given RNTI, TTI, eNb cell/carrier and
    * Transport block.
@@ -29,7 +29,10 @@
 #include "srsenb/hdr/stack/mac/common/mac_metrics.h"
 #include "srsenb/hdr/stack/rrc/rrc_metrics.h"
 #include "srsenb/hdr/stack/s1ap/s1ap_metrics.h"
+#include "srsenb/hdr/stack/upper/gtpu_metrics.h"
+#include "srsenb/hdr/stack/upper/traffic_gen_metrics.h"
 #include "srsran/common/metrics_hub.h"
+#include "srsran/phy/utils/stage_prof.h"
 #include "srsran/radio/radio_metrics.h"
 #include "srsran/rlc/rlc_metrics.h"
 #include "srsran/system/sys_metrics.h"
@@ -52,15 +55,40 @@ struct stack_metrics_t {
   rlc_metrics_t  rlc;
   pdcp_metrics_t pdcp;
   s1ap_metrics_t s1ap;
+  gtpu_metrics_t gtpu;
+
+  traffic_gen_metrics_t traffic_gen;
+};
+
+/// Memory held by a UE in each subsystem, in bytes
+struct mem_ue_metrics_t {
+  uint16_t rnti;
+  uint64_t softbuffer_bytes;
+  uint64_t rlc_bytes;
+  uint64_t rrc_bytes;
+};
+
+/// Memory held by each subsystem, in bytes
+struct mem_metrics_t {
+  uint64_t                      phy_bytes;
+  uint64_t                      softbuffer_bytes;
+  uint64_t                      byte_buffer_pool_bytes;
+  uint64_t                      rlc_bytes;
+  uint64_t                      rrc_bytes;
+  std::vector<uint64_t>         cell_phy_bytes; ///< PHY worker buffers of each cell
+  std::vector<mem_ue_metrics_t> ues;
 };
 
 struct enb_metrics_t {
-  srsran::rf_metrics_t       rf;
-  std::vector<phy_metrics_t> phy;
-  stack_metrics_t            stack;
-  stack_metrics_t            nr_stack;
-  srsran::sys_metrics_t      sys;
-  bool                       running;
+  srsran::rf_metrics_t        rf;
+  std::vector<phy_metrics_t>  phy;
+  tti_deadline_metrics_t      phy_deadline;
+  srsran_stage_prof_metrics_t phy_stages[SRSRAN_STAGE_PROF_NOF];
+  stack_metrics_t             stack;
+  stack_metrics_t             nr_stack;
+  srsran::sys_metrics_t       sys;
+  mem_metrics_t               mem;
+  bool                        running;
 };
 
 // ENB interface
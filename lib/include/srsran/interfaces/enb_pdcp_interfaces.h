@@ -19,6 +19,7 @@
  *
  */
 
+#include "srsran/adt/span.h"
 #include "srsran/common/byte_buffer.h"
 #include "srsran/interfaces/pdcp_interface_types.h"
 #include <map>
@@ -33,7 +34,15 @@ class pdcp_interface_gtpu
 {
 public:
   virtual void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn = -1) = 0;
-  virtual std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) = 0;
+  virtual srsran::pdcp_sdu_list_t get_buffered_pdus(uint16_t rnti, uint32_t lcid) = 0;
+
+  /* Writes a burst of SDUs of the same bearer, with the SNs assigned by PDCP. The SDUs are moved out of the span. */
+  virtual void write_sdus(uint16_t rnti, uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus)
+  {
+    for (srsran::unique_byte_buffer_t& sdu : sdus) {
+      write_sdu(rnti, lcid, std::move(sdu));
+    }
+  }
 };
 
 // PDCP interface for RRC
@@ -65,6 +74,14 @@ public:
   virtual void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu)               = 0;
   virtual void notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns) = 0;
   virtual void notify_failure(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)  = 0;
+
+  /* RLC calls PDCP to push a burst of PDCP PDUs of the same bearer. The PDUs are moved out of the span. */
+  virtual void write_pdus(uint16_t rnti, uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> pdus)
+  {
+    for (srsran::unique_byte_buffer_t& pdu : pdus) {
+      write_pdu(rnti, lcid, std::move(pdu));
+    }
+  }
 };
 
 } // namespace srsenb
@@ -22,6 +22,7 @@
 #ifndef SRSRAN_ENB_RLC_INTERFACES_H
 #define SRSRAN_ENB_RLC_INTERFACES_H
 
+#include "srsran/adt/span.h"
 #include "srsran/common/byte_buffer.h"
 #include "srsran/interfaces/rlc_interface_types.h"
 
@@ -51,6 +52,14 @@ public:
   virtual bool rb_is_um(uint16_t rnti, uint32_t lcid)                                    = 0;
   virtual bool sdu_queue_is_full(uint16_t rnti, uint32_t lcid)                           = 0;
   virtual bool is_suspended(uint16_t rnti, uint32_t lcid)                                = 0;
+
+  /* PDCP calls RLC to push a burst of RLC SDUs of the same bearer. The SDUs are moved out of the span. */
+  virtual void write_sdus(uint16_t rnti, uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus)
+  {
+    for (srsran::unique_byte_buffer_t& sdu : sdus) {
+      write_sdu(rnti, lcid, std::move(sdu));
+    }
+  }
 };
 
 // RLC interface for RRC
@@ -47,6 +47,7 @@ struct s1ap_args_t {
   int32_t     sctp_rto_max;
   int32_t     sctp_init_max_attempts;
   int32_t     sctp_max_init_timeo;
+  int32_t     sctp_nof_streams;
 };
 
 // S1AP interface for RRC
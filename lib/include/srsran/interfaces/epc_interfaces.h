@@ -22,10 +22,10 @@
 #ifndef SRSRAN_EPC_INTERFACES_H
 #define SRSRAN_EPC_INTERFACES_H
 
+#include "srsran/adt/circular_buffer.h"
 #include "srsran/asn1/gtpc_ies.h"
 #include "srsran/common/common.h"
 #include <netinet/sctp.h>
-#include <queue>
 
 namespace srsepc {
 
@@ -116,8 +116,8 @@ public:
   virtual bool modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtpc_f_teid_ie dw_user_fteid, uint32_t up_ctrl_teid) = 0;
   virtual bool delete_gtpu_tunnel(in_addr_t ue_ipv4)                                                              = 0;
   virtual bool delete_gtpc_tunnel(in_addr_t ue_ipv4)                                                              = 0;
-  virtual void send_all_queued_packets(srsran::gtp_fteid_t                       dw_user_fteid,
-                                       std::queue<srsran::unique_byte_buffer_t>& pkt_queue)                       = 0;
+  virtual void send_all_queued_packets(srsran::gtp_fteid_t                                        dw_user_fteid,
+                                       srsran::dyn_circular_buffer<srsran::unique_byte_buffer_t>& pkt_queue)      = 0;
 };
 
 class gtpc_interface_gtpu // GTP-U -> GTP-C
@@ -24,6 +24,7 @@
 
 #include "srsran/srsran.h"
 
+#include "srsran/adt/span.h"
 #include "srsran/common/interfaces_common.h"
 #include "srsran/common/security.h"
 #include "srsran/interfaces/pdcp_interface_types.h"
@@ -100,6 +101,14 @@ class pdcp_interface_sdap_nr
 {
 public:
   virtual void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) = 0;
+
+  /* Writes a burst of SDUs of the same bearer. The SDUs are moved out of the span. */
+  virtual void write_sdus(uint16_t rnti, uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus)
+  {
+    for (srsran::unique_byte_buffer_t& sdu : sdus) {
+      write_sdu(rnti, lcid, std::move(sdu));
+    }
+  }
 };
 
 /*****************************
@@ -114,6 +123,14 @@ class sdap_interface_gtpu_nr
 {
 public:
   virtual void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) = 0;
+
+  /* Writes a burst of SDUs of the same bearer. The SDUs are moved out of the span. */
+  virtual void write_sdus(uint16_t rnti, uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus)
+  {
+    for (srsran::unique_byte_buffer_t& sdu : sdus) {
+      write_sdu(rnti, lcid, std::move(sdu));
+    }
+  }
 };
 
 /*****************************
@@ -178,11 +195,12 @@ public:
    * @brief Describes physical layer configuration common among all the UEs for a given cell
    */
   struct common_cfg_t {
-    srsran_carrier_nr_t   carrier;
-    srsran_pdcch_cfg_nr_t pdcch;
-    srsran_prach_cfg_t    prach;
-    srsran_ssb_cfg_t      ssb;
-    srsran_duplex_mode_t  duplex_mode;
+    srsran_carrier_nr_t       carrier;
+    srsran_pdcch_cfg_nr_t     pdcch;
+    srsran_prach_cfg_t        prach;
+    srsran_ssb_cfg_t          ssb;
+    srsran_duplex_mode_t      duplex_mode;
+    srsran_duplex_config_nr_t duplex; ///< Slot pattern, the workers skip the chain stages a slot can not carry
   };
 
   virtual int set_common_cfg(const common_cfg_t& common_cfg) = 0;
@@ -37,6 +37,7 @@ struct ngap_args_t {
   std::string gtp_advertise_addr = "";
   std::string ngc_bind_addr      = "";
   std::string gnb_name           = "";
+  int32_t     sctp_nof_streams   = 16;
 };
 
 // NGAP interface for RRC
@@ -28,9 +28,11 @@
 #define SRSRAN_PDCP_INTERFACE_TYPES_H
 
 #include "srsran/adt/bounded_vector.h"
+#include "srsran/common/byte_buffer.h"
 #include "srsran/common/security.h"
 #include <math.h>
 #include <stdint.h>
+#include <vector>
 
 namespace srsran {
 
@@ -193,6 +195,10 @@ struct pdcp_lte_state_t {
   uint32_t reordering_pdcp_rx_count;
 };
 
+// PDCP SDUs that have not been acknowledged yet, with their PDCP SN, in transmission order. Used to forward them
+// during handover
+using pdcp_sdu_list_t = std::vector<std::pair<uint32_t, unique_byte_buffer_t> >;
+
 // Custom type for interface between PDCP and RLC to convey SDU delivery status
 // Arbitrarily chosen limit, optimal value depends on the RLC (pollPDU) and PDCP config, channel BLER,
 // traffic characterisitcs, etc. The chosen value has been tested with 100 PRB bi-dir TCP
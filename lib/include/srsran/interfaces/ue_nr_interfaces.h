@@ -220,6 +220,7 @@ struct phy_args_nr_t {
   uint32_t               worker_cpu_mask       = 0;
   int                    slot_recv_thread_prio = 0; /// Specifies the slot receive thread priority, RT by default
   int                    workers_thread_prio   = 2; /// Specifies the workers thread priority, RT by default
+  uint32_t               slot_rx_queue_size    = 0; ///< Slots queued between reception and workers, 0 disables it
   srsran::phy_log_args_t log                   = {};
   srsran_ue_dl_nr_args_t dl                    = {};
   srsran_ue_ul_nr_args_t ul                    = {};
@@ -23,6 +23,7 @@
 #define SRSRAN_UE_PDCP_INTERFACES_H
 
 #include "pdcp_interface_types.h"
+#include "srsran/adt/span.h"
 #include "srsran/common/byte_buffer.h"
 
 namespace srsue {
@@ -58,6 +59,14 @@ public:
   virtual void write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t sdu)          = 0;
   virtual void notify_delivery(uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sn) = 0;
   virtual void notify_failure(uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sn)  = 0;
+
+  /* RLC calls PDCP to push a burst of PDCP PDUs of the same bearer. The PDUs are moved out of the span. */
+  virtual void write_pdus(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> pdus)
+  {
+    for (srsran::unique_byte_buffer_t& pdu : pdus) {
+      write_pdu(lcid, std::move(pdu));
+    }
+  }
 };
 
 // Data-plane interface for Stack after EPS bearer to LCID conversion
@@ -73,6 +82,14 @@ class pdcp_interface_sdap_nr
 {
 public:
   virtual void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu) = 0;
+
+  /* Writes a burst of SDUs of the same bearer. The SDUs are moved out of the span. */
+  virtual void write_sdus(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus)
+  {
+    for (srsran::unique_byte_buffer_t& sdu : sdus) {
+      write_sdu(lcid, std::move(sdu));
+    }
+  }
 };
 
 // STACK interface for GW (based on EPS-bearer IDs)
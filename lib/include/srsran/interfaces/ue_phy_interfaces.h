@@ -56,6 +56,8 @@ struct phy_args_t {
   int force_N_id_2 = -1; // Cell identity within the identity group (PSS) to filter.
   int force_N_id_1 = -1; // Cell identity group (SSS) to filter.
 
+  std::string cell_cache_file = ""; // File with the cells camped on before, probed first by the cell search
+
   float dl_freq = -1.0f;
   float ul_freq = -1.0f;
 
@@ -64,6 +66,7 @@ struct phy_args_t {
   uint32_t pdsch_max_its   = 8;
   bool     meas_evm        = false;
   uint32_t nof_phy_threads = 3;
+  bool     parallel_cc     = false; ///< Processes the DL of the SCells in parallel to the PCell
 
   int worker_cpu_mask   = -1;
   int sync_cpu_affinity = -1;
@@ -89,13 +92,16 @@ struct phy_args_t {
   float       cfo_loop_pss_tol             = DEFAULT_CFO_PSS_MIN;
   float       sfo_ema                      = DEFAULT_SFO_EMA_COEFF;
   uint32_t    sfo_correct_period           = DEFAULT_SAMPLE_OFFSET_CORRECT_PERIOD;
+  uint32_t    pss_track_period             = 0;
   uint32_t    cfo_loop_pss_conv            = DEFAULT_PSS_STABLE_TIMEOUT;
   uint32_t    cfo_ref_mask                 = 1023;
   bool        interpolate_subframe_enabled = false;
   bool        estimator_fil_auto           = false;
   float       estimator_fil_stddev         = 1.0f;
   uint32_t    estimator_fil_order          = 4;
+  uint32_t    estimator_sf_avg             = 0;
   float       snr_to_cqi_offset            = 0.0f;
+  uint32_t    pmi_decimation               = 0;
   std::string sss_algorithm                = "full";
   float       rx_gain_offset               = 62;
   bool        pdsch_csi_enabled            = true;
@@ -105,7 +111,8 @@ struct phy_args_t {
   float       force_ul_amplitude           = 0.0f;
   bool        detect_cp                    = false;
 
-  bool nr_store_pdsch_ko = false;
+  bool     nr_store_pdsch_ko = false;
+  uint32_t nr_rx_queue_size  = 0;
 
   float    in_sync_rsrp_dbm_th    = -130.0f;
   float    in_sync_snr_db_th      = 1.0f;
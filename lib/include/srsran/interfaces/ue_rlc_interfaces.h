@@ -22,6 +22,7 @@
 #ifndef SRSRAN_UE_RLC_INTERFACES_H
 #define SRSRAN_UE_RLC_INTERFACES_H
 
+#include "srsran/adt/span.h"
 #include "srsran/common/interfaces_common.h"
 #include "srsran/interfaces/rlc_interface_types.h"
 
@@ -52,6 +53,14 @@ public:
   ///< MAC pulls RLC PDUs according to TB size
   virtual void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu) = 0;
 
+  ///< PDCP calls RLC to push a burst of RLC SDUs of the same bearer. The SDUs are moved out of the span
+  virtual void write_sdus(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus)
+  {
+    for (srsran::unique_byte_buffer_t& sdu : sdus) {
+      write_sdu(lcid, std::move(sdu));
+    }
+  }
+
   ///< Indicate RLC that a certain SN can be discarded
   virtual void discard_sdu(uint32_t lcid, uint32_t discard_sn) = 0;
 
@@ -83,6 +92,13 @@ public:
   /* MAC calls RLC to push an RLC PDU. This function is called from an independent MAC thread.
    * PDU gets placed into the buffer and higher layer thread gets notified. */
   virtual void write_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)     = 0;
+
+  /* Same as write_pdu(), but safe to call from other threads than the stack thread, e.g. the PHY workers. It must only
+   * be used for the data bearers, as the bearers can not be reconfigured while the PDU goes up the stack. */
+  virtual void write_pdu_locked(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
+  {
+    write_pdu(lcid, payload, nof_bytes);
+  }
   virtual void write_pdu_bcch_bch(srsran::unique_byte_buffer_t payload)           = 0;
   virtual void write_pdu_bcch_dlsch(uint8_t* payload, uint32_t nof_bytes)         = 0;
   virtual void write_pdu_pcch(srsran::unique_byte_buffer_t payload)               = 0;
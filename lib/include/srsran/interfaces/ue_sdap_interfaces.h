@@ -27,6 +27,9 @@
 #ifndef SRSRAN_UE_SDAP_INTERFACES_H
 #define SRSRAN_UE_SDAP_INTERFACES_H
 
+#include "srsran/adt/span.h"
+#include "srsran/common/byte_buffer.h"
+
 /*****************************
  *      SDAP INTERFACES
  ****************************/
@@ -34,11 +37,27 @@ class sdap_interface_pdcp_nr
 {
 public:
   virtual void write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu) = 0;
+
+  /* PDCP calls SDAP to push a burst of SDAP PDUs of the same bearer. The PDUs are moved out of the span. */
+  virtual void write_pdus(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> pdus)
+  {
+    for (srsran::unique_byte_buffer_t& pdu : pdus) {
+      write_pdu(lcid, std::move(pdu));
+    }
+  }
 };
 class sdap_interface_gw_nr
 {
 public:
   virtual void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu) = 0;
+
+  /* Writes a burst of SDUs of the same bearer. The SDUs are moved out of the span. */
+  virtual void write_sdus(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus)
+  {
+    for (srsran::unique_byte_buffer_t& sdu : sdus) {
+      write_sdu(lcid, std::move(sdu));
+    }
+  }
 };
 
 class sdap_interface_rrc
@@ -24,6 +24,7 @@
 
 #include "srsran/common/byte_buffer.h"
 #include "srsran/common/common.h"
+#include "srsran/common/interfaces_common.h"
 #include "srsran/config.h"
 #include "srsran/srslog/srslog.h"
 #include <memory>
@@ -110,7 +111,7 @@ public:
   uint64_t                                       get_ue_con_res_id_ce_packed();
 
   // setters
-  void set_sdu(const uint32_t lcid_, const uint8_t* payload_, const uint32_t len_);
+  void set_sdu(const uint32_t lcid_, const uint8_t* payload_, const uint32_t len_, bool long_len_field = false);
   void set_padding(const uint32_t len_);
   void set_c_rnti(const uint16_t crnti_);
   void set_se_phr(const uint8_t phr_, const uint8_t pcmax_);
@@ -118,6 +119,7 @@ public:
   void set_lbsr(const std::array<mac_sch_subpdu_nr::lcg_bsr_t, max_num_lcg_lbsr> bsr_);
   void set_ue_con_res_id_ce(const ue_con_res_id_t id);
 
+  uint32_t write_subheader(uint8_t* start_);
   uint32_t write_subpdu(const uint8_t* start_);
 
   // Used by BSR procedure to determine size of BSR types
@@ -221,6 +223,11 @@ public:
   uint32_t add_lbsr_ce(const std::array<mac_sch_subpdu_nr::lcg_bsr_t, mac_sch_subpdu_nr::max_num_lcg_lbsr> bsr_);
   uint32_t add_ue_con_res_id_ce(const mac_sch_subpdu_nr::ue_con_res_id_t id);
 
+  /// Lets sdu_itf_ write up to requested_bytes_ of SDU (or the space left) straight into the PDU, after a subheader
+  /// whose L field is filled in once the SDU size is known. Returns the SDU size, 0 if there was nothing to send, or
+  /// SRSRAN_ERROR
+  int add_sdu(const uint32_t lcid_, const uint32_t requested_bytes_, read_pdu_interface* sdu_itf_);
+
   uint32_t get_remaing_len();
 
   void to_string(fmt::memory_buffer& buffer);
@@ -28,6 +28,11 @@
 
 #define CFR_EMA_INIT_AVG_PWR 0.1
 
+/**
+ * @brief Maximum number of OFDM symbols processed in one srsran_cfr_process_batch() call, one subframe
+ */
+#define SRSRAN_CFR_MAX_BATCH (SRSRAN_NOF_SLOTS_PER_SF * SRSRAN_CP_NORM_NSYMB)
+
 /**
  * @brief CFR manual threshold or PAPR limiting with CMA or EMA power averaging
  */
@@ -39,6 +44,15 @@ typedef enum SRSRAN_API {
   SRSRAN_CFR_NOF_MODES
 } srsran_cfr_mode_t;
 
+/**
+ * @brief CFR peak filtering method
+ */
+typedef enum SRSRAN_API {
+  SRSRAN_CFR_FILTER_FFT,    ///< Clipping followed by an FFT low-pass filter round-trip
+  SRSRAN_CFR_FILTER_WINDOW, ///< Time-domain peak windowing, no FFT
+  SRSRAN_CFR_NOF_FILTERS
+} srsran_cfr_filter_t;
+
 /**
  * @brief CFR module configuration arguments
  */
@@ -51,6 +65,10 @@ typedef struct SRSRAN_API {
   float    alpha;     ///< Alpha parameter of the clipping algorithm
   bool     dc_sc;     ///< Take into account the DC subcarrier for the filter BW
 
+  // Peak filtering
+  srsran_cfr_filter_t filter;     ///< Peak filtering method, FFT by default
+  uint32_t            window_len; ///< Odd peak window length in samples for SRSRAN_CFR_FILTER_WINDOW, 0 for auto
+
   // SRSRAN_CFR_THR_MANUAL mode parameters
   float manual_thr; ///< Fixed threshold used in SRSRAN_CFR_THR_MANUAL mode
 
@@ -69,9 +87,12 @@ typedef struct SRSRAN_API {
   float*            lpf_spectrum; ///< FFT filter spectrum
   uint32_t          lpf_bw;       ///< Bandwidth of the LPF
 
-  float* abs_buffer_in;  ///< Store the input absolute value
-  float* abs_buffer_out; ///< Store the output absolute value
-  cf_t*  peak_buffer;
+  float*   abs_buffer_in;  ///< Store the input absolute value of up to SRSRAN_CFR_MAX_BATCH symbols
+  float*   abs_buffer_out; ///< Store the output absolute value
+  cf_t*    peak_buffer;
+  float*   env_buffer; ///< Gain envelope of the peak windowing
+  float*   window;     ///< Peak window, the maximum is in the centre
+  uint32_t window_len; ///< Length of the peak window
 
   float pwr_avg_in;  ///< store the avg. input power with MA or EMA averaging
   float pwr_avg_out; ///< store the avg. output power with MA or EMA averaging
@@ -94,6 +115,20 @@ SRSRAN_API int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg);
  */
 SRSRAN_API void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out);
 
+/**
+ * @brief Applies the CFR algorithm to a batch of time domain OFDM symbols, typically all the symbols of a subframe
+ *
+ * The thresholds of all the symbols are computed first, in order, so the power averages evolve as with one
+ * srsran_cfr_process() call per symbol. Then only the symbols with peaks above their threshold are clipped and
+ * filtered, the rest are copied.
+ *
+ * @param[in]  q           The CFR object and configuration
+ * @param[in]  in          Pointers to the time domain OFDM symbols without CP
+ * @param[out] out         Pointers to the processed OFDM symbols, they can be the same as the input ones
+ * @param[in]  nof_symbols Number of symbols, larger batches than SRSRAN_CFR_MAX_BATCH are split
+ */
+SRSRAN_API void srsran_cfr_process_batch(srsran_cfr_t* q, cf_t* const* in, cf_t* const* out, uint32_t nof_symbols);
+
 SRSRAN_API void srsran_cfr_free(srsran_cfr_t* q);
 
 /**
@@ -136,4 +171,13 @@ SRSRAN_API int srsran_cfr_set_papr(srsran_cfr_t* q, float papr);
  */
 SRSRAN_API srsran_cfr_mode_t srsran_cfr_str2mode(const char* mode_str);
 
+/**
+ * @brief Converts a string representing a CFR filter from the config files into srsran_cfr_filter_t type
+ *
+ * @param[in]  filter_str   the cfr.filter string coming from the config file
+ * @return SRSRAN_CFR_FILTER_FFT if filter_str is empty or "fft", SRSRAN_CFR_FILTER_WINDOW if it is "window",
+ * otherwise SRSRAN_CFR_NOF_FILTERS.
+ */
+SRSRAN_API srsran_cfr_filter_t srsran_cfr_str2filter(const char* filter_str);
+
 #endif // SRSRAN_CFR_H
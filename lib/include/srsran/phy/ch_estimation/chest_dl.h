@@ -81,6 +81,18 @@ typedef enum SRSRAN_API {
   SRSRAN_ESTIMATOR_ALG_WIENER,
 } srsran_chest_dl_estimator_alg_t;
 
+// Ring of the last pilot estimates of one port and receive antenna, with their running sum
+typedef struct SRSRAN_API {
+  cf_t*    buffer;     // len subframes of nof_pilots estimates each, the oldest at idx once full
+  cf_t*    sum;        // Running sum of the stored subframes
+  uint32_t max_len;    // Allocated number of subframes
+  uint32_t max_pilots; // Allocated number of pilots per subframe
+  uint32_t nof_pilots; // Pilots per subframe
+  uint32_t len;        // Number of subframes averaged
+  uint32_t count;      // Number of subframes stored
+  uint32_t idx;        // Next subframe to write
+} srsran_chest_dl_pilot_ring_t;
+
 typedef struct SRSRAN_API {
   srsran_cell_t cell;
   uint32_t      nof_rx_antennas;
@@ -90,6 +102,8 @@ typedef struct SRSRAN_API {
 
   srsran_wiener_dl_t* wiener_dl;
 
+  srsran_chest_dl_pilot_ring_t pilot_ring[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS]; // Indexed by receive antenna and port
+
   cf_t* pilot_estimates;
   cf_t* pilot_estimates_average;
   cf_t* pilot_recv_signal;
@@ -132,6 +146,7 @@ typedef struct SRSRAN_API {
   bool     cfo_estimate_enable;
   uint32_t cfo_estimate_sf_mask;
   bool     sync_error_enable;
+  uint32_t pilot_avg_len; // Subframes the pilot estimates are averaged over before interpolation (0 or 1 disables)
 
 } srsran_chest_dl_cfg_t;
 
@@ -167,6 +182,16 @@ SRSRAN_API int srsran_chest_dl_estimate_cfg(srsran_chest_dl_t*     q,
                                             cf_t*                  input[SRSRAN_MAX_PORTS],
                                             srsran_chest_dl_res_t* res);
 
+/**
+ * Returns the estimator algorithm best suited to the SIMD width this library was built for: Wiener when the vector
+ * units are wide enough to run its matrix products in real time, linear interpolation otherwise.
+ */
+SRSRAN_API srsran_chest_dl_estimator_alg_t srsran_chest_dl_default_estimator_alg(void);
+
+/**
+ * Converts an estimator name (average, interpolate, wiener or auto) to its algorithm. "auto" selects
+ * srsran_chest_dl_default_estimator_alg(), any other name defaults to average.
+ */
 SRSRAN_API srsran_chest_dl_estimator_alg_t srsran_chest_dl_str2estimator_alg(const char* str);
 
 #endif // SRSRAN_CHEST_DL_H
@@ -41,6 +41,7 @@
 #include "srsran/phy/ch_estimation/chest_common.h"
 #include "srsran/phy/ch_estimation/refsignal_ul.h"
 #include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/dft/dft.h"
 #include "srsran/phy/phch/pucch_cfg.h"
 #include "srsran/phy/phch/pusch_cfg.h"
 #include "srsran/phy/resampling/interp.h"
@@ -60,6 +61,9 @@ typedef struct SRSRAN_API {
   float    ta_us;
 } srsran_chest_ul_res_t;
 
+/* Number of SRS bandwidths (B) a UE can be configured with */
+#define SRSRAN_CHEST_UL_SRS_NOF_B 4
+
 typedef struct {
   srsran_cell_t cell;
 
@@ -70,6 +74,19 @@ typedef struct {
   srsran_refsignal_srs_pregen_t srs_pregen;
   bool                          srs_signal_configured;
 
+  // Multi-UE SRS estimation. The base sequences (no cyclic shift) are shared by all the UEs with the same SRS bandwidth
+  // and are kept per subframe, the DFT plans are only replanned if the SRS bandwidth of the cell changes.
+  uint32_t                          max_srs_re;
+  cf_t*                             srs_base[SRSRAN_CHEST_UL_SRS_NOF_B][SRSRAN_NOF_SF_X_FRAME];
+  uint32_t                          srs_base_M_sc[SRSRAN_CHEST_UL_SRS_NOF_B][SRSRAN_NOF_SF_X_FRAME];
+  srsran_refsignal_dmrs_pusch_cfg_t srs_base_pusch_cfg;
+  srsran_dft_plan_t                 srs_idft[SRSRAN_CHEST_UL_SRS_NOF_B];
+  srsran_dft_plan_t                 srs_dft[SRSRAN_CHEST_UL_SRS_NOF_B];
+  cf_t*                             srs_despread;
+  cf_t*                             srs_cir;
+  cf_t*                             srs_window;
+  cf_t*                             srs_residual;
+
   cf_t* pilot_estimates;
   cf_t* pilot_estimates_tmp[4];
   cf_t* pilot_recv_signal;
@@ -122,4 +139,15 @@ SRSRAN_API int srsran_chest_ul_estimate_srs(srsran_chest_ul_t*                 q
                                             cf_t*                              input,
                                             srsran_chest_ul_res_t*             res);
 
+/* Estimates the SRS of several UEs received in the same subframe. The UEs sharing the SRS comb and bandwidth are
+ * extracted and despread once, and separated by their cyclic shift in the time domain. res[i] holds the estimate of
+ * the UE configured by cfg[i]. */
+SRSRAN_API int srsran_chest_ul_estimate_srs_multi(srsran_chest_ul_t*                 q,
+                                                  srsran_ul_sf_cfg_t*                sf,
+                                                  srsran_refsignal_srs_cfg_t*        cfg[],
+                                                  srsran_refsignal_dmrs_pusch_cfg_t* pusch_cfg,
+                                                  cf_t*                              input,
+                                                  srsran_chest_ul_res_t*             res[],
+                                                  uint32_t                           nof_ue);
+
 #endif // SRSRAN_CHEST_UL_H
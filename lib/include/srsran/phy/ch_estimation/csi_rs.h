@@ -169,6 +169,32 @@ SRSRAN_API int srsran_csi_rs_nzp_measure_channel(const srsran_carrier_nr_t*
                                                  const cf_t*                        grid,
                                                  srsran_csi_channel_measurements_t* measure);
 
+/**
+ * @brief Performs channel measurements of every active NZP-CSI-RS resource of a set, for instance for beam management
+ *
+ * @note It performs the following wideband measurements for each resource:
+ * - RSRP (dB),
+ * - EPRE (dB),
+ * - SNR (dB)
+ *
+ * @note The resources are measured in a single batch, the symbols sharing the pseudo-random sequence generate it once.
+ * The CQI is given by the CSI report quantification, as it depends on the configured CQI table
+ *
+ * @param carrier Provides carrier configuration
+ * @param slot_cfg Provides current slot
+ * @param set Provides NZP-CSI-RS resource set
+ * @param grid Resource grid
+ * @param measurements Provides a CSI measurement per active resource, in the set order
+ * @return The number of NZP-CSI-RS resources scheduled for this slot if the configuration is right, SRSRAN_ERROR code
+ * if the configuration is invalid
+ */
+SRSRAN_API int
+srsran_csi_rs_nzp_measure_resources(const srsran_carrier_nr_t*        carrier,
+                                    const srsran_slot_cfg_t*          slot_cfg,
+                                    const srsran_csi_rs_nzp_set_t*    set,
+                                    const cf_t*                       grid,
+                                    srsran_csi_channel_measurements_t measurements[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET]);
+
 /**
  * @brief Performs measurements of ZP-CSI-RS resource set for CSI reports
  *
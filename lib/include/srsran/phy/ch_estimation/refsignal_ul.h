@@ -40,6 +40,9 @@
 #define SRSRAN_NOF_DELTA_SS 30
 #define SRSRAN_NOF_CSHIFT 8
 
+#define SRSRAN_REFSIGNAL_PUCCH_MAX_N_RS 3
+#define SRSRAN_REFSIGNAL_PUCCH_CACHE_WAYS 4
+
 #define SRSRAN_REFSIGNAL_UL_L(ns_idx, cp) ((ns_idx + 1) * SRSRAN_CP_NSYMB(cp) - 4)
 
 /* PUSCH DMRS common configuration (received in SIB2) */
@@ -90,6 +93,27 @@ typedef struct {
   cf_t* r[SRSRAN_NOF_SF_X_FRAME];
 } srsran_refsignal_srs_pregen_t;
 
+/* PUCCH DMRS of a subframe, together with the PUCCH configuration it was generated for */
+typedef struct {
+  bool                  valid;
+  srsran_pucch_format_t format;
+  uint32_t              n_pucch;
+  uint32_t              N_cs;
+  uint32_t              delta_pucch_shift;
+  uint32_t              n_rb_2;
+  bool                  group_hopping_en;
+  uint8_t               drs_bits[2];
+  cf_t                  r[SRSRAN_NOF_SLOTS_PER_SF * SRSRAN_REFSIGNAL_PUCCH_MAX_N_RS * SRSRAN_NRE];
+} srsran_refsignal_dmrs_pucch_cache_entry_t;
+
+/* The PUCCH DMRS only change with the resource and the subframe index, so a few of them are kept per subframe */
+typedef struct {
+  srsran_refsignal_dmrs_pucch_cache_entry_t entry[SRSRAN_NOF_SF_X_FRAME][SRSRAN_REFSIGNAL_PUCCH_CACHE_WAYS];
+  uint32_t                                  next_way[SRSRAN_NOF_SF_X_FRAME];
+  uint64_t                                  nof_hits;
+  uint64_t                                  nof_misses;
+} srsran_refsignal_dmrs_pucch_cache_t;
+
 SRSRAN_API int srsran_refsignal_ul_set_cell(srsran_refsignal_ul_t* q, srsran_cell_t cell);
 
 SRSRAN_API uint32_t srsran_refsignal_dmrs_N_rs(srsran_pucch_format_t format, srsran_cp_t cp);
@@ -133,6 +157,14 @@ SRSRAN_API int srsran_refsignal_dmrs_pucch_gen(srsran_refsignal_ul_t* q,
                                                srsran_pucch_cfg_t*    cfg,
                                                cf_t*                  r_pucch);
 
+SRSRAN_API void srsran_refsignal_dmrs_pucch_cache_reset(srsran_refsignal_dmrs_pucch_cache_t* cache);
+
+/* Returns the PUCCH DMRS of the subframe from the cache, generating them on a miss. Returns NULL on error. */
+SRSRAN_API cf_t* srsran_refsignal_dmrs_pucch_cache_get(srsran_refsignal_ul_t*               q,
+                                                       srsran_refsignal_dmrs_pucch_cache_t* cache,
+                                                       srsran_ul_sf_cfg_t*                  sf,
+                                                       srsran_pucch_cfg_t*                  cfg);
+
 SRSRAN_API int
 srsran_refsignal_dmrs_pucch_put(srsran_refsignal_ul_t* q, srsran_pucch_cfg_t* cfg, cf_t* r_pucch, cf_t* output);
 
@@ -190,4 +222,7 @@ SRSRAN_API uint32_t srsran_refsignal_srs_rb_L_cs(uint32_t bw_cfg, uint32_t nof_p
 
 SRSRAN_API uint32_t srsran_refsignal_srs_M_sc(srsran_refsignal_ul_t* q, srsran_refsignal_srs_cfg_t* cfg);
 
+/* Returns the first subcarrier of the SRS of the UE in the given TTI */
+SRSRAN_API uint32_t srsran_refsignal_srs_k0(srsran_refsignal_ul_t* q, srsran_refsignal_srs_cfg_t* cfg, uint32_t tti);
+
 #endif // SRSRAN_REFSIGNAL_UL_H
@@ -37,6 +37,12 @@
 #define SRSRAN_WIENER_DL_TIMEFIFO_SIZE (32U)
 #define SRSRAN_WIENER_DL_CXFIFO_SIZE (400U)
 
+// Wiener matrices cache parameters
+#define SRSRAN_WIENER_DL_SNR_MIN_DB (-10.0f)
+#define SRSRAN_WIENER_DL_SNR_STEP_DB (1.0f)
+#define SRSRAN_WIENER_DL_NOF_SNR_BINS (23U)
+#define SRSRAN_WIENER_DL_CACHE_TOL (1e-3f)
+
 typedef struct {
   cf_t*    hls_fifo_1[SRSRAN_WIENER_DL_HLS_FIFO_SIZE]; // Least square channel estimates on odd pilots
   cf_t*    hls_fifo_2[SRSRAN_WIENER_DL_HLS_FIFO_SIZE]; // Least square channel estimates on even pilots
@@ -53,6 +59,20 @@ typedef struct {
   uint32_t cnt;    // counter for skipping pilot OFDM symbols
 } srsran_wiener_dl_state_t;
 
+/**
+ * Wiener matrices computed for one SNR bin. The matrices are stored transposed, one row per reference signal, so the
+ * estimation is a sum of scaled rows. An entry is reused for as long as the averaged correlation vector stays within
+ * SRSRAN_WIENER_DL_CACHE_TOL (relative squared error) of the one the matrices were computed from.
+ */
+typedef struct {
+  cf_t     acV[SRSRAN_WIENER_DL_MIN_RE]; // Correlation vector the matrices were computed from
+  float    acV_pwr;                      // Squared norm of acV
+  uint32_t shift;                        // Reference signal shift the matrices were computed for
+  bool     valid;
+  cf_t     wm1[SRSRAN_WIENER_DL_MIN_REF][SRSRAN_WIENER_DL_MIN_RE];
+  cf_t     wm2[SRSRAN_WIENER_DL_MIN_REF][SRSRAN_WIENER_DL_MIN_RE];
+} srsran_wiener_dl_cache_t;
+
 typedef struct {
   // Maximum allocated number of...
   uint32_t max_prb;      // Resource Blocks
@@ -71,11 +91,14 @@ typedef struct {
   // One state per possible channel (allocated in init)
   srsran_wiener_dl_state_t* state[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS];
 
-  // Wiener matrices
-  cf_t wm1[SRSRAN_WIENER_DL_MIN_RE][SRSRAN_WIENER_DL_MIN_REF];
-  cf_t wm2[SRSRAN_WIENER_DL_MIN_RE][SRSRAN_WIENER_DL_MIN_REF];
-  bool wm_computed;
-  bool ready;
+  // Wiener matrices, one cache entry per SNR bin plus one for the noiseless case
+  srsran_wiener_dl_cache_t  cache[SRSRAN_WIENER_DL_NOF_SNR_BINS + 1];
+  srsran_wiener_dl_cache_t* wm; // Entry in use
+  float                     snr_bin_lin[SRSRAN_WIENER_DL_NOF_SNR_BINS];
+  uint32_t                  cache_hits;
+  uint32_t                  cache_misses;
+  bool                      wm_computed;
+  bool                      ready;
 
   // Calculation support
   cf_t hlsv[SRSRAN_WIENER_DL_MIN_RE];
@@ -90,8 +113,8 @@ typedef struct {
     cf_t m[SRSRAN_WIENER_DL_MIN_REF][SRSRAN_WIENER_DL_MIN_REF];
     cf_t v[SRSRAN_WIENER_DL_MIN_REF * SRSRAN_WIENER_DL_MIN_REF];
   } invRH;
-  cf_t hH1[SRSRAN_WIENER_DL_MIN_RE][SRSRAN_WIENER_DL_MIN_REF];
-  cf_t hH2[SRSRAN_WIENER_DL_MIN_RE][SRSRAN_WIENER_DL_MIN_REF];
+  cf_t hH1[SRSRAN_WIENER_DL_MIN_REF][SRSRAN_WIENER_DL_MIN_RE]; // Transposed
+  cf_t hH2[SRSRAN_WIENER_DL_MIN_REF][SRSRAN_WIENER_DL_MIN_RE]; // Transposed
 
   // Temporal vector
   cf_t* tmp;
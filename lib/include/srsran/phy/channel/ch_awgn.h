@@ -41,7 +41,7 @@ extern "C" {
 typedef struct {
   float*   table_cos;
   float*   table_log;
-  uint32_t rand_state;
+  uint32_t rand_state[4];
   float    std_dev;
 } srsran_channel_awgn_t;
 
@@ -24,7 +24,7 @@
 
 #include "srsran/config.h"
 #include "srsran/phy/common/timestamp.h"
-#include "srsran/phy/utils/ringbuffer.h"
+#include "srsran/phy/utils/ringbuffer_mirror.h"
 #include <stdint.h>
 
 typedef struct {
@@ -37,8 +37,7 @@ typedef struct {
   float    delay_us;
   uint32_t delay_nsamples;
 
-  srsran_ringbuffer_t rb;
-  cf_t*               zero_buffer;
+  srsran_ringbuffer_mirror_t rb;
 } srsran_channel_delay_t;
 
 #ifdef __cplusplus
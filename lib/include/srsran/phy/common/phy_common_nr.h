@@ -495,6 +495,17 @@ typedef struct SRSRAN_API {
   };
 } srsran_duplex_config_nr_t;
 
+/**
+ * @brief Direction of a slot given by the duplex configuration, it tells the PHY workers which chain stages can carry
+ * any signal in the slot
+ */
+typedef enum SRSRAN_API {
+  SRSRAN_DUPLEX_NR_SLOT_NONE = 0, // Neither DL nor UL symbols, flexible or guard only
+  SRSRAN_DUPLEX_NR_SLOT_DL,       // DL symbols only
+  SRSRAN_DUPLEX_NR_SLOT_UL,       // UL symbols only
+  SRSRAN_DUPLEX_NR_SLOT_DL_UL,    // Both DL and UL symbols, every FDD slot and the TDD special slots with UL symbols
+} srsran_duplex_nr_slot_t;
+
 /**
  * @brief Describes a measurement based on NZP-CSI-RS or SSB-CSI
  * @note Used for tracking RSRP, SNR, CFO, SFO, and so on
@@ -654,6 +665,17 @@ SRSRAN_API bool srsran_duplex_nr_is_dl(const srsran_duplex_config_nr_t* cfg, uin
  */
 SRSRAN_API bool srsran_duplex_nr_is_ul(const srsran_duplex_config_nr_t* cfg, uint32_t numerology, uint32_t slot_idx);
 
+/**
+ * @brief Classifies a given slot by the directions it carries
+ * @param cfg Provides the carrier duplex configuration
+ * @param numerology Provides BWP numerology
+ * @param slot_idx Slot index in the frame for the given numerology
+ * @return The direction class of the slot, SRSRAN_DUPLEX_NR_SLOT_NONE if the configuration is NULL
+ */
+SRSRAN_API srsran_duplex_nr_slot_t srsran_duplex_nr_slot_type(const srsran_duplex_config_nr_t* cfg,
+                                                             uint32_t                         numerology,
+                                                             uint32_t                         slot_idx);
+
 SRSRAN_API int srsran_carrier_to_cell(const srsran_carrier_nr_t* carrier, srsran_cell_t* cell);
 
 /**
@@ -47,12 +47,31 @@ SRSRAN_API void srsran_sequence_state_gen_f(srsran_sequence_state_t* s, float va
 
 SRSRAN_API void srsran_sequence_state_apply_f(srsran_sequence_state_t* s, const float* in, float* out, uint32_t length);
 
+SRSRAN_API void
+srsran_sequence_state_apply_s(srsran_sequence_state_t* s, const int16_t* in, int16_t* out, uint32_t length);
+
 SRSRAN_API void
 srsran_sequence_state_apply_c(srsran_sequence_state_t* s, const int8_t* in, int8_t* out, uint32_t length);
 
 SRSRAN_API
 void srsran_sequence_state_apply_bit(srsran_sequence_state_t* s, const uint8_t* in, uint8_t* out, uint32_t length);
 
+/**
+ * @brief Applies the sequence to packed bits and advances the state by length bits. All calls but the last one shall
+ * have a length multiple of 8 bits, so the following call starts in a whole byte
+ * @param s Sequence state
+ * @param in Input packed bits
+ * @param out Output packed bits, it can be the same as the input
+ * @param length Number of bits
+ */
+SRSRAN_API void
+srsran_sequence_state_apply_packed(srsran_sequence_state_t* s, const uint8_t* in, uint8_t* out, uint32_t length);
+
+/**
+ * @brief Advances the sequence state by length bits, the cost is logarithmic in length
+ * @param s Sequence state
+ * @param length Number of bits to skip
+ */
 SRSRAN_API void srsran_sequence_state_advance(srsran_sequence_state_t* s, uint32_t length);
 
 typedef struct SRSRAN_API {
@@ -94,6 +113,11 @@ SRSRAN_API int srsran_sequence_pdcch(srsran_sequence_t* seq, uint32_t nslot, uin
 SRSRAN_API int
 srsran_sequence_pdsch(srsran_sequence_t* seq, uint16_t rnti, int q, uint32_t nslot, uint32_t cell_id, uint32_t len);
 
+/**
+ * @brief Computes the LTE PDSCH scrambling sequence seed, 36.211 6.3.1
+ */
+SRSRAN_API uint32_t srsran_sequence_pdsch_seed(uint16_t rnti, int q, uint32_t nslot, uint32_t cell_id);
+
 SRSRAN_API void srsran_sequence_pdsch_apply_pack(const uint8_t* in,
                                                  uint8_t*       out,
                                                  uint16_t       rnti,
@@ -129,6 +153,11 @@ SRSRAN_API void srsran_sequence_pdsch_apply_c(const int8_t* in,
 SRSRAN_API int
 srsran_sequence_pusch(srsran_sequence_t* seq, uint16_t rnti, uint32_t nslot, uint32_t cell_id, uint32_t len);
 
+/**
+ * @brief Computes the LTE PUSCH scrambling sequence seed, 36.211 5.3.1
+ */
+SRSRAN_API uint32_t srsran_sequence_pusch_seed(uint16_t rnti, uint32_t nslot, uint32_t cell_id);
+
 SRSRAN_API void srsran_sequence_pusch_apply_pack(const uint8_t* in,
                                                  uint8_t*       out,
                                                  uint16_t       rnti,
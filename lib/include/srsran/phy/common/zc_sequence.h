@@ -36,6 +36,16 @@
  */
 #define SRSRAN_ZC_SEQUENCE_NOF_BASE 2
 
+/**
+ * @brief Defines the longest ZC sequence which base sequence is cached, 110 PRB
+ *
+ * The base sequences, without cyclic shift, are generated the first time they are used and shared by all the users in
+ * the process. The generation functions apply the cyclic shift on a copy of the cached base sequence. Only the lengths
+ * in use are stored: all the PUSCH DMRS allocations of a 100 PRB cell, with every group and base sequence, take about
+ * 7 MB.
+ */
+#define SRSRAN_ZC_SEQUENCE_CACHE_MAX_LEN 1320
+
 /**
  * @brief Generates ZC sequences given the required parameters used in the TS 36 series (LTE)
  *
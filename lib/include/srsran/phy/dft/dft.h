@@ -40,6 +40,10 @@
  *                norm   - Normalizes output (by sqrt(len) for complex, len for real).
  *                dc     - Handles insertion and removal of null DC carrier internally.
  *
+ *                Backends: complex transforms are computed by FFTW or, if selected with
+ *                srsran_dft_set_backend(), by the native mixed-radix FFT for lengths of the
+ *                form 2^a*3^b*5^c. Other lengths and real transforms always use FFTW.
+ *
  *  Reference:
  *********************************************************************************************/
 
@@ -51,22 +55,37 @@ typedef enum { SRSRAN_DFT_COMPLEX, SRSRAN_REAL } srsran_dft_mode_t;
 
 typedef enum { SRSRAN_DFT_FORWARD, SRSRAN_DFT_BACKWARD } srsran_dft_dir_t;
 
+typedef enum { SRSRAN_DFT_BACKEND_FFTW = 0, SRSRAN_DFT_BACKEND_NATIVE } srsran_dft_backend_t;
+
 typedef struct SRSRAN_API {
-  int               init_size; // DFT length used in the first initialization
-  int               size;      // DFT length
-  void*             in;        // Input buffer
-  void*             out;       // Output buffer
-  void*             p;         // DFT plan
-  bool              is_guru;
-  bool              forward; // Forward transform?
-  bool              mirror;  // Shift negative and positive frequencies?
-  bool              db;      // Provide output in dB?
-  bool              norm;    // Normalize output?
-  bool              dc;      // Handle insertion/removal of null DC carrier internally?
-  srsran_dft_dir_t  dir;     // Forward/Backward
-  srsran_dft_mode_t mode;    // Complex/Real
+  int                  init_size; // DFT length used in the first initialization
+  int                  size;      // DFT length
+  void*                in;        // Input buffer
+  void*                out;       // Output buffer
+  void*                p;         // DFT plan
+  srsran_dft_backend_t backend;   // Backend that computes the plan
+  bool                 is_guru;
+  bool                 forward; // Forward transform?
+  bool                 mirror;  // Shift negative and positive frequencies?
+  bool                 db;      // Provide output in dB?
+  bool                 norm;    // Normalize output?
+  bool                 dc;      // Handle insertion/removal of null DC carrier internally?
+  srsran_dft_dir_t     dir;     // Forward/Backward
+  srsran_dft_mode_t    mode;    // Complex/Real
 } srsran_dft_plan_t;
 
+/**
+ * @brief Selects the backend of the complex plans created from now on. The plans that already exist are not modified.
+ *
+ * With the native backend, all the plans of the same length and direction share their twiddle factors, which are
+ * computed only once. FFTW wisdom is only loaded when the first FFTW plan is created.
+ *
+ * @param backend Backend for the new plans, FFTW by default
+ */
+SRSRAN_API void srsran_dft_set_backend(srsran_dft_backend_t backend);
+
+SRSRAN_API srsran_dft_backend_t srsran_dft_get_backend();
+
 SRSRAN_API int srsran_dft_plan(srsran_dft_plan_t* plan, int dft_points, srsran_dft_dir_t dir, srsran_dft_mode_t type);
 
 SRSRAN_API int srsran_dft_plan_c(srsran_dft_plan_t* plan, int dft_points, srsran_dft_dir_t dir);
@@ -120,6 +139,15 @@ SRSRAN_API void srsran_dft_run_c_zerocopy(srsran_dft_plan_t* plan, const cf_t* i
 
 SRSRAN_API void srsran_dft_run_c(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out);
 
+/**
+ * @brief Computes a complex DFT without modifying the plan, so that several threads can share it. As in
+ * srsran_dft_run_c_zerocopy(), the output is neither normalized nor rearranged.
+ *
+ * @param plan Complex plan of even length
+ * @param work Scratch buffer of 2 * plan->size samples owned by the calling thread
+ */
+SRSRAN_API void srsran_dft_run_c_shared(const srsran_dft_plan_t* plan, const cf_t* in, cf_t* out, cf_t* work);
+
 SRSRAN_API void srsran_dft_run_guru_c(srsran_dft_plan_t* plan);
 
 SRSRAN_API void srsran_dft_run_r(srsran_dft_plan_t* plan, const float* in, float* out);
@@ -35,11 +35,13 @@
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/phy/dft/dft.h"
 
-/* DFT-based Transform Precoding object */
+/* DFT-based Transform Precoding object. The DFT plans of every valid number of PRB are created once and shared,
+ * read-only, by all the objects of the process: an object only owns the scratch buffer of its thread. */
 typedef struct SRSRAN_API {
 
-  uint32_t          max_prb;
-  srsran_dft_plan_t dft_plan[SRSRAN_MAX_PRB + 1];
+  uint32_t max_prb;
+  bool     is_tx;
+  cf_t*    work;
 
 } srsran_dft_precoding_t;
 
@@ -55,6 +57,7 @@ SRSRAN_API bool srsran_dft_precoding_valid_prb(uint32_t nof_prb);
 
 SRSRAN_API uint32_t srsran_dft_precoding_get_valid_prb(uint32_t nof_prb);
 
+/* Transforms the nof_symbols SC-FDMA symbols of a grant, stored one after the other, in a single batch */
 SRSRAN_API int
 srsran_dft_precoding(srsran_dft_precoding_t* q, cf_t* input, cf_t* output, uint32_t nof_prb, uint32_t nof_symbols);
 
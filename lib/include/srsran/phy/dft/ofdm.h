@@ -38,6 +38,12 @@
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/phy/dft/dft.h"
 
+/**
+ * Largest fractional CFO, normalised by the subcarrier spacing, that the receiver removes after the DFT. Above it, the
+ * inter-carrier interference is not negligible and the CFO is removed from the time domain signal before the DFT
+ */
+#define SRSRAN_OFDM_RX_CFO_MAX_RESIDUAL 0.01f
+
 /**
  * @struct srsran_ofdm_cfg_t
  * Contains the generic OFDM modulator configuration. The structure must be initialised to all zeros before being
@@ -87,6 +93,10 @@ typedef struct SRSRAN_API {
   cf_t*             shift_buffer;
   cf_t*             window_offset_buffer;
   cf_t              phase_compensation[SRSRAN_MAX_NSYMB * SRSRAN_NOF_SLOTS_PER_SF];
+  float             cfo;          ///< Rx CFO normalised by the subcarrier spacing, 0 if disabled
+  bool              cfo_post_dft; ///< Rx CFO is removed after the DFT
+  int32_t           cfo_shift;    ///< Integer part of the Rx CFO, removed as a subcarrier shift
+  cf_t              cfo_compensation[SRSRAN_MAX_NSYMB * SRSRAN_NOF_SLOTS_PER_SF]; ///< Rx CFO phase of every symbol
   srsran_cfr_t      tx_cfr; ///< Tx CFR object
 } srsran_ofdm_t;
 
@@ -128,6 +138,17 @@ SRSRAN_API void srsran_ofdm_rx_free(srsran_ofdm_t* q);
 
 SRSRAN_API void srsran_ofdm_rx_sf(srsran_ofdm_t* q);
 
+/**
+ * @brief Demodulates only the given slots of the subframe, leaving the output of the other slots untouched
+ *
+ * @note MBSFN subframes and CFO correction before the DFT demodulate the whole subframe
+ *
+ * @param q OFDM object
+ * @param first_slot First slot to demodulate
+ * @param nof_slots Number of slots to demodulate
+ */
+SRSRAN_API void srsran_ofdm_rx_sf_slots(srsran_ofdm_t* q, uint32_t first_slot, uint32_t nof_slots);
+
 SRSRAN_API void srsran_ofdm_rx_sf_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output);
 
 SRSRAN_API int
@@ -140,12 +161,39 @@ SRSRAN_API void srsran_ofdm_tx_free(srsran_ofdm_t* q);
 
 SRSRAN_API void srsran_ofdm_tx_sf(srsran_ofdm_t* q);
 
+/**
+ * @brief Modulates a subframe and writes it as interleaved 16-bit integer samples (sc16), as the radio expects them
+ *
+ * The normalization, phase compensation, scaling and conversion are applied in a single pass after the IFFT, the
+ * floating point output buffer is only used as IFFT output. MBSFN subframes and transmitters with CFR or frequency
+ * shift modulate in floating point and convert at the end.
+ *
+ * @param q OFDM object
+ * @param scale Scaling applied before the conversion, for example INT16_MAX for a full-scale signal of amplitude 1
+ * @param output Output buffer, it must fit twice the subframe size
+ */
+SRSRAN_API void srsran_ofdm_tx_sf_sc16(srsran_ofdm_t* q, float scale, int16_t* output);
+
 SRSRAN_API int srsran_ofdm_set_freq_shift(srsran_ofdm_t* q, float freq_shift);
 
 SRSRAN_API void srsran_ofdm_set_normalize(srsran_ofdm_t* q, bool normalize_enable);
 
 SRSRAN_API int srsran_ofdm_set_phase_compensation(srsran_ofdm_t* q, double center_freq_hz);
 
+/**
+ * @brief Sets the carrier frequency offset removed by the receiver in the following subframes
+ *
+ * The correction is equivalent to rotating the input subframe by -cfo subcarriers with srsran_vec_apply_cfo() before
+ * srsran_ofdm_rx_sf(). If the fractional part does not exceed SRSRAN_OFDM_RX_CFO_MAX_RESIDUAL, it is removed in the
+ * same pass that extracts the subcarriers after the DFT: the integer part as a subcarrier shift and the fractional part
+ * as a phase per symbol. Otherwise the input buffer is rotated before the DFT.
+ *
+ * @param q OFDM receiver object
+ * @param cfo Carrier frequency offset normalised by the subcarrier spacing, 0 disables the correction
+ * @return SRSRAN_SUCCESS if the parameters are valid, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_ofdm_set_cfo(srsran_ofdm_t* q, float cfo);
+
 SRSRAN_API void srsran_ofdm_set_non_mbsfn_region(srsran_ofdm_t* q, uint8_t non_mbsfn_region);
 
 SRSRAN_API int srsran_ofdm_set_cfr(srsran_ofdm_t* q, srsran_cfr_cfg_t* cfr);
@@ -86,6 +86,19 @@ typedef struct SRSRAN_API {
   float sss_signal0[SRSRAN_SSS_LEN];
   float sss_signal5[SRSRAN_SSS_LEN];
 
+  /* Pre-rendered PSS/SSS and CRS of the normal subframes, only the symbols set in the mask of each
+   * port and subframe are stored */
+  cf_t*               base_symbols[SRSRAN_MAX_PORTS];
+  uint32_t            base_symbol_mask[SRSRAN_MAX_PORTS][SRSRAN_NOF_SF_X_FRAME];
+  uint32_t            base_symbol_offset[SRSRAN_MAX_PORTS][SRSRAN_NOF_SF_X_FRAME];
+  srsran_tdd_config_t base_tdd_config;
+  bool                base_valid;
+
+  /* Time domain signal of the subframes carrying base signals only, valid for the CFI stored for each subframe */
+  bool     sf_base_only;
+  cf_t*    base_signal[SRSRAN_NOF_SF_X_FRAME][SRSRAN_MAX_PORTS];
+  uint32_t base_signal_cfi[SRSRAN_NOF_SF_X_FRAME];
+
   uint32_t              nof_common_locations[3];
   srsran_dci_location_t common_locations[3][SRSRAN_MAX_CANDIDATES_COM];
 
@@ -121,6 +134,9 @@ srsran_enb_dl_put_pdsch(srsran_enb_dl_t* q, srsran_pdsch_cfg_t* pdsch, uint8_t*
 
 SRSRAN_API int srsran_enb_dl_put_pmch(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmch_cfg, uint8_t* data);
 
+/* Maps PMCH symbols encoded by another cell of the same MBSFN area, see srsran_pmch_encode_symbols() */
+SRSRAN_API int srsran_enb_dl_put_pmch_symbols(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmch_cfg, const cf_t* symbols);
+
 SRSRAN_API void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q);
 
 SRSRAN_API bool srsran_enb_dl_gen_cqi_periodic(const srsran_cell_t*   cell,
@@ -85,4 +85,13 @@ SRSRAN_API int srsran_enb_ul_get_pusch(srsran_enb_ul_t*    q,
                                        srsran_pusch_cfg_t* cfg,
                                        srsran_pusch_res_t* res);
 
+/**
+ * Enables the deferred PUSCH decoding. When enabled, srsran_enb_ul_get_pusch() does not decode the transport block,
+ * and the CRC and number of iterations of the result are written by srsran_enb_ul_decode_deferred_pusch(). All the
+ * pending PUSCH transport blocks are decoded together by the batched turbo decoder.
+ */
+SRSRAN_API int srsran_enb_ul_enable_deferred_pusch(srsran_enb_ul_t* q, bool enable);
+
+SRSRAN_API int srsran_enb_ul_decode_deferred_pusch(srsran_enb_ul_t* q);
+
 #endif // SRSRAN_ENB_UL_H
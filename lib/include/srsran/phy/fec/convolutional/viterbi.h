@@ -92,4 +92,16 @@ SRSRAN_API int srsran_viterbi_init_avx2(srsran_viterbi_t*     q,
                                         uint32_t              max_frame_length,
                                         bool                  tail_bitting);
 
+SRSRAN_API int srsran_viterbi_init_avx2_16bit(srsran_viterbi_t*     q,
+                                              srsran_viterbi_type_t type,
+                                              int                   poly[3],
+                                              uint32_t              max_frame_length,
+                                              bool                  tail_bitting);
+
+SRSRAN_API int srsran_viterbi_init_avx512_16bit(srsran_viterbi_t*     q,
+                                                srsran_viterbi_type_t type,
+                                                int                   poly[3],
+                                                uint32_t              max_frame_length,
+                                                bool                  tail_bitting);
+
 #endif // SRSRAN_VITERBI_H
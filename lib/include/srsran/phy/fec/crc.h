@@ -44,6 +44,7 @@ typedef struct SRSRAN_API {
   uint64_t crcmask;
   uint64_t crchighbit;
   uint32_t srsran_crc_out;
+  uint64_t fold_k[2]; ///< x^192 and x^128 modulo the polynomial aligned to 32 bits, for the carry-less multiply kernel
 } srsran_crc_t;
 
 SRSRAN_API int srsran_crc_init(srsran_crc_t* h, uint32_t srsran_crc_poly, int srsran_crc_order);
@@ -51,6 +51,14 @@ typedef enum {
                                    (AVX512 version). */
 } srsran_ldpc_decoder_type_t;
 
+/*!
+ * \brief Variants of the min-sum algorithm used for computing the check-to-variable messages.
+ */
+typedef enum {
+  SRSRAN_LDPC_DECODER_MS_NORMALIZED = 0, /*!< \brief Normalized min-sum, messages are multiplied by a scaling factor. */
+  SRSRAN_LDPC_DECODER_MS_OFFSET,         /*!< \brief Offset min-sum, an offset is subtracted from the messages. */
+} srsran_ldpc_decoder_ms_t;
+
 /*!
  * \brief Describes the LDPC decoder configuration arguments.
  */
@@ -60,6 +68,9 @@ typedef struct {
   uint16_t                   ls;           /*!< \brief The desired lifting size. */
   float                      scaling_fctr; /*!< \brief Scaling factor of the normalized min-sum algorithm.*/
   uint32_t                   max_nof_iter; /*!< \brief Maximum number of iterations, set to 0 for default value. */
+  srsran_ldpc_decoder_ms_t   ms_type;      /*!< \brief Min-sum variant, normalized by default. */
+  float                      offset;       /*!< \brief Offset of the offset min-sum algorithm, 0 for default value. */
+  bool                       early_stop;   /*!< \brief Stop when all the parity checks are satisfied (layered only). */
 } srsran_ldpc_decoder_args_t;
 
 /*!
@@ -81,6 +92,8 @@ typedef struct SRSRAN_API {
   int8_t (*var_indices)[MAX_CNCT]; /*!< \brief Pointer to lists of variable indices connected to a given check node. */
 
   float scaling_fctr; /*!< \brief Scaling factor for the normalized min-sum algorithm. */
+  float offset;       /*!< \brief Offset for the offset min-sum algorithm, 0 for the normalized min-sum algorithm. */
+  bool  early_stop;   /*!< \brief Stops decoding as soon as all the parity checks are satisfied. */
 
   void (*free)(void*); /*!< \brief Pointer to a "destructor". */
 
@@ -110,6 +123,15 @@ typedef struct SRSRAN_API {
  */
 SRSRAN_API int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder_args_t* args);
 
+/*!
+ * Returns the calibrated offset of the offset min-sum algorithm for the 8-bit decoders, that is, the offset that
+ * minimizes the block error rate for the given base graph and lifting size.
+ * \param[in] bg The base graph (BG1 or BG2).
+ * \param[in] ls The lifting size.
+ * \return The offset in 8-bit LLR units, 0 if the lifting size is not valid.
+ */
+SRSRAN_API float srsran_ldpc_decoder_default_offset(srsran_basegraph_t bg, uint16_t ls);
+
 /*!
  * The LDPC decoder "destructor": it frees all the resources allocated to the decoder.
  * \param[in] q A pointer to the dismantled decoder.
@@ -171,7 +193,9 @@ srsran_ldpc_decoder_decode_c(srsran_ldpc_decoder_t* q, const int8_t* llrs, uint8
  *    operation.
  * \param[in] cdwd_rm_length The number of bits forming the codeword (after rate matching).
  * \param[in,out] crc Code-block CRC object for early stop. Set for NULL to disable check
- * \return -1 if an error occurred, the number of used iterations, and 0 if CRC is provided and did not match
+ * \return -1 if an error occurred, the number of used iterations, and 0 if CRC is provided and did not match. If the
+ * decoder was initialized with early_stop, decoding stops as soon as all the parity checks are satisfied and the CRC
+ * (if provided) matches
  */
 SRSRAN_API int srsran_ldpc_decoder_decode_crc_c(srsran_ldpc_decoder_t* q,
                                                 const int8_t*          llrs,
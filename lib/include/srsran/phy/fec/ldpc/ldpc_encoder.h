@@ -102,6 +102,22 @@ SRSRAN_API void srsran_ldpc_encoder_free(srsran_ldpc_encoder_t* q);
 SRSRAN_API int
 srsran_ldpc_encoder_encode(srsran_ldpc_encoder_t* q, const uint8_t* input, uint8_t* output, uint32_t input_length);
 
+/*!
+ * Encodes a batch of messages into codewords with the specified encoder, that is, all of them with the same base
+ * graph and lifting size. The message length is checked once for the whole batch.
+ * \param[in] q A pointer to the desired encoder.
+ * \param[in] input Array of nof_messages pointers to the messages to encode.
+ * \param[out] output Array of nof_messages pointers to the resulting codewords.
+ * \param[in] nof_messages The number of messages in the batch.
+ * \param[in] input_length The number of uncoded bits in each input message.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int srsran_ldpc_encoder_encode_batch(srsran_ldpc_encoder_t* q,
+                                                const uint8_t* const*  input,
+                                                uint8_t* const*        output,
+                                                uint32_t               nof_messages,
+                                                uint32_t               input_length);
+
 /*!
  * Encodes a message into a codeword with the specified encoder.
  * \param[in] q A pointer to the desired encoder.
@@ -34,12 +34,30 @@
 
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/phy/fec/ldpc/base_graph.h"
+#include <pthread.h>
+
+/*!
+ * \brief Cache of rate-dematching index maps, keyed by base graph, lifting size, redundancy version, modulation
+ * order, rate-matched length, number of filler bits and limited buffer size.
+ *
+ * A single cache can be shared by several rate dematchers running in different threads: the maps are never modified
+ * nor removed once they are inserted, and the insertion is protected by a mutex. When the cache is full, the rate
+ * dematchers fall back to computing the indices on the fly.
+ */
+typedef struct SRSRAN_API {
+  void**          entries;     /*!< \brief Hash table of index maps (open addressing). */
+  uint32_t        nof_slots;   /*!< \brief Number of slots of the hash table. */
+  uint32_t        nof_entries; /*!< \brief Number of index maps in the cache. */
+  uint32_t        max_entries; /*!< \brief Maximum number of index maps. */
+  pthread_mutex_t mutex;       /*!< \brief Protects the hash table. */
+} srsran_ldpc_rm_cache_t;
 
 /*!
  * \brief Describes a rate matcher or rate dematcher (K, F are ignored at rate matcher)
  */
 typedef struct SRSRAN_API {
-  void*              ptr;       /*!< \brief %Rate Matcher auxiliary registers. */
+  void*                   ptr;   /*!< \brief %Rate Matcher auxiliary registers. */
+  srsran_ldpc_rm_cache_t* cache; /*!< \brief Shared index map cache (int8_t rate dematcher only), NULL for none. */
   srsran_basegraph_t bg;        /*!< \brief Current base graph. */
   uint16_t           ls;        /*!< \brief Current lifting size. */
   uint32_t           N;         /*!< \brief Codeword size. */
@@ -162,6 +180,27 @@ SRSRAN_API int srsran_ldpc_rm_rx_s(srsran_ldpc_rm_t*        q,
  */
 SRSRAN_API int srsran_ldpc_rm_rx_init_c(srsran_ldpc_rm_t* q);
 
+/*!
+ * Initializes a rate-dematching index map cache.
+ * \param[out] cache       A pointer to a srsran_ldpc_rm_cache_t structure.
+ * \param[in] max_entries  Maximum number of index maps kept in the cache.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int srsran_ldpc_rm_cache_init(srsran_ldpc_rm_cache_t* cache, uint32_t max_entries);
+
+/*!
+ * Frees all the index maps of a cache. No rate dematcher shall be using it.
+ * \param[in] cache A pointer to the dismantled cache.
+ */
+SRSRAN_API void srsran_ldpc_rm_cache_free(srsran_ldpc_rm_cache_t* cache);
+
+/*!
+ * Makes an int8_t rate dematcher use a (possibly shared) index map cache.
+ * \param[in,out] q    A pointer to a rate dematcher initialized with srsran_ldpc_rm_rx_init_c().
+ * \param[in] cache    A pointer to an initialized cache, NULL for computing the indices on the fly.
+ */
+SRSRAN_API void srsran_ldpc_rm_rx_set_cache_c(srsran_ldpc_rm_t* q, srsran_ldpc_rm_cache_t* cache);
+
 /*!
  * Carries out the actual rate-dematching (int8_t symbols).
  * \param[in] q           A pointer to the Rate-DeMatcher (a srsran_ldpc_rm_t structure
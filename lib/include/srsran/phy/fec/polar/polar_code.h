@@ -333,6 +333,8 @@ typedef struct {
   uint16_t* tmp_K_set;  /*!< \brief Temporal Pointer. */
   uint16_t  PC_set[4];  /*!< \brief Pointer to the indices of the encoder input vector containing the parity bits.*/
   uint16_t* F_set;      /*!< \brief Pointer to the indices of the encoder input vector containing frozen bits.*/
+  uint16_t  E;          /*!< \brief Number of rate-matched bits of the current sets, 0 if there are none. */
+  uint8_t   nMax;       /*!< \brief Maximum \f$ log_2(N)\f$ of the current sets. */
 } srsran_polar_code_t;
 
 /*!
@@ -409,6 +411,7 @@ int srsran_polar_code_init(srsran_polar_code_t* c);
  * \param[in] E Number of bits of the codeword after rate matching.
  * \param[in] nMax Maximum \f$log_2(N)\f$, where \f$N\f$ is the codeword size, nMax = 9 for downlink and nMax = 10, for
  * uplink.
+ * The sets are kept when the parameters match the previous call, as for the PDCCH candidates of one aggregation level.
  * \return An integer: 0 if the function executes correctly, -1 otherwise.
  */
 int srsran_polar_code_get(srsran_polar_code_t* c, const uint16_t K, const uint16_t E, const uint8_t nMax);
@@ -37,6 +37,16 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+/*!
+ * \brief Maximum number of paths of a list decoder.
+ */
+#define SRSRAN_POLAR_DECODER_LIST_SIZE_MAX 8
+
+/*!
+ * \brief Number of paths of a list decoder initialized by srsran_polar_decoder_init().
+ */
+#define SRSRAN_POLAR_DECODER_LIST_SIZE_DEFAULT 8
+
 /*!
  * Lists the different types of polar decoder.
  */
@@ -45,15 +55,19 @@ typedef enum SRSRAN_API {
   SRSRAN_POLAR_DECODER_SSC_S = 1, /*!< \brief Fixed-point (16 bit) Simplified Successive Cancellation (SSC) decoder. */
   SRSRAN_POLAR_DECODER_SSC_C = 2, /*!< \brief Fixed-point (8 bit) Simplified Successive Cancellation (SSC) decoder. */
   SRSRAN_POLAR_DECODER_SSC_C_AVX2 =
-      3 /*!< \brief Fixed-point (8 bit, avx2) Simplified Successive Cancellation (SSC) decoder. */
+      3, /*!< \brief Fixed-point (8 bit, avx2) Simplified Successive Cancellation (SSC) decoder. */
+  SRSRAN_POLAR_DECODER_SCL_C = 4, /*!< \brief Fixed-point (8 bit) Successive Cancellation List (SCL) decoder. */
+  SRSRAN_POLAR_DECODER_SCL_C_AVX2 =
+      5 /*!< \brief Fixed-point (8 bit, avx2) Successive Cancellation List (SCL) decoder. */
 } srsran_polar_decoder_type_t;
 
 /*!
  * \brief Describes a polar decoder.
  */
 typedef struct SRSRAN_API {
-  void*   ptr;  /*!< \brief Pointer to the actual polar decoder structure. */
-  uint8_t nMax; /*!< \brief Maximum \f$log_2(code_size)\f$. */
+  void*   ptr;       /*!< \brief Pointer to the actual polar decoder structure. */
+  uint8_t nMax;      /*!< \brief Maximum \f$log_2(code_size)\f$. */
+  uint8_t list_size; /*!< \brief Maximum number of decoded candidates per codeword, 1 for SSC decoders. */
   int (*decode_f)(void*           ptr,
                   const float*    symbols,
                   uint8_t*        data_decoded,
@@ -72,6 +86,14 @@ typedef struct SRSRAN_API {
                   const uint8_t   n,
                   const uint16_t* frozen_set,
                   const uint16_t  frozen_set_size); /*!< \brief Pointer to the decoder function (8-bit version). */
+  int (*decode_list_c)(void*                ptr,
+                       const int8_t* const* symbols,
+                       uint8_t* const*      data_decoded,
+                       const uint32_t       nof_codewords,
+                       const uint8_t        n,
+                       const uint16_t*      frozen_set,
+                       const uint16_t       frozen_set_size); /*!< \brief Pointer to the list decoder function (8-bit
+                                                                version), NULL if the decoder is not a list decoder. */
   void (*free)(void*);                             /*!< \brief Pointer to a "destructor". */
 } srsran_polar_decoder_t;
 
@@ -87,6 +109,20 @@ SRSRAN_API int srsran_polar_decoder_init(srsran_polar_decoder_t*     q,
                                          srsran_polar_decoder_type_t polar_decoder_type,
                                          const uint8_t               code_size_log);
 
+/*!
+ * Same as srsran_polar_decoder_init() with a given number of paths for the list decoders. SSC decoders only accept a
+ * list size of 1.
+ * \param[out] q A pointer to the initialized polar decoder.
+ * \param[in] polar_decoder_type Polar decoder type.
+ * \param[in] code_size_log The \f$ log_2\f$ of the number of bits of the decoder input/output vector.
+ * \param[in] list_size Number of paths, up to \ref SRSRAN_POLAR_DECODER_LIST_SIZE_MAX.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int srsran_polar_decoder_init_list(srsran_polar_decoder_t*     q,
+                                              srsran_polar_decoder_type_t polar_decoder_type,
+                                              const uint8_t               code_size_log,
+                                              const uint8_t               list_size);
+
 /*!
  * The polar decoder "destructor": it frees all the resources.
  * \param[in, out] q A pointer to the dismantled decoder.
@@ -145,4 +181,45 @@ SRSRAN_API int srsran_polar_decoder_decode_c(srsran_polar_decoder_t* q,
                                              const uint16_t*         frozen_set,
                                              const uint16_t          frozen_set_size);
 
+/*!
+ * Decodes the input (int8_t) codeword and returns all the decoded candidates, the most likely first. List decoders
+ * provide up to srsran_polar_decoder_t::list_size candidates, the rest of the decoders provide one. The caller selects
+ * the right candidate, typically the first one matching the CRC (CRC-aided list decoding).
+ * \param[in] q A pointer to the desired polar decoder.
+ * \param[in] input_llr The decoder LLR input vector.
+ * \param[out] data_decoded The candidates one after the other, it must fit srsran_polar_decoder_t::list_size times
+ * \f$2^{code\_size\_log}\f$ bits.
+ * \param[in] code_size_log The \f$ log_2\f$ of the number of bits of the decoder input/output vector.
+ * \param[in] frozen_set The position of the frozen bits in increasing order.
+ * \param[in] frozen_set_size The size of the frozen_set.
+ * \return The number of candidates if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int srsran_polar_decoder_decode_list_c(srsran_polar_decoder_t* q,
+                                                  const int8_t*           input_llr,
+                                                  uint8_t*                data_decoded,
+                                                  const uint8_t           code_size_log,
+                                                  const uint16_t*         frozen_set,
+                                                  const uint16_t          frozen_set_size);
+
+/*!
+ * Same as srsran_polar_decoder_decode_list_c() for several codewords sharing the same code. The decoding tree is
+ * computed from the frozen set only once for the whole batch.
+ * \param[in] q A pointer to the desired polar decoder.
+ * \param[in] input_llr Array with the LLR input vector of every codeword.
+ * \param[out] data_decoded Array with the candidate output vectors of every codeword, see
+ * srsran_polar_decoder_decode_list_c().
+ * \param[in] nof_codewords Number of codewords.
+ * \param[in] code_size_log The \f$ log_2\f$ of the number of bits of the decoder input/output vector.
+ * \param[in] frozen_set The position of the frozen bits in increasing order.
+ * \param[in] frozen_set_size The size of the frozen_set.
+ * \return The number of candidates per codeword if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int srsran_polar_decoder_decode_list_batch_c(srsran_polar_decoder_t* q,
+                                                        const int8_t* const*    input_llr,
+                                                        uint8_t* const*         data_decoded,
+                                                        const uint32_t          nof_codewords,
+                                                        const uint8_t           code_size_log,
+                                                        const uint16_t*         frozen_set,
+                                                        const uint16_t          frozen_set_size);
+
 #endif // SRSRAN_POLARDECODER_H
@@ -44,7 +44,9 @@ typedef struct SRSRAN_API {
   int16_t** buffer_f;
   uint8_t** data;
   bool*     cb_crc;
+  bool*     cb_dirty; ///< Code blocks written since the last reset, only these are zeroed by the reset functions
   bool      tb_crc;
+  uint32_t  cb_buffer_len; ///< Size in bytes of each code block buffer in buffer_f
 } srsran_softbuffer_rx_t;
 
 typedef struct SRSRAN_API {
@@ -67,6 +69,47 @@ SRSRAN_API int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof
  */
 SRSRAN_API int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size);
 
+/**
+ * @brief Initialises an Rx soft-buffer for NR, which stores the LLRs as int8_t. The code block buffers are not
+ * allocated here but on their first use, see srsran_softbuffer_rx_reserve_cb(), so that the memory of the soft-buffer
+ * follows the largest transport block actually received instead of the largest possible one
+ * @param q The Rx soft-buffer pointer
+ * @param max_cb The maximum number of code blocks
+ * @param max_cb_size The maximum number of LLRs of a code block
+ * @return It returns SRSRAN_SUCCESS if it initialises the soft-buffer successfully, otherwise it returns SRSRAN_ERROR
+ * code
+ */
+SRSRAN_API int srsran_softbuffer_rx_init_nr(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size);
+
+/**
+ * @brief Initialises an LTE Rx soft-buffer like srsran_softbuffer_rx_init() but without allocating the code block
+ * buffers, which shall be reserved before each reception with srsran_softbuffer_rx_reserve_tbs()
+ * @param q The Rx soft-buffer pointer
+ * @param nof_prb The cell bandwidth the soft-buffer is sized for
+ * @return It returns SRSRAN_SUCCESS if it initialises the soft-buffer successfully, otherwise it returns SRSRAN_ERROR
+ * code
+ */
+SRSRAN_API int srsran_softbuffer_rx_init_on_demand(srsran_softbuffer_rx_t* q, uint32_t nof_prb);
+
+/**
+ * @brief Allocates the buffers of the first nof_cb code blocks that are not allocated yet
+ * @param q Rx soft-buffer object
+ * @param nof_cb Number of code blocks to use
+ * @return It returns SRSRAN_SUCCESS if the code blocks are available, otherwise it returns SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_softbuffer_rx_reserve_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb);
+
+/**
+ * @brief Allocates the code blocks of a transport block of tbs bits that are not allocated yet
+ * @param q Rx soft-buffer object
+ * @param tbs Transport block size in bits
+ * @return It returns SRSRAN_SUCCESS if the code blocks are available, otherwise it returns SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_softbuffer_rx_reserve_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs);
+
+/// Returns the memory allocated by the soft-buffer, in bytes
+SRSRAN_API uint64_t srsran_softbuffer_rx_mem_bytes(const srsran_softbuffer_rx_t* q);
+
 SRSRAN_API void srsran_softbuffer_rx_reset(srsran_softbuffer_rx_t* p);
 
 SRSRAN_API void srsran_softbuffer_rx_reset_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs);
@@ -75,6 +118,15 @@ SRSRAN_API void srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_
 
 SRSRAN_API void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* p);
 
+/**
+ * @brief Marks a code block as written, so that the next reset zeroes it
+ * @note Whoever writes in buffer_f or data shall call this function, the reset functions skip the code blocks that
+ * have not been marked
+ * @param q Rx soft-buffer object
+ * @param cb_idx Code block index
+ */
+SRSRAN_API void srsran_softbuffer_rx_set_dirty(srsran_softbuffer_rx_t* q, uint32_t cb_idx);
+
 /**
  * @brief Resets a number of CB CRCs
  * @note This function is intended to be used if all CB CRC have matched but the TB CRC failed. In this case, all CB
@@ -96,6 +148,35 @@ SRSRAN_API int srsran_softbuffer_tx_init(srsran_softbuffer_tx_t* q, uint32_t nof
  */
 SRSRAN_API int srsran_softbuffer_tx_init_guru(srsran_softbuffer_tx_t* q, uint32_t max_cb, uint32_t max_cb_size);
 
+/**
+ * @brief Initialises an LTE Tx soft-buffer like srsran_softbuffer_tx_init() but without allocating the code block
+ * buffers, which shall be reserved before each transmission with srsran_softbuffer_tx_reserve_tbs()
+ * @param q The Tx soft-buffer pointer
+ * @param nof_prb The cell bandwidth the soft-buffer is sized for
+ * @return It returns SRSRAN_SUCCESS if it initialises the soft-buffer successfully, otherwise it returns SRSRAN_ERROR
+ * code
+ */
+SRSRAN_API int srsran_softbuffer_tx_init_on_demand(srsran_softbuffer_tx_t* q, uint32_t nof_prb);
+
+/**
+ * @brief Allocates the buffers of the first nof_cb code blocks that are not allocated yet
+ * @param q Tx soft-buffer object
+ * @param nof_cb Number of code blocks to use
+ * @return It returns SRSRAN_SUCCESS if the code blocks are available, otherwise it returns SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_softbuffer_tx_reserve_cb(srsran_softbuffer_tx_t* q, uint32_t nof_cb);
+
+/**
+ * @brief Allocates the code blocks of a transport block of tbs bits that are not allocated yet
+ * @param q Tx soft-buffer object
+ * @param tbs Transport block size in bits
+ * @return It returns SRSRAN_SUCCESS if the code blocks are available, otherwise it returns SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_softbuffer_tx_reserve_tbs(srsran_softbuffer_tx_t* q, uint32_t tbs);
+
+/// Returns the memory allocated by the soft-buffer, in bytes
+SRSRAN_API uint64_t srsran_softbuffer_tx_mem_bytes(const srsran_softbuffer_tx_t* q);
+
 SRSRAN_API void srsran_softbuffer_tx_reset(srsran_softbuffer_tx_t* p);
 
 SRSRAN_API void srsran_softbuffer_tx_reset_tbs(srsran_softbuffer_tx_t* q, uint32_t tbs);
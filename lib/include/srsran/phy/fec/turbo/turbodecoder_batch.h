@@ -0,0 +1,119 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**********************************************************************************************
+ *  File:         turbodecoder_batch.h
+ *
+ *  Description:  Batched Turbo Decoder.
+ *                Decodes several independent code blocks at once, possibly of different lengths
+ *                and belonging to different transport blocks. Every SIMD lane carries one code
+ *                block. Shorter blocks are right-aligned in the lane and preceded by known zero
+ *                bits, so that all lanes share the same trellis length. Every block stops as soon
+ *                as its CRC passes, and its lane is refilled with the next pending block.
+ *
+ *  Reference:    3GPP TS 36.212 version 10.0.0 Release 10 Sec. 5.1.3.2
+ *********************************************************************************************/
+
+#ifndef SRSRAN_TURBODECODER_BATCH_H
+#define SRSRAN_TURBODECODER_BATCH_H
+
+#include "srsran/config.h"
+#include "srsran/phy/fec/cbsegm.h"
+#include "srsran/phy/fec/crc.h"
+#include "srsran/phy/fec/turbo/tc_interl.h"
+#include "srsran/phy/fec/turbo/turbodecoder.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Describes one code block in a batch
+ */
+typedef struct SRSRAN_API {
+  /* Inputs */
+  int8_t*       input;          ///< Soft bits as written by srsran_rm_turbo_rx_lut_8bit()
+  uint8_t*      output;         ///< Decoded packed bits, it must be at least long_cb / 8 bytes long
+  uint32_t      long_cb;        ///< Code block size in bits
+  srsran_crc_t* crc;            ///< CRC used for early stopping, set to NULL for running all the iterations
+  uint32_t      crc_len;        ///< Number of bits covered by the CRC check, including the CRC itself
+  uint32_t      max_iterations; ///< Maximum number of (half) iterations for this block, 0 uses the batch maximum
+
+  /* Outputs */
+  bool     crc_ok;         ///< Set to true if the CRC matched
+  uint32_t nof_iterations; ///< Number of (half) iterations run for this block
+} srsran_tdec_batch_cb_t;
+
+typedef struct SRSRAN_API {
+  uint32_t max_long_cb;
+  uint32_t nof_lanes;
+  uint32_t min_iterations;
+  bool     early_termination;
+
+  /* Lane-interleaved buffers: element k * nof_lanes + lane */
+  int16_t* syst;
+  int16_t* parity0;
+  int16_t* parity1;
+  int16_t* app1;
+  int16_t* app2;
+  int16_t* ext1;
+  int16_t* ext2;
+  int16_t* beta;
+
+  /* Natural order interleavers, generated on demand */
+  srsran_tc_interl_t interleaver[SRSRAN_NOF_TC_CB_SIZES];
+  bool               interleaver_ready[SRSRAN_NOF_TC_CB_SIZES];
+} srsran_tdec_batch_t;
+
+SRSRAN_API int srsran_tdec_batch_init(srsran_tdec_batch_t* q, uint32_t max_long_cb);
+
+SRSRAN_API void srsran_tdec_batch_free(srsran_tdec_batch_t* q);
+
+/**
+ * Sets the minimum number of iterations run before the CRC is checked. Default is 2.
+ */
+SRSRAN_API void srsran_tdec_batch_set_min_iterations(srsran_tdec_batch_t* q, uint32_t min_iterations);
+
+/**
+ * Stops decoding a block when its hard decision did not change in the last half iteration, even if the CRC does not
+ * match. Further iterations are unlikely to correct such a block. Default is disabled.
+ */
+SRSRAN_API void srsran_tdec_batch_set_early_termination(srsran_tdec_batch_t* q, bool enable);
+
+/**
+ * @brief Returns the number of code blocks decoded in parallel (number of SIMD lanes).
+ */
+SRSRAN_API uint32_t srsran_tdec_batch_nof_lanes(const srsran_tdec_batch_t* q);
+
+/**
+ * @brief Decodes a set of code blocks. The blocks are scheduled in the SIMD lanes from the longest to the shortest,
+ * and every block is decoded until its CRC matches or max_iterations (half) iterations are reached.
+ *
+ * @param q Initialized batch decoder
+ * @param cbs Array of code blocks. The output fields are written by the decoder
+ * @param nof_cbs Number of code blocks in the array
+ * @param max_iterations Maximum number of (half) iterations for each block, as in srsran_tdec_iteration_8bit(). Blocks
+ * with a lower max_iterations stop before
+ * @return The number of blocks with CRC match or SRSRAN_ERROR if the inputs are invalid
+ */
+SRSRAN_API int
+srsran_tdec_batch_run(srsran_tdec_batch_t* q, srsran_tdec_batch_cb_t* cbs, uint32_t nof_cbs, uint32_t max_iterations);
+
+#endif // SRSRAN_TURBODECODER_BATCH_H
@@ -50,6 +50,7 @@ typedef struct SRSRAN_API {
   srsran_ofdm_t fft[SRSRAN_MAX_PORTS];
 
   cf_t*             sf_symbols[SRSRAN_MAX_PORTS];
+  bool              sf_symbols_empty; ///< Set when the grid is zeroed, cleared when any channel or signal is put
   srsran_pdsch_nr_t pdsch;
   srsran_dmrs_sch_t dmrs;
 
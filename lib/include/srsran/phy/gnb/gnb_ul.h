@@ -57,12 +57,35 @@ SRSRAN_API int srsran_gnb_ul_set_carrier(srsran_gnb_ul_t* q, const srsran_carrie
 
 SRSRAN_API int srsran_gnb_ul_fft(srsran_gnb_ul_t* q);
 
+/**
+ * @brief Demodulates only the half slots (groups of 7 symbols) that overlap the given symbols
+ */
+SRSRAN_API int srsran_gnb_ul_fft_symbols(srsran_gnb_ul_t* q, uint32_t first_symbol, uint32_t nof_symbols);
+
 SRSRAN_API int srsran_gnb_ul_get_pusch(srsran_gnb_ul_t*             q,
                                        const srsran_slot_cfg_t*     slot_cfg,
                                        const srsran_sch_cfg_nr_t*   cfg,
                                        const srsran_sch_grant_nr_t* grant,
                                        srsran_pusch_res_nr_t*       data);
 
+/**
+ * @brief Initialises a gNb UL object that only decodes PUSCH transmissions from the resource grid of other gNb UL
+ * objects, see srsran_gnb_ul_get_pusch_grid(). It has no OFDM demodulator nor PUCCH decoder.
+ */
+SRSRAN_API int srsran_gnb_ul_init_pusch_decoder(srsran_gnb_ul_t* q, const srsran_gnb_ul_args_t* args);
+
+/**
+ * @brief Decodes a PUSCH transmission from the demodulated resource grid of the gNb UL object grid, using the DMRS
+ * estimator and the PUSCH decoder of q. Several objects can decode the transmissions of the same grid in parallel, q is
+ * switched to the carrier of grid if they differ. q can be grid itself.
+ */
+SRSRAN_API int srsran_gnb_ul_get_pusch_grid(srsran_gnb_ul_t*             q,
+                                            const srsran_gnb_ul_t*       grid,
+                                            const srsran_slot_cfg_t*     slot_cfg,
+                                            const srsran_sch_cfg_nr_t*   cfg,
+                                            const srsran_sch_grant_nr_t* grant,
+                                            srsran_pusch_res_nr_t*       data);
+
 SRSRAN_API int srsran_gnb_ul_get_pucch(srsran_gnb_ul_t*                    q,
                                        const srsran_slot_cfg_t*            slot_cfg,
                                        const srsran_pucch_nr_common_cfg_t* cfg,
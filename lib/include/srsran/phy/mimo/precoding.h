@@ -117,6 +117,27 @@ SRSRAN_API int srsran_precoding_pmi_select(cf_t*     h[SRSRAN_MAX_PORTS][SRSRAN_
                                            uint32_t* pmi,
                                            float     sinr[SRSRAN_MAX_CODEBOOKS]);
 
+/* Average channel covariance R = H' * H of a 2x2 channel, it is computed once from the channel estimate and all the
+ * codebook entries are evaluated on it */
+typedef struct SRSRAN_API {
+  cf_t     R[2][2];
+  uint32_t nof_re;
+} srsran_precoding_cov_t;
+
+/* Accumulates the channel covariance taking one every decimation resource elements (0 or 1 take all of them) */
+SRSRAN_API int srsran_precoding_cov_estimate(cf_t*                   h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                                             uint32_t                nof_symbols,
+                                             uint32_t                decimation,
+                                             srsran_precoding_cov_t* cov);
+
+/* Selects the PMI maximising the SINR from a covariance given by srsran_precoding_cov_estimate(), returns the number
+ * of evaluated codebooks */
+SRSRAN_API int srsran_precoding_pmi_select_cov(const srsran_precoding_cov_t* cov,
+                                               float                         noise_estimate,
+                                               int                           nof_layers,
+                                               uint32_t*                     pmi,
+                                               float                         sinr[SRSRAN_MAX_CODEBOOKS]);
+
 SRSRAN_API int srsran_precoding_cn(cf_t*    h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
                                    uint32_t nof_tx_antennas,
                                    uint32_t nof_rx_antennas,
@@ -42,4 +42,29 @@ SRSRAN_API int srsran_demod_soft_demodulate_s(srsran_mod_t modulation, const cf_
 
 SRSRAN_API int srsran_demod_soft_demodulate_b(srsran_mod_t modulation, const cf_t* symbols, int8_t* llr, int nsymbols);
 
+/**
+ * @brief Demodulates and descrambles the symbols in blocks small enough to stay in cache, it produces the same result
+ * as srsran_demod_soft_demodulate_s() followed by srsran_sequence_apply_s() in a single pass over the LLR buffer
+ * @param modulation Modulation of the symbols
+ * @param symbols Input symbols
+ * @param llr Output LLR, it must fit the bits of all the symbols
+ * @param nsymbols Number of symbols
+ * @param seed Scrambling sequence seed
+ * @return 0 if successful, -1 otherwise
+ */
+SRSRAN_API int srsran_demod_soft_demodulate_descramble_s(srsran_mod_t modulation,
+                                                         const cf_t*  symbols,
+                                                         short*       llr,
+                                                         int          nsymbols,
+                                                         uint32_t     seed);
+
+/**
+ * @brief Same as srsran_demod_soft_demodulate_descramble_s() with 8-bit LLR
+ */
+SRSRAN_API int srsran_demod_soft_demodulate_descramble_b(srsran_mod_t modulation,
+                                                         const cf_t*  symbols,
+                                                         int8_t*      llr,
+                                                         int          nsymbols,
+                                                         uint32_t     seed);
+
 #endif // SRSRAN_DEMOD_SOFT_H
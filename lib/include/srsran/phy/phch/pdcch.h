@@ -47,6 +47,17 @@
 
 typedef enum SRSRAN_API { SEARCH_UE, SEARCH_COMMON } srsran_pdcch_search_mode_t;
 
+/* Maximum number of decoded candidates kept between two calls to srsran_pdcch_extract_llr() */
+#define SRSRAN_PDCCH_MAX_DECODED_CANDIDATES 64
+
+/* Result of decoding one candidate, reused by any DCI format of the same size in the same location */
+typedef struct SRSRAN_API {
+  srsran_dci_location_t location;
+  uint32_t              nof_bits;
+  uint16_t              crc_rem;
+  uint8_t               payload[SRSRAN_DCI_MAX_BITS];
+} srsran_pdcch_decoded_t;
+
 /* PDCCH object */
 typedef struct SRSRAN_API {
   srsran_cell_t cell;
@@ -73,6 +84,11 @@ typedef struct SRSRAN_API {
   srsran_viterbi_t     decoder;
   srsran_crc_t         crc;
 
+  /* candidates decoded from the current LLRs */
+  srsran_pdcch_decoded_t decoded[SRSRAN_PDCCH_MAX_DECODED_CANDIDATES];
+  uint32_t               nof_decoded;
+  uint32_t               nof_decoded_hits;
+
 } srsran_pdcch_t;
 
 SRSRAN_API int srsran_pdcch_init_ue(srsran_pdcch_t* q, uint32_t max_prb, uint32_t nof_rx_antennas);
@@ -45,35 +45,49 @@
  * @brief PDCCH configuration initialization arguments
  */
 typedef struct {
-  bool disable_simd;
-  bool measure_evm;
-  bool measure_time;
+  bool     disable_simd;
+  bool     measure_evm;
+  bool     measure_time;
+  uint32_t polar_list_size; ///< Number of paths of the CRC-aided list polar decoder, 0 or 1 selects the SSC decoder
 } srsran_pdcch_nr_args_t;
 
+/**
+ * @brief Demodulated candidate, kept for the next decodes of the same location in the slot
+ */
+typedef struct {
+  uint32_t              coreset_id;
+  srsran_dci_location_t location;
+  float                 evm;
+  int8_t*               llr; ///< Demodulated and negated LLR, before descrambling
+} srsran_pdcch_nr_cache_t;
+
 /**
  * @brief PDCCH Attributes and objects required to encode/decode NR PDCCH
  */
 typedef struct SRSRAN_API {
-  bool                   is_tx;
-  srsran_polar_code_t    code;
-  srsran_polar_encoder_t encoder;
-  srsran_polar_decoder_t decoder;
-  srsran_polar_rm_t      rm;
-  srsran_carrier_nr_t    carrier;
-  srsran_coreset_t       coreset;
-  srsran_crc_t           crc24c;
-  uint8_t*               c;         // Message bits with attached CRC
-  uint8_t*               d;         // encoded bits
-  uint8_t*               f;         // bits at the Rate matching output
-  uint8_t*               allocated; // Allocated polar bit buffer, encoder input, decoder output
-  cf_t*                  symbols;
-  srsran_modem_table_t   modem_table;
-  srsran_evm_buffer_t*   evm_buffer;
-  bool                   meas_time_en;
-  uint32_t               meas_time_us;
-  uint32_t               K;
-  uint32_t               M;
-  uint32_t               E;
+  bool                    is_tx;
+  srsran_polar_code_t     code;
+  srsran_polar_encoder_t  encoder;
+  srsran_polar_decoder_t  decoder;
+  srsran_polar_rm_t       rm;
+  srsran_carrier_nr_t     carrier;
+  srsran_coreset_t        coreset;
+  srsran_crc_t            crc24c;
+  uint8_t*                c;         // Message bits with attached CRC
+  uint8_t*                d;         // encoded bits
+  uint8_t*                f;         // bits at the Rate matching output
+  uint8_t*                allocated; // Allocated polar bit buffer, encoder input, decoder output
+  cf_t*                   symbols;
+  srsran_modem_table_t    modem_table;
+  srsran_evm_buffer_t*    evm_buffer;
+  bool                    meas_time_en;
+  uint32_t                meas_time_us;
+  uint32_t                K;
+  uint32_t                M;
+  uint32_t                E;
+  bool                    cache_en;
+  uint32_t                cache_count;
+  srsran_pdcch_nr_cache_t cache[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR];
 } srsran_pdcch_nr_t;
 
 /**
@@ -137,6 +151,17 @@ srsran_pdcch_nr_set_carrier(srsran_pdcch_nr_t* q, const srsran_carrier_nr_t* car
 
 SRSRAN_API int srsran_pdcch_nr_encode(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_msg, cf_t* slot_symbols);
 
+/**
+ * @brief Enables and clears the cache of demodulated candidates
+ *
+ * The decodes that follow keep the demodulated LLR of every candidate. Decoding again the same CORESET and location,
+ * for another DCI size or RNTI, skips the extraction, equalization and demodulation. The resource grid and the
+ * channel estimates must not change until the next call, so it shall be called once the slot is estimated.
+ *
+ * @param[in,out] q PDCCH decoder object
+ */
+SRSRAN_API void srsran_pdcch_nr_cache_reset(srsran_pdcch_nr_t* q);
+
 /**
  * @brief Decodes a DCI
  *
@@ -75,6 +75,7 @@ typedef struct SRSRAN_API {
   srsran_sch_t dl_sch;
 
   void* coworker_ptr;
+  void* re_map_ptr;
 
 } srsran_pdsch_t;
 
@@ -110,11 +111,17 @@ SRSRAN_API int srsran_pdsch_decode(srsran_pdsch_t*        q,
                                    cf_t*                  sf_symbols[SRSRAN_MAX_PORTS],
                                    srsran_pdsch_res_t     data[SRSRAN_MAX_CODEWORDS]);
 
-SRSRAN_API int srsran_pdsch_select_pmi(srsran_pdsch_t*        q,
-                                       srsran_chest_dl_res_t* channel,
-                                       uint32_t               nof_layers,
-                                       uint32_t*              best_pmi,
-                                       float                  sinr[SRSRAN_MAX_CODEBOOKS]);
+SRSRAN_API int srsran_pdsch_compute_cov(srsran_pdsch_t*         q,
+                                        srsran_chest_dl_res_t*  channel,
+                                        uint32_t                decimation,
+                                        srsran_precoding_cov_t* cov);
+
+SRSRAN_API int srsran_pdsch_select_pmi(srsran_pdsch_t*               q,
+                                       srsran_chest_dl_res_t*        channel,
+                                       const srsran_precoding_cov_t* cov,
+                                       uint32_t                      nof_layers,
+                                       uint32_t*                     best_pmi,
+                                       float                         sinr[SRSRAN_MAX_CODEBOOKS]);
 
 SRSRAN_API int srsran_pdsch_compute_cn(srsran_pdsch_t* q, srsran_chest_dl_res_t* channel, float* cn);
 
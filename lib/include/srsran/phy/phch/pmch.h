@@ -90,6 +90,16 @@ SRSRAN_API void srsran_pmch_free_area_id(srsran_pmch_t* q, uint16_t area_id);
 
 SRSRAN_API void srsran_configure_pmch(srsran_pmch_cfg_t* pmch_cfg, srsran_cell_t* cell, srsran_mbsfn_cfg_t* mbsfn_cfg);
 
+/* Encodes, scrambles and modulates the MCH transport block into q->d. The symbols only depend on the MBSFN area and
+ * the grant, so that they can be mapped into every cell of the area with srsran_pmch_put_symbols() */
+SRSRAN_API int srsran_pmch_encode_symbols(srsran_pmch_t* q, srsran_dl_sf_cfg_t* sf, srsran_pmch_cfg_t* cfg, uint8_t* data);
+
+SRSRAN_API int srsran_pmch_put_symbols(srsran_pmch_t*      q,
+                                       srsran_dl_sf_cfg_t* sf,
+                                       srsran_pmch_cfg_t*  cfg,
+                                       const cf_t*         symbols,
+                                       cf_t*               sf_symbols[SRSRAN_MAX_PORTS]);
+
 SRSRAN_API int srsran_pmch_encode(srsran_pmch_t*      q,
                                   srsran_dl_sf_cfg_t* sf,
                                   srsran_pmch_cfg_t*  cfg,
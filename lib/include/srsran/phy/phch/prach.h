@@ -119,6 +119,10 @@ typedef struct SRSRAN_API {
   cf_t                        sub[839 * 2];
   float                       phase[839];
 
+  // Detection results of every root and root correlation worker pool, NULL if all roots are correlated in the caller
+  void* root_corr;
+  void* corr_pool;
+
 } srsran_prach_t;
 
 typedef struct SRSRAN_API {
@@ -236,6 +240,13 @@ SRSRAN_API int srsran_prach_detect_offset(srsran_prach_t* p,
 
 SRSRAN_API void srsran_prach_set_detect_factor(srsran_prach_t* p, float factor);
 
+/**
+ * Starts nof_workers threads that correlate the received preamble bins with the root sequences, in parallel with the
+ * thread calling srsran_prach_detect_offset(). Zero stops the threads and correlates all the roots in the caller.
+ * It must be called after srsran_prach_init().
+ */
+SRSRAN_API int srsran_prach_set_nof_workers(srsran_prach_t* p, uint32_t nof_workers);
+
 SRSRAN_API int srsran_prach_free(srsran_prach_t* p);
 
 SRSRAN_API int srsran_prach_print_seqs(srsran_prach_t* p);
@@ -119,6 +119,13 @@ SRSRAN_API int srsran_pusch_decode(srsran_pusch_t*        q,
                                    cf_t*                  sf_symbols,
                                    srsran_pusch_res_t*    data);
 
+/**
+ * Returns the maximum number of turbo decoder (half) iterations for a grant given the measured SNR. When the SNR is
+ * well above the one needed by the grant spectral efficiency, the blocks decode in one or two iterations or do not
+ * decode at all, so max_nof_iterations is reduced. It returns max_nof_iterations if max_nof_iterations_snr is not set.
+ */
+SRSRAN_API uint32_t srsran_pusch_max_nof_iterations(const srsran_pusch_cfg_t* cfg, float snr_db);
+
 SRSRAN_API uint32_t srsran_pusch_grant_tx_info(srsran_pusch_grant_t* grant,
                                                srsran_uci_cfg_t*     uci_cfg,
                                                srsran_uci_value_t*   uci_data,
@@ -65,6 +65,8 @@ typedef struct SRSRAN_API {
   srsran_pusch_grant_t    grant;
 
   uint32_t max_nof_iterations;
+  bool     max_nof_iterations_snr; // Reduces max_nof_iterations when the SNR is well above the grant needs
+  bool     early_termination;      // Stops the turbo decoder when the hard decision converges
   uint32_t last_O_cqi;
   uint32_t K_segm;
   uint32_t current_tx_nb;
@@ -87,6 +87,14 @@ SRSRAN_API int srsran_ra_dl_nr_slot_nof_re(const srsran_sch_cfg_nr_t* pdsch_cfg,
  */
 SRSRAN_API uint32_t srsran_ra_nr_tbs(uint32_t N_re, double S, double R, uint32_t Qm, uint32_t nof_layers);
 
+/**
+ * @brief Calculates the number of CRC bits added to a transport block, the TB CRC and the code block CRCs
+ * @param tbs Transport block size in bits
+ * @param R Target Rate, used for selecting the LDPC base graph
+ * @return The number of CRC bits
+ */
+SRSRAN_API uint32_t srsran_ra_nr_nof_crc_bits(uint32_t tbs, double R);
+
 SRSRAN_API int srsran_ra_nr_fill_tb(const srsran_sch_cfg_nr_t*   pdsch_cfg,
                                     const srsran_sch_grant_nr_t* grant,
                                     uint32_t                     mcs_idx,
@@ -52,6 +52,7 @@ typedef struct SRSRAN_API {
 typedef struct SRSRAN_API {
   uint32_t            nof_regs;
   srsran_regs_reg_t** regs;
+  uint32_t*           re_idx; // Resource grid index of every RE of the REGs, in mapping order (PDCCH only)
 } srsran_regs_ch_t;
 
 typedef struct SRSRAN_API {
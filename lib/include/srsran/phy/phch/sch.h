@@ -32,10 +32,13 @@
 
 #include "srsran/config.h"
 #include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/common/sequence.h"
 #include "srsran/phy/fec/crc.h"
 #include "srsran/phy/fec/turbo/rm_turbo.h"
 #include "srsran/phy/fec/turbo/turbocoder.h"
 #include "srsran/phy/fec/turbo/turbodecoder.h"
+#include "srsran/phy/fec/turbo/turbodecoder_batch.h"
+#include "srsran/phy/modem/modem_table.h"
 #include "srsran/phy/phch/pdsch_cfg.h"
 #include "srsran/phy/phch/pusch_cfg.h"
 #include "srsran/phy/phch/uci.h"
@@ -48,11 +51,28 @@
 #define SRSRAN_TX_NULL 100
 #endif
 
+#define SRSRAN_SCH_MAX_DEFERRED_TB 64
+#define SRSRAN_SCH_MAX_DEFERRED_CB (4 * SRSRAN_MAX_CODEBLOCKS)
+
+/* Transport block waiting for the deferred turbo decoding */
+typedef struct SRSRAN_API {
+  srsran_softbuffer_rx_t* softbuffer;
+  srsran_cbsegm_t         cb_segm;
+  uint8_t*                data;
+  bool*                   crc;
+  float*                  avg_iterations;
+  uint32_t                cb_offset;
+  uint32_t                nof_cb;
+  uint32_t                noi;
+  uint8_t                 cb_idx[SRSRAN_MAX_CODEBLOCKS];
+} srsran_sch_deferred_tb_t;
+
 /* DL-SCH AND UL-SCH common functions */
 typedef struct SRSRAN_API {
 
   uint32_t max_iterations;
   float    avg_iterations;
+  bool     early_termination;
 
   bool llr_is_8bit;
 
@@ -71,6 +91,16 @@ typedef struct SRSRAN_API {
 
   srsran_uci_cqi_pusch_t uci_cqi;
 
+  /* Deferred decoding, code blocks of several transport blocks are decoded together */
+  bool                     deferred_decoding;
+  srsran_tdec_batch_t      batch;
+  uint8_t*                 deferred_data;
+  uint32_t                 deferred_max_iterations;
+  uint32_t                 nof_deferred_tb;
+  uint32_t                 nof_deferred_cb;
+  srsran_sch_deferred_tb_t deferred_tb[SRSRAN_SCH_MAX_DEFERRED_TB];
+  srsran_tdec_batch_cb_t   deferred_cb[SRSRAN_SCH_MAX_DEFERRED_CB];
+
 } srsran_sch_t;
 
 SRSRAN_API int srsran_sch_init(srsran_sch_t* q);
@@ -81,6 +111,24 @@ SRSRAN_API void srsran_sch_set_max_noi(srsran_sch_t* q, uint32_t max_iterations)
 
 SRSRAN_API float srsran_sch_last_noi(srsran_sch_t* q);
 
+/**
+ * Enables or disables the early termination of the turbo decoder. When enabled, a code block stops decoding if its
+ * hard decision did not change in the last half iteration, even if its CRC does not match yet.
+ */
+SRSRAN_API void srsran_sch_set_early_termination(srsran_sch_t* q, bool enable);
+
+/**
+ * Enables or disables the deferred decoding of 8-bit LLR transport blocks. When enabled, srsran_ulsch_decode_deferred()
+ * only rate-dematches the code blocks, and the turbo decoding of all of them is run by srsran_sch_decode_deferred().
+ */
+SRSRAN_API int srsran_sch_enable_deferred_decoding(srsran_sch_t* q, bool enable);
+
+/**
+ * Decodes all the pending transport blocks and writes their CRC result and average number of iterations.
+ * @return The number of decoded transport blocks or SRSRAN_ERROR
+ */
+SRSRAN_API int srsran_sch_decode_deferred(srsran_sch_t* q);
+
 SRSRAN_API int srsran_dlsch_encode(srsran_sch_t* q, srsran_pdsch_cfg_t* cfg, uint8_t* data, uint8_t* e_bits);
 
 SRSRAN_API int srsran_dlsch_encode2(srsran_sch_t*       q,
@@ -90,6 +138,24 @@ SRSRAN_API int srsran_dlsch_encode2(srsran_sch_t*       q,
                                     int                 codeword_idx,
                                     uint32_t            nof_layers);
 
+/**
+ * Encodes a codeword like srsran_dlsch_encode2() and, as soon as each code block is rate matched, scrambles its bits
+ * and maps them to modulation symbols while they are still in cache.
+ * @param scrambler Scrambling sequence state, it is advanced by the number of encoded bits
+ * @param modem Modulation table, it shall have the byte tables initialised
+ * @param symbols Output modulation symbols
+ * @return SRSRAN_SUCCESS or an error code
+ */
+SRSRAN_API int srsran_dlsch_encode2_modulate(srsran_sch_t*               q,
+                                             srsran_pdsch_cfg_t*         cfg,
+                                             uint8_t*                    data,
+                                             uint8_t*                    e_bits,
+                                             int                         codeword_idx,
+                                             uint32_t                    nof_layers,
+                                             srsran_sequence_state_t*    scrambler,
+                                             const srsran_modem_table_t* modem,
+                                             cf_t*                       symbols);
+
 SRSRAN_API int srsran_dlsch_decode(srsran_sch_t* q, srsran_pdsch_cfg_t* cfg, int16_t* e_bits, uint8_t* data);
 
 SRSRAN_API int srsran_dlsch_decode2(srsran_sch_t*       q,
@@ -114,6 +180,21 @@ SRSRAN_API int srsran_ulsch_decode(srsran_sch_t*       q,
                                    uint8_t*            data,
                                    srsran_uci_value_t* uci_data);
 
+/**
+ * Same as srsran_ulsch_decode() but the turbo decoding is deferred to srsran_sch_decode_deferred() if enabled. The CRC
+ * result and average number of iterations are written once the transport block is decoded. The data, softbuffer, crc
+ * and avg_iterations pointers must remain valid until then. UCI values are decoded immediately.
+ */
+SRSRAN_API int srsran_ulsch_decode_deferred(srsran_sch_t*       q,
+                                            srsran_pusch_cfg_t* cfg,
+                                            int16_t*            q_bits,
+                                            int16_t*            g_bits,
+                                            uint8_t*            c_seq,
+                                            uint8_t*            data,
+                                            srsran_uci_value_t* uci_data,
+                                            bool*               crc,
+                                            float*              avg_iterations);
+
 SRSRAN_API float srsran_sch_beta_cqi(uint32_t I_cqi);
 
 SRSRAN_API float srsran_sch_beta_ack(uint32_t I_harq);
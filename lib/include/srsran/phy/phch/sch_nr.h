@@ -76,16 +76,23 @@ typedef struct SRSRAN_API {
   /// LDPC Rate matcher
   srsran_ldpc_rm_t tx_rm;
   srsran_ldpc_rm_t rx_rm;
+
+  /// Code block decoder worker pool, NULL if the code blocks are decoded in the caller thread only
+  void* cb_pool;
 } srsran_sch_nr_t;
 
 /**
  * @brief SCH encoder and decoder initialization arguments
  */
 typedef struct SRSRAN_API {
-  bool     disable_simd;
-  bool     decoder_use_flooded;
-  float    decoder_scaling_factor;
-  uint32_t max_nof_iter; ///< Maximum number of LDPC iterations
+  bool                    disable_simd;
+  bool                    decoder_use_flooded;
+  float                   decoder_scaling_factor;
+  uint32_t                max_nof_iter;           ///< Maximum number of LDPC iterations
+  bool                    decoder_offset_min_sum; ///< Use the offset min-sum algorithm instead of the scaled one
+  bool                    decoder_early_stop;     ///< Stop the layered LDPC decoder when the checks and the CRC pass
+  uint32_t                nof_cb_workers;         ///< Number of extra threads decoding the CBs of a TB, 0 for none
+  srsran_ldpc_rm_cache_t* rm_cache;               ///< Rate dematching index map cache, it can be shared. NULL for none
 } srsran_sch_nr_args_t;
 
 /**
@@ -145,6 +152,11 @@ SRSRAN_API int srsran_sch_nr_init_tx(srsran_sch_nr_t* q, const srsran_sch_nr_arg
 
 /**
  * @brief Initialises an SCH object as receiver
+ *
+ * If args->nof_cb_workers is not zero, it also starts a pool of threads with their own decoders. The code blocks of a
+ * transport block are then shared between the pool and the caller thread. Every code block writes only its own
+ * soft-buffer entries, so the soft-buffer semantics are unchanged.
+ *
  * @param q Points ats the SCH object
  * @param args Provides static configuration arguments
  * @return SRSRAN_SUCCESS if the initialization is successful, SRSRAN_ERROR otherwise
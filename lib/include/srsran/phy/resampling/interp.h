@@ -91,14 +91,18 @@ SRSRAN_API void srsran_interp_linear_vector3(srsran_interp_linsrsran_vec_t* q,
 
 /* Interpolation within a vector */
 
+/* Interpolation kernel specialised for one (vector_len, M) pair, writes (vector_len - 1) * M samples */
+typedef void (*srsran_interp_lin_kernel_t)(const cf_t* input, cf_t* output);
+
 typedef struct {
-  cf_t*    diff_vec;
-  cf_t*    diff_vec2;
-  float*   ramp;
-  uint32_t vector_len;
-  uint32_t M;
-  uint32_t max_vector_len;
-  uint32_t max_M;
+  cf_t*                      diff_vec;
+  cf_t*                      diff_vec2;
+  float*                     ramp;
+  uint32_t                   vector_len;
+  uint32_t                   M;
+  uint32_t                   max_vector_len;
+  uint32_t                   max_M;
+  srsran_interp_lin_kernel_t fixed_kernel; // Selected on init/resize, NULL when the generic path is used
 } srsran_interp_lin_t;
 
 SRSRAN_API int srsran_interp_linear_init(srsran_interp_lin_t* q, uint32_t vector_len, uint32_t M);
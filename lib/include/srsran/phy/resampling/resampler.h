@@ -106,6 +106,75 @@ SRSRAN_API void srsran_resampler_fft_run(srsran_resampler_fft_t* q, const cf_t*
  */
 SRSRAN_API void srsran_resampler_fft_free(srsran_resampler_fft_t* q);
 
+/**
+ * @brief Rational ratio polyphase resampler internal buffers. The output rate is interp / decim times the input rate.
+ */
+typedef struct {
+  uint32_t interp;   ///< Interpolation factor
+  uint32_t decim;    ///< Decimation factor
+  uint32_t nof_taps; ///< Number of taps of each polyphase branch
+  uint32_t phase;    ///< Position of the next output sample in the interpolated grid, relative to the next input
+  cf_t*    bank;     ///< Polyphase filter bank, the real taps of each branch are stored in reverse order
+  cf_t*    buffer;   ///< Filter history followed by the block being processed
+} srsran_resampler_poly_t;
+
+/**
+ * Initialise a polyphase resampler for the ratio interp / decim, the filter bank is designed here so it is not
+ * suitable for real-time calls. The ratio is reduced to its irreducible form. The object must be zeroed before the
+ * first initialisation, later calls with the same ratio only reset the state.
+ * @param q Object pointer
+ * @param interp Interpolation factor
+ * @param decim Decimation factor
+ * @return SRSRAN_SUCCES if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int srsran_resampler_poly_init(srsran_resampler_poly_t* q, uint32_t interp, uint32_t decim);
+
+/**
+ * @brief resets internal re-sampler state
+ * @param q Object pointer
+ */
+SRSRAN_API void srsran_resampler_poly_reset_state(srsran_resampler_poly_t* q);
+
+/**
+ * Get delay from the polyphase resampler.
+ * @param q Object pointer
+ * @return the delay in number of output samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_get_delay(srsran_resampler_poly_t* q);
+
+/**
+ * Get the minimum number of input samples the next srsran_resampler_poly_run() call needs for producing nof_output
+ * output samples. When decimating (decim >= interp) it produces exactly nof_output samples.
+ * @param q Object pointer
+ * @param nof_output Number of desired output samples
+ * @return the number of input samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_get_nof_input(srsran_resampler_poly_t* q, uint32_t nof_output);
+
+/**
+ * @brief Run the polyphase resampler. The number of output samples depends on the internal state, it is at most
+ * ceil(nsamples * interp / decim).
+ *
+ * @note Setting the input to NULL is equivalent of feeding zeroes
+ * @note Setting the output to NULL is equivalent of dropping output samples
+ *
+ * @param q Object pointer, make sure it has been initialised
+ * @param input Points at the input complex buffer
+ * @param output Points at the output complex buffer
+ * @param nsamples Number of input samples
+ * @return the number of output samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_run(srsran_resampler_poly_t* q,
+                                              const cf_t*              input,
+                                              cf_t*                    output,
+                                              uint32_t                 nsamples);
+
+/**
+ * Free polyphase resampler buffers
+ * @param q  Object pointer
+ */
+SRSRAN_API void srsran_resampler_poly_free(srsran_resampler_poly_t* q);
+
 #ifdef __cplusplus
 }
 #endif
@@ -137,6 +137,15 @@ SRSRAN_API int srsran_pss_set_N_id_2(srsran_pss_t* q, uint32_t N_id_2);
 
 SRSRAN_API int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_value);
 
+/* Same as srsran_pss_find_pss() for several PSS objects looking at the same input, e.g. the integer CFO or N_id_2
+ * hypotheses. The input is transformed once and each hypothesis only costs its product and inverse transform. The
+ * peak positions are written in peak_pos, corr_peak_value is optional */
+SRSRAN_API int srsran_pss_find_pss_multi(srsran_pss_t* q[],
+                                         uint32_t      nof_pss,
+                                         const cf_t*   input,
+                                         int           peak_pos[],
+                                         float         corr_peak_value[]);
+
 SRSRAN_API int srsran_pss_chest(srsran_pss_t* q, const cf_t* input, cf_t ce[SRSRAN_PSS_LEN]);
 
 SRSRAN_API float srsran_pss_cfo_compute(srsran_pss_t* q, const cf_t* pss_recv);
@@ -60,6 +60,7 @@ typedef struct SRSRAN_API {
   bool                        enable_decode;      ///< Enables PBCH Decoder
   bool                        disable_polar_simd; ///< Disables polar encoder/decoder SIMD acceleration
   float                       pbch_dmrs_thr;      ///< NR-PBCH DMRS threshold for blind decoding, set to 0 for default
+  uint32_t                    polar_list_size;    ///< NR-PBCH list polar decoder paths, 0 or 1 selects the SSC decoder
 } srsran_ssb_args_t;
 
 /**
@@ -276,6 +277,27 @@ SRSRAN_API int srsran_ssb_find(srsran_ssb_t*                  q,
                                srsran_csi_trs_measurements_t* meas,
                                srsran_pbch_msg_nr_t*          pbch_msg);
 
+/**
+ * @brief Same as srsran_ssb_find() but the PSS is only correlated around the expected position of a known SSB candidate,
+ * typically a single correlation instead of one per correlation window of the subframe. Only the subframes carrying the
+ * candidate need to be given.
+ * @param q SSB object
+ * @param sf_buffer subframe buffer with 1ms worth of samples
+ * @param N_id Physical cell identifier to find
+ * @param ssb_idx Expected SSB candidate index
+ * @param max_delay Maximum timing error in samples, on either side of the expected position
+ * @param meas Measurements performed on the found peak
+ * @param pbch_msg PBCH decoded message
+ * @return SRSRAN_SUCCESS if the parameters are valid, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_ssb_find_window(srsran_ssb_t*                  q,
+                                      const cf_t*                    sf_buffer,
+                                      uint32_t                       N_id,
+                                      uint32_t                       ssb_idx,
+                                      uint32_t                       max_delay,
+                                      srsran_csi_trs_measurements_t* meas,
+                                      srsran_pbch_msg_nr_t*          pbch_msg);
+
 /**
  * @brief Track SSB by performing measurements and decoding PBCH
  * @param q SSB object
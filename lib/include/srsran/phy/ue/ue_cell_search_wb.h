@@ -0,0 +1,148 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         ue_cell_search_wb.h
+ *
+ *  Description:  Wideband cell search.
+ *
+ *                Searches several LTE carriers in a single wideband capture.
+ *                Every sub-channel is shifted to base-band and decimated to
+ *                SRSRAN_CS_SAMP_FREQ with a polyphase resampler, then it is
+ *                scanned by its own ue_cellsearch object. The sub-channels are
+ *                processed in parallel by a set of worker threads.
+ *
+ *  Reference:
+ *****************************************************************************/
+
+#ifndef SRSRAN_UE_CELL_SEARCH_WB_H
+#define SRSRAN_UE_CELL_SEARCH_WB_H
+
+#include <pthread.h>
+
+#include "srsran/config.h"
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/ue/ue_cell_search.h"
+
+/**
+ * @brief Bandwidth kept around each sub-channel centre, it must fit in the capture bandwidth
+ */
+#define SRSRAN_CS_WB_CHANNEL_BW_HZ SRSRAN_CS_SAMP_FREQ
+
+/**
+ * @brief Cell search results of one sub-channel
+ */
+typedef struct SRSRAN_API {
+  float                         freq_offset_hz;                 ///< Sub-channel centre relative to the capture centre
+  uint32_t                      nof_detected;                   ///< Number of N_id_2 with a detected cell
+  uint32_t                      max_N_id_2;                     ///< N_id_2 with the strongest correlation peak
+  srsran_ue_cellsearch_result_t found_cells[SRSRAN_NOF_NID_2]; ///< Results for every N_id_2
+} srsran_ue_cellsearch_wb_result_t;
+
+/**
+ * @brief Internal state of one sub-channel
+ */
+typedef struct SRSRAN_API {
+  float                   freq_offset_hz; ///< Sub-channel centre relative to the capture centre
+  srsran_resampler_poly_t resampler;      ///< Decimator from the capture rate to SRSRAN_CS_SAMP_FREQ
+  srsran_ue_cellsearch_t  cs;             ///< Cell search fed from buffer
+  bool                    cs_initiated;   ///< Set once cs is initialised
+  cf_t*                   mix;            ///< Frequency shifted block of the capture
+  cf_t*                   buffer;         ///< Sub-channel samples at SRSRAN_CS_SAMP_FREQ
+  uint32_t                nof_samples;    ///< Number of valid samples in buffer
+  uint32_t                read_idx;       ///< Next sample of buffer delivered to the cell search
+} srsran_ue_cellsearch_wb_channel_t;
+
+typedef struct SRSRAN_API {
+  double                             srate_hz;     ///< Capture sampling rate
+  uint32_t                           max_samples;  ///< Maximum capture length
+  uint32_t                           max_channels; ///< Number of allocated sub-channels
+  uint32_t                           nof_channels; ///< Number of sub-channels to scan
+  uint32_t                           nof_threads;  ///< Number of worker threads
+  srsran_ue_cellsearch_wb_channel_t* channels;
+  pthread_t*                         threads;
+
+  // Scan context shared by the workers
+  pthread_mutex_t                   mutex;
+  const cf_t*                       capture;
+  uint32_t                          capture_len;
+  srsran_ue_cellsearch_wb_result_t* results;
+  uint32_t                          next_channel;
+  int                               ret;
+} srsran_ue_cellsearch_wb_t;
+
+/**
+ * @brief Initialises a wideband cell search. The filter banks and the cell search objects of every sub-channel are
+ * created here, so it is not suitable for real-time calls.
+ * @param q Object pointer
+ * @param srate_hz Capture sampling rate, its ratio to SRSRAN_CS_SAMP_FREQ must be supported by the polyphase resampler
+ * @param max_samples Maximum number of samples of the captures given to srsran_ue_cellsearch_wb_scan()
+ * @param max_channels Maximum number of sub-channels
+ * @param max_frames Maximum number of 5 ms frames scanned for every N_id_2, see srsran_ue_cellsearch_init_multi()
+ * @param nof_threads Number of worker threads, 0 or 1 scans the sub-channels in the calling thread
+ * @return SRSRAN_SUCCESS if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int srsran_ue_cellsearch_wb_init(srsran_ue_cellsearch_wb_t* q,
+                                            double                     srate_hz,
+                                            uint32_t                   max_samples,
+                                            uint32_t                   max_channels,
+                                            uint32_t                   max_frames,
+                                            uint32_t                   nof_threads);
+
+SRSRAN_API void srsran_ue_cellsearch_wb_free(srsran_ue_cellsearch_wb_t* q);
+
+/**
+ * @brief Sets the sub-channels to scan. Every sub-channel must fit in the capture bandwidth together with
+ * SRSRAN_CS_WB_CHANNEL_BW_HZ.
+ * @param q Object pointer
+ * @param freq_offset_hz Centre of every sub-channel relative to the capture centre, e.g. the EARFCN frequencies minus
+ * the RF centre frequency
+ * @param nof_channels Number of sub-channels
+ * @return SRSRAN_SUCCESS if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int
+srsran_ue_cellsearch_wb_set_channels(srsran_ue_cellsearch_wb_t* q, const float* freq_offset_hz, uint32_t nof_channels);
+
+/**
+ * @brief Sets the number of frames with a detected cell that finish the scan of an N_id_2 in every sub-channel
+ */
+SRSRAN_API int srsran_ue_cellsearch_wb_set_nof_valid_frames(srsran_ue_cellsearch_wb_t* q, uint32_t nof_frames);
+
+/**
+ * @brief Enables the CP detection in every sub-channel
+ */
+SRSRAN_API void srsran_ue_cellsearch_wb_set_detect_cp(srsran_ue_cellsearch_wb_t* q, bool enable);
+
+/**
+ * @brief Scans all the sub-channels in a capture for the three N_id_2. Each sub-channel is read cyclically for as long
+ * as its cell search needs, so captures of a whole number of radio frames wrap without a timing jump.
+ * @param q Object pointer
+ * @param capture Wideband samples, at the rate given in srsran_ue_cellsearch_wb_init()
+ * @param nof_samples Number of samples in the capture, up to max_samples
+ * @param results Results of every sub-channel, in the order given to srsran_ue_cellsearch_wb_set_channels()
+ * @return The total number of detected cells if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int srsran_ue_cellsearch_wb_scan(srsran_ue_cellsearch_wb_t*       q,
+                                            const cf_t*                      capture,
+                                            uint32_t                         nof_samples,
+                                            srsran_ue_cellsearch_wb_result_t results[]);
+
+#endif // SRSRAN_UE_CELL_SEARCH_WB_H
@@ -123,6 +123,7 @@ typedef struct SRSRAN_API {
   srsran_chest_dl_cfg_t chest_cfg;
   uint32_t              last_ri;
   float                 snr_to_cqi_offset;
+  uint32_t              pmi_decimation; // PMI selection takes one every pmi_decimation RE, 0 takes all of them
 } srsran_ue_dl_cfg_t;
 
 typedef struct {
@@ -172,6 +173,10 @@ SRSRAN_API void srsran_ue_dl_set_mi_manual(srsran_ue_dl_t* q, uint32_t mi_idx);
 
 SRSRAN_API void srsran_ue_dl_set_mi_auto(srsran_ue_dl_t* q);
 
+/* Sets the CFO in Hz that the OFDM demodulators remove from the following subframes. It replaces a separate CFO
+ * correction pass over the received subframe, see srsran_ofdm_set_cfo() */
+SRSRAN_API void srsran_ue_dl_set_cfo(srsran_ue_dl_t* q, float cfo_hz);
+
 /* Perform signal demodulation and channel estimation and store signals in the object */
 SRSRAN_API int srsran_ue_dl_decode_fft_estimate(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_ue_dl_cfg_t* cfg);
 
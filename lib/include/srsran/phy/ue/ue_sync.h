@@ -142,6 +142,10 @@ typedef struct SRSRAN_API {
   float mean_sample_offset; 
   uint32_t sample_offset_correct_period;
   float sfo_ema; 
+
+  uint32_t track_period;     ///< PSS occasions between tracked ones once the timing is stable, 0 tracks all of them
+  uint32_t track_stable_cnt; ///< Consecutive tracked PSS within the stable time offset
+  uint32_t track_skip_cnt;   ///< PSS occasions since the last tracked one
   
 
   #ifdef MEASURE_EXEC_TIME
@@ -257,6 +261,15 @@ SRSRAN_API void srsran_ue_sync_set_sfo_correct_period(srsran_ue_sync_t* q, uint3
 
 SRSRAN_API void srsran_ue_sync_set_sfo_ema(srsran_ue_sync_t* q, float ema_coefficient);
 
+/**
+ * @brief Sets the adaptive tracking period. Once the PSS timing and CFO are stable, only one PSS every nof_pss occasions
+ * is tracked, relying on the cyclic prefix and the channel estimator time error correction in between. Any drift or
+ * lost peak returns to tracking every PSS occasion.
+ * @param q UE synchronization object
+ * @param nof_pss Number of PSS occasions (5 ms each) per tracked PSS, 0 or 1 track every PSS
+ */
+SRSRAN_API void srsran_ue_sync_set_track_period(srsran_ue_sync_t* q, uint32_t nof_pss);
+
 SRSRAN_API void srsran_ue_sync_get_last_timestamp(srsran_ue_sync_t* q, srsran_timestamp_t* timestamp);
 
 SRSRAN_API int srsran_ue_sync_run_find_pss_mode(srsran_ue_sync_t* q, cf_t* input_buffer[SRSRAN_MAX_CHANNELS]);
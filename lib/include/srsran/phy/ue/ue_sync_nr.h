@@ -76,6 +76,7 @@ typedef struct SRSRAN_API {
   uint32_t                      sf_idx;                ///< Current subframe index (0-9)
   uint32_t                      sfn;                   ///< Current system frame number (0-1023)
   srsran_csi_trs_measurements_t feedback;              ///< Feedback measurements
+  uint32_t                      find_window_cnt;       ///< SSB opportunities left for searching around the last timing
 
   // Components
   srsran_ssb_t ssb;        ///< SSB internal object
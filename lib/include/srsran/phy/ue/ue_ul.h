@@ -99,9 +99,10 @@ typedef struct SRSRAN_API {
   srsran_ofdm_t fft;
   srsran_cfo_t  cfo;
 
-  srsran_refsignal_ul_t             signals;
-  srsran_refsignal_ul_dmrs_pregen_t pregen_dmrs;
-  srsran_refsignal_srs_pregen_t     pregen_srs;
+  srsran_refsignal_ul_t               signals;
+  srsran_refsignal_ul_dmrs_pregen_t   pregen_dmrs;
+  srsran_refsignal_srs_pregen_t       pregen_srs;
+  srsran_refsignal_dmrs_pucch_cache_t pucch_dmrs_cache;
 
   srsran_pusch_t pusch;
   srsran_pucch_t pucch;
@@ -65,6 +65,19 @@ SRSRAN_API void srsran_mat_2x2_mmse_csi_gen(cf_t   y0,
                                             float  noise_estimate,
                                             float  norm);
 
+/* Maximum number of receive antennas and layers of the NxL solvers */
+#define SRSRAN_MAT_NXL_MAX 4
+
+/* Generic implementation for the NxL MMSE solver, up to 4 receive antennas and 4 layers. It solves
+ * (H' x H + No) x X = H' x Y with an LDL' (square root free Cholesky) decomposition, ZF when No is zero */
+SRSRAN_API void srsran_mat_NxL_mmse_gen(const cf_t* y,
+                                        cf_t        h[SRSRAN_MAT_NXL_MAX][SRSRAN_MAT_NXL_MAX],
+                                        cf_t*       x,
+                                        uint32_t    nof_rxant,
+                                        uint32_t    nof_layers,
+                                        float       noise_estimate,
+                                        float       norm);
+
 SRSRAN_API int srsran_mat_2x2_cn(cf_t h00, cf_t h01, cf_t h10, cf_t h11, float* cn);
 
 #ifdef LV_HAVE_SSE
@@ -203,6 +216,75 @@ static inline void srsran_mat_2x2_mmse_simd(simd_cf_t  y0,
   srsran_mat_2x2_mmse_csi_simd(y0, y1, h00, h01, h10, h11, x0, x1, &csi0, &csi1, noise_estimate, norm);
 }
 
+/* Generic SIMD implementation for the NxL MMSE solver, it takes the same steps as srsran_mat_NxL_mmse_gen() for every
+ * element of the registers. h[i][j] is the channel from the layer j to the receive antenna i */
+static inline void srsran_mat_NxL_mmse_simd(const simd_cf_t* y,
+                                            simd_cf_t        h[SRSRAN_MAT_NXL_MAX][SRSRAN_MAT_NXL_MAX],
+                                            simd_cf_t*       x,
+                                            uint32_t         nof_rxant,
+                                            uint32_t         nof_layers,
+                                            float            noise_estimate,
+                                            float            norm)
+{
+  simd_cf_t a[SRSRAN_MAT_NXL_MAX][SRSRAN_MAT_NXL_MAX];
+  simd_f_t  d[SRSRAN_MAT_NXL_MAX];
+  simd_f_t  d_rcp[SRSRAN_MAT_NXL_MAX];
+  simd_cf_t z[SRSRAN_MAT_NXL_MAX];
+
+  /* 1. Lower triangle of A = H' x H and Z = H' x Y */
+  for (uint32_t i = 0; i < nof_layers; i++) {
+    z[i] = srsran_simd_cf_zero();
+    for (uint32_t j = 0; j <= i; j++) {
+      a[i][j] = srsran_simd_cf_zero();
+    }
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      z[i] = srsran_simd_cf_add(z[i], srsran_simd_cf_conjprod(y[r], h[r][i]));
+      for (uint32_t j = 0; j <= i; j++) {
+        a[i][j] = srsran_simd_cf_add(a[i][j], srsran_simd_cf_conjprod(h[r][j], h[r][i]));
+      }
+    }
+  }
+
+  /* 2. A + No = L x D x L', L is unit lower triangular and it overwrites A */
+  for (uint32_t j = 0; j < nof_layers; j++) {
+    d[j] = srsran_simd_f_add(srsran_simd_cf_re(a[j][j]), srsran_simd_f_set1(noise_estimate));
+    for (uint32_t k = 0; k < j; k++) {
+      simd_f_t l2 = srsran_simd_cf_re(srsran_simd_cf_conjprod(a[j][k], a[j][k]));
+      d[j]        = srsran_simd_f_sub(d[j], srsran_simd_f_mul(l2, d[k]));
+    }
+
+    /* One Newton-Raphson iteration refines the reciprocal estimate */
+    simd_f_t r = srsran_simd_f_rcp(d[j]);
+    d_rcp[j]   = srsran_simd_f_mul(r, srsran_simd_f_sub(srsran_simd_f_set1(2.0f), srsran_simd_f_mul(d[j], r)));
+
+    for (uint32_t i = j + 1; i < nof_layers; i++) {
+      for (uint32_t k = 0; k < j; k++) {
+        a[i][j] = srsran_simd_cf_sub(a[i][j], srsran_simd_cf_mul(srsran_simd_cf_conjprod(a[i][k], a[j][k]), d[k]));
+      }
+      a[i][j] = srsran_simd_cf_mul(a[i][j], d_rcp[j]);
+    }
+  }
+
+  /* 3. Forward substitution, L x Z' = Z */
+  for (uint32_t i = 1; i < nof_layers; i++) {
+    for (uint32_t k = 0; k < i; k++) {
+      z[i] = srsran_simd_cf_sub(z[i], srsran_simd_cf_prod(a[i][k], z[k]));
+    }
+  }
+
+  /* 4. Backward substitution, L' x X = inv(D) x Z' */
+  simd_f_t _norm = srsran_simd_f_set1(norm);
+  for (int i = (int)nof_layers - 1; i >= 0; i--) {
+    x[i] = srsran_simd_cf_mul(z[i], d_rcp[i]);
+    for (uint32_t k = i + 1; k < nof_layers; k++) {
+      x[i] = srsran_simd_cf_sub(x[i], srsran_simd_cf_conjprod(x[k], a[k][i]));
+    }
+  }
+  for (uint32_t i = 0; i < nof_layers; i++) {
+    x[i] = srsran_simd_cf_mul(x[i], _norm);
+  }
+}
+
 #endif /* SRSRAN_SIMD_CF_SIZE != 0 */
 
 typedef struct {
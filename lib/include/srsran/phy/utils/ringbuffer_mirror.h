@@ -0,0 +1,86 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        ringbuffer_mirror.h
+ * Description: Lock-free single producer, single consumer ring buffer. The
+ *              buffer memory is mapped twice in consecutive virtual addresses,
+ *              so any region of the buffer, even when it wraps around, can be
+ *              accessed as a contiguous span. The producer and the consumer
+ *              work in place through views of the buffer, without copies.
+ *****************************************************************************/
+
+#ifndef SRSRAN_RINGBUFFER_MIRROR_H
+#define SRSRAN_RINGBUFFER_MIRROR_H
+
+#include "srsran/config.h"
+#include <stdint.h>
+
+typedef struct {
+  uint8_t* buffer;   ///< Start of the first mapping, the second one follows at buffer + capacity
+  uint32_t capacity; ///< Size of the buffer in bytes, a multiple of the page size
+  uint64_t wpm;      ///< Total number of bytes written, only modified by the producer
+  uint64_t rpm;      ///< Total number of bytes read, only modified by the consumer
+} srsran_ringbuffer_mirror_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Creates a ring buffer of at least min_capacity bytes, rounded up to the page size.
+SRSRAN_API int srsran_ringbuffer_mirror_init(srsran_ringbuffer_mirror_t* q, uint32_t min_capacity);
+
+SRSRAN_API void srsran_ringbuffer_mirror_free(srsran_ringbuffer_mirror_t* q);
+
+/// Discards the buffered data. It must not be called while the producer or the consumer are using the buffer.
+SRSRAN_API void srsran_ringbuffer_mirror_reset(srsran_ringbuffer_mirror_t* q);
+
+/// Returns the number of bytes available for reading.
+SRSRAN_API uint32_t srsran_ringbuffer_mirror_status(srsran_ringbuffer_mirror_t* q);
+
+/// Returns the number of bytes available for writing.
+SRSRAN_API uint32_t srsran_ringbuffer_mirror_space(srsran_ringbuffer_mirror_t* q);
+
+/// Producer side. Returns a pointer where up to nof_bytes contiguous bytes can be written, nof_bytes is set to the
+/// free space. The data becomes visible to the consumer after srsran_ringbuffer_mirror_write_commit().
+SRSRAN_API uint8_t* srsran_ringbuffer_mirror_write_view(srsran_ringbuffer_mirror_t* q, uint32_t* nof_bytes);
+
+/// Producer side. Publishes nof_bytes bytes written through the last write view.
+SRSRAN_API int srsran_ringbuffer_mirror_write_commit(srsran_ringbuffer_mirror_t* q, uint32_t nof_bytes);
+
+/// Consumer side. Returns a pointer to the nof_bytes contiguous bytes available for reading. The bytes stay in the
+/// buffer until srsran_ringbuffer_mirror_read_release() is called.
+SRSRAN_API const uint8_t* srsran_ringbuffer_mirror_read_view(srsran_ringbuffer_mirror_t* q, uint32_t* nof_bytes);
+
+/// Consumer side. Frees the first nof_bytes bytes of the last read view for the producer.
+SRSRAN_API int srsran_ringbuffer_mirror_read_release(srsran_ringbuffer_mirror_t* q, uint32_t nof_bytes);
+
+/// Copies nof_bytes into the buffer. It does not block, it fails without writing if there is not enough space.
+SRSRAN_API int srsran_ringbuffer_mirror_write(srsran_ringbuffer_mirror_t* q, const void* ptr, uint32_t nof_bytes);
+
+/// Copies nof_bytes out of the buffer. It does not block, it fails without reading if there is not enough data.
+SRSRAN_API int srsran_ringbuffer_mirror_read(srsran_ringbuffer_mirror_t* q, void* ptr, uint32_t nof_bytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_RINGBUFFER_MIRROR_H
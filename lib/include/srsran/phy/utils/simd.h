@@ -1584,6 +1584,63 @@ static inline simd_s_t srsran_simd_s_sub(simd_s_t a, simd_s_t b)
 #endif /* LV_HAVE_AVX512 */
 }
 
+static inline simd_s_t srsran_simd_s_max(simd_s_t a, simd_s_t b)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_max_epi16(a, b);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_max_epi16(a, b);
+#else /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_SSE
+  return _mm_max_epi16(a, b);
+#else /* LV_HAVE_SSE */
+#ifdef HAVE_NEON
+  return vmaxq_s16(a, b);
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+static inline simd_s_t srsran_simd_s_min(simd_s_t a, simd_s_t b)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_min_epi16(a, b);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_min_epi16(a, b);
+#else /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_SSE
+  return _mm_min_epi16(a, b);
+#else /* LV_HAVE_SSE */
+#ifdef HAVE_NEON
+  return vminq_s16(a, b);
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+static inline simd_s_t srsran_simd_s_set1(int16_t x)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_set1_epi16(x);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_set1_epi16(x);
+#else /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_SSE
+  return _mm_set1_epi16(x);
+#else /* LV_HAVE_SSE */
+#ifdef HAVE_NEON
+  return vdupq_n_s16(x);
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
 #endif /* SRSRAN_SIMD_S_SIZE */
 
 #if SRSRAN_SIMD_C16_SIZE
@@ -1885,6 +1942,31 @@ static inline simd_s_t srsran_simd_convert_2f_s(simd_f_t a, simd_f_t b)
 #endif /* LV_HAVE_AVX512 */
 }
 
+/* Converts the first and the second half of a short register to float, keeping the element order */
+static inline void srsran_simd_convert_s_2f(simd_s_t a, simd_f_t* lo, simd_f_t* hi)
+{
+#ifdef LV_HAVE_AVX512
+  *lo = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm512_castsi512_si256(a)));
+  *hi = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm512_extracti64x4_epi64(a, 1)));
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  *lo = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_castsi256_si128(a)));
+  *hi = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(a, 1)));
+#else
+#ifdef LV_HAVE_SSE
+  // Sign extension of every short placed in the upper half of a 32-bit lane
+  *lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16));
+  *hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16));
+#else
+#ifdef HAVE_NEON
+  *lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(a)));
+  *hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(a)));
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
 #endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_C16_SIZE */
 
 #if SRSRAN_SIMD_B_SIZE
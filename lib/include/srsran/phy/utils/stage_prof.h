@@ -0,0 +1,91 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ *  \file stage_prof.h
+ *  \brief Per-stage PHY processing timers, shared by every thread of the process. They cost a single flag check while
+ *  disabled and can be toggled at runtime. Each thread accumulates its measurements in its own slot without locking.
+ */
+
+#ifndef SRSRAN_STAGE_PROF_H
+#define SRSRAN_STAGE_PROF_H
+
+#include "srsran/config.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  SRSRAN_STAGE_PROF_OFDM = 0,
+  SRSRAN_STAGE_PROF_CHEST,
+  SRSRAN_STAGE_PROF_EQUALIZE,
+  SRSRAN_STAGE_PROF_DEMOD,
+  SRSRAN_STAGE_PROF_FEC,
+  SRSRAN_STAGE_PROF_CRC,
+  SRSRAN_STAGE_PROF_ENCODE,
+  SRSRAN_STAGE_PROF_MAP,
+  SRSRAN_STAGE_PROF_NOF
+} srsran_stage_prof_t;
+
+/// Histogram bins, the first one counts the measurements below 1 us and bin i > 0 the ones in [2^(i-1), 2^i) us. The
+/// last bin also counts any longer measurement
+#define SRSRAN_STAGE_PROF_HIST_LEN 16
+
+typedef struct {
+  uint64_t count;
+  double   total_us;
+  double   max_us;
+  uint32_t hist[SRSRAN_STAGE_PROF_HIST_LEN];
+} srsran_stage_prof_metrics_t;
+
+/**
+ * \brief Enables or disables the stage timers, the timer clock is calibrated the first time they are enabled
+ */
+SRSRAN_API void srsran_stage_prof_set_enabled(bool enabled);
+
+SRSRAN_API bool srsran_stage_prof_is_enabled(void);
+
+SRSRAN_API const char* srsran_stage_prof_name(srsran_stage_prof_t stage);
+
+/**
+ * \brief Starts a stage measurement
+ * \return the current clock ticks, or 0 if the timers are disabled
+ */
+SRSRAN_API uint64_t srsran_stage_prof_start(void);
+
+/**
+ * \brief Accumulates the time elapsed since \p t0 in the calling thread slot of \p stage, nothing is done if \p t0 is 0
+ */
+SRSRAN_API void srsran_stage_prof_stop(srsran_stage_prof_t stage, uint64_t t0);
+
+/**
+ * \brief Merges the measurements of every thread since the previous call into \p metrics and resets them
+ */
+SRSRAN_API void srsran_stage_prof_get(srsran_stage_prof_metrics_t metrics[SRSRAN_STAGE_PROF_NOF]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_STAGE_PROF_H
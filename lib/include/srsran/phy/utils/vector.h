@@ -111,6 +111,13 @@ static inline float srsran_convert_dB_to_power(float v)
   return powf(10.0f, v / 10.0f);
 }
 
+/*!
+ * Returns the instruction set of the vector kernels in use. It differs from the build one when the library is built
+ * with ENABLE_SIMD_DISPATCH and a faster set is found in the CPU at startup.
+ * \return A string such as "sse", "avx2" or "avx512".
+ */
+SRSRAN_API const char* srsran_vec_simd_isa();
+
 /*!
  * Computes \f$ z = x \oplus y \f$ elementwise.
  * \param[in] x A pointer to a vector of uint8_t with 0's and 1's.
@@ -136,6 +143,41 @@ SRSRAN_API uint8_t* srsran_vec_u8_malloc(uint32_t nsamples);
 
 SRSRAN_API void* srsran_vec_realloc(void* ptr, uint32_t old_size, uint32_t new_size);
 
+/**
+ * Makes srsran_vec_malloc() allocate the buffers of at least min_size bytes in whole 2 MB pages, advised to be backed
+ * by transparent huge pages. They are still released with free(). A min_size of 0, the default, disables it.
+ */
+SRSRAN_API void srsran_vec_set_hugepage_min_size(uint32_t min_size);
+
+/** Returns the number and total size of the buffers backed by huge pages since startup */
+SRSRAN_API void srsran_vec_get_hugepage_usage(uint64_t* nof_allocs, uint64_t* nof_bytes);
+
+/** Subsystems the memory is accounted to */
+typedef enum {
+  SRSRAN_MEM_TAG_NONE = 0, // Not accounted
+  SRSRAN_MEM_TAG_PHY,
+  SRSRAN_MEM_TAG_SOFTBUFFER,
+  SRSRAN_MEM_TAG_NOF
+} srsran_mem_tag_t;
+
+SRSRAN_API const char* srsran_mem_tag_to_str(srsran_mem_tag_t tag);
+
+/**
+ * Sets the subsystem the buffers allocated by srsran_vec_malloc() in the calling thread are accounted to, and returns
+ * the previous one. Buffers released with free() can not be tracked, so the tag is meant to be set while allocating
+ * the buffers that live as long as their subsystem, the others shall be accounted with srsran_mem_account().
+ */
+SRSRAN_API srsran_mem_tag_t srsran_vec_set_mem_tag(srsran_mem_tag_t tag);
+
+/** Adds nof_bytes, which may be negative, to the memory of the subsystem */
+SRSRAN_API void srsran_mem_account(srsran_mem_tag_t tag, int64_t nof_bytes);
+
+/** Returns the memory accounted to the subsystem */
+SRSRAN_API uint64_t srsran_mem_get_usage(srsran_mem_tag_t tag);
+
+/** Returns the memory allocated by srsran_vec_malloc() with a tag set in the calling thread, since it started */
+SRSRAN_API uint64_t srsran_vec_get_thread_mem_usage(void);
+
 /* Zero memory */
 SRSRAN_API void srsran_vec_zero(void* ptr, uint32_t nsamples);
 SRSRAN_API void srsran_vec_cf_zero(cf_t* ptr, uint32_t nsamples);
@@ -191,7 +233,9 @@ SRSRAN_API void srsran_vec_sc_prod_fff(const float* x, const float h, float* z,
 
 SRSRAN_API void srsran_vec_convert_fi(const float* x, const float scale, int16_t* z, const uint32_t len);
 SRSRAN_API void srsran_vec_convert_conj_cs(const cf_t* x, const float scale, int16_t* z, const uint32_t len);
+SRSRAN_API void srsran_vec_convert_sc_prod_cs(const cf_t* x, const cf_t h, int16_t* z, const uint32_t len);
 SRSRAN_API void srsran_vec_convert_if(const int16_t* x, const float scale, float* z, const uint32_t len);
+SRSRAN_API void srsran_vec_convert_conj_sc(const int16_t* x, const float scale, cf_t* z, const uint32_t len);
 SRSRAN_API void srsran_vec_convert_fb(const float* x, const float scale, int8_t* z, const uint32_t len);
 
 SRSRAN_API void srsran_vec_lut_sss(const short* x, const unsigned short* lut, short* y, const uint32_t len);
@@ -113,6 +113,9 @@ SRSRAN_API int srsran_vec_dot_prod_sss_simd(const int16_t* x, const int16_t* y,
 /* SIMD Modulus functions */
 SRSRAN_API void srsran_vec_abs_cf_simd(const cf_t* x, float* z, const int len);
 
+SRSRAN_API void
+srsran_vec_gen_clip_env_simd(const float* x_abs, const float thres, const float alpha, float* env, const int len);
+
 SRSRAN_API void srsran_vec_abs_square_cf_simd(const cf_t* x, float* z, const int len);
 
 /* Other Functions */
@@ -126,6 +129,8 @@ SRSRAN_API void srsran_vec_convert_fi_simd(const float* x, int16_t* z, const flo
 
 SRSRAN_API void srsran_vec_convert_conj_cs_simd(const cf_t* x, int16_t* z, const float scale, const int len);
 
+SRSRAN_API void srsran_vec_convert_sc_prod_cs_simd(const cf_t* x, const cf_t h, int16_t* z, const int len);
+
 SRSRAN_API void srsran_vec_convert_fb_simd(const float* x, int8_t* z, const float scale, const int len);
 
 SRSRAN_API void srsran_vec_interleave_simd(const cf_t* x, const cf_t* y, cf_t* z, const int len);
@@ -23,7 +23,9 @@
 #include "radio_metrics.h"
 #include "rf_buffer.h"
 #include "rf_timestamp.h"
+#include "srsran/adt/circular_buffer.h"
 #include "srsran/common/interfaces_common.h"
+#include "srsran/common/threads.h"
 #include "srsran/interfaces/radio_interfaces.h"
 #include "srsran/phy/resampling/resampler.h"
 #include "srsran/phy/rf/rf.h"
@@ -31,7 +33,9 @@
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
 
+#include <condition_variable>
 #include <list>
+#include <memory>
 #include <string>
 
 #ifndef SRSRAN_RADIO_H
@@ -112,6 +116,9 @@ private:
   std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> decimators    = {};
   std::atomic<bool> decimator_busy = {false}; ///< Indicates the decimator is changing the rate
 
+  std::array<srsran_resampler_poly_t, SRSRAN_MAX_CHANNELS> poly_interpolators = {}; ///< Fractional ratio interpolators
+  std::array<srsran_resampler_poly_t, SRSRAN_MAX_CHANNELS> poly_decimators    = {}; ///< Fractional ratio decimators
+
   rf_timestamp_t    end_of_burst_time = {};
   std::atomic<bool> is_start_of_burst{false};
   uint32_t          tx_adv_nsamples    = 0;
@@ -198,6 +205,97 @@ private:
   // private unprotected tx_end implementation
   void tx_end_nolock();
 
+  /**
+   * Reception shared by all the RF devices in a call to rx_now
+   */
+  struct rx_job_t {
+    rf_buffer_interface*                      buffer    = nullptr; ///< Output buffers, at the PHY rate
+    const rf_buffer_interface*                buffer_rx = nullptr; ///< Buffers at the radio rate
+    rf_timestamp_interface*                   rxd_time  = nullptr; ///< Receive time of every device
+    uint32_t                                  ratio     = 1;       ///< Integer decimation ratio
+    bool                                      poly      = false;   ///< Fractional decimation
+    std::array<uint32_t, SRSRAN_MAX_CHANNELS> ch_device = {};      ///< Device decimating each logical channel
+  };
+
+  /**
+   * Receives and decimates the channels of one RF device, in parallel with the other devices, so that the receive and
+   * decimation times of multiple devices do not add up in the thread calling rx_now
+   */
+  class rx_dev_worker : public srsran::thread
+  {
+  public:
+    rx_dev_worker(radio& parent_, uint32_t device_idx_);
+    void stop();
+    void start_rx(const rx_job_t& job_);
+    bool wait_rx();
+
+  private:
+    radio&                  parent;
+    uint32_t                device_idx = 0;
+    std::mutex              mutex;
+    std::condition_variable cvar;
+    const rx_job_t*         job     = nullptr;
+    bool                    running = true;
+    bool                    done    = false;
+    bool                    ret     = false;
+
+    void run_thread() override;
+  };
+  std::vector<std::unique_ptr<rx_dev_worker> > rx_workers; ///< One per RF device except the first, if there are many
+  constexpr static int                         rx_worker_prio = 0;
+
+  /**
+   * Transmission waiting in the Tx queue, the slots are allocated at initialization and recycled
+   */
+  struct tx_slot_t {
+    std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS> samples;              ///< Samples at the PHY rate
+    rf_buffer_t                                        buffer;               ///< Points at the samples
+    rf_timestamp_t                                     tx_time;              ///< Transmission time of every device
+    bool                                               end_of_burst = false; ///< tx_end request, without samples
+  };
+
+  /**
+   * Drains the Tx queue, so the PHY workers calling tx only copy their samples and never wait for the RF device
+   */
+  class tx_queue_worker : public srsran::thread
+  {
+  public:
+    explicit tx_queue_worker(radio& parent_) : srsran::thread("RADIO_TX"), parent(parent_) {}
+
+  private:
+    radio& parent;
+
+    void run_thread() override { parent.tx_queue_run(); }
+  };
+  std::vector<std::unique_ptr<tx_slot_t> > tx_slots;         ///< Empty if the Tx queue is disabled
+  srsran::dyn_blocking_queue<tx_slot_t*>   tx_free_slots{1}; ///< Slots available for tx
+  srsran::dyn_blocking_queue<tx_slot_t*>   tx_pending{1};    ///< Transmissions in order, for the Tx thread
+  std::unique_ptr<tx_queue_worker>         tx_queue_thread;  ///< Null if the Tx queue is disabled
+  std::mutex                               tx_queue_mutex;   ///< Protects the radio time and the slack metrics
+  srsran_timestamp_t                       tx_queue_rx_time       = {};    ///< End of the last reception
+  bool                                     tx_queue_rx_time_valid = false; ///< Set after the first reception
+  double                                   tx_slack_min_us        = 0.0;
+  double                                   tx_slack_sum_us        = 0.0;
+  uint32_t                                 tx_slack_count         = 0;
+  constexpr static int                     tx_queue_prio          = 0;
+
+  /**
+   * Copies a transmission into a free slot of the Tx queue. It drops the transmission if there is none
+   *
+   * @param buffer Transmit buffers
+   * @param tx_time Timestamp to transmit
+   * @return it returns true if the transmission was queued, otherwise it returns false
+   */
+  bool tx_enqueue(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_time);
+
+  /**
+   * Tx thread loop, it transmits the queued slots in order and drops the ones already late
+   */
+  void tx_queue_run();
+
+  // private unprotected tx implementation, it interpolates and transmits over every RF device
+  bool tx_nolock(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_time);
+
   /**
    * Helper method for receiving over a single RF device. This function maps automatically the logical receive buffers
    * to the physical RF buffers for the given device.
@@ -209,6 +307,15 @@ private:
    */
   bool rx_dev(const uint32_t& device_idx, const rf_buffer_interface& buffer, srsran_timestamp_t* rxd_time);
 
+  /**
+   * Helper method for receiving over a single RF device and decimating the logical channels it carries
+   *
+   * @param device_idx Device index
+   * @param job Reception of the current call to rx_now
+   * @return it returns true if the reception was successful, otherwise it returns false
+   */
+  bool rx_dev_decimate(uint32_t device_idx, const rx_job_t& job);
+
   /**
    * Helper method for mapping logical channels into physical radio buffers.
    *
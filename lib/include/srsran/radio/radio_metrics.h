@@ -29,6 +29,11 @@ typedef struct {
   uint32_t rf_u;
   uint32_t rf_l;
   bool     rf_error;
+  uint32_t tx_queue_max;    // Maximum number of transmissions waiting in the Tx queue
+  uint32_t tx_queue_drop;   // Transmissions dropped because the Tx queue was full
+  uint32_t tx_queue_late;   // Transmissions dropped because they were due before the last received sample
+  float    tx_slack_min_us; // Minimum time left to the due time of a transmission when the Tx thread takes it
+  float    tx_slack_avg_us; // Average time left to the due time of a transmission when the Tx thread takes it
 } rf_metrics_t;
 
 } // namespace srsran
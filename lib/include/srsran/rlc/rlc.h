@@ -56,10 +56,14 @@ public:
             bsr_callback_t             bsr_callback_);
   void stop();
 
+  /// Bounds the bytes queued for TX across the DRBs added from now on. 0 removes the bound
+  void set_tx_byte_budget(uint32_t max_bytes) { tx_budget.set_max_bytes(max_bytes); }
+
   void get_metrics(rlc_metrics_t& m, const uint32_t nof_tti);
 
   // PDCP interface
   void write_sdu(uint32_t lcid, unique_byte_buffer_t sdu);
+  void write_sdus(uint32_t lcid, span<unique_byte_buffer_t> sdus);
   void write_sdu_mch(uint32_t lcid, unique_byte_buffer_t sdu);
   bool rb_is_um(uint32_t lcid);
   void discard_sdu(uint32_t lcid, uint32_t discard_sn);
@@ -73,6 +77,7 @@ public:
   uint32_t read_pdu_mch(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes);
   int      get_increment_sequence_num();
   void     write_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes);
+  void     write_pdu_locked(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes);
   void     write_pdu_bcch_bch(srsran::unique_byte_buffer_t pdu);
   void     write_pdu_bcch_dlsch(uint8_t* payload, uint32_t nof_bytes);
   void     write_pdu_pcch(srsran::unique_byte_buffer_t pdu);
@@ -108,6 +113,9 @@ private:
   typedef std::map<uint16_t, std::unique_ptr<rlc_common> >  rlc_map_t;
   typedef std::pair<uint16_t, std::unique_ptr<rlc_common> > rlc_map_pair_t;
 
+  // Declared before the entities, whose queues give their bytes back on destruction
+  byte_buffer_budget tx_budget;
+
   rlc_map_t        rlc_array, rlc_array_mrb;
   pthread_rwlock_t rwlock;
 
@@ -28,6 +28,7 @@
 #include "srsran/interfaces/ue_rrc_interfaces.h"
 #include "srsran/rlc/rlc_common.h"
 #include "srsran/upper/byte_buffer_queue.h"
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <pthread.h>
@@ -85,6 +86,8 @@ public:
    ***************************************************************************/
   void write_sdu(unique_byte_buffer_t sdu) final;
 
+  void write_sdus(span<unique_byte_buffer_t> sdus) final;
+
   void discard_sdu(uint32_t discard_sn) final;
 
   bool sdu_queue_is_full() final;
@@ -111,6 +114,8 @@ public:
    ***************************************************************************/
   void set_bsr_callback(bsr_callback_t callback) final;
 
+  void set_tx_budget(byte_buffer_budget* budget) final;
+
 protected:
   // Common variables needed/provided by parent class
   srsran::timer_handler* timers = nullptr;
@@ -122,6 +127,12 @@ protected:
   std::mutex           metrics_mutex;
   rlc_bearer_metrics_t metrics = {};
 
+  // TX counters of the SDU writer and the PDU reader threads, updated without the metrics mutex
+  std::atomic<uint32_t> num_tx_sdus{0};
+  std::atomic<uint64_t> num_tx_sdu_bytes{0};
+  std::atomic<uint32_t> num_tx_pdus{0};
+  std::atomic<uint64_t> num_tx_pdu_bytes{0};
+
   srsue::rrc_interface_rlc*  rrc  = nullptr;
   srsue::pdcp_interface_rlc* pdcp = nullptr;
 
@@ -145,15 +156,18 @@ public:
     virtual void     empty_queue()                                                 = 0;
     virtual bool     has_data()                                                    = 0;
     virtual void     stop()                                                        = 0;
+    virtual size_t   get_memory_usage()                                            = 0;
 
     void set_bsr_callback(bsr_callback_t callback);
 
-    int              write_sdu(unique_byte_buffer_t sdu);
-    bool             sdu_queue_is_full();
+    virtual int      write_sdu(unique_byte_buffer_t sdu);
+    virtual void     write_sdus(span<unique_byte_buffer_t> sdus, uint32_t& nof_sdus, uint32_t& nof_bytes);
+    virtual bool     sdu_queue_is_full();
+    virtual void     set_tx_budget(byte_buffer_budget* budget);
     virtual void     discard_sdu(uint32_t pdcp_sn);
     virtual uint32_t read_pdu(uint8_t* payload, uint32_t nof_bytes) = 0;
 
-    bool                  tx_enabled = false;
+    std::atomic<bool>     tx_enabled{false};
     byte_buffer_pool*     pool       = nullptr;
     srslog::basic_logger& logger;
     std::string           rb_name;
@@ -165,6 +179,9 @@ public:
 
     // Mutexes
     std::mutex mutex;
+
+  private:
+    int queue_sdu(unique_byte_buffer_t sdu);
   };
 
   /*******************************************************
@@ -184,6 +201,7 @@ public:
     virtual void     stop()                                                = 0;
     virtual uint32_t get_sdu_rx_latency_ms()                               = 0;
     virtual uint32_t get_rx_buffered_bytes()                               = 0;
+    virtual size_t   get_memory_usage()                                    = 0;
 
     void write_pdu(uint8_t* payload, uint32_t nof_bytes);
 
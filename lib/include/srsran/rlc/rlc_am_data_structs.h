@@ -22,11 +22,17 @@
 #ifndef SRSRAN_RLC_AM_DATA_STRUCTS_H
 #define SRSRAN_RLC_AM_DATA_STRUCTS_H
 
+#include "srsran/adt/bounded_bitset.h"
+#include "srsran/adt/bounded_vector.h"
 #include "srsran/adt/circular_buffer.h"
 #include "srsran/adt/circular_map.h"
+#include "srsran/adt/interval.h"
 #include "srsran/adt/intrusive_list.h"
 #include "srsran/common/buffer_pool.h"
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <deque>
 #include <list>
 #include <vector>
 
@@ -129,6 +135,8 @@ public:
   uint32_t             retx_count = 0;
   HeaderType           header     = {};
   unique_byte_buffer_t buf        = nullptr;
+  uint64_t             sdu_offset = 0; ///< Data field position in the TX SDU stream, for the PDUs without buf
+  uint32_t             data_len   = 0; ///< Data field size, for the PDUs without buf
 
   explicit rlc_amd_tx_pdu(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
   rlc_amd_tx_pdu(const rlc_amd_tx_pdu&)           = delete;
@@ -154,6 +162,89 @@ public:
 };
 
 /// Class that contains the parameters and state (e.g. unACKed segments) of a PDCP PDU
+/**
+ * SDUs of an RLC AM TX entity, seen as one byte stream in the order they are segmented. The data field of a PDU is a
+ * range of the stream, so the PDUs and their retransmissions are written into the MAC PDU straight from the SDUs. The
+ * SDUs are kept until the PDUs carrying their bytes are ACKed
+ */
+class rlc_am_tx_sdu_stream
+{
+public:
+  /// Appends an SDU to the stream. The previous SDU must have been fully read
+  void push(unique_byte_buffer_t sdu)
+  {
+    srsran_assert(pending_bytes() == 0, "Pushing an SDU before the previous one was fully read");
+    uint32_t len = sdu->N_bytes;
+    sdus.push_back(retained_sdu{end_offset, len, std::move(sdu)});
+    end_offset += len;
+  }
+
+  /// Marks the next len bytes of the last SDU as read and returns their position in the stream
+  uint64_t read(uint32_t len)
+  {
+    uint64_t offset = read_offset;
+    read_offset += len;
+    return offset;
+  }
+
+  /// Drops the bytes of the last SDU that were not read yet. The ones already read stay available
+  void drop_pending()
+  {
+    if (pending_bytes() > 0) {
+      sdus.back().len -= pending_bytes();
+      end_offset = read_offset;
+    }
+  }
+
+  /// Copies len bytes from the stream position offset into dst. The bytes must have been read and not released
+  void copy(uint64_t offset, uint32_t len, uint8_t* dst) const
+  {
+    auto it = std::upper_bound(sdus.begin(), sdus.end(), offset, [](uint64_t offset_, const retained_sdu& sdu) {
+      return offset_ < sdu.offset;
+    });
+    srsran_assert(it != sdus.begin(), "Copying released SDU bytes");
+    for (--it; len > 0; ++it) {
+      uint32_t pos = offset - it->offset;
+      uint32_t n   = std::min(len, it->len - pos);
+      memcpy(dst, it->sdu->msg + pos, n);
+      dst += n;
+      offset += n;
+      len -= n;
+    }
+  }
+
+  /// Frees the SDUs whose bytes are all before the stream position offset
+  void release(uint64_t offset)
+  {
+    while (not sdus.empty() and sdus.front().offset + sdus.front().len <= offset) {
+      sdus.pop_front();
+    }
+  }
+
+  void clear()
+  {
+    sdus.clear();
+    end_offset  = 0;
+    read_offset = 0;
+  }
+
+  uint32_t             pending_bytes() const { return end_offset - read_offset; }
+  uint64_t             get_read_offset() const { return read_offset; }
+  const byte_buffer_t& last_sdu() const { return *sdus.back().sdu; }
+  size_t               nof_sdus() const { return sdus.size(); }
+
+private:
+  struct retained_sdu {
+    uint64_t             offset;
+    uint32_t             len;
+    unique_byte_buffer_t sdu;
+  };
+
+  std::deque<retained_sdu> sdus;
+  uint64_t                 end_offset  = 0;
+  uint64_t                 read_offset = 0;
+};
+
 template <typename HeaderType>
 class pdcp_pdu_info
 {
@@ -205,6 +296,129 @@ public:
   const_iterator end() const { return list.end(); }
 };
 
+/**
+ * Byte ranges received so far of an SDU under reassembly. The ranges are kept sorted and disjoint, and the ranges that
+ * touch are merged, so the gaps between them are the missing bytes. Ranges are stored inline, so that tracking the
+ * segments of an SDU does not allocate, and the range lookups are O(log n)
+ * @tparam MAX_RANGES maximum number of disjoint byte ranges, i.e. of gaps plus one, that can be tracked per SDU
+ */
+template <std::size_t MAX_RANGES>
+class rlc_am_rx_byte_ranges
+{
+public:
+  using range_t        = interval<uint32_t>;
+  using const_iterator = typename bounded_vector<range_t, MAX_RANGES>::const_iterator;
+
+  /// Checks whether any of the bytes [so, so + len) was already received
+  bool overlaps(uint32_t so, uint32_t len) const
+  {
+    auto it = first_ending_after(so);
+    return len > 0 and it != ranges.end() and it->start() < so + len;
+  }
+
+  /// Adds the bytes [so, so + len), which must not overlap with the received ones. Returns false if the new bytes would
+  /// need a range beyond MAX_RANGES
+  bool add(uint32_t so, uint32_t len)
+  {
+    if (len == 0) {
+      return true;
+    }
+    // the ranges around the new bytes
+    uint32_t stop = so + len;
+    auto     next = std::lower_bound(
+        ranges.begin(), ranges.end(), stop, [](const range_t& r, uint32_t stop_) { return r.start() < stop_; });
+    auto prev = next == ranges.begin() ? ranges.end() : next - 1;
+
+    bool join_prev = prev != ranges.end() and prev->stop() == so;
+    bool join_next = next != ranges.end() and next->start() == stop;
+    if (join_prev and join_next) {
+      prev->set(prev->start(), next->stop());
+      ranges.erase(next);
+    } else if (join_prev) {
+      prev->set(prev->start(), stop);
+    } else if (join_next) {
+      next->set(so, next->stop());
+    } else {
+      if (ranges.full()) {
+        return false;
+      }
+      // insert the new range before next
+      size_t pos = next - ranges.begin();
+      ranges.emplace_back(so, stop);
+      std::rotate(ranges.begin() + pos, ranges.end() - 1, ranges.end());
+    }
+    return true;
+  }
+
+  void           clear() { ranges.clear(); }
+  bool           empty() const { return ranges.empty(); }
+  size_t         size() const { return ranges.size(); }
+  const range_t& front() const { return ranges.front(); }
+  const_iterator begin() const { return ranges.begin(); }
+  const_iterator end() const { return ranges.end(); }
+
+private:
+  /// First range whose last byte is at or after so
+  const_iterator first_ending_after(uint32_t so) const
+  {
+    return std::upper_bound(
+        ranges.begin(), ranges.end(), so, [](uint32_t so_, const range_t& r) { return so_ < r.stop(); });
+  }
+
+  bounded_vector<range_t, MAX_RANGES> ranges;
+};
+
+/**
+ * Set of the SNs of an RX window, as a bitmap over the SN space. The runs of SNs in and out of the set are skipped a
+ * word at a time, so that the status PDUs are built in O(#gaps + window / 64) instead of with one lookup per SN
+ * @tparam MAX_SN_SPACE largest SN space, i.e. the modulus of the SNs, which must be a multiple of 64
+ */
+template <std::size_t MAX_SN_SPACE>
+class rlc_am_rx_sn_bitmap
+{
+public:
+  explicit rlc_am_rx_sn_bitmap(uint32_t sn_space = MAX_SN_SPACE) : bitmap(sn_space) {}
+
+  void resize(uint32_t sn_space)
+  {
+    bitmap.resize(sn_space);
+    bitmap.reset();
+  }
+  void set(uint32_t sn) { bitmap.set(sn); }
+  void reset(uint32_t sn) { bitmap.reset(sn); }
+  void clear() { bitmap.reset(); }
+  bool test(uint32_t sn) const { return bitmap.test(sn); }
+
+  /// First SN from sn up to stop, excluded and wrapping around the SN space, that is in the set (value = true) or out
+  /// of it (value = false). Returns stop if there is none
+  uint32_t find_next(uint32_t sn, uint32_t stop, bool value) const
+  {
+    if (sn <= stop) {
+      return find_(sn, stop, value);
+    }
+    uint32_t found = find_(sn, bitmap.size(), value);
+    return found != bitmap.size() ? found : find_(0, stop, value);
+  }
+
+  /// Number of SNs from sn up to stop, excluded and wrapping around the SN space, that are out of the set
+  uint32_t count_missing(uint32_t sn, uint32_t stop) const
+  {
+    if (sn <= stop) {
+      return (stop - sn) - bitmap.count(sn, stop);
+    }
+    return (bitmap.size() - sn) - bitmap.count(sn, bitmap.size()) + stop - bitmap.count(0, stop);
+  }
+
+private:
+  uint32_t find_(uint32_t start, uint32_t end, bool value) const
+  {
+    int pos = bitmap.find_lowest(start, end, value);
+    return pos < 0 ? end : pos;
+  }
+
+  bounded_bitset<MAX_SN_SPACE> bitmap;
+};
+
 template <class T>
 struct rlc_ringbuffer_base {
   virtual ~rlc_ringbuffer_base()           = default;
@@ -216,6 +430,7 @@ struct rlc_ringbuffer_base {
   virtual bool   full() const              = 0;
   virtual void   clear()                   = 0;
   virtual bool   has_sn(uint32_t sn) const = 0;
+  virtual size_t memory_usage() const      = 0;
 };
 
 template <class T, std::size_t WINDOW_SIZE>
@@ -241,6 +456,9 @@ struct rlc_ringbuffer_t : public rlc_ringbuffer_base<T> {
 
   bool has_sn(uint32_t sn) const override { return window.contains(sn); }
 
+  // The window storage is static, so its footprint does not depend on the number of PDUs in flight
+  size_t memory_usage() const override { return sizeof(*this); }
+
   // Return the sum data bytes of all active PDUs (check PDU is non-null)
   uint32_t get_buffered_bytes()
   {
@@ -25,6 +25,7 @@
 #include "srsran/adt/accumulators.h"
 #include "srsran/adt/circular_array.h"
 #include "srsran/adt/circular_map.h"
+#include "srsran/adt/spsc_queue.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/task_scheduler.h"
@@ -67,11 +68,19 @@ public:
   void reestablish();
   void stop();
 
+  // SDU interface. Lock-free, from a single writer thread
+  int  write_sdu(unique_byte_buffer_t sdu) final;
+  void write_sdus(span<unique_byte_buffer_t> sdus, uint32_t& nof_sdus, uint32_t& nof_bytes) final;
+  bool sdu_queue_is_full() final;
+  void set_tx_budget(byte_buffer_budget* budget) final;
+  void discard_sdu(uint32_t discard_sn) final;
+
   uint32_t read_pdu(uint8_t* payload, uint32_t nof_bytes);
 
   bool     has_data();
   uint32_t get_buffer_state();
   void     get_buffer_state(uint32_t& n_bytes_newtx, uint32_t& n_bytes_prio);
+  size_t   get_memory_usage() final { return sizeof(*this); }
 
   void empty_queue_nolock();
   void debug_state();
@@ -84,6 +93,14 @@ public:
 
 private:
   void stop_nolock();
+  int  push_sdu(unique_byte_buffer_t sdu);
+
+  // Deferred work of the threads other than the PDU reader
+  void run_deferred_work();
+  void process_deferred_work_nolock();
+  void handle_status_pdu_nolock(uint8_t* payload, uint32_t nof_bytes);
+
+  uint32_t read_pdu_nolock(uint8_t* payload, uint32_t nof_bytes);
 
   int  build_status_pdu(uint8_t* payload, uint32_t nof_bytes);
   int  build_retx_pdu(uint8_t* payload, uint32_t nof_bytes);
@@ -113,8 +130,10 @@ private:
 
   rlc_am_config_t cfg = {};
 
-  // TX SDU buffers
-  unique_byte_buffer_t tx_sdu;
+  // TX SDU buffers. The SDU ring is only read while holding the mutex. The SDUs taken from it are kept in the stream
+  // until ACKed, as the PDUs in the tx window only refer to their bytes
+  byte_buffer_spsc_queue tx_sdu_ring;
+  rlc_am_tx_sdu_stream   tx_sdu_stream;
 
   /****************************************************************************
    * State variables and counters
@@ -141,6 +160,19 @@ private:
   srsran::timer_handler::unique_timer poll_retx_timer;
   srsran::timer_handler::unique_timer status_prohibit_timer;
 
+  /****************************************************************************
+   * Deferred work
+   * The TX window belongs to the holder of the mutex, normally the PDU reader. The other threads queue their work and
+   * only run it if the mutex is free. Otherwise, the PDU reader runs it, or the stack thread at the next tick
+   ***************************************************************************/
+
+  srsran::timer_handler::unique_timer deferred_work_timer;
+  spsc_queue<unique_byte_buffer_t>    status_pdu_queue{16};
+  spsc_queue<uint32_t>                discard_queue;
+  std::atomic<bool>                   poll_retx_expired{false};
+  std::atomic<uint32_t>               last_bytes_newtx{0}; ///< Buffer state reported while the mutex is held
+  std::atomic<uint32_t>               last_bytes_prio{0};
+
   // SDU info for PDCP notifications
   buffered_pdcp_pdu_list<rlc_amd_pdu_header_t> undelivered_sdu_info_queue;
 
@@ -172,6 +204,7 @@ public:
 
   uint32_t get_rx_buffered_bytes() final; // returns sum of PDUs in rx_window
   uint32_t get_sdu_rx_latency_ms() final;
+  size_t   get_memory_usage() final { return sizeof(*this); }
 
   // Timeout callback interface
   void timer_expired(uint32_t timeout_id) final;
@@ -222,6 +255,7 @@ private:
 
   // Rx windows
   rlc_ringbuffer_t<rlc_amd_rx_pdu, RLC_AM_WINDOW_SIZE> rx_window;
+  rlc_am_rx_sn_bitmap<MOD>                             rx_sn_bitmap; ///< SNs in rx_window, for the status PDUs
   std::map<uint32_t, rlc_amd_rx_pdu_segments_t>        rx_segments;
 
   bool              poll_received = false;
@@ -34,6 +34,7 @@
 #include <mutex>
 #include <pthread.h>
 #include <queue>
+#include <set>
 
 namespace srsran {
 
@@ -109,7 +110,6 @@ public:
   void reestablish() final;
   void stop() final;
 
-  int  write_sdu(unique_byte_buffer_t sdu);
   void empty_queue() final;
   void empty_queue_no_lock();
 
@@ -127,6 +127,7 @@ public:
   bool     has_data() final;
   uint32_t get_buffer_state() final;
   void     get_buffer_state(uint32_t& tx_queue, uint32_t& prio_tx_queue) final;
+  size_t   get_memory_usage() final;
 
   // Status PDU
   bool     do_status();
@@ -250,9 +251,10 @@ public:
   int  handle_full_data_sdu(const rlc_am_nr_pdu_header_t& header, const uint8_t* payload, uint32_t nof_bytes);
   int  handle_segment_data_sdu(const rlc_am_nr_pdu_header_t& header, const uint8_t* payload, uint32_t nof_bytes);
   bool inside_rx_window(uint32_t sn) const;
+  rlc_amd_rx_sdu_nr_t& add_rx_sdu(uint32_t sn);
+  void                 remove_rx_sdu(uint32_t sn);
   bool valid_ack_sn(uint32_t sn) const;
   void write_to_upper_layers(uint32_t lcid, unique_byte_buffer_t sdu);
-  void insert_received_segment(rlc_amd_rx_pdu_nr segment, rlc_amd_rx_sdu_nr_t::segment_list_t& segment_list) const;
   /**
    * @brief update_segment_inventory This function updates the flags has_gap and fully_received of an SDU
    * according to the current inventory of received SDU segments
@@ -263,6 +265,7 @@ public:
   // Metrics
   uint32_t get_sdu_rx_latency_ms() final;
   uint32_t get_rx_buffered_bytes() final;
+  size_t   get_memory_usage() final;
 
   // Timers
   void timer_expired(uint32_t timeout_id);
@@ -282,6 +285,11 @@ private:
   // RX Window
   std::unique_ptr<rlc_ringbuffer_base<rlc_amd_rx_sdu_nr_t> > rx_window;
 
+  // SNs in the RX window and SNs fully received, to skip the runs of received and of lost SDUs
+  using rx_sn_bitmap_t = rlc_am_rx_sn_bitmap<cardinality(rlc_am_nr_sn_size_t::size18bits)>;
+  rx_sn_bitmap_t rx_sdus_present;
+  rx_sn_bitmap_t rx_sdus_complete;
+
   // Mutexes
   std::mutex mutex;
 
@@ -24,7 +24,7 @@
 
 #include "srsran/common/string_helpers.h"
 #include "srsran/rlc/rlc_am_base.h"
-#include <set>
+#include "srsran/rlc/rlc_am_data_structs.h"
 
 namespace srsran {
 
@@ -54,25 +54,16 @@ struct rlc_amd_pdu_nr_t {
   unique_byte_buffer_t   buf;
 };
 
-struct rlc_amd_rx_pdu_nr {
-  rlc_am_nr_pdu_header_t header = {};
-  unique_byte_buffer_t   buf    = nullptr;
-  uint32_t               rlc_sn = {};
-
-  rlc_amd_rx_pdu_nr() = default;
-  explicit rlc_amd_rx_pdu_nr(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
-};
-
-struct rlc_amd_rx_pdu_nr_cmp {
-  bool operator()(const rlc_amd_rx_pdu_nr& a, const rlc_amd_rx_pdu_nr& b) const { return a.header.so < b.header.so; }
-};
+/// Maximum number of disjoint byte ranges received per SDU. Segments that would need more are discarded, to be NACKed
+const uint32_t RLC_AM_NR_MAX_RX_BYTE_RANGES = 8;
 
 struct rlc_amd_rx_sdu_nr_t {
   uint32_t             rlc_sn         = 0;
   bool                 fully_received = false;
   bool                 has_gap        = false;
-  unique_byte_buffer_t buf;
-  using segment_list_t = std::set<rlc_amd_rx_pdu_nr, rlc_amd_rx_pdu_nr_cmp>;
+  unique_byte_buffer_t buf;         ///< SDU under reassembly. The segments are copied at their SO
+  uint32_t             sdu_len = 0; ///< Known once the last segment is received
+  using segment_list_t = rlc_am_rx_byte_ranges<RLC_AM_NR_MAX_RX_BYTE_RANGES>;
   segment_list_t segments;
 
   rlc_amd_rx_sdu_nr_t() = default;
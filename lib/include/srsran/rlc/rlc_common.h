@@ -25,9 +25,11 @@
 #include "srsran/adt/circular_buffer.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/intrusive_list.h"
+#include "srsran/adt/span.h"
 #include "srsran/interfaces/rlc_interface_types.h"
 #include "srsran/rlc/bearer_mem_pool.h"
 #include "srsran/rlc/rlc_metrics.h"
+#include "srsran/upper/byte_buffer_queue.h"
 #include <cstdlib>
 #include <list>
 
@@ -279,17 +281,61 @@ public:
     }
   }
 
+  void write_sdus_s(span<unique_byte_buffer_t> sdus)
+  {
+    if (suspended) {
+      for (unique_byte_buffer_t& sdu : sdus) {
+        queue_tx_sdu(std::move(sdu));
+      }
+    } else {
+      write_sdus(sdus);
+    }
+  }
+
   virtual rlc_mode_t get_mode() = 0;
   virtual uint32_t   get_lcid() = 0;
 
   virtual rlc_bearer_metrics_t get_metrics()   = 0;
   virtual void                 reset_metrics() = 0;
 
+  // Accounts the latencies of an SDU that leaves the TX queue, called by the TX entity when it first reads the SDU
+  void tx_sdu_dequeued(const byte_buffer_t& sdu)
+  {
+    if (not sdu.md.queue_tp.has_timestamp()) {
+      return;
+    }
+    std::chrono::microseconds queue_latency = sdu.md.queue_tp.get_latency_us();
+    tx_queue_latency.push(queue_latency);
+    if (sdu.md.tp.has_timestamp()) {
+      tx_proc_latency.push(sdu.md.tp.get_latency_us() - queue_latency);
+    }
+  }
+
+  void get_latency_metrics(rlc_bearer_metrics_t& m) const
+  {
+    tx_queue_latency.read(m.tx_queue_latency_hist);
+    tx_proc_latency.read(m.tx_proc_latency_hist);
+  }
+
+  void reset_latency_metrics()
+  {
+    tx_queue_latency.reset();
+    tx_proc_latency.reset();
+  }
+
   // PDCP interface
   virtual void write_sdu(unique_byte_buffer_t sdu) = 0;
   virtual void discard_sdu(uint32_t discard_sn)    = 0;
   virtual bool sdu_queue_is_full()                 = 0;
 
+  // Writes a burst of SDUs. The bearers that can enqueue them under a single lock override it
+  virtual void write_sdus(span<unique_byte_buffer_t> sdus)
+  {
+    for (unique_byte_buffer_t& sdu : sdus) {
+      write_sdu(std::move(sdu));
+    }
+  }
+
   // MAC interface
   virtual bool     has_data() = 0;
   bool             is_suspended() { return suspended; };
@@ -300,6 +346,9 @@ public:
 
   virtual void set_bsr_callback(bsr_callback_t callback) = 0;
 
+  // Charges the TX SDU queue to a byte budget shared with the other bearers of the UE. Bearers without queue ignore it
+  virtual void set_tx_budget(byte_buffer_budget* budget) {}
+
   void* operator new(size_t sz) { return allocate_rlc_bearer(sz); }
   void  operator delete(void* p) { return deallocate_rlc_bearer(p); }
 
@@ -310,6 +359,9 @@ protected:
 private:
   bool suspended = false;
 
+  latency_hist tx_queue_latency;
+  latency_hist tx_proc_latency;
+
   // Enqueues the Rx PDU in the resume queue
   void queue_rx_pdu(uint8_t* payload, uint32_t nof_bytes)
   {
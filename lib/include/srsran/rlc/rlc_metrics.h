@@ -23,6 +23,7 @@
 #define SRSRAN_RLC_METRICS_H
 
 #include "srsran/common/common.h"
+#include "srsran/common/latency_hist.h"
 #include <iostream>
 
 namespace srsran {
@@ -45,6 +46,11 @@ typedef struct {
 
   // misc metrics
   uint32_t rx_buffered_bytes; //< sum of payload of PDUs buffered in rx_window
+  uint64_t mem_bytes;         //< memory held by the bearer entity, including its windows
+
+  // TX SDU latency histograms, see latency_hist_bin()
+  uint32_t tx_queue_latency_hist[latency_hist_len]; //< Time from TX queue entry to the first PDU carrying the SDU
+  uint32_t tx_proc_latency_hist[latency_hist_len];  //< Time from stack ingress (e.g. GTP-U) to TX queue entry
 } rlc_bearer_metrics_t;
 
 typedef struct {
@@ -76,6 +76,7 @@ public:
   void                 reset_metrics();
 
   void set_bsr_callback(bsr_callback_t callback);
+  void set_tx_budget(byte_buffer_budget* budget) final;
 
   uint32_t get_lcid() const { return lcid; }
 
@@ -94,6 +95,7 @@ protected:
     void             write_sdu(unique_byte_buffer_t sdu);
     void             discard_sdu(uint32_t discard_sn);
     bool             sdu_queue_is_full();
+    void             set_tx_budget(byte_buffer_budget* budget);
     int              try_write_sdu(unique_byte_buffer_t sdu);
     void             reset_metrics();
     bool             has_data();
@@ -122,7 +124,8 @@ protected:
     srsran::rolling_average<double> mean_pdu_latency_us;
 #endif
 
-    virtual uint32_t build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes) = 0;
+    /// Writes the header and the SDU segments of the next PDU straight into the MAC payload
+    virtual uint32_t pack_data_pdu(uint8_t* payload, uint32_t nof_bytes) = 0;
 
     // helper functions
     virtual void debug_state() = 0;
@@ -57,7 +57,7 @@ private:
     rlc_um_lte_tx(rlc_um_base* parent_);
 
     bool     configure(const rlc_config_t& cfg, std::string rb_name);
-    uint32_t build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes);
+    uint32_t pack_data_pdu(uint8_t* payload, uint32_t nof_bytes);
     void     discard_sdu(uint32_t discard_sn);
     uint32_t get_buffer_state();
     bool     sdu_queue_is_full();
@@ -71,6 +71,9 @@ private:
      ***************************************************************************/
     uint32_t vt_us = 0; // Send state. SN to be assigned for next PDU.
 
+    // SDUs that fit entirely in the PDU being built, until they are copied into the MAC payload
+    std::vector<unique_byte_buffer_t> pdu_sdus;
+
     // Metrics
     void debug_state();
   };
@@ -127,7 +130,9 @@ void rlc_um_read_data_pdu_header(uint8_t*              payload,
                                  uint32_t              nof_bytes,
                                  rlc_umd_sn_size_t     sn_size,
                                  rlc_umd_pdu_header_t* header);
-void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* pdu);
+
+void     rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* pdu);
+uint32_t rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, uint8_t* payload);
 
 uint32_t rlc_um_packed_length(rlc_umd_pdu_header_t* header);
 bool     rlc_um_start_aligned(uint8_t fi);
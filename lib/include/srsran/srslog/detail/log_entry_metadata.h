@@ -23,6 +23,7 @@
 #define SRSLOG_DETAIL_LOG_ENTRY_METADATA_H
 
 #include "srsran/srslog/bundled/fmt/printf.h"
+#include "srsran/srslog/detail/support/hex_dump_buffer.h"
 #include <chrono>
 
 namespace srslog {
@@ -46,7 +47,7 @@ struct log_entry_metadata {
   fmt::dynamic_format_arg_store<fmt::printf_context>* store;
   std::string                                         log_name;
   char                                                log_tag;
-  std::vector<uint8_t>                                hex_dump;
+  hex_dump_buffer                                     hex_dump;
 };
 
 } // namespace detail
@@ -0,0 +1,131 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSLOG_DETAIL_SUPPORT_HEX_DUMP_BUFFER_H
+#define SRSLOG_DETAIL_SUPPORT_HEX_DUMP_BUFFER_H
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace srslog {
+
+namespace detail {
+
+/// Storage for the bytes of a hex dump attached to a log entry.
+/// Payloads up to inline_capacity bytes, which covers the usual hex dump
+/// limits, are kept inside the log entry itself, so that logging a PDU does
+/// not take a heap allocation. Larger payloads fall back to the heap.
+class hex_dump_buffer
+{
+public:
+  static constexpr size_t inline_capacity = 64;
+
+  using value_type     = uint8_t;
+  using iterator       = uint8_t*;
+  using const_iterator = const uint8_t*;
+
+  hex_dump_buffer() = default;
+
+  hex_dump_buffer(const uint8_t* first, const uint8_t* last) { assign(first, last - first); }
+
+  hex_dump_buffer(const hex_dump_buffer& other) { assign(other.data(), other.size()); }
+
+  hex_dump_buffer(hex_dump_buffer&& other) noexcept { *this = std::move(other); }
+
+  hex_dump_buffer& operator=(const hex_dump_buffer& other)
+  {
+    if (this != &other) {
+      assign(other.data(), other.size());
+    }
+    return *this;
+  }
+
+  hex_dump_buffer& operator=(hex_dump_buffer&& other) noexcept
+  {
+    if (this == &other) {
+      return *this;
+    }
+    heap = std::move(other.heap);
+    cap  = other.cap;
+    len  = other.len;
+    if (!heap) {
+      std::memcpy(inline_buf, other.inline_buf, len);
+    }
+    other.len = 0;
+    return *this;
+  }
+
+  /// Resizes the buffer, keeping its contents. New bytes are set to zero.
+  void resize(size_t n)
+  {
+    if (n > capacity()) {
+      std::unique_ptr<uint8_t[]> tmp(new uint8_t[n]);
+      std::memcpy(tmp.get(), data(), len);
+      heap = std::move(tmp);
+      cap  = n;
+    }
+    if (n > len) {
+      std::memset(data() + len, 0, n - len);
+    }
+    len = n;
+  }
+
+  size_t size() const { return len; }
+  bool   empty() const { return len == 0; }
+
+  uint8_t*       data() { return heap ? heap.get() : inline_buf; }
+  const uint8_t* data() const { return heap ? heap.get() : inline_buf; }
+
+  iterator       begin() { return data(); }
+  iterator       end() { return data() + len; }
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + len; }
+  const_iterator cbegin() const { return data(); }
+  const_iterator cend() const { return data() + len; }
+
+private:
+  size_t capacity() const { return heap ? cap : inline_capacity; }
+
+  void assign(const uint8_t* bytes, size_t n)
+  {
+    if (n > capacity()) {
+      heap.reset(new uint8_t[n]);
+      cap = n;
+    }
+    if (n) {
+      std::memcpy(data(), bytes, n);
+    }
+    len = n;
+  }
+
+private:
+  uint8_t                    inline_buf[inline_capacity];
+  std::unique_ptr<uint8_t[]> heap;
+  size_t                     cap = 0;
+  size_t                     len = 0;
+};
+
+} // namespace detail
+
+} // namespace srslog
+
+#endif // SRSLOG_DETAIL_SUPPORT_HEX_DUMP_BUFFER_H
@@ -22,78 +22,100 @@
 #ifndef SRSLOG_DETAIL_SUPPORT_WORK_QUEUE_H
 #define SRSLOG_DETAIL_SUPPORT_WORK_QUEUE_H
 
-#include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/detail/type_storage.h"
 #include "srsran/srslog/detail/support/backend_capacity.h"
-#include "srsran/srslog/detail/support/thread_utils.h"
+#include <atomic>
+#include <memory>
 
 namespace srslog {
 
 namespace detail {
 
-//: TODO: this is a temp work queue.
-
-/// Thread safe generic data type work queue.
+/// Thread safe generic data type work queue, with many producers and a single consumer.
+/// The queue is a bounded lock-free ring, where each slot carries a sequence number that tells whether it is ready to be
+/// written or read (D. Vyukov's bounded queue). Producers never block: when the queue is full the new element is
+/// discarded, so that a slow backend can not stall the threads that log.
 template <typename T, size_t capacity = SRSLOG_QUEUE_CAPACITY>
 class work_queue
 {
-  srsran::dyn_circular_buffer<T> queue;
-  mutable mutex                  m;
-  static constexpr size_t        threshold = capacity * 0.98;
+  static_assert(capacity > 1, "The queue needs at least two slots");
 
-public:
-  work_queue() : queue(capacity) {}
+  struct slot {
+    std::atomic<size_t>             seq;
+    srsran::detail::type_storage<T> item;
+  };
 
-  work_queue(const work_queue&) = delete;
-  work_queue& operator=(const work_queue&) = delete;
+  static constexpr size_t threshold = capacity * 0.98;
+  std::unique_ptr<slot[]> slots;
+  std::atomic<size_t>     tail; ///< Next position to be claimed by the producers
+  std::atomic<size_t>     head; ///< Next position to be read by the consumer
 
-  /// Inserts a new element into the back of the queue. Returns false when the
-  /// queue is full, otherwise true.
-  bool push(const T& value)
+  template <typename U>
+  bool push_impl(U&& value)
   {
-    m.lock();
-    // Discard the new element if we reach the maximum capacity.
-    if (queue.full()) {
-      m.unlock();
-      return false;
+    size_t pos = tail.load(std::memory_order_relaxed);
+    while (true) {
+      slot&  s    = slots[pos % capacity];
+      size_t seq  = s.seq.load(std::memory_order_acquire);
+      auto   diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+      if (diff == 0) {
+        // The slot is free, claim it.
+        if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          s.item.emplace(std::forward<U>(value));
+          s.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        // The slot still holds the element of the previous lap, the queue is full.
+        return false;
+      } else {
+        // Another producer claimed the slot, retry with the current tail.
+        pos = tail.load(std::memory_order_relaxed);
+      }
     }
-    queue.push(value);
-    m.unlock();
-
-    return true;
   }
 
-  /// Inserts a new element into the back of the queue. Returns false when the
-  /// queue is full, otherwise true.
-  bool push(T&& value)
+public:
+  work_queue() : slots(new slot[capacity]), tail(0), head(0)
   {
-    m.lock();
-    // Discard the new element if we reach the maximum capacity.
-    if (queue.full()) {
-      m.unlock();
-      return false;
+    for (size_t i = 0; i != capacity; ++i) {
+      slots[i].seq.store(i, std::memory_order_relaxed);
     }
-    queue.push(std::move(value));
-    m.unlock();
+  }
 
-    return true;
+  ~work_queue()
+  {
+    while (try_pop().first) {
+    }
   }
 
+  work_queue(const work_queue&) = delete;
+  work_queue& operator=(const work_queue&) = delete;
+
+  /// Inserts a new element into the back of the queue. Returns false when the
+  /// queue is full, otherwise true.
+  bool push(const T& value) { return push_impl(value); }
+
+  /// Inserts a new element into the back of the queue. Returns false when the
+  /// queue is full, otherwise true.
+  bool push(T&& value) { return push_impl(std::move(value)); }
+
   /// Extracts the top most element from the queue if it exists.
   /// Returns a pair with a bool indicating if the pop has been successful.
+  /// NOTE: only one thread may pop from the queue.
   std::pair<bool, T> try_pop()
   {
-    m.lock();
-
-    if (queue.empty()) {
-      m.unlock();
+    size_t pos = head.load(std::memory_order_relaxed);
+    slot&  s   = slots[pos % capacity];
+    if (s.seq.load(std::memory_order_acquire) != pos + 1) {
       return {false, T()};
     }
 
-    // Here we have been woken up normally.
-    T Item = std::move(queue.top());
-    queue.pop();
-
-    m.unlock();
+    T Item = std::move(s.item.get());
+    s.item.destroy();
+    head.store(pos + 1, std::memory_order_relaxed);
+    // Hand the slot over to the producers of the next lap.
+    s.seq.store(pos + capacity, std::memory_order_release);
 
     return {true, std::move(Item)};
   }
@@ -104,9 +126,9 @@ public:
   /// Returns true when the queue is almost full, otherwise returns false.
   bool is_almost_full() const
   {
-    scoped_lock lock(m);
-
-    return queue.size() > threshold;
+    size_t h = head.load(std::memory_order_relaxed);
+    size_t t = tail.load(std::memory_order_relaxed);
+    return t > h and t - h > threshold;
   }
 };
 
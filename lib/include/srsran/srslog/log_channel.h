@@ -68,7 +68,10 @@ public:
     should_print_context(config.should_print_context),
     ctx_value(0),
     hex_max_size(0),
-    is_enabled(true)
+    is_enabled(true),
+    hex_sampling(1),
+    hex_sample_count(0),
+    nof_dropped(0)
   {}
 
   log_channel(const log_channel& other) = delete;
@@ -91,6 +94,14 @@ public:
   /// Set to -1 to indicate no hex dump limit.
   void set_hex_dump_max_size(int size) { hex_max_size = size; }
 
+  /// Captures the hex dump of only one in every n log entries that carry one,
+  /// the other entries keep their message. Set to 1 to capture every hex dump.
+  void set_hex_dump_sampling(uint32_t n) { hex_sampling.store(std::max<uint32_t>(n, 1), std::memory_order_relaxed); }
+
+  /// Returns the number of log entries of this channel that have been
+  /// discarded because the backend was full.
+  uint32_t get_nof_dropped() const { return nof_dropped.load(std::memory_order_relaxed); }
+
   /// Builds the provided log entry and passes it to the backend. When the
   /// channel is disabled the log entry will be discarded.
   template <typename... Args>
@@ -103,6 +114,7 @@ public:
     // Populate the store with all incoming arguments.
     auto* store = backend.alloc_arg_store();
     if (!store) {
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
       return;
     }
     (void)std::initializer_list<int>{(store->push_back(std::forward<Args>(args)), 0)...};
@@ -119,7 +131,9 @@ public:
                                 store,
                                 log_name,
                                 log_tag}};
-    backend.push(std::move(entry));
+    if (!backend.push(std::move(entry))) {
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
   }
 
   /// Builds the provided log entry and passes it to the backend. When the
@@ -134,6 +148,7 @@ public:
     // Populate the store with all incoming arguments.
     auto* store = backend.alloc_arg_store();
     if (!store) {
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
       return;
     }
     (void)std::initializer_list<int>{(store->push_back(std::forward<Args>(args)), 0)...};
@@ -142,6 +157,11 @@ public:
     if (hex_max_size >= 0) {
       len = std::min<size_t>(len, hex_max_size);
     }
+    // Only one in every N hex dumps is captured when sampling.
+    uint32_t sampling = hex_sampling.load(std::memory_order_relaxed);
+    if (sampling > 1 && hex_sample_count.fetch_add(1, std::memory_order_relaxed) % sampling != 0) {
+      len = 0;
+    }
 
     // Send the log entry to the backend.
     log_formatter&    formatter = log_sink.get_formatter();
@@ -155,8 +175,10 @@ public:
                                 store,
                                 log_name,
                                 log_tag,
-                                std::vector<uint8_t>(buffer, buffer + len)}};
-    backend.push(std::move(entry));
+                                detail::hex_dump_buffer(buffer, buffer + len)}};
+    if (!backend.push(std::move(entry))) {
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
   }
 
   /// Builds the provided log entry and passes it to the backend. When the
@@ -180,7 +202,9 @@ public:
                                 nullptr,
                                 log_name,
                                 log_tag}};
-    backend.push(std::move(entry));
+    if (!backend.push(std::move(entry))) {
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
   }
 
   /// Builds the provided log entry and passes it to the backend. When the
@@ -195,6 +219,7 @@ public:
     // Populate the store with all incoming arguments.
     auto* store = backend.alloc_arg_store();
     if (!store) {
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
       return;
     }
     (void)std::initializer_list<int>{(store->push_back(std::forward<Args>(args)), 0)...};
@@ -211,7 +236,9 @@ public:
                                 store,
                                 log_name,
                                 log_tag}};
-    backend.push(std::move(entry));
+    if (!backend.push(std::move(entry))) {
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
   }
 
 private:
@@ -224,6 +251,9 @@ private:
   std::atomic<uint32_t> ctx_value;
   std::atomic<int>      hex_max_size;
   std::atomic<bool>     is_enabled;
+  std::atomic<uint32_t> hex_sampling;
+  std::atomic<uint32_t> hex_sample_count;
+  std::atomic<uint32_t> nof_dropped;
 };
 
 } // namespace srslog
@@ -92,6 +92,16 @@ public:
     }
   }
 
+  /// Captures the hex dump of only one in every n log entries in all the
+  /// channels of the logger.
+  void set_hex_dump_sampling(uint32_t n)
+  {
+    detail::scoped_lock lock(m);
+    for (auto channel : channels) {
+      channel->set_hex_dump_sampling(n);
+    }
+  }
+
 private:
   /// Comparison operator for enum types, used by the set_level method.
   friend bool operator<=(Enum lhs, Enum rhs)
@@ -156,6 +156,10 @@ std::unique_ptr<log_formatter> create_text_formatter();
 /// Creates a new instance of a JSON formatter.
 std::unique_ptr<log_formatter> create_json_formatter();
 
+/// Creates a new instance of a binary formatter, which writes the log entries
+/// unformatted to be decoded offline with the srslog_decoder tool.
+std::unique_ptr<log_formatter> create_binary_formatter();
+
 ///
 /// Sink management functions.
 ///
@@ -195,6 +199,19 @@ sink& fetch_file_sink(const std::string&             path,
                       bool                           force_flush = false,
                       std::unique_ptr<log_formatter> f           = get_default_log_formatter());
 
+/// Returns an instance of a sink that writes into a file in the specified path
+/// from a dedicated thread, so that the backend never blocks on disk I/O.
+/// Data is accumulated and written in chunks of chunk_size bytes, or at least
+/// once per second. When the disk can not keep up, data gets discarded.
+/// Specifying a max_size value different to zero will make the sink create a
+/// new file each time the current file exceeds this value. The units of
+/// max_size and chunk_size are bytes.
+/// NOTE: Any '#' characters in the path will get removed.
+sink& fetch_async_file_sink(const std::string&             path,
+                            size_t                         max_size   = 0,
+                            size_t                         chunk_size = 1024 * 1024,
+                            std::unique_ptr<log_formatter> f          = get_default_log_formatter());
+
 /// Returns an instance of a sink that writes into syslog
 /// preamble: The string  prepended to every message, If ident is "", the program name is used.
 /// log_local: custom unused facilities that syslog provides which can be used by the user
@@ -31,25 +31,59 @@
 #define SRSRAN_BYTE_BUFFERQUEUE_H
 
 #include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/spsc_queue.h"
 #include "srsran/common/block_queue.h"
 #include "srsran/common/byte_buffer.h"
 #include "srsran/common/common.h"
+#include <atomic>
 #include <functional>
 #include <pthread.h>
 
 namespace srsran {
 
+/// Byte budget shared by the TX SDU queues of a UE. The queues charge it with the bytes of their SDUs and refuse the
+/// SDUs that would exceed it, except when they are empty, so that a backlogged bearer can't starve the other ones
+class byte_buffer_budget
+{
+public:
+  /// Sets the maximum number of queued bytes, where 0 means no limit
+  void     set_max_bytes(uint32_t max_bytes_) { max_bytes.store(max_bytes_, std::memory_order_relaxed); }
+  uint32_t get_max_bytes() const { return max_bytes.load(std::memory_order_relaxed); }
+  uint32_t get_used_bytes() const { return used_bytes.load(std::memory_order_relaxed); }
+
+  bool fits(uint32_t nof_bytes) const
+  {
+    uint32_t max = get_max_bytes();
+    return max == 0 or get_used_bytes() + nof_bytes <= max;
+  }
+  void take(uint32_t nof_bytes) { used_bytes.fetch_add(nof_bytes, std::memory_order_relaxed); }
+  void give_back(uint32_t nof_bytes) { used_bytes.fetch_sub(nof_bytes, std::memory_order_relaxed); }
+
+private:
+  std::atomic<uint32_t> max_bytes{0};
+  std::atomic<uint32_t> used_bytes{0};
+};
+
 class byte_buffer_queue
 {
 public:
   byte_buffer_queue(int capacity = 128) :
-    queue(capacity, push_callback(unread_bytes, n_sdus), pop_callback(unread_bytes, n_sdus))
+    queue(capacity, push_callback(unread_bytes, n_sdus, budget), pop_callback(unread_bytes, n_sdus, budget))
   {}
+  ~byte_buffer_queue()
+  {
+    if (budget != nullptr) {
+      budget->give_back(unread_bytes);
+    }
+  }
 
   void write(unique_byte_buffer_t msg) { queue.push_blocking(std::move(msg)); }
 
   srsran::error_type<unique_byte_buffer_t> try_write(unique_byte_buffer_t&& msg)
   {
+    if (not fits(msg->N_bytes)) {
+      return std::move(msg);
+    }
     return queue.try_push(std::move(msg));
   }
 
@@ -75,11 +109,24 @@ public:
   }
 
   // This is a hack to reset N_bytes counter when queue is corrupted (see line 89)
-  void reset() { unread_bytes = 0; }
+  void reset()
+  {
+    if (budget != nullptr) {
+      budget->give_back(unread_bytes);
+    }
+    unread_bytes = 0;
+  }
 
   bool is_empty() { return queue.empty(); }
 
-  bool is_full() { return queue.full(); }
+  /// Full when out of slots, or when the byte budget is used up and the queue already holds SDUs
+  bool is_full() { return queue.full() or not fits(1); }
+
+  /// Charges the SDUs queued from now on to the budget, which is shared with other queues. The queue must be empty
+  void set_budget(byte_buffer_budget* budget_) { budget = budget_; }
+
+  /// Whether an SDU of nof_bytes is within the byte budget
+  bool fits(uint32_t nof_bytes) { return budget == nullptr or queue.empty() or budget->fits(nof_bytes); }
 
   template <typename F>
   bool apply_first(const F& func)
@@ -89,20 +136,28 @@ public:
 
 private:
   struct push_callback {
-    explicit push_callback(std::atomic<uint32_t>& unread_bytes_, std::atomic<uint32_t>& n_sdus_) :
-      unread_bytes(unread_bytes_), n_sdus(n_sdus_)
+    explicit push_callback(std::atomic<uint32_t>& unread_bytes_,
+                           std::atomic<uint32_t>& n_sdus_,
+                           byte_buffer_budget*&   budget_) :
+      unread_bytes(unread_bytes_), n_sdus(n_sdus_), budget(budget_)
     {}
     void operator()(const unique_byte_buffer_t& msg)
     {
       unread_bytes.fetch_add(msg->N_bytes, std::memory_order_relaxed);
       n_sdus.fetch_add(1, std::memory_order_relaxed);
+      if (budget != nullptr) {
+        budget->take(msg->N_bytes);
+      }
     }
     std::atomic<uint32_t>& unread_bytes;
     std::atomic<uint32_t>& n_sdus;
+    byte_buffer_budget*&   budget;
   };
   struct pop_callback {
-    explicit pop_callback(std::atomic<uint32_t>& unread_bytes_, std::atomic<uint32_t>& n_sdus_) :
-      unread_bytes(unread_bytes_), n_sdus(n_sdus_)
+    explicit pop_callback(std::atomic<uint32_t>& unread_bytes_,
+                          std::atomic<uint32_t>& n_sdus_,
+                          byte_buffer_budget*&   budget_) :
+      unread_bytes(unread_bytes_), n_sdus(n_sdus_), budget(budget_)
     {}
     void operator()(const unique_byte_buffer_t& msg)
     {
@@ -110,21 +165,113 @@ private:
         return;
       }
       // non-atomic update of both state variables
-      unread_bytes.fetch_sub(std::min(msg->N_bytes, unread_bytes.load(std::memory_order_relaxed)),
-                             std::memory_order_relaxed);
+      uint32_t nof_bytes = std::min(msg->N_bytes, unread_bytes.load(std::memory_order_relaxed));
+      unread_bytes.fetch_sub(nof_bytes, std::memory_order_relaxed);
       n_sdus.store(std::max(0, (int32_t)(n_sdus.load(std::memory_order_relaxed)) - 1), std::memory_order_relaxed);
+      if (budget != nullptr) {
+        budget->give_back(nof_bytes);
+      }
     }
     std::atomic<uint32_t>& unread_bytes;
     std::atomic<uint32_t>& n_sdus;
+    byte_buffer_budget*&   budget;
   };
 
   std::atomic<uint32_t> unread_bytes = {0};
   std::atomic<uint32_t> n_sdus       = {0};
+  byte_buffer_budget*   budget       = nullptr;
 
 public:
   dyn_blocking_queue<unique_byte_buffer_t, push_callback, pop_callback> queue;
 };
 
+/// Lock-free variant of the byte_buffer_queue for a single writer and a single reader thread, that never blocks. The
+/// byte and SDU counters may be read from any thread
+class byte_buffer_spsc_queue
+{
+public:
+  explicit byte_buffer_spsc_queue(uint32_t capacity = 128) : queue(capacity) {}
+  ~byte_buffer_spsc_queue()
+  {
+    if (budget != nullptr) {
+      budget->give_back(size_bytes());
+    }
+  }
+
+  srsran::error_type<unique_byte_buffer_t> try_write(unique_byte_buffer_t&& msg)
+  {
+    uint32_t nof_bytes = msg->N_bytes;
+    if (not fits(nof_bytes)) {
+      return std::move(msg);
+    }
+    // The counters are raised first, so that the reader never takes them below zero
+    add_bytes(nof_bytes);
+    if (not queue.try_push(std::move(msg))) {
+      remove_bytes(nof_bytes);
+      return std::move(msg);
+    }
+    return {};
+  }
+
+  bool try_read(unique_byte_buffer_t* msg)
+  {
+    if (not queue.try_pop(*msg)) {
+      return false;
+    }
+    // Discarded SDUs were already removed from the counters
+    if (*msg != nullptr) {
+      remove_bytes((*msg)->N_bytes);
+    }
+    return true;
+  }
+
+  /// Frees the first SDU for which pred returns true. Its slot stays in the queue until it is read. Reader side only
+  template <typename F>
+  bool discard_first(const F& pred)
+  {
+    return queue.apply_first([this, &pred](unique_byte_buffer_t& sdu) {
+      if (sdu == nullptr or not pred(sdu)) {
+        return false;
+      }
+      remove_bytes(sdu->N_bytes);
+      sdu.reset();
+      return true;
+    });
+  }
+
+  void     resize(uint32_t capacity) { queue.set_size(capacity); }
+  uint32_t size() { return (uint32_t)queue.size(); }
+  uint32_t get_n_sdus() { return n_sdus.load(std::memory_order_relaxed); }
+  uint32_t size_bytes() { return unread_bytes.load(std::memory_order_relaxed); }
+  bool     is_empty() { return queue.empty(); }
+  bool     is_full() { return queue.full() or not fits(1); }
+  bool     fits(uint32_t nof_bytes) { return budget == nullptr or queue.empty() or budget->fits(nof_bytes); }
+  void     set_budget(byte_buffer_budget* budget_) { budget = budget_; }
+
+private:
+  void add_bytes(uint32_t nof_bytes)
+  {
+    unread_bytes.fetch_add(nof_bytes, std::memory_order_relaxed);
+    n_sdus.fetch_add(1, std::memory_order_relaxed);
+    if (budget != nullptr) {
+      budget->take(nof_bytes);
+    }
+  }
+  void remove_bytes(uint32_t nof_bytes)
+  {
+    unread_bytes.fetch_sub(nof_bytes, std::memory_order_relaxed);
+    n_sdus.fetch_sub(1, std::memory_order_relaxed);
+    if (budget != nullptr) {
+      budget->give_back(nof_bytes);
+    }
+  }
+
+  spsc_queue<unique_byte_buffer_t> queue;
+  std::atomic<uint32_t>            unread_bytes = {0};
+  std::atomic<uint32_t>            n_sdus       = {0};
+  byte_buffer_budget*              budget       = nullptr;
+};
+
 } // namespace srsran
 
 #endif // SRSRAN_BYTE_BUFFERQUEUE_H
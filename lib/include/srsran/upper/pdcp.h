@@ -40,6 +40,7 @@ public:
 
   // Stack interface
   bool is_lcid_enabled(uint32_t lcid);
+  void set_crypto_workers(task_thread_pool* workers);
 
   // RRC interface
   void reestablish() override;
@@ -47,6 +48,7 @@ public:
   void reset() override;
   void set_enabled(uint32_t lcid, bool enabled) override;
   void write_sdu(uint32_t lcid, unique_byte_buffer_t sdu, int sn = -1) override;
+  void write_sdus(uint32_t lcid, span<unique_byte_buffer_t> sdus);
   void write_sdu_mch(uint32_t lcid, unique_byte_buffer_t sdu);
   int  add_bearer(uint32_t lcid, const pdcp_config_t& cnfg) override;
   void add_bearer_mrb(uint32_t lcid, const pdcp_config_t& cnfg);
@@ -64,6 +66,7 @@ public:
 
   // RLC interface
   void write_pdu(uint32_t lcid, unique_byte_buffer_t sdu) override;
+  void write_pdus(uint32_t lcid, span<unique_byte_buffer_t> pdus) override;
   void write_pdu_mch(uint32_t lcid, unique_byte_buffer_t sdu) override;
   void write_pdu_bcch_bch(unique_byte_buffer_t sdu) override;
   void write_pdu_bcch_dlsch(unique_byte_buffer_t sdu) override;
@@ -72,7 +75,7 @@ public:
   void notify_failure(uint32_t lcid, const pdcp_sn_vector_t& pdcp_sns) override;
 
   // eNB-only methods
-  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint32_t lcid);
+  srsran::pdcp_sdu_list_t get_buffered_pdus(uint32_t lcid);
 
   // Metrics
   void get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti);
@@ -84,6 +87,7 @@ private:
   srsue::gw_interface_pdcp*  gw     = nullptr;
   srsran::task_sched_handle  task_sched;
   srslog::basic_logger&      logger;
+  task_thread_pool*          crypto_workers = nullptr;
 
   using pdcp_map_t = std::map<uint16_t, std::unique_ptr<pdcp_entity_base> >;
   pdcp_map_t pdcp_array, pdcp_array_mrb;
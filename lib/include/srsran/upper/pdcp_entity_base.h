@@ -23,16 +23,20 @@
 #define SRSRAN_PDCP_ENTITY_BASE_H
 
 #include "srsran/adt/accumulators.h"
+#include "srsran/adt/span.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/interfaces_common.h"
 #include "srsran/common/security.h"
 #include "srsran/common/task_scheduler.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/common/threads.h"
 #include "srsran/common/timers.h"
 #include "srsran/interfaces/pdcp_interface_types.h"
 #include "srsran/upper/byte_buffer_queue.h"
 #include "srsran/upper/pdcp_metrics.h"
+#include <atomic>
+#include <deque>
 
 namespace srsran {
 
@@ -74,6 +78,9 @@ public:
   bool is_srb() { return cfg.rb_type == PDCP_RB_IS_SRB; }
   bool is_drb() { return cfg.rb_type == PDCP_RB_IS_DRB; }
 
+  // Sets the pool where the DRB PDUs are integrity protected and ciphered. When null, it is done inline
+  void set_crypto_workers(task_thread_pool* workers);
+
   // RRC interface
   void enable_integrity(srsran_direction_t direction = DIRECTION_TXRX)
   {
@@ -121,15 +128,31 @@ public:
   // GW/SDAP/RRC interface
   virtual void write_sdu(unique_byte_buffer_t sdu, int sn = -1) = 0;
 
+  // Burst of SDUs, with the SNs assigned by PDCP. The SDUs are moved out of the span
+  virtual void write_sdus(span<unique_byte_buffer_t> sdus)
+  {
+    for (unique_byte_buffer_t& sdu : sdus) {
+      write_sdu(std::move(sdu));
+    }
+  }
+
   // RLC interface
   virtual void write_pdu(unique_byte_buffer_t pdu)               = 0;
   virtual void notify_delivery(const pdcp_sn_vector_t& pdcp_sns) = 0;
   virtual void notify_failure(const pdcp_sn_vector_t& pdcp_sns)  = 0;
 
+  // Burst of PDUs received from RLC. The PDUs are moved out of the span
+  void write_pdus(span<unique_byte_buffer_t> pdus)
+  {
+    for (unique_byte_buffer_t& pdu : pdus) {
+      write_pdu(std::move(pdu));
+    }
+  }
+
   virtual void get_bearer_state(pdcp_lte_state_t* state)                     = 0;
   virtual void set_bearer_state(const pdcp_lte_state_t& state, bool set_fmc) = 0;
 
-  virtual std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus() = 0;
+  virtual srsran::pdcp_sdu_list_t get_buffered_pdus() = 0;
 
   virtual void send_status_report() = 0;
 
@@ -167,14 +190,36 @@ protected:
                        srsran_rat_t::lte};
   std::string   rb_name;
 
-  srsran::as_security_config_t sec_cfg = {};
+  // Security config of the bearer and the EIA2/EEA2 key schedules of its keys. A new context is created on each
+  // security configuration, so that the PDUs in the crypto workers keep the keys they were submitted with
+  struct security_ctx_t {
+    srsran::as_security_config_t sec_cfg = {};
+    security_aes_key_t           int_aes_key;
+    security_aes_key_t           enc_aes_key;
+  };
+  std::shared_ptr<const security_ctx_t> sec = std::make_shared<security_ctx_t>();
 
   // Security functions
-  void integrity_generate(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
+  void integrity_generate(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac)
+  {
+    integrity_generate(*sec, msg, msg_len, count, mac);
+  }
+  void integrity_generate(const security_ctx_t& ctx, uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
   bool integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
-  void cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* ct);
+  void cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* ct)
+  {
+    cipher_encrypt(*sec, msg, msg_len, count, ct);
+  }
+  void cipher_encrypt(const security_ctx_t& ctx, uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* ct);
   void cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t count, uint8_t* msg);
 
+  // Asynchronous TX security. The PDUs are passed to lower layers in COUNT order once the crypto workers are done
+  bool         tx_crypto_offload() { return crypto_workers != nullptr and is_drb(); }
+  void         submit_tx_pdu(unique_byte_buffer_t pdu, uint32_t count, bool do_integrity, bool do_encryption);
+  void         flush_tx_crypto_jobs(bool wait);
+  void         discard_tx_crypto_jobs();
+  virtual void pass_to_lower_layers(unique_byte_buffer_t pdu) = 0;
+
   // Common packing functions
   bool            is_control_pdu(const unique_byte_buffer_t& pdu);
   pdcp_pdu_type_t get_control_pdu_type(const unique_byte_buffer_t& pdu);
@@ -187,6 +232,36 @@ protected:
   // Metrics helpers
   pdcp_bearer_metrics_t           metrics = {};
   srsran::rolling_average<double> tx_pdu_ack_latency_ms;
+
+  // Accounts the latency of an SDU delivered to the upper layers, measured from the RLC reception of its first segment
+  void account_rx_latency(const unique_byte_buffer_t& sdu)
+  {
+    if (sdu->md.tp.has_timestamp()) {
+      metrics.rx_latency_hist[latency_hist_bin(sdu->get_latency_us())]++;
+    }
+  }
+
+private:
+  struct tx_crypto_job_t {
+    unique_byte_buffer_t                  pdu;
+    uint32_t                              count         = 0;
+    bool                                  do_integrity  = false;
+    bool                                  do_encryption = false;
+    std::shared_ptr<const security_ctx_t> sec;
+    std::atomic<bool>                     done{false};
+  };
+  // Shared with the crypto workers, which notify the entity through it while it exists
+  struct tx_crypto_owner_t {
+    pdcp_entity_base* entity;
+    task_sched_handle task_sched;
+  };
+
+  void apply_tx_security(tx_crypto_job_t& job);
+
+  task_thread_pool*                             crypto_workers  = nullptr;
+  uint32_t                                      crypto_affinity = 0; ///< Keeps the jobs of the bearer in one worker
+  std::shared_ptr<tx_crypto_owner_t>            tx_crypto_owner;
+  std::deque<std::shared_ptr<tx_crypto_job_t> > tx_crypto_jobs;
 };
 
 inline uint32_t pdcp_entity_base::HFN(uint32_t count)
@@ -23,6 +23,7 @@
 #define SRSRAN_PDCP_ENTITY_LTE_H
 
 #include "srsran/adt/circular_array.h"
+#include "srsran/adt/circular_map.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/security.h"
@@ -44,14 +45,14 @@ class undelivered_sdus_queue
 public:
   explicit undelivered_sdus_queue(srsran::task_sched_handle task_sched, uint32_t sn_mod);
 
-  bool            empty() const { return count == 0; }
-  bool            is_full() const { return count >= capacity; }
-  uint32_t        size() const { return count; }
+  bool            empty() const { return sdus.empty(); }
+  bool            is_full() const { return sdus.full(); }
+  uint32_t        size() const { return sdus.size(); }
   static uint32_t get_capacity() { return capacity; }
   bool            has_sdu(uint32_t sn) const
   {
     assert(sn != invalid_sn && "provided PDCP SN is invalid");
-    return sdus[sn].sdu != nullptr and sdus[sn].sdu->md.pdcp_sn == sn;
+    return sdus.contains(sn);
   }
   // Getter for the number of discard timers. Used for debugging.
   size_t nof_discard_timers() const;
@@ -64,7 +65,7 @@ public:
   unique_byte_buffer_t& operator[](uint32_t sn)
   {
     assert(has_sdu(sn));
-    return sdus[sn].sdu;
+    return sdus[sn];
   }
   bool clear_sdu(uint32_t sn);
   void clear();
@@ -77,7 +78,7 @@ public:
 
   uint32_t get_lms() const { return lms; }
 
-  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_sdus();
+  srsran::pdcp_sdu_list_t get_buffered_sdus();
 
 private:
   const static uint32_t capacity   = 4096;
@@ -86,16 +87,11 @@ private:
 
   uint32_t increment_sn(uint32_t sn) { return (sn + 1) % sn_mod; }
 
-  struct sdu_data {
-    srsran::unique_byte_buffer_t sdu;
-    srsran::unique_timer         discard_timer;
-  };
-
-  uint32_t                                   count = 0;
-  uint32_t                                   bytes = 0;
-  uint32_t                                   fms   = 0; // SN of the first missing PDCP SDU
-  uint32_t                                   lms   = 0;
-  srsran::circular_array<sdu_data, capacity> sdus;
+  uint32_t                                                 bytes = 0;
+  uint32_t                                                 fms   = 0; // SN of the first missing PDCP SDU
+  uint32_t                                                 lms   = 0;
+  srsran::dyn_circular_map<uint32_t, unique_byte_buffer_t> sdus{capacity};
+  srsran::circular_array<srsran::unique_timer, capacity>   discard_timers;
 };
 
 /****************************************************************************
@@ -126,6 +122,7 @@ public:
 
   // GW/RRC interface
   void write_sdu(unique_byte_buffer_t sdu, int sn = -1) override;
+  void write_sdus(span<unique_byte_buffer_t> sdus) override;
 
   // RLC interface
   void write_pdu(unique_byte_buffer_t pdu) override;
@@ -139,7 +136,7 @@ public:
   bool store_sdu(uint32_t tx_count, const unique_byte_buffer_t& pdu);
 
   // Getter for unacknowledged PDUs. Used for handover
-  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus() override;
+  srsran::pdcp_sdu_list_t get_buffered_pdus() override;
 
   // Status report helper(s)
   void send_status_report() override;
@@ -166,6 +163,11 @@ private:
   uint32_t reordering_window = 0;
   uint32_t maximum_pdcp_sn   = 0;
 
+  // TX helpers
+  bool can_tx_sdus();
+  bool build_tx_pdu(unique_byte_buffer_t& sdu, int upper_sn);
+  void pass_to_lower_layers(unique_byte_buffer_t pdu) override;
+
   // PDU handlers
   void handle_control_pdu(srsran::unique_byte_buffer_t pdu);
   void handle_srb_pdu(srsran::unique_byte_buffer_t pdu);
@@ -23,6 +23,7 @@
 #define SRSRAN_PDCP_ENTITY_NR_H
 
 #include "pdcp_entity_base.h"
+#include "srsran/adt/circular_map.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/interfaces_common.h"
@@ -55,6 +56,7 @@ public:
 
   // RRC interface
   void write_sdu(unique_byte_buffer_t sdu, int sn = -1) final;
+  void write_sdus(span<unique_byte_buffer_t> sdus) final;
 
   // RLC interface
   void write_pdu(unique_byte_buffer_t pdu) final;
@@ -68,7 +70,7 @@ public:
   pdcp_bearer_metrics_t get_metrics() override;
   void                  reset_metrics() override;
 
-  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus() override { return {}; }
+  srsran::pdcp_sdu_list_t get_buffered_pdus() override { return {}; }
 
   // State variable getters (useful for testing)
   uint32_t nof_discard_timers() { return discard_timers_map.size(); }
@@ -98,9 +100,13 @@ private:
   // Constants: 3GPP TS 38.323 v15.2.0, section 7.2
   uint32_t window_size = 0;
 
-  // Reordering Queue / Timers
-  std::map<uint32_t, unique_byte_buffer_t> reorder_queue;
-  timer_handler::unique_timer              reordering_timer;
+  // Reordering Queue / Timers. The queue is indexed by COUNT over the [RX_DELIV, RX_DELIV + Window_Size) range
+  dyn_circular_map<uint32_t, unique_byte_buffer_t> reorder_queue;
+  timer_handler::unique_timer                      reordering_timer;
+
+  // TX helper
+  bool build_tx_pdu(unique_byte_buffer_t& sdu);
+  void pass_to_lower_layers(unique_byte_buffer_t pdu) override;
 
   // Pass to Upper Layers Helper function
   void deliver_all_consecutive_counts();
@@ -162,6 +168,7 @@ inline void pdcp_entity_nr::pass_to_upper_layers(unique_byte_buffer_t sdu)
   if (is_srb()) {
     rrc->write_pdu(lcid, std::move(sdu));
   } else {
+    account_rx_latency(sdu);
     gw->write_pdu(lcid, std::move(sdu));
   }
 }
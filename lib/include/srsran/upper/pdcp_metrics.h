@@ -23,6 +23,7 @@
 #define SRSRAN_PDCP_METRICS_H
 
 #include "srsran/common/common.h"
+#include "srsran/common/latency_hist.h"
 #include <iostream>
 
 namespace srsran {
@@ -39,6 +40,9 @@ typedef struct {
   uint64_t tx_notification_latency_ms; //< Average time in ms from PDU delivery to RLC to ACK notification from RLC
   uint32_t num_tx_buffered_pdus;       //< Number of PDUs waiting for ACK
   uint32_t num_tx_buffered_pdus_bytes; //< Number of bytes of PDUs waiting for ACK
+
+  // RX SDU latency histogram, see latency_hist_bin()
+  uint32_t rx_latency_hist[latency_hist_len]; //< Time from the first RLC segment reception to upper layer delivery
 } pdcp_bearer_metrics_t;
 
 typedef struct {
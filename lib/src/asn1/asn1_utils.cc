@@ -113,6 +113,25 @@ map_enum_number<const float>(const float* array, uint32_t nof_types, uint32_t en
        bit_ref
 *********************/
 
+/// Loads 8 bytes as a big-endian word, so that the first bit in the buffer is the MSB
+static inline uint64_t load_be64(const uint8_t* p)
+{
+  uint64_t w;
+  memcpy(&w, p, sizeof(w));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  w = __builtin_bswap64(w);
+#endif
+  return w;
+}
+
+static inline void store_be64(uint8_t* p, uint64_t w)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  w = __builtin_bswap64(w);
+#endif
+  memcpy(p, &w, sizeof(w));
+}
+
 template <typename Ptr>
 int bit_ref_impl<Ptr>::distance(const bit_ref_impl<Ptr>& other) const
 {
@@ -150,6 +169,30 @@ SRSASN_CODE bit_ref::pack(uint64_t val, uint32_t n_bits)
     log_error("This method only supports packing up to 64 bits");
     return SRSASN_ERROR_ENCODE_FAIL;
   }
+  if (n_bits == 0) {
+    return SRSASN_SUCCESS;
+  }
+
+  // Fast paths: the field fits in the current byte, or in the 8 bytes starting at ptr, which are then updated with a
+  // single read-modify-write. As in the bytewise path, the bits following the field in its last byte are zeroed, and
+  // the next bytes are left untouched
+  uint32_t end_bit = offset + n_bits;
+  if (end_bit <= 8 and ptr < max_ptr) {
+    *ptr = (*ptr & ~(0xffu >> offset)) | static_cast<uint8_t>((val & ((1u << n_bits) - 1u)) << (8u - end_bit));
+    ptr += end_bit / 8;
+    offset = end_bit % 8;
+    return SRSASN_SUCCESS;
+  }
+  if (end_bit <= 64 and ptr + sizeof(uint64_t) <= max_ptr) {
+    uint32_t touched_bits = (end_bit + 7u) & ~7u;
+    uint64_t field_mask   = (~0ull >> offset) & ~(touched_bits == 64 ? 0ull : ~0ull >> touched_bits);
+    uint64_t field        = (val & ((1ull << n_bits) - 1ull)) << (64u - end_bit);
+    store_be64(ptr, (load_be64(ptr) & ~field_mask) | field);
+    ptr += end_bit / 8;
+    offset = end_bit % 8;
+    return SRSASN_SUCCESS;
+  }
+
   uint64_t mask;
   while (n_bits > 0) {
     if (ptr >= max_ptr) {
@@ -182,6 +225,16 @@ SRSASN_CODE unpack_bits(T& val, Ptr& ptr, uint8_t& offset, const uint8_t* max_pt
     log_error("This method only supports unpacking up to %d bits", (int)sizeof(T) * 8);
     return SRSASN_ERROR_DECODE_FAIL;
   }
+
+  // Fast path: the field fits in the 8 bytes starting at ptr, which are read as a single word
+  uint32_t end_bit = offset + n_bits;
+  if (n_bits > 0 and end_bit <= 64 and ptr + sizeof(uint64_t) <= max_ptr) {
+    val = static_cast<T>((load_be64(ptr) << offset) >> (64u - n_bits));
+    ptr += end_bit / 8;
+    offset = end_bit % 8;
+    return SRSASN_SUCCESS;
+  }
+
   val = 0;
   while (n_bits > 0) {
     if (ptr >= max_ptr) {
@@ -260,7 +313,16 @@ SRSASN_CODE bit_ref_impl<Ptr>::unpack_bytes(uint8_t* buf, uint32_t n_bytes)
       log_error("unpack_bytes (unaligned): Buffer size limit was achieved");
       return SRSASN_ERROR_DECODE_FAIL;
     }
-    for (uint32_t i = 0; i < n_bytes; ++i) {
+    // Seven bytes at a time, so that they fit in a word along with the offset
+    uint32_t i = 0;
+    for (; i + 7 <= n_bytes; i += 7) {
+      uint64_t word;
+      HANDLE_CODE(unpack(word, 56));
+      for (uint32_t j = 0; j < 7; ++j) {
+        buf[i + j] = static_cast<uint8_t>(word >> (48u - 8u * j));
+      }
+    }
+    for (; i < n_bytes; ++i) {
       HANDLE_CODE(unpack(buf[i], 8));
     }
   }
@@ -314,7 +376,7 @@ SRSASN_CODE bit_ref::pack_bytes(const uint8_t* buf, uint32_t n_bytes)
   if (n_bytes == 0) {
     return SRSASN_SUCCESS;
   }
-  if (ptr + n_bytes >= max_ptr) {
+  if (ptr + n_bytes + (offset != 0 ? 1 : 0) > max_ptr) {
     log_error("pack_bytes: Buffer size limit was achieved");
     return SRSASN_ERROR_ENCODE_FAIL;
   }
@@ -323,7 +385,16 @@ SRSASN_CODE bit_ref::pack_bytes(const uint8_t* buf, uint32_t n_bytes)
     memcpy(ptr, buf, n_bytes);
     ptr += n_bytes;
   } else {
-    for (uint32_t i = 0; i < n_bytes; ++i) {
+    // Seven bytes at a time, so that they fit in a word along with the offset
+    uint32_t i = 0;
+    for (; i + 7 <= n_bytes; i += 7) {
+      uint64_t word = 0;
+      for (uint32_t j = 0; j < 7; ++j) {
+        word = (word << 8u) | buf[i + j];
+      }
+      pack(word, 56);
+    }
+    for (; i < n_bytes; ++i) {
       pack(buf[i], 8);
     }
   }
@@ -1452,9 +1523,7 @@ varlength_field_pack_guard::~varlength_field_pack_guard()
   pack_length(brefstart, nof_bytes, align);
 
   // pack encoded bytes
-  for (uint32_t i = 0; i < nof_bytes; ++i) {
-    brefstart.pack((*buffer_ptr)[i], 8);
-  }
+  brefstart.pack_bytes(buffer_ptr->data(), nof_bytes);
   *bref_tracker = brefstart;
 }
 
@@ -1471,6 +1540,71 @@ varlength_field_unpack_guard::~varlength_field_unpack_guard()
   bref_tracker->unpack(pad, len * 8 - bref_tracker->distance(bref0));
 }
 
+/*********************
+  protocol_ie_index
+*********************/
+
+SRSASN_CODE protocol_ie_index::index(const uint8_t* buf, uint32_t len)
+{
+  nof_ies_ = 0;
+  cbit_ref bref(buf, len);
+
+  // CHOICE of initiatingMessage, successfulOutcome and unsuccessfulOutcome, with extension marker
+  bool    choice_ext;
+  uint8_t crit;
+  HANDLE_CODE(bref.unpack(choice_ext, 1));
+  HANDLE_CODE(bref.unpack(type, 2));
+  if (choice_ext or type > 2) {
+    return SRSASN_ERROR_DECODE_FAIL;
+  }
+  HANDLE_CODE(unpack_integer(proc, bref, (uint16_t)0u, (uint16_t)255u, false, true));
+  HANDLE_CODE(bref.unpack(crit, 2));
+
+  // Open type holding the ProtocolIE-Container of the procedure
+  uint32_t value_len, nof_ies;
+  HANDLE_CODE(unpack_length(value_len, bref, true));
+  HANDLE_CODE(bref.unpack(ext_, 1));
+  HANDLE_CODE(unpack_length(nof_ies, bref, 0u, 65535u, true));
+  if (nof_ies > max_nof_ies) {
+    return SRSASN_ERROR_DECODE_FAIL;
+  }
+  for (; nof_ies_ < nof_ies; ++nof_ies_) {
+    ie_t& ie = ies[nof_ies_];
+    HANDLE_CODE(unpack_integer(ie.id, bref, (uint32_t)0u, (uint32_t)65535u, false, true));
+    HANDLE_CODE(bref.unpack(crit, 2));
+    HANDLE_CODE(unpack_length(ie.len, bref, true));
+    // The length leaves the bit_ref byte-aligned
+    ie.value = buf + bref.distance_bytes();
+    HANDLE_CODE(bref.advance_bits(ie.len * 8));
+  }
+  return SRSASN_SUCCESS;
+}
+
+const protocol_ie_index::ie_t* protocol_ie_index::find_ie(uint32_t id) const
+{
+  for (uint32_t i = 0; i < nof_ies_; ++i) {
+    if (ies[i].id == id) {
+      return &ies[i];
+    }
+  }
+  return nullptr;
+}
+
+SRSASN_CODE protocol_ie_index::get_octstring_ie(uint32_t id, const uint8_t*& data, uint32_t& len) const
+{
+  const ie_t* ie = find_ie(id);
+  if (ie == nullptr) {
+    return SRSASN_ERROR_DECODE_FAIL;
+  }
+  cbit_ref bref(ie->value, ie->len);
+  HANDLE_CODE(unpack_length(len, bref, true));
+  if (bref.distance_bytes() + len > ie->len) {
+    return SRSASN_ERROR_DECODE_FAIL;
+  }
+  data = ie->value + bref.distance_bytes();
+  return SRSASN_SUCCESS;
+}
+
 /*******************
     JsonWriter
 *******************/
@@ -5292,6 +5292,144 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_attach_request_msg(LIBLTE_BYTE_MSG_STRUCT*
   return (err);
 }
 
+/*********************************************************************
+    Message Name: Attach Request (view)
+
+    Description: Compact form of the Attach Request with the IEs used
+                 by the network. The message is parsed in place with
+                 bounds checking, only the present IEs are touched and
+                 the ESM message container is not copied.
+
+    Document Reference: 24.301 v10.2.0 Section 8.2.4
+*********************************************************************/
+// Skips an optional IE of the type given by its IEI, returns NULL if it does not fit in the message
+static const uint8* liblte_mme_skip_optional_ie(const uint8* ie_ptr, const uint8* end, uint32 tv_len)
+{
+  uint32 len;
+
+  if (*ie_ptr & 0x80) {
+    // Type 1 and type 2 IEs
+    len = 1;
+  } else if (tv_len != 0) {
+    len = tv_len;
+  } else if ((*ie_ptr & 0xF0) == 0x70) {
+    // Type 6 IEs
+    if (end - ie_ptr < 3) {
+      return NULL;
+    }
+    len = 3 + ((ie_ptr[1] << 8) | ie_ptr[2]);
+  } else {
+    // Type 4 IEs
+    if (end - ie_ptr < 2) {
+      return NULL;
+    }
+    len = 2 + ie_ptr[1];
+  }
+  if ((uint32)(end - ie_ptr) < len) {
+    return NULL;
+  }
+  return ie_ptr + len;
+}
+LIBLTE_ERROR_ENUM liblte_mme_parse_attach_request_msg(const uint8*                           msg,
+                                                      uint32                                 msg_len,
+                                                      LIBLTE_MME_ATTACH_REQUEST_VIEW_STRUCT* attach_req)
+{
+  const uint8* msg_ptr = msg;
+  const uint8* end     = msg + msg_len;
+  uint8*       ie_ptr;
+  uint32       hdr_len;
+  uint32       len;
+  uint32       tv_len;
+
+  if (msg == NULL || attach_req == NULL || msg_len == 0) {
+    return LIBLTE_ERROR_INVALID_INPUTS;
+  }
+
+  // Security Header Type
+  hdr_len = (LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS == ((msg[0] & 0xF0) >> 4)) ? 1 : 7;
+  if (msg_len < hdr_len + 2 || LIBLTE_MME_MSG_TYPE_ATTACH_REQUEST != msg[hdr_len]) {
+    return LIBLTE_ERROR_DECODE_FAIL;
+  }
+  msg_ptr += hdr_len + 1;
+
+  // EPS Attach Type & NAS Key Set Identifier
+  ie_ptr = (uint8*)msg_ptr;
+  liblte_mme_unpack_eps_attach_type_ie(&ie_ptr, 0, &attach_req->eps_attach_type);
+  liblte_mme_unpack_nas_key_set_id_ie(&ie_ptr, 4, &attach_req->nas_ksi);
+  msg_ptr++;
+
+  // EPS Mobile ID
+  if (end - msg_ptr < 2) {
+    return LIBLTE_ERROR_DECODE_FAIL;
+  }
+  len = msg_ptr[0];
+  if ((uint32)(end - msg_ptr) < len + 1 ||
+      len < ((LIBLTE_MME_EPS_MOBILE_ID_TYPE_GUTI == (msg_ptr[1] & 0x07)) ? 11u : 8u)) {
+    return LIBLTE_ERROR_DECODE_FAIL;
+  }
+  ie_ptr = (uint8*)msg_ptr;
+  liblte_mme_unpack_eps_mobile_id_ie(&ie_ptr, &attach_req->eps_mobile_id);
+  msg_ptr += len + 1;
+
+  // UE Network Capability
+  if (end - msg_ptr < 1) {
+    return LIBLTE_ERROR_DECODE_FAIL;
+  }
+  len = msg_ptr[0];
+  if ((uint32)(end - msg_ptr) < len + 1 || len < 2) {
+    return LIBLTE_ERROR_DECODE_FAIL;
+  }
+  ie_ptr = (uint8*)msg_ptr;
+  liblte_mme_unpack_ue_network_capability_ie(&ie_ptr, &attach_req->ue_network_cap);
+  msg_ptr += len + 1;
+
+  // ESM Message Container
+  if (end - msg_ptr < 2) {
+    return LIBLTE_ERROR_DECODE_FAIL;
+  }
+  len = (msg_ptr[0] << 8) | msg_ptr[1];
+  if ((uint32)(end - msg_ptr) < len + 2) {
+    return LIBLTE_ERROR_DECODE_FAIL;
+  }
+  attach_req->esm_msg     = msg_ptr + 2;
+  attach_req->esm_msg_len = len;
+  msg_ptr += len + 2;
+
+  // Optional IEs, only the MS Network Capability is decoded
+  attach_req->ms_network_cap_present = false;
+  while (msg_ptr < end) {
+    if (LIBLTE_MME_MS_NETWORK_CAPABILITY_IEI == *msg_ptr) {
+      if (end - msg_ptr < 2 || (uint32)(end - msg_ptr) < msg_ptr[1] + 2u || msg_ptr[1] < 3) {
+        return LIBLTE_ERROR_DECODE_FAIL;
+      }
+      ie_ptr = (uint8*)msg_ptr + 1;
+      liblte_mme_unpack_ms_network_capability_ie(&ie_ptr, &attach_req->ms_network_cap);
+      attach_req->ms_network_cap_present = true;
+    }
+    switch (*msg_ptr) {
+      case LIBLTE_MME_P_TMSI_SIGNATURE_IEI:
+        tv_len = 4;
+        break;
+      case LIBLTE_MME_LAST_VISITED_REGISTERED_TAI_IEI:
+      case LIBLTE_MME_LOCATION_AREA_IDENTIFICATION_IEI:
+        tv_len = 6;
+        break;
+      case LIBLTE_MME_DRX_PARAMETER_IEI:
+        tv_len = 3;
+        break;
+      default:
+        tv_len = 0;
+        break;
+    }
+    msg_ptr = liblte_mme_skip_optional_ie(msg_ptr, end, tv_len);
+    if (msg_ptr == NULL) {
+      return LIBLTE_ERROR_DECODE_FAIL;
+    }
+  }
+
+  return LIBLTE_SUCCESS;
+}
+
 /*********************************************************************
     Message Name: Authentication Failure
 
@@ -10177,6 +10315,72 @@ liblte_mme_unpack_pdn_connectivity_request_msg(LIBLTE_BYTE_MSG_STRUCT*
   return (err);
 }
 
+/*********************************************************************
+    Message Name: PDN Connectivity Request (view)
+
+    Description: Compact form of the PDN Connectivity Request. The
+                 APN and the Protocol Configuration Options are not
+                 decoded, they point into the parsed message.
+
+    Document Reference: 24.301 v10.2.0 Section 8.3.20
+*********************************************************************/
+LIBLTE_ERROR_ENUM
+liblte_mme_parse_pdn_connectivity_request_msg(const uint8*                                     msg,
+                                              uint32                                           msg_len,
+                                              LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_VIEW_STRUCT* pdn_con_req)
+{
+  const uint8* msg_ptr = msg;
+  const uint8* end     = msg + msg_len;
+  const uint8* next;
+  uint8*       ie_ptr;
+
+  if (msg == NULL || pdn_con_req == NULL) {
+    return LIBLTE_ERROR_INVALID_INPUTS;
+  }
+  if (msg_len < 4 || LIBLTE_MME_MSG_TYPE_PDN_CONNECTIVITY_REQUEST != msg[2]) {
+    return LIBLTE_ERROR_DECODE_FAIL;
+  }
+
+  // EPS Bearer ID
+  pdn_con_req->eps_bearer_id = (msg[0] >> 4);
+
+  // Procedure Transaction ID
+  pdn_con_req->proc_transaction_id = msg[1];
+
+  // Request Type & PDN Type
+  ie_ptr = (uint8*)msg + 3;
+  liblte_mme_unpack_request_type_ie(&ie_ptr, 0, &pdn_con_req->request_type);
+  liblte_mme_unpack_pdn_type_ie(&ie_ptr, 4, &pdn_con_req->pdn_type);
+  msg_ptr += 4;
+
+  // Optional IEs
+  pdn_con_req->esm_info_transfer_flag_present = false;
+  pdn_con_req->apn_present                    = false;
+  pdn_con_req->protocol_cnfg_opts_present     = false;
+  while (msg_ptr < end) {
+    next = liblte_mme_skip_optional_ie(msg_ptr, end, 0);
+    if (next == NULL) {
+      return LIBLTE_ERROR_DECODE_FAIL;
+    }
+    if ((LIBLTE_MME_ESM_INFO_TRANSFER_FLAG_IEI << 4) == (*msg_ptr & 0xF0)) {
+      ie_ptr = (uint8*)msg_ptr;
+      liblte_mme_unpack_esm_info_transfer_flag_ie(&ie_ptr, 0, &pdn_con_req->esm_info_transfer_flag);
+      pdn_con_req->esm_info_transfer_flag_present = true;
+    } else if (LIBLTE_MME_ACCESS_POINT_NAME_IEI == *msg_ptr) {
+      pdn_con_req->apn         = msg_ptr + 2;
+      pdn_con_req->apn_len     = msg_ptr[1];
+      pdn_con_req->apn_present = true;
+    } else if (LIBLTE_MME_PROTOCOL_CONFIGURATION_OPTIONS_IEI == *msg_ptr) {
+      pdn_con_req->protocol_cnfg_opts         = msg_ptr + 2;
+      pdn_con_req->protocol_cnfg_opts_len     = msg_ptr[1];
+      pdn_con_req->protocol_cnfg_opts_present = true;
+    }
+    msg_ptr = next;
+  }
+
+  return LIBLTE_SUCCESS;
+}
+
 /*********************************************************************
     Message Name: PDN Disconnect Reject
 
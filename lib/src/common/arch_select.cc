@@ -58,7 +58,7 @@ static __inline int __get_cpuid_count_redef(unsigned int  __leaf,
 const char* x86_get_isa()
 {
   int          ret       = 0;
-  int          has_sse42 = 0, has_avx = 0, has_avx2 = 0;
+  int          has_sse42 = 0, has_avx = 0, has_avx2 = 0, has_avx512 = 0;
   unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
 
   // query basic features
@@ -75,10 +75,15 @@ const char* x86_get_isa()
   ret = __get_cpuid_count_redef(X86_CPUID_ADVANCED_LEAF, 0, &eax, &ebx, &ecx, &edx);
   if (ret) {
     has_avx2 = ebx & bit_AVX2;
+#if defined(bit_AVX512F) && defined(bit_AVX512BW)
+    has_avx512 = (ebx & bit_AVX512F) && (ebx & bit_AVX512BW);
+#endif
   }
 #endif
 
-  if (has_avx2) {
+  if (has_avx512) {
+    return "avx512";
+  } else if (has_avx2) {
     return "avx2";
   } else if (has_avx) {
     return "avx";
@@ -436,6 +436,7 @@ private:
 } // namespace
 
 std::unique_ptr<event_logger_interface> event_logger::pimpl = std::unique_ptr<null_event_logger>(new null_event_logger);
+bool                                    event_logger::enabled = false;
 
 event_logger_interface& event_logger::get()
 {
@@ -444,5 +445,6 @@ event_logger_interface& event_logger::get()
 
 void event_logger::configure(srslog::log_channel& c, asn1_output_format asn1_format)
 {
-  pimpl = std::unique_ptr<logging_event_logger>(new logging_event_logger(c, asn1_format));
+  pimpl   = std::unique_ptr<logging_event_logger>(new logging_event_logger(c, asn1_format));
+  enabled = true;
 }
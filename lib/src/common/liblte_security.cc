@@ -23,6 +23,10 @@
 
 #include <arpa/inet.h>
 
+#ifdef __PCLMUL__
+#include <wmmintrin.h>
+#endif
+
 /*******************************************************************************
                               LOCAL FUNCTION PROTOTYPES
 *******************************************************************************/
@@ -505,15 +509,7 @@ LIBLTE_ERROR_ENUM liblte_security_128_eia1(const uint8* key,
   LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
 
   if (key != NULL && msg != NULL && mac != NULL) {
-    uint32_t msg_len_bits = 0;
-    uint32_t i            = 0;
-    uint8_t* m_ptr;
-
-    msg_len_bits = msg_len * 8;
-    m_ptr        = s3g_f9(key, count, bearer << 27, direction, msg, msg_len_bits);
-    for (i = 0; i < 4; i++) {
-      mac[i] = m_ptr[i];
-    }
+    s3g_f9(key, count, bearer << 27, direction, msg, (uint64_t)msg_len * 8, mac);
     err = LIBLTE_SUCCESS;
   }
   return (err);
@@ -784,11 +780,36 @@ LIBLTE_ERROR_ENUM liblte_security_128_eia3(const uint8* key,
 
     zuc_generate_keystream(&zuc_state, L, ks);
 
+    // The words of the keystream starting at each of the 32 bits of a message word are taken from a 64-bit window,
+    // instead of being built bit by bit
     uint32_t T = 0;
-    for (uint32_t i = 0; i < msg_len; i++) {
-      if (GET_BIT(msg, i)) {
-        T ^= GET_WORD(ks, i);
+    for (uint32_t w = 0; 32 * w < msg_len; w++) {
+      uint64_t window = ((uint64_t)ks[w] << 32U) | ks[w + 1];
+      uint32_t nbits  = (msg_len - 32 * w) < 32 ? (msg_len - 32 * w) : 32;
+#ifdef __PCLMUL__
+      // Bit j of the message word selects the window shifted left by j bits, so the XOR of all of them is the
+      // carry-less product of the window with the bit-reversed message word
+      uint32_t m = 0;
+      for (uint32_t b = 0; b < (nbits + 7) / 8; b++) {
+        m |= (uint32_t)msg[4 * w + b] << (24 - 8 * b);
+      }
+      m = ((m >> 1) & 0x55555555U) | ((m & 0x55555555U) << 1);
+      m = ((m >> 2) & 0x33333333U) | ((m & 0x33333333U) << 2);
+      m = ((m >> 4) & 0x0F0F0F0FU) | ((m & 0x0F0F0F0FU) << 4);
+      m = __builtin_bswap32(m);
+      if (nbits < 32) {
+        m &= (1U << nbits) - 1;
+      }
+      __m128i prod = _mm_clmulepi64_si128(_mm_cvtsi64_si128(window), _mm_cvtsi32_si128(m), 0x00);
+      T ^= (uint32_t)((uint64_t)_mm_cvtsi128_si64(prod) >> 32U);
+#else
+      for (uint32_t j = 0; j < nbits; j++) {
+        uint32_t i = 32 * w + j;
+        if (msg[i / 8] & (0x80U >> (i % 8))) {
+          T ^= (uint32_t)(window >> (32 - j));
+        }
       }
+#endif
     }
 
     T ^= GET_WORD(ks, msg_len);
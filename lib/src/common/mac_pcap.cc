@@ -22,9 +22,14 @@
 #include "srsran/common/mac_pcap.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/threads.h"
+#include <unistd.h>
 
 namespace srsran {
-mac_pcap::mac_pcap() : mac_pcap_base() {}
+mac_pcap::mac_pcap() : mac_pcap_base()
+{
+  iovs.reserve(2 * max_batch_pdus);
+  headers.resize(max_batch_pdus * max_header_bytes);
+}
 
 mac_pcap::~mac_pcap()
 {
@@ -46,6 +51,8 @@ uint32_t mac_pcap::open(std::string filename_, uint32_t ue_id_)
     logger.error("Couldn't open %s to write PCAP", filename_.c_str());
     return SRSRAN_ERROR;
   }
+  // The records are written directly to the file descriptor
+  fflush(pcap_file);
 
   filename = filename_;
   ue_id    = ue_id_;
@@ -66,9 +73,7 @@ uint32_t mac_pcap::close()
     }
 
     // tell writer thread to stop
-    running        = false;
-    pcap_pdu_t pdu = {};
-    queue.push_blocking(std::move(pdu));
+    running = false;
   }
 
   wait_thread_finish();
@@ -84,20 +89,67 @@ uint32_t mac_pcap::close()
   return SRSRAN_SUCCESS;
 }
 
-void mac_pcap::write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu)
+void mac_pcap::write_pdu(const srsran::mac_pcap_base::pcap_pdu_t& pdu, const uint8_t* payload)
 {
-  if (pdu.pdu != nullptr) {
-    switch (pdu.rat) {
-      case srsran_rat_t::lte:
-        LTE_PCAP_MAC_UDP_WritePDU(pcap_file, &pdu.context, pdu.pdu->msg, pdu.pdu->N_bytes);
-        break;
-      case srsran_rat_t::nr:
-        NR_PCAP_MAC_UDP_WritePDU(pcap_file, &pdu.context_nr, pdu.pdu->msg, pdu.pdu->N_bytes);
-        break;
-      default:
-        logger.error("Error writing PDU to PCAP. Unsupported RAT selected.");
+  if (iovs.size() == 2 * max_batch_pdus) {
+    flush_pdus();
+  }
+
+  uint8_t* header = &headers[(iovs.size() / 2) * max_header_bytes];
+  int      offset = 0;
+  switch (pdu.rat) {
+    case srsran_rat_t::lte: {
+      MAC_Context_Info_t context = pdu.context;
+      offset = LTE_PCAP_PACK_MAC_UDP_HEADER_TO_BUFFER(&context, pdu.orig_len, header + sizeof(pcaprec_hdr_t));
+      break;
+    }
+    case srsran_rat_t::nr: {
+      mac_nr_context_info_t context = pdu.context_nr;
+      offset = NR_PCAP_PACK_MAC_UDP_HEADER_TO_BUFFER(&context, pdu.orig_len, header + sizeof(pcaprec_hdr_t));
+      break;
+    }
+    default:
+      logger.error("Error writing PDU to PCAP. Unsupported RAT selected.");
+      return;
+  }
+
+  pcaprec_hdr_t packet_header;
+  packet_header.ts_sec   = pdu.timestamp.tv_sec;
+  packet_header.ts_usec  = pdu.timestamp.tv_usec;
+  packet_header.incl_len = offset + pdu.len;
+  packet_header.orig_len = offset + pdu.orig_len;
+  memcpy(header, &packet_header, sizeof(pcaprec_hdr_t));
+
+  iovs.push_back({header, sizeof(pcaprec_hdr_t) + offset});
+  iovs.push_back({const_cast<uint8_t*>(payload), pdu.len});
+}
+
+void mac_pcap::flush_pdus()
+{
+  struct iovec* iov      = iovs.data();
+  int           nof_iovs = iovs.size();
+  while (nof_iovs > 0) {
+    ssize_t n = writev(fileno(pcap_file), iov, nof_iovs);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      logger.error("Error writing PCAP file %s: %s", filename.c_str(), strerror(errno));
+      break;
+    }
+
+    // Continue a partial write from where it stopped
+    while (nof_iovs > 0 && (size_t)n >= iov->iov_len) {
+      n -= iov->iov_len;
+      iov++;
+      nof_iovs--;
+    }
+    if (nof_iovs > 0) {
+      iov->iov_base = (uint8_t*)iov->iov_base + n;
+      iov->iov_len -= n;
     }
   }
+  iovs.clear();
 }
 
 } // namespace srsran
\ No newline at end of file
@@ -23,10 +23,25 @@
 #include "srsran/config.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/support/emergency_handlers.h"
+#include <chrono>
 #include <stdint.h>
 
 namespace srsran {
 
+/// Index of the calling thread among the threads that have written PDUs, used to pick its capture ring.
+static uint32_t producer_index()
+{
+  static std::atomic<uint32_t> nof_producers = {0};
+  static thread_local uint32_t index         = nof_producers.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+/// Size of a captured PDU in the capture rings. Records are padded to keep the next header aligned.
+static uint32_t record_size(uint32_t len, uint32_t header_len)
+{
+  return (header_len + len + 7U) & ~7U;
+}
+
 /// Try to flush the contents of the pcap class before the application is killed.
 static void emergency_cleanup_handler(void* data)
 {
@@ -36,6 +51,13 @@ static void emergency_cleanup_handler(void* data)
 mac_pcap_base::mac_pcap_base() : logger(srslog::fetch_basic_logger("MAC")), thread("PCAP_WRITER_MAC")
 {
   emergency_handler_id = add_emergency_cleanup_handler(emergency_cleanup_handler, this);
+
+  // The memory of the rings is only backed as the captures reach it
+  for (capture_ring_t& ring : rings) {
+    if (srsran_ringbuffer_mirror_init(&ring.buffer, ring_capacity) < SRSRAN_SUCCESS) {
+      logger.error("Error creating PCAP capture ring, PDUs of some threads will not be captured");
+    }
+  }
 }
 
 mac_pcap_base::~mac_pcap_base()
@@ -43,6 +65,9 @@ mac_pcap_base::~mac_pcap_base()
   if (emergency_handler_id > 0) {
     remove_emergency_cleanup_handler(emergency_handler_id);
   }
+  for (capture_ring_t& ring : rings) {
+    srsran_ringbuffer_mirror_free(&ring.buffer);
+  }
 }
 
 void mac_pcap_base::enable(bool enable_)
@@ -57,26 +82,85 @@ void mac_pcap_base::set_ue_id(uint16_t ue_id_)
   ue_id = ue_id_;
 }
 
+void mac_pcap_base::set_snaplen(uint32_t snaplen_)
+{
+  snaplen.store(snaplen_, std::memory_order_relaxed);
+}
+
 void mac_pcap_base::run_thread()
 {
-  // blocking write until stopped
+  // poll the capture rings until stopped
   while (running) {
-    pcap_pdu_t pdu = queue.pop_blocking();
-    {
-      std::lock_guard<std::mutex> lock(mutex);
-      write_pdu(pdu);
+    if (write_captured_pdus() == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  // write remainder of the rings
+  write_captured_pdus();
+}
+
+// Copies the PDU into the capture ring of the calling thread, without waiting for the writer thread
+bool mac_pcap_base::capture(pcap_pdu_t& pdu, const uint8_t* payload, uint32_t payload_len)
+{
+  uint32_t max_len = snaplen.load(std::memory_order_relaxed);
+  pdu.orig_len     = payload_len;
+  pdu.len          = (max_len > 0) ? std::min(payload_len, max_len) : payload_len;
+  gettimeofday(&pdu.timestamp, nullptr);
+  uint32_t len = record_size(pdu.len, sizeof(pcap_pdu_t));
+
+  capture_ring_t& ring = rings[producer_index() % nof_rings];
+  if (ring.buffer.buffer == nullptr) {
+    return false;
+  }
+  while (ring.busy.test_and_set(std::memory_order_acquire)) {
+    // Only contended when more threads than rings write PDUs
+  }
+
+  uint32_t space = 0;
+  uint8_t* ptr   = srsran_ringbuffer_mirror_write_view(&ring.buffer, &space);
+  bool     ok    = space >= len;
+  if (ok) {
+    memcpy(ptr, &pdu, sizeof(pcap_pdu_t));
+    memcpy(ptr + sizeof(pcap_pdu_t), payload, pdu.len);
+    srsran_ringbuffer_mirror_write_commit(&ring.buffer, len);
+  }
+
+  ring.busy.clear(std::memory_order_release);
+  return ok;
+}
+
+// Writes all the captured PDUs in one batch, the ring memory is released once the batch is flushed
+uint32_t mac_pcap_base::write_captured_pdus()
+{
+  std::array<uint32_t, nof_rings> nof_bytes = {};
+  uint32_t                        nof_pdus  = 0;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  for (uint32_t i = 0; i < nof_rings; i++) {
+    if (rings[i].buffer.buffer == nullptr) {
+      continue;
+    }
+    const uint8_t* ptr = srsran_ringbuffer_mirror_read_view(&rings[i].buffer, &nof_bytes[i]);
+    for (uint32_t offset = 0; offset < nof_bytes[i]; nof_pdus++) {
+      const pcap_pdu_t* pdu = reinterpret_cast<const pcap_pdu_t*>(ptr + offset);
+      write_pdu(*pdu, ptr + offset + sizeof(pcap_pdu_t));
+      offset += record_size(pdu->len, sizeof(pcap_pdu_t));
     }
   }
 
-  // write remainder of queue
-  pcap_pdu_t pdu = {};
-  while (queue.try_pop(pdu)) {
-    std::lock_guard<std::mutex> lock(mutex);
-    write_pdu(pdu);
+  if (nof_pdus > 0) {
+    flush_pdus();
+  }
+  for (uint32_t i = 0; i < nof_rings; i++) {
+    if (nof_bytes[i] > 0) {
+      srsran_ringbuffer_mirror_read_release(&rings[i].buffer, nof_bytes[i]);
+    }
   }
+  return nof_pdus;
 }
 
-// Function called from PHY worker context, locking not needed as PDU queue is thread-safe
+// Function called from PHY worker context, locking not needed as the capture rings are thread-safe
 void mac_pcap_base::pack_and_queue(uint8_t* payload,
                                    uint32_t payload_len,
                                    uint16_t ue_id,
@@ -102,22 +186,13 @@ void mac_pcap_base::pack_and_queue(uint8_t* payload,
     pdu.context.sysFrameNumber = (uint16_t)(tti / 10);
     pdu.context.subFrameNumber = (uint16_t)(tti % 10);
 
-    // try to allocate PDU buffer
-    pdu.pdu = srsran::make_byte_buffer();
-    if (pdu.pdu != nullptr && pdu.pdu->get_tailroom() >= payload_len) {
-      // copy payload into PDU buffer
-      memcpy(pdu.pdu->msg, payload, payload_len);
-      pdu.pdu->N_bytes = payload_len;
-      if (not queue.try_push(std::move(pdu))) {
-        logger.warning("Dropping PDU (%d B) in PCAP. Write queue full.", payload_len);
-      }
-    } else {
-      logger.warning("Dropping PDU in PCAP. No buffer available or not enough space (pdu_len=%d).", payload_len);
+    if (not capture(pdu, payload, payload_len)) {
+      logger.warning("Dropping PDU (%d B) in PCAP. Capture ring full.", payload_len);
     }
   }
 }
 
-// Function called from PHY worker context, locking not needed as PDU queue is thread-safe
+// Function called from PHY worker context, locking not needed as the capture rings are thread-safe
 void mac_pcap_base::pack_and_queue_nr(uint8_t* payload,
                                       uint32_t payload_len,
                                       uint32_t tti,
@@ -139,17 +214,8 @@ void mac_pcap_base::pack_and_queue_nr(uint8_t* payload,
     pdu.context_nr.system_frame_number = tti / 10;
     pdu.context_nr.sub_frame_number    = tti % 10;
 
-    // try to allocate PDU buffer
-    pdu.pdu = srsran::make_byte_buffer();
-    if (pdu.pdu != nullptr && pdu.pdu->get_tailroom() >= payload_len) {
-      // copy payload into PDU buffer
-      memcpy(pdu.pdu->msg, payload, payload_len);
-      pdu.pdu->N_bytes = payload_len;
-      if (not queue.try_push(std::move(pdu))) {
-        logger.warning("Dropping PDU (%d B) in NR PCAP. Write queue full.", payload_len);
-      }
-    } else {
-      logger.warning("Dropping PDU in NR PCAP. No buffer available or not enough space (pdu_len=%d).", payload_len);
+    if (not capture(pdu, payload, payload_len)) {
+      logger.warning("Dropping PDU (%d B) in NR PCAP. Capture ring full.", payload_len);
     }
   }
 }
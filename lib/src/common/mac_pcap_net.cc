@@ -80,9 +80,7 @@ uint32_t mac_pcap_net::close()
     }
 
     // tell writer thread to stop
-    running        = false;
-    pcap_pdu_t pdu = {};
-    queue.push_blocking(std::move(pdu));
+    running = false;
   }
 
   wait_thread_finish();
@@ -95,15 +93,15 @@ uint32_t mac_pcap_net::close()
   return SRSRAN_SUCCESS;
 }
 
-void mac_pcap_net::write_pdu(pcap_pdu_t& pdu)
+void mac_pcap_net::write_pdu(const pcap_pdu_t& pdu, const uint8_t* payload)
 {
-  if (pdu.pdu != nullptr && socket.is_open()) {
+  if (socket.is_open()) {
     switch (pdu.rat) {
       case srsran_rat_t::lte:
-        write_mac_lte_pdu_to_net(pdu);
+        write_mac_lte_pdu_to_net(pdu, payload);
         break;
       case srsran_rat_t::nr:
-        write_mac_nr_pdu_to_net(pdu);
+        write_mac_nr_pdu_to_net(pdu, payload);
         break;
       default:
         logger.error("Error writing PDU to PCAP socket. Unsupported RAT selected.");
@@ -111,71 +109,50 @@ void mac_pcap_net::write_pdu(pcap_pdu_t& pdu)
   }
 }
 
-void mac_pcap_net::write_mac_lte_pdu_to_net(pcap_pdu_t& pdu)
+void mac_pcap_net::write_mac_lte_pdu_to_net(const pcap_pdu_t& pdu, const uint8_t* payload)
 {
-  int      bytes_sent;
-  uint32_t offset = 0;
-  uint8_t  buffer[PCAP_CONTEXT_HEADER_MAX];
+  uint32_t           offset  = 0;
+  uint8_t            buffer[PCAP_CONTEXT_HEADER_MAX];
+  MAC_Context_Info_t context = pdu.context;
 
   // MAC_LTE_START_STRING for UDP heuristics
   memcpy(buffer + offset, MAC_LTE_START_STRING, strlen(MAC_LTE_START_STRING));
   offset += strlen(MAC_LTE_START_STRING);
 
-  offset += LTE_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(&pdu.context, buffer + offset, PCAP_CONTEXT_HEADER_MAX);
-
-  if (pdu.pdu.get()->get_headroom() < offset) {
-    logger.error("PDU headroom is to small for adding context buffer");
-    return;
-  }
-
-  pdu.pdu.get()->msg -= offset;
-  memcpy(pdu.pdu.get()->msg, buffer, offset);
-  pdu.pdu.get()->N_bytes += offset;
-
-  bytes_sent = sendto(socket.get_socket(),
-                      pdu.pdu.get()->msg,
-                      pdu.pdu.get()->N_bytes,
-                      0,
-                      (const struct sockaddr*)&client_addr,
-                      sizeof(client_addr));
+  offset += LTE_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(&context, buffer + offset, PCAP_CONTEXT_HEADER_MAX);
 
-  if ((int)pdu.pdu.get()->N_bytes != bytes_sent || bytes_sent < 0) {
-    logger.error(
-        "Sending UDP packet mismatches %d != %d (err %s)", pdu.pdu.get()->N_bytes, bytes_sent, strerror(errno));
-  }
+  send_to_net(buffer, offset, payload, pdu.len);
 }
 
-void mac_pcap_net::write_mac_nr_pdu_to_net(pcap_pdu_t& pdu)
+void mac_pcap_net::write_mac_nr_pdu_to_net(const pcap_pdu_t& pdu, const uint8_t* payload)
 {
-  int      bytes_sent;
-  uint32_t offset = 0;
-  uint8_t  buffer[PCAP_CONTEXT_HEADER_MAX];
+  uint32_t              offset  = 0;
+  uint8_t               buffer[PCAP_CONTEXT_HEADER_MAX];
+  mac_nr_context_info_t context = pdu.context_nr;
 
   // MAC_LTE_START_STRING for UDP heuristics
   memcpy(buffer + offset, MAC_LTE_START_STRING, strlen(MAC_LTE_START_STRING));
   offset += strlen(MAC_LTE_START_STRING);
 
-  offset += NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(&pdu.context_nr, buffer + offset, PCAP_CONTEXT_HEADER_MAX);
+  offset += NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(&context, buffer + offset, PCAP_CONTEXT_HEADER_MAX);
 
-  if (pdu.pdu.get()->get_headroom() < offset) {
-    logger.error("PDU headroom is to small for adding context buffer");
-    return;
-  }
-
-  pdu.pdu.get()->msg -= offset;
-  memcpy(pdu.pdu.get()->msg, buffer, offset);
-  pdu.pdu.get()->N_bytes += offset;
-
-  bytes_sent = sendto(socket.get_socket(),
-                      pdu.pdu.get()->msg,
-                      pdu.pdu.get()->N_bytes,
-                      0,
-                      (const struct sockaddr*)&client_addr,
-                      sizeof(client_addr));
+  send_to_net(buffer, offset, payload, pdu.len);
+}
 
-  if ((int)pdu.pdu.get()->N_bytes != bytes_sent || bytes_sent < 0) {
-    logger.error(
-        "Sending UDP packet mismatches %d != %d (err %s)", pdu.pdu.get()->N_bytes, bytes_sent, strerror(errno));
+void mac_pcap_net::send_to_net(const uint8_t* context, uint32_t context_len, const uint8_t* payload, uint32_t len)
+{
+  // The context and the payload are gathered into one datagram
+  struct iovec iov[2] = {{const_cast<uint8_t*>(context), context_len}, {const_cast<uint8_t*>(payload), len}};
+
+  struct msghdr msg = {};
+  msg.msg_name      = &client_addr;
+  msg.msg_namelen   = sizeof(client_addr);
+  msg.msg_iov       = iov;
+  msg.msg_iovlen    = 2;
+
+  int bytes_sent = sendmsg(socket.get_socket(), &msg, 0);
+  if ((int)(context_len + len) != bytes_sent || bytes_sent < 0) {
+    logger.error("Sending UDP packet mismatches %d != %d (err %s)", context_len + len, bytes_sent, strerror(errno));
   }
 }
 } // namespace srsran
\ No newline at end of file
@@ -20,6 +20,7 @@
  */
 
 #include "srsran/common/network_utils.h"
+#include "srsran/common/epoll_helper.h"
 
 #include <netinet/sctp.h>
 #include <sys/socket.h>
@@ -230,8 +231,10 @@ bool sctp_subscribe_to_events(int fd)
   // Sets the data_io_event to be able to use sendrecv_info
   // Subscribes to the SCTP_SHUTDOWN event, to handle graceful shutdown
   // Also subscribes to SCTP_PEER_ADDR_CHANGE, to handle ungraceful shutdown of the link.
+  // And to SCTP_ASSOC_CHANGE, which reports the number of streams of the association.
   struct sctp_event_subscribe evnts = {};
   evnts.sctp_data_io_event          = 1;
+  evnts.sctp_association_event      = 1;
   evnts.sctp_shutdown_event         = 1;
   evnts.sctp_address_event          = 1;
   if (setsockopt(fd, IPPROTO_SCTP, SCTP_EVENTS, &evnts, sizeof(evnts)) != 0) {
@@ -305,6 +308,41 @@ bool sctp_set_init_msg_opts(int fd, int init_max_attempts, int max_init_timeo)
   }
   return true;
 }
+
+/*
+ * Requests the number of outbound streams of the association, and accepts as many inbound ones.
+ * The peer may grant fewer, the SCTP_ASSOC_CHANGE notification carries the negotiated numbers.
+ */
+bool sctp_set_nof_streams(int fd, int nof_streams)
+{
+  sctp_initmsg init_opts;
+  socklen_t    init_sz = sizeof(sctp_initmsg);
+  if (getsockopt(fd, SOL_SCTP, SCTP_INITMSG, &init_opts, &init_sz) < 0) {
+    printf("Error getting sockopts\n");
+    close(fd);
+    return false;
+  }
+
+  init_opts.sinit_num_ostreams  = nof_streams;
+  init_opts.sinit_max_instreams = nof_streams;
+
+  srslog::fetch_basic_logger(LOGSERVICE).debug("Setting SCTP_INITMSG options on SCTP socket. Streams %d", nof_streams);
+  if (setsockopt(fd, SOL_SCTP, SCTP_INITMSG, &init_opts, init_sz) < 0) {
+    perror("Error setting SCTP_INITMSG sockopts\n");
+    close(fd);
+    return false;
+  }
+  return true;
+}
+
+uint16_t sctp_ue_stream_id(uint32_t ue_id, int nof_ostreams)
+{
+  // Stream 0 is reserved to the non UE-associated signalling
+  if (nof_ostreams <= 1) {
+    return 0;
+  }
+  return 1 + ue_id % (nof_ostreams - 1);
+}
 } // namespace net_utils
 
 /********************************************
@@ -391,6 +429,11 @@ bool unique_socket::sctp_set_init_msg_opts(int max_init_attempts, int max_init_t
   return net_utils::sctp_set_init_msg_opts(sockfd, max_init_attempts, max_init_timeo);
 }
 
+bool unique_socket::sctp_set_nof_streams(int nof_streams)
+{
+  return net_utils::sctp_set_nof_streams(sockfd, nof_streams);
+}
+
 /***************************************************************
  *                 Rx Multisocket Handler
  **************************************************************/
@@ -400,6 +443,9 @@ socket_manager::socket_manager() : thread("RXsockets"), socket_manager_itf(srslo
   // register control pipe fd
   int fd = pipe(pipefd);
   srsran_assert(fd != -1, "Failed to open control pipe");
+  epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  srsran_assert(epoll_fd != -1, "Failed to create epoll instance");
+  srsran_assert(add_epoll(pipefd[0], epoll_fd) == SRSRAN_SUCCESS, "Failed to register control pipe");
   start(thread_prio);
 }
 
@@ -431,6 +477,10 @@ void socket_manager::stop()
     pipefd[1] = -1;
     rxSockDebug("closed.");
   }
+  if (epoll_fd >= 0) {
+    close(epoll_fd);
+    epoll_fd = -1;
+  }
 }
 
 bool socket_manager::add_socket_handler(int fd, recv_callback_t handler)
@@ -445,14 +495,12 @@ bool socket_manager::add_socket_handler(int fd, recv_callback_t handler)
     return false;
   }
 
+  // The epoll instance can be updated from any thread. The handler is inserted first, so that it is found on the
+  // first event of the fd
   active_sockets.insert(std::make_pair(fd, std::move(handler)));
-
-  // this unlocks the reading thread to add new connections
-  ctrl_cmd_t msg;
-  msg.cmd    = ctrl_cmd_t::cmd_id_t::NEW_FD;
-  msg.new_fd = fd;
-  if (write(pipefd[1], &msg, sizeof(msg)) != sizeof(msg)) {
-    rxSockError("while writing to control pipe");
+  if (add_epoll(fd, epoll_fd) != SRSRAN_SUCCESS) {
+    rxSockError("Failed to register fd=%d in the epoll instance", fd);
+    active_sockets.erase(fd);
     return false;
   }
 
@@ -495,18 +543,20 @@ bool socket_manager::remove_socket(int fd)
   return result;
 }
 
-std::map<int, socket_manager::recv_callback_t>::iterator
-socket_manager::remove_socket_unprotected(int fd, fd_set* total_fd_set, int* max_fd)
+std::map<int, socket_manager::recv_callback_t>::iterator socket_manager::remove_socket_unprotected(int fd)
 {
   if (fd < 0) {
     rxSockError("fd to be removed is not valid");
     return active_sockets.end();
   }
   auto it = active_sockets.find(fd);
-  it      = active_sockets.erase(it);
-  FD_CLR(fd, total_fd_set);
-  // assumes ordering
-  *max_fd = (active_sockets.empty()) ? pipefd[0] : std::max(pipefd[0], active_sockets.rbegin()->first);
+  if (it == active_sockets.end()) {
+    return it;
+  }
+  it = active_sockets.erase(it);
+  // A fd that was already closed left the epoll instance on its own
+  epoll_event ev = {};
+  epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, &ev);
   rxSockDebug("Socket fd=%d has been successfully removed", fd);
   return it;
 }
@@ -514,49 +564,44 @@ socket_manager::remove_socket_unprotected(int fd, fd_set* total_fd_set, int* max
 void socket_manager::run_thread()
 {
   running = true;
-  fd_set total_fd_set, read_fd_set;
-  FD_ZERO(&total_fd_set);
-  int max_fd = 0;
-
-  FD_SET(pipefd[0], &total_fd_set);
-  max_fd = std::max(pipefd[0], max_fd);
+  std::array<epoll_event, max_events> events;
 
   while (running.load(std::memory_order_relaxed)) {
-    memcpy(&read_fd_set, &total_fd_set, sizeof(total_fd_set));
-    int n = select(max_fd + 1, &read_fd_set, nullptr, nullptr, nullptr);
+    int n = epoll_wait(epoll_fd, events.data(), max_events, -1);
 
-    // handle select return
+    // handle epoll_wait return
     if (n == -1) {
-      rxSockError("Error from select(%d,...). Number of rx sockets: %d", max_fd + 1, (int)active_sockets.size() + 1);
-      continue;
-    }
-    if (n == 0) {
-      rxSockDebug("No data from select.");
+      if (errno != EINTR) {
+        rxSockError("Error from epoll_wait(). Number of rx sockets: %d", (int)active_sockets.size() + 1);
+      }
       continue;
     }
 
     // Shared state area
     std::lock_guard<std::mutex> lock(socket_mutex);
 
-    // call read callback for all SCTP/TCP/UDP connections
-    for (auto handler_it = active_sockets.begin(); handler_it != active_sockets.end();) {
-      int              fd       = handler_it->first;
-      recv_callback_t& callback = handler_it->second;
-      if (not FD_ISSET(fd, &read_fd_set)) {
-        ++handler_it;
+    // call read callback for all the SCTP/TCP/UDP connections with data
+    bool ctrl_pending = false;
+    for (int i = 0; i < n; ++i) {
+      int fd = events[i].data.fd;
+      if (fd == pipefd[0]) {
+        ctrl_pending = true;
+        continue;
+      }
+      auto handler_it = active_sockets.find(fd);
+      if (handler_it == active_sockets.end()) {
+        // removed by the handlers of this wake-up
         continue;
       }
-      bool socket_valid = callback(fd);
+      bool socket_valid = handler_it->second(fd);
       if (not socket_valid) {
         rxSockInfo("The socket fd=%d has been closed by peer", fd);
-        handler_it = remove_socket_unprotected(fd, &total_fd_set, &max_fd);
-      } else {
-        ++handler_it;
+        remove_socket_unprotected(fd);
       }
     }
 
     // handle ctrl messages
-    if (FD_ISSET(pipefd[0], &read_fd_set)) {
+    if (ctrl_pending) {
       ctrl_cmd_t msg;
       ssize_t    nrd = read(pipefd[0], &msg, sizeof(msg));
       if (nrd <= 0) {
@@ -567,16 +612,8 @@ void socket_manager::run_thread()
         case ctrl_cmd_t::cmd_id_t::EXIT:
           running = false;
           return;
-        case ctrl_cmd_t::cmd_id_t::NEW_FD:
-          if (msg.new_fd >= 0) {
-            FD_SET(msg.new_fd, &total_fd_set);
-            max_fd = std::max(max_fd, msg.new_fd);
-          } else {
-            rxSockError("added fd is not valid");
-          }
-          break;
         case ctrl_cmd_t::cmd_id_t::RM_FD:
-          remove_socket_unprotected(msg.new_fd, &total_fd_set, &max_fd);
+          remove_socket_unprotected(msg.new_fd);
           if (msg.signal_rm_complete) {
             rem_fd_tmp_list.push_back(msg.new_fd);
             rem_cvar.notify_one();
@@ -662,29 +699,119 @@ public:
 
   bool operator()(int fd)
   {
-    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
-    if (pdu == nullptr) {
+    // Drain the socket, up to a budget that keeps the other sockets of the wake-up served. Only the first read may
+    // block, as the socket is known to have data
+    for (size_t i = 0; i < max_pdus_per_event; ++i) {
+      srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+      if (pdu == nullptr) {
+        logger.error("Unable to allocate byte buffer");
+        return true;
+      }
+      sockaddr_in from    = {};
+      socklen_t   fromlen = sizeof(from);
+
+      int     flags  = i == 0 ? 0 : MSG_DONTWAIT;
+      ssize_t n_recv = recvfrom(fd, pdu->msg, pdu->get_tailroom(), flags, (struct sockaddr*)&from, &fromlen);
+      if (n_recv == -1 and errno != EAGAIN) {
+        logger.error("Error reading from socket: %s", strerror(errno));
+        return true;
+      }
+      if (n_recv == -1 and errno == EAGAIN) {
+        if (i == 0) {
+          logger.debug("Socket timeout reached");
+        }
+        return true;
+      }
+
+      pdu->N_bytes = static_cast<uint32_t>(n_recv);
+
+      // Defer handling of received packet to provided queue
+      queue.push(
+          std::bind([this, from](srsran::unique_byte_buffer_t& sdu) { func(std::move(sdu), from); }, std::move(pdu)));
+    }
+
+    return true;
+  }
+
+private:
+  static const size_t max_pdus_per_event = 16;
+
+  srslog::basic_logger&      logger;
+  srsran::task_queue_handle& queue;
+  callback_t                 func;
+};
+
+socket_manager_itf::recv_callback_t
+make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue, recvfrom_callback_t rx_callback)
+{
+  return socket_manager_itf::recv_callback_t(recvfrom_pdu_task(logger, queue, std::move(rx_callback)));
+}
+
+/**
+ * Description: Functor that reads the pending datagrams of a socket with a single recvmmsg(...) call. The datagrams are
+ * written in a ring of pool buffers, which is refilled before each call, and are passed to the queue as one batch
+ */
+class recvmmsg_pdu_task
+{
+public:
+  using callback_t = recvfrom_batch_callback_t;
+  explicit recvmmsg_pdu_task(srslog::basic_logger& logger, srsran::task_queue_handle& queue_, callback_t func_) :
+    logger(logger), queue(queue_), func(std::move(func_))
+  {}
+
+  bool operator()(int fd)
+  {
+    // Refill the buffers handed over in the last batch. A depleted pool shortens the batch
+    size_t nof_bufs = 0;
+    for (; nof_bufs < datagram_batch::max_size; ++nof_bufs) {
+      if (ring[nof_bufs] == nullptr) {
+        ring[nof_bufs] = srsran::make_byte_buffer();
+        if (ring[nof_bufs] == nullptr) {
+          break;
+        }
+      }
+    }
+    if (nof_bufs == 0) {
       logger.error("Unable to allocate byte buffer");
       return true;
     }
-    sockaddr_in from    = {};
-    socklen_t   fromlen = sizeof(from);
 
-    ssize_t n_recv = recvfrom(fd, pdu->msg, pdu->get_tailroom(), 0, (struct sockaddr*)&from, &fromlen);
+    for (size_t i = 0; i < nof_bufs; ++i) {
+      iovs[i].iov_base            = ring[i]->msg;
+      iovs[i].iov_len             = ring[i]->get_tailroom();
+      msgs[i]                     = {};
+      msgs[i].msg_hdr.msg_name    = &addrs[i];
+      msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+      msgs[i].msg_hdr.msg_iov     = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen  = 1;
+    }
+
+    int n_recv = recvmmsg(fd, msgs.data(), nof_bufs, MSG_DONTWAIT, nullptr);
     if (n_recv == -1 and errno != EAGAIN) {
       logger.error("Error reading from socket: %s", strerror(errno));
       return true;
     }
-    if (n_recv == -1 and errno == EAGAIN) {
+    if (n_recv <= 0) {
       logger.debug("Socket timeout reached");
       return true;
     }
 
-    pdu->N_bytes = static_cast<uint32_t>(n_recv);
+    std::unique_ptr<datagram_batch> batch(new datagram_batch);
+    for (int i = 0; i < n_recv; ++i) {
+      if ((msgs[i].msg_hdr.msg_flags & MSG_TRUNC) != 0) {
+        logger.warning("Discarding datagram larger than %d bytes", (int)iovs[i].iov_len);
+        continue;
+      }
+      ring[i]->N_bytes = msgs[i].msg_len;
+      batch->pdus.push_back(std::move(ring[i]));
+      batch->addrs.push_back(addrs[i]);
+    }
+    if (batch->pdus.empty()) {
+      return true;
+    }
 
-    // Defer handling of received packet to provided queue
-    queue.push(
-        std::bind([this, from](srsran::unique_byte_buffer_t& sdu) { func(std::move(sdu), from); }, std::move(pdu)));
+    // Defer handling of received batch to provided queue
+    queue.push(std::bind([this](std::unique_ptr<datagram_batch>& b) { func(*b); }, std::move(batch)));
 
     return true;
   }
@@ -693,12 +820,221 @@ private:
   srslog::basic_logger&      logger;
   srsran::task_queue_handle& queue;
   callback_t                 func;
+
+  std::array<srsran::unique_byte_buffer_t, datagram_batch::max_size> ring;
+  std::array<mmsghdr, datagram_batch::max_size>                      msgs;
+  std::array<iovec, datagram_batch::max_size>                        iovs;
+  std::array<sockaddr_in, datagram_batch::max_size>                  addrs;
 };
 
-socket_manager_itf::recv_callback_t
-make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue, recvfrom_callback_t rx_callback)
+socket_manager_itf::recv_callback_t make_batch_sdu_handler(srslog::basic_logger&      logger,
+                                                           srsran::task_queue_handle& queue,
+                                                           recvfrom_batch_callback_t  rx_callback)
 {
-  return socket_manager_itf::recv_callback_t(recvfrom_pdu_task(logger, queue, std::move(rx_callback)));
+  return socket_manager_itf::recv_callback_t(recvmmsg_pdu_task(logger, queue, std::move(rx_callback)));
+}
+
+/***************************************************************
+ *                 Datagram Tx Aggregation
+ **************************************************************/
+
+void datagram_tx_batch::push(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr)
+{
+  pending.pdus.push_back(std::move(pdu));
+  pending.addrs.push_back(addr);
+  if (pending.pdus.full()) {
+    flush();
+  }
+}
+
+void datagram_tx_batch::flush()
+{
+  size_t nof_msgs = pending.pdus.size();
+  if (nof_msgs == 0) {
+    return;
+  }
+
+  std::array<mmsghdr, datagram_batch::max_size> msgs;
+  std::array<iovec, datagram_batch::max_size>   iovs;
+  for (size_t i = 0; i < nof_msgs; ++i) {
+    iovs[i].iov_base            = pending.pdus[i]->msg;
+    iovs[i].iov_len             = pending.pdus[i]->N_bytes;
+    msgs[i]                     = {};
+    msgs[i].msg_hdr.msg_name    = &pending.addrs[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    msgs[i].msg_hdr.msg_iov     = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen  = 1;
+  }
+
+  // sendmmsg() stops at the first datagram that fails, which is then skipped so that the rest is still sent
+  size_t nof_sent = 0;
+  while (nof_sent < nof_msgs) {
+    int ret = sendmmsg(fd, &msgs[nof_sent], nof_msgs - nof_sent, 0);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      logger.error("Error sending datagram to %s: %s", net_utils::get_ip(pending.addrs[nof_sent]).c_str(), strerror(errno));
+      ret = 1;
+    }
+    nof_sent += ret;
+  }
+
+  pending.pdus.clear();
+  pending.addrs.clear();
+}
+
+/***************************************************************
+ *                 SCTP Tx Worker
+ **************************************************************/
+
+sctp_tx_worker::sctp_tx_worker(srslog::basic_logger& logger_, std::string thread_name) :
+  thread(std::move(thread_name)), logger(logger_), queue(max_nof_batches)
+{
+  start();
+}
+
+sctp_tx_worker::~sctp_tx_worker()
+{
+  stop();
+}
+
+void sctp_tx_worker::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (not running) {
+      return;
+    }
+    running = false;
+  }
+  cvar.notify_all();
+  wait_thread_finish();
+}
+
+void sctp_tx_worker::set_socket(int fd_, const sockaddr_in& dest_addr_, uint32_t ppid_)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  fd        = fd_;
+  dest_addr = dest_addr_;
+  ppid      = ppid_;
+}
+
+void sctp_tx_worker::clear_socket()
+{
+  pending.pdus.clear();
+  pending.stream_ids.clear();
+  std::unique_lock<std::mutex> lock(mutex);
+  fd = -1;
+  queue.clear();
+  while (sending) {
+    cvar.wait(lock);
+  }
+}
+
+void sctp_tx_worker::push(srsran::unique_byte_buffer_t pdu, uint16_t stream_id)
+{
+  pending.pdus.push_back(std::move(pdu));
+  pending.stream_ids.push_back(stream_id);
+  if (pending.pdus.full()) {
+    flush();
+  }
+}
+
+void sctp_tx_worker::flush()
+{
+  if (pending.pdus.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (queue.full()) {
+      logger.error("Discarding %zd SCTP messages. Cause: The SCTP Tx thread can not keep up", pending.pdus.size());
+    } else {
+      queue.push(std::move(pending));
+    }
+  }
+  pending.pdus.clear();
+  pending.stream_ids.clear();
+  cvar.notify_one();
+}
+
+void sctp_tx_worker::run_thread()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    while (running and queue.empty()) {
+      cvar.wait(lock);
+    }
+    // The batches queued before stop() are still sent
+    if (queue.empty()) {
+      break;
+    }
+    batch_t     batch      = std::move(queue.top());
+    int         batch_fd   = fd;
+    sockaddr_in batch_addr = dest_addr;
+    uint32_t    batch_ppid = ppid;
+    queue.pop();
+    sending = true;
+    lock.unlock();
+
+    send_batch(batch, batch_fd, batch_addr, batch_ppid);
+
+    lock.lock();
+    sending = false;
+    cvar.notify_all();
+  }
+}
+
+void sctp_tx_worker::send_batch(batch_t& batch, int fd_, const sockaddr_in& dest_addr_, uint32_t ppid_)
+{
+  size_t nof_msgs = batch.pdus.size();
+  if (fd_ < 0) {
+    logger.warning("Discarding %zd SCTP messages. Cause: The socket is closed", nof_msgs);
+    return;
+  }
+
+  // The stream of each message goes in its SCTP_SNDRCV ancillary data, as sctp_sendmsg() does
+  using cmsg_buf_t = std::array<uint8_t, CMSG_SPACE(sizeof(sctp_sndrcvinfo))>;
+  std::array<mmsghdr, max_batch_size>    msgs;
+  std::array<iovec, max_batch_size>      iovs;
+  std::array<cmsg_buf_t, max_batch_size> cmsg_bufs;
+  sockaddr_in                            addr = dest_addr_;
+  for (size_t i = 0; i < nof_msgs; ++i) {
+    iovs[i].iov_base = batch.pdus[i]->msg;
+    iovs[i].iov_len  = batch.pdus[i]->N_bytes;
+    cmsg_bufs[i].fill(0);
+    msgs[i]                        = {};
+    msgs[i].msg_hdr.msg_name       = &addr;
+    msgs[i].msg_hdr.msg_namelen    = sizeof(sockaddr_in);
+    msgs[i].msg_hdr.msg_iov        = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen     = 1;
+    msgs[i].msg_hdr.msg_control    = cmsg_bufs[i].data();
+    msgs[i].msg_hdr.msg_controllen = cmsg_bufs[i].size();
+
+    cmsghdr* cmsg    = CMSG_FIRSTHDR(&msgs[i].msg_hdr);
+    cmsg->cmsg_level = IPPROTO_SCTP;
+    cmsg->cmsg_type  = SCTP_SNDRCV;
+    cmsg->cmsg_len   = CMSG_LEN(sizeof(sctp_sndrcvinfo));
+
+    sctp_sndrcvinfo* sinfo = (sctp_sndrcvinfo*)CMSG_DATA(cmsg);
+    sinfo->sinfo_stream    = batch.stream_ids[i];
+    sinfo->sinfo_ppid      = htonl(ppid_);
+  }
+
+  // sendmmsg() stops at the first message that fails, which is then skipped so that the rest is still sent
+  size_t nof_sent = 0;
+  while (nof_sent < nof_msgs) {
+    int ret = sendmmsg(fd_, &msgs[nof_sent], nof_msgs - nof_sent, 0);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      logger.error("Error sending SCTP message on stream %d: %s", batch.stream_ids[nof_sent], strerror(errno));
+      ret = 1;
+    }
+    nof_sent += ret;
+  }
 }
 
 } // namespace srsran
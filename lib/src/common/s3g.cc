@@ -21,6 +21,10 @@
 
 #include "srsran/common/s3g.h"
 
+#ifdef __PCLMUL__
+#include <wmmintrin.h>
+#endif
+
 /* S-box SQ */
 static const uint8_t SQ[256] = {
     0x25, 0x24, 0x73, 0x67, 0xD7, 0xAE, 0x5C, 0x30, 0xA4, 0xEE, 0x6E, 0xCB, 0x7D, 0xB5, 0x82, 0xDB, 0xE4, 0x8E, 0x48,
@@ -194,6 +198,48 @@ uint8_t s3g_mul_x_pow(uint8_t v, uint8_t i, uint8_t c)
     return s3g_mul_x(s3g_mul_x_pow(v, i - 1, c), c);
 }
 
+/*********************************************************************
+    Name: s3g_tables
+
+    Description: MULalpha, DIValpha and the S-box tables, computed once
+                 so that every clock of the LFSR and of the FSM is a
+                 few table lookups.
+
+    Document Reference: Specification of the 3GPP Confidentiality and
+                            Integrity Algorithms UEA2 & UIA2 D2 v1.1
+                            Section 3.3 and Section 3.4
+*********************************************************************/
+struct s3g_tables_t {
+  s3g_tables_t()
+  {
+    for (uint32_t x = 0; x < 256; x++) {
+      uint8_t c    = (uint8_t)x;
+      mul_alpha[x] = ((((uint32_t)s3g_mul_x_pow(c, 23, 0xa9)) << 24) | (((uint32_t)s3g_mul_x_pow(c, 245, 0xa9)) << 16) |
+                      (((uint32_t)s3g_mul_x_pow(c, 48, 0xa9)) << 8) | (((uint32_t)s3g_mul_x_pow(c, 239, 0xa9))));
+      div_alpha[x] = ((((uint32_t)s3g_mul_x_pow(c, 16, 0xa9)) << 24) | (((uint32_t)s3g_mul_x_pow(c, 39, 0xa9)) << 16) |
+                      (((uint32_t)s3g_mul_x_pow(c, 6, 0xa9)) << 8) | (((uint32_t)s3g_mul_x_pow(c, 64, 0xa9))));
+      fill_sbox(s1[0][x], s1[1][x], s1[2][x], s1[3][x], S[x], s3g_mul_x(S[x], 0x1b));
+      fill_sbox(s2[0][x], s2[1][x], s2[2][x], s2[3][x], SQ[x], s3g_mul_x(SQ[x], 0x69));
+    }
+  }
+
+  /// Contribution of each input byte to the output word of S1/S2, for the S-box output s and its product m by x
+  static void fill_sbox(uint32_t& t0, uint32_t& t1, uint32_t& t2, uint32_t& t3, uint32_t s, uint32_t m)
+  {
+    t0 = (m << 24) | ((m ^ s) << 16) | (s << 8) | s;
+    t1 = (s << 24) | (m << 16) | ((m ^ s) << 8) | s;
+    t2 = (s << 24) | (s << 16) | (m << 8) | (m ^ s);
+    t3 = ((m ^ s) << 24) | (s << 16) | (s << 8) | m;
+  }
+
+  uint32_t mul_alpha[256];
+  uint32_t div_alpha[256];
+  uint32_t s1[4][256];
+  uint32_t s2[4][256];
+};
+
+static const s3g_tables_t s3g_tables;
+
 /*********************************************************************
     Name: s3g_mul_alpha
 
@@ -205,8 +251,7 @@ uint8_t s3g_mul_x_pow(uint8_t v, uint8_t i, uint8_t c)
 *********************************************************************/
 uint32_t s3g_mul_alpha(uint8_t c)
 {
-  return ((((uint32_t)s3g_mul_x_pow(c, 23, 0xa9)) << 24) | (((uint32_t)s3g_mul_x_pow(c, 245, 0xa9)) << 16) |
-          (((uint32_t)s3g_mul_x_pow(c, 48, 0xa9)) << 8) | (((uint32_t)s3g_mul_x_pow(c, 239, 0xa9))));
+  return s3g_tables.mul_alpha[c];
 }
 
 /*********************************************************************
@@ -220,8 +265,7 @@ uint32_t s3g_mul_alpha(uint8_t c)
 *********************************************************************/
 uint32_t s3g_div_alpha(uint8_t c)
 {
-  return ((((uint32_t)s3g_mul_x_pow(c, 16, 0xa9)) << 24) | (((uint32_t)s3g_mul_x_pow(c, 39, 0xa9)) << 16) |
-          (((uint32_t)s3g_mul_x_pow(c, 6, 0xa9)) << 8) | (((uint32_t)s3g_mul_x_pow(c, 64, 0xa9))));
+  return s3g_tables.div_alpha[c];
 }
 
 /*********************************************************************
@@ -235,21 +279,8 @@ uint32_t s3g_div_alpha(uint8_t c)
 *********************************************************************/
 uint32_t s3g_s1(uint32_t w)
 {
-  uint8_t r0 = 0, r1 = 0, r2 = 0, r3 = 0;
-  uint8_t srw0 = S[(uint8_t)((w >> 24) & 0xff)];
-  uint8_t srw1 = S[(uint8_t)((w >> 16) & 0xff)];
-  uint8_t srw2 = S[(uint8_t)((w >> 8) & 0xff)];
-  uint8_t srw3 = S[(uint8_t)((w)&0xff)];
-
-  r0 = ((s3g_mul_x(srw0, 0x1b)) ^ (srw1) ^ (srw2) ^ ((s3g_mul_x(srw3, 0x1b)) ^ srw3));
-
-  r1 = (((s3g_mul_x(srw0, 0x1b)) ^ srw0) ^ (s3g_mul_x(srw1, 0x1b)) ^ (srw2) ^ (srw3));
-
-  r2 = ((srw0) ^ ((s3g_mul_x(srw1, 0x1b)) ^ srw1) ^ (s3g_mul_x(srw2, 0x1b)) ^ (srw3));
-
-  r3 = ((srw0) ^ (srw1) ^ ((s3g_mul_x(srw2, 0x1b)) ^ srw2) ^ (s3g_mul_x(srw3, 0x1b)));
-
-  return ((((uint32_t)r0) << 24) | (((uint32_t)r1) << 16) | (((uint32_t)r2) << 8) | (((uint32_t)r3)));
+  return s3g_tables.s1[0][(w >> 24) & 0xff] ^ s3g_tables.s1[1][(w >> 16) & 0xff] ^ s3g_tables.s1[2][(w >> 8) & 0xff] ^
+         s3g_tables.s1[3][w & 0xff];
 }
 
 /*********************************************************************
@@ -263,21 +294,8 @@ uint32_t s3g_s1(uint32_t w)
 *********************************************************************/
 uint32_t s3g_s2(uint32_t w)
 {
-  uint8_t r0 = 0, r1 = 0, r2 = 0, r3 = 0;
-  uint8_t sqw0 = SQ[(uint8_t)((w >> 24) & 0xff)];
-  uint8_t sqw1 = SQ[(uint8_t)((w >> 16) & 0xff)];
-  uint8_t sqw2 = SQ[(uint8_t)((w >> 8) & 0xff)];
-  uint8_t sqw3 = SQ[(uint8_t)((w)&0xff)];
-
-  r0 = ((s3g_mul_x(sqw0, 0x69)) ^ (sqw1) ^ (sqw2) ^ ((s3g_mul_x(sqw3, 0x69)) ^ sqw3));
-
-  r1 = (((s3g_mul_x(sqw0, 0x69)) ^ sqw0) ^ (s3g_mul_x(sqw1, 0x69)) ^ (sqw2) ^ (sqw3));
-
-  r2 = ((sqw0) ^ ((s3g_mul_x(sqw1, 0x69)) ^ sqw1) ^ (s3g_mul_x(sqw2, 0x69)) ^ (sqw3));
-
-  r3 = ((sqw0) ^ (sqw1) ^ ((s3g_mul_x(sqw2, 0x69)) ^ sqw2) ^ (s3g_mul_x(sqw3, 0x69)));
-
-  return ((((uint32_t)r0) << 24) | (((uint32_t)r1) << 16) | (((uint32_t)r2) << 8) | (((uint32_t)r3)));
+  return s3g_tables.s2[0][(w >> 24) & 0xff] ^ s3g_tables.s2[1][(w >> 16) & 0xff] ^ s3g_tables.s2[2][(w >> 8) & 0xff] ^
+         s3g_tables.s2[3][w & 0xff];
 }
 
 /*********************************************************************
@@ -337,9 +355,6 @@ void s3g_initialize(S3G_STATE* state, uint32_t k[4], uint32_t iv[4])
   uint8_t  i = 0;
   uint32_t f = 0x0;
 
-  state->lfsr = (uint32_t*)calloc(16, sizeof(uint32_t));
-  state->fsm  = (uint32_t*)calloc(3, sizeof(uint32_t));
-
   state->lfsr[15] = k[3] ^ iv[0];
   state->lfsr[14] = k[2];
   state->lfsr[13] = k[1];
@@ -377,8 +392,7 @@ void s3g_initialize(S3G_STATE* state, uint32_t k[4], uint32_t iv[4])
 *********************************************************************/
 void s3g_deinitialize(S3G_STATE* state)
 {
-  free(state->lfsr);
-  free(state->fsm);
+  memset(state, 0, sizeof(S3G_STATE));
 }
 
 /*********************************************************************
@@ -461,6 +475,47 @@ uint64_t s3g_MUL64(uint64_t V, uint64_t P, uint64_t c)
   return result;
 }
 
+/* MUL64 by a fixed P.
+ * Input P: a 64-bit input, fixed for all the multiplications.
+ * Computes s3g_MUL64(V, P, 0x1b) with the carry-less multiplication
+ * instruction where available. Otherwise P * x^i is precomputed for every
+ * bit i, so that each multiplication is at most 64 XORs.
+ */
+struct s3g_mul64_p {
+  explicit s3g_mul64_p(uint64_t P_) : P(P_)
+  {
+#ifndef __PCLMUL__
+    P_pow[0] = P;
+    for (uint32_t i = 1; i < 64; i++) {
+      P_pow[i] = s3g_MUL64x(P_pow[i - 1], 0x1b);
+    }
+#endif
+  }
+
+  uint64_t operator()(uint64_t V) const
+  {
+#ifdef __PCLMUL__
+    // The high half of the product is reduced with x^64 = x^4 + x^3 + x + 1, twice because it can overflow again
+    const __m128i c    = _mm_cvtsi64_si128(0x1b);
+    __m128i       prod = _mm_clmulepi64_si128(_mm_cvtsi64_si128(V), _mm_cvtsi64_si128(P), 0x00);
+    __m128i       red  = _mm_clmulepi64_si128(_mm_unpackhi_epi64(prod, prod), c, 0x00);
+    __m128i       red2 = _mm_clmulepi64_si128(_mm_unpackhi_epi64(red, red), c, 0x00);
+    return (uint64_t)_mm_cvtsi128_si64(_mm_xor_si128(_mm_xor_si128(prod, red), red2));
+#else
+    uint64_t result = 0;
+    for (uint32_t i = 0; i < 64; i++) {
+      result ^= P_pow[i] & (0 - ((V >> i) & 0x1));
+    }
+    return result;
+#endif
+  }
+
+  uint64_t P;
+#ifndef __PCLMUL__
+  uint64_t P_pow[64];
+#endif
+};
+
 /* mask8bit.
  * Input n: an integer in 1-7.
  * Output : an 8 bit mask.
@@ -481,17 +536,21 @@ uint8_t mask8bit(int n)
  * Output  : 32 bit block used as MAC
  * Generates 32-bit MAC using UIA2 algorithm as defined in Section 4.
  */
-uint8_t* s3g_f9(const uint8_t* key, uint32_t count, uint32_t fresh, uint32_t dir, uint8_t* data, uint64_t length)
+void s3g_f9(const uint8_t* key,
+            uint32_t       count,
+            uint32_t       fresh,
+            uint32_t       dir,
+            const uint8_t* data,
+            uint64_t       length,
+            uint8_t*       mac)
 {
-  uint32_t       K[4], IV[4], z[5];
-  uint32_t       i        = 0, D;
-  static uint8_t MAC_I[4] = {0, 0, 0, 0}; /* static memory for the result */
-  uint64_t       EVAL;
-  uint64_t       V;
-  uint64_t       P;
-  uint64_t       Q;
-  uint64_t       c;
-  S3G_STATE      state, *state_ptr;
+  uint32_t  K[4], IV[4], z[5];
+  uint32_t  i = 0, D;
+  uint64_t  EVAL;
+  uint64_t  V;
+  uint64_t  P;
+  uint64_t  Q;
+  S3G_STATE state, *state_ptr;
 
   uint64_t M_D_2;
   int      rem_bits = 0;
@@ -522,14 +581,14 @@ uint8_t* s3g_f9(const uint8_t* key, uint32_t count, uint32_t fresh, uint32_t dir
   else
     D = (length >> 6) + 2;
   EVAL = 0;
-  c    = 0x1b;
+  s3g_mul64_p mul_P(P);
 
   /* for 0 <= i <= D-3 */
   for (i = 0; i < D - 2; i++) {
     V    = EVAL ^ ((uint64_t)data[8 * i] << 56 | (uint64_t)data[8 * i + 1] << 48 | (uint64_t)data[8 * i + 2] << 40 |
                 (uint64_t)data[8 * i + 3] << 32 | (uint64_t)data[8 * i + 4] << 24 | (uint64_t)data[8 * i + 5] << 16 |
                 (uint64_t)data[8 * i + 6] << 8 | (uint64_t)data[8 * i + 7]);
-    EVAL = s3g_MUL64(V, P, c);
+    EVAL = mul_P(V);
   }
 
   /* for D-2 */
@@ -548,13 +607,13 @@ uint8_t* s3g_f9(const uint8_t* key, uint32_t count, uint32_t fresh, uint32_t dir
     M_D_2 |= (uint64_t)(data[8 * (D - 2) + i] & mask8bit(rem_bits)) << (8 * (7 - i));
 
   V    = EVAL ^ M_D_2;
-  EVAL = s3g_MUL64(V, P, c);
+  EVAL = mul_P(V);
 
   /* for D-1 */
   EVAL ^= length;
 
   /* Multiply by Q */
-  EVAL = s3g_MUL64(EVAL, Q, c);
+  EVAL = s3g_mul64_p(Q)(EVAL);
 
   /* XOR with z_5: this is a modification to the reference C code,
      which forgot to XOR z[5] */
@@ -562,7 +621,5 @@ uint8_t* s3g_f9(const uint8_t* key, uint32_t count, uint32_t fresh, uint32_t dir
     /*
     MAC_I[i] = (mac32 >> (8*(3-i))) & 0xff;
     */
-    MAC_I[i] = ((EVAL >> (56 - (i * 8))) ^ (z[4] >> (24 - (i * 8)))) & 0xff;
-
-  return MAC_I;
+    mac[i] = ((EVAL >> (56 - (i * 8))) ^ (z[4] >> (24 - (i * 8)))) & 0xff;
 }
\ No newline at end of file
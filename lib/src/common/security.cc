@@ -25,6 +25,7 @@
 #include "srsran/common/s3g.h"
 #include "srsran/common/ssl.h"
 #include "srsran/config.h"
+#include <algorithm>
 #include <arpa/inet.h>
 
 #define FC_EPS_K_ASME_DERIVATION 0x10
@@ -804,6 +805,43 @@ int kdf_common(const uint8_t                  fc,
 
   return SRSRAN_SUCCESS;
 }
+/******************************************************************************
+ * AES key schedule
+ *****************************************************************************/
+
+struct security_aes_key_t::aes_ctx_t {
+  aes_ctx_t() { aes_init(&aes); }
+  ~aes_ctx_t() { aes_free(&aes); }
+
+  aes_context aes;
+  uint8_t     k1[16]; ///< CMAC subkey of the last block when complete
+  uint8_t     k2[16]; ///< CMAC subkey of the last block when padded
+};
+
+security_aes_key_t::security_aes_key_t()  = default;
+security_aes_key_t::~security_aes_key_t() = default;
+
+/// Doubling in GF(2^128), used to generate the CMAC subkeys (RFC4493)
+static void cmac_gen_subkey(const uint8_t* in, uint8_t* out)
+{
+  for (uint32_t i = 0; i < 15; i++) {
+    out[i] = (in[i] << 1U) | (in[i + 1] >> 7U);
+  }
+  out[15] = (in[15] << 1U) ^ ((in[0] & 0x80U) ? 0x87U : 0U);
+}
+
+void security_aes_key_t::set_key(const uint8_t* key)
+{
+  ctx.reset(new aes_ctx_t);
+  aes_setkey_enc(&ctx->aes, key, 128);
+
+  uint8_t const_zero[16] = {};
+  uint8_t L[16];
+  aes_crypt_ecb(&ctx->aes, AES_ENCRYPT, const_zero, L);
+  cmac_gen_subkey(L, ctx->k1);
+  cmac_gen_subkey(ctx->k1, ctx->k2);
+}
+
 /******************************************************************************
  * Integrity Protection
  *****************************************************************************/
@@ -830,6 +868,58 @@ uint8_t security_128_eia2(const uint8_t* key,
   return liblte_security_128_eia2(key, count, bearer, direction, msg, msg_len, mac);
 }
 
+uint8_t security_128_eia2(const security_aes_key_t& key,
+                          uint32_t                  count,
+                          uint32_t                  bearer,
+                          uint8_t                   direction,
+                          const uint8_t*            msg,
+                          uint32_t                  msg_len,
+                          uint8_t*                  mac)
+{
+  if (not key.is_set() or msg == nullptr or mac == nullptr) {
+    return SRSRAN_ERROR;
+  }
+  aes_context* aes = &key.ctx->aes;
+
+  // The CMAC input is the COUNT, BEARER and DIRECTION header followed by the message (33.401 Annex B.2.3). Only the
+  // first block, which holds the header, and the last block, which is padded, are built apart
+  uint32_t total_len = msg_len + 8;
+  uint32_t nof_blks  = (total_len + 15) / 16;
+  uint8_t  first[16] = {};
+  first[0]           = (count >> 24U) & 0xFFU;
+  first[1]           = (count >> 16U) & 0xFFU;
+  first[2]           = (count >> 8U) & 0xFFU;
+  first[3]           = count & 0xFFU;
+  first[4]           = (bearer << 3U) | (direction << 2U);
+  memcpy(&first[8], msg, std::min(msg_len, 8U));
+
+  uint8_t T[16] = {};
+  uint8_t tmp[16];
+  for (uint32_t i = 0; i + 1 < nof_blks; i++) {
+    const uint8_t* blk = i == 0 ? first : &msg[16 * i - 8];
+    for (uint32_t j = 0; j < 16; j++) {
+      tmp[j] = T[j] ^ blk[j];
+    }
+    aes_crypt_ecb(aes, AES_ENCRYPT, tmp, T);
+  }
+
+  uint8_t  last[16] = {};
+  uint32_t last_len = total_len - 16 * (nof_blks - 1);
+  memcpy(last, nof_blks == 1 ? first : &msg[16 * (nof_blks - 1) - 8], last_len);
+  const uint8_t* subkey = key.ctx->k1;
+  if (last_len < 16) {
+    last[last_len] = 0x80;
+    subkey         = key.ctx->k2;
+  }
+  for (uint32_t j = 0; j < 16; j++) {
+    tmp[j] = T[j] ^ last[j] ^ subkey[j];
+  }
+  aes_crypt_ecb(aes, AES_ENCRYPT, tmp, T);
+
+  memcpy(mac, T, 4);
+  return SRSRAN_SUCCESS;
+}
+
 uint8_t security_128_eia3(const uint8_t* key,
                           uint32_t       count,
                           uint32_t       bearer,
@@ -874,6 +964,33 @@ uint8_t security_128_eea2(uint8_t* key,
   return liblte_security_encryption_eea2(key, count, bearer, direction, msg, msg_len * 8, msg_out);
 }
 
+uint8_t security_128_eea2(const security_aes_key_t& key,
+                          uint32_t                  count,
+                          uint8_t                   bearer,
+                          uint8_t                   direction,
+                          const uint8_t*            msg,
+                          uint32_t                  msg_len,
+                          uint8_t*                  msg_out)
+{
+  if (not key.is_set() or msg == nullptr or msg_out == nullptr) {
+    return SRSRAN_ERROR;
+  }
+
+  unsigned char stream_blk[16] = {};
+  unsigned char nonce_cnt[16]  = {};
+  size_t        nc_off         = 0;
+  nonce_cnt[0]                 = (count >> 24U) & 0xFFU;
+  nonce_cnt[1]                 = (count >> 16U) & 0xFFU;
+  nonce_cnt[2]                 = (count >> 8U) & 0xFFU;
+  nonce_cnt[3]                 = count & 0xFFU;
+  nonce_cnt[4]                 = ((bearer & 0x1FU) << 3U) | ((direction & 0x01U) << 2U);
+
+  if (aes_crypt_ctr(&key.ctx->aes, msg_len, &nc_off, nonce_cnt, stream_blk, msg, msg_out) != 0) {
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
 uint8_t security_128_eea3(uint8_t* key,
                           uint32_t count,
                           uint8_t  bearer,
@@ -21,9 +21,11 @@
 
 #include "srsran/common/thread_pool.h"
 #include "srsran/srslog/srslog.h"
+#include <algorithm>
 #include <assert.h>
 #include <chrono>
 #include <stdio.h>
+#include <thread>
 
 #define DEBUG 0
 #define debug_thread(fmt, ...)                                                                                         \
@@ -48,6 +50,14 @@ void thread_pool::worker::setup(uint32_t id, thread_pool* parent, uint32_t prio,
   }
 }
 
+void thread_pool::worker::setup(uint32_t id, thread_pool* parent, uint32_t prio, const std::string& cpu_list)
+{
+  my_id     = id;
+  my_parent = parent;
+
+  start_cpu_list(prio, cpu_list);
+}
+
 void thread_pool::worker::run_thread()
 {
   set_name(my_parent->get_id() + std::string("WORKER") + std::to_string(my_id));
@@ -94,6 +104,19 @@ void thread_pool::init_worker(uint32_t id, worker* obj, uint32_t prio, uint32_t
   }
 }
 
+void thread_pool::init_worker(uint32_t id, worker* obj, uint32_t prio, const std::string& cpu_list)
+{
+  std::lock_guard<std::mutex> lock(mutex_queue);
+  if (id < max_workers) {
+    if (id >= nof_workers) {
+      nof_workers = id + 1;
+    }
+    workers[id] = obj;
+    obj->setup(id, this, prio, cpu_list);
+    cvar_queue.notify_all();
+  }
+}
+
 void thread_pool::stop()
 {
   {
@@ -272,9 +295,16 @@ std::string thread_pool::get_id()
  *  once a worker is available
  *************************************************************************/
 
+thread_local task_thread_pool::worker_t* task_thread_pool::current_worker = nullptr;
+
 task_thread_pool::task_thread_pool(uint32_t nof_workers, bool start_deferred, int32_t prio_, uint32_t mask_) :
-  logger(srslog::fetch_basic_logger("POOL")), pending_tasks(max_task_num), workers(std::max(1u, nof_workers))
+  logger(srslog::fetch_basic_logger("POOL")), workers(std::max(min_nof_slots, nof_workers))
 {
+  nof_workers = std::max(1u, nof_workers);
+  for (uint32_t i = 0; i < nof_workers; ++i) {
+    workers[i].reset(new worker_t(this, i));
+  }
+  nof_active.store(nof_workers, std::memory_order_release);
   if (not start_deferred) {
     start(prio_, mask_);
   }
@@ -287,79 +317,186 @@ task_thread_pool::~task_thread_pool()
 
 void task_thread_pool::set_nof_workers(uint32_t nof_workers)
 {
-  std::lock_guard<std::mutex> lock(queue_mutex);
-  if (workers.size() > nof_workers) {
+  std::lock_guard<std::mutex> lock(state_mutex);
+  uint32_t                    old_size = nof_active.load(std::memory_order_relaxed);
+  if (old_size > nof_workers) {
     logger.error("Reducing the number of workers dynamically not supported");
     return;
   }
-  uint32_t old_size = workers.size();
-  workers.resize(nof_workers);
-  if (running) {
-    for (uint32_t i = old_size; i < nof_workers; ++i) {
-      workers[i].reset(new worker_t(this, i));
+  if (nof_workers > workers.size()) {
+    logger.error("Increasing the number of workers beyond %zd not supported", workers.size());
+    return;
+  }
+  for (uint32_t i = old_size; i < nof_workers; ++i) {
+    workers[i].reset(new worker_t(this, i));
+    if (running) {
+      workers[i]->launch();
     }
   }
+  nof_active.store(nof_workers, std::memory_order_release);
 }
 
 void task_thread_pool::start(int32_t prio_, uint32_t mask_)
 {
-  std::lock_guard<std::mutex> lock(queue_mutex);
+  std::lock_guard<std::mutex> lock(state_mutex);
   if (running) {
     logger.error("Starting thread pool that has already started");
     return;
   }
-  prio    = prio_;
-  mask    = mask_;
-  running = true;
-  for (uint32_t i = 0; i < workers.size(); ++i) {
-    workers[i].reset(new worker_t(this, i));
+  prio = prio_;
+  mask = mask_;
+  running.store(true, std::memory_order_seq_cst);
+  for (uint32_t i = 0; i < nof_workers(); ++i) {
+    workers[i]->launch();
   }
 }
 
 void task_thread_pool::stop()
 {
-  std::unique_lock<std::mutex> lock(queue_mutex);
+  std::lock_guard<std::mutex> lock(state_mutex);
   if (running) {
-    running              = false;
-    bool workers_running = false;
-    for (std::unique_ptr<worker_t>& w : workers) {
-      if (w->is_running()) {
-        workers_running = true;
-        break;
-      }
+    running.store(false, std::memory_order_seq_cst);
+    for (uint32_t i = 0; i < nof_workers(); ++i) {
+      workers[i]->wake_up();
     }
-    lock.unlock();
-    if (workers_running) {
-      cv_empty.notify_all();
-    }
-    for (std::unique_ptr<worker_t>& w : workers) {
-      w->stop();
+    for (uint32_t i = 0; i < nof_workers(); ++i) {
+      workers[i]->stop();
     }
   }
 }
 
 void task_thread_pool::push_task(task_t&& task)
 {
-  {
-    std::lock_guard<std::mutex> lock(queue_mutex);
-    if (pending_tasks.full()) {
-      logger.error("Cannot push anymore tasks into the queue, maximum size is %u", uint32_t(max_task_num));
+  worker_t* worker = current_worker;
+  if (worker != nullptr and worker->belongs_to(this)) {
+    // Tasks pushed by a task stay in the deque of its worker, where the idle workers can steal them
+    nof_queued.fetch_add(1, std::memory_order_seq_cst);
+    if (worker->deque.push(std::move(task))) {
+      wake_up_worker(worker->id(), false);
+      return;
+    }
+    nof_queued.fetch_sub(1, std::memory_order_relaxed);
+  }
+  push_task_to(next_worker.fetch_add(1, std::memory_order_relaxed) % nof_workers(), std::move(task), false);
+}
+
+void task_thread_pool::push_task(uint32_t affinity_key, task_t&& task)
+{
+  uint32_t  worker_idx = affinity_key % nof_workers();
+  worker_t* worker     = current_worker;
+  if (worker != nullptr and worker->belongs_to(this) and worker->id() == worker_idx) {
+    nof_queued.fetch_add(1, std::memory_order_seq_cst);
+    if (worker->deque.push(std::move(task))) {
+      wake_up_worker(worker_idx, true);
+      return;
+    }
+    nof_queued.fetch_sub(1, std::memory_order_relaxed);
+  }
+  push_task_to(worker_idx, std::move(task), true);
+}
+
+void task_thread_pool::push_task_to(uint32_t worker_idx, task_t&& task, bool keep_affinity)
+{
+  // The task is counted before it becomes visible, so that a worker never goes to sleep with a task queued
+  uint32_t n = nof_workers();
+  nof_queued.fetch_add(1, std::memory_order_seq_cst);
+  for (uint32_t i = 0; i < n; ++i) {
+    worker_t& worker = *workers[(worker_idx + i) % n];
+    if (worker.push_inbox(std::move(task))) {
+      wake_up_worker(worker.id(), keep_affinity);
+      return;
+    }
+  }
+  nof_queued.fetch_sub(1, std::memory_order_relaxed);
+  logger.error("Cannot push anymore tasks into the queue, maximum size is %u", n * inbox_size);
+}
+
+void task_thread_pool::wake_up_worker(uint32_t preferred_idx, bool keep_affinity)
+{
+  uint32_t  n         = nof_workers();
+  worker_t& preferred = *workers[preferred_idx % n];
+  if (preferred.sleeping.load(std::memory_order_seq_cst)) {
+    preferred.wake_up();
+    return;
+  }
+  // An awake worker takes its next task soon, another worker only steps in when a backlog builds up
+  if (keep_affinity and preferred.queue_len() <= 1) {
+    return;
+  }
+  for (uint32_t i = 1; i < n; ++i) {
+    worker_t& worker = *workers[(preferred_idx + i) % n];
+    if (worker.sleeping.load(std::memory_order_seq_cst)) {
+      worker.wake_up();
       return;
     }
-    pending_tasks.push(std::move(task));
   }
-  cv_empty.notify_one();
 }
 
 uint32_t task_thread_pool::nof_pending_tasks() const
 {
-  std::lock_guard<std::mutex> lock(queue_mutex);
-  return pending_tasks.size();
+  return std::max(0, nof_queued.load(std::memory_order_relaxed));
+}
+
+task_thread_pool_metrics_t task_thread_pool::get_metrics() const
+{
+  task_thread_pool_metrics_t metrics;
+  uint32_t                   n = nof_workers();
+  metrics.queue_len.resize(n);
+  for (uint32_t i = 0; i < n; ++i) {
+    metrics.nof_tasks += workers[i]->nof_tasks.load(std::memory_order_relaxed);
+    metrics.nof_stolen_tasks += workers[i]->nof_stolen_tasks.load(std::memory_order_relaxed);
+    metrics.queue_len[i] = workers[i]->queue_len();
+  }
+  metrics.nof_pending_tasks = nof_pending_tasks();
+  return metrics;
+}
+
+bool task_thread_pool::task_deque::push(task_t&& task)
+{
+  uint64_t b    = bottom.load(std::memory_order_relaxed);
+  slot_t&  slot = slots[b & mask];
+  // The slot is still taken when the deque is full, or when a thief has not finished moving the task out of it
+  if (slot.busy.load(std::memory_order_acquire)) {
+    return false;
+  }
+  slot.task = std::move(task);
+  slot.busy.store(true, std::memory_order_relaxed);
+  bottom.store(b + 1, std::memory_order_release);
+  return true;
+}
+
+bool task_thread_pool::task_deque::pop(task_t& task)
+{
+  uint64_t t = top.load(std::memory_order_acquire);
+  while (t < bottom.load(std::memory_order_acquire)) {
+    if (top.compare_exchange_weak(t, t + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+      slot_t& slot = slots[t & mask];
+      task         = std::move(slot.task);
+      slot.busy.store(false, std::memory_order_release);
+      return true;
+    }
+  }
+  return false;
+}
+
+uint32_t task_thread_pool::task_deque::size() const
+{
+  uint64_t t = top.load(std::memory_order_acquire);
+  uint64_t b = bottom.load(std::memory_order_acquire);
+  return b > t ? b - t : 0;
 }
 
 task_thread_pool::worker_t::worker_t(srsran::task_thread_pool* parent_, uint32_t my_id) :
-  parent(parent_), thread(std::string("TASKWORKER") + std::to_string(my_id)), id_(my_id), running(true)
+  thread(std::string("TASKWORKER") + std::to_string(my_id)),
+  deque(deque_size),
+  parent(parent_),
+  id_(my_id),
+  inbox(inbox_size)
+{}
+
+void task_thread_pool::worker_t::launch()
 {
+  launched = true;
   if (parent->mask == 255) {
     start(parent->prio);
   } else {
@@ -369,36 +506,113 @@ task_thread_pool::worker_t::worker_t(srsran::task_thread_pool* parent_, uint32_t
 
 void task_thread_pool::worker_t::stop()
 {
-  wait_thread_finish();
+  if (launched) {
+    wait_thread_finish();
+    launched = false;
+  }
+}
+
+void task_thread_pool::worker_t::wake_up()
+{
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+  }
+  cv_sleep.notify_one();
+}
+
+bool task_thread_pool::worker_t::push_inbox(task_t&& task)
+{
+  std::lock_guard<std::mutex> lock(inbox_mutex);
+  if (inbox.full()) {
+    return false;
+  }
+  inbox.push(std::move(task));
+  inbox_len.store(inbox.size(), std::memory_order_release);
+  return true;
 }
 
-bool task_thread_pool::worker_t::wait_task(task_t* task)
+bool task_thread_pool::worker_t::pop_inbox(task_t& task, bool refill_deque)
 {
-  std::unique_lock<std::mutex> lock(parent->queue_mutex);
-  while (parent->running and parent->pending_tasks.empty()) {
-    parent->cv_empty.wait(lock);
+  if (inbox_len.load(std::memory_order_acquire) == 0) {
+    return false;
   }
-  if (not parent->running) {
+  std::lock_guard<std::mutex> lock(inbox_mutex);
+  if (inbox.empty()) {
     return false;
   }
-  if (task) {
-    *task = std::move(parent->pending_tasks.top());
+  task = std::move(inbox.top());
+  inbox.pop();
+  // The owner moves the rest of the inbox into its deque, where it takes them, and the thieves steal them, lock-free
+  while (refill_deque and not inbox.empty() and deque.push(std::move(inbox.top()))) {
+    inbox.pop();
   }
-  parent->pending_tasks.pop();
+  inbox_len.store(inbox.size(), std::memory_order_release);
   return true;
 }
 
+uint32_t task_thread_pool::worker_t::queue_len() const
+{
+  return deque.size() + inbox_len.load(std::memory_order_relaxed);
+}
+
+bool task_thread_pool::worker_t::find_task(task_t& task)
+{
+  if (deque.pop(task) or pop_inbox(task, true)) {
+    nof_tasks.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  uint32_t n = parent->nof_workers();
+  for (uint32_t i = 1; i < n; ++i) {
+    worker_t& victim = *parent->workers[(id_ + i) % n];
+    if (victim.deque.pop(task) or victim.pop_inbox(task, false)) {
+      nof_tasks.fetch_add(1, std::memory_order_relaxed);
+      nof_stolen_tasks.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool task_thread_pool::worker_t::wait_task(task_t& task)
+{
+  while (parent->running.load(std::memory_order_acquire)) {
+    if (find_task(task)) {
+      // Hand the remaining tasks to a sleeping worker
+      if (parent->nof_queued.fetch_sub(1, std::memory_order_seq_cst) > 1) {
+        parent->wake_up_worker(id_ + 1, false);
+      }
+      return true;
+    }
+
+    // A task may be counted and not yet visible in the queues, in that case retry
+    std::unique_lock<std::mutex> lock(sleep_mutex);
+    sleeping.store(true, std::memory_order_seq_cst);
+    if (parent->nof_queued.load(std::memory_order_seq_cst) > 0) {
+      sleeping.store(false, std::memory_order_relaxed);
+      lock.unlock();
+      std::this_thread::yield();
+      continue;
+    }
+    while (parent->running.load(std::memory_order_seq_cst) and
+           parent->nof_queued.load(std::memory_order_seq_cst) == 0) {
+      cv_sleep.wait(lock);
+    }
+    sleeping.store(false, std::memory_order_relaxed);
+  }
+  return false;
+}
+
 void task_thread_pool::worker_t::run_thread()
 {
+  current_worker = this;
+
   // main loop
   task_t task;
-  while (wait_task(&task)) {
+  while (wait_task(task)) {
     task();
   }
 
-  // on exit, notify pool class
-  std::unique_lock<std::mutex> lock(parent->queue_mutex);
-  running = false;
+  current_worker = nullptr;
 }
 
 task_worker::task_worker(std::string thread_name_,
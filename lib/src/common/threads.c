@@ -23,6 +23,7 @@
 #include <pthread.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
 
@@ -47,13 +48,17 @@ bool threads_new_rt_mask(pthread_t* thread, void* (*start_routine)(void*), void*
                             prio_offset); // we multiply mask by 100 to distinguish it from a single cpu core id
 }
 
-bool threads_new_rt_cpu(pthread_t* thread, void* (*start_routine)(void*), void* arg, int cpu, int prio_offset)
+/* Creates the thread with the priority given by prio_offset and, if cpuset is not NULL, bound to its CPUs */
+static bool threads_new_rt_cpuset(pthread_t* thread,
+                                  void* (*start_routine)(void*),
+                                  void*            arg,
+                                  const cpu_set_t* cpuset,
+                                  int              prio_offset)
 {
   bool ret = false;
 
   pthread_attr_t     attr;
   struct sched_param param;
-  cpu_set_t          cpuset;
   bool               attr_enable = false;
 
 #ifdef PER_THREAD_PRIO
@@ -126,23 +131,8 @@ bool threads_new_rt_cpu(pthread_t* thread, void* (*start_routine)(void*), void*
       fprintf(stderr, "Error not enough privileges to set Scheduling priority\n");
     }
   }
-  if (cpu > 0) {
-    if (cpu > 50) {
-      uint32_t mask;
-      mask = cpu / 100;
-
-      CPU_ZERO(&cpuset);
-      for (uint32_t i = 0; i < 8; i++) {
-        if (((mask >> i) & 0x01U) == 1U) {
-          CPU_SET((size_t)i, &cpuset);
-        }
-      }
-    } else {
-      CPU_ZERO(&cpuset);
-      CPU_SET((size_t)cpu, &cpuset);
-    }
-
-    if (pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &cpuset)) {
+  if (cpuset != NULL) {
+    if (pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), cpuset)) {
       perror("pthread_attr_setaffinity_np");
     }
   }
@@ -176,6 +166,128 @@ bool threads_new_rt_cpu(pthread_t* thread, void* (*start_routine)(void*), void*
   return ret;
 }
 
+bool threads_new_rt_cpu(pthread_t* thread, void* (*start_routine)(void*), void* arg, int cpu, int prio_offset)
+{
+  cpu_set_t cpuset;
+
+  if (cpu <= 0) {
+    return threads_new_rt_cpuset(thread, start_routine, arg, NULL, prio_offset);
+  }
+
+  if (cpu > 50) {
+    uint32_t mask;
+    mask = cpu / 100;
+
+    CPU_ZERO(&cpuset);
+    for (uint32_t i = 0; i < 8; i++) {
+      if (((mask >> i) & 0x01U) == 1U) {
+        CPU_SET((size_t)i, &cpuset);
+      }
+    }
+  } else {
+    CPU_ZERO(&cpuset);
+    CPU_SET((size_t)cpu, &cpuset);
+  }
+
+  return threads_new_rt_cpuset(thread, start_routine, arg, &cpuset, prio_offset);
+}
+
+int threads_parse_cpu_list(const char* cpu_list, uint32_t* cpus, uint32_t max_cpus)
+{
+  uint32_t    nof_cpus = 0;
+  const char* ptr      = cpu_list;
+
+  if (cpu_list == NULL) {
+    return -1;
+  }
+
+  // Same syntax as the isolcpus kernel parameter, comma separated CPUs or ranges of CPUs, e.g. "2,4-7"
+  while (*ptr != '\0') {
+    char*         end   = NULL;
+    unsigned long first = strtoul(ptr, &end, 10);
+    unsigned long last  = first;
+    if (end == ptr) {
+      return -1;
+    }
+    ptr = end;
+    if (*ptr == '-') {
+      ptr++;
+      last = strtoul(ptr, &end, 10);
+      if (end == ptr || last < first) {
+        return -1;
+      }
+      ptr = end;
+    }
+    if (last >= CPU_SETSIZE) {
+      return -1;
+    }
+    for (unsigned long cpu = first; cpu <= last; cpu++) {
+      if (nof_cpus == max_cpus) {
+        return -1;
+      }
+      cpus[nof_cpus++] = (uint32_t)cpu;
+    }
+    if (*ptr == ',') {
+      ptr++;
+    } else if (*ptr != '\0') {
+      return -1;
+    }
+  }
+
+  return (int)nof_cpus;
+}
+
+bool threads_new_rt_cpu_list(pthread_t* thread,
+                             void* (*start_routine)(void*),
+                             void*       arg,
+                             const char* cpu_list,
+                             int         prio_offset)
+{
+  uint32_t  cpus[CPU_SETSIZE];
+  cpu_set_t cpuset;
+
+  int nof_cpus = threads_parse_cpu_list(cpu_list, cpus, CPU_SETSIZE);
+  if (nof_cpus < 0) {
+    fprintf(stderr, "Error: invalid CPU list '%s'\n", cpu_list);
+    return false;
+  }
+  if (nof_cpus == 0) {
+    return threads_new_rt_cpuset(thread, start_routine, arg, NULL, prio_offset);
+  }
+
+  CPU_ZERO(&cpuset);
+  for (int i = 0; i < nof_cpus; i++) {
+    CPU_SET((size_t)cpus[i], &cpuset);
+  }
+
+  return threads_new_rt_cpuset(thread, start_routine, arg, &cpuset, prio_offset);
+}
+
+bool threads_set_self_cpu_list(const char* cpu_list)
+{
+  uint32_t  cpus[CPU_SETSIZE];
+  cpu_set_t cpuset;
+
+  int nof_cpus = threads_parse_cpu_list(cpu_list, cpus, CPU_SETSIZE);
+  if (nof_cpus < 0) {
+    fprintf(stderr, "Error: invalid CPU list '%s'\n", cpu_list);
+    return false;
+  }
+  if (nof_cpus == 0) {
+    return true;
+  }
+
+  CPU_ZERO(&cpuset);
+  for (int i = 0; i < nof_cpus; i++) {
+    CPU_SET((size_t)cpus[i], &cpuset);
+  }
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset)) {
+    perror("pthread_setaffinity_np");
+    return false;
+  }
+  return true;
+}
+
 void threads_print_self()
 {
   pthread_t          thread;
@@ -105,7 +105,7 @@ int32_t mac_sch_subpdu_nr::read_subheader(const uint8_t* ptr)
   return header_length;
 }
 
-void mac_sch_subpdu_nr::set_sdu(const uint32_t lcid_, const uint8_t* payload_, const uint32_t len_)
+void mac_sch_subpdu_nr::set_sdu(const uint32_t lcid_, const uint8_t* payload_, const uint32_t len_, bool long_len_field)
 {
   // Use CCCH_SIZE_48 when SDU len fits
   lcid = (lcid_ == CCCH_SIZE_64 && len_ == sizeof_ce(CCCH_SIZE_48, true)) ? CCCH_SIZE_48 : lcid_;
@@ -120,7 +120,8 @@ void mac_sch_subpdu_nr::set_sdu(const uint32_t lcid_, const uint8_t* payload_, c
     }
   }
 
-  if (sdu_length >= MAC_SUBHEADER_LEN_THRESHOLD) {
+  // The 16-bit L field may also be used for short SDUs, e.g. when the subheader was reserved before the SDU was written
+  if (header_length == 2 && (sdu_length >= MAC_SUBHEADER_LEN_THRESHOLD || long_len_field)) {
     F_bit = true;
     header_length += 1;
   }
@@ -183,9 +184,9 @@ void mac_sch_subpdu_nr::set_ue_con_res_id_ce(const mac_sch_subpdu_nr::ue_con_res
 }
 
 // Section 6.1.2
-uint32_t mac_sch_subpdu_nr::write_subpdu(const uint8_t* start_)
+uint32_t mac_sch_subpdu_nr::write_subheader(uint8_t* start_)
 {
-  uint8_t* ptr = const_cast<uint8_t*>(start_);
+  uint8_t* ptr = start_;
   *ptr         = (uint8_t)((F_bit ? 1 : 0) << 6) | ((uint8_t)lcid & 0x3f);
   ptr += 1;
 
@@ -206,6 +207,14 @@ uint32_t mac_sch_subpdu_nr::write_subpdu(const uint8_t* start_)
     logger->error("Error while packing PDU. Unsupported header length (%d)", header_length);
   }
 
+  return ptr - start_;
+}
+
+uint32_t mac_sch_subpdu_nr::write_subpdu(const uint8_t* start_)
+{
+  uint8_t* ptr = const_cast<uint8_t*>(start_);
+  ptr += write_subheader(ptr);
+
   // copy SDU payload
   if (sdu) {
     memcpy(ptr, sdu.ptr(), sdu_length);
@@ -572,6 +581,37 @@ uint32_t mac_sch_pdu_nr::add_sdu(const uint32_t lcid_, const uint8_t* payload_,
   return add_sudpdu(sch_pdu);
 }
 
+int mac_sch_pdu_nr::add_sdu(const uint32_t lcid_, const uint32_t requested_bytes_, read_pdu_interface* sdu_itf_)
+{
+  // The subheader is sized for the requested bytes and is kept as such when the SDU turns out shorter
+  uint32_t header_size = size_header_sdu(lcid_, requested_bytes_);
+  if (header_size >= remaining_len) {
+    logger.warning("Not enough space to add SDU to PDU (%d >= %d)", header_size, remaining_len);
+    return SRSRAN_ERROR;
+  }
+  uint32_t max_sdu_len = std::min(requested_bytes_, remaining_len - header_size);
+
+  uint8_t* subpdu_ptr = buffer->msg + buffer->N_bytes;
+  int      sdu_len    = sdu_itf_->read_pdu(lcid_, subpdu_ptr + header_size, max_sdu_len);
+  if (sdu_len <= 0) {
+    return sdu_len < 0 ? SRSRAN_ERROR : 0;
+  }
+  if (sdu_len > (int)max_sdu_len) {
+    logger.error("Header and SDU exceed space in PDU (%d + %d > %d)", header_size, sdu_len, remaining_len);
+    return SRSRAN_ERROR;
+  }
+
+  mac_sch_subpdu_nr sch_pdu(this);
+  sch_pdu.set_sdu(lcid_, subpdu_ptr + header_size, sdu_len, header_size == 3);
+  sch_pdu.write_subheader(subpdu_ptr);
+
+  buffer->N_bytes += sch_pdu.get_total_length();
+  remaining_len -= sch_pdu.get_total_length();
+  subpdus.push_back(sch_pdu);
+
+  return sdu_len;
+}
+
 uint32_t mac_sch_pdu_nr::add_crnti_ce(const uint16_t crnti)
 {
   mac_sch_subpdu_nr ce(this);
@@ -92,6 +92,15 @@ bool pdcp::is_lcid_enabled(uint32_t lcid)
   return valid_lcids_cached.count(lcid) > 0;
 }
 
+// The DRBs added afterwards also use the crypto workers
+void pdcp::set_crypto_workers(task_thread_pool* workers)
+{
+  crypto_workers = workers;
+  for (auto& lcid_it : pdcp_array) {
+    lcid_it.second->set_crypto_workers(crypto_workers);
+  }
+}
+
 void pdcp::write_sdu(uint32_t lcid, unique_byte_buffer_t sdu, int sn)
 {
   if (valid_lcid(lcid)) {
@@ -101,6 +110,15 @@ void pdcp::write_sdu(uint32_t lcid, unique_byte_buffer_t sdu, int sn)
   }
 }
 
+void pdcp::write_sdus(uint32_t lcid, span<unique_byte_buffer_t> sdus)
+{
+  if (valid_lcid(lcid)) {
+    pdcp_array.at(lcid)->write_sdus(sdus);
+  } else {
+    logger.warning("LCID %d doesn't exist. Deallocating %zd SDUs", lcid, sdus.size());
+  }
+}
+
 void pdcp::write_sdu_mch(uint32_t lcid, unique_byte_buffer_t sdu)
 {
   if (valid_mch_lcid(lcid)) {
@@ -127,6 +145,7 @@ int pdcp::add_bearer(uint32_t lcid, const pdcp_config_t& cfg)
     logger.error("Can not configure PDCP entity");
     return SRSRAN_ERROR;
   }
+  entity->set_crypto_workers(crypto_workers);
 
   if (not pdcp_array.insert(std::make_pair(lcid, std::move(entity))).second) {
     logger.error("Error inserting PDCP entity in to array.");
@@ -274,7 +293,7 @@ bool pdcp::set_bearer_state(uint32_t lcid, const srsran::pdcp_lte_state_t& state
   return true;
 }
 
-std::map<uint32_t, srsran::unique_byte_buffer_t> pdcp::get_buffered_pdus(uint32_t lcid)
+srsran::pdcp_sdu_list_t pdcp::get_buffered_pdus(uint32_t lcid)
 {
   if (not valid_lcid(lcid)) {
     return {};
@@ -294,6 +313,15 @@ void pdcp::write_pdu(uint32_t lcid, unique_byte_buffer_t pdu)
   }
 }
 
+void pdcp::write_pdus(uint32_t lcid, span<unique_byte_buffer_t> pdus)
+{
+  if (valid_lcid(lcid)) {
+    pdcp_array.at(lcid)->write_pdus(pdus);
+  } else {
+    logger.warning("Dropping %zd PDUs, lcid=%d doesnt exists", pdus.size(), lcid);
+  }
+}
+
 void pdcp::write_pdu_bcch_bch(unique_byte_buffer_t sdu)
 {
   rrc->write_pdu_bcch_bch(std::move(sdu));
@@ -30,11 +30,39 @@ pdcp_entity_base::pdcp_entity_base(task_sched_handle task_sched_, srslog::basic_
   logger(logger), task_sched(task_sched_)
 {}
 
-pdcp_entity_base::~pdcp_entity_base() {}
+pdcp_entity_base::~pdcp_entity_base()
+{
+  // The crypto workers may still be using the entity
+  discard_tx_crypto_jobs();
+  if (tx_crypto_owner != nullptr) {
+    tx_crypto_owner->entity = nullptr;
+  }
+}
+
+void pdcp_entity_base::set_crypto_workers(task_thread_pool* workers)
+{
+  static std::atomic<uint32_t> next_affinity{0};
+
+  crypto_workers = workers;
+  if (crypto_workers != nullptr and tx_crypto_owner == nullptr) {
+    tx_crypto_owner = std::make_shared<tx_crypto_owner_t>(tx_crypto_owner_t{this, task_sched});
+    crypto_affinity = next_affinity.fetch_add(1, std::memory_order_relaxed);
+  }
+}
 
 void pdcp_entity_base::config_security(const as_security_config_t& sec_cfg_)
 {
-  sec_cfg = sec_cfg_;
+  std::shared_ptr<security_ctx_t> new_sec = std::make_shared<security_ctx_t>();
+  as_security_config_t&           sec_cfg = new_sec->sec_cfg;
+  sec_cfg                                 = sec_cfg_;
+
+  if (sec_cfg.integ_algo == INTEGRITY_ALGORITHM_ID_128_EIA2) {
+    new_sec->int_aes_key.set_key(is_srb() ? &sec_cfg.k_rrc_int[16] : &sec_cfg.k_up_int[16]);
+  }
+  if (sec_cfg.cipher_algo == CIPHERING_ALGORITHM_ID_128_EEA2) {
+    new_sec->enc_aes_key.set_key(is_srb() ? &sec_cfg.k_rrc_enc[16] : &sec_cfg.k_up_enc[16]);
+  }
+  sec = std::move(new_sec);
 
   logger.info("Configuring security with %s and %s",
               integrity_algorithm_id_text[sec_cfg.integ_algo],
@@ -49,9 +77,14 @@ void pdcp_entity_base::config_security(const as_security_config_t& sec_cfg_)
 /****************************************************************************
  * Security functions
  ***************************************************************************/
-void pdcp_entity_base::integrity_generate(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac)
+void pdcp_entity_base::integrity_generate(const security_ctx_t& ctx,
+                                          uint8_t*              msg,
+                                          uint32_t              msg_len,
+                                          uint32_t              count,
+                                          uint8_t*              mac)
 {
-  uint8_t* k_int;
+  const as_security_config_t& sec_cfg = ctx.sec_cfg;
+  const uint8_t*              k_int;
 
   // If control plane use RRC integrity key. If data use user plane key
   if (is_srb()) {
@@ -67,7 +100,7 @@ void pdcp_entity_base::integrity_generate(uint8_t* msg, uint32_t msg_len, uint32
       security_128_eia1(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA2:
-      security_128_eia2(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
+      security_128_eia2(ctx.int_aes_key, count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA3:
       security_128_eia3(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
@@ -87,9 +120,10 @@ void pdcp_entity_base::integrity_generate(uint8_t* msg, uint32_t msg_len, uint32
 
 bool pdcp_entity_base::integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac)
 {
-  uint8_t  mac_exp[4] = {};
-  bool     is_valid   = true;
-  uint8_t* k_int;
+  const as_security_config_t& sec_cfg    = sec->sec_cfg;
+  uint8_t                     mac_exp[4] = {};
+  bool                        is_valid   = true;
+  const uint8_t*              k_int;
 
   // If control plane use RRC integrity key. If data use user plane key
   if (is_srb()) {
@@ -105,7 +139,7 @@ bool pdcp_entity_base::integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t
       security_128_eia1(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA2:
-      security_128_eia2(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
+      security_128_eia2(sec->int_aes_key, count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA3:
       security_128_eia3(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
@@ -135,23 +169,24 @@ bool pdcp_entity_base::integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t
   return is_valid;
 }
 
-void pdcp_entity_base::cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* ct)
+void pdcp_entity_base::cipher_encrypt(const security_ctx_t& ctx,
+                                      uint8_t*              msg,
+                                      uint32_t              msg_len,
+                                      uint32_t              count,
+                                      uint8_t*              ct)
 {
-  uint8_t* k_enc;
-  uint8_t  ct_tmp[PDCP_MAX_SDU_SIZE];
+  const as_security_config_t& sec_cfg = ctx.sec_cfg;
+  uint8_t                     ct_tmp[PDCP_MAX_SDU_SIZE];
 
   // If control plane use RRC encrytion key. If data use user plane key
-  if (is_srb()) {
-    k_enc = sec_cfg.k_rrc_enc.data();
-  } else {
-    k_enc = sec_cfg.k_up_enc.data();
-  }
+  // The key is copied, as EEA1/EEA3 take it non-const
+  as_key_t k_enc = is_srb() ? sec_cfg.k_rrc_enc : sec_cfg.k_up_enc;
 
   logger.debug("Cipher encrypt input: COUNT: %" PRIu32 ", Bearer ID: %d, Direction %s",
                count,
                cfg.bearer_id,
                cfg.tx_direction == SECURITY_DIRECTION_DOWNLINK ? "Downlink" : "Uplink");
-  logger.debug(k_enc, 32, "Cipher encrypt key:");
+  logger.debug(k_enc.data(), 32, "Cipher encrypt key:");
   logger.debug(msg, msg_len, "Cipher encrypt input msg");
 
   switch (sec_cfg.cipher_algo) {
@@ -162,8 +197,7 @@ void pdcp_entity_base::cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t c
       memcpy(ct, ct_tmp, msg_len);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA2:
-      security_128_eea2(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
-      memcpy(ct, ct_tmp, msg_len);
+      security_128_eea2(ctx.enc_aes_key, count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA3:
       security_128_eea3(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
@@ -177,21 +211,18 @@ void pdcp_entity_base::cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t c
 
 void pdcp_entity_base::cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t count, uint8_t* msg)
 {
-  uint8_t* k_enc;
-  uint8_t  msg_tmp[PDCP_MAX_SDU_SIZE];
+  const as_security_config_t& sec_cfg = sec->sec_cfg;
+  uint8_t                     msg_tmp[PDCP_MAX_SDU_SIZE];
 
   // If control plane use RRC encrytion key. If data use user plane key
-  if (is_srb()) {
-    k_enc = sec_cfg.k_rrc_enc.data();
-  } else {
-    k_enc = sec_cfg.k_up_enc.data();
-  }
+  // The key is copied, as EEA1/EEA3 take it non-const
+  as_key_t k_enc = is_srb() ? sec_cfg.k_rrc_enc : sec_cfg.k_up_enc;
 
   logger.debug("Cipher decrypt input: COUNT: %" PRIu32 ", Bearer ID: %d, Direction %s",
                count,
                cfg.bearer_id,
                (cfg.rx_direction == SECURITY_DIRECTION_DOWNLINK) ? "Downlink" : "Uplink");
-  logger.debug(k_enc, 32, "Cipher decrypt key:");
+  logger.debug(k_enc.data(), 32, "Cipher decrypt key:");
   logger.debug(ct, ct_len, "Cipher decrypt input msg");
 
   switch (sec_cfg.cipher_algo) {
@@ -202,8 +233,7 @@ void pdcp_entity_base::cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t cou
       memcpy(msg, msg_tmp, ct_len);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA2:
-      security_128_eea2(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
-      memcpy(msg, msg_tmp, ct_len);
+      security_128_eea2(sec->enc_aes_key, count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA3:
       security_128_eea3(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
@@ -215,6 +245,85 @@ void pdcp_entity_base::cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t cou
   logger.debug(msg, ct_len, "Cipher decrypt output msg");
 }
 
+/****************************************************************************
+ * Asynchronous TX security
+ ***************************************************************************/
+
+void pdcp_entity_base::submit_tx_pdu(unique_byte_buffer_t pdu, uint32_t count, bool do_integrity, bool do_encryption)
+{
+  std::shared_ptr<tx_crypto_job_t> job = std::make_shared<tx_crypto_job_t>();
+  job->pdu                             = std::move(pdu);
+  job->count                           = count;
+  job->do_integrity                    = do_integrity;
+  job->do_encryption                   = do_encryption;
+  job->sec                             = sec;
+  tx_crypto_jobs.push_back(job);
+
+  crypto_workers->push_task(crypto_affinity, [owner = tx_crypto_owner, job]() {
+    owner->entity->apply_tx_security(*job);
+    job->done.store(true, std::memory_order_release);
+    owner->task_sched.notify_background_task_result([owner]() {
+      if (owner->entity != nullptr) {
+        owner->entity->flush_tx_crypto_jobs(false);
+      }
+    });
+  });
+}
+
+void pdcp_entity_base::apply_tx_security(tx_crypto_job_t& job)
+{
+  unique_byte_buffer_t& pdu = job.pdu;
+  if (job.do_integrity) {
+    uint8_t mac[4] = {};
+    integrity_generate(*job.sec, pdu->msg, pdu->N_bytes, job.count, mac);
+    append_mac(pdu, mac);
+  }
+  if (job.do_encryption) {
+    cipher_encrypt(*job.sec,
+                   &pdu->msg[cfg.hdr_len_bytes],
+                   pdu->N_bytes - cfg.hdr_len_bytes,
+                   job.count,
+                   &pdu->msg[cfg.hdr_len_bytes]);
+  }
+}
+
+void pdcp_entity_base::flush_tx_crypto_jobs(bool wait)
+{
+  // The PDUs leave in submission order, so a PDU waits for the ones with a lower COUNT
+  while (not tx_crypto_jobs.empty()) {
+    tx_crypto_job_t& job = *tx_crypto_jobs.front();
+    if (not job.done.load(std::memory_order_acquire)) {
+      if (not wait) {
+        return;
+      }
+      std::this_thread::yield();
+      continue;
+    }
+    logger.info(job.pdu->msg,
+                job.pdu->N_bytes,
+                "TX %s PDU (%dB), HFN=%d, SN=%d, integrity=%s, encryption=%s",
+                rb_name.c_str(),
+                job.pdu->N_bytes,
+                HFN(job.count),
+                SN(job.count),
+                srsran_direction_text[integrity_direction],
+                srsran_direction_text[encryption_direction]);
+    unique_byte_buffer_t pdu = std::move(job.pdu);
+    tx_crypto_jobs.pop_front();
+    pass_to_lower_layers(std::move(pdu));
+  }
+}
+
+void pdcp_entity_base::discard_tx_crypto_jobs()
+{
+  for (const std::shared_ptr<tx_crypto_job_t>& job : tx_crypto_jobs) {
+    while (not job->done.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+  }
+  tx_crypto_jobs.clear();
+}
+
 /****************************************************************************
  * Common pack functions
  ***************************************************************************/
@@ -131,6 +131,8 @@ void pdcp_entity_lte::reestablish()
   } else {
     // Sending the status report will be triggered by the RRC if required
   }
+  // The PDUs built before the re-establishment are handed to RLC first
+  flush_tx_crypto_jobs(true);
 }
 
 // Used to stop/pause the entity (called on RRC conn release)
@@ -140,24 +142,63 @@ void pdcp_entity_lte::reset()
     logger.debug("Reset %s", rb_name.c_str());
   }
   active = false;
+  discard_tx_crypto_jobs();
 }
 
 // GW/RRC interface
 void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
+{
+  if (not can_tx_sdus()) {
+    return;
+  }
+  if (build_tx_pdu(sdu, upper_sn)) {
+    rlc->write_sdu(lcid, std::move(sdu));
+  }
+}
+
+void pdcp_entity_lte::write_sdus(span<unique_byte_buffer_t> sdus)
+{
+  if (not can_tx_sdus()) {
+    return;
+  }
+
+  // The PDUs are built in place and handed to RLC in one call, without the dropped SDUs
+  size_t nof_pdus = 0;
+  for (size_t i = 0; i < sdus.size(); ++i) {
+    if (not build_tx_pdu(sdus[i], -1)) {
+      continue;
+    }
+    if (i != nof_pdus) {
+      sdus[nof_pdus] = std::move(sdus[i]);
+    }
+    nof_pdus++;
+  }
+  if (nof_pdus > 0) {
+    rlc->write_sdus(lcid, sdus.first(nof_pdus));
+  }
+}
+
+bool pdcp_entity_lte::can_tx_sdus()
 {
   if (!active) {
     logger.warning("Dropping %s SDU due to inactive bearer", rb_name.c_str());
-    return;
+    return false;
   }
 
   if (rlc->is_suspended(lcid)) {
     logger.warning("Trying to send SDU while re-establishment is in progress. Dropping SDU. LCID=%d", lcid);
-    return;
+    return false;
   }
+  return true;
+}
 
+// Turns the SDU into a PDU and updates the TX state. Returns false if the SDU has to be dropped or if it was handed to
+// the crypto workers, which pass it to lower layers once ciphered
+bool pdcp_entity_lte::build_tx_pdu(unique_byte_buffer_t& sdu, int upper_sn)
+{
   if (rlc->sdu_queue_is_full(lcid)) {
     logger.info(sdu->msg, sdu->N_bytes, "Dropping %s SDU due to full queue", rb_name.c_str());
-    return;
+    return false;
   }
 
   // Get COUNT to be used with this packet
@@ -179,7 +220,7 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
     if (not store_sdu(used_sn, sdu)) {
       // Could not store the SDU, discarding
       logger.warning("Could not store SDU. Discarding SN=%d", used_sn);
-      return;
+      return false;
     }
   }
   // check for pending security config in transmit direction
@@ -202,19 +243,6 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
     append_mac(sdu, mac);
   }
 
-  if (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX) {
-    cipher_encrypt(
-        &sdu->msg[cfg.hdr_len_bytes], sdu->N_bytes - cfg.hdr_len_bytes, tx_count, &sdu->msg[cfg.hdr_len_bytes]);
-  }
-
-  logger.info(sdu->msg,
-              sdu->N_bytes,
-              "TX %s PDU, SN=%d, integrity=%s, encryption=%s",
-              rb_name.c_str(),
-              used_sn,
-              srsran_direction_text[integrity_direction],
-              srsran_direction_text[encryption_direction]);
-
   // Set SDU metadata for RLC AM
   sdu->md.pdcp_sn = used_sn;
 
@@ -227,14 +255,36 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
     }
   }
 
-  // Pass PDU to lower layers
   metrics.num_tx_pdus++;
   metrics.num_tx_pdu_bytes += sdu->N_bytes;
   // Count TX'd bytes as if they were ACK'd if RLC is UM
   if (rlc->rb_is_um(lcid)) {
     metrics.num_tx_acked_bytes = metrics.num_tx_pdu_bytes;
   }
-  rlc->write_sdu(lcid, std::move(sdu));
+
+  bool do_encryption = encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX;
+  if (tx_crypto_offload()) {
+    submit_tx_pdu(std::move(sdu), tx_count, false, do_encryption);
+    return false;
+  }
+  if (do_encryption) {
+    cipher_encrypt(
+        &sdu->msg[cfg.hdr_len_bytes], sdu->N_bytes - cfg.hdr_len_bytes, tx_count, &sdu->msg[cfg.hdr_len_bytes]);
+  }
+
+  logger.info(sdu->msg,
+              sdu->N_bytes,
+              "TX %s PDU, SN=%d, integrity=%s, encryption=%s",
+              rb_name.c_str(),
+              used_sn,
+              srsran_direction_text[integrity_direction],
+              srsran_direction_text[encryption_direction]);
+  return true;
+}
+
+void pdcp_entity_lte::pass_to_lower_layers(unique_byte_buffer_t pdu)
+{
+  rlc->write_sdu(lcid, std::move(pdu));
 }
 
 // RLC interface
@@ -390,6 +440,7 @@ void pdcp_entity_lte::handle_um_drb_pdu(srsran::unique_byte_buffer_t pdu)
   }
 
   // Pass to upper layers
+  account_rx_latency(pdu);
   gw->write_pdu(lcid, std::move(pdu));
 }
 
@@ -454,6 +505,7 @@ void pdcp_entity_lte::handle_am_drb_pdu(srsran::unique_byte_buffer_t pdu)
   update_rx_counts_queue(count);
 
   // Pass to upper layers
+  account_rx_latency(pdu);
   gw->write_pdu(lcid, std::move(pdu));
 }
 
@@ -840,11 +892,11 @@ void pdcp_entity_lte::set_bearer_state(const pdcp_lte_state_t& state, bool set_f
   }
 }
 
-std::map<uint32_t, srsran::unique_byte_buffer_t> pdcp_entity_lte::get_buffered_pdus()
+srsran::pdcp_sdu_list_t pdcp_entity_lte::get_buffered_pdus()
 {
   if (undelivered_sdus == nullptr) {
     logger.error("Buffered PDUs being requested for non-AM DRB");
-    return std::map<uint32_t, srsran::unique_byte_buffer_t>{};
+    return srsran::pdcp_sdu_list_t{};
   }
   logger.info("Buffered PDUs requested, buffer_size=%zu", undelivered_sdus->size());
   return undelivered_sdus->get_buffered_sdus();
@@ -868,6 +920,7 @@ void pdcp_entity_lte::reset_metrics()
 {
   // Only reset metrics that have are snapshots, leave the incremental ones untouched.
   metrics.tx_notification_latency_ms = 0;
+  std::fill(std::begin(metrics.rx_latency_hist), std::end(metrics.rx_latency_hist), 0);
 }
 
 /****************************************************************************
@@ -875,8 +928,8 @@ void pdcp_entity_lte::reset_metrics()
  ***************************************************************************/
 undelivered_sdus_queue::undelivered_sdus_queue(srsran::task_sched_handle task_sched, uint32_t sn_mod) : sn_mod(sn_mod)
 {
-  for (auto& e : sdus) {
-    e.discard_timer = task_sched.get_unique_timer();
+  for (auto& t : discard_timers) {
+    t = task_sched.get_unique_timer();
   }
 }
 
@@ -916,16 +969,15 @@ bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
     update_lms(sn);
   }
   // Add SDU
-  count++;
-  sdus[sn].sdu             = std::move(tmp);
-  sdus[sn].sdu->md.pdcp_sn = sn;
-  sdus[sn].sdu->N_bytes    = sdu->N_bytes;
-  memcpy(sdus[sn].sdu->msg, sdu->msg, sdu->N_bytes);
+  tmp->md.pdcp_sn = sn;
+  tmp->N_bytes    = sdu->N_bytes;
+  memcpy(tmp->msg, sdu->msg, sdu->N_bytes);
+  tmp->set_timestamp(); // Metrics
+  sdus.insert(sn, std::move(tmp));
   if (discard_timeout > 0) {
-    sdus[sn].discard_timer.set(discard_timeout, std::move(callback));
-    sdus[sn].discard_timer.run();
+    discard_timers[sn].set(discard_timeout, std::move(callback));
+    discard_timers[sn].run();
   }
-  sdus[sn].sdu->set_timestamp(); // Metrics
   bytes += sdu->N_bytes;
   return true;
 }
@@ -935,10 +987,9 @@ bool undelivered_sdus_queue::clear_sdu(uint32_t sn)
   if (not has_sdu(sn)) {
     return false;
   }
-  count--;
-  bytes -= sdus[sn].sdu->N_bytes;
-  sdus[sn].discard_timer.stop();
-  sdus[sn].sdu.reset();
+  bytes -= sdus[sn]->N_bytes;
+  discard_timers[sn].stop();
+  sdus.erase(sn);
   // Find next FMS, if necessary
   if (sn == fms) {
     update_fms();
@@ -948,20 +999,23 @@ bool undelivered_sdus_queue::clear_sdu(uint32_t sn)
 
 void undelivered_sdus_queue::clear()
 {
-  count = 0;
   bytes = 0;
   fms   = 0;
-  for (uint32_t sn = 0; sn < capacity; sn++) {
-    sdus[sn].discard_timer.stop();
-    sdus[sn].sdu.reset();
+  sdus.clear();
+  for (auto& t : discard_timers) {
+    t.stop();
   }
 }
 
 size_t undelivered_sdus_queue::nof_discard_timers() const
 {
-  return std::count_if(sdus.begin(), sdus.end(), [](const sdu_data& s) {
-    return s.sdu != nullptr and s.discard_timer.is_valid() and s.discard_timer.is_running();
+  size_t nof_timers = 0;
+  sdus.for_each([this, &nof_timers](uint32_t sn, const unique_byte_buffer_t& sdu) {
+    if (discard_timers[sn].is_valid() and discard_timers[sn].is_running()) {
+      nof_timers++;
+    }
   });
+  return nof_timers;
 }
 
 void undelivered_sdus_queue::update_fms()
@@ -997,20 +1051,25 @@ void undelivered_sdus_queue::update_lms(uint32_t sn)
   }
 }
 
-std::map<uint32_t, srsran::unique_byte_buffer_t> undelivered_sdus_queue::get_buffered_sdus()
+srsran::pdcp_sdu_list_t undelivered_sdus_queue::get_buffered_sdus()
 {
-  std::map<uint32_t, srsran::unique_byte_buffer_t> fwd_sdus;
-  for (auto& sdu : sdus) {
-    if (sdu.sdu != nullptr) {
-      // TODO: Find ways to avoid deep copy
-      srsran::unique_byte_buffer_t fwd_sdu = make_byte_buffer();
-      if (fwd_sdu != nullptr) {
-        *fwd_sdu = *sdu.sdu;
-        fwd_sdus.emplace(sdu.sdu->md.pdcp_sn, std::move(fwd_sdu));
-      } else {
-        srslog::fetch_basic_logger("PDCP").warning("Can't allocate buffer to forward buffered SDUs.");
-      }
+  srsran::pdcp_sdu_list_t fwd_sdus;
+  fwd_sdus.reserve(sdus.size());
+
+  // Walk the SNs from the first missing one, so that the SDUs are forwarded in transmission order
+  uint32_t sn = fms;
+  for (uint32_t i = 0; i < sn_mod and fwd_sdus.size() < sdus.size(); ++i, sn = increment_sn(sn)) {
+    if (not sdus.contains(sn)) {
+      continue;
+    }
+    // TODO: Find ways to avoid deep copy
+    srsran::unique_byte_buffer_t fwd_sdu = make_byte_buffer();
+    if (fwd_sdu == nullptr) {
+      srslog::fetch_basic_logger("PDCP").warning("Can't allocate buffer to forward buffered SDUs.");
+      break;
     }
+    *fwd_sdu = *sdus[sn];
+    fwd_sdus.emplace_back(sn, std::move(fwd_sdu));
   }
   return fwd_sdus;
 }
@@ -55,6 +55,7 @@ bool pdcp_entity_nr::configure(const pdcp_config_t& cnfg_)
   cfg         = cnfg_;
   rb_name     = cfg.get_rb_name();
   window_size = 1 << (cfg.sn_len - 1);
+  reorder_queue.set_size(window_size);
 
   rlc_mode = rlc->rb_is_um(lcid) ? rlc_mode_t::UM : rlc_mode_t::AM;
 
@@ -89,6 +90,7 @@ bool pdcp_entity_nr::configure(const pdcp_config_t& cnfg_)
 void pdcp_entity_nr::reestablish()
 {
   logger.info("Re-establish %s with bearer ID: %d", rb_name.c_str(), cfg.bearer_id);
+  flush_tx_crypto_jobs(true);
   // TODO
 }
 
@@ -96,11 +98,41 @@ void pdcp_entity_nr::reestablish()
 void pdcp_entity_nr::reset()
 {
   active = false;
+  discard_tx_crypto_jobs();
   logger.debug("Reset %s", rb_name.c_str());
 }
 
 // SDAP/RRC interface
 void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
+{
+  if (build_tx_pdu(sdu)) {
+    // Check if PDCP is associated with more than on RLC entity TODO
+    // Write to lower layers
+    rlc->write_sdu(lcid, std::move(sdu));
+  }
+}
+
+void pdcp_entity_nr::write_sdus(span<unique_byte_buffer_t> sdus)
+{
+  // The PDUs are built in place and handed to RLC in one call, without the dropped SDUs
+  size_t nof_pdus = 0;
+  for (size_t i = 0; i < sdus.size(); ++i) {
+    if (not build_tx_pdu(sdus[i])) {
+      continue;
+    }
+    if (i != nof_pdus) {
+      sdus[nof_pdus] = std::move(sdus[i]);
+    }
+    nof_pdus++;
+  }
+  if (nof_pdus > 0) {
+    rlc->write_sdus(lcid, sdus.first(nof_pdus));
+  }
+}
+
+// Turns the SDU into a PDU and increments TX_NEXT. Returns false if the SDU has to be dropped or if it was handed to the
+// crypto workers, which pass it to lower layers once protected
+bool pdcp_entity_nr::build_tx_pdu(unique_byte_buffer_t& sdu)
 {
   // Log SDU
   logger.info(sdu->msg,
@@ -113,13 +145,13 @@ void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
 
   if (rlc->sdu_queue_is_full(lcid)) {
     logger.info(sdu->msg, sdu->N_bytes, "Dropping %s SDU due to full queue", rb_name.c_str());
-    return;
+    return false;
   }
 
   // Check for COUNT overflow
   if (tx_overflow) {
     logger.warning("TX_NEXT has overflowed. Dropping packet");
-    return;
+    return false;
   }
   if (tx_next + 1 == 0) {
     tx_overflow = true;
@@ -140,15 +172,25 @@ void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
   // Write PDCP header info
   write_data_header(sdu, tx_next);
 
+  // Set meta-data for RLC AM
+  sdu->md.pdcp_sn = tx_next;
+
+  bool do_integrity =
+      is_srb() || (is_drb() && (integrity_direction == DIRECTION_TX || integrity_direction == DIRECTION_TXRX));
+  bool do_encryption = encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX;
+  if (tx_crypto_offload()) {
+    submit_tx_pdu(std::move(sdu), tx_next, do_integrity, do_encryption);
+    tx_next++;
+    return false;
+  }
+
   // TS 38.323, section 5.9: Integrity protection
   // The data unit that is integrity protected is the PDU header
   // and the data part of the PDU before ciphering.
   uint8_t mac[4] = {};
-  if (is_srb() || (is_drb() && (integrity_direction == DIRECTION_TX || integrity_direction == DIRECTION_TXRX))) {
+  if (do_integrity) {
     integrity_generate(sdu->msg, sdu->N_bytes, tx_next, mac);
-  }
-  // Append MAC-I
-  if (is_srb() || (is_drb() && (integrity_direction == DIRECTION_TX || integrity_direction == DIRECTION_TXRX))) {
+    // Append MAC-I
     append_mac(sdu, mac);
   }
 
@@ -156,14 +198,11 @@ void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
   // The data unit that is ciphered is the MAC-I and the
   // data part of the PDCP Data PDU except the
   // SDAP header and the SDAP Control PDU if included in the PDCP SDU.
-  if (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX) {
+  if (do_encryption) {
     cipher_encrypt(
         &sdu->msg[cfg.hdr_len_bytes], sdu->N_bytes - cfg.hdr_len_bytes, tx_next, &sdu->msg[cfg.hdr_len_bytes]);
   }
 
-  // Set meta-data for RLC AM
-  sdu->md.pdcp_sn = tx_next;
-
   logger.info(sdu->msg,
               sdu->N_bytes,
               "TX %s PDU (%dB), HFN=%d, SN=%d, integrity=%s, encryption=%s",
@@ -174,12 +213,14 @@ void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
               srsran_direction_text[integrity_direction],
               srsran_direction_text[encryption_direction]);
 
-  // Check if PDCP is associated with more than on RLC entity TODO
-  // Write to lower layers
-  rlc->write_sdu(lcid, std::move(sdu));
-
   // Increment TX_NEXT
   tx_next++;
+  return true;
+}
+
+void pdcp_entity_nr::pass_to_lower_layers(unique_byte_buffer_t pdu)
+{
+  rlc->write_sdu(lcid, std::move(pdu));
 }
 
 // RLC interface
@@ -285,15 +326,12 @@ void pdcp_entity_nr::write_pdu(unique_byte_buffer_t pdu)
     return; // Invalid count, drop.
   }
 
-  // Check if PDU has been received
-  if (reorder_queue.find(rcvd_count) != reorder_queue.end()) {
+  // Store PDU in reception buffer, unless it has been received
+  if (not reorder_queue.insert(rcvd_count, std::move(pdu))) {
     logger.debug("Duplicate PDU, dropping");
     return; // PDU already present, drop.
   }
 
-  // Store PDU in reception buffer
-  reorder_queue[rcvd_count] = std::move(pdu);
-
   // Update RX_NEXT
   if (rcvd_count >= rx_next) {
     rx_next = rcvd_count + 1;
@@ -347,10 +385,8 @@ void pdcp_entity_nr::notify_failure(const pdcp_sn_vector_t& pdcp_sns)
 // Update RX_NEXT after submitting to higher layers
 void pdcp_entity_nr::deliver_all_consecutive_counts()
 {
-  for (std::map<uint32_t, unique_byte_buffer_t>::iterator it = reorder_queue.begin();
-       it != reorder_queue.end() && it->first == rx_deliv;
-       reorder_queue.erase(it++)) {
-    logger.debug("Delivering SDU with RCVD_COUNT %u", it->first);
+  while (reorder_queue.contains(rx_deliv)) {
+    logger.debug("Delivering SDU with RCVD_COUNT %u", rx_deliv);
 
     // Check RX_DELIV overflow
     if (rx_overflow) {
@@ -362,7 +398,7 @@ void pdcp_entity_nr::deliver_all_consecutive_counts()
     }
 
     // Pass PDCP SDU to the next layers
-    pass_to_upper_layers(std::move(it->second));
+    pass_to_upper_layers(reorder_queue.pop(rx_deliv));
 
     // Update RX_DELIV
     rx_deliv = rx_deliv + 1;
@@ -379,11 +415,11 @@ void pdcp_entity_nr::reordering_callback::operator()(uint32_t timer_id)
       "Reordering timer expired. RX_REORD=%u, re-order queue size=%ld", parent->rx_reord, parent->reorder_queue.size());
 
   // Deliver all PDCP SDU(s) with associated COUNT value(s) < RX_REORD
-  for (std::map<uint32_t, unique_byte_buffer_t>::iterator it = parent->reorder_queue.begin();
-       it != parent->reorder_queue.end() && it->first < parent->rx_reord;
-       parent->reorder_queue.erase(it++)) {
-    // Deliver to upper layers
-    parent->pass_to_upper_layers(std::move(it->second));
+  for (uint32_t count = parent->rx_deliv; count < parent->rx_reord and not parent->reorder_queue.empty(); ++count) {
+    if (parent->reorder_queue.contains(count)) {
+      // Deliver to upper layers
+      parent->pass_to_upper_layers(parent->reorder_queue.pop(count));
+    }
   }
 
   // Update RX_DELIV to the first PDCP SDU not delivered to the upper layers
@@ -31,125 +31,198 @@
 
 static inline float cfr_symb_peak(float* in_abs, int len);
 
-void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
+// Computes the clipping threshold of one symbol, 0 if the symbol has no peak above it
+static float cfr_symb_threshold(srsran_cfr_t* q, float* in_abs)
 {
-  if (q == NULL || in == NULL || out == NULL) {
-    return;
+  const float symb_peak = cfr_symb_peak(in_abs, q->cfg.symbol_sz);
+
+  // In manual mode, the symbols without samples above the threshold are left untouched
+  if (q->cfg.cfr_mode == SRSRAN_CFR_THR_MANUAL) {
+    return (symb_peak > q->cfg.manual_thr) ? q->cfg.manual_thr : 0.0f;
   }
-  if (!q->cfg.cfr_enable) {
-    // If no processing, copy the input samples into the output buffer
-    if (in != out) {
-      srsran_vec_cf_copy(out, in, q->cfg.symbol_sz);
+
+  // In auto modes, the beta threshold is calculated based on the measured PAPR
+  const float pwr_symb_peak = symb_peak * symb_peak;
+  const float pwr_symb_avg  = srsran_vec_avg_power_ff(in_abs, q->cfg.symbol_sz);
+  float       symb_papr     = 0.0f;
+
+  if (isnormal(pwr_symb_avg) && isnormal(pwr_symb_peak)) {
+    if (q->cfg.cfr_mode == SRSRAN_CFR_THR_AUTO_CMA) {
+      // Once cma_n reaches its max value, stop incrementing to prevent overflow.
+      // This turns the averaging into a de-facto EMA with an extremely slow time constant
+      q->pwr_avg_in = SRSRAN_VEC_CMA(pwr_symb_avg, q->pwr_avg_in, q->cma_n++);
+      q->cma_n      = q->cma_n & UINT64_MAX ? q->cma_n : UINT64_MAX;
+    } else if (q->cfg.cfr_mode == SRSRAN_CFR_THR_AUTO_EMA) {
+      q->pwr_avg_in = SRSRAN_VEC_EMA(pwr_symb_avg, q->pwr_avg_in, q->cfg.ema_alpha);
     }
-    return;
+
+    symb_papr = pwr_symb_peak / q->pwr_avg_in;
   }
+  float papr_reduction = symb_papr / q->max_papr_lin;
+  return (papr_reduction > 1) ? symb_peak / sqrtf(papr_reduction) : 0;
+}
 
+// Clips the peaks above beta and filters them with an FFT round-trip
+static void cfr_clip_fft(srsran_cfr_t* q, cf_t* in, float* in_abs, float beta, cf_t* out)
+{
   const float    alpha     = q->cfg.alpha;
   const uint32_t symbol_sz = q->cfg.symbol_sz;
-  float          beta      = 0.0f;
-
-  // Calculate absolute input values
-  srsran_vec_abs_cf(in, q->abs_buffer_in, symbol_sz);
 
-  // In auto modes, the beta threshold is calculated based on the measured PAPR
-  if (q->cfg.cfr_mode == SRSRAN_CFR_THR_MANUAL) {
-    beta = q->cfg.manual_thr;
-  } else {
-    const float symb_peak     = cfr_symb_peak(q->abs_buffer_in, q->cfg.symbol_sz);
-    const float pwr_symb_peak = symb_peak * symb_peak;
-    const float pwr_symb_avg  = srsran_vec_avg_power_ff(q->abs_buffer_in, q->cfg.symbol_sz);
-    float       symb_papr     = 0.0f;
-
-    if (isnormal(pwr_symb_avg) && isnormal(pwr_symb_peak)) {
-      if (q->cfg.cfr_mode == SRSRAN_CFR_THR_AUTO_CMA) {
-        // Once cma_n reaches its max value, stop incrementing to prevent overflow.
-        // This turns the averaging into a de-facto EMA with an extremely slow time constant
-        q->pwr_avg_in = SRSRAN_VEC_CMA(pwr_symb_avg, q->pwr_avg_in, q->cma_n++);
-        q->cma_n      = q->cma_n & UINT64_MAX ? q->cma_n : UINT64_MAX;
-      } else if (q->cfg.cfr_mode == SRSRAN_CFR_THR_AUTO_EMA) {
-        q->pwr_avg_in = SRSRAN_VEC_EMA(pwr_symb_avg, q->pwr_avg_in, q->cfg.ema_alpha);
-      }
-
-      symb_papr = pwr_symb_peak / q->pwr_avg_in;
-    }
-    float papr_reduction = symb_papr / q->max_papr_lin;
-    beta                 = (papr_reduction > 1) ? symb_peak / sqrtf(papr_reduction) : 0;
-  }
-
-  // Clipping algorithm
-  if (isnormal(beta)) {
 #ifdef CFR_PEAK_EXTRACTION
-    srsran_vec_cf_zero(q->peak_buffer, symbol_sz);
-    cf_t clip_thr = 0;
-    for (int i = 0; i < symbol_sz; i++) {
-      if (q->abs_buffer_in[i] > beta) {
-        clip_thr          = beta * (in[i] / q->abs_buffer_in[i]);
-        q->peak_buffer[i] = in[i] - clip_thr;
-      }
+  srsran_vec_cf_zero(q->peak_buffer, symbol_sz);
+  cf_t clip_thr = 0;
+  for (int i = 0; i < symbol_sz; i++) {
+    if (in_abs[i] > beta) {
+      clip_thr          = beta * (in[i] / in_abs[i]);
+      q->peak_buffer[i] = in[i] - clip_thr;
     }
+  }
 
-    // Apply FFT filter to the peak signal
-    srsran_dft_run_c(&q->fft_plan, q->peak_buffer, q->peak_buffer);
+  // Apply FFT filter to the peak signal
+  srsran_dft_run_c(&q->fft_plan, q->peak_buffer, q->peak_buffer);
 #ifdef CFR_LPF_WITH_ZEROS
-    srsran_vec_cf_zero(q->peak_buffer + q->lpf_bw / 2 + q->cfg.dc_sc, symbol_sz - q->cfg.symbol_bw - q->cfg.dc_sc);
+  srsran_vec_cf_zero(q->peak_buffer + q->lpf_bw / 2 + q->cfg.dc_sc, symbol_sz - q->cfg.symbol_bw - q->cfg.dc_sc);
 #else  /* CFR_LPF_WITH_ZEROS */
-    srsran_vec_prod_cfc(q->peak_buffer, q->lpf_spectrum, q->peak_buffer, symbol_sz);
+  srsran_vec_prod_cfc(q->peak_buffer, q->lpf_spectrum, q->peak_buffer, symbol_sz);
 #endif /* CFR_LPF_WITH_ZEROS */
-    srsran_dft_run_c(&q->ifft_plan, q->peak_buffer, q->peak_buffer);
+  srsran_dft_run_c(&q->ifft_plan, q->peak_buffer, q->peak_buffer);
 
-    // Scale the peak signal according to alpha
-    srsran_vec_sc_prod_cfc(q->peak_buffer, alpha, q->peak_buffer, symbol_sz);
+  // Scale the peak signal according to alpha
+  srsran_vec_sc_prod_cfc(q->peak_buffer, alpha, q->peak_buffer, symbol_sz);
 
-    // Apply the filtered clipping
-    srsran_vec_sub_ccc(in, q->peak_buffer, out, symbol_sz);
+  // Apply the filtered clipping
+  srsran_vec_sub_ccc(in, q->peak_buffer, out, symbol_sz);
 #else /* CFR_PEAK_EXTRACTION */
 
-    // Generate a clipping envelope and clip the signal
-    srsran_vec_gen_clip_env(q->abs_buffer_in, beta, alpha, q->abs_buffer_in, symbol_sz);
-    srsran_vec_prod_cfc(in, q->abs_buffer_in, out, symbol_sz);
+  // Generate a clipping envelope and clip the signal
+  srsran_vec_gen_clip_env(in_abs, beta, alpha, in_abs, symbol_sz);
+  srsran_vec_prod_cfc(in, in_abs, out, symbol_sz);
 
-    // FFT filter
-    srsran_dft_run_c(&q->fft_plan, out, out);
+  // FFT filter
+  srsran_dft_run_c(&q->fft_plan, out, out);
 #ifdef CFR_LPF_WITH_ZEROS
-    srsran_vec_cf_zero(out + q->lpf_bw / 2 + q->cfg.dc_sc, symbol_sz - q->cfg.symbol_bw - q->cfg.dc_sc);
+  srsran_vec_cf_zero(out + q->lpf_bw / 2 + q->cfg.dc_sc, symbol_sz - q->cfg.symbol_bw - q->cfg.dc_sc);
 #else  /* CFR_LPF_WITH_ZEROS */
-    srsran_vec_prod_cfc(out, q->lpf_spectrum, out, symbol_sz);
+  srsran_vec_prod_cfc(out, q->lpf_spectrum, out, symbol_sz);
 #endif /* CFR_LPF_WITH_ZEROS */
-    srsran_dft_run_c(&q->ifft_plan, out, out);
+  srsran_dft_run_c(&q->ifft_plan, out, out);
 #endif /* CFR_PEAK_EXTRACTION */
+}
 
-  } else {
-    // If no processing, copy the input samples into the output buffer
-    if (in != out) {
-      srsran_vec_cf_copy(out, in, symbol_sz);
+// Attenuates the peaks above beta with a smooth window centred on each of them, in the time domain
+static void cfr_clip_window(srsran_cfr_t* q, cf_t* in, const float* in_abs, float beta, cf_t* out)
+{
+  const uint32_t symbol_sz = q->cfg.symbol_sz;
+  const uint32_t half_len  = q->window_len / 2;
+  float*         env       = q->env_buffer;
+
+  // The gain around every peak is the minimum of the windowed attenuations reaching it. The symbol is periodic, as the
+  // CP is added afterwards, so the windows wrap around its edges
+  for (uint32_t i = 0; i < symbol_sz; i++) {
+    env[i] = 1.0f;
+  }
+  for (uint32_t i = 0; i < symbol_sz; i++) {
+    if (in_abs[i] <= beta) {
+      continue;
+    }
+    const float att = 1.0f - beta / in_abs[i];
+    uint32_t    idx = (i + symbol_sz - half_len) % symbol_sz;
+    for (uint32_t k = 0; k < q->window_len; k++) {
+      env[idx] = SRSRAN_MIN(env[idx], 1.0f - att * q->window[k]);
+      idx      = (idx + 1 == symbol_sz) ? 0 : idx + 1;
     }
   }
-  if (q->cfg.cfr_mode != SRSRAN_CFR_THR_MANUAL && q->cfg.measure_out_papr) {
-    srsran_vec_abs_cf(in, q->abs_buffer_out, symbol_sz);
 
-    const float symb_peak     = cfr_symb_peak(q->abs_buffer_out, q->cfg.symbol_sz);
-    const float pwr_symb_peak = symb_peak * symb_peak;
-    const float pwr_symb_avg  = srsran_vec_avg_power_ff(q->abs_buffer_out, q->cfg.symbol_sz);
-    float       symb_papr     = 0.0f;
+  // Blend the envelope with the unprocessed signal according to alpha and apply it
+  srsran_vec_sc_prod_fff(env, q->cfg.alpha, env, symbol_sz);
+  srsran_vec_sc_sum_fff(env, 1.0f - q->cfg.alpha, env, symbol_sz);
+  srsran_vec_prod_cfc(in, env, out, symbol_sz);
+}
 
-    if (isnormal(pwr_symb_avg) && isnormal(pwr_symb_peak)) {
-      if (q->cfg.cfr_mode == SRSRAN_CFR_THR_AUTO_CMA) {
-        // Do not increment cma_n here, as it is being done when calculating input PAPR
-        q->pwr_avg_out = SRSRAN_VEC_CMA(pwr_symb_avg, q->pwr_avg_out, q->cma_n);
-      }
+static void cfr_measure_out_papr(srsran_cfr_t* q, const cf_t* out)
+{
+  srsran_vec_abs_cf(out, q->abs_buffer_out, q->cfg.symbol_sz);
+
+  const float symb_peak     = cfr_symb_peak(q->abs_buffer_out, q->cfg.symbol_sz);
+  const float pwr_symb_peak = symb_peak * symb_peak;
+  const float pwr_symb_avg  = srsran_vec_avg_power_ff(q->abs_buffer_out, q->cfg.symbol_sz);
+  float       symb_papr     = 0.0f;
+
+  if (isnormal(pwr_symb_avg) && isnormal(pwr_symb_peak)) {
+    if (q->cfg.cfr_mode == SRSRAN_CFR_THR_AUTO_CMA) {
+      // Do not increment cma_n here, as it is being done when calculating input PAPR
+      q->pwr_avg_out = SRSRAN_VEC_CMA(pwr_symb_avg, q->pwr_avg_out, q->cma_n);
+    }
+
+    else if (q->cfg.cfr_mode == SRSRAN_CFR_THR_AUTO_EMA) {
+      q->pwr_avg_out = SRSRAN_VEC_EMA(pwr_symb_avg, q->pwr_avg_out, q->cfg.ema_alpha);
+    }
+
+    symb_papr = pwr_symb_peak / q->pwr_avg_out;
+  }
+
+  const float papr_out_db = srsran_convert_power_to_dB(symb_papr);
+  printf("Output  PAPR: %f dB\n", papr_out_db);
+}
+
+void srsran_cfr_process_batch(srsran_cfr_t* q, cf_t* const* in, cf_t* const* out, uint32_t nof_symbols)
+{
+  if (q == NULL || in == NULL || out == NULL) {
+    return;
+  }
+
+  const uint32_t symbol_sz = q->cfg.symbol_sz;
 
-      else if (q->cfg.cfr_mode == SRSRAN_CFR_THR_AUTO_EMA) {
-        q->pwr_avg_out = SRSRAN_VEC_EMA(pwr_symb_avg, q->pwr_avg_out, q->cfg.ema_alpha);
+  if (!q->cfg.cfr_enable) {
+    // If no processing, copy the input samples into the output buffer
+    for (uint32_t i = 0; i < nof_symbols; i++) {
+      if (in[i] != out[i]) {
+        srsran_vec_cf_copy(out[i], in[i], symbol_sz);
       }
+    }
+    return;
+  }
+
+  for (uint32_t first = 0; first < nof_symbols; first += SRSRAN_CFR_MAX_BATCH) {
+    const uint32_t batch_sz = SRSRAN_MIN(nof_symbols - first, SRSRAN_CFR_MAX_BATCH);
+    float          beta[SRSRAN_CFR_MAX_BATCH];
 
-      symb_papr = pwr_symb_peak / q->pwr_avg_out;
+    // Calculate the absolute input values and the thresholds of the whole batch, in symbol order
+    for (uint32_t i = 0; i < batch_sz; i++) {
+      float* in_abs = q->abs_buffer_in + i * symbol_sz;
+      srsran_vec_abs_cf(in[first + i], in_abs, symbol_sz);
+      beta[i] = cfr_symb_threshold(q, in_abs);
     }
 
-    const float papr_out_db = srsran_convert_power_to_dB(symb_papr);
-    printf("Output  PAPR: %f dB\n", papr_out_db);
+    // Clipping algorithm, only for the symbols with peaks
+    for (uint32_t i = 0; i < batch_sz; i++) {
+      cf_t*  symb_in  = in[first + i];
+      cf_t*  symb_out = out[first + i];
+      float* in_abs   = q->abs_buffer_in + i * symbol_sz;
+
+      if (isnormal(beta[i])) {
+        if (q->cfg.filter == SRSRAN_CFR_FILTER_WINDOW) {
+          cfr_clip_window(q, symb_in, in_abs, beta[i], symb_out);
+        } else {
+          cfr_clip_fft(q, symb_in, in_abs, beta[i], symb_out);
+        }
+      } else if (symb_in != symb_out) {
+        // If no processing, copy the input samples into the output buffer
+        srsran_vec_cf_copy(symb_out, symb_in, symbol_sz);
+      }
+
+      if (q->cfg.cfr_mode != SRSRAN_CFR_THR_MANUAL && q->cfg.measure_out_papr) {
+        cfr_measure_out_papr(q, symb_out);
+      }
+    }
   }
 }
 
+void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
+{
+  srsran_cfr_process_batch(q, &in, &out, 1);
+}
+
 int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg)
 {
   int ret = SRSRAN_ERROR;
@@ -166,6 +239,15 @@ int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg)
     ERROR("Error, invalid CFR mode");
     goto clean_exit;
   }
+  if (cfg->filter >= SRSRAN_CFR_NOF_FILTERS) {
+    ERROR("Error, invalid CFR filter");
+    goto clean_exit;
+  }
+  if (cfg->filter == SRSRAN_CFR_FILTER_WINDOW &&
+      ((cfg->window_len && cfg->window_len % 2 == 0) || cfg->window_len >= cfg->symbol_sz)) {
+    ERROR("Error, invalid configuration for the peak window");
+    goto clean_exit;
+  }
   if (cfg->cfr_mode == SRSRAN_CFR_THR_MANUAL && cfg->manual_thr <= 0) {
     ERROR("Error, invalid configuration for manual threshold");
     goto clean_exit;
@@ -193,7 +275,7 @@ int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg)
   if (q->abs_buffer_in) {
     free(q->abs_buffer_in);
   }
-  q->abs_buffer_in = srsran_vec_f_malloc(q->cfg.symbol_sz);
+  q->abs_buffer_in = srsran_vec_f_malloc(SRSRAN_CFR_MAX_BATCH * q->cfg.symbol_sz);
   if (!q->abs_buffer_in) {
     ERROR("Error allocating abs_buffer_in");
     goto clean_exit;
@@ -217,6 +299,31 @@ int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg)
     goto clean_exit;
   }
 
+  if (q->env_buffer) {
+    free(q->env_buffer);
+  }
+  q->env_buffer = srsran_vec_f_malloc(q->cfg.symbol_sz);
+  if (!q->env_buffer) {
+    ERROR("Error allocating env_buffer");
+    goto clean_exit;
+  }
+
+  // Peak window, by default it spans two samples per symbol bandwidth period on each side of the peak
+  q->window_len = q->cfg.window_len ? q->cfg.window_len : 4 * SRSRAN_CEIL(q->cfg.symbol_sz, q->cfg.symbol_bw) + 1;
+  if (q->window) {
+    free(q->window);
+  }
+  q->window = srsran_vec_f_malloc(q->window_len);
+  if (!q->window) {
+    ERROR("Error allocating window");
+    goto clean_exit;
+  }
+
+  // Hann window without the zero end points, so every sample of the window attenuates
+  for (uint32_t i = 0; i < q->window_len; i++) {
+    q->window[i] = 0.5f * (1.0f - cosf(2.0f * (float)M_PI * (float)(i + 1) / (float)(q->window_len + 1)));
+  }
+
   // Allocate the filter
   if (q->lpf_spectrum) {
     free(q->lpf_spectrum);
@@ -290,7 +397,7 @@ int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg)
   srsran_dft_plan_set_norm(&q->ifft_plan, true);
 
   srsran_vec_cf_zero(q->peak_buffer, q->cfg.symbol_sz);
-  srsran_vec_f_zero(q->abs_buffer_in, q->cfg.symbol_sz);
+  srsran_vec_f_zero(q->abs_buffer_in, SRSRAN_CFR_MAX_BATCH * q->cfg.symbol_sz);
   srsran_vec_f_zero(q->abs_buffer_out, q->cfg.symbol_sz);
   ret = SRSRAN_SUCCESS;
 
@@ -315,6 +422,12 @@ void srsran_cfr_free(srsran_cfr_t* q)
     if (q->peak_buffer) {
       free(q->peak_buffer);
     }
+    if (q->env_buffer) {
+      free(q->env_buffer);
+    }
+    if (q->window) {
+      free(q->window);
+    }
     if (q->lpf_spectrum) {
       free(q->lpf_spectrum);
     }
@@ -337,6 +450,12 @@ bool srsran_cfr_params_valid(srsran_cfr_cfg_t* cfr_conf)
   if (cfr_conf->cfr_mode == SRSRAN_CFR_THR_INVALID) {
     return false;
   }
+  if (cfr_conf->filter >= SRSRAN_CFR_NOF_FILTERS) {
+    return false;
+  }
+  if (cfr_conf->filter == SRSRAN_CFR_FILTER_WINDOW && cfr_conf->window_len && cfr_conf->window_len % 2 == 0) {
+    return false;
+  }
   if (cfr_conf->alpha < 0 || cfr_conf->alpha > 1) {
     return false;
   }
@@ -400,3 +519,14 @@ srsran_cfr_mode_t srsran_cfr_str2mode(const char* mode_str)
   }
   return ret;
 }
+
+srsran_cfr_filter_t srsran_cfr_str2filter(const char* filter_str)
+{
+  if (!strcmp(filter_str, "") || !strcmp(filter_str, "fft")) {
+    return SRSRAN_CFR_FILTER_FFT;
+  }
+  if (!strcmp(filter_str, "window")) {
+    return SRSRAN_CFR_FILTER_WINDOW;
+  }
+  return SRSRAN_CFR_NOF_FILTERS; // filter_str is not recognised
+}
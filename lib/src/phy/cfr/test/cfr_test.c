@@ -44,6 +44,8 @@ static bool              dc_empty        = true;
 static float             thr_manual      = 1.5f;
 static float             max_papr_db     = 8.0f;
 static float             ema_alpha       = (float)1 / (float)SRSRAN_CP_NORM_NSYMB;
+static bool              window_filter   = false;
+static uint32_t          window_len      = 0;
 
 static uint32_t force_symbol_sz = 0;
 static double   elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
@@ -71,12 +73,14 @@ static void usage(char* prog)
   printf("\t-t CFR manual threshold: [Default %.2f]\n", thr_manual);
   printf("\t-p CFR Max PAPR in dB (auto modes): [Default %.2f]\n", max_papr_db);
   printf("\t-E Power avg EMA alpha (EMA mode): [Default %.2f]\n", ema_alpha);
+  printf("\t-w Use time-domain peak windowing instead of the FFT filter: [Default FFT filter]\n");
+  printf("\t-W Peak window length, 0 for auto (window filter): [Default %d]\n", window_len);
 }
 
 static int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "NnerfmatdpE")) != -1) {
+  while ((opt = getopt(argc, argv, "NnerfmatdpEwW")) != -1) {
     switch (opt) {
       case 'n':
         nof_prb = (int)strtol(argv[optind], NULL, 10);
@@ -111,6 +115,12 @@ static int parse_args(int argc, char** argv)
       case 'E':
         ema_alpha = strtof(argv[optind], NULL);
         break;
+      case 'w':
+        window_filter = true;
+        break;
+      case 'W':
+        window_len = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       default:
         usage(argv[0]);
         return SRSRAN_ERROR;
@@ -161,6 +171,7 @@ int main(int argc, char** argv)
     const uint32_t symbol_sz      = (force_symbol_sz) ? force_symbol_sz : (uint32_t)srsran_symbol_sz(nof_prb);
     const uint32_t symbol_bw      = nof_prb * SRSRAN_NRE;
     const uint32_t nof_symb_slot  = SRSRAN_CP_NSYMB(cp);
+    const uint32_t nof_symb_sf    = nof_symb_slot * SRSRAN_NOF_SLOTS_PER_SF;
     const uint32_t nof_symb_frame = nof_symb_slot * SRSRAN_NOF_SLOTS_PER_SF * SRSRAN_NOF_SF_X_FRAME;
     const uint32_t frame_sz       = symbol_sz * nof_symb_frame;
     const uint32_t total_nof_re   = frame_sz * nof_frames;
@@ -192,6 +203,8 @@ int main(int argc, char** argv)
     cfr_tx_cfg.manual_thr       = thr_manual;
     cfr_tx_cfg.ema_alpha        = ema_alpha;
     cfr_tx_cfg.dc_sc            = dc_empty;
+    cfr_tx_cfg.filter           = window_filter ? SRSRAN_CFR_FILTER_WINDOW : SRSRAN_CFR_FILTER_FFT;
+    cfr_tx_cfg.window_len       = window_len;
 
     if (!srsran_cfr_params_valid(&cfr_tx_cfg)) {
       ERROR("Invalid CFR configuration");
@@ -228,14 +241,18 @@ int main(int argc, char** argv)
     acpr_in_dB = srsran_vec_acc_ff(acpr_buff, total_nof_symb) / (float)total_nof_symb;
     acpr_in_dB = srsran_convert_power_to_dB(acpr_in_dB);
 
-    // Execute CFR
+    // Execute CFR, one subframe per batch as the OFDM modulator does
     gettimeofday(&start, NULL);
     for (uint32_t i = 0; i < nof_repetitions; i++) {
       for (uint32_t j = 0; j < nof_frames; j++) {
-        for (uint32_t k = 0; k < nof_symb_frame; k++) {
-          srsran_cfr_process(&cfr,
-                             input + (size_t)((k * symbol_sz) + (j * frame_sz)),
-                             output + (size_t)((k * symbol_sz) + (j * frame_sz)));
+        for (uint32_t k = 0; k < nof_symb_frame; k += nof_symb_sf) {
+          cf_t* symb_in[SRSRAN_CFR_MAX_BATCH];
+          cf_t* symb_out[SRSRAN_CFR_MAX_BATCH];
+          for (uint32_t l = 0; l < nof_symb_sf; l++) {
+            symb_in[l]  = input + (size_t)(((k + l) * symbol_sz) + (j * frame_sz));
+            symb_out[l] = output + (size_t)(((k + l) * symbol_sz) + (j * frame_sz));
+          }
+          srsran_cfr_process_batch(&cfr, symb_in, symb_out, nof_symb_sf);
         }
       }
     }
@@ -284,10 +301,15 @@ int main(int argc, char** argv)
     acpr_buff = NULL;
 
     ++nof_prb;
-    if (acpr_out_dB > MAX_ACPR_DB) {
+    // The peak windowing does not filter the out of band emissions, it must reduce the PAPR instead
+    if (!window_filter && acpr_out_dB > MAX_ACPR_DB) {
       printf("ACPR too large \n");
       goto clean_exit;
     }
+    if (window_filter && papr_out >= papr_in) {
+      printf("PAPR not reduced \n");
+      goto clean_exit;
+    }
   }
   ret = SRSRAN_SUCCESS;
 
@@ -31,6 +31,8 @@
 
 #include "srsran/phy/ch_estimation/chest_dl.h"
 #include "srsran/phy/utils/convolution.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/stage_prof.h"
 #include "srsran/phy/utils/vector.h"
 
 //#define DEFAULT_FILTER_LEN 3
@@ -161,6 +163,85 @@ clean_exit:
   return ret;
 }
 
+static void pilot_ring_free(srsran_chest_dl_pilot_ring_t* r)
+{
+  if (r->buffer) {
+    free(r->buffer);
+  }
+  if (r->sum) {
+    free(r->sum);
+  }
+  bzero(r, sizeof(srsran_chest_dl_pilot_ring_t));
+}
+
+static int pilot_ring_reset(srsran_chest_dl_pilot_ring_t* r, uint32_t len, uint32_t nof_pilots)
+{
+  // Grow the buffers if required
+  if (len > r->max_len || nof_pilots > r->max_pilots) {
+    uint32_t max_len    = SRSRAN_MAX(len, r->max_len);
+    uint32_t max_pilots = SRSRAN_MAX(nof_pilots, r->max_pilots);
+    pilot_ring_free(r);
+
+    r->buffer = srsran_vec_cf_malloc(max_len * max_pilots);
+    r->sum    = srsran_vec_cf_malloc(max_pilots);
+    if (!r->buffer || !r->sum) {
+      perror("malloc");
+      pilot_ring_free(r);
+      return SRSRAN_ERROR;
+    }
+    r->max_len    = max_len;
+    r->max_pilots = max_pilots;
+  }
+
+  srsran_vec_cf_zero(r->sum, nof_pilots);
+  r->nof_pilots = nof_pilots;
+  r->len        = len;
+  r->count      = 0;
+  r->idx        = 0;
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Stores the pilot estimates of this subframe in the ring and replaces them by the average of the stored subframes.
+ * The sum is updated with the new and the dropped subframes only, and rebuilt once per ring turn so the rounding
+ * errors do not accumulate. */
+static int pilot_ring_average(srsran_chest_dl_pilot_ring_t* r, uint32_t len, cf_t* pilots, uint32_t nof_pilots)
+{
+  // Subframes with less pilots (DwPTS) are neither stored nor averaged
+  if (r->len == len && nof_pilots < r->nof_pilots) {
+    return SRSRAN_SUCCESS;
+  }
+
+  if (r->len != len || r->nof_pilots != nof_pilots) {
+    if (pilot_ring_reset(r, len, nof_pilots)) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // Replace the oldest subframe by this one
+  cf_t* slot = &r->buffer[r->idx * nof_pilots];
+  if (r->count == len) {
+    srsran_vec_sub_ccc(r->sum, slot, r->sum, nof_pilots);
+  } else {
+    r->count++;
+  }
+  srsran_vec_cf_copy(slot, pilots, nof_pilots);
+  srsran_vec_sum_ccc(r->sum, pilots, r->sum, nof_pilots);
+  r->idx = (r->idx + 1) % len;
+
+  // Rebuild the sum after a full turn
+  if (r->idx == 0) {
+    srsran_vec_cf_copy(r->sum, r->buffer, nof_pilots);
+    for (uint32_t i = 1; i < r->count; i++) {
+      srsran_vec_sum_ccc(r->sum, &r->buffer[i * nof_pilots], r->sum, nof_pilots);
+    }
+  }
+
+  srsran_vec_sc_prod_cfc(r->sum, 1.0f / (float)r->count, pilots, nof_pilots);
+
+  return SRSRAN_SUCCESS;
+}
+
 void srsran_chest_dl_free(srsran_chest_dl_t* q)
 {
   if (!q) {
@@ -202,6 +283,11 @@ void srsran_chest_dl_free(srsran_chest_dl_t* q)
     srsran_wiener_dl_free(q->wiener_dl);
     free(q->wiener_dl);
   }
+  for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    for (uint32_t j = 0; j < SRSRAN_MAX_PORTS; j++) {
+      pilot_ring_free(&q->pilot_ring[i][j]);
+    }
+  }
   bzero(q, sizeof(srsran_chest_dl_t));
 }
 
@@ -315,6 +401,13 @@ int srsran_chest_dl_set_cell(srsran_chest_dl_t* q, srsran_cell_t cell)
         fprintf(stderr, "Error initializing interpolator\n");
         return SRSRAN_ERROR;
       }
+
+      // Drop the pilots of the previous cell, the rings are reset on their next use
+      for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
+        for (uint32_t j = 0; j < SRSRAN_MAX_PORTS; j++) {
+          q->pilot_ring[i][j].len = 0;
+        }
+      }
     }
     ret = SRSRAN_SUCCESS;
   }
@@ -697,6 +790,16 @@ static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
     }
   }
 
+  /* Average the pilot estimates over the last subframes */
+  if (cfg->pilot_avg_len > 1 && ch_mode == SRSRAN_SF_NORM) {
+    if (pilot_ring_average(&q->pilot_ring[rxant_id][port_id],
+                           cfg->pilot_avg_len,
+                           q->pilot_estimates,
+                           srsran_refsignal_cs_nof_re(&q->csr_refs, sf, port_id))) {
+      ERROR("Error averaging pilot estimates");
+    }
+  }
+
   if (ce != NULL) {
     switch (cfg->filter_type) {
       case SRSRAN_CHEST_FILTER_GAUSS:
@@ -1002,6 +1105,7 @@ int srsran_chest_dl_estimate_cfg(srsran_chest_dl_t*     q,
                                  cf_t*                  input[SRSRAN_MAX_PORTS],
                                  srsran_chest_dl_res_t* res)
 {
+  uint64_t t0 = srsran_stage_prof_start();
   for (uint32_t rxant_id = 0; rxant_id < q->nof_rx_antennas; rxant_id++) {
     // Estimate and correct synchronization error if enabled
     if (cfg->sync_error_enable) {
@@ -1022,10 +1126,21 @@ int srsran_chest_dl_estimate_cfg(srsran_chest_dl_t*     q,
   }
 
   fill_res(q, res);
+  srsran_stage_prof_stop(SRSRAN_STAGE_PROF_CHEST, t0);
 
   return SRSRAN_SUCCESS;
 }
 
+srsran_chest_dl_estimator_alg_t srsran_chest_dl_default_estimator_alg(void)
+{
+  // The Wiener matrix products run along the SIMD lanes, they are affordable from 8 complex lanes (AVX2) onwards
+#if SRSRAN_SIMD_CF_SIZE >= 8
+  return SRSRAN_ESTIMATOR_ALG_WIENER;
+#else
+  return SRSRAN_ESTIMATOR_ALG_INTERPOLATE;
+#endif
+}
+
 srsran_chest_dl_estimator_alg_t srsran_chest_dl_str2estimator_alg(const char* str)
 {
   srsran_chest_dl_estimator_alg_t ret = SRSRAN_ESTIMATOR_ALG_AVERAGE;
@@ -1037,6 +1152,8 @@ srsran_chest_dl_estimator_alg_t srsran_chest_dl_str2estimator_alg(const char* st
       ret = SRSRAN_ESTIMATOR_ALG_AVERAGE;
     } else if (strcmp(str, "wiener") == 0) {
       ret = SRSRAN_ESTIMATOR_ALG_WIENER;
+    } else if (strcmp(str, "auto") == 0) {
+      ret = srsran_chest_dl_default_estimator_alg();
     }
   }
 
@@ -855,21 +855,24 @@ static void chest_sl_pssch_ls_estimate(srsran_chest_sl_t* q, cf_t* sf_buffer)
 
 static void get_subband_noise(srsran_chest_sl_t* q, uint32_t k_start, uint32_t k_end, uint32_t sf_nsymbols)
 {
-  for (int k = k_start; k < k_end; k++) {
-    cf_t aux = 0.0;
-    for (int l = 0; l < sf_nsymbols / 2; l++) {
-      aux = aux + q->ce[k + l * q->cell.nof_prb * SRSRAN_NRE];
+  uint32_t n_re = q->cell.nof_prb * SRSRAN_NRE;
+  uint32_t len  = k_end - k_start;
+
+  // Average the estimates of each half of the subframe, one symbol at a time
+  uint32_t l_start[2] = {0, sf_nsymbols / 2};
+  uint32_t l_end[2]   = {sf_nsymbols / 2, sf_nsymbols};
+  for (uint32_t h = 0; h < 2; h++) {
+    if (l_start[h] == l_end[h]) {
+      continue;
     }
-    for (int l = 0; l < sf_nsymbols / 2; l++) {
-      q->ce_average[k + l * q->cell.nof_prb * SRSRAN_NRE] = aux / (float)sf_nsymbols * 2;
+    cf_t* avg = &q->ce_average[k_start + l_start[h] * n_re];
+    srsran_vec_cf_copy(avg, &q->ce[k_start + l_start[h] * n_re], len);
+    for (uint32_t l = l_start[h] + 1; l < l_end[h]; l++) {
+      srsran_vec_sum_ccc(avg, &q->ce[k_start + l * n_re], avg, len);
     }
-
-    aux = 0.0;
-    for (int l = sf_nsymbols / 2; l < sf_nsymbols; l++) {
-      aux = aux + q->ce[k + l * q->cell.nof_prb * SRSRAN_NRE];
-    }
-    for (int l = sf_nsymbols / 2; l < sf_nsymbols; l++) {
-      q->ce_average[k + l * q->cell.nof_prb * SRSRAN_NRE] = aux / (float)sf_nsymbols * 2;
+    srsran_vec_sc_prod_cfc(avg, 2.0f / (float)sf_nsymbols, avg, len);
+    for (uint32_t l = l_start[h] + 1; l < l_end[h]; l++) {
+      srsran_vec_cf_copy(&q->ce_average[k_start + l * n_re], avg, len);
     }
   }
 
@@ -883,63 +886,75 @@ static void get_subband_noise(srsran_chest_sl_t* q, uint32_t k_start, uint32_t k
   }
 }
 
-float srsran_chest_sl_estimate_noise(srsran_chest_sl_t* q)
+/** Gets the subcarrier bands [k_start, k_end) occupied by the channel, at most two for PSSCH in TM1/2. Returns the
+ * number of bands.
+ */
+static uint32_t chest_sl_get_bands(srsran_chest_sl_t* q, uint32_t k_start[2], uint32_t k_end[2])
 {
-  uint32_t sf_nsymbols = srsran_sl_get_num_symbols(q->cell.tm, q->cell.cp);
-  if (sf_nsymbols == 0) {
-    ERROR("Error estimating channel noise. Invalid number of OFDM symbols.");
-    return SRSRAN_ERROR;
-  }
-
-  srsran_vec_cf_zero(q->ce_average, q->sf_n_re);
-  q->noise_estimated = 0.0;
-
-  uint32_t k_start = 0;
-  uint32_t k_end   = 0;
-
   switch (q->channel) {
     case SRSRAN_SIDELINK_PSBCH:
-      k_start = q->cell.nof_prb * SRSRAN_NRE / 2 - 36;
-      k_end   = k_start + q->M_sc_rs;
-      get_subband_noise(q, k_start, k_end, sf_nsymbols);
-      break;
+      k_start[0] = q->cell.nof_prb * SRSRAN_NRE / 2 - 36;
+      k_end[0]   = k_start[0] + q->M_sc_rs;
+      return 1;
     case SRSRAN_SIDELINK_PSCCH:
-      k_start = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
-      k_end   = k_start + q->M_sc_rs;
-      get_subband_noise(q, k_start, k_end, sf_nsymbols);
-      break;
+      k_start[0] = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
+      k_end[0]   = k_start[0] + q->M_sc_rs;
+      return 1;
     case SRSRAN_SIDELINK_PSSCH:
       if (q->cell.tm == SRSRAN_SIDELINK_TM1 || q->cell.tm == SRSRAN_SIDELINK_TM2) {
         if (q->chest_sl_cfg.nof_prb <= q->sl_comm_resource_pool.prb_num) {
-          k_start = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
-          k_end   = (q->chest_sl_cfg.nof_prb + q->chest_sl_cfg.prb_start_idx) * SRSRAN_NRE;
-          get_subband_noise(q, k_start, k_end, sf_nsymbols);
+          k_start[0] = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
+          k_end[0]   = (q->chest_sl_cfg.nof_prb + q->chest_sl_cfg.prb_start_idx) * SRSRAN_NRE;
+          return 1;
+        }
+        // First band
+        k_start[0] = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
+        k_end[0]   = k_start[0] + q->sl_comm_resource_pool.prb_num * SRSRAN_NRE;
+
+        // Second band
+        if ((q->sl_comm_resource_pool.prb_num * 2) >
+            (q->sl_comm_resource_pool.prb_end - q->sl_comm_resource_pool.prb_start + 1)) {
+          k_start[1] = (q->sl_comm_resource_pool.prb_end + 1 - q->sl_comm_resource_pool.prb_num + 1) * SRSRAN_NRE;
         } else {
-          // First band
-          k_start = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
-          k_end   = k_start + q->sl_comm_resource_pool.prb_num * SRSRAN_NRE;
-          get_subband_noise(q, k_start, k_end, sf_nsymbols);
-
-          // Second band
-          if ((q->sl_comm_resource_pool.prb_num * 2) >
-              (q->sl_comm_resource_pool.prb_end - q->sl_comm_resource_pool.prb_start + 1)) {
-            k_start = (q->sl_comm_resource_pool.prb_end + 1 - q->sl_comm_resource_pool.prb_num + 1) * SRSRAN_NRE;
-          } else {
-            k_start = (q->sl_comm_resource_pool.prb_end + 1 - q->sl_comm_resource_pool.prb_num) * SRSRAN_NRE;
-          }
-          k_end = k_start + (q->chest_sl_cfg.nof_prb - q->sl_comm_resource_pool.prb_num) * SRSRAN_NRE;
-          get_subband_noise(q, k_start, k_end, sf_nsymbols);
+          k_start[1] = (q->sl_comm_resource_pool.prb_end + 1 - q->sl_comm_resource_pool.prb_num) * SRSRAN_NRE;
         }
+        k_end[1] = k_start[1] + (q->chest_sl_cfg.nof_prb - q->sl_comm_resource_pool.prb_num) * SRSRAN_NRE;
+        return 2;
       } else if (q->cell.tm == SRSRAN_SIDELINK_TM3 || q->cell.tm == SRSRAN_SIDELINK_TM4) {
-        k_start = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
-        k_end   = (q->chest_sl_cfg.nof_prb + q->chest_sl_cfg.prb_start_idx) * SRSRAN_NRE;
-        get_subband_noise(q, k_start, k_end, sf_nsymbols);
+        k_start[0] = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
+        k_end[0]   = (q->chest_sl_cfg.nof_prb + q->chest_sl_cfg.prb_start_idx) * SRSRAN_NRE;
+        return 1;
       }
-      break;
+      return 0;
     default:
-      ERROR("Invalid Sidelink channel");
-      return SRSRAN_ERROR;
+      return 0;
+  }
+}
+
+float srsran_chest_sl_estimate_noise(srsran_chest_sl_t* q)
+{
+  uint32_t sf_nsymbols = srsran_sl_get_num_symbols(q->cell.tm, q->cell.cp);
+  if (sf_nsymbols == 0) {
+    ERROR("Error estimating channel noise. Invalid number of OFDM symbols.");
+    return SRSRAN_ERROR;
+  }
+
+  if (q->channel != SRSRAN_SIDELINK_PSBCH && q->channel != SRSRAN_SIDELINK_PSCCH &&
+      q->channel != SRSRAN_SIDELINK_PSSCH) {
+    ERROR("Invalid Sidelink channel");
+    return SRSRAN_ERROR;
   }
+
+  srsran_vec_cf_zero(q->ce_average, q->sf_n_re);
+  q->noise_estimated = 0.0;
+
+  uint32_t k_start[2] = {};
+  uint32_t k_end[2]   = {};
+  uint32_t nof_bands  = chest_sl_get_bands(q, k_start, k_end);
+  for (uint32_t i = 0; i < nof_bands; i++) {
+    get_subband_noise(q, k_start[i], k_end[i], sf_nsymbols);
+  }
+
   q->noise_estimated = q->noise_estimated / (float)sf_nsymbols;
   return q->noise_estimated;
 }
@@ -1129,8 +1144,21 @@ void srsran_chest_sl_ls_equalize(srsran_chest_sl_t* q, cf_t* sf_buffer, cf_t* eq
 {
   srsran_chest_sl_estimate_noise(q);
 
-  // Perform channel equalization
-  srsran_predecoding_single(sf_buffer, q->ce_average, equalized_sf_buffer, NULL, q->sf_n_re, 1.0, q->noise_estimated);
+  // Perform channel equalization only on the subcarriers of the channel, the rest of the subframe is not estimated.
+  // This keeps the cost of trying many PSCCH candidates per subframe proportional to the candidate size.
+  uint32_t sf_nsymbols = srsran_sl_get_num_symbols(q->cell.tm, q->cell.cp);
+  uint32_t n_re        = q->cell.nof_prb * SRSRAN_NRE;
+  uint32_t k_start[2]  = {};
+  uint32_t k_end[2]    = {};
+  uint32_t nof_bands   = chest_sl_get_bands(q, k_start, k_end);
+  for (uint32_t l = 0; l < sf_nsymbols; l++) {
+    for (uint32_t i = 0; i < nof_bands; i++) {
+      uint32_t k   = l * n_re + k_start[i];
+      uint32_t len = k_end[i] - k_start[i];
+      srsran_predecoding_single(
+          &sf_buffer[k], &q->ce_average[k], &equalized_sf_buffer[k], NULL, len, 1.0, q->noise_estimated);
+    }
+  }
 }
 
 void srsran_chest_sl_ls_estimate_equalize(srsran_chest_sl_t* q, cf_t* sf_buffer, cf_t* equalized_sf_buffer)
@@ -31,6 +31,7 @@
 #include "srsran/phy/ch_estimation/chest_ul.h"
 #include "srsran/phy/dft/dft_precoding.h"
 #include "srsran/phy/utils/convolution.h"
+#include "srsran/phy/utils/stage_prof.h"
 #include "srsran/phy/utils/vector.h"
 #include "srsran/srsran.h"
 
@@ -98,6 +99,31 @@ int srsran_chest_ul_init(srsran_chest_ul_t* q, uint32_t max_prb)
       ERROR("Error allocating memory for pregenerated signals");
       goto clean_exit;
     }
+
+    // The SRS uses one every two subcarriers
+    q->max_srs_re = MAX_REFS_SYM / 2;
+    for (uint32_t b = 0; b < SRSRAN_CHEST_UL_SRS_NOF_B; b++) {
+      for (uint32_t i = 0; i < SRSRAN_NOF_SF_X_FRAME; i++) {
+        q->srs_base[b][i] = srsran_vec_cf_malloc(q->max_srs_re);
+        if (!q->srs_base[b][i]) {
+          perror("malloc");
+          goto clean_exit;
+        }
+      }
+      if (srsran_dft_plan_c(&q->srs_idft[b], q->max_srs_re, SRSRAN_DFT_BACKWARD) ||
+          srsran_dft_plan_c(&q->srs_dft[b], q->max_srs_re, SRSRAN_DFT_FORWARD)) {
+        ERROR("Error creating SRS DFT plans");
+        goto clean_exit;
+      }
+    }
+    q->srs_despread = srsran_vec_cf_malloc(q->max_srs_re);
+    q->srs_cir      = srsran_vec_cf_malloc(q->max_srs_re);
+    q->srs_window   = srsran_vec_cf_malloc(q->max_srs_re);
+    q->srs_residual = srsran_vec_cf_malloc(q->max_srs_re);
+    if (!q->srs_despread || !q->srs_cir || !q->srs_window || !q->srs_residual) {
+      perror("malloc");
+      goto clean_exit;
+    }
   }
 
   ret = SRSRAN_SUCCESS;
@@ -132,6 +158,27 @@ void srsran_chest_ul_free(srsran_chest_ul_t* q)
   if (q->pilot_known_signal) {
     free(q->pilot_known_signal);
   }
+  for (uint32_t b = 0; b < SRSRAN_CHEST_UL_SRS_NOF_B; b++) {
+    for (uint32_t i = 0; i < SRSRAN_NOF_SF_X_FRAME; i++) {
+      if (q->srs_base[b][i]) {
+        free(q->srs_base[b][i]);
+      }
+    }
+    srsran_dft_plan_free(&q->srs_idft[b]);
+    srsran_dft_plan_free(&q->srs_dft[b]);
+  }
+  if (q->srs_despread) {
+    free(q->srs_despread);
+  }
+  if (q->srs_cir) {
+    free(q->srs_cir);
+  }
+  if (q->srs_window) {
+    free(q->srs_window);
+  }
+  if (q->srs_residual) {
+    free(q->srs_residual);
+  }
   bzero(q, sizeof(srsran_chest_ul_t));
 }
 
@@ -177,6 +224,9 @@ int srsran_chest_ul_set_cell(srsran_chest_ul_t* q, srsran_cell_t cell)
         ERROR("Error initializing vector interpolator");
         return SRSRAN_ERROR;
       }
+
+      // The SRS base sequences depend on the cell
+      bzero(q->srs_base_M_sc, sizeof(q->srs_base_M_sc));
     }
     ret = SRSRAN_SUCCESS;
   }
@@ -399,8 +449,9 @@ int srsran_chest_ul_estimate_pusch(srsran_chest_ul_t*     q,
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
-  int nrefs_sym = nof_prb * SRSRAN_NRE;
-  int nrefs_sf  = nrefs_sym * SRSRAN_NOF_SLOTS_PER_SF;
+  uint64_t t0        = srsran_stage_prof_start();
+  int      nrefs_sym = nof_prb * SRSRAN_NRE;
+  int      nrefs_sf  = nrefs_sym * SRSRAN_NOF_SLOTS_PER_SF;
 
   /* Get references from the input signal */
   srsran_refsignal_dmrs_pusch_get(&q->dmrs_signal, cfg, input, q->pilot_recv_signal);
@@ -413,6 +464,7 @@ int srsran_chest_ul_estimate_pusch(srsran_chest_ul_t*     q,
 
   // Estimate
   chest_ul_estimate(q, SRSRAN_NOF_SLOTS_PER_SF, nrefs_sym, 1, cfg->meas_ta_en, true, cfg->grant.n_prb, res);
+  srsran_stage_prof_stop(SRSRAN_STAGE_PROF_CHEST, t0);
 
   return 0;
 }
@@ -472,11 +524,25 @@ int srsran_chest_ul_estimate_pucch(srsran_chest_ul_t*     q,
       m = 4;
     }
 
+    // The known pilots of the hypotheses only differ in the second DMRS symbol of each slot, which carries d(10). The
+    // estimates of every hypothesis are derived from the ones for d(10) = 1, given by the bits 0
+    cfg->pucch2_drs_bits[0] = 0;
+    cfg->pucch2_drs_bits[1] = 0;
+    srsran_refsignal_dmrs_pucch_gen(&q->dmrs_signal, sf, cfg, q->pilot_known_signal);
+    srsran_vec_prod_conj_ccc(q->pilot_recv_signal, q->pilot_known_signal, q->pilot_estimates_tmp[0], nrefs_sf);
+
     for (int i = 0; i < m; i++) {
-      cfg->pucch2_drs_bits[0] = i % 2;
-      cfg->pucch2_drs_bits[1] = i / 2;
-      srsran_refsignal_dmrs_pucch_gen(&q->dmrs_signal, sf, cfg, q->pilot_known_signal);
-      srsran_vec_prod_conj_ccc(q->pilot_recv_signal, q->pilot_known_signal, q->pilot_estimates_tmp[i], nrefs_sf);
+      if (i > 0) {
+        uint8_t bits[2] = {i % 2, i / 2};
+        cf_t    d_10    = 1.0f;
+        srsran_pucch_format2ab_mod_bits(cfg->format, bits, &d_10);
+
+        srsran_vec_cf_copy(q->pilot_estimates_tmp[i], q->pilot_estimates_tmp[0], nrefs_sf);
+        for (int ns = 0; ns < SRSRAN_NOF_SLOTS_PER_SF; ns++) {
+          cf_t* ce_m_1 = &q->pilot_estimates_tmp[i][(ns * n_rs + 1) * SRSRAN_NRE];
+          srsran_vec_sc_prod_ccc(ce_m_1, conjf(d_10), ce_m_1, SRSRAN_NRE);
+        }
+      }
       float x = cabsf(srsran_vec_acc_cc(q->pilot_estimates_tmp[i], nrefs_sf));
       if (x >= max) {
         max   = x;
@@ -624,3 +690,142 @@ int srsran_chest_ul_estimate_srs(srsran_chest_ul_t*                 q,
 
   return SRSRAN_SUCCESS;
 }
+
+/* Returns the SRS base sequence, without cyclic shift, of the subframe. It is only generated the first time. */
+static cf_t* chest_ul_srs_base(srsran_chest_ul_t*                 q,
+                               srsran_refsignal_srs_cfg_t*        cfg,
+                               srsran_refsignal_dmrs_pusch_cfg_t* pusch_cfg,
+                               uint32_t                           sf_idx,
+                               uint32_t                           M_sc)
+{
+  // The sequence group and number depend on the PUSCH DMRS common configuration
+  if (pusch_cfg->delta_ss != q->srs_base_pusch_cfg.delta_ss ||
+      pusch_cfg->group_hopping_en != q->srs_base_pusch_cfg.group_hopping_en ||
+      pusch_cfg->sequence_hopping_en != q->srs_base_pusch_cfg.sequence_hopping_en) {
+    bzero(q->srs_base_M_sc, sizeof(q->srs_base_M_sc));
+    q->srs_base_pusch_cfg = *pusch_cfg;
+  }
+
+  cf_t* base = q->srs_base[cfg->B][sf_idx];
+  if (q->srs_base_M_sc[cfg->B][sf_idx] != M_sc) {
+    srsran_refsignal_srs_cfg_t base_cfg = *cfg;
+    base_cfg.n_srs                      = 0;
+    if (srsran_refsignal_srs_gen(&q->dmrs_signal, &base_cfg, pusch_cfg, sf_idx, q->pilot_known_signal)) {
+      return NULL;
+    }
+    srsran_vec_cf_copy(base, q->pilot_known_signal, M_sc);
+    q->srs_base_M_sc[cfg->B][sf_idx] = M_sc;
+  }
+  return base;
+}
+
+/* Copies the time domain window of the cyclic shift n_srs from src into dst, or zeroes it in dst if src is NULL.
+ * The cyclic shifts are M_sc / 8 samples apart, a quarter of the window is left for negative delays. */
+static void chest_ul_srs_window(const cf_t* src, cf_t* dst, uint32_t M_sc, uint32_t n_srs)
+{
+  uint32_t len   = M_sc / SRSRAN_NOF_CSHIFT;
+  uint32_t start = (2 * M_sc - n_srs * len - len / 4) % M_sc;
+  for (uint32_t i = 0; i < len; i++) {
+    uint32_t k = (start + i) % M_sc;
+    dst[k]     = src ? src[k] : 0.0f;
+  }
+}
+
+static bool chest_ul_srs_same_group(srsran_chest_ul_t*          q,
+                                    srsran_refsignal_srs_cfg_t* a,
+                                    srsran_refsignal_srs_cfg_t* b,
+                                    uint32_t                    tti)
+{
+  return srsran_refsignal_srs_M_sc(&q->dmrs_signal, a) == srsran_refsignal_srs_M_sc(&q->dmrs_signal, b) &&
+         srsran_refsignal_srs_k0(&q->dmrs_signal, a, tti) == srsran_refsignal_srs_k0(&q->dmrs_signal, b, tti);
+}
+
+int srsran_chest_ul_estimate_srs_multi(srsran_chest_ul_t*                 q,
+                                       srsran_ul_sf_cfg_t*                sf,
+                                       srsran_refsignal_srs_cfg_t*        cfg[],
+                                       srsran_refsignal_dmrs_pusch_cfg_t* pusch_cfg,
+                                       cf_t*                              input,
+                                       srsran_chest_ul_res_t*             res[],
+                                       uint32_t                           nof_ue)
+{
+  if (q == NULL || sf == NULL || cfg == NULL || pusch_cfg == NULL || input == NULL || res == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  for (uint32_t i = 0; i < nof_ue; i++) {
+    if (cfg[i] == NULL || res[i] == NULL || cfg[i]->B >= SRSRAN_CHEST_UL_SRS_NOF_B) {
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+  }
+
+  uint32_t sf_idx = sf->tti % SRSRAN_NOF_SF_X_FRAME;
+  for (uint32_t i = 0; i < nof_ue; i++) {
+    // Skip the UEs already estimated in the group of a previous UE
+    bool done = false;
+    for (uint32_t j = 0; j < i && !done; j++) {
+      done = chest_ul_srs_same_group(q, cfg[i], cfg[j], sf->tti);
+    }
+    if (done) {
+      continue;
+    }
+
+    uint32_t M_sc = srsran_refsignal_srs_M_sc(&q->dmrs_signal, cfg[i]);
+    if (M_sc == 0 || M_sc > q->max_srs_re) {
+      ERROR("Invalid number of SRS subcarriers %d", M_sc);
+      return SRSRAN_ERROR;
+    }
+
+    cf_t* base = chest_ul_srs_base(q, cfg[i], pusch_cfg, sf_idx, M_sc);
+    if (base == NULL) {
+      return SRSRAN_ERROR;
+    }
+
+    srsran_dft_plan_t* idft = &q->srs_idft[cfg[i]->B];
+    srsran_dft_plan_t* dft  = &q->srs_dft[cfg[i]->B];
+    if (idft->size != M_sc) {
+      if (srsran_dft_replan_c(idft, M_sc) || srsran_dft_replan_c(dft, M_sc)) {
+        ERROR("Error replanning SRS DFT to %d points", M_sc);
+        return SRSRAN_ERROR;
+      }
+    }
+
+    // Extract and despread the SRS of the whole group once
+    if (srsran_refsignal_srs_get(&q->dmrs_signal, cfg[i], sf->tti, q->pilot_recv_signal, input) != SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    srsran_vec_prod_conj_ccc(q->pilot_recv_signal, base, q->srs_despread, M_sc);
+
+    // Every cyclic shift of the group shows up as a delayed channel impulse response
+    srsran_dft_run_c(idft, q->srs_despread, q->srs_cir);
+    srsran_vec_sc_prod_cfc(q->srs_cir, 1.0f / (float)M_sc, q->srs_cir, M_sc);
+
+    // The residual is what falls outside all the windows of the group, noise and interference
+    srsran_vec_cf_copy(q->srs_window, q->srs_cir, M_sc);
+    for (uint32_t j = i; j < nof_ue; j++) {
+      if (chest_ul_srs_same_group(q, cfg[i], cfg[j], sf->tti)) {
+        chest_ul_srs_window(NULL, q->srs_window, M_sc, cfg[j]->n_srs);
+      }
+    }
+    srsran_dft_run_c(dft, q->srs_window, q->srs_residual);
+
+    for (uint32_t j = i; j < nof_ue; j++) {
+      if (!chest_ul_srs_same_group(q, cfg[i], cfg[j], sf->tti)) {
+        continue;
+      }
+
+      // Own window back to frequency domain, plus the residual, as if the UE was alone
+      srsran_vec_cf_zero(q->srs_window, M_sc);
+      chest_ul_srs_window(q->srs_cir, q->srs_window, M_sc, cfg[j]->n_srs);
+      srsran_dft_run_c(dft, q->srs_window, q->srs_despread);
+      srsran_vec_sum_ccc(q->srs_despread, q->srs_residual, q->srs_despread, M_sc);
+
+      // Least squares estimates without the UE cyclic shift, and the received signal of the UE
+      srsran_vec_apply_cfo(q->srs_despread, -(float)cfg[j]->n_srs / SRSRAN_NOF_CSHIFT, q->pilot_estimates, M_sc);
+      srsran_vec_prod_ccc(q->srs_despread, base, q->pilot_recv_signal, M_sc);
+
+      uint32_t n_prb[2] = {};
+      chest_ul_estimate(q, 1, M_sc, 1, true, false, n_prb, res[j]);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
@@ -568,26 +568,51 @@ typedef struct {
   uint32_t nof_re;   ///< Total number of resource elements
 } csi_rs_nzp_resource_measure_t;
 
-static int csi_rs_nzp_measure_resource(const srsran_carrier_nr_t*          carrier,
-                                       const srsran_slot_cfg_t*            slot_cfg,
-                                       const srsran_csi_rs_nzp_resource_t* resource,
-                                       const cf_t*                         grid,
-                                       csi_rs_nzp_resource_measure_t*      measure)
+/**
+ * @brief Internal NZP-CSI-RS resource RE pattern, it is calculated once per resource and shared by all its symbols
+ */
+typedef struct {
+  uint32_t k_list[CSI_RS_MAX_SUBC_PRB]; ///< Subcarrier indexes within a resource block
+  uint32_t nof_k;                       ///< Number of subcarriers per resource block
+  uint32_t rb_begin;                    ///< First resource block
+  uint32_t rb_end;                      ///< Last resource block (excluded)
+  uint32_t rb_stride;                   ///< Resource block stride
+  uint32_t nof_re;                      ///< Number of RE per symbol
+  uint32_t nof_l;                       ///< Number of symbols
+} csi_rs_nzp_pattern_t;
+
+/**
+ * @brief Internal NZP-CSI-RS symbol measurement, one for every OFDM symbol of every measured resource
+ */
+typedef struct {
+  uint32_t resource_idx; ///< Index of the measured resource
+  uint32_t l;            ///< OFDM symbol index
+  uint32_t cinit;        ///< Sequence initialization value
+  uint32_t seq_offset;   ///< Number of skipped sequence RE, given by the first resource block
+  bool     done;         ///< Set to true once the symbol has been measured
+  float    epre;         ///< Linear EPRE
+  cf_t     corr;         ///< Correlation
+  float    delay;        ///< Normalised average delay
+} csi_rs_nzp_symbol_measure_t;
+
+static int csi_rs_nzp_pattern(const srsran_carrier_nr_t*          carrier,
+                              const srsran_csi_rs_nzp_resource_t* resource,
+                              csi_rs_nzp_pattern_t*               pattern)
 {
   // Force CDM group to 0
   uint32_t j = 0;
 
   // Get subcarrier indexes
-  uint32_t k_list[CSI_RS_MAX_SUBC_PRB];
-  int      nof_k = csi_rs_location_get_k_list(&resource->resource_mapping, j, k_list);
+  int nof_k = csi_rs_location_get_k_list(&resource->resource_mapping, j, pattern->k_list);
   if (nof_k <= 0) {
     return SRSRAN_ERROR;
   }
+  pattern->nof_k = (uint32_t)nof_k;
 
   // Calculate average CSI-RS RE stride
-  float avg_k_stride = (float)((k_list[0] + SRSRAN_NRE) - k_list[nof_k - 1]);
+  float avg_k_stride = (float)((pattern->k_list[0] + SRSRAN_NRE) - pattern->k_list[nof_k - 1]);
   for (uint32_t i = 1; i < (uint32_t)nof_k; i++) {
-    avg_k_stride += (float)(k_list[i] - k_list[i - 1]);
+    avg_k_stride += (float)(pattern->k_list[i] - pattern->k_list[i - 1]);
   }
   avg_k_stride /= (float)nof_k;
   if (!isnormal(avg_k_stride)) {
@@ -595,88 +620,160 @@ static int csi_rs_nzp_measure_resource(const srsran_carrier_nr_t*          carri
     return SRSRAN_ERROR;
   }
 
-  // Get symbol indexes
-  uint32_t l_list[CSI_RS_MAX_SYMBOLS_SLOT];
-  int      nof_l = csi_rs_location_get_l_list(&resource->resource_mapping, j, l_list);
-  if (nof_l <= 0) {
+  // Calculate Resource Block boundaries
+  pattern->rb_begin  = csi_rs_rb_begin(carrier, &resource->resource_mapping);
+  pattern->rb_end    = csi_rs_rb_end(carrier, &resource->resource_mapping);
+  pattern->rb_stride = csi_rs_rb_stride(&resource->resource_mapping);
+
+  // Calculate ideal number of RE per symbol
+  pattern->nof_re = csi_rs_count(resource->resource_mapping.density, pattern->rb_end - pattern->rb_begin);
+
+  return SRSRAN_SUCCESS;
+}
+
+static int csi_rs_nzp_measure_symbol(const srsran_carrier_nr_t*   carrier,
+                                     const csi_rs_nzp_pattern_t*  pattern,
+                                     const cf_t*                  r,
+                                     const cf_t*                  grid,
+                                     csi_rs_nzp_symbol_measure_t* symbol)
+{
+  // Temporal Least Square Estimates
+  cf_t        lse[CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR];
+  uint32_t    count_re = 0;
+  const cf_t* grid_l   = &grid[symbol->l * SRSRAN_NRE * carrier->nof_prb];
+
+  // Extract RE
+  for (uint32_t n = pattern->rb_begin; n < pattern->rb_end; n += pattern->rb_stride) {
+    for (uint32_t k_idx = 0; k_idx < pattern->nof_k; k_idx++) {
+      lse[count_re++] = grid_l[SRSRAN_NRE * n + pattern->k_list[k_idx]];
+    }
+  }
+
+  // Verify RE count matches the expected number of RE
+  if (count_re == 0 || count_re != pattern->nof_re) {
+    ERROR("Unmatched number of RE (%d != %d)", count_re, pattern->nof_re);
     return SRSRAN_ERROR;
   }
 
-  // Calculate Resource Block boundaries
-  uint32_t rb_begin  = csi_rs_rb_begin(carrier, &resource->resource_mapping);
-  uint32_t rb_end    = csi_rs_rb_end(carrier, &resource->resource_mapping);
-  uint32_t rb_stride = csi_rs_rb_stride(&resource->resource_mapping);
+  // Compute LSE
+  srsran_vec_prod_conj_ccc(lse, r, lse, count_re);
 
-  // Calculate ideal number of RE per symbol
-  uint32_t nof_re = csi_rs_count(resource->resource_mapping.density, rb_end - rb_begin);
+  // Compute average delay
+  symbol->delay = srsran_vec_estimate_frequency(lse, (int)count_re);
 
-  // Accumulators
-  float epre_acc  = 0.0f;
-  cf_t  corr_acc  = 0.0f;
-  float delay_acc = 0.0f;
+  // Pre-compensate delay to avoid RSRP measurements get affected by average delay
+  srsran_vec_apply_cfo(lse, symbol->delay, lse, (int)count_re);
 
-  // Initialise measurement
-  SRSRAN_MEM_ZERO(measure, csi_rs_nzp_resource_measure_t, 1);
+  // Compute EPRE
+  symbol->epre = srsran_vec_avg_power_cf(lse, count_re);
 
-  // Iterate time symbols
-  for (int l_idx = 0; l_idx < nof_l; l_idx++) {
-    // Get symbol index
-    uint32_t l = l_list[l_idx];
+  // Compute correlation
+  symbol->corr = srsran_vec_acc_cc(lse, count_re) / (float)count_re;
 
-    // Initialise sequence for this OFDM symbol
-    uint32_t                cinit          = csi_rs_cinit(carrier, slot_cfg, resource, l);
-    srsran_sequence_state_t sequence_state = {};
-    srsran_sequence_state_init(&sequence_state, cinit);
+  return SRSRAN_SUCCESS;
+}
 
-    // Skip unallocated RB
-    srsran_sequence_state_advance(&sequence_state, 2 * csi_rs_count(resource->resource_mapping.density, rb_begin));
+/**
+ * @brief Measures a batch of NZP-CSI-RS resources
+ *
+ * The RE pattern of every resource is calculated once. The symbols of all the resources are measured together and the
+ * pseudo-random sequence is generated once for all the symbols that share the initialization value, the first resource
+ * block and the number of RE, which is the case of the beam management resources transmitted in the same symbol.
+ */
+static int csi_rs_nzp_measure_resources(const srsran_carrier_nr_t*           carrier,
+                                        const srsran_slot_cfg_t*             slot_cfg,
+                                        const srsran_csi_rs_nzp_resource_t** resources,
+                                        uint32_t                             nof_resources,
+                                        const cf_t*                          grid,
+                                        csi_rs_nzp_resource_measure_t*       measurements)
+{
+  csi_rs_nzp_pattern_t        patterns[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET];
+  csi_rs_nzp_symbol_measure_t symbols[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET * CSI_RS_MAX_SYMBOLS_SLOT];
+  uint32_t                    nof_symbols = 0;
 
-    // Temporal Least Square Estimates
-    cf_t     lse[CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR];
-    uint32_t count_re = 0;
+  if (nof_resources > SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET) {
+    ERROR("Too many NZP-CSI-RS resources (%d)", nof_resources);
+    return SRSRAN_ERROR;
+  }
 
-    // Extract RE
-    for (uint32_t n = rb_begin; n < rb_end; n += rb_stride) {
-      for (uint32_t k_idx = 0; k_idx < nof_k; k_idx++) {
-        // Calculate sub-carrier index k
-        uint32_t k = SRSRAN_NRE * n + k_list[k_idx];
+  // Calculate the RE pattern and list the symbols of every resource
+  for (uint32_t i = 0; i < nof_resources; i++) {
+    const srsran_csi_rs_nzp_resource_t* resource = resources[i];
 
-        lse[count_re++] = grid[l * SRSRAN_NRE * carrier->nof_prb + k];
-      }
+    if (csi_rs_nzp_pattern(carrier, resource, &patterns[i]) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
     }
 
-    // Verify RE count matches the expected number of RE
-    if (count_re == 0 || count_re != nof_re) {
-      ERROR("Unmatched number of RE (%d != %d)", count_re, nof_re);
+    // Get symbol indexes, force CDM group to 0
+    uint32_t l_list[CSI_RS_MAX_SYMBOLS_SLOT];
+    int      nof_l = csi_rs_location_get_l_list(&resource->resource_mapping, 0, l_list);
+    if (nof_l <= 0) {
       return SRSRAN_ERROR;
     }
 
-    // Compute LSE
-    cf_t r[CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR];
-    srsran_sequence_state_gen_f(&sequence_state, M_SQRT1_2, (float*)r, 2 * count_re);
-    srsran_vec_prod_conj_ccc(lse, r, lse, count_re);
+    patterns[i].nof_l = (uint32_t)nof_l;
 
-    // Compute average delay
-    float delay = srsran_vec_estimate_frequency(lse, (int)count_re);
-    delay_acc += delay;
+    for (uint32_t l_idx = 0; l_idx < (uint32_t)nof_l; l_idx++) {
+      csi_rs_nzp_symbol_measure_t* symbol = &symbols[nof_symbols++];
+      symbol->resource_idx                = i;
+      symbol->l                           = l_list[l_idx];
+      symbol->cinit                       = csi_rs_cinit(carrier, slot_cfg, resource, l_list[l_idx]);
+      symbol->seq_offset                  = csi_rs_count(resource->resource_mapping.density, patterns[i].rb_begin);
+      symbol->done                        = false;
+    }
 
-    // Pre-compensate delay to avoid RSRP measurements get affected by average delay
-    srsran_vec_apply_cfo(lse, delay, lse, (int)count_re);
+    // Initialise measurement
+    SRSRAN_MEM_ZERO(&measurements[i], csi_rs_nzp_resource_measure_t, 1);
+    measurements[i].cri    = resource->id;
+    measurements[i].l0     = l_list[0];
+    measurements[i].nof_re = nof_l * patterns[i].nof_re;
+  }
 
-    // Compute EPRE
-    epre_acc += srsran_vec_avg_power_cf(lse, count_re);
+  // Measure all symbols, grouping them by sequence
+  for (uint32_t i = 0; i < nof_symbols; i++) {
+    if (symbols[i].done) {
+      continue;
+    }
 
-    // Compute correlation
-    corr_acc += srsran_vec_acc_cc(lse, count_re) / (float)count_re;
+    // Generate the sequence for this group
+    uint32_t                nof_re         = patterns[symbols[i].resource_idx].nof_re;
+    cf_t                    r[CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR];
+    srsran_sequence_state_t sequence_state = {};
+    srsran_sequence_state_init(&sequence_state, symbols[i].cinit);
+    srsran_sequence_state_advance(&sequence_state, 2 * symbols[i].seq_offset);
+    srsran_sequence_state_gen_f(&sequence_state, M_SQRT1_2, (float*)r, 2 * nof_re);
+
+    for (uint32_t j = i; j < nof_symbols; j++) {
+      csi_rs_nzp_symbol_measure_t* symbol  = &symbols[j];
+      const csi_rs_nzp_pattern_t*  pattern = &patterns[symbol->resource_idx];
+      if (symbol->done || symbol->cinit != symbols[i].cinit || symbol->seq_offset != symbols[i].seq_offset ||
+          pattern->nof_re != nof_re) {
+        continue;
+      }
+
+      if (csi_rs_nzp_measure_symbol(carrier, pattern, r, grid, symbol) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+      symbol->done = true;
+    }
   }
 
-  // Set measure fields
-  measure->cri      = resource->id;
-  measure->l0       = l_list[0];
-  measure->epre     = epre_acc / (float)nof_l;
-  measure->corr     = corr_acc / (float)nof_l;
-  measure->delay_us = 1e6f * delay_acc / ((float)nof_l * SRSRAN_SUBC_SPACING_NR(carrier->scs));
-  measure->nof_re   = nof_l * nof_re;
+  // Accumulate the symbol measurements of every resource, in symbol order
+  float delay_acc[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET] = {};
+  for (uint32_t i = 0; i < nof_symbols; i++) {
+    csi_rs_nzp_resource_measure_t* m = &measurements[symbols[i].resource_idx];
+    m->epre += symbols[i].epre;
+    m->corr += symbols[i].corr;
+    delay_acc[symbols[i].resource_idx] += symbols[i].delay;
+  }
+
+  // Average over the symbols
+  for (uint32_t i = 0; i < nof_resources; i++) {
+    float nof_l              = (float)patterns[i].nof_l;
+    measurements[i].epre     = measurements[i].epre / nof_l;
+    measurements[i].corr     = measurements[i].corr / nof_l;
+    measurements[i].delay_us = 1e6f * delay_acc[i] / (nof_l * SRSRAN_SUBC_SPACING_NR(carrier->scs));
+  }
 
   return SRSRAN_SUCCESS;
 }
@@ -687,21 +784,20 @@ static int csi_rs_nzp_measure_set(const srsran_carrier_nr_t*     carrier,
                                   const cf_t*                    grid,
                                   csi_rs_nzp_resource_measure_t  measurements[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET])
 {
-  uint32_t count = 0;
+  const srsran_csi_rs_nzp_resource_t* resources[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET];
+  uint32_t                            count = 0;
 
-  // Iterate all resources in set
-  for (uint32_t i = 0; i < set->count; i++) {
-    // Skip resource
-    if (!srsran_csi_rs_send(&set->data[i].periodicity, slot_cfg)) {
-      continue;
+  // Select the resources of the set transmitted in this slot
+  for (uint32_t i = 0; i < set->count && i < SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET; i++) {
+    if (srsran_csi_rs_send(&set->data[i].periodicity, slot_cfg)) {
+      resources[count++] = &set->data[i];
     }
+  }
 
-    // Perform measurement
-    if (csi_rs_nzp_measure_resource(carrier, slot_cfg, &set->data[i], grid, &measurements[count]) < SRSRAN_SUCCESS) {
-      ERROR("Error measuring NZP-CSI-RS resource");
-      return SRSRAN_ERROR;
-    }
-    count++;
+  // Perform measurements
+  if (csi_rs_nzp_measure_resources(carrier, slot_cfg, resources, count, grid, measurements) < SRSRAN_SUCCESS) {
+    ERROR("Error measuring NZP-CSI-RS resource");
+    return SRSRAN_ERROR;
   }
 
   return count;
@@ -718,7 +814,7 @@ int srsran_csi_rs_nzp_measure(const srsran_carrier_nr_t*          carrier,
   }
 
   csi_rs_nzp_resource_measure_t m = {};
-  if (csi_rs_nzp_measure_resource(carrier, slot_cfg, resource, grid, &m) < SRSRAN_SUCCESS) {
+  if (csi_rs_nzp_measure_resources(carrier, slot_cfg, &resource, 1, grid, &m) < SRSRAN_SUCCESS) {
     ERROR("Error measuring NZP-CSI-RS resource");
     return SRSRAN_ERROR;
   }
@@ -909,6 +1005,51 @@ int srsran_csi_rs_nzp_measure_channel(const srsran_carrier_nr_t*         carrier
   return count;
 }
 
+int srsran_csi_rs_nzp_measure_resources(
+    const srsran_carrier_nr_t*        carrier,
+    const srsran_slot_cfg_t*          slot_cfg,
+    const srsran_csi_rs_nzp_set_t*    set,
+    const cf_t*                       grid,
+    srsran_csi_channel_measurements_t measurements[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET])
+{
+  // Verify inputs
+  if (carrier == NULL || slot_cfg == NULL || set == NULL || grid == NULL || measurements == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  // Perform Measurements
+  csi_rs_nzp_resource_measure_t m[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET];
+  int                           ret = csi_rs_nzp_measure_set(carrier, slot_cfg, set, grid, m);
+
+  // Return to prevent assigning negative values to count
+  if (ret < SRSRAN_SUCCESS) {
+    ERROR("Error performing measurements");
+    return SRSRAN_ERROR;
+  }
+  uint32_t count = (uint32_t)ret;
+
+  // Report every resource separately
+  for (uint32_t i = 0; i < count; i++) {
+    float rsrp = SRSRAN_CSQABS(m[i].corr);
+
+    // Estimate noise from EPRE and RSPR
+    float n0 = 0.0f;
+    if (m[i].epre > rsrp) {
+      n0 = m[i].epre - rsrp;
+    }
+
+    measurements[i].cri               = m[i].cri;
+    measurements[i].wideband_rsrp_dBm = srsran_convert_power_to_dB(rsrp);
+    measurements[i].wideband_epre_dBm = srsran_convert_power_to_dB(m[i].epre);
+    measurements[i].wideband_snr_db   = measurements[i].wideband_rsrp_dBm - srsran_convert_power_to_dB(n0);
+    measurements[i].K_csi_rs          = count;
+    measurements[i].nof_ports         = 1; // No other value is currently supported
+  }
+
+  // Return the number of active resources for this slot
+  return count;
+}
+
 /**
  * @brief Internal ZP-CSI-RS measurement structure
  */
@@ -511,6 +511,71 @@ int srsran_refsignal_dmrs_pucch_gen(srsran_refsignal_ul_t* q,
   return ret;
 }
 
+void srsran_refsignal_dmrs_pucch_cache_reset(srsran_refsignal_dmrs_pucch_cache_t* cache)
+{
+  if (cache) {
+    for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+      for (uint32_t way = 0; way < SRSRAN_REFSIGNAL_PUCCH_CACHE_WAYS; way++) {
+        cache->entry[sf_idx][way].valid = false;
+      }
+      cache->next_way[sf_idx] = 0;
+    }
+  }
+}
+
+static bool dmrs_pucch_cache_match(const srsran_refsignal_dmrs_pucch_cache_entry_t* e, const srsran_pucch_cfg_t* cfg)
+{
+  if (!e->valid || e->format != cfg->format || e->n_pucch != cfg->n_pucch || e->N_cs != cfg->N_cs ||
+      e->delta_pucch_shift != cfg->delta_pucch_shift || e->n_rb_2 != cfg->n_rb_2 ||
+      e->group_hopping_en != cfg->group_hopping_en) {
+    return false;
+  }
+  // The second DMRS symbol of formats 2a/2b carries the HARQ-ACK bits
+  if (cfg->format == SRSRAN_PUCCH_FORMAT_2A || cfg->format == SRSRAN_PUCCH_FORMAT_2B) {
+    return e->drs_bits[0] == cfg->pucch2_drs_bits[0] && e->drs_bits[1] == cfg->pucch2_drs_bits[1];
+  }
+  return true;
+}
+
+cf_t* srsran_refsignal_dmrs_pucch_cache_get(srsran_refsignal_ul_t*               q,
+                                            srsran_refsignal_dmrs_pucch_cache_t* cache,
+                                            srsran_ul_sf_cfg_t*                  sf,
+                                            srsran_pucch_cfg_t*                  cfg)
+{
+  if (!q || !cache || !sf || !cfg) {
+    return NULL;
+  }
+
+  uint32_t                                   sf_idx  = sf->tti % SRSRAN_NOF_SF_X_FRAME;
+  srsran_refsignal_dmrs_pucch_cache_entry_t* entries = cache->entry[sf_idx];
+  for (uint32_t way = 0; way < SRSRAN_REFSIGNAL_PUCCH_CACHE_WAYS; way++) {
+    if (dmrs_pucch_cache_match(&entries[way], cfg)) {
+      cache->nof_hits++;
+      return entries[way].r;
+    }
+  }
+
+  // Replace the entries of the subframe in round-robin
+  srsran_refsignal_dmrs_pucch_cache_entry_t* e = &entries[cache->next_way[sf_idx]];
+  cache->next_way[sf_idx]                      = (cache->next_way[sf_idx] + 1) % SRSRAN_REFSIGNAL_PUCCH_CACHE_WAYS;
+  cache->nof_misses++;
+
+  e->valid = false;
+  if (srsran_refsignal_dmrs_pucch_gen(q, sf, cfg, e->r)) {
+    return NULL;
+  }
+  e->valid             = true;
+  e->format            = cfg->format;
+  e->n_pucch           = cfg->n_pucch;
+  e->N_cs              = cfg->N_cs;
+  e->delta_pucch_shift = cfg->delta_pucch_shift;
+  e->n_rb_2            = cfg->n_rb_2;
+  e->group_hopping_en  = cfg->group_hopping_en;
+  e->drs_bits[0]       = cfg->pucch2_drs_bits[0];
+  e->drs_bits[1]       = cfg->pucch2_drs_bits[1];
+  return e->r;
+}
+
 int srsran_refsignal_dmrs_pucch_cp(srsran_refsignal_ul_t* q,
                                    srsran_pucch_cfg_t*    cfg,
                                    cf_t*                  source,
@@ -829,6 +894,11 @@ uint32_t srsran_refsignal_srs_M_sc(srsran_refsignal_ul_t* q, srsran_refsignal_sr
   return m_srs_b[srsbwtable_idx(q->cell.nof_prb)][cfg->B][cfg->bw_cfg] * SRSRAN_NRE / 2;
 }
 
+uint32_t srsran_refsignal_srs_k0(srsran_refsignal_ul_t* q, srsran_refsignal_srs_cfg_t* cfg, uint32_t tti)
+{
+  return srs_k0_ue(cfg, q->cell.nof_prb, tti);
+}
+
 int srsran_refsignal_srs_pregen(srsran_refsignal_ul_t*             q,
                                 srsran_refsignal_srs_pregen_t*     pregen,
                                 srsran_refsignal_srs_cfg_t*        cfg,
@@ -35,16 +35,18 @@ srsran_cell_t cell = {6,              // nof_prb
                       SRSRAN_PHICH_R_1_6,
                       SRSRAN_FDD};
 
-char* output_matlab = NULL;
+char*    output_matlab = NULL;
+uint32_t pilot_avg_len = 0;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [recov]\n", prog);
+  printf("Usage: %s [recaov]\n", prog);
 
   printf("\t-r nof_prb [Default %d]\n", cell.nof_prb);
   printf("\t-e extended cyclic prefix [Default normal]\n");
 
   printf("\t-c cell_id (1000 tests all). [Default %d]\n", cell.id);
+  printf("\t-a number of subframes the pilots are averaged over [Default %d]\n", pilot_avg_len);
 
   printf("\t-o output matlab file [Default %s]\n", output_matlab ? output_matlab : "None");
   printf("\t-v increase verbosity\n");
@@ -53,7 +55,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "recov")) != -1) {
+  while ((opt = getopt(argc, argv, "recaov")) != -1) {
     switch (opt) {
       case 'r':
         cell.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -64,6 +66,9 @@ void parse_args(int argc, char** argv)
       case 'c':
         cell.id = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'a':
+        pilot_avg_len = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'o':
         output_matlab = argv[optind];
         break;
@@ -164,6 +169,9 @@ int main(int argc, char** argv)
       }
 
       srsran_chest_dl_res_t res;
+      srsran_chest_dl_cfg_t chest_cfg;
+      ZERO_OBJECT(chest_cfg);
+      chest_cfg.pilot_avg_len = pilot_avg_len;
 
       res.ce[0][0] = ce;
 
@@ -173,7 +181,7 @@ int main(int argc, char** argv)
       struct timeval t[3];
       gettimeofday(&t[1], NULL);
       for (int k = 0; k < 100; k++) {
-        srsran_chest_dl_estimate(&est, &sf_cfg, input_m, &res);
+        srsran_chest_dl_estimate_cfg(&est, &sf_cfg, &chest_cfg, input_m, &res);
       }
       gettimeofday(&t[2], NULL);
       get_time_interval(t);
@@ -170,6 +170,68 @@ int srs_test_context_run(srs_test_context_t* q)
   return SRSRAN_SUCCESS;
 }
 
+#define SRS_MULTI_NOF_UE 5
+
+/* Four UEs in the same comb with different cyclic shifts and gains, and one more UE in the other comb */
+int srs_test_multi_ue(srs_test_context_t* q)
+{
+  static const uint32_t n_srs[SRS_MULTI_NOF_UE]   = {0, 2, 5, 7, 3};
+  static const uint32_t k_tc[SRS_MULTI_NOF_UE]    = {0, 0, 0, 0, 1};
+  static const float    gain_db[SRS_MULTI_NOF_UE] = {0.0f, -6.0f, 3.0f, -3.0f, 0.0f};
+
+  srsran_ul_sf_cfg_t          ul_sf_cfg = {};
+  srsran_refsignal_srs_cfg_t  ue_cfg[SRS_MULTI_NOF_UE];
+  srsran_refsignal_srs_cfg_t* ue_cfg_ptr[SRS_MULTI_NOF_UE];
+  srsran_chest_ul_res_t       ue_res[SRS_MULTI_NOF_UE];
+  srsran_chest_ul_res_t*      ue_res_ptr[SRS_MULTI_NOF_UE];
+
+  cf_t* r_srs  = srsran_vec_cf_malloc(SRSRAN_MAX_PRB * SRSRAN_NRE);
+  cf_t* ue_sym = srsran_vec_cf_malloc(q->sf_size);
+  TESTASSERT(r_srs != NULL && ue_sym != NULL);
+
+  // The received signal is the sum of the UE signals
+  srsran_vec_cf_zero(q->sf_symbols, q->sf_size);
+  for (uint32_t i = 0; i < SRS_MULTI_NOF_UE; i++) {
+    ue_cfg[i]       = srs_cfg;
+    ue_cfg[i].n_srs = n_srs[i];
+    ue_cfg[i].k_tc  = k_tc[i];
+    ue_cfg_ptr[i]   = &ue_cfg[i];
+    ue_res_ptr[i]   = &ue_res[i];
+    TESTASSERT(srsran_chest_ul_res_init(&ue_res[i], cell.nof_prb) == SRSRAN_SUCCESS);
+
+    uint32_t M_sc = srsran_refsignal_srs_M_sc(&q->refsignal_ul, &ue_cfg[i]);
+    TESTASSERT(srsran_refsignal_srs_gen(&q->refsignal_ul, &ue_cfg[i], &dmrs_pusch_cfg, ul_sf_cfg.tti, r_srs) ==
+               SRSRAN_SUCCESS);
+    srsran_vec_sc_prod_cfc(r_srs, srsran_convert_dB_to_amplitude(gain_db[i]), r_srs, M_sc);
+
+    srsran_vec_cf_zero(ue_sym, q->sf_size);
+    TESTASSERT(srsran_refsignal_srs_put(&q->refsignal_ul, &ue_cfg[i], ul_sf_cfg.tti, r_srs, ue_sym) ==
+               SRSRAN_SUCCESS);
+    srsran_vec_sum_ccc(q->sf_symbols, ue_sym, q->sf_symbols, q->sf_size);
+  }
+
+  TESTASSERT(srsran_chest_ul_estimate_srs_multi(
+                 &q->chest_ul, &ul_sf_cfg, ue_cfg_ptr, &dmrs_pusch_cfg, q->sf_symbols, ue_res_ptr, SRS_MULTI_NOF_UE) ==
+             SRSRAN_SUCCESS);
+
+  // Every UE is measured without the others
+  for (uint32_t i = 0; i < SRS_MULTI_NOF_UE; i++) {
+    INFO("MULTI-UE: n_srs=%d; k_tc=%d; epre_dbfs=%+.1f; ta_us=%+.1f;",
+         n_srs[i],
+         k_tc[i],
+         ue_res[i].epre_dBfs,
+         ue_res[i].ta_us);
+    TESTASSERT(fabsf(ue_res[i].epre_dBfs - gain_db[i]) < 0.5f);
+    TESTASSERT(fabsf(ue_res[i].ta_us) < CHEST_TEST_SRS_TA_US_TOLERANCE);
+    srsran_chest_ul_res_free(&ue_res[i]);
+  }
+
+  free(r_srs);
+  free(ue_sym);
+
+  return SRSRAN_SUCCESS;
+}
+
 void parse_args(int argc, char** argv)
 {
   int opt;
@@ -241,6 +303,21 @@ int main(int argc, char** argv)
     }
   }
 
+  // Several UEs in the same SRS symbol, with the widest SRS bandwidth of the first configuration
+  if (!ret) {
+    srs_cfg       = (srsran_refsignal_srs_cfg_t){};
+    srs_cfg.B     = 0;
+    srs_cfg.I_srs = 0;
+    ret           = srs_test_context_init(&context);
+    if (!ret) {
+      ret = srs_test_multi_ue(&context);
+    }
+    srs_test_context_free(&context);
+    if (!ret) {
+      test_counter++;
+    }
+  }
+
   srsran_channel_awgn_free(&channel);
 
   if (!ret) {
@@ -330,6 +330,70 @@ static int nzp_test_trs(srsran_channel_awgn_t* awgn, cf_t* grid)
   return SRSRAN_SUCCESS;
 }
 
+static int nzp_test_resources(srsran_channel_awgn_t* awgn, cf_t* grid)
+{
+  srsran_slot_cfg_t slot_cfg = {};
+
+  // Beam management like set: four single port resources sharing the symbol 4 and two more in the symbol 9, the last
+  // one is transmitted in the next slot
+  srsran_csi_rs_nzp_set_t set = {};
+  for (uint32_t i = 0; i < 6; i++) {
+    srsran_csi_rs_nzp_resource_t* resource                   = &set.data[set.count++];
+    resource->id                                             = i;
+    resource->resource_mapping.frequency_domain_alloc[i % 4] = 1;
+    resource->resource_mapping.nof_ports                     = 1;
+    resource->resource_mapping.first_symbol_idx              = (i < 4) ? 4 : 9;
+    resource->resource_mapping.cdm                           = srsran_csi_rs_cdm_nocdm;
+    resource->resource_mapping.density                       = srsran_csi_rs_resource_mapping_density_three;
+    resource->resource_mapping.freq_band.start_rb            = 0;
+    resource->resource_mapping.freq_band.nof_rb              = carrier.nof_prb;
+    resource->power_control_offset                           = 2.0f * (float)i;
+    resource->scrambling_id                                  = 1;
+    resource->periodicity.period                             = 20;
+    resource->periodicity.offset                             = (i == 5) ? 1 : 0;
+  }
+
+  for (slot_cfg.idx = 0; slot_cfg.idx < 2; slot_cfg.idx++) {
+    srsran_vec_cf_zero(grid, SRSRAN_SLOT_LEN_RE_NR(carrier.nof_prb));
+    int nof_active = srsran_csi_rs_nzp_put_set(&carrier, &slot_cfg, &set, grid);
+    TESTASSERT(nof_active == ((slot_cfg.idx == 0) ? 5 : 1));
+
+    // Add noise relative to the lowest power resource
+    TESTASSERT(srsran_channel_awgn_set_n0(awgn, -snr_dB) == SRSRAN_SUCCESS);
+    srsran_channel_awgn_run_c(awgn, grid, grid, SRSRAN_SLOT_LEN_RE_NR(carrier.nof_prb));
+
+    srsran_csi_channel_measurements_t measurements[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET] = {};
+    TESTASSERT(srsran_csi_rs_nzp_measure_resources(&carrier, &slot_cfg, &set, grid, measurements) == nof_active);
+
+    // The batched measurements shall be the same as measuring each resource on its own
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < set.count; i++) {
+      if (!srsran_csi_rs_send(&set.data[i].periodicity, &slot_cfg)) {
+        continue;
+      }
+
+      srsran_csi_trs_measurements_t measure = {};
+      TESTASSERT(srsran_csi_rs_nzp_measure(&carrier, &slot_cfg, &set.data[i], grid, &measure) == SRSRAN_SUCCESS);
+
+      const srsran_csi_channel_measurements_t* m = &measurements[count++];
+      INFO("Resource %d: rsrp=%+.2f epre=%+.2f snr=%+.2f",
+           m->cri,
+           m->wideband_rsrp_dBm,
+           m->wideband_epre_dBm,
+           m->wideband_snr_db);
+
+      TESTASSERT(m->cri == set.data[i].id);
+      TESTASSERT(m->K_csi_rs == (uint32_t)nof_active);
+      TESTASSERT(fabsf(m->wideband_rsrp_dBm - measure.rsrp_dB) < 1e-3f);
+      TESTASSERT(fabsf(m->wideband_epre_dBm - measure.epre_dB) < 1e-3f);
+      TESTASSERT(fabsf(m->wideband_snr_db - measure.snr_dB) < 1e-3f);
+      TESTASSERT(fabsf(m->wideband_rsrp_dBm - (float)set.data[i].power_control_offset) < 1.0f);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 static void usage(char* prog)
 {
   printf("Usage: %s [recov]\n", prog);
@@ -405,6 +469,10 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
+  if (nzp_test_resources(&awgn, grid) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
   ret = SRSRAN_SUCCESS;
 
 clean_exit:
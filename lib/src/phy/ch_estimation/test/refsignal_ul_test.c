@@ -75,6 +75,51 @@ void parse_args(int argc, char** argv)
   }
 }
 
+static int test_dmrs_pucch_cache(srsran_refsignal_ul_t* refs)
+{
+  static srsran_refsignal_dmrs_pucch_cache_t cache = {};
+  cf_t r_ref[SRSRAN_NOF_SLOTS_PER_SF * SRSRAN_REFSIGNAL_PUCCH_MAX_N_RS * SRSRAN_NRE];
+
+  srsran_pucch_cfg_t pucch_cfg = {};
+  pucch_cfg.delta_pucch_shift  = 2;
+  pucch_cfg.N_cs               = 0;
+  pucch_cfg.n_rb_2             = 2;
+  srsran_refsignal_dmrs_pucch_cache_reset(&cache);
+
+  srsran_pucch_format_t formats[] = {SRSRAN_PUCCH_FORMAT_1A, SRSRAN_PUCCH_FORMAT_2, SRSRAN_PUCCH_FORMAT_2B};
+  for (uint32_t rep = 0; rep < 2; rep++) {
+    for (uint32_t f = 0; f < sizeof(formats) / sizeof(formats[0]); f++) {
+      for (uint32_t tti = 0; tti < 20; tti++) {
+        srsran_ul_sf_cfg_t sf        = {};
+        sf.tti                       = tti;
+        pucch_cfg.format             = formats[f];
+        pucch_cfg.n_pucch            = 3 + f;
+        pucch_cfg.pucch2_drs_bits[0] = tti % 2;
+        pucch_cfg.pucch2_drs_bits[1] = (tti / 2) % 2;
+
+        cf_t* r_cached = srsran_refsignal_dmrs_pucch_cache_get(refs, &cache, &sf, &pucch_cfg);
+        if (r_cached == NULL || srsran_refsignal_dmrs_pucch_gen(refs, &sf, &pucch_cfg, r_ref)) {
+          ERROR("Error generating PUCCH DMRS");
+          return SRSRAN_ERROR;
+        }
+        uint32_t nof_re = SRSRAN_NOF_SLOTS_PER_SF * srsran_refsignal_dmrs_N_rs(formats[f], refs->cell.cp) * SRSRAN_NRE;
+        if (memcmp(r_cached, r_ref, nof_re * sizeof(cf_t)) != 0) {
+          ERROR("Cached PUCCH DMRS of format %d differ in tti=%d", formats[f], tti);
+          return SRSRAN_ERROR;
+        }
+      }
+    }
+  }
+
+  // The second pass finds all the DMRS in the cache
+  printf("PUCCH DMRS cache: %" PRIu64 " hits, %" PRIu64 " misses\n", cache.nof_hits, cache.nof_misses);
+  if (cache.nof_hits == 0) {
+    ERROR("The PUCCH DMRS were never reused");
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   srsran_refsignal_ul_t             refs      = {};
@@ -96,6 +141,10 @@ int main(int argc, char** argv)
   }
   printf("Running tests for %d PRB\n", cell.nof_prb);
 
+  if (test_dmrs_pucch_cache(&refs)) {
+    goto do_exit;
+  }
+
   for (int n = 6; n < cell.nof_prb; n++) {
     for (int delta_ss = 29; delta_ss < SRSRAN_NOF_DELTA_SS; delta_ss++) {
       for (int cshift = 0; cshift < SRSRAN_NOF_CSHIFT; cshift++) {
@@ -314,6 +314,12 @@ int srsran_wiener_dl_init(srsran_wiener_dl_t* q, uint32_t max_prb, uint32_t max_
       srsran_dft_run_c(&q->fft, q->filter, q->filter);
     }
 
+    // Initialise the linear SNR of each cache bin, the last bin is saturated by the Wiener noise term limit
+    for (uint32_t i = 0; i < SRSRAN_WIENER_DL_NOF_SNR_BINS; i++) {
+      q->snr_bin_lin[i] = SRSRAN_MIN(15.0f, srsran_convert_dB_to_power(SRSRAN_WIENER_DL_SNR_MIN_DB +
+                                                                        SRSRAN_WIENER_DL_SNR_STEP_DB * i));
+    }
+
     // Initialise matrix inverter
     if (!ret) {
       q->matrix_inverter = calloc(sizeof(srsran_matrix_NxN_inv_t), 1);
@@ -365,9 +371,11 @@ void srsran_wiener_dl_reset(srsran_wiener_dl_t* q)
       }
     }
 
-    // Reset wiener
-    bzero(q->wm1, NSAMPLES2NBYTES(SRSRAN_WIENER_DL_MIN_REF * SRSRAN_WIENER_DL_MIN_RE));
-    bzero(q->wm2, NSAMPLES2NBYTES(SRSRAN_WIENER_DL_MIN_REF * SRSRAN_WIENER_DL_MIN_RE));
+    // Reset wiener matrices cache
+    bzero(q->cache, sizeof(q->cache));
+    q->wm           = &q->cache[0];
+    q->cache_hits   = 0;
+    q->cache_misses = 0;
   }
 }
 
@@ -464,84 +472,63 @@ static inline uint32_t vec_find_first_smaller_than_cf(cf_t* x, float y, uint32_t
   return ret;
 }
 
-static inline cf_t _srsran_vec_dot_prod_ccc_simd(const cf_t* x, const cf_t* y, const int len)
+/* Computes y[i] = sum_k x[k] * a[k][offset + i] for i = 0..n-1, that is, the product of a row vector by a matrix
+ * stored transposed. The reference signals are broadcast and the resource elements run along the SIMD lanes. */
+static void matrix_vec_prod_ccc(const cf_t  a[SRSRAN_WIENER_DL_MIN_REF][SRSRAN_WIENER_DL_MIN_RE],
+                                uint32_t    offset,
+                                const cf_t* x,
+                                cf_t*       y,
+                                uint32_t    n)
 {
-  int  i      = 0;
-  cf_t result = 0;
+  uint32_t i = 0;
 
 #if SRSRAN_SIMD_CF_SIZE
-  if (len >= SRSRAN_SIMD_CF_SIZE) {
-    simd_cf_t avx_result = srsran_simd_cf_zero();
-    for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
-      simd_cf_t xVal = srsran_simd_cfi_loadu(&x[i]);
-      simd_cf_t yVal = srsran_simd_cfi_loadu(&y[i]);
-
-      avx_result = srsran_simd_cf_add(srsran_simd_cf_prod(xVal, yVal), avx_result);
-    }
-
-    __attribute__((aligned(64))) float simd_dotProdVector[SRSRAN_SIMD_CF_SIZE];
-    simd_f_t                           acc_re = srsran_simd_cf_re(avx_result);
-    simd_f_t                           acc_im = srsran_simd_cf_im(avx_result);
+  simd_cf_t xv[SRSRAN_WIENER_DL_MIN_REF];
+  for (uint32_t k = 0; k < SRSRAN_WIENER_DL_MIN_REF; k++) {
+    xv[k] = srsran_simd_cf_set1(x[k]);
+  }
 
-    simd_f_t acc = srsran_simd_f_hadd(acc_re, acc_im);
-    for (int j = 2; j < SRSRAN_SIMD_F_SIZE; j *= 2) {
-      acc = srsran_simd_f_hadd(acc, acc);
+  for (; i + SRSRAN_SIMD_CF_SIZE <= n; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t acc = srsran_simd_cf_prod(xv[0], srsran_simd_cfi_loadu(&a[0][offset + i]));
+    for (uint32_t k = 1; k < SRSRAN_WIENER_DL_MIN_REF; k++) {
+      acc = srsran_simd_cf_add(acc, srsran_simd_cf_prod(xv[k], srsran_simd_cfi_loadu(&a[k][offset + i])));
     }
-    srsran_simd_f_store(simd_dotProdVector, acc);
-    __real__ result = simd_dotProdVector[0];
-    __imag__ result = simd_dotProdVector[1];
+    srsran_simd_cfi_storeu(&y[i], acc);
   }
 #endif
 
-  for (; i < len; i++) {
-    result += (x[i] * y[i]);
+  for (; i < n; i++) {
+    cf_t acc = 0.0f;
+    for (uint32_t k = 0; k < SRSRAN_WIENER_DL_MIN_REF; k++) {
+      acc += x[k] * a[k][offset + i];
+    }
+    y[i] = acc;
   }
-
-  return result;
 }
 
 static void estimate_wiener(srsran_wiener_dl_t* q,
-                            const cf_t          wm[SRSRAN_WIENER_DL_MIN_RE][SRSRAN_WIENER_DL_MIN_REF],
+                            const cf_t          wm[SRSRAN_WIENER_DL_MIN_REF][SRSRAN_WIENER_DL_MIN_RE],
                             cf_t*               ref,
                             cf_t*               h)
 {
-  uint32_t r_offset = 0; // Resource Element indexing offset
-  uint32_t p_offset = 0; // Pilot indexing offset
-
   // Estimate lower band
-  for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_RE; i++) {
-    h[r_offset + i] = _srsran_vec_dot_prod_ccc_simd(&ref[p_offset], wm[i], SRSRAN_WIENER_DL_MIN_REF);
-  }
+  matrix_vec_prod_ccc(wm, 0, ref, h, SRSRAN_WIENER_DL_MIN_RE);
 
   // Estimate Upper band (it might overlap in 6PRB cells with the lower band)
-  r_offset = q->nof_re - SRSRAN_WIENER_DL_MIN_RE;
-  p_offset = q->nof_ref - SRSRAN_WIENER_DL_MIN_REF;
-  for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_RE; i++) {
-    h[r_offset + i] = _srsran_vec_dot_prod_ccc_simd(&ref[p_offset], wm[i], SRSRAN_WIENER_DL_MIN_REF);
-  }
+  matrix_vec_prod_ccc(wm,
+                      0,
+                      &ref[q->nof_ref - SRSRAN_WIENER_DL_MIN_REF],
+                      &h[q->nof_re - SRSRAN_WIENER_DL_MIN_RE],
+                      SRSRAN_WIENER_DL_MIN_RE);
 
   // Estimate center Resource elements
   if (q->nof_re > 2 * SRSRAN_WIENER_DL_MIN_RE) {
     for (uint32_t prb = 2; prb < q->nof_prb - 2; prb += 2) {
-      p_offset = (prb - 1) * 2;
-      r_offset = prb * SRSRAN_NRE;
-      for (uint32_t i = 0; i < SRSRAN_NRE * 2; i++) {
-        h[r_offset + i] = _srsran_vec_dot_prod_ccc_simd(&ref[p_offset], wm[i + SRSRAN_NRE], SRSRAN_WIENER_DL_MIN_REF);
-      }
+      matrix_vec_prod_ccc(wm, SRSRAN_NRE, &ref[(prb - 1) * 2], &h[prb * SRSRAN_NRE], SRSRAN_NRE * 2);
     }
   }
 }
 
-inline static cf_t _cmul(cf_t a, cf_t b)
-{
-  cf_t ret = 0;
-
-  __real__ ret = __real__ a * __real__ b - __imag__ a * __imag__ b;
-  __imag__ ret = __real__ a * __imag__ b + __imag__ a * __real__ b;
-
-  return ret;
-}
-
 static void
 srsran_wiener_dl_run_symbol_1_8(srsran_wiener_dl_t* q, srsran_wiener_dl_state_t* state, cf_t* pilots, float snr_lin)
 {
@@ -581,7 +568,7 @@ static void srsran_wiener_dl_run_symbol_2_9(srsran_wiener_dl_t* q, srsran_wiener
   srsran_vec_sc_prod_cfc(q->tmp, 1.0f / state->sumlen, q->tmp, q->nof_ref); // Scale sum
 
   // Estimate channel based on the wiener matrix 2
-  estimate_wiener(q, q->wm2, q->tmp, state->tfifo[0]);
+  estimate_wiener(q, q->wm->wm2, q->tmp, state->tfifo[0]);
 
   // Update internal states
   state->deltan       = 0.0f;
@@ -607,7 +594,7 @@ static void srsran_wiener_dl_run_symbol_5_12(srsran_wiener_dl_t*       q,
   srsran_vec_sc_prod_cfc(q->tmp, 1.0f / state->sumlen, q->tmp, q->nof_ref); // Scale sum
 
   // Estimate channel based on the wiener matrix 1
-  estimate_wiener(q, q->wm1, q->tmp, state->tfifo[0]);
+  estimate_wiener(q, q->wm->wm1, q->tmp, state->tfifo[0]);
 
   // Update internal states
   state->deltan       = 0.0f;
@@ -692,59 +679,88 @@ static void srsran_wiener_dl_run_symbol_5_12(srsran_wiener_dl_t*       q,
       // Apply averaging scale
       srsran_vec_sc_prod_cfc(q->acV, 1.0f / (q->nof_tx_ports * q->nof_rx_ant), q->acV, SRSRAN_WIENER_DL_MIN_RE);
 
-      // Compute square wiener correlation matrix
-      for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_REF; i++) {
-        for (uint32_t k = i; k < SRSRAN_WIENER_DL_MIN_REF; k++) {
-          q->RH.m[i][k] = q->acV[6 * (k - i)];
-          q->RH.m[k][i] = conjf(q->RH.m[i][k]);
-        }
-      }
-
-      // Add noise contribution to the square wiener
-      float N = 0.0f;
-
+      // Select the cache entry for the current SNR
+      float    snr_eff = 0.0f;
+      uint32_t bin     = SRSRAN_WIENER_DL_NOF_SNR_BINS;
       if (isnormal(__real__ q->acV[0]) && isnormal(snr_lin) && state->sumlen > 0) {
-        N = (__real__ q->acV[0] / SRSRAN_MIN(15, snr_lin * state->sumlen));
+        snr_eff = SRSRAN_MIN(15.0f, snr_lin * state->sumlen);
+        float idx =
+            roundf((srsran_convert_power_to_dB(snr_eff) - SRSRAN_WIENER_DL_SNR_MIN_DB) / SRSRAN_WIENER_DL_SNR_STEP_DB);
+        bin = (uint32_t)SRSRAN_MIN(SRSRAN_MAX(idx, 0.0f), SRSRAN_WIENER_DL_NOF_SNR_BINS - 1);
       }
-
-      for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_REF; i++) {
-        q->RH.m[i][i] += N;
+      srsran_wiener_dl_cache_t* entry = &q->cache[bin];
+
+      // Reuse the cached matrices if they were computed from a close enough correlation vector
+      bool hit = false;
+      if (entry->valid && entry->shift == shift) {
+        srsran_vec_sub_ccc(q->acV, entry->acV, q->tmp, SRSRAN_WIENER_DL_MIN_RE);
+        float err = srsran_vec_avg_power_cf(q->tmp, SRSRAN_WIENER_DL_MIN_RE) * SRSRAN_WIENER_DL_MIN_RE;
+        hit       = err <= SRSRAN_WIENER_DL_CACHE_TOL * entry->acV_pwr;
       }
 
-      // Compute wiener correlation inverse matrix
-      srsran_matrix_NxN_inv_run(q->matrix_inverter, q->RH.v, q->invRH.v);
-
-      // Generate Rectangular Wiener
-      for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_RE; i++) {
-        for (uint32_t k = 0; k < SRSRAN_WIENER_DL_MIN_REF; k++) {
-          int m1 = ((shift + 3) % 6) + 6 * k - i;
-          int m2 = shift + 6 * k - i;
+      if (hit) {
+        q->cache_hits++;
+      } else {
+        q->cache_misses++;
 
-          if (m1 >= 0) {
-            q->hH1[i][k] = q->acV[m1];
-          } else {
-            q->hH1[i][k] = conjf(q->acV[-m1]);
+        // Compute square wiener correlation matrix
+        for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_REF; i++) {
+          for (uint32_t k = i; k < SRSRAN_WIENER_DL_MIN_REF; k++) {
+            q->RH.m[i][k] = q->acV[6 * (k - i)];
+            q->RH.m[k][i] = conjf(q->RH.m[i][k]);
           }
+        }
 
-          if (m2 >= 0) {
-            q->hH2[i][k] = q->acV[m2];
-          } else {
-            q->hH2[i][k] = conjf(q->acV[-m2]);
+        // Add noise contribution to the square wiener, quantised to the bin SNR
+        float N = 0.0f;
+        if (bin < SRSRAN_WIENER_DL_NOF_SNR_BINS) {
+          N = __real__ q->acV[0] / q->snr_bin_lin[bin];
+        }
+
+        for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_REF; i++) {
+          q->RH.m[i][i] += N;
+        }
+
+        // Compute wiener correlation inverse matrix
+        srsran_matrix_NxN_inv_run(q->matrix_inverter, q->RH.v, q->invRH.v);
+
+        // Generate Rectangular Wiener
+        for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_RE; i++) {
+          for (uint32_t k = 0; k < SRSRAN_WIENER_DL_MIN_REF; k++) {
+            int m1 = ((shift + 3) % 6) + 6 * k - i;
+            int m2 = shift + 6 * k - i;
+
+            if (m1 >= 0) {
+              q->hH1[k][i] = q->acV[m1];
+            } else {
+              q->hH1[k][i] = conjf(q->acV[-m1]);
+            }
+
+            if (m2 >= 0) {
+              q->hH2[k][i] = q->acV[m2];
+            } else {
+              q->hH2[k][i] = conjf(q->acV[-m2]);
+            }
           }
         }
-      }
 
-      // Compute Wiener matrices
-      for (uint32_t dim1 = 0; dim1 < SRSRAN_WIENER_DL_MIN_RE; dim1++) {
-        for (uint32_t dim2 = 0; dim2 < SRSRAN_WIENER_DL_MIN_REF; dim2++) {
-          q->wm1[dim1][dim2] = 0;
-          q->wm2[dim1][dim2] = 0;
-          for (int i = 0; i < SRSRAN_WIENER_DL_MIN_REF; i++) {
-            q->wm1[dim1][dim2] += _cmul(q->hH1[dim1][i], q->invRH.m[i][dim2]);
-            q->wm2[dim1][dim2] += _cmul(q->hH2[dim1][i], q->invRH.m[i][dim2]);
+        // Compute Wiener matrices, each row k is the combination of the hH rows weighted by the column k of invRH
+        for (uint32_t k = 0; k < SRSRAN_WIENER_DL_MIN_REF; k++) {
+          cf_t col[SRSRAN_WIENER_DL_MIN_REF];
+          for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_REF; i++) {
+            col[i] = q->invRH.m[i][k];
           }
+          matrix_vec_prod_ccc(q->hH1, 0, col, entry->wm1[k], SRSRAN_WIENER_DL_MIN_RE);
+          matrix_vec_prod_ccc(q->hH2, 0, col, entry->wm2[k], SRSRAN_WIENER_DL_MIN_RE);
         }
+
+        // Save the entry key
+        memcpy(entry->acV, q->acV, NSAMPLES2NBYTES(SRSRAN_WIENER_DL_MIN_RE));
+        entry->acV_pwr = srsran_vec_avg_power_cf(q->acV, SRSRAN_WIENER_DL_MIN_RE) * SRSRAN_WIENER_DL_MIN_RE;
+        entry->shift   = shift;
+        entry->valid   = true;
       }
+      q->wm          = entry;
       q->wm_computed = true;
     }
   }
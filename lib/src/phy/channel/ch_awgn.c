@@ -34,20 +34,37 @@
 #define AWGN_TABLE_SIZE (1U << AWGN_TABLE_SIZE_POW)
 #define AWGN_TABLE_ALLOC_SIZE (AWGN_TABLE_SIZE + SRSRAN_MAX(SRSRAN_SIMD_F_SIZE, AWGN_TABLE_READ_BURST))
 
-// Linear congruential Generator parameters
-#define AWGN_LCG_A 12345U
-#define AWGN_LCG_C 1103515245U
+static inline uint32_t channel_awgn_rotl(uint32_t x, uint32_t k)
+{
+  return (x << k) | (x >> (32U - k));
+}
+
+// xoshiro128+ generator, only its upper bits are used since the lowest ones are linear
+static inline uint32_t channel_awgn_next(srsran_channel_awgn_t* q)
+{
+  uint32_t* s      = q->rand_state;
+  uint32_t  result = s[0] + s[3];
+  uint32_t  t      = s[1] << 9U;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = channel_awgn_rotl(s[3], 11);
+
+  return result;
+}
 
-static inline int32_t channel_awgn_rand(srsran_channel_awgn_t* q)
+static inline uint32_t channel_awgn_rand(srsran_channel_awgn_t* q)
 {
-  q->rand_state = (AWGN_LCG_A + AWGN_LCG_C * q->rand_state);
-  return q->rand_state % AWGN_TABLE_SIZE;
+  return channel_awgn_next(q) >> (32U - AWGN_TABLE_SIZE_POW);
 }
 
 static inline void channel_awgn_shuffle_tables(srsran_channel_awgn_t* q)
 {
   for (uint32_t i = 0; i < AWGN_TABLE_SIZE; i++) {
-    int32_t idx;
+    uint32_t idx;
 
     do {
       idx = channel_awgn_rand(q);
@@ -71,8 +88,16 @@ int srsran_channel_awgn_init(srsran_channel_awgn_t* q, uint32_t seed)
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
-  // Initialise random generator
-  q->rand_state = seed;
+  // Initialise random generator, the state is expanded from the seed with splitmix32 so it is never all zeros
+  uint32_t z = seed;
+  for (uint32_t i = 0; i < 4; i++) {
+    z += 0x9e3779b9U;
+    uint32_t x = z;
+    x          = (x ^ (x >> 16U)) * 0x85ebca6bU;
+    x          = (x ^ (x >> 13U)) * 0xc2b2ae35U;
+    x          = x ^ (x >> 16U);
+    q->rand_state[i] = x;
+  }
 
   // Allocate complex exponential and logarithmic tables
   q->table_cos = srsran_vec_f_malloc(AWGN_TABLE_ALLOC_SIZE);
@@ -122,18 +147,20 @@ static inline void channel_awgn_run(srsran_channel_awgn_t* q, const float* in, f
     return;
   }
 
-  int32_t i    = 0;
-  int32_t idx1 = 0;
-  int32_t idx2 = 0;
+  uint32_t i    = 0;
+  uint32_t idx1 = 0;
+  uint32_t idx2 = 0;
 
 #if SRSRAN_SIMD_F_SIZE
-  for (; i < (int)size - SRSRAN_SIMD_F_SIZE + 1; i += SRSRAN_SIMD_F_SIZE) {
+  for (; i + SRSRAN_SIMD_F_SIZE <= size; i += SRSRAN_SIMD_F_SIZE) {
     if (i % AWGN_TABLE_READ_BURST == 0) {
-      idx1 = channel_awgn_rand(q);
-      idx2 = channel_awgn_rand(q);
+      // Both table offsets are taken from a single draw
+      uint32_t r = channel_awgn_next(q);
+      idx1       = r >> (32U - AWGN_TABLE_SIZE_POW);
+      idx2       = (r >> (32U - 2U * AWGN_TABLE_SIZE_POW)) & (AWGN_TABLE_SIZE - 1U);
     } else {
-      idx1 = (idx1 + SRSRAN_SIMD_F_SIZE) % AWGN_TABLE_SIZE;
-      idx2 = (idx2 + SRSRAN_SIMD_F_SIZE) % AWGN_TABLE_SIZE;
+      idx1 = (idx1 + SRSRAN_SIMD_F_SIZE) & (AWGN_TABLE_SIZE - 1U);
+      idx2 = (idx2 + SRSRAN_SIMD_F_SIZE) & (AWGN_TABLE_SIZE - 1U);
     }
 
     // Load SIMD registers
@@ -154,11 +181,12 @@ static inline void channel_awgn_run(srsran_channel_awgn_t* q, const float* in, f
 
   for (; i < size; i++) {
     if (i % AWGN_TABLE_READ_BURST == 0) {
-      idx1 = channel_awgn_rand(q);
-      idx2 = channel_awgn_rand(q);
+      uint32_t r = channel_awgn_next(q);
+      idx1       = r >> (32U - AWGN_TABLE_SIZE_POW);
+      idx2       = (r >> (32U - 2U * AWGN_TABLE_SIZE_POW)) & (AWGN_TABLE_SIZE - 1U);
     } else {
-      idx1 = (idx1 + 1) % AWGN_TABLE_SIZE;
-      idx2 = (idx2 + 1) % AWGN_TABLE_SIZE;
+      idx1 = (idx1 + 1) & (AWGN_TABLE_SIZE - 1U);
+      idx2 = (idx2 + 1) & (AWGN_TABLE_SIZE - 1U);
     }
 
     float n = std_dev;
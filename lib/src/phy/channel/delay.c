@@ -52,7 +52,7 @@ static inline uint32_t calculate_delay_nsamples(srsran_channel_delay_t* q)
 
 static inline uint32_t ringbuffer_available_nsamples(srsran_channel_delay_t* q)
 {
-  return srsran_ringbuffer_status(&q->rb) / sizeof(cf_t);
+  return srsran_ringbuffer_mirror_status(&q->rb) / sizeof(cf_t);
 }
 
 int srsran_channel_delay_init(srsran_channel_delay_t* q,
@@ -65,14 +65,8 @@ int srsran_channel_delay_init(srsran_channel_delay_t* q,
   // Calculate buffer size
   uint32_t buff_size = (uint32_t)ceilf(delay_max_us * (float)srate_max_hz / 1e6f);
 
-  // Create ring buffer
-  int ret = srsran_ringbuffer_init(&q->rb, sizeof(cf_t) * buff_size);
-
-  // Create zero buffer
-  q->zero_buffer = srsran_vec_cf_malloc(buff_size);
-  if (!q->zero_buffer) {
-    ret = SRSRAN_ERROR;
-  }
+  // Create ring buffer, the delayed samples are read and written in place
+  int ret = srsran_ringbuffer_mirror_init(&q->rb, sizeof(cf_t) * SRSRAN_MAX(buff_size, 1));
 
   // Load initial parameters
   q->delay_min_us = delay_min_us;
@@ -87,17 +81,13 @@ int srsran_channel_delay_init(srsran_channel_delay_t* q,
 
 void srsran_channel_delay_update_srate(srsran_channel_delay_t* q, uint32_t srate_hz)
 {
-  srsran_ringbuffer_reset(&q->rb);
+  srsran_ringbuffer_mirror_reset(&q->rb);
   q->srate_hz = srate_hz;
 }
 
 void srsran_channel_delay_free(srsran_channel_delay_t* q)
 {
-  srsran_ringbuffer_free(&q->rb);
-
-  if (q->zero_buffer) {
-    free(q->zero_buffer);
-  }
+  srsran_ringbuffer_mirror_free(&q->rb);
 }
 
 void srsran_channel_delay_execute(srsran_channel_delay_t*   q,
@@ -114,20 +104,23 @@ void srsran_channel_delay_execute(srsran_channel_delay_t*   q,
 
   if (available_nsamples < q->delay_nsamples) {
     uint32_t nzeros = q->delay_nsamples - available_nsamples;
-    srsran_vec_cf_zero(q->zero_buffer, nzeros);
-    srsran_ringbuffer_write(&q->rb, q->zero_buffer, sizeof(cf_t) * nzeros);
+    srsran_vec_cf_zero((cf_t*)srsran_ringbuffer_mirror_write_view(&q->rb, NULL), nzeros);
+    srsran_ringbuffer_mirror_write_commit(&q->rb, sizeof(cf_t) * nzeros);
   } else if (available_nsamples > q->delay_nsamples) {
-    srsran_ringbuffer_read(&q->rb, q->zero_buffer, sizeof(cf_t) * (available_nsamples - q->delay_nsamples));
+    srsran_ringbuffer_mirror_read_release(&q->rb, sizeof(cf_t) * (available_nsamples - q->delay_nsamples));
   }
 
-  // Read buffered samples
-  srsran_ringbuffer_read(&q->rb, out, sizeof(cf_t) * read_nsamples);
+  // Read buffered samples, the mirrored buffer makes them contiguous
+  const cf_t* delayed = (const cf_t*)srsran_ringbuffer_mirror_read_view(&q->rb, NULL);
+  srsran_vec_cf_copy(out, delayed, read_nsamples);
+  srsran_ringbuffer_mirror_read_release(&q->rb, sizeof(cf_t) * read_nsamples);
 
   // Read other samples
   if (copy_nsamples) {
     memcpy(&out[read_nsamples], in, sizeof(cf_t) * copy_nsamples);
   }
 
-  // Write new sampels
-  srsran_ringbuffer_write(&q->rb, (void*)&in[copy_nsamples], sizeof(cf_t) * read_nsamples);
+  // Write new samples
+  srsran_vec_cf_copy((cf_t*)srsran_ringbuffer_mirror_write_view(&q->rb, NULL), &in[copy_nsamples], read_nsamples);
+  srsran_ringbuffer_mirror_write_commit(&q->rb, sizeof(cf_t) * read_nsamples);
 }
@@ -394,6 +394,24 @@ bool srsran_duplex_nr_is_ul(const srsran_duplex_config_nr_t* cfg, uint32_t numer
   return true;
 }
 
+srsran_duplex_nr_slot_t
+srsran_duplex_nr_slot_type(const srsran_duplex_config_nr_t* cfg, uint32_t numerology, uint32_t slot_idx)
+{
+  bool is_dl = srsran_duplex_nr_is_dl(cfg, numerology, slot_idx);
+  bool is_ul = srsran_duplex_nr_is_ul(cfg, numerology, slot_idx);
+
+  if (is_dl && is_ul) {
+    return SRSRAN_DUPLEX_NR_SLOT_DL_UL;
+  }
+  if (is_dl) {
+    return SRSRAN_DUPLEX_NR_SLOT_DL;
+  }
+  if (is_ul) {
+    return SRSRAN_DUPLEX_NR_SLOT_UL;
+  }
+  return SRSRAN_DUPLEX_NR_SLOT_NONE;
+}
+
 int srsran_carrier_to_cell(const srsran_carrier_nr_t* carrier, srsran_cell_t* cell)
 {
   // Protect memory access
@@ -146,6 +146,28 @@ static inline uint32_t sequence_gen_LTE_pr_memless_step_x2(uint32_t state)
 static uint32_t sequence_x1_init                    = 0;
 static uint32_t sequence_x2_init[SEQUENCE_SEED_LEN] = {};
 
+/**
+ * Jump-ahead of the x1/x2 sequences. Both are linear over GF(2), so advancing 2^k steps is a 31x31 binary matrix
+ * whose column j is the state reached from the state with only the bit j set. The matrices are shared read-only by all
+ * the users and any offset is advanced with one matrix product per set bit.
+ *
+ * Offsets below 2^SEQUENCE_JUMP_LOG2_MIN are cheaper to advance with the parallel steps.
+ */
+#define SEQUENCE_JUMP_LOG2_MIN (10)
+#define SEQUENCE_JUMP_LOG2_MAX (32)
+static uint32_t sequence_x1_jump[SEQUENCE_JUMP_LOG2_MAX][SEQUENCE_SEED_LEN] = {};
+static uint32_t sequence_x2_jump[SEQUENCE_JUMP_LOG2_MAX][SEQUENCE_SEED_LEN] = {};
+
+static inline uint32_t sequence_jump(const uint32_t* matrix, uint32_t state)
+{
+  uint32_t result = 0;
+  while (state) {
+    result ^= matrix[__builtin_ctz(state)];
+    state &= state - 1U;
+  }
+  return result;
+}
+
 /**
  * C constructor, pre-computes X1 and X2 initial states
  */
@@ -165,6 +187,26 @@ __attribute__((constructor)) __attribute__((unused)) static void srsran_lte_pr_p
       sequence_x2_init[i] = sequence_gen_LTE_pr_memless_step_x2(sequence_x2_init[i]);
     }
   }
+
+  // Smallest jump, computed one step at a time
+  for (uint32_t j = 0; j < SEQUENCE_SEED_LEN; j++) {
+    uint32_t x1 = 1U << j;
+    uint32_t x2 = 1U << j;
+    for (uint32_t n = 0; n < (1U << SEQUENCE_JUMP_LOG2_MIN); n++) {
+      x1 = sequence_gen_LTE_pr_memless_step_x1(x1);
+      x2 = sequence_gen_LTE_pr_memless_step_x2(x2);
+    }
+    sequence_x1_jump[SEQUENCE_JUMP_LOG2_MIN][j] = x1;
+    sequence_x2_jump[SEQUENCE_JUMP_LOG2_MIN][j] = x2;
+  }
+
+  // Every following jump doubles the previous one
+  for (uint32_t k = SEQUENCE_JUMP_LOG2_MIN + 1; k < SEQUENCE_JUMP_LOG2_MAX; k++) {
+    for (uint32_t j = 0; j < SEQUENCE_SEED_LEN; j++) {
+      sequence_x1_jump[k][j] = sequence_jump(sequence_x1_jump[k - 1], sequence_x1_jump[k - 1][j]);
+      sequence_x2_jump[k][j] = sequence_jump(sequence_x2_jump[k - 1], sequence_x2_jump[k - 1][j]);
+    }
+  }
 }
 
 static uint32_t sequence_get_x2_init(uint32_t seed)
@@ -334,6 +376,15 @@ void srsran_sequence_state_apply_f(srsran_sequence_state_t* s, const float* in,
 
 void srsran_sequence_state_advance(srsran_sequence_state_t* s, uint32_t length)
 {
+  // Jump over the large part of the offset
+  for (uint32_t k = SEQUENCE_JUMP_LOG2_MIN; k < SEQUENCE_JUMP_LOG2_MAX; k++) {
+    if ((length >> k) & 1U) {
+      s->x1 = sequence_jump(sequence_x1_jump[k], s->x1);
+      s->x2 = sequence_jump(sequence_x2_jump[k], s->x2);
+    }
+  }
+  length &= (1U << SEQUENCE_JUMP_LOG2_MIN) - 1U;
+
   uint32_t i = 0;
   if (length >= SEQUENCE_PAR_BITS) {
     for (; i < length - (SEQUENCE_PAR_BITS - 1); i += SEQUENCE_PAR_BITS) {
@@ -504,11 +555,11 @@ void srsran_sequence_apply_f(const float* in, float* out, uint32_t length, uint3
   srsran_sequence_state_apply_f(&seq, in, out, length);
 }
 
-void srsran_sequence_apply_s(const int16_t* in, int16_t* out, uint32_t length, uint32_t seed)
+void srsran_sequence_state_apply_s(srsran_sequence_state_t* state, const int16_t* in, int16_t* out, uint32_t length)
 {
   const int16_t s[2] = {+1, -1};
-  uint32_t      x1   = sequence_x1_init;           // X1 initial state is fix
-  uint32_t      x2   = sequence_get_x2_init(seed); // loads x2 initial state
+  uint32_t      x1   = state->x1;
+  uint32_t      x2   = state->x2;
 
   uint32_t i = 0;
 
@@ -517,6 +568,13 @@ void srsran_sequence_apply_s(const int16_t* in, int16_t* out, uint32_t length, u
       uint32_t c = (uint32_t)(x1 ^ x2);
 
       uint32_t j = 0;
+#ifdef LV_HAVE_AVX512
+      // Negates the selected words of the whole step at once
+      __m512i v512 = _mm512_maskz_loadu_epi16((__mmask32)SEQUENCE_MASK, in + i);
+      v512         = _mm512_mask_sub_epi16(v512, (__mmask32)(c & SEQUENCE_MASK), _mm512_setzero_si512(), v512);
+      _mm512_mask_storeu_epi16(out + i, (__mmask32)SEQUENCE_MASK, v512);
+      j = SEQUENCE_PAR_BITS;
+#endif // LV_HAVE_AVX512
 #ifdef LV_HAVE_SSE
       for (; j < SEQUENCE_PAR_BITS - 7; j += 8) {
         // Preloads bits of interest in the 8 LSB
@@ -558,6 +616,16 @@ void srsran_sequence_apply_s(const int16_t* in, int16_t* out, uint32_t length, u
     x1 = sequence_gen_LTE_pr_memless_step_x1(x1);
     x2 = sequence_gen_LTE_pr_memless_step_x2(x2);
   }
+
+  state->x1 = x1;
+  state->x2 = x2;
+}
+
+void srsran_sequence_apply_s(const int16_t* in, int16_t* out, uint32_t length, uint32_t seed)
+{
+  srsran_sequence_state_t sequence_state;
+  srsran_sequence_state_init(&sequence_state, seed);
+  srsran_sequence_state_apply_s(&sequence_state, in, out, length);
 }
 
 void srsran_sequence_state_apply_c(srsran_sequence_state_t* s, const int8_t* in, int8_t* out, uint32_t length)
@@ -569,8 +637,15 @@ void srsran_sequence_state_apply_c(srsran_sequence_state_t* s, const int8_t* in,
       uint32_t c = (uint32_t)(s->x1 ^ s->x2);
 
       uint32_t j = 0;
+#ifdef LV_HAVE_AVX512
+      // Negates the selected bytes of the whole step at once
+      __m512i v512 = _mm512_maskz_loadu_epi8((__mmask64)SEQUENCE_MASK, in + i);
+      v512         = _mm512_mask_sub_epi8(v512, (__mmask64)(c & SEQUENCE_MASK), _mm512_setzero_si512(), v512);
+      _mm512_mask_storeu_epi8(out + i, (__mmask64)SEQUENCE_MASK, v512);
+      j = SEQUENCE_PAR_BITS;
+#endif // LV_HAVE_AVX512
 #ifdef LV_HAVE_SSE
-      if (SEQUENCE_PAR_BITS >= 16) {
+      if (j == 0 && SEQUENCE_PAR_BITS >= 16) {
         // Preloads bits of interest in the 16 LSB
         __m128i mask = _mm_set1_epi32(c);
         mask         = _mm_shuffle_epi8(mask, _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1));
@@ -687,43 +762,44 @@ void srsran_sequence_apply_bit(const uint8_t* in, uint8_t* out, uint32_t length,
   srsran_sequence_state_apply_bit(&sequence_state, in, out, length);
 }
 
+// Reverses the bit order of a byte
+static const uint8_t reverse_lut[256] = {
+    0b00000000, 0b10000000, 0b01000000, 0b11000000, 0b00100000, 0b10100000, 0b01100000, 0b11100000, 0b00010000,
+    0b10010000, 0b01010000, 0b11010000, 0b00110000, 0b10110000, 0b01110000, 0b11110000, 0b00001000, 0b10001000,
+    0b01001000, 0b11001000, 0b00101000, 0b10101000, 0b01101000, 0b11101000, 0b00011000, 0b10011000, 0b01011000,
+    0b11011000, 0b00111000, 0b10111000, 0b01111000, 0b11111000, 0b00000100, 0b10000100, 0b01000100, 0b11000100,
+    0b00100100, 0b10100100, 0b01100100, 0b11100100, 0b00010100, 0b10010100, 0b01010100, 0b11010100, 0b00110100,
+    0b10110100, 0b01110100, 0b11110100, 0b00001100, 0b10001100, 0b01001100, 0b11001100, 0b00101100, 0b10101100,
+    0b01101100, 0b11101100, 0b00011100, 0b10011100, 0b01011100, 0b11011100, 0b00111100, 0b10111100, 0b01111100,
+    0b11111100, 0b00000010, 0b10000010, 0b01000010, 0b11000010, 0b00100010, 0b10100010, 0b01100010, 0b11100010,
+    0b00010010, 0b10010010, 0b01010010, 0b11010010, 0b00110010, 0b10110010, 0b01110010, 0b11110010, 0b00001010,
+    0b10001010, 0b01001010, 0b11001010, 0b00101010, 0b10101010, 0b01101010, 0b11101010, 0b00011010, 0b10011010,
+    0b01011010, 0b11011010, 0b00111010, 0b10111010, 0b01111010, 0b11111010, 0b00000110, 0b10000110, 0b01000110,
+    0b11000110, 0b00100110, 0b10100110, 0b01100110, 0b11100110, 0b00010110, 0b10010110, 0b01010110, 0b11010110,
+    0b00110110, 0b10110110, 0b01110110, 0b11110110, 0b00001110, 0b10001110, 0b01001110, 0b11001110, 0b00101110,
+    0b10101110, 0b01101110, 0b11101110, 0b00011110, 0b10011110, 0b01011110, 0b11011110, 0b00111110, 0b10111110,
+    0b01111110, 0b11111110, 0b00000001, 0b10000001, 0b01000001, 0b11000001, 0b00100001, 0b10100001, 0b01100001,
+    0b11100001, 0b00010001, 0b10010001, 0b01010001, 0b11010001, 0b00110001, 0b10110001, 0b01110001, 0b11110001,
+    0b00001001, 0b10001001, 0b01001001, 0b11001001, 0b00101001, 0b10101001, 0b01101001, 0b11101001, 0b00011001,
+    0b10011001, 0b01011001, 0b11011001, 0b00111001, 0b10111001, 0b01111001, 0b11111001, 0b00000101, 0b10000101,
+    0b01000101, 0b11000101, 0b00100101, 0b10100101, 0b01100101, 0b11100101, 0b00010101, 0b10010101, 0b01010101,
+    0b11010101, 0b00110101, 0b10110101, 0b01110101, 0b11110101, 0b00001101, 0b10001101, 0b01001101, 0b11001101,
+    0b00101101, 0b10101101, 0b01101101, 0b11101101, 0b00011101, 0b10011101, 0b01011101, 0b11011101, 0b00111101,
+    0b10111101, 0b01111101, 0b11111101, 0b00000011, 0b10000011, 0b01000011, 0b11000011, 0b00100011, 0b10100011,
+    0b01100011, 0b11100011, 0b00010011, 0b10010011, 0b01010011, 0b11010011, 0b00110011, 0b10110011, 0b01110011,
+    0b11110011, 0b00001011, 0b10001011, 0b01001011, 0b11001011, 0b00101011, 0b10101011, 0b01101011, 0b11101011,
+    0b00011011, 0b10011011, 0b01011011, 0b11011011, 0b00111011, 0b10111011, 0b01111011, 0b11111011, 0b00000111,
+    0b10000111, 0b01000111, 0b11000111, 0b00100111, 0b10100111, 0b01100111, 0b11100111, 0b00010111, 0b10010111,
+    0b01010111, 0b11010111, 0b00110111, 0b10110111, 0b01110111, 0b11110111, 0b00001111, 0b10001111, 0b01001111,
+    0b11001111, 0b00101111, 0b10101111, 0b01101111, 0b11101111, 0b00011111, 0b10011111, 0b01011111, 0b11011111,
+    0b00111111, 0b10111111, 0b01111111, 0b11111111,
+};
+
 void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t length, uint32_t seed)
 {
   uint32_t x1 = sequence_x1_init;           // X1 initial state is fix
   uint32_t x2 = sequence_get_x2_init(seed); // loads x2 initial state
 
-  const uint8_t reverse_lut[256] = {
-      0b00000000, 0b10000000, 0b01000000, 0b11000000, 0b00100000, 0b10100000, 0b01100000, 0b11100000, 0b00010000,
-      0b10010000, 0b01010000, 0b11010000, 0b00110000, 0b10110000, 0b01110000, 0b11110000, 0b00001000, 0b10001000,
-      0b01001000, 0b11001000, 0b00101000, 0b10101000, 0b01101000, 0b11101000, 0b00011000, 0b10011000, 0b01011000,
-      0b11011000, 0b00111000, 0b10111000, 0b01111000, 0b11111000, 0b00000100, 0b10000100, 0b01000100, 0b11000100,
-      0b00100100, 0b10100100, 0b01100100, 0b11100100, 0b00010100, 0b10010100, 0b01010100, 0b11010100, 0b00110100,
-      0b10110100, 0b01110100, 0b11110100, 0b00001100, 0b10001100, 0b01001100, 0b11001100, 0b00101100, 0b10101100,
-      0b01101100, 0b11101100, 0b00011100, 0b10011100, 0b01011100, 0b11011100, 0b00111100, 0b10111100, 0b01111100,
-      0b11111100, 0b00000010, 0b10000010, 0b01000010, 0b11000010, 0b00100010, 0b10100010, 0b01100010, 0b11100010,
-      0b00010010, 0b10010010, 0b01010010, 0b11010010, 0b00110010, 0b10110010, 0b01110010, 0b11110010, 0b00001010,
-      0b10001010, 0b01001010, 0b11001010, 0b00101010, 0b10101010, 0b01101010, 0b11101010, 0b00011010, 0b10011010,
-      0b01011010, 0b11011010, 0b00111010, 0b10111010, 0b01111010, 0b11111010, 0b00000110, 0b10000110, 0b01000110,
-      0b11000110, 0b00100110, 0b10100110, 0b01100110, 0b11100110, 0b00010110, 0b10010110, 0b01010110, 0b11010110,
-      0b00110110, 0b10110110, 0b01110110, 0b11110110, 0b00001110, 0b10001110, 0b01001110, 0b11001110, 0b00101110,
-      0b10101110, 0b01101110, 0b11101110, 0b00011110, 0b10011110, 0b01011110, 0b11011110, 0b00111110, 0b10111110,
-      0b01111110, 0b11111110, 0b00000001, 0b10000001, 0b01000001, 0b11000001, 0b00100001, 0b10100001, 0b01100001,
-      0b11100001, 0b00010001, 0b10010001, 0b01010001, 0b11010001, 0b00110001, 0b10110001, 0b01110001, 0b11110001,
-      0b00001001, 0b10001001, 0b01001001, 0b11001001, 0b00101001, 0b10101001, 0b01101001, 0b11101001, 0b00011001,
-      0b10011001, 0b01011001, 0b11011001, 0b00111001, 0b10111001, 0b01111001, 0b11111001, 0b00000101, 0b10000101,
-      0b01000101, 0b11000101, 0b00100101, 0b10100101, 0b01100101, 0b11100101, 0b00010101, 0b10010101, 0b01010101,
-      0b11010101, 0b00110101, 0b10110101, 0b01110101, 0b11110101, 0b00001101, 0b10001101, 0b01001101, 0b11001101,
-      0b00101101, 0b10101101, 0b01101101, 0b11101101, 0b00011101, 0b10011101, 0b01011101, 0b11011101, 0b00111101,
-      0b10111101, 0b01111101, 0b11111101, 0b00000011, 0b10000011, 0b01000011, 0b11000011, 0b00100011, 0b10100011,
-      0b01100011, 0b11100011, 0b00010011, 0b10010011, 0b01010011, 0b11010011, 0b00110011, 0b10110011, 0b01110011,
-      0b11110011, 0b00001011, 0b10001011, 0b01001011, 0b11001011, 0b00101011, 0b10101011, 0b01101011, 0b11101011,
-      0b00011011, 0b10011011, 0b01011011, 0b11011011, 0b00111011, 0b10111011, 0b01111011, 0b11111011, 0b00000111,
-      0b10000111, 0b01000111, 0b11000111, 0b00100111, 0b10100111, 0b01100111, 0b11100111, 0b00010111, 0b10010111,
-      0b01010111, 0b11010111, 0b00110111, 0b10110111, 0b01110111, 0b11110111, 0b00001111, 0b10001111, 0b01001111,
-      0b11001111, 0b00101111, 0b10101111, 0b01101111, 0b11101111, 0b00011111, 0b10011111, 0b01011111, 0b11011111,
-      0b00111111, 0b10111111, 0b01111111, 0b11111111,
-  };
-
   uint32_t i = 0;
 #if SEQUENCE_PAR_BITS % 8 != 0
   uint64_t buffer = 0;
@@ -797,3 +873,40 @@ void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t leng
   }
 #endif // SEQUENCE_PAR_BITS % 8 == 0
 }
+
+void srsran_sequence_state_apply_packed(srsran_sequence_state_t* s, const uint8_t* in, uint8_t* out, uint32_t length)
+{
+  uint32_t i = 0;
+
+#if SEQUENCE_PAR_BITS % 8 == 0
+  // Whole words of the parallel generator
+  for (; i + SEQUENCE_PAR_BITS <= length; i += SEQUENCE_PAR_BITS) {
+    uint32_t c = (uint32_t)(s->x1 ^ s->x2);
+
+    for (uint32_t j = 0; j < SEQUENCE_PAR_BITS / 8; j++) {
+      out[i / 8 + j] = in[i / 8 + j] ^ reverse_lut[c & 255U];
+      c              = c >> 8U;
+    }
+
+    // Step sequences
+    s->x1 = sequence_gen_LTE_pr_memless_step_par_x1(s->x1);
+    s->x2 = sequence_gen_LTE_pr_memless_step_par_x2(s->x2);
+  }
+#endif // SEQUENCE_PAR_BITS % 8 == 0
+
+  // Spare bits, one step at a time so the state stays exact
+  for (; i < length; i += 8) {
+    uint32_t nbits = SRSRAN_MIN(8, length - i);
+    uint8_t  c     = 0;
+
+    for (uint32_t j = 0; j < nbits; j++) {
+      c |= (uint8_t)(((s->x1 ^ s->x2) & 1U) << (7U - j));
+
+      // Step sequences
+      s->x1 = sequence_gen_LTE_pr_memless_step_x1(s->x1);
+      s->x2 = sequence_gen_LTE_pr_memless_step_x2(s->x2);
+    }
+
+    out[i / 8] = in[i / 8] ^ c;
+  }
+}
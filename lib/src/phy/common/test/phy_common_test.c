@@ -20,6 +20,7 @@
  */
 #include "srsran/common/test_common.h"
 #include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/common/phy_common_nr.h"
 
 int srsran_default_rates_test()
 {
@@ -51,9 +52,48 @@ int lte_standard_rates_test()
   return SRSRAN_SUCCESS;
 }
 
+int duplex_nr_slot_type_test()
+{
+  srsran_duplex_config_nr_t duplex = {};
+
+  // FDD slots carry both directions, a missing configuration none
+  duplex.mode = SRSRAN_DUPLEX_MODE_FDD;
+  TESTASSERT(srsran_duplex_nr_slot_type(&duplex, 0, 3) == SRSRAN_DUPLEX_NR_SLOT_DL_UL);
+  TESTASSERT(srsran_duplex_nr_slot_type(NULL, 0, 3) == SRSRAN_DUPLEX_NR_SLOT_NONE);
+
+  // TDD 6 DL slots, special slot with DL and UL symbols, 3 UL slots
+  duplex.mode                        = SRSRAN_DUPLEX_MODE_TDD;
+  duplex.tdd.pattern1.period_ms      = 10;
+  duplex.tdd.pattern1.nof_dl_slots   = 6;
+  duplex.tdd.pattern1.nof_dl_symbols = 6;
+  duplex.tdd.pattern1.nof_ul_slots   = 3;
+  duplex.tdd.pattern1.nof_ul_symbols = 4;
+  for (uint32_t slot = 0; slot < 20; slot++) {
+    uint32_t                slot_period = slot % 10;
+    srsran_duplex_nr_slot_t expected    = SRSRAN_DUPLEX_NR_SLOT_UL;
+    if (slot_period < 6) {
+      expected = SRSRAN_DUPLEX_NR_SLOT_DL;
+    } else if (slot_period == 6) {
+      expected = SRSRAN_DUPLEX_NR_SLOT_DL_UL;
+    }
+    TESTASSERT(srsran_duplex_nr_slot_type(&duplex, 0, slot) == expected);
+  }
+
+  // The special slot follows the symbols it carries
+  duplex.tdd.pattern1.nof_ul_symbols = 0;
+  TESTASSERT(srsran_duplex_nr_slot_type(&duplex, 0, 6) == SRSRAN_DUPLEX_NR_SLOT_DL);
+  duplex.tdd.pattern1.nof_dl_symbols = 0;
+  TESTASSERT(srsran_duplex_nr_slot_type(&duplex, 0, 6) == SRSRAN_DUPLEX_NR_SLOT_NONE);
+  duplex.tdd.pattern1.nof_ul_symbols = 4;
+  TESTASSERT(srsran_duplex_nr_slot_type(&duplex, 0, 6) == SRSRAN_DUPLEX_NR_SLOT_UL);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   TESTASSERT(srsran_default_rates_test() == SRSRAN_SUCCESS);
   TESTASSERT(lte_standard_rates_test() == SRSRAN_SUCCESS);
+  TESTASSERT(duplex_nr_slot_type_test() == SRSRAN_SUCCESS);
   return SRSRAN_SUCCESS;
 }
\ No newline at end of file
@@ -23,6 +23,7 @@
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/random.h"
+#include <string.h>
 
 #define Nc 1600
 #define MAX_SEQ_LEN (256 * 1024)
@@ -192,6 +193,29 @@ static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t le
   return SRSRAN_SUCCESS;
 }
 
+static int test_advance(srsran_sequence_t* sequence, uint32_t seed, uint32_t offset)
+{
+  const uint32_t nof_bits     = 64;
+  uint8_t        zeros[64]    = {};
+  uint8_t        advanced[64] = {};
+
+  if (srsran_sequence_LTE_pr(sequence, offset + nof_bits, seed) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  srsran_sequence_state_t state = {};
+  srsran_sequence_state_init(&state, seed);
+  srsran_sequence_state_advance(&state, offset);
+  srsran_sequence_state_apply_bit(&state, zeros, advanced, nof_bits);
+
+  if (memcmp(advanced, &sequence->c[offset], nof_bits) != 0) {
+    fprintf(stderr, "Sequence advance failed for seed %08x and offset %d\n", seed, offset);
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   uint32_t repetitions = 1;
@@ -233,9 +257,15 @@ int main(int argc, char** argv)
     test_sequence(&sequence, (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, INT32_MAX), length, repetitions);
   }
 
+  // Test the sequence jump-ahead, from single steps to the largest offsets
+  int ret = SRSRAN_SUCCESS;
+  for (uint32_t offset = 0; offset < max_length - 64 && ret == SRSRAN_SUCCESS; offset = (offset * 3) / 2 + 1) {
+    ret = test_advance(&sequence, (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, INT32_MAX), offset);
+  }
+
   // Free sequence object
   srsran_sequence_free(&sequence);
   srsran_random_free(random_gen);
 
-  return SRSRAN_SUCCESS;
+  return ret;
 }
@@ -0,0 +1,231 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/common/zc_sequence.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/primes.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+#define MAX_M_ZC (SRSRAN_MAX_PRB * SRSRAN_NRE)
+#define NOF_THREADS 4
+#define MAX_ERROR 1e-3f
+
+// Number of PRB used in the long sequence tests
+static const uint32_t test_nof_prb[] = {3, 4, 5, 6, 25, 50, 75, 100, 110};
+
+#define TEST_NOF_PRB (sizeof(test_nof_prb) / sizeof(test_nof_prb[0]))
+
+static cf_t sequence[MAX_M_ZC];
+static cf_t sequence_ref[MAX_M_ZC];
+
+/* Maximum absolute difference between the generated sequence and the reference */
+static float max_error(const cf_t* a, const cf_t* b, uint32_t len)
+{
+  float err = 0.0f;
+  for (uint32_t i = 0; i < len; i++) {
+    err = SRSRAN_MAX(err, cabsf(a[i] - b[i]));
+  }
+  return err;
+}
+
+/* Zadoff-Chu sequence defined in TS 36.211 section 5.5.1.1, calculated in double precision */
+static void zc_sequence_ref(uint32_t u, uint32_t v, float alpha, uint32_t M_zc, cf_t* r)
+{
+  uint32_t N_zc  = (uint32_t)srsran_prime_lower_than(M_zc);
+  double   q_hat = (double)N_zc * (u + 1) / 31.0;
+  double   q     = floor(q_hat + 0.5) + v * ((((uint32_t)(2 * q_hat)) % 2 == 0) ? 1.0 : -1.0);
+
+  for (uint32_t n = 0; n < M_zc; n++) {
+    double m = (double)(n % N_zc);
+    r[n]     = (cf_t)cexp(I * (-M_PI * q * m * (m + 1) / N_zc + alpha * (double)n));
+  }
+}
+
+static int test_lte_long()
+{
+  for (uint32_t i = 0; i < TEST_NOF_PRB; i++) {
+    uint32_t M_zc = test_nof_prb[i] * SRSRAN_NRE;
+    for (uint32_t u = 0; u < SRSRAN_ZC_SEQUENCE_NOF_GROUPS; u++) {
+      for (uint32_t v = 0; v < SRSRAN_ZC_SEQUENCE_NOF_BASE; v++) {
+        for (uint32_t n_cs = 0; n_cs < SRSRAN_NRE; n_cs++) {
+          float alpha = 2.0f * (float)M_PI * n_cs / SRSRAN_NRE;
+
+          TESTASSERT(srsran_zc_sequence_generate_lte(u, v, alpha, test_nof_prb[i], sequence) == SRSRAN_SUCCESS);
+          zc_sequence_ref(u, v, alpha, M_zc, sequence_ref);
+
+          float err = max_error(sequence, sequence_ref, M_zc);
+          if (err > MAX_ERROR) {
+            ERROR("Error %f exceeds maximum for nof_prb=%d, u=%d, v=%d, n_cs=%d", err, test_nof_prb[i], u, v, n_cs);
+            return SRSRAN_ERROR;
+          }
+        }
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/* The cyclic shift must be the same rotation of the alpha = 0 sequence for the sequences from tables */
+static int test_short(bool nr, uint32_t M_zc)
+{
+  cf_t base[MAX_M_ZC];
+
+  for (uint32_t u = 0; u < SRSRAN_ZC_SEQUENCE_NOF_GROUPS; u++) {
+    if (nr) {
+      TESTASSERT(srsran_zc_sequence_generate_nr(u, 0, 0.0f, M_zc / (SRSRAN_NRE / 2), 1, base) == SRSRAN_SUCCESS);
+    } else {
+      TESTASSERT(srsran_zc_sequence_generate_lte(u, 0, 0.0f, M_zc / SRSRAN_NRE, base) == SRSRAN_SUCCESS);
+    }
+
+    for (uint32_t n_cs = 1; n_cs < SRSRAN_NRE; n_cs++) {
+      float alpha = 2.0f * (float)M_PI * n_cs / SRSRAN_NRE;
+
+      if (nr) {
+        TESTASSERT(srsran_zc_sequence_generate_nr(u, 0, alpha, M_zc / (SRSRAN_NRE / 2), 1, sequence) ==
+                   SRSRAN_SUCCESS);
+      } else {
+        TESTASSERT(srsran_zc_sequence_generate_lte(u, 0, alpha, M_zc / SRSRAN_NRE, sequence) == SRSRAN_SUCCESS);
+      }
+
+      for (uint32_t n = 0; n < M_zc; n++) {
+        sequence_ref[n] = base[n] * (cf_t)cexp(I * alpha * (double)n);
+      }
+
+      float err = max_error(sequence, sequence_ref, M_zc);
+      if (err > MAX_ERROR) {
+        ERROR("Error %f exceeds maximum for %s M_zc=%d, u=%d, n_cs=%d", err, nr ? "NR" : "LTE", M_zc, u, n_cs);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+typedef struct {
+  uint32_t nof_prb;
+  int      ret;
+} test_thread_args_t;
+
+/* Every thread generates the same sequences concurrently while the cache is populated */
+static void* test_thread(void* ptr)
+{
+  test_thread_args_t* args = (test_thread_args_t*)ptr;
+  uint32_t            M_zc = args->nof_prb * SRSRAN_NRE;
+  cf_t*               r    = srsran_vec_cf_malloc(M_zc);
+  cf_t*               ref  = srsran_vec_cf_malloc(M_zc);
+
+  args->ret = SRSRAN_ERROR;
+  if (r == NULL || ref == NULL) {
+    goto clean_exit;
+  }
+
+  for (uint32_t u = 0; u < SRSRAN_ZC_SEQUENCE_NOF_GROUPS; u++) {
+    for (uint32_t v = 0; v < SRSRAN_ZC_SEQUENCE_NOF_BASE; v++) {
+      float alpha = 2.0f * (float)M_PI * ((u + v) % SRSRAN_NRE) / SRSRAN_NRE;
+      if (srsran_zc_sequence_generate_lte(u, v, alpha, args->nof_prb, r) < SRSRAN_SUCCESS) {
+        goto clean_exit;
+      }
+      zc_sequence_ref(u, v, alpha, M_zc, ref);
+      if (max_error(r, ref, M_zc) > MAX_ERROR) {
+        goto clean_exit;
+      }
+    }
+  }
+
+  args->ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  if (r) {
+    free(r);
+  }
+  if (ref) {
+    free(ref);
+  }
+  return NULL;
+}
+
+static int test_threads()
+{
+  pthread_t          threads[NOF_THREADS];
+  test_thread_args_t args[NOF_THREADS];
+
+  for (uint32_t i = 0; i < NOF_THREADS; i++) {
+    args[i].nof_prb = 48;
+    args[i].ret     = SRSRAN_ERROR;
+    TESTASSERT(pthread_create(&threads[i], NULL, test_thread, &args[i]) == 0);
+  }
+
+  for (uint32_t i = 0; i < NOF_THREADS; i++) {
+    pthread_join(threads[i], NULL);
+    TESTASSERT(args[i].ret == SRSRAN_SUCCESS);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Generates the PUSCH DMRS sequences of every subframe and cyclic shift of a 100 PRB cell, as the pregeneration does */
+static uint64_t test_pregen_time_us()
+{
+  struct timeval t[3] = {};
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    for (uint32_t n_cs = 0; n_cs < 8; n_cs++) {
+      for (uint32_t nof_prb = 1; nof_prb <= 100; nof_prb++) {
+        uint32_t u = (sf_idx * 7 + nof_prb) % SRSRAN_ZC_SEQUENCE_NOF_GROUPS;
+        srsran_zc_sequence_generate_lte(u, 0, 2.0f * (float)M_PI * n_cs / SRSRAN_NRE, nof_prb, sequence);
+      }
+    }
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+
+  return t[0].tv_sec * 1000000UL + t[0].tv_usec;
+}
+
+int main(int argc, char** argv)
+{
+  // Populate the cache from several threads at the same time before any other test
+  TESTASSERT(test_threads() == SRSRAN_SUCCESS);
+
+  TESTASSERT(test_lte_long() == SRSRAN_SUCCESS);
+  TESTASSERT(test_short(false, 12) == SRSRAN_SUCCESS);
+  TESTASSERT(test_short(false, 24) == SRSRAN_SUCCESS);
+  TESTASSERT(test_short(true, 6) == SRSRAN_SUCCESS);
+  TESTASSERT(test_short(true, 12) == SRSRAN_SUCCESS);
+  TESTASSERT(test_short(true, 18) == SRSRAN_SUCCESS);
+  TESTASSERT(test_short(true, 24) == SRSRAN_SUCCESS);
+
+  // The first run populates the cache for the subframe groups, the second finds all the base sequences in it
+  uint64_t cold_us = test_pregen_time_us();
+  uint64_t warm_us = test_pregen_time_us();
+  printf("DMRS pregeneration: first run %ld us, second run %ld us\n", (long)cold_us, (long)warm_us);
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
@@ -26,9 +26,18 @@
 #include "srsran/phy/utils/vector.h"
 #include <assert.h>
 #include <complex.h>
+#include <pthread.h>
 
 #define NOF_ZC_SEQ 30
 
+/* The base sequences are cached by their length divided by half a PRB */
+#define ZC_CACHE_LEN_UNIT (SRSRAN_NRE / 2)
+
+/* The sequences shorter than 36 come from tables which are different for LTE and NR */
+#define ZC_CACHE_NOF_SHORT (36 / ZC_CACHE_LEN_UNIT)
+
+#define ZC_CACHE_NOF_LONG (SRSRAN_ZC_SEQUENCE_CACHE_MAX_LEN / ZC_CACHE_LEN_UNIT + 1)
+
 // Phi values for M_sc=12 Table 5.5.1.2-1 in TS 36.211
 static const float zc_sequence_lte_phi_M_sc_12[NOF_ZC_SEQ][12] = {
     {-1, 1, 3, -3, 3, 3, 1, 1, 3, 1, -3, 3},      {1, 1, 3, 3, 3, -1, 1, -3, -3, 1, -3, 3},
@@ -231,11 +240,13 @@ static void zc_sequence_r_uv_arg_mprb(uint32_t M_zc, uint32_t u, uint32_t v, cf_
 {
   int32_t N_sz = srsran_prime_lower_than(M_zc); // N_zc - Zadoff Chu Sequence Length
   if (N_sz > 0) {
-    float q    = zc_sequence_q(u, v, N_sz);
-    float n_sz = (float)N_sz;
+    uint64_t q    = zc_sequence_q(u, v, N_sz);
+    float    n_sz = (float)N_sz;
     for (uint32_t i = 0; i < M_zc; i++) {
-      float m    = (float)(i % N_sz);
-      tmp_arg[i] = -M_PI * q * m * (m + 1) / n_sz;
+      // Reduce q * m * (m + 1) modulo 2 * N_sz with integers, the phase in floating point loses precision otherwise
+      uint64_t m = i % N_sz;
+      uint64_t k = (q * m * (m + 1)) % (2 * (uint64_t)N_sz);
+      tmp_arg[i] = -M_PI * (float)k / n_sz;
     }
   }
 }
@@ -283,6 +294,68 @@ static void zc_sequence_generate(uint32_t M_zc, float alpha, const cf_t* tmp_arg
   }
 }
 
+/* Base sequences (alpha = 0) shared by all the users in the process. They are generated the first time they are
+ * requested and never released, the number of entries is bounded by the table sizes. */
+static cf_t*           zc_cache_short[2][NOF_ZC_SEQ][ZC_CACHE_NOF_SHORT];
+static cf_t*           zc_cache_long[NOF_ZC_SEQ][SRSRAN_ZC_SEQUENCE_NOF_BASE][ZC_CACHE_NOF_LONG];
+static pthread_mutex_t zc_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* Returns the cached base sequence, or NULL if the length is not cached or the generation fails */
+static const cf_t* zc_sequence_base_get(bool nr, uint32_t u, uint32_t v, uint32_t M_zc)
+{
+  if (M_zc == 0 || M_zc % ZC_CACHE_LEN_UNIT != 0 || M_zc > SRSRAN_ZC_SEQUENCE_CACHE_MAX_LEN) {
+    return NULL;
+  }
+
+  // The short sequences do not depend on v, the long ones are common for LTE and NR
+  uint32_t idx   = M_zc / ZC_CACHE_LEN_UNIT;
+  cf_t**   entry = (M_zc < 36) ? &zc_cache_short[nr ? 1 : 0][u][idx] : &zc_cache_long[u][v][idx];
+
+  pthread_mutex_lock(&zc_cache_mutex);
+
+  if (*entry == NULL) {
+    cf_t* sequence = srsran_vec_cf_malloc(M_zc);
+    if (sequence != NULL) {
+      int ret = nr ? zc_sequence_nr_r_uv_arg(M_zc, u, v, sequence) : zc_sequence_lte_r_uv_arg(M_zc, u, v, sequence);
+      if (ret == SRSRAN_SUCCESS) {
+        zc_sequence_generate(M_zc, 0.0f, sequence, sequence);
+        *entry = sequence;
+      } else {
+        free(sequence);
+      }
+    }
+  }
+
+  const cf_t* ret = *entry;
+
+  pthread_mutex_unlock(&zc_cache_mutex);
+
+  return ret;
+}
+
+/* Applies the cyclic shift to the cached base sequence. It generates the sequence if it is not cached */
+static int zc_sequence_generate_cached(bool nr, uint32_t u, uint32_t v, float alpha, uint32_t M_zc, cf_t* sequence)
+{
+  const cf_t* base = zc_sequence_base_get(nr, u, v, M_zc);
+
+  if (base == NULL) {
+    int ret = nr ? zc_sequence_nr_r_uv_arg(M_zc, u, v, sequence) : zc_sequence_lte_r_uv_arg(M_zc, u, v, sequence);
+    if (ret < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    zc_sequence_generate(M_zc, alpha, sequence, sequence);
+    return SRSRAN_SUCCESS;
+  }
+
+  if (isnormal(alpha)) {
+    srsran_vec_apply_cfo(base, alpha / (2.0f * (float)M_PI), sequence, (int)M_zc);
+  } else {
+    srsran_vec_cf_copy(sequence, base, M_zc);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_zc_sequence_generate_lte(uint32_t u, uint32_t v, float alpha, uint32_t nof_prb, cf_t* sequence)
 {
   // Check inputs
@@ -299,15 +372,8 @@ int srsran_zc_sequence_generate_lte(uint32_t u, uint32_t v, float alpha, uint32_
   // Calculate number of samples
   uint32_t M_zc = nof_prb * SRSRAN_NRE;
 
-  // Calculate argument
-  if (zc_sequence_lte_r_uv_arg(M_zc, u, v, sequence) < SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
-  }
-
-  // Do complex exponential and adjust amplitude
-  zc_sequence_generate(M_zc, alpha, sequence, sequence);
-
-  return SRSRAN_SUCCESS;
+  // Apply the cyclic shift to the base sequence
+  return zc_sequence_generate_cached(false, u, v, alpha, M_zc, sequence);
 }
 
 int srsran_zc_sequence_generate_nr(uint32_t u, uint32_t v, float alpha, uint32_t m, uint32_t delta, cf_t* sequence)
@@ -326,15 +392,8 @@ int srsran_zc_sequence_generate_nr(uint32_t u, uint32_t v, float alpha, uint32_t
   // Calculate number of samples
   uint32_t M_zc = (m * SRSRAN_NRE) >> delta;
 
-  // Calculate argument
-  if (zc_sequence_nr_r_uv_arg(M_zc, u, v, sequence) < SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
-  }
-
-  // Do complex exponential and adjust amplitude
-  zc_sequence_generate(M_zc, alpha, sequence, sequence);
-
-  return SRSRAN_SUCCESS;
+  // Apply the cyclic shift to the base sequence
+  return zc_sequence_generate_cached(true, u, v, alpha, M_zc, sequence);
 }
 
 int srsran_zc_sequence_lut_init_nr(srsran_zc_sequence_lut_t* q,
@@ -27,6 +27,7 @@
 #include <string.h>
 #include <unistd.h>
 
+#include "dft_native.h"
 #include "srsran/phy/dft/dft.h"
 #include "srsran/phy/utils/vector.h"
 
@@ -53,9 +54,15 @@ static int get_fftw_wisdom_file(char* full_path, uint32_t n)
 
 static pthread_mutex_t fft_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-// This function is called in the beggining of any executable where it is linked
-__attribute__((constructor)) static void srsran_dft_load()
+static srsran_dft_backend_t dft_backend = SRSRAN_DFT_BACKEND_FFTW;
+
+// The wisdom is loaded before the first FFTW plan, processes that only use the native backend never read it
+static pthread_once_t fftw_wisdom_once   = PTHREAD_ONCE_INIT;
+static bool           fftw_wisdom_loaded = false;
+
+static void srsran_dft_load()
 {
+  fftw_wisdom_loaded = true;
 #ifdef FFTW_WISDOM_FILE
   char full_path[256];
   get_fftw_wisdom_file(full_path, sizeof(full_path));
@@ -84,6 +91,9 @@ __attribute__((constructor)) static void srsran_dft_load()
 // This function is called in the ending of any executable where it is linked
 __attribute__((destructor)) void srsran_dft_exit()
 {
+  if (!fftw_wisdom_loaded) {
+    return;
+  }
 #ifdef FFTW_WISDOM_FILE
   char full_path[256];
   get_fftw_wisdom_file(full_path, sizeof(full_path));
@@ -107,6 +117,44 @@ __attribute__((destructor)) void srsran_dft_exit()
   fftwf_cleanup();
 }
 
+void srsran_dft_set_backend(srsran_dft_backend_t backend)
+{
+  dft_backend = backend;
+}
+
+srsran_dft_backend_t srsran_dft_get_backend()
+{
+  return dft_backend;
+}
+
+static bool dft_use_native(int dft_points)
+{
+  return dft_backend == SRSRAN_DFT_BACKEND_NATIVE && dft_points > 0 && dft_native_is_supported((uint32_t)dft_points);
+}
+
+// Must be called with fft_mutex taken
+static void dft_destroy_plan(srsran_dft_plan_t* plan)
+{
+  if (plan->p == NULL) {
+    return;
+  }
+  if (plan->backend == SRSRAN_DFT_BACKEND_NATIVE) {
+    dft_native_free(plan->p);
+  } else {
+    fftwf_destroy_plan(plan->p);
+  }
+  plan->p = NULL;
+}
+
+static void dft_execute(srsran_dft_plan_t* plan)
+{
+  if (plan->backend == SRSRAN_DFT_BACKEND_NATIVE) {
+    dft_native_execute(plan->p, plan->in, plan->out);
+  } else {
+    fftwf_execute(plan->p);
+  }
+}
+
 int srsran_dft_plan(srsran_dft_plan_t* plan, const int dft_points, srsran_dft_dir_t dir, srsran_dft_mode_t mode)
 {
   bzero(plan, sizeof(srsran_dft_plan_t));
@@ -159,9 +207,17 @@ int srsran_dft_replan_guru_c(srsran_dft_plan_t* plan,
   pthread_mutex_lock(&fft_mutex);
 
   /* Destroy current plan */
-  fftwf_destroy_plan(plan->p);
+  dft_destroy_plan(plan);
 
-  plan->p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
+  if (dft_use_native(new_dft_points)) {
+    plan->p = dft_native_create_guru(
+        new_dft_points, plan->forward, in_buffer, out_buffer, istride, ostride, how_many, idist, odist);
+    plan->backend = SRSRAN_DFT_BACKEND_NATIVE;
+  } else {
+    pthread_once(&fftw_wisdom_once, srsran_dft_load);
+    plan->p       = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
+    plan->backend = SRSRAN_DFT_BACKEND_FFTW;
+  }
 
   pthread_mutex_unlock(&fft_mutex);
 
@@ -184,11 +240,15 @@ int srsran_dft_replan_c(srsran_dft_plan_t* plan, const int new_dft_points)
   }
 
   pthread_mutex_lock(&fft_mutex);
-  if (plan->p) {
-    fftwf_destroy_plan(plan->p);
-    plan->p = NULL;
+  dft_destroy_plan(plan);
+  if (dft_use_native(new_dft_points)) {
+    plan->p       = dft_native_create(new_dft_points, plan->dir == SRSRAN_DFT_FORWARD);
+    plan->backend = SRSRAN_DFT_BACKEND_NATIVE;
+  } else {
+    pthread_once(&fftw_wisdom_once, srsran_dft_load);
+    plan->p       = fftwf_plan_dft_1d(new_dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+    plan->backend = SRSRAN_DFT_BACKEND_FFTW;
   }
-  plan->p = fftwf_plan_dft_1d(new_dft_points, plan->in, plan->out, sign, FFTW_TYPE);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -216,7 +276,15 @@ int srsran_dft_plan_guru_c(srsran_dft_plan_t* plan,
 
   pthread_mutex_lock(&fft_mutex);
 
-  plan->p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
+  if (dft_use_native(dft_points)) {
+    plan->p = dft_native_create_guru(
+        dft_points, dir == SRSRAN_DFT_FORWARD, in_buffer, out_buffer, istride, ostride, how_many, idist, odist);
+    plan->backend = SRSRAN_DFT_BACKEND_NATIVE;
+  } else {
+    pthread_once(&fftw_wisdom_once, srsran_dft_load);
+    plan->p       = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
+    plan->backend = SRSRAN_DFT_BACKEND_FFTW;
+  }
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -243,8 +311,15 @@ int srsran_dft_plan_c(srsran_dft_plan_t* plan, const int dft_points, srsran_dft_
 
   pthread_mutex_lock(&fft_mutex);
 
-  int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
-  plan->p  = fftwf_plan_dft_1d(dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  if (dft_use_native(dft_points)) {
+    plan->p       = dft_native_create(dft_points, dir == SRSRAN_DFT_FORWARD);
+    plan->backend = SRSRAN_DFT_BACKEND_NATIVE;
+  } else {
+    pthread_once(&fftw_wisdom_once, srsran_dft_load);
+    int sign      = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
+    plan->p       = fftwf_plan_dft_1d(dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+    plan->backend = SRSRAN_DFT_BACKEND_FFTW;
+  }
 
   pthread_mutex_unlock(&fft_mutex);
 
@@ -270,10 +345,8 @@ int srsran_dft_replan_r(srsran_dft_plan_t* plan, const int new_dft_points)
   int sign = (plan->dir == SRSRAN_DFT_FORWARD) ? FFTW_R2HC : FFTW_HC2R;
 
   pthread_mutex_lock(&fft_mutex);
-  if (plan->p) {
-    fftwf_destroy_plan(plan->p);
-    plan->p = NULL;
-  }
+  dft_destroy_plan(plan);
+  pthread_once(&fftw_wisdom_once, srsran_dft_load);
   plan->p = fftwf_plan_r2r_1d(new_dft_points, plan->in, plan->out, sign, FFTW_TYPE);
   pthread_mutex_unlock(&fft_mutex);
 
@@ -289,8 +362,11 @@ int srsran_dft_plan_r(srsran_dft_plan_t* plan, const int dft_points, srsran_dft_
   allocate(plan, sizeof(float), sizeof(float), dft_points);
   int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_R2HC : FFTW_HC2R;
 
+  // The real transforms are only implemented by FFTW
   pthread_mutex_lock(&fft_mutex);
-  plan->p = fftwf_plan_r2r_1d(dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  pthread_once(&fftw_wisdom_once, srsran_dft_load);
+  plan->p       = fftwf_plan_r2r_1d(dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  plan->backend = SRSRAN_DFT_BACKEND_FFTW;
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -362,7 +438,28 @@ void srsran_dft_run(srsran_dft_plan_t* plan, const void* in, void* out)
 
 void srsran_dft_run_c_zerocopy(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
 {
-  fftwf_execute_dft(plan->p, (cf_t*)in, out);
+  if (plan->backend == SRSRAN_DFT_BACKEND_NATIVE) {
+    dft_native_execute(plan->p, in, out);
+  } else {
+    fftwf_execute_dft(plan->p, (cf_t*)in, out);
+  }
+}
+
+void srsran_dft_run_c_shared(const srsran_dft_plan_t* plan, const cf_t* in, cf_t* out, cf_t* work)
+{
+  if (plan->backend == SRSRAN_DFT_BACKEND_NATIVE) {
+    dft_native_execute_work(plan->p, in, out, work);
+    return;
+  }
+
+  // New-array execution needs out-of-place buffers with the alignment of the ones the plan was created with
+  if (in != out && fftwf_alignment_of((float*)in) == 0 && fftwf_alignment_of((float*)out) == 0) {
+    fftwf_execute_dft(plan->p, (cf_t*)in, out);
+  } else {
+    srsran_vec_cf_copy(work, in, plan->size);
+    fftwf_execute_dft(plan->p, work, &work[plan->size]);
+    srsran_vec_cf_copy(out, &work[plan->size], plan->size);
+  }
 }
 
 void srsran_dft_run_c(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
@@ -372,7 +469,7 @@ void srsran_dft_run_c(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
   fftwf_complex* f_out = plan->out;
 
   copy_pre((uint8_t*)plan->in, (uint8_t*)in, sizeof(cf_t), plan->size, plan->forward, plan->mirror, plan->dc);
-  fftwf_execute(plan->p);
+  dft_execute(plan);
   if (plan->norm) {
     norm = 1.0 / sqrtf(plan->size);
     srsran_vec_sc_prod_cfc(f_out, norm, f_out, plan->size);
@@ -387,10 +484,12 @@ void srsran_dft_run_c(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
 
 void srsran_dft_run_guru_c(srsran_dft_plan_t* plan)
 {
-  if (plan->is_guru == true) {
-    fftwf_execute(plan->p);
-  } else {
+  if (plan->is_guru == false) {
     ERROR("srsran_dft_run_guru_c: the selected plan is not guru!");
+  } else if (plan->backend == SRSRAN_DFT_BACKEND_NATIVE) {
+    dft_native_execute_guru(plan->p);
+  } else {
+    fftwf_execute(plan->p);
   }
 }
 
@@ -402,7 +501,7 @@ void srsran_dft_run_r(srsran_dft_plan_t* plan, const float* in, float* out)
   float* f_out = plan->out;
 
   memcpy(plan->in, in, sizeof(float) * plan->size);
-  fftwf_execute(plan->p);
+  dft_execute(plan);
   if (plan->norm) {
     norm = 1.0 / plan->size;
     srsran_vec_sc_prod_fff(f_out, norm, f_out, plan->size);
@@ -429,8 +528,7 @@ void srsran_dft_plan_free(srsran_dft_plan_t* plan)
     if (plan->out)
       fftwf_free(plan->out);
   }
-  if (plan->p)
-    fftwf_destroy_plan(plan->p);
+  dft_destroy_plan(plan);
   pthread_mutex_unlock(&fft_mutex);
   bzero(plan, sizeof(srsran_dft_plan_t));
 }
@@ -0,0 +1,509 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "dft_native.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DFT_NATIVE_MAX_STAGES 32
+
+/* Twiddle factors of one DFT size and direction, shared by all the plans with the same parameters */
+typedef struct dft_native_kernel_s {
+  uint32_t                    size;
+  bool                        forward;
+  uint32_t                    nof_stages;
+  uint32_t                    radix[DFT_NATIVE_MAX_STAGES];
+  const cf_t*                 twiddles[DFT_NATIVE_MAX_STAGES]; // Stage k twiddle q*(radix-1)+t-1 is w_n^(q*t)
+  cf_t*                       buffer;
+  uint32_t                    nof_users;
+  struct dft_native_kernel_s* next;
+} dft_native_kernel_t;
+
+struct dft_native_s {
+  dft_native_kernel_t* kernel;
+  cf_t*                work;    // Stockham ping-pong buffer
+  cf_t*                strided; // Contiguous copy of strided guru vectors
+  cf_t*                in;
+  cf_t*                out;
+  int                  istride;
+  int                  ostride;
+  int                  how_many;
+  int                  idist;
+  int                  odist;
+};
+
+static dft_native_kernel_t* kernel_list  = NULL;
+static pthread_mutex_t      kernel_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* Radix-4 stages go first so that the stride of the following stages is a multiple of the SIMD width */
+static uint32_t dft_native_factorize(uint32_t size, uint32_t* radix)
+{
+  static const uint32_t radix_list[] = {4, 2, 3, 5};
+  uint32_t              nof_stages   = 0;
+
+  for (uint32_t i = 0; i < sizeof(radix_list) / sizeof(radix_list[0]); i++) {
+    while (size % radix_list[i] == 0 && nof_stages < DFT_NATIVE_MAX_STAGES) {
+      radix[nof_stages++] = radix_list[i];
+      size /= radix_list[i];
+    }
+  }
+
+  return (size == 1) ? nof_stages : 0;
+}
+
+bool dft_native_is_supported(uint32_t size)
+{
+  uint32_t radix[DFT_NATIVE_MAX_STAGES];
+  return size > 1 && dft_native_factorize(size, radix) > 0;
+}
+
+static dft_native_kernel_t* dft_native_kernel_create(uint32_t size, bool forward)
+{
+  dft_native_kernel_t* k = calloc(1, sizeof(dft_native_kernel_t));
+  if (k == NULL) {
+    return NULL;
+  }
+
+  k->size       = size;
+  k->forward    = forward;
+  k->nof_stages = dft_native_factorize(size, k->radix);
+
+  // Count the twiddle factors of all the stages
+  uint32_t nof_twiddles = 0;
+  for (uint32_t i = 0, n = size; i < k->nof_stages; n /= k->radix[i], i++) {
+    nof_twiddles += (n / k->radix[i]) * (k->radix[i] - 1);
+  }
+
+  k->buffer = srsran_vec_cf_malloc(nof_twiddles);
+  if (k->buffer == NULL) {
+    free(k);
+    return NULL;
+  }
+
+  cf_t* tw = k->buffer;
+  for (uint32_t i = 0, n = size; i < k->nof_stages; n /= k->radix[i], i++) {
+    uint32_t p    = k->radix[i];
+    uint32_t m    = n / p;
+    k->twiddles[i] = tw;
+    for (uint32_t q = 0; q < m; q++) {
+      for (uint32_t t = 1; t < p; t++) {
+        double arg = (forward ? -2.0 : 2.0) * M_PI * (double)(q * t) / (double)n;
+        *(tw++)    = (float)cos(arg) + _Complex_I * (float)sin(arg);
+      }
+    }
+  }
+
+  return k;
+}
+
+static dft_native_kernel_t* dft_native_kernel_get(uint32_t size, bool forward)
+{
+  pthread_mutex_lock(&kernel_mutex);
+
+  dft_native_kernel_t* k = kernel_list;
+  while (k != NULL && (k->size != size || k->forward != forward)) {
+    k = k->next;
+  }
+
+  if (k == NULL) {
+    k = dft_native_kernel_create(size, forward);
+    if (k != NULL) {
+      k->next     = kernel_list;
+      kernel_list = k;
+    }
+  }
+
+  if (k != NULL) {
+    k->nof_users++;
+  }
+
+  pthread_mutex_unlock(&kernel_mutex);
+
+  return k;
+}
+
+static void dft_native_kernel_put(dft_native_kernel_t* k)
+{
+  pthread_mutex_lock(&kernel_mutex);
+
+  if (--k->nof_users == 0) {
+    dft_native_kernel_t** it = &kernel_list;
+    while (*it != k) {
+      it = &(*it)->next;
+    }
+    *it = k->next;
+    free(k->buffer);
+    free(k);
+  }
+
+  pthread_mutex_unlock(&kernel_mutex);
+}
+
+/* Multiplies by the imaginary unit, with the sign of the transform exponent */
+static inline cf_t dft_native_rot(cf_t z, bool forward)
+{
+  return forward ? (cimagf(z) - _Complex_I * crealf(z)) : (-cimagf(z) + _Complex_I * crealf(z));
+}
+
+#if SRSRAN_SIMD_CF_SIZE
+static inline simd_cf_t dft_native_rot_simd(simd_cf_t z, bool forward)
+{
+  return forward ? srsran_simd_cf_neg(srsran_simd_cf_mulj(z)) : srsran_simd_cf_mulj(z);
+}
+#endif // SRSRAN_SIMD_CF_SIZE
+
+/*
+ * Each stage splits n-point sub-transforms, interleaved with stride s, into n/p-point sub-transforms with stride s*p:
+ *   y[j + s*(p*q + t)] = w_n^(q*t) * sum_r x[j + s*(q + r*n/p)] * w_p^(r*t)
+ * The SIMD loops run over j, where the input and output samples are contiguous.
+ */
+static void dft_native_stage2(uint32_t n, uint32_t s, const cf_t* tw, const cf_t* x, cf_t* y)
+{
+  uint32_t m = n / 2;
+
+  for (uint32_t q = 0; q < m; q++) {
+    const cf_t* x0 = &x[s * q];
+    const cf_t* x1 = &x[s * (q + m)];
+    cf_t*       y0 = &y[s * 2 * q];
+    cf_t*       y1 = &y[s * (2 * q + 1)];
+
+    uint32_t j = 0;
+#if SRSRAN_SIMD_CF_SIZE
+    if (s >= SRSRAN_SIMD_CF_SIZE) {
+      simd_cf_t w1 = srsran_simd_cf_set1(tw[q]);
+      for (; j + SRSRAN_SIMD_CF_SIZE <= s; j += SRSRAN_SIMD_CF_SIZE) {
+        simd_cf_t a0 = srsran_simd_cfi_loadu(&x0[j]);
+        simd_cf_t a1 = srsran_simd_cfi_loadu(&x1[j]);
+        srsran_simd_cfi_storeu(&y0[j], srsran_simd_cf_add(a0, a1));
+        srsran_simd_cfi_storeu(&y1[j], srsran_simd_cf_prod(srsran_simd_cf_sub(a0, a1), w1));
+      }
+    }
+#endif // SRSRAN_SIMD_CF_SIZE
+    for (; j < s; j++) {
+      y0[j] = x0[j] + x1[j];
+      y1[j] = (x0[j] - x1[j]) * tw[q];
+    }
+  }
+}
+
+static void dft_native_stage3(uint32_t n, uint32_t s, const cf_t* tw, const cf_t* x, cf_t* y, bool forward)
+{
+  const float c = -0.5f;
+  const float d = 0.86602540378443864676f; // sin(2*pi/3)
+  uint32_t    m = n / 3;
+
+  for (uint32_t q = 0; q < m; q++) {
+    const cf_t* x0 = &x[s * q];
+    const cf_t* x1 = &x[s * (q + m)];
+    const cf_t* x2 = &x[s * (q + 2 * m)];
+    cf_t*       y0 = &y[s * 3 * q];
+    cf_t*       y1 = &y[s * (3 * q + 1)];
+    cf_t*       y2 = &y[s * (3 * q + 2)];
+
+    uint32_t j = 0;
+#if SRSRAN_SIMD_CF_SIZE
+    if (s >= SRSRAN_SIMD_CF_SIZE) {
+      simd_cf_t w1 = srsran_simd_cf_set1(tw[2 * q]);
+      simd_cf_t w2 = srsran_simd_cf_set1(tw[2 * q + 1]);
+      simd_f_t  cv = srsran_simd_f_set1(c);
+      simd_f_t  dv = srsran_simd_f_set1(d);
+      for (; j + SRSRAN_SIMD_CF_SIZE <= s; j += SRSRAN_SIMD_CF_SIZE) {
+        simd_cf_t a0 = srsran_simd_cfi_loadu(&x0[j]);
+        simd_cf_t a1 = srsran_simd_cfi_loadu(&x1[j]);
+        simd_cf_t a2 = srsran_simd_cfi_loadu(&x2[j]);
+        simd_cf_t t1 = srsran_simd_cf_add(a1, a2);
+        simd_cf_t t2 = dft_native_rot_simd(srsran_simd_cf_mul(srsran_simd_cf_sub(a1, a2), dv), forward);
+        simd_cf_t m1 = srsran_simd_cf_add(a0, srsran_simd_cf_mul(t1, cv));
+        srsran_simd_cfi_storeu(&y0[j], srsran_simd_cf_add(a0, t1));
+        srsran_simd_cfi_storeu(&y1[j], srsran_simd_cf_prod(srsran_simd_cf_add(m1, t2), w1));
+        srsran_simd_cfi_storeu(&y2[j], srsran_simd_cf_prod(srsran_simd_cf_sub(m1, t2), w2));
+      }
+    }
+#endif // SRSRAN_SIMD_CF_SIZE
+    for (; j < s; j++) {
+      cf_t t1 = x1[j] + x2[j];
+      cf_t t2 = dft_native_rot((x1[j] - x2[j]) * d, forward);
+      cf_t m1 = x0[j] + t1 * c;
+      y0[j]   = x0[j] + t1;
+      y1[j]   = (m1 + t2) * tw[2 * q];
+      y2[j]   = (m1 - t2) * tw[2 * q + 1];
+    }
+  }
+}
+
+static void dft_native_stage4(uint32_t n, uint32_t s, const cf_t* tw, const cf_t* x, cf_t* y, bool forward)
+{
+  uint32_t m = n / 4;
+
+  for (uint32_t q = 0; q < m; q++) {
+    const cf_t* x0 = &x[s * q];
+    const cf_t* x1 = &x[s * (q + m)];
+    const cf_t* x2 = &x[s * (q + 2 * m)];
+    const cf_t* x3 = &x[s * (q + 3 * m)];
+    cf_t*       y0 = &y[s * 4 * q];
+    cf_t*       y1 = &y[s * (4 * q + 1)];
+    cf_t*       y2 = &y[s * (4 * q + 2)];
+    cf_t*       y3 = &y[s * (4 * q + 3)];
+
+    uint32_t j = 0;
+#if SRSRAN_SIMD_CF_SIZE
+    if (s >= SRSRAN_SIMD_CF_SIZE) {
+      simd_cf_t w1 = srsran_simd_cf_set1(tw[3 * q]);
+      simd_cf_t w2 = srsran_simd_cf_set1(tw[3 * q + 1]);
+      simd_cf_t w3 = srsran_simd_cf_set1(tw[3 * q + 2]);
+      for (; j + SRSRAN_SIMD_CF_SIZE <= s; j += SRSRAN_SIMD_CF_SIZE) {
+        simd_cf_t a0 = srsran_simd_cfi_loadu(&x0[j]);
+        simd_cf_t a1 = srsran_simd_cfi_loadu(&x1[j]);
+        simd_cf_t a2 = srsran_simd_cfi_loadu(&x2[j]);
+        simd_cf_t a3 = srsran_simd_cfi_loadu(&x3[j]);
+        simd_cf_t t0 = srsran_simd_cf_add(a0, a2);
+        simd_cf_t t1 = srsran_simd_cf_sub(a0, a2);
+        simd_cf_t t2 = srsran_simd_cf_add(a1, a3);
+        simd_cf_t t3 = dft_native_rot_simd(srsran_simd_cf_sub(a1, a3), forward);
+        srsran_simd_cfi_storeu(&y0[j], srsran_simd_cf_add(t0, t2));
+        srsran_simd_cfi_storeu(&y1[j], srsran_simd_cf_prod(srsran_simd_cf_add(t1, t3), w1));
+        srsran_simd_cfi_storeu(&y2[j], srsran_simd_cf_prod(srsran_simd_cf_sub(t0, t2), w2));
+        srsran_simd_cfi_storeu(&y3[j], srsran_simd_cf_prod(srsran_simd_cf_sub(t1, t3), w3));
+      }
+    }
+#endif // SRSRAN_SIMD_CF_SIZE
+    for (; j < s; j++) {
+      cf_t t0 = x0[j] + x2[j];
+      cf_t t1 = x0[j] - x2[j];
+      cf_t t2 = x1[j] + x3[j];
+      cf_t t3 = dft_native_rot(x1[j] - x3[j], forward);
+      y0[j]   = t0 + t2;
+      y1[j]   = (t1 + t3) * tw[3 * q];
+      y2[j]   = (t0 - t2) * tw[3 * q + 1];
+      y3[j]   = (t1 - t3) * tw[3 * q + 2];
+    }
+  }
+}
+
+static void dft_native_stage5(uint32_t n, uint32_t s, const cf_t* tw, const cf_t* x, cf_t* y, bool forward)
+{
+  const float c1 = 0.30901699437494742410f;  // cos(2*pi/5)
+  const float c2 = -0.80901699437494742410f; // cos(4*pi/5)
+  const float s1 = 0.95105651629515357212f;  // sin(2*pi/5)
+  const float s2 = 0.58778525229247312917f;  // sin(4*pi/5)
+  uint32_t    m  = n / 5;
+
+  for (uint32_t q = 0; q < m; q++) {
+    const cf_t* x0 = &x[s * q];
+    const cf_t* x1 = &x[s * (q + m)];
+    const cf_t* x2 = &x[s * (q + 2 * m)];
+    const cf_t* x3 = &x[s * (q + 3 * m)];
+    const cf_t* x4 = &x[s * (q + 4 * m)];
+    const cf_t* w  = &tw[4 * q];
+
+    uint32_t j = 0;
+#if SRSRAN_SIMD_CF_SIZE
+    if (s >= SRSRAN_SIMD_CF_SIZE) {
+      simd_cf_t w1  = srsran_simd_cf_set1(w[0]);
+      simd_cf_t w2  = srsran_simd_cf_set1(w[1]);
+      simd_cf_t w3  = srsran_simd_cf_set1(w[2]);
+      simd_cf_t w4  = srsran_simd_cf_set1(w[3]);
+      simd_f_t  c1v = srsran_simd_f_set1(c1);
+      simd_f_t  c2v = srsran_simd_f_set1(c2);
+      simd_f_t  s1v = srsran_simd_f_set1(s1);
+      simd_f_t  s2v = srsran_simd_f_set1(s2);
+      for (; j + SRSRAN_SIMD_CF_SIZE <= s; j += SRSRAN_SIMD_CF_SIZE) {
+        simd_cf_t a0 = srsran_simd_cfi_loadu(&x0[j]);
+        simd_cf_t a1 = srsran_simd_cfi_loadu(&x1[j]);
+        simd_cf_t a2 = srsran_simd_cfi_loadu(&x2[j]);
+        simd_cf_t a3 = srsran_simd_cfi_loadu(&x3[j]);
+        simd_cf_t a4 = srsran_simd_cfi_loadu(&x4[j]);
+        simd_cf_t t1 = srsran_simd_cf_add(a1, a4);
+        simd_cf_t t2 = srsran_simd_cf_add(a2, a3);
+        simd_cf_t t3 = srsran_simd_cf_sub(a1, a4);
+        simd_cf_t t4 = srsran_simd_cf_sub(a2, a3);
+        simd_cf_t m1 = srsran_simd_cf_add(srsran_simd_cf_mul(t1, c1v), srsran_simd_cf_mul(t2, c2v));
+        simd_cf_t m2 = srsran_simd_cf_add(srsran_simd_cf_mul(t1, c2v), srsran_simd_cf_mul(t2, c1v));
+        simd_cf_t n1 = srsran_simd_cf_add(srsran_simd_cf_mul(t3, s1v), srsran_simd_cf_mul(t4, s2v));
+        simd_cf_t n2 = srsran_simd_cf_sub(srsran_simd_cf_mul(t3, s2v), srsran_simd_cf_mul(t4, s1v));
+        m1           = srsran_simd_cf_add(a0, m1);
+        m2           = srsran_simd_cf_add(a0, m2);
+        n1           = dft_native_rot_simd(n1, forward);
+        n2           = dft_native_rot_simd(n2, forward);
+        srsran_simd_cfi_storeu(&y[s * 5 * q + j], srsran_simd_cf_add(a0, srsran_simd_cf_add(t1, t2)));
+        srsran_simd_cfi_storeu(&y[s * (5 * q + 1) + j], srsran_simd_cf_prod(srsran_simd_cf_add(m1, n1), w1));
+        srsran_simd_cfi_storeu(&y[s * (5 * q + 2) + j], srsran_simd_cf_prod(srsran_simd_cf_add(m2, n2), w2));
+        srsran_simd_cfi_storeu(&y[s * (5 * q + 3) + j], srsran_simd_cf_prod(srsran_simd_cf_sub(m2, n2), w3));
+        srsran_simd_cfi_storeu(&y[s * (5 * q + 4) + j], srsran_simd_cf_prod(srsran_simd_cf_sub(m1, n1), w4));
+      }
+    }
+#endif // SRSRAN_SIMD_CF_SIZE
+    for (; j < s; j++) {
+      cf_t t1                 = x1[j] + x4[j];
+      cf_t t2                 = x2[j] + x3[j];
+      cf_t t3                 = x1[j] - x4[j];
+      cf_t t4                 = x2[j] - x3[j];
+      cf_t m1                 = x0[j] + t1 * c1 + t2 * c2;
+      cf_t m2                 = x0[j] + t1 * c2 + t2 * c1;
+      cf_t n1                 = dft_native_rot(t3 * s1 + t4 * s2, forward);
+      cf_t n2                 = dft_native_rot(t3 * s2 - t4 * s1, forward);
+      y[s * 5 * q + j]        = x0[j] + t1 + t2;
+      y[s * (5 * q + 1) + j]  = (m1 + n1) * w[0];
+      y[s * (5 * q + 2) + j]  = (m2 + n2) * w[1];
+      y[s * (5 * q + 3) + j]  = (m2 - n2) * w[2];
+      y[s * (5 * q + 4) + j]  = (m1 - n1) * w[3];
+    }
+  }
+}
+
+dft_native_t* dft_native_create(uint32_t size, bool forward)
+{
+  if (!dft_native_is_supported(size)) {
+    ERROR("The native DFT does not support the size %d", size);
+    return NULL;
+  }
+
+  dft_native_t* q = calloc(1, sizeof(dft_native_t));
+  if (q == NULL) {
+    return NULL;
+  }
+
+  q->kernel = dft_native_kernel_get(size, forward);
+  q->work   = srsran_vec_cf_malloc(size);
+  if (q->kernel == NULL || q->work == NULL) {
+    dft_native_free(q);
+    return NULL;
+  }
+
+  return q;
+}
+
+dft_native_t* dft_native_create_guru(uint32_t size,
+                                     bool     forward,
+                                     cf_t*    in,
+                                     cf_t*    out,
+                                     int      istride,
+                                     int      ostride,
+                                     int      how_many,
+                                     int      idist,
+                                     int      odist)
+{
+  dft_native_t* q = dft_native_create(size, forward);
+  if (q == NULL) {
+    return NULL;
+  }
+
+  if (istride != 1 || ostride != 1) {
+    q->strided = srsran_vec_cf_malloc(size);
+    if (q->strided == NULL) {
+      dft_native_free(q);
+      return NULL;
+    }
+  }
+
+  q->in       = in;
+  q->out      = out;
+  q->istride  = istride;
+  q->ostride  = ostride;
+  q->how_many = how_many;
+  q->idist    = idist;
+  q->odist    = odist;
+
+  return q;
+}
+
+void dft_native_execute(dft_native_t* q, const cf_t* in, cf_t* out)
+{
+  dft_native_execute_work(q, in, out, q->work);
+}
+
+void dft_native_execute_work(const dft_native_t* q, const cf_t* in, cf_t* out, cf_t* work)
+{
+  const dft_native_kernel_t* k = q->kernel;
+
+  // The stages alternate between the output and the scratch buffer, the last one always writes the output
+  const cf_t* src = in;
+  if (in == out && k->nof_stages % 2 == 1) {
+    srsran_vec_cf_copy(work, in, k->size);
+    src = work;
+  }
+
+  for (uint32_t i = 0, n = k->size, s = 1; i < k->nof_stages; n /= k->radix[i], s *= k->radix[i], i++) {
+    cf_t* dst = ((k->nof_stages - 1 - i) % 2 == 0) ? out : work;
+    switch (k->radix[i]) {
+      case 2:
+        dft_native_stage2(n, s, k->twiddles[i], src, dst);
+        break;
+      case 3:
+        dft_native_stage3(n, s, k->twiddles[i], src, dst, k->forward);
+        break;
+      case 4:
+        dft_native_stage4(n, s, k->twiddles[i], src, dst, k->forward);
+        break;
+      default:
+        dft_native_stage5(n, s, k->twiddles[i], src, dst, k->forward);
+        break;
+    }
+    src = dst;
+  }
+}
+
+void dft_native_execute_guru(dft_native_t* q)
+{
+  uint32_t size = q->kernel->size;
+
+  for (int h = 0; h < q->how_many; h++) {
+    cf_t* in  = &q->in[h * q->idist];
+    cf_t* out = &q->out[h * q->odist];
+
+    if (q->strided == NULL) {
+      dft_native_execute(q, in, out);
+      continue;
+    }
+
+    for (uint32_t i = 0; i < size; i++) {
+      q->strided[i] = in[i * q->istride];
+    }
+    dft_native_execute(q, q->strided, q->strided);
+    for (uint32_t i = 0; i < size; i++) {
+      out[i * q->ostride] = q->strided[i];
+    }
+  }
+}
+
+void dft_native_free(dft_native_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->kernel) {
+    dft_native_kernel_put(q->kernel);
+  }
+  if (q->work) {
+    free(q->work);
+  }
+  if (q->strided) {
+    free(q->strided);
+  }
+  free(q);
+}
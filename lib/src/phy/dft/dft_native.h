@@ -0,0 +1,118 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file dft_native.h
+ * \brief Declaration of the native mixed-radix DFT backend.
+ *
+ * The transform is a Stockham autosort FFT for lengths of the form \f$2^a 3^b 5^c\f$, which covers every LTE and NR
+ * symbol size and the transform precoding sizes. The twiddle factors of a given size and direction are computed once
+ * and shared, read-only, by all the plans that use them: a plan only owns its scratch buffer.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#ifndef SRSRAN_DFT_NATIVE_H
+#define SRSRAN_DFT_NATIVE_H
+
+#include "srsran/config.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct dft_native_s dft_native_t;
+
+/*!
+ * Checks whether the native backend can compute a DFT of a given length.
+ *
+ * \param[in] size DFT length.
+ * \return True if \a size is a product of the radices 2, 3 and 5, false otherwise.
+ */
+bool dft_native_is_supported(uint32_t size);
+
+/*!
+ * Creates a native DFT plan. The transforms are not normalized, as in FFTW.
+ *
+ * \param[in] size DFT length.
+ * \param[in] forward True for the forward transform (negative exponent), false for the inverse one.
+ * \return A pointer to the plan if the function executes correctly, NULL otherwise.
+ */
+dft_native_t* dft_native_create(uint32_t size, bool forward);
+
+/*!
+ * Creates a native DFT plan that transforms \a how_many vectors with the given layout, as FFTW guru plans do.
+ *
+ * \param[in] size DFT length.
+ * \param[in] forward True for the forward transform, false for the inverse one.
+ * \param[in] in Input buffer.
+ * \param[out] out Output buffer.
+ * \param[in] istride Distance between two consecutive input samples.
+ * \param[in] ostride Distance between two consecutive output samples.
+ * \param[in] how_many Number of transforms.
+ * \param[in] idist Distance between the first input samples of two consecutive transforms.
+ * \param[in] odist Distance between the first output samples of two consecutive transforms.
+ * \return A pointer to the plan if the function executes correctly, NULL otherwise.
+ */
+dft_native_t* dft_native_create_guru(uint32_t size,
+                                     bool     forward,
+                                     cf_t*    in,
+                                     cf_t*    out,
+                                     int      istride,
+                                     int      ostride,
+                                     int      how_many,
+                                     int      idist,
+                                     int      odist);
+
+/*!
+ * Computes one DFT. The input and output buffers can be the same.
+ *
+ * \param[in, out] q The plan, only its scratch buffer is modified.
+ * \param[in] in Input samples.
+ * \param[out] out Output samples.
+ */
+void dft_native_execute(dft_native_t* q, const cf_t* in, cf_t* out);
+
+/*!
+ * Computes one DFT with a scratch buffer owned by the caller. The plan is not modified, so that several threads can
+ * use it at the same time.
+ *
+ * \param[in] q The plan.
+ * \param[in] in Input samples.
+ * \param[out] out Output samples.
+ * \param[out] work Scratch buffer of the DFT length.
+ */
+void dft_native_execute_work(const dft_native_t* q, const cf_t* in, cf_t* out, cf_t* work);
+
+/*!
+ * Computes the transforms described by a plan created with dft_native_create_guru().
+ *
+ * \param[in, out] q The plan.
+ */
+void dft_native_execute_guru(dft_native_t* q);
+
+/*!
+ * Frees a native plan. The shared twiddle factors are released when no plan uses them anymore.
+ *
+ * \param[in] q The plan, it can be NULL.
+ */
+void dft_native_free(dft_native_t* q);
+
+#endif // SRSRAN_DFT_NATIVE_H
@@ -21,6 +21,7 @@
 
 #include <assert.h>
 #include <math.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -34,7 +35,42 @@
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
 
-/* Create DFT plans for transform precoding */
+/* DFT plans for transform precoding, shared by all the precoding objects. Index 0 holds the inverse transforms */
+static srsran_dft_plan_t dft_precoding_plans[2][SRSRAN_MAX_PRB + 1];
+static bool              dft_precoding_plans_ready = false;
+static pthread_mutex_t   dft_precoding_mutex       = PTHREAD_MUTEX_INITIALIZER;
+
+static int dft_precoding_create_plans()
+{
+  int ret = SRSRAN_SUCCESS;
+
+  pthread_mutex_lock(&dft_precoding_mutex);
+  if (dft_precoding_plans_ready) {
+    goto clean_exit;
+  }
+  for (uint32_t i = 1; i <= SRSRAN_MAX_PRB; i++) {
+    if (!srsran_dft_precoding_valid_prb(i)) {
+      continue;
+    }
+    for (uint32_t is_tx = 0; is_tx < 2; is_tx++) {
+      srsran_dft_plan_t* plan = &dft_precoding_plans[is_tx][i];
+      if (plan->size != 0) {
+        continue;
+      }
+      DEBUG("Initiating DFT precoding plan for %d PRBs", i);
+      if (srsran_dft_plan_c(plan, i * SRSRAN_NRE, is_tx ? SRSRAN_DFT_FORWARD : SRSRAN_DFT_BACKWARD)) {
+        ERROR("Error: Creating DFT plan %d", i);
+        ret = SRSRAN_ERROR;
+        goto clean_exit;
+      }
+    }
+  }
+  dft_precoding_plans_ready = true;
+
+clean_exit:
+  pthread_mutex_unlock(&dft_precoding_mutex);
+  return ret;
+}
 
 int srsran_dft_precoding_init(srsran_dft_precoding_t* q, uint32_t max_prb, bool is_tx)
 {
@@ -43,24 +79,19 @@ int srsran_dft_precoding_init(srsran_dft_precoding_t* q, uint32_t max_prb, bool
 
   if (max_prb <= SRSRAN_MAX_PRB) {
     ret = SRSRAN_ERROR;
-    for (uint32_t i = 1; i <= max_prb; i++) {
-      if (srsran_dft_precoding_valid_prb(i)) {
-        DEBUG("Initiating DFT precoding plan for %d PRBs", i);
-        if (srsran_dft_plan_c(&q->dft_plan[i], i * SRSRAN_NRE, is_tx ? SRSRAN_DFT_FORWARD : SRSRAN_DFT_BACKWARD)) {
-          ERROR("Error: Creating DFT plan %d", i);
-          goto clean_exit;
-        }
-        srsran_dft_plan_set_norm(&q->dft_plan[i], true);
-      }
+    if (dft_precoding_create_plans() < SRSRAN_SUCCESS) {
+      return ret;
+    }
+    q->work = srsran_vec_cf_malloc(2 * SRSRAN_NRE * SRSRAN_MAX(max_prb, 1));
+    if (q->work == NULL) {
+      ERROR("Error allocating memory");
+      return ret;
     }
     q->max_prb = max_prb;
+    q->is_tx   = is_tx;
     ret        = SRSRAN_SUCCESS;
   }
 
-clean_exit:
-  if (ret == SRSRAN_ERROR) {
-    srsran_dft_precoding_free(q);
-  }
   return ret;
 }
 
@@ -74,13 +105,11 @@ int srsran_dft_precoding_init_tx(srsran_dft_precoding_t* q, uint32_t max_prb)
   return srsran_dft_precoding_init(q, max_prb, true);
 }
 
-/* Free DFT plans for transform precoding */
+/* Free the scratch buffer, the shared DFT plans live until the process exits */
 void srsran_dft_precoding_free(srsran_dft_precoding_t* q)
 {
-  for (uint32_t i = 1; i <= q->max_prb; i++) {
-    if (srsran_dft_precoding_valid_prb(i)) {
-      srsran_dft_plan_free(&q->dft_plan[i]);
-    }
+  if (q->work) {
+    free(q->work);
   }
   bzero(q, sizeof(srsran_dft_precoding_t));
 }
@@ -113,14 +142,19 @@ uint32_t srsran_dft_precoding_get_valid_prb(uint32_t nof_prb)
 
 int srsran_dft_precoding(srsran_dft_precoding_t* q, cf_t* input, cf_t* output, uint32_t nof_prb, uint32_t nof_symbols)
 {
-  if (!srsran_dft_precoding_valid_prb(nof_prb) && nof_prb <= q->max_prb) {
+  if (!srsran_dft_precoding_valid_prb(nof_prb) || nof_prb > q->max_prb) {
     ERROR("Error invalid number of PRB (%d)", nof_prb);
     return SRSRAN_ERROR;
   }
 
+  const srsran_dft_plan_t* plan = &dft_precoding_plans[q->is_tx ? 1 : 0][nof_prb];
+  uint32_t                 len  = SRSRAN_NRE * nof_prb;
+
+  // Transform all the symbols without intermediate copies and normalize the whole grant at once
   for (uint32_t i = 0; i < nof_symbols; i++) {
-    srsran_dft_run_c(&q->dft_plan[nof_prb], &input[i * SRSRAN_NRE * nof_prb], &output[i * SRSRAN_NRE * nof_prb]);
+    srsran_dft_run_c_shared(plan, &input[i * len], &output[i * len], q->work);
   }
+  srsran_vec_sc_prod_cfc(output, 1.0f / sqrtf((float)len), output, len * nof_symbols);
 
   return SRSRAN_SUCCESS;
 }
@@ -30,11 +30,64 @@
 #include "srsran/phy/dft/dft.h"
 #include "srsran/phy/dft/ofdm.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/stage_prof.h"
 #include "srsran/phy/utils/vector.h"
 
 /* Uncomment next line for avoiding Guru DFT call */
 //#define AVOID_GURU
 
+/* Selects where the Rx CFO is removed and, if it is after the DFT, calculates the phase of every symbol window: the
+ * phase accumulated since the beginning of the subframe plus the average phase of the residual CFO within the window
+ */
+static void ofdm_rx_cfo_update(srsran_ofdm_t* q)
+{
+  q->cfo_post_dft = false;
+  q->cfo_shift    = 0;
+
+  if (!isnormal(q->cfo)) {
+    return;
+  }
+
+#ifdef AVOID_GURU
+  // The non-guru receiver does not extract the subcarriers, remove the CFO before the DFT
+  return;
+#endif
+
+  // The MBSFN receiver does not extract the subcarriers, remove the CFO before the DFT
+  if (q->mbsfn_subframe) {
+    return;
+  }
+
+  int32_t shift    = (int32_t)roundf(q->cfo);
+  float   residual = q->cfo - (float)shift;
+  if (fabsf(residual) > SRSRAN_OFDM_RX_CFO_MAX_RESIDUAL) {
+    return;
+  }
+
+  uint32_t symbol_sz = q->cfg.symbol_sz;
+  uint32_t count     = 0;
+  for (uint32_t l = 0; l < q->nof_symbols * SRSRAN_NOF_SLOTS_PER_SF; l++) {
+    uint32_t cp_len =
+        SRSRAN_CP_ISNORM(q->cfg.cp) ? SRSRAN_CP_LEN_NORM(l % q->nof_symbols, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+
+    // Advance CP
+    count += cp_len;
+
+    // First sample of the DFT window
+    double n0 = (double)count - (double)q->window_offset_n;
+
+    // Calculate the compensation phase in double precision and then convert to single
+    double phase_rad = -2.0 * M_PI * q->cfo * n0 / symbol_sz - M_PI * residual * (symbol_sz - 1) / symbol_sz;
+    q->cfo_compensation[l] = (cf_t)cexp(I * phase_rad);
+
+    // Advance symbol
+    count += symbol_sz;
+  }
+
+  q->cfo_shift    = shift;
+  q->cfo_post_dft = true;
+}
+
 static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft_dir_t dir)
 {
   // If the symbol size is not given, calculate in function of the number of resource blocks
@@ -235,6 +288,9 @@ static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft
     return SRSRAN_ERROR;
   }
 
+  // The CFO phases depend on the symbol size, CP and window offset
+  ofdm_rx_cfo_update(q);
+
   return SRSRAN_SUCCESS;
 }
 
@@ -409,6 +465,24 @@ int srsran_ofdm_set_phase_compensation(srsran_ofdm_t* q, double center_freq_hz)
   return SRSRAN_SUCCESS;
 }
 
+int srsran_ofdm_set_cfo(srsran_ofdm_t* q, float cfo)
+{
+  // Validate pointer
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Check if the CFO has changed
+  if (q->cfo == cfo) {
+    return SRSRAN_SUCCESS;
+  }
+
+  q->cfo = cfo;
+  ofdm_rx_cfo_update(q);
+
+  return SRSRAN_SUCCESS;
+}
+
 void srsran_ofdm_rx_free(srsran_ofdm_t* q)
 {
   srsran_ofdm_free_(q);
@@ -468,6 +542,43 @@ void srsran_ofdm_rx_slot_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output)
   }
 }
 
+/* Extracts len subcarriers of a DFT output starting at the bin idx while applying the window offset and the gain. The
+ * bins are read cfo_shift positions higher, wrapping around the symbol size, to remove the integer part of the CFO.
+ */
+static void ofdm_rx_extract_re(srsran_ofdm_t* q,
+                               const cf_t*    tmp,
+                               uint32_t       idx,
+                               cf_t*          output,
+                               uint32_t       len,
+                               cf_t           gain,
+                               bool           apply_gain)
+{
+  int32_t symbol_sz = (int32_t)q->cfg.symbol_sz;
+  int32_t src       = ((int32_t)idx + q->cfo_shift) % symbol_sz;
+  if (src < 0) {
+    src += symbol_sz;
+  }
+
+  uint32_t count = 0;
+  while (count < len) {
+    uint32_t n = SRSRAN_MIN(len - count, (uint32_t)(symbol_sz - src));
+
+    if (q->window_offset_n) {
+      srsran_vec_prod_ccc(&tmp[src], &q->window_offset_buffer[idx + count], &output[count], n);
+      if (apply_gain) {
+        srsran_vec_sc_prod_ccc(&output[count], gain, &output[count], n);
+      }
+    } else if (apply_gain) {
+      srsran_vec_sc_prod_ccc(&tmp[src], gain, &output[count], n);
+    } else {
+      srsran_vec_cf_copy(&output[count], &tmp[src], n);
+    }
+
+    count += n;
+    src = 0;
+  }
+}
+
 /* Transforms input samples into output OFDM symbols.
  * Performs FFT on a each symbol and removes CP.
  */
@@ -478,40 +589,36 @@ static void ofdm_rx_slot(srsran_ofdm_t* q, int slot_in_sf)
       q, q->cfg.in_buffer + slot_in_sf * q->slot_sz, q->cfg.out_buffer + slot_in_sf * q->nof_re * q->nof_symbols);
 #else
   uint32_t nof_symbols = q->nof_symbols;
-  uint32_t nof_re = q->nof_re;
-  cf_t* output = q->cfg.out_buffer + slot_in_sf * nof_re * nof_symbols;
-  uint32_t symbol_sz = q->cfg.symbol_sz;
-  float norm = 1.0f / sqrtf(q->fft_plan.size);
-  cf_t* tmp = q->tmp;
-  uint32_t dc = (q->fft_plan.dc) ? 1 : 0;
-
+  uint32_t nof_re      = q->nof_re;
+  cf_t*    output      = q->cfg.out_buffer + slot_in_sf * nof_re * nof_symbols;
+  uint32_t symbol_sz   = q->cfg.symbol_sz;
+  float    norm        = 1.0f / sqrtf(q->fft_plan.size);
+  cf_t*    tmp         = q->tmp;
+  uint32_t dc          = (q->fft_plan.dc) ? 1 : 0;
+  bool     apply_gain  = isnormal(q->cfg.phase_compensation_hz) || q->fft_plan.norm || q->cfo_post_dft;
+
+  // All the symbols of the slot are transformed at once
   srsran_dft_run_guru_c(&q->fft_plan_sf[slot_in_sf]);
 
-  for (int i = 0; i < q->nof_symbols; i++) {
-    // Apply frequency domain window offset
-    if (q->window_offset_n) {
-      srsran_vec_prod_ccc(tmp, q->window_offset_buffer, tmp, symbol_sz);
-    }
-
-    // Perform FFT shift
-    memcpy(output, tmp + symbol_sz - nof_re / 2, sizeof(cf_t) * nof_re / 2);
-    memcpy(output + nof_re / 2, &tmp[dc], sizeof(cf_t) * nof_re / 2);
+  // The negative frequencies go first in the output, the positive ones follow
+  uint32_t neg_offset = symbol_sz - nof_re / 2;
 
-    // Normalize output
+  for (int i = 0; i < nof_symbols; i++) {
+    // Combine phase compensation and normalization
+    cf_t gain = 1.0f;
     if (isnormal(q->cfg.phase_compensation_hz)) {
-      // Get phase compensation
-      cf_t phase_compensation = conjf(q->phase_compensation[slot_in_sf * q->nof_symbols + i]);
-
-      // Apply normalization
-      if (q->fft_plan.norm) {
-        phase_compensation *= norm;
-      }
-
-      // Apply correction
-      srsran_vec_sc_prod_ccc(output, phase_compensation, output, nof_re);
-    } else if (q->fft_plan.norm) {
-      srsran_vec_sc_prod_cfc(output, norm, output, nof_re);
+      gain = conjf(q->phase_compensation[slot_in_sf * q->nof_symbols + i]);
     }
+    if (q->fft_plan.norm) {
+      gain *= norm;
+    }
+    if (q->cfo_post_dft) {
+      gain *= q->cfo_compensation[slot_in_sf * q->nof_symbols + i];
+    }
+
+    // Perform FFT shift while applying the window offset, the CFO and the gain, only the used subcarriers are processed
+    ofdm_rx_extract_re(q, tmp, neg_offset, output, nof_re / 2, gain, apply_gain);
+    ofdm_rx_extract_re(q, tmp, dc, &output[nof_re / 2], nof_re / 2, gain, apply_gain);
 
     tmp += symbol_sz;
     output += nof_re;
@@ -550,9 +657,13 @@ void srsran_ofdm_rx_slot_zerocopy(srsran_ofdm_t* q, cf_t* input, cf_t* output)
 
 void srsran_ofdm_rx_sf(srsran_ofdm_t* q)
 {
+  uint64_t t0 = srsran_stage_prof_start();
   if (isnormal(q->cfg.freq_shift_f)) {
     srsran_vec_prod_ccc(q->cfg.in_buffer, q->shift_buffer, q->cfg.in_buffer, q->sf_sz);
   }
+  if (isnormal(q->cfo) && !q->cfo_post_dft) {
+    srsran_vec_apply_cfo(q->cfg.in_buffer, -q->cfo / (float)q->cfg.symbol_sz, q->cfg.in_buffer, q->sf_sz);
+  }
   if (!q->mbsfn_subframe) {
     for (uint32_t n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
       ofdm_rx_slot(q, n);
@@ -561,6 +672,28 @@ void srsran_ofdm_rx_sf(srsran_ofdm_t* q)
     ofdm_rx_slot_mbsfn(q, q->cfg.in_buffer, q->cfg.out_buffer);
     ofdm_rx_slot(q, 1);
   }
+  srsran_stage_prof_stop(SRSRAN_STAGE_PROF_OFDM, t0);
+}
+
+void srsran_ofdm_rx_sf_slots(srsran_ofdm_t* q, uint32_t first_slot, uint32_t nof_slots)
+{
+  // The CFO phase runs along the whole subframe
+  if (q->mbsfn_subframe || (isnormal(q->cfo) && !q->cfo_post_dft)) {
+    srsran_ofdm_rx_sf(q);
+    return;
+  }
+
+  uint64_t t0 = srsran_stage_prof_start();
+  nof_slots   = SRSRAN_MIN(nof_slots, SRSRAN_NOF_SLOTS_PER_SF - SRSRAN_MIN(first_slot, SRSRAN_NOF_SLOTS_PER_SF));
+  if (isnormal(q->cfg.freq_shift_f)) {
+    uint32_t offset = first_slot * q->slot_sz;
+    srsran_vec_prod_ccc(
+        &q->cfg.in_buffer[offset], &q->shift_buffer[offset], &q->cfg.in_buffer[offset], nof_slots * q->slot_sz);
+  }
+  for (uint32_t n = first_slot; n < first_slot + nof_slots; n++) {
+    ofdm_rx_slot(q, n);
+  }
+  srsran_stage_prof_stop(SRSRAN_STAGE_PROF_OFDM, t0);
 }
 
 void srsran_ofdm_rx_sf_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output)
@@ -569,6 +702,9 @@ void srsran_ofdm_rx_sf_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output)
   if (isnormal(q->cfg.freq_shift_f)) {
     srsran_vec_prod_ccc(input, q->shift_buffer, input, q->sf_sz);
   }
+  if (isnormal(q->cfo)) {
+    srsran_vec_apply_cfo(input, -q->cfo / (float)q->cfg.symbol_sz, input, q->sf_sz);
+  }
   if (!q->mbsfn_subframe) {
     for (n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
       srsran_ofdm_rx_slot_ng(q, &input[n * q->slot_sz], &output[n * q->nof_re * q->nof_symbols]);
@@ -579,6 +715,52 @@ void srsran_ofdm_rx_sf_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output)
   }
 }
 
+#ifndef AVOID_GURU
+/**
+ * Maps the resource elements of a slot in the IFFT inputs and runs the IFFT of all the slot symbols, the output is
+ * written in the output buffer after the CP of every symbol
+ */
+static void ofdm_tx_slot_ifft(srsran_ofdm_t* q, int slot_in_sf)
+{
+  uint32_t symbol_sz   = q->cfg.symbol_sz;
+  uint32_t nof_symbols = q->nof_symbols;
+  uint32_t nof_re      = q->nof_re;
+  cf_t*    input       = q->cfg.in_buffer + slot_in_sf * q->nof_re * q->nof_symbols;
+  cf_t*    tmp         = q->tmp;
+
+  bzero(tmp, q->slot_sz);
+  uint32_t dc = (q->fft_plan.dc) ? 1 : 0;
+
+  for (int i = 0; i < nof_symbols; i++) {
+    srsran_vec_cf_copy(&tmp[dc], &input[nof_re / 2], nof_re / 2);
+    srsran_vec_cf_copy(&tmp[symbol_sz - nof_re / 2], &input[0], nof_re / 2);
+
+    input += nof_re;
+    tmp += symbol_sz;
+  }
+
+  srsran_dft_run_guru_c(&q->fft_plan_sf[slot_in_sf]);
+}
+
+/**
+ * Gain applied to the IFFT output of a symbol, it combines the phase compensation and the normalization
+ */
+static cf_t ofdm_tx_symbol_gain(srsran_ofdm_t* q, int slot_in_sf, uint32_t i)
+{
+  cf_t gain = 1.0f;
+
+  if (isnormal(q->cfg.phase_compensation_hz)) {
+    gain = q->phase_compensation[slot_in_sf * q->nof_symbols + i];
+  }
+
+  if (q->fft_plan.norm) {
+    gain *= 1.0f / sqrtf(q->cfg.symbol_sz);
+  }
+
+  return gain;
+}
+#endif
+
 /* Transforms input OFDM symbols into output samples.
  * Performs the FFT on each symbol and adds CP.
  */
@@ -587,10 +769,10 @@ static void ofdm_tx_slot(srsran_ofdm_t* q, int slot_in_sf)
   uint32_t    symbol_sz = q->cfg.symbol_sz;
   srsran_cp_t cp        = q->cfg.cp;
 
-  cf_t* input  = q->cfg.in_buffer + slot_in_sf * q->nof_re * q->nof_symbols;
   cf_t* output = q->cfg.out_buffer + slot_in_sf * q->slot_sz;
 
 #ifdef AVOID_GURU
+  cf_t* input = q->cfg.in_buffer + slot_in_sf * q->nof_re * q->nof_symbols;
   for (int i = 0; i < q->nof_symbols; i++) {
     int cp_len = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
     memcpy(&q->tmp[q->nof_guards], input, q->nof_re * sizeof(cf_t));
@@ -601,53 +783,87 @@ static void ofdm_tx_slot(srsran_ofdm_t* q, int slot_in_sf)
     output += symbol_sz + cp_len;
   }
 #else
-  uint32_t nof_symbols = q->nof_symbols;
-  uint32_t nof_re = q->nof_re;
-  float norm = 1.0f / sqrtf(symbol_sz);
-  cf_t* tmp = q->tmp;
+  ofdm_tx_slot_ifft(q, slot_in_sf);
 
-  bzero(tmp, q->slot_sz);
-  uint32_t dc = (q->fft_plan.dc) ? 1 : 0;
+  for (int i = 0; i < q->nof_symbols; i++) {
+    int cp_len = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
 
-  for (int i = 0; i < nof_symbols; i++) {
-    srsran_vec_cf_copy(&tmp[dc], &input[nof_re / 2], nof_re / 2);
-    srsran_vec_cf_copy(&tmp[symbol_sz - nof_re / 2], &input[0], nof_re / 2);
+    // Apply phase compensation and normalization
+    if (isnormal(q->cfg.phase_compensation_hz)) {
+      srsran_vec_sc_prod_ccc(&output[cp_len], ofdm_tx_symbol_gain(q, slot_in_sf, i), &output[cp_len], symbol_sz);
+    } else if (q->fft_plan.norm) {
+      srsran_vec_sc_prod_cfc(&output[cp_len], 1.0f / sqrtf(symbol_sz), &output[cp_len], symbol_sz);
+    }
 
-    input += nof_re;
-    tmp += symbol_sz;
+    // With CFR, the CP is added once the CFR has processed the whole subframe
+    if (!q->cfg.cfr_tx_cfg.cfr_enable) {
+      /* add CP */
+      srsran_vec_cf_copy(output, &output[symbol_sz], cp_len);
+    }
+    output += symbol_sz + cp_len;
   }
+#endif
+}
 
-  srsran_dft_run_guru_c(&q->fft_plan_sf[slot_in_sf]);
+/* Applies the CFR to the time-domain symbols of the given slots in one batch and adds their CP.
+ */
+static void ofdm_tx_slot_cfr(srsran_ofdm_t* q, uint32_t first_slot, uint32_t nof_slots)
+{
+#ifndef AVOID_GURU
+  uint32_t    symbol_sz = q->cfg.symbol_sz;
+  srsran_cp_t cp        = q->cfg.cp;
+  cf_t*       symbols[SRSRAN_CFR_MAX_BATCH];
+  int         cp_lens[SRSRAN_CFR_MAX_BATCH];
+  uint32_t    nof_symbols = 0;
+
+  if (!q->cfg.cfr_tx_cfg.cfr_enable) {
+    return;
+  }
+
+  // CFR: Process the time-domain signal without the CP
+  for (uint32_t n = first_slot; n < first_slot + nof_slots; n++) {
+    cf_t* output = q->cfg.out_buffer + n * q->slot_sz;
+    for (int i = 0; i < q->nof_symbols; i++) {
+      int cp_len           = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+      cp_lens[nof_symbols] = cp_len;
+      symbols[nof_symbols] = output + cp_len;
+      nof_symbols++;
+      output += symbol_sz + cp_len;
+    }
+  }
+  srsran_cfr_process_batch(&q->tx_cfr, symbols, symbols, nof_symbols);
 
-  for (int i = 0; i < nof_symbols; i++) {
-    int cp_len = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+  /* add CP */
+  for (uint32_t i = 0; i < nof_symbols; i++) {
+    srsran_vec_cf_copy(symbols[i] - cp_lens[i], symbols[i] + symbol_sz - cp_lens[i], cp_lens[i]);
+  }
+#endif
+}
 
-    if (isnormal(q->cfg.phase_compensation_hz)) {
-      // Get phase compensation
-      cf_t phase_compensation = q->phase_compensation[slot_in_sf * q->nof_symbols + i];
+#ifndef AVOID_GURU
+static void ofdm_tx_slot_sc16(srsran_ofdm_t* q, int slot_in_sf, float scale, int16_t* output)
+{
+  uint32_t    symbol_sz = q->cfg.symbol_sz;
+  srsran_cp_t cp        = q->cfg.cp;
 
-      // Apply normalization
-      if (q->fft_plan.norm) {
-        phase_compensation *= norm;
-      }
+  cf_t* ifft_output = q->cfg.out_buffer + slot_in_sf * q->slot_sz;
 
-      // Apply correction
-      srsran_vec_sc_prod_ccc(&output[cp_len], phase_compensation, &output[cp_len], symbol_sz);
-    } else if (q->fft_plan.norm) {
-      srsran_vec_sc_prod_cfc(&output[cp_len], norm, &output[cp_len], symbol_sz);
-    }
+  ofdm_tx_slot_ifft(q, slot_in_sf);
 
-    // CFR: Process the time-domain signal without the CP
-    if (q->cfg.cfr_tx_cfg.cfr_enable) {
-      srsran_cfr_process(&q->tx_cfr, output + cp_len, output + cp_len);
-    }
+  for (int i = 0; i < q->nof_symbols; i++) {
+    int cp_len = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+
+    // Apply phase compensation, normalization and scaling while converting to sc16
+    cf_t gain = scale * ofdm_tx_symbol_gain(q, slot_in_sf, i);
+    srsran_vec_convert_sc_prod_cs(&ifft_output[cp_len], gain, &output[2 * cp_len], symbol_sz);
 
     /* add CP */
-    srsran_vec_cf_copy(output, &output[symbol_sz], cp_len);
-    output += symbol_sz + cp_len;
+    memcpy(output, &output[2 * symbol_sz], 2 * cp_len * sizeof(int16_t));
+    ifft_output += symbol_sz + cp_len;
+    output += 2 * (symbol_sz + cp_len);
   }
-#endif
 }
+#endif
 
 void ofdm_tx_slot_mbsfn(srsran_ofdm_t* q, cf_t* input, cf_t* output)
 {
@@ -675,18 +891,40 @@ void srsran_ofdm_set_normalize(srsran_ofdm_t* q, bool normalize_enable)
 
 void srsran_ofdm_tx_sf(srsran_ofdm_t* q)
 {
+  uint64_t t0 = srsran_stage_prof_start();
   uint32_t n;
   if (!q->mbsfn_subframe) {
     for (n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
       ofdm_tx_slot(q, n);
     }
+    ofdm_tx_slot_cfr(q, 0, SRSRAN_NOF_SLOTS_PER_SF);
   } else {
     ofdm_tx_slot_mbsfn(q, q->cfg.in_buffer, q->cfg.out_buffer);
     ofdm_tx_slot(q, 1);
+    ofdm_tx_slot_cfr(q, 1, 1);
   }
   if (isnormal(q->cfg.freq_shift_f)) {
     srsran_vec_prod_ccc(q->cfg.out_buffer, q->shift_buffer, q->cfg.out_buffer, q->sf_sz);
   }
+  srsran_stage_prof_stop(SRSRAN_STAGE_PROF_OFDM, t0);
+}
+
+void srsran_ofdm_tx_sf_sc16(srsran_ofdm_t* q, float scale, int16_t* output)
+{
+#ifndef AVOID_GURU
+  // MBSFN, CFR and frequency shift need the floating point signal
+  if (!q->mbsfn_subframe && !q->cfg.cfr_tx_cfg.cfr_enable && !isnormal(q->cfg.freq_shift_f)) {
+    uint64_t t0 = srsran_stage_prof_start();
+    for (uint32_t n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
+      ofdm_tx_slot_sc16(q, n, scale, output + 2 * n * q->slot_sz);
+    }
+    srsran_stage_prof_stop(SRSRAN_STAGE_PROF_OFDM, t0);
+    return;
+  }
+#endif
+
+  srsran_ofdm_tx_sf(q);
+  srsran_vec_convert_fi((float*)q->cfg.out_buffer, scale, output, 2 * q->sf_sz);
 }
 
 int srsran_ofdm_set_cfr(srsran_ofdm_t* q, srsran_cfr_cfg_t* cfr)
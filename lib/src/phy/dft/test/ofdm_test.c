@@ -36,6 +36,7 @@ static float       rx_window_offset      = 0.5f;
 static float       freq_shift_f          = 0.0f;
 static double      phase_compensation_hz = 0.0;
 static uint32_t    force_symbol_sz       = 0;
+static float       cfo                   = 0.0f;
 static double      elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
 {
   if (ts_end->tv_usec > ts_start->tv_usec) {
@@ -57,12 +58,14 @@ static void usage(char* prog)
   printf("\t-o rx window offset (portion of CP length) [Default %.1f]\n", rx_window_offset);
   printf("\t-s frequency shift (normalised with sampling rate) [Default %.1f]\n", freq_shift_f);
   printf("\t-p Phase compensation carrier frequency in Hz [Default %.1f]\n", phase_compensation_hz);
+  printf("\t-c CFO removed by the receiver (normalised with subcarrier spacing) [Default %.1f]\n", cfo);
+  printf("\t-b use the native DFT backend [Default FFTW]\n");
 }
 
 static void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "Nnerosp")) != -1) {
+  while ((opt = getopt(argc, argv, "Nnerospcb")) != -1) {
     switch (opt) {
       case 'n':
         nof_prb = (int)strtol(argv[optind], NULL, 10);
@@ -85,6 +88,12 @@ static void parse_args(int argc, char** argv)
       case 'p':
         phase_compensation_hz = strtod(argv[optind], NULL);
         break;
+      case 'c':
+        cfo = strtof(argv[optind], NULL);
+        break;
+      case 'b':
+        srsran_dft_set_backend(SRSRAN_DFT_BACKEND_NATIVE);
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -150,7 +159,13 @@ int main(int argc, char** argv)
       exit(-1);
     }
 
-    if (isnormal(freq_shift_f)) {
+    if (srsran_ofdm_set_cfo(&fft, cfo)) {
+      ERROR("Error setting CFO");
+      exit(-1);
+    }
+
+    // Shifting or removing the CFO before the DFT modifies the input buffer
+    if (isnormal(freq_shift_f) || (isnormal(cfo) && !fft.cfo_post_dft)) {
       nof_repetitions = 1;
     }
 
@@ -165,6 +180,13 @@ int main(int argc, char** argv)
     gettimeofday(&end, NULL);
     printf(" Tx@%.1fMsps", (float)(sf_len * nof_repetitions) / elapsed_us(&start, &end));
 
+    // Add CFO, the phase is calculated in double precision to avoid accumulating errors
+    if (isnormal(cfo)) {
+      for (uint32_t i = 0; i < sf_len; i++) {
+        outifft[i] *= (cf_t)cexp(I * 2.0 * M_PI * cfo * (double)i / (double)symbol_sz);
+      }
+    }
+
     // Execute Rx
     gettimeofday(&start, NULL);
     for (uint32_t i = 0; i < nof_repetitions; i++) {
@@ -179,11 +201,40 @@ int main(int argc, char** argv)
 
     printf(" MSE=%.6f\n", mse);
 
-    if (mse >= 0.0001) {
+    // The residual CFO removed after the DFT leaves some inter-carrier interference, and the rotation before the DFT
+    // accumulates the phase in single precision
+    float mse_max = 0.0001f;
+    if (fft.cfo_post_dft) {
+      mse_max += (float)M_PI * fabsf(cfo - roundf(cfo));
+    } else if (isnormal(cfo)) {
+      mse_max = 0.001f;
+    }
+
+    if (mse >= mse_max) {
       printf("MSE too large\n");
       exit(-1);
     }
 
+    // The sc16 output must match the floating point output converted afterwards
+    const float scale        = 8192.0f;
+    int16_t*    outifft_gold = srsran_vec_i16_malloc(2 * sf_len);
+    int16_t*    outifft_sc16 = srsran_vec_i16_malloc(2 * sf_len);
+    if (!outifft_gold || !outifft_sc16) {
+      perror("malloc");
+      exit(-1);
+    }
+    srsran_ofdm_tx_sf(&ifft);
+    srsran_vec_convert_fi((float*)outifft, scale, outifft_gold, 2 * sf_len);
+    srsran_ofdm_tx_sf_sc16(&ifft, scale, outifft_sc16);
+    for (uint32_t i = 0; i < 2 * sf_len; i++) {
+      if (abs(outifft_gold[i] - outifft_sc16[i]) > 1) {
+        printf("sc16 output mismatch in sample %d: %d != %d\n", i / 2, outifft_gold[i], outifft_sc16[i]);
+        exit(-1);
+      }
+    }
+    free(outifft_gold);
+    free(outifft_sc16);
+
     srsran_ofdm_rx_free(&fft);
     srsran_ofdm_tx_free(&ifft);
 
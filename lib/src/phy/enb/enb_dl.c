@@ -34,6 +34,19 @@ static float enb_dl_get_norm_factor(uint32_t nof_prb)
   return 0.05f / sqrtf(nof_prb);
 }
 
+static void base_signal_free(srsran_enb_dl_t* q)
+{
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+      if (q->base_signal[sf_idx][p]) {
+        free(q->base_signal[sf_idx][p]);
+        q->base_signal[sf_idx][p] = NULL;
+      }
+    }
+    q->base_signal_cfi[sf_idx] = 0;
+  }
+}
+
 int srsran_enb_dl_init(srsran_enb_dl_t* q, cf_t* out_buffer[SRSRAN_MAX_PORTS], uint32_t max_prb)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
@@ -133,10 +146,14 @@ void srsran_enb_dl_free(srsran_enb_dl_t* q)
     srsran_pmch_free(&q->pmch);
     srsran_refsignal_free(&q->csr_signal);
     srsran_refsignal_free(&q->mbsfnr_signal);
+    base_signal_free(q);
     for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
       if (q->sf_symbols[i]) {
         free(q->sf_symbols[i]);
       }
+      if (q->base_symbols[i]) {
+        free(q->base_symbols[i]);
+      }
     }
     bzero(q, sizeof(srsran_enb_dl_t));
   }
@@ -152,6 +169,8 @@ int srsran_enb_dl_set_cell(srsran_enb_dl_t* q, srsran_cell_t cell)
         srsran_regs_free(&q->regs);
       }
       q->cell                    = cell;
+      q->base_valid              = false;
+      base_signal_free(q);
       srsran_ofdm_cfg_t ofdm_cfg = {};
       ofdm_cfg.nof_prb           = q->cell.nof_prb;
       ofdm_cfg.cp                = cell.cp;
@@ -248,6 +267,9 @@ int srsran_enb_dl_set_cfr(srsran_enb_dl_t* q, const srsran_cfr_cfg_t* cfr)
 
   // Copy the cfr config into the eNB
   q->cfr_config = *cfr;
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    q->base_signal_cfi[sf_idx] = 0;
+  }
 
   // Set the cfr for the ifft's
   if (srsran_ofdm_set_cfr(&q->ifft_mbsfn, &q->cfr_config) < SRSRAN_SUCCESS) {
@@ -355,6 +377,126 @@ static void put_refs(srsran_enb_dl_t* q)
   }
 }
 
+static bool symbol_is_zero(const cf_t* symbol, uint32_t nof_re)
+{
+  for (uint32_t i = 0; i < nof_re; i++) {
+    if (symbol[i] != 0.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Renders the PSS/SSS and CRS of every normal subframe of the frame and keeps the symbols carrying any of them */
+static int gen_base_template(srsran_enb_dl_t* q, const srsran_tdd_config_t* tdd_config)
+{
+  uint32_t           nof_re_symbol                = SRSRAN_NRE * q->cell.nof_prb;
+  uint32_t           nof_symbols                  = SRSRAN_NOF_SLOTS_PER_SF * SRSRAN_CP_NSYMB(q->cell.cp);
+  srsran_dl_sf_cfg_t dl_sf                        = q->dl_sf;
+  uint32_t           nof_stored[SRSRAN_MAX_PORTS] = {};
+
+  q->base_valid = false;
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    q->base_signal_cfi[sf_idx] = 0;
+  }
+  for (int p = 0; p < SRSRAN_MAX_PORTS; p++) {
+    if (q->base_symbols[p]) {
+      free(q->base_symbols[p]);
+      q->base_symbols[p] = NULL;
+    }
+  }
+
+  // The first pass finds the symbols of each subframe and port, the second one stores them
+  for (uint32_t pass = 0; pass < 2; pass++) {
+    for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+      ZERO_OBJECT(q->dl_sf);
+      q->dl_sf.tti        = sf_idx;
+      q->dl_sf.tdd_config = *tdd_config;
+      q->dl_sf.sf_type    = SRSRAN_SF_NORM;
+      clear_sf(q);
+      put_sync(q);
+      put_refs(q);
+
+      for (int p = 0; p < q->cell.nof_ports; p++) {
+        if (pass == 0) {
+          uint32_t mask = 0;
+          for (uint32_t l = 0; l < nof_symbols; l++) {
+            if (!symbol_is_zero(&q->sf_symbols[p][l * nof_re_symbol], nof_re_symbol)) {
+              mask |= 1U << l;
+              nof_stored[p]++;
+            }
+          }
+          q->base_symbol_mask[p][sf_idx]   = mask;
+          q->base_symbol_offset[p][sf_idx] = nof_stored[p];
+        } else {
+          cf_t* ptr = &q->base_symbols[p][q->base_symbol_offset[p][sf_idx] * nof_re_symbol];
+          for (uint32_t l = 0; l < nof_symbols; l++) {
+            if (q->base_symbol_mask[p][sf_idx] & (1U << l)) {
+              srsran_vec_cf_copy(ptr, &q->sf_symbols[p][l * nof_re_symbol], nof_re_symbol);
+              ptr += nof_re_symbol;
+            }
+          }
+        }
+      }
+    }
+
+    if (pass == 0) {
+      for (int p = 0; p < q->cell.nof_ports; p++) {
+        // Offsets are taken at the end of each subframe, turn them into the start
+        for (int32_t sf_idx = SRSRAN_NOF_SF_X_FRAME - 1; sf_idx >= 0; sf_idx--) {
+          q->base_symbol_offset[p][sf_idx] = sf_idx ? q->base_symbol_offset[p][sf_idx - 1] : 0;
+        }
+        q->base_symbols[p] = srsran_vec_cf_malloc(SRSRAN_MAX(nof_stored[p], 1) * nof_re_symbol);
+        if (q->base_symbols[p] == NULL) {
+          perror("malloc");
+          q->dl_sf = dl_sf;
+          return SRSRAN_ERROR;
+        }
+      }
+    }
+  }
+
+  q->dl_sf           = dl_sf;
+  q->base_tdd_config = *tdd_config;
+  q->base_valid      = true;
+  return SRSRAN_SUCCESS;
+}
+
+/* Copies the pre-rendered symbols of the subframe and clears the rest of the grid in a single pass */
+static void put_base_template(srsran_enb_dl_t* q)
+{
+  uint32_t sf_idx        = q->dl_sf.tti % SRSRAN_NOF_SF_X_FRAME;
+  uint32_t nof_re_symbol = SRSRAN_NRE * q->cell.nof_prb;
+  uint32_t nof_symbols   = SRSRAN_NOF_SLOTS_PER_SF * SRSRAN_CP_NSYMB(q->cell.cp);
+
+  for (int p = 0; p < q->cell.nof_ports; p++) {
+    uint32_t    mask = q->base_symbol_mask[p][sf_idx];
+    const cf_t* src  = &q->base_symbols[p][q->base_symbol_offset[p][sf_idx] * nof_re_symbol];
+    cf_t*       dst  = q->sf_symbols[p];
+    for (uint32_t l = 0; l < nof_symbols; l++, dst += nof_re_symbol) {
+      if (mask & (1U << l)) {
+        srsran_vec_cf_copy(dst, src, nof_re_symbol);
+        src += nof_re_symbol;
+      } else {
+        srsran_vec_cf_zero(dst, nof_re_symbol);
+      }
+    }
+  }
+}
+
+static bool base_template_matches(srsran_enb_dl_t* q, const srsran_dl_sf_cfg_t* dl_sf)
+{
+  if (!q->base_valid) {
+    return false;
+  }
+  if (q->cell.frame_type == SRSRAN_FDD) {
+    return true;
+  }
+  return q->base_tdd_config.configured == dl_sf->tdd_config.configured &&
+         q->base_tdd_config.sf_config == dl_sf->tdd_config.sf_config &&
+         q->base_tdd_config.ss_config == dl_sf->tdd_config.ss_config;
+}
+
 static void put_mib(srsran_enb_dl_t* q)
 {
   uint8_t bch_payload[SRSRAN_BCH_PAYLOAD_LEN];
@@ -376,10 +518,21 @@ static void put_pcfich(srsran_enb_dl_t* q)
 void srsran_enb_dl_put_base(srsran_enb_dl_t* q, srsran_dl_sf_cfg_t* dl_sf)
 {
   srsran_ofdm_set_non_mbsfn_region(&q->ifft_mbsfn, dl_sf->non_mbsfn_region);
-  q->dl_sf = *dl_sf;
-  clear_sf(q);
-  put_sync(q);
-  put_refs(q);
+  q->dl_sf        = *dl_sf;
+  q->sf_base_only = false;
+
+  // PSS/SSS and CRS repeat every frame in normal subframes, only the MIB and the CFI change between frames
+  if (dl_sf->sf_type == SRSRAN_SF_NORM &&
+      (base_template_matches(q, dl_sf) || gen_base_template(q, &dl_sf->tdd_config) == SRSRAN_SUCCESS)) {
+    put_base_template(q);
+
+    // Without PBCH the subframe repeats every frame until something else is put in it
+    q->sf_base_only = (dl_sf->tti % SRSRAN_NOF_SF_X_FRAME) != 0;
+  } else {
+    clear_sf(q);
+    put_sync(q);
+    put_refs(q);
+  }
   put_mib(q);
   put_pcfich(q);
 }
@@ -387,6 +540,7 @@ void srsran_enb_dl_put_base(srsran_enb_dl_t* q, srsran_dl_sf_cfg_t* dl_sf)
 void srsran_enb_dl_put_phich(srsran_enb_dl_t* q, srsran_phich_grant_t* grant, bool ack)
 {
   srsran_phich_resource_t resource;
+  q->sf_base_only = false;
   srsran_phich_calc(&q->phich, grant, &resource);
   srsran_phich_encode(&q->phich, &q->dl_sf, resource, ack, q->sf_symbols);
 }
@@ -405,6 +559,7 @@ int srsran_enb_dl_put_pdcch_dl(srsran_enb_dl_t* q, srsran_dci_cfg_t* dci_cfg, sr
 {
   srsran_dci_msg_t dci_msg;
   ZERO_OBJECT(dci_msg);
+  q->sf_base_only = false;
 
   if (srsran_dci_msg_pack_pdsch(&q->cell, &q->dl_sf, dci_cfg, dci_dl, &dci_msg)) {
     ERROR("Error packing DL DCI");
@@ -421,6 +576,7 @@ int srsran_enb_dl_put_pdcch_ul(srsran_enb_dl_t* q, srsran_dci_cfg_t* dci_cfg, sr
 {
   srsran_dci_msg_t dci_msg;
   ZERO_OBJECT(dci_msg);
+  q->sf_base_only = false;
 
   if (srsran_dci_msg_pack_pusch(&q->cell, &q->dl_sf, dci_cfg, dci_ul, &dci_msg)) {
     ERROR("Error packing UL DCI");
@@ -435,14 +591,64 @@ int srsran_enb_dl_put_pdcch_ul(srsran_enb_dl_t* q, srsran_dci_cfg_t* dci_cfg, sr
 
 int srsran_enb_dl_put_pdsch(srsran_enb_dl_t* q, srsran_pdsch_cfg_t* pdsch, uint8_t* data[SRSRAN_MAX_CODEWORDS])
 {
+  q->sf_base_only = false;
   return srsran_pdsch_encode(&q->pdsch, &q->dl_sf, pdsch, data, q->sf_symbols);
 }
 
 int srsran_enb_dl_put_pmch(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmch_cfg, uint8_t* data)
 {
+  q->sf_base_only = false;
   return srsran_pmch_encode(&q->pmch, &q->dl_sf, pmch_cfg, data, q->sf_symbols);
 }
 
+int srsran_enb_dl_put_pmch_symbols(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmch_cfg, const cf_t* symbols)
+{
+  q->sf_base_only = false;
+  return srsran_pmch_put_symbols(&q->pmch, &q->dl_sf, pmch_cfg, symbols, q->sf_symbols);
+}
+
+/* The automatic CFR thresholds depend on the previous subframes, their output can not be reused */
+static bool base_signal_cacheable(srsran_enb_dl_t* q)
+{
+  return q->sf_base_only && (!q->cfr_config.cfr_enable || q->cfr_config.cfr_mode == SRSRAN_CFR_THR_MANUAL);
+}
+
+/* Copies the signal of a base-signals-only subframe modulated in a previous frame, if the CFI is the same */
+static bool base_signal_get(srsran_enb_dl_t* q)
+{
+  uint32_t sf_idx = q->dl_sf.tti % SRSRAN_NOF_SF_X_FRAME;
+
+  if (!base_signal_cacheable(q) || q->base_signal_cfi[sf_idx] != q->dl_sf.cfi) {
+    return false;
+  }
+
+  for (int i = 0; i < q->cell.nof_ports; i++) {
+    srsran_vec_cf_copy(q->ifft[i].cfg.out_buffer, q->base_signal[sf_idx][i], q->ifft[i].sf_sz);
+  }
+  return true;
+}
+
+static void base_signal_save(srsran_enb_dl_t* q)
+{
+  uint32_t sf_idx = q->dl_sf.tti % SRSRAN_NOF_SF_X_FRAME;
+
+  if (!base_signal_cacheable(q)) {
+    return;
+  }
+
+  q->base_signal_cfi[sf_idx] = 0;
+  for (int i = 0; i < q->cell.nof_ports; i++) {
+    if (q->base_signal[sf_idx][i] == NULL) {
+      q->base_signal[sf_idx][i] = srsran_vec_cf_malloc(q->ifft[i].sf_sz);
+      if (q->base_signal[sf_idx][i] == NULL) {
+        return;
+      }
+    }
+    srsran_vec_cf_copy(q->base_signal[sf_idx][i], q->ifft[i].cfg.out_buffer, q->ifft[i].sf_sz);
+  }
+  q->base_signal_cfi[sf_idx] = q->dl_sf.cfi;
+}
+
 void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q)
 {
   float norm_factor = enb_dl_get_norm_factor(q->cell.nof_prb);
@@ -454,6 +660,8 @@ void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q)
                            q->ifft_mbsfn.cfg.in_buffer,
                            SRSRAN_NOF_SLOTS_PER_SF * q->cell.nof_prb * SRSRAN_NRE * SRSRAN_CP_NSYMB(q->cell.cp));
     srsran_ofdm_tx_sf(&q->ifft_mbsfn);
+  } else if (base_signal_get(q)) {
+    return;
   } else {
     for (int i = 0; i < q->cell.nof_ports; i++) {
       srsran_vec_sc_prod_cfc(q->ifft[i].cfg.in_buffer,
@@ -462,6 +670,7 @@ void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q)
                              SRSRAN_NOF_SLOTS_PER_SF * q->cell.nof_prb * SRSRAN_NRE * SRSRAN_CP_NSYMB(q->cell.cp));
       srsran_ofdm_tx_sf(&q->ifft[i]);
     }
+    base_signal_save(q);
   }
 }
 
@@ -281,3 +281,13 @@ int srsran_enb_ul_get_pusch(srsran_enb_ul_t*    q,
 
   return srsran_pusch_decode(&q->pusch, ul_sf, cfg, &q->chest_res, q->sf_symbols, res);
 }
+
+int srsran_enb_ul_enable_deferred_pusch(srsran_enb_ul_t* q, bool enable)
+{
+  return srsran_sch_enable_deferred_decoding(&q->pusch.ul_sch, enable);
+}
+
+int srsran_enb_ul_decode_deferred_pusch(srsran_enb_ul_t* q)
+{
+  return srsran_sch_decode_deferred(&q->pusch.ul_sch);
+}
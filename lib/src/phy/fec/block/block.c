@@ -110,6 +110,85 @@ void srsran_block_encode(const uint8_t* input, uint32_t input_len, uint8_t* outp
 #endif // USE_LUT
 }
 
+// Words of this length or longer are correlated using the fast Walsh-Hadamard transform, shorter words are cheaper by
+// brute force
+#define BLOCK_DECODE_FHT_MIN_NOF_BITS 9U
+
+// The basis sequences 1 to 5 take every 5-bit value once along the 32 rows, the basis sequences 6 to 10 are applied
+// on top of them as signs of the row LLR
+#define BLOCK_DECODE_FHT_SIZE (1U << 5U)
+#define BLOCK_DECODE_FHT_NOF_SIGNS (1U << (SRSRAN_FEC_BLOCK_MAX_NOF_BITS - 6U))
+
+// Sign of each row LLR for every value of the data bits 6 to 10
+static int32_t block_decode_sign[SRSRAN_FEC_BLOCK_SIZE][BLOCK_DECODE_FHT_NOF_SIGNS];
+
+// Initialization function, as the table is read-only after initialization, it can be initialised from constructor
+__attribute__((constructor)) static void srsran_block_decode_init()
+{
+  for (uint32_t i = 0; i < SRSRAN_FEC_BLOCK_SIZE; i++) {
+    for (uint32_t hi = 0; hi < BLOCK_DECODE_FHT_NOF_SIGNS; hi++) {
+      block_decode_sign[i][hi] = encode_M_basis_seq_u16((uint16_t)(hi << 6U), i) ? -1 : +1;
+    }
+  }
+}
+
+// The basis sequence 0 is all ones, so the words 2b and 2b + 1 correlate -W(b) and W(b). W is the Walsh-Hadamard
+// transform of the row LLR placed at the index given by the basis sequences 1 to 5, for each sign hypothesis of the data
+// bits 6 to 10. It gives the same decision as the brute force search.
+static int32_t block_decode_fht(const block_llr_t* llr, uint8_t* data, uint32_t data_len)
+{
+  int32_t  max_corr = 0; //< Stores maximum correlation
+  uint32_t max_data = 0; //< Stores the word for maximum correlation
+
+  uint32_t nof_signs = 1U << (data_len - 6U);
+  int32_t  w[BLOCK_DECODE_FHT_SIZE][BLOCK_DECODE_FHT_NOF_SIGNS];
+  for (uint32_t lo = 0; lo < BLOCK_DECODE_FHT_SIZE; lo++) {
+    for (uint32_t hi = 0; hi < nof_signs; hi++) {
+      w[lo][hi] = 0;
+    }
+  }
+  for (uint32_t i = 0; i < SRSRAN_FEC_BLOCK_SIZE; i++) {
+    uint32_t lo = (M_basis_seq_b[i] >> 1U) & (BLOCK_DECODE_FHT_SIZE - 1);
+    for (uint32_t hi = 0; hi < nof_signs; hi++) {
+      w[lo][hi] += block_decode_sign[i][hi] * (int32_t)llr[i];
+    }
+  }
+
+  // Transform all the sign hypotheses at once
+  for (uint32_t h = 1; h < BLOCK_DECODE_FHT_SIZE; h <<= 1U) {
+    for (uint32_t j = 0; j < BLOCK_DECODE_FHT_SIZE; j += 2 * h) {
+      for (uint32_t k = j; k < j + h; k++) {
+        for (uint32_t hi = 0; hi < nof_signs; hi++) {
+          int32_t x    = w[k][hi];
+          int32_t y    = w[k + h][hi];
+          w[k][hi]     = x + y;
+          w[k + h][hi] = x - y;
+        }
+      }
+    }
+  }
+
+  // Take the first word with the maximum correlation in increasing order. Only one word of each pair can have a
+  // positive correlation
+  for (uint32_t hi = 0; hi < nof_signs; hi++) {
+    for (uint32_t lo = 0; lo < BLOCK_DECODE_FHT_SIZE; lo++) {
+      int32_t corr = abs(w[lo][hi]);
+      if (corr > max_corr) {
+        max_corr = corr;
+        max_data = (((hi * BLOCK_DECODE_FHT_SIZE) | lo) << 1U) | ((w[lo][hi] > 0) ? 1U : 0U);
+      }
+    }
+  }
+
+  // Bit unpack (reversed)
+  for (uint32_t i = 0; i < data_len; i++) {
+    data[i] = (uint8_t)((max_data >> i) & 1U);
+  }
+
+  // Return correlation
+  return max_corr;
+}
+
 static int32_t block_decode(const block_llr_t* llr, uint8_t* data, uint32_t data_len)
 {
   int32_t  max_corr = 0; //< Stores maximum correlation
@@ -118,6 +197,11 @@ static int32_t block_decode(const block_llr_t* llr, uint8_t* data, uint32_t data
   // Limit data to maximum
   data_len = SRSRAN_MIN(data_len, SRSRAN_FEC_BLOCK_MAX_NOF_BITS);
 
+  // Long words are correlated through the transform
+  if (data_len >= BLOCK_DECODE_FHT_MIN_NOF_BITS) {
+    return block_decode_fht(llr, data, data_len);
+  }
+
   // Brute force all possible sequences
   uint16_t max_guess = (1U << data_len); //< Maximum guess bit combination (excluded)
   for (uint16_t guess = 0; guess < max_guess; guess++) {
@@ -32,6 +32,13 @@
 #include "srsran/phy/utils/vector.h"
 #include "viterbi37.h"
 
+#ifdef IS_ARM
+#include <sys/auxv.h>
+#ifndef HWCAP_NEON
+#define HWCAP_NEON (1 << 12)
+#endif
+#endif
+
 #define DEB 0
 
 #define TB_ITER 5
@@ -217,6 +224,57 @@ void free37_avx2(void* o)
 
 #endif
 
+#ifdef LV_HAVE_AVX512
+int decode37_avx512_16bit(void* o, uint16_t* symbols, uint8_t* data, uint32_t frame_length)
+{
+  srsran_viterbi_t* q = o;
+
+  uint32_t best_state;
+
+  if (frame_length > q->framebits) {
+    fprintf(stderr, "Initialized decoder for max frame length %d bits\n", q->framebits);
+    return -1;
+  }
+
+  /* Initialize Viterbi decoder */
+  init_viterbi37_avx512_16bit(q->ptr, q->tail_biting ? -1 : 0);
+
+  /* Decode block */
+  if (q->tail_biting) {
+    for (int i = 0; i < TB_ITER; i++) {
+      memcpy(&q->tmp_s[i * 3 * frame_length], symbols, 3 * frame_length * sizeof(uint16_t));
+    }
+    update_viterbi37_blk_avx512_16bit(q->ptr, q->tmp_s, TB_ITER * frame_length, &best_state);
+    chainback_viterbi37_avx512_16bit(q->ptr, q->tmp, TB_ITER * frame_length, best_state);
+    memcpy(data, &q->tmp[((int)(TB_ITER / 2)) * frame_length], frame_length * sizeof(uint8_t));
+  } else {
+    update_viterbi37_blk_avx512_16bit(q->ptr, symbols, frame_length + q->K - 1, NULL);
+    chainback_viterbi37_avx512_16bit(q->ptr, data, frame_length, 0);
+  }
+
+  return q->framebits;
+}
+
+void free37_avx512_16bit(void* o)
+{
+  srsran_viterbi_t* q = o;
+
+  if (q->symbols_uc) {
+    free(q->symbols_uc);
+  }
+  if (q->symbols_us) {
+    free(q->symbols_us);
+  }
+  if (q->tmp) {
+    free(q->tmp);
+  }
+  if (q->tmp_s) {
+    free(q->tmp_s);
+  }
+  delete_viterbi37_avx512_16bit(q->ptr);
+}
+#endif
+
 #ifdef HAVE_NEON
 int decode37_neon(void* o, uint8_t* symbols, uint8_t* data, uint32_t frame_length)
 {
@@ -471,6 +529,60 @@ int init37_avx2_16bit(srsran_viterbi_t* q, int poly[3], uint32_t framebits, bool
 
 #endif
 
+#ifdef LV_HAVE_AVX512
+int init37_avx512_16bit(srsran_viterbi_t* q, int poly[3], uint32_t framebits, bool tail_biting)
+{
+  q->K            = 7;
+  q->R            = 3;
+  q->framebits    = framebits;
+  q->gain_quant_s = 4;
+  q->gain_quant   = DEFAULT_GAIN_16;
+  q->tail_biting  = tail_biting;
+  q->decode_s     = decode37_avx512_16bit;
+  q->free         = free37_avx512_16bit;
+  q->decode_f     = NULL;
+  q->symbols_uc   = srsran_vec_u8_malloc(3 * (q->framebits + q->K - 1));
+  q->symbols_us   = srsran_vec_u16_malloc(3 * (q->framebits + q->K - 1));
+  if (!q->symbols_uc || !q->symbols_us) {
+    perror("malloc");
+    free37_avx512_16bit(q);
+    return -1;
+  }
+  if (q->tail_biting) {
+    q->tmp   = srsran_vec_u8_malloc(TB_ITER * 3 * (q->framebits + q->K - 1));
+    q->tmp_s = srsran_vec_u16_malloc(TB_ITER * 3 * (q->framebits + q->K - 1));
+    if (!q->tmp || !q->tmp_s) {
+      perror("malloc");
+      free37_avx512_16bit(q);
+      return -1;
+    }
+  } else {
+    q->tmp = NULL;
+  }
+
+  if ((q->ptr = create_viterbi37_avx512_16bit(poly, TB_ITER * framebits)) == NULL) {
+    ERROR("create_viterbi37 failed");
+    free37_avx512_16bit(q);
+    return -1;
+  } else {
+    return 0;
+  }
+}
+#endif
+
+/* The SIMD backends are selected at run time among those enabled at compile time, so the same binary falls back to
+ * the fastest decoder the host supports. */
+#ifdef IS_ARM
+static bool viterbi_cpu_has_neon()
+{
+#ifdef HAVE_NEONv8
+  return true;
+#else
+  return (getauxval(AT_HWCAP) & HWCAP_NEON) != 0;
+#endif
+}
+#endif
+
 void srsran_viterbi_set_gain_quant(srsran_viterbi_t* q, float gain_quant)
 {
   q->gain_quant = gain_quant;
@@ -490,24 +602,31 @@ int srsran_viterbi_init(srsran_viterbi_t*     q,
   bzero(q, sizeof(srsran_viterbi_t));
   switch (type) {
     case SRSRAN_VITERBI_37:
-#ifdef LV_HAVE_SSE
-
+#ifdef LV_HAVE_AVX512
+      if (__builtin_cpu_supports("avx512bw")) {
+        return init37_avx512_16bit(q, poly, max_frame_length, tail_bitting);
+      }
+#endif
 #ifdef LV_HAVE_AVX2
+      if (__builtin_cpu_supports("avx2")) {
 #ifdef VITERBI_16
-      return init37_avx2_16bit(q, poly, max_frame_length, tail_bitting);
+        return init37_avx2_16bit(q, poly, max_frame_length, tail_bitting);
 #else
-      return init37_avx2(q, poly, max_frame_length, tail_bitting);
+        return init37_avx2(q, poly, max_frame_length, tail_bitting);
 #endif
-#else
-      return init37_sse(q, poly, max_frame_length, tail_bitting);
+      }
 #endif
-#else
-#ifdef HAVE_NEON
-      return init37_neon(q, poly, max_frame_length, tail_bitting);
-#else
-      return init37(q, poly, max_frame_length, tail_bitting);
+#ifdef LV_HAVE_SSE
+      if (__builtin_cpu_supports("sse2")) {
+        return init37_sse(q, poly, max_frame_length, tail_bitting);
+      }
 #endif
+#ifdef HAVE_NEON
+      if (viterbi_cpu_has_neon()) {
+        return init37_neon(q, poly, max_frame_length, tail_bitting);
+      }
 #endif
+      return init37(q, poly, max_frame_length, tail_bitting);
     default:
       ERROR("Decoder not implemented");
       return -1;
@@ -534,6 +653,26 @@ int srsran_viterbi_init_avx2(srsran_viterbi_t*     q,
 {
   return init37_avx2(q, poly, max_frame_length, tail_bitting);
 }
+
+int srsran_viterbi_init_avx2_16bit(srsran_viterbi_t*     q,
+                                   srsran_viterbi_type_t type,
+                                   int                   poly[3],
+                                   uint32_t              max_frame_length,
+                                   bool                  tail_bitting)
+{
+  return init37_avx2_16bit(q, poly, max_frame_length, tail_bitting);
+}
+#endif
+
+#ifdef LV_HAVE_AVX512
+int srsran_viterbi_init_avx512_16bit(srsran_viterbi_t*     q,
+                                     srsran_viterbi_type_t type,
+                                     int                   poly[3],
+                                     uint32_t              max_frame_length,
+                                     bool                  tail_bitting)
+{
+  return init37_avx512_16bit(q, poly, max_frame_length, tail_bitting);
+}
 #endif
 
 void srsran_viterbi_free(srsran_viterbi_t* q)
@@ -563,13 +702,12 @@ int srsran_viterbi_decode_f(srsran_viterbi_t* q, float* symbols, uint8_t* data,
     if (max_i < len && isnormal(symbols[max_i])) {
       max = fabsf(symbols[max_i]);
     }
-#ifdef VITERBI_16
-    srsran_vec_quant_fus(symbols, q->symbols_us, q->gain_quant / max, 32767.5, 65535, len);
-    return srsran_viterbi_decode_us(q, q->symbols_us, data, frame_length);
-#else
+    if (q->decode_s) {
+      srsran_vec_quant_fus(symbols, q->symbols_us, q->gain_quant / max, 32767.5, 65535, len);
+      return srsran_viterbi_decode_us(q, q->symbols_us, data, frame_length);
+    }
     srsran_vec_quant_fuc(symbols, q->symbols_uc, q->gain_quant / max, 127.5, 255, len);
     return srsran_viterbi_decode_uc(q, q->symbols_uc, data, frame_length);
-#endif
   } else {
     return q->decode_f(q, symbols, data, frame_length);
   }
@@ -595,13 +733,12 @@ int srsran_viterbi_decode_s(srsran_viterbi_t* q, int16_t* symbols, uint8_t* data
       max = abs(symbols[i]);
     }
   }
-#ifdef VITERBI_16
-  srsran_vec_quant_sus(symbols, q->symbols_us, 1, (float)INT16_MAX, UINT16_MAX, len);
-  return srsran_viterbi_decode_us(q, q->symbols_us, data, frame_length);
-#else
+  if (q->decode_s) {
+    srsran_vec_quant_sus(symbols, q->symbols_us, 1, (float)INT16_MAX, UINT16_MAX, len);
+    return srsran_viterbi_decode_us(q, q->symbols_us, data, frame_length);
+  }
   srsran_vec_quant_suc(symbols, q->symbols_uc, (float)q->gain_quant / max, 127, 255, len);
   return srsran_viterbi_decode_uc(q, q->symbols_uc, data, frame_length);
-#endif
 }
 
 int srsran_viterbi_decode_us(srsran_viterbi_t* q, uint16_t* symbols, uint8_t* data, uint32_t frame_length)
@@ -0,0 +1,256 @@
+/* Adapted Phil Karn's r=1/3 k=9 viterbi decoder to r=1/3 k=7
+ *
+ * K=15 r=1/6 Viterbi decoder for x86 SSE2
+ * Copyright Mar 2004, Phil Karn, KA9Q
+ * May be used under the terms of the GNU Lesser General Public License (LGPL)
+ */
+
+#include "parity.h"
+#include <limits.h>
+#include <memory.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef LV_HAVE_AVX512
+
+#include <immintrin.h>
+
+/* The 64 path metrics fit in two AVX512 registers */
+typedef union {
+  unsigned short c[64];
+  __m512i        v[2];
+} metric_t;
+
+/* One decision bit per state */
+typedef union {
+  unsigned int  w[2];
+  unsigned char c[8];
+} decision_t;
+
+static union branchtab37 {
+  unsigned short c[32];
+  __m512i        v;
+} Branchtab37_avx512[3];
+
+/* State info for instance of Viterbi decoder */
+struct v37 {
+  metric_t    metrics1;                  /* path metric buffer 1 */
+  metric_t    metrics2;                  /* path metric buffer 2 */
+  decision_t* dp;                        /* Pointer to current decision */
+  metric_t *  old_metrics, *new_metrics; /* Pointers to path metrics, swapped on every bit */
+  decision_t* decisions;                 /* Beginning of decisions for block */
+  uint32_t    len;
+  __m512i     idx;                       /* Places butterflies 4k..4k+3 and 16+4k..16+4k+3 in the lane k */
+};
+
+static void set_viterbi37_polynomial_avx512_16bit(int polys[3])
+{
+  int state;
+  for (state = 0; state < 32; state++) {
+    Branchtab37_avx512[0].c[state] = (polys[0] < 0) ^ parity((2 * state) & polys[0]) ? 65535 : 0;
+    Branchtab37_avx512[1].c[state] = (polys[1] < 0) ^ parity((2 * state) & polys[1]) ? 65535 : 0;
+    Branchtab37_avx512[2].c[state] = (polys[2] < 0) ^ parity((2 * state) & polys[2]) ? 65535 : 0;
+  }
+}
+
+static void clear_v37_avx512_16bit(struct v37* vp)
+{
+  bzero(vp->decisions, sizeof(decision_t) * vp->len);
+  vp->dp = NULL;
+  bzero(&vp->metrics1, sizeof(metric_t));
+  bzero(&vp->metrics2, sizeof(metric_t));
+  vp->old_metrics = NULL;
+  vp->new_metrics = NULL;
+}
+
+/* Initialize Viterbi decoder for start of new frame */
+int init_viterbi37_avx512_16bit(void* p, int starting_state)
+{
+  struct v37* vp = p;
+  uint32_t    i;
+
+  for (i = 0; i < 64; i++)
+    vp->metrics1.c[i] = 63;
+
+  clear_v37_avx512_16bit(vp);
+  vp->old_metrics = &vp->metrics1;
+  vp->new_metrics = &vp->metrics2;
+  vp->dp          = vp->decisions;
+  if (starting_state != -1) {
+    vp->old_metrics->c[starting_state & 63] = 0; /* Bias known start state */
+  }
+  return 0;
+}
+
+/* Create a new instance of a Viterbi decoder */
+void* create_viterbi37_avx512_16bit(int polys[3], uint32_t len)
+{
+  void*       p;
+  struct v37* vp;
+
+  set_viterbi37_polynomial_avx512_16bit(polys);
+
+  if (posix_memalign(&p, sizeof(__m512i), sizeof(struct v37)))
+    return NULL;
+
+  vp = (struct v37*)p;
+  if (posix_memalign(&p, sizeof(__m512i), (len + 6) * sizeof(decision_t))) {
+    free(vp);
+    return NULL;
+  }
+  vp->decisions = (decision_t*)p;
+  vp->len       = len + 6;
+
+  vp->idx = _mm512_setr_epi64(0, 4, 1, 5, 2, 6, 3, 7);
+
+  return vp;
+}
+
+/* Viterbi chainback */
+int chainback_viterbi37_avx512_16bit(void*    p,
+                                     uint8_t* data,  /* Decoded output data */
+                                     uint32_t nbits, /* Number of data bits */
+                                     uint32_t endstate)
+{ /* Terminal encoder state */
+  struct v37* vp = p;
+
+  if (p == NULL)
+    return -1;
+
+  decision_t* d = (decision_t*)vp->decisions;
+
+  /* Make room beyond the end of the encoder register so we can
+   * accumulate a full byte of decoded data
+   */
+  endstate %= 64;
+  endstate <<= 2;
+
+  d += 6; /* Look past tail */
+  while (nbits--) {
+    int k;
+
+    k           = (d[nbits].c[(endstate >> 2) / 8] >> ((endstate >> 2) % 8)) & 1;
+    endstate    = (endstate >> 1) | (k << 7);
+    data[nbits] = k;
+  }
+  return 0;
+}
+
+/* Delete instance of a Viterbi decoder */
+void delete_viterbi37_avx512_16bit(void* p)
+{
+  struct v37* vp = p;
+
+  if (vp != NULL) {
+    free(vp->decisions);
+    free(vp);
+  }
+}
+
+void update_viterbi37_blk_avx512_16bit(void* p, unsigned short* syms, int nbits, uint32_t* best_state)
+{
+  struct v37* vp = p;
+  decision_t* d;
+
+  if (p == NULL)
+    return;
+
+  d = (decision_t*)vp->dp;
+
+  /* The path metrics stay in registers during the whole block */
+  __m512i old0 = vp->old_metrics->v[0];
+  __m512i old1 = vp->old_metrics->v[1];
+
+  while (nbits--) {
+    __m512i sym0v, sym1v, sym2v;
+
+    /* Splat the 0th symbol across sym0v, the 1st symbol across sym1v, etc */
+    sym0v = _mm512_set1_epi16(syms[0]);
+    sym1v = _mm512_set1_epi16(syms[1]);
+    sym2v = _mm512_set1_epi16(syms[2]);
+
+    syms += 3;
+
+    /* All the 32 butterflies are computed at once */
+    __m512i metric, m_metric, m0, m1, m2, m3;
+
+    /* Form branch metrics */
+    m0     = _mm512_avg_epu16(_mm512_xor_si512(Branchtab37_avx512[0].v, sym0v),
+                          _mm512_xor_si512(Branchtab37_avx512[1].v, sym1v));
+    metric = _mm512_avg_epu16(_mm512_xor_si512(Branchtab37_avx512[2].v, sym2v), m0);
+
+    metric   = _mm512_srli_epi16(metric, 3);
+    m_metric = _mm512_sub_epi16(_mm512_set1_epi16(8191), metric);
+
+    /* Add branch metrics to path metrics */
+    m0 = _mm512_add_epi16(old0, metric);
+    m3 = _mm512_add_epi16(old1, metric);
+    m1 = _mm512_add_epi16(old1, m_metric);
+    m2 = _mm512_add_epi16(old0, m_metric);
+
+    /* Butterfly j produces the states 2j and 2j+1: the candidates are interleaved before the selection, so the new
+     * metrics and the decisions come out in state order */
+    m0 = _mm512_permutexvar_epi64(vp->idx, m0);
+    m1 = _mm512_permutexvar_epi64(vp->idx, m1);
+    m2 = _mm512_permutexvar_epi64(vp->idx, m2);
+    m3 = _mm512_permutexvar_epi64(vp->idx, m3);
+
+    __m512i a0 = _mm512_unpacklo_epi16(m0, m2);
+    __m512i b0 = _mm512_unpacklo_epi16(m1, m3);
+    __m512i a1 = _mm512_unpackhi_epi16(m0, m2);
+    __m512i b1 = _mm512_unpackhi_epi16(m1, m3);
+
+    /* Compare and select, using modulo arithmetic */
+    __mmask32 decision0 = _mm512_cmpgt_epi16_mask(_mm512_sub_epi16(a0, b0), _mm512_setzero_si512());
+    __mmask32 decision1 = _mm512_cmpgt_epi16_mask(_mm512_sub_epi16(a1, b1), _mm512_setzero_si512());
+
+    d->w[0] = decision0;
+    d->w[1] = decision1;
+    old0    = _mm512_mask_blend_epi16(decision0, a0, b0);
+    old1    = _mm512_mask_blend_epi16(decision1, a1, b1);
+
+    // See if we need to normalize
+    if ((uint16_t)_mm_extract_epi16(_mm512_castsi512_si128(old0), 0) > 12288) {
+      union {
+        __m512i        v;
+        unsigned short c[32];
+      } t;
+
+      t.v             = _mm512_min_epu16(old0, old1);
+      uint16_t adjust = t.c[0];
+      for (int i = 1; i < 32; i++) {
+        adjust = (t.c[i] < adjust) ? t.c[i] : adjust;
+      }
+
+      /* We cannot use a saturated subtract, because we often have to adjust by more than SHRT_MAX
+       * This is okay since it can't overflow anyway
+       */
+      __m512i adjustv = _mm512_set1_epi16(adjust);
+      old0            = _mm512_sub_epi16(old0, adjustv);
+      old1            = _mm512_sub_epi16(old1, adjustv);
+    }
+
+    d++;
+  }
+
+  vp->old_metrics->v[0] = old0;
+  vp->old_metrics->v[1] = old1;
+
+  if (best_state) {
+    uint32_t i, bst = 0;
+
+    uint16_t minmetric = UINT16_MAX;
+    for (i = 0; i < 64; i++) {
+      if (vp->old_metrics->c[i] <= minmetric) {
+        bst       = i;
+        minmetric = vp->old_metrics->c[i];
+      }
+    }
+    *best_state = bst;
+  }
+
+  vp->dp = d;
+}
+
+#endif // LV_HAVE_AVX512
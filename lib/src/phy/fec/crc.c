@@ -22,11 +22,19 @@
 #include "srsran/phy/fec/crc.h"
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/stage_prof.h"
 
 #ifdef LV_HAVE_SSE
 #include <immintrin.h>
 #endif // LV_HAVE_SSE
 
+// The carry-less multiply kernels fold the message 128 bits at a time, the remainder is reduced by the byte table
+#if defined(LV_HAVE_SSE) && defined(__PCLMUL__)
+#include <wmmintrin.h>
+#define CRC_FOLD_ENABLED
+#define CRC_FOLD_MIN_BYTES 32
+#endif
+
 static void gen_crc_table(srsran_crc_t* h)
 {
   uint32_t pad        = (h->order < 8) ? (8 - h->order) : 0;
@@ -47,6 +55,64 @@ static void gen_crc_table(srsran_crc_t* h)
   }
 }
 
+// Computes x^n modulo the polynomial aligned to 32 bits, P(x)*x^(32-order)
+static uint64_t gen_fold_xpow(const srsran_crc_t* h, uint32_t n)
+{
+  uint64_t poly = (uint64_t)h->polynom << (32U - h->order);
+  uint64_t r    = 1;
+
+  for (uint32_t i = 0; i < n; i++) {
+    r <<= 1U;
+    if (r & (1ULL << 32U)) {
+      r ^= poly;
+    }
+  }
+  return r;
+}
+
+#ifdef CRC_FOLD_ENABLED
+// Loads 16 bytes as a 128-bit polynomial, the first byte carries the highest degree coefficients
+static inline __m128i crc_fold_load(const uint8_t* ptr)
+{
+  return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)ptr),
+                          _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+// Packs 128 unpacked bits and loads them as a 128-bit polynomial
+static inline __m128i crc_fold_pack(const uint8_t* bits)
+{
+  uint16_t packed[8];
+  for (uint32_t j = 0; j < 8; j++) {
+    __m128i mask = _mm_cmpgt_epi8(_mm_loadu_si128((const __m128i*)&bits[16 * j]), _mm_setzero_si128());
+
+    // Reverse each group of 8 bits, so the first bit ends up in the MSB
+    mask      = _mm_shuffle_epi8(mask, _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7));
+    packed[j] = (uint16_t)_mm_movemask_epi8(mask);
+  }
+  return crc_fold_load((const uint8_t*)packed);
+}
+
+// Shifts the accumulator by 128 bits and adds the next block. The accumulator stays congruent with the message modulo
+// the polynomial: A*x^128 = H*x^192 + L*x^128, with x^192 and x^128 replaced by their remainders
+static inline __m128i crc_fold_block(__m128i acc, __m128i block, __m128i k)
+{
+  __m128i hi = _mm_clmulepi64_si128(acc, k, 0x11);
+  __m128i lo = _mm_clmulepi64_si128(acc, k, 0x00);
+  return _mm_xor_si128(_mm_xor_si128(hi, lo), block);
+}
+
+// Feeds the accumulator through the byte table. It replaces the folded bytes, as it has the same remainder
+static inline void crc_fold_flush(srsran_crc_t* h, __m128i acc)
+{
+  uint8_t bytes[16];
+  _mm_storeu_si128((__m128i*)bytes,
+                   _mm_shuffle_epi8(acc, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)));
+  for (uint32_t i = 0; i < 16; i++) {
+    srsran_crc_checksum_put_byte(h, bytes[i]);
+  }
+}
+#endif // CRC_FOLD_ENABLED
+
 uint64_t reversecrcbit(uint32_t crc, int nbits, srsran_crc_t* h)
 {
   uint64_t m, rmask = 0x1;
@@ -89,14 +155,23 @@ int srsran_crc_init(srsran_crc_t* h, uint32_t crc_poly, int crc_order)
   // generate lookup table
   gen_crc_table(h);
 
+  // generate folding constants, the kernel works on polynomials up to 32 bits
+  h->fold_k[0] = 0;
+  h->fold_k[1] = 0;
+  if (h->order < 32) {
+    h->fold_k[0] = gen_fold_xpow(h, 128);
+    h->fold_k[1] = gen_fold_xpow(h, 192);
+  }
+
   return 0;
 }
 
 uint32_t srsran_crc_checksum(srsran_crc_t* h, uint8_t* data, int len)
 {
-  int      i, k, len8, res8, a = 0;
+  int      i = 0, k, len8, res8, a = 0;
   uint32_t crc = 0;
   uint8_t* pter;
+  uint64_t t0 = srsran_stage_prof_start();
 
   srsran_crc_set_init(h, 0);
 
@@ -107,8 +182,20 @@ uint32_t srsran_crc_checksum(srsran_crc_t* h, uint8_t* data, int len)
     a = 1;
   }
 
+#ifdef CRC_FOLD_ENABLED
+  // Pack and fold the bits 128 at a time
+  if (h->order < 32 && len8 >= CRC_FOLD_MIN_BYTES) {
+    __m128i k   = _mm_loadu_si128((const __m128i*)h->fold_k);
+    __m128i acc = crc_fold_pack(data);
+    for (i = 16; i + 16 <= len8; i += 16) {
+      acc = crc_fold_block(acc, crc_fold_pack(&data[8 * i]), k);
+    }
+    crc_fold_flush(h, acc);
+  }
+#endif // CRC_FOLD_ENABLED
+
   // Calculate CRC
-  for (i = 0; i < len8 + a; i++) {
+  for (; i < len8 + a; i++) {
     pter = (uint8_t*)(data + 8 * i);
     uint8_t byte;
     if (i == len8) {
@@ -138,6 +225,7 @@ uint32_t srsran_crc_checksum(srsran_crc_t* h, uint8_t* data, int len)
   if (a == 1) {
     crc = reversecrcbit(crc, 8 - res8, h);
   }
+  srsran_stage_prof_stop(SRSRAN_STAGE_PROF_CRC, t0);
 
   // Return CRC value
   return crc;
@@ -146,16 +234,31 @@ uint32_t srsran_crc_checksum(srsran_crc_t* h, uint8_t* data, int len)
 // len is multiple of 8
 uint32_t srsran_crc_checksum_byte(srsran_crc_t* h, const uint8_t* data, int len)
 {
-  int      i;
-  uint32_t crc = 0;
+  int      i    = 0;
+  int      len8 = len / 8;
+  uint32_t crc  = 0;
+  uint64_t t0   = srsran_stage_prof_start();
 
   srsran_crc_set_init(h, 0);
 
+#ifdef CRC_FOLD_ENABLED
+  // Fold the bytes 128 bits at a time
+  if (h->order < 32 && len8 >= CRC_FOLD_MIN_BYTES) {
+    __m128i k   = _mm_loadu_si128((const __m128i*)h->fold_k);
+    __m128i acc = crc_fold_load(data);
+    for (i = 16; i + 16 <= len8; i += 16) {
+      acc = crc_fold_block(acc, crc_fold_load(&data[i]), k);
+    }
+    crc_fold_flush(h, acc);
+  }
+#endif // CRC_FOLD_ENABLED
+
   // Calculate CRC
-  for (i = 0; i < len / 8; i++) {
+  for (; i < len8; i++) {
     srsran_crc_checksum_put_byte(h, data[i]);
   }
   crc = (uint32_t)srsran_crc_checksum_get(h);
+  srsran_stage_prof_stop(SRSRAN_STAGE_PROF_CRC, t0);
 
   return crc;
 }
@@ -41,9 +41,10 @@
  * \param[in] bgM Number of check nodes.
  * \param[in] ls  Lifting size.
  * \param[in]  scaling_fctr Scaling factor of the normalized min-sum algorithm.
+ * \param[in]  offset       Offset of the offset min-sum algorithm, 0 for the normalized min-sum algorithm.
  * \return A pointer to the created registers (an ldpc_regs structure).
  */
-void* create_ldpc_dec_f(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr);
+void* create_ldpc_dec_f(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset);
 
 /*!
  * Destroys the inner registers of the float-based LDPC decoder.
@@ -78,7 +79,8 @@ int update_ldpc_var_to_check_f(void* p, int i_layer);
  * \param[in]     these_var_indices
  *                         Contains the indices of the variable nodes connected
  *                         to the current layer.
- * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ * \return The number of parity checks of the layer that are not satisfied by the updated soft bits, -1 if an
+ *         error occurred.
  */
 int update_ldpc_check_to_var_f(void*           p,
                                int             i_layer,
@@ -111,9 +113,10 @@ int extract_ldpc_message_f(void* p, uint8_t* message, uint16_t liftK);
  * \param[in] bgM          Number of check nodes.
  * \param[in] ls           Lifting size.
  * \param[in] scaling_fctr Scaling factor of the normalized min-sum algorithm.
+ * \param[in] offset       Offset of the offset min-sum algorithm, 0 for the normalized min-sum algorithm.
  * \return A pointer to the created registers (an ldpc_regs_s structure).
  */
-void* create_ldpc_dec_s(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr);
+void* create_ldpc_dec_s(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset);
 
 /*!
  * Destroys the inner registers of the 16-bit integer-based LDPC decoder.
@@ -148,7 +151,8 @@ int update_ldpc_var_to_check_s(void* p, int i_layer);
  * \param[in]     these_var_indices
  *                         Contains the indices of the variable nodes connected
  *                         to the current layer.
- * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ * \return The number of parity checks of the layer that are not satisfied by the updated soft bits, -1 if an
+ *         error occurred.
  */
 int update_ldpc_check_to_var_s(void*           p,
                                int             i_layer,
@@ -181,9 +185,10 @@ int extract_ldpc_message_s(void* p, uint8_t* message, uint16_t liftK);
  * \param[in] bgM          Number of check nodes.
  * \param[in] ls           Lifting size.
  * \param[in] scaling_fctr Scaling factor of the normalized min-sum algorithm.
+ * \param[in] offset       Offset of the offset min-sum algorithm, 0 for the normalized min-sum algorithm.
  * \return A pointer to the created registers (an ldpc_regs_c structure).
  */
-void* create_ldpc_dec_c(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr);
+void* create_ldpc_dec_c(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset);
 
 /*!
  * Destroys the inner registers of the 8-bit integer-based LDPC decoder.
@@ -218,7 +223,8 @@ int update_ldpc_var_to_check_c(void* p, int i_layer);
  * \param[in]     these_var_indices
  *                         Contains the indices of the variable nodes connected
  *                         to the current layer.
- * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ * \return The number of parity checks of the layer that are not satisfied by the updated soft bits, -1 if an
+ *         error occurred.
  */
 int update_ldpc_check_to_var_c(void*           p,
                                int             i_layer,
@@ -251,9 +257,10 @@ int extract_ldpc_message_c(void* p, uint8_t* message, uint16_t liftK);
  * \param[in] bgM          Number of check nodes.
  * \param[in] ls           Lifting size.
  * \param[in] scaling_fctr Scaling factor of the normalized min-sum algorithm.
+ * \param[in] offset       Offset of the offset min-sum algorithm, 0 for the normalized min-sum algorithm.
  * \return A pointer to the created registers (an ldpc_regs_c_flood structure).
  */
-void* create_ldpc_dec_c_flood(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr);
+void* create_ldpc_dec_c_flood(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset);
 
 /*!
  * Destroys the inner registers of the 8-bit integer-based LDPC decoder (flooded scheduling).
@@ -318,9 +325,10 @@ int extract_ldpc_message_c_flood(void* p, uint8_t* message, uint16_t liftK);
  * Creates the registers used by the optimized 8-bit-based implementation of the LDPC decoder (LS <= \ref
  * SRSRAN_AVX2_B_SIZE). \param[in] bgN          Codeword length. \param[in] bgM          Number of check nodes.
  * \param[in] ls           Lifting size. \param[in] scaling_fctr Scaling factor of the normalized min-sum algorithm.
+ * \param[in] offset       Offset of the offset min-sum algorithm, 0 for the normalized min-sum algorithm.
  * \return A pointer to the created registers (an ldpc_regs_c_avx2 structure).
  */
-void* create_ldpc_dec_c_avx2(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr);
+void* create_ldpc_dec_c_avx2(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset);
 
 /*!
  * Destroys the inner registers of the optimized 8-bit integer-based LDPC decoder (LS <= \ref SRSRAN_AVX2_B_SIZE).
@@ -355,7 +363,8 @@ int update_ldpc_var_to_check_c_avx2(void* p, int i_layer);
  * \param[in]     these_var_indices
  *                         Contains the indices of the variable nodes connected
  *                         to the current layer.
- * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ * \return The number of parity checks of the layer that are not satisfied by the updated soft bits, -1 if an
+ *         error occurred.
  */
 int update_ldpc_check_to_var_c_avx2(void*           p,
                                     int             i_layer,
@@ -388,9 +397,10 @@ int extract_ldpc_message_c_avx2(void* p, uint8_t* message, uint16_t liftK);
  * SRSRAN_AVX2_B_SIZE).
  * \param[in] bgN          Codeword length. \param[in] bgM          Number of check nodes.
  * \param[in] ls           Lifting size. \param[in] scaling_fctr Scaling factor of the normalized min-sum algorithm.
+ * \param[in] offset       Offset of the offset min-sum algorithm, 0 for the normalized min-sum algorithm.
  * \return A pointer to the created registers (an ldpc_regs_c_avx2long structure).
  */
-void* create_ldpc_dec_c_avx2long(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr);
+void* create_ldpc_dec_c_avx2long(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset);
 
 /*!
  * Destroys the inner registers of the optimized 8-bit integer-based LDPC decoder (LS > \ref SRSRAN_AVX2_B_SIZE).
@@ -425,7 +435,8 @@ int update_ldpc_var_to_check_c_avx2long(void* p, int i_layer);
  * \param[in]     these_var_indices
  *                         Contains the indices of the variable nodes connected
  *                         to the current layer.
- * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ * \return The number of parity checks of the layer that are not satisfied by the updated soft bits, -1 if an
+ *         error occurred.
  */
 int update_ldpc_check_to_var_c_avx2long(void*           p,
                                         int             i_layer,
@@ -459,9 +470,10 @@ int extract_ldpc_message_c_avx2long(void* p, uint8_t* message, uint16_t liftK);
  * \param[in] bgM          Number of check nodes.
  * \param[in] ls           Lifting size.
  * \param[in] scaling_fctr Scaling factor of the normalized min-sum algorithm.
+ * \param[in] offset       Offset of the offset min-sum algorithm, 0 for the normalized min-sum algorithm.
  * \return A pointer to the created registers (an ldpc_regs_c_avx2_flood structure).
  */
-void* create_ldpc_dec_c_avx2_flood(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr);
+void* create_ldpc_dec_c_avx2_flood(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset);
 
 /*!
  * Destroys the inner registers of the optimized 8-bit integer-based LDPC decoder
@@ -533,9 +545,10 @@ int extract_ldpc_message_c_avx2_flood(void* p, uint8_t* message, uint16_t liftK)
  * \param[in] bgM          Number of check nodes.
  * \param[in] ls           Lifting size.
  * \param[in] scaling_fctr Scaling factor of the normalized min-sum algorithm.
+ * \param[in] offset       Offset of the offset min-sum algorithm, 0 for the normalized min-sum algorithm.
  * \return A pointer to the created registers (an ldpc_regs_c_avx2long_flood structure).
  */
-void* create_ldpc_dec_c_avx2long_flood(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr);
+void* create_ldpc_dec_c_avx2long_flood(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset);
 
 /*!
  * Destroys the inner registers of the optimized 8-bit integer-based LDPC decoder (flooded scheduling, LS > \ref
@@ -605,9 +618,10 @@ int extract_ldpc_message_c_avx2long_flood(void* p, uint8_t* message, uint16_t li
  * Creates the registers used by the optimized 8-bit-based implementation of the LDPC decoder (LS > \ref
  * SRSRAN_AVX512_B_SIZE). \param[in] bgN          Codeword length. \param[in] bgM          Number of check nodes.
  * \param[in] ls           Lifting size. \param[in] scaling_fctr Scaling factor of the normalized min-sum algorithm.
+ * \param[in] offset       Offset of the offset min-sum algorithm, 0 for the normalized min-sum algorithm.
  * \return A pointer to the created registers (an ldpc_regs_c_avx512long structure).
  */
-void* create_ldpc_dec_c_avx512long(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr);
+void* create_ldpc_dec_c_avx512long(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset);
 
 /*!
  * Destroys the inner registers of the optimized 8-bit integer-based LDPC decoder (LS > \ref SRSRAN_AVX512_B_SIZE).
@@ -642,7 +656,8 @@ int update_ldpc_var_to_check_c_avx512long(void* p, int i_layer);
  * \param[in]     these_var_indices
  *                         Contains the indices of the variable nodes connected
  *                         to the current layer.
- * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ * \return The number of parity checks of the layer that are not satisfied by the updated soft bits, -1 if an
+ *         error occurred.
  */
 int update_ldpc_check_to_var_c_avx512long(void*           p,
                                           int             i_layer,
@@ -674,9 +689,10 @@ int extract_ldpc_message_c_avx512long(void* p, uint8_t* message, uint16_t liftK)
  * SRSRAN_AVX512_B_SIZE).
  * \param[in] bgN          Codeword length. \param[in] bgM          Number of check nodes.
  * \param[in] ls           Lifting size. \param[in] scaling_fctr Scaling factor of the normalized min-sum algorithm.
+ * \param[in] offset       Offset of the offset min-sum algorithm, 0 for the normalized min-sum algorithm.
  * \return A pointer to the created registers (an ldpc_regs_c_avx512 structure).
  */
-void* create_ldpc_dec_c_avx512(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr);
+void* create_ldpc_dec_c_avx512(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset);
 
 /*!
  * Destroys the inner registers of the optimized 8-bit integer-based LDPC decoder (LS <= \ref SRSRAN_AVX512_B_SIZE).
@@ -711,7 +727,8 @@ int update_ldpc_var_to_check_c_avx512(void* p, int i_layer);
  * \param[in]     these_var_indices
  *                         Contains the indices of the variable nodes connected
  *                         to the current layer.
- * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ * \return The number of parity checks of the layer that are not satisfied by the updated soft bits, -1 if an
+ *         error occurred.
  */
 int update_ldpc_check_to_var_c_avx512(void*           p,
                                       int             i_layer,
@@ -745,9 +762,10 @@ int extract_ldpc_message_c_avx512(void* p, uint8_t* message, uint16_t liftK);
  * \param[in] bgM          Number of check nodes.
  * \param[in] ls           Lifting size.
  * \param[in] scaling_fctr Scaling factor of the normalized min-sum algorithm.
+ * \param[in] offset       Offset of the offset min-sum algorithm, 0 for the normalized min-sum algorithm.
  * \return A pointer to the created registers (an ldpc_regs_c_avx512long_flood structure).
  */
-void* create_ldpc_dec_c_avx512long_flood(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr);
+void* create_ldpc_dec_c_avx512long_flood(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset);
 
 /*!
  * Destroys the inner registers of the optimized 8-bit integer-based LDPC decoder (flooded scheduling, LS > \ref
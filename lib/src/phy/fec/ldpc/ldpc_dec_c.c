@@ -35,6 +35,7 @@
  *
  */
 
+#include <math.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <strings.h>
@@ -61,12 +62,14 @@ struct ldpc_regs_c {
   int8_t (*min_v2c)[2]; /*!< \brief Helper register for computing check-to-variable messages. */
   int* min_v_index;     /*!< \brief Helper register for computing check-to-variable messages. */
   int* prod_v2c;        /*!< \brief Helper register for computing check-to-variable messages. */
+  uint8_t* syndrome;    /*!< \brief Helper register for checking the parity equations of a layer. */
 
   uint16_t liftN;        /*!< \brief Total number of variable nodes (after lifting). */
   uint16_t hrrN;         /*!< \brief Number of variable nodes in the high-rate region (after lifing). */
   uint8_t  bgM;          /*!< \brief Number of check nodes (before lifting). */
   uint16_t ls;           /*!< \brief Lifting size. */
   int      scaling_fctr; /*!< \brief Scaling factor for the normalized min-sum decoding algorithm. */
+  int8_t   offset;       /*!< \brief Offset for the offset min-sum decoding algorithm, 0 if not used. */
 };
 
 /*!
@@ -85,7 +88,7 @@ struct ldpc_regs_c {
  */
 static void inner_var_to_check_c(const int8_t* x, const int8_t* y, int8_t* z, uint8_t clip, uint32_t len);
 
-void* create_ldpc_dec_c(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr)
+void* create_ldpc_dec_c(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset)
 {
   struct ldpc_regs_c* vp = NULL;
 
@@ -142,12 +145,24 @@ void* create_ldpc_dec_c(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fct
     return NULL;
   }
 
+  if ((vp->syndrome = srsran_vec_u8_malloc(ls)) == NULL) {
+    free(vp->prod_v2c);
+    free(vp->min_v_index);
+    free(vp->min_v2c);
+    free(vp->var_to_check);
+    free(vp->check_to_var);
+    free(vp->soft_bits);
+    free(vp);
+    return NULL;
+  }
+
   vp->bgM   = bgM;
   vp->liftN = liftN;
   vp->hrrN  = hrrN;
   vp->ls    = ls;
 
   vp->scaling_fctr = (int)(scaling_fctr * F2I);
+  vp->offset       = (int8_t)roundf(offset);
 
   return vp;
 }
@@ -157,6 +172,7 @@ void delete_ldpc_dec_c(void* p)
   struct ldpc_regs_c* vp = p;
 
   if (vp != NULL) {
+    free(vp->syndrome);
     free(vp->prod_v2c);
     free(vp->min_v_index);
     free(vp->min_v2c);
@@ -264,6 +280,8 @@ int update_ldpc_check_to_var_c(void*           p,
   int8_t* this_check_to_var = vp->check_to_var + i_layer * (vp->hrrN + vp->ls);
   current_var_index         = (*these_var_indices)[0];
 
+  srsran_vec_u8_zero(vp->syndrome, vp->ls);
+
   for (i = 0; (current_var_index != -1) && (i < MAX_CNCT); i++) {
     shift      = this_pcm[current_var_index];
     i_v2c_base = current_var_index * vp->ls;
@@ -273,14 +291,27 @@ int update_ldpc_check_to_var_c(void*           p,
       i_v2c = i_v2c_base + j;
 
       this_check_to_var[i_v2c] = (i_v2c != vp->min_v_index[index]) ? vp->min_v2c[index][0] : vp->min_v2c[index][1];
-      this_check_to_var[i_v2c] = this_check_to_var[i_v2c] * vp->scaling_fctr / F2I;
+      if (vp->offset > 0) {
+        this_check_to_var[i_v2c] =
+            (this_check_to_var[i_v2c] > vp->offset) ? (int8_t)(this_check_to_var[i_v2c] - vp->offset) : 0;
+      } else {
+        this_check_to_var[i_v2c] = this_check_to_var[i_v2c] * vp->scaling_fctr / F2I;
+      }
 
       this_check_to_var[i_v2c] *= vp->prod_v2c[index] * ((vp->var_to_check[i_v2c] >= 0) ? 1 : -1);
+
+      // The parity check is evaluated on the hard decision of the updated soft bit
+      vp->syndrome[index] ^= ((long)this_check_to_var[i_v2c] + vp->var_to_check[i_v2c] < 0);
     }
     current_var_index = (*these_var_indices)[(i + 1) % MAX_CNCT];
   }
 
-  return 0;
+  int n_unsatisfied = 0;
+  for (i = 0; i < vp->ls; i++) {
+    n_unsatisfied += vp->syndrome[i];
+  }
+
+  return n_unsatisfied;
 }
 
 int update_ldpc_soft_bits_c(void* p, int i_layer, const int8_t (*these_var_indices)[MAX_CNCT])
@@ -35,6 +35,8 @@
  *
  */
 
+#include <math.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <strings.h>
@@ -71,6 +73,8 @@ static const int8_t infinity7 = (1U << 6U) - 1;
  */
 struct ldpc_regs_c_avx2 {
   __m256i scaling_fctr; /*!< \brief Scaling factor for the normalized min-sum decoding algorithm. */
+  __m256i offset;       /*!< \brief Offset for the offset min-sum decoding algorithm. */
+  bool    use_offset;   /*!< \brief Use the offset min-sum instead of the normalized min-sum decoding algorithm. */
 
   bg_node_t soft_bits;    /*!< \brief A-posteriori log-likelihood ratios. */
   __m256i*  check_to_var; /*!< \brief Check-to-variable messages. */
@@ -147,7 +151,7 @@ static __m256i rotate_node_right(__m256i a, int imm, uint16_t ls);
  */
 static __m256i _mm256_scalei_epi8(__m256i a, __m256i sf);
 
-void* create_ldpc_dec_c_avx2(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr)
+void* create_ldpc_dec_c_avx2(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset)
 {
   struct ldpc_regs_c_avx2* vp = NULL;
 
@@ -186,6 +190,8 @@ void* create_ldpc_dec_c_avx2(uint8_t bgN, uint8_t bgM, uint16_t ls, float scalin
 
   // correction > 1/16 to compensate the scaling error (2^16-1)/2^16 incurred in _mm256_scalei_epi8
   vp->scaling_fctr = _mm256_set1_epi16((uint16_t)((scaling_fctr + 0.00001525879) * F2I));
+  vp->offset       = _mm256_set1_epi8((int8_t)roundf(offset));
+  vp->use_offset   = (roundf(offset) > 0);
 
   return vp;
 }
@@ -324,6 +330,7 @@ int update_ldpc_check_to_var_c_avx2(void*           p,
   __m256i this_c2v_epi8;
   __m256i help_c2v_epi8;
   __m256i final_sign_epi8;
+  __m256i syndrome_epi8 = _mm256_setzero_si256();
 
   for (i = 0; (current_var_index != -1) && (i < MAX_CNCT); i++) {
     shift      = this_pcm[current_var_index];
@@ -337,16 +344,29 @@ int update_ldpc_check_to_var_c_avx2(void*           p,
     current_ix_epi8  = _mm256_set1_epi8((int8_t)i);
     mask_is_min_epi8 = _mm256_cmpeq_epi8(current_ix_epi8, min_ix_epi8);
     this_c2v_epi8    = _mm256_blendv_epi8(minp_v2c_epi8, mins_v2c_epi8, mask_is_min_epi8);
-    this_c2v_epi8    = _mm256_scalei_epi8(this_c2v_epi8, vp->scaling_fctr);
-    help_c2v_epi8    = _mm256_sign_epi8(this_c2v_epi8, final_sign_epi8);
-    this_c2v_epi8    = _mm256_blendv_epi8(this_c2v_epi8, help_c2v_epi8, final_sign_epi8);
+    if (vp->use_offset) {
+      this_c2v_epi8 = _mm256_subs_epu8(this_c2v_epi8, vp->offset);
+    } else {
+      this_c2v_epi8 = _mm256_scalei_epi8(this_c2v_epi8, vp->scaling_fctr);
+    }
+    help_c2v_epi8 = _mm256_sign_epi8(this_c2v_epi8, final_sign_epi8);
+    this_c2v_epi8 = _mm256_blendv_epi8(this_c2v_epi8, help_c2v_epi8, final_sign_epi8);
+
+    // The parity check is evaluated on the hard decision of the updated soft bit
+    syndrome_epi8 = _mm256_xor_si256(syndrome_epi8, _mm256_adds_epi8(*this_rotated_v2c, this_c2v_epi8));
 
     this_check_to_var[i_v2c_base] = rotate_node_left(this_c2v_epi8, shift, vp->ls);
 
     current_var_index = (*these_var_indices)[(i + 1) % MAX_CNCT];
   }
 
-  return 0;
+  // Only the first ls chars of a rotated node correspond to parity checks
+  uint32_t syndrome = (uint32_t)_mm256_movemask_epi8(syndrome_epi8);
+  if (vp->ls < SRSRAN_AVX2_B_SIZE) {
+    syndrome &= (1U << vp->ls) - 1U;
+  }
+
+  return __builtin_popcount(syndrome);
 }
 
 int update_ldpc_soft_bits_c_avx2(void* p, int i_layer, const int8_t (*these_var_indices)[MAX_CNCT])
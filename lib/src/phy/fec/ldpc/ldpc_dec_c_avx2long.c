@@ -35,6 +35,8 @@
  *
  */
 
+#include <math.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <strings.h>
@@ -71,6 +73,8 @@ static const int8_t infinity7 = (1U << 6U) - 1;
  */
 struct ldpc_regs_c_avx2long {
   __m256i scaling_fctr; /*!< \brief Scaling factor for the normalized min-sum decoding algorithm. */
+  __m256i offset;       /*!< \brief Offset for the offset min-sum decoding algorithm. */
+  bool    use_offset;   /*!< \brief Use the offset min-sum instead of the normalized min-sum decoding algorithm. */
 
   bg_node_t* soft_bits;            /*!< \brief A-posteriori log-likelihood ratios. */
   __m256i*   check_to_var;         /*!< \brief Check-to-variable messages. */
@@ -85,6 +89,7 @@ struct ldpc_regs_c_avx2long {
   __m256i* mins_v2c_epi8;         /*!< \brief Helper register for the second minimum v2c message. */
   __m256i* prod_v2c_epi8;         /*!< \brief Helper register for the sign of the product of all v2c messages. */
   __m256i* min_ix_epi8;           /*!< \brief Helper register for the index of the minimum v2c message. */
+  __m256i* syndrome_epi8;         /*!< \brief Helper register for checking the parity equations of a layer. */
 
   uint16_t ls;  /*!< \brief Lifting size. */
   uint8_t  hrr; /*!< \brief Number of variable nodes in the high-rate region (before lifting). */
@@ -130,7 +135,7 @@ static void rotate_node_right(const __m256i* in_256i, __m256i* out, uint16_t shi
  */
 static __m256i _mm256_scalei_epi8(__m256i a, __m256i sf);
 
-void* create_ldpc_dec_c_avx2long(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr)
+void* create_ldpc_dec_c_avx2long(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset)
 {
   struct ldpc_regs_c_avx2long* vp = NULL;
 
@@ -194,6 +199,11 @@ void* create_ldpc_dec_c_avx2long(uint8_t bgN, uint8_t bgM, uint16_t ls, float sc
   vp->this_c2v_epi8 =
       &vp->this_c2v_epi8_to_free[1]; //+1 to support reading negative position in this_c2v_epi8 at rotate_node_rigth
 
+  if ((vp->syndrome_epi8 = SRSRAN_MEM_ALLOC(__m256i, n_subnodes)) == NULL) {
+    delete_ldpc_dec_c_avx2long(vp);
+    return NULL;
+  }
+
   vp->bgM = bgM;
   vp->bgN = bgN;
   vp->hrr = hrr;
@@ -203,6 +213,8 @@ void* create_ldpc_dec_c_avx2long(uint8_t bgN, uint8_t bgM, uint16_t ls, float sc
 
   // correction > 1/16 to compensate the scaling error (2^16-1)/2^16 incurred in _mm256_scalei_epi8
   vp->scaling_fctr = _mm256_set1_epi16((uint16_t)((scaling_fctr + 0.00001525879) * F2I));
+  vp->offset       = _mm256_set1_epi8((int8_t)roundf(offset));
+  vp->use_offset   = (roundf(offset) > 0);
 
   return vp;
 }
@@ -214,6 +226,9 @@ void delete_ldpc_dec_c_avx2long(void* p)
   if (vp == NULL) {
     return;
   }
+  if (vp->syndrome_epi8) {
+    free(vp->syndrome_epi8);
+  }
   if (vp->this_c2v_epi8_to_free) {
     free(vp->this_c2v_epi8_to_free);
   }
@@ -333,6 +348,7 @@ int update_ldpc_check_to_var_c_avx2long(void*           p,
     vp->minp_v2c_epi8[j] = _mm256_set1_epi8(INT8_MAX);
     vp->mins_v2c_epi8[j] = _mm256_set1_epi8(INT8_MAX);
     vp->prod_v2c_epi8[j] = _mm256_set1_epi8(0);
+    vp->syndrome_epi8[j] = _mm256_setzero_si256();
   }
 
   int8_t current_var_index = (*these_var_indices)[0];
@@ -396,9 +412,17 @@ int update_ldpc_check_to_var_c_avx2long(void*           p,
       current_ix_epi8      = _mm256_set1_epi8((int8_t)i);
       mask_is_min_epi8     = _mm256_cmpeq_epi8(current_ix_epi8, vp->min_ix_epi8[j]);
       vp->this_c2v_epi8[j] = _mm256_blendv_epi8(vp->minp_v2c_epi8[j], vp->mins_v2c_epi8[j], mask_is_min_epi8);
-      vp->this_c2v_epi8[j] = _mm256_scalei_epi8(vp->this_c2v_epi8[j], vp->scaling_fctr);
+      if (vp->use_offset) {
+        vp->this_c2v_epi8[j] = _mm256_subs_epu8(vp->this_c2v_epi8[j], vp->offset);
+      } else {
+        vp->this_c2v_epi8[j] = _mm256_scalei_epi8(vp->this_c2v_epi8[j], vp->scaling_fctr);
+      }
       help_c2v_epi8        = _mm256_sign_epi8(vp->this_c2v_epi8[j], final_sign_epi8);
       vp->this_c2v_epi8[j] = _mm256_blendv_epi8(vp->this_c2v_epi8[j], help_c2v_epi8, final_sign_epi8);
+
+      // The parity check is evaluated on the hard decision of the updated soft bit
+      vp->syndrome_epi8[j] =
+          _mm256_xor_si256(vp->syndrome_epi8[j], _mm256_adds_epi8(this_rotated_v2c[j], vp->this_c2v_epi8[j]));
     }
     // rotating right LS - shift positions is the same as rotating left shift positions
     rotate_node_right(vp->this_c2v_epi8, this_check_to_var + i_v2c_base, vp->ls - shift, vp->ls, vp->n_subnodes);
@@ -406,7 +430,18 @@ int update_ldpc_check_to_var_c_avx2long(void*           p,
     current_var_index = (*these_var_indices)[(i + 1) % MAX_CNCT];
   }
 
-  return 0;
+  // Only the first ls chars of a rotated node correspond to parity checks
+  int n_unsatisfied = 0;
+  for (j = 0; j < vp->n_subnodes; j++) {
+    uint32_t syndrome = (uint32_t)_mm256_movemask_epi8(vp->syndrome_epi8[j]);
+    int      n_checks = vp->ls - j * SRSRAN_AVX2_B_SIZE;
+    if (n_checks < SRSRAN_AVX2_B_SIZE) {
+      syndrome &= (1U << n_checks) - 1U;
+    }
+    n_unsatisfied += __builtin_popcount(syndrome);
+  }
+
+  return n_unsatisfied;
 }
 
 int update_ldpc_soft_bits_c_avx2long(void* p, int i_layer, const int8_t (*these_var_indices)[MAX_CNCT])
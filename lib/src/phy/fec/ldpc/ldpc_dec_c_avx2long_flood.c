@@ -35,6 +35,8 @@
  *
  */
 
+#include <math.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <strings.h>
@@ -71,6 +73,8 @@ static const int8_t infinity7 = (1U << 6U) - 1;
  */
 struct ldpc_regs_c_avx2long_flood {
   __m256i scaling_fctr; /*!< \brief Scaling factor for the normalized min-sum decoding algorithm. */
+  __m256i offset;       /*!< \brief Offset for the offset min-sum decoding algorithm. */
+  bool    use_offset;   /*!< \brief Use the offset min-sum instead of the normalized min-sum decoding algorithm. */
 
   bg_node_t* soft_bits;            /*!< \brief A-posteriori log-likelihood ratios. */
   __m256i*   llrs;                 /*!< \brief A-priori log-likelihood ratios. */
@@ -130,7 +134,7 @@ static void rotate_node_right(const __m256i* in_256i, __m256i* out, uint16_t shi
  */
 static __m256i _mm256_scalei_epi8(__m256i a, __m256i sf);
 
-void* create_ldpc_dec_c_avx2long_flood(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr)
+void* create_ldpc_dec_c_avx2long_flood(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset)
 {
   struct ldpc_regs_c_avx2long_flood* vp = NULL;
 
@@ -207,6 +211,8 @@ void* create_ldpc_dec_c_avx2long_flood(uint8_t bgN, uint8_t bgM, uint16_t ls, fl
 
   // correction > 1/16 to compensate the scaling error (2^16-1)/2^16 incurred in _mm256_scalei_epi8
   vp->scaling_fctr = _mm256_set1_epi16((uint16_t)((scaling_fctr + 0.00001525879) * F2I));
+  vp->offset       = _mm256_set1_epi8((int8_t)roundf(offset));
+  vp->use_offset   = (roundf(offset) > 0);
 
   return vp;
 }
@@ -398,7 +404,11 @@ int update_ldpc_check_to_var_c_avx2long_flood(void*           p,
       current_ix_epi8      = _mm256_set1_epi8((int8_t)i);
       mask_is_min_epi8     = _mm256_cmpeq_epi8(current_ix_epi8, vp->min_ix_epi8[j]);
       vp->this_c2v_epi8[j] = _mm256_blendv_epi8(vp->minp_v2c_epi8[j], vp->mins_v2c_epi8[j], mask_is_min_epi8);
-      vp->this_c2v_epi8[j] = _mm256_scalei_epi8(vp->this_c2v_epi8[j], vp->scaling_fctr);
+      if (vp->use_offset) {
+        vp->this_c2v_epi8[j] = _mm256_subs_epu8(vp->this_c2v_epi8[j], vp->offset);
+      } else {
+        vp->this_c2v_epi8[j] = _mm256_scalei_epi8(vp->this_c2v_epi8[j], vp->scaling_fctr);
+      }
       help_c2v_epi8        = _mm256_sign_epi8(vp->this_c2v_epi8[j], final_sign_epi8);
       vp->this_c2v_epi8[j] = _mm256_blendv_epi8(vp->this_c2v_epi8[j], help_c2v_epi8, final_sign_epi8);
     }
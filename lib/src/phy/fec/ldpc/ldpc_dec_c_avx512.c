@@ -35,6 +35,8 @@
  *
  */
 
+#include <math.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <stdlib.h>
@@ -72,6 +74,8 @@ typedef union bg_node_avx512_t {
  */
 struct ldpc_regs_c_avx512 {
   __m512i scaling_fctr; /*!< \brief Scaling factor for the normalized min-sum decoding algorithm. */
+  __m512i offset;       /*!< \brief Offset for the offset min-sum decoding algorithm. */
+  bool    use_offset;   /*!< \brief Use the offset min-sum instead of the normalized min-sum decoding algorithm. */
 
   bg_node_avx512_t soft_bits;    /*!< \brief A-posteriori log-likelihood ratios. */
   __m512i*         check_to_var; /*!< \brief Check-to-variable messages. */
@@ -125,7 +129,7 @@ static void rotate_node_right(const uint8_t* mem_addr, __m512i* out, uint16_t th
  */
 static __m512i _mm512_scalei_epi8(__m512i a, __m512i sf);
 
-void* create_ldpc_dec_c_avx512(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr)
+void* create_ldpc_dec_c_avx512(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset)
 {
   struct ldpc_regs_c_avx512* vp = NULL;
 
@@ -173,6 +177,8 @@ void* create_ldpc_dec_c_avx512(uint8_t bgN, uint8_t bgM, uint16_t ls, float scal
   vp->finalN = (bgN - 2) * ls;
   // correction > 1/16 to compensate the scaling error (2^16-1)/2^16 incurred in _mm512_scalei_epi8
   vp->scaling_fctr = _mm512_set1_epi16((uint16_t)((scaling_fctr + 0.00001525879) * F2I));
+  vp->offset       = _mm512_set1_epi8((int8_t)roundf(offset));
+  vp->use_offset   = (roundf(offset) > 0);
 
   return vp;
 }
@@ -334,6 +340,7 @@ int update_ldpc_check_to_var_c_avx512(void*           p,
   __mmask64 mask_is_min_epi8;
   __m512i*  this_c2v_epi8 = vp->this_c2v_epi8;
   __m512i   final_sign_epi8;
+  __m512i   syndrome_epi8 = _mm512_setzero_si512();
 
   for (i = 0; (current_var_index != -1) && (i < MAX_CNCT); i++) {
     shift      = this_pcm[current_var_index];
@@ -346,20 +353,33 @@ int update_ldpc_check_to_var_c_avx512(void*           p,
     current_ix_epi8  = _mm512_set1_epi8((int8_t)i);
     mask_is_min_epi8 = _mm512_cmpeq_epi8_mask(current_ix_epi8, min_ix_epi8);
     this_c2v_epi8[0] = _mm512_mask_blend_epi8(mask_is_min_epi8, minp_v2c_epi8, mins_v2c_epi8);
-    this_c2v_epi8[0] = _mm512_scalei_epi8(this_c2v_epi8[0], vp->scaling_fctr);
+    if (vp->use_offset) {
+      this_c2v_epi8[0] = _mm512_subs_epu8(this_c2v_epi8[0], vp->offset);
+    } else {
+      this_c2v_epi8[0] = _mm512_scalei_epi8(this_c2v_epi8[0], vp->scaling_fctr);
+    }
 
     // does *not* do anything special for signs[i] == 0, just negative / non-negative
     __mmask64 negmask = _mm512_movepi8_mask(final_sign_epi8); // transform final_sing_epi8 into a mask
 
     this_c2v_epi8[0] = _mm512_mask_sub_epi8(this_c2v_epi8[0], negmask, _mm512_setzero_si512(), this_c2v_epi8[0]);
 
+    // The parity check is evaluated on the hard decision of the updated soft bit
+    syndrome_epi8 = _mm512_xor_si512(syndrome_epi8, _mm512_adds_epi8(*this_rotated_v2c, this_c2v_epi8[0]));
+
     // rotating right LS - shift positions is the same as rotating left shift positions
     rotate_node_right((uint8_t*)vp->this_c2v_epi8, this_check_to_var + i_v2c_base, (vp->ls - shift) % vp->ls, vp->ls);
 
     current_var_index = (*these_var_indices)[(i + 1) % MAX_CNCT];
   }
 
-  return 0;
+  // Only the first ls chars of a rotated node correspond to parity checks
+  uint64_t syndrome = _mm512_movepi8_mask(syndrome_epi8);
+  if (vp->ls < SRSRAN_AVX512_B_SIZE) {
+    syndrome &= (1ULL << vp->ls) - 1ULL;
+  }
+
+  return __builtin_popcountll(syndrome);
 }
 
 int update_ldpc_soft_bits_c_avx512(void* p, int i_layer, const int8_t (*these_var_indices)[MAX_CNCT])
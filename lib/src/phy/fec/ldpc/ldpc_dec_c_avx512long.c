@@ -35,6 +35,8 @@
  *
  */
 
+#include <math.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <stdlib.h>
@@ -72,6 +74,8 @@ typedef union bg_node_avx512_t {
  */
 struct ldpc_regs_c_avx512long {
   __m512i scaling_fctr; /*!< \brief Scaling factor for the normalized min-sum decoding algorithm. */
+  __m512i offset;       /*!< \brief Offset for the offset min-sum decoding algorithm. */
+  bool    use_offset;   /*!< \brief Use the offset min-sum instead of the normalized min-sum decoding algorithm. */
 
   bg_node_avx512_t* soft_bits;    /*!< \brief A-posteriori log-likelihood ratios. */
   __m512i*          check_to_var; /*!< \brief Check-to-variable messages. */
@@ -86,6 +90,7 @@ struct ldpc_regs_c_avx512long {
   __m512i* mins_v2c_epi8;         /*!< \brief Helper register for the second minimum v2c message. */
   __m512i* prod_v2c_epi8;         /*!< \brief Helper register for the sign of the product of all v2c messages. */
   __m512i* min_ix_epi8;           /*!< \brief Helper register for the index of the minimum v2c message. */
+  __m512i* syndrome_epi8;         /*!< \brief Helper register for checking the parity equations of a layer. */
 
   uint16_t ls;         /*!< \brief Lifting size. */
   uint8_t  hrr;        /*!< \brief Number of variable nodes in the high-rate region (before lifting). */
@@ -131,7 +136,7 @@ static void rotate_node_right(const uint8_t* mem_addr, __m512i* out, uint16_t th
  */
 static __m512i _mm512_scalei_epi8(__m512i a, __m512i sf);
 
-void* create_ldpc_dec_c_avx512long(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr)
+void* create_ldpc_dec_c_avx512long(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset)
 {
   struct ldpc_regs_c_avx512long* vp = NULL;
 
@@ -230,6 +235,20 @@ void* create_ldpc_dec_c_avx512long(uint8_t bgN, uint8_t bgM, uint16_t ls, float
   vp->this_c2v_epi8 =
       &vp->this_c2v_epi8_to_free[1]; //+1 to support reading negative position in this_c2v_epi8 at rotate_node_rigth
 
+  if ((vp->syndrome_epi8 = srsran_vec_malloc(n_subnodes * sizeof(__m512i))) == NULL) {
+    free(vp->this_c2v_epi8_to_free);
+    free(vp->rotated_v2c);
+    free(vp->min_ix_epi8);
+    free(vp->prod_v2c_epi8);
+    free(vp->mins_v2c_epi8);
+    free(vp->minp_v2c_epi8);
+    free(vp->var_to_check_to_free);
+    free(vp->check_to_var);
+    free(vp->soft_bits);
+    free(vp);
+    return NULL;
+  }
+
   vp->bgM = bgM;
   vp->bgN = bgN;
   vp->hrr = hrr;
@@ -240,6 +259,8 @@ void* create_ldpc_dec_c_avx512long(uint8_t bgN, uint8_t bgM, uint16_t ls, float
   vp->finalN     = (bgN - 2) * ls;
   // correction > 1/16 to compensate the scaling error (2^16-1)/2^16 incurred in _mm512_scalei_epi8
   vp->scaling_fctr = _mm512_set1_epi16((uint16_t)((scaling_fctr + 0.00001525879) * F2I));
+  vp->offset       = _mm512_set1_epi8((int8_t)roundf(offset));
+  vp->use_offset   = (roundf(offset) > 0);
   return vp;
 }
 
@@ -248,6 +269,7 @@ void delete_ldpc_dec_c_avx512long(void* p)
   struct ldpc_regs_c_avx512long* vp = p;
 
   if (vp != NULL) {
+    free(vp->syndrome_epi8);
     free(vp->this_c2v_epi8_to_free);
     free(vp->rotated_v2c);
     free(vp->min_ix_epi8);
@@ -361,6 +383,7 @@ int update_ldpc_check_to_var_c_avx512long(void*           p,
     vp->minp_v2c_epi8[j] = _mm512_set1_epi8(INT8_MAX);
     vp->mins_v2c_epi8[j] = _mm512_set1_epi8(INT8_MAX);
     vp->prod_v2c_epi8[j] = _mm512_set1_epi8(0);
+    vp->syndrome_epi8[j] = _mm512_setzero_si512();
   }
 
   int8_t current_var_index = (*these_var_indices)[0];
@@ -414,13 +437,21 @@ int update_ldpc_check_to_var_c_avx512long(void*           p,
       current_ix_epi8      = _mm512_set1_epi8((int8_t)i);
       mask_is_min_epi8     = _mm512_cmpeq_epi8_mask(current_ix_epi8, vp->min_ix_epi8[j]);
       vp->this_c2v_epi8[j] = _mm512_mask_blend_epi8(mask_is_min_epi8, vp->minp_v2c_epi8[j], vp->mins_v2c_epi8[j]);
-      vp->this_c2v_epi8[j] = _mm512_scalei_epi8(vp->this_c2v_epi8[j], vp->scaling_fctr);
+      if (vp->use_offset) {
+        vp->this_c2v_epi8[j] = _mm512_subs_epu8(vp->this_c2v_epi8[j], vp->offset);
+      } else {
+        vp->this_c2v_epi8[j] = _mm512_scalei_epi8(vp->this_c2v_epi8[j], vp->scaling_fctr);
+      }
 
       // does *not* do anything special for signs[i] == 0, just negative / non-negative
       __mmask64 negmask = _mm512_movepi8_mask(final_sign_epi8); // transform final_sing_epi8 into a mask
 
       vp->this_c2v_epi8[j] =
           _mm512_mask_sub_epi8(vp->this_c2v_epi8[j], negmask, _mm512_setzero_si512(), vp->this_c2v_epi8[j]);
+
+      // The parity check is evaluated on the hard decision of the updated soft bit
+      vp->syndrome_epi8[j] =
+          _mm512_xor_si512(vp->syndrome_epi8[j], _mm512_adds_epi8(this_rotated_v2c[j], vp->this_c2v_epi8[j]));
     }
 
     // rotating right LS - shift positions is the same as rotating left shift positions
@@ -429,7 +460,18 @@ int update_ldpc_check_to_var_c_avx512long(void*           p,
     current_var_index = (*these_var_indices)[(i + 1) % MAX_CNCT];
   }
 
-  return 0;
+  // Only the first ls chars of a rotated node correspond to parity checks
+  int n_unsatisfied = 0;
+  for (j = 0; j < vp->n_subnodes; j++) {
+    uint64_t syndrome = _mm512_movepi8_mask(vp->syndrome_epi8[j]);
+    int      n_checks = vp->ls - j * SRSRAN_AVX512_B_SIZE;
+    if (n_checks < SRSRAN_AVX512_B_SIZE) {
+      syndrome &= (1ULL << n_checks) - 1ULL;
+    }
+    n_unsatisfied += __builtin_popcountll(syndrome);
+  }
+
+  return n_unsatisfied;
 }
 
 int update_ldpc_soft_bits_c_avx512long(void* p, int i_layer, const int8_t (*these_var_indices)[MAX_CNCT])
@@ -35,6 +35,8 @@
  *
  */
 
+#include <math.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <strings.h>
@@ -72,6 +74,8 @@ typedef union bg_node_avx512_t {
  */
 struct ldpc_regs_c_avx512long_flood {
   __m512i scaling_fctr; /*!< \brief Scaling factor for the normalized min-sum decoding algorithm. */
+  __m512i offset;       /*!< \brief Offset for the offset min-sum decoding algorithm. */
+  bool    use_offset;   /*!< \brief Use the offset min-sum instead of the normalized min-sum decoding algorithm. */
 
   bg_node_avx512_t* soft_bits;            /*!< \brief A-posteriori log-likelihood ratios. */
   __m512i*          llrs;                 /*!< \brief A-priori log-likelihood ratios. */
@@ -130,7 +134,7 @@ static void rotate_node_right(const uint8_t* mem_addr, __m512i* out, uint16_t th
  */
 static __m512i _mm512_scalei_epi8(__m512i a, __m512i sf);
 
-void* create_ldpc_dec_c_avx512long_flood(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr)
+void* create_ldpc_dec_c_avx512long_flood(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset)
 {
   struct ldpc_regs_c_avx512long_flood* vp = NULL;
 
@@ -251,6 +255,8 @@ void* create_ldpc_dec_c_avx512long_flood(uint8_t bgN, uint8_t bgM, uint16_t ls,
 
   // correction > 1/16 to compensate the scaling error (2^16-1)/2^16 incurred in _mm512_scalei_epi8
   vp->scaling_fctr = _mm512_set1_epi16((uint16_t)((scaling_fctr + 0.00001525879) * F2I));
+  vp->offset       = _mm512_set1_epi8((int8_t)roundf(offset));
+  vp->use_offset   = (roundf(offset) > 0);
 
   return vp;
 }
@@ -416,7 +422,11 @@ int update_ldpc_check_to_var_c_avx512long_flood(void*           p,
       current_ix_epi8      = _mm512_set1_epi8((int8_t)i);
       mask_is_min_epi8     = _mm512_cmpeq_epi8_mask(current_ix_epi8, vp->min_ix_epi8[j]);
       vp->this_c2v_epi8[j] = _mm512_mask_blend_epi8(mask_is_min_epi8, vp->minp_v2c_epi8[j], vp->mins_v2c_epi8[j]);
-      vp->this_c2v_epi8[j] = _mm512_scalei_epi8(vp->this_c2v_epi8[j], vp->scaling_fctr);
+      if (vp->use_offset) {
+        vp->this_c2v_epi8[j] = _mm512_subs_epu8(vp->this_c2v_epi8[j], vp->offset);
+      } else {
+        vp->this_c2v_epi8[j] = _mm512_scalei_epi8(vp->this_c2v_epi8[j], vp->scaling_fctr);
+      }
 
       // does *not* do anything special for signs[i] == 0, just negative / non-negative
       __mmask64 negmask = _mm512_movepi8_mask(final_sign_epi8); // transform final_sing_epi8 into a mask
@@ -35,6 +35,7 @@
  *
  */
 
+#include <math.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <strings.h>
@@ -68,6 +69,7 @@ struct ldpc_regs_c_flood {
   uint8_t  bgM;          /*!< \brief Number of check nodes (before lifting). */
   uint16_t ls;           /*!< \brief Lifting size. */
   int      scaling_fctr; /*!< \brief Scaling factor for the normalized min-sum decoding algorithm. */
+  int8_t   offset;       /*!< \brief Offset for the offset min-sum decoding algorithm, 0 if not used. */
 };
 
 /*!
@@ -86,7 +88,7 @@ struct ldpc_regs_c_flood {
  */
 static void inner_var_to_check_c(const int8_t* x, const int8_t* y, int8_t* z, uint8_t clip, uint32_t len);
 
-void* create_ldpc_dec_c_flood(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr)
+void* create_ldpc_dec_c_flood(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr, float offset)
 {
   struct ldpc_regs_c_flood* vp = NULL;
 
@@ -160,6 +162,7 @@ void* create_ldpc_dec_c_flood(uint8_t bgN, uint8_t bgM, uint16_t ls, float scali
   vp->ls    = ls;
 
   vp->scaling_fctr = (int)(scaling_fctr * F2I);
+  vp->offset       = (int8_t)roundf(offset);
 
   return vp;
 }
@@ -291,7 +294,12 @@ int update_ldpc_check_to_var_c_flood(void*           p,
       i_v2c = i_v2c_base + j;
 
       this_check_to_var[i_v2c] = (i_v2c != vp->min_v_index[index]) ? vp->min_v2c[index][0] : vp->min_v2c[index][1];
-      this_check_to_var[i_v2c] = this_check_to_var[i_v2c] * vp->scaling_fctr / F2I;
+      if (vp->offset > 0) {
+        this_check_to_var[i_v2c] =
+            (this_check_to_var[i_v2c] > vp->offset) ? (int8_t)(this_check_to_var[i_v2c] - vp->offset) : 0;
+      } else {
+        this_check_to_var[i_v2c] = this_check_to_var[i_v2c] * vp->scaling_fctr / F2I;
+      }
 
       this_check_to_var[i_v2c] *= vp->prod_v2c[index] * ((this_var_to_check[i_v2c] >= 0) ? 1 : -1);
     }
@@ -29,6 +29,7 @@
  *
  */
 
+#include <math.h>
 #include <stdint.h>
 
 #include "../utils_avx2.h"
@@ -41,6 +42,12 @@
 
 #define LDPC_DECODER_DEFAULT_MAX_NOF_ITER 10 /*!< \brief Default maximum number of iterations of the BP algorithm. */
 
+/*!
+ * \brief Default offset of the offset min-sum algorithm for the 8-bit decoders. It was found to give the lowest block
+ * error rate for both base graphs and all lifting sizes, with the LLR quantization of the NR PUSCH/PDSCH demodulators.
+ */
+#define LDPC_DECODER_DEFAULT_OFFSET 1.0f
+
 #define LDPC_DECODER_TEMPLATE(LLR_TYPE, SUFFIX)                                                                        \
   static int decode_##SUFFIX(                                                                                          \
       void* o, const LLR_TYPE* llrs, uint8_t* message, uint32_t cdwd_rm_length, srsran_crc_t* crc)                     \
@@ -72,6 +79,9 @@
     /* the first two variable nodes from the final codeword.*/                                                         \
     uint8_t n_layers = cdwd_rm_length / q->ls - q->bgK + 2;                                                            \
                                                                                                                        \
+    /* Number of consecutive layers whose parity checks are all satisfied */                                           \
+    uint16_t n_layers_ok = 0;                                                                                          \
+                                                                                                                       \
     for (int i_iteration = 0; i_iteration < q->max_nof_iter; i_iteration++) {                                          \
       for (int i_layer = 0; i_layer < n_layers; i_layer++) {                                                           \
         update_ldpc_var_to_check_##SUFFIX(q->ptr, i_layer);                                                            \
@@ -79,9 +89,28 @@
         this_pcm          = q->pcm + i_layer * q->bgN;                                                                 \
         these_var_indices = q->var_indices + i_layer;                                                                  \
                                                                                                                        \
-        update_ldpc_check_to_var_##SUFFIX(q->ptr, i_layer, this_pcm, these_var_indices);                               \
+        int n_unsatisfied = update_ldpc_check_to_var_##SUFFIX(q->ptr, i_layer, this_pcm, these_var_indices);           \
                                                                                                                        \
         update_ldpc_soft_bits_##SUFFIX(q->ptr, i_layer, these_var_indices);                                            \
+                                                                                                                       \
+        if (!q->early_stop) {                                                                                          \
+          continue;                                                                                                    \
+        }                                                                                                              \
+                                                                                                                       \
+        /* Stop once a whole round of layers satisfies all the parity checks. The check of a layer may be broken by */ \
+        /* the following ones, hence two rounds are required if the CRC cannot confirm the codeword */                 \
+        n_layers_ok = (n_unsatisfied == 0) ? n_layers_ok + 1 : 0;                                                      \
+        if (n_layers_ok < ((crc == NULL) ? 2 * n_layers : n_layers)) {                                                 \
+          continue;                                                                                                    \
+        }                                                                                                              \
+                                                                                                                       \
+        extract_ldpc_message_##SUFFIX(q->ptr, message, q->liftK);                                                      \
+        if (crc == NULL || srsran_crc_match(crc, message, q->liftK - crc->order)) {                                    \
+          return i_iteration + 1;                                                                                      \
+        }                                                                                                              \
+                                                                                                                       \
+        /* A valid codeword that does not match the CRC, keep iterating in case it moves away from it */               \
+        n_layers_ok = 0;                                                                                               \
       }                                                                                                                \
                                                                                                                        \
       if (crc != NULL) {                                                                                               \
@@ -188,7 +217,7 @@ static int init_f(srsran_ldpc_decoder_t* q)
 {
   q->free = free_dec_f;
 
-  if ((q->ptr = create_ldpc_dec_f(q->bgN, q->bgM, q->ls, q->scaling_fctr)) == NULL) {
+  if ((q->ptr = create_ldpc_dec_f(q->bgN, q->bgM, q->ls, q->scaling_fctr, q->offset)) == NULL) {
     ERROR("Create_ldpc_dec failed");
     free_dec_f(q);
     return -1;
@@ -220,7 +249,7 @@ static int init_s(srsran_ldpc_decoder_t* q)
 {
   q->free = free_dec_s;
 
-  if ((q->ptr = create_ldpc_dec_s(q->bgN, q->bgM, q->ls, q->scaling_fctr)) == NULL) {
+  if ((q->ptr = create_ldpc_dec_s(q->bgN, q->bgM, q->ls, q->scaling_fctr, q->offset)) == NULL) {
     ERROR("Create_ldpc_dec failed");
     free_dec_s(q);
     return -1;
@@ -252,7 +281,7 @@ static int init_c(srsran_ldpc_decoder_t* q)
 {
   q->free = free_dec_c;
 
-  if ((q->ptr = create_ldpc_dec_c(q->bgN, q->bgM, q->ls, q->scaling_fctr)) == NULL) {
+  if ((q->ptr = create_ldpc_dec_c(q->bgN, q->bgM, q->ls, q->scaling_fctr, q->offset)) == NULL) {
     ERROR("Create_ldpc_dec failed");
     free_dec_c(q);
     return -1;
@@ -284,7 +313,7 @@ static int init_c_flood(srsran_ldpc_decoder_t* q)
 {
   q->free = free_dec_c_flood;
 
-  if ((q->ptr = create_ldpc_dec_c_flood(q->bgN, q->bgM, q->ls, q->scaling_fctr)) == NULL) {
+  if ((q->ptr = create_ldpc_dec_c_flood(q->bgN, q->bgM, q->ls, q->scaling_fctr, q->offset)) == NULL) {
     ERROR("Create_ldpc_dec failed");
     free_dec_c_flood(q);
     return -1;
@@ -317,7 +346,7 @@ static int init_c_avx2(srsran_ldpc_decoder_t* q)
 {
   q->free = free_dec_c_avx2;
 
-  if ((q->ptr = create_ldpc_dec_c_avx2(q->bgN, q->bgM, q->ls, q->scaling_fctr)) == NULL) {
+  if ((q->ptr = create_ldpc_dec_c_avx2(q->bgN, q->bgM, q->ls, q->scaling_fctr, q->offset)) == NULL) {
     ERROR("Create_ldpc_dec failed");
     free_dec_c_avx2(q);
     return -1;
@@ -350,7 +379,7 @@ static int init_c_avx2long(srsran_ldpc_decoder_t* q)
 {
   q->free = free_dec_c_avx2long;
 
-  if ((q->ptr = create_ldpc_dec_c_avx2long(q->bgN, q->bgM, q->ls, q->scaling_fctr)) == NULL) {
+  if ((q->ptr = create_ldpc_dec_c_avx2long(q->bgN, q->bgM, q->ls, q->scaling_fctr, q->offset)) == NULL) {
     ERROR("Create_ldpc_dec failed");
     free_dec_c_avx2long(q);
     return -1;
@@ -383,7 +412,7 @@ static int init_c_avx2_flood(srsran_ldpc_decoder_t* q)
 {
   q->free = free_dec_c_avx2_flood;
 
-  if ((q->ptr = create_ldpc_dec_c_avx2_flood(q->bgN, q->bgM, q->ls, q->scaling_fctr)) == NULL) {
+  if ((q->ptr = create_ldpc_dec_c_avx2_flood(q->bgN, q->bgM, q->ls, q->scaling_fctr, q->offset)) == NULL) {
     ERROR("Create_ldpc_dec failed");
     free_dec_c_avx2_flood(q);
     return -1;
@@ -418,7 +447,7 @@ static int init_c_avx2long_flood(srsran_ldpc_decoder_t* q)
 {
   q->free = free_dec_c_avx2long_flood;
 
-  if ((q->ptr = create_ldpc_dec_c_avx2long_flood(q->bgN, q->bgM, q->ls, q->scaling_fctr)) == NULL) {
+  if ((q->ptr = create_ldpc_dec_c_avx2long_flood(q->bgN, q->bgM, q->ls, q->scaling_fctr, q->offset)) == NULL) {
     ERROR("Create_ldpc_dec failed");
     free_dec_c_avx2long(q);
     return -1;
@@ -456,7 +485,7 @@ static int init_c_avx512(srsran_ldpc_decoder_t* q)
 {
   q->free = free_dec_c_avx512;
 
-  if ((q->ptr = create_ldpc_dec_c_avx512(q->bgN, q->bgM, q->ls, q->scaling_fctr)) == NULL) {
+  if ((q->ptr = create_ldpc_dec_c_avx512(q->bgN, q->bgM, q->ls, q->scaling_fctr, q->offset)) == NULL) {
     ERROR("Create_ldpc_dec failed");
     free_dec_c_avx512(q);
     return -1;
@@ -489,7 +518,7 @@ static int init_c_avx512long(srsran_ldpc_decoder_t* q)
 {
   q->free = free_dec_c_avx512long;
 
-  if ((q->ptr = create_ldpc_dec_c_avx512long(q->bgN, q->bgM, q->ls, q->scaling_fctr)) == NULL) {
+  if ((q->ptr = create_ldpc_dec_c_avx512long(q->bgN, q->bgM, q->ls, q->scaling_fctr, q->offset)) == NULL) {
     ERROR("Create_ldpc_dec failed");
     free_dec_c_avx512long(q);
     return -1;
@@ -524,7 +553,7 @@ static int init_c_avx512long_flood(srsran_ldpc_decoder_t* q)
 {
   q->free = free_dec_c_avx512long_flood;
 
-  if ((q->ptr = create_ldpc_dec_c_avx512long_flood(q->bgN, q->bgM, q->ls, q->scaling_fctr)) == NULL) {
+  if ((q->ptr = create_ldpc_dec_c_avx512long_flood(q->bgN, q->bgM, q->ls, q->scaling_fctr, q->offset)) == NULL) {
     ERROR("Create_ldpc_dec failed");
     free_dec_c_avx512long_flood(q);
     return -1;
@@ -537,6 +566,19 @@ static int init_c_avx512long_flood(srsran_ldpc_decoder_t* q)
 
 #endif // LV_HAVE_AVX512
 
+float srsran_ldpc_decoder_default_offset(srsran_basegraph_t bg, uint16_t ls)
+{
+  if (bg != BG1 && bg != BG2) {
+    return 0;
+  }
+
+  if (get_ls_index(ls) == VOID_LIFTSIZE) {
+    return 0;
+  }
+
+  return LDPC_DECODER_DEFAULT_OFFSET;
+}
+
 int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder_args_t* args)
 {
   if (q == NULL || args == NULL) {
@@ -577,6 +619,23 @@ int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder
   q->liftN = ls * q->bgN;
 
   q->max_nof_iter = (args->max_nof_iter == 0) ? LDPC_DECODER_DEFAULT_MAX_NOF_ITER : args->max_nof_iter;
+  q->early_stop   = args->early_stop;
+
+  // The offset min-sum algorithm does not use the scaling factor
+  q->offset = 0;
+  if (args->ms_type == SRSRAN_LDPC_DECODER_MS_OFFSET) {
+    if (args->offset > 0) {
+      q->offset = args->offset;
+    } else if (type != SRSRAN_LDPC_DECODER_F && type != SRSRAN_LDPC_DECODER_S) {
+      q->offset = srsran_ldpc_decoder_default_offset(bg, ls);
+    }
+    // Integer decoders round the offset
+    if (q->offset <= 0 || (type != SRSRAN_LDPC_DECODER_F && roundf(q->offset) < 1)) {
+      ERROR("Invalid offset %.2f for the offset min-sum algorithm", q->offset);
+      return -1;
+    }
+    scaling_fctr = 0;
+  }
 
   q->pcm = srsran_vec_u16_malloc(q->bgM * q->bgN);
   if (!q->pcm) {
@@ -598,7 +657,7 @@ int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder
     return -1;
   }
 
-  if ((scaling_fctr <= 0) || (scaling_fctr > 1)) {
+  if (q->offset == 0 && ((scaling_fctr <= 0) || (scaling_fctr > 1))) {
     perror("The scaling factor of the min-sum algorithm should be larger than 0 and not larger than 1.");
     free(q->var_indices);
     free(q->pcm);
@@ -581,6 +581,26 @@ int srsran_ldpc_encoder_encode(srsran_ldpc_encoder_t* q, const uint8_t* input, u
   return q->encode(q, input, output, input_length, q->liftN - 2 * q->ls);
 }
 
+int srsran_ldpc_encoder_encode_batch(srsran_ldpc_encoder_t* q,
+                                     const uint8_t* const*  input,
+                                     uint8_t* const*        output,
+                                     uint32_t               nof_messages,
+                                     uint32_t               input_length)
+{
+  if (input_length / q->bgK != q->ls) {
+    ERROR("Dimension mismatch.");
+    return -1;
+  }
+
+  uint32_t cdwd_length = q->liftN - 2 * q->ls;
+  for (uint32_t i = 0; i < nof_messages; i++) {
+    if (q->encode(q, input[i], output[i], input_length, cdwd_length) < 0) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
 int srsran_ldpc_encoder_encode_rm(srsran_ldpc_encoder_t* q,
                                   const uint8_t*         input,
                                   uint8_t*               output,
@@ -30,6 +30,7 @@
  */
 
 #include <math.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -40,6 +41,10 @@
 
 #include "srsran/phy/utils/debug.h"
 
+#if defined(LV_HAVE_AVX2) || defined(LV_HAVE_AVX512)
+#include <immintrin.h>
+#endif // LV_HAVE_AVX2 || LV_HAVE_AVX512
+
 //#define debug
 /*!
  * \brief Look-up table: k0 indices
@@ -107,6 +112,35 @@ struct pRM_rx_c {
   uint32_t* indices;       /*!< \brief Pointer to a temporal buffer with the indices for bit-selection. */
 };
 
+/*!
+ * \brief Contiguous piece of the bit selection: the soft bits k to k + len - 1 (bit-selection order) are added to
+ * the circular buffer positions dst to dst + len - 1.
+ */
+typedef struct {
+  uint32_t k;   /*!< \brief First soft bit. */
+  uint32_t dst; /*!< \brief First position in the circular buffer. */
+  uint32_t len; /*!< \brief Number of soft bits. */
+} rm_rx_run_t;
+
+/*!
+ * \brief Rate-dematching index map. The key fields fully determine the bit selection and the bit deinterleaver.
+ */
+typedef struct {
+  /* Key */
+  uint32_t bg;        /*!< \brief Base graph. */
+  uint32_t ls;        /*!< \brief Lifting size. */
+  uint32_t mod_order; /*!< \brief Modulation order. */
+  uint32_t E;         /*!< \brief Rate-matched codeword length. */
+  uint32_t F;         /*!< \brief Number of filler bits. */
+  uint32_t k0;        /*!< \brief Starting position in the circular buffer. */
+  uint32_t Ncb;       /*!< \brief Size of the circular buffer. */
+
+  /* Maps */
+  uint32_t*    in_idx;   /*!< \brief Position in the received sequence of every soft bit, NULL if mod_order = 1. */
+  rm_rx_run_t* runs;     /*!< \brief Bit selection as contiguous runs. */
+  uint32_t     nof_runs; /*!< \brief Number of runs. */
+} rm_rx_map_t;
+
 /*!
  * Initialize rate-matching parameters
  */
@@ -501,7 +535,8 @@ int srsran_ldpc_rm_rx_init_c(srsran_ldpc_rm_t* p)
   if ((pp = malloc(sizeof(struct pRM_rx_c))) == NULL) {
     return -1;
   }
-  p->ptr = pp;
+  p->ptr   = pp;
+  p->cache = NULL;
 
   // allocate memory to the temporal buffer
   if ((pp->tmp_rm_symbol = srsran_vec_i8_malloc(MAXE)) == NULL) {
@@ -672,6 +707,286 @@ int srsran_ldpc_rm_rx_s(srsran_ldpc_rm_t*        q,
   return 0;
 }
 
+static void rm_rx_map_free(rm_rx_map_t* map)
+{
+  if (map->in_idx != NULL) {
+    free(map->in_idx);
+  }
+  if (map->runs != NULL) {
+    free(map->runs);
+  }
+  free(map);
+}
+
+/*!
+ * Computes the index map of the current rate dematcher configuration.
+ */
+static rm_rx_map_t* rm_rx_map_create(const srsran_ldpc_rm_t* q)
+{
+  rm_rx_map_t* map = calloc(1, sizeof(rm_rx_map_t));
+  if (map == NULL) {
+    return NULL;
+  }
+  map->bg        = q->bg;
+  map->ls        = q->ls;
+  map->mod_order = q->mod_order;
+  map->E         = q->E;
+  map->F         = q->F;
+  map->k0        = q->k0;
+  map->Ncb       = q->Ncb;
+
+  uint32_t end_exclude = q->K - 2 * q->ls;
+  uint32_t ini_exclude = end_exclude - q->F;
+
+  // There is one run per lap around the circular buffer, plus one for jumping over the filler bits
+  uint32_t max_runs = 2 * (q->E / (q->Ncb - q->F) + 2);
+  if ((map->runs = malloc(sizeof(rm_rx_run_t) * max_runs)) == NULL) {
+    rm_rx_map_free(map);
+    return NULL;
+  }
+
+  uint32_t k   = 0;
+  uint32_t pos = q->k0;
+  while (k < q->E && map->nof_runs < max_runs) {
+    // Jump over the filler bits
+    if (pos >= ini_exclude && pos < end_exclude) {
+      pos = (end_exclude < q->Ncb) ? end_exclude : 0;
+      continue;
+    }
+
+    uint32_t limit = (pos < ini_exclude) ? SRSRAN_MIN(ini_exclude, q->Ncb) : q->Ncb;
+    uint32_t len   = SRSRAN_MIN(limit - pos, q->E - k);
+
+    map->runs[map->nof_runs].k   = k;
+    map->runs[map->nof_runs].dst = pos;
+    map->runs[map->nof_runs].len = len;
+    map->nof_runs++;
+
+    k += len;
+    pos += len;
+    if (pos >= q->Ncb) {
+      pos = 0;
+    }
+  }
+
+  if (k < q->E) {
+    ERROR("Error computing the rate dematching runs (E=%d; Ncb=%d; F=%d)", q->E, q->Ncb, q->F);
+    rm_rx_map_free(map);
+    return NULL;
+  }
+
+  // Bit deinterleaver: the k-th soft bit (bit-selection order) is received at (k % cols) * rows + k / cols
+  if (q->mod_order > 1) {
+    if ((map->in_idx = srsran_vec_u32_malloc(q->E)) == NULL) {
+      rm_rx_map_free(map);
+      return NULL;
+    }
+    uint32_t rows = q->mod_order;
+    uint32_t cols = q->E / rows;
+    for (uint32_t i = 0; i < rows; i++) {
+      for (uint32_t j = 0; j < cols; j++) {
+        map->in_idx[i * cols + j] = j * rows + i;
+      }
+    }
+  }
+
+  return map;
+}
+
+static bool rm_rx_map_match(const rm_rx_map_t* map, const srsran_ldpc_rm_t* q)
+{
+  return map->bg == q->bg && map->ls == q->ls && map->mod_order == q->mod_order && map->E == q->E && map->F == q->F &&
+         map->k0 == q->k0 && map->Ncb == q->Ncb;
+}
+
+static uint32_t rm_rx_map_hash(const srsran_ldpc_rm_t* q)
+{
+  uint32_t h = 2166136261U;
+  uint32_t key[7] = {q->bg, q->ls, q->mod_order, q->E, q->F, q->k0, q->Ncb};
+  for (uint32_t i = 0; i < 7; i++) {
+    h = (h ^ key[i]) * 16777619U;
+  }
+  return h;
+}
+
+/*!
+ * Returns the index map for the current rate dematcher configuration, creating it if it is not in the cache. It
+ * returns NULL if the cache is full.
+ */
+static const rm_rx_map_t* rm_rx_cache_get(srsran_ldpc_rm_cache_t* cache, const srsran_ldpc_rm_t* q)
+{
+  uint32_t first = rm_rx_map_hash(q) % cache->nof_slots;
+
+  // Look up the map
+  pthread_mutex_lock(&cache->mutex);
+  for (uint32_t i = 0; i < cache->nof_slots; i++) {
+    rm_rx_map_t* map = cache->entries[(first + i) % cache->nof_slots];
+    if (map == NULL) {
+      break;
+    }
+    if (rm_rx_map_match(map, q)) {
+      pthread_mutex_unlock(&cache->mutex);
+      return map;
+    }
+  }
+  bool full = (cache->nof_entries >= cache->max_entries);
+  pthread_mutex_unlock(&cache->mutex);
+
+  if (full) {
+    return NULL;
+  }
+
+  // Compute the map without holding the lock
+  rm_rx_map_t* new_map = rm_rx_map_create(q);
+  if (new_map == NULL) {
+    return NULL;
+  }
+
+  // Insert it, unless another thread did it in the meantime
+  const rm_rx_map_t* ret = NULL;
+  pthread_mutex_lock(&cache->mutex);
+  for (uint32_t i = 0; i < cache->nof_slots; i++) {
+    void** slot = &cache->entries[(first + i) % cache->nof_slots];
+    if (*slot == NULL) {
+      if (cache->nof_entries < cache->max_entries) {
+        *slot = new_map;
+        cache->nof_entries++;
+        ret     = new_map;
+        new_map = NULL;
+      }
+      break;
+    }
+    if (rm_rx_map_match(*slot, q)) {
+      ret = *slot;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&cache->mutex);
+
+  if (new_map != NULL) {
+    rm_rx_map_free(new_map);
+  }
+
+  return ret;
+}
+
+int srsran_ldpc_rm_cache_init(srsran_ldpc_rm_cache_t* cache, uint32_t max_entries)
+{
+  if (cache == NULL || max_entries == 0) {
+    return -1;
+  }
+
+  // Keep the hash table at most half full
+  cache->nof_slots   = 2 * max_entries;
+  cache->nof_entries = 0;
+  cache->max_entries = max_entries;
+  if ((cache->entries = calloc(cache->nof_slots, sizeof(void*))) == NULL) {
+    return -1;
+  }
+
+  if (pthread_mutex_init(&cache->mutex, NULL)) {
+    free(cache->entries);
+    cache->entries = NULL;
+    return -1;
+  }
+
+  return 0;
+}
+
+void srsran_ldpc_rm_cache_free(srsran_ldpc_rm_cache_t* cache)
+{
+  if (cache == NULL || cache->entries == NULL) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < cache->nof_slots; i++) {
+    if (cache->entries[i] != NULL) {
+      rm_rx_map_free(cache->entries[i]);
+    }
+  }
+  free(cache->entries);
+  cache->entries = NULL;
+  pthread_mutex_destroy(&cache->mutex);
+}
+
+void srsran_ldpc_rm_rx_set_cache_c(srsran_ldpc_rm_t* q, srsran_ldpc_rm_cache_t* cache)
+{
+  if (q != NULL) {
+    q->cache = cache;
+  }
+}
+
+/*!
+ * Adds the soft bits to the circular buffer following an index map (int8_t). It gives the same result as the bit
+ * deinterleaver followed by bit_selection_rm_rx_c(), without the intermediate buffer.
+ */
+static void rm_rx_map_apply_c(const rm_rx_map_t* map, const int8_t* input, int8_t* output)
+{
+  const int8_t infinity7 = (1U << 6U) - 1;
+
+  for (uint32_t r = 0; r < map->nof_runs; r++) {
+    const rm_rx_run_t* run = &map->runs[r];
+    int8_t*            out = output + run->dst;
+    uint32_t           i   = 0;
+
+    if (map->in_idx == NULL) {
+      const int8_t* in = input + run->k;
+#ifdef LV_HAVE_AVX2
+      for (; i + 16 <= run->len; i += 16) {
+        __m128i o = _mm_adds_epi8(_mm_loadu_si128((__m128i*)(out + i)), _mm_loadu_si128((__m128i*)(in + i)));
+        o         = _mm_min_epi8(_mm_max_epi8(o, _mm_set1_epi8(-infinity7)), _mm_set1_epi8(infinity7));
+        _mm_storeu_si128((__m128i*)(out + i), o);
+      }
+#endif // LV_HAVE_AVX2
+      for (; i < run->len; i++) {
+        int16_t tmp = (int16_t)out[i] + in[i];
+        out[i]      = (int8_t)SRSRAN_MAX(SRSRAN_MIN(tmp, infinity7), -infinity7);
+      }
+      continue;
+    }
+
+    const uint32_t* idx = map->in_idx + run->k;
+    // The gathers read 32-bit words: the last three soft bits are read from the word ending at the last one
+#ifdef LV_HAVE_AVX512
+    if (map->E >= 4) {
+      __m512i last = _mm512_set1_epi32((int)map->E - 4);
+      for (; i + 16 <= run->len; i += 16) {
+        __m512i pos   = _mm512_loadu_si512((const void*)(idx + i));
+        __m512i word  = _mm512_min_epu32(pos, last);
+        __m512i shift = _mm512_slli_epi32(_mm512_sub_epi32(pos, word), 3);
+        __m512i v     = _mm512_srlv_epi32(_mm512_i32gather_epi32(word, (const void*)input, 1), shift);
+        __m128i o     = _mm_adds_epi8(_mm_loadu_si128((__m128i*)(out + i)), _mm512_cvtepi32_epi8(v));
+        o             = _mm_min_epi8(_mm_max_epi8(o, _mm_set1_epi8(-infinity7)), _mm_set1_epi8(infinity7));
+        _mm_storeu_si128((__m128i*)(out + i), o);
+      }
+    }
+#endif // LV_HAVE_AVX512
+#ifdef LV_HAVE_AVX2
+    if (map->E >= 4) {
+      __m256i last  = _mm256_set1_epi32((int)map->E - 4);
+      __m256i bytes = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // Lane 0
+                                       0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1  // Lane 1
+      );
+      __m256i lanes = _mm256_setr_epi32(0, 4, 1, 1, 1, 1, 1, 1);
+      for (; i + 8 <= run->len; i += 8) {
+        __m256i pos   = _mm256_loadu_si256((const __m256i*)(idx + i));
+        __m256i word  = _mm256_min_epu32(pos, last);
+        __m256i shift = _mm256_slli_epi32(_mm256_sub_epi32(pos, word), 3);
+        __m256i v     = _mm256_srlv_epi32(_mm256_i32gather_epi32((const int*)input, word, 1), shift);
+        v             = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(v, bytes), lanes);
+        __m128i o     = _mm_adds_epi8(_mm_loadl_epi64((__m128i*)(out + i)), _mm256_castsi256_si128(v));
+        o             = _mm_min_epi8(_mm_max_epi8(o, _mm_set1_epi8(-infinity7)), _mm_set1_epi8(infinity7));
+        _mm_storel_epi64((__m128i*)(out + i), o);
+      }
+    }
+#endif // LV_HAVE_AVX2
+    for (; i < run->len; i++) {
+      int16_t tmp = (int16_t)out[i] + input[idx[i]];
+      out[i]      = (int8_t)SRSRAN_MAX(SRSRAN_MIN(tmp, infinity7), -infinity7);
+    }
+  }
+}
+
 int srsran_ldpc_rm_rx_c(srsran_ldpc_rm_t*        q,
                         const int8_t*            input,
                         int8_t*                  output,
@@ -694,7 +1009,16 @@ int srsran_ldpc_rm_rx_c(srsran_ldpc_rm_t*        q,
   uint32_t         end_exclude   = q->K - 2 * q->ls;
   uint32_t         ini_exclude   = end_exclude - q->F;
 
-  if (q->mod_order == 1) { // interleaver can be skipped
+  // Use the cached index map if available
+  const rm_rx_map_t* map = (q->cache != NULL) ? rm_rx_cache_get(q->cache, q) : NULL;
+  if (map != NULL) {
+    // set filler bits to INFINITY
+    const int8_t infinity8 = (1U << 7U) - 1;
+    for (uint32_t i = ini_exclude; i < end_exclude; i++) {
+      output[i] = infinity8;
+    }
+    rm_rx_map_apply_c(map, input, output);
+  } else if (q->mod_order == 1) { // interleaver can be skipped
     bit_selection_rm_rx_c(input, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
   } else {
     bit_interleaver_rm_rx_c(input, tmp_rm_symbol, q->E, q->mod_order);
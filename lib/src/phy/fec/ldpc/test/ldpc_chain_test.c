@@ -47,6 +47,9 @@
  *  - **-B \<number\>** Number of codewords in a batch.(Default 100).
  *  - **-N \<number\>** Max number of simulated batches.(Default 10000).
  *  - **-E \<number\>** Minimum number of errors for a significant simulation.(Default 100).
+ *  - **-O** Use the offset min-sum algorithm in the 8-bit decoders.
+ *  - **-o \<number\>** Offset of the offset min-sum algorithm (Default 0, calibrated value).
+ *  - **-T** Enable syndrome-based early termination.
  */
 
 #include <math.h>
@@ -73,6 +76,10 @@ static float              snr = 0;          /*!< \brief Signal-to-Noise Ratio [d
 static int batch_size  = 100;   /*!< \brief Number of codewords in a batch. */
 static int max_n_batch = 10000; /*!< \brief Max number of simulated batches. */
 static int req_errors  = 100;   /*!< \brief Minimum number of errors for a significant simulation. */
+
+static bool  offset_ms  = false; /*!< \brief Use the offset min-sum algorithm in the 8-bit decoders. */
+static float ms_offset  = 0;     /*!< \brief Offset of the offset min-sum algorithm, 0 for the calibrated value. */
+static bool  early_stop = false; /*!< \brief Syndrome-based early termination. */
 #define MS_SF 0.75f             /*!< \brief Scaling factor for the normalized min-sum decoding algorithm. */
 
 /*!
@@ -80,7 +87,7 @@ static int req_errors  = 100;   /*!< \brief Minimum number of errors for a signi
  */
 void usage(char* prog)
 {
-  printf("Usage: %s [-bX] [-lX] [-eX] [-sX] [-BX]\n", prog);
+  printf("Usage: %s [-bX] [-lX] [-eX] [-sX] [-BX] [-O] [-oX] [-T]\n", prog);
   printf("\t-b Base Graph [(1 or 2) Default %d]\n", base_graph + 1);
   printf("\t-l Lifting Size [Default %d]\n", lift_size);
   printf("\t-e Word length after rate matching [Default %d (no rate matching, only filler-bits are extracted)]\n",
@@ -88,6 +95,9 @@ void usage(char* prog)
   printf("\t-B Number of codewords in a batch. [Default %d]\n", batch_size);
   printf("\t-N Max number of simulated batches. [Default %d]\n", max_n_batch);
   printf("\t-E Minimum number of errors for a significant simulation. [Default %d]\n", req_errors);
+  printf("\t-O Use the offset min-sum algorithm in the 8-bit decoders. [Default %s]\n", offset_ms ? "true" : "false");
+  printf("\t-o Offset of the offset min-sum algorithm. [Default %.1f (calibrated value)]\n", ms_offset);
+  printf("\t-T Enable syndrome-based early termination. [Default %s]\n", early_stop ? "true" : "false");
 }
 
 /*!
@@ -96,7 +106,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt = 0;
-  while ((opt = getopt(argc, argv, "b:l:e:s:B:N:E:")) != -1) {
+  while ((opt = getopt(argc, argv, "b:l:e:s:B:N:E:Oo:T")) != -1) {
     switch (opt) {
       case 'b':
         base_graph = (int)strtol(optarg, NULL, 10) - 1;
@@ -119,6 +129,15 @@ void parse_args(int argc, char** argv)
       case 'E':
         req_errors = (int)strtol(optarg, NULL, 10);
         break;
+      case 'O':
+        offset_ms = true;
+        break;
+      case 'o':
+        ms_offset = (float)strtod(optarg, NULL);
+        break;
+      case 'T':
+        early_stop = true;
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -182,6 +201,7 @@ int main(int argc, char** argv)
   decoder_args.bg                         = base_graph;
   decoder_args.ls                         = lift_size;
   decoder_args.scaling_fctr               = MS_SF;
+  decoder_args.early_stop                 = early_stop;
 
   // create an LDPC decoder (float)
   srsran_ldpc_decoder_t decoder_f;
@@ -197,6 +217,12 @@ int main(int argc, char** argv)
     perror("decoder init");
     exit(-1);
   }
+  // the float and 16-bit decoders always use the normalized min-sum algorithm
+  if (offset_ms) {
+    decoder_args.ms_type = SRSRAN_LDPC_DECODER_MS_OFFSET;
+    decoder_args.offset  = ms_offset;
+  }
+
   // create an LDPC decoder (8 bit)
   srsran_ldpc_decoder_t decoder_c;
   decoder_args.type = SRSRAN_LDPC_DECODER_C;
@@ -274,6 +300,10 @@ int main(int argc, char** argv)
          rm_length,
          1.0 * (encoder.liftK - F) / rm_length);
   printf("\n  Signal-to-Noise Ratio -> %.2f dB\n", snr);
+  if (offset_ms) {
+    printf("  Min-sum offset (8 bits) -> %.1f\n", decoder_c.offset);
+  }
+  printf("  Early termination -> %s\n", early_stop ? "yes" : "no");
 
   messages_true             = srsran_vec_u8_malloc(finalK * batch_size);
   messages_sim_f            = srsran_vec_u8_malloc(finalK * batch_size);
@@ -183,6 +183,19 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
+  // create a LDPC rate DeMatcher (int8_t) with an index map cache
+  srsran_ldpc_rm_cache_t rm_cache;
+  if (srsran_ldpc_rm_cache_init(&rm_cache, 4) != 0) {
+    perror("rate dematcher cache init");
+    exit(-1);
+  }
+  srsran_ldpc_rm_t rm_rx_c_cached;
+  if (srsran_ldpc_rm_rx_init_c(&rm_rx_c_cached) != 0) {
+    perror("rate dematcher init (int8_t, cached)");
+    exit(-1);
+  }
+  srsran_ldpc_rm_rx_set_cache_c(&rm_rx_c_cached, &rm_cache);
+
   printf("Test LDPC chain:\n");
   printf("  Base Graph      -> BG%d\n", encoder.bg + 1);
   printf("  Lifting Size    -> %d\n", encoder.ls);
@@ -210,8 +223,9 @@ int main(int argc, char** argv)
   unrm_symbols   = srsran_vec_f_malloc(C * N);
   unrm_symbols_s = srsran_vec_i16_malloc(C * N);
   unrm_symbols_c = srsran_vec_i8_malloc(C * N);
+  int8_t* unrm_symbols_c_cached = srsran_vec_i8_malloc(N);
   if (!codeblocks || !codewords || !rm_codewords || !rm_symbols || !rm_symbols_s || !rm_symbols_c || !unrm_symbols ||
-      !unrm_symbols_s || !unrm_symbols_c) {
+      !unrm_symbols_s || !unrm_symbols_c || !unrm_symbols_c_cached) {
     perror("malloc");
     exit(-1);
   }
@@ -336,11 +350,37 @@ int main(int argc, char** argv)
       printf(" No errors in rate-matching block: (int8_t)\n");
     }
 
+    // check the cached index maps against the int8_t implementation, twice for using the map once it is cached
+    for (uint32_t n = 0; n < 2; n++) {
+      bzero(unrm_symbols_c_cached, N * sizeof(int8_t));
+      if (srsran_ldpc_rm_rx_c(&rm_rx_c_cached,
+                              rm_symbols_c + r * E,
+                              unrm_symbols_c_cached,
+                              E,
+                              F,
+                              base_graph,
+                              lift_size,
+                              rv,
+                              mod_type,
+                              Nref) < 0) {
+        exit(-1);
+      }
+      if (memcmp(unrm_symbols_c_cached, unrm_symbols_c + r * N, N) != 0) {
+        error = -4;
+      }
+    }
+    if (error == -4) {
+      printf("Error in rate-matching block (int8_t, cached) at code segment: %d\n", r);
+    } else {
+      printf(" No errors in rate-matching block: (int8_t, cached)\n");
+    }
+
   } // codeblocks r
 
   free(unrm_symbols);
   free(unrm_symbols_s);
   free(unrm_symbols_c);
+  free(unrm_symbols_c_cached);
   free(rm_symbols);
   free(rm_symbols_s);
   free(rm_symbols_c);
@@ -353,5 +393,7 @@ int main(int argc, char** argv)
   srsran_ldpc_rm_rx_free_f(&rm_rx);
   srsran_ldpc_rm_rx_free_s(&rm_rx_s);
   srsran_ldpc_rm_rx_free_c(&rm_rx_c);
+  srsran_ldpc_rm_rx_free_c(&rm_rx_c_cached);
+  srsran_ldpc_rm_cache_free(&rm_cache);
   return error;
 }
@@ -215,6 +215,11 @@ int srsran_polar_code_init(srsran_polar_code_t* c)
     exit(-1);
   }
 
+  // No sets yet
+  c->K    = 0;
+  c->E    = 0;
+  c->nMax = 0;
+
   return 0;
 }
 
@@ -223,6 +228,13 @@ int srsran_polar_code_get(srsran_polar_code_t* c, uint16_t K, uint16_t E, uint8_
   if (c == NULL) {
     return -1;
   }
+
+  // The sets of the previous call are still valid
+  if (c->E != 0 && c->K == K && c->E == E && c->nMax == nMax) {
+    return 0;
+  }
+  c->E = 0;
+
   // check polar code parameters
   if (get_code_params(c, K, E, nMax) == -1) {
     return -1;
@@ -308,5 +320,8 @@ int srsran_polar_code_get(srsran_polar_code_t* c, uint16_t K, uint16_t E, uint8_
   c->K_set[c->K + c->nPC] = 1024;
   c->PC_set[c->nPC]       = 1024;
 
+  c->E    = E;
+  c->nMax = nMax;
+
   return 0;
 }
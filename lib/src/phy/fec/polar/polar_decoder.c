@@ -37,6 +37,7 @@
 #include <math.h>
 #include <string.h>
 
+#include "polar_decoder_scl_c.h"
 #include "polar_decoder_ssc_c.h"
 #include "polar_decoder_ssc_c_avx2.h"
 #include "polar_decoder_ssc_f.h"
@@ -114,6 +115,49 @@ static int decode_ssc_c_avx2(void*           o,
 }
 #endif // LV_HAVE_AVX2
 
+/*! SCL Polar decoder with int8_t LLR inputs, several codewords with the same frozen set. */
+static int decode_list_scl_c(void*                o,
+                             const int8_t* const* symbols,
+                             uint8_t* const*      data,
+                             const uint32_t       nof_codewords,
+                             const uint8_t        n,
+                             const uint16_t*      frozen_set,
+                             const uint16_t       frozen_set_size)
+{
+  srsran_polar_decoder_t* q              = o;
+  int                     nof_candidates = 0;
+
+  if (init_polar_decoder_scl_c(q->ptr, n, frozen_set, frozen_set_size) < 0) {
+    return -1;
+  }
+
+  for (uint32_t i = 0; i < nof_codewords; i++) {
+    nof_candidates = polar_decoder_scl_c(q->ptr, symbols[i], data[i], q->list_size);
+    if (nof_candidates < 0) {
+      return -1;
+    }
+  }
+
+  return nof_candidates;
+}
+
+/*! SCL Polar decoder with int8_t LLR inputs, only the most likely candidate is returned. */
+static int decode_scl_c(void*           o,
+                        const int8_t*   symbols,
+                        uint8_t*        data,
+                        const uint8_t   n,
+                        const uint16_t* frozen_set,
+                        const uint16_t  frozen_set_size)
+{
+  srsran_polar_decoder_t* q = o;
+
+  if (init_polar_decoder_scl_c(q->ptr, n, frozen_set, frozen_set_size) < 0) {
+    return -1;
+  }
+
+  return (polar_decoder_scl_c(q->ptr, symbols, data, 1) < 0) ? -1 : 0;
+}
+
 /*! Destructor of a (float) SSC polar decoder. */
 static void free_ssc_f(void* o)
 {
@@ -144,6 +188,13 @@ static void free_ssc_c_avx2(void* o)
 }
 #endif
 
+/*! Destructor of a (int8_t) SCL polar decoder. */
+static void free_scl_c(void* o)
+{
+  srsran_polar_decoder_t* q = o;
+  delete_polar_decoder_scl_c(q->ptr);
+}
+
 /*! Initializes a polar decoder structure to use the SSC polar decoder algorithm with float LLR inputs. */
 static int init_ssc_f(srsran_polar_decoder_t* q)
 {
@@ -203,9 +254,64 @@ static int init_ssc_c_avx2(srsran_polar_decoder_t* q)
 }
 #endif
 
+/*! Initializes a polar decoder structure to use the SCL polar decoder algorithm with uint8_t LLR inputs. */
+static int init_scl_c(srsran_polar_decoder_t* q)
+{
+  q->decode_c      = decode_scl_c;
+  q->decode_list_c = decode_list_scl_c;
+  q->free          = free_scl_c;
+
+  if ((q->ptr = create_polar_decoder_scl_c(q->nMax, q->list_size)) == NULL) {
+    ERROR("create_polar_decoder_scl_c failed");
+    return -1;
+  }
+  return 0;
+}
+
+#ifdef LV_HAVE_AVX2
+/*! Initializes a polar decoder structure to use the SCL polar decoder algorithm with uint8_t LLR inputs and AVX2
+ * instructions. */
+static int init_scl_c_avx2(srsran_polar_decoder_t* q)
+{
+  q->decode_c      = decode_scl_c;
+  q->decode_list_c = decode_list_scl_c;
+  q->free          = free_scl_c;
+
+  if ((q->ptr = create_polar_decoder_scl_c_avx2(q->nMax, q->list_size)) == NULL) {
+    ERROR("create_polar_decoder_scl_c_avx2 failed");
+    return -1;
+  }
+  return 0;
+}
+#endif
+
 int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_type_t type, const uint8_t nMax)
 {
-  q->nMax = nMax;
+  uint8_t list_size = 1;
+  if (type == SRSRAN_POLAR_DECODER_SCL_C || type == SRSRAN_POLAR_DECODER_SCL_C_AVX2) {
+    list_size = SRSRAN_POLAR_DECODER_LIST_SIZE_DEFAULT;
+  }
+  return srsran_polar_decoder_init_list(q, type, nMax, list_size);
+}
+
+int srsran_polar_decoder_init_list(srsran_polar_decoder_t*     q,
+                                   srsran_polar_decoder_type_t type,
+                                   const uint8_t               nMax,
+                                   const uint8_t               list_size)
+{
+  if (q == NULL) {
+    return -1;
+  }
+  memset(q, 0, sizeof(srsran_polar_decoder_t));
+
+  if (list_size < 1 || list_size > SRSRAN_POLAR_DECODER_LIST_SIZE_MAX ||
+      (list_size > 1 && type != SRSRAN_POLAR_DECODER_SCL_C && type != SRSRAN_POLAR_DECODER_SCL_C_AVX2)) {
+    ERROR("Invalid list size %d for decoder type %d", list_size, type);
+    return -1;
+  }
+
+  q->nMax      = nMax;
+  q->list_size = list_size;
   switch (type) {
     case SRSRAN_POLAR_DECODER_SSC_F:
       return init_ssc_f(q);
@@ -216,6 +322,12 @@ int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_ty
 #ifdef LV_HAVE_AVX2
     case SRSRAN_POLAR_DECODER_SSC_C_AVX2:
       return init_ssc_c_avx2(q);
+#endif
+    case SRSRAN_POLAR_DECODER_SCL_C:
+      return init_scl_c(q);
+#ifdef LV_HAVE_AVX2
+    case SRSRAN_POLAR_DECODER_SCL_C_AVX2:
+      return init_scl_c_avx2(q);
 #endif
     default:
       ERROR("Decoder not implemented");
@@ -273,3 +385,39 @@ int srsran_polar_decoder_decode_c(srsran_polar_decoder_t* q,
 
   return -1;
 }
+
+int srsran_polar_decoder_decode_list_c(srsran_polar_decoder_t* q,
+                                       const int8_t*           llr,
+                                       uint8_t*                data_decoded,
+                                       const uint8_t           n,
+                                       const uint16_t*         frozen_set,
+                                       const uint16_t          frozen_set_size)
+{
+  return srsran_polar_decoder_decode_list_batch_c(q, &llr, &data_decoded, 1, n, frozen_set, frozen_set_size);
+}
+
+int srsran_polar_decoder_decode_list_batch_c(srsran_polar_decoder_t* q,
+                                             const int8_t* const*    llr,
+                                             uint8_t* const*         data_decoded,
+                                             const uint32_t          nof_codewords,
+                                             const uint8_t           n,
+                                             const uint16_t*         frozen_set,
+                                             const uint16_t          frozen_set_size)
+{
+  if (q->nMax < n) {
+    return -1;
+  }
+
+  if (q->decode_list_c != NULL) {
+    return q->decode_list_c(q, llr, data_decoded, nof_codewords, n, frozen_set, frozen_set_size);
+  }
+
+  // Decoders without list provide a single candidate
+  for (uint32_t i = 0; i < nof_codewords; i++) {
+    if (q->decode_c(q, llr[i], data_decoded[i], n, frozen_set, frozen_set_size) < 0) {
+      return -1;
+    }
+  }
+
+  return 1;
+}
@@ -0,0 +1,577 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_scl_c.c
+ * \brief Definition of the Successive Cancellation List (SCL) polar decoder inner functions working with
+ * 8-bit integer-valued LLRs.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ * The decoder follows the LLR-based SCL algorithm with the min-sum approximation of the path metric. All paths walk
+ * the decoding tree in lockstep. Every stage keeps, for each path, an index to one of \a list_size buffers of LLRs and
+ * of partial sums. Cloning a path only copies these indexes; the buffers are never copied. Since all the LLRs (or
+ * partial sums) of a stage are rewritten at once, paths pointing to the same source buffers share the result.
+ *
+ * Subtrees with only frozen bits (::RATE_0 nodes) are not traversed: their contribution to the path metric is
+ * accumulated directly from the node LLRs.
+ *
+ */
+
+#include "polar_decoder_scl_c.h"
+#include "../utils_avx2.h"
+#include "polar_decoder_vector.h"
+#include "polar_decoder_vector_avx2.h"
+#include "srsran/phy/fec/polar/polar_decoder.h"
+#include "srsran/phy/utils/vector.h"
+
+/*!
+ * \brief Maximum supported \f$log_2\f$ of the code size.
+ */
+#define SCL_NMAX_LOG 10
+
+/*!
+ * \brief Number of 64-bit words to store the decisions of all the bits of a path.
+ */
+#define SCL_HIST_WORDS ((1U << SCL_NMAX_LOG) / 64)
+
+/*!
+ * \brief Maximum magnitude of the LLRs at the root of the decoding tree. Function g doubles the LLR magnitude at every
+ * stage and a saturated LLR biases the path metrics, the input LLRs are scaled down to leave some headroom.
+ */
+#define SCL_LLR_ROOT_MAX 8
+
+/*!
+ * \brief Describes an SCL polar decoder (8-bit version).
+ */
+struct pSCL_c {
+  uint8_t  nMax;                   /*!< \brief \f$log_2\f$ of the maximum code size. */
+  uint8_t  code_size_log;          /*!< \brief \f$log_2\f$ of the current code size. */
+  uint8_t  list_size;              /*!< \brief Maximum number of paths. */
+  uint8_t  nof_paths;              /*!< \brief Current number of paths. */
+  uint8_t  bit_one;                /*!< \brief Value of a bit 1 as understood by function g. */
+  uint16_t nof_info;               /*!< \brief Number of information bits decided so far. */
+  uint16_t stride[SCL_NMAX_LOG + 1]; /*!< \brief Size of the buffers at each stage (at least a SIMD register). */
+
+  int8_t*  llr_in;                   /*!< \brief Padded copy of the codeword LLRs (root node). */
+  int8_t*  llr[SCL_NMAX_LOG];        /*!< \brief LLR buffers at each stage below the root. */
+  uint8_t* beta[2][SCL_NMAX_LOG + 1]; /*!< \brief Partial sums of the left (0) and right (1) child nodes. */
+  uint8_t* node_type[SCL_NMAX_LOG + 1]; /*!< \brief Node type at all stages, see compute_node_type(). */
+  void*    tmp_node_type;               /*!< \brief Pointer to a Tmp_node_type. */
+
+  uint8_t  llr_idx[SCL_NMAX_LOG + 1][SRSRAN_POLAR_DECODER_LIST_SIZE_MAX];     /*!< \brief LLR buffer of each path. */
+  uint8_t  beta_idx[2][SCL_NMAX_LOG + 1][SRSRAN_POLAR_DECODER_LIST_SIZE_MAX]; /*!< \brief Partial sums of each path. */
+  uint32_t pm[SRSRAN_POLAR_DECODER_LIST_SIZE_MAX];                            /*!< \brief Path metrics. */
+  uint64_t hist[SRSRAN_POLAR_DECODER_LIST_SIZE_MAX][SCL_HIST_WORDS];          /*!< \brief Information bit decisions. */
+
+  void (*f)(const int8_t* x, const int8_t* y, int8_t* z, const uint16_t len); /*!< \brief Pointer to the function-f. */
+  void (*g)(const uint8_t* b,
+            const int8_t*  x,
+            const int8_t*  y,
+            int8_t*        z,
+            const uint16_t len); /*!< \brief Pointer to the function-g. */
+  void (*xor)(const uint8_t* x,
+              const uint8_t* y,
+              uint8_t*       z,
+              const uint32_t len); /*!< \brief Pointer to the function-xor. */
+};
+
+/*!
+ * Returns the LLRs of path \a l at stage \a s.
+ */
+static inline int8_t* scl_llr(struct pSCL_c* pp, uint8_t s, uint8_t l)
+{
+  if (s == pp->code_size_log) {
+    return pp->llr_in;
+  }
+  return pp->llr[s] + pp->llr_idx[s][l] * pp->stride[s];
+}
+
+/*!
+ * Returns the partial sums of path \a l at stage \a s for the child node \a c (0 for left, 1 for right).
+ */
+static inline uint8_t* scl_beta(struct pSCL_c* pp, uint8_t c, uint8_t s, uint8_t l)
+{
+  return pp->beta[c][s] + pp->beta_idx[c][s][l] * pp->stride[s];
+}
+
+/*!
+ * Groups the paths with the same pair of buffer indexes \a key_a and \a key_b (which may be NULL). Writes the group of
+ * every path in \a group and the first path of every group in \a leader.
+ * \return The number of groups.
+ */
+static uint8_t
+scl_group(uint8_t nof_paths, const uint8_t* key_a, const uint8_t* key_b, uint8_t* group, uint8_t* leader)
+{
+  // Buffer indexes are lower than the list size, a look-up table maps every pair of keys to its group
+  uint8_t map[SRSRAN_POLAR_DECODER_LIST_SIZE_MAX * SRSRAN_POLAR_DECODER_LIST_SIZE_MAX];
+  memset(map, 0xff, sizeof(map));
+
+  uint8_t nof_groups = 0;
+  for (uint8_t l = 0; l < nof_paths; l++) {
+    uint8_t a   = (key_a == NULL) ? 0 : key_a[l];
+    uint8_t b   = (key_b == NULL) ? 0 : key_b[l];
+    uint8_t key = a * SRSRAN_POLAR_DECODER_LIST_SIZE_MAX + b;
+    if (map[key] == 0xff) {
+      map[key]           = nof_groups;
+      leader[nof_groups] = l;
+      nof_groups++;
+    }
+    group[l] = map[key];
+  }
+  return nof_groups;
+}
+
+/*!
+ * Path metric penalty of deciding all-zero bits given the node LLRs.
+ */
+static inline uint32_t scl_rate_0_penalty(const int8_t* llr, uint16_t len)
+{
+  uint32_t penalty = 0;
+  for (uint16_t i = 0; i < len; i++) {
+    if (llr[i] < 0) {
+      penalty += (uint32_t)(-llr[i]);
+    }
+  }
+  return penalty;
+}
+
+/*!
+ * Copies the input LLRs into \a llr_out, scaled down by a power of two until the magnitude does not exceed
+ * ::SCL_LLR_ROOT_MAX.
+ */
+static void scl_scale_input(const int8_t* llr, int8_t* llr_out, uint16_t len)
+{
+  int max_abs = 0;
+  for (uint16_t i = 0; i < len; i++) {
+    max_abs = SRSRAN_MAX(max_abs, abs(llr[i]));
+  }
+
+  int shift = 0;
+  while ((max_abs >> shift) > SCL_LLR_ROOT_MAX) {
+    shift++;
+  }
+
+  for (uint16_t i = 0; i < len; i++) {
+    llr_out[i] = (int8_t)(llr[i] >> shift);
+  }
+}
+
+/*!
+ * Copies path \a src into path \a dst, except for the path metric.
+ */
+static void scl_clone_path(struct pSCL_c* pp, uint8_t src, uint8_t dst)
+{
+  for (uint8_t s = 0; s <= pp->code_size_log; s++) {
+    pp->llr_idx[s][dst]     = pp->llr_idx[s][src];
+    pp->beta_idx[0][s][dst] = pp->beta_idx[0][s][src];
+    pp->beta_idx[1][s][dst] = pp->beta_idx[1][s][src];
+  }
+  memcpy(pp->hist[dst], pp->hist[src], ((pp->nof_info / 64) + 1) * sizeof(uint64_t));
+}
+
+/*!
+ * Stores the decision \a bit of the current information bit in path \a l.
+ */
+static inline void scl_set_bit(struct pSCL_c* pp, uint8_t l, uint8_t bit)
+{
+  uint64_t mask = 1ULL << (pp->nof_info % 64U);
+  if (bit) {
+    pp->hist[l][pp->nof_info / 64] |= mask;
+  } else {
+    pp->hist[l][pp->nof_info / 64] &= ~mask;
+  }
+}
+
+/*!
+ * ::RATE_0 node at stage \a s: all bits are zero, the path metrics get the penalty of the node LLRs.
+ */
+static void scl_rate_0_node(struct pSCL_c* pp, uint8_t s, uint16_t node)
+{
+  uint8_t  group[SRSRAN_POLAR_DECODER_LIST_SIZE_MAX];
+  uint8_t  leader[SRSRAN_POLAR_DECODER_LIST_SIZE_MAX];
+  uint32_t penalty[SRSRAN_POLAR_DECODER_LIST_SIZE_MAX];
+  uint16_t len = 1U << s;
+
+  uint8_t nof_groups = scl_group(pp->nof_paths, (s < pp->code_size_log) ? pp->llr_idx[s] : NULL, NULL, group, leader);
+  for (uint8_t i = 0; i < nof_groups; i++) {
+    penalty[i] = scl_rate_0_penalty(scl_llr(pp, s, leader[i]), len);
+  }
+
+  uint8_t c = node & 1U;
+  memset(pp->beta[c][s], 0, len);
+  for (uint8_t l = 0; l < pp->nof_paths; l++) {
+    pp->pm[l] += penalty[group[l]];
+    pp->beta_idx[c][s][l] = 0;
+  }
+}
+
+/*!
+ * Information bit leaf: every path is split in the two possible decisions and only the \a list_size most likely
+ * survive.
+ */
+static void scl_info_leaf(struct pSCL_c* pp, uint16_t node)
+{
+  uint8_t  nof_paths = pp->nof_paths;
+  uint8_t  hard[SRSRAN_POLAR_DECODER_LIST_SIZE_MAX];
+  uint32_t penalty[SRSRAN_POLAR_DECODER_LIST_SIZE_MAX];
+  uint8_t  keep[SRSRAN_POLAR_DECODER_LIST_SIZE_MAX] = {}; // bit 0: hard decision, bit 1: flipped decision
+  uint8_t  bit[SRSRAN_POLAR_DECODER_LIST_SIZE_MAX];
+
+  for (uint8_t l = 0; l < nof_paths; l++) {
+    int8_t llr = *scl_llr(pp, 0, l);
+    hard[l]    = (llr < 0) ? 1 : 0;
+    penalty[l] = (llr < 0) ? (uint32_t)(-llr) : (uint32_t)llr;
+  }
+
+  uint8_t nof_new_paths = 0;
+  if (2 * nof_paths <= pp->list_size) {
+    // All the candidates survive, the flipped decisions go to new paths
+    for (uint8_t l = 0; l < nof_paths; l++) {
+      uint8_t dst = nof_paths + l;
+      scl_clone_path(pp, l, dst);
+      pp->pm[dst] = pp->pm[l] + penalty[l];
+      bit[dst]    = hard[l] ^ 1U;
+      bit[l]      = hard[l];
+    }
+    nof_new_paths = 2 * nof_paths;
+  } else {
+    // Sort the 2 x nof_paths candidates by path metric, the hard decisions come first for stability
+    uint8_t  order[2 * SRSRAN_POLAR_DECODER_LIST_SIZE_MAX];
+    uint32_t metric[2 * SRSRAN_POLAR_DECODER_LIST_SIZE_MAX];
+    uint8_t  nof_candidates = 2 * nof_paths;
+    for (uint8_t i = 0; i < nof_candidates; i++) {
+      uint8_t l   = i % nof_paths;
+      uint8_t b   = i / nof_paths;
+      metric[i]   = pp->pm[l] + (b ? penalty[l] : 0);
+      uint8_t pos = i;
+      while (pos > 0 && metric[order[pos - 1]] > metric[i]) {
+        order[pos] = order[pos - 1];
+        pos--;
+      }
+      order[pos] = i;
+    }
+    for (uint8_t i = 0; i < pp->list_size; i++) {
+      keep[order[i] % nof_paths] |= 1U << (order[i] / nof_paths);
+    }
+
+    // Paths without surviving candidates make room for the paths with two
+    uint8_t free_paths[SRSRAN_POLAR_DECODER_LIST_SIZE_MAX];
+    uint8_t nof_free = 0;
+    for (uint8_t l = 0; l < nof_paths; l++) {
+      if (keep[l] == 0) {
+        free_paths[nof_free++] = l;
+      }
+    }
+    nof_new_paths = nof_paths;
+    for (uint8_t l = 0; l < nof_paths; l++) {
+      if (keep[l] == 3) {
+        uint8_t dst = (nof_free > 0) ? free_paths[--nof_free] : nof_new_paths++;
+        scl_clone_path(pp, l, dst);
+        pp->pm[dst] = pp->pm[l] + penalty[l];
+        bit[dst]    = hard[l] ^ 1U;
+        bit[l]      = hard[l];
+      } else if (keep[l] == 1) {
+        bit[l] = hard[l];
+      } else if (keep[l] == 2) {
+        pp->pm[l] += penalty[l];
+        bit[l] = hard[l] ^ 1U;
+      }
+    }
+  }
+  pp->nof_paths = nof_new_paths;
+
+  // Store decisions and partial sums, there are only two possible buffers
+  uint8_t c                = node & 1U;
+  pp->beta[c][0][0]        = 0;
+  pp->beta[c][0][pp->stride[0]] = pp->bit_one;
+  for (uint8_t l = 0; l < nof_new_paths; l++) {
+    scl_set_bit(pp, l, bit[l]);
+    pp->beta_idx[c][0][l] = bit[l];
+  }
+  pp->nof_info++;
+}
+
+/*!
+ * Decodes the node \a node at stage \a s for all the paths. The resultant partial sums are stored in the left or right
+ * child buffers of stage \a s, according to the node position.
+ */
+static void scl_node(struct pSCL_c* pp, uint8_t s, uint16_t node)
+{
+  uint8_t type = pp->node_type[s][node];
+
+  if (type == RATE_0) {
+    scl_rate_0_node(pp, s, node);
+    return;
+  }
+
+  if (s == 0) {
+    scl_info_leaf(pp, node);
+    return;
+  }
+
+  uint8_t        group[SRSRAN_POLAR_DECODER_LIST_SIZE_MAX];
+  uint8_t        leader[SRSRAN_POLAR_DECODER_LIST_SIZE_MAX];
+  uint8_t        nof_groups = 0;
+  uint16_t       half       = 1U << (s - 1);
+  const uint8_t* llr_key    = (s < pp->code_size_log) ? pp->llr_idx[s] : NULL;
+
+  // Left child (function f)
+  nof_groups = scl_group(pp->nof_paths, llr_key, NULL, group, leader);
+  for (uint8_t i = 0; i < nof_groups; i++) {
+    int8_t* llr = scl_llr(pp, s, leader[i]);
+    pp->f(llr, llr + half, pp->llr[s - 1] + i * pp->stride[s - 1], half);
+  }
+  memcpy(pp->llr_idx[s - 1], group, pp->nof_paths);
+
+  scl_node(pp, s - 1, 2 * node);
+
+  // Right child (function g), paths might have been cloned by the left child
+  llr_key    = (s < pp->code_size_log) ? pp->llr_idx[s] : NULL;
+  nof_groups = scl_group(pp->nof_paths, llr_key, pp->beta_idx[0][s - 1], group, leader);
+  for (uint8_t i = 0; i < nof_groups; i++) {
+    int8_t* llr = scl_llr(pp, s, leader[i]);
+    pp->g(scl_beta(pp, 0, s - 1, leader[i]), llr, llr + half, pp->llr[s - 1] + i * pp->stride[s - 1], half);
+  }
+  memcpy(pp->llr_idx[s - 1], group, pp->nof_paths);
+
+  scl_node(pp, s - 1, 2 * node + 1);
+
+  // Partial sums of this node
+  uint8_t c  = node & 1U;
+  nof_groups = scl_group(pp->nof_paths, pp->beta_idx[0][s - 1], pp->beta_idx[1][s - 1], group, leader);
+  for (uint8_t i = 0; i < nof_groups; i++) {
+    uint8_t* beta0 = scl_beta(pp, 0, s - 1, leader[i]);
+    uint8_t* beta1 = scl_beta(pp, 1, s - 1, leader[i]);
+    uint8_t* beta  = pp->beta[c][s] + i * pp->stride[s];
+    pp->xor (beta0, beta1, beta, half);
+    memcpy(beta + half, beta1, half);
+  }
+  memcpy(pp->beta_idx[c][s], group, pp->nof_paths);
+}
+
+int init_polar_decoder_scl_c(void*           p,
+                             const uint8_t   code_size_log,
+                             const uint16_t* frozen_set,
+                             const uint16_t  frozen_set_size)
+{
+  struct pSCL_c* pp = p;
+
+  if (p == NULL || code_size_log < 1 || code_size_log > pp->nMax) {
+    return -1;
+  }
+
+  pp->code_size_log = code_size_log;
+
+  // computes the node types for the decoding tree
+  return compute_node_type(pp->tmp_node_type, pp->node_type, frozen_set, code_size_log, frozen_set_size);
+}
+
+int polar_decoder_scl_c(void* p, const int8_t* llr, uint8_t* data_decoded, const uint8_t max_candidates)
+{
+  struct pSCL_c* pp = p;
+
+  if (p == NULL || llr == NULL || data_decoded == NULL || pp->code_size_log == 0) {
+    return -1;
+  }
+
+  uint8_t  n         = pp->code_size_log;
+  uint16_t code_size = 1U << n;
+
+  // Initializes a single path with the codeword LLRs at the root
+  scl_scale_input(llr, pp->llr_in, code_size);
+  pp->nof_paths = 1;
+  pp->nof_info  = 0;
+  pp->pm[0]     = 0;
+
+  scl_node(pp, n, 0);
+
+  // Sort the paths by increasing path metric
+  uint8_t order[SRSRAN_POLAR_DECODER_LIST_SIZE_MAX];
+  for (uint8_t l = 0; l < pp->nof_paths; l++) {
+    uint8_t pos = l;
+    while (pos > 0 && pp->pm[order[pos - 1]] > pp->pm[l]) {
+      order[pos] = order[pos - 1];
+      pos--;
+    }
+    order[pos] = l;
+  }
+
+  // Write the messages, the frozen bits are set to zero
+  uint8_t nof_candidates = SRSRAN_MIN(pp->nof_paths, max_candidates);
+  for (uint8_t i = 0; i < nof_candidates; i++) {
+    const uint64_t* hist    = pp->hist[order[i]];
+    uint8_t*        message = data_decoded + i * code_size;
+    uint16_t        k       = 0;
+    for (uint16_t j = 0; j < code_size; j++) {
+      if (pp->node_type[0][j] == RATE_0) {
+        message[j] = 0;
+      } else {
+        message[j] = (hist[k / 64] >> (k % 64U)) & 1U;
+        k++;
+      }
+    }
+  }
+
+  return nof_candidates;
+}
+
+void delete_polar_decoder_scl_c(void* p)
+{
+  struct pSCL_c* pp = p;
+
+  if (p != NULL) {
+    if (pp->llr_in) {
+      free(pp->llr_in);
+    }
+    for (uint8_t s = 0; s <= SCL_NMAX_LOG; s++) {
+      if (s < SCL_NMAX_LOG && pp->llr[s]) {
+        free(pp->llr[s]);
+      }
+      if (pp->beta[0][s]) {
+        free(pp->beta[0][s]);
+      }
+      if (pp->beta[1][s]) {
+        free(pp->beta[1][s]);
+      }
+    }
+    if (pp->node_type[0]) {
+      free(pp->node_type[0]);
+    }
+    if (pp->tmp_node_type) {
+      delete_tmp_node_type(pp->tmp_node_type);
+    }
+    free(pp);
+  }
+}
+
+/*!
+ * Allocates the decoder buffers, the function pointers must be set afterwards.
+ */
+static struct pSCL_c* create_polar_decoder_scl_common(const uint8_t nMax, const uint8_t list_size)
+{
+  struct pSCL_c* pp = NULL; // pointer to the polar decoder instance
+
+  if (nMax < 1 || nMax > SCL_NMAX_LOG || list_size < 1 || list_size > SRSRAN_POLAR_DECODER_LIST_SIZE_MAX) {
+    return NULL;
+  }
+
+  // allocate memory to the polar decoder instance
+  if ((pp = malloc(sizeof(struct pSCL_c))) == NULL) {
+    return NULL;
+  }
+  SRSRAN_MEM_ZERO(pp, struct pSCL_c, 1);
+
+  pp->nMax      = nMax;
+  pp->list_size = list_size;
+
+  // Every buffer fits at least a SIMD register, plus one register at the end of every stage since the second half of
+  // the LLRs is read with a non-aligned offset
+  for (uint8_t s = 0; s <= nMax; s++) {
+    pp->stride[s] = SRSRAN_MAX(1U << s, SRSRAN_AVX2_B_SIZE);
+  }
+
+  pp->llr_in = srsran_vec_i8_malloc(pp->stride[nMax] + SRSRAN_AVX2_B_SIZE);
+  if (pp->llr_in == NULL) {
+    delete_polar_decoder_scl_c(pp);
+    return NULL;
+  }
+
+  for (uint8_t s = 0; s <= nMax; s++) {
+    uint32_t size = list_size * pp->stride[s] + SRSRAN_AVX2_B_SIZE;
+    if (s < nMax) {
+      pp->llr[s] = srsran_vec_i8_malloc(size);
+      if (pp->llr[s] == NULL) {
+        delete_polar_decoder_scl_c(pp);
+        return NULL;
+      }
+    }
+    // The leaves need two buffers, bit 0 and bit 1
+    size          = SRSRAN_MAX(list_size, 2) * pp->stride[s] + SRSRAN_AVX2_B_SIZE;
+    pp->beta[0][s] = srsran_vec_u8_malloc(size);
+    pp->beta[1][s] = srsran_vec_u8_malloc(size);
+    if (pp->beta[0][s] == NULL || pp->beta[1][s] == NULL) {
+      delete_polar_decoder_scl_c(pp);
+      return NULL;
+    }
+  }
+
+  // allocate memory to node_type. Stage s has 2^(nMax-s) nodes s=0,...,nMax.
+  pp->node_type[0] = srsran_vec_u8_malloc(1U << (nMax + 1));
+  if (pp->node_type[0] == NULL) {
+    delete_polar_decoder_scl_c(pp);
+    return NULL;
+  }
+  for (uint8_t s = 1; s <= nMax; s++) {
+    pp->node_type[s] = pp->node_type[s - 1] + (1U << (nMax - s + 1));
+  }
+
+  // memory allocation to compute node_type
+  pp->tmp_node_type = create_tmp_node_type(nMax);
+  if (pp->tmp_node_type == NULL) {
+    delete_polar_decoder_scl_c(pp);
+    return NULL;
+  }
+
+  return pp;
+}
+
+void* create_polar_decoder_scl_c(const uint8_t nMax, const uint8_t list_size)
+{
+  struct pSCL_c* pp = create_polar_decoder_scl_common(nMax, list_size);
+  if (pp == NULL) {
+    return NULL;
+  }
+
+  // set functions
+  pp->f       = srsran_vec_function_f_ccc;
+  pp->g       = srsran_vec_function_g_bccc;
+  pp->xor     = srsran_vec_xor_bbb;
+  pp->bit_one = 1;
+
+  return pp;
+}
+
+#ifdef LV_HAVE_AVX2
+/*!
+ * Adapts srsran_vec_xor_bbb_avx2() to the function-xor signature.
+ */
+static void scl_xor_avx2(const uint8_t* x, const uint8_t* y, uint8_t* z, const uint32_t len)
+{
+  srsran_vec_xor_bbb_avx2(x, y, z, (uint16_t)len);
+}
+
+void* create_polar_decoder_scl_c_avx2(const uint8_t nMax, const uint8_t list_size)
+{
+  struct pSCL_c* pp = create_polar_decoder_scl_common(nMax, list_size);
+  if (pp == NULL) {
+    return NULL;
+  }
+
+  // set functions, the AVX2 function g takes the bits as {0, 128}
+  pp->f       = srsran_vec_function_f_ccc_avx2;
+  pp->g       = srsran_vec_function_g_bccc_avx2;
+  pp->xor     = scl_xor_avx2;
+  pp->bit_one = 128;
+
+  return pp;
+}
+#endif // LV_HAVE_AVX2
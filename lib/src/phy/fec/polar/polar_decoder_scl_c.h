@@ -0,0 +1,90 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_scl_c.h
+ * \brief Declaration of the Successive Cancellation List (SCL) polar decoder inner functions working with
+ * 8-bit integer-valued LLRs.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#ifndef POLAR_DECODER_SCL_C_H
+#define POLAR_DECODER_SCL_C_H
+#include "polar_decoder_ssc_all.h"
+
+/*!
+ * Creates an (8-bit) SCL polar decoder structure of type pSCL_c, and allocates memory for the decoding buffers of
+ * \a list_size paths.
+ *
+ * \param[in] nMax \f$log_2\f$ of the maximum number of bits in the codeword.
+ * \param[in] list_size Number of decoding paths, from 1 to \ref SRSRAN_POLAR_DECODER_LIST_SIZE_MAX.
+ * \return A pointer to a pSCL_c structure if the function executes correctly, NULL otherwise.
+ */
+void* create_polar_decoder_scl_c(const uint8_t nMax, const uint8_t list_size);
+
+#ifdef LV_HAVE_AVX2
+/*!
+ * Same as create_polar_decoder_scl_c() but the decoder uses the AVX2 versions of the functions f, g and xor.
+ *
+ * \param[in] nMax \f$log_2\f$ of the maximum number of bits in the codeword.
+ * \param[in] list_size Number of decoding paths, from 1 to \ref SRSRAN_POLAR_DECODER_LIST_SIZE_MAX.
+ * \return A pointer to a pSCL_c structure if the function executes correctly, NULL otherwise.
+ */
+void* create_polar_decoder_scl_c_avx2(const uint8_t nMax, const uint8_t list_size);
+#endif // LV_HAVE_AVX2
+
+/*!
+ * The (8-bit) SCL polar decoder "destructor": it frees all the resources allocated to the decoder.
+ *
+ * \param[in, out] p A pointer to the dismantled decoder.
+ */
+void delete_polar_decoder_scl_c(void* p);
+
+/*!
+ * Prepares the decoding tree of an (8-bit) SCL polar decoder for a given frozen set. The decoding tree can be reused
+ * for any number of codewords with the same frozen set through polar_decoder_scl_c().
+ *
+ * \param[in, out] p A pointer to a pSCL_c structure.
+ * \param[in] code_size_log \f$log_2\f$ of the number of bits in the codeword.
+ * \param[in] frozen_set The position of the frozen bits in increasing order.
+ * \param[in] frozen_set_size The size of the frozen_set.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int init_polar_decoder_scl_c(void*           p,
+                             const uint8_t   code_size_log,
+                             const uint16_t* frozen_set,
+                             const uint16_t  frozen_set_size);
+
+/*!
+ * Decodes one codeword with the decoding tree set by init_polar_decoder_scl_c(). The surviving paths are written,
+ * one after the other, in increasing order of path metric, that is, the most likely first.
+ *
+ * \param[in] p A pointer to the desired decoder.
+ * \param[in] llr LLRs of the codeword.
+ * \param[out] data_decoded Decoded messages, it must fit \a max_candidates times the code size.
+ * \param[in] max_candidates Maximum number of paths to write.
+ * \return The number of written paths if the function executes correctly, -1 otherwise.
+ */
+int polar_decoder_scl_c(void* p, const int8_t* llr, uint8_t* data_decoded, const uint8_t max_candidates);
+
+#endif // POLAR_DECODER_SCL_C_H
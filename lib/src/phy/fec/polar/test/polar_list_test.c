@@ -0,0 +1,292 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_list_test.c
+ * \brief End-to-end test for the CRC-aided Successive Cancellation List (SCL) polar decoder.
+ *
+ * Batches of random messages with an attached CRC24C are allocated, encoded, rate-matched, sent over an AWGN channel
+ * and rate-dematched. Every batch is decoded by the 8-bit SSC decoder, one codeword at a time, and by the 8-bit SCL
+ * decoder in a single batch call. For the SCL decoder, the first candidate matching the CRC is selected. The test
+ * fails if any decoder makes an error in the noiseless case or if the SCL decoder makes more errors than the SSC one.
+ *
+ * Synopsis: **polar_list_test [options]**
+ *
+ * Options:
+ *
+ *  - <b>-n \<number\></b> nMax,  [Default 9].
+ *  - <b>-k \<number\></b> Message size (K) including the 24 CRC bits,  [Default 64].
+ *  - <b>-e \<number\></b> Rate matching size (E), [Default 216].
+ *  - <b>-l \<number\></b> List size, [Default 8].
+ *  - <b>-s \<number\></b> SNR [dB, Default 101] -- Use 101 for noiseless.
+ *  - <b>-b \<number\></b> Number of batches, [Default 100].
+ *
+ * Example (DCI, aggregation level 2): ./polar_list_test -n9 -k64 -e216 -l8 -s0
+ */
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/common/timestamp.h"
+#include "srsran/phy/fec/crc.h"
+#include "srsran/phy/fec/polar/polar_chanalloc.h"
+#include "srsran/phy/fec/polar/polar_code.h"
+#include "srsran/phy/fec/polar/polar_decoder.h"
+#include "srsran/phy/fec/polar/polar_encoder.h"
+#include "srsran/phy/fec/polar/polar_rm.h"
+#include "srsran/phy/utils/bit.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define BATCH_SIZE 16 /*!< \brief Number of codewords in a batch. */
+#define CRC_LEN 24    /*!< \brief Number of CRC bits. */
+
+static uint16_t K         = 64;  /*!< \brief Number of message bits (data and CRC). */
+static uint16_t E         = 216; /*!< \brief Number of bits of the codeword after rate matching. */
+static uint8_t  nMax      = 9;   /*!< \brief Maximum \f$log_2(N)\f$, where \f$N\f$ is the codeword size.*/
+static uint8_t  list_size = 8;   /*!< \brief Number of paths of the list decoder. */
+static double   snr_db    = 101; /*!< \brief SNR in dB (101 for no noise). */
+static uint32_t nof_batch = 100; /*!< \brief Number of simulated batches. */
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [-nX] [-kX] [-eX] [-lX] [-sX] [-bX]\n", prog);
+  printf("\t-n nMax [Default %d]\n", nMax);
+  printf("\t-k Message size including CRC [Default %d]\n", K);
+  printf("\t-e Rate matching size [Default %d]\n", E);
+  printf("\t-l List size [Default %d]\n", list_size);
+  printf("\t-s SNR [dB, Default %.2f dB] -- Use 101 for noiseless\n", snr_db);
+  printf("\t-b Number of batches [Default %d]\n", nof_batch);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "n:k:e:l:s:b:")) != -1) {
+    switch (opt) {
+      case 'n':
+        nMax = (uint8_t)strtol(optarg, NULL, 10);
+        break;
+      case 'k':
+        K = (uint16_t)strtol(optarg, NULL, 10);
+        break;
+      case 'e':
+        E = (uint16_t)strtol(optarg, NULL, 10);
+        break;
+      case 'l':
+        list_size = (uint8_t)strtol(optarg, NULL, 10);
+        break;
+      case 's':
+        snr_db = strtof(optarg, NULL);
+        break;
+      case 'b':
+        nof_batch = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int    ret          = SRSRAN_ERROR;
+  int    n_errors_ssc = 0;
+  int    n_errors_scl = 0;
+  double t_ssc_us     = 0;
+  double t_scl_us     = 0;
+
+  struct timeval t[3];
+
+  srsran_polar_code_t    code    = {};
+  srsran_polar_encoder_t enc     = {};
+  srsran_polar_decoder_t dec_ssc = {};
+  srsran_polar_decoder_t dec_scl = {};
+  srsran_polar_rm_t      rm_tx   = {};
+  srsran_polar_rm_t      rm_rx   = {};
+  srsran_crc_t           crc     = {};
+
+  parse_args(argc, argv);
+
+  srsran_polar_decoder_type_t ssc_type = SRSRAN_POLAR_DECODER_SSC_C;
+  srsran_polar_decoder_type_t scl_type = SRSRAN_POLAR_DECODER_SCL_C;
+#ifdef LV_HAVE_AVX2
+  ssc_type = SRSRAN_POLAR_DECODER_SSC_C_AVX2;
+  scl_type = SRSRAN_POLAR_DECODER_SCL_C_AVX2;
+#endif // LV_HAVE_AVX2
+
+  srsran_random_t random_gen = srsran_random_init(0);
+
+  uint8_t* data_tx    = srsran_vec_u8_malloc(K * BATCH_SIZE);
+  uint8_t* data_rx    = srsran_vec_u8_malloc(K);
+  uint8_t* input_enc  = srsran_vec_u8_malloc(NMAX);
+  uint8_t* output_enc = srsran_vec_u8_malloc(NMAX);
+  uint8_t* rm_cw      = srsran_vec_u8_malloc(E);
+  float*   rm_llr     = srsran_vec_f_malloc(E);
+  int8_t*  rm_llr_c   = srsran_vec_i8_malloc(E);
+  int8_t*  llr        = srsran_vec_i8_malloc(NMAX * BATCH_SIZE);
+  uint8_t* out_ssc    = srsran_vec_u8_malloc(NMAX);
+  uint8_t* out_scl    = srsran_vec_u8_malloc(NMAX * SRSRAN_POLAR_DECODER_LIST_SIZE_MAX * BATCH_SIZE);
+  uint8_t* out_single = srsran_vec_u8_malloc(NMAX);
+  if (!data_tx || !data_rx || !input_enc || !output_enc || !rm_cw || !rm_llr || !rm_llr_c || !llr || !out_ssc ||
+      !out_scl || !out_single) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+
+  if (srsran_polar_code_init(&code) < SRSRAN_SUCCESS || srsran_polar_code_get(&code, K, E, nMax) < SRSRAN_SUCCESS) {
+    ERROR("Error getting polar code K=%d, E=%d, nMax=%d", K, E, nMax);
+    goto clean_exit;
+  }
+
+  if (srsran_polar_encoder_init(&enc, SRSRAN_POLAR_ENCODER_PIPELINED, nMax) < SRSRAN_SUCCESS ||
+      srsran_polar_decoder_init(&dec_ssc, ssc_type, nMax) < SRSRAN_SUCCESS ||
+      srsran_polar_decoder_init_list(&dec_scl, scl_type, nMax, list_size) < SRSRAN_SUCCESS ||
+      srsran_polar_rm_tx_init(&rm_tx) < SRSRAN_SUCCESS || srsran_polar_rm_rx_init_c(&rm_rx) < SRSRAN_SUCCESS ||
+      srsran_crc_init(&crc, SRSRAN_LTE_CRC24C, CRC_LEN) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising objects");
+    goto clean_exit;
+  }
+
+  float noise_std = sqrtf(srsran_convert_dB_to_power(-snr_db));
+  float llr_gain  = (snr_db == 101) ? 32.0f : 4.0f * 2.0f / (noise_std * noise_std);
+
+  const int8_t* llr_ptr[BATCH_SIZE];
+  uint8_t*      out_scl_ptr[BATCH_SIZE];
+  for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+    llr_ptr[i]     = llr + i * code.N;
+    out_scl_ptr[i] = out_scl + i * code.N * list_size;
+  }
+
+  for (uint32_t i_batch = 0; i_batch < nof_batch; i_batch++) {
+    // Generate, encode and transmit the batch
+    for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+      uint8_t* c = data_tx + i * K;
+      for (uint32_t j = 0; j < K - CRC_LEN; j++) {
+        c[j] = srsran_random_uniform_int_dist(random_gen, 0, 1);
+      }
+      srsran_crc_attach(&crc, c, K - CRC_LEN);
+
+      srsran_polar_chanalloc_tx(c, input_enc, code.N, code.K, code.nPC, code.K_set, code.PC_set);
+      srsran_polar_encoder_encode(&enc, input_enc, output_enc, code.n);
+      srsran_polar_rm_tx(&rm_tx, output_enc, rm_cw, code.n, E, K, 0);
+
+      for (uint32_t j = 0; j < E; j++) {
+        rm_llr[j] = rm_cw[j] ? -1.0f : 1.0f;
+      }
+      if (snr_db != 101) {
+        srsran_ch_awgn_f(rm_llr, rm_llr, noise_std, E);
+      }
+      srsran_vec_quant_fc(rm_llr, rm_llr_c, llr_gain, 0, 127, E);
+
+      srsran_polar_rm_rx_c(&rm_rx, rm_llr_c, llr + i * code.N, E, code.n, K, 0);
+    }
+
+    // SSC decoder, one codeword at a time
+    gettimeofday(&t[1], NULL);
+    for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+      srsran_polar_decoder_decode_c(&dec_ssc, llr_ptr[i], out_ssc, code.n, code.F_set, code.F_set_size);
+      srsran_polar_chanalloc_rx(out_ssc, data_rx, code.K, code.nPC, code.K_set, code.PC_set);
+      if (srsran_bit_diff(data_tx + i * K, data_rx, K) != 0) {
+        n_errors_ssc++;
+      }
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    t_ssc_us += t[0].tv_sec * 1e6 + t[0].tv_usec;
+
+    // SCL decoder, the whole batch at once and CRC-aided selection
+    gettimeofday(&t[1], NULL);
+    int nof_candidates = srsran_polar_decoder_decode_list_batch_c(
+        &dec_scl, llr_ptr, out_scl_ptr, BATCH_SIZE, code.n, code.F_set, code.F_set_size);
+    if (nof_candidates < 1 || nof_candidates > list_size) {
+      ERROR("Invalid number of candidates %d", nof_candidates);
+      goto clean_exit;
+    }
+    for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+      bool crc_ok = false;
+      for (int l = 0; l < nof_candidates && !crc_ok; l++) {
+        srsran_polar_chanalloc_rx(out_scl_ptr[i] + l * code.N, data_rx, code.K, code.nPC, code.K_set, code.PC_set);
+        crc_ok = srsran_crc_match(&crc, data_rx, K - CRC_LEN);
+      }
+      if (!crc_ok || srsran_bit_diff(data_tx + i * K, data_rx, K) != 0) {
+        n_errors_scl++;
+      }
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    t_scl_us += t[0].tv_sec * 1e6 + t[0].tv_usec;
+
+    // The single codeword interface returns the most likely candidate
+    srsran_polar_decoder_decode_c(&dec_scl, llr_ptr[0], out_single, code.n, code.F_set, code.F_set_size);
+    if (memcmp(out_single, out_scl_ptr[0], code.N) != 0) {
+      ERROR("Single and batch list decoding mismatch");
+      goto clean_exit;
+    }
+  }
+
+  uint32_t nof_cw = nof_batch * BATCH_SIZE;
+  printf("K=%d; E=%d; N=%d; L=%d; SNR=%.1f dB; SSC: WER=%.4f, %.2f us/cw; SCL: WER=%.4f, %.2f us/cw;\n",
+         K,
+         E,
+         code.N,
+         list_size,
+         snr_db,
+         (double)n_errors_ssc / nof_cw,
+         t_ssc_us / nof_cw,
+         (double)n_errors_scl / nof_cw,
+         t_scl_us / nof_cw);
+
+  if (snr_db == 101) {
+    ret = (n_errors_ssc == 0 && n_errors_scl == 0) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+  } else {
+    ret = (n_errors_scl <= n_errors_ssc) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+  }
+
+clean_exit:
+  srsran_random_free(random_gen);
+  free(data_tx);
+  free(data_rx);
+  free(input_enc);
+  free(output_enc);
+  free(rm_cw);
+  free(rm_llr);
+  free(rm_llr_c);
+  free(llr);
+  free(out_ssc);
+  free(out_scl);
+  free(out_single);
+  srsran_polar_code_free(&code);
+  srsran_polar_encoder_free(&enc);
+  srsran_polar_decoder_free(&dec_ssc);
+  srsran_polar_decoder_free(&dec_scl);
+  srsran_polar_rm_tx_free(&rm_tx);
+  srsran_polar_rm_rx_free_c(&rm_rx);
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
@@ -33,20 +33,45 @@
 
 #define MAX_PDSCH_RE(cp) (2 * SRSRAN_CP_NSYMB(cp) * 12)
 
-int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof_prb)
+// Number of code blocks of a transport block of tbs bits
+#define SOFTBUFFER_NOF_CB(tbs) (((tbs) + 24) / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1)
+
+// The soft-buffers are accounted on their own, whichever memory tag the calling thread has set
+static void* softbuffer_malloc(uint32_t size)
 {
-  int ret = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, nof_prb);
+  srsran_mem_tag_t tag = srsran_vec_set_mem_tag(SRSRAN_MEM_TAG_NONE);
+  void*            ptr = srsran_vec_malloc(size);
+  srsran_vec_set_mem_tag(tag);
+  if (ptr) {
+    srsran_mem_account(SRSRAN_MEM_TAG_SOFTBUFFER, size);
+  }
+  return ptr;
+}
 
+static int softbuffer_max_cb(uint32_t nof_prb)
+{
+  int ret = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, nof_prb);
   if (ret == SRSRAN_ERROR) {
     return SRSRAN_ERROR;
   }
-  uint32_t max_cb      = (uint32_t)ret / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
-  uint32_t max_cb_size = SOFTBUFFER_SIZE;
+  return (int)((uint32_t)ret / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1);
+}
 
-  return srsran_softbuffer_rx_init_guru(q, max_cb, max_cb_size);
+int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof_prb)
+{
+  int max_cb = softbuffer_max_cb(nof_prb);
+  if (max_cb == SRSRAN_ERROR) {
+    return SRSRAN_ERROR;
+  }
+
+  return srsran_softbuffer_rx_init_guru(q, (uint32_t)max_cb, SOFTBUFFER_SIZE);
 }
 
-int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+static int softbuffer_rx_init(srsran_softbuffer_rx_t* q,
+                              uint32_t                max_cb,
+                              uint32_t                max_cb_size,
+                              uint32_t                cb_buffer_len,
+                              bool                    alloc_cb)
 {
   int ret = SRSRAN_ERROR;
 
@@ -59,41 +84,42 @@ int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, u
   SRSRAN_MEM_ZERO(q, srsran_softbuffer_rx_t, 1);
 
   // Set internal attributes
-  q->max_cb      = max_cb;
-  q->max_cb_size = max_cb_size;
+  q->max_cb        = max_cb;
+  q->max_cb_size   = max_cb_size;
+  q->cb_buffer_len = cb_buffer_len;
 
-  q->buffer_f = SRSRAN_MEM_ALLOC(int16_t*, q->max_cb);
+  q->buffer_f = softbuffer_malloc(sizeof(int16_t*) * q->max_cb);
   if (!q->buffer_f) {
     perror("malloc");
     goto clean_exit;
   }
   SRSRAN_MEM_ZERO(q->buffer_f, int16_t*, q->max_cb);
 
-  q->data = SRSRAN_MEM_ALLOC(uint8_t*, q->max_cb);
+  q->data = softbuffer_malloc(sizeof(uint8_t*) * q->max_cb);
   if (!q->data) {
     perror("malloc");
     goto clean_exit;
   }
   SRSRAN_MEM_ZERO(q->data, uint8_t*, q->max_cb);
 
-  q->cb_crc = SRSRAN_MEM_ALLOC(bool, q->max_cb);
+  q->cb_crc = softbuffer_malloc(sizeof(bool) * q->max_cb);
   if (!q->cb_crc) {
     perror("malloc");
     goto clean_exit;
   }
 
+  // All code blocks start dirty so the initial reset zeroes them
+  q->cb_dirty = softbuffer_malloc(sizeof(bool) * q->max_cb);
+  if (!q->cb_dirty) {
+    perror("malloc");
+    goto clean_exit;
+  }
   for (uint32_t i = 0; i < q->max_cb; i++) {
-    q->buffer_f[i] = srsran_vec_i16_malloc(q->max_cb_size);
-    if (!q->buffer_f[i]) {
-      perror("malloc");
-      goto clean_exit;
-    }
+    q->cb_dirty[i] = true;
+  }
 
-    q->data[i] = srsran_vec_u8_malloc(q->max_cb_size / 8);
-    if (!q->data[i]) {
-      perror("malloc");
-      goto clean_exit;
-    }
+  if (alloc_cb && srsran_softbuffer_rx_reserve_cb(q, q->max_cb) < SRSRAN_SUCCESS) {
+    goto clean_exit;
   }
 
   srsran_softbuffer_rx_reset(q);
@@ -109,9 +135,90 @@ clean_exit:
   return ret;
 }
 
+int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+{
+  return softbuffer_rx_init(q, max_cb, max_cb_size, max_cb_size * sizeof(int16_t), true);
+}
+
+int srsran_softbuffer_rx_init_nr(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+{
+  return softbuffer_rx_init(q, max_cb, max_cb_size, max_cb_size * sizeof(int8_t), false);
+}
+
+int srsran_softbuffer_rx_init_on_demand(srsran_softbuffer_rx_t* q, uint32_t nof_prb)
+{
+  int max_cb = softbuffer_max_cb(nof_prb);
+  if (max_cb == SRSRAN_ERROR) {
+    return SRSRAN_ERROR;
+  }
+
+  return softbuffer_rx_init(q, (uint32_t)max_cb, SOFTBUFFER_SIZE, SOFTBUFFER_SIZE * sizeof(int16_t), false);
+}
+
+int srsran_softbuffer_rx_reserve_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
+{
+  if (q == NULL || q->buffer_f == NULL || nof_cb > q->max_cb) {
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < nof_cb; i++) {
+    if (q->buffer_f[i] == NULL) {
+      q->buffer_f[i] = softbuffer_malloc(q->cb_buffer_len);
+      if (!q->buffer_f[i]) {
+        perror("malloc");
+        return SRSRAN_ERROR;
+      }
+      srsran_vec_u8_zero((uint8_t*)q->buffer_f[i], q->cb_buffer_len);
+    }
+
+    if (q->data[i] == NULL) {
+      q->data[i] = softbuffer_malloc(q->max_cb_size / 8);
+      if (!q->data[i]) {
+        perror("malloc");
+        return SRSRAN_ERROR;
+      }
+      srsran_vec_u8_zero(q->data[i], q->max_cb_size / 8);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_softbuffer_rx_reserve_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR;
+  }
+  return srsran_softbuffer_rx_reserve_cb(q, SRSRAN_MIN(SOFTBUFFER_NOF_CB(tbs), q->max_cb));
+}
+
+uint64_t srsran_softbuffer_rx_mem_bytes(const srsran_softbuffer_rx_t* q)
+{
+  uint64_t nof_bytes = 0;
+  if (q == NULL) {
+    return nof_bytes;
+  }
+  if (q->buffer_f) {
+    nof_bytes += sizeof(int16_t*) * q->max_cb;
+    for (uint32_t i = 0; i < q->max_cb; i++) {
+      nof_bytes += q->buffer_f[i] ? q->cb_buffer_len : 0;
+    }
+  }
+  if (q->data) {
+    nof_bytes += sizeof(uint8_t*) * q->max_cb;
+    for (uint32_t i = 0; i < q->max_cb; i++) {
+      nof_bytes += q->data[i] ? q->max_cb_size / 8 : 0;
+    }
+  }
+  nof_bytes += q->cb_crc ? sizeof(bool) * q->max_cb : 0;
+  nof_bytes += q->cb_dirty ? sizeof(bool) * q->max_cb : 0;
+  return nof_bytes;
+}
+
 void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* q)
 {
   if (q) {
+    srsran_mem_account(SRSRAN_MEM_TAG_SOFTBUFFER, -(int64_t)srsran_softbuffer_rx_mem_bytes(q));
     if (q->buffer_f) {
       for (uint32_t i = 0; i < q->max_cb; i++) {
         if (q->buffer_f[i]) {
@@ -131,6 +238,9 @@ void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* q)
     if (q->cb_crc) {
       free(q->cb_crc);
     }
+    if (q->cb_dirty) {
+      free(q->cb_dirty);
+    }
 
     SRSRAN_MEM_ZERO(q, srsran_softbuffer_rx_t, 1);
   }
@@ -138,8 +248,7 @@ void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* q)
 
 void srsran_softbuffer_rx_reset_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs)
 {
-  uint32_t nof_cb = (tbs + 24) / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
-  srsran_softbuffer_rx_reset_cb(q, SRSRAN_MIN(nof_cb, q->max_cb));
+  srsran_softbuffer_rx_reset_cb(q, SRSRAN_MIN(SOFTBUFFER_NOF_CB(tbs), q->max_cb));
 }
 
 void srsran_softbuffer_rx_reset(srsran_softbuffer_rx_t* q)
@@ -154,12 +263,19 @@ void srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
       nof_cb = q->max_cb;
     }
     for (uint32_t i = 0; i < nof_cb; i++) {
+      // Skip the code blocks that have not been written since the last reset
+      if (q->cb_dirty != NULL && !q->cb_dirty[i]) {
+        continue;
+      }
       if (q->buffer_f[i]) {
-        srsran_vec_i16_zero(q->buffer_f[i], q->max_cb_size);
+        srsran_vec_u8_zero((uint8_t*)q->buffer_f[i], q->cb_buffer_len);
       }
       if (q->data[i]) {
         srsran_vec_u8_zero(q->data[i], q->max_cb_size / 8);
       }
+      if (q->cb_dirty != NULL) {
+        q->cb_dirty[i] = false;
+      }
     }
   }
   if (q->cb_crc) {
@@ -168,6 +284,15 @@ void srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
   q->tb_crc = false;
 }
 
+void srsran_softbuffer_rx_set_dirty(srsran_softbuffer_rx_t* q, uint32_t cb_idx)
+{
+  if (q == NULL || q->cb_dirty == NULL || cb_idx >= q->max_cb) {
+    return;
+  }
+
+  q->cb_dirty[cb_idx] = true;
+}
+
 void srsran_softbuffer_rx_reset_cb_crc(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
 {
   if (q == NULL || nof_cb == 0) {
@@ -179,17 +304,15 @@ void srsran_softbuffer_rx_reset_cb_crc(srsran_softbuffer_rx_t* q, uint32_t nof_c
 
 int srsran_softbuffer_tx_init(srsran_softbuffer_tx_t* q, uint32_t nof_prb)
 {
-  int ret = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, nof_prb);
-  if (ret == SRSRAN_ERROR) {
+  int max_cb = softbuffer_max_cb(nof_prb);
+  if (max_cb == SRSRAN_ERROR) {
     return SRSRAN_ERROR;
   }
-  uint32_t max_cb      = (uint32_t)ret / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
-  uint32_t max_cb_size = SOFTBUFFER_SIZE;
 
-  return srsran_softbuffer_tx_init_guru(q, max_cb, max_cb_size);
+  return srsran_softbuffer_tx_init_guru(q, (uint32_t)max_cb, SOFTBUFFER_SIZE);
 }
 
-int srsran_softbuffer_tx_init_guru(srsran_softbuffer_tx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+static int softbuffer_tx_init(srsran_softbuffer_tx_t* q, uint32_t max_cb, uint32_t max_cb_size, bool alloc_cb)
 {
   // Protect pointer
   if (!q) {
@@ -203,7 +326,7 @@ int srsran_softbuffer_tx_init_guru(srsran_softbuffer_tx_t* q, uint32_t max_cb, u
   q->max_cb      = max_cb;
   q->max_cb_size = max_cb_size;
 
-  q->buffer_b = SRSRAN_MEM_ALLOC(uint8_t*, q->max_cb);
+  q->buffer_b = softbuffer_malloc(sizeof(uint8_t*) * q->max_cb);
   if (!q->buffer_b) {
     perror("malloc");
     return SRSRAN_ERROR;
@@ -211,12 +334,8 @@ int srsran_softbuffer_tx_init_guru(srsran_softbuffer_tx_t* q, uint32_t max_cb, u
   SRSRAN_MEM_ZERO(q->buffer_b, uint8_t*, q->max_cb);
 
   // TODO: Use HARQ buffer limitation based on UE category
-  for (uint32_t i = 0; i < q->max_cb; i++) {
-    q->buffer_b[i] = srsran_vec_u8_malloc(q->max_cb_size);
-    if (!q->buffer_b[i]) {
-      perror("malloc");
-      return SRSRAN_ERROR;
-    }
+  if (alloc_cb && srsran_softbuffer_tx_reserve_cb(q, q->max_cb) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
   }
 
   srsran_softbuffer_tx_reset(q);
@@ -224,9 +343,66 @@ int srsran_softbuffer_tx_init_guru(srsran_softbuffer_tx_t* q, uint32_t max_cb, u
   return SRSRAN_SUCCESS;
 }
 
+int srsran_softbuffer_tx_init_guru(srsran_softbuffer_tx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+{
+  return softbuffer_tx_init(q, max_cb, max_cb_size, true);
+}
+
+int srsran_softbuffer_tx_init_on_demand(srsran_softbuffer_tx_t* q, uint32_t nof_prb)
+{
+  int max_cb = softbuffer_max_cb(nof_prb);
+  if (max_cb == SRSRAN_ERROR) {
+    return SRSRAN_ERROR;
+  }
+
+  return softbuffer_tx_init(q, (uint32_t)max_cb, SOFTBUFFER_SIZE, false);
+}
+
+int srsran_softbuffer_tx_reserve_cb(srsran_softbuffer_tx_t* q, uint32_t nof_cb)
+{
+  if (q == NULL || q->buffer_b == NULL || nof_cb > q->max_cb) {
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < nof_cb; i++) {
+    if (q->buffer_b[i] == NULL) {
+      q->buffer_b[i] = softbuffer_malloc(q->max_cb_size);
+      if (!q->buffer_b[i]) {
+        perror("malloc");
+        return SRSRAN_ERROR;
+      }
+      srsran_vec_u8_zero(q->buffer_b[i], q->max_cb_size);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_softbuffer_tx_reserve_tbs(srsran_softbuffer_tx_t* q, uint32_t tbs)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR;
+  }
+  return srsran_softbuffer_tx_reserve_cb(q, SRSRAN_MIN(SOFTBUFFER_NOF_CB(tbs), q->max_cb));
+}
+
+uint64_t srsran_softbuffer_tx_mem_bytes(const srsran_softbuffer_tx_t* q)
+{
+  uint64_t nof_bytes = 0;
+  if (q == NULL || q->buffer_b == NULL) {
+    return nof_bytes;
+  }
+  nof_bytes += sizeof(uint8_t*) * q->max_cb;
+  for (uint32_t i = 0; i < q->max_cb; i++) {
+    nof_bytes += q->buffer_b[i] ? q->max_cb_size : 0;
+  }
+  return nof_bytes;
+}
+
 void srsran_softbuffer_tx_free(srsran_softbuffer_tx_t* q)
 {
   if (q) {
+    srsran_mem_account(SRSRAN_MEM_TAG_SOFTBUFFER, -(int64_t)srsran_softbuffer_tx_mem_bytes(q));
     if (q->buffer_b) {
       for (uint32_t i = 0; i < q->max_cb; i++) {
         if (q->buffer_b[i]) {
@@ -241,8 +417,7 @@ void srsran_softbuffer_tx_free(srsran_softbuffer_tx_t* q)
 
 void srsran_softbuffer_tx_reset_tbs(srsran_softbuffer_tx_t* q, uint32_t tbs)
 {
-  uint32_t nof_cb = (tbs + 24) / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
-  srsran_softbuffer_tx_reset_cb(q, nof_cb);
+  srsran_softbuffer_tx_reset_cb(q, SOFTBUFFER_NOF_CB(tbs));
 }
 
 void srsran_softbuffer_tx_reset(srsran_softbuffer_tx_t* q)
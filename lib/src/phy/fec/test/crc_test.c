@@ -111,6 +111,23 @@ int main(int argc, char** argv)
 
   INFO("checksum=%x", crc_word);
 
+  // check the packed and unpacked checksums match for every whole number of bytes
+  uint8_t* data_bytes = srsran_vec_u8_malloc(num_bits / 8 + 1);
+  if (!data_bytes) {
+    perror("malloc");
+    exit(-1);
+  }
+  srsran_bit_pack_vector(data, data_bytes, num_bits);
+  for (i = 0; i <= num_bits / 8; i++) {
+    uint32_t crc_unpacked = srsran_crc_checksum(&crc_p, data, 8 * i);
+    uint32_t crc_packed   = srsran_crc_checksum_byte(&crc_p, data_bytes, 8 * i);
+    if (crc_unpacked != crc_packed) {
+      ERROR("Packed checksum %x does not match unpacked %x for %d bytes", crc_packed, crc_unpacked, i);
+      exit(-1);
+    }
+  }
+  free(data_bytes);
+
   free(data);
 
   // check if generated word is as expected
@@ -0,0 +1,319 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/fec/turbo/turbodecoder_batch.h"
+#include "srsran/srsran.h"
+#include <srsran/phy/utils/random.h>
+
+#define MIN_ITERATIONS 2
+#define MAX_ITERATIONS 10
+#define MAX_NOF_CB 64
+#define LLR_AMPLITUDE 32.0f
+
+uint32_t nof_frames = 10;
+uint32_t nof_cb     = 40;
+uint32_t min_cb_idx = 0;
+uint32_t max_cb_idx = SRSRAN_NOF_TC_CB_SIZES - 1;
+float    ebno_db    = 3.0f;
+uint32_t seed       = 0;
+bool     early_stop = false;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [ncmMesEv]\n", prog);
+  printf("\t-n nof_frames [Default %d]\n", nof_frames);
+  printf("\t-c nof_cb in each batch [Default %d]\n", nof_cb);
+  printf("\t-m minimum code block size index [Default %d]\n", min_cb_idx);
+  printf("\t-M maximum code block size index [Default %d]\n", max_cb_idx);
+  printf("\t-e ebno in dB [Default %.1f]\n", ebno_db);
+  printf("\t-s seed [Default 0=time]\n");
+  printf("\t-E enable early termination of the batch decoder [Default disabled]\n");
+  printf("\t-v increase verbosity\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "ncmMesEv")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_frames = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'c':
+        nof_cb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'm':
+        min_cb_idx = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'M':
+        max_cb_idx = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'e':
+        ebno_db = strtof(argv[optind], NULL);
+        break;
+      case 's':
+        seed = (uint32_t)strtoul(argv[optind], NULL, 0);
+        break;
+      case 'E':
+        early_stop = true;
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int                    ret = SRSRAN_ERROR;
+  srsran_random_t        random_gen;
+  srsran_tcod_t          tcod  = {};
+  srsran_tdec_t          tdec  = {};
+  srsran_tdec_batch_t    batch = {};
+  srsran_crc_t           crc_tb, crc_cb;
+  srsran_tdec_batch_cb_t cbs[MAX_NOF_CB];
+  uint8_t*               data_tx[MAX_NOF_CB]  = {};
+  uint8_t*               data_rx[MAX_NOF_CB]  = {};
+  int8_t*                llr_rm[MAX_NOF_CB]   = {};
+  uint8_t*               ref_rx               = NULL;
+  uint8_t*               parity               = NULL;
+  uint8_t*               w_buff               = NULL;
+  uint8_t*               e_bits               = NULL;
+  uint8_t*               e_bits_unpacked      = NULL;
+  float*                 llr_f                = NULL;
+  int8_t*                llr                  = NULL;
+  uint32_t               errors_batch         = 0;
+  uint32_t               errors_ref           = 0;
+  uint64_t               nof_bits             = 0;
+  uint64_t               batch_usec           = 0;
+  uint64_t               ref_usec             = 0;
+  uint64_t               iterations_batch     = 0;
+  uint64_t               iterations_ref       = 0;
+  struct timeval         t[3];
+
+  parse_args(argc, argv);
+
+  if (nof_cb > MAX_NOF_CB || min_cb_idx > max_cb_idx || max_cb_idx >= SRSRAN_NOF_TC_CB_SIZES) {
+    usage(argv[0]);
+    return SRSRAN_ERROR;
+  }
+
+  if (!seed) {
+    seed = time(NULL);
+  }
+  srand(seed);
+  random_gen = srsran_random_init(seed);
+
+  uint32_t max_e = SRSRAN_TCOD_RATE * SRSRAN_TCOD_MAX_LEN_CB + SRSRAN_TCOD_TOTALTAIL;
+
+  if (srsran_crc_init(&crc_tb, SRSRAN_LTE_CRC24A, 24) || srsran_crc_init(&crc_cb, SRSRAN_LTE_CRC24B, 24)) {
+    ERROR("Error initiating CRC");
+    goto clean_exit;
+  }
+
+  if (srsran_tcod_init(&tcod, SRSRAN_TCOD_MAX_LEN_CB)) {
+    ERROR("Error initiating Turbo coder");
+    goto clean_exit;
+  }
+
+  if (srsran_tdec_init(&tdec, SRSRAN_TCOD_MAX_LEN_CB)) {
+    ERROR("Error initiating Turbo decoder");
+    goto clean_exit;
+  }
+
+  if (srsran_tdec_batch_init(&batch, SRSRAN_TCOD_MAX_LEN_CB)) {
+    ERROR("Error initiating batch Turbo decoder");
+    goto clean_exit;
+  }
+  srsran_tdec_batch_set_min_iterations(&batch, MIN_ITERATIONS);
+  srsran_tdec_batch_set_early_termination(&batch, early_stop);
+
+  srsran_rm_turbo_gentables();
+
+  for (uint32_t i = 0; i < nof_cb; i++) {
+    data_tx[i] = srsran_vec_u8_malloc(SRSRAN_TCOD_MAX_LEN_CB / 8);
+    data_rx[i] = srsran_vec_u8_malloc(SRSRAN_TCOD_MAX_LEN_CB / 8);
+    llr_rm[i]  = srsran_vec_i8_malloc(SOFTBUFFER_SIZE);
+    if (!data_tx[i] || !data_rx[i] || !llr_rm[i]) {
+      perror("malloc");
+      goto clean_exit;
+    }
+  }
+  ref_rx          = srsran_vec_u8_malloc(SRSRAN_TCOD_MAX_LEN_CB / 8);
+  parity          = srsran_vec_u8_malloc((3 * SRSRAN_TCOD_MAX_LEN_CB + 16) / 8);
+  w_buff          = srsran_vec_u8_malloc(SOFTBUFFER_SIZE);
+  e_bits          = srsran_vec_u8_malloc(max_e / 8 + 1);
+  e_bits_unpacked = srsran_vec_u8_malloc(max_e);
+  llr_f           = srsran_vec_f_malloc(max_e);
+  llr             = srsran_vec_i8_malloc(max_e);
+  if (!ref_rx || !parity || !w_buff || !e_bits || !e_bits_unpacked || !llr_f || !llr) {
+    perror("malloc");
+    goto clean_exit;
+  }
+
+  float esno_db = ebno_db + srsran_convert_power_to_dB(1.0f / 3.0f);
+  float var     = srsran_convert_dB_to_power(-esno_db);
+
+  printf("Batch of %d code blocks, %d lanes, EbNo: %.2f dB\n", nof_cb, srsran_tdec_batch_nof_lanes(&batch), ebno_db);
+
+  for (uint32_t frame = 0; frame < nof_frames; frame++) {
+    // Encode code blocks of random lengths
+    for (uint32_t i = 0; i < nof_cb; i++) {
+      uint32_t cb_idx  = (uint32_t)srsran_random_uniform_int_dist(random_gen, min_cb_idx, max_cb_idx);
+      uint32_t long_cb = (uint32_t)srsran_cbsegm_cbsize(cb_idx);
+      uint32_t e       = SRSRAN_TCOD_RATE * long_cb + SRSRAN_TCOD_TOTALTAIL;
+
+      srsran_random_byte_vector(random_gen, data_tx[i], (long_cb - 24) / 8);
+      srsran_tcod_encode_lut(&tcod, &crc_tb, &crc_cb, data_tx[i], parity, cb_idx, false);
+      srsran_rm_turbo_tx_lut(w_buff, data_tx[i], parity, e_bits, cb_idx, e, 0, 0);
+      srsran_bit_unpack_vector(e_bits, e_bits_unpacked, e);
+
+      for (uint32_t j = 0; j < e; j++) {
+        llr_f[j] = e_bits_unpacked[j] ? 1.0f : -1.0f;
+      }
+      srsran_ch_awgn_f(llr_f, llr_f, var, e);
+      for (uint32_t j = 0; j < e; j++) {
+        llr[j] = (int8_t)SRSRAN_MAX(SRSRAN_MIN(LLR_AMPLITUDE * llr_f[j], 127.0f), -127.0f);
+      }
+
+      srsran_vec_i8_zero(llr_rm[i], SOFTBUFFER_SIZE);
+      srsran_rm_turbo_rx_lut_8bit(llr, llr_rm[i], e, cb_idx, 0);
+
+      cbs[i].input          = llr_rm[i];
+      cbs[i].output         = data_rx[i];
+      cbs[i].long_cb        = long_cb;
+      cbs[i].crc            = &crc_cb;
+      cbs[i].crc_len        = long_cb;
+      cbs[i].max_iterations = 0;
+      nof_bits += long_cb;
+    }
+
+    // Batch decoder
+    gettimeofday(&t[1], NULL);
+    int n = srsran_tdec_batch_run(&batch, cbs, nof_cb, MAX_ITERATIONS);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    batch_usec += t[0].tv_sec * 1000000 + t[0].tv_usec;
+    if (n < SRSRAN_SUCCESS) {
+      ERROR("Error running batch decoder");
+      goto clean_exit;
+    }
+
+    for (uint32_t i = 0; i < nof_cb; i++) {
+      iterations_batch += cbs[i].nof_iterations;
+      if (!cbs[i].crc_ok || memcmp(data_tx[i], data_rx[i], cbs[i].long_cb / 8) != 0) {
+        errors_batch++;
+      }
+    }
+
+    // Reference decoder, one code block at a time with the same early stopping
+    gettimeofday(&t[1], NULL);
+    for (uint32_t i = 0; i < nof_cb; i++) {
+      bool     crc_ok = false;
+      uint32_t noi    = 0;
+      srsran_tdec_new_cb(&tdec, cbs[i].long_cb);
+      do {
+        srsran_tdec_iteration_8bit(&tdec, llr_rm[i], ref_rx);
+        noi++;
+        crc_ok = !srsran_crc_checksum_byte(&crc_cb, ref_rx, cbs[i].long_cb) && noi >= MIN_ITERATIONS;
+      } while (noi < MAX_ITERATIONS && !crc_ok);
+      iterations_ref += noi;
+      if (!crc_ok || memcmp(data_tx[i], ref_rx, cbs[i].long_cb / 8) != 0) {
+        errors_ref++;
+      }
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    ref_usec += t[0].tv_sec * 1000000 + t[0].tv_usec;
+  }
+
+  uint32_t total_cb = nof_frames * nof_cb;
+  printf("Batch:     BLER %.2e, %.2f iterations/CB, %.1f Mbps\n",
+         (float)errors_batch / total_cb,
+         (float)iterations_batch / total_cb,
+         (float)nof_bits / batch_usec);
+  printf("Reference: BLER %.2e, %.2f iterations/CB, %.1f Mbps\n",
+         (float)errors_ref / total_cb,
+         (float)iterations_ref / total_cb,
+         (float)nof_bits / ref_usec);
+
+  // The batch decoder shall not be worse than the reference decoder by more than 1% of the blocks
+  if (errors_batch > errors_ref + total_cb / 100) {
+    ERROR("Batch decoder failed %d blocks, reference decoder failed %d", errors_batch, errors_ref);
+    goto clean_exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  for (uint32_t i = 0; i < MAX_NOF_CB; i++) {
+    if (data_tx[i]) {
+      free(data_tx[i]);
+    }
+    if (data_rx[i]) {
+      free(data_rx[i]);
+    }
+    if (llr_rm[i]) {
+      free(llr_rm[i]);
+    }
+  }
+  if (ref_rx) {
+    free(ref_rx);
+  }
+  if (parity) {
+    free(parity);
+  }
+  if (w_buff) {
+    free(w_buff);
+  }
+  if (e_bits) {
+    free(e_bits);
+  }
+  if (e_bits_unpacked) {
+    free(e_bits_unpacked);
+  }
+  if (llr_f) {
+    free(llr_f);
+  }
+  if (llr) {
+    free(llr);
+  }
+  srsran_tdec_batch_free(&batch);
+  srsran_tdec_free(&tdec);
+  srsran_tcod_free(&tcod);
+  srsran_rm_turbo_free_tables();
+  srsran_random_free(random_gen);
+
+  printf("%s\n", ret ? "Failed" : "Ok");
+  return ret;
+}
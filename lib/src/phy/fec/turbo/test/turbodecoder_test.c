@@ -45,16 +45,28 @@ int nof_iterations  = MAX_ITERATIONS;
 int test_known_data = 0;
 int test_errors     = 0;
 int nof_repetitions = 1;
+int compare_impl    = 0;
 
 srsran_tdec_impl_type_t tdec_type;
 
+static const char* tdec_impl_name[SRSRAN_TDEC_NOF_IMP] = {"Auto",
+                                                          "Generic",
+                                                          "SSE",
+                                                          "SSE-window",
+                                                          "NEON-window",
+                                                          "AVX-window",
+                                                          "SSE8-window",
+                                                          "AVX8-window",
+                                                          "AVX512-window",
+                                                          "AVX512-8-window"};
+
 #define SNR_POINTS 4
 #define SNR_MIN 1.0
 #define SNR_MAX 8.0
 
 void usage(char* prog)
 {
-  printf("Usage: %s [kcinNledts]\n", prog);
+  printf("Usage: %s [kcinNledtsb]\n", prog);
   printf("\t-k Test with known data (ignores frame_length) [Default disabled]\n");
   printf("\t-c nof_cb in parallel [Default %d]\n", nof_cb);
   printf("\t-i nof_iterations [Default %d]\n", nof_iterations);
@@ -62,15 +74,17 @@ void usage(char* prog)
   printf("\t-N nof_repetitions [Default %d]\n", nof_repetitions);
   printf("\t-l frame_length [Default %d]\n", frame_length);
   printf("\t-e ebno in dB [Default scan]\n");
-  printf("\t-d Decoder implementation type: 0: Generic, 1: SSE, 2: SSE-window\n");
+  printf("\t-d Decoder implementation type: 0: Auto, 1: Generic, 2: SSE, 3: SSE-window, 4: NEON-window, 5: AVX-window, "
+         "6: SSE8-window, 7: AVX8-window, 8: AVX512-window, 9: AVX512-8-window\n");
   printf("\t-t test: check errors on exit [Default disabled]\n");
   printf("\t-s seed [Default 0=time]\n");
+  printf("\t-b compare the throughput of all the available implementations on exit [Default disabled]\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "kcinNledts")) != -1) {
+  while ((opt = getopt(argc, argv, "kcinNledtsb")) != -1) {
     switch (opt) {
       case 'c':
         nof_cb = (int)strtol(argv[optind], NULL, 10);
@@ -102,6 +116,9 @@ void parse_args(int argc, char** argv)
       case 's':
         seed = (uint32_t)strtoul(argv[optind], NULL, 0);
         break;
+      case 'b':
+        compare_impl = 1;
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -294,6 +311,50 @@ int main(int argc, char** argv)
     }
   }
 
+  // Decode the last frame with every implementation supported by this build
+  if (compare_impl) {
+    // 8-bit implementations take saturated 8-bit soft bits
+    srsran_vec_convert_fb(llr, 16, (int8_t*)llr_c, coded_length);
+
+    printf("\n%-24s %8s %12s %8s\n", "Implementation", "Errors", "usec", "Mbps");
+    for (int type = SRSRAN_TDEC_AUTO; type < SRSRAN_TDEC_NOF_IMP; type++) {
+      srsran_tdec_t tdec_cmp;
+      if (srsran_tdec_init_manual(&tdec_cmp, frame_length, (srsran_tdec_impl_type_t)type)) {
+        continue;
+      }
+
+      // Sub-block implementations need a frame length multiple of the number of sub-blocks
+      int nof_sb = SRSRAN_MAX(tdec_cmp.nof_blocks16[0], tdec_cmp.nof_blocks8[0]);
+      if (type != SRSRAN_TDEC_AUTO && nof_sb > 1 && (frame_length % nof_sb)) {
+        srsran_tdec_free(&tdec_cmp);
+        continue;
+      }
+      srsran_tdec_force_not_sb(&tdec_cmp);
+
+      uint32_t t = (nof_iterations == -1) ? MAX_ITERATIONS : nof_iterations;
+      gettimeofday(&tdata[1], NULL);
+      for (int k = 0; k < nof_repetitions; k++) {
+        if (tdec_cmp.nof_blocks8[0] > 0) {
+          srsran_tdec_run_all_8bit(&tdec_cmp, (int8_t*)llr_c, data_rx_bytes, t, frame_length);
+        } else {
+          srsran_tdec_run_all(&tdec_cmp, llr_s, data_rx_bytes, t, frame_length);
+        }
+      }
+      gettimeofday(&tdata[2], NULL);
+      get_time_interval(tdata);
+      mean_usec = (tdata[0].tv_sec * 1e6 + tdata[0].tv_usec) / nof_repetitions;
+
+      srsran_bit_unpack_vector(data_rx_bytes, data_rx, frame_length);
+      printf("%-24s %8d %12.2f %8.1f\n",
+             tdec_impl_name[type],
+             srsran_bit_diff(data_tx, data_rx, frame_length),
+             mean_usec,
+             (float)frame_length / mean_usec);
+
+      srsran_tdec_free(&tdec_cmp);
+    }
+  }
+
   free(data_rx_bytes);
   free(data_tx);
   free(symbols);
@@ -0,0 +1,609 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "srsran/phy/fec/turbo/turbodecoder_batch.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector.h"
+
+#define NUMSTATES 8
+#define TAIL 3
+
+#define TDEC_BATCH_INF 8192
+#define TDEC_BATCH_LLR_MAX 1024
+#define TDEC_BATCH_PAD_LLR (-127)
+#define TDEC_BATCH_MAX_CB 256
+#define TDEC_BATCH_DEFAULT_MIN_ITERATIONS 2
+
+/*
+ * Each lane of the SIMD registers holds a different code block. Without SIMD support the batch degenerates into one
+ * lane, which is the generic MAX-LOG-MAP decoder.
+ */
+#if SRSRAN_SIMD_S_SIZE
+#define NOF_LANES SRSRAN_SIMD_S_SIZE
+typedef simd_s_t lane_t;
+#define lane_load srsran_simd_s_load
+#define lane_store srsran_simd_s_store
+#define lane_add srsran_simd_s_add
+#define lane_sub srsran_simd_s_sub
+#define lane_max srsran_simd_s_max
+#define lane_min srsran_simd_s_min
+#define lane_set1 srsran_simd_s_set1
+#else /* SRSRAN_SIMD_S_SIZE */
+#define NOF_LANES 1
+typedef int16_t lane_t;
+static inline lane_t lane_load(const int16_t* ptr)
+{
+  return *ptr;
+}
+static inline void lane_store(int16_t* ptr, lane_t a)
+{
+  *ptr = a;
+}
+static inline lane_t lane_add(lane_t a, lane_t b)
+{
+  return (lane_t)(a + b);
+}
+static inline lane_t lane_sub(lane_t a, lane_t b)
+{
+  return (lane_t)(a - b);
+}
+static inline lane_t lane_max(lane_t a, lane_t b)
+{
+  return a > b ? a : b;
+}
+static inline lane_t lane_min(lane_t a, lane_t b)
+{
+  return a < b ? a : b;
+}
+static inline lane_t lane_set1(int16_t a)
+{
+  return a;
+}
+#endif /* SRSRAN_SIMD_S_SIZE */
+
+#define IDX(k, lane) ((k)*NOF_LANES + (lane))
+
+typedef struct {
+  srsran_tdec_batch_cb_t* cb;
+  uint32_t                offset;
+  uint16_t*               forward;
+  uint32_t                checksum; // CRC remainder of the previous hard decision
+} tdec_batch_lane_t;
+
+int srsran_tdec_batch_init(srsran_tdec_batch_t* q, uint32_t max_long_cb)
+{
+  if (q == NULL || max_long_cb == 0 || max_long_cb > SRSRAN_TCOD_MAX_LEN_CB) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  bzero(q, sizeof(srsran_tdec_batch_t));
+
+  q->max_long_cb    = max_long_cb;
+  q->nof_lanes      = NOF_LANES;
+  q->min_iterations = TDEC_BATCH_DEFAULT_MIN_ITERATIONS;
+
+  uint32_t len = (max_long_cb + TAIL + 1) * NOF_LANES;
+
+  q->syst    = srsran_vec_i16_malloc(len);
+  q->parity0 = srsran_vec_i16_malloc(len);
+  q->parity1 = srsran_vec_i16_malloc(len);
+  q->app1    = srsran_vec_i16_malloc(len);
+  q->app2    = srsran_vec_i16_malloc(len);
+  q->ext1    = srsran_vec_i16_malloc(len);
+  q->ext2    = srsran_vec_i16_malloc(len);
+  q->beta    = srsran_vec_i16_malloc(len * NUMSTATES);
+  if (!q->syst || !q->parity0 || !q->parity1 || !q->app1 || !q->app2 || !q->ext1 || !q->ext2 || !q->beta) {
+    perror("srsran_vec_malloc");
+    srsran_tdec_batch_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_tdec_batch_free(srsran_tdec_batch_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->syst) {
+    free(q->syst);
+  }
+  if (q->parity0) {
+    free(q->parity0);
+  }
+  if (q->parity1) {
+    free(q->parity1);
+  }
+  if (q->app1) {
+    free(q->app1);
+  }
+  if (q->app2) {
+    free(q->app2);
+  }
+  if (q->ext1) {
+    free(q->ext1);
+  }
+  if (q->ext2) {
+    free(q->ext2);
+  }
+  if (q->beta) {
+    free(q->beta);
+  }
+  for (uint32_t i = 0; i < SRSRAN_NOF_TC_CB_SIZES; i++) {
+    if (q->interleaver_ready[i]) {
+      srsran_tc_interl_free(&q->interleaver[i]);
+    }
+  }
+
+  bzero(q, sizeof(srsran_tdec_batch_t));
+}
+
+void srsran_tdec_batch_set_min_iterations(srsran_tdec_batch_t* q, uint32_t min_iterations)
+{
+  if (q) {
+    q->min_iterations = min_iterations;
+  }
+}
+
+void srsran_tdec_batch_set_early_termination(srsran_tdec_batch_t* q, bool enable)
+{
+  if (q) {
+    q->early_termination = enable;
+  }
+}
+
+uint32_t srsran_tdec_batch_nof_lanes(const srsran_tdec_batch_t* q)
+{
+  return q ? q->nof_lanes : 0;
+}
+
+static uint16_t* tdec_batch_get_interleaver(srsran_tdec_batch_t* q, uint32_t long_cb)
+{
+  int cb_idx = srsran_cbsegm_cbindex(long_cb);
+  if (cb_idx < 0 || cb_idx >= SRSRAN_NOF_TC_CB_SIZES) {
+    return NULL;
+  }
+
+  if (!q->interleaver_ready[cb_idx]) {
+    if (srsran_tc_interl_init(&q->interleaver[cb_idx], long_cb) < SRSRAN_SUCCESS) {
+      return NULL;
+    }
+    if (srsran_tc_interl_LTE_gen(&q->interleaver[cb_idx], long_cb) < SRSRAN_SUCCESS) {
+      srsran_tc_interl_free(&q->interleaver[cb_idx]);
+      return NULL;
+    }
+    q->interleaver_ready[cb_idx] = true;
+  }
+
+  return q->interleaver[cb_idx].forward;
+}
+
+/* MAX-LOG-MAP decoder running all the lanes in parallel. Same trellis as the generic implementation */
+static void
+tdec_batch_map(srsran_tdec_batch_t* q, int16_t* input, int16_t* app, int16_t* parity, int16_t* output, uint32_t len)
+{
+  int16_t* beta = q->beta;
+  lane_t   old[NUMSTATES], new[NUMSTATES], m_b[NUMSTATES];
+  lane_t   minus_inf = lane_set1(-TDEC_BATCH_INF);
+
+  // Backward recursion, the trellis is terminated on state 0
+  old[0] = lane_set1(0);
+  for (uint32_t i = 1; i < NUMSTATES; i++) {
+    old[i] = minus_inf;
+  }
+
+  for (int k = (int)(len + TAIL) - 1; k >= 0; k--) {
+    lane_t x = lane_load(&input[IDX(k, 0)]);
+    if (app && k < len) {
+      x = lane_add(x, lane_load(&app[IDX(k, 0)]));
+    }
+    lane_t y  = lane_load(&parity[IDX(k, 0)]);
+    lane_t xy = lane_add(x, y);
+
+    m_b[0] = lane_add(old[4], xy);
+    m_b[1] = old[4];
+    m_b[2] = lane_add(old[5], y);
+    m_b[3] = lane_add(old[5], x);
+    m_b[4] = lane_add(old[6], x);
+    m_b[5] = lane_add(old[6], y);
+    m_b[6] = old[7];
+    m_b[7] = lane_add(old[7], xy);
+
+    new[0] = old[0];
+    new[1] = lane_add(old[0], xy);
+    new[2] = lane_add(old[1], x);
+    new[3] = lane_add(old[1], y);
+    new[4] = lane_add(old[2], y);
+    new[5] = lane_add(old[2], x);
+    new[6] = lane_add(old[3], xy);
+    new[7] = old[3];
+
+    // Normalize every step, lanes carry blocks that may have very different reliabilities
+    lane_t norm = lane_max(m_b[0], new[0]);
+    for (uint32_t i = 0; i < NUMSTATES; i++) {
+      old[i] = lane_sub(lane_max(m_b[i], new[i]), norm);
+      lane_store(&beta[IDX(NUMSTATES * k + i, 0)], old[i]);
+    }
+  }
+
+  // Forward recursion, starts on state 0
+  old[0] = lane_set1(0);
+  for (uint32_t i = 1; i < NUMSTATES; i++) {
+    old[i] = minus_inf;
+  }
+
+  for (uint32_t k = 1; k < len + 1; k++) {
+    lane_t x = lane_load(&input[IDX(k - 1, 0)]);
+    if (app) {
+      x = lane_add(x, lane_load(&app[IDX(k - 1, 0)]));
+    }
+    lane_t y  = lane_load(&parity[IDX(k - 1, 0)]);
+    lane_t xy = lane_add(x, y);
+
+    m_b[0] = old[0];
+    m_b[1] = lane_add(old[3], y);
+    m_b[2] = lane_add(old[4], y);
+    m_b[3] = old[7];
+    m_b[4] = old[1];
+    m_b[5] = lane_add(old[2], y);
+    m_b[6] = lane_add(old[5], y);
+    m_b[7] = old[6];
+
+    new[0] = lane_add(old[1], xy);
+    new[1] = lane_add(old[2], x);
+    new[2] = lane_add(old[5], x);
+    new[3] = lane_add(old[6], xy);
+    new[4] = lane_add(old[0], xy);
+    new[5] = lane_add(old[3], x);
+    new[6] = lane_add(old[4], x);
+    new[7] = lane_add(old[7], xy);
+
+    lane_t b  = lane_load(&beta[IDX(NUMSTATES * k, 0)]);
+    lane_t m0 = lane_add(m_b[0], b);
+    lane_t m1 = lane_add(new[0], b);
+    for (uint32_t i = 1; i < NUMSTATES; i++) {
+      b  = lane_load(&beta[IDX(NUMSTATES * k + i, 0)]);
+      m0 = lane_max(m0, lane_add(m_b[i], b));
+      m1 = lane_max(m1, lane_add(new[i], b));
+    }
+
+    lane_t norm = lane_max(m_b[0], new[0]);
+    for (uint32_t i = 0; i < NUMSTATES; i++) {
+      old[i] = lane_sub(lane_max(m_b[i], new[i]), norm);
+    }
+
+    lane_store(&output[IDX(k - 1, 0)], lane_sub(m1, m0));
+  }
+}
+
+/* Copies one code block from the rate matching output layout into a lane, right-aligned to len */
+static void tdec_batch_load(srsran_tdec_batch_t* q, uint32_t lane, tdec_batch_lane_t* l, uint32_t len)
+{
+  int8_t*  input   = l->cb->input;
+  uint32_t long_cb = l->cb->long_cb;
+  uint32_t offset  = len - long_cb;
+#if SRSRAN_TDEC_EXPECT_INPUT_SB == 1
+  uint32_t nof_sb = srsran_tdec_autoimp_get_subblocks_8bit(long_cb);
+#else
+  uint32_t nof_sb = 0;
+#endif
+
+  l->offset = offset;
+
+  // Known zero bits before the block keep the trellis in the all-zero state
+  for (uint32_t k = 0; k < offset; k++) {
+    q->syst[IDX(k, lane)]    = TDEC_BATCH_PAD_LLR;
+    q->parity0[IDX(k, lane)] = TDEC_BATCH_PAD_LLR;
+    q->parity1[IDX(k, lane)] = TDEC_BATCH_PAD_LLR;
+    q->app2[IDX(k, lane)]    = TDEC_BATCH_PAD_LLR;
+    q->app1[IDX(k, lane)]    = 0;
+    q->ext1[IDX(k, lane)]    = 0;
+  }
+
+  uint32_t tail_offset;
+  if (nof_sb) {
+    // Sub-block layout, see interleave_table_sb() in rm_turbo.c
+    uint32_t sb_len = long_cb / nof_sb;
+    for (uint32_t j = 0; j < long_cb; j++) {
+      uint32_t s                        = (j % sb_len) * nof_sb + j / sb_len;
+      q->syst[IDX(offset + j, lane)]    = input[s];
+      q->parity0[IDX(offset + j, lane)] = input[(long_cb + 32) + s];
+      q->parity1[IDX(offset + j, lane)] = input[2 * (long_cb + 32) + s];
+    }
+    tail_offset = 3 * (long_cb + 32);
+  } else {
+    for (uint32_t j = 0; j < long_cb; j++) {
+      q->syst[IDX(offset + j, lane)]    = input[SRSRAN_TCOD_RATE * j];
+      q->parity0[IDX(offset + j, lane)] = input[SRSRAN_TCOD_RATE * j + 1];
+      q->parity1[IDX(offset + j, lane)] = input[SRSRAN_TCOD_RATE * j + 2];
+    }
+    tail_offset = SRSRAN_TCOD_RATE * long_cb;
+  }
+
+  // No apriori information for the first iteration
+  for (uint32_t k = offset; k < len + TAIL; k++) {
+    q->app1[IDX(k, lane)] = 0;
+    q->ext1[IDX(k, lane)] = 0;
+  }
+
+  for (uint32_t i = 0; i < TAIL; i++) {
+    q->syst[IDX(len + i, lane)]    = input[tail_offset + 2 * i];
+    q->parity0[IDX(len + i, lane)] = input[tail_offset + 2 * i + 1];
+    q->app2[IDX(len + i, lane)]    = input[tail_offset + 2 * TAIL + 2 * i];
+    q->parity1[IDX(len + i, lane)] = input[tail_offset + 2 * TAIL + 2 * i + 1];
+  }
+}
+
+/* Saturates the LLR of all lanes, keeps the sums of the next iterations in range */
+static void tdec_batch_saturate(int16_t* llr, uint32_t len)
+{
+  lane_t max = lane_set1(TDEC_BATCH_LLR_MAX);
+  lane_t min = lane_set1(-TDEC_BATCH_LLR_MAX);
+  for (uint32_t k = 0; k < len; k++) {
+    lane_store(&llr[IDX(k, 0)], lane_max(lane_min(lane_load(&llr[IDX(k, 0)]), max), min));
+  }
+}
+
+/* c = saturate(a - b) for all the lanes */
+static void tdec_batch_sub(int16_t* a, int16_t* b, int16_t* c, uint32_t len)
+{
+  lane_t max = lane_set1(TDEC_BATCH_LLR_MAX);
+  lane_t min = lane_set1(-TDEC_BATCH_LLR_MAX);
+  for (uint32_t k = 0; k < len; k++) {
+    lane_t x = lane_sub(lane_load(&a[IDX(k, 0)]), lane_load(&b[IDX(k, 0)]));
+    lane_store(&c[IDX(k, 0)], lane_max(lane_min(x, max), min));
+  }
+}
+
+/* Hard decision of the active lanes. Rows are traversed in order, so that all lanes share the cache lines */
+static void tdec_batch_decision(tdec_batch_lane_t* lanes,
+                                uint32_t*          active,
+                                uint32_t           nof_active,
+                                int16_t*           llr,
+                                uint32_t           min_offset,
+                                uint32_t           len)
+{
+  for (uint32_t k = min_offset; k < len; k += 8) {
+    for (uint32_t i = 0; i < nof_active; i++) {
+      uint32_t           lane = active[i];
+      tdec_batch_lane_t* l    = &lanes[lane];
+      if (k >= l->offset) {
+        uint8_t byte = 0;
+        for (uint32_t j = 0; j < 8; j++) {
+          byte |= (llr[IDX(k + j, lane)] > 0) ? (0x80 >> j) : 0;
+        }
+        l->cb->output[(k - l->offset) / 8] = byte;
+      }
+    }
+  }
+}
+
+static inline uint32_t tdec_batch_max_iterations(const srsran_tdec_batch_cb_t* cb, uint32_t max_iterations)
+{
+  return cb->max_iterations ? SRSRAN_MIN(cb->max_iterations, max_iterations) : max_iterations;
+}
+
+/* CRC check of a lane after a half iteration. Returns true if the lane is done */
+static bool tdec_batch_check(srsran_tdec_batch_t* q, tdec_batch_lane_t* l, uint32_t max_iterations)
+{
+  srsran_tdec_batch_cb_t* cb = l->cb;
+
+  if (cb->crc && cb->nof_iterations >= q->min_iterations) {
+    uint32_t checksum = srsran_crc_checksum_byte(cb->crc, cb->output, cb->crc_len);
+    if (!checksum) {
+      cb->crc_ok = true;
+      return true;
+    }
+
+    // The same remainder means the same hard decision as in the previous half iteration
+    if (q->early_termination && cb->nof_iterations > q->min_iterations && checksum == l->checksum) {
+      return true;
+    }
+    l->checksum = checksum;
+  }
+
+  return cb->nof_iterations >= tdec_batch_max_iterations(cb, max_iterations);
+}
+
+/* Runs the hard decision and CRC of the active lanes, and removes the lanes that are done */
+static uint32_t tdec_batch_retire(srsran_tdec_batch_t* q,
+                                  tdec_batch_lane_t*   lanes,
+                                  uint32_t*            active,
+                                  uint32_t             nof_active,
+                                  int16_t*             llr,
+                                  uint32_t             len,
+                                  uint32_t             max_iterations,
+                                  uint32_t*            nof_crc)
+{
+  uint32_t min_offset  = len;
+  bool     need_output = false;
+
+  // The decision is only needed by the lanes reaching a CRC check or the last iteration
+  for (uint32_t i = 0; i < nof_active; i++) {
+    srsran_tdec_batch_cb_t* cb = lanes[active[i]].cb;
+    cb->nof_iterations++;
+    if ((cb->crc && cb->nof_iterations >= q->min_iterations) ||
+        cb->nof_iterations >= tdec_batch_max_iterations(cb, max_iterations)) {
+      min_offset  = SRSRAN_MIN(min_offset, lanes[active[i]].offset);
+      need_output = true;
+    }
+  }
+
+  if (!need_output) {
+    return nof_active;
+  }
+
+  tdec_batch_decision(lanes, active, nof_active, llr, min_offset, len);
+
+  uint32_t n = 0;
+  for (uint32_t i = 0; i < nof_active; i++) {
+    tdec_batch_lane_t* l = &lanes[active[i]];
+    if (tdec_batch_check(q, l, max_iterations)) {
+      *nof_crc += l->cb->crc_ok ? 1 : 0;
+      l->cb = NULL;
+    } else {
+      active[n++] = active[i];
+    }
+  }
+
+  return n;
+}
+
+static int tdec_batch_run_chunk(srsran_tdec_batch_t*    q,
+                                srsran_tdec_batch_cb_t* cbs,
+                                uint32_t                nof_cbs,
+                                uint32_t                max_iterations)
+{
+  uint16_t          order[TDEC_BATCH_MAX_CB];
+  tdec_batch_lane_t lanes[NOF_LANES];
+  uint32_t          active[NOF_LANES];
+  uint32_t          nof_active = 0;
+  uint32_t          len        = 0;
+  uint32_t          next       = 0;
+  uint32_t          nof_crc    = 0;
+
+  // Schedule the longest blocks first, so that the blocks sharing lanes have similar lengths
+  for (uint32_t i = 0; i < nof_cbs; i++) {
+    uint32_t j = i;
+    while (j > 0 && cbs[order[j - 1]].long_cb < cbs[i].long_cb) {
+      order[j] = order[j - 1];
+      j--;
+    }
+    order[j] = (uint16_t)i;
+  }
+
+  bzero(lanes, sizeof(lanes));
+
+  while (next < nof_cbs || nof_active > 0) {
+    // Start a new batch sized for the longest pending block
+    if (nof_active == 0) {
+      len = cbs[order[next]].long_cb;
+      bzero(q->syst, sizeof(int16_t) * IDX(len + TAIL, 0));
+      bzero(q->parity0, sizeof(int16_t) * IDX(len + TAIL, 0));
+      bzero(q->parity1, sizeof(int16_t) * IDX(len + TAIL, 0));
+      bzero(q->app1, sizeof(int16_t) * IDX(len + TAIL, 0));
+      bzero(q->app2, sizeof(int16_t) * IDX(len + TAIL, 0));
+      bzero(q->ext1, sizeof(int16_t) * IDX(len + TAIL, 0));
+    }
+
+    // Refill idle lanes, as long as the block is not much shorter than the batch length
+    for (uint32_t lane = 0; lane < NOF_LANES && next < nof_cbs; lane++) {
+      if (lanes[lane].cb == NULL && 2 * cbs[order[next]].long_cb > len) {
+        lanes[lane].cb       = &cbs[order[next]];
+        lanes[lane].forward  = tdec_batch_get_interleaver(q, lanes[lane].cb->long_cb);
+        lanes[lane].checksum = 0;
+        if (lanes[lane].forward == NULL) {
+          ERROR("Error generating interleaver for long_cb=%d", lanes[lane].cb->long_cb);
+          return SRSRAN_ERROR;
+        }
+        tdec_batch_load(q, lane, &lanes[lane], len);
+        active[nof_active++] = lane;
+        next++;
+      }
+    }
+
+    /* Constituent decoder #1. Removes the decoder #1 output of the previous iteration from the apriori information.
+     * The extrinsic information of a lane is zero in the padding and before its first iteration. */
+    tdec_batch_sub(q->app1, q->ext1, q->app1, len);
+
+    tdec_batch_map(q, q->syst, q->app1, q->parity0, q->ext1, len);
+
+    nof_active = tdec_batch_retire(q, lanes, active, nof_active, q->ext1, len, max_iterations, &nof_crc);
+    if (nof_active == 0) {
+      continue;
+    }
+
+    // Convert aposteriori into extrinsic information, clean the padding and interleave it for decoder #2
+    for (uint32_t i = 0; i < nof_active; i++) {
+      tdec_batch_lane_t* l = &lanes[active[i]];
+      for (uint32_t k = 0; k < l->offset; k++) {
+        q->ext1[IDX(k, active[i])] = 0;
+      }
+    }
+    tdec_batch_sub(q->ext1, q->app1, q->ext1, len);
+
+    for (uint32_t i = 0; i < nof_active; i++) {
+      uint32_t           lane = active[i];
+      tdec_batch_lane_t* l    = &lanes[lane];
+      int16_t*           src  = &q->ext1[IDX(l->offset, lane)];
+      int16_t*           dst  = &q->app2[IDX(l->offset, lane)];
+      for (uint32_t j = 0; j < l->cb->long_cb; j++) {
+        dst[IDX(j, 0)] = src[IDX(l->forward[j], 0)];
+      }
+    }
+
+    // Constituent decoder #2, uses the apriori information as systematic bits
+    tdec_batch_map(q, q->app2, NULL, q->parity1, q->ext2, len);
+    tdec_batch_saturate(q->ext2, len);
+
+    // Deinterleaved output becomes the apriori information for decoder #1
+    for (uint32_t i = 0; i < nof_active; i++) {
+      uint32_t           lane = active[i];
+      tdec_batch_lane_t* l    = &lanes[lane];
+      int16_t*           src  = &q->ext2[IDX(l->offset, lane)];
+      int16_t*           dst  = &q->app1[IDX(l->offset, lane)];
+      for (uint32_t j = 0; j < l->cb->long_cb; j++) {
+        dst[IDX(l->forward[j], 0)] = src[IDX(j, 0)];
+      }
+    }
+
+    nof_active = tdec_batch_retire(q, lanes, active, nof_active, q->app1, len, max_iterations, &nof_crc);
+  }
+
+  return (int)nof_crc;
+}
+
+int srsran_tdec_batch_run(srsran_tdec_batch_t* q, srsran_tdec_batch_cb_t* cbs, uint32_t nof_cbs, uint32_t max_iterations)
+{
+  if (q == NULL || (cbs == NULL && nof_cbs > 0) || max_iterations == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  for (uint32_t i = 0; i < nof_cbs; i++) {
+    if (cbs[i].input == NULL || cbs[i].output == NULL || cbs[i].long_cb > q->max_long_cb ||
+        srsran_cbsegm_cbindex(cbs[i].long_cb) < 0) {
+      ERROR("Invalid code block %d in batch (long_cb=%d, max_long_cb=%d)", i, cbs[i].long_cb, q->max_long_cb);
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+    cbs[i].crc_ok         = false;
+    cbs[i].nof_iterations = 0;
+  }
+
+  int nof_crc = 0;
+  for (uint32_t i = 0; i < nof_cbs; i += TDEC_BATCH_MAX_CB) {
+    int n = tdec_batch_run_chunk(q, &cbs[i], SRSRAN_MIN(nof_cbs - i, TDEC_BATCH_MAX_CB), max_iterations);
+    if (n < SRSRAN_SUCCESS) {
+      return n;
+    }
+    nof_crc += n;
+  }
+
+  return nof_crc;
+}
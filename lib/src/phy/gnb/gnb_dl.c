@@ -231,6 +231,14 @@ void srsran_gnb_dl_gen_signal(srsran_gnb_dl_t* q)
     return;
   }
 
+  // An empty grid modulates into silence, the SSB is added afterwards in the time domain
+  if (q->sf_symbols_empty) {
+    for (uint32_t i = 0; i < q->nof_tx_antennas; i++) {
+      srsran_vec_cf_zero(q->fft[i].cfg.out_buffer, (uint32_t)q->fft[i].sf_sz);
+    }
+    return;
+  }
+
   float norm_factor = gnb_dl_get_norm_factor(q->pdsch.carrier.nof_prb);
 
   for (uint32_t i = 0; i < q->nof_tx_antennas; i++) {
@@ -255,6 +263,7 @@ int srsran_gnb_dl_base_zero(srsran_gnb_dl_t* q)
   for (uint32_t i = 0; i < q->nof_tx_antennas; i++) {
     srsran_vec_cf_zero(q->sf_symbols[i], SRSRAN_SLOT_LEN_RE_NR(q->carrier.nof_prb));
   }
+  q->sf_symbols_empty = true;
 
   return SRSRAN_SUCCESS;
 }
@@ -268,6 +277,7 @@ gnb_dl_pdcch_put_msg(srsran_gnb_dl_t* q, const srsran_slot_cfg_t* slot_cfg, cons
     return SRSRAN_ERROR;
   }
   srsran_coreset_t* coreset = &q->pdcch_cfg.coreset[dci_msg->ctx.coreset_id];
+  q->sf_symbols_empty       = false;
 
   if (srsran_pdcch_nr_set_carrier(&q->pdcch, &q->carrier, coreset) < SRSRAN_SUCCESS) {
     ERROR("Error setting PDCCH carrier/CORESET");
@@ -333,6 +343,8 @@ int srsran_gnb_dl_pdsch_put(srsran_gnb_dl_t*           q,
                             const srsran_sch_cfg_nr_t* cfg,
                             uint8_t*                   data[SRSRAN_MAX_TB])
 {
+  q->sf_symbols_empty = false;
+
   if (srsran_dmrs_sch_put_sf(&q->dmrs, slot, cfg, &cfg->grant, q->sf_symbols[0]) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
@@ -382,6 +394,8 @@ int srsran_gnb_dl_nzp_csi_rs_put(srsran_gnb_dl_t*                    q,
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
+  q->sf_symbols_empty = false;
+
   if (srsran_csi_rs_nzp_put_resource(&q->carrier, slot_cfg, resource, q->sf_symbols[0]) < SRSRAN_SUCCESS) {
     ERROR("Error putting NZP-CSI-RS resource");
     return SRSRAN_ERROR;
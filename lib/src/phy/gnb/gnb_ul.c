@@ -106,6 +106,32 @@ int srsran_gnb_ul_init(srsran_gnb_ul_t* q, cf_t* input, const srsran_gnb_ul_args
   return SRSRAN_SUCCESS;
 }
 
+int srsran_gnb_ul_init_pusch_decoder(srsran_gnb_ul_t* q, const srsran_gnb_ul_args_t* args)
+{
+  if (q == NULL || args == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (gnb_ul_alloc_prb(q, args->nof_max_prb) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_pusch_nr_init_gnb(&q->pusch, &args->pusch) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_dmrs_sch_init(&q->dmrs, true) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  q->pusch_min_snr_dB = GNB_UL_PUSCH_MIN_SNR_DEFAULT;
+  if (isnormal(args->pusch_min_snr_dB)) {
+    q->pusch_min_snr_dB = args->pusch_min_snr_dB;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 void srsran_gnb_ul_free(srsran_gnb_ul_t* q)
 {
   if (q == NULL) {
@@ -175,17 +201,56 @@ int srsran_gnb_ul_fft(srsran_gnb_ul_t* q)
   return SRSRAN_SUCCESS;
 }
 
+int srsran_gnb_ul_fft_symbols(srsran_gnb_ul_t* q, uint32_t first_symbol, uint32_t nof_symbols)
+{
+  if (q == NULL || nof_symbols == 0 || first_symbol + nof_symbols > SRSRAN_NSYMB_PER_SLOT_NR) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // The OFDM demodulator transforms the slot in halves of SRSRAN_CP_NORM_NSYMB symbols
+  uint32_t first_half = first_symbol / SRSRAN_CP_NORM_NSYMB;
+  uint32_t last_half  = (first_symbol + nof_symbols - 1) / SRSRAN_CP_NORM_NSYMB;
+  srsran_ofdm_rx_sf_slots(&q->fft, first_half, last_half - first_half + 1);
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_gnb_ul_get_pusch(srsran_gnb_ul_t*             q,
                             const srsran_slot_cfg_t*     slot_cfg,
                             const srsran_sch_cfg_nr_t*   cfg,
                             const srsran_sch_grant_nr_t* grant,
                             srsran_pusch_res_nr_t*       data)
 {
-  if (q == NULL || cfg == NULL || grant == NULL || data == NULL) {
+  return srsran_gnb_ul_get_pusch_grid(q, q, slot_cfg, cfg, grant, data);
+}
+
+int srsran_gnb_ul_get_pusch_grid(srsran_gnb_ul_t*             q,
+                                 const srsran_gnb_ul_t*       grid,
+                                 const srsran_slot_cfg_t*     slot_cfg,
+                                 const srsran_sch_cfg_nr_t*   cfg,
+                                 const srsran_sch_grant_nr_t* grant,
+                                 srsran_pusch_res_nr_t*       data)
+{
+  if (q == NULL || grid == NULL || cfg == NULL || grant == NULL || data == NULL) {
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
-  if (srsran_dmrs_sch_estimate(&q->dmrs, slot_cfg, cfg, grant, q->sf_symbols[0], &q->chest_pusch) < SRSRAN_SUCCESS) {
+  // A decoder shared by several cells follows the carrier of the grid, the estimator and the decoder only grow
+  if (q != grid && memcmp(&q->carrier, &grid->carrier, sizeof(srsran_carrier_nr_t)) != 0) {
+    q->carrier = grid->carrier;
+    if (gnb_ul_alloc_prb(q, grid->carrier.nof_prb) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    if (srsran_pusch_nr_set_carrier(&q->pusch, &grid->carrier) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    if (srsran_dmrs_sch_set_carrier(&q->dmrs, &grid->carrier) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  if (srsran_dmrs_sch_estimate(&q->dmrs, slot_cfg, cfg, grant, grid->sf_symbols[0], &q->chest_pusch) <
+      SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
@@ -198,7 +263,8 @@ int srsran_gnb_ul_get_pusch(srsran_gnb_ul_t*             q,
     return SRSRAN_SUCCESS;
   }
 
-  if (srsran_pusch_nr_decode(&q->pusch, cfg, grant, &q->chest_pusch, q->sf_symbols, data) < SRSRAN_SUCCESS) {
+  if (srsran_pusch_nr_decode(&q->pusch, cfg, grant, &q->chest_pusch, (cf_t**)grid->sf_symbols, data) <
+      SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
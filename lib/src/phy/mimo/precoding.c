@@ -62,6 +62,62 @@ int srsran_predecoding_single_avx(cf_t* y[SRSRAN_MAX_PORTS],
 
 static srsran_mimo_decoder_t mimo_decoder = SRSRAN_MIMO_DECODER_MMSE;
 
+/* 36.211 v10.3.0 Table 6.3.4.2.3-2: generating vectors u_n of the 4 antenna port codebook */
+#define PRECODING_4TX_NOF_CODEBOOKS 16
+#define PRECODING_4TX_A ((float)M_SQRT1_2)
+static const cf_t precoding_4tx_u[PRECODING_4TX_NOF_CODEBOOKS][4] = {
+    {1.0f, -1.0f, -1.0f, -1.0f},
+    {1.0f, -_Complex_I, 1.0f, _Complex_I},
+    {1.0f, 1.0f, -1.0f, 1.0f},
+    {1.0f, _Complex_I, 1.0f, -_Complex_I},
+    {1.0f, -PRECODING_4TX_A - PRECODING_4TX_A * _Complex_I, -_Complex_I, PRECODING_4TX_A - PRECODING_4TX_A * _Complex_I},
+    {1.0f, PRECODING_4TX_A - PRECODING_4TX_A * _Complex_I, _Complex_I, -PRECODING_4TX_A - PRECODING_4TX_A * _Complex_I},
+    {1.0f, PRECODING_4TX_A + PRECODING_4TX_A * _Complex_I, -_Complex_I, -PRECODING_4TX_A + PRECODING_4TX_A * _Complex_I},
+    {1.0f, -PRECODING_4TX_A + PRECODING_4TX_A * _Complex_I, _Complex_I, PRECODING_4TX_A + PRECODING_4TX_A * _Complex_I},
+    {1.0f, -1.0f, 1.0f, 1.0f},
+    {1.0f, -_Complex_I, -1.0f, -_Complex_I},
+    {1.0f, 1.0f, 1.0f, -1.0f},
+    {1.0f, _Complex_I, -1.0f, _Complex_I},
+    {1.0f, -1.0f, -1.0f, 1.0f},
+    {1.0f, -1.0f, 1.0f, -1.0f},
+    {1.0f, 1.0f, -1.0f, -1.0f},
+    {1.0f, 1.0f, 1.0f, 1.0f},
+};
+
+/* Columns of W_n = I - 2 u_n u_n' / (u_n' u_n) that form the precoding matrix of every number of layers */
+static const uint8_t precoding_4tx_columns[SRSRAN_MAX_LAYERS][PRECODING_4TX_NOF_CODEBOOKS][SRSRAN_MAX_LAYERS] = {
+    {{0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}},
+    {{0, 3}, {0, 1}, {0, 1}, {0, 1}, {0, 3}, {0, 3}, {0, 2}, {0, 2},
+     {0, 1}, {0, 3}, {0, 2}, {0, 2}, {0, 1}, {0, 2}, {0, 2}, {0, 1}},
+    {{0, 1, 3}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 3}, {0, 1, 3}, {0, 2, 3}, {0, 2, 3},
+     {0, 1, 3}, {0, 2, 3}, {0, 1, 2}, {0, 2, 3}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}},
+    {{0, 1, 2, 3}, {0, 1, 2, 3}, {2, 1, 0, 3}, {2, 1, 0, 3}, {0, 1, 2, 3}, {0, 1, 2, 3}, {0, 2, 1, 3}, {0, 2, 1, 3},
+     {0, 1, 2, 3}, {0, 1, 2, 3}, {0, 2, 1, 3}, {0, 2, 1, 3}, {0, 1, 2, 3}, {0, 2, 1, 3}, {2, 1, 0, 3}, {0, 1, 2, 3}},
+};
+
+/* Computes the 4 antenna port precoding matrix w[port][layer], including the 1/sqrt(nof_layers) normalization */
+static int precoding_4tx_matrix(int codebook_idx, int nof_layers, cf_t w[SRSRAN_MAX_PORTS][SRSRAN_MAX_LAYERS])
+{
+  if (codebook_idx < 0 || codebook_idx >= PRECODING_4TX_NOF_CODEBOOKS || nof_layers < 1 ||
+      nof_layers > SRSRAN_MAX_LAYERS) {
+    ERROR("Invalid 4 port codebook_idx=%d for %d layers", codebook_idx, nof_layers);
+    return SRSRAN_ERROR;
+  }
+
+  const cf_t* u    = precoding_4tx_u[codebook_idx];
+  float       norm = 1.0f / sqrtf((float)nof_layers);
+
+  for (int l = 0; l < nof_layers; l++) {
+    uint8_t c = precoding_4tx_columns[nof_layers - 1][codebook_idx][l];
+    for (int p = 0; p < SRSRAN_MAX_PORTS; p++) {
+      // u_n' u_n is 4 for all the vectors
+      w[p][l] = (((p == c) ? 1.0f : 0.0f) - u[p] * conjf(u[c]) / 2.0f) * norm;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 /************************************************
  *
  * RECEIVER SIDE FUNCTIONS
@@ -1811,6 +1867,103 @@ static int srsran_predecoding_multiplex_2x1_mrc_csi(cf_t*  y[SRSRAN_MAX_PORTS],
   return SRSRAN_SUCCESS;
 }
 
+// Implementation of the 4 antenna port Spatial Multiplexing equalizer, ZF or MMSE on the precoded channel
+static int srsran_predecoding_multiplex_4tx(cf_t*  y[SRSRAN_MAX_PORTS],
+                                            cf_t*  h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                                            cf_t*  x[SRSRAN_MAX_LAYERS],
+                                            float* csi[SRSRAN_MAX_CODEWORDS],
+                                            int    nof_rxant,
+                                            int    nof_layers,
+                                            int    codebook_idx,
+                                            int    nof_symbols,
+                                            float  scaling,
+                                            float  noise_estimate)
+{
+  cf_t w[SRSRAN_MAX_PORTS][SRSRAN_MAX_LAYERS];
+  if (precoding_4tx_matrix(codebook_idx, nof_layers, w) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  if (nof_rxant < nof_layers || nof_rxant > SRSRAN_MAT_NXL_MAX) {
+    ERROR("Error predecoding multiplex: %d layers cannot be separated with %d rx antennas", nof_layers, nof_rxant);
+    return SRSRAN_ERROR;
+  }
+
+  float norm  = 1.0f / scaling;
+  float noise = (mimo_decoder == SRSRAN_MIMO_DECODER_MMSE) ? noise_estimate : 0.0f;
+  int   i     = 0;
+
+#if SRSRAN_SIMD_CF_SIZE != 0
+  simd_cf_t _w[SRSRAN_MAX_PORTS][SRSRAN_MAX_LAYERS];
+  for (int p = 0; p < SRSRAN_MAX_PORTS; p++) {
+    for (int l = 0; l < nof_layers; l++) {
+      _w[p][l] = srsran_simd_cf_set1(w[p][l]);
+    }
+  }
+
+  for (; i < nof_symbols - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t _y[SRSRAN_MAT_NXL_MAX];
+    simd_cf_t _g[SRSRAN_MAT_NXL_MAX][SRSRAN_MAT_NXL_MAX];
+    simd_cf_t _x[SRSRAN_MAT_NXL_MAX];
+
+    // Effective channel from every layer to every rx antenna, G = H x W
+    for (int r = 0; r < nof_rxant; r++) {
+      _y[r] = srsran_simd_cfi_load(&y[r][i]);
+      for (int l = 0; l < nof_layers; l++) {
+        _g[r][l] = srsran_simd_cf_zero();
+      }
+      for (int p = 0; p < SRSRAN_MAX_PORTS; p++) {
+        simd_cf_t _h = srsran_simd_cfi_load(&h[p][r][i]);
+        for (int l = 0; l < nof_layers; l++) {
+          _g[r][l] = srsran_simd_cf_add(_g[r][l], srsran_simd_cf_prod(_h, _w[p][l]));
+        }
+      }
+    }
+
+    srsran_mat_NxL_mmse_simd(_y, _g, _x, nof_rxant, nof_layers, noise, norm);
+
+    for (int l = 0; l < nof_layers; l++) {
+      srsran_simd_cfi_store(&x[l][i], _x[l]);
+    }
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE != 0 */
+
+  for (; i < nof_symbols; i++) {
+    cf_t _y[SRSRAN_MAT_NXL_MAX];
+    cf_t _g[SRSRAN_MAT_NXL_MAX][SRSRAN_MAT_NXL_MAX];
+    cf_t _x[SRSRAN_MAT_NXL_MAX];
+
+    for (int r = 0; r < nof_rxant; r++) {
+      _y[r] = y[r][i];
+      for (int l = 0; l < nof_layers; l++) {
+        _g[r][l] = 0.0f;
+        for (int p = 0; p < SRSRAN_MAX_PORTS; p++) {
+          _g[r][l] += h[p][r][i] * w[p][l];
+        }
+      }
+    }
+
+    srsran_mat_NxL_mmse_gen(_y, _g, _x, nof_rxant, nof_layers, noise, norm);
+
+    for (int l = 0; l < nof_layers; l++) {
+      x[l][i] = _x[l];
+    }
+  }
+
+  // The equalizer does not estimate the post-equalization SINR, the CSI is flat
+  if (csi) {
+    for (int cw = 0; cw < SRSRAN_MAX_CODEWORDS; cw++) {
+      if (csi[cw]) {
+        for (int k = 0; k < nof_symbols; k++) {
+          csi[cw][k] = 1.0f;
+        }
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 static int srsran_predecoding_multiplex(cf_t*  y[SRSRAN_MAX_PORTS],
                                         cf_t*  h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
                                         cf_t*  x[SRSRAN_MAX_LAYERS],
@@ -1850,7 +2003,8 @@ static int srsran_predecoding_multiplex(cf_t*  y[SRSRAN_MAX_PORTS],
       }
     }
   } else if (nof_ports == 4) {
-    ERROR("Error predecoding multiplex: not implemented for %d Tx ports", nof_ports);
+    return srsran_predecoding_multiplex_4tx(
+        y, h, x, csi, nof_rxant, nof_layers, codebook_idx, nof_symbols, scaling, noise_estimate);
   } else {
     ERROR("Error predecoding multiplex: Invalid combination of ports %d and rx antennas %d", nof_ports, nof_rxant);
   }
@@ -2084,6 +2238,63 @@ int srsran_precoding_cdd(cf_t* x[SRSRAN_MAX_LAYERS],
   }
 }
 
+// Precoding of up to 4 layers into 4 antenna ports, y = W x X
+static int srsran_precoding_multiplex_4tx(cf_t*    x[SRSRAN_MAX_LAYERS],
+                                          cf_t*    y[SRSRAN_MAX_PORTS],
+                                          int      nof_layers,
+                                          int      codebook_idx,
+                                          uint32_t nof_symbols,
+                                          float    scaling)
+{
+  cf_t w[SRSRAN_MAX_PORTS][SRSRAN_MAX_LAYERS];
+  if (precoding_4tx_matrix(codebook_idx, nof_layers, w) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  for (int p = 0; p < SRSRAN_MAX_PORTS; p++) {
+    for (int l = 0; l < nof_layers; l++) {
+      w[p][l] *= scaling;
+    }
+  }
+
+  uint32_t i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE != 0
+  simd_cf_t _w[SRSRAN_MAX_PORTS][SRSRAN_MAX_LAYERS];
+  for (int p = 0; p < SRSRAN_MAX_PORTS; p++) {
+    for (int l = 0; l < nof_layers; l++) {
+      _w[p][l] = srsran_simd_cf_set1(w[p][l]);
+    }
+  }
+
+  for (; i + SRSRAN_SIMD_CF_SIZE < nof_symbols + 1; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t _x[SRSRAN_MAX_LAYERS];
+    for (int l = 0; l < nof_layers; l++) {
+      _x[l] = srsran_simd_cfi_load(&x[l][i]);
+    }
+
+    for (int p = 0; p < SRSRAN_MAX_PORTS; p++) {
+      simd_cf_t _y = srsran_simd_cf_prod(_x[0], _w[p][0]);
+      for (int l = 1; l < nof_layers; l++) {
+        _y = srsran_simd_cf_add(_y, srsran_simd_cf_prod(_x[l], _w[p][l]));
+      }
+      srsran_simd_cfi_store(&y[p][i], _y);
+    }
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE != 0 */
+
+  for (; i < nof_symbols; i++) {
+    for (int p = 0; p < SRSRAN_MAX_PORTS; p++) {
+      y[p][i] = 0.0f;
+      for (int l = 0; l < nof_layers; l++) {
+        y[p][i] += x[l][i] * w[p][l];
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_precoding_multiplex(cf_t*    x[SRSRAN_MAX_LAYERS],
                                cf_t*    y[SRSRAN_MAX_PORTS],
                                int      nof_layers,
@@ -2204,6 +2415,8 @@ int srsran_precoding_multiplex(cf_t*    x[SRSRAN_MAX_LAYERS],
     } else {
       ERROR("Not implemented");
     }
+  } else if (nof_ports == 4) {
+    return srsran_precoding_multiplex_4tx(x, y, nof_layers, codebook_idx, nof_symbols, scaling);
   } else {
     ERROR("Not implemented");
   }
@@ -2794,6 +3007,131 @@ int srsran_precoding_pmi_select(cf_t*     h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
   return ret;
 }
 
+int srsran_precoding_cov_estimate(cf_t*                   h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                                  uint32_t                nof_symbols,
+                                  uint32_t                decimation,
+                                  srsran_precoding_cov_t* cov)
+{
+  if (h == NULL || cov == NULL || nof_symbols == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  cf_t r00 = 0.0f;
+  cf_t r01 = 0.0f;
+  cf_t r11 = 0.0f;
+
+  if (decimation < 2) {
+    // R[p][q] = sum_rx conj(h[p][rx]) * h[q][rx], with the SIMD dot products
+    for (uint32_t rx = 0; rx < 2; rx++) {
+      r00 += srsran_vec_dot_prod_conj_ccc(h[0][rx], h[0][rx], nof_symbols);
+      r01 += srsran_vec_dot_prod_conj_ccc(h[1][rx], h[0][rx], nof_symbols);
+      r11 += srsran_vec_dot_prod_conj_ccc(h[1][rx], h[1][rx], nof_symbols);
+    }
+    cov->nof_re = nof_symbols;
+  } else {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < nof_symbols; i += decimation) {
+      for (uint32_t rx = 0; rx < 2; rx++) {
+        cf_t h0 = h[0][rx][i];
+        cf_t h1 = h[1][rx][i];
+        r00 += h0 * conjf(h0);
+        r01 += conjf(h0) * h1;
+        r11 += h1 * conjf(h1);
+      }
+      count++;
+    }
+    cov->nof_re = count;
+  }
+
+  float norm = 1.0f / (float)cov->nof_re;
+
+  cov->R[0][0] = crealf(r00) * norm;
+  cov->R[0][1] = r01 * norm;
+  cov->R[1][0] = conjf(r01) * norm;
+  cov->R[1][1] = crealf(r11) * norm;
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_precoding_pmi_select_cov(const srsran_precoding_cov_t* cov,
+                                    float                         noise_estimate,
+                                    int                           nof_layers,
+                                    uint32_t*                     pmi,
+                                    float                         sinr_list[SRSRAN_MAX_CODEBOOKS])
+{
+  // Second element of the 1 layer codebook vectors, the first one is always 1
+  static const cf_t codebook_1l[4] = {1.0f, -1.0f, _Complex_I, -_Complex_I};
+
+  // Second row of the 2 layer codebook matrices, the first one is always [1 1]
+  static const cf_t codebook_2l[2][2] = {{1.0f, -1.0f}, {_Complex_I, -_Complex_I}};
+
+  if (cov == NULL || cov->nof_re == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Bound noise estimate value
+  if (!isnormal(noise_estimate) || noise_estimate < 1e-9f) {
+    noise_estimate = 1e-9f;
+  }
+
+  float r00      = crealf(cov->R[0][0]);
+  float r11      = crealf(cov->R[1][1]);
+  cf_t  r01      = cov->R[0][1];
+  float max_sinr = 0.0f;
+  int   ret;
+
+  if (nof_layers == 1) {
+    for (uint32_t i = 0; i < 4; i++) {
+      // w' * R * w with w = [1 v]' / sqrt(2)
+      float sinr = (0.5f * (r00 + r11) + crealf(r01 * codebook_1l[i])) / noise_estimate;
+
+      if (sinr_list) {
+        sinr_list[i] = sinr;
+      }
+      if (pmi && sinr > max_sinr) {
+        max_sinr = sinr;
+        *pmi     = i;
+      }
+    }
+    ret = 4;
+  } else if (nof_layers == 2) {
+    for (uint32_t i = 0; i < 2; i++) {
+      // C = W' * R * W + noise * I, with W = [1 1; v0 v1] / 2
+      cf_t c[2][2];
+      for (uint32_t k = 0; k < 2; k++) {
+        for (uint32_t l = 0; l < 2; l++) {
+          cf_t vk = codebook_2l[i][k];
+          cf_t vl = codebook_2l[i][l];
+          c[k][l] = 0.25f * (r00 + conjf(vk) * conjf(r01) + r01 * vl + conjf(vk) * r11 * vl);
+        }
+      }
+      c[0][0] += noise_estimate;
+      c[1][1] += noise_estimate;
+
+      // MMSE SINR of each layer, gamma_k = 1 / (noise * inv(C)[k][k]) - 1
+      float det = SRSRAN_MAX(crealf(c[0][0] * c[1][1] - c[0][1] * c[1][0]), 1e-10f);
+
+      float gamma0 = SRSRAN_MAX(det / (noise_estimate * crealf(c[1][1])) - 1.0f, 1e-9f);
+      float gamma1 = SRSRAN_MAX(det / (noise_estimate * crealf(c[0][0])) - 1.0f, 1e-9f);
+      float sinr   = gamma0 + gamma1;
+
+      if (sinr_list) {
+        sinr_list[i] = sinr;
+      }
+      if (pmi && sinr > max_sinr) {
+        max_sinr = sinr;
+        *pmi     = i;
+      }
+    }
+    ret = 2;
+  } else {
+    ERROR("Unsupported number of layers");
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  return ret;
+}
+
 /* PMI Select for 1 layer */
 float srsran_precoding_2x2_cn_gen(cf_t* h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS], uint32_t nof_symbols)
 {
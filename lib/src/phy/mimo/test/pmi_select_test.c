@@ -137,6 +137,57 @@ int main(int argc, char** argv)
       goto clean;
     }
 
+    /* PMI select from the channel covariance, with and without decimation */
+    for (uint32_t decimation = 0; decimation < 8; decimation += 7) {
+      srsran_precoding_cov_t cov = {};
+      if (srsran_precoding_cov_estimate(h, nof_symbols, decimation, &cov)) {
+        ERROR("Test case %d covariance estimation returned error", c + 1);
+        goto clean;
+      }
+
+      for (uint32_t nof_layers = 1; nof_layers <= 2; nof_layers++) {
+        float*   sinr_gold = (nof_layers == 1) ? gold->snri_1l : gold->snri_2l;
+        float    sinr_cov[SRSRAN_MAX_CODEBOOKS];
+        uint32_t pmi_cov = 0;
+
+        ret = srsran_precoding_pmi_select_cov(&cov, noise_estimate, nof_layers, &pmi_cov, sinr_cov);
+        if (ret < 0) {
+          ERROR("During covariance PMI selection for %d layers", nof_layers);
+          goto clean;
+        }
+
+        for (int i = 0; i < ret; i++) {
+          float err = fabsf(sinr_gold[i] - sinr_cov[i]);
+
+          // Normalise to prevent floating point rounding error
+          if (sinr_gold[i] > 1000.0f) {
+            err /= sinr_gold[i];
+          }
+
+          if (err > 0.1f) {
+            ERROR("Test case %d failed computing %d layer covariance SINR for codebook %d (test=%.2f; gold=%.2f)",
+                  c + 1,
+                  nof_layers,
+                  i,
+                  sinr_cov[i],
+                  sinr_gold[i]);
+            ret = SRSRAN_ERROR;
+            goto clean;
+          }
+        }
+
+        if (pmi_cov != gold->pmi[nof_layers - 1]) {
+          ERROR("Test case %d failed computing %d layer covariance PMI (test=%d; gold=%d)",
+                c + 1,
+                nof_layers,
+                pmi_cov,
+                gold->pmi[nof_layers - 1]);
+          ret = SRSRAN_ERROR;
+          goto clean;
+        }
+      }
+    }
+
     /* Condition number */
     if (srsran_precoding_cn(h, 2, 2, nof_symbols, &cn)) {
       ERROR("Test case %d condition number returned error", c + 1);
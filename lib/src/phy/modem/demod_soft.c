@@ -23,6 +23,7 @@
 #include <stdlib.h>
 #include <strings.h>
 
+#include "srsran/phy/common/sequence.h"
 #include "srsran/phy/modem/demod_soft.h"
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
@@ -917,3 +918,61 @@ int srsran_demod_soft_demodulate_b(srsran_mod_t modulation, const cf_t* symbols,
   }
   return 0;
 }
+
+/**
+ * Number of symbols demodulated before descrambling them. The LLRs of a block stay in the L1 cache between both steps
+ * and, for any modulation, the block bits are a multiple of the 24 sequence bits generated per step.
+ */
+#define DEMOD_SOFT_DESCRAMBLE_BLOCK_NSYMB 240
+
+int srsran_demod_soft_demodulate_descramble_s(srsran_mod_t modulation,
+                                              const cf_t*  symbols,
+                                              short*       llr,
+                                              int          nsymbols,
+                                              uint32_t     seed)
+{
+  uint32_t nof_bits_x_symb = srsran_mod_bits_x_symbol(modulation);
+  if (nof_bits_x_symb == 0 || nsymbols < 0) {
+    ERROR("Invalid modulation %d", modulation);
+    return -1;
+  }
+
+  srsran_sequence_state_t sequence_state;
+  srsran_sequence_state_init(&sequence_state, seed);
+
+  for (int i = 0; i < nsymbols; i += DEMOD_SOFT_DESCRAMBLE_BLOCK_NSYMB) {
+    int    n     = SRSRAN_MIN(DEMOD_SOFT_DESCRAMBLE_BLOCK_NSYMB, nsymbols - i);
+    short* block = &llr[i * nof_bits_x_symb];
+    if (srsran_demod_soft_demodulate_s(modulation, &symbols[i], block, n)) {
+      return -1;
+    }
+    srsran_sequence_state_apply_s(&sequence_state, block, block, n * nof_bits_x_symb);
+  }
+  return 0;
+}
+
+int srsran_demod_soft_demodulate_descramble_b(srsran_mod_t modulation,
+                                              const cf_t*  symbols,
+                                              int8_t*      llr,
+                                              int          nsymbols,
+                                              uint32_t     seed)
+{
+  uint32_t nof_bits_x_symb = srsran_mod_bits_x_symbol(modulation);
+  if (nof_bits_x_symb == 0 || nsymbols < 0) {
+    ERROR("Invalid modulation %d", modulation);
+    return -1;
+  }
+
+  srsran_sequence_state_t sequence_state;
+  srsran_sequence_state_init(&sequence_state, seed);
+
+  for (int i = 0; i < nsymbols; i += DEMOD_SOFT_DESCRAMBLE_BLOCK_NSYMB) {
+    int     n     = SRSRAN_MIN(DEMOD_SOFT_DESCRAMBLE_BLOCK_NSYMB, nsymbols - i);
+    int8_t* block = &llr[i * nof_bits_x_symb];
+    if (srsran_demod_soft_demodulate_b(modulation, &symbols[i], block, n)) {
+      return -1;
+    }
+    srsran_sequence_state_apply_c(&sequence_state, block, block, n * nof_bits_x_symb);
+  }
+  return 0;
+}
@@ -195,6 +195,36 @@ int main(int argc, char** argv)
     }
   }
 
+  /* check that the fused demodulation and descrambling matches both steps done separately */
+  uint32_t num_symbols = num_bits / mod.nbits_x_symbol;
+  uint32_t seed        = 0x1234;
+  int8_t*  llr_b       = srsran_vec_i8_malloc(num_bits);
+  int8_t*  llr_b_fused = srsran_vec_i8_malloc(num_bits);
+  int16_t* llr_s       = srsran_vec_i16_malloc(num_bits);
+  int16_t* llr_s_fused = srsran_vec_i16_malloc(num_bits);
+  if (!llr_b || !llr_b_fused || !llr_s || !llr_s_fused) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  srsran_demod_soft_demodulate_b(modulation, symbols, llr_b, num_symbols);
+  srsran_sequence_apply_c(llr_b, llr_b, num_bits, seed);
+  srsran_demod_soft_demodulate_descramble_b(modulation, symbols, llr_b_fused, num_symbols, seed);
+  srsran_demod_soft_demodulate_s(modulation, symbols, llr_s, num_symbols);
+  srsran_sequence_apply_s(llr_s, llr_s, num_bits, seed);
+  srsran_demod_soft_demodulate_descramble_s(modulation, symbols, llr_s_fused, num_symbols, seed);
+
+  for (i = 0; i < num_bits && ret == SRSRAN_SUCCESS; i++) {
+    if (llr_b[i] != llr_b_fused[i] || llr_s[i] != llr_s_fused[i]) {
+      ERROR("Error in fused descrambling bit %d", i);
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+  free(llr_b);
+  free(llr_b_fused);
+  free(llr_s);
+  free(llr_s_fused);
   free(llr);
   free(symbols);
   free(symbols_bytes);
@@ -508,7 +508,7 @@ int srsran_npdsch_rm_and_decode(srsran_npdsch_t* q, srsran_npdsch_cfg_t* cfg, fl
 {
   // unrate-matching
   uint32_t coded_len = 3 * (cfg->grant.mcs[0].tbs + SRSRAN_NPDSCH_CRC_LEN);
-  bzero(q->rm_f, sizeof(float) * SRSRAN_NPDSCH_MAX_TBS_ENC);
+  srsran_vec_f_zero(q->rm_f, coded_len);
   srsran_rm_conv_rx(softbits, cfg->grant.nof_sf * cfg->nbits.nof_bits, q->rm_f, coded_len);
 
   // TODO: normalization needed?
@@ -113,15 +113,17 @@ static int pbch_nr_init_decoder(srsran_pbch_nr_t* q, const srsran_pbch_nr_args_t
     return SRSRAN_SUCCESS;
   }
 
-  srsran_polar_decoder_type_t decoder_type = SRSRAN_POLAR_DECODER_SSC_C;
+  uint8_t                     list_size    = (uint8_t)SRSRAN_MAX(args->polar_list_size, 1);
+  srsran_polar_decoder_type_t decoder_type = (list_size > 1) ? SRSRAN_POLAR_DECODER_SCL_C : SRSRAN_POLAR_DECODER_SSC_C;
 
 #ifdef LV_HAVE_AVX2
   if (!args->disable_simd) {
-    decoder_type = SRSRAN_POLAR_DECODER_SSC_C_AVX2;
+    decoder_type = (list_size > 1) ? SRSRAN_POLAR_DECODER_SCL_C_AVX2 : SRSRAN_POLAR_DECODER_SSC_C_AVX2;
   }
 #endif /* LV_HAVE_AVX2 */
 
-  if (srsran_polar_decoder_init(&q->polar_decoder, decoder_type, PBCH_NR_POLAR_N_MAX) < SRSRAN_SUCCESS) {
+  if (srsran_polar_decoder_init_list(&q->polar_decoder, decoder_type, PBCH_NR_POLAR_N_MAX, list_size) <
+      SRSRAN_SUCCESS) {
     ERROR("Error initiating polar decoder");
     return SRSRAN_ERROR;
   }
@@ -349,23 +351,38 @@ static int pbch_nr_polar_encode(srsran_pbch_nr_t* q, const uint8_t c[PBCH_NR_K],
 
 static int pbch_nr_polar_decode(srsran_pbch_nr_t* q, const int8_t d[PBCH_NR_N], uint8_t c[PBCH_NR_K])
 {
-  // Decode bits
-  uint8_t allocated[PBCH_NR_N];
-  if (srsran_polar_decoder_decode_c(&q->polar_decoder, d, allocated, q->code.n, q->code.F_set, q->code.F_set_size) <
-      SRSRAN_SUCCESS) {
+  // Decode bits, the list decoder returns the candidates sorted from the most likely
+  uint8_t allocated[PBCH_NR_N * SRSRAN_POLAR_DECODER_LIST_SIZE_MAX];
+  int     nof_candidates = srsran_polar_decoder_decode_list_c(
+      &q->polar_decoder, d, allocated, q->code.n, q->code.F_set, q->code.F_set_size);
+  if (nof_candidates < 1) {
     return SRSRAN_ERROR;
   }
 
-  if (get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
-    PBCH_NR_DEBUG_RX("Allocated: ");
-    srsran_vec_fprint_byte(stdout, allocated, PBCH_NR_N);
+  for (int i = 0; i < nof_candidates; i++) {
+    const uint8_t* candidate = &allocated[i * PBCH_NR_N];
+
+    if (get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
+      PBCH_NR_DEBUG_RX("Allocated: ");
+      srsran_vec_fprint_byte(stdout, candidate, PBCH_NR_N);
+    }
+
+    // Allocate channel
+    uint8_t c_prime[SRSRAN_POLAR_INTERLEAVER_K_MAX_IL];
+    srsran_polar_chanalloc_rx(candidate, c_prime, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
+
+    // Interleave
+    srsran_polar_interleaver_run_u8(c_prime, c, PBCH_NR_K, false);
+
+    // Keep the first candidate that passes the CRC, the most likely one is kept otherwise
+    if (nof_candidates == 1 || srsran_crc_match(&q->crc, c, PBCH_NR_A)) {
+      return SRSRAN_SUCCESS;
+    }
   }
 
-  // Allocate channel
+  // Restore the most likely candidate
   uint8_t c_prime[SRSRAN_POLAR_INTERLEAVER_K_MAX_IL];
   srsran_polar_chanalloc_rx(allocated, c_prime, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
-
-  // Interleave
   srsran_polar_interleaver_run_u8(c_prime, c, PBCH_NR_K, false);
 
   return SRSRAN_SUCCESS;
@@ -369,6 +369,37 @@ int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t
   }
 }
 
+/* Decodes a candidate, or reuses the result if the same location was already decoded with the same size. DCI formats
+ * of equal size share the same coded bits, so the blind search only pays one Viterbi decoding per size and location.
+ */
+static int pdcch_decode_candidate(srsran_pdcch_t*              q,
+                                  const srsran_dci_location_t* location,
+                                  uint32_t                     e_bits,
+                                  uint32_t                     nof_bits,
+                                  uint8_t*                     payload,
+                                  uint16_t*                    crc_rem)
+{
+  for (uint32_t i = 0; i < q->nof_decoded; i++) {
+    srsran_pdcch_decoded_t* d = &q->decoded[i];
+    if (d->location.ncce == location->ncce && d->location.L == location->L && d->nof_bits == nof_bits) {
+      srsran_vec_u8_copy(payload, d->payload, nof_bits);
+      *crc_rem = d->crc_rem;
+      q->nof_decoded_hits++;
+      return SRSRAN_SUCCESS;
+    }
+  }
+
+  int ret = srsran_pdcch_dci_decode(q, &q->llr[location->ncce * 72], payload, e_bits, nof_bits, crc_rem);
+  if (ret == SRSRAN_SUCCESS && q->nof_decoded < SRSRAN_PDCCH_MAX_DECODED_CANDIDATES) {
+    srsran_pdcch_decoded_t* d = &q->decoded[q->nof_decoded++];
+    d->location               = *location;
+    d->nof_bits               = nof_bits;
+    d->crc_rem                = *crc_rem;
+    srsran_vec_u8_copy(d->payload, payload, nof_bits);
+  }
+  return ret;
+}
+
 /** Tries to decode a DCI message from the LLRs stored in the srsran_pdcch_t structure by the function
  * srsran_pdcch_extract_llr(). This function can be called multiple times.
  * The location to search for is obtained from msg.
@@ -395,7 +426,7 @@ int srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dc
       mean /= e_bits;
 
       if (mean > 0.3f) {
-        ret = srsran_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
+        ret = pdcch_decode_candidate(q, &msg->location, e_bits, nof_bits, msg->payload, &msg->rnti);
         if (ret == SRSRAN_SUCCESS) {
           msg->nof_bits = nof_bits;
           // Check format differentiation
@@ -463,6 +494,9 @@ int srsran_pdcch_extract_llr(srsran_pdcch_t*        q,
     ret             = SRSRAN_ERROR;
     srsran_vec_f_zero(q->llr, q->max_bits);
 
+    /* previously decoded candidates are no longer valid */
+    q->nof_decoded = 0;
+
     DEBUG("Extracting LLRs: E: %d, SF: %d, CFI: %d", e_bits, sf->tti % 10, sf->cfi);
 
     /* number of layers equals number of ports */
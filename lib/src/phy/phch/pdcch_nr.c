@@ -173,7 +173,8 @@ static int pdcch_nr_init_common(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args
     return SRSRAN_ERROR;
   }
 
-  q->allocated = srsran_vec_u8_malloc(NMAX);
+  // The decoder provides up to one candidate per path
+  q->allocated = srsran_vec_u8_malloc(NMAX * SRSRAN_MAX(args->polar_list_size, 1));
   if (q->allocated == NULL) {
     return SRSRAN_ERROR;
   }
@@ -227,14 +228,19 @@ int srsran_pdcch_nr_init_rx(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args_t*
   }
 
   srsran_polar_decoder_type_t decoder_type = SRSRAN_POLAR_DECODER_SSC_C;
+  uint32_t                    list_size    = SRSRAN_MAX(args->polar_list_size, 1);
+
+  if (list_size > 1) {
+    decoder_type = SRSRAN_POLAR_DECODER_SCL_C;
+  }
 
 #ifdef LV_HAVE_AVX2
   if (!args->disable_simd) {
-    decoder_type = SRSRAN_POLAR_DECODER_SSC_C_AVX2;
+    decoder_type = (list_size > 1) ? SRSRAN_POLAR_DECODER_SCL_C_AVX2 : SRSRAN_POLAR_DECODER_SSC_C_AVX2;
   }
 #endif // LV_HAVE_AVX2
 
-  if (srsran_polar_decoder_init(&q->decoder, decoder_type, NMAX_LOG) < SRSRAN_SUCCESS) {
+  if (srsran_polar_decoder_init_list(&q->decoder, decoder_type, NMAX_LOG, list_size) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
@@ -246,6 +252,13 @@ int srsran_pdcch_nr_init_rx(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args_t*
     q->evm_buffer = srsran_evm_buffer_alloc(SRSRAN_PDCCH_MAX_RE * 2);
   }
 
+  for (uint32_t i = 0; i < SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR; i++) {
+    q->cache[i].llr = srsran_vec_i8_malloc(SRSRAN_PDCCH_MAX_RE * 2);
+    if (q->cache[i].llr == NULL) {
+      return SRSRAN_ERROR;
+    }
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -291,6 +304,12 @@ void srsran_pdcch_nr_free(srsran_pdcch_nr_t* q)
     srsran_evm_free(q->evm_buffer);
   }
 
+  for (uint32_t i = 0; i < SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR; i++) {
+    if (q->cache[i].llr) {
+      free(q->cache[i].llr);
+    }
+  }
+
   SRSRAN_MEM_ZERO(q, srsran_pdcch_nr_t, 1);
 }
 
@@ -313,6 +332,28 @@ int srsran_pdcch_nr_set_carrier(srsran_pdcch_nr_t*         q,
   return SRSRAN_SUCCESS;
 }
 
+void srsran_pdcch_nr_cache_reset(srsran_pdcch_nr_t* q)
+{
+  if (q == NULL || q->is_tx) {
+    return;
+  }
+
+  q->cache_en    = true;
+  q->cache_count = 0;
+}
+
+static srsran_pdcch_nr_cache_t* pdcch_nr_cache_find(srsran_pdcch_nr_t* q, const srsran_dci_location_t* location)
+{
+  for (uint32_t i = 0; i < q->cache_count; i++) {
+    srsran_pdcch_nr_cache_t* entry = &q->cache[i];
+    if (entry->coreset_id == q->coreset.id && entry->location.L == location->L &&
+        entry->location.ncce == location->ncce) {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
 static int pdcch_nr_cce_to_reg_mapping_non_interleaved(const srsran_coreset_t*      coreset,
                                                        const srsran_dci_location_t* dci_location,
                                                        bool                         rb_mask[SRSRAN_MAX_PRB_NR])
@@ -569,38 +610,56 @@ int srsran_pdcch_nr_encode(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_
   return SRSRAN_SUCCESS;
 }
 
-int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
-                           cf_t*                   slot_symbols,
-                           srsran_dmrs_pdcch_ce_t* ce,
-                           srsran_dci_msg_nr_t*    dci_msg,
-                           srsran_pdcch_nr_res_t*  res)
+/**
+ * @brief Extracts the message of a decoded polar candidate into q->c and checks its CRC
+ */
+static bool pdcch_nr_check_candidate(srsran_pdcch_nr_t* q, const uint8_t* allocated, const srsran_dci_msg_nr_t* dci_msg)
 {
-  if (q == NULL || dci_msg == NULL || ce == NULL || slot_symbols == NULL || res == NULL) {
-    return SRSRAN_ERROR;
-  }
+  // De-allocate channel
+  uint8_t c_prime[SRSRAN_POLAR_INTERLEAVER_K_MAX_IL];
+  srsran_polar_chanalloc_rx(allocated, c_prime, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
 
-  struct timeval t[3];
-  if (q->meas_time_en) {
-    gettimeofday(&t[1], NULL);
-  }
+  // Set first L bits to ones, c will have an offset of 24 bits
+  uint8_t* c = q->c;
+  srsran_bit_unpack(UINT32_MAX, &c, 24U);
 
-  // Calculate...
-  q->K = dci_msg->nof_bits + 24U;                                  // Payload size including CRC
-  q->M = (1U << dci_msg->ctx.location.L) * (SRSRAN_NRE - 3U) * 6U; // Number of RE
-  q->E = q->M * 2;                                                 // Number of Rate-Matched bits
+  // De-interleave
+  srsran_polar_interleaver_run_u8(c_prime, c, q->K, false);
 
-  // Check number of estimates is correct
-  if (ce->nof_re != q->M) {
-    ERROR("Invalid number of channel estimates (%d != %d)", q->M, ce->nof_re);
-    return SRSRAN_ERROR;
+  // Print c
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
+    PDCCH_INFO_RX("c_prime=");
+    srsran_vec_fprint_hex(stdout, c_prime, q->K);
+    PDCCH_INFO_RX("c=");
+    srsran_vec_fprint_hex(stdout, c, q->K);
   }
 
-  // Get polar code
-  if (srsran_polar_code_get(&q->code, q->K, q->E, 9U) < SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
+  // Unpack RNTI
+  uint8_t  unpacked_rnti[16] = {};
+  uint8_t* ptr               = unpacked_rnti;
+  srsran_bit_unpack(dci_msg->ctx.rnti, &ptr, 16);
+
+  // De-Scramble CRC with RNTI
+  srsran_vec_xor_bbb(unpacked_rnti, &c[q->K - 16], &c[q->K - 16], 16);
+
+  // Check CRC
+  ptr                = &c[q->K - 24];
+  uint32_t checksum1 = srsran_crc_checksum(&q->crc24c, q->c, q->K);
+  uint32_t checksum2 = srsran_bit_pack(&ptr, 24);
+
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
+    PDCCH_INFO_RX("CRC={%06x, %06x};", checksum1, checksum2);
   }
-  PDCCH_INFO_RX("K=%d; E=%d; M=%d; n=%d;", q->K, q->E, q->M, q->code.n);
 
+  return checksum1 == checksum2;
+}
+
+static int pdcch_nr_demodulate(srsran_pdcch_nr_t*         q,
+                               cf_t*                      slot_symbols,
+                               srsran_dmrs_pdcch_ce_t*    ce,
+                               const srsran_dci_msg_nr_t* dci_msg,
+                               srsran_pdcch_nr_res_t*     res)
+{
   // Get symbols from grid
   uint32_t m = pdcch_nr_cp(q, &dci_msg->ctx.location, slot_symbols, q->symbols, false);
   if (q->M != m) {
@@ -639,6 +698,66 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
     llr[i] *= -1;
   }
 
+  // Keep the LLR for the next decodes of the candidate
+  if (q->cache_en && q->cache_count < SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR) {
+    srsran_pdcch_nr_cache_t* entry = &q->cache[q->cache_count++];
+    entry->coreset_id              = q->coreset.id;
+    entry->location                = dci_msg->ctx.location;
+    entry->evm                     = res->evm;
+    srsran_vec_i8_copy(entry->llr, llr, q->E);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
+                           cf_t*                   slot_symbols,
+                           srsran_dmrs_pdcch_ce_t* ce,
+                           srsran_dci_msg_nr_t*    dci_msg,
+                           srsran_pdcch_nr_res_t*  res)
+{
+  if (q == NULL || dci_msg == NULL || ce == NULL || slot_symbols == NULL || res == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  struct timeval t[3];
+  if (q->meas_time_en) {
+    gettimeofday(&t[1], NULL);
+  }
+
+  // Calculate...
+  uint32_t prev_K = q->K;
+  uint32_t prev_E = q->E;
+  q->K            = dci_msg->nof_bits + 24U;                                  // Payload size including CRC
+  q->M            = (1U << dci_msg->ctx.location.L) * (SRSRAN_NRE - 3U) * 6U; // Number of RE
+  q->E            = q->M * 2;                                                 // Number of Rate-Matched bits
+
+  // Check number of estimates is correct
+  if (ce->nof_re != q->M) {
+    ERROR("Invalid number of channel estimates (%d != %d)", q->M, ce->nof_re);
+    return SRSRAN_ERROR;
+  }
+
+  // Get polar code, only if it changed. Blind decoding tries consecutively the candidates with the same aggregation
+  // level and DCI size, so most of the candidates reuse the code of the previous one
+  if (q->K != prev_K || q->E != prev_E) {
+    if (srsran_polar_code_get(&q->code, q->K, q->E, 9U) < SRSRAN_SUCCESS) {
+      q->K = 0;
+      return SRSRAN_ERROR;
+    }
+  }
+  PDCCH_INFO_RX("K=%d; E=%d; M=%d; n=%d;", q->K, q->E, q->M, q->code.n);
+
+  // The candidate was already demodulated in this slot, for another DCI size or RNTI
+  int8_t*                  llr    = (int8_t*)q->f;
+  srsran_pdcch_nr_cache_t* cached = q->cache_en ? pdcch_nr_cache_find(q, &dci_msg->ctx.location) : NULL;
+  if (cached != NULL) {
+    srsran_vec_i8_copy(llr, cached->llr, q->E);
+    res->evm = cached->evm;
+  } else if (pdcch_nr_demodulate(q, slot_symbols, ce, dci_msg, res) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   // Descrambling
   srsran_sequence_apply_c(llr, llr, q->E, pdcch_nr_c_init(q, dci_msg));
 
@@ -655,46 +774,24 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
   }
 
   // Decode
-  if (srsran_polar_decoder_decode_c(&q->decoder, d, q->allocated, q->code.n, q->code.F_set, q->code.F_set_size) <
-      SRSRAN_SUCCESS) {
+  int nof_candidates =
+      srsran_polar_decoder_decode_list_c(&q->decoder, d, q->allocated, q->code.n, q->code.F_set, q->code.F_set_size);
+  if (nof_candidates < 1) {
     return SRSRAN_ERROR;
   }
 
-  // De-allocate channel
-  uint8_t c_prime[SRSRAN_POLAR_INTERLEAVER_K_MAX_IL];
-  srsran_polar_chanalloc_rx(q->allocated, c_prime, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
-
-  // Set first L bits to ones, c will have an offset of 24 bits
-  uint8_t* c = q->c;
-  srsran_bit_unpack(UINT32_MAX, &c, 24U);
-
-  // De-interleave
-  srsran_polar_interleaver_run_u8(c_prime, c, q->K, false);
-
-  // Print c
-  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
-    PDCCH_INFO_RX("c_prime=");
-    srsran_vec_fprint_hex(stdout, c_prime, q->K);
-    PDCCH_INFO_RX("c=");
-    srsran_vec_fprint_hex(stdout, c, q->K);
+  // Select the first candidate matching the CRC, candidates are sorted by likelihood
+  for (int i = 0; i < nof_candidates; i++) {
+    res->crc = pdcch_nr_check_candidate(q, q->allocated + i * q->code.N, dci_msg);
+    if (res->crc) {
+      break;
+    }
   }
 
-  // Unpack RNTI
-  uint8_t  unpacked_rnti[16] = {};
-  uint8_t* ptr               = unpacked_rnti;
-  srsran_bit_unpack(dci_msg->ctx.rnti, &ptr, 16);
-
-  // De-Scramble CRC with RNTI
-  srsran_vec_xor_bbb(unpacked_rnti, &c[q->K - 16], &c[q->K - 16], 16);
-
-  // Check CRC
-  ptr                = &c[q->K - 24];
-  uint32_t checksum1 = srsran_crc_checksum(&q->crc24c, q->c, q->K);
-  uint32_t checksum2 = srsran_bit_pack(&ptr, 24);
-  res->crc           = checksum1 == checksum2;
-
+  // The message starts after the 24 leading ones
+  uint8_t* c = q->c + 24U;
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
-    PDCCH_INFO_RX("CRC={%06x, %06x}; msg=", checksum1, checksum2);
+    PDCCH_INFO_RX("crc=%s; candidates=%d; msg=", res->crc ? "OK" : "KO", nof_candidates);
     srsran_vec_fprint_hex(stdout, c, dci_msg->nof_bits);
   }
 
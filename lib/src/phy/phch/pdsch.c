@@ -29,9 +29,9 @@
 #include <pthread.h>
 #include <semaphore.h>
 
-#include "prb_dl.h"
 #include "srsran/phy/phch/pdsch.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/stage_prof.h"
 #include "srsran/phy/utils/vector.h"
 
 #ifdef LV_HAVE_SSE
@@ -133,17 +133,99 @@ static inline uint32_t pdsch_cp_crs_offset(const srsran_cell_t* cell, uint32_t l
   return cell->id % 3;
 }
 
-static int srsran_pdsch_cp(const srsran_pdsch_t*       q,
-                           cf_t*                       input,
-                           cf_t*                       output,
-                           const srsran_pdsch_grant_t* grant,
-                           uint32_t                    lstart_grant,
-                           uint32_t                    sf_idx,
-                           bool                        put)
+/* Contiguous grid REs carrying PDSCH */
+typedef struct {
+  uint32_t offset;
+  uint32_t len;
+} pdsch_re_run_t;
+
+/* Grid position of the PDSCH REs of the last grant, which is replayed while the allocation does not change */
+typedef struct {
+  bool            valid;
+  uint32_t        lstart;
+  uint32_t        sf_type;
+  uint32_t        nof_symb_slot[SRSRAN_NOF_SLOTS_PER_SF];
+  bool            prb_idx[SRSRAN_NOF_SLOTS_PER_SF][SRSRAN_MAX_PRB];
+  uint32_t        nof_re;
+  uint32_t        nof_runs;
+  uint32_t        max_runs;
+  pdsch_re_run_t* runs;
+} pdsch_re_map_t;
+
+/* Only these subframes carry synchronization signals or PBCH, the rest share the same mapping */
+static inline uint32_t pdsch_re_map_sf_type(uint32_t sf_idx)
+{
+  return (sf_idx == 0 || sf_idx == 1 || sf_idx == 5 || sf_idx == 6) ? sf_idx : SRSRAN_NOF_SF_X_FRAME;
+}
+
+static bool
+pdsch_re_map_match(const pdsch_re_map_t* m, const srsran_pdsch_grant_t* grant, uint32_t lstart, uint32_t sf_idx)
+{
+  return m->valid && m->lstart == lstart && m->sf_type == pdsch_re_map_sf_type(sf_idx) &&
+         memcmp(m->nof_symb_slot, grant->nof_symb_slot, sizeof(m->nof_symb_slot)) == 0 &&
+         memcmp(m->prb_idx, grant->prb_idx, sizeof(m->prb_idx)) == 0;
+}
+
+static inline void pdsch_re_map_push(pdsch_re_map_t* m, uint32_t offset, uint32_t len)
+{
+  if (len == 0) {
+    return;
+  }
+
+  // Extend the previous run if it ends right before
+  if (m->nof_runs > 0) {
+    pdsch_re_run_t* last = &m->runs[m->nof_runs - 1];
+    if (last->offset + last->len == offset) {
+      last->len += len;
+      m->nof_re += len;
+      return;
+    }
+  }
+
+  if (m->nof_runs < m->max_runs) {
+    m->runs[m->nof_runs].offset = offset;
+    m->runs[m->nof_runs].len    = len;
+    m->nof_runs++;
+    m->nof_re += len;
+  }
+}
+
+/* Pushes the REs [k0, k1) of a PRB symbol, skipping the CRS */
+static inline void pdsch_re_map_push_prb(pdsch_re_map_t* m,
+                                         uint32_t        offset,
+                                         uint32_t        k0,
+                                         uint32_t        k1,
+                                         bool            has_crs,
+                                         uint32_t        crs_offset,
+                                         uint32_t        crs_spacing)
 {
-  cf_t*    in_ptr   = input;
-  cf_t*    out_ptr  = output;
-  uint32_t nof_refs = (q->cell.nof_ports == 1) ? 2 : 4;
+  if (!has_crs) {
+    pdsch_re_map_push(m, offset + k0, k1 - k0);
+    return;
+  }
+
+  uint32_t k = k0;
+  for (uint32_t ref = crs_offset; ref < k1; ref += crs_spacing) {
+    if (ref >= k) {
+      pdsch_re_map_push(m, offset + k, ref - k);
+      k = ref + 1;
+    }
+  }
+  if (k < k1) {
+    pdsch_re_map_push(m, offset + k, k1 - k);
+  }
+}
+
+static void pdsch_re_map_build(const srsran_pdsch_t*       q,
+                               pdsch_re_map_t*             m,
+                               const srsran_pdsch_grant_t* grant,
+                               uint32_t                    lstart_grant,
+                               uint32_t                    sf_idx)
+{
+  uint32_t crs_spacing = SRSRAN_NRE / ((q->cell.nof_ports == 1) ? 2 : 4);
+
+  m->nof_re   = 0;
+  m->nof_runs = 0;
 
   // Iterate over slots
   for (uint32_t s = 0; s < SRSRAN_NOF_SLOTS_PER_SF; s++) {
@@ -162,46 +244,20 @@ static int srsran_pdsch_cp(const srsran_pdsch_t*       q,
       for (uint32_t n = 0; n < q->cell.nof_prb; n++) {
         // If this PRB is assigned
         if (grant->prb_idx[s][n]) {
-          bool skip = pdsch_cp_skip_symbol(&q->cell, grant, sf_idx, s, l, n);
-
-          // Get grid pointer
-          if (put) {
-            out_ptr = &output[(lp * q->cell.nof_prb + n) * SRSRAN_NRE];
-          } else {
-            in_ptr = &input[(lp * q->cell.nof_prb + n) * SRSRAN_NRE];
-          }
+          uint32_t offset = (lp * q->cell.nof_prb + n) * SRSRAN_NRE;
 
-          // This is a symbol in a normal PRB with or without references
-          if (!skip) {
-            if (has_crs) {
-              prb_cp_ref(&in_ptr, &out_ptr, crs_offset, nof_refs, nof_refs, put);
-            } else {
-              prb_cp(&in_ptr, &out_ptr, 1);
-            }
+          if (!pdsch_cp_skip_symbol(&q->cell, grant, sf_idx, s, l, n)) {
+            // This is a symbol in a normal PRB with or without references
+            pdsch_re_map_push_prb(m, offset, 0, SRSRAN_NRE, has_crs, crs_offset, crs_spacing);
           } else if (q->cell.nof_prb % 2 != 0) {
             // This is a symbol in a PRB with PBCH or Synch signals (SS).
             // If the number or total PRB is odd, half of the the PBCH or SS will fall into the symbol
             if (n == q->cell.nof_prb / 2 - 3) {
               // Lower sync block half RB
-              if (has_crs) {
-                prb_cp_ref(&in_ptr, &out_ptr, crs_offset, nof_refs, nof_refs / 2, put);
-              } else {
-                prb_cp_half(&in_ptr, &out_ptr, 1);
-              }
+              pdsch_re_map_push_prb(m, offset, 0, SRSRAN_NRE / 2, has_crs, crs_offset, crs_spacing);
             } else if (n == q->cell.nof_prb / 2 + 3) {
               // Upper sync block half RB
-              // Skip half RB on the grid
-              if (put) {
-                out_ptr += SRSRAN_NRE / 2;
-              } else {
-                in_ptr += SRSRAN_NRE / 2;
-              }
-
-              if (has_crs) {
-                prb_cp_ref(&in_ptr, &out_ptr, crs_offset, nof_refs, nof_refs / 2, put);
-              } else {
-                prb_cp_half(&in_ptr, &out_ptr, 1);
-              }
+              pdsch_re_map_push_prb(m, offset, SRSRAN_NRE / 2, SRSRAN_NRE, has_crs, crs_offset, crs_spacing);
             }
           }
         }
@@ -209,14 +265,50 @@ static int srsran_pdsch_cp(const srsran_pdsch_t*       q,
     }
   }
 
-  int r;
-  if (put) {
-    r = abs((int)(input - in_ptr));
-  } else {
-    r = abs((int)(output - out_ptr));
+  m->valid            = true;
+  m->lstart           = lstart_grant;
+  m->sf_type          = pdsch_re_map_sf_type(sf_idx);
+  m->nof_symb_slot[0] = grant->nof_symb_slot[0];
+  m->nof_symb_slot[1] = grant->nof_symb_slot[1];
+  memcpy(m->prb_idx, grant->prb_idx, sizeof(m->prb_idx));
+}
+
+static int srsran_pdsch_cp(srsran_pdsch_t*             q,
+                           cf_t*                       input,
+                           cf_t*                       output,
+                           const srsran_pdsch_grant_t* grant,
+                           uint32_t                    lstart_grant,
+                           uint32_t                    sf_idx,
+                           bool                        put)
+{
+  pdsch_re_map_t* m = (pdsch_re_map_t*)q->re_map_ptr;
+  if (m == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  // The mapping only depends on the allocation, so the channel estimates of every port and antenna, and the following
+  // subframes with the same allocation, replay it
+  if (!pdsch_re_map_match(m, grant, lstart_grant, sf_idx)) {
+    pdsch_re_map_build(q, m, grant, lstart_grant, sf_idx);
   }
 
-  return r;
+  cf_t* ptr = put ? input : output;
+  for (uint32_t i = 0; i < m->nof_runs; i++) {
+    const pdsch_re_run_t* run = &m->runs[i];
+    cf_t*                 dst = put ? &output[run->offset] : ptr;
+    const cf_t*           src = put ? ptr : &input[run->offset];
+    if (run->len < SRSRAN_NRE) {
+      // Short runs between CRS
+      for (uint32_t k = 0; k < run->len; k++) {
+        dst[k] = src[k];
+      }
+    } else {
+      memcpy(dst, src, sizeof(cf_t) * run->len);
+    }
+    ptr += run->len;
+  }
+
+  return (int)m->nof_re;
 }
 
 /**
@@ -321,6 +413,18 @@ static int pdsch_init(srsran_pdsch_t* q, uint32_t max_prb, bool is_ue, uint32_t
       }
     }
 
+    pdsch_re_map_t* re_map = calloc(1, sizeof(pdsch_re_map_t));
+    if (!re_map) {
+      ERROR("Allocating RE map");
+      goto clean;
+    }
+    q->re_map_ptr    = re_map;
+    re_map->max_runs = q->max_re;
+    re_map->runs     = SRSRAN_MEM_ALLOC(pdsch_re_run_t, re_map->max_runs);
+    if (!re_map->runs) {
+      goto clean;
+    }
+
     for (int i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
       if (!q->csi[i]) {
         q->csi[i] = srsran_vec_f_malloc(q->max_re * 2);
@@ -454,6 +558,14 @@ void srsran_pdsch_free(srsran_pdsch_t* q)
     srsran_modem_table_free(&q->mod[i]);
   }
 
+  pdsch_re_map_t* re_map = (pdsch_re_map_t*)q->re_map_ptr;
+  if (re_map) {
+    if (re_map->runs) {
+      free(re_map->runs);
+    }
+    free(re_map);
+  }
+
   bzero(q, sizeof(srsran_pdsch_t));
 }
 
@@ -465,6 +577,11 @@ int srsran_pdsch_set_cell(srsran_pdsch_t* q, srsran_cell_t cell)
     q->cell   = cell;
     q->max_re = q->cell.nof_prb * MAX_PDSCH_RE(q->cell.cp);
 
+    // The RE map depends on the cell
+    if (q->re_map_ptr) {
+      ((pdsch_re_map_t*)q->re_map_ptr)->valid = false;
+    }
+
     // Resize EVM buffer, only for UE
     if (q->is_ue) {
       for (int i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
@@ -690,12 +807,29 @@ static int srsran_pdsch_codeword_decode(srsran_pdsch_t*     q,
      * The MAX-log-MAP algorithm used in turbo decoding is unsensitive to SNR estimation,
      * thus we don't need tot set it in the LLRs normalization
      */
-    if (q->llr_is_8bit) {
-      srsran_demod_soft_demodulate_b(mcs->mod, q->d[codeword_idx], q->e[codeword_idx], cfg->grant.nof_re);
+    bool     meas_evm = cfg->meas_evm_en && q->evm_buffer[codeword_idx];
+    uint32_t seed =
+        srsran_sequence_pdsch_seed(cfg->rnti, codeword_idx, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id);
+    uint64_t t0 = srsran_stage_prof_start();
+    if (meas_evm) {
+      // The EVM is measured on the scrambled LLR, descrambling is done afterwards
+      if (q->llr_is_8bit) {
+        srsran_demod_soft_demodulate_b(mcs->mod, q->d[codeword_idx], q->e[codeword_idx], cfg->grant.nof_re);
+      } else {
+        srsran_demod_soft_demodulate_s(mcs->mod, q->d[codeword_idx], q->e[codeword_idx], cfg->grant.nof_re);
+      }
     } else {
-      srsran_demod_soft_demodulate_s(mcs->mod, q->d[codeword_idx], q->e[codeword_idx], cfg->grant.nof_re);
+      // Demodulation and descrambling in a single pass
+      if (q->llr_is_8bit) {
+        srsran_demod_soft_demodulate_descramble_b(
+            mcs->mod, q->d[codeword_idx], q->e[codeword_idx], cfg->grant.nof_re, seed);
+      } else {
+        srsran_demod_soft_demodulate_descramble_s(
+            mcs->mod, q->d[codeword_idx], q->e[codeword_idx], cfg->grant.nof_re, seed);
+      }
     }
-    if (cfg->meas_evm_en && q->evm_buffer[codeword_idx]) {
+    srsran_stage_prof_stop(SRSRAN_STAGE_PROF_DEMOD, t0);
+    if (meas_evm) {
       if (q->llr_is_8bit) {
         data[tb_idx].evm = srsran_evm_run_b(q->evm_buffer[codeword_idx],
                                             &q->mod[mcs->mod],
@@ -714,22 +848,12 @@ static int srsran_pdsch_codeword_decode(srsran_pdsch_t*     q,
     }
 
     /* Bit scrambling */
-    if (q->llr_is_8bit) {
-      srsran_sequence_pdsch_apply_c(q->e[codeword_idx],
-                                    q->e[codeword_idx],
-                                    cfg->rnti,
-                                    codeword_idx,
-                                    2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                    q->cell.id,
-                                    cfg->grant.tb[tb_idx].nof_bits);
-    } else {
-      srsran_sequence_pdsch_apply_s(q->e[codeword_idx],
-                                    q->e[codeword_idx],
-                                    cfg->rnti,
-                                    codeword_idx,
-                                    2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                    q->cell.id,
-                                    cfg->grant.tb[tb_idx].nof_bits);
+    if (meas_evm) {
+      if (q->llr_is_8bit) {
+        srsran_sequence_apply_c(q->e[codeword_idx], q->e[codeword_idx], cfg->grant.tb[tb_idx].nof_bits, seed);
+      } else {
+        srsran_sequence_apply_s(q->e[codeword_idx], q->e[codeword_idx], cfg->grant.tb[tb_idx].nof_bits, seed);
+      }
     }
 
     if (cfg->csi_enable) {
@@ -737,7 +861,9 @@ static int srsran_pdsch_codeword_decode(srsran_pdsch_t*     q,
     }
 
     /* Return  */
+    t0  = srsran_stage_prof_start();
     ret = srsran_dlsch_decode2(dl_sch, cfg, q->e[codeword_idx], data[tb_idx].payload, tb_idx, nof_layers);
+    srsran_stage_prof_stop(SRSRAN_STAGE_PROF_FEC, t0);
 
     if (ret == SRSRAN_SUCCESS) {
       *ack = true;
@@ -864,6 +990,7 @@ int srsran_pdsch_decode(srsran_pdsch_t*        q,
     }
 
     // Pre-decoder
+    uint64_t t0           = srsran_stage_prof_start();
     uint32_t codebook_idx = nof_tb == 1 ? cfg->grant.pmi : (cfg->grant.pmi + 1);
     if (srsran_predecoding_type(q->symbols,
                                 q->ce,
@@ -885,6 +1012,7 @@ int srsran_pdsch_decode(srsran_pdsch_t*        q,
     if (cfg->grant.nof_layers != nof_tb) {
       srsran_layerdemap_type(x, q->d, cfg->grant.nof_layers, nof_tb, nof_symbols[0], nof_symbols, cfg->grant.tx_scheme);
     }
+    srsran_stage_prof_stop(SRSRAN_STAGE_PROF_EQUALIZE, t0);
 
     /* Codeword decoding: Implementation of 3GPP 36.212 Table 5.3.3.1.5-1 and Table 5.3.3.1.5-2 */
     for (uint32_t tb_idx = 0; tb_idx < SRSRAN_MAX_TB; tb_idx++) {
@@ -988,24 +1116,25 @@ static int srsran_pdsch_codeword_encode(srsran_pdsch_t*         q,
            rv);
     }
 
-    /* Channel coding */
-    if (srsran_dlsch_encode2(&q->dl_sch, cfg, data, q->e[codeword_idx], tb_idx, nof_layers)) {
+    /* Channel coding, bit scrambling and bit mapping, run per code block while the bits are in cache */
+    uint64_t                t0 = srsran_stage_prof_start();
+    srsran_sequence_state_t scrambler;
+    srsran_sequence_state_init(
+        &scrambler,
+        srsran_sequence_pdsch_seed(cfg->rnti, codeword_idx, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id));
+    if (srsran_dlsch_encode2_modulate(&q->dl_sch,
+                                      cfg,
+                                      data,
+                                      q->e[codeword_idx],
+                                      tb_idx,
+                                      nof_layers,
+                                      &scrambler,
+                                      &q->mod[mcs->mod],
+                                      q->d[codeword_idx])) {
       ERROR("Error encoding (TB%d -> CW%d)", tb_idx, codeword_idx);
       return SRSRAN_ERROR;
     }
-
-    /* Bit scrambling */
-    srsran_sequence_pdsch_apply_pack((uint8_t*)q->e[codeword_idx],
-                                     (uint8_t*)q->e[codeword_idx],
-                                     cfg->rnti,
-                                     codeword_idx,
-                                     2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                     q->cell.id,
-                                     cfg->grant.tb[tb_idx].nof_bits);
-
-    /* Bit mapping */
-    srsran_mod_modulate_bytes(
-        &q->mod[mcs->mod], (uint8_t*)q->e[codeword_idx], q->d[codeword_idx], cfg->grant.tb[tb_idx].nof_bits);
+    srsran_stage_prof_stop(SRSRAN_STAGE_PROF_ENCODE, t0);
 
   } else {
     return SRSRAN_ERROR_INVALID_INPUTS;
@@ -1082,6 +1211,7 @@ int srsran_pdsch_encode(srsran_pdsch_t*     q,
     }
 
     // Layer mapping & precode if necessary
+    uint64_t t0 = srsran_stage_prof_start();
     if (q->cell.nof_ports > 1) {
       int nof_symbols;
       /* If number of layers is equal to transport blocks (codewords) skip layer mapping */
@@ -1128,6 +1258,7 @@ int srsran_pdsch_encode(srsran_pdsch_t*     q,
     for (i = 0; i < q->cell.nof_ports; i++) {
       srsran_pdsch_put(q, q->symbols[i], sf_symbols[i], &cfg->grant, lstart, sf->tti % 10);
     }
+    srsran_stage_prof_stop(SRSRAN_STAGE_PROF_MAP, t0);
 
     if (cfg->meas_time_en) {
       gettimeofday(&t[2], NULL);
@@ -1140,16 +1271,24 @@ int srsran_pdsch_encode(srsran_pdsch_t*     q,
   return ret;
 }
 
-int srsran_pdsch_select_pmi(srsran_pdsch_t*        q,
-                            srsran_chest_dl_res_t* channel,
-                            uint32_t               nof_layers,
-                            uint32_t*              best_pmi,
-                            float                  sinr[SRSRAN_MAX_CODEBOOKS])
+int srsran_pdsch_compute_cov(srsran_pdsch_t*         q,
+                             srsran_chest_dl_res_t*  channel,
+                             uint32_t                decimation,
+                             srsran_precoding_cov_t* cov)
+{
+  return srsran_precoding_cov_estimate(channel->ce, SRSRAN_NOF_RE(q->cell), decimation, cov);
+}
+
+int srsran_pdsch_select_pmi(srsran_pdsch_t*               q,
+                            srsran_chest_dl_res_t*        channel,
+                            const srsran_precoding_cov_t* cov,
+                            uint32_t                      nof_layers,
+                            uint32_t*                     best_pmi,
+                            float                         sinr[SRSRAN_MAX_CODEBOOKS])
 {
-  uint32_t nof_ce = SRSRAN_NOF_RE(q->cell);
-  uint32_t pmi    = 0;
+  uint32_t pmi = 0;
 
-  if (srsran_precoding_pmi_select(channel->ce, nof_ce, channel->noise_estimate, nof_layers, &pmi, sinr) < 0) {
+  if (srsran_precoding_pmi_select_cov(cov, channel->noise_estimate, nof_layers, &pmi, sinr) < 0) {
     ERROR("PMI Select for %d layers", nof_layers);
     return SRSRAN_ERROR;
   }
@@ -25,6 +25,7 @@
 #include "srsran/phy/mimo/layermap.h"
 #include "srsran/phy/mimo/precoding.h"
 #include "srsran/phy/modem/demod_soft.h"
+#include "srsran/phy/utils/stage_prof.h"
 
 static int pdsch_nr_alloc(srsran_pdsch_nr_t* q, uint32_t max_mimo_layers, uint32_t max_prb)
 {
@@ -247,6 +248,9 @@ static int srsran_pdsch_nr_cp(const srsran_pdsch_nr_t*     q,
       return SRSRAN_ERROR;
     }
 
+    // Symbols without DMRS nor reserved RE are copied in whole PRB, without checking the mask
+    bool has_rvd = memchr(rvd_mask, true, q->carrier.nof_prb * SRSRAN_NRE) != NULL;
+
     // Actual copy
     for (uint32_t rb = 0; rb < q->carrier.nof_prb; rb++) {
       // Skip PRB if not available in grant
@@ -258,7 +262,14 @@ static int srsran_pdsch_nr_cp(const srsran_pdsch_nr_t*     q,
       uint32_t re_idx = (q->carrier.nof_prb * l + rb) * SRSRAN_NRE;
 
       // Put or get
-      if (put) {
+      if (!has_rvd) {
+        if (put) {
+          srsran_vec_cf_copy(&sf_symbols[re_idx], &symbols[count], SRSRAN_NRE);
+        } else {
+          srsran_vec_cf_copy(&symbols[count], &sf_symbols[re_idx], SRSRAN_NRE);
+        }
+        count += SRSRAN_NRE;
+      } else if (put) {
         count += pdsch_nr_put_rb(&sf_symbols[re_idx], &symbols[count], &rvd_mask[rb * SRSRAN_NRE]);
       } else {
         count += pdsch_nr_get_rb(&symbols[count], &sf_symbols[re_idx], &rvd_mask[rb * SRSRAN_NRE]);
@@ -325,10 +336,12 @@ static inline int pdsch_nr_encode_codeword(srsran_pdsch_nr_t*         q,
   }
 
   // Encode SCH
+  uint64_t t0 = srsran_stage_prof_start();
   if (srsran_dlsch_nr_encode(&q->sch, &cfg->sch_cfg, tb, data, q->b[tb->cw_idx]) < SRSRAN_SUCCESS) {
     ERROR("Error in DL-SCH encoding");
     return SRSRAN_ERROR;
   }
+  srsran_stage_prof_stop(SRSRAN_STAGE_PROF_ENCODE, t0);
 
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
     DEBUG("b=");
@@ -340,7 +353,9 @@ static inline int pdsch_nr_encode_codeword(srsran_pdsch_nr_t*         q,
   srsran_sequence_apply_bit(q->b[tb->cw_idx], q->b[tb->cw_idx], tb->nof_bits, cinit);
 
   // 7.3.1.2 Modulation
+  t0 = srsran_stage_prof_start();
   srsran_mod_modulate(&q->modem_tables[tb->mod], q->b[tb->cw_idx], q->d[tb->cw_idx], tb->nof_bits);
+  srsran_stage_prof_stop(SRSRAN_STAGE_PROF_MAP, t0);
 
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
     DEBUG("d=");
@@ -451,34 +466,41 @@ static inline int pdsch_nr_decode_codeword(srsran_pdsch_nr_t*         q,
     srsran_vec_fprint_c(stdout, q->d[tb->cw_idx], tb->nof_re);
   }
 
-  // Demodulation
-  int8_t* llr = (int8_t*)q->b[tb->cw_idx];
-  if (srsran_demod_soft_demodulate_b(tb->mod, q->d[tb->cw_idx], llr, tb->nof_re)) {
-    return SRSRAN_ERROR;
-  }
-
-  // EVM
+  // Demodulation, the descrambling is fused unless the EVM is measured on the scrambled LLR
+  int8_t*  llr   = (int8_t*)q->b[tb->cw_idx];
+  uint32_t cinit = pdsch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx);
+  uint64_t t0    = srsran_stage_prof_start();
   if (q->evm_buffer != NULL) {
+    if (srsran_demod_soft_demodulate_b(tb->mod, q->d[tb->cw_idx], llr, tb->nof_re)) {
+      return SRSRAN_ERROR;
+    }
+
+    // EVM
     res->evm[tb->cw_idx] =
         srsran_evm_run_b(q->evm_buffer, &q->modem_tables[tb->mod], q->d[tb->cw_idx], llr, tb->nof_bits);
+
+    // Descrambling
+    srsran_sequence_apply_c(llr, llr, tb->nof_bits, cinit);
+  } else if (srsran_demod_soft_demodulate_descramble_b(tb->mod, q->d[tb->cw_idx], llr, tb->nof_re, cinit)) {
+    return SRSRAN_ERROR;
   }
+  srsran_stage_prof_stop(SRSRAN_STAGE_PROF_DEMOD, t0);
 
   // Change LLR sign and set to zero the LLR that are not used
   srsran_vec_neg_bb(llr, llr, tb->nof_bits);
 
-  // Descrambling
-  srsran_sequence_apply_c(llr, llr, tb->nof_bits, pdsch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx));
-
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
     DEBUG("b=");
     srsran_vec_fprint_b(stdout, q->b[tb->cw_idx], tb->nof_bits);
   }
 
   // Decode SCH
+  t0 = srsran_stage_prof_start();
   if (srsran_dlsch_nr_decode(&q->sch, &cfg->sch_cfg, tb, llr, &res->tb[tb->cw_idx]) < SRSRAN_SUCCESS) {
     ERROR("Error in DL-SCH encoding");
     return SRSRAN_ERROR;
   }
+  srsran_stage_prof_stop(SRSRAN_STAGE_PROF_FEC, t0);
 
   return SRSRAN_SUCCESS;
 }
@@ -537,12 +559,14 @@ int srsran_pdsch_nr_decode(srsran_pdsch_nr_t*           q,
 
   // Antenna port demapping
   // ... Not implemented
+  uint64_t t0 = srsran_stage_prof_start();
   srsran_predecoding_single(q->x[0], channel->ce[0][0], q->d[0], NULL, nof_re, 1.0f, channel->noise_estimate);
 
   // Layer demapping
   if (grant->nof_layers > 1) {
     srsran_layerdemap_nr(q->d, nof_cw, q->x, grant->nof_layers, nof_re);
   }
+  srsran_stage_prof_stop(SRSRAN_STAGE_PROF_EQUALIZE, t0);
 
   // SCH decode
   for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
@@ -396,64 +396,101 @@ void srsran_configure_pmch(srsran_pmch_cfg_t* pmch_cfg, srsran_cell_t* cell, srs
   }
 }
 
-int srsran_pmch_encode(srsran_pmch_t*      q,
-                       srsran_dl_sf_cfg_t* sf,
-                       srsran_pmch_cfg_t*  cfg,
-                       uint8_t*            data,
-                       cf_t*               sf_symbols[SRSRAN_MAX_PORTS])
+int srsran_pmch_encode_symbols(srsran_pmch_t* q, srsran_dl_sf_cfg_t* sf, srsran_pmch_cfg_t* cfg, uint8_t* data)
 {
-  int i;
-  int ret = SRSRAN_ERROR_INVALID_INPUTS;
-  if (q != NULL && cfg != NULL) {
-    for (i = 0; i < q->cell.nof_ports; i++) {
-      if (sf_symbols[i] == NULL) {
-        return SRSRAN_ERROR_INVALID_INPUTS;
-      }
-    }
+  if (q == NULL || sf == NULL || cfg == NULL || data == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-    if (cfg->pdsch_cfg.grant.tb[0].tbs == 0) {
-      return SRSRAN_ERROR_INVALID_INPUTS;
-    }
+  if (cfg->pdsch_cfg.grant.tb[0].tbs == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-    if (cfg->pdsch_cfg.grant.nof_re > q->max_re) {
-      ERROR("Error too many RE per subframe (%d). PMCH configured for %d RE (%d PRB)",
-            cfg->pdsch_cfg.grant.nof_re,
-            q->max_re,
-            q->cell.nof_prb);
-      return SRSRAN_ERROR_INVALID_INPUTS;
-    }
+  if (cfg->pdsch_cfg.grant.nof_re > q->max_re) {
+    ERROR("Error too many RE per subframe (%d). PMCH configured for %d RE (%d PRB)",
+          cfg->pdsch_cfg.grant.nof_re,
+          q->max_re,
+          q->cell.nof_prb);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-    INFO("Encoding PMCH SF: %d, Mod %s, NofBits: %d, NofSymbols: %d, NofBitsE: %d, rv_idx: %d",
-         sf->tti % 10,
-         srsran_mod_string(cfg->pdsch_cfg.grant.tb[0].mod),
-         cfg->pdsch_cfg.grant.tb[0].tbs,
-         cfg->pdsch_cfg.grant.nof_re,
-         cfg->pdsch_cfg.grant.tb[0].nof_bits,
-         0);
+  INFO("Encoding PMCH SF: %d, Mod %s, NofBits: %d, NofSymbols: %d, NofBitsE: %d, rv_idx: %d",
+       sf->tti % 10,
+       srsran_mod_string(cfg->pdsch_cfg.grant.tb[0].mod),
+       cfg->pdsch_cfg.grant.tb[0].tbs,
+       cfg->pdsch_cfg.grant.nof_re,
+       cfg->pdsch_cfg.grant.tb[0].nof_bits,
+       0);
+
+  // TODO: use tb_encode directly
+  if (srsran_dlsch_encode(&q->dl_sch, &cfg->pdsch_cfg, data, q->e)) {
+    ERROR("Error encoding TB");
+    return SRSRAN_ERROR;
+  }
 
-    // TODO: use tb_encode directly
-    if (srsran_dlsch_encode(&q->dl_sch, &cfg->pdsch_cfg, data, q->e)) {
-      ERROR("Error encoding TB");
-      return SRSRAN_ERROR;
+  /* scramble */
+  srsran_scrambling_bytes(
+      &q->seqs[cfg->area_id]->seq[sf->tti % 10], (uint8_t*)q->e, cfg->pdsch_cfg.grant.tb[0].nof_bits);
+
+  srsran_mod_modulate_bytes(
+      &q->mod[cfg->pdsch_cfg.grant.tb[0].mod], (uint8_t*)q->e, q->d, cfg->pdsch_cfg.grant.tb[0].nof_bits);
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_pmch_put_symbols(srsran_pmch_t*      q,
+                            srsran_dl_sf_cfg_t* sf,
+                            srsran_pmch_cfg_t*  cfg,
+                            const cf_t*         symbols,
+                            cf_t*               sf_symbols[SRSRAN_MAX_PORTS])
+{
+  if (q == NULL || sf == NULL || cfg == NULL || symbols == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  for (uint32_t i = 0; i < q->cell.nof_ports; i++) {
+    if (sf_symbols[i] == NULL) {
+      return SRSRAN_ERROR_INVALID_INPUTS;
     }
+  }
 
-    /* scramble */
-    srsran_scrambling_bytes(
-        &q->seqs[cfg->area_id]->seq[sf->tti % 10], (uint8_t*)q->e, cfg->pdsch_cfg.grant.tb[0].nof_bits);
+  if (cfg->pdsch_cfg.grant.nof_re > q->max_re) {
+    ERROR("Error too many RE per subframe (%d). PMCH configured for %d RE (%d PRB)",
+          cfg->pdsch_cfg.grant.nof_re,
+          q->max_re,
+          q->cell.nof_prb);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-    srsran_mod_modulate_bytes(
-        &q->mod[cfg->pdsch_cfg.grant.tb[0].mod], (uint8_t*)q->e, q->d, cfg->pdsch_cfg.grant.tb[0].nof_bits);
+  /* No tx diversity in MBSFN */
+  memcpy(q->symbols[0], symbols, cfg->pdsch_cfg.grant.nof_re * sizeof(cf_t));
 
-    /* No tx diversity in MBSFN */
-    memcpy(q->symbols[0], q->d, cfg->pdsch_cfg.grant.nof_re * sizeof(cf_t));
+  /* mapping to resource elements */
+  uint32_t lstart = SRSRAN_NOF_CTRL_SYMBOLS(q->cell, sf->cfi);
+  for (uint32_t i = 0; i < q->cell.nof_ports; i++) {
+    pmch_put(q, q->symbols[i], sf_symbols[i], lstart);
+  }
 
-    /* mapping to resource elements */
-    uint32_t lstart = SRSRAN_NOF_CTRL_SYMBOLS(q->cell, sf->cfi);
-    for (i = 0; i < q->cell.nof_ports; i++) {
-      pmch_put(q, q->symbols[i], sf_symbols[i], lstart);
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_pmch_encode(srsran_pmch_t*      q,
+                       srsran_dl_sf_cfg_t* sf,
+                       srsran_pmch_cfg_t*  cfg,
+                       uint8_t*            data,
+                       cf_t*               sf_symbols[SRSRAN_MAX_PORTS])
+{
+  if (q == NULL || cfg == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  for (uint32_t i = 0; i < q->cell.nof_ports; i++) {
+    if (sf_symbols[i] == NULL) {
+      return SRSRAN_ERROR_INVALID_INPUTS;
     }
+  }
 
-    ret = SRSRAN_SUCCESS;
+  int ret = srsran_pmch_encode_symbols(q, sf, cfg, data);
+  if (ret != SRSRAN_SUCCESS) {
+    return ret;
   }
-  return ret;
+  return srsran_pmch_put_symbols(q, sf, cfg, q->d, sf_symbols);
 }
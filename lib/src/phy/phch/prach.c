@@ -21,6 +21,8 @@
 
 #include <assert.h>
 #include <math.h>
+#include <pthread.h>
+#include <semaphore.h>
 #include <string.h>
 
 #include "srsran/phy/common/phy_common.h"
@@ -447,6 +449,283 @@ static cf_t* get_precoded_dft(srsran_prach_t* p, uint32_t idx)
   return p->dft_seqs[idx];
 }
 
+/* Correlation peaks of the received bins with a root sequence, one peak per cyclic shift window */
+typedef struct {
+  float    peak_values[65];
+  uint32_t peak_offsets[65];
+  float    corr_ave;
+  float    max_peak;
+  cf_t     cross_acc; // Sum of the cross products of adjacent bins, only if the offset is calculated in frequency
+} prach_root_corr_t;
+
+typedef struct {
+  /* Thread identifier: it must be set before thread creation */
+  pthread_t thread;
+  void*     pool_ptr;
+
+  /* Own ZC IFFT and correlation buffers */
+  srsran_dft_plan_t zc_ifft;
+  cf_t*             corr_spec;
+  float*            corr;
+  cf_t*             cross;
+
+  /* Semaphore */
+  sem_t start;
+} prach_corr_worker_t;
+
+typedef struct {
+  prach_corr_worker_t* workers;
+  uint32_t             nof_workers;
+
+  /* Current detection: it must be set before posting the start semaphores */
+  const srsran_prach_t* p;
+
+  /* Next root to correlate, protected by the mutex */
+  uint32_t        next_root;
+  pthread_mutex_t mutex;
+
+  sem_t finish;
+  bool  quit;
+} prach_corr_pool_t;
+
+// Correlates the received bins with the root i, whose DFT must have been generated, and finds the peak of every window
+static void prach_correlate_root(const srsran_prach_t* p,
+                                 srsran_dft_plan_t*    zc_ifft,
+                                 cf_t*                 corr_spec,
+                                 float*                corr,
+                                 cf_t*                 cross,
+                                 uint32_t              i)
+{
+  prach_root_corr_t* r         = &((prach_root_corr_t*)p->root_corr)[i];
+  const cf_t*        root_spec = p->dft_seqs[p->root_seqs_idx[i]];
+
+  srsran_vec_prod_conj_ccc(p->prach_bins, root_spec, corr_spec, p->N_zc);
+
+  r->cross_acc = 0;
+  if (p->freq_domain_offset_calc) {
+    srsran_vec_prod_conj_ccc(corr_spec, &corr_spec[1], cross, p->N_zc - 1);
+    r->cross_acc = srsran_vec_acc_cc(cross, p->N_zc - 1);
+  }
+
+  srsran_dft_run(zc_ifft, corr_spec, corr_spec);
+
+  srsran_vec_abs_square_cf(corr_spec, corr, p->N_zc);
+
+  r->corr_ave = srsran_vec_acc_ff(corr, p->N_zc) / p->N_zc;
+
+  uint32_t winsize = (p->N_cs != 0) ? p->N_cs : p->N_zc;
+  uint32_t n_wins  = p->N_zc / winsize;
+
+  r->max_peak = 0;
+  for (int j = 0; j < n_wins; j++) {
+    uint32_t start = (p->N_zc - (j * p->N_cs)) % p->N_zc;
+    uint32_t end   = start + winsize;
+    if (end > p->deadzone) {
+      end -= p->deadzone;
+    }
+    start += p->deadzone;
+    r->peak_values[j] = 0;
+    for (int k = start; k < end; k++) {
+      if (corr[k] > r->peak_values[j]) {
+        r->peak_values[j]  = corr[k];
+        r->peak_offsets[j] = k - start;
+        if (r->peak_values[j] > r->max_peak) {
+          r->max_peak = r->peak_values[j];
+        }
+      }
+    }
+  }
+}
+
+static void prach_corr_pool_run(prach_corr_pool_t* pool,
+                                srsran_dft_plan_t* zc_ifft,
+                                cf_t*              corr_spec,
+                                float*             corr,
+                                cf_t*              cross)
+{
+  const srsran_prach_t* p = pool->p;
+  while (true) {
+    pthread_mutex_lock(&pool->mutex);
+    uint32_t i = pool->next_root++;
+    pthread_mutex_unlock(&pool->mutex);
+
+    if (i >= p->num_ra_preambles) {
+      break;
+    }
+
+    prach_correlate_root(p, zc_ifft, corr_spec, corr, cross, i);
+  }
+}
+
+static void* prach_corr_worker_thread(void* arg)
+{
+  prach_corr_worker_t* w    = (prach_corr_worker_t*)arg;
+  prach_corr_pool_t*   pool = (prach_corr_pool_t*)w->pool_ptr;
+
+  sem_wait(&w->start);
+  while (!pool->quit) {
+    prach_corr_pool_run(pool, &w->zc_ifft, w->corr_spec, w->corr, w->cross);
+
+    /* Post finish semaphore */
+    sem_post(&pool->finish);
+
+    /* Wait for next detection */
+    sem_wait(&w->start);
+  }
+
+  return NULL;
+}
+
+static void prach_corr_worker_free(prach_corr_worker_t* w)
+{
+  srsran_dft_plan_free(&w->zc_ifft);
+  if (w->corr_spec) {
+    free(w->corr_spec);
+  }
+  if (w->corr) {
+    free(w->corr);
+  }
+  if (w->cross) {
+    free(w->cross);
+  }
+}
+
+static void prach_corr_pool_free(srsran_prach_t* p)
+{
+  prach_corr_pool_t* pool = (prach_corr_pool_t*)p->corr_pool;
+  if (pool == NULL) {
+    return;
+  }
+
+  /* Stop threads */
+  pool->quit = true;
+  for (uint32_t i = 0; i < pool->nof_workers; i++) {
+    sem_post(&pool->workers[i].start);
+  }
+  for (uint32_t i = 0; i < pool->nof_workers; i++) {
+    pthread_join(pool->workers[i].thread, NULL);
+    sem_destroy(&pool->workers[i].start);
+    prach_corr_worker_free(&pool->workers[i]);
+  }
+
+  sem_destroy(&pool->finish);
+  pthread_mutex_destroy(&pool->mutex);
+  free(pool->workers);
+  free(pool);
+
+  p->corr_pool = NULL;
+}
+
+static int prach_corr_worker_init(prach_corr_worker_t* w, uint32_t N_zc)
+{
+  w->corr_spec = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG);
+  w->corr      = srsran_vec_f_malloc(SRSRAN_PRACH_N_ZC_LONG);
+  w->cross     = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG);
+  if (w->corr_spec == NULL || w->corr == NULL || w->cross == NULL) {
+    ERROR("Error allocating memory");
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_dft_plan(&w->zc_ifft, SRSRAN_PRACH_N_ZC_LONG, SRSRAN_DFT_BACKWARD, SRSRAN_DFT_COMPLEX)) {
+    ERROR("Error creating DFT plan");
+    return SRSRAN_ERROR;
+  }
+  srsran_dft_plan_set_mirror(&w->zc_ifft, false);
+  srsran_dft_plan_set_norm(&w->zc_ifft, false);
+
+  if (N_zc != SRSRAN_PRACH_N_ZC_LONG && srsran_dft_replan(&w->zc_ifft, N_zc)) {
+    ERROR("Error creating DFT plan");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+// Resizes the worker IFFTs to the sequence length of the current configuration
+static int prach_corr_pool_replan(srsran_prach_t* p)
+{
+  prach_corr_pool_t* pool = (prach_corr_pool_t*)p->corr_pool;
+  if (pool == NULL) {
+    return SRSRAN_SUCCESS;
+  }
+
+  for (uint32_t i = 0; i < pool->nof_workers; i++) {
+    if (pool->workers[i].zc_ifft.size != p->N_zc && srsran_dft_replan(&pool->workers[i].zc_ifft, p->N_zc)) {
+      ERROR("Error creating DFT plan");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_prach_set_nof_workers(srsran_prach_t* p, uint32_t nof_workers)
+{
+  if (p == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  prach_corr_pool_free(p);
+  if (nof_workers == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  prach_corr_pool_t* pool = SRSRAN_MEM_ALLOC(prach_corr_pool_t, 1);
+  if (pool == NULL) {
+    ERROR("Error: calloc");
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(pool, prach_corr_pool_t, 1);
+
+  pool->workers = SRSRAN_MEM_ALLOC(prach_corr_worker_t, nof_workers);
+  if (pool->workers == NULL) {
+    ERROR("Error: calloc");
+    free(pool);
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(pool->workers, prach_corr_worker_t, nof_workers);
+
+  if (pthread_mutex_init(&pool->mutex, NULL) || sem_init(&pool->finish, 0, 0)) {
+    ERROR("Error: creating root correlation pool synchronization");
+    free(pool->workers);
+    free(pool);
+    return SRSRAN_ERROR;
+  }
+  p->corr_pool = pool;
+
+  uint32_t N_zc = (p->N_zc != 0) ? p->N_zc : SRSRAN_PRACH_N_ZC_LONG;
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    prach_corr_worker_t* w = &pool->workers[i];
+    w->pool_ptr            = pool;
+
+    if (prach_corr_worker_init(w, N_zc) < SRSRAN_SUCCESS) {
+      ERROR("Error: initialising root correlation worker %d", i);
+      prach_corr_worker_free(w);
+      prach_corr_pool_free(p);
+      return SRSRAN_ERROR;
+    }
+
+    if (sem_init(&w->start, 0, 0)) {
+      ERROR("Error: creating semaphore");
+      prach_corr_worker_free(w);
+      prach_corr_pool_free(p);
+      return SRSRAN_ERROR;
+    }
+
+    if (pthread_create(&w->thread, NULL, prach_corr_worker_thread, w)) {
+      ERROR("Error: creating root correlation worker %d", i);
+      sem_destroy(&w->start);
+      prach_corr_worker_free(w);
+      prach_corr_pool_free(p);
+      return SRSRAN_ERROR;
+    }
+
+    pool->nof_workers++;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_prach_gen_seqs(srsran_prach_t* p)
 {
   uint32_t u           = 0;
@@ -569,6 +848,11 @@ int srsran_prach_init(srsran_prach_t* p, uint32_t max_N_ifft_ul)
     p->corr       = srsran_vec_f_malloc(SRSRAN_PRACH_N_ZC_LONG);
     p->cross      = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG);
     p->corr_freq  = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG);
+    p->root_corr  = SRSRAN_MEM_ALLOC(prach_root_corr_t, N_SEQS);
+    if (!p->root_corr) {
+      ERROR("Error allocating memory");
+      return -1;
+    }
 
     // Set up ZC FFTS
     if (srsran_dft_plan(&p->zc_fft, SRSRAN_PRACH_N_ZC_LONG, SRSRAN_DFT_FORWARD, SRSRAN_DFT_COMPLEX)) {
@@ -687,6 +971,9 @@ int srsran_prach_set_cell_(srsran_prach_t*      p,
         return SRSRAN_ERROR;
       }
     }
+    if (prach_corr_pool_replan(p) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
 
     // Generate our 64 sequences
     p->N_roots = 0;
@@ -845,10 +1132,10 @@ float srsran_prach_get_offset_secs(srsran_prach_t* p, int n_win)
 
 // calculates the timing offset of the incoming PRACH by calculating the phase in frequency - alternative to time domain
 // approach
-float srsran_prach_calculate_time_offset_secs(srsran_prach_t* p, cf_t* cross)
+static float prach_time_offset_secs_from_cross_acc(srsran_prach_t* p, cf_t cross_acc)
 {
   // calculate the phase of the cross correlation
-  float freq_domain_phase = cargf(srsran_vec_acc_cc(cross, p->N_zc));
+  float freq_domain_phase = cargf(cross_acc);
   float ratio             = (float)(p->N_ifft_ul * DELTA_F) / (float)(SRSRAN_PRACH_N_ZC_LONG * DELTA_F_RA);
   // converting from phase to number of samples
   float num_samples = roundf((ratio * freq_domain_phase * p->N_zc) / (2 * M_PI));
@@ -856,6 +1143,11 @@ float srsran_prach_calculate_time_offset_secs(srsran_prach_t* p, cf_t* cross)
   // converting to time in seconds
   return num_samples / ((float)p->N_ifft_ul * DELTA_F);
 }
+
+float srsran_prach_calculate_time_offset_secs(srsran_prach_t* p, cf_t* cross)
+{
+  return prach_time_offset_secs_from_cross_acc(p, srsran_vec_acc_cc(cross, p->N_zc));
+}
 // calculates the aggregate phase offset of the incomming PRACH signal so it can be applied to the reference signal
 // before it is subtracted from the input
 void srsran_prach_calculate_correction_array(srsran_prach_t* p, cf_t* corr_freq)
@@ -877,55 +1169,48 @@ int srsran_prach_process(srsran_prach_t* p,
                          uint32_t        begin,
                          uint32_t        sig_len)
 {
-  float max_to_cancel = 0;
-  cancellation_idx    = -1;
-  int max_idx         = 0;
-  srsran_vec_cf_zero(p->cross, p->N_zc);
-  srsran_vec_cf_zero(p->corr_freq, p->N_zc);
-  for (int i = 0; i < p->num_ra_preambles; i++) {
-    cf_t* root_spec = get_precoded_dft(p, p->root_seqs_idx[i]);
+  float    max_to_cancel = 0;
+  uint32_t cancel_root   = 0;
+  cancellation_idx       = -1;
 
-    srsran_vec_prod_conj_ccc(p->prach_bins, root_spec, p->corr_spec, p->N_zc);
+  // The DFT of the roots are generated here, so the workers only read them
+  for (uint32_t i = 0; i < p->num_ra_preambles; i++) {
+    get_precoded_dft(p, p->root_seqs_idx[i]);
+  }
 
-    srsran_vec_prod_conj_ccc(p->corr_spec, &p->corr_spec[1], p->cross, p->N_zc - 1);
-    if (p->successive_cancellation) {
-      srsran_vec_cf_copy(p->corr_freq, p->corr_spec, p->N_zc);
-    }
-    srsran_dft_run(&p->zc_ifft, p->corr_spec, p->corr_spec);
+  // Correlate the received bins with every root, sharing the roots with the worker pool if there is more than one
+  prach_corr_pool_t* pool = (prach_corr_pool_t*)p->corr_pool;
+  if (pool != NULL && p->num_ra_preambles > 1) {
+    pool->p         = p;
+    pool->next_root = 0;
 
-    srsran_vec_abs_square_cf(p->corr_spec, p->corr, p->N_zc);
+    for (uint32_t i = 0; i < pool->nof_workers; i++) {
+      sem_post(&pool->workers[i].start);
+    }
 
-    float corr_ave = srsran_vec_acc_ff(p->corr, p->N_zc) / p->N_zc;
+    prach_corr_pool_run(pool, &p->zc_ifft, p->corr_spec, p->corr, p->cross);
 
-    uint32_t winsize = 0;
-    if (p->N_cs != 0) {
-      winsize = p->N_cs;
-    } else {
-      winsize = p->N_zc;
+    for (uint32_t i = 0; i < pool->nof_workers; i++) {
+      sem_wait(&pool->finish);
     }
-    uint32_t n_wins = p->N_zc / winsize;
-
-    float max_peak = 0;
-    for (int j = 0; j < n_wins; j++) {
-      uint32_t start = (p->N_zc - (j * p->N_cs)) % p->N_zc;
-      uint32_t end   = start + winsize;
-      if (end > p->deadzone) {
-        end -= p->deadzone;
-      }
-      start += p->deadzone;
-      p->peak_values[j] = 0;
-      for (int k = start; k < end; k++) {
-        if (p->corr[k] > p->peak_values[j]) {
-          p->peak_values[j]  = p->corr[k];
-          p->peak_offsets[j] = k - start;
-          if (p->peak_values[j] > max_peak) {
-            max_peak = p->peak_values[j];
-            max_idx  = k;
-          }
-        }
-      }
+  } else {
+    for (uint32_t i = 0; i < p->num_ra_preambles; i++) {
+      prach_correlate_root(p, &p->zc_ifft, p->corr_spec, p->corr, p->cross, i);
     }
+  }
+
+  uint32_t winsize = (p->N_cs != 0) ? p->N_cs : p->N_zc;
+  uint32_t n_wins  = p->N_zc / winsize;
+
+  // Report the peaks in root order
+  for (int i = 0; i < p->num_ra_preambles; i++) {
+    prach_root_corr_t* r        = &((prach_root_corr_t*)p->root_corr)[i];
+    float              corr_ave = r->corr_ave;
+    float              max_peak = r->max_peak;
+
     if (max_peak > (p->detect_factor * corr_ave)) {
+      memcpy(p->peak_values, r->peak_values, sizeof(float) * n_wins);
+      memcpy(p->peak_offsets, r->peak_offsets, sizeof(uint32_t) * n_wins);
       for (int j = 0; j < n_wins; j++) {
         if (p->peak_values[j] > p->detect_factor * corr_ave) {
           if (indices) {
@@ -933,9 +1218,9 @@ int srsran_prach_process(srsran_prach_t* p,
               if (max_peak > max_to_cancel) {
                 cancellation_idx       = (i * n_wins) + j;
                 max_to_cancel          = max_peak;
+                cancel_root            = i;
                 p->prach_cancel.idx    = cancellation_idx;
                 p->prach_cancel.factor = (sqrt(max_peak / (p->N_zc * p->N_zc)));
-                srsran_prach_calculate_correction_array(p, p->corr_freq);
               }
               if (srsran_prach_have_stored(((i * n_wins) + j), indices, *n_indices)) {
                 break;
@@ -949,7 +1234,7 @@ int srsran_prach_process(srsran_prach_t* p,
           if (t_offsets) {
             // saves the PRACH offset in seconds to t_offsets, time domain or freq domain base calc
             t_offsets[*n_indices] = (p->freq_domain_offset_calc)
-                                        ? (srsran_prach_calculate_time_offset_secs(p, p->cross))
+                                        ? (prach_time_offset_secs_from_cross_acc(p, r->cross_acc))
                                         : (srsran_prach_get_offset_secs(p, j));
           }
           (*n_indices)++;
@@ -958,7 +1243,10 @@ int srsran_prach_process(srsran_prach_t* p,
     }
   }
   if (cancellation_idx != -1) {
-    // if a peak has been found, this applies cancellation, if many found, subtracts strongest
+    // if a peak has been found, this applies cancellation, if many found, subtracts strongest. The phase correction
+    // uses the correlation spectrum of the root with the strongest peak
+    srsran_vec_prod_conj_ccc(p->prach_bins, p->dft_seqs[p->root_seqs_idx[cancel_root]], p->corr_freq, p->N_zc);
+    srsran_prach_calculate_correction_array(p, p->corr_freq);
     srsran_prach_cancellation(p);
   } else {
     return 1;
@@ -1013,6 +1301,10 @@ int srsran_prach_detect_offset(srsran_prach_t* p,
 
 int srsran_prach_free(srsran_prach_t* p)
 {
+  prach_corr_pool_free(p);
+  if (p->root_corr) {
+    free(p->root_corr);
+  }
   free(p->prach_bins);
   free(p->corr_spec);
   free(p->corr);
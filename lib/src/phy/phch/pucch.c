@@ -580,7 +580,8 @@ static int encode_signal(srsran_pucch_t*     q,
 }
 
 // Encode bits from uci_data
-static int encode_bits(srsran_pucch_cfg_t*   cfg,
+static int encode_bits(srsran_pucch_t*       q,
+                       srsran_pucch_cfg_t*   cfg,
                        srsran_uci_value_t*   uci_data,
                        srsran_pucch_format_t format,
                        uint8_t               pucch_bits[SRSRAN_PUCCH_MAX_BITS],
@@ -589,10 +590,10 @@ static int encode_bits(srsran_pucch_cfg_t*   cfg,
   if (format < SRSRAN_PUCCH_FORMAT_2) {
     srsran_vec_u8_copy(pucch_bits, uci_data->ack.ack_value, srsran_uci_cfg_total_ack(&cfg->uci_cfg));
   } else if (format >= SRSRAN_PUCCH_FORMAT_2 && format < SRSRAN_PUCCH_FORMAT_3) {
-    /* Put RI (goes alone) */
+    /* Put RI (goes alone). The RI and CQI codewords are taken from the table of all the (20,A) codewords */
     if (cfg->uci_cfg.cqi.ri_len) {
-      uint8_t temp[2] = {uci_data->ri, 0};
-      srsran_uci_encode_cqi_pucch(temp, cfg->uci_cfg.cqi.ri_len, pucch_bits);
+      uint8_t temp[SRSRAN_UCI_MAX_CQI_LEN_PUCCH] = {(uint8_t)(uci_data->ri & 1U)};
+      srsran_uci_encode_cqi_pucch_from_table(&q->cqi, temp, cfg->uci_cfg.cqi.ri_len, pucch_bits);
     } else {
       /* Put CQI Report*/
       uint8_t buff[SRSRAN_CQI_MAX_BITS];
@@ -601,7 +602,10 @@ static int encode_bits(srsran_pucch_cfg_t*   cfg,
         ERROR("Error encoding CQI");
         return SRSRAN_ERROR;
       }
-      srsran_uci_encode_cqi_pucch(buff, (uint32_t)uci_cqi_len, pucch_bits);
+      if (srsran_uci_encode_cqi_pucch_from_table(&q->cqi, buff, (uint32_t)uci_cqi_len, pucch_bits)) {
+        ERROR("Error encoding CQI");
+        return SRSRAN_ERROR;
+      }
     }
     if (format > SRSRAN_PUCCH_FORMAT_2) {
       pucch2_bits[0] = uci_data->ack.ack_value[0];
@@ -637,10 +641,21 @@ static bool decode_signal(srsran_pucch_t*     q,
 
   cf_t ref[SRSRAN_PUCCH_MAX_SYMBOLS];
 
+  // The signal of a format 1, 1a or 1b hypothesis is the one for d(0) = 1 times the unit modulus d(0). Hence, a single
+  // correlation with that signal gives the correlation of all the hypotheses of the resource.
+  cf_t  cov  = 0;
+  float norm = 1.0f;
+  if (cfg->format < SRSRAN_PUCCH_FORMAT_2) {
+    encode_signal_format12(q, sf, cfg, NULL, q->z_tmp, true);
+    float s_x = crealf(srsran_vec_dot_prod_conj_ccc(q->z, q->z, nof_re)) / nof_re;
+    float s_y = crealf(srsran_vec_dot_prod_conj_ccc(q->z_tmp, q->z_tmp, nof_re)) / nof_re;
+    cov       = srsran_vec_dot_prod_conj_ccc(q->z, q->z_tmp, nof_re) / nof_re;
+    norm      = sqrtf(s_x * s_y);
+  }
+
   switch (cfg->format) {
     case SRSRAN_PUCCH_FORMAT_1:
-      encode_signal(q, sf, cfg, pucch_bits, q->z_tmp);
-      corr = srsran_vec_corr_ccc(q->z, q->z_tmp, nof_re);
+      corr = crealf(conjf(uci_encode_format1()) * cov) / norm;
       if (corr >= cfg->threshold_format1) {
         detected = true;
       }
@@ -649,9 +664,7 @@ static bool decode_signal(srsran_pucch_t*     q,
     case SRSRAN_PUCCH_FORMAT_1A:
       detected = 0;
       for (uint8_t b = 0; b < 2; b++) {
-        pucch_bits[0] = b;
-        encode_signal(q, sf, cfg, pucch_bits, q->z_tmp);
-        corr = srsran_vec_corr_ccc(q->z, q->z_tmp, nof_re);
+        corr = crealf(conjf(uci_encode_format1a(b)) * cov) / norm;
         if (corr > corr_max) {
           corr_max = corr;
           b_max    = b;
@@ -668,10 +681,8 @@ static bool decode_signal(srsran_pucch_t*     q,
       detected = 0;
       for (uint8_t b = 0; b < 2; b++) {
         for (uint8_t b2 = 0; b2 < 2; b2++) {
-          pucch_bits[0] = b;
-          pucch_bits[1] = b2;
-          encode_signal(q, sf, cfg, pucch_bits, q->z_tmp);
-          corr = srsran_vec_corr_ccc(q->z, q->z_tmp, nof_re);
+          uint8_t tmp[2] = {b, b2};
+          corr           = crealf(conjf(uci_encode_format1b(tmp)) * cov) / norm;
           if (corr > corr_max) {
             corr_max = corr;
             b_max    = b;
@@ -777,7 +788,7 @@ int srsran_pucch_encode(srsran_pucch_t*     q,
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
   if (q != NULL && sf_symbols != NULL) {
     // Encode bits from UCI data for this format
-    encode_bits(cfg, uci_data, cfg->format, pucch_bits, cfg->pucch2_drs_bits);
+    encode_bits(q, cfg, uci_data, cfg->format, pucch_bits, cfg->pucch2_drs_bits);
 
     if (encode_signal(q, sf, cfg, pucch_bits, q->z)) {
       return SRSRAN_ERROR;
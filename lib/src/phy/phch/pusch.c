@@ -37,12 +37,19 @@
 #include "srsran/phy/phch/uci.h"
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/stage_prof.h"
 #include "srsran/phy/utils/vector.h"
 
 #define MAX_PUSCH_RE(cp) (2 * SRSRAN_CP_NSYMB(cp) * 12)
 
 #define ACK_SNR_TH -1.0
 
+// SNR margin over the Shannon bound of the grant above which the turbo decoder iterations are reduced
+#define PUSCH_SNR_MARGIN_HIGH_DB 6.0f
+#define PUSCH_SNR_MARGIN_LOW_DB 3.0f
+#define PUSCH_SNR_MAX_NOF_ITERATIONS_HIGH 4
+#define PUSCH_SNR_MAX_NOF_ITERATIONS_LOW 6
+
 /* Allocate/deallocate PUSCH RBs to the resource grid
  */
 static int pusch_cp(srsran_pusch_t*       q,
@@ -296,11 +303,13 @@ int srsran_pusch_encode(srsran_pusch_t*      q,
          cfg->grant.tb.nof_bits,
          cfg->grant.tb.rv);
 
+    uint64_t t0 = srsran_stage_prof_start();
     bzero(q->q, cfg->grant.tb.nof_bits);
     if ((ret = srsran_ulsch_encode(&q->ul_sch, cfg, data->ptr, &data->uci, q->g, q->q)) < 0) {
       ERROR("Error encoding TB");
       return SRSRAN_ERROR;
     }
+    srsran_stage_prof_stop(SRSRAN_STAGE_PROF_ENCODE, t0);
 
     uint32_t nof_ri_ack_bits = (uint32_t)ret;
 
@@ -331,6 +340,7 @@ int srsran_pusch_encode(srsran_pusch_t*      q,
     }
 
     // Bit mapping
+    t0 = srsran_stage_prof_start();
     srsran_mod_modulate_bytes(&q->mod[cfg->grant.tb.mod], (uint8_t*)q->q, q->d, cfg->grant.tb.nof_bits);
 
     // DFT precoding
@@ -347,6 +357,7 @@ int srsran_pusch_encode(srsran_pusch_t*      q,
             cfg->grant.L_prb);
       return SRSRAN_ERROR;
     }
+    srsran_stage_prof_stop(SRSRAN_STAGE_PROF_MAP, t0);
 
     ret = SRSRAN_SUCCESS;
   }
@@ -355,6 +366,36 @@ int srsran_pusch_encode(srsran_pusch_t*      q,
 
 /** Decodes the PUSCH from the received symbols
  */
+uint32_t srsran_pusch_max_nof_iterations(const srsran_pusch_cfg_t* cfg, float snr_db)
+{
+  if (cfg == NULL) {
+    return 0;
+  }
+
+  uint32_t max_nof_iterations = cfg->max_nof_iterations;
+  if (!cfg->max_nof_iterations_snr || !isfinite(snr_db) || cfg->grant.nof_re == 0) {
+    return max_nof_iterations;
+  }
+
+  // Minimum SNR for the spectral efficiency of the grant, in bits per resource element
+  float se         = (float)cfg->grant.tb.tbs / (float)cfg->grant.nof_re;
+  float snr_min_db = srsran_convert_power_to_dB(exp2f(se) - 1.0f);
+  float margin_db  = snr_db - snr_min_db;
+
+  uint32_t cap = max_nof_iterations;
+  if (margin_db > PUSCH_SNR_MARGIN_HIGH_DB) {
+    cap = PUSCH_SNR_MAX_NOF_ITERATIONS_HIGH;
+  } else if (margin_db > PUSCH_SNR_MARGIN_LOW_DB) {
+    cap = PUSCH_SNR_MAX_NOF_ITERATIONS_LOW;
+  }
+
+  // Zero selects the decoder default, which is above the caps
+  if (max_nof_iterations == 0 || cap < max_nof_iterations) {
+    return cap;
+  }
+  return max_nof_iterations;
+}
+
 int srsran_pusch_decode(srsran_pusch_t*        q,
                         srsran_ul_sf_cfg_t*    sf,
                         srsran_pusch_cfg_t*    cfg,
@@ -410,19 +451,33 @@ int srsran_pusch_decode(srsran_pusch_t*        q,
     }
 
     // Equalization
+    uint64_t t0 = srsran_stage_prof_start();
     srsran_predecoding_single(q->d, q->ce, q->z, NULL, cfg->grant.nof_re, 1.0f, channel->noise_estimate);
 
     // DFT predecoding
     srsran_dft_precoding(&q->dft_precoding, q->z, q->d, cfg->grant.L_prb, cfg->grant.nof_symb);
+    srsran_stage_prof_stop(SRSRAN_STAGE_PROF_EQUALIZE, t0);
 
-    // Soft demodulation
-    if (q->llr_is_8bit) {
-      srsran_demod_soft_demodulate_b(cfg->grant.tb.mod, q->d, q->q, cfg->grant.nof_re);
+    // Soft demodulation, the descrambling is fused unless the EVM is measured on the scrambled LLR
+    bool     meas_evm = cfg->meas_evm_en && q->evm_buffer;
+    uint32_t seed     = srsran_sequence_pusch_seed(cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id);
+    t0                = srsran_stage_prof_start();
+    if (meas_evm) {
+      if (q->llr_is_8bit) {
+        srsran_demod_soft_demodulate_b(cfg->grant.tb.mod, q->d, q->q, cfg->grant.nof_re);
+      } else {
+        srsran_demod_soft_demodulate_s(cfg->grant.tb.mod, q->d, q->q, cfg->grant.nof_re);
+      }
     } else {
-      srsran_demod_soft_demodulate_s(cfg->grant.tb.mod, q->d, q->q, cfg->grant.nof_re);
+      if (q->llr_is_8bit) {
+        srsran_demod_soft_demodulate_descramble_b(cfg->grant.tb.mod, q->d, q->q, cfg->grant.nof_re, seed);
+      } else {
+        srsran_demod_soft_demodulate_descramble_s(cfg->grant.tb.mod, q->d, q->q, cfg->grant.nof_re, seed);
+      }
     }
+    srsran_stage_prof_stop(SRSRAN_STAGE_PROF_DEMOD, t0);
 
-    if (cfg->meas_evm_en && q->evm_buffer) {
+    if (meas_evm) {
       if (q->llr_is_8bit) {
         out->evm = srsran_evm_run_b(q->evm_buffer, &q->mod[cfg->grant.tb.mod], q->d, q->q, cfg->grant.tb.nof_bits);
       } else {
@@ -433,12 +488,12 @@ int srsran_pusch_decode(srsran_pusch_t*        q,
     }
 
     // Descrambling
-    if (q->llr_is_8bit) {
-      srsran_sequence_pusch_apply_c(
-          q->q, q->q, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
-    } else {
-      srsran_sequence_pusch_apply_s(
-          q->q, q->q, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+    if (meas_evm) {
+      if (q->llr_is_8bit) {
+        srsran_sequence_apply_c(q->q, q->q, cfg->grant.tb.nof_bits, seed);
+      } else {
+        srsran_sequence_apply_s(q->q, q->q, cfg->grant.tb.nof_bits, seed);
+      }
     }
 
     // Generate packed sequence for UCI decoder
@@ -447,14 +502,23 @@ int srsran_pusch_decode(srsran_pusch_t*        q,
         c, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
 
     // Set max number of iterations
-    srsran_sch_set_max_noi(&q->ul_sch, cfg->max_nof_iterations);
-
-    // Decode
-    ret      = srsran_ulsch_decode(&q->ul_sch, cfg, q->q, q->g, c, out->data, &out->uci);
-    out->crc = (ret == 0);
+    srsran_sch_set_max_noi(&q->ul_sch, srsran_pusch_max_nof_iterations(cfg, channel->snr_db));
+    srsran_sch_set_early_termination(&q->ul_sch, cfg->early_termination);
+
+    // Decode, the deferred turbo decoding is timed apart by srsran_sch_decode_deferred()
+    t0 = srsran_stage_prof_start();
+    if (q->ul_sch.deferred_decoding) {
+      // CRC and number of iterations are written by srsran_sch_decode_deferred()
+      srsran_ulsch_decode_deferred(
+          &q->ul_sch, cfg, q->q, q->g, c, out->data, &out->uci, &out->crc, &out->avg_iterations_block);
+    } else {
+      ret      = srsran_ulsch_decode(&q->ul_sch, cfg, q->q, q->g, c, out->data, &out->uci);
+      out->crc = (ret == 0);
 
-    // Save number of iterations
-    out->avg_iterations_block = q->ul_sch.avg_iterations;
+      // Save number of iterations
+      out->avg_iterations_block = q->ul_sch.avg_iterations;
+    }
+    srsran_stage_prof_stop(SRSRAN_STAGE_PROF_FEC, t0);
 
     // Save O_cqi for power control
     cfg->last_O_cqi = srsran_cqi_size(&cfg->uci_cfg.cqi);
@@ -26,6 +26,7 @@
 #include "srsran/phy/phch/csi.h"
 #include "srsran/phy/phch/ra_nr.h"
 #include "srsran/phy/phch/uci_cfg.h"
+#include "srsran/phy/utils/stage_prof.h"
 
 static int pusch_nr_alloc(srsran_pusch_nr_t* q, uint32_t max_mimo_layers, uint32_t max_prb)
 {
@@ -638,10 +639,12 @@ static inline int pusch_nr_encode_codeword(srsran_pusch_nr_t*           q,
   }
 
   // Encode SCH
+  uint64_t t0 = srsran_stage_prof_start();
   if (srsran_ulsch_nr_encode(&q->sch, &cfg->sch_cfg, tb, data, q->g_ulsch) < SRSRAN_SUCCESS) {
     ERROR("Error in SCH encoding");
     return SRSRAN_ERROR;
   }
+  srsran_stage_prof_stop(SRSRAN_STAGE_PROF_ENCODE, t0);
 
   // Multiplex UL-SCH with UCI only if it is necessary
   uint32_t nof_bits = tb->nof_re * srsran_mod_bits_x_symbol(tb->mod);
@@ -695,7 +698,9 @@ static inline int pusch_nr_encode_codeword(srsran_pusch_nr_t*           q,
   }
 
   // 7.3.1.2 Modulation
+  t0 = srsran_stage_prof_start();
   srsran_mod_modulate(&q->modem_tables[tb->mod], q->b[tb->cw_idx], q->d[tb->cw_idx], nof_bits);
+  srsran_stage_prof_stop(SRSRAN_STAGE_PROF_MAP, t0);
 
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
     DEBUG("d=");
@@ -840,19 +845,24 @@ static inline int pusch_nr_decode_codeword(srsran_pusch_nr_t*         q,
     return SRSRAN_ERROR;
   }
 
-  // Demodulation
-  int8_t* llr = (int8_t*)q->b[tb->cw_idx];
-  if (srsran_demod_soft_demodulate_b(tb->mod, q->d[tb->cw_idx], llr, tb->nof_re)) {
-    return SRSRAN_ERROR;
-  }
-
-  // EVM
+  // Demodulation, the descrambling is fused unless the EVM is measured on the scrambled LLR
+  int8_t*  llr   = (int8_t*)q->b[tb->cw_idx];
+  uint32_t cinit = pusch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx);
+  uint64_t t0    = srsran_stage_prof_start();
   if (q->evm_buffer != NULL) {
+    if (srsran_demod_soft_demodulate_b(tb->mod, q->d[tb->cw_idx], llr, tb->nof_re)) {
+      return SRSRAN_ERROR;
+    }
+
+    // EVM
     res->evm[tb->cw_idx] = srsran_evm_run_b(q->evm_buffer, &q->modem_tables[tb->mod], q->d[tb->cw_idx], llr, nof_bits);
-  }
 
-  // Descrambling
-  srsran_sequence_apply_c(llr, llr, nof_bits, pusch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx));
+    // Descrambling
+    srsran_sequence_apply_c(llr, llr, nof_bits, cinit);
+  } else if (srsran_demod_soft_demodulate_descramble_b(tb->mod, q->d[tb->cw_idx], llr, tb->nof_re, cinit)) {
+    return SRSRAN_ERROR;
+  }
+  srsran_stage_prof_stop(SRSRAN_STAGE_PROF_DEMOD, t0);
 
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
     DEBUG("b=");
@@ -918,10 +928,12 @@ static inline int pusch_nr_decode_codeword(srsran_pusch_nr_t*         q,
 
   // Decode Ul-SCH
   if (nof_bits != 0) {
+    t0 = srsran_stage_prof_start();
     if (srsran_ulsch_nr_decode(&q->sch, &cfg->sch_cfg, tb, llr, &res->tb[tb->cw_idx]) < SRSRAN_SUCCESS) {
       ERROR("Error in SCH decoding");
       return SRSRAN_ERROR;
     }
+    srsran_stage_prof_stop(SRSRAN_STAGE_PROF_FEC, t0);
   }
 
   return SRSRAN_SUCCESS;
@@ -992,12 +1004,14 @@ int srsran_pusch_nr_decode(srsran_pusch_nr_t*           q,
 
   // Antenna port demapping
   // ... Not implemented
+  uint64_t t0 = srsran_stage_prof_start();
   srsran_predecoding_single(q->x[0], channel->ce[0][0], q->d[0], NULL, nof_re, 1.0f, channel->noise_estimate);
 
   // Layer demapping
   if (grant->nof_layers > 1) {
     srsran_layerdemap_nr(q->d, nof_cw, q->x, grant->nof_layers, nof_re);
   }
+  srsran_stage_prof_stop(SRSRAN_STAGE_PROF_EQUALIZE, t0);
 
   // SCH decode
   for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
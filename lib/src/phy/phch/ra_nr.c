@@ -549,7 +549,7 @@ static int ra_nr_assert_csi_rs_dmrs_collision(const srsran_sch_cfg_nr_t* pdsch_c
   return SRSRAN_SUCCESS;
 }
 
-uint32_t ra_nr_nof_crc_bits(uint32_t tbs, double R)
+uint32_t srsran_ra_nr_nof_crc_bits(uint32_t tbs, double R)
 {
   srsran_cbsegm_t    cbsegm = {};
   srsran_basegraph_t bg     = srsran_sch_nr_select_basegraph(tbs, R);
@@ -646,7 +646,7 @@ int srsran_ra_nr_fill_tb(const srsran_sch_cfg_nr_t*   pdsch_cfg,
   // Calculate actual rate
   tb->R_prime = 0.0;
   if (tb->nof_re != 0) {
-    tb->R_prime = (double)(tb->tbs + ra_nr_nof_crc_bits(tb->tbs, tb->R)) / (double)tb->nof_bits;
+    tb->R_prime = (double)(tb->tbs + srsran_ra_nr_nof_crc_bits(tb->tbs, tb->R)) / (double)tb->nof_bits;
   }
 
   return SRSRAN_SUCCESS;
@@ -1174,7 +1174,7 @@ int srsran_ra_ul_set_grant_uci_nr(const srsran_carrier_nr_t*    carrier,
     if (pusch_cfg->grant.tb[i].nof_bits > 0) {
       pusch_cfg->grant.tb[i].R_prime =
           (double)(pusch_cfg->grant.tb[i].tbs +
-                   ra_nr_nof_crc_bits(pusch_cfg->grant.tb[i].tbs, pusch_cfg->grant.tb[i].R)) /
+                   srsran_ra_nr_nof_crc_bits(pusch_cfg->grant.tb[i].tbs, pusch_cfg->grant.tb[i].R)) /
           (double)pusch_cfg->grant.tb[i].nof_bits;
     } else {
       pusch_cfg->grant.tb[i].R_prime = NAN;
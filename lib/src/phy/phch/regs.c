@@ -27,6 +27,7 @@
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/phy/phch/regs.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
 
 #define REG_IDX(r, i, n) r->k[i] + r->l* n* SRSRAN_NRE
 
@@ -53,6 +54,10 @@ void regs_pdcch_free(srsran_regs_t* h)
       free(h->pdcch[i].regs);
       h->pdcch[i].regs = NULL;
     }
+    if (h->pdcch[i].re_idx) {
+      free(h->pdcch[i].re_idx);
+      h->pdcch[i].re_idx = NULL;
+    }
   }
 }
 
@@ -71,7 +76,7 @@ int regs_pdcch_init(srsran_regs_t* h)
   uint32_t            k, kp;
   srsran_regs_reg_t** tmp = NULL;
 
-  bzero(&h->pdcch, sizeof(srsran_regs_ch_t));
+  bzero(&h->pdcch, sizeof(h->pdcch));
 
   for (cfi = 0; cfi < 3; cfi++) {
     if (h->cell.nof_prb <= 10) {
@@ -126,6 +131,18 @@ int regs_pdcch_init(srsran_regs_t* h)
       }
     }
     h->pdcch[cfi].nof_regs = (h->pdcch[cfi].nof_regs / 9) * 9;
+
+    /* Flatten the interleaved REGs into grid indices, so mapping a CCE does not walk the REG structures */
+    h->pdcch[cfi].re_idx = malloc(sizeof(uint32_t) * REGS_RE_X_REG * SRSRAN_MAX(h->pdcch[cfi].nof_regs, 1));
+    if (!h->pdcch[cfi].re_idx) {
+      perror("malloc");
+      goto clean_and_exit;
+    }
+    for (i = 0; i < h->pdcch[cfi].nof_regs; i++) {
+      for (j = 0; j < REGS_RE_X_REG; j++) {
+        h->pdcch[cfi].re_idx[i * REGS_RE_X_REG + j] = REG_IDX(h->pdcch[cfi].regs[i], j, h->cell.nof_prb);
+      }
+    }
     INFO("Init PDCCH REG space CFI %d. %d useful REGs (%d CCEs)",
          cfi + 1,
          h->pdcch[cfi].nof_regs,
@@ -181,11 +198,10 @@ int srsran_regs_pdcch_put_offset(srsran_regs_t* h,
     return SRSRAN_ERROR;
   }
   if (start_reg + nof_regs <= h->pdcch[cfi - 1].nof_regs) {
-    uint32_t i, k;
-    k = 0;
-    for (i = start_reg; i < start_reg + nof_regs; i++) {
-      regs_put_reg(h->pdcch[cfi - 1].regs[i], &d[k], slot_symbols, h->cell.nof_prb);
-      k += 4;
+    const uint32_t* re_idx = &h->pdcch[cfi - 1].re_idx[start_reg * REGS_RE_X_REG];
+    uint32_t        k;
+    for (k = 0; k < nof_regs * REGS_RE_X_REG; k++) {
+      slot_symbols[re_idx[k]] = d[k];
     }
     return k;
   } else {
@@ -215,11 +231,10 @@ int srsran_regs_pdcch_get_offset(srsran_regs_t* h,
     return SRSRAN_ERROR;
   }
   if (start_reg + nof_regs <= h->pdcch[cfi - 1].nof_regs) {
-    uint32_t i, k;
-    k = 0;
-    for (i = start_reg; i < start_reg + nof_regs; i++) {
-      regs_get_reg(h->pdcch[cfi - 1].regs[i], slot_symbols, &d[k], h->cell.nof_prb);
-      k += 4;
+    const uint32_t* re_idx = &h->pdcch[cfi - 1].re_idx[start_reg * REGS_RE_X_REG];
+    uint32_t        k;
+    for (k = 0; k < nof_regs * REGS_RE_X_REG; k++) {
+      d[k] = slot_symbols[re_idx[k]];
     }
     return k;
   } else {
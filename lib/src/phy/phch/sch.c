@@ -21,6 +21,7 @@
 
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/stage_prof.h"
 #include "srsran/phy/utils/vector.h"
 #include "srsran/srsran.h"
 #include <assert.h>
@@ -214,6 +215,10 @@ void srsran_sch_free(srsran_sch_t* q)
   if (q->ul_interleaver) {
     free(q->ul_interleaver);
   }
+  if (q->deferred_data) {
+    free(q->deferred_data);
+  }
+  srsran_tdec_batch_free(&q->batch);
   srsran_tdec_free(&q->decoder);
   srsran_tcod_free(&q->encoder);
   srsran_uci_cqi_free(&q->uci_cqi);
@@ -234,6 +239,66 @@ float srsran_sch_last_noi(srsran_sch_t* q)
   return q->avg_iterations;
 }
 
+void srsran_sch_set_early_termination(srsran_sch_t* q, bool enable)
+{
+  q->early_termination = enable;
+  srsran_tdec_batch_set_early_termination(&q->batch, enable);
+}
+
+int srsran_sch_enable_deferred_decoding(srsran_sch_t* q, bool enable)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (enable && q->deferred_data == NULL) {
+    if (srsran_tdec_batch_init(&q->batch, SRSRAN_TCOD_MAX_LEN_CB)) {
+      ERROR("Error initiating batch Turbo Decoder");
+      return SRSRAN_ERROR;
+    }
+    srsran_tdec_batch_set_min_iterations(&q->batch, SRSRAN_PDSCH_MIN_TDEC_ITERS);
+
+    q->deferred_data = srsran_vec_u8_malloc(SRSRAN_SCH_MAX_DEFERRED_CB * SRSRAN_TCOD_MAX_LEN_CB / 8);
+    if (!q->deferred_data) {
+      srsran_tdec_batch_free(&q->batch);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // Do not leave transport blocks behind
+  if (!enable && q->deferred_decoding) {
+    srsran_sch_decode_deferred(q);
+  }
+
+  q->deferred_decoding = enable;
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Scrambling and modulation of the encoded bits, run after each code block while its bits are still in cache */
+typedef struct {
+  srsran_sequence_state_t*    scrambler;
+  const srsran_modem_table_t* modem;
+  cf_t*                       symbols;
+  uint32_t                    nof_bits; // Number of bits already scrambled and modulated
+} sch_modulate_t;
+
+// 24 bits are whole bytes, whole symbols for every modulation order and a whole scrambling sequence word
+#define SCH_MODULATE_ALIGN 24
+
+static void encode_tb_modulate(sch_modulate_t* mod, uint8_t* e_bits, uint32_t end)
+{
+  if (end <= mod->nof_bits) {
+    return;
+  }
+
+  uint32_t len = end - mod->nof_bits;
+  uint8_t* ptr = &e_bits[mod->nof_bits / 8];
+  srsran_sequence_state_apply_packed(mod->scrambler, ptr, ptr, len);
+  srsran_mod_modulate_bytes(mod->modem, ptr, &mod->symbols[mod->nof_bits / mod->modem->nbits_x_symbol], len);
+  mod->nof_bits = end;
+}
+
 /* Encode a transport block according to 36.212 5.3.2
  *
  */
@@ -245,7 +310,8 @@ static int encode_tb_off(srsran_sch_t*           q,
                          uint32_t                nof_e_bits,
                          uint8_t*                data,
                          uint8_t*                e_bits,
-                         uint32_t                w_offset)
+                         uint32_t                w_offset,
+                         sch_modulate_t*         mod)
 {
   uint32_t i;
   uint32_t cb_len = 0, rp = 0, wp = 0, rlen = 0, n_e = 0;
@@ -346,6 +412,11 @@ static int encode_tb_off(srsran_sch_t*           q,
       /* Set read/write pointers */
       rp += rlen;
       wp += n_e;
+
+      /* Scramble and modulate the whole bytes and symbols written so far */
+      if (mod != NULL) {
+        encode_tb_modulate(mod, e_bits, (i == cb_segm->C - 1) ? wp : wp - wp % SCH_MODULATE_ALIGN);
+      }
     }
 
     INFO("END CB#%d: wp: %d, rp: %d", i, wp, rp);
@@ -363,9 +434,140 @@ static int encode_tb(srsran_sch_t*           q,
                      uint32_t                rv,
                      uint32_t                nof_e_bits,
                      uint8_t*                data,
-                     uint8_t*                e_bits)
+                     uint8_t*                e_bits,
+                     sch_modulate_t*         mod)
+{
+  return encode_tb_off(q, soft_buffer, cb_segm, Qm, rv, nof_e_bits, data, e_bits, 0, mod);
+}
+
+/* Rate dematching of one code block into the softbuffer */
+static int decode_cb_dematch(srsran_sch_t*           q,
+                             srsran_softbuffer_rx_t* softbuffer,
+                             srsran_cbsegm_t*        cb_segm,
+                             uint32_t                Qm,
+                             uint32_t                rv,
+                             uint32_t                nof_e_bits,
+                             void*                   e_bits,
+                             uint32_t                cb_idx)
 {
-  return encode_tb_off(q, soft_buffer, cb_segm, Qm, rv, nof_e_bits, data, e_bits, 0);
+  int8_t*  e_bits_b = e_bits;
+  int16_t* e_bits_s = e_bits;
+
+  uint32_t cb_len_idx = cb_idx < cb_segm->C1 ? cb_segm->K1_idx : cb_segm->K2_idx;
+
+  uint32_t Gp    = nof_e_bits / Qm;
+  uint32_t gamma = cb_segm->C > 0 ? Gp % cb_segm->C : Gp;
+  uint32_t n_e   = Qm * (Gp / cb_segm->C);
+
+  uint32_t rp   = cb_idx * n_e;
+  uint32_t n_e2 = n_e;
+
+  if (cb_idx > cb_segm->C - gamma) {
+    n_e2 = n_e + Qm;
+    rp   = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * n_e2;
+  }
+
+  srsran_softbuffer_rx_set_dirty(softbuffer, cb_idx);
+  if (q->llr_is_8bit) {
+    if (srsran_rm_turbo_rx_lut_8bit(&e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
+      ERROR("Error in rate matching");
+      return SRSRAN_ERROR;
+    }
+  } else {
+    if (srsran_rm_turbo_rx_lut(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
+      ERROR("Error in rate matching");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  INFO("CB %d: rp=%d, n_e=%d", cb_idx, rp, n_e2);
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Aggregates the CB CRC results and saves the correct CBs for the next retransmission */
+static bool decode_tb_cb_finish(srsran_softbuffer_rx_t* softbuffer, srsran_cbsegm_t* cb_segm, uint8_t* data)
+{
+  softbuffer->tb_crc = true;
+  for (int i = 0; i < cb_segm->C && softbuffer->tb_crc; i++) {
+    /* If one CB failed return false */
+    softbuffer->tb_crc = softbuffer->cb_crc[i];
+  }
+  // If TB CRC failed, save correct CB for next retransmission
+  if (!softbuffer->tb_crc) {
+    for (int i = 0; i < cb_segm->C; i++) {
+      if (softbuffer->cb_crc[i]) {
+        uint32_t cb_len = i < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
+        uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
+        memcpy(softbuffer->data[i], &data[i * rlen / 8], rlen / 8 * sizeof(uint8_t));
+      }
+    }
+  }
+
+  return softbuffer->tb_crc;
+}
+
+/* Turbo decoding of one code block, uses the CRC for early stopping. Returns the number of iterations */
+static uint32_t
+decode_cb(srsran_sch_t* q, srsran_softbuffer_rx_t* softbuffer, srsran_cbsegm_t* cb_segm, uint32_t cb_idx, uint8_t* data)
+{
+  uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
+  uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
+
+  srsran_tdec_new_cb(&q->decoder, cb_len);
+
+  // Run iterations and use CRC for early stopping
+  bool     early_stop    = false;
+  bool     converged     = false;
+  uint32_t last_checksum = 0;
+  uint32_t cb_noi        = 0;
+  do {
+    if (q->llr_is_8bit) {
+      srsran_tdec_iteration_8bit(&q->decoder, (int8_t*)softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
+    } else {
+      srsran_tdec_iteration(&q->decoder, softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
+    }
+    cb_noi++;
+
+    uint32_t      len_crc;
+    srsran_crc_t* crc_ptr;
+
+    if (cb_segm->C > 1) {
+      len_crc = cb_len;
+      crc_ptr = &q->crc_cb;
+    } else {
+      len_crc = cb_segm->tbs + 24;
+      crc_ptr = &q->crc_tb;
+    }
+
+    // CRC is OK and ran the minimum number of iterations
+    uint32_t checksum = srsran_crc_checksum_byte(crc_ptr, &data[cb_idx * rlen / 8], len_crc);
+    if (!checksum && (cb_noi >= SRSRAN_PDSCH_MIN_TDEC_ITERS)) {
+      softbuffer->cb_crc[cb_idx] = true;
+      early_stop                 = true;
+
+      // CRC is error and exceeded maximum iterations for this CB.
+      // Early stop the whole transport block.
+    }
+
+    // The same CRC remainder means the hard decision did not change in the last half iteration
+    if (q->early_termination && cb_noi > SRSRAN_PDSCH_MIN_TDEC_ITERS && checksum == last_checksum) {
+      converged = true;
+    }
+    last_checksum = checksum;
+
+  } while (cb_noi < q->max_iterations && !early_stop && !converged);
+
+  INFO("CB %d: cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d%s",
+       cb_idx,
+       cb_len,
+       early_stop ? "OK" : "KO",
+       rlen,
+       cb_noi,
+       q->max_iterations,
+       (converged && !early_stop) ? " (converged)" : "");
+
+  return cb_noi;
 }
 
 bool decode_tb_cb(srsran_sch_t*           q,
@@ -377,9 +579,6 @@ bool decode_tb_cb(srsran_sch_t*           q,
                   void*                   e_bits,
                   uint8_t*                data)
 {
-  int8_t*  e_bits_b = e_bits;
-  int16_t* e_bits_s = e_bits;
-
   if (cb_segm->C > SRSRAN_MAX_CODEBLOCKS) {
     ERROR("Error SRSRAN_MAX_CODEBLOCKS=%d", SRSRAN_MAX_CODEBLOCKS);
     return false;
@@ -390,107 +589,191 @@ bool decode_tb_cb(srsran_sch_t*           q,
   for (int cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
     /* Do not process blocks with CRC Ok */
     if (softbuffer->cb_crc[cb_idx] == false) {
-      uint32_t cb_len     = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
-      uint32_t cb_len_idx = cb_idx < cb_segm->C1 ? cb_segm->K1_idx : cb_segm->K2_idx;
-
-      uint32_t rlen  = cb_segm->C == 1 ? cb_len : (cb_len - 24);
-      uint32_t Gp    = nof_e_bits / Qm;
-      uint32_t gamma = cb_segm->C > 0 ? Gp % cb_segm->C : Gp;
-      uint32_t n_e   = Qm * (Gp / cb_segm->C);
-
-      uint32_t rp   = cb_idx * n_e;
-      uint32_t n_e2 = n_e;
-
-      if (cb_idx > cb_segm->C - gamma) {
-        n_e2 = n_e + Qm;
-        rp   = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * n_e2;
+      if (decode_cb_dematch(q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, cb_idx)) {
+        return SRSRAN_ERROR;
       }
 
-      if (q->llr_is_8bit) {
-        if (srsran_rm_turbo_rx_lut_8bit(&e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
-          ERROR("Error in rate matching");
-          return SRSRAN_ERROR;
-        }
-      } else {
-        if (srsran_rm_turbo_rx_lut(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
-          ERROR("Error in rate matching");
-          return SRSRAN_ERROR;
-        }
-      }
+      q->avg_iterations += decode_cb(q, softbuffer, cb_segm, cb_idx, data);
+    } else {
+      // Copy decoded data from previous transmissions
+      uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
+      uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
+      memcpy(&data[cb_idx * rlen / 8], softbuffer->data[cb_idx], rlen / 8 * sizeof(uint8_t));
+    }
+  }
 
-      srsran_tdec_new_cb(&q->decoder, cb_len);
+  decode_tb_cb_finish(softbuffer, cb_segm, data);
 
-      // Run iterations and use CRC for early stopping
-      bool     early_stop = false;
-      uint32_t cb_noi     = 0;
-      do {
-        if (q->llr_is_8bit) {
-          srsran_tdec_iteration_8bit(&q->decoder, (int8_t*)softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
-        } else {
-          srsran_tdec_iteration(&q->decoder, softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
-        }
-        q->avg_iterations++;
-        cb_noi++;
+  q->avg_iterations /= (float)cb_segm->C;
+  return softbuffer->tb_crc;
+}
+
+/* Checks the TB CRC once all the code blocks are decoded */
+static int decode_tb_check(srsran_sch_t*           q,
+                           srsran_softbuffer_rx_t* softbuffer,
+                           srsran_cbsegm_t*        cb_segm,
+                           uint8_t*                data,
+                           bool                    cb_crc_ok)
+{
+  // If any of the CBs CRC is KO
+  if (!cb_crc_ok) {
+    INFO("Error in CB parity");
+    return SRSRAN_ERROR;
+  }
 
-        uint32_t      len_crc;
-        srsran_crc_t* crc_ptr;
+  // One CB CRC OK, means TB CRC is OK.
+  if (cb_segm->C == 1) {
+    INFO("TB decoded OK");
+    return SRSRAN_SUCCESS;
+  }
 
-        if (cb_segm->C > 1) {
-          len_crc = cb_len;
-          crc_ptr = &q->crc_cb;
-        } else {
-          len_crc = cb_segm->tbs + 24;
-          crc_ptr = &q->crc_tb;
-        }
+  // Check TB CRC for whole TB
+  if (srsran_crc_match_byte(&q->crc_tb, data, cb_segm->tbs)) {
+    INFO("TB decoded OK");
+    return SRSRAN_SUCCESS;
+  }
 
-        // CRC is OK and ran the minimum number of iterations
-        if (!srsran_crc_checksum_byte(crc_ptr, &data[cb_idx * rlen / 8], len_crc) &&
-            (cb_noi >= SRSRAN_PDSCH_MIN_TDEC_ITERS)) {
-          softbuffer->cb_crc[cb_idx] = true;
-          early_stop                 = true;
+  // TB CRC check failed, as at least one CB had a false alarm, reset all CB CRC flags in the softbuffer
+  srsran_softbuffer_rx_reset_cb_crc(softbuffer, cb_segm->C);
 
-          // CRC is error and exceeded maximum iterations for this CB.
-          // Early stop the whole transport block.
-        }
+  INFO("Error in TB parity");
+  return SRSRAN_ERROR;
+}
 
-      } while (cb_noi < q->max_iterations && !early_stop);
+/* Rate dematches the code blocks of a transport block and queues them for srsran_sch_decode_deferred() */
+static int decode_tb_defer(srsran_sch_t*           q,
+                           srsran_softbuffer_rx_t* softbuffer,
+                           srsran_cbsegm_t*        cb_segm,
+                           uint32_t                Qm,
+                           uint32_t                rv,
+                           uint32_t                nof_e_bits,
+                           int16_t*                e_bits,
+                           uint8_t*                data,
+                           bool*                   crc,
+                           float*                  avg_iterations)
+{
+  if (cb_segm->C > SRSRAN_MAX_CODEBLOCKS) {
+    ERROR("Error SRSRAN_MAX_CODEBLOCKS=%d", SRSRAN_MAX_CODEBLOCKS);
+    return SRSRAN_ERROR;
+  }
 
-      INFO("CB %d: rp=%d, n_e=%d, cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d",
-           cb_idx,
-           rp,
-           n_e2,
-           cb_len,
-           early_stop ? "OK" : "KO",
-           rlen,
-           cb_noi,
-           q->max_iterations);
+  // Flush the queue if there is no space left
+  if (q->nof_deferred_tb == SRSRAN_SCH_MAX_DEFERRED_TB || q->nof_deferred_cb + cb_segm->C > SRSRAN_SCH_MAX_DEFERRED_CB) {
+    if (srsran_sch_decode_deferred(q) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+  // Every block keeps the maximum number of iterations of its transport block
+  q->deferred_max_iterations = SRSRAN_MAX(q->deferred_max_iterations, q->max_iterations);
+
+  srsran_sch_deferred_tb_t* tb = &q->deferred_tb[q->nof_deferred_tb];
+  tb->softbuffer               = softbuffer;
+  tb->cb_segm                  = *cb_segm;
+  tb->data                     = data;
+  tb->crc                      = crc;
+  tb->avg_iterations           = avg_iterations;
+  tb->cb_offset                = q->nof_deferred_cb;
+  tb->nof_cb                   = 0;
+  tb->noi                      = 0;
+
+  *crc            = false;
+  *avg_iterations = 0;
+
+  for (uint32_t cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
+    uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
+    uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
 
-    } else {
+    /* Do not process blocks with CRC Ok */
+    if (softbuffer->cb_crc[cb_idx]) {
       // Copy decoded data from previous transmissions
-      uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
-      uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
       memcpy(&data[cb_idx * rlen / 8], softbuffer->data[cb_idx], rlen / 8 * sizeof(uint8_t));
+      continue;
     }
+
+    if (decode_cb_dematch(q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, cb_idx)) {
+      return SRSRAN_ERROR;
+    }
+
+    // Blocks split in sub-blocks already fill the SIMD lanes of the single block decoder
+    if (srsran_tdec_autoimp_get_subblocks_8bit(cb_len) > 0) {
+      tb->noi += decode_cb(q, softbuffer, cb_segm, cb_idx, data);
+      continue;
+    }
+
+    // Decode into scratch memory, the code block CRC would overwrite the beginning of the next block in data
+    uint32_t                n  = tb->cb_offset + tb->nof_cb;
+    srsran_tdec_batch_cb_t* cb = &q->deferred_cb[n];
+    cb->input                  = (int8_t*)softbuffer->buffer_f[cb_idx];
+    cb->output                 = &q->deferred_data[n * SRSRAN_TCOD_MAX_LEN_CB / 8];
+    cb->long_cb                = cb_len;
+    cb->crc                    = (cb_segm->C > 1) ? &q->crc_cb : &q->crc_tb;
+    cb->crc_len                = (cb_segm->C > 1) ? cb_len : cb_segm->tbs + 24;
+    cb->max_iterations         = q->max_iterations;
+
+    tb->cb_idx[tb->nof_cb++] = (uint8_t)cb_idx;
   }
 
-  softbuffer->tb_crc = true;
-  for (int i = 0; i < cb_segm->C && softbuffer->tb_crc; i++) {
-    /* If one CB failed return false */
-    softbuffer->tb_crc = softbuffer->cb_crc[i];
+  q->nof_deferred_cb += tb->nof_cb;
+  q->nof_deferred_tb++;
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_sch_decode_deferred(srsran_sch_t* q)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
   }
-  // If TB CRC failed, save correct CB for next retransmission
-  if (!softbuffer->tb_crc) {
-    for (int i = 0; i < cb_segm->C; i++) {
-      if (softbuffer->cb_crc[i]) {
-        uint32_t cb_len = i < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
-        uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
-        memcpy(softbuffer->data[i], &data[i * rlen / 8], rlen / 8 * sizeof(uint8_t));
-      }
+
+  if (q->nof_deferred_tb == 0) {
+    return 0;
+  }
+
+  uint64_t t0  = srsran_stage_prof_start();
+  int      ret = srsran_tdec_batch_run(&q->batch, q->deferred_cb, q->nof_deferred_cb, q->deferred_max_iterations);
+  if (ret < SRSRAN_SUCCESS) {
+    ERROR("Error running batch Turbo decoder");
+  }
+  srsran_stage_prof_stop(SRSRAN_STAGE_PROF_FEC, t0);
+
+  for (uint32_t i = 0; i < q->nof_deferred_tb; i++) {
+    srsran_sch_deferred_tb_t* tb = &q->deferred_tb[i];
+
+    if (ret < SRSRAN_SUCCESS) {
+      *tb->crc = false;
+      continue;
     }
+
+    float noi = tb->noi;
+    for (uint32_t j = 0; j < tb->nof_cb; j++) {
+      srsran_tdec_batch_cb_t* cb     = &q->deferred_cb[tb->cb_offset + j];
+      uint32_t                cb_idx = tb->cb_idx[j];
+      uint32_t                rlen   = tb->cb_segm.C == 1 ? cb->long_cb : (cb->long_cb - 24);
+
+      memcpy(&tb->data[cb_idx * rlen / 8], cb->output, rlen / 8 * sizeof(uint8_t));
+      tb->softbuffer->cb_crc[cb_idx] = cb->crc_ok;
+      noi += cb->nof_iterations;
+
+      INFO("CB %d: cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d",
+           cb_idx,
+           cb->long_cb,
+           cb->crc_ok ? "OK" : "KO",
+           rlen,
+           cb->nof_iterations,
+           cb->max_iterations);
+    }
+
+    bool cb_crc_ok      = decode_tb_cb_finish(tb->softbuffer, &tb->cb_segm, tb->data);
+    *tb->crc            = (decode_tb_check(q, tb->softbuffer, &tb->cb_segm, tb->data, cb_crc_ok) == SRSRAN_SUCCESS);
+    *tb->avg_iterations = noi / (float)tb->cb_segm.C;
   }
 
-  q->avg_iterations /= (float)cb_segm->C;
-  return softbuffer->tb_crc;
+  uint32_t nof_tb            = q->nof_deferred_tb;
+  q->nof_deferred_tb         = 0;
+  q->nof_deferred_cb         = 0;
+  q->deferred_max_iterations = 0;
+
+  return ret < SRSRAN_SUCCESS ? SRSRAN_ERROR : (int)nof_tb;
 }
 
 /**
@@ -504,6 +787,8 @@ bool decode_tb_cb(srsran_sch_t*           q,
  * @param[in] rv Redundancy Version. Indicates which part of FEC bits is in input buffer
  * @param[out] softbuffer Initialized output softbuffer
  * @param[out] data Decoded transport block
+ * @param[out] crc If not NULL, CRC result. The decoding may be deferred, see srsran_sch_decode_deferred()
+ * @param[out] avg_iterations If not NULL, average number of iterations
  * @return negative if error in parameters or CRC error in decoding
  */
 static int decode_tb(srsran_sch_t*           q,
@@ -513,7 +798,9 @@ static int decode_tb(srsran_sch_t*           q,
                      uint32_t                rv,
                      uint32_t                nof_e_bits,
                      int16_t*                e_bits,
-                     uint8_t*                data)
+                     uint8_t*                data,
+                     bool*                   crc,
+                     float*                  avg_iterations)
 {
   // Check inputs
   if (q == NULL || data == NULL || softbuffer == NULL || e_bits == NULL || cb_segm == NULL || Qm == 0) {
@@ -544,32 +831,20 @@ static int decode_tb(srsran_sch_t*           q,
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
-  // Process Codeblocks
-  bool cb_crc_ok = decode_tb_cb(q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, data);
-
-  // If any of the CBs CRC is KO
-  if (!cb_crc_ok) {
-    INFO("Error in CB parity");
-    return SRSRAN_ERROR;
+  // Queue the code blocks for the batch decoder if the caller can wait for the result
+  if (crc != NULL && q->deferred_decoding && q->llr_is_8bit) {
+    return decode_tb_defer(q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, data, crc, avg_iterations);
   }
 
-  // One CB CRC OK, means TB CRC is OK.
-  if (cb_segm->C == 1) {
-    INFO("TB decoded OK");
-    return SRSRAN_SUCCESS;
-  }
+  // Process Codeblocks
+  bool cb_crc_ok = decode_tb_cb(q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, data);
 
-  // Check TB CRC for whole TB
-  if (srsran_crc_match_byte(&q->crc_tb, data, cb_segm->tbs)) {
-    INFO("TB decoded OK");
-    return SRSRAN_SUCCESS;
+  int ret = decode_tb_check(q, softbuffer, cb_segm, data, cb_crc_ok);
+  if (crc != NULL) {
+    *crc            = (ret == SRSRAN_SUCCESS);
+    *avg_iterations = q->avg_iterations;
   }
-
-  // TB CRC check failed, as at least one CB had a false alarm, reset all CB CRC flags in the softbuffer
-  srsran_softbuffer_rx_reset_cb_crc(softbuffer, cb_segm->C);
-
-  INFO("Error in TB parity");
-  return SRSRAN_ERROR;
+  return ret;
 }
 
 int srsran_dlsch_decode(srsran_sch_t* q, srsran_pdsch_cfg_t* cfg, int16_t* e_bits, uint8_t* data)
@@ -605,7 +880,9 @@ int srsran_dlsch_decode2(srsran_sch_t*       q,
                    cfg->grant.tb[tb_idx].rv,
                    cfg->grant.tb[tb_idx].nof_bits,
                    e_bits,
-                   data);
+                   data,
+                   NULL,
+                   NULL);
 }
 
 /**
@@ -623,12 +900,13 @@ int srsran_dlsch_encode(srsran_sch_t* q, srsran_pdsch_cfg_t* cfg, uint8_t* data,
   return srsran_dlsch_encode2(q, cfg, data, e_bits, 0, 1);
 }
 
-int srsran_dlsch_encode2(srsran_sch_t*       q,
-                         srsran_pdsch_cfg_t* cfg,
-                         uint8_t*            data,
-                         uint8_t*            e_bits,
-                         int                 tb_idx,
-                         uint32_t            nof_layers)
+static int dlsch_encode(srsran_sch_t*       q,
+                        srsran_pdsch_cfg_t* cfg,
+                        uint8_t*            data,
+                        uint8_t*            e_bits,
+                        int                 tb_idx,
+                        uint32_t            nof_layers,
+                        sch_modulate_t*     mod)
 {
   uint32_t Nl = 1;
 
@@ -652,7 +930,45 @@ int srsran_dlsch_encode2(srsran_sch_t*       q,
                    cfg->grant.tb[tb_idx].rv,
                    cfg->grant.tb[tb_idx].nof_bits,
                    data,
-                   e_bits);
+                   e_bits,
+                   mod);
+}
+
+int srsran_dlsch_encode2(srsran_sch_t*       q,
+                         srsran_pdsch_cfg_t* cfg,
+                         uint8_t*            data,
+                         uint8_t*            e_bits,
+                         int                 tb_idx,
+                         uint32_t            nof_layers)
+{
+  return dlsch_encode(q, cfg, data, e_bits, tb_idx, nof_layers, NULL);
+}
+
+int srsran_dlsch_encode2_modulate(srsran_sch_t*               q,
+                                  srsran_pdsch_cfg_t*         cfg,
+                                  uint8_t*                    data,
+                                  uint8_t*                    e_bits,
+                                  int                         tb_idx,
+                                  uint32_t                    nof_layers,
+                                  srsran_sequence_state_t*    scrambler,
+                                  const srsran_modem_table_t* modem,
+                                  cf_t*                       symbols)
+{
+  if (scrambler == NULL || modem == NULL || symbols == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!modem->byte_tables_init) {
+    ERROR("Error need to initiate modem tables for packed bits");
+    return SRSRAN_ERROR;
+  }
+
+  sch_modulate_t mod = {};
+  mod.scrambler      = scrambler;
+  mod.modem          = modem;
+  mod.symbols        = symbols;
+
+  return dlsch_encode(q, cfg, data, e_bits, tb_idx, nof_layers, &mod);
 }
 
 /* Compute the interleaving function on-the-fly, because it depends on number of RI bits
@@ -1119,13 +1435,15 @@ static int uci_decode_ri_ack(srsran_sch_t*       q,
   return Q_prime_ri;
 }
 
-int srsran_ulsch_decode(srsran_sch_t*       q,
+static int ulsch_decode(srsran_sch_t*       q,
                         srsran_pusch_cfg_t* cfg,
                         int16_t*            q_bits,
                         int16_t*            g_bits,
                         uint8_t*            c_seq,
                         uint8_t*            data,
-                        srsran_uci_value_t* uci_data)
+                        srsran_uci_value_t* uci_data,
+                        bool*               crc,
+                        float*              avg_iterations)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
 
@@ -1187,11 +1505,43 @@ int srsran_ulsch_decode(srsran_sch_t*       q,
   // Decode ULSCH
   if (cb_segm.tbs > 0) {
     uint32_t G = nb_q / Qm - Q_prime_ri - Q_prime_cqi;
-    ret        = decode_tb(q, cfg->softbuffers.rx, &cb_segm, Qm, cfg->grant.tb.rv, G * Qm, &g_bits[e_offset], data);
+    ret        = decode_tb(
+        q, cfg->softbuffers.rx, &cb_segm, Qm, cfg->grant.tb.rv, G * Qm, &g_bits[e_offset], data, crc, avg_iterations);
   }
   return ret;
 }
 
+int srsran_ulsch_decode(srsran_sch_t*       q,
+                        srsran_pusch_cfg_t* cfg,
+                        int16_t*            q_bits,
+                        int16_t*            g_bits,
+                        uint8_t*            c_seq,
+                        uint8_t*            data,
+                        srsran_uci_value_t* uci_data)
+{
+  return ulsch_decode(q, cfg, q_bits, g_bits, c_seq, data, uci_data, NULL, NULL);
+}
+
+int srsran_ulsch_decode_deferred(srsran_sch_t*       q,
+                                 srsran_pusch_cfg_t* cfg,
+                                 int16_t*            q_bits,
+                                 int16_t*            g_bits,
+                                 uint8_t*            c_seq,
+                                 uint8_t*            data,
+                                 srsran_uci_value_t* uci_data,
+                                 bool*               crc,
+                                 float*              avg_iterations)
+{
+  if (crc == NULL || avg_iterations == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  *crc            = false;
+  *avg_iterations = 0;
+
+  return ulsch_decode(q, cfg, q_bits, g_bits, c_seq, data, uci_data, crc, avg_iterations);
+}
+
 int srsran_ulsch_encode(srsran_sch_t*       q,
                         srsran_pusch_cfg_t* cfg,
                         uint8_t*            data,
@@ -1286,8 +1636,16 @@ int srsran_ulsch_encode(srsran_sch_t*       q,
   // Encode UL-SCH
   if (cb_segm.tbs > 0) {
     uint32_t G = nb_q / Qm - Q_prime_ri - Q_prime_cqi;
-    ret        = encode_tb_off(
-        q, cfg->softbuffers.tx, &cb_segm, Qm, cfg->grant.tb.rv, G * Qm, data, &g_bits[e_offset / 8], e_offset % 8);
+    ret        = encode_tb_off(q,
+                        cfg->softbuffers.tx,
+                        &cb_segm,
+                        Qm,
+                        cfg->grant.tb.rv,
+                        G * Qm,
+                        data,
+                        &g_bits[e_offset / 8],
+                        e_offset % 8,
+                        NULL);
     if (ret) {
       return ret;
     }
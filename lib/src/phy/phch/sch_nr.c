@@ -28,10 +28,15 @@
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
+#include <pthread.h>
+#include <semaphore.h>
 
 #define SCH_INFO_TX(...) INFO("SCH Tx: " __VA_ARGS__)
 #define SCH_INFO_RX(...) INFO("SCH Rx: " __VA_ARGS__)
 
+// Number of code blocks given to the LDPC encoder in a single call, the temporary code block buffer fits all of them
+#define SCH_NR_ENCODE_BATCH 8
+
 srsran_basegraph_t srsran_sch_nr_select_basegraph(uint32_t tbs, double R)
 {
   // if A ≤ 292 , or if A ≤ 3824 and R ≤ 0.67 , or if R ≤ 0 . 25 , LDPC base graph 2 is used;
@@ -207,7 +212,7 @@ static inline int sch_nr_init_common(srsran_sch_nr_t* q)
   }
 
   if (!q->temp_cb) {
-    q->temp_cb = srsran_vec_u8_malloc(SRSRAN_LDPC_MAX_LEN_CB * 8);
+    q->temp_cb = srsran_vec_u8_malloc(SRSRAN_LDPC_MAX_LEN_CB * SCH_NR_ENCODE_BATCH);
     if (!q->temp_cb) {
       return SRSRAN_ERROR;
     }
@@ -216,6 +221,237 @@ static inline int sch_nr_init_common(srsran_sch_nr_t* q)
   return SRSRAN_SUCCESS;
 }
 
+/**
+ * @brief Describes the decoding of a single code block
+ */
+typedef struct {
+  const int8_t* input; ///< Pointer to the code block rate-matched LLR
+  uint32_t      E;     ///< Number of rate-matched LLR
+  uint32_t      r;     ///< Code block index
+  int           ret;   ///< Number of iterations, 0 if the CRC did not match and SRSRAN_ERROR if an error occurred
+} sch_nr_cb_task_t;
+
+typedef struct {
+  /* Thread identifier: it must be set before thread creation */
+  pthread_t thread;
+  void*     pool_ptr;
+
+  /* Own decoders, rate matcher, CRC and temporal buffer */
+  srsran_sch_nr_t sch;
+
+  /* Semaphore */
+  sem_t start;
+} sch_nr_cb_worker_t;
+
+typedef struct {
+  sch_nr_cb_worker_t* workers;
+  uint32_t            nof_workers;
+
+  /* Current transport block: it must be set before posting the start semaphores */
+  const srsran_sch_nr_tb_info_t* cfg;
+  const srsran_sch_tb_t*         tb;
+  sch_nr_cb_task_t*              tasks;
+  uint32_t                       nof_tasks;
+
+  /* Next task to decode, protected by the mutex */
+  uint32_t        next_task;
+  pthread_mutex_t mutex;
+
+  sem_t finish;
+  bool  quit;
+} sch_nr_cb_pool_t;
+
+static int sch_nr_decode_cb(srsran_sch_nr_t*               q,
+                            const srsran_sch_nr_tb_info_t* cfg,
+                            const srsran_sch_tb_t*         tb,
+                            const sch_nr_cb_task_t*        task)
+{
+  uint32_t r         = task->r;
+  int8_t*  rm_buffer = (int8_t*)tb->softbuffer.tx->buffer_b[r];
+
+  // Select decoder
+  srsran_ldpc_decoder_t* decoder = (cfg->bg == BG1) ? q->decoder_bg1[cfg->Z] : q->decoder_bg2[cfg->Z];
+  if (decoder == NULL) {
+    ERROR("Error: decoder for lifting size Z=%d not found", cfg->Z);
+    return SRSRAN_ERROR;
+  }
+
+  // LDPC Rate matching
+  SCH_INFO_RX("RM CB %d: E=%d; F=%d; BG=%d; Z=%d; RV=%d; Qm=%d; Nref=%d;",
+              r,
+              task->E,
+              cfg->F,
+              cfg->bg == BG1 ? 1 : 2,
+              cfg->Z,
+              tb->rv,
+              cfg->Qm,
+              cfg->Nref);
+  srsran_softbuffer_rx_set_dirty(tb->softbuffer.rx, r);
+  int n_llr = srsran_ldpc_rm_rx_c(
+      &q->rx_rm, task->input, rm_buffer, task->E, cfg->F, cfg->bg, cfg->Z, tb->rv, tb->mod, cfg->Nref);
+  if (n_llr < SRSRAN_SUCCESS) {
+    ERROR("Error in LDPC rate mateching");
+    return SRSRAN_ERROR;
+  }
+
+  // Select CB or TB early stop CRC
+  srsran_crc_t* crc = (cfg->L_tb == 16) ? &q->crc_tb_16 : &q->crc_tb_24;
+  if (cfg->L_cb) {
+    crc = &q->crc_cb;
+  }
+
+  // Decode. if CRC=KO, then ret=0
+  int ret = srsran_ldpc_decoder_decode_crc_c(decoder, rm_buffer, q->temp_cb, n_llr, crc);
+  if (ret < SRSRAN_SUCCESS) {
+    ERROR("Error decoding CB");
+    return SRSRAN_ERROR;
+  }
+
+  // Check if CB is all zeros
+  uint32_t cb_len = cfg->Kp - cfg->L_cb;
+
+  tb->softbuffer.rx->cb_crc[r] = (ret != 0);
+  SCH_INFO_RX("CB %d/%d iter=%d CRC=%s",
+              r,
+              cfg->C,
+              (ret == 0) ? decoder->max_nof_iter : (uint32_t)ret,
+              tb->softbuffer.rx->cb_crc[r] ? "OK" : "KO");
+
+  // CB Debug trace
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
+    DEBUG("CB %d/%d:", r, cfg->C);
+    srsran_vec_fprint_hex(stdout, q->temp_cb, cb_len);
+  }
+
+  // Pack only if CRC is match
+  if (tb->softbuffer.rx->cb_crc[r]) {
+    srsran_bit_pack_vector(q->temp_cb, tb->softbuffer.rx->data[r], cb_len);
+  }
+
+  return ret;
+}
+
+static void sch_nr_cb_pool_run(sch_nr_cb_pool_t* pool, srsran_sch_nr_t* q)
+{
+  while (true) {
+    pthread_mutex_lock(&pool->mutex);
+    uint32_t i = pool->next_task++;
+    pthread_mutex_unlock(&pool->mutex);
+
+    if (i >= pool->nof_tasks) {
+      break;
+    }
+
+    pool->tasks[i].ret = sch_nr_decode_cb(q, pool->cfg, pool->tb, &pool->tasks[i]);
+  }
+}
+
+static void* sch_nr_cb_worker_thread(void* arg)
+{
+  sch_nr_cb_worker_t* w    = (sch_nr_cb_worker_t*)arg;
+  sch_nr_cb_pool_t*   pool = (sch_nr_cb_pool_t*)w->pool_ptr;
+
+  sem_wait(&w->start);
+  while (!pool->quit) {
+    sch_nr_cb_pool_run(pool, &w->sch);
+
+    /* Post finish semaphore */
+    sem_post(&pool->finish);
+
+    /* Wait for next transport block */
+    sem_wait(&w->start);
+  }
+
+  return NULL;
+}
+
+static void sch_nr_cb_pool_free(srsran_sch_nr_t* q)
+{
+  sch_nr_cb_pool_t* pool = (sch_nr_cb_pool_t*)q->cb_pool;
+  if (pool == NULL) {
+    return;
+  }
+
+  /* Stop threads */
+  pool->quit = true;
+  for (uint32_t i = 0; i < pool->nof_workers; i++) {
+    sem_post(&pool->workers[i].start);
+  }
+  for (uint32_t i = 0; i < pool->nof_workers; i++) {
+    pthread_join(pool->workers[i].thread, NULL);
+    sem_destroy(&pool->workers[i].start);
+    srsran_sch_nr_free(&pool->workers[i].sch);
+  }
+
+  sem_destroy(&pool->finish);
+  pthread_mutex_destroy(&pool->mutex);
+  free(pool->workers);
+  free(pool);
+
+  q->cb_pool = NULL;
+}
+
+static int sch_nr_cb_pool_init(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
+{
+  sch_nr_cb_pool_t* pool = SRSRAN_MEM_ALLOC(sch_nr_cb_pool_t, 1);
+  if (pool == NULL) {
+    ERROR("Error: calloc");
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(pool, sch_nr_cb_pool_t, 1);
+
+  pool->workers = SRSRAN_MEM_ALLOC(sch_nr_cb_worker_t, args->nof_cb_workers);
+  if (pool->workers == NULL) {
+    ERROR("Error: calloc");
+    free(pool);
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(pool->workers, sch_nr_cb_worker_t, args->nof_cb_workers);
+
+  if (pthread_mutex_init(&pool->mutex, NULL) || sem_init(&pool->finish, 0, 0)) {
+    ERROR("Error: creating code block pool synchronization");
+    free(pool->workers);
+    free(pool);
+    return SRSRAN_ERROR;
+  }
+  q->cb_pool = pool;
+
+  // The workers decode in the caller thread only
+  srsran_sch_nr_args_t worker_args = *args;
+  worker_args.nof_cb_workers       = 0;
+
+  for (uint32_t i = 0; i < args->nof_cb_workers; i++) {
+    sch_nr_cb_worker_t* w = &pool->workers[i];
+    w->pool_ptr           = pool;
+
+    if (srsran_sch_nr_init_rx(&w->sch, &worker_args) < SRSRAN_SUCCESS) {
+      ERROR("Error: initialising code block worker %d", i);
+      srsran_sch_nr_free(&w->sch);
+      sch_nr_cb_pool_free(q);
+      return SRSRAN_ERROR;
+    }
+
+    if (sem_init(&w->start, 0, 0)) {
+      ERROR("Error: creating semaphore");
+      srsran_sch_nr_free(&w->sch);
+      sch_nr_cb_pool_free(q);
+      return SRSRAN_ERROR;
+    }
+
+    if (pthread_create(&w->thread, NULL, sch_nr_cb_worker_thread, w)) {
+      ERROR("Error: creating code block worker %d", i);
+      sem_destroy(&w->start);
+      srsran_sch_nr_free(&w->sch);
+      sch_nr_cb_pool_free(q);
+      return SRSRAN_ERROR;
+    }
+
+    pool->nof_workers++;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_sch_nr_init_tx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
 {
   int ret = sch_nr_init_common(q);
@@ -306,6 +542,10 @@ int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
   // and MCS indexes for all possible MCS tables
   float scaling_factor = isnormal(args->decoder_scaling_factor) ? args->decoder_scaling_factor : 0.8f;
 
+  // The offset min-sum algorithm uses the default offset of the decoder
+  srsran_ldpc_decoder_ms_t ms_type =
+      args->decoder_offset_min_sum ? SRSRAN_LDPC_DECODER_MS_OFFSET : SRSRAN_LDPC_DECODER_MS_NORMALIZED;
+
   // Iterate over all possible lifting sizes
   for (uint16_t ls = 0; ls <= MAX_LIFTSIZE; ls++) {
     uint8_t ls_index = get_ls_index(ls);
@@ -323,6 +563,8 @@ int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
     decoder_args.ls                         = ls;
     decoder_args.scaling_fctr               = scaling_factor;
     decoder_args.max_nof_iter               = args->max_nof_iter;
+    decoder_args.ms_type                    = ms_type;
+    decoder_args.early_stop                 = args->decoder_early_stop;
 
     q->decoder_bg1[ls] = SRSRAN_MEM_ALLOC(srsran_ldpc_decoder_t, 1);
     if (!q->decoder_bg1[ls]) {
@@ -355,6 +597,14 @@ int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
     ERROR("Error: initialising Rx LDPC Rate matching");
     return SRSRAN_ERROR;
   }
+  srsran_ldpc_rm_rx_set_cache_c(&q->rx_rm, args->rm_cache);
+
+  if (args->nof_cb_workers > 0 && q->cb_pool == NULL) {
+    if (sch_nr_cb_pool_init(q, args) < SRSRAN_SUCCESS) {
+      ERROR("Error: initialising code block worker pool");
+      return SRSRAN_ERROR;
+    }
+  }
 
   return SRSRAN_SUCCESS;
 }
@@ -377,6 +627,8 @@ void srsran_sch_nr_free(srsran_sch_nr_t* q)
     return;
   }
 
+  sch_nr_cb_pool_free(q);
+
   if (q->temp_cb) {
     free(q->temp_cb);
   }
@@ -468,84 +720,106 @@ static inline int sch_nr_encode(srsran_sch_nr_t*        q,
     srsran_vec_fprint_byte(stdout, data, tb->tbs / 8);
   }
 
-  // For each code block...
+  // For each batch of code blocks...
   uint32_t j = 0;
-  for (uint32_t r = 0; r < cfg.C; r++) {
-    // Select rate matching circular buffer
-    uint8_t* rm_buffer = tb->softbuffer.tx->buffer_b[r];
-    if (rm_buffer == NULL) {
-      ERROR("Error: soft-buffer provided NULL buffer for cb_idx=%d", r);
-      return SRSRAN_ERROR;
-    }
-
-    // If data provided, encode and store in RM circular buffer
-    if (data != NULL) {
-      uint32_t cb_len = cfg.Kp - cfg.L_cb;
-
-      // If it is the last segment...
-      if (r == cfg.C - 1) {
-        cb_len -= cfg.L_tb;
-
-        // Copy payload without TB CRC
-        srsran_bit_unpack_vector(input_ptr, q->temp_cb, (int)cb_len);
-
-        // Append TB CRC
-        uint8_t* ptr = &q->temp_cb[cb_len];
-        srsran_bit_unpack(checksum_tb, &ptr, cfg.L_tb);
-        SCH_INFO_TX("CB %d: appending TB CRC=%06x", r, checksum_tb);
-      } else {
-        // Copy payload
-        srsran_bit_unpack_vector(input_ptr, q->temp_cb, (int)cb_len);
-      }
-
-      if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
-        DEBUG("cb%d=", r);
-        srsran_vec_fprint_byte(stdout, input_ptr, cb_len / 8);
+  for (uint32_t r0 = 0; r0 < cfg.C; r0 += SCH_NR_ENCODE_BATCH) {
+    uint32_t       nof_cbs = SRSRAN_MIN(SCH_NR_ENCODE_BATCH, cfg.C - r0);
+    const uint8_t* cb_in[SCH_NR_ENCODE_BATCH];
+    uint8_t*       cb_out[SCH_NR_ENCODE_BATCH];
+
+    for (uint32_t b = 0; b < nof_cbs; b++) {
+      uint32_t r = r0 + b;
+
+      // Select rate matching circular buffer
+      cb_out[b] = tb->softbuffer.tx->buffer_b[r];
+      if (cb_out[b] == NULL) {
+        ERROR("Error: soft-buffer provided NULL buffer for cb_idx=%d", r);
+        return SRSRAN_ERROR;
       }
 
-      input_ptr += cb_len / 8;
-
-      // Attach code block CRC if required
-      if (cfg.L_cb) {
-        srsran_crc_attach(&q->crc_cb, q->temp_cb, (int)(cfg.Kp - cfg.L_cb));
-        SCH_INFO_TX("CB %d: CRC=%06x", r, (uint32_t)srsran_crc_checksum_get(&q->crc_cb));
+      // If data provided, prepare the code block for encoding
+      if (data != NULL) {
+        uint8_t* temp_cb = &q->temp_cb[b * SRSRAN_LDPC_MAX_LEN_CB];
+        uint32_t cb_len  = cfg.Kp - cfg.L_cb;
+
+        // If it is the last segment...
+        if (r == cfg.C - 1) {
+          cb_len -= cfg.L_tb;
+
+          // Copy payload without TB CRC
+          srsran_bit_unpack_vector(input_ptr, temp_cb, (int)cb_len);
+
+          // Append TB CRC
+          uint8_t* ptr = &temp_cb[cb_len];
+          srsran_bit_unpack(checksum_tb, &ptr, cfg.L_tb);
+          SCH_INFO_TX("CB %d: appending TB CRC=%06x", r, checksum_tb);
+        } else {
+          // Copy payload
+          srsran_bit_unpack_vector(input_ptr, temp_cb, (int)cb_len);
+        }
+
+        if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
+          DEBUG("cb%d=", r);
+          srsran_vec_fprint_byte(stdout, input_ptr, cb_len / 8);
+        }
+
+        input_ptr += cb_len / 8;
+
+        // Attach code block CRC if required
+        if (cfg.L_cb) {
+          srsran_crc_attach(&q->crc_cb, temp_cb, (int)(cfg.Kp - cfg.L_cb));
+          SCH_INFO_TX("CB %d: CRC=%06x", r, (uint32_t)srsran_crc_checksum_get(&q->crc_cb));
+        }
+
+        // Insert filler bits
+        for (uint32_t i = cfg.Kp; i < cfg.Kr; i++) {
+          temp_cb[i] = FILLER_BIT;
+        }
+
+        cb_in[b] = temp_cb;
       }
+    }
 
-      // Insert filler bits
-      for (uint32_t i = cfg.Kp; i < cfg.Kr; i++) {
-        q->temp_cb[i] = FILLER_BIT;
+    // Encode all the code blocks of the batch
+    if (data != NULL) {
+      if (srsran_ldpc_encoder_encode_batch(encoder, cb_in, cb_out, nof_cbs, cfg.Kr) < SRSRAN_SUCCESS) {
+        ERROR("Error encoding code blocks %d to %d", r0, r0 + nof_cbs - 1);
+        return SRSRAN_ERROR;
       }
 
-      // Encode code block
-      srsran_ldpc_encoder_encode(encoder, q->temp_cb, rm_buffer, cfg.Kr);
-
       if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
-        DEBUG("encoded=");
-        srsran_vec_fprint_b(stdout, rm_buffer, encoder->liftN - 2 * encoder->ls);
+        for (uint32_t b = 0; b < nof_cbs; b++) {
+          DEBUG("encoded=");
+          srsran_vec_fprint_b(stdout, cb_out[b], encoder->liftN - 2 * encoder->ls);
+        }
       }
     }
 
-    // Skip block
-    if (!cfg.mask[r]) {
-      continue;
-    }
+    for (uint32_t b = 0; b < nof_cbs; b++) {
+      uint32_t r = r0 + b;
 
-    // Select rate matching output sequence number of bits
-    uint32_t E = sch_nr_get_E(&cfg, j);
-    j++;
+      // Skip block
+      if (!cfg.mask[r]) {
+        continue;
+      }
 
-    // LDPC Rate matching
-    SCH_INFO_TX("RM CB %d: E=%d; F=%d; BG=%d; Z=%d; RV=%d; Qm=%d; Nref=%d;",
-                r,
-                E,
-                cfg.F,
-                cfg.bg == BG1 ? 1 : 2,
-                cfg.Z,
-                tb->rv,
-                cfg.Qm,
-                cfg.Nref);
-    srsran_ldpc_rm_tx(&q->tx_rm, rm_buffer, output_ptr, E, cfg.bg, cfg.Z, tb->rv, tb->mod, cfg.Nref);
-    output_ptr += E;
+      // Select rate matching output sequence number of bits
+      uint32_t E = sch_nr_get_E(&cfg, j);
+      j++;
+
+      // LDPC Rate matching
+      SCH_INFO_TX("RM CB %d: E=%d; F=%d; BG=%d; Z=%d; RV=%d; Qm=%d; Nref=%d;",
+                  r,
+                  E,
+                  cfg.F,
+                  cfg.bg == BG1 ? 1 : 2,
+                  cfg.Z,
+                  tb->rv,
+                  cfg.Qm,
+                  cfg.Nref);
+      srsran_ldpc_rm_tx(&q->tx_rm, cb_out[b], output_ptr, E, cfg.bg, cfg.Z, tb->rv, tb->mod, cfg.Nref);
+      output_ptr += E;
+    }
   }
 
   return SRSRAN_SUCCESS;
@@ -603,10 +877,21 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     return SRSRAN_ERROR;
   }
 
+  // Allocate the code blocks that the soft-buffer has not used yet
+  if (srsran_softbuffer_rx_reserve_cb(tb->softbuffer.rx, SRSRAN_MIN(cfg.C, tb->softbuffer.rx->max_cb)) <
+      SRSRAN_SUCCESS) {
+    ERROR("Error allocating %d code blocks in the soft-buffer", cfg.C);
+    return SRSRAN_ERROR;
+  }
+
   // Counter of code blocks that have matched CRC
   uint32_t cb_ok = 0;
   res->crc       = false;
 
+  // Code blocks pending decoding
+  sch_nr_cb_task_t tasks[SRSRAN_SCH_NR_MAX_NOF_CB_LDPC];
+  uint32_t         nof_tasks = 0;
+
   // For each code block...
   uint32_t j = 0;
   for (uint32_t r = 0; r < cfg.C; r++) {
@@ -634,63 +919,58 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     if (decoded) {
       SCH_INFO_RX("RM CB %d: CRC OK ... Skipping", r);
       cb_ok++;
+      input_ptr += E;
       continue;
     }
 
-    // LDPC Rate matching
-    SCH_INFO_RX("RM CB %d: E=%d; F=%d; BG=%d; Z=%d; RV=%d; Qm=%d; Nref=%d;",
-                r,
-                E,
-                cfg.F,
-                cfg.bg == BG1 ? 1 : 2,
-                cfg.Z,
-                tb->rv,
-                cfg.Qm,
-                cfg.Nref);
-    int n_llr =
-        srsran_ldpc_rm_rx_c(&q->rx_rm, input_ptr, rm_buffer, E, cfg.F, cfg.bg, cfg.Z, tb->rv, tb->mod, cfg.Nref);
-    if (n_llr < SRSRAN_SUCCESS) {
-      ERROR("Error in LDPC rate mateching");
-      return SRSRAN_ERROR;
+    tasks[nof_tasks].input = input_ptr;
+    tasks[nof_tasks].E     = E;
+    tasks[nof_tasks].r     = r;
+    tasks[nof_tasks].ret   = SRSRAN_ERROR;
+    nof_tasks++;
+
+    input_ptr += E;
+  }
+
+  // Decode the code blocks, sharing them with the worker pool if there is more than one
+  sch_nr_cb_pool_t* pool = (sch_nr_cb_pool_t*)q->cb_pool;
+  if (pool != NULL && nof_tasks > 1) {
+    pool->cfg       = &cfg;
+    pool->tb        = tb;
+    pool->tasks     = tasks;
+    pool->nof_tasks = nof_tasks;
+    pool->next_task = 0;
+
+    for (uint32_t i = 0; i < pool->nof_workers; i++) {
+      sem_post(&pool->workers[i].start);
     }
 
-    // Select CB or TB early stop CRC
-    srsran_crc_t* crc = (cfg.L_tb == 16) ? &q->crc_tb_16 : &q->crc_tb_24;
-    if (cfg.L_cb) {
-      crc = &q->crc_cb;
+    sch_nr_cb_pool_run(pool, q);
+
+    for (uint32_t i = 0; i < pool->nof_workers; i++) {
+      sem_wait(&pool->finish);
     }
+  } else {
+    for (uint32_t i = 0; i < nof_tasks; i++) {
+      tasks[i].ret = sch_nr_decode_cb(q, &cfg, tb, &tasks[i]);
+    }
+  }
 
-    // Decode. if CRC=KO, then ret=0
-    int ret = srsran_ldpc_decoder_decode_crc_c(decoder, rm_buffer, q->temp_cb, n_llr, crc);
-    if (ret < SRSRAN_SUCCESS) {
-      ERROR("Error decoding CB");
+  // Count iterations and CRC OK
+  for (uint32_t i = 0; i < nof_tasks; i++) {
+    if (tasks[i].ret < SRSRAN_SUCCESS) {
       return SRSRAN_ERROR;
     }
 
     // Compute number of iterations
-    uint32_t n_iter_cb = (ret == 0) ? decoder->max_nof_iter : (uint32_t)ret;
+    uint32_t n_iter_cb = (tasks[i].ret == 0) ? decoder->max_nof_iter : (uint32_t)tasks[i].ret;
     nof_iter_sum += n_iter_cb;
 
-    // Check if CB is all zeros
-    uint32_t cb_len = cfg.Kp - cfg.L_cb;
-
-    tb->softbuffer.rx->cb_crc[r] = (ret != 0);
-    SCH_INFO_RX("CB %d/%d iter=%d CRC=%s", r, cfg.C, n_iter_cb, tb->softbuffer.rx->cb_crc[r] ? "OK" : "KO");
-
-    // CB Debug trace
-    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
-      DEBUG("CB %d/%d:", r, cfg.C);
-      srsran_vec_fprint_hex(stdout, q->temp_cb, cb_len);
-    }
-
-    // Pack and count CRC OK only if CRC is match
-    if (tb->softbuffer.rx->cb_crc[r]) {
-      srsran_bit_pack_vector(q->temp_cb, tb->softbuffer.rx->data[r], cb_len);
+    if (tb->softbuffer.rx->cb_crc[tasks[i].r]) {
       cb_ok++;
     }
-
-    input_ptr += E;
   }
+
   // Set average number of iterations
   res->avg_iter = (float)nof_iter_sum / (float)cfg.C;
 
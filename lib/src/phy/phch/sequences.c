@@ -69,6 +69,11 @@ int srsran_sequence_pdsch(srsran_sequence_t* seq, uint16_t rnti, int q, uint32_t
   return srsran_sequence_LTE_pr(seq, len, sequence_pdsch_seed(rnti, q, nslot, cell_id));
 }
 
+uint32_t srsran_sequence_pdsch_seed(uint16_t rnti, int q, uint32_t nslot, uint32_t cell_id)
+{
+  return sequence_pdsch_seed(rnti, q, nslot, cell_id);
+}
+
 void srsran_sequence_pdsch_apply_pack(const uint8_t* in,
                                       uint8_t*       out,
                                       uint16_t       rnti,
@@ -121,6 +126,11 @@ static inline uint32_t sequence_pusch_seed(uint16_t rnti, uint32_t nslot, uint32
   return (rnti << 14) + ((nslot / 2) << 9) + cell_id;
 }
 
+uint32_t srsran_sequence_pusch_seed(uint16_t rnti, uint32_t nslot, uint32_t cell_id)
+{
+  return sequence_pusch_seed(rnti, nslot, cell_id);
+}
+
 int srsran_sequence_pusch(srsran_sequence_t* seq, uint16_t rnti, uint32_t nslot, uint32_t cell_id, uint32_t len)
 {
   return srsran_sequence_LTE_pr(seq, len, sequence_pusch_seed(rnti, nslot, cell_id));
@@ -283,6 +283,16 @@ static int test_case1()
           t_decode_us += (size_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
           t_decode_count++;
 
+          // Decoding the same candidate again must give the same result without running the decoder
+          srsran_dci_msg_t dci_rx2 = {};
+          dci_rx2.location         = locations[loc_rx];
+          dci_rx2.format           = format;
+          uint32_t nof_hits        = pdcch_rx.nof_decoded_hits;
+          TESTASSERT(srsran_pdcch_decode_msg(&pdcch_rx, &dl_sf_cfg, &dci_cfg, &dci_rx2) == SRSRAN_SUCCESS);
+          TESTASSERT(dci_rx2.rnti == dci_rx.rnti && dci_rx2.nof_bits == dci_rx.nof_bits);
+          TESTASSERT(memcmp(dci_rx2.payload, dci_rx.payload, dci_rx.nof_bits) == 0);
+          TESTASSERT(dci_rx.nof_bits == 0 || pdcch_rx.nof_decoded_hits == nof_hits + 1);
+
           // Compute LLR correlation
           float corr = srsran_pdcch_msg_corr(&pdcch_rx, &dci_rx);
 
@@ -38,6 +38,7 @@ static uint32_t config_idx       = 3;
 static uint32_t root_seq_idx     = 0;
 static uint32_t zero_corr_zone   = 15;
 static uint32_t num_ra_preambles = 0; // use default
+static uint32_t nof_workers      = 0;
 
 static void usage(char* prog)
 {
@@ -47,12 +48,13 @@ static void usage(char* prog)
   printf("\t-r Root sequence index [Default 0]\n");
   printf("\t-z Zero correlation zone config [Default 1]\n");
   printf("\t-N Toggle LTE/NR operation, zero for LTE, non-zero for NR [Default %s]\n", is_nr ? "NR" : "LTE");
+  printf("\t-t Number of root correlation worker threads [Default %d]\n", nof_workers);
 }
 
 static void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "nfrzN")) != -1) {
+  while ((opt = getopt(argc, argv, "nfrzNt")) != -1) {
     switch (opt) {
       case 'n':
         nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -69,6 +71,9 @@ static void parse_args(int argc, char** argv)
       case 'N':
         is_nr = (uint32_t)strtol(argv[optind], NULL, 10) > 0;
         break;
+      case 't':
+        nof_workers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -100,6 +105,11 @@ int main(int argc, char** argv)
     return -1;
   }
 
+  if (srsran_prach_set_nof_workers(&prach, nof_workers)) {
+    ERROR("Error starting PRACH workers");
+    return -1;
+  }
+
   struct timeval t[3] = {};
   gettimeofday(&t[1], NULL);
   if (srsran_prach_set_cfg(&prach, &prach_cfg, nof_prb)) {
@@ -113,6 +123,7 @@ int main(int argc, char** argv)
   uint32_t seq_index = 0;
   uint32_t indices[64];
   uint32_t n_indices = 0;
+  uint64_t total_us  = 0;
   for (int i = 0; i < 64; i++)
     indices[i] = 0;
 
@@ -126,10 +137,13 @@ int main(int argc, char** argv)
     gettimeofday(&t[2], NULL);
     get_time_interval(t);
     printf("texec=%ld us\n", t[0].tv_usec);
+    total_us += t[0].tv_usec + t[0].tv_sec * 1000000UL;
     if (n_indices != 1 || indices[0] != seq_index)
       return -1;
   }
 
+  printf("Detected %.1f preambles per second with %d workers\n", 64 * 1e6 / SRSRAN_MAX(total_us, 1), nof_workers);
+
   srsran_prach_free(&prach);
 
   printf("Done\n");
@@ -29,10 +29,11 @@
 
 static srsran_carrier_nr_t carrier = SRSRAN_DEFAULT_CARRIER_NR;
 
-static uint32_t            n_prb     = 0;  // Set to 0 for steering
-static uint32_t            mcs       = 30; // Set to 30 for steering
-static uint32_t            rv        = 4;  // Set to 30 for steering
-static srsran_sch_cfg_nr_t pdsch_cfg = {};
+static uint32_t            n_prb          = 0;  // Set to 0 for steering
+static uint32_t            mcs            = 30; // Set to 30 for steering
+static uint32_t            rv             = 4;  // Set to 30 for steering
+static uint32_t            nof_cb_workers = 0;  // Set to 0 for decoding the code blocks in the main thread
+static srsran_sch_cfg_nr_t pdsch_cfg      = {};
 
 static void usage(char* prog)
 {
@@ -44,13 +45,14 @@ static void usage(char* prog)
   printf("\t-T Provide MCS table (64qam, 256qam, 64qamLowSE) [Default %s]\n",
          srsran_mcs_table_to_str(pdsch_cfg.sch_cfg.mcs_table));
   printf("\t-L Provide number of layers [Default %d]\n", carrier.max_mimo_layers);
+  printf("\t-W Number of code block decoder worker threads [Default %d]\n", nof_cb_workers);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "PpmTLvr")) != -1) {
+  while ((opt = getopt(argc, argv, "PpmTLvrW")) != -1) {
     switch (opt) {
       case 'P':
         carrier.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -70,6 +72,9 @@ int parse_args(int argc, char** argv)
       case 'L':
         carrier.max_mimo_layers = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'W':
+        nof_cb_workers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -110,6 +115,7 @@ int main(int argc, char** argv)
   args.decoder_use_flooded    = false;
   args.decoder_scaling_factor = 0.8;
   args.max_nof_iter           = 20;
+  args.nof_cb_workers         = nof_cb_workers;
   if (srsran_sch_nr_init_tx(&sch_nr_tx, &args) < SRSRAN_SUCCESS) {
     ERROR("Error initiating SCH NR for Tx");
     goto clean_exit;
@@ -139,7 +145,7 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
-  if (srsran_softbuffer_rx_init_guru(&softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
+  if (srsran_softbuffer_rx_init_nr(&softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
       SRSRAN_SUCCESS) {
     ERROR("Error init soft-buffer");
     goto clean_exit;
@@ -187,6 +187,69 @@ void srsran_interp_linear_vector3(srsran_interp_linsrsran_vec_t* q,
   }
 }
 
+/* Interpolation within a vector for fixed cell bandwidths. With the pilot count and the interpolation factor known at
+ * compile time, the compiler unrolls the inner loop and vectorises the whole PRB span, instead of the generic path
+ * issuing one short vector product per pilot. */
+static inline void interp_linear_core(const cf_t* input, cf_t* output, const uint32_t vector_len, const uint32_t M)
+{
+  const float inv_M = 1.0f / (float)M;
+  for (uint32_t i = 0; i < vector_len - 1; i++) {
+    cf_t diff = (input[i + 1] - input[i]) * inv_M;
+    for (uint32_t j = 0; j < M; j++) {
+      output[i * M + j] = input[i] + diff * (float)j;
+    }
+  }
+}
+
+#ifdef SRSRAN_INTERP_FIXED_BW
+
+#define INTERP_LINEAR_FIXED(LEN, M)                                                                                    \
+  static void interp_linear_##LEN##_##M(const cf_t* input, cf_t* output)                                              \
+  {                                                                                                                    \
+    interp_linear_core(input, output, LEN, M);                                                                         \
+  }
+
+// LTE 100 PRB: CRS with 2, 4 and 6 pilots per PRB
+INTERP_LINEAR_FIXED(200, 6)
+INTERP_LINEAR_FIXED(400, 3)
+INTERP_LINEAR_FIXED(600, 2)
+// NR 52, 106 and 273 PRB: DMRS type 1 (6 pilots per PRB) and type 2 (4 pilots per PRB)
+INTERP_LINEAR_FIXED(312, 2)
+INTERP_LINEAR_FIXED(636, 2)
+INTERP_LINEAR_FIXED(1638, 2)
+INTERP_LINEAR_FIXED(208, 3)
+INTERP_LINEAR_FIXED(424, 3)
+INTERP_LINEAR_FIXED(1092, 3)
+
+static const struct {
+  uint32_t                   vector_len;
+  uint32_t                   M;
+  srsran_interp_lin_kernel_t kernel;
+} interp_linear_fixed_kernels[] = {{200, 6, interp_linear_200_6},
+                                   {400, 3, interp_linear_400_3},
+                                   {600, 2, interp_linear_600_2},
+                                   {312, 2, interp_linear_312_2},
+                                   {636, 2, interp_linear_636_2},
+                                   {1638, 2, interp_linear_1638_2},
+                                   {208, 3, interp_linear_208_3},
+                                   {424, 3, interp_linear_424_3},
+                                   {1092, 3, interp_linear_1092_3}};
+
+#endif /* SRSRAN_INTERP_FIXED_BW */
+
+static srsran_interp_lin_kernel_t interp_linear_select_kernel(uint32_t vector_len, uint32_t M)
+{
+#ifdef SRSRAN_INTERP_FIXED_BW
+  const uint32_t nof_kernels = sizeof(interp_linear_fixed_kernels) / sizeof(interp_linear_fixed_kernels[0]);
+  for (uint32_t k = 0; k < nof_kernels; k++) {
+    if (interp_linear_fixed_kernels[k].vector_len == vector_len && interp_linear_fixed_kernels[k].M == M) {
+      return interp_linear_fixed_kernels[k].kernel;
+    }
+  }
+#endif /* SRSRAN_INTERP_FIXED_BW */
+  return NULL;
+}
+
 int srsran_interp_linear_init(srsran_interp_lin_t* q, uint32_t vector_len, uint32_t M)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
@@ -220,6 +283,7 @@ int srsran_interp_linear_init(srsran_interp_lin_t* q, uint32_t vector_len, uint3
     q->M              = M;
     q->max_vector_len = vector_len;
     q->max_M          = M;
+    q->fixed_kernel   = interp_linear_select_kernel(vector_len, M);
   }
   return ret;
 }
@@ -246,6 +310,9 @@ int srsran_interp_linear_resize(srsran_interp_lin_t* q, uint32_t vector_len, uin
       q->ramp[i] = (float)i;
     }
 
+    if (vector_len != q->vector_len || M != q->M) {
+      q->fixed_kernel = interp_linear_select_kernel(vector_len, M);
+    }
     q->vector_len = vector_len;
     q->M          = M;
     return SRSRAN_SUCCESS;
@@ -264,16 +331,21 @@ void srsran_interp_linear_offset(srsran_interp_lin_t* q, cf_t* input, cf_t* outp
   for (j = 0; j < off_st; j++) {
     output[off_st - j - 1] = input[i] - (j + 1) * (input[i + 1] - input[i]) / q->M;
   }
-  srsran_vec_sub_ccc(&input[1], input, q->diff_vec, (q->vector_len - 1));
-  srsran_vec_sc_prod_cfc(q->diff_vec, (float)1 / q->M, q->diff_vec, q->vector_len - 1);
-  for (i = 0; i < q->vector_len - 1; i++) {
-    for (j = 0; j < q->M; j++) {
-      output[i * q->M + j + off_st] = input[i];
-      q->diff_vec2[i * q->M + j]    = q->diff_vec[i];
+  if (q->fixed_kernel) {
+    q->fixed_kernel(input, &output[off_st]);
+    i = q->vector_len - 1;
+  } else {
+    srsran_vec_sub_ccc(&input[1], input, q->diff_vec, (q->vector_len - 1));
+    srsran_vec_sc_prod_cfc(q->diff_vec, (float)1 / q->M, q->diff_vec, q->vector_len - 1);
+    for (i = 0; i < q->vector_len - 1; i++) {
+      for (j = 0; j < q->M; j++) {
+        output[i * q->M + j + off_st] = input[i];
+        q->diff_vec2[i * q->M + j]    = q->diff_vec[i];
+      }
+      srsran_vec_prod_cfc(&q->diff_vec2[i * q->M], q->ramp, &q->diff_vec2[i * q->M], q->M);
     }
-    srsran_vec_prod_cfc(&q->diff_vec2[i * q->M], q->ramp, &q->diff_vec2[i * q->M], q->M);
+    srsran_vec_sum_ccc(&output[off_st], q->diff_vec2, &output[off_st], q->M * (q->vector_len - 1));
   }
-  srsran_vec_sum_ccc(&output[off_st], q->diff_vec2, &output[off_st], q->M * (q->vector_len - 1));
 
   if (q->vector_len > 1) {
     diff = input[q->vector_len - 1] - input[q->vector_len - 2];
@@ -0,0 +1,333 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector.h"
+
+/**
+ * Number of taps of each polyphase branch when interpolating, it is scaled by the decimation to interpolation ratio
+ * when decimating
+ */
+#define RESAMPLER_POLY_TAPS 32
+
+/**
+ * The number of taps is rounded up to a multiple of the largest SIMD size for complex samples
+ */
+#define RESAMPLER_POLY_TAPS_ALIGN 16
+
+/**
+ * Kaiser window shape parameter, a beta of 8 gives about 80 dB of stop-band attenuation
+ */
+#define RESAMPLER_POLY_KAISER_BETA 8.0
+
+/**
+ * Maximum interpolation factor after reducing the ratio, it bounds the size of the filter bank
+ */
+#define RESAMPLER_POLY_MAX_INTERP 64
+
+/**
+ * Number of input samples processed at once through the internal buffer
+ */
+#define RESAMPLER_POLY_BLOCK 1024
+
+static uint32_t resampler_poly_gcd(uint32_t a, uint32_t b)
+{
+  while (b != 0) {
+    uint32_t t = a % b;
+    a          = b;
+    b          = t;
+  }
+  return a;
+}
+
+// Zeroth order modified Bessel function of the first kind
+static double resampler_poly_bessel_i0(double x)
+{
+  double sum  = 1.0;
+  double term = 1.0;
+  for (uint32_t k = 1; k < 32; k++) {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+  }
+  return sum;
+}
+
+// Dot product between the complex samples and the real taps of one branch
+static inline cf_t resampler_poly_dot(const cf_t* x, const cf_t* taps, uint32_t nof_taps)
+{
+  cf_t     y = 0.0f;
+  uint32_t j = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  simd_cf_t acc = srsran_simd_cf_zero();
+  for (; j + SRSRAN_SIMD_CF_SIZE < nof_taps + 1; j += SRSRAN_SIMD_CF_SIZE) {
+    simd_f_t t = srsran_simd_cf_re(srsran_simd_cfi_load(taps + j));
+    acc        = srsran_simd_cf_add(acc, srsran_simd_cf_mul(srsran_simd_cfi_loadu(x + j), t));
+  }
+
+  srsran_simd_aligned cf_t v[SRSRAN_SIMD_CF_SIZE];
+  srsran_simd_cfi_store(v, acc);
+  for (uint32_t k = 0; k < SRSRAN_SIMD_CF_SIZE; k++) {
+    y += v[k];
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  for (; j < nof_taps; j++) {
+    y += x[j] * crealf(taps[j]);
+  }
+
+  return y;
+}
+
+#if SRSRAN_SIMD_CF_SIZE
+// Computes SRSRAN_SIMD_F_SIZE output samples at once, the accumulators are reduced together with a tree of horizontal
+// additions which leaves the sum of every accumulator in its own lane. The taps are loaded as complex numbers so they
+// follow the same lane order as the samples
+static inline void resampler_poly_dot_group(const srsran_resampler_poly_t* q,
+                                            const uint32_t*                idx,
+                                            const uint32_t*                phase,
+                                            cf_t*                          y)
+{
+  simd_f_t re[SRSRAN_SIMD_F_SIZE];
+  simd_f_t im[SRSRAN_SIMD_F_SIZE];
+
+  for (uint32_t k = 0; k < SRSRAN_SIMD_F_SIZE; k++) {
+    const cf_t* x    = &q->buffer[idx[k]];
+    const cf_t* taps = &q->bank[q->nof_taps * phase[k]];
+
+    simd_cf_t acc = srsran_simd_cf_zero();
+    for (uint32_t j = 0; j < q->nof_taps; j += SRSRAN_SIMD_CF_SIZE) {
+      simd_f_t t = srsran_simd_cf_re(srsran_simd_cfi_load(taps + j));
+      acc        = srsran_simd_cf_add(acc, srsran_simd_cf_mul(srsran_simd_cfi_loadu(x + j), t));
+    }
+    re[k] = srsran_simd_cf_re(acc);
+    im[k] = srsran_simd_cf_im(acc);
+  }
+
+  for (uint32_t n = SRSRAN_SIMD_F_SIZE; n > 1; n /= 2) {
+    for (uint32_t k = 0; k < n / 2; k++) {
+      re[k] = srsran_simd_f_hadd(re[2 * k], re[2 * k + 1]);
+      im[k] = srsran_simd_f_hadd(im[2 * k], im[2 * k + 1]);
+    }
+  }
+
+  srsran_simd_aligned float v_re[SRSRAN_SIMD_F_SIZE];
+  srsran_simd_aligned float v_im[SRSRAN_SIMD_F_SIZE];
+  srsran_simd_f_store(v_re, re[0]);
+  srsran_simd_f_store(v_im, im[0]);
+  for (uint32_t k = 0; k < SRSRAN_SIMD_F_SIZE; k++) {
+    y[k] = v_re[k] + _Complex_I * v_im[k];
+  }
+}
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+int srsran_resampler_poly_init(srsran_resampler_poly_t* q, uint32_t interp, uint32_t decim)
+{
+  if (q == NULL || interp == 0 || decim == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Reduce ratio
+  uint32_t gcd = resampler_poly_gcd(interp, decim);
+  interp /= gcd;
+  decim /= gcd;
+
+  if (interp > RESAMPLER_POLY_MAX_INTERP) {
+    ERROR("Polyphase resampler interpolation factor %d exceeds the maximum %d", interp, RESAMPLER_POLY_MAX_INTERP);
+    return SRSRAN_ERROR;
+  }
+
+  // Skip initialisation if the ratio did not change
+  uint32_t nof_taps = SRSRAN_CEIL(RESAMPLER_POLY_TAPS * SRSRAN_MAX(interp, decim), interp);
+  nof_taps          = SRSRAN_CEIL(nof_taps, RESAMPLER_POLY_TAPS_ALIGN) * RESAMPLER_POLY_TAPS_ALIGN;
+  if (q->bank != NULL && q->interp == interp && q->decim == decim && q->nof_taps == nof_taps) {
+    srsran_resampler_poly_reset_state(q);
+    return SRSRAN_SUCCESS;
+  }
+
+  srsran_resampler_poly_free(q);
+
+  q->interp   = interp;
+  q->decim    = decim;
+  q->nof_taps = nof_taps;
+  q->bank     = srsran_vec_cf_malloc(nof_taps * interp);
+  q->buffer   = srsran_vec_cf_malloc(nof_taps - 1 + RESAMPLER_POLY_BLOCK);
+  if (q->bank == NULL || q->buffer == NULL) {
+    ERROR("Error allocating memory");
+    srsran_resampler_poly_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  // Low-pass prototype at the interpolated rate, with the cut-off at half of the lowest rate
+  uint32_t N      = nof_taps * interp;
+  double   center = (N - 1) / 2.0;
+  double   fc     = 0.5 / SRSRAN_MAX(interp, decim);
+  double   i0     = resampler_poly_bessel_i0(RESAMPLER_POLY_KAISER_BETA);
+  double*  h      = calloc(N, sizeof(double));
+  if (h == NULL) {
+    ERROR("Error allocating memory");
+    srsran_resampler_poly_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  double sum = 0.0;
+  for (uint32_t n = 0; n < N; n++) {
+    double t    = n - center;
+    double x    = 2.0 * fc * t;
+    double r    = 2.0 * t / (N - 1);
+    double sinc = (fabs(x) < 1e-9) ? 1.0 : sin(M_PI * x) / (M_PI * x);
+    h[n]        = 2.0 * fc * sinc * resampler_poly_bessel_i0(RESAMPLER_POLY_KAISER_BETA * sqrt(1.0 - r * r)) / i0;
+    sum += h[n];
+  }
+
+  // Decompose in branches, scaled for unitary gain. Each branch holds the taps in reverse order so the convolution
+  // becomes a dot product with the samples in increasing time order
+  for (uint32_t p = 0; p < interp; p++) {
+    for (uint32_t j = 0; j < nof_taps; j++) {
+      q->bank[nof_taps * p + j] = (float)(h[p + (nof_taps - 1 - j) * interp] * interp / sum);
+    }
+  }
+
+  free(h);
+
+  srsran_resampler_poly_reset_state(q);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_resampler_poly_reset_state(srsran_resampler_poly_t* q)
+{
+  if (q == NULL || q->buffer == NULL) {
+    return;
+  }
+
+  q->phase = 0;
+  srsran_vec_cf_zero(q->buffer, q->nof_taps - 1);
+}
+
+uint32_t srsran_resampler_poly_get_delay(srsran_resampler_poly_t* q)
+{
+  if (q == NULL || q->bank == NULL) {
+    return UINT32_MAX;
+  }
+
+  // The prototype delay is (N - 1) / 2 samples at the interpolated rate
+  return (q->nof_taps * q->interp - 1 + q->decim) / (2 * q->decim);
+}
+
+uint32_t srsran_resampler_poly_get_nof_input(srsran_resampler_poly_t* q, uint32_t nof_output)
+{
+  if (q == NULL || q->bank == NULL || nof_output == 0) {
+    return 0;
+  }
+
+  // The last output sample reads the input sample at its position in the interpolated grid
+  return (q->phase + (nof_output - 1) * q->decim) / q->interp + 1;
+}
+
+uint32_t srsran_resampler_poly_run(srsran_resampler_poly_t* q, const cf_t* input, cf_t* output, uint32_t nsamples)
+{
+  if (q == NULL || q->bank == NULL) {
+    return 0;
+  }
+
+  uint32_t count    = 0;
+  uint32_t nof_hist = q->nof_taps - 1;
+
+  while (nsamples > 0) {
+    uint32_t n = SRSRAN_MIN(nsamples, RESAMPLER_POLY_BLOCK);
+
+    // Append the new samples to the filter history
+    if (input != NULL) {
+      srsran_vec_cf_copy(&q->buffer[nof_hist], input, n);
+      input += n;
+    } else {
+      srsran_vec_cf_zero(&q->buffer[nof_hist], n);
+    }
+
+    // Compute all the output samples which position falls in this block
+    uint32_t limit = n * q->interp;
+    uint32_t i     = q->phase / q->interp;
+    uint32_t p     = q->phase % q->interp;
+    for (; q->phase < limit; q->phase += q->decim) {
+      if (output != NULL) {
+#if SRSRAN_SIMD_CF_SIZE
+        // Group the following output samples if all of them fall in this block
+        if (q->phase + (SRSRAN_SIMD_F_SIZE - 1) * q->decim < limit) {
+          uint32_t idx[SRSRAN_SIMD_F_SIZE];
+          uint32_t phase[SRSRAN_SIMD_F_SIZE];
+          for (uint32_t k = 0; k < SRSRAN_SIMD_F_SIZE; k++) {
+            idx[k]   = i;
+            phase[k] = p;
+            p += q->decim;
+            while (p >= q->interp) {
+              p -= q->interp;
+              i++;
+            }
+          }
+          resampler_poly_dot_group(q, idx, phase, &output[count]);
+          count += SRSRAN_SIMD_F_SIZE;
+          q->phase += (SRSRAN_SIMD_F_SIZE - 1) * q->decim;
+          continue;
+        }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+        output[count] = resampler_poly_dot(&q->buffer[i], &q->bank[q->nof_taps * p], q->nof_taps);
+      }
+      count++;
+      p += q->decim;
+      while (p >= q->interp) {
+        p -= q->interp;
+        i++;
+      }
+    }
+    q->phase -= limit;
+
+    // Keep the history for the next block
+    memmove(q->buffer, &q->buffer[n], nof_hist * sizeof(cf_t));
+
+    nsamples -= n;
+  }
+
+  return count;
+}
+
+void srsran_resampler_poly_free(srsran_resampler_poly_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->bank) {
+    free(q->bank);
+  }
+  if (q->buffer) {
+    free(q->buffer);
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_resampler_poly_t, 1);
+}
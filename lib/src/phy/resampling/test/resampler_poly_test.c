@@ -0,0 +1,158 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+static uint32_t interp      = 2;
+static uint32_t decim       = 3;
+static uint32_t buffer_size = 23040;
+static uint32_t repetitions = 10;
+static float    freq        = 0.3f;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [idsrf]\n", prog);
+  printf("\t-i Interpolation factor [Default %d]\n", interp);
+  printf("\t-d Decimation factor [Default %d]\n", decim);
+  printf("\t-s Number of output samples per run [Default %d]\n", buffer_size);
+  printf("\t-r Number of repetitions [Default %d]\n", repetitions);
+  printf("\t-f Tone frequency relative to the lowest rate [Default %.2f]\n", freq);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+
+  while ((opt = getopt(argc, argv, "idsrfv")) != -1) {
+    switch (opt) {
+      case 'i':
+        interp = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'd':
+        decim = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        buffer_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'f':
+        freq = strtof(argv[optind], NULL);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  struct timeval          t[3] = {};
+  srsran_resampler_poly_t q    = {};
+  int                     ret  = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  if (srsran_resampler_poly_init(&q, interp, decim)) {
+    ERROR("Error initialising resampler");
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t max_input = buffer_size * decim / interp + decim + 1;
+  cf_t*    input     = srsran_vec_cf_malloc(max_input);
+  cf_t*    output    = srsran_vec_cf_malloc(buffer_size * repetitions + interp);
+  if (input == NULL || output == NULL) {
+    goto clean;
+  }
+
+  // Tone frequency normalised to the input rate
+  double f0 = (q.interp < q.decim) ? freq * (double)q.interp / (double)q.decim : freq;
+
+  uint64_t nof_input  = 0;
+  uint32_t nof_output = 0;
+  uint64_t elapsed_us = 0;
+  for (uint32_t r = 0; r < repetitions; r++) {
+    // Request a different number of samples every run to exercise the internal state
+    uint32_t nof_req = buffer_size - (r % 3);
+    uint32_t n       = srsran_resampler_poly_get_nof_input(&q, nof_req);
+    if (n > max_input) {
+      ERROR("Number of input samples (%d) exceeds the buffer (%d)", n, max_input);
+      goto clean;
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+      input[i] = cexp(_Complex_I * 2.0 * M_PI * f0 * (double)(nof_input + i));
+    }
+    nof_input += n;
+
+    gettimeofday(&t[1], NULL);
+    uint32_t count = srsran_resampler_poly_run(&q, input, &output[nof_output], n);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    elapsed_us += t[0].tv_sec * 1000000UL + t[0].tv_usec;
+
+    // The number of output samples is exact when decimating
+    if (count < nof_req || (q.decim >= q.interp && count != nof_req)) {
+      ERROR("Run %d produced %d samples, %d were requested", r, count, nof_req);
+      goto clean;
+    }
+    nof_output += count;
+  }
+
+  // Compare with the ideal tone, delayed by the prototype filter delay, skipping the filter transition
+  double delay_up = (q.nof_taps * q.interp - 1) / 2.0;
+  float  max_err  = 0.0f;
+  for (uint32_t n = 2 * srsran_resampler_poly_get_delay(&q); n < nof_output; n++) {
+    cf_t gold = cexp(_Complex_I * 2.0 * M_PI * f0 * ((double)n * q.decim - delay_up) / (double)q.interp);
+    max_err   = SRSRAN_MAX(max_err, cabsf(output[n] - gold));
+  }
+
+  printf("Done %.1f Msps; ratio: %d/%d; max error: %.6f\n",
+         nof_output / (double)elapsed_us,
+         q.interp,
+         q.decim,
+         max_err);
+
+  ret = (max_err < 1e-2f) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+
+clean:
+  srsran_resampler_poly_free(&q);
+  if (input) {
+    free(input);
+  }
+  if (output) {
+    free(output);
+  }
+
+  return ret;
+}
@@ -29,6 +29,7 @@
 #include <srsran/phy/utils/vector.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <time.h>
 #include <unistd.h>
 
 typedef struct {
@@ -59,6 +60,12 @@ typedef struct {
   // Rx timestamp
   uint64_t next_rx_ts;
 
+  // Pacing of the reception, 0 reads as fast as possible and 1 in real time
+  double          pacing;
+  bool            pacing_started;
+  struct timespec pacing_start;
+  uint64_t        pacing_start_ts;
+
   pthread_mutex_t tx_config_mutex;
   pthread_mutex_t rx_config_mutex;
   pthread_mutex_t decim_mutex;
@@ -116,6 +123,121 @@ static inline int update_ts(void* h, uint64_t* ts, int nsamples, const char* dir
   return ret;
 }
 
+/* Sleeps until the received samples are due for the configured pacing */
+static void rf_file_pace(rf_file_handler_t* handler)
+{
+  if (handler->pacing <= 0.0) {
+    return;
+  }
+
+  // The reference is the end of the first reception
+  if (!handler->pacing_started) {
+    clock_gettime(CLOCK_MONOTONIC, &handler->pacing_start);
+    handler->pacing_start_ts = handler->next_rx_ts;
+    handler->pacing_started  = true;
+    return;
+  }
+
+  uint64_t        nsamples = handler->next_rx_ts - handler->pacing_start_ts;
+  double          elapsed  = (double)nsamples / (double)handler->base_srate / handler->pacing;
+  struct timespec due      = handler->pacing_start;
+  due.tv_sec += (time_t)elapsed;
+  due.tv_nsec += (long)((elapsed - floor(elapsed)) * 1e9);
+  if (due.tv_nsec >= 1000000000L) {
+    due.tv_sec++;
+    due.tv_nsec -= 1000000000L;
+  }
+
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, NULL) == EINTR) {
+    // Sleep again if interrupted
+  }
+}
+
+/* Replaces the SigMF data file extension by the metadata one, returns false if the file is not a SigMF recording */
+static bool rf_file_sigmf_meta_name(const char* data_file, char meta_file[RF_PARAM_LEN])
+{
+  const char* ext     = ".sigmf-data";
+  size_t      len     = strlen(data_file);
+  size_t      ext_len = strlen(ext);
+
+  if (len <= ext_len || strcmp(data_file + len - ext_len, ext) != 0 || len + 1 > RF_PARAM_LEN) {
+    return false;
+  }
+
+  snprintf(meta_file, RF_PARAM_LEN, "%.*s.sigmf-meta", (int)(len - ext_len), data_file);
+  return true;
+}
+
+/* Reads the datatype and sample rate of a SigMF recording, only the samples of type cf32_le can be replayed */
+static int rf_file_sigmf_read(const char* data_file, double* sample_rate)
+{
+  char meta_file[RF_PARAM_LEN] = {};
+  if (!rf_file_sigmf_meta_name(data_file, meta_file)) {
+    return SRSRAN_SUCCESS;
+  }
+
+  FILE* f = fopen(meta_file, "r");
+  if (f == NULL) {
+    fprintf(stderr, "[file] Warning: no SigMF metadata %s; %s\n", meta_file, strerror(errno));
+    return SRSRAN_SUCCESS;
+  }
+
+  char meta[4096] = {};
+  fread(meta, 1, sizeof(meta) - 1, f);
+  fclose(f);
+
+  // The metadata is JSON, the two keys of the global object are enough and a full parser is not needed
+  char* ptr = strstr(meta, "\"core:datatype\"");
+  if (ptr != NULL) {
+    ptr = strchr(ptr + strlen("\"core:datatype\""), '"');
+    if (ptr == NULL || strncmp(ptr, "\"cf32_le\"", strlen("\"cf32_le\"")) != 0) {
+      fprintf(stderr, "[file] Error: %s datatype is not supported, only cf32_le\n", meta_file);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  ptr = strstr(meta, "\"core:sample_rate\"");
+  if (ptr != NULL) {
+    ptr = strchr(ptr + strlen("\"core:sample_rate\""), ':');
+    if (ptr != NULL) {
+      *sample_rate = strtod(ptr + 1, NULL);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Writes the SigMF metadata of a transmitted recording */
+static int rf_file_sigmf_write(const char* data_file, uint32_t base_srate)
+{
+  char meta_file[RF_PARAM_LEN] = {};
+  if (!rf_file_sigmf_meta_name(data_file, meta_file)) {
+    return SRSRAN_SUCCESS;
+  }
+
+  FILE* f = fopen(meta_file, "w");
+  if (f == NULL) {
+    fprintf(stderr, "[file] Error: opening SigMF metadata %s; %s\n", meta_file, strerror(errno));
+    return SRSRAN_ERROR;
+  }
+
+  fprintf(f,
+          "{\n"
+          "  \"global\": {\n"
+          "    \"core:datatype\": \"cf32_le\",\n"
+          "    \"core:sample_rate\": %u,\n"
+          "    \"core:version\": \"1.0.0\",\n"
+          "    \"core:recorder\": \"srsRAN\"\n"
+          "  },\n"
+          "  \"captures\": [{\"core:sample_start\": 0}],\n"
+          "  \"annotations\": []\n"
+          "}\n",
+          base_srate);
+  fclose(f);
+
+  return SRSRAN_SUCCESS;
+}
+
 int rf_file_handle_error(char* id, const char* text)
 {
   // Not implemented
@@ -179,17 +301,49 @@ int rf_file_open_multi(char* args, void** h, uint32_t nof_channels)
   FILE* tx_files[SRSRAN_MAX_CHANNELS] = {NULL};
 
   if (h && nof_channels <= SRSRAN_MAX_CHANNELS) {
-    uint32_t base_srate = FILE_BASERATE_DEFAULT_HZ;
+    uint32_t base_srate       = FILE_BASERATE_DEFAULT_HZ;
+    bool     base_srate_given = false;
+    bool     use_mmap         = false;
+    bool     hugepages        = false;
+    double   pacing           = 0.0;
 
     // parse args
     if (args && strlen(args)) {
       // base_srate
-      parse_uint32(args, "base_srate", -1, &base_srate);
+      base_srate_given = (parse_uint32(args, "base_srate", -1, &base_srate) == SRSRAN_SUCCESS);
+
+      // mmap, memory maps the rx files instead of reading them
+      char tmp_str[RF_PARAM_LEN] = {};
+      if (parse_string(args, "mmap", -1, tmp_str) == SRSRAN_SUCCESS) {
+        use_mmap = (strcmp(tmp_str, "true") == 0 || strcmp(tmp_str, "yes") == 0);
+      }
+
+      // hugepages, requests huge pages for the mapping
+      if (parse_string(args, "hugepages", -1, tmp_str) == SRSRAN_SUCCESS) {
+        hugepages = (strcmp(tmp_str, "true") == 0 || strcmp(tmp_str, "yes") == 0);
+      }
+
+      // pacing, "max" (default), "realtime" or a multiple of real time
+      if (parse_string(args, "pacing", -1, tmp_str) == SRSRAN_SUCCESS) {
+        if (strcmp(tmp_str, "realtime") == 0) {
+          pacing = 1.0;
+        } else if (strcmp(tmp_str, "max") == 0) {
+          pacing = 0.0;
+        } else {
+          pacing = strtod(tmp_str, NULL);
+          if (!isnormal(pacing) || pacing < 0.0) {
+            fprintf(stderr, "[file] Error: invalid pacing %s\n", tmp_str);
+            goto clean_exit;
+          }
+        }
+      }
     } else {
       fprintf(stderr, "[file] Error: RF device args are required for file-based no-RF module\n");
       goto clean_exit;
     }
 
+    char tx_file_names[SRSRAN_MAX_CHANNELS][RF_PARAM_LEN] = {};
+
     for (int i = 0; i < nof_channels; i++) {
       // rx_file
       char rx_file[RF_PARAM_LEN] = {};
@@ -199,6 +353,8 @@ int rf_file_open_multi(char* args, void** h, uint32_t nof_channels)
       char tx_file[RF_PARAM_LEN] = {};
       parse_string(args, "tx_file", i, tx_file);
 
+      strncpy(tx_file_names[i], tx_file, RF_PARAM_LEN - 1);
+
       // initialize transmitter
       if (strlen(tx_file) != 0) {
         tx_files[i] = fopen(tx_file, "wb");
@@ -215,6 +371,29 @@ int rf_file_open_multi(char* args, void** h, uint32_t nof_channels)
           fprintf(stderr, "[file] Error: opening rx_file%d: %s; %s\n", i, rx_file, strerror(errno));
           goto clean_exit;
         }
+
+        // SigMF recordings provide the base rate unless it is given in the arguments
+        double sigmf_srate = 0.0;
+        if (rf_file_sigmf_read(rx_file, &sigmf_srate) != SRSRAN_SUCCESS) {
+          goto clean_exit;
+        }
+        if (!base_srate_given && isnormal(sigmf_srate)) {
+          base_srate       = (uint32_t)sigmf_srate;
+          base_srate_given = true;
+        } else if (isnormal(sigmf_srate) && (uint32_t)sigmf_srate != base_srate) {
+          fprintf(stderr,
+                  "[file] Warning: rx_file%d sample rate %.2f MHz differs from the base rate %.2f MHz\n",
+                  i,
+                  sigmf_srate / 1e6,
+                  base_srate / 1e6);
+        }
+      }
+    }
+
+    // The metadata of the transmitted recordings is written once the base rate is known
+    for (int i = 0; i < nof_channels; i++) {
+      if (tx_files[i] != NULL && rf_file_sigmf_write(tx_file_names[i], base_srate) != SRSRAN_SUCCESS) {
+        goto clean_exit;
       }
     }
 
@@ -227,6 +406,16 @@ int rf_file_open_multi(char* args, void** h, uint32_t nof_channels)
     // add flag to close all files when closing device
     rf_file_handler_t* handler = (rf_file_handler_t*)(*h);
     handler->close_files       = true;
+    handler->pacing            = pacing;
+
+    // Map the rx files, the receivers that can not be mapped keep reading the file
+    if (use_mmap) {
+      for (int i = 0; i < nof_channels; i++) {
+        if (handler->receiver[i].running) {
+          rf_file_rx_mmap(&handler->receiver[i], hugepages);
+        }
+      }
+    }
     return ret;
   }
 
@@ -601,6 +790,7 @@ int rf_file_recv_with_time_multi(void*    h,
     // return if receiver is turned off
     if (!handler->receiver[0].running) {
       update_ts(handler, &handler->next_rx_ts, nsamples_baserate, "rx");
+      rf_file_pace(handler);
       return nsamples;
     }
 
@@ -628,6 +818,12 @@ int rf_file_recv_with_time_multi(void*    h,
       }
     }
 
+    // Decimation source of every channel, the memory mapped files are decimated in place
+    const cf_t* src[SRSRAN_MAX_CHANNELS] = {};
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      src[i] = handler->buffer_decimation[i];
+    }
+
     // copy from rx buffer as many samples as requested into provided buffer
     bool    completed                  = false;
     int32_t count[SRSRAN_MAX_CHANNELS] = {};
@@ -638,6 +834,17 @@ int rf_file_recv_with_time_multi(void*    h,
       for (uint32_t i = 0; i < handler->nof_channels; i++) {
         cf_t* ptr = (decim_factor != 1 || buffers[i] == NULL) ? handler->buffer_decimation[i] : buffers[i];
 
+        // Samples that are not copied to the caller buffer are not copied at all from a mapped file
+        if (count[i] == 0 && handler->receiver[i].running && handler->receiver[i].map != NULL &&
+            ptr == handler->buffer_decimation[i]) {
+          src[i] = rf_file_rx_baseband_map(&handler->receiver[i], nsamples_baserate);
+          if (src[i] == NULL) {
+            ret = SRSRAN_ERROR_RX_EOF;
+            goto clean_exit;
+          }
+          count[i] = nsamples_baserate;
+        }
+
         // Completed condition
         if (count[i] < nsamples_baserate && handler->receiver[i].running) {
           // Keep receiving
@@ -669,8 +876,8 @@ int rf_file_recv_with_time_multi(void*    h,
       for (uint32_t c = 0; c < handler->nof_channels; c++) {
         // skip if buffer is not available
         if (buffers[c]) {
-          cf_t* dst = buffers[c];
-          cf_t* ptr = handler->buffer_decimation[c];
+          cf_t*       dst = buffers[c];
+          const cf_t* ptr = src[c];
 
           for (uint32_t i = 0, n = 0; i < nsamples; i++) {
             // Averaging decimation
@@ -704,6 +911,7 @@ int rf_file_recv_with_time_multi(void*    h,
 
     // update rx time
     update_ts(handler, &handler->next_rx_ts, nsamples_baserate, "rx");
+    rf_file_pace(handler);
   }
 
   ret = nsamples;
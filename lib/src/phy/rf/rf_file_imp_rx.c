@@ -20,9 +20,12 @@
  */
 
 #include "rf_file_imp_trx.h"
+#include <errno.h>
 #include <srsran/phy/utils/vector.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 int rf_file_rx_open(rf_file_rx_t* q, rf_file_opts_t opts)
 {
@@ -69,10 +72,64 @@ clean_exit:
   return ret;
 }
 
+int rf_file_rx_mmap(rf_file_rx_t* q, bool hugepages)
+{
+  if (q == NULL || q->file == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Only regular files can be mapped, anything else keeps using fread
+  struct stat st = {};
+  int         fd = fileno(q->file);
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+    fprintf(stderr, "[file] Warning: %s can not be memory mapped, reading it instead\n", q->id);
+    return SRSRAN_ERROR;
+  }
+
+  // The mapping starts where the file position is, the samples before it are skipped as fread would
+  long pos = ftell(q->file);
+  if (pos < 0 || pos >= st.st_size) {
+    return SRSRAN_ERROR;
+  }
+
+  void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (map == MAP_FAILED) {
+    fprintf(stderr, "[file] Warning: mmap failed for %s: %s\n", q->id, strerror(errno));
+    return SRSRAN_ERROR;
+  }
+
+  // The samples are read once from the beginning to the end
+  madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+#ifdef MADV_HUGEPAGE
+  // Best effort, only honoured by the file systems that support huge pages in the page cache
+  if (hugepages && madvise(map, (size_t)st.st_size, MADV_HUGEPAGE) != 0) {
+    rf_file_info(q->id, "Huge pages not available for the mapping\n");
+  }
+#endif /* MADV_HUGEPAGE */
+
+  q->map          = map;
+  q->map_len      = (size_t)st.st_size;
+  q->map_nsamples = NBYTES2NSAMPLES((uint64_t)st.st_size);
+  q->map_offset   = NBYTES2NSAMPLES((uint64_t)pos);
+
+  return SRSRAN_SUCCESS;
+}
+
 int rf_file_rx_baseband(rf_file_rx_t* q, cf_t* buffer, uint32_t nsamples)
 {
   uint32_t sample_sz = sizeof(cf_t);
 
+  if (q->map != NULL) {
+    uint64_t n = SRSRAN_MIN((uint64_t)nsamples, q->map_nsamples - q->map_offset);
+    if (n == 0) {
+      return SRSRAN_ERROR_RX_EOF;
+    }
+    srsran_vec_cf_copy(buffer, (const cf_t*)q->map + q->map_offset, (uint32_t)n);
+    q->map_offset += n;
+    return (int)n;
+  }
+
   int ret = fread(buffer, sample_sz, nsamples, q->file);
   if (ret > 0) {
     return ret;
@@ -81,6 +138,18 @@ int rf_file_rx_baseband(rf_file_rx_t* q, cf_t* buffer, uint32_t nsamples)
   }
 }
 
+const cf_t* rf_file_rx_baseband_map(rf_file_rx_t* q, uint32_t nsamples)
+{
+  // The samples are used in place, a partial read is treated as the end of the file
+  if (q->map == NULL || q->map_nsamples - q->map_offset < nsamples) {
+    return NULL;
+  }
+
+  const cf_t* ptr = (const cf_t*)q->map + q->map_offset;
+  q->map_offset += nsamples;
+  return ptr;
+}
+
 bool rf_file_rx_match_freq(rf_file_rx_t* q, uint32_t freq_hz)
 {
   bool ret = false;
@@ -103,5 +172,10 @@ void rf_file_rx_close(rf_file_rx_t* q)
     free(q->temp_buffer_convert);
   }
 
+  if (q->map) {
+    munmap(q->map, q->map_len);
+    q->map = NULL;
+  }
+
   // not touching q->file as we don't know if we need to close it ourselves
 }
@@ -66,6 +66,10 @@ typedef struct {
   cf_t*            temp_buffer;
   void*            temp_buffer_convert;
   uint32_t         frequency_mhz;
+  void*            map;          // Memory mapped file, NULL if the file is read with fread
+  size_t           map_len;      // Length of the mapping in bytes
+  uint64_t         map_nsamples; // Number of samples in the mapping
+  uint64_t         map_offset;   // Next sample to read from the mapping
 } rf_file_rx_t;
 
 typedef struct {
@@ -106,8 +110,12 @@ SRSRAN_API void rf_file_tx_close(rf_file_tx_t* q);
  */
 SRSRAN_API int rf_file_rx_open(rf_file_rx_t* q, rf_file_opts_t opts);
 
+SRSRAN_API int rf_file_rx_mmap(rf_file_rx_t* q, bool hugepages);
+
 SRSRAN_API int rf_file_rx_baseband(rf_file_rx_t* q, cf_t* buffer, uint32_t nsamples);
 
+SRSRAN_API const cf_t* rf_file_rx_baseband_map(rf_file_rx_t* q, uint32_t nsamples);
+
 SRSRAN_API bool rf_file_rx_match_freq(rf_file_rx_t* q, uint32_t freq_hz);
 
 SRSRAN_API void rf_file_rx_close(rf_file_rx_t* q);
@@ -28,6 +28,7 @@
 #include <srsran/phy/common/phy_common.h>
 #include <srsran/phy/utils/vector.h>
 #include <stdlib.h>
+#include <sys/time.h>
 
 #define PRINT_SAMPLES 0
 #define COMPARE_BITS 0
@@ -320,6 +321,41 @@ int main()
     return -1;
   }
 
+  // same with the rx files memory mapped, decimated in place
+  if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3,mmap=true",
+               "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3",
+               true) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test failed (memory mapped, with decimation, timed tx)!\n");
+    return -1;
+  }
+
+  // SigMF recordings, the rx base rate is taken from the metadata written by the transmitter
+  if (run_test("rx_file=tx_file0.sigmf-data,rx_file=tx_file1.sigmf-data,rx_file=tx_file2.sigmf-data,"
+               "rx_file=tx_file3.sigmf-data,mmap=true",
+               "tx_file=tx_file0.sigmf-data,tx_file=tx_file1.sigmf-data,tx_file=tx_file2.sigmf-data,"
+               "tx_file=tx_file3.sigmf-data,base_srate=1.92e6",
+               false) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "SigMF test failed (memory mapped, no decimation, no timed tx)!\n");
+    return -1;
+  }
+
+  // 10 times real time pacing, the reception of NUM_SF subframes takes at least NUM_SF / 10 ms
+  struct timeval t[3] = {};
+  gettimeofday(&t[1], NULL);
+  if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3,pacing=10",
+               "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3",
+               false) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test failed (paced, with decimation, no timed tx)!\n");
+    return -1;
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t elapsed_ms = t[0].tv_sec * 1000UL + t[0].tv_usec / 1000UL;
+  if (elapsed_ms < (NUM_SF - 5) / 10) {
+    fprintf(stderr, "Paced test took %" PRIu64 " ms, expected at least %d ms\n", elapsed_ms, (NUM_SF - 5) / 10);
+    return -1;
+  }
+
   // clean workspace
   remove_file("rx_file0");
   remove_file("rx_file1");
@@ -329,6 +365,13 @@ int main()
   remove_file("tx_file1");
   remove_file("tx_file2");
   remove_file("tx_file3");
+  for (int i = 0; i < NOF_RX_ANT; i++) {
+    char name[RF_PARAM_LEN];
+    snprintf(name, sizeof(name), "tx_file%d.sigmf-data", i);
+    remove_file(name);
+    snprintf(name, sizeof(name), "tx_file%d.sigmf-meta", i);
+    remove_file(name);
+  }
 
   fprintf(stdout, "Test passed!\n");
 
@@ -0,0 +1,253 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp_trx.h"
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Maps the segment of the transmitter, if it has been created already */
+static bool rf_shm_rx_attach(rf_shm_rx_t* q)
+{
+  bool ok = false;
+
+  int fd = shm_open(q->name, O_RDWR, 0);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat st = {};
+  if (fstat(fd, &st) == 0 && st.st_size >= sizeof(rf_shm_header_t)) {
+    void* ptr = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (ptr != MAP_FAILED) {
+      rf_shm_header_t* hdr = (rf_shm_header_t*)ptr;
+      if (__atomic_load_n(&hdr->magic, __ATOMIC_ACQUIRE) == SHM_MAGIC && hdr->version == SHM_VERSION &&
+          !__atomic_load_n(&hdr->closed, __ATOMIC_ACQUIRE) &&
+          hdr->data_offset + hdr->capacity * hdr->sample_size <= (uint64_t)st.st_size) {
+        q->hdr         = hdr;
+        q->data        = (uint8_t*)ptr + hdr->data_offset;
+        q->size        = (size_t)st.st_size;
+        q->capacity    = hdr->capacity;
+        q->sample_size = hdr->sample_size;
+
+        // Consume from where the previous receiver stopped, the start of the stream for a new segment
+        __atomic_store_n(&hdr->reader_attached, 1, __ATOMIC_RELEASE);
+        rf_shm_info(q->id, "Attached receiver: %s (%" PRIu64 " samples)\n", q->name, q->capacity);
+        ok = true;
+      } else {
+        munmap(ptr, (size_t)st.st_size);
+      }
+    }
+  }
+  close(fd);
+
+  return ok;
+}
+
+static void rf_shm_rx_detach(rf_shm_rx_t* q)
+{
+  if (q->hdr) {
+    __atomic_store_n(&q->hdr->reader_attached, 0, __ATOMIC_RELEASE);
+    munmap(q->hdr, q->size);
+    q->hdr  = NULL;
+    q->data = NULL;
+  }
+}
+
+int rf_shm_rx_open(rf_shm_rx_t* q, rf_shm_opts_t opts, const char* name)
+{
+  int ret = SRSRAN_ERROR;
+
+  if (q && name) {
+    // Zero object
+    bzero(q, sizeof(rf_shm_rx_t));
+
+    // Copy id
+    strncpy(q->id, opts.id, SHM_ID_STRLEN - 1);
+    q->id[SHM_ID_STRLEN - 1] = '\0';
+
+    // POSIX shared memory names start with a slash
+    snprintf(q->name, SHM_NAME_STRLEN, "%s%s", (name[0] == '/') ? "" : "/", name);
+
+    q->frequency_mhz      = opts.frequency_mhz;
+    q->fail_on_disconnect = opts.fail_on_disconnect;
+    q->sample_offset      = opts.sample_offset;
+    q->trx_timeout_ms     = opts.trx_timeout_ms;
+    q->log_trx_timeout    = opts.log_trx_timeout;
+
+    if (pthread_mutex_init(&q->mutex, NULL)) {
+      fprintf(stderr, "Error: creating mutex\n");
+      goto clean_exit;
+    }
+
+    // The transmitter may not have started yet, the receiver attaches on its first read then
+    rf_shm_info(q->id, "Connecting receiver: %s\n", q->name);
+    rf_shm_rx_attach(q);
+
+    q->running = true;
+
+    ret = SRSRAN_SUCCESS;
+  }
+
+clean_exit:
+  return ret;
+}
+
+/* Reads the samples straight from the ring, converting and scaling them on the way. A NULL buffer discards them */
+static void rf_shm_rx_read(rf_shm_rx_t* q, uint64_t read_ts, cf_t* buffer, float scale, uint32_t nsamples)
+{
+  uint64_t offset = read_ts % q->capacity;
+
+  while (buffer != NULL && nsamples > 0) {
+    uint32_t    n   = (uint32_t)SRSRAN_MIN(nsamples, q->capacity - offset);
+    const void* src = q->data + offset * q->sample_size;
+
+    if (q->hdr->sample_format == SHM_TYPE_SC16) {
+      srsran_vec_convert_if((const int16_t*)src, INT16_MAX / scale, (float*)buffer, 2 * n);
+    } else if (scale == 1.0f) {
+      srsran_vec_cf_copy(buffer, (const cf_t*)src, n);
+    } else {
+      srsran_vec_sc_prod_cfc((const cf_t*)src, scale, buffer, n);
+    }
+
+    buffer += n;
+    nsamples -= n;
+    offset = 0;
+  }
+}
+
+/* Waits for up to half a ring of samples from the transmitter, so it can keep writing while they are read. Returns the
+ * number of samples to read from read_ts, or SRSRAN_ERROR_TIMEOUT */
+static int rf_shm_rx_wait_samples(rf_shm_rx_t* q, uint32_t max_nsamples, uint64_t* read_ts)
+{
+  uint64_t timeout_us = rf_shm_time_us() + 1000UL * q->trx_timeout_ms;
+
+  while (true) {
+    if (q->hdr == NULL && !rf_shm_rx_attach(q)) {
+      // Transmitter not started yet
+    } else {
+      // Attach again if the transmitter dropped this receiver after a stall
+      if (!__atomic_load_n(&q->hdr->reader_attached, __ATOMIC_ACQUIRE)) {
+        __atomic_store_n(&q->hdr->reader_attached, 1, __ATOMIC_RELEASE);
+      }
+
+      // The closed flag is loaded before the write pointer, so no sample published before closing is missed
+      bool     closed   = __atomic_load_n(&q->hdr->closed, __ATOMIC_ACQUIRE);
+      uint32_t nsamples = (uint32_t)SRSRAN_MIN(max_nsamples, SRSRAN_MAX(q->capacity / 2, 1));
+      *read_ts          = __atomic_load_n(&q->hdr->read_ts, __ATOMIC_ACQUIRE);
+      uint64_t write_ts = __atomic_load_n(&q->hdr->write_ts, __ATOMIC_ACQUIRE);
+      if (write_ts >= *read_ts + nsamples) {
+        return (int)nsamples;
+      }
+
+      if (closed) {
+        // Drain what the transmitter left before it went away, a new one creates a new segment
+        if (write_ts > *read_ts) {
+          return (int)(write_ts - *read_ts);
+        }
+        rf_shm_info(q->id, "Transmitter %s closed\n", q->name);
+        rf_shm_rx_detach(q);
+      }
+    }
+
+    if (rf_shm_time_us() > timeout_us) {
+      return SRSRAN_ERROR_TIMEOUT;
+    }
+
+    usleep(SHM_POLL_US);
+  }
+}
+
+int rf_shm_rx_baseband(rf_shm_rx_t* q, cf_t* buffer, float scale, uint32_t nsamples)
+{
+  uint64_t read_ts = 0;
+  int      n       = 0;
+
+  // If the read needs to be delayed
+  if (q->sample_offset > 0) {
+    n = SRSRAN_MIN(q->sample_offset, (int)nsamples);
+    if (buffer != NULL) {
+      srsran_vec_cf_zero(buffer, n);
+    }
+    q->sample_offset -= n;
+    return n;
+  }
+
+  // If the read needs to be advanced
+  while (q->sample_offset < 0) {
+    n = rf_shm_rx_wait_samples(q, (uint32_t)-q->sample_offset, &read_ts);
+    if (n < SRSRAN_SUCCESS) {
+      return n;
+    }
+    __atomic_store_n(&q->hdr->read_ts, read_ts + n, __ATOMIC_RELEASE);
+    q->sample_offset += n;
+  }
+
+  n = rf_shm_rx_wait_samples(q, nsamples, &read_ts);
+  if (n < SRSRAN_SUCCESS) {
+    return n;
+  }
+
+  rf_shm_rx_read(q, read_ts, buffer, scale, (uint32_t)n);
+  __atomic_store_n(&q->hdr->read_ts, read_ts + n, __ATOMIC_RELEASE);
+
+  return n;
+}
+
+bool rf_shm_rx_match_freq(rf_shm_rx_t* q, uint32_t freq_hz)
+{
+  bool ret = false;
+  if (q) {
+    ret = (q->frequency_mhz == 0 || q->frequency_mhz == freq_hz);
+  }
+  return ret;
+}
+
+void rf_shm_rx_close(rf_shm_rx_t* q)
+{
+  rf_shm_info(q->id, "Closing ...\n");
+
+  pthread_mutex_lock(&q->mutex);
+  q->running = false;
+  pthread_mutex_unlock(&q->mutex);
+
+  pthread_mutex_destroy(&q->mutex);
+
+  rf_shm_rx_detach(q);
+}
+
+bool rf_shm_rx_is_running(rf_shm_rx_t* q)
+{
+  if (!q) {
+    return false;
+  }
+
+  bool ret = false;
+  pthread_mutex_lock(&q->mutex);
+  ret = q->running;
+  pthread_mutex_unlock(&q->mutex);
+
+  return ret;
+}
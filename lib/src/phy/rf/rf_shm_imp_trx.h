@@ -0,0 +1,163 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_RF_SHM_IMP_TRX_H
+#define SRSRAN_RF_SHM_IMP_TRX_H
+
+#include <pthread.h>
+#include <srsran/config.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Definitions */
+#define VERBOSE (0)
+#define NSAMPLES2NBYTES(X) (((uint32_t)(X)) * sizeof(cf_t))
+#define NBYTES2NSAMPLES(X) ((X) / sizeof(cf_t))
+#define SHM_MAX_BUFFER_SIZE (NSAMPLES2NBYTES(3072000)) // 10 subframes at 20 MHz, for decimation and interpolation
+#define SHM_TIMEOUT_MS (2000)
+#define SHM_BASERATE_DEFAULT_HZ (23040000)
+#define SHM_RING_DEFAULT_MS (20)
+#define SHM_POLL_US (20)
+#define SHM_ID_STRLEN 16
+#define SHM_NAME_STRLEN 64
+#define SHM_MAX_GAIN_DB (30.0f)
+#define SHM_MIN_GAIN_DB (0.0f)
+#define SHM_MAGIC (0x7372736dU) // "srsm"
+#define SHM_VERSION (1U)
+#define SHM_CACHE_LINE (64)
+
+typedef enum { SHM_TYPE_FC32 = 0, SHM_TYPE_SC16 } rf_shm_format_t;
+
+/*
+ * Header at the beginning of every shared memory segment. A segment carries one channel from its only writer, the
+ * transmitter that created it, to its only reader. The positions are absolute sample counts at the base rate, so they
+ * double as timestamps, and they are the only fields written after the creation. Each side owns one cache line.
+ */
+typedef struct {
+  // Written once by the transmitter, the magic word last
+  uint32_t magic;
+  uint32_t version;
+  uint32_t sample_format;
+  uint32_t sample_size;
+  uint64_t capacity; ///< Number of samples in the ring
+  uint64_t data_offset;
+  uint8_t  reserved0[SHM_CACHE_LINE - 4 * sizeof(uint32_t) - 2 * sizeof(uint64_t)];
+
+  // Written by the transmitter
+  uint64_t write_ts; ///< Timestamp of the next sample to write
+  uint32_t closed;   ///< Set when the transmitter leaves the segment
+  uint8_t  reserved1[SHM_CACHE_LINE - sizeof(uint64_t) - sizeof(uint32_t)];
+
+  // Written by the receiver, the transmitter only clears reader_attached if the receiver stops consuming
+  uint64_t read_ts;         ///< Timestamp of the next sample to read
+  uint32_t reader_attached; ///< While set, the transmitter does not overwrite unread samples
+  uint8_t  reserved2[SHM_CACHE_LINE - sizeof(uint64_t) - sizeof(uint32_t)];
+} rf_shm_header_t;
+
+typedef struct {
+  char             id[SHM_ID_STRLEN];
+  char             name[SHM_NAME_STRLEN];
+  rf_shm_format_t  sample_format;
+  rf_shm_header_t* hdr;
+  uint8_t*         data;
+  size_t           size;
+  uint64_t         capacity;
+  uint64_t         nsamples;
+  bool             running;
+  pthread_mutex_t  mutex;
+  uint32_t         frequency_mhz;
+  int32_t          sample_offset;
+  uint32_t         trx_timeout_ms;
+} rf_shm_tx_t;
+
+typedef struct {
+  char             id[SHM_ID_STRLEN];
+  char             name[SHM_NAME_STRLEN];
+  rf_shm_header_t* hdr;
+  uint8_t*         data;
+  size_t           size;
+  uint64_t         capacity;
+  uint32_t         sample_size;
+  bool             running;
+  pthread_mutex_t  mutex;
+  uint32_t         frequency_mhz;
+  bool             fail_on_disconnect;
+  uint32_t         trx_timeout_ms;
+  bool             log_trx_timeout;
+  int32_t          sample_offset;
+} rf_shm_rx_t;
+
+typedef struct {
+  const char*     id;
+  rf_shm_format_t sample_format;
+  uint32_t        frequency_mhz;
+  bool            fail_on_disconnect;
+  uint32_t        trx_timeout_ms;
+  bool            log_trx_timeout;
+  int32_t         sample_offset; ///< offset in samples
+  uint32_t        ring_nsamples; ///< ring capacity in samples, only used by the transmitter
+} rf_shm_opts_t;
+
+/*
+ * Common functions
+ */
+SRSRAN_API void rf_shm_info(char* id, const char* format, ...);
+
+SRSRAN_API void rf_shm_error(char* id, const char* format, ...);
+
+SRSRAN_API uint64_t rf_shm_time_us(void);
+
+/*
+ * Transmitter functions
+ */
+SRSRAN_API int rf_shm_tx_open(rf_shm_tx_t* q, rf_shm_opts_t opts, const char* name);
+
+SRSRAN_API int rf_shm_tx_align(rf_shm_tx_t* q, uint64_t ts);
+
+SRSRAN_API int rf_shm_tx_wait(rf_shm_tx_t* q, uint64_t ts);
+
+SRSRAN_API int rf_shm_tx_baseband(rf_shm_tx_t* q, const cf_t* buffer, float scale, uint32_t nsamples);
+
+SRSRAN_API uint64_t rf_shm_tx_get_nsamples(rf_shm_tx_t* q);
+
+SRSRAN_API int rf_shm_tx_zeros(rf_shm_tx_t* q, uint32_t nsamples);
+
+SRSRAN_API bool rf_shm_tx_match_freq(rf_shm_tx_t* q, uint32_t freq_hz);
+
+SRSRAN_API void rf_shm_tx_close(rf_shm_tx_t* q);
+
+SRSRAN_API bool rf_shm_tx_is_running(rf_shm_tx_t* q);
+
+/*
+ * Receiver functions
+ */
+SRSRAN_API int rf_shm_rx_open(rf_shm_rx_t* q, rf_shm_opts_t opts, const char* name);
+
+SRSRAN_API int rf_shm_rx_baseband(rf_shm_rx_t* q, cf_t* buffer, float scale, uint32_t nsamples);
+
+SRSRAN_API bool rf_shm_rx_match_freq(rf_shm_rx_t* q, uint32_t freq_hz);
+
+SRSRAN_API void rf_shm_rx_close(rf_shm_rx_t* q);
+
+SRSRAN_API bool rf_shm_rx_is_running(rf_shm_rx_t* q);
+
+#endif // SRSRAN_RF_SHM_IMP_TRX_H
@@ -0,0 +1,319 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp_trx.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* Marks as closed a segment left behind by a previous transmitter with the same name, and removes its name */
+static void rf_shm_tx_unlink(rf_shm_tx_t* q)
+{
+  int fd = shm_open(q->name, O_RDWR, 0);
+  if (fd >= 0) {
+    void* ptr = mmap(NULL, sizeof(rf_shm_header_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (ptr != MAP_FAILED) {
+      rf_shm_header_t* hdr = (rf_shm_header_t*)ptr;
+      if (__atomic_load_n(&hdr->magic, __ATOMIC_ACQUIRE) == SHM_MAGIC) {
+        __atomic_store_n(&hdr->closed, 1, __ATOMIC_RELEASE);
+      }
+      munmap(ptr, sizeof(rf_shm_header_t));
+    }
+    close(fd);
+    shm_unlink(q->name);
+  }
+}
+
+int rf_shm_tx_open(rf_shm_tx_t* q, rf_shm_opts_t opts, const char* name)
+{
+  int ret = SRSRAN_ERROR;
+  int fd  = -1;
+
+  if (q && name) {
+    // Zero object
+    bzero(q, sizeof(rf_shm_tx_t));
+
+    // Copy id
+    strncpy(q->id, opts.id, SHM_ID_STRLEN - 1);
+    q->id[SHM_ID_STRLEN - 1] = '\0';
+
+    // POSIX shared memory names start with a slash
+    snprintf(q->name, SHM_NAME_STRLEN, "%s%s", (name[0] == '/') ? "" : "/", name);
+
+    q->sample_format  = opts.sample_format;
+    q->frequency_mhz  = opts.frequency_mhz;
+    q->sample_offset  = opts.sample_offset;
+    q->trx_timeout_ms = opts.trx_timeout_ms;
+    q->capacity       = opts.ring_nsamples;
+
+    if (pthread_mutex_init(&q->mutex, NULL)) {
+      fprintf(stderr, "Error: creating mutex\n");
+      goto clean_exit;
+    }
+
+    if (q->capacity < 2) {
+      fprintf(stderr, "[shm] Error: invalid ring size of %" PRIu64 " samples\n", q->capacity);
+      goto clean_exit;
+    }
+
+    uint32_t sample_sz = (q->sample_format == SHM_TYPE_SC16) ? 2 * sizeof(int16_t) : sizeof(cf_t);
+    q->size            = sizeof(rf_shm_header_t) + q->capacity * sample_sz;
+
+    rf_shm_info(q->id, "Creating transmitter: %s (%" PRIu64 " samples)\n", q->name, q->capacity);
+
+    // A receiver still attached to a previous segment sees it closed and attaches to the new one
+    rf_shm_tx_unlink(q);
+
+    fd = shm_open(q->name, O_CREAT | O_EXCL | O_RDWR, 0660);
+    if (fd < 0) {
+      fprintf(stderr, "[shm] Error: creating shared memory %s: %s\n", q->name, strerror(errno));
+      goto clean_exit;
+    }
+
+    // The new segment is zero filled, samples and positions included
+    if (ftruncate(fd, (off_t)q->size)) {
+      fprintf(stderr, "[shm] Error: resizing shared memory %s: %s\n", q->name, strerror(errno));
+      goto clean_exit;
+    }
+
+    void* ptr = mmap(NULL, q->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (ptr == MAP_FAILED) {
+      fprintf(stderr, "[shm] Error: mapping shared memory %s: %s\n", q->name, strerror(errno));
+      goto clean_exit;
+    }
+    q->hdr  = (rf_shm_header_t*)ptr;
+    q->data = (uint8_t*)ptr + sizeof(rf_shm_header_t);
+
+    q->hdr->version       = SHM_VERSION;
+    q->hdr->sample_format = q->sample_format;
+    q->hdr->sample_size   = sample_sz;
+    q->hdr->capacity      = q->capacity;
+    q->hdr->data_offset   = sizeof(rf_shm_header_t);
+    __atomic_store_n(&q->hdr->magic, SHM_MAGIC, __ATOMIC_RELEASE);
+
+    q->running = true;
+
+    ret = SRSRAN_SUCCESS;
+  }
+
+clean_exit:
+  if (fd >= 0) {
+    close(fd);
+  }
+  return ret;
+}
+
+/* Waits until the receiver has consumed enough samples to write nsamples without overwriting any unread sample */
+static void rf_shm_tx_wait_space(rf_shm_tx_t* q, uint32_t nsamples)
+{
+  uint64_t timeout_us = rf_shm_time_us() + 1000UL * q->trx_timeout_ms;
+
+  while (q->running) {
+    uint64_t read_ts = __atomic_load_n(&q->hdr->read_ts, __ATOMIC_ACQUIRE);
+    uint64_t used    = (q->nsamples > read_ts) ? SRSRAN_MIN(q->nsamples - read_ts, q->capacity) : 0;
+    if (q->capacity - used >= nsamples) {
+      return;
+    }
+
+    // Drop the oldest samples if the receiver stopped consuming, it attaches again on its next read
+    if (rf_shm_time_us() > timeout_us) {
+      if (__atomic_exchange_n(&q->hdr->reader_attached, 0, __ATOMIC_ACQ_REL)) {
+        rf_shm_error(q->id, "[shm] Receiver of %s is not consuming samples, dropping them\n", q->name);
+      }
+      __atomic_store_n(&q->hdr->read_ts, q->nsamples + nsamples - q->capacity, __ATOMIC_RELEASE);
+      return;
+    }
+
+    usleep(SHM_POLL_US);
+  }
+}
+
+/* Writes the samples straight into the ring, converting and scaling them on the way. A NULL buffer writes zeros */
+static void rf_shm_tx_write(rf_shm_tx_t* q, const cf_t* buffer, float scale, uint32_t nsamples)
+{
+  uint64_t offset = q->nsamples % q->capacity;
+
+  while (nsamples > 0) {
+    uint32_t n   = (uint32_t)SRSRAN_MIN(nsamples, q->capacity - offset);
+    void*    dst = q->data + offset * q->hdr->sample_size;
+
+    if (buffer == NULL) {
+      memset(dst, 0, (size_t)n * q->hdr->sample_size);
+    } else if (q->sample_format == SHM_TYPE_SC16) {
+      srsran_vec_convert_fi((const float*)buffer, INT16_MAX * scale, (int16_t*)dst, 2 * n);
+    } else if (scale == 1.0f) {
+      srsran_vec_cf_copy((cf_t*)dst, buffer, n);
+    } else {
+      srsran_vec_sc_prod_cfc(buffer, scale, (cf_t*)dst, n);
+    }
+
+    if (buffer != NULL) {
+      buffer += n;
+    }
+    nsamples -= n;
+    offset = 0;
+  }
+}
+
+static int _rf_shm_tx_baseband(rf_shm_tx_t* q, const cf_t* buffer, float scale, uint32_t nsamples)
+{
+  uint32_t count = 0;
+
+  // Write at most half a ring at once, so the receiver can consume while the rest is written
+  while (count < nsamples && q->running) {
+    uint32_t n = (uint32_t)SRSRAN_MIN(nsamples - count, q->capacity / 2);
+
+    rf_shm_tx_wait_space(q, n);
+    rf_shm_tx_write(q, (buffer != NULL) ? &buffer[count] : NULL, scale, n);
+
+    // Publish the samples
+    q->nsamples += n;
+    __atomic_store_n(&q->hdr->write_ts, q->nsamples, __ATOMIC_RELEASE);
+    count += n;
+  }
+
+  return (int)count;
+}
+
+int rf_shm_tx_align(rf_shm_tx_t* q, uint64_t ts)
+{
+  pthread_mutex_lock(&q->mutex);
+
+  int64_t nsamples = (int64_t)ts - (int64_t)q->nsamples;
+
+  if (nsamples > 0) {
+    rf_shm_info(q->id, " - Detected Tx gap of %" PRId64 " samples.\n", nsamples);
+    _rf_shm_tx_baseband(q, NULL, 1.0f, (uint32_t)nsamples);
+  }
+
+  pthread_mutex_unlock(&q->mutex);
+
+  return (int)nsamples;
+}
+
+/* Waits until the transmitted samples reach the timestamp, returns the number of samples still missing on timeout */
+int rf_shm_tx_wait(rf_shm_tx_t* q, uint64_t ts)
+{
+  uint64_t timeout_us = rf_shm_time_us() + 1000UL * q->trx_timeout_ms;
+
+  while (q->running) {
+    uint64_t write_ts = __atomic_load_n(&q->hdr->write_ts, __ATOMIC_ACQUIRE);
+    if (write_ts >= ts) {
+      return 0;
+    }
+    if (rf_shm_time_us() > timeout_us) {
+      rf_shm_info(q->id, " - Tx did not reach %" PRIu64 " samples after %d ms.\n", ts, q->trx_timeout_ms);
+      return (int)(ts - write_ts);
+    }
+    usleep(SHM_POLL_US);
+  }
+
+  return 0;
+}
+
+int rf_shm_tx_baseband(rf_shm_tx_t* q, const cf_t* buffer, float scale, uint32_t nsamples)
+{
+  int n = 0;
+
+  pthread_mutex_lock(&q->mutex);
+
+  if (q->sample_offset > 0) {
+    _rf_shm_tx_baseband(q, NULL, 1.0f, (uint32_t)q->sample_offset);
+    q->sample_offset = 0;
+  } else if (q->sample_offset < 0) {
+    n = SRSRAN_MIN(-q->sample_offset, nsamples);
+    buffer += n;
+    nsamples -= n;
+    q->sample_offset += n;
+  }
+
+  if (nsamples > 0) {
+    n += _rf_shm_tx_baseband(q, buffer, scale, nsamples);
+  }
+
+  pthread_mutex_unlock(&q->mutex);
+
+  return n;
+}
+
+uint64_t rf_shm_tx_get_nsamples(rf_shm_tx_t* q)
+{
+  pthread_mutex_lock(&q->mutex);
+  uint64_t ret = q->nsamples;
+  pthread_mutex_unlock(&q->mutex);
+  return ret;
+}
+
+int rf_shm_tx_zeros(rf_shm_tx_t* q, uint32_t nsamples)
+{
+  pthread_mutex_lock(&q->mutex);
+
+  rf_shm_info(q->id, " - Tx %d Zeros.\n", nsamples);
+  _rf_shm_tx_baseband(q, NULL, 1.0f, nsamples);
+
+  pthread_mutex_unlock(&q->mutex);
+
+  return (int)nsamples;
+}
+
+bool rf_shm_tx_match_freq(rf_shm_tx_t* q, uint32_t freq_hz)
+{
+  bool ret = false;
+  if (q) {
+    ret = (q->frequency_mhz == 0 || q->frequency_mhz == freq_hz);
+  }
+  return ret;
+}
+
+void rf_shm_tx_close(rf_shm_tx_t* q)
+{
+  pthread_mutex_lock(&q->mutex);
+  q->running = false;
+  pthread_mutex_unlock(&q->mutex);
+
+  pthread_mutex_destroy(&q->mutex);
+
+  if (q->hdr) {
+    __atomic_store_n(&q->hdr->closed, 1, __ATOMIC_RELEASE);
+    munmap(q->hdr, q->size);
+    q->hdr  = NULL;
+    q->data = NULL;
+    shm_unlink(q->name);
+  }
+}
+
+bool rf_shm_tx_is_running(rf_shm_tx_t* q)
+{
+  if (!q) {
+    return false;
+  }
+
+  bool ret = false;
+  pthread_mutex_lock(&q->mutex);
+  ret = q->running;
+  pthread_mutex_unlock(&q->mutex);
+
+  return ret;
+}
@@ -153,6 +153,12 @@ public:
       otw_format = dev_addr.pop("otw_format");
     }
 
+    // Set host format, sc16 leaves the conversion to floats to the caller
+    std::string cpu_format = "fc32";
+    if (dev_addr.has_key("cpu_format")) {
+      cpu_format = dev_addr.pop("cpu_format");
+    }
+
     // Samples-Per-Packet option, 0 means automatic
     std::string spp;
     if (dev_addr.has_key("spp")) {
@@ -208,7 +214,7 @@ public:
     }
 
     // Initialize TX/RX stream args
-    stream_args.cpu_format = "fc32";
+    stream_args.cpu_format = cpu_format;
     stream_args.otw_format = otw_format;
     if (not spp.empty()) {
       if (spp == "0") {
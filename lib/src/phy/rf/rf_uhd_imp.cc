@@ -153,6 +153,11 @@ struct rf_uhd_handler_t {
   std::array<double, SRSRAN_MAX_CHANNELS> rx_freq             = {};
   double                                  cur_rx_gain_ch0     = 0;
 
+  // Host sc16 mode, UHD hands over the samples as they are on the wire and they are converted with SIMD here
+  bool                                                  cpu_sc16 = false;
+  std::array<std::vector<int16_t>, SRSRAN_MAX_CHANNELS> rx_sc16  = {};
+  std::array<std::vector<int16_t>, SRSRAN_MAX_CHANNELS> tx_sc16  = {};
+
   std::mutex                                                 tx_gain_mutex;
   std::array<std::pair<double, double>, SRSRAN_MAX_CHANNELS> tx_gain_db = {};
 
@@ -753,6 +758,11 @@ static int uhd_init(rf_uhd_handler_t* handler, char* args, uint32_t nof_channels
     device_addr.pop("sampling_rate");
   }
 
+  // Parse host sample format, the key is consumed by the UHD device
+  if (device_addr.has_key("cpu_format")) {
+    handler->cpu_sc16 = (device_addr["cpu_format"] == "sc16");
+  }
+
   // Create UHD handler
   printf("Opening USRP channels=%d, args: %s\n", nof_channels, device_addr.to_string().c_str());
 
@@ -760,6 +770,15 @@ static int uhd_init(rf_uhd_handler_t* handler, char* args, uint32_t nof_channels
 #ifdef UHD_ENABLE_RFNOC
   if (rf_uhd_rfnoc::is_required(device_addr)) {
     handler->uhd = std::make_shared<rf_uhd_rfnoc>();
+
+    // RFNoC streams are always fc32 on the host
+    if (device_addr.has_key("cpu_format")) {
+      device_addr.pop("cpu_format");
+      if (handler->cpu_sc16) {
+        Warning("cpu_format=sc16 is not supported by RFNoC devices, using fc32");
+      }
+      handler->cpu_sc16 = false;
+    }
   }
 #endif // UHD_ENABLE_RFNOC
 
@@ -1308,7 +1327,14 @@ int rf_uhd_recv_with_time_multi(void*    h,
     size_t num_rx_samples = SRSRAN_MIN(handler->rx_nof_samples, num_samps_left);
 
     for (uint32_t i = 0; i < handler->nof_rx_channels; i++) {
-      if (data[i] != nullptr) {
+      if (handler->cpu_sc16) {
+        // Receive in the intermediate buffer, the samples are converted after
+        std::vector<int16_t>& buf = handler->rx_sc16[i];
+        if (buf.size() < 2 * num_rx_samples) {
+          buf.resize(2 * num_rx_samples);
+        }
+        buffs_ptr[i] = buf.data();
+      } else if (data[i] != nullptr) {
         cf_t* data_c = (cf_t*)data[i];
         buffs_ptr[i] = &data_c[rxd_samples_total];
       } else {
@@ -1322,6 +1348,17 @@ int rf_uhd_recv_with_time_multi(void*    h,
       return SRSRAN_ERROR;
     }
 
+    // Convert to floats only the channels with a buffer, with the same scale UHD uses
+    if (handler->cpu_sc16) {
+      for (uint32_t i = 0; i < handler->nof_rx_channels; i++) {
+        if (data[i] != nullptr) {
+          cf_t* data_c = (cf_t*)data[i];
+          srsran_vec_convert_if(
+              handler->rx_sc16[i].data(), INT16_MAX, (float*)&data_c[rxd_samples_total], 2 * (uint32_t)rxd_samples);
+        }
+      }
+    }
+
     // Save timespec for first block
     if (rxd_samples_total == 0) {
       timespec = md.time_spec;
@@ -1513,6 +1550,21 @@ int rf_uhd_send_timed_multi(void*  h,
       buffs_ptr[i] = buff;
     }
 
+    // Convert the channels with samples to sc16, the zeros are the same in both formats
+    if (handler->cpu_sc16) {
+      for (uint32_t i = 0; i < handler->nof_tx_channels; i++) {
+        if (data_c[i] == zero_mem.data()) {
+          continue;
+        }
+        std::vector<int16_t>& buf = handler->tx_sc16[i];
+        if (buf.size() < 2 * tx_samples) {
+          buf.resize(2 * tx_samples);
+        }
+        srsran_vec_convert_fi((const float*)&data_c[i][n], INT16_MAX, buf.data(), 2 * (uint32_t)tx_samples);
+        buffs_ptr[i] = buf.data();
+      }
+    }
+
     size_t txd_samples = tx_samples; //< Stores the number of transmitted samples in this packet
 
     // Skip baseband packet transmission if it is waiting for the enb of burst ACK
@@ -49,6 +49,10 @@ typedef struct {
   bool     tx_off;
   char     id[RF_PARAM_LEN];
 
+  // Virtual time, the Rx does not pace to the wall clock but waits for the ongoing Tx burst instead
+  bool virtual_time;
+  bool tx_in_burst;
+
   // Server
   void*       context;
   rf_zmq_tx_t transmitter[SRSRAN_MAX_CHANNELS];
@@ -288,6 +292,13 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
           goto clean_exit;
         }
       }
+
+      // virtual_time
+      bzero(tmp, RF_PARAM_LEN);
+      parse_string(args, "virtual_time", -1, tmp);
+      if (strncmp(tmp, "true", RF_PARAM_LEN) == 0 || strncmp(tmp, "yes", RF_PARAM_LEN) == 0) {
+        handler->virtual_time = true;
+      }
     } else {
       fprintf(stderr,
               "[zmq] Error: No device 'args' option has been set. Please make sure to set this option to be able to "
@@ -710,8 +721,22 @@ int rf_zmq_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool bl
     rf_zmq_info(handler->id, " - next rx time: %d + %.3f\n", ts_rx.full_secs, ts_rx.frac_secs);
     rf_zmq_info(handler->id, " - next tx time: %d + %.3f\n", ts_tx.full_secs, ts_tx.frac_secs);
 
-    // Leave time for the Tx to transmit
-    usleep((1000000UL * nsamples_baserate) / handler->base_srate);
+    if (handler->virtual_time) {
+      // Instead of pacing to the wall clock, wait for the ongoing Tx burst to reach the end of this reception. The
+      // time then advances as fast as all the peers produce their samples, and no late Tx is replaced by a gap
+      if (__atomic_load_n(&handler->tx_in_burst, __ATOMIC_ACQUIRE)) {
+        for (int i = 0; i < handler->nof_channels; i++) {
+          if (rf_zmq_tx_is_running(&handler->transmitter[i])) {
+            rf_zmq_tx_wait(&handler->transmitter[i],
+                           handler->next_rx_ts + nsamples_baserate,
+                           handler->receiver[i].trx_timeout_ms);
+          }
+        }
+      }
+    } else {
+      // Leave time for the Tx to transmit
+      usleep((1000000UL * nsamples_baserate) / handler->base_srate);
+    }
 
     // check for tx gap if we're also transmitting on this radio
     for (int i = 0; i < handler->nof_channels; i++) {
@@ -861,6 +886,12 @@ int rf_zmq_send_timed_multi(void*  h,
 {
   int ret = SRSRAN_ERROR;
 
+  // Follow the Tx bursts, the end of burst comes without samples
+  if (h && (is_end_of_burst || nsamples > 0)) {
+    rf_zmq_handler_t* handler = (rf_zmq_handler_t*)h;
+    __atomic_store_n(&handler->tx_in_burst, !is_end_of_burst, __ATOMIC_RELEASE);
+  }
+
   if (h && data && nsamples > 0) {
     rf_zmq_handler_t* handler = (rf_zmq_handler_t*)h;
 
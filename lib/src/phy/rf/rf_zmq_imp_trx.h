@@ -33,6 +33,7 @@
 #define NBYTES2NSAMPLES(X) ((X) / sizeof(cf_t))
 #define ZMQ_MAX_BUFFER_SIZE (NSAMPLES2NBYTES(3072000)) // 10 subframes at 20 MHz
 #define ZMQ_TIMEOUT_MS (2000)
+#define ZMQ_POLL_US (20)
 #define ZMQ_BASERATE_DEFAULT_HZ (23040000)
 #define ZMQ_ID_STRLEN 16
 #define ZMQ_MAX_GAIN_DB (30.0f)
@@ -104,6 +105,8 @@ SRSRAN_API int rf_zmq_tx_open(rf_zmq_tx_t* q, rf_zmq_opts_t opts, void* zmq_ctx,
 
 SRSRAN_API int rf_zmq_tx_align(rf_zmq_tx_t* q, uint64_t ts);
 
+SRSRAN_API int rf_zmq_tx_wait(rf_zmq_tx_t* q, uint64_t ts, uint32_t timeout_ms);
+
 SRSRAN_API int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples);
 
 SRSRAN_API int rf_zmq_tx_get_nsamples(rf_zmq_tx_t* q);
@@ -25,6 +25,8 @@
 #include <srsran/phy/utils/vector.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <unistd.h>
 #include <zmq.h>
 
 int rf_zmq_tx_open(rf_zmq_tx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock_args)
@@ -183,6 +185,37 @@ int rf_zmq_tx_align(rf_zmq_tx_t* q, uint64_t ts)
   return (int)nsamples;
 }
 
+static uint64_t rf_zmq_time_us(void)
+{
+  struct timespec t = {};
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (uint64_t)t.tv_sec * 1000000UL + (uint64_t)t.tv_nsec / 1000UL;
+}
+
+/* Waits until the transmitted samples reach the timestamp, returns the number of samples still missing on timeout */
+int rf_zmq_tx_wait(rf_zmq_tx_t* q, uint64_t ts, uint32_t timeout_ms)
+{
+  uint64_t timeout_us = rf_zmq_time_us() + 1000UL * timeout_ms;
+
+  while (q->running) {
+    // The mutex is held while a transmission waits for the request of the receiver
+    pthread_mutex_lock(&q->mutex);
+    uint64_t nsamples = q->nsamples;
+    pthread_mutex_unlock(&q->mutex);
+
+    if (nsamples >= ts) {
+      return 0;
+    }
+    if (rf_zmq_time_us() > timeout_us) {
+      rf_zmq_info(q->id, " - Tx did not reach %" PRIu64 " samples after %d ms.\n", ts, timeout_ms);
+      return (int)(ts - nsamples);
+    }
+    usleep(ZMQ_POLL_US);
+  }
+
+  return 0;
+}
+
 int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
 {
   int n;
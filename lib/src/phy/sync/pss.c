@@ -39,7 +39,8 @@ int srsran_pss_init_N_id_2(cf_t* pss_signal_freq, cf_t* pss_signal_time, uint32_
 
     srsran_vec_cf_zero(pss_signal_pad, fft_size);
     srsran_vec_cf_zero(pss_signal_time, fft_size);
-    memcpy(&pss_signal_pad[(fft_size - SRSRAN_PSS_LEN) / 2 + cfo_i], pss_signal_freq, SRSRAN_PSS_LEN * sizeof(cf_t));
+    // The time-domain sequence is conjugated below, which mirrors the shift: place it at -cfo_i to match +cfo_i
+    memcpy(&pss_signal_pad[(fft_size - SRSRAN_PSS_LEN) / 2 - cfo_i], pss_signal_freq, SRSRAN_PSS_LEN * sizeof(cf_t));
 
     /* Convert signal into the time domain */
     if (srsran_dft_plan(&plan, fft_size, SRSRAN_DFT_BACKWARD, SRSRAN_DFT_COMPLEX)) {
@@ -443,12 +444,86 @@ float compute_peak_sidelobe(srsran_pss_t* q, uint32_t corr_peak_pos, uint32_t co
  *
  * Input buffer must be subframe_size long.
  */
+#ifdef CONVOLUTION_FFT
+/* Transforms the (decimated) input frame to the frequency domain, leaves the result in q->conv_fft.input_fft */
+static void pss_input_fft(srsran_pss_t* q, const cf_t* input)
+{
+  memcpy(q->tmp_input, input, (q->frame_size * q->decimate) * sizeof(cf_t));
+  if (q->decimate > 1) {
+    srsran_filt_decim_cc_execute(&(q->filter),
+                                 q->tmp_input,
+                                 q->filter.downsampled_input,
+                                 q->filter.filter_output,
+                                 (q->frame_size * q->decimate));
+    srsran_dft_run_c(&q->conv_fft.input_plan, q->filter.filter_output, q->conv_fft.input_fft);
+  } else {
+    srsran_dft_run_c(&q->conv_fft.input_plan, q->tmp_input, q->conv_fft.input_fft);
+  }
+}
+
+/* Correlates a transformed input frame with the PSS sequence of q, returns the correlation length. Same as
+ * srsran_conv_fft_cc_run_opt() without the input transform, so an input_fft can be shared by several objects */
+static uint32_t pss_correlate_fft(srsran_pss_t* q, const cf_t* input_fft)
+{
+  srsran_vec_prod_ccc(input_fft, q->pss_signal_freq_full[q->N_id_2], q->conv_fft.output_fft, q->conv_fft.output_len);
+  srsran_dft_run_c(&q->conv_fft.output_plan, q->conv_fft.output_fft, q->conv_output);
+
+  return q->conv_fft.output_len - 1;
+}
+#endif
+
+/* Averages the correlation in q->conv_output with the previous calls and returns the position of its peak */
+static int pss_find_peak(srsran_pss_t* q, uint32_t conv_output_len, float* corr_peak_value)
+{
+  uint32_t corr_peak_pos;
+
+  // Compute modulus square
+  srsran_vec_abs_square_cf(q->conv_output, q->conv_output_abs, conv_output_len - 1);
+
+  // If enabled, average the absolute value from previous calls
+  if (q->ema_alpha < 1.0 && q->ema_alpha > 0.0) {
+    srsran_vec_sc_prod_fff(q->conv_output_abs, q->ema_alpha, q->conv_output_abs, conv_output_len - 1);
+    srsran_vec_sc_prod_fff(q->conv_output_avg, 1 - q->ema_alpha, q->conv_output_avg, conv_output_len - 1);
+
+    srsran_vec_sum_fff(q->conv_output_abs, q->conv_output_avg, q->conv_output_avg, conv_output_len - 1);
+  } else {
+    memcpy(q->conv_output_avg, q->conv_output_abs, sizeof(float) * (conv_output_len - 1));
+  }
+
+  /* Find maximum of the absolute value of the correlation */
+  corr_peak_pos = srsran_vec_max_fi(q->conv_output_avg, conv_output_len - 1);
+
+  // save absolute value
+  q->peak_value = q->conv_output_avg[corr_peak_pos];
+
+#ifdef SRSRAN_PSS_RETURN_PSR
+  if (corr_peak_value) {
+    *corr_peak_value = compute_peak_sidelobe(q, corr_peak_pos, conv_output_len);
+  }
+#else
+  if (corr_peak_value) {
+    *corr_peak_value = q->conv_output_avg[corr_peak_pos];
+  }
+#endif
+
+  if (q->decimate > 1) {
+    int decimation_correction = (q->filter.num_taps - 2);
+    corr_peak_pos             = corr_peak_pos - decimation_correction;
+    corr_peak_pos             = corr_peak_pos * q->decimate;
+  }
+
+  if (q->frame_size >= q->fft_size) {
+    return (int)corr_peak_pos;
+  } else {
+    return (int)corr_peak_pos + q->fft_size;
+  }
+}
+
 int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_value)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
 
   if (q != NULL && input != NULL) {
-    uint32_t corr_peak_pos;
     uint32_t conv_output_len;
 
     if (!srsran_N_id_2_isvalid(q->N_id_2)) {
@@ -464,20 +539,8 @@ int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_val
      */
     if (q->frame_size >= q->fft_size) {
 #ifdef CONVOLUTION_FFT
-      memcpy(q->tmp_input, input, (q->frame_size * q->decimate) * sizeof(cf_t));
-      if (q->decimate > 1) {
-        srsran_filt_decim_cc_execute(&(q->filter),
-                                     q->tmp_input,
-                                     q->filter.downsampled_input,
-                                     q->filter.filter_output,
-                                     (q->frame_size * q->decimate));
-        conv_output_len = srsran_conv_fft_cc_run_opt(
-            &q->conv_fft, q->filter.filter_output, q->pss_signal_freq_full[q->N_id_2], q->conv_output);
-      } else {
-        conv_output_len =
-            srsran_conv_fft_cc_run_opt(&q->conv_fft, q->tmp_input, q->pss_signal_freq_full[q->N_id_2], q->conv_output);
-      }
-
+      pss_input_fft(q, input);
+      conv_output_len = pss_correlate_fft(q, q->conv_fft.input_fft);
 #else
       conv_output_len =
           srsran_conv_cc(input, q->pss_signal_time[q->N_id_2], q->conv_output, q->frame_size, q->fft_size);
@@ -489,48 +552,56 @@ int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_val
       conv_output_len = q->frame_size;
     }
 
-    // Compute modulus square
-    srsran_vec_abs_square_cf(q->conv_output, q->conv_output_abs, conv_output_len - 1);
+    ret = pss_find_peak(q, conv_output_len, corr_peak_value);
+  }
+  return ret;
+}
 
-    // If enabled, average the absolute value from previous calls
-    if (q->ema_alpha < 1.0 && q->ema_alpha > 0.0) {
-      srsran_vec_sc_prod_fff(q->conv_output_abs, q->ema_alpha, q->conv_output_abs, conv_output_len - 1);
-      srsran_vec_sc_prod_fff(q->conv_output_avg, 1 - q->ema_alpha, q->conv_output_avg, conv_output_len - 1);
+int srsran_pss_find_pss_multi(srsran_pss_t* q[],
+                              uint32_t      nof_pss,
+                              const cf_t*   input,
+                              int           peak_pos[],
+                              float         corr_peak_value[])
+{
+  if (q == NULL || input == NULL || peak_pos == NULL || nof_pss == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-      srsran_vec_sum_fff(q->conv_output_abs, q->conv_output_avg, q->conv_output_avg, conv_output_len - 1);
-    } else {
-      memcpy(q->conv_output_avg, q->conv_output_abs, sizeof(float) * (conv_output_len - 1));
+  for (uint32_t i = 0; i < nof_pss; i++) {
+    if (q[i] == NULL) {
+      return SRSRAN_ERROR_INVALID_INPUTS;
     }
+    if (!srsran_N_id_2_isvalid(q[i]->N_id_2)) {
+      ERROR("Error finding PSS peak, Must set N_id_2 first");
+      return SRSRAN_ERROR;
+    }
+  }
 
-    /* Find maximum of the absolute value of the correlation */
-    corr_peak_pos = srsran_vec_max_fi(q->conv_output_avg, conv_output_len - 1);
-
-    // save absolute value
-    q->peak_value = q->conv_output_avg[corr_peak_pos];
+#ifdef CONVOLUTION_FFT
+  // The input transform can only be shared if all the objects see the same decimated frame through the same plan
+  bool shared = q[0]->frame_size >= q[0]->fft_size;
+  for (uint32_t i = 1; i < nof_pss && shared; i++) {
+    shared = q[i]->frame_size == q[0]->frame_size && q[i]->fft_size == q[0]->fft_size &&
+             q[i]->decimate == q[0]->decimate && q[i]->conv_fft.output_len == q[0]->conv_fft.output_len;
+  }
 
-#ifdef SRSRAN_PSS_RETURN_PSR
-    if (corr_peak_value) {
-      *corr_peak_value = compute_peak_sidelobe(q, corr_peak_pos, conv_output_len);
-    }
-#else
-    if (corr_peak_value) {
-      *corr_peak_value = q->conv_output_avg[corr_peak_pos];
+  if (shared) {
+    pss_input_fft(q[0], input);
+    for (uint32_t i = 0; i < nof_pss; i++) {
+      uint32_t conv_output_len = pss_correlate_fft(q[i], q[0]->conv_fft.input_fft);
+      peak_pos[i]              = pss_find_peak(q[i], conv_output_len, corr_peak_value ? &corr_peak_value[i] : NULL);
     }
+    return SRSRAN_SUCCESS;
+  }
 #endif
 
-    if (q->decimate > 1) {
-      int decimation_correction = (q->filter.num_taps - 2);
-      corr_peak_pos             = corr_peak_pos - decimation_correction;
-      corr_peak_pos             = corr_peak_pos * q->decimate;
-    }
-
-    if (q->frame_size >= q->fft_size) {
-      ret = (int)corr_peak_pos;
-    } else {
-      ret = (int)corr_peak_pos + q->fft_size;
+  for (uint32_t i = 0; i < nof_pss; i++) {
+    peak_pos[i] = srsran_pss_find_pss(q[i], input, corr_peak_value ? &corr_peak_value[i] : NULL);
+    if (peak_pos[i] < 0) {
+      return peak_pos[i];
     }
   }
-  return ret;
+  return SRSRAN_SUCCESS;
 }
 
 /* Computes frequency-domain channel estimation of the PSS symbol
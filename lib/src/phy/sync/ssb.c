@@ -81,6 +81,7 @@ static int ssb_init_pbch(srsran_ssb_t* q)
   args.enable_encode         = q->args.enable_encode;
   args.enable_decode         = q->args.enable_decode;
   args.disable_simd          = q->args.disable_polar_simd;
+  args.polar_list_size       = q->args.polar_list_size;
 
   if (!args.enable_encode && !args.enable_decode) {
     return SRSRAN_SUCCESS;
@@ -1435,38 +1436,16 @@ static int ssb_pss_find(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, u
   return SRSRAN_SUCCESS;
 }
 
-int srsran_ssb_find(srsran_ssb_t*                  q,
-                    const cf_t*                    sf_buffer,
-                    uint32_t                       N_id,
-                    srsran_csi_trs_measurements_t* meas,
-                    srsran_pbch_msg_nr_t*          pbch_msg)
+// Demodulates, measures and decodes the SSB whose PSS correlation peak is at t_offset of buffer, the subframe starts at
+// the sample sf_start of buffer
+static int ssb_find_decode(srsran_ssb_t*                  q,
+                           const cf_t*                    buffer,
+                           uint32_t                       sf_start,
+                           uint32_t                       t_offset,
+                           uint32_t                       N_id,
+                           srsran_csi_trs_measurements_t* meas,
+                           srsran_pbch_msg_nr_t*          pbch_msg)
 {
-  // Verify inputs
-  if (q == NULL || sf_buffer == NULL || meas == NULL || !isnormal(q->scs_hz)) {
-    return SRSRAN_ERROR_INVALID_INPUTS;
-  }
-
-  if (!q->args.enable_search) {
-    ERROR("SSB is not configured for search");
-    return SRSRAN_ERROR;
-  }
-
-  // Set the PBCH message result with default value (CRC unmatched), meaning no cell is found
-  SRSRAN_MEM_ZERO(pbch_msg, srsran_pbch_msg_nr_t, 1);
-
-  // Copy tail from previous execution into the start of this
-  srsran_vec_cf_copy(q->sf_buffer, &q->sf_buffer[q->sf_sz], q->ssb_sz);
-
-  // Append new samples
-  srsran_vec_cf_copy(&q->sf_buffer[q->ssb_sz], sf_buffer, q->sf_sz);
-
-  // Search for PSS in time domain
-  uint32_t t_offset = 0;
-  if (ssb_pss_find(q, q->sf_buffer, q->sf_sz + q->ssb_sz, SRSRAN_NID_2_NR(N_id), &t_offset) < SRSRAN_SUCCESS) {
-    ERROR("Error searching for N_id_2");
-    return SRSRAN_ERROR;
-  }
-
   // Remove CP offset prior demodulation
   if (t_offset >= q->cp_sz) {
     t_offset -= q->cp_sz;
@@ -1475,13 +1454,13 @@ int srsran_ssb_find(srsran_ssb_t*                  q,
   }
 
   // Make sure SSB time offset is in bounded in the input buffer
-  if (t_offset > q->sf_sz) {
+  if (t_offset + q->ssb_sz > sf_start + q->sf_sz) {
     return SRSRAN_SUCCESS;
   }
 
   // Demodulate
   cf_t ssb_grid[SRSRAN_SSB_NOF_RE] = {};
-  if (ssb_demodulate(q, q->sf_buffer, t_offset, 0.0f, ssb_grid) < SRSRAN_SUCCESS) {
+  if (ssb_demodulate(q, buffer, t_offset, 0.0f, ssb_grid) < SRSRAN_SUCCESS) {
     ERROR("Error demodulating");
     return SRSRAN_ERROR;
   }
@@ -1516,7 +1495,7 @@ int srsran_ssb_find(srsran_ssb_t*                  q,
   }
 
   // SSB delay in SF
-  float ssb_delay_us = (float)(1e6 * (((double)t_offset - (double)q->ssb_sz - (double)ssb_offset) / q->cfg.srate_hz));
+  float ssb_delay_us = (float)(1e6 * (((double)t_offset - (double)sf_start - (double)ssb_offset) / q->cfg.srate_hz));
 
   // Add delay to measure
   meas->delay_us += ssb_delay_us;
@@ -1524,6 +1503,83 @@ int srsran_ssb_find(srsran_ssb_t*                  q,
   return SRSRAN_SUCCESS;
 }
 
+int srsran_ssb_find(srsran_ssb_t*                  q,
+                    const cf_t*                    sf_buffer,
+                    uint32_t                       N_id,
+                    srsran_csi_trs_measurements_t* meas,
+                    srsran_pbch_msg_nr_t*          pbch_msg)
+{
+  // Verify inputs
+  if (q == NULL || sf_buffer == NULL || meas == NULL || !isnormal(q->scs_hz)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!q->args.enable_search) {
+    ERROR("SSB is not configured for search");
+    return SRSRAN_ERROR;
+  }
+
+  // Set the PBCH message result with default value (CRC unmatched), meaning no cell is found
+  SRSRAN_MEM_ZERO(pbch_msg, srsran_pbch_msg_nr_t, 1);
+
+  // Copy tail from previous execution into the start of this
+  srsran_vec_cf_copy(q->sf_buffer, &q->sf_buffer[q->sf_sz], q->ssb_sz);
+
+  // Append new samples
+  srsran_vec_cf_copy(&q->sf_buffer[q->ssb_sz], sf_buffer, q->sf_sz);
+
+  // Search for PSS in time domain
+  uint32_t t_offset = 0;
+  if (ssb_pss_find(q, q->sf_buffer, q->sf_sz + q->ssb_sz, SRSRAN_NID_2_NR(N_id), &t_offset) < SRSRAN_SUCCESS) {
+    ERROR("Error searching for N_id_2");
+    return SRSRAN_ERROR;
+  }
+
+  return ssb_find_decode(q, q->sf_buffer, q->ssb_sz, t_offset, N_id, meas, pbch_msg);
+}
+
+int srsran_ssb_find_window(srsran_ssb_t*                  q,
+                           const cf_t*                    sf_buffer,
+                           uint32_t                       N_id,
+                           uint32_t                       ssb_idx,
+                           uint32_t                       max_delay,
+                           srsran_csi_trs_measurements_t* meas,
+                           srsran_pbch_msg_nr_t*          pbch_msg)
+{
+  // Verify inputs
+  if (q == NULL || sf_buffer == NULL || meas == NULL || !isnormal(q->scs_hz)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!q->args.enable_search) {
+    ERROR("SSB is not configured for search");
+    return SRSRAN_ERROR;
+  }
+
+  // Set the PBCH message result with default value (CRC unmatched), meaning no cell is found
+  SRSRAN_MEM_ZERO(pbch_msg, srsran_pbch_msg_nr_t, 1);
+
+  // The subframes in between are not given, discard the tail kept by srsran_ssb_find()
+  srsran_vec_cf_zero(&q->sf_buffer[q->sf_sz], q->ssb_sz);
+
+  // Expected PSS correlation peak, clipped to the subframe
+  uint32_t expected = srsran_ssb_candidate_sf_offset(q, ssb_idx) + q->cp_sz;
+  uint32_t start    = (expected > max_delay) ? expected - max_delay : 0;
+  uint32_t end      = SRSRAN_MIN(expected + max_delay + 1 + q->symbol_sz, q->sf_sz);
+  if (start + q->symbol_sz >= end) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Search for PSS in the window only
+  uint32_t t_offset = 0;
+  if (ssb_pss_find(q, &sf_buffer[start], end - start, SRSRAN_NID_2_NR(N_id), &t_offset) < SRSRAN_SUCCESS) {
+    ERROR("Error searching for N_id_2");
+    return SRSRAN_ERROR;
+  }
+
+  return ssb_find_decode(q, sf_buffer, 0, start + t_offset, N_id, meas, pbch_msg);
+}
+
 int srsran_ssb_track(srsran_ssb_t*                  q,
                      const cf_t*                    sf_buffer,
                      uint32_t                       N_id,
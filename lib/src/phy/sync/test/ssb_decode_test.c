@@ -39,6 +39,7 @@ static double                      carrier_freq_hz = 3.5e9 + 960e3;
 static srsran_subcarrier_spacing_t ssb_scs         = srsran_subcarrier_spacing_30kHz;
 static double                      ssb_freq_hz     = 3.5e9;
 static srsran_ssb_pattern_t        ssb_pattern     = SRSRAN_SSB_PATTERN_A;
+static uint32_t                    polar_list_size = 1;
 
 // Channel parameters
 static cf_t    wideband_gain = 1.0f + 0.5 * I;
@@ -61,13 +62,14 @@ static void usage(char* prog)
   printf("\t-S cell/carrier subcarrier spacing [default, %s kHz]\n", srsran_subcarrier_spacing_to_str(carrier_scs));
   printf("\t-F cell/carrier center frequency in Hz [default, %.3f MHz]\n", carrier_freq_hz / 1e6);
   printf("\t-P SSB pattern [default, %s]\n", srsran_ssb_pattern_to_str(ssb_pattern));
+  printf("\t-L PBCH polar decoder list size, 1 selects the SSC decoder [default, %d]\n", polar_list_size);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 static void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "SsFfPv")) != -1) {
+  while ((opt = getopt(argc, argv, "SsFfPLv")) != -1) {
     switch (opt) {
       case 's':
         ssb_scs = srsran_subcarrier_spacing_from_str(argv[optind]);
@@ -92,6 +94,9 @@ static void parse_args(int argc, char** argv)
       case 'P':
         ssb_pattern = srsran_ssb_pattern_fom_str(argv[optind]);
         break;
+      case 'L':
+        polar_list_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -310,6 +315,7 @@ int main(int argc, char** argv)
   ssb_args.enable_encode     = true;
   ssb_args.enable_decode     = true;
   ssb_args.enable_search     = true;
+  ssb_args.polar_list_size   = polar_list_size;
 
   if (buffer == NULL) {
     ERROR("Malloc");
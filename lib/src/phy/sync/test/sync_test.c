@@ -31,7 +31,8 @@
 
 #include "srsran/srsran.h"
 
-int         cell_id = -1, offset = 0;
+int         cell_id = -1, offset = 0, cfo_i = 0;
+bool        cfo_i_enable = false;
 srsran_cp_t cp      = SRSRAN_CP_NORM;
 uint32_t    nof_prb = 6;
 
@@ -39,18 +40,19 @@ uint32_t    nof_prb = 6;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [cpoev]\n", prog);
+  printf("Usage: %s [cpoeiv]\n", prog);
   printf("\t-c cell_id [Default check for all]\n");
   printf("\t-p nof_prb [Default %d]\n", nof_prb);
   printf("\t-o offset [Default %d]\n", offset);
   printf("\t-e extended CP [Default normal]\n");
+  printf("\t-i integer CFO in subcarriers, enables its estimation [Default disabled]\n");
   printf("\t-v srsran_verbose\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "cpoev")) != -1) {
+  while ((opt = getopt(argc, argv, "cpoeiv")) != -1) {
     switch (opt) {
       case 'c':
         cell_id = (int)strtol(argv[optind], NULL, 10);
@@ -64,6 +66,10 @@ void parse_args(int argc, char** argv)
       case 'e':
         cp = SRSRAN_CP_EXT;
         break;
+      case 'i':
+        cfo_i        = (int)strtol(argv[optind], NULL, 10);
+        cfo_i_enable = true;
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -122,6 +128,7 @@ int main(int argc, char** argv)
   /* Set a very high threshold to make sure the correlation is ok */
   srsran_sync_set_threshold(&syncobj, 5.0);
   srsran_sync_set_sss_algorithm(&syncobj, SSS_PARTIAL_3);
+  srsran_sync_set_cfo_i_enable(&syncobj, cfo_i_enable);
 
   if (cell_id == -1) {
     cid     = 0;
@@ -149,6 +156,11 @@ int main(int argc, char** argv)
       memset(fft_buffer, 0, sizeof(cf_t) * FLEN);
       srsran_ofdm_tx_sf(&ifft);
 
+      /* Apply integer CFO */
+      for (int i = 0; i < FLEN && cfo_i != 0; i++) {
+        fft_buffer[i] *= cexpf(_Complex_I * 2.0f * (float)M_PI * (float)(cfo_i * i) / (float)fft_size);
+      }
+
       /* Apply sample offset */
       for (int i = 0; i < FLEN; i++) {
         fft_buffer[FLEN - i - 1 + offset] = fft_buffer[FLEN - i - 1];
@@ -169,6 +181,10 @@ int main(int argc, char** argv)
         printf("ns != find_ns\n");
         exit(-1);
       }
+      if (cfo_i_enable && syncobj.cfo_i_value != cfo_i) {
+        printf("cfo_i != find_cfo_i: %d != %d\n", cfo_i, syncobj.cfo_i_value);
+        exit(-1);
+      }
       if (srsran_sync_get_cp(&syncobj) != cp) {
         printf("Detected CP should be %s\n", SRSRAN_CP_ISNORM(cp) ? "Normal" : "Extended");
         exit(-1);
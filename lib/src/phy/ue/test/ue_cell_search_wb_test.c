@@ -0,0 +1,241 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/dft/ofdm.h"
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/sync/pss.h"
+#include "srsran/phy/sync/sss.h"
+#include "srsran/phy/ue/ue_cell_search_wb.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#define NOF_CELLS 3
+#define NOF_CHANNELS (NOF_CELLS + 1)
+
+// Cells in the capture, the last sub-channel is empty
+static const uint32_t cell_pci[NOF_CELLS]      = {1, 150, 500};
+static const float    channel_hz[NOF_CHANNELS] = {-3.5e6f, 2.2e6f, 4.0e6f, -1.2e6f};
+static double         srate_hz                 = 11.52e6;
+static uint32_t       nof_threads              = 4;
+static float          snr_dB                   = 10.0f;
+static uint32_t       nof_frames               = 2; // Number of 10 ms radio frames in the capture
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [stnv]\n", prog);
+  printf("\t-s capture sampling rate in Hz [Default %.0f]\n", srate_hz);
+  printf("\t-t number of threads [Default %d]\n", nof_threads);
+  printf("\t-n SNR in dB [Default %.1f]\n", snr_dB);
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "stnv")) != -1) {
+    switch (opt) {
+      case 's':
+        srate_hz = strtod(argv[optind], NULL);
+        break;
+      case 't':
+        nof_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        snr_dB = strtof(argv[optind], NULL);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+// Generates the radio frames of a 6 PRB cell with random QPSK around the PSS/SSS, at SRSRAN_CS_SAMP_FREQ
+static int gen_cell(uint32_t pci, srsran_random_t random, cf_t* signal)
+{
+  srsran_cell_t cell = {};
+  cell.nof_prb       = SRSRAN_CS_NOF_PRB;
+  cell.id            = pci;
+  cell.cp            = SRSRAN_CP_NORM;
+
+  uint32_t      sf_len    = SRSRAN_SF_LEN_PRB(cell.nof_prb);
+  uint32_t      nof_re    = SRSRAN_SF_LEN_RE(cell.nof_prb, cell.cp);
+  cf_t*         sf_symbol = srsran_vec_cf_malloc(nof_re);
+  cf_t*         sf_signal = srsran_vec_cf_malloc(sf_len);
+  srsran_ofdm_t ifft      = {};
+  if (sf_symbol == NULL || sf_signal == NULL ||
+      srsran_ofdm_tx_init(&ifft, cell.cp, sf_symbol, sf_signal, cell.nof_prb)) {
+    ERROR("Error initiating OFDM modulator");
+    return SRSRAN_ERROR;
+  }
+
+  cf_t  pss_signal[SRSRAN_PSS_LEN];
+  float sss_signal0[SRSRAN_SSS_LEN];
+  float sss_signal5[SRSRAN_SSS_LEN];
+  srsran_pss_generate(pss_signal, pci % SRSRAN_NOF_NID_2);
+  srsran_sss_generate(sss_signal0, sss_signal5, pci);
+
+  for (uint32_t sf = 0; sf < nof_frames * SRSRAN_NOF_SF_X_FRAME; sf++) {
+    for (uint32_t i = 0; i < nof_re; i++) {
+      sf_symbol[i] = ((float)srsran_random_uniform_int_dist(random, 0, 1) * 2 - 1 +
+                      _Complex_I * ((float)srsran_random_uniform_int_dist(random, 0, 1) * 2 - 1)) *
+                     (float)M_SQRT1_2;
+    }
+    if (sf % 5 == 0) {
+      srsran_pss_put_slot(pss_signal, sf_symbol, cell.nof_prb, cell.cp);
+      srsran_sss_put_slot(sf % 10 == 0 ? sss_signal0 : sss_signal5, sf_symbol, cell.nof_prb, cell.cp);
+    }
+    srsran_ofdm_tx_sf(&ifft);
+    srsran_vec_cf_copy(&signal[sf * sf_len], sf_signal, sf_len);
+  }
+
+  srsran_ofdm_tx_free(&ifft);
+  free(sf_symbol);
+  free(sf_signal);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  uint32_t cell_len    = nof_frames * SRSRAN_NOF_SF_X_FRAME * SRSRAN_SF_LEN_PRB(SRSRAN_CS_NOF_PRB);
+  uint32_t capture_len = (uint32_t)round(cell_len * srate_hz / SRSRAN_CS_SAMP_FREQ);
+
+  srsran_random_t                  random    = srsran_random_init(1234);
+  srsran_channel_awgn_t            awgn      = {};
+  srsran_resampler_poly_t          interp    = {};
+  srsran_ue_cellsearch_wb_t        cs_wb     = {};
+  srsran_ue_cellsearch_wb_result_t results[NOF_CHANNELS];
+  cf_t*                            cell      = srsran_vec_cf_malloc(cell_len);
+  cf_t*                            upsampled = srsran_vec_cf_malloc(capture_len + 1);
+  cf_t*                            capture   = srsran_vec_cf_malloc(capture_len + 1);
+  if (cell == NULL || upsampled == NULL || capture == NULL) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+  srsran_vec_cf_zero(capture, capture_len);
+
+  if (srsran_resampler_poly_init(&interp, (uint32_t)round(srate_hz), (uint32_t)SRSRAN_CS_SAMP_FREQ) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating interpolator");
+    goto clean_exit;
+  }
+
+  // Build the wideband capture, every cell is interpolated and shifted to its sub-channel
+  for (uint32_t c = 0; c < NOF_CELLS; c++) {
+    if (gen_cell(cell_pci[c], random, cell) < SRSRAN_SUCCESS) {
+      goto clean_exit;
+    }
+
+    // The first pass only fills the filter history, so the capture wraps around seamlessly
+    srsran_resampler_poly_reset_state(&interp);
+    srsran_resampler_poly_run(&interp, cell, NULL, cell_len);
+    uint32_t nof_upsampled = srsran_resampler_poly_run(&interp, cell, upsampled, cell_len);
+
+    for (uint32_t n = 0; n < SRSRAN_MIN(nof_upsampled, capture_len); n++) {
+      capture[n] += upsampled[n] * cexp(_Complex_I * 2.0 * M_PI * fmod(channel_hz[c] * (double)n / srate_hz, 1.0));
+    }
+  }
+
+  // The SNR is given relative to the power of one cell
+  if (srsran_channel_awgn_init(&awgn, 1234) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating AWGN");
+    goto clean_exit;
+  }
+  float cell_power = srsran_vec_avg_power_cf(capture, capture_len) / NOF_CELLS;
+  srsran_channel_awgn_set_n0(&awgn, srsran_convert_power_to_dB(cell_power) - snr_dB);
+  srsran_channel_awgn_run_c(&awgn, capture, capture, capture_len);
+
+  if (srsran_ue_cellsearch_wb_init(&cs_wb, srate_hz, capture_len, NOF_CHANNELS, 8, nof_threads) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating wideband cell search");
+    goto clean_exit;
+  }
+  srsran_ue_cellsearch_wb_set_nof_valid_frames(&cs_wb, 4);
+  if (srsran_ue_cellsearch_wb_set_channels(&cs_wb, channel_hz, NOF_CHANNELS) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  struct timeval t[3];
+  gettimeofday(&t[1], NULL);
+  int nof_detected = srsran_ue_cellsearch_wb_scan(&cs_wb, capture, capture_len, results);
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+
+  if (nof_detected < SRSRAN_SUCCESS) {
+    ERROR("Error scanning");
+    goto clean_exit;
+  }
+
+  printf("Scanned %d sub-channels with %d threads in %.1f ms\n",
+         NOF_CHANNELS,
+         nof_threads,
+         (double)t[0].tv_sec * 1e3 + (double)t[0].tv_usec / 1e3);
+
+  ret = SRSRAN_SUCCESS;
+  for (uint32_t i = 0; i < NOF_CHANNELS; i++) {
+    const srsran_ue_cellsearch_result_t* found = &results[i].found_cells[results[i].max_N_id_2];
+    printf("  %+.2f MHz: %d detected, strongest PCI=%d, PSR=%.1f, CFO=%.1f Hz\n",
+           results[i].freq_offset_hz / 1e6,
+           results[i].nof_detected,
+           found->cell_id,
+           found->psr,
+           found->cfo);
+
+    if (i < NOF_CELLS && (results[i].nof_detected == 0 || found->cell_id != cell_pci[i])) {
+      ERROR("Expected PCI=%d at %+.2f MHz", cell_pci[i], channel_hz[i] / 1e6);
+      ret = SRSRAN_ERROR;
+    }
+    if (i >= NOF_CELLS && results[i].nof_detected != 0) {
+      ERROR("Unexpected cell at %+.2f MHz", channel_hz[i] / 1e6);
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+clean_exit:
+  srsran_ue_cellsearch_wb_free(&cs_wb);
+  srsran_resampler_poly_free(&interp);
+  srsran_channel_awgn_free(&awgn);
+  srsran_random_free(random);
+  if (cell) {
+    free(cell);
+  }
+  if (upsampled) {
+    free(upsampled);
+  }
+  if (capture) {
+    free(capture);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Failed");
+  return ret;
+}
@@ -46,6 +46,8 @@ static float    n0_dB          = -10.0f;  // Noise floor in dB relative to full-
 static float    delay_min_us   = 10.0f;   // Minimum dynamic delay in microseconds
 static float    delay_max_us   = 1000.0f; // Maximum dynamic delay in microseconds
 static float    delay_period_s = 60.0f;   // Delay period in seconds
+static uint32_t outage_period  = 0;       // Period of the signal outages in subframes, set to 0 for none
+static uint32_t outage_len     = 10;      // Length of the signal outages in subframes
 
 // Test context
 static double   srate_hz = 0.0;  // Base-band sampling rate
@@ -55,15 +57,23 @@ static cf_t*    buffer2  = NULL; // Base-band buffer
 
 static void usage(char* prog)
 {
-  printf("Usage: %s [v]\n", prog);
+  printf("Usage: %s [Oov]\n", prog);
+  printf("\t-O outage period in subframes [Default %d, none]\n", outage_period);
+  printf("\t-o outage length in subframes [Default %d]\n", outage_len);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 static void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "v")) != -1) {
+  while ((opt = getopt(argc, argv, "Oov")) != -1) {
     switch (opt) {
+      case 'O':
+        outage_period = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'o':
+        outage_len = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -77,6 +87,7 @@ static void parse_args(int argc, char** argv)
 typedef struct {
   uint32_t               sf_idx;
   uint32_t               sfn;
+  uint32_t               sf_count;
   srsran_ringbuffer_t    ringbuffer;
   srsran_ssb_t           ssb;
   srsran_timestamp_t     timestamp;
@@ -92,6 +103,11 @@ static void run_channel(test_context_t* ctx)
   // CFO
   srsran_vec_apply_cfo(buffer2, -cfo_hz / srate_hz, buffer, sf_len);
 
+  // Outage, only noise is received
+  if (outage_period > 0 && (ctx->sf_count % outage_period) >= outage_period - outage_len) {
+    srsran_vec_cf_zero(buffer, sf_len);
+  }
+
   // AWGN
   srsran_channel_awgn_run_c(&ctx->awgn, buffer, buffer, sf_len);
 }
@@ -201,6 +217,7 @@ static int recv_callback(void* ptr, cf_t** rx_buffer, uint32_t nof_samples, srsr
 
     // Increment subframe index
     ctx->sf_idx++;
+    ctx->sf_count++;
 
     // Increment SFN if required
     if (ctx->sf_idx >= SRSRAN_NOF_SF_X_FRAME) {
@@ -227,6 +244,7 @@ static int recv_callback(void* ptr, cf_t** rx_buffer, uint32_t nof_samples, srsr
 
 static int test_case_1(srsran_ue_sync_nr_t* ue_sync)
 {
+  uint32_t nof_in_sync = 0;
   for (uint32_t sf_idx = 0; sf_idx < nof_sf; sf_idx++) {
     srsran_ue_sync_nr_outcome_t outcome = {};
 
@@ -245,8 +263,12 @@ static int test_case_1(srsran_ue_sync_nr_t* ue_sync)
          srsran_timestamp_real(&outcome.timestamp),
          outcome.cfo_hz,
          outcome.delay_us);
+
+    nof_in_sync += outcome.in_sync ? 1 : 0;
   }
 
+  printf("in-sync %d of %d subframes\n", nof_in_sync, nof_sf);
+
   return SRSRAN_SUCCESS;
 }
 
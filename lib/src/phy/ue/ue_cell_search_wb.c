@@ -0,0 +1,306 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srsran/phy/common/timestamp.h"
+#include "srsran/phy/ue/ue_cell_search_wb.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+
+/**
+ * Number of capture samples shifted to base-band at once, the oscillator phase is recomputed at every block so it
+ * does not drift over long captures
+ */
+#define CS_WB_BLOCK 4096
+
+// Feeds the cell search of a sub-channel, wrapping around the end of its buffer
+static int cs_wb_recv(void* h, cf_t* data[SRSRAN_MAX_CHANNELS], uint32_t nsamples, srsran_timestamp_t* rx_time)
+{
+  srsran_ue_cellsearch_wb_channel_t* ch = (srsran_ue_cellsearch_wb_channel_t*)h;
+
+  if (ch->nof_samples == 0) {
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t count = 0;
+  while (count < nsamples) {
+    uint32_t len = SRSRAN_MIN(nsamples - count, ch->nof_samples - ch->read_idx);
+    if (data[0] != NULL) {
+      srsran_vec_cf_copy(&data[0][count], &ch->buffer[ch->read_idx], len);
+    }
+    count += len;
+    ch->read_idx = (ch->read_idx + len) % ch->nof_samples;
+  }
+
+  if (rx_time != NULL) {
+    srsran_timestamp_init(rx_time, 0, (double)ch->read_idx / SRSRAN_CS_SAMP_FREQ);
+  }
+
+  return (int)nsamples;
+}
+
+int srsran_ue_cellsearch_wb_init(srsran_ue_cellsearch_wb_t* q,
+                                 double                     srate_hz,
+                                 uint32_t                   max_samples,
+                                 uint32_t                   max_channels,
+                                 uint32_t                   max_frames,
+                                 uint32_t                   nof_threads)
+{
+  if (q == NULL || srate_hz < SRSRAN_CS_SAMP_FREQ || max_samples == 0 || max_channels == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_ue_cellsearch_wb_t, 1);
+
+  if (pthread_mutex_init(&q->mutex, NULL)) {
+    ERROR("Error initiating mutex");
+    return SRSRAN_ERROR;
+  }
+
+  q->srate_hz     = srate_hz;
+  q->max_samples  = max_samples;
+  q->max_channels = max_channels;
+  q->nof_threads  = nof_threads;
+
+  q->channels = calloc(max_channels, sizeof(srsran_ue_cellsearch_wb_channel_t));
+  q->threads  = calloc(SRSRAN_MAX(nof_threads, 1), sizeof(pthread_t));
+  if (q->channels == NULL || q->threads == NULL) {
+    ERROR("Error allocating memory");
+    srsran_ue_cellsearch_wb_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t buffer_len = (uint32_t)ceil((double)max_samples * SRSRAN_CS_SAMP_FREQ / srate_hz) + 1;
+  for (uint32_t i = 0; i < max_channels; i++) {
+    srsran_ue_cellsearch_wb_channel_t* ch = &q->channels[i];
+
+    if (srsran_resampler_poly_init(&ch->resampler, (uint32_t)SRSRAN_CS_SAMP_FREQ, (uint32_t)round(srate_hz)) <
+        SRSRAN_SUCCESS) {
+      ERROR("Error initiating resampler from %.2f MHz", srate_hz / 1e6);
+      srsran_ue_cellsearch_wb_free(q);
+      return SRSRAN_ERROR;
+    }
+
+    ch->mix    = srsran_vec_cf_malloc(CS_WB_BLOCK);
+    ch->buffer = srsran_vec_cf_malloc(buffer_len);
+    if (ch->mix == NULL || ch->buffer == NULL) {
+      ERROR("Error allocating memory");
+      srsran_ue_cellsearch_wb_free(q);
+      return SRSRAN_ERROR;
+    }
+
+    // The cell search frees itself if its initialisation fails
+    if (srsran_ue_cellsearch_init_multi(&ch->cs, max_frames, cs_wb_recv, 1, ch) < SRSRAN_SUCCESS) {
+      ERROR("Error initiating cell search");
+      srsran_ue_cellsearch_wb_free(q);
+      return SRSRAN_ERROR;
+    }
+    ch->cs_initiated = true;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_ue_cellsearch_wb_free(srsran_ue_cellsearch_wb_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->channels != NULL) {
+    for (uint32_t i = 0; i < q->max_channels; i++) {
+      srsran_ue_cellsearch_wb_channel_t* ch = &q->channels[i];
+      srsran_resampler_poly_free(&ch->resampler);
+      if (ch->cs_initiated) {
+        srsran_ue_cellsearch_free(&ch->cs);
+      }
+      if (ch->mix) {
+        free(ch->mix);
+      }
+      if (ch->buffer) {
+        free(ch->buffer);
+      }
+    }
+    free(q->channels);
+  }
+
+  if (q->threads != NULL) {
+    free(q->threads);
+  }
+
+  pthread_mutex_destroy(&q->mutex);
+
+  SRSRAN_MEM_ZERO(q, srsran_ue_cellsearch_wb_t, 1);
+}
+
+int srsran_ue_cellsearch_wb_set_channels(srsran_ue_cellsearch_wb_t* q,
+                                         const float*               freq_offset_hz,
+                                         uint32_t                   nof_channels)
+{
+  if (q == NULL || freq_offset_hz == NULL || nof_channels > q->max_channels) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    if (fabs(freq_offset_hz[i]) + SRSRAN_CS_WB_CHANNEL_BW_HZ / 2 > q->srate_hz / 2) {
+      ERROR("Sub-channel at %+.3f MHz does not fit in a %.2f MHz capture", freq_offset_hz[i] / 1e6, q->srate_hz / 1e6);
+      return SRSRAN_ERROR;
+    }
+    q->channels[i].freq_offset_hz = freq_offset_hz[i];
+  }
+  q->nof_channels = nof_channels;
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_ue_cellsearch_wb_set_nof_valid_frames(srsran_ue_cellsearch_wb_t* q, uint32_t nof_frames)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  for (uint32_t i = 0; i < q->max_channels; i++) {
+    if (srsran_ue_cellsearch_set_nof_valid_frames(&q->channels[i].cs, nof_frames) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_ue_cellsearch_wb_set_detect_cp(srsran_ue_cellsearch_wb_t* q, bool enable)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < q->max_channels; i++) {
+    srsran_set_detect_cp(&q->channels[i].cs, enable);
+  }
+}
+
+// Shifts the sub-channel to base-band, decimates it and runs the cell search over it
+static int cs_wb_scan_channel(srsran_ue_cellsearch_wb_t* q, uint32_t idx)
+{
+  srsran_ue_cellsearch_wb_channel_t* ch  = &q->channels[idx];
+  srsran_ue_cellsearch_wb_result_t*  res = &q->results[idx];
+
+  srsran_resampler_poly_reset_state(&ch->resampler);
+  ch->nof_samples = 0;
+  ch->read_idx    = 0;
+
+  double freq = -ch->freq_offset_hz / q->srate_hz;
+  for (uint32_t n = 0; n < q->capture_len; n += CS_WB_BLOCK) {
+    uint32_t len   = SRSRAN_MIN(CS_WB_BLOCK, q->capture_len - n);
+    double   phase = fmod(freq * n, 1.0);
+
+    srsran_vec_apply_cfo(&q->capture[n], (float)freq, ch->mix, (int)len);
+    srsran_vec_sc_prod_ccc(ch->mix, cexpf(_Complex_I * 2.0f * (float)M_PI * (float)phase), ch->mix, len);
+    ch->nof_samples += srsran_resampler_poly_run(&ch->resampler, ch->mix, &ch->buffer[ch->nof_samples], len);
+  }
+
+  SRSRAN_MEM_ZERO(res, srsran_ue_cellsearch_wb_result_t, 1);
+  res->freq_offset_hz = ch->freq_offset_hz;
+
+  int ret = srsran_ue_cellsearch_scan(&ch->cs, res->found_cells, &res->max_N_id_2);
+  if (ret < SRSRAN_SUCCESS) {
+    ERROR("Error searching sub-channel at %+.3f MHz", ch->freq_offset_hz / 1e6);
+    return ret;
+  }
+  res->nof_detected = (uint32_t)ret;
+
+  INFO("CELL SEARCH WB: %+.3f MHz, detected %d cells, strongest PCI=%d",
+       ch->freq_offset_hz / 1e6,
+       ret,
+       res->found_cells[res->max_N_id_2].cell_id);
+
+  return ret;
+}
+
+// Takes sub-channels from the shared context until all of them are scanned or one fails
+static void* cs_wb_worker(void* arg)
+{
+  srsran_ue_cellsearch_wb_t* q = (srsran_ue_cellsearch_wb_t*)arg;
+
+  while (true) {
+    pthread_mutex_lock(&q->mutex);
+    uint32_t idx  = q->next_channel++;
+    bool     stop = idx >= q->nof_channels || q->ret < SRSRAN_SUCCESS;
+    pthread_mutex_unlock(&q->mutex);
+
+    if (stop) {
+      break;
+    }
+
+    int ret = cs_wb_scan_channel(q, idx);
+
+    pthread_mutex_lock(&q->mutex);
+    if (ret < SRSRAN_SUCCESS) {
+      q->ret = ret;
+    } else if (q->ret >= SRSRAN_SUCCESS) {
+      q->ret += ret;
+    }
+    pthread_mutex_unlock(&q->mutex);
+  }
+
+  return NULL;
+}
+
+int srsran_ue_cellsearch_wb_scan(srsran_ue_cellsearch_wb_t*       q,
+                                 const cf_t*                      capture,
+                                 uint32_t                         nof_samples,
+                                 srsran_ue_cellsearch_wb_result_t results[])
+{
+  if (q == NULL || capture == NULL || results == NULL || nof_samples == 0 || nof_samples > q->max_samples) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  q->capture      = capture;
+  q->capture_len  = nof_samples;
+  q->results      = results;
+  q->next_channel = 0;
+  q->ret          = SRSRAN_SUCCESS;
+
+  // The calling thread is one of the workers, the scan goes on with fewer workers if a thread cannot be created
+  uint32_t nof_created = 0;
+  for (uint32_t i = 1; i < SRSRAN_MIN(q->nof_threads, q->nof_channels); i++) {
+    if (pthread_create(&q->threads[nof_created], NULL, cs_wb_worker, q)) {
+      perror("pthread_create");
+      break;
+    }
+    nof_created++;
+  }
+
+  cs_wb_worker(q);
+
+  for (uint32_t i = 0; i < nof_created; i++) {
+    pthread_join(q->threads[i], NULL);
+  }
+
+  q->capture = NULL;
+  q->results = NULL;
+
+  return q->ret;
+}
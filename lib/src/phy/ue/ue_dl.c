@@ -260,6 +260,15 @@ void srsran_ue_dl_set_non_mbsfn_region(srsran_ue_dl_t* q, uint8_t non_mbsfn_regi
   srsran_ofdm_set_non_mbsfn_region(&q->fft_mbsfn, non_mbsfn_region_length);
 }
 
+void srsran_ue_dl_set_cfo(srsran_ue_dl_t* q, float cfo_hz)
+{
+  float cfo = cfo_hz / 15e3f;
+  for (uint32_t i = 0; i < q->nof_rx_antennas; i++) {
+    srsran_ofdm_set_cfo(&q->fft[i], cfo);
+  }
+  srsran_ofdm_set_cfo(&q->fft_mbsfn, cfo);
+}
+
 void srsran_ue_dl_set_mi_auto(srsran_ue_dl_t* q)
 {
   q->mi_auto = true;
@@ -745,9 +754,20 @@ int srsran_ue_dl_decode_phich(srsran_ue_dl_t*       q,
   }
 }
 
+/* Computes the channel covariance of the last channel estimate, it is shared by all the RI hypotheses */
+static int compute_cov(srsran_ue_dl_t* q, srsran_ue_dl_cfg_t* cfg, srsran_precoding_cov_t* cov)
+{
+  if (q->cell.nof_ports < 2) {
+    /* Do nothing */
+    return SRSRAN_SUCCESS;
+  }
+
+  return srsran_pdsch_compute_cov(&q->pdsch, &q->chest_res, cfg->pmi_decimation, cov);
+}
+
 /* Compute the Rank Indicator (RI) and Precoder Matrix Indicator (PMI) by computing the Signal to Interference plus
  * Noise Ratio (SINR), valid for TM4 */
-static int select_pmi(srsran_ue_dl_t* q, uint32_t ri, uint32_t* pmi, float* sinr_db)
+static int select_pmi(srsran_ue_dl_t* q, const srsran_precoding_cov_t* cov, uint32_t ri, uint32_t* pmi, float* sinr_db)
 {
   uint32_t best_pmi = 0;
   float    sinr_list[SRSRAN_MAX_CODEBOOKS];
@@ -756,7 +776,7 @@ static int select_pmi(srsran_ue_dl_t* q, uint32_t ri, uint32_t* pmi, float* sinr
     /* Do nothing */
     return SRSRAN_SUCCESS;
   } else {
-    if (srsran_pdsch_select_pmi(&q->pdsch, &q->chest_res, ri + 1, &best_pmi, sinr_list)) {
+    if (srsran_pdsch_select_pmi(&q->pdsch, &q->chest_res, cov, ri + 1, &best_pmi, sinr_list)) {
       DEBUG("SINR calculation error");
       return SRSRAN_ERROR;
     }
@@ -775,7 +795,8 @@ static int select_pmi(srsran_ue_dl_t* q, uint32_t ri, uint32_t* pmi, float* sinr
   return SRSRAN_SUCCESS;
 }
 
-static int select_ri_pmi(srsran_ue_dl_t* q, uint32_t* ri, uint32_t* pmi, float* sinr_db)
+static int
+select_ri_pmi(srsran_ue_dl_t* q, const srsran_precoding_cov_t* cov, uint32_t* ri, uint32_t* pmi, float* sinr_db)
 {
   float    best_sinr_db = -INFINITY;
   uint32_t best_pmi = 0, best_ri = 0;
@@ -789,7 +810,7 @@ static int select_ri_pmi(srsran_ue_dl_t* q, uint32_t* ri, uint32_t* pmi, float*
     for (uint32_t this_ri = 0; this_ri < max_ri; this_ri++) {
       uint32_t this_pmi     = 0;
       float    this_sinr_db = 0.0f;
-      if (select_pmi(q, this_ri, &this_pmi, &this_sinr_db)) {
+      if (select_pmi(q, cov, this_ri, &this_pmi, &this_sinr_db)) {
         DEBUG("SINR calculation error");
         return SRSRAN_ERROR;
       }
@@ -854,7 +875,10 @@ void srsran_ue_dl_gen_cqi_periodic(srsran_ue_dl_t*     q,
       if (cfg->cfg.tm == SRSRAN_TM3) {
         srsran_ue_dl_select_ri(q, &cfg->last_ri, NULL);
       } else if (cfg->cfg.tm == SRSRAN_TM4) {
-        select_ri_pmi(q, &cfg->last_ri, NULL, NULL);
+        srsran_precoding_cov_t cov = {};
+        if (compute_cov(q, cfg, &cov) == SRSRAN_SUCCESS) {
+          select_ri_pmi(q, &cov, &cfg->last_ri, NULL, NULL);
+        }
       }
     } else {
       cfg->last_ri = 0;
@@ -874,8 +898,11 @@ void srsran_ue_dl_gen_cqi_periodic(srsran_ue_dl_t*     q,
       uci_data->cfg.cqi.type                    = SRSRAN_CQI_TYPE_WIDEBAND;
       uci_data->value.cqi.wideband.wideband_cqi = wideband_value;
       if (cfg->cfg.tm == SRSRAN_TM4) {
-        uint32_t pmi = 0;
-        select_pmi(q, cfg->last_ri, &pmi, NULL);
+        uint32_t               pmi = 0;
+        srsran_precoding_cov_t cov = {};
+        if (compute_cov(q, cfg, &cov) == SRSRAN_SUCCESS) {
+          select_pmi(q, &cov, cfg->last_ri, &pmi, NULL);
+        }
 
         uci_data->cfg.cqi.pmi_present     = true;
         uci_data->cfg.cqi.rank_is_not_one = (cfg->last_ri != 0);
@@ -893,8 +920,9 @@ void srsran_ue_dl_gen_cqi_aperiodic(srsran_ue_dl_t*     q,
                                     uint32_t            wideband_value,
                                     srsran_uci_data_t*  uci_data)
 {
-  uint32_t pmi     = 0;
-  float    sinr_db = 0.0f;
+  uint32_t               pmi     = 0;
+  float                  sinr_db = 0.0f;
+  srsran_precoding_cov_t cov     = {};
 
   switch (cfg->cfg.cqi_report.aperiodic_mode) {
     case SRSRAN_CQI_MODE_30:
@@ -945,7 +973,9 @@ void srsran_ue_dl_gen_cqi_aperiodic(srsran_ue_dl_t*     q,
       /* Loads the latest SINR according to the calculated RI and PMI */
       pmi     = 0;
       sinr_db = 0.0f;
-      select_ri_pmi(q, &cfg->last_ri, &pmi, &sinr_db);
+      if (compute_cov(q, cfg, &cov) == SRSRAN_SUCCESS) {
+        select_ri_pmi(q, &cov, &cfg->last_ri, &pmi, &sinr_db);
+      }
 
       /* Fill CQI Report */
       uci_data->cfg.cqi.type = SRSRAN_CQI_TYPE_SUBBAND_HL;
@@ -732,6 +732,7 @@ int srsran_nbiot_ue_dl_decode_npdsch(srsran_nbiot_ue_dl_t* q,
 
 /** Handles subframe reception of a NPDSCH which doesn't carry the BCCH
  *  - In this NPDSCH config, up to four repetitons are transmitted one after another
+ *  - The repetitions are combined at symbol level before demodulation
  */
 int srsran_nbiot_ue_dl_decode_npdsch_no_bcch(srsran_nbiot_ue_dl_t* q, uint8_t* data, uint32_t tti, uint16_t rnti)
 {
@@ -752,43 +753,28 @@ int srsran_nbiot_ue_dl_decode_npdsch_no_bcch(srsran_nbiot_ue_dl_t* q, uint8_t* d
        q->npdsch_cfg.num_sf + 1,
        q->npdsch_cfg.grant.nof_sf * q->npdsch_cfg.grant.nof_rep);
 
-  if (q->npdsch_cfg.num_sf % q->npdsch_cfg.grant.nof_rep == 0) {
+  cf_t* sf_buffer = &q->sf_buffer[q->npdsch_cfg.sf_idx * q->nof_re];
+  if (q->npdsch_cfg.rep_idx == 0) {
     // copy data and ce symbols for first repetition of each subframe
-    srsran_vec_cf_copy(&q->sf_buffer[q->npdsch_cfg.sf_idx * q->nof_re], q->sf_symbols, q->nof_re);
+    srsran_vec_cf_copy(sf_buffer, q->sf_symbols, q->nof_re);
     for (int i = 0; i < q->cell.nof_ports; i++) {
       srsran_vec_cf_copy(&q->ce_buffer[i][q->npdsch_cfg.sf_idx * q->nof_re], q->ce[i], q->nof_re);
     }
   } else {
-    // accumulate subframe samples and channel estimates
-    srsran_vec_sum_ccc(&q->sf_buffer[q->npdsch_cfg.sf_idx * q->nof_re],
-                       q->sf_symbols,
-                       &q->sf_buffer[q->npdsch_cfg.sf_idx * q->nof_re],
-                       q->nof_re);
+    // accumulate subframe samples and channel estimates of all repetitions
+    srsran_vec_sum_ccc(sf_buffer, q->sf_symbols, sf_buffer, q->nof_re);
     for (int i = 0; i < q->cell.nof_ports; i++) {
-      srsran_vec_sum_ccc(&q->ce_buffer[i][q->npdsch_cfg.sf_idx * q->nof_re],
-                         q->ce[i],
-                         &q->ce_buffer[i][q->npdsch_cfg.sf_idx * q->nof_re],
-                         q->nof_re);
+      cf_t* ce_buffer = &q->ce_buffer[i][q->npdsch_cfg.sf_idx * q->nof_re];
+      srsran_vec_sum_ccc(ce_buffer, q->ce[i], ce_buffer, q->nof_re);
     }
   }
   q->npdsch_cfg.num_sf++;
   // srsran_nbiot_ue_dl_save_signal(q, input, sfn, sf_idx);
 
+  // subframes are repeated in blocks of up to four repetitions before moving to the next subframe
   q->npdsch_cfg.rep_idx++;
   int m = SRSRAN_MIN(q->npdsch_cfg.grant.nof_rep, 4);
   if (q->npdsch_cfg.rep_idx % m == 0) {
-    // average accumulated samples
-    srsran_vec_sc_prod_ccc(&q->sf_buffer[q->npdsch_cfg.sf_idx * q->nof_re],
-                           1.0 / m,
-                           &q->sf_buffer[q->npdsch_cfg.sf_idx * q->nof_re],
-                           q->nof_re);
-    for (int i = 0; i < q->cell.nof_ports; i++) {
-      srsran_vec_sc_prod_ccc(&q->ce_buffer[i][q->npdsch_cfg.sf_idx * q->nof_re],
-                             1.0 / m,
-                             &q->ce_buffer[i][q->npdsch_cfg.sf_idx * q->nof_re],
-                             q->nof_re);
-    }
-
     q->npdsch_cfg.sf_idx++;
     if (q->npdsch_cfg.sf_idx == q->npdsch_cfg.grant.nof_sf) {
       q->npdsch_cfg.sf_idx = 0;
@@ -797,34 +783,61 @@ int srsran_nbiot_ue_dl_decode_npdsch_no_bcch(srsran_nbiot_ue_dl_t* q, uint8_t* d
     }
   }
 
-  if (q->npdsch_cfg.num_sf == q->npdsch_cfg.grant.nof_sf * q->npdsch_cfg.grant.nof_rep) {
-    // try to decode NPDSCH
-    INFO("%d.%d: Trying to decode NPDSCH with %d subframe(s).", tti / 10, tti % 10, q->npdsch_cfg.grant.nof_sf);
-    if (srsran_nbiot_ue_dl_decode_rnti_packet(q,
-                                              &q->npdsch_cfg.grant,
-                                              data,
-                                              tti / 10,
-                                              tti % 10,
-                                              rnti,
-                                              q->sf_buffer,
-                                              q->ce_buffer,
-                                              q->npdsch_cfg.rep_idx) != SRSRAN_SUCCESS) {
-      // decoding failed
-      INFO("%d.%d: Error decoding NPDSCH with %d repetitions.", tti / 10, tti % 10, q->npdsch_cfg.rep_idx);
-      q->pkt_errors++;
-      q->has_dl_grant = false;
-      ret             = SRSRAN_ERROR;
-    } else {
-      srsran_nbiot_ue_dl_tb_decoded(q, data);
-      ret = SRSRAN_SUCCESS;
+  uint32_t total_sf = q->npdsch_cfg.grant.nof_sf * q->npdsch_cfg.grant.nof_rep;
+  uint32_t nof_rep  = q->npdsch_cfg.rep_idx;
+  if (q->npdsch_cfg.sf_idx == 0 && nof_rep % m == 0) {
+    // All subframes hold the same number of combined repetitions. Try to decode the average of the repetitions at the
+    // end of the transmission and, to leave the transmission early once the CRC passes, whenever the number of combined
+    // repetitions doubles.
+    bool last = q->npdsch_cfg.num_sf == total_sf;
+    if (last || (nof_rep & (nof_rep - 1)) == 0) {
+      uint32_t nof_samples = q->npdsch_cfg.grant.nof_sf * q->nof_re;
+      if (nof_rep > 1) {
+        srsran_vec_sc_prod_cfc(q->sf_buffer, 1.0f / nof_rep, q->sf_buffer, nof_samples);
+        for (int i = 0; i < q->cell.nof_ports; i++) {
+          srsran_vec_sc_prod_cfc(q->ce_buffer[i], 1.0f / nof_rep, q->ce_buffer[i], nof_samples);
+        }
+      }
+
+      INFO("%d.%d: Trying to decode NPDSCH with %d subframe(s) after %d repetitions.",
+           tti / 10,
+           tti % 10,
+           q->npdsch_cfg.grant.nof_sf,
+           nof_rep);
+      if (srsran_nbiot_ue_dl_decode_rnti_packet(q,
+                                                &q->npdsch_cfg.grant,
+                                                data,
+                                                tti / 10,
+                                                tti % 10,
+                                                rnti,
+                                                q->sf_buffer,
+                                                q->ce_buffer,
+                                                nof_rep) == SRSRAN_SUCCESS) {
+        // the remaining repetitions are skipped, as the grant is de-activated
+        srsran_nbiot_ue_dl_tb_decoded(q, data);
+        return SRSRAN_SUCCESS;
+      }
+
+      if (last) {
+        // decoding failed
+        INFO("%d.%d: Error decoding NPDSCH with %d repetitions.", tti / 10, tti % 10, nof_rep);
+        q->pkt_errors++;
+        q->has_dl_grant = false;
+        return SRSRAN_ERROR;
+      }
+
+      // restore the accumulated sums for the next repetitions
+      if (nof_rep > 1) {
+        srsran_vec_sc_prod_cfc(q->sf_buffer, (float)nof_rep, q->sf_buffer, nof_samples);
+        for (int i = 0; i < q->cell.nof_ports; i++) {
+          srsran_vec_sc_prod_cfc(q->ce_buffer[i], (float)nof_rep, q->ce_buffer[i], nof_samples);
+        }
+      }
     }
-  } else {
-    DEBUG("%d.%d: Waiting for %d more subframes.",
-          tti / 10,
-          tti % 10,
-          q->npdsch_cfg.grant.nof_sf * q->npdsch_cfg.grant.nof_rep - q->npdsch_cfg.num_sf);
-    ret = SRSRAN_NBIOT_EXPECT_MORE_SF;
   }
+
+  DEBUG("%d.%d: Waiting for %d more subframes.", tti / 10, tti % 10, total_sf - q->npdsch_cfg.num_sf);
+  ret = SRSRAN_NBIOT_EXPECT_MORE_SF;
   return ret;
 }
 
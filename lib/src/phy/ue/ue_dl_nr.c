@@ -234,6 +234,9 @@ void srsran_ue_dl_nr_estimate_fft(srsran_ue_dl_nr_t* q, const srsran_slot_cfg_t*
       srsran_dmrs_pdcch_estimate(&q->dmrs_pdcch[i], slot_cfg, q->sf_symbols[0]);
     }
   }
+
+  // The candidates demodulated for a search space are reused by the rest of DCI sizes and search spaces of the slot
+  srsran_pdcch_nr_cache_reset(&q->pdcch);
 }
 
 static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
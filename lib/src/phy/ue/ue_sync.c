@@ -37,6 +37,8 @@
 
 #define TRACK_MAX_LOST 10
 #define TRACK_FRAME_SIZE 32
+#define TRACK_STABLE_OFFSET 2
+#define TRACK_STABLE_NOF_PEAKS 10
 #define FIND_NOF_AVG_FRAMES 4
 
 #define PSS_OFFSET                                                                                                     \
@@ -136,6 +138,8 @@ void srsran_ue_sync_reset(srsran_ue_sync_t* q)
   q->frame_ok_cnt          = 0;
   q->frame_no_cnt          = 0;
   q->frame_total_cnt       = 0;
+  q->track_stable_cnt      = 0;
+  q->track_skip_cnt        = 0;
   q->mean_sample_offset    = 0.0;
   q->next_rf_sample_offset = 0;
   q->frame_find_cnt        = 0;
@@ -559,6 +563,11 @@ void srsran_ue_sync_set_N_id_2(srsran_ue_sync_t* q, uint32_t N_id_2)
   }
 }
 
+void srsran_ue_sync_set_track_period(srsran_ue_sync_t* q, uint32_t nof_pss)
+{
+  q->track_period = nof_pss;
+}
+
 void srsran_ue_sync_set_agc_period(srsran_ue_sync_t* q, uint32_t period)
 {
   q->agc_period = period;
@@ -601,6 +610,8 @@ static int find_peak_ok(srsran_ue_sync_t* q, cf_t* input_buffer[SRSRAN_MAX_CHANN
     q->frame_no_cnt       = 0;
     q->frame_total_cnt    = 0;
     q->frame_find_cnt     = 0;
+    q->track_stable_cnt   = 0;
+    q->track_skip_cnt     = 0;
     q->mean_sample_offset = 0;
 
     /* Goto Tracking state if cell ID is known already */
@@ -653,6 +664,13 @@ static int track_peak_ok(srsran_ue_sync_t* q, uint32_t track_idx)
     }
   }
 
+  // The timing is stable while the PSS CFO is and the peak stays around its expected position
+  if (q->pss_is_stable && abs(q->last_sample_offset) <= TRACK_STABLE_OFFSET) {
+    q->track_stable_cnt++;
+  } else {
+    q->track_stable_cnt = 0;
+  }
+
   // Compute cumulative moving average time offset */
   if (!frame_idx) {
     // Adjust RF sampling time based on the mean sampling offset
@@ -691,6 +709,7 @@ static int track_peak_no(srsran_ue_sync_t* q)
 {
   /* if we missed too many PSS go back to FIND and consider this frame unsynchronized */
   q->frame_no_cnt++;
+  q->track_stable_cnt = 0;
   if (q->frame_no_cnt >= TRACK_MAX_LOST) {
     INFO("%d frames lost. Going back to FIND", (int)q->frame_no_cnt);
     q->state = SF_FIND;
@@ -880,6 +899,16 @@ int srsran_ue_sync_run_track_pss_mode(srsran_ue_sync_t* q, cf_t* input_buffer[SR
       srsran_agc_process(&q->agc, input_buffer[0], q->sf_len);
     }
 
+    /* Once the timing is stable, track one PSS every track_period occasions only. The time offset accumulated in
+     * between stays within the cyclic prefix and the channel estimator can compensate it (correct_sync_error)
+     */
+    if (q->track_period > 1 && q->track_stable_cnt >= TRACK_STABLE_NOF_PEAKS && ++q->track_skip_cnt < q->track_period) {
+      q->frame_total_cnt++;
+      INFO("SYNC TRACK: sf_idx=%d, tracking skipped (%d/%d)", q->sf_idx, q->track_skip_cnt, q->track_period);
+      return 1;
+    }
+    q->track_skip_cnt = 0;
+
     /* Track PSS around the expected PSS position
      * In tracking phase, the subframe carrying the PSS is always the last one of the frame
      */
@@ -24,6 +24,16 @@
 
 #define UE_SYNC_NR_DEFAULT_CFO_ALPHA 0.1
 
+/**
+ * Number of SSB opportunities searched around the last known timing before going back to the full subframe search
+ */
+#define UE_SYNC_NR_FIND_WINDOW_NOF_OPPORTUNITIES 4
+
+/**
+ * Maximum timing error in microseconds covered by the search around the last known timing
+ */
+#define UE_SYNC_NR_FIND_WINDOW_US 5.0
+
 int srsran_ue_sync_nr_init(srsran_ue_sync_nr_t* q, const srsran_ue_sync_nr_args_t* args)
 {
   // Check inputs
@@ -96,8 +106,9 @@ int srsran_ue_sync_nr_set_cfg(srsran_ue_sync_nr_t* q, const srsran_ue_sync_nr_cf
     return SRSRAN_ERROR;
   }
 
-  // Transition to find
-  q->state = SRSRAN_UE_SYNC_NR_STATE_FIND;
+  // Transition to find, the timing is unknown
+  q->state           = SRSRAN_UE_SYNC_NR_STATE_FIND;
+  q->find_window_cnt = 0;
 
   return SRSRAN_SUCCESS;
 }
@@ -152,6 +163,9 @@ static int ue_sync_nr_update_ssb(srsran_ue_sync_nr_t*                 q,
   q->sf_idx  = srsran_ssb_candidate_sf_idx(&q->ssb, pbch_msg->ssb_idx, pbch_msg->hrf);
   q->sfn     = mib.sfn;
 
+  // The timing is known, if it is lost the search starts around it
+  q->find_window_cnt = UE_SYNC_NR_FIND_WINDOW_NOF_OPPORTUNITIES;
+
   // Transition to track only if the measured delay is below 2.4 microseconds
   if (measurements->delay_us < 2.4f) {
     q->state = SRSRAN_UE_SYNC_NR_STATE_TRACK;
@@ -160,15 +174,47 @@ static int ue_sync_nr_update_ssb(srsran_ue_sync_nr_t*                 q,
   return SRSRAN_SUCCESS;
 }
 
+// Checks if the SSB selected candidate index shall be received in the current subframe
+static bool ue_sync_nr_is_ssb_opportunity(const srsran_ue_sync_nr_t* q, uint32_t* half_frame)
+{
+  *half_frame = q->sf_idx / (SRSRAN_NOF_SF_X_FRAME / 2);
+
+  bool is_ssb_opportunity = (q->sf_idx == srsran_ssb_candidate_sf_idx(&q->ssb, q->ssb_idx, *half_frame > 0));
+
+  // Use SSB periodicity
+  if (q->ssb.cfg.periodicity_ms >= 10) {
+    // SFN match with the periodicity
+    is_ssb_opportunity = is_ssb_opportunity && (*half_frame == 0) && (q->sfn % q->ssb.cfg.periodicity_ms / 10 == 0);
+  }
+
+  return is_ssb_opportunity;
+}
+
 static int ue_sync_nr_run_find(srsran_ue_sync_nr_t* q, cf_t* buffer)
 {
   srsran_csi_trs_measurements_t measurements = {};
   srsran_pbch_msg_nr_t          pbch_msg     = {};
 
-  // Find SSB, measure PSS/SSS and decode PBCH
-  if (srsran_ssb_find(&q->ssb, buffer, q->N_id, &measurements, &pbch_msg) < SRSRAN_SUCCESS) {
-    ERROR("Error finding SSB");
-    return SRSRAN_ERROR;
+  if (q->find_window_cnt > 0) {
+    // The last SSB timing is known, search only its opportunities around the expected position
+    uint32_t half_frame = 0;
+    if (!ue_sync_nr_is_ssb_opportunity(q, &half_frame)) {
+      return SRSRAN_SUCCESS;
+    }
+    q->find_window_cnt--;
+
+    uint32_t max_delay = (uint32_t)round(UE_SYNC_NR_FIND_WINDOW_US * 1e-6 * q->srate_hz);
+    if (srsran_ssb_find_window(&q->ssb, buffer, q->N_id, q->ssb_idx, max_delay, &measurements, &pbch_msg) <
+        SRSRAN_SUCCESS) {
+      ERROR("Error finding SSB");
+      return SRSRAN_ERROR;
+    }
+  } else {
+    // Find SSB, measure PSS/SSS and decode PBCH
+    if (srsran_ssb_find(&q->ssb, buffer, q->N_id, &measurements, &pbch_msg) < SRSRAN_SUCCESS) {
+      ERROR("Error finding SSB");
+      return SRSRAN_ERROR;
+    }
   }
 
   // If the PBCH message was NOT decoded, early return
@@ -183,18 +229,10 @@ static int ue_sync_nr_run_track(srsran_ue_sync_nr_t* q, cf_t* buffer)
 {
   srsran_csi_trs_measurements_t measurements = {};
   srsran_pbch_msg_nr_t          pbch_msg     = {};
-  uint32_t                      half_frame   = q->sf_idx / (SRSRAN_NOF_SF_X_FRAME / 2);
+  uint32_t                      half_frame   = 0;
 
   // Check if the SSB selected candidate index shall be received in this subframe
-  bool is_ssb_opportunity = (q->sf_idx == srsran_ssb_candidate_sf_idx(&q->ssb, q->ssb_idx, half_frame > 0));
-
-  // Use SSB periodicity
-  if (q->ssb.cfg.periodicity_ms >= 10) {
-    // SFN match with the periodicity
-    is_ssb_opportunity = is_ssb_opportunity && (half_frame == 0) && (q->sfn % q->ssb.cfg.periodicity_ms / 10 == 0);
-  }
-
-  if (!is_ssb_opportunity) {
+  if (!ue_sync_nr_is_ssb_opportunity(q, &half_frame)) {
     return SRSRAN_SUCCESS;
   }
 
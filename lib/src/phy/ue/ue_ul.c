@@ -160,6 +160,7 @@ int srsran_ue_ul_set_cell(srsran_ue_ul_t* q, srsran_cell_t cell)
         ERROR("Error resizing srsran_refsignal_ul");
         return SRSRAN_ERROR;
       }
+      srsran_refsignal_dmrs_pucch_cache_reset(&q->pucch_dmrs_cache);
 
       if (srsran_ra_ul_pusch_hopping_init(&q->hopping, q->cell)) {
         ERROR("Error setting hopping procedure cell");
@@ -534,11 +535,13 @@ pucch_encode(srsran_ue_ul_t* q, srsran_ul_sf_cfg_t* sf, srsran_ue_ul_cfg_t* cfg,
       return ret;
     }
 
-    if (srsran_refsignal_dmrs_pucch_gen(&q->signals, sf, &cfg->ul_cfg.pucch, q->refsignal)) {
+    // The DMRS of the PUCCH resource are reused from the previous frames
+    cf_t* r_pucch = srsran_refsignal_dmrs_pucch_cache_get(&q->signals, &q->pucch_dmrs_cache, sf, &cfg->ul_cfg.pucch);
+    if (r_pucch == NULL) {
       ERROR("Error generating PUSCH DMRS signals");
       return ret;
     }
-    srsran_refsignal_dmrs_pucch_put(&q->signals, &cfg->ul_cfg.pucch, q->refsignal, q->sf_symbols);
+    srsran_refsignal_dmrs_pucch_put(&q->signals, &cfg->ul_cfg.pucch, r_pucch, q->sf_symbols);
 
     add_srs(q, cfg, sf->tti);
 
@@ -32,9 +32,22 @@
 
 #endif /* LV_HAVE_SSE */
 
+#ifdef HAVE_NEON
+#include <arm_neon.h>
+#endif /* HAVE_NEON */
+
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/vector.h"
 
+// A byte repeated in the 8 bytes of a 64-bit word
+#define BIT_REP8 0x0101010101010101LL
+
+// The bit masks 0x80, 0x40, ..., 0x01 in memory order
+#define BIT_MASK8 0x0102040810204080LL
+
+// Reverses the order of the bytes in each half of a 128-bit register
+#define BIT_REV8_SSE _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8)
+
 void srsran_bit_interleaver_init(srsran_bit_interleaver_t* q, uint16_t* interleaver, uint32_t nof_bits)
 {
   static const uint8_t mask[] = {0x80, 0x40, 0x20, 0x10, 0x8, 0x4, 0x2, 0x1};
@@ -699,9 +712,55 @@ void srsran_bit_copy(uint8_t* dst, uint32_t dst_offset, uint8_t* src, uint32_t s
 
 void srsran_bit_unpack_vector(const uint8_t* packed, uint8_t* unpacked, int nof_bits)
 {
-  uint32_t i, nbytes;
+  uint32_t i = 0, nbytes;
   nbytes = nof_bits / 8;
-  for (i = 0; i < nbytes; i++) {
+
+  // Each packed byte is broadcast into 8 lanes, which keep the bit selected by 0x80, 0x40, ..., 0x01
+#ifdef LV_HAVE_AVX512
+  const __m512i idx512 =
+      _mm512_set_epi64(7 * BIT_REP8, 6 * BIT_REP8, 5 * BIT_REP8, 4 * BIT_REP8, 3 * BIT_REP8, 2 * BIT_REP8, BIT_REP8, 0);
+  const __m512i mask512 = _mm512_set1_epi64(BIT_MASK8);
+  for (; i + 8 <= nbytes; i += 8) {
+    uint64_t word;
+    memcpy(&word, &packed[i], sizeof(word));
+    __mmask64 bits = _mm512_test_epi8_mask(_mm512_shuffle_epi8(_mm512_set1_epi64(word), idx512), mask512);
+    _mm512_storeu_si512(unpacked, _mm512_maskz_mov_epi8(bits, _mm512_set1_epi8(1)));
+    unpacked += 64;
+  }
+#endif /* LV_HAVE_AVX512 */
+
+#ifdef LV_HAVE_AVX2
+  const __m256i idx256  = _mm256_set_epi64x(3 * BIT_REP8, 2 * BIT_REP8, BIT_REP8, 0);
+  const __m256i mask256 = _mm256_set1_epi64x(BIT_MASK8);
+  for (; i + 4 <= nbytes; i += 4) {
+    uint32_t word;
+    memcpy(&word, &packed[i], sizeof(word));
+    __m256i bits = _mm256_and_si256(_mm256_shuffle_epi8(_mm256_set1_epi32(word), idx256), mask256);
+    _mm256_storeu_si256((__m256i*)unpacked, _mm256_min_epu8(bits, _mm256_set1_epi8(1)));
+    unpacked += 32;
+  }
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_SSE
+  const __m128i idx128  = _mm_set_epi64x(BIT_REP8, 0);
+  const __m128i mask128 = _mm_set1_epi64x(BIT_MASK8);
+  for (; i + 2 <= nbytes; i += 2) {
+    uint16_t word;
+    memcpy(&word, &packed[i], sizeof(word));
+    __m128i bits = _mm_and_si128(_mm_shuffle_epi8(_mm_set1_epi16(word), idx128), mask128);
+    _mm_storeu_si128((__m128i*)unpacked, _mm_min_epu8(bits, _mm_set1_epi8(1)));
+    unpacked += 16;
+  }
+#elif defined(HAVE_NEON)
+  const uint8x16_t mask128 = vreinterpretq_u8_u64(vdupq_n_u64(BIT_MASK8));
+  for (; i + 2 <= nbytes; i += 2) {
+    uint8x16_t bits = vcombine_u8(vdup_n_u8(packed[i]), vdup_n_u8(packed[i + 1]));
+    vst1q_u8(unpacked, vandq_u8(vtstq_u8(bits, mask128), vdupq_n_u8(1)));
+    unpacked += 16;
+  }
+#endif /* LV_HAVE_SSE */
+
+  for (; i < nbytes; i++) {
     srsran_bit_unpack(packed[i], &unpacked, 8);
   }
   if (nof_bits % 8) {
@@ -754,11 +813,32 @@ void srsran_bit_unpack_lsb(uint32_t value, uint8_t** bits, int nof_bits)
 
 void srsran_bit_pack_vector(uint8_t* unpacked, uint8_t* packed, int nof_bits)
 {
-  uint32_t i, nbytes;
+  uint32_t i = 0, nbytes;
   nbytes = nof_bits / 8;
 
+  // Each group of 8 bits is reversed, so the first one ends up in the MSB of the movemask byte
+#ifdef LV_HAVE_AVX512
+  const __m512i rev512 = _mm512_broadcast_i32x4(BIT_REV8_SSE);
+  for (; i + 8 <= nbytes; i += 8) {
+    __m512i  bits = _mm512_shuffle_epi8(_mm512_loadu_si512(unpacked), rev512);
+    uint64_t word = (uint64_t)_mm512_cmpgt_epi8_mask(bits, _mm512_setzero_si512());
+    memcpy(&packed[i], &word, sizeof(word));
+    unpacked += 64;
+  }
+#endif /* LV_HAVE_AVX512 */
+
+#ifdef LV_HAVE_AVX2
+  const __m256i rev256 = _mm256_broadcastsi128_si256(BIT_REV8_SSE);
+  for (; i + 4 <= nbytes; i += 4) {
+    __m256i  bits = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i*)unpacked), rev256);
+    uint32_t word = (uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(bits, _mm256_setzero_si256()));
+    memcpy(&packed[i], &word, sizeof(word));
+    unpacked += 32;
+  }
+#endif /* LV_HAVE_AVX2 */
+
 #ifdef LV_HAVE_SSE
-  for (i = 0; i < nbytes; i++) {
+  for (; i < nbytes; i++) {
     // Get 8 Bit
     __m64 mask = _mm_cmpgt_pi8(*((__m64*)unpacked), _mm_set1_pi8(0));
     unpacked += 8;
@@ -769,8 +849,20 @@ void srsran_bit_pack_vector(uint8_t* unpacked, uint8_t* packed, int nof_bits)
     // Get mask and write
     packed[i] = (uint8_t)_mm_movemask_pi8(mask);
   }
-#else  /* LV_HAVE_SSE */
-  for (i = 0; i < nbytes; i++) {
+#else /* LV_HAVE_SSE */
+#ifdef HAVE_NEON
+  const uint8x16_t weights = vreinterpretq_u8_u64(vdupq_n_u64(BIT_MASK8));
+  for (; i + 2 <= nbytes; i += 2) {
+    uint8x16_t bits = vandq_u8(vcgtq_u8(vld1q_u8(unpacked), vdupq_n_u8(0)), weights);
+    uint8x8_t  sum  = vpadd_u8(vget_low_u8(bits), vget_high_u8(bits));
+    sum             = vpadd_u8(sum, sum);
+    sum             = vpadd_u8(sum, sum);
+    packed[i]       = vget_lane_u8(sum, 0);
+    packed[i + 1]   = vget_lane_u8(sum, 1);
+    unpacked += 16;
+  }
+#endif /* HAVE_NEON */
+  for (; i < nbytes; i++) {
     packed[i] = srsran_bit_pack(&unpacked, 8);
   }
 #endif /* LV_HAVE_SSE */
@@ -25,6 +25,7 @@
 #include "srsran/phy/dft/dft.h"
 #include "srsran/phy/utils/convolution.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 
 int srsran_conv_fft_cc_init(srsran_conv_fft_cc_t* q, uint32_t input_len, uint32_t filter_len)
@@ -176,6 +177,34 @@ uint32_t srsran_conv_same_cc(cf_t* input, cf_t* filter, cf_t* output, uint32_t i
   return N;
 }
 
+/* Computes the outputs start to end-1 of a real filter of length M whose window fits in the input. The outputs run
+ * along the SIMD lanes and the taps are broadcast. In-place filtering keeps the sample by sample order, as every output
+ * reads the previous already filtered one. Returns the index after the last computed output. */
+static uint32_t
+conv_same_cf_center(const cf_t* input, const float* filter, cf_t* output, uint32_t start, uint32_t end, uint32_t M)
+{
+  uint32_t i = start;
+
+#if SRSRAN_SIMD_CF_SIZE
+  if (input != output) {
+    for (; i + SRSRAN_SIMD_CF_SIZE <= end; i += SRSRAN_SIMD_CF_SIZE) {
+      const cf_t* x   = &input[i - M / 2];
+      simd_cf_t   acc = srsran_simd_cf_mul(srsran_simd_cfi_loadu(x), srsran_simd_f_set1(filter[0]));
+      for (uint32_t k = 1; k < M; k++) {
+        acc = srsran_simd_cf_add(acc, srsran_simd_cf_mul(srsran_simd_cfi_loadu(&x[k]), srsran_simd_f_set1(filter[k])));
+      }
+      srsran_simd_cfi_storeu(&output[i], acc);
+    }
+  }
+#endif
+
+  for (; i < end; i++) {
+    output[i] = srsran_vec_dot_prod_cfc(&input[i - M / 2], filter, M);
+  }
+
+  return i;
+}
+
 #define conv_same_extrapolates_extremes
 
 #ifdef conv_same_extrapolates_extremes
@@ -207,9 +236,8 @@ uint32_t srsran_conv_same_cf(cf_t* input, float* filter, cf_t* output, uint32_t
     output[i] = srsran_vec_dot_prod_cfc(&first[i], filter, M);
   }
 
-  for (; i < N - M / 2; i++) {
-    output[i] = srsran_vec_dot_prod_cfc(&input[i - M / 2], filter, M);
-  }
+  i = conv_same_cf_center(input, filter, output, i, N - M / 2, M);
+
   int j = 0;
   for (; i < N; i++) {
     output[i] = srsran_vec_dot_prod_cfc(&last[j++], filter, M);
@@ -227,9 +255,7 @@ uint32_t srsran_conv_same_cf(cf_t* input, float* filter, cf_t* output, uint32_t
   for (i = 0; i < M / 2; i++) {
     output[i] = srsran_vec_dot_prod_cfc(&input[i], &filter[M / 2 - i], M - M / 2 + i);
   }
-  for (; i < N - M / 2; i++) {
-    output[i] = srsran_vec_dot_prod_cfc(&input[i - M / 2], filter, M);
-  }
+  i = conv_same_cf_center(input, filter, output, i, N - M / 2, M);
   for (; i < N; i++) {
     output[i] = srsran_vec_dot_prod_cfc(&input[i - M / 2], filter, N - i + M / 2);
   }
@@ -124,6 +124,65 @@ void srsran_mat_2x2_mmse_gen(cf_t  y0,
   srsran_mat_2x2_mmse_csi_gen(y0, y1, h00, h01, h10, h11, x0, x1, &csi0, &csi1, noise_estimate, norm);
 }
 
+void srsran_mat_NxL_mmse_gen(const cf_t* y,
+                             cf_t        h[SRSRAN_MAT_NXL_MAX][SRSRAN_MAT_NXL_MAX],
+                             cf_t*       x,
+                             uint32_t    nof_rxant,
+                             uint32_t    nof_layers,
+                             float       noise_estimate,
+                             float       norm)
+{
+  cf_t  a[SRSRAN_MAT_NXL_MAX][SRSRAN_MAT_NXL_MAX];
+  float d[SRSRAN_MAT_NXL_MAX];
+  cf_t  z[SRSRAN_MAT_NXL_MAX];
+
+  // 1. Lower triangle of A = H' x H and Z = H' x Y
+  for (uint32_t i = 0; i < nof_layers; i++) {
+    z[i] = 0.0f;
+    for (uint32_t j = 0; j <= i; j++) {
+      a[i][j] = 0.0f;
+    }
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      z[i] += conjf(h[r][i]) * y[r];
+      for (uint32_t j = 0; j <= i; j++) {
+        a[i][j] += conjf(h[r][i]) * h[r][j];
+      }
+    }
+  }
+
+  // 2. A + No = L x D x L', L is unit lower triangular and it overwrites A
+  for (uint32_t j = 0; j < nof_layers; j++) {
+    d[j] = crealf(a[j][j]) + noise_estimate;
+    for (uint32_t k = 0; k < j; k++) {
+      d[j] -= (crealf(a[j][k]) * crealf(a[j][k]) + cimagf(a[j][k]) * cimagf(a[j][k])) * d[k];
+    }
+    for (uint32_t i = j + 1; i < nof_layers; i++) {
+      for (uint32_t k = 0; k < j; k++) {
+        a[i][j] -= a[i][k] * conjf(a[j][k]) * d[k];
+      }
+      a[i][j] /= d[j];
+    }
+  }
+
+  // 3. Forward substitution, L x Z' = Z
+  for (uint32_t i = 1; i < nof_layers; i++) {
+    for (uint32_t k = 0; k < i; k++) {
+      z[i] -= a[i][k] * z[k];
+    }
+  }
+
+  // 4. Backward substitution, L' x X = inv(D) x Z'
+  for (int i = (int)nof_layers - 1; i >= 0; i--) {
+    x[i] = z[i] / d[i];
+    for (uint32_t k = i + 1; k < nof_layers; k++) {
+      x[i] -= conjf(a[k][i]) * x[k];
+    }
+  }
+  for (uint32_t i = 0; i < nof_layers; i++) {
+    x[i] *= norm;
+  }
+}
+
 int srsran_mat_2x2_cn(cf_t h00, cf_t h01, cf_t h10, cf_t h11, float* cn)
 {
   // 1. A = H * H' (A = A')
@@ -279,16 +279,15 @@ int srsran_ringbuffer_read_convert_conj(srsran_ringbuffer_t* q, cf_t* dst_ptr, f
   }
 
   int16_t* src = (int16_t*)&q->buffer[q->rpm];
-  float*   dst = (float*)dst_ptr;
 
+  // The conjugate is applied while converting, the samples are not read twice
   if (nof_bytes + q->rpm > q->capacity) {
-    int x = (q->capacity - q->rpm);
-    srsran_vec_convert_if(src, norm, dst, x / 2);
-    srsran_vec_convert_if((int16_t*)q->buffer, norm, &dst[x / 2], 2 * nof_samples - x / 2);
+    int x = (q->capacity - q->rpm) / 4;
+    srsran_vec_convert_conj_sc(src, norm, dst_ptr, x);
+    srsran_vec_convert_conj_sc((int16_t*)q->buffer, norm, &dst_ptr[x], nof_samples - x);
   } else {
-    srsran_vec_convert_if(src, norm, dst, 2 * nof_samples);
+    srsran_vec_convert_conj_sc(src, norm, dst_ptr, nof_samples);
   }
-  srsran_vec_conj_cc(dst_ptr, dst_ptr, nof_samples);
   q->rpm += nof_bytes;
   if (q->rpm >= q->capacity) {
     q->rpm -= q->capacity;
@@ -0,0 +1,177 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/ringbuffer_mirror.h"
+#include "srsran/phy/utils/vector.h"
+
+int srsran_ringbuffer_mirror_init(srsran_ringbuffer_mirror_t* q, uint32_t min_capacity)
+{
+  if (q == NULL || min_capacity == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  memset(q, 0, sizeof(srsran_ringbuffer_mirror_t));
+
+  long     page_size = sysconf(_SC_PAGESIZE);
+  uint32_t capacity  = SRSRAN_CEIL(min_capacity, (uint32_t)page_size) * (uint32_t)page_size;
+
+  int fd = memfd_create("srsran_ringbuffer", MFD_CLOEXEC);
+  if (fd < 0) {
+    ERROR("Error creating ring buffer memory: %s", strerror(errno));
+    return SRSRAN_ERROR;
+  }
+  if (ftruncate(fd, capacity) < 0) {
+    ERROR("Error setting ring buffer size: %s", strerror(errno));
+    close(fd);
+    return SRSRAN_ERROR;
+  }
+
+  // Reserve twice the capacity of consecutive addresses and map the same memory in both halves
+  uint8_t* base = mmap(NULL, 2 * (size_t)capacity, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (base == MAP_FAILED) {
+    ERROR("Error reserving ring buffer addresses: %s", strerror(errno));
+    close(fd);
+    return SRSRAN_ERROR;
+  }
+  for (uint32_t i = 0; i < 2; i++) {
+    if (mmap(base + i * capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+      ERROR("Error mapping ring buffer memory: %s", strerror(errno));
+      munmap(base, 2 * (size_t)capacity);
+      close(fd);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // The mappings keep the memory alive
+  close(fd);
+
+  q->buffer   = base;
+  q->capacity = capacity;
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_ringbuffer_mirror_free(srsran_ringbuffer_mirror_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+  if (q->buffer) {
+    munmap(q->buffer, 2 * (size_t)q->capacity);
+  }
+  memset(q, 0, sizeof(srsran_ringbuffer_mirror_t));
+}
+
+void srsran_ringbuffer_mirror_reset(srsran_ringbuffer_mirror_t* q)
+{
+  __atomic_store_n(&q->wpm, 0, __ATOMIC_RELEASE);
+  __atomic_store_n(&q->rpm, 0, __ATOMIC_RELEASE);
+}
+
+uint32_t srsran_ringbuffer_mirror_status(srsran_ringbuffer_mirror_t* q)
+{
+  uint64_t rpm = __atomic_load_n(&q->rpm, __ATOMIC_ACQUIRE);
+  uint64_t wpm = __atomic_load_n(&q->wpm, __ATOMIC_ACQUIRE);
+  return (uint32_t)(wpm - rpm);
+}
+
+uint32_t srsran_ringbuffer_mirror_space(srsran_ringbuffer_mirror_t* q)
+{
+  return q->capacity - srsran_ringbuffer_mirror_status(q);
+}
+
+uint8_t* srsran_ringbuffer_mirror_write_view(srsran_ringbuffer_mirror_t* q, uint32_t* nof_bytes)
+{
+  // The write counter is only modified by the caller, the read counter is acquired to see the released bytes
+  uint64_t wpm = __atomic_load_n(&q->wpm, __ATOMIC_RELAXED);
+  uint64_t rpm = __atomic_load_n(&q->rpm, __ATOMIC_ACQUIRE);
+
+  if (nof_bytes) {
+    *nof_bytes = q->capacity - (uint32_t)(wpm - rpm);
+  }
+  return &q->buffer[wpm % q->capacity];
+}
+
+int srsran_ringbuffer_mirror_write_commit(srsran_ringbuffer_mirror_t* q, uint32_t nof_bytes)
+{
+  uint64_t wpm = __atomic_load_n(&q->wpm, __ATOMIC_RELAXED);
+  uint64_t rpm = __atomic_load_n(&q->rpm, __ATOMIC_ACQUIRE);
+  if (nof_bytes > q->capacity - (uint32_t)(wpm - rpm)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Publish the written bytes to the consumer
+  __atomic_store_n(&q->wpm, wpm + nof_bytes, __ATOMIC_RELEASE);
+  return SRSRAN_SUCCESS;
+}
+
+const uint8_t* srsran_ringbuffer_mirror_read_view(srsran_ringbuffer_mirror_t* q, uint32_t* nof_bytes)
+{
+  // The read counter is only modified by the caller, the write counter is acquired to see the committed bytes
+  uint64_t rpm = __atomic_load_n(&q->rpm, __ATOMIC_RELAXED);
+  uint64_t wpm = __atomic_load_n(&q->wpm, __ATOMIC_ACQUIRE);
+
+  if (nof_bytes) {
+    *nof_bytes = (uint32_t)(wpm - rpm);
+  }
+  return &q->buffer[rpm % q->capacity];
+}
+
+int srsran_ringbuffer_mirror_read_release(srsran_ringbuffer_mirror_t* q, uint32_t nof_bytes)
+{
+  uint64_t rpm = __atomic_load_n(&q->rpm, __ATOMIC_RELAXED);
+  uint64_t wpm = __atomic_load_n(&q->wpm, __ATOMIC_ACQUIRE);
+  if (nof_bytes > (uint32_t)(wpm - rpm)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Hand the released bytes back to the producer
+  __atomic_store_n(&q->rpm, rpm + nof_bytes, __ATOMIC_RELEASE);
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_ringbuffer_mirror_write(srsran_ringbuffer_mirror_t* q, const void* ptr, uint32_t nof_bytes)
+{
+  uint32_t space = 0;
+  uint8_t* dst   = srsran_ringbuffer_mirror_write_view(q, &space);
+  if (nof_bytes > space) {
+    return SRSRAN_ERROR;
+  }
+  memcpy(dst, ptr, nof_bytes);
+  srsran_ringbuffer_mirror_write_commit(q, nof_bytes);
+  return nof_bytes;
+}
+
+int srsran_ringbuffer_mirror_read(srsran_ringbuffer_mirror_t* q, void* ptr, uint32_t nof_bytes)
+{
+  uint32_t       count = 0;
+  const uint8_t* src   = srsran_ringbuffer_mirror_read_view(q, &count);
+  if (nof_bytes > count) {
+    return SRSRAN_ERROR;
+  }
+  memcpy(ptr, src, nof_bytes);
+  srsran_ringbuffer_mirror_read_release(q, nof_bytes);
+  return nof_bytes;
+}
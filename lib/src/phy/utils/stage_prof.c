@@ -0,0 +1,167 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/stage_prof.h"
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Threads beyond this number share the last slot, which stays correct since every update is atomic
+#define STAGE_PROF_MAX_THREADS 64
+
+typedef struct {
+  uint64_t count;
+  uint64_t ticks;
+  uint64_t max_ticks;
+  uint32_t hist[SRSRAN_STAGE_PROF_HIST_LEN];
+} stage_prof_counters_t;
+
+// Every slot starts in its own cache line so the threads do not invalidate each other
+typedef struct {
+  stage_prof_counters_t stage[SRSRAN_STAGE_PROF_NOF];
+} __attribute__((aligned(64))) stage_prof_slot_t;
+
+static stage_prof_slot_t           slots[STAGE_PROF_MAX_THREADS] = {};
+static uint32_t                    nof_slots                     = 0;
+static __thread stage_prof_slot_t* thread_slot                   = NULL;
+static bool                        enabled                       = false;
+static uint64_t                    ticks_per_ms                  = 0;
+
+static const char* const stage_names[SRSRAN_STAGE_PROF_NOF] =
+    {"ofdm", "chest", "equalize", "demod", "fec", "crc", "encode", "map"};
+
+static inline uint64_t stage_prof_ticks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000UL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static uint64_t stage_prof_clock_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000UL + (uint64_t)ts.tv_nsec;
+}
+
+// Measures the tick rate against the monotonic clock over a couple of milliseconds
+static void stage_prof_calibrate(void)
+{
+  uint64_t ns0    = stage_prof_clock_ns();
+  uint64_t ticks0 = stage_prof_ticks();
+  uint64_t ns1    = ns0;
+  while (ns1 - ns0 < 2000000UL) {
+    ns1 = stage_prof_clock_ns();
+  }
+  uint64_t ticks1 = stage_prof_ticks();
+
+  __atomic_store_n(&ticks_per_ms, (ticks1 - ticks0) * 1000000UL / (ns1 - ns0), __ATOMIC_RELEASE);
+}
+
+void srsran_stage_prof_set_enabled(bool en)
+{
+  if (en && __atomic_load_n(&ticks_per_ms, __ATOMIC_ACQUIRE) == 0) {
+    stage_prof_calibrate();
+  }
+  __atomic_store_n(&enabled, en, __ATOMIC_RELEASE);
+}
+
+bool srsran_stage_prof_is_enabled(void)
+{
+  return __atomic_load_n(&enabled, __ATOMIC_RELAXED);
+}
+
+const char* srsran_stage_prof_name(srsran_stage_prof_t stage)
+{
+  return stage < SRSRAN_STAGE_PROF_NOF ? stage_names[stage] : "unknown";
+}
+
+uint64_t srsran_stage_prof_start(void)
+{
+  if (!__atomic_load_n(&enabled, __ATOMIC_RELAXED)) {
+    return 0;
+  }
+  return stage_prof_ticks();
+}
+
+void srsran_stage_prof_stop(srsran_stage_prof_t stage, uint64_t t0)
+{
+  if (t0 == 0 || stage >= SRSRAN_STAGE_PROF_NOF) {
+    return;
+  }
+  uint64_t ticks = stage_prof_ticks() - t0;
+
+  if (thread_slot == NULL) {
+    uint32_t idx = __atomic_fetch_add(&nof_slots, 1, __ATOMIC_RELAXED);
+    thread_slot  = &slots[idx < STAGE_PROF_MAX_THREADS ? idx : STAGE_PROF_MAX_THREADS - 1];
+  }
+  stage_prof_counters_t* c = &thread_slot->stage[stage];
+
+  // Bin on the bit length of the duration in us, ticks_per_ms is set before the timers are enabled
+  uint64_t us  = ticks * 1000UL / __atomic_load_n(&ticks_per_ms, __ATOMIC_RELAXED);
+  uint32_t bin = us ? 64U - (uint32_t)__builtin_clzll(us) : 0;
+  bin          = bin < SRSRAN_STAGE_PROF_HIST_LEN ? bin : SRSRAN_STAGE_PROF_HIST_LEN - 1;
+
+  __atomic_fetch_add(&c->count, 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&c->ticks, ticks, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&c->hist[bin], 1, __ATOMIC_RELAXED);
+
+  uint64_t max_ticks = __atomic_load_n(&c->max_ticks, __ATOMIC_RELAXED);
+  while (ticks > max_ticks &&
+         !__atomic_compare_exchange_n(&c->max_ticks, &max_ticks, ticks, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+  }
+}
+
+void srsran_stage_prof_get(srsran_stage_prof_metrics_t metrics[SRSRAN_STAGE_PROF_NOF])
+{
+  memset(metrics, 0, sizeof(srsran_stage_prof_metrics_t) * SRSRAN_STAGE_PROF_NOF);
+
+  uint64_t tpms        = __atomic_load_n(&ticks_per_ms, __ATOMIC_ACQUIRE);
+  double   us_per_tick = tpms ? 1000.0 / (double)tpms : 0.0;
+
+  uint32_t n = __atomic_load_n(&nof_slots, __ATOMIC_RELAXED);
+  n          = n < STAGE_PROF_MAX_THREADS ? n : STAGE_PROF_MAX_THREADS;
+  for (uint32_t i = 0; i < n; i++) {
+    for (uint32_t s = 0; s < SRSRAN_STAGE_PROF_NOF; s++) {
+      stage_prof_counters_t*       c = &slots[i].stage[s];
+      srsran_stage_prof_metrics_t* m = &metrics[s];
+
+      m->count += __atomic_exchange_n(&c->count, 0, __ATOMIC_RELAXED);
+      m->total_us += (double)__atomic_exchange_n(&c->ticks, 0, __ATOMIC_RELAXED) * us_per_tick;
+
+      double max_us = (double)__atomic_exchange_n(&c->max_ticks, 0, __ATOMIC_RELAXED) * us_per_tick;
+      if (max_us > m->max_us) {
+        m->max_us = max_us;
+      }
+
+      for (uint32_t b = 0; b < SRSRAN_STAGE_PROF_HIST_LEN; b++) {
+        m->hist[b] += __atomic_exchange_n(&c->hist[b], 0, __ATOMIC_RELAXED);
+      }
+    }
+  }
+}
@@ -0,0 +1,186 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/bit.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include "srsran/support/srsran_test.h"
+#include <stdlib.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+static uint32_t nof_bits        = 8448 * 3 + 5;
+static uint32_t nof_repetitions = 1000;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [nrv]\n", prog);
+  printf("\t-n number of bits [Default %d]\n", nof_bits);
+  printf("\t-r number of repetitions for the benchmark [Default %d]\n", nof_repetitions);
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nrv")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_bits = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static double elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
+{
+  return ((double)ts_end->tv_sec - (double)ts_start->tv_sec) * 1e6 + (double)ts_end->tv_usec -
+         (double)ts_start->tv_usec;
+}
+
+static void print_throughput(const char* name, struct timeval* ts_start, struct timeval* ts_end)
+{
+  double elapsed = elapsed_us(ts_start, ts_end);
+  printf("%24s (%6d bits) ... %8.1f Mbps\n", name, nof_bits, (double)nof_bits * nof_repetitions / elapsed);
+}
+
+static int test_pack_unpack(srsran_random_t random_gen, uint8_t* bits, uint8_t* packed, uint8_t* unpacked)
+{
+  struct timeval t[3];
+
+  // Every length up to the given one, so all the SIMD widths and tails are checked
+  srsran_random_bit_vector(random_gen, bits, nof_bits);
+  for (uint32_t len = 0; len <= nof_bits; len += (len < 512) ? 1 : 67) {
+    srsran_bit_pack_vector(bits, packed, len);
+    for (uint32_t i = 0; i < len; i++) {
+      TESTASSERT(((packed[i / 8] >> (7 - i % 8)) & 1) == bits[i]);
+    }
+
+    srsran_bit_unpack_vector(packed, unpacked, len);
+    TESTASSERT(memcmp(bits, unpacked, len) == 0);
+  }
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    srsran_bit_pack_vector(bits, packed, nof_bits);
+  }
+  gettimeofday(&t[2], NULL);
+  print_throughput("srsran_bit_pack_vector", &t[1], &t[2]);
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    srsran_bit_unpack_vector(packed, unpacked, nof_bits);
+  }
+  gettimeofday(&t[2], NULL);
+  print_throughput("srsran_bit_unpack_vector", &t[1], &t[2]);
+
+  return SRSRAN_SUCCESS;
+}
+
+static int test_interleaver(srsran_random_t random_gen, uint8_t* bits, uint8_t* packed, uint8_t* output)
+{
+  struct timeval t[3];
+
+  // Random permutation
+  uint16_t* interleaver = srsran_vec_u16_malloc(nof_bits);
+  TESTASSERT(interleaver != NULL);
+  for (uint32_t i = 0; i < nof_bits; i++) {
+    interleaver[i] = (uint16_t)i;
+  }
+  for (uint32_t i = nof_bits - 1; i > 0; i--) {
+    uint32_t j     = (uint32_t)srsran_random_uniform_int_dist(random_gen, 0, (int)i);
+    uint16_t tmp   = interleaver[i];
+    interleaver[i] = interleaver[j];
+    interleaver[j] = tmp;
+  }
+
+  srsran_bit_interleaver_t q;
+  srsran_bit_interleaver_init(&q, interleaver, nof_bits);
+
+  srsran_random_bit_vector(random_gen, bits, nof_bits);
+  srsran_bit_pack_vector(bits, packed, nof_bits);
+  srsran_bit_interleaver_run(&q, packed, output, 0);
+  for (uint32_t i = 0; i < nof_bits; i++) {
+    TESTASSERT(((output[i / 8] >> (7 - i % 8)) & 1) == bits[interleaver[i]]);
+  }
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    srsran_bit_interleaver_run(&q, packed, output, 0);
+  }
+  gettimeofday(&t[2], NULL);
+  print_throughput("srsran_bit_interleaver_run", &t[1], &t[2]);
+
+  srsran_bit_interleaver_free(&q);
+  free(interleaver);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  srsran_random_t random_gen = srsran_random_init(0x1234);
+  uint8_t*        bits       = srsran_vec_u8_malloc(nof_bits);
+  uint8_t*        packed     = srsran_vec_u8_malloc(nof_bits / 8 + 1);
+  uint8_t*        unpacked   = srsran_vec_u8_malloc(nof_bits);
+  if (random_gen == NULL || bits == NULL || packed == NULL || unpacked == NULL) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+
+  if (test_pack_unpack(random_gen, bits, packed, unpacked) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  if (test_interleaver(random_gen, bits, packed, unpacked) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(random_gen);
+  if (bits) {
+    free(bits);
+  }
+  if (packed) {
+    free(packed);
+  }
+  if (unpacked) {
+    free(unpacked);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Failed");
+  return ret;
+}
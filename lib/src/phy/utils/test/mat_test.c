@@ -128,6 +128,43 @@ static bool test_zf_solver_gen(void)
   return (error < MAXIMUM_ERROR);
 }
 
+/* Random, well conditioned, 4x4 channel and the received signal of random transmitted symbols */
+static void generate_4x4_system(cf_t h[SRSRAN_MAT_NXL_MAX][SRSRAN_MAT_NXL_MAX],
+                                cf_t x_gold[SRSRAN_MAT_NXL_MAX],
+                                cf_t y[SRSRAN_MAT_NXL_MAX])
+{
+  for (int i = 0; i < SRSRAN_MAT_NXL_MAX; i++) {
+    x_gold[i] = RANDOM_CF();
+    for (int j = 0; j < SRSRAN_MAT_NXL_MAX; j++) {
+      h[i][j] = RANDOM_CF() * 0.25f + ((i == j) ? 1.0f : 0.0f);
+    }
+  }
+  for (int i = 0; i < SRSRAN_MAT_NXL_MAX; i++) {
+    y[i] = 0.0f;
+    for (int j = 0; j < SRSRAN_MAT_NXL_MAX; j++) {
+      y[i] += h[i][j] * x_gold[j];
+    }
+  }
+}
+
+static bool test_mmse_4x4_solver_gen(void)
+{
+  cf_t  h[SRSRAN_MAT_NXL_MAX][SRSRAN_MAT_NXL_MAX];
+  cf_t  x_gold[SRSRAN_MAT_NXL_MAX], y[SRSRAN_MAT_NXL_MAX], x[SRSRAN_MAT_NXL_MAX];
+  float error = 0.0f;
+
+  generate_4x4_system(h, x_gold, y);
+
+  srsran_mat_NxL_mmse_gen(y, h, x, SRSRAN_MAT_NXL_MAX, SRSRAN_MAT_NXL_MAX, 0.0f, 1.0f);
+
+  for (int i = 0; i < SRSRAN_MAT_NXL_MAX; i++) {
+    cf_t cf_error = x[i] - x_gold[i];
+    error += crealf(cf_error) * crealf(cf_error) + cimagf(cf_error) * cimagf(cf_error);
+  }
+
+  return (error < MAXIMUM_ERROR);
+}
+
 static bool test_mmse_solver_gen(void)
 {
   cf_t  x0, x1, cf_error0, cf_error1;
@@ -248,6 +285,46 @@ static bool test_mmse_solver_simd(void)
   return (error < MAXIMUM_ERROR);
 }
 
+static bool test_mmse_4x4_solver_simd(void)
+{
+  cf_t      h[SRSRAN_SIMD_CF_SIZE][SRSRAN_MAT_NXL_MAX][SRSRAN_MAT_NXL_MAX];
+  cf_t      x_gold[SRSRAN_SIMD_CF_SIZE][SRSRAN_MAT_NXL_MAX], y[SRSRAN_SIMD_CF_SIZE][SRSRAN_MAT_NXL_MAX];
+  simd_cf_t _h[SRSRAN_MAT_NXL_MAX][SRSRAN_MAT_NXL_MAX], _y[SRSRAN_MAT_NXL_MAX], _x[SRSRAN_MAT_NXL_MAX];
+  float     error = 0.0f;
+
+  for (int k = 0; k < SRSRAN_SIMD_CF_SIZE; k++) {
+    generate_4x4_system(h[k], x_gold[k], y[k]);
+  }
+
+  // Transpose the systems so that every register holds one coefficient of all of them
+  srsran_simd_aligned cf_t tmp[SRSRAN_SIMD_CF_SIZE];
+  for (int i = 0; i < SRSRAN_MAT_NXL_MAX; i++) {
+    for (int j = 0; j < SRSRAN_MAT_NXL_MAX; j++) {
+      for (int k = 0; k < SRSRAN_SIMD_CF_SIZE; k++) {
+        tmp[k] = h[k][i][j];
+      }
+      _h[i][j] = srsran_simd_cfi_load(tmp);
+    }
+    for (int k = 0; k < SRSRAN_SIMD_CF_SIZE; k++) {
+      tmp[k] = y[k][i];
+    }
+    _y[i] = srsran_simd_cfi_load(tmp);
+  }
+
+  srsran_mat_NxL_mmse_simd(_y, _h, _x, SRSRAN_MAT_NXL_MAX, SRSRAN_MAT_NXL_MAX, 0.0f, 1.0f);
+
+  for (int i = 0; i < SRSRAN_MAT_NXL_MAX; i++) {
+    srsran_simd_cfi_store(tmp, _x[i]);
+    for (int k = 0; k < SRSRAN_SIMD_CF_SIZE; k++) {
+      cf_t cf_error = tmp[k] - x_gold[k][i];
+      error += crealf(cf_error) * crealf(cf_error) + cimagf(cf_error) * cimagf(cf_error);
+    }
+  }
+  error /= SRSRAN_SIMD_CF_SIZE;
+
+  return (error < MAXIMUM_ERROR);
+}
+
 #endif /* SRSRAN_SIMD_CF_SIZE != 0 */
 
 static bool test_vec_dot_prod_ccc(void)
@@ -312,9 +389,11 @@ int main(int argc, char** argv)
 
   if (mmse_solver) {
     RUN_TEST(test_mmse_solver_gen);
+    RUN_TEST(test_mmse_4x4_solver_gen);
 
 #if SRSRAN_SIMD_CF_SIZE != 0
     RUN_TEST(test_mmse_solver_simd);
+    RUN_TEST(test_mmse_4x4_solver_simd);
 #endif /* SRSRAN_SIMD_CF_SIZE != 0*/
   }
 
@@ -31,6 +31,7 @@
 #include <unistd.h>
 
 #include "srsran/phy/utils/ringbuffer.h"
+#include "srsran/phy/utils/ringbuffer_mirror.h"
 #include "srsran/phy/utils/vector.h"
 
 struct thread_args_t {
@@ -151,6 +152,94 @@ int threaded_blocking_test(struct thread_args_t* args)
   return SRSRAN_SUCCESS;
 }
 
+int test_mirror_wraparound(srsran_ringbuffer_mirror_t* q, uint8_t* in, int len)
+{
+  srsran_ringbuffer_mirror_reset(q);
+
+  // Leave the write position right before the end of the buffer
+  uint32_t offset = q->capacity - (uint32_t)len / 2;
+  TESTASSERT(srsran_ringbuffer_mirror_write_commit(q, offset) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_ringbuffer_mirror_read_release(q, offset) == SRSRAN_SUCCESS);
+
+  // The written and read views are contiguous across the end of the buffer
+  uint32_t space = 0;
+  uint8_t* dst   = srsran_ringbuffer_mirror_write_view(q, &space);
+  TESTASSERT(space == q->capacity);
+  memcpy(dst, in, len);
+  TESTASSERT(srsran_ringbuffer_mirror_write_commit(q, len) == SRSRAN_SUCCESS);
+
+  uint32_t       count = 0;
+  const uint8_t* src   = srsran_ringbuffer_mirror_read_view(q, &count);
+  TESTASSERT(count == (uint32_t)len);
+  TESTASSERT(src == dst);
+  TESTASSERT(!memcmp(src, in, len));
+
+  // The wrapped part is in the start of the buffer
+  TESTASSERT(!memcmp(q->buffer, &in[len - len / 2], len / 2));
+  TESTASSERT(srsran_ringbuffer_mirror_read_release(q, len) == SRSRAN_SUCCESS);
+
+  // Commits and releases beyond the available bytes are rejected
+  TESTASSERT(srsran_ringbuffer_mirror_read_release(q, 1) == SRSRAN_ERROR_INVALID_INPUTS);
+  TESTASSERT(srsran_ringbuffer_mirror_write_commit(q, q->capacity + 1) == SRSRAN_ERROR_INVALID_INPUTS);
+  TESTASSERT(srsran_ringbuffer_mirror_read(q, dst, 1) == SRSRAN_ERROR);
+  return SRSRAN_SUCCESS;
+}
+
+struct mirror_args_t {
+  srsran_ringbuffer_mirror_t* buf;
+  uint32_t                    nof_bytes;
+};
+
+void* mirror_write_thread(void* args_)
+{
+  struct mirror_args_t* args  = (struct mirror_args_t*)args_;
+  uint32_t              count = 0;
+  while (count < args->nof_bytes) {
+    uint32_t space = 0;
+    uint8_t* dst   = srsran_ringbuffer_mirror_write_view(args->buf, &space);
+    space          = SRSRAN_MIN(space, args->nof_bytes - count);
+    for (uint32_t i = 0; i < space; i++) {
+      dst[i] = (uint8_t)(count + i);
+    }
+    srsran_ringbuffer_mirror_write_commit(args->buf, space);
+    count += space;
+  }
+  return NULL;
+}
+
+int threaded_mirror_test(srsran_ringbuffer_mirror_t* q)
+{
+  struct mirror_args_t args = {q, 64 * q->capacity + 123};
+  srsran_ringbuffer_mirror_reset(q);
+
+  pthread_t thread;
+  if (pthread_create(&thread, NULL, mirror_write_thread, &args)) {
+    fprintf(stderr, "Error creating thread\n");
+    return SRSRAN_ERROR;
+  }
+
+  // Consume the bytes as they are published and check they arrive in order
+  uint32_t count  = 0;
+  int      errors = 0;
+  while (count < args.nof_bytes) {
+    uint32_t       nof_bytes = 0;
+    const uint8_t* src       = srsran_ringbuffer_mirror_read_view(q, &nof_bytes);
+    for (uint32_t i = 0; i < nof_bytes; i++) {
+      errors += (src[i] != (uint8_t)(count + i));
+    }
+    srsran_ringbuffer_mirror_read_release(q, nof_bytes);
+    count += nof_bytes;
+  }
+
+  if (pthread_join(thread, NULL)) {
+    fprintf(stderr, "Error joining thread\n");
+    return SRSRAN_ERROR;
+  }
+  TESTASSERT(errors == 0);
+  TESTASSERT(srsran_ringbuffer_mirror_status(q) == 0);
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   int ret = SRSRAN_SUCCESS;
@@ -192,6 +281,22 @@ int main(int argc, char** argv)
   }
   srsran_ringbuffer_stop(&ring_buf);
   srsran_ringbuffer_free(&ring_buf);
+
+  srsran_ringbuffer_mirror_t mirror_buf;
+  if (srsran_ringbuffer_mirror_init(&mirror_buf, N) < SRSRAN_SUCCESS) {
+    printf("Error initialising mirrored ringbuffer\n");
+    ret = SRSRAN_ERROR;
+  } else {
+    if (test_mirror_wraparound(&mirror_buf, in, N) < SRSRAN_SUCCESS) {
+      printf("Mirrored ringbuffer wraparound test failed\n");
+      ret = SRSRAN_ERROR;
+    }
+    if (threaded_mirror_test(&mirror_buf) < SRSRAN_SUCCESS) {
+      printf("Error in multithreaded mirrored ringbuffer test\n");
+      ret = SRSRAN_ERROR;
+    }
+    srsran_ringbuffer_mirror_free(&mirror_buf);
+  }
   free(in);
   free(out);
   printf("Done\n");
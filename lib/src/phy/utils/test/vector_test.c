@@ -482,6 +482,26 @@ TEST(
     free(x);
     free(z);)
 
+TEST(
+    srsran_vec_convert_sc_prod_cs, MALLOC(cf_t, x); int16_t* z = srsran_vec_i16_malloc(block_size * 2);
+    cf_t h = RANDOM_CF() * 1000.0f;
+
+    for (int i = 0; i < block_size; i++) { x[i] = RANDOM_CF(); }
+
+    TEST_CALL(srsran_vec_convert_sc_prod_cs(x, h, z, block_size))
+
+        for (int i = 0; i < block_size; i++) {
+          // The conversion truncates and the product rounding may differ, any result within one unit is correct
+          cf_t   gold = x[i] * h;
+          double err  = (fabsf(crealf(gold) - z[2 * i]) < 1.01f && fabsf(cimagf(gold) - z[2 * i + 1]) < 1.01f) ? 0 : 1;
+          if (err > mse) {
+            mse = err;
+          }
+        }
+
+    free(x);
+    free(z);)
+
 TEST(
     srsran_vec_convert_if, MALLOC(int16_t, x); MALLOC(float, z); float scale = 1000.0f;
 
@@ -502,6 +522,26 @@ TEST(
     free(x);
     free(z);)
 
+TEST(
+    srsran_vec_convert_conj_sc, int16_t* x = srsran_vec_i16_malloc(block_size * 2); MALLOC(cf_t, z);
+    float scale = 1000.0f;
+
+    float k = 1.0f / scale;
+    for (int i = 0; i < 2 * block_size; i++) { x[i] = (int16_t)RANDOM_S(); }
+
+    TEST_CALL(srsran_vec_convert_conj_sc(x, scale, z, block_size))
+
+        for (int i = 0; i < block_size; i++) {
+          cf_t   gold = ((float)x[2 * i] - I * (float)x[2 * i + 1]) * k;
+          double err  = cabsf(gold - z[i]);
+          if (err > mse) {
+            mse = err;
+          }
+        }
+
+    free(x);
+    free(z);)
+
 TEST(
     srsran_vec_prod_fff, MALLOC(float, x); MALLOC(float, y); MALLOC(float, z);
 
@@ -959,10 +999,18 @@ int main(int argc, char** argv)
         test_srsran_vec_convert_conj_cs(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
 
+    passed[func_count][size_count] =
+        test_srsran_vec_convert_sc_prod_cs(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
     passed[func_count][size_count] =
         test_srsran_vec_convert_if(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
 
+    passed[func_count][size_count] =
+        test_srsran_vec_convert_conj_sc(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
     passed[func_count][size_count] =
         test_srsran_vec_prod_fff(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
@@ -1076,7 +1124,7 @@ int main(int argc, char** argv)
     pclose(p);
   }
 
-  printf("\n");
+  printf("\nVector kernels: %s\n", srsran_vec_simd_isa());
   printf("%32s |", "Subroutine/MSps");
   if (f)
     fprintf(f, "Subroutine/MSps Vs Vector size\t");
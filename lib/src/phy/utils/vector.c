@@ -24,12 +24,44 @@
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 #include "srsran/phy/utils/vector_simd.h"
+#include "vector_simd_dispatch.h"
+
+// Kernels of the hot vector functions, the build instruction set ones unless a faster set is found at startup
+static const srsran_vec_simd_kernels_t* vec_kernels = &srsran_vec_simd_kernels_simd;
+
+#if defined(SRSRAN_VEC_DISPATCH_AVX2) || defined(SRSRAN_VEC_DISPATCH_AVX512)
+__attribute__((constructor)) static void vec_simd_dispatch_init()
+{
+  // CPU features must be initialised explicitly before main()
+  __builtin_cpu_init();
+
+#ifdef SRSRAN_VEC_DISPATCH_AVX512
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq") &&
+      __builtin_cpu_supports("avx512cd")) {
+    vec_kernels = &srsran_vec_simd_kernels_avx512;
+    return;
+  }
+#endif /* SRSRAN_VEC_DISPATCH_AVX512 */
+
+#ifdef SRSRAN_VEC_DISPATCH_AVX2
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    vec_kernels = &srsran_vec_simd_kernels_avx2;
+  }
+#endif /* SRSRAN_VEC_DISPATCH_AVX2 */
+}
+#endif /* defined(SRSRAN_VEC_DISPATCH_AVX2) || defined(SRSRAN_VEC_DISPATCH_AVX512) */
+
+const char* srsran_vec_simd_isa()
+{
+  return vec_kernels->name;
+}
 
 void srsran_vec_xor_bbb(const uint8_t* x, const uint8_t* y, uint8_t* z, const uint32_t len)
 {
@@ -99,7 +131,7 @@ void srsran_vec_sc_prod_fff(const float* x, const float h, float* z, const uint3
 // Used throughout
 void srsran_vec_sc_prod_cfc(const cf_t* x, const float h, cf_t* z, const uint32_t len)
 {
-  srsran_vec_sc_prod_cfc_simd(x, h, z, len);
+  vec_kernels->sc_prod_cfc(x, h, z, len);
 }
 
 void srsran_vec_sc_prod_fcc(const float* x, const cf_t h, cf_t* z, const uint32_t len)
@@ -110,18 +142,23 @@ void srsran_vec_sc_prod_fcc(const float* x, const cf_t h, cf_t* z, const uint32_
 // Chest UL
 void srsran_vec_sc_prod_ccc(const cf_t* x, const cf_t h, cf_t* z, const uint32_t len)
 {
-  srsran_vec_sc_prod_ccc_simd(x, h, z, len);
+  vec_kernels->sc_prod_ccc(x, h, z, len);
 }
 
 // Used in turbo decoder
 void srsran_vec_convert_if(const int16_t* x, const float scale, float* z, const uint32_t len)
 {
-  srsran_vec_convert_if_simd(x, z, scale, len);
+  vec_kernels->convert_if(x, z, scale, len);
 }
 
 void srsran_vec_convert_fi(const float* x, const float scale, int16_t* z, const uint32_t len)
 {
-  srsran_vec_convert_fi_simd(x, z, scale, len);
+  vec_kernels->convert_fi(x, z, scale, len);
+}
+
+void srsran_vec_convert_conj_sc(const int16_t* x, const float scale, cf_t* z, const uint32_t len)
+{
+  vec_kernels->convert_conj_sc(x, z, scale, len);
 }
 
 void srsran_vec_convert_conj_cs(const cf_t* x, const float scale, int16_t* z, const uint32_t len)
@@ -129,6 +166,11 @@ void srsran_vec_convert_conj_cs(const cf_t* x, const float scale, int16_t* z, co
   srsran_vec_convert_conj_cs_simd(x, z, scale, len);
 }
 
+void srsran_vec_convert_sc_prod_cs(const cf_t* x, const cf_t h, int16_t* z, const uint32_t len)
+{
+  srsran_vec_convert_sc_prod_cs_simd(x, h, z, len);
+}
+
 void srsran_vec_convert_fb(const float* x, const float scale, int8_t* z, const uint32_t len)
 {
   srsran_vec_convert_fb_simd(x, z, scale, len);
@@ -151,12 +193,118 @@ void srsran_vec_lut_sis(const short* x, const unsigned int* lut, short* y, const
   }
 }
 
+// Size of a transparent huge page
+#define VEC_HUGEPAGE_SIZE (2U * 1024U * 1024U)
+
+// Allocations of at least this size are backed by transparent huge pages, 0 disables them
+static uint32_t vec_hugepage_min_size = 0;
+
+// Allocations backed by huge pages since startup
+static uint64_t vec_hugepage_nof_allocs = 0;
+static uint64_t vec_hugepage_nof_bytes  = 0;
+
+void srsran_vec_set_hugepage_min_size(uint32_t min_size)
+{
+  __atomic_store_n(&vec_hugepage_min_size, min_size, __ATOMIC_RELAXED);
+}
+
+void srsran_vec_get_hugepage_usage(uint64_t* nof_allocs, uint64_t* nof_bytes)
+{
+  *nof_allocs = __atomic_load_n(&vec_hugepage_nof_allocs, __ATOMIC_RELAXED);
+  *nof_bytes  = __atomic_load_n(&vec_hugepage_nof_bytes, __ATOMIC_RELAXED);
+}
+
+// Memory accounted to each subsystem
+static int64_t mem_usage[SRSRAN_MEM_TAG_NOF];
+
+// Subsystem of the buffers allocated by the thread, and their total size
+static __thread srsran_mem_tag_t thread_mem_tag   = SRSRAN_MEM_TAG_NONE;
+static __thread uint64_t         thread_mem_usage = 0;
+
+const char* srsran_mem_tag_to_str(srsran_mem_tag_t tag)
+{
+  switch (tag) {
+    case SRSRAN_MEM_TAG_PHY:
+      return "phy";
+    case SRSRAN_MEM_TAG_SOFTBUFFER:
+      return "softbuffer";
+    default:
+      break;
+  }
+  return "none";
+}
+
+srsran_mem_tag_t srsran_vec_set_mem_tag(srsran_mem_tag_t tag)
+{
+  srsran_mem_tag_t prev = thread_mem_tag;
+  thread_mem_tag        = tag;
+  return prev;
+}
+
+void srsran_mem_account(srsran_mem_tag_t tag, int64_t nof_bytes)
+{
+  if (tag > SRSRAN_MEM_TAG_NONE && tag < SRSRAN_MEM_TAG_NOF) {
+    __atomic_fetch_add(&mem_usage[tag], nof_bytes, __ATOMIC_RELAXED);
+  }
+}
+
+uint64_t srsran_mem_get_usage(srsran_mem_tag_t tag)
+{
+  if (tag <= SRSRAN_MEM_TAG_NONE || tag >= SRSRAN_MEM_TAG_NOF) {
+    return 0;
+  }
+  int64_t usage = __atomic_load_n(&mem_usage[tag], __ATOMIC_RELAXED);
+  return usage > 0 ? (uint64_t)usage : 0;
+}
+
+uint64_t srsran_vec_get_thread_mem_usage(void)
+{
+  return thread_mem_usage;
+}
+
+static void vec_mem_account(uint32_t size)
+{
+  if (thread_mem_tag != SRSRAN_MEM_TAG_NONE) {
+    thread_mem_usage += size;
+    srsran_mem_account(thread_mem_tag, size);
+  }
+}
+
+// Allocates whole huge pages aligned to their size, so that the kernel can back them with huge pages. The memory is
+// still released with free()
+static void* vec_hugepage_malloc(uint32_t size)
+{
+  size_t len = ((size_t)size + VEC_HUGEPAGE_SIZE - 1) / VEC_HUGEPAGE_SIZE * VEC_HUGEPAGE_SIZE;
+  void*  ptr;
+  if (posix_memalign(&ptr, VEC_HUGEPAGE_SIZE, len)) {
+    return NULL;
+  }
+#ifdef MADV_HUGEPAGE
+  // Best effort, the memory is usable anyway when transparent huge pages are disabled in the system
+  if (madvise(ptr, len, MADV_HUGEPAGE) == 0) {
+    __atomic_fetch_add(&vec_hugepage_nof_allocs, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&vec_hugepage_nof_bytes, len, __ATOMIC_RELAXED);
+  }
+#endif /* MADV_HUGEPAGE */
+  return ptr;
+}
+
 void* srsran_vec_malloc(uint32_t size)
 {
+  uint32_t hugepage_min_size = __atomic_load_n(&vec_hugepage_min_size, __ATOMIC_RELAXED);
+  if (hugepage_min_size > 0 && size >= hugepage_min_size) {
+    void* ptr = vec_hugepage_malloc(size);
+    if (ptr) {
+      vec_mem_account(size);
+    }
+    return ptr;
+  }
+
   void* ptr;
   if (posix_memalign(&ptr, SRSRAN_SIMD_BIT_ALIGN, size)) {
     return NULL;
   } else {
+    vec_mem_account(size);
     return ptr;
   }
 }
@@ -509,7 +657,7 @@ void srsran_vec_neg_bb(const int8_t* x, int8_t* z, const uint32_t len)
 // CFO and OFDM processing
 void srsran_vec_prod_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t len)
 {
-  srsran_vec_prod_ccc_simd(x, y, z, len);
+  vec_kernels->prod_ccc(x, y, z, len);
 }
 
 void srsran_vec_prod_ccc_split(const float*   x_re,
@@ -702,23 +850,23 @@ void srsran_vec_arg_deg_cf(const cf_t* x, float default_value, float* arg, const
 // PRACH
 void srsran_vec_abs_square_cf(const cf_t* x, float* abs_square, const uint32_t len)
 {
-  srsran_vec_abs_square_cf_simd(x, abs_square, len);
+  vec_kernels->abs_square_cf(x, abs_square, len);
 }
 
 uint32_t srsran_vec_max_fi(const float* x, const uint32_t len)
 {
-  return srsran_vec_max_fi_simd(x, len);
+  return vec_kernels->max_fi(x, len);
 }
 
 uint32_t srsran_vec_max_abs_fi(const float* x, const uint32_t len)
 {
-  return srsran_vec_max_abs_fi_simd(x, len);
+  return vec_kernels->max_abs_fi(x, len);
 }
 
 // CP autocorr
 uint32_t srsran_vec_max_abs_ci(const cf_t* x, const uint32_t len)
 {
-  return srsran_vec_max_ci_simd(x, len);
+  return vec_kernels->max_ci(x, len);
 }
 
 void srsran_vec_quant_fs(const float*   in,
@@ -865,9 +1013,7 @@ float srsran_vec_estimate_frequency(const cf_t* x, int len)
 // TODO: implement with SIMD
 void srsran_vec_gen_clip_env(const float* x_abs, const float thres, const float alpha, float* env, const int len)
 {
-  for (int i = 0; i < len; i++) {
-    env[i] = (x_abs[i] > thres) ? (1 - alpha) + alpha * thres / x_abs[i] : 1;
-  }
+  srsran_vec_gen_clip_env_simd(x_abs, thres, alpha, env, len);
 }
 
 float srsran_vec_papr_c(const cf_t* in, const int len)
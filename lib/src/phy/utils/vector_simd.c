@@ -30,6 +30,10 @@
 #include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector_simd.h"
 
+/* Kernels that are also built for the instruction sets selected at runtime, see vector.c */
+#define SRSRAN_VEC_KERNEL(NAME) NAME##_simd
+#include "vector_simd_kernels.h"
+
 void srsran_vec_xor_bbb_simd(const uint8_t* x, const uint8_t* y, uint8_t* z, const int len)
 {
   int i = 0;
@@ -402,43 +406,20 @@ void srsran_vec_lut_bbb_simd(const int8_t* x, const unsigned short* lut, int8_t*
   }
 }
 
-void srsran_vec_convert_if_simd(const int16_t* x, float* z, const float scale, const int len)
+void srsran_vec_convert_conj_cs_simd(const cf_t* x_, int16_t* z, const float scale, const int len_)
 {
-  int         i    = 0;
-  const float gain = 1.0f / scale;
-
-#ifdef LV_HAVE_SSE
-  __m128 s = _mm_set1_ps(gain);
-  if (SRSRAN_IS_ALIGNED(z)) {
-    for (; i < len - 3; i += 4) {
-      __m64* ptr = (__m64*)&x[i];
-      __m128 fl  = _mm_cvtpi16_ps(*ptr);
-      __m128 v   = _mm_mul_ps(fl, s);
-
-      _mm_store_ps(&z[i], v);
-    }
-  } else {
-    for (; i < len - 3; i += 4) {
-      __m64* ptr = (__m64*)&x[i];
-      __m128 fl  = _mm_cvtpi16_ps(*ptr);
-      __m128 v   = _mm_mul_ps(fl, s);
+  int i = 0;
 
-      _mm_storeu_ps(&z[i], v);
-    }
-  }
-#endif /* LV_HAVE_SSE */
+  const float* x   = (float*)x_;
+  const int    len = len_ * 2;
 
-  for (; i < len; i++) {
-    z[i] = ((float)x[i]) * gain;
+#if SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE
+  srsran_simd_aligned float scale_v[SRSRAN_SIMD_F_SIZE];
+  for (uint32_t j = 0; j < SRSRAN_SIMD_F_SIZE; j++) {
+    scale_v[j] = (j % 2 == 0) ? +scale : -scale;
   }
-}
-
-void srsran_vec_convert_fi_simd(const float* x, int16_t* z, const float scale, const int len)
-{
-  int i = 0;
 
-#if SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE
-  simd_f_t s = srsran_simd_f_set1(scale);
+  simd_f_t s = srsran_simd_f_load(scale_v);
   if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(z)) {
     for (; i < len - SRSRAN_SIMD_S_SIZE + 1; i += SRSRAN_SIMD_S_SIZE) {
       simd_f_t a = srsran_simd_f_load(&x[i]);
@@ -468,10 +449,12 @@ void srsran_vec_convert_fi_simd(const float* x, int16_t* z, const float scale, c
 
   for (; i < len; i++) {
     z[i] = (int16_t)(x[i] * scale);
+    i++;
+    z[i] = (int16_t)(x[i] * -scale);
   }
 }
 
-void srsran_vec_convert_conj_cs_simd(const cf_t* x_, int16_t* z, const float scale, const int len_)
+void srsran_vec_convert_sc_prod_cs_simd(const cf_t* x_, const cf_t h, int16_t* z, const int len_)
 {
   int i = 0;
 
@@ -479,21 +462,23 @@ void srsran_vec_convert_conj_cs_simd(const cf_t* x_, int16_t* z, const float sca
   const int    len = len_ * 2;
 
 #if SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE
-  srsran_simd_aligned float scale_v[SRSRAN_SIMD_F_SIZE];
+  // The complex product is computed as x * re(h) + swap(x) * (-im(h), +im(h)), without add-subtract
+  srsran_simd_aligned float him_v[SRSRAN_SIMD_F_SIZE];
   for (uint32_t j = 0; j < SRSRAN_SIMD_F_SIZE; j++) {
-    scale_v[j] = (j % 2 == 0) ? +scale : -scale;
+    him_v[j] = (j % 2 == 0) ? -__imag__ h : +__imag__ h;
   }
 
-  simd_f_t s = srsran_simd_f_load(scale_v);
+  simd_f_t hre = srsran_simd_f_set1(__real__ h);
+  simd_f_t him = srsran_simd_f_load(him_v);
   if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(z)) {
     for (; i < len - SRSRAN_SIMD_S_SIZE + 1; i += SRSRAN_SIMD_S_SIZE) {
       simd_f_t a = srsran_simd_f_load(&x[i]);
       simd_f_t b = srsran_simd_f_load(&x[i + SRSRAN_SIMD_F_SIZE]);
 
-      simd_f_t sa = srsran_simd_f_mul(a, s);
-      simd_f_t sb = srsran_simd_f_mul(b, s);
+      simd_f_t ha = srsran_simd_f_add(srsran_simd_f_mul(a, hre), srsran_simd_f_mul(srsran_simd_f_swap(a), him));
+      simd_f_t hb = srsran_simd_f_add(srsran_simd_f_mul(b, hre), srsran_simd_f_mul(srsran_simd_f_swap(b), him));
 
-      simd_s_t i16 = srsran_simd_convert_2f_s(sa, sb);
+      simd_s_t i16 = srsran_simd_convert_2f_s(ha, hb);
 
       srsran_simd_s_store(&z[i], i16);
     }
@@ -502,20 +487,20 @@ void srsran_vec_convert_conj_cs_simd(const cf_t* x_, int16_t* z, const float sca
       simd_f_t a = srsran_simd_f_loadu(&x[i]);
       simd_f_t b = srsran_simd_f_loadu(&x[i + SRSRAN_SIMD_F_SIZE]);
 
-      simd_f_t sa = srsran_simd_f_mul(a, s);
-      simd_f_t sb = srsran_simd_f_mul(b, s);
+      simd_f_t ha = srsran_simd_f_add(srsran_simd_f_mul(a, hre), srsran_simd_f_mul(srsran_simd_f_swap(a), him));
+      simd_f_t hb = srsran_simd_f_add(srsran_simd_f_mul(b, hre), srsran_simd_f_mul(srsran_simd_f_swap(b), him));
 
-      simd_s_t i16 = srsran_simd_convert_2f_s(sa, sb);
+      simd_s_t i16 = srsran_simd_convert_2f_s(ha, hb);
 
       srsran_simd_s_storeu(&z[i], i16);
     }
   }
 #endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE */
 
-  for (; i < len; i++) {
-    z[i] = (int16_t)(x[i] * scale);
-    i++;
-    z[i] = (int16_t)(x[i] * -scale);
+  for (; i < len; i += 2) {
+    cf_t r   = x_[i / 2] * h;
+    z[i]     = (int16_t)__real__ r;
+    z[i + 1] = (int16_t)__imag__ r;
   }
 }
 
@@ -932,37 +917,6 @@ void srsran_vec_prod_fff_simd(const float* x, const float* y, float* z, const in
   }
 }
 
-void srsran_vec_prod_ccc_simd(const cf_t* x, const cf_t* y, cf_t* z, const int len)
-{
-  int i = 0;
-
-#if SRSRAN_SIMD_CF_SIZE
-  if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(y) && SRSRAN_IS_ALIGNED(z)) {
-    for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
-      simd_cf_t a = srsran_simd_cfi_load(&x[i]);
-      simd_cf_t b = srsran_simd_cfi_load(&y[i]);
-
-      simd_cf_t r = srsran_simd_cf_prod(a, b);
-
-      srsran_simd_cfi_store(&z[i], r);
-    }
-  } else {
-    for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
-      simd_cf_t a = srsran_simd_cfi_loadu(&x[i]);
-      simd_cf_t b = srsran_simd_cfi_loadu(&y[i]);
-
-      simd_cf_t r = srsran_simd_cf_prod(a, b);
-
-      srsran_simd_cfi_storeu(&z[i], r);
-    }
-  }
-#endif
-
-  for (; i < len; i++) {
-    z[i] = x[i] * y[i];
-  }
-}
-
 void srsran_vec_prod_ccc_split_simd(const float* a_re,
                                     const float* a_im,
                                     const float* b_re,
@@ -1173,66 +1127,6 @@ void srsran_vec_div_fff_simd(const float* x, const float* y, float* z, const int
   }
 }
 
-int srsran_vec_sc_prod_ccc_simd2(const cf_t* x, const cf_t h, cf_t* z, const int len)
-{
-  int                i     = 0;
-  const unsigned int loops = len / 4;
-#ifdef HAVE_NEON
-  simd_cf_t h_vec;
-  h_vec.val[0] = srsran_simd_f_set1(__real__ h);
-  h_vec.val[1] = srsran_simd_f_set1(__imag__ h);
-  for (; i < loops; i++) {
-    simd_cf_t in   = srsran_simd_cfi_load(&x[i * 4]);
-    simd_cf_t temp = srsran_simd_cf_prod(in, h_vec);
-    srsran_simd_cfi_store(&z[i * 4], temp);
-  }
-
-#endif
-  i = loops * 4;
-  return i;
-}
-
-void srsran_vec_sc_prod_ccc_simd(const cf_t* x, const cf_t h, cf_t* z, const int len)
-{
-  int i = 0;
-
-#if SRSRAN_SIMD_F_SIZE
-
-#ifdef HAVE_NEON
-  i = srsran_vec_sc_prod_ccc_simd2(x, h, z, len);
-#else
-  const simd_f_t hre = srsran_simd_f_set1(__real__ h);
-  const simd_f_t him = srsran_simd_f_set1(__imag__ h);
-
-  if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(z)) {
-    for (; i < len - SRSRAN_SIMD_F_SIZE / 2 + 1; i += SRSRAN_SIMD_F_SIZE / 2) {
-      simd_f_t temp = srsran_simd_f_load((float*)&x[i]);
-
-      simd_f_t m1 = srsran_simd_f_mul(hre, temp);
-      simd_f_t sw = srsran_simd_f_swap(temp);
-      simd_f_t m2 = srsran_simd_f_mul(him, sw);
-      simd_f_t r  = srsran_simd_f_addsub(m1, m2);
-      srsran_simd_f_store((float*)&z[i], r);
-    }
-  } else {
-    for (; i < len - SRSRAN_SIMD_F_SIZE / 2 + 1; i += SRSRAN_SIMD_F_SIZE / 2) {
-      simd_f_t temp = srsran_simd_f_loadu((float*)&x[i]);
-
-      simd_f_t m1 = srsran_simd_f_mul(hre, temp);
-      simd_f_t sw = srsran_simd_f_swap(temp);
-      simd_f_t m2 = srsran_simd_f_mul(him, sw);
-      simd_f_t r  = srsran_simd_f_addsub(m1, m2);
-
-      srsran_simd_f_storeu((float*)&z[i], r);
-    }
-  }
-#endif
-#endif
-  for (; i < len; i++) {
-    z[i] = x[i] * h;
-  }
-}
-
 void srsran_vec_sc_prod_fff_simd(const float* x, const float h, float* z, const int len)
 {
   int i = 0;
@@ -1301,71 +1195,33 @@ void srsran_vec_abs_cf_simd(const cf_t* x, float* z, const int len)
   }
 }
 
-void srsran_vec_abs_square_cf_simd(const cf_t* x, float* z, const int len)
+void srsran_vec_gen_clip_env_simd(const float* x_abs, const float thres, const float alpha, float* env, const int len)
 {
   int i = 0;
 
 #if SRSRAN_SIMD_F_SIZE
-  if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(z)) {
-    for (; i < len - SRSRAN_SIMD_F_SIZE + 1; i += SRSRAN_SIMD_F_SIZE) {
-      simd_f_t x1 = srsran_simd_f_load((float*)&x[i]);
-      simd_f_t x2 = srsran_simd_f_load((float*)&x[i + SRSRAN_SIMD_F_SIZE / 2]);
+  const simd_f_t one     = srsran_simd_f_set1(1.0f);
+  const simd_f_t two     = srsran_simd_f_set1(2.0f);
+  const simd_f_t thr     = srsran_simd_f_set1(thres);
+  const simd_f_t a_thr   = srsran_simd_f_set1(alpha * thres);
+  const simd_f_t one_m_a = srsran_simd_f_set1(1.0f - alpha);
 
-      simd_f_t mul1 = srsran_simd_f_mul(x1, x1);
-      simd_f_t mul2 = srsran_simd_f_mul(x2, x2);
+  for (; i < len - SRSRAN_SIMD_F_SIZE + 1; i += SRSRAN_SIMD_F_SIZE) {
+    simd_f_t a = srsran_simd_f_loadu(&x_abs[i]);
 
-      simd_f_t z1 = srsran_simd_f_hadd(mul1, mul2);
+    // Reciprocal estimate refined with one Newton-Raphson iteration, the samples under the threshold are discarded
+    simd_f_t rcp = srsran_simd_f_rcp(a);
+    rcp          = srsran_simd_f_mul(rcp, srsran_simd_f_sub(two, srsran_simd_f_mul(a, rcp)));
 
-      srsran_simd_f_store(&z[i], z1);
-    }
-  } else {
-    for (; i < len - SRSRAN_SIMD_F_SIZE + 1; i += SRSRAN_SIMD_F_SIZE) {
-      simd_f_t x1 = srsran_simd_f_loadu((float*)&x[i]);
-      simd_f_t x2 = srsran_simd_f_loadu((float*)&x[i + SRSRAN_SIMD_F_SIZE / 2]);
+    simd_f_t   clip = srsran_simd_f_add(one_m_a, srsran_simd_f_mul(a_thr, rcp));
+    simd_sel_t sel  = srsran_simd_f_max(a, thr);
 
-      simd_f_t mul1 = srsran_simd_f_mul(x1, x1);
-      simd_f_t mul2 = srsran_simd_f_mul(x2, x2);
-
-      simd_f_t z1 = srsran_simd_f_hadd(mul1, mul2);
-
-      srsran_simd_f_storeu(&z[i], z1);
-    }
+    srsran_simd_f_storeu(&env[i], srsran_simd_f_select(one, clip, sel));
   }
-#endif
+#endif /* SRSRAN_SIMD_F_SIZE */
 
   for (; i < len; i++) {
-    z[i] = __real__(x[i]) * __real__(x[i]) + __imag__(x[i]) * __imag__(x[i]);
-  }
-}
-
-void srsran_vec_sc_prod_cfc_simd(const cf_t* x, const float h, cf_t* z, const int len)
-{
-  int i = 0;
-
-#if SRSRAN_SIMD_F_SIZE
-  const simd_f_t tap = srsran_simd_f_set1(h);
-
-  if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(z)) {
-    for (; i < len - SRSRAN_SIMD_F_SIZE / 2 + 1; i += SRSRAN_SIMD_F_SIZE / 2) {
-      simd_f_t temp = srsran_simd_f_load((float*)&x[i]);
-
-      temp = srsran_simd_f_mul(tap, temp);
-
-      srsran_simd_f_store((float*)&z[i], temp);
-    }
-  } else {
-    for (; i < len - SRSRAN_SIMD_F_SIZE / 2 + 1; i += SRSRAN_SIMD_F_SIZE / 2) {
-      simd_f_t temp = srsran_simd_f_loadu((float*)&x[i]);
-
-      temp = srsran_simd_f_mul(tap, temp);
-
-      srsran_simd_f_storeu((float*)&z[i], temp);
-    }
-  }
-#endif
-
-  for (; i < len; i++) {
-    z[i] = x[i] * h;
+    env[i] = (x_abs[i] > thres) ? (1 - alpha) + alpha * thres / x_abs[i] : 1;
   }
 }
 
@@ -1392,199 +1248,6 @@ void srsran_vec_sc_prod_fcc_simd(const float* x, const cf_t h, cf_t* z, const in
   }
 }
 
-uint32_t srsran_vec_max_fi_simd(const float* x, const int len)
-{
-  int i = 0;
-
-  float    max_value = -INFINITY;
-  uint32_t max_index = 0;
-
-#if SRSRAN_SIMD_I_SIZE
-  srsran_simd_aligned int   indexes_buffer[SRSRAN_SIMD_I_SIZE] = {0};
-  srsran_simd_aligned float values_buffer[SRSRAN_SIMD_I_SIZE]  = {0};
-
-  for (int k = 0; k < SRSRAN_SIMD_I_SIZE; k++)
-    indexes_buffer[k] = k;
-  simd_i_t simd_inc         = srsran_simd_i_set1(SRSRAN_SIMD_I_SIZE);
-  simd_i_t simd_indexes     = srsran_simd_i_load(indexes_buffer);
-  simd_i_t simd_max_indexes = srsran_simd_i_set1(0);
-
-  simd_f_t simd_max_values = srsran_simd_f_set1(-INFINITY);
-
-  if (SRSRAN_IS_ALIGNED(x)) {
-    for (; i < len - SRSRAN_SIMD_I_SIZE + 1; i += SRSRAN_SIMD_I_SIZE) {
-      simd_f_t   a     = srsran_simd_f_load(&x[i]);
-      simd_sel_t res   = srsran_simd_f_max(a, simd_max_values);
-      simd_max_indexes = srsran_simd_i_select(simd_max_indexes, simd_indexes, res);
-      simd_max_values  = srsran_simd_f_select(simd_max_values, a, res);
-      simd_indexes     = srsran_simd_i_add(simd_indexes, simd_inc);
-    }
-  } else {
-    for (; i < len - SRSRAN_SIMD_I_SIZE + 1; i += SRSRAN_SIMD_I_SIZE) {
-      simd_f_t   a     = srsran_simd_f_loadu(&x[i]);
-      simd_sel_t res   = srsran_simd_f_max(a, simd_max_values);
-      simd_max_indexes = srsran_simd_i_select(simd_max_indexes, simd_indexes, res);
-      simd_max_values  = srsran_simd_f_select(simd_max_values, a, res);
-      simd_indexes     = srsran_simd_i_add(simd_indexes, simd_inc);
-    }
-  }
-
-  srsran_simd_i_store(indexes_buffer, simd_max_indexes);
-  srsran_simd_f_store(values_buffer, simd_max_values);
-
-  for (int k = 0; k < SRSRAN_SIMD_I_SIZE; k++) {
-    if (values_buffer[k] > max_value) {
-      max_value = values_buffer[k];
-      max_index = (uint32_t)indexes_buffer[k];
-    }
-  }
-#endif /* SRSRAN_SIMD_I_SIZE */
-
-  for (; i < len; i++) {
-    if (x[i] > max_value) {
-      max_value = x[i];
-      max_index = (uint32_t)i;
-    }
-  }
-
-  return max_index;
-}
-
-uint32_t srsran_vec_max_abs_fi_simd(const float* x, const int len)
-{
-  int i = 0;
-
-  float    max_value = -INFINITY;
-  uint32_t max_index = 0;
-
-#if SRSRAN_SIMD_I_SIZE
-  srsran_simd_aligned int   indexes_buffer[SRSRAN_SIMD_I_SIZE] = {0};
-  srsran_simd_aligned float values_buffer[SRSRAN_SIMD_I_SIZE]  = {0};
-
-  for (int k = 0; k < SRSRAN_SIMD_I_SIZE; k++)
-    indexes_buffer[k] = k;
-  simd_i_t simd_inc         = srsran_simd_i_set1(SRSRAN_SIMD_I_SIZE);
-  simd_i_t simd_indexes     = srsran_simd_i_load(indexes_buffer);
-  simd_i_t simd_max_indexes = srsran_simd_i_set1(0);
-
-  simd_f_t simd_max_values = srsran_simd_f_set1(-INFINITY);
-
-  if (SRSRAN_IS_ALIGNED(x)) {
-    for (; i < len - SRSRAN_SIMD_I_SIZE + 1; i += SRSRAN_SIMD_I_SIZE) {
-      simd_f_t   a     = srsran_simd_f_abs(srsran_simd_f_load(&x[i]));
-      simd_sel_t res   = srsran_simd_f_max(a, simd_max_values);
-      simd_max_indexes = srsran_simd_i_select(simd_max_indexes, simd_indexes, res);
-      simd_max_values  = srsran_simd_f_select(simd_max_values, a, res);
-      simd_indexes     = srsran_simd_i_add(simd_indexes, simd_inc);
-    }
-  } else {
-    for (; i < len - SRSRAN_SIMD_I_SIZE + 1; i += SRSRAN_SIMD_I_SIZE) {
-      simd_f_t   a     = srsran_simd_f_abs(srsran_simd_f_loadu(&x[i]));
-      simd_sel_t res   = srsran_simd_f_max(a, simd_max_values);
-      simd_max_indexes = srsran_simd_i_select(simd_max_indexes, simd_indexes, res);
-      simd_max_values  = srsran_simd_f_select(simd_max_values, a, res);
-      simd_indexes     = srsran_simd_i_add(simd_indexes, simd_inc);
-    }
-  }
-
-  srsran_simd_i_store(indexes_buffer, simd_max_indexes);
-  srsran_simd_f_store(values_buffer, simd_max_values);
-
-  for (int k = 0; k < SRSRAN_SIMD_I_SIZE; k++) {
-    if (values_buffer[k] > max_value) {
-      max_value = values_buffer[k];
-      max_index = (uint32_t)indexes_buffer[k];
-    }
-  }
-#endif /* SRSRAN_SIMD_I_SIZE */
-
-  for (; i < len; i++) {
-    float a = fabsf(x[i]);
-    if (a > max_value) {
-      max_value = a;
-      max_index = (uint32_t)i;
-    }
-  }
-
-  return max_index;
-}
-
-uint32_t srsran_vec_max_ci_simd(const cf_t* x, const int len)
-{
-  int i = 0;
-
-  float    max_value = -INFINITY;
-  uint32_t max_index = 0;
-
-#if SRSRAN_SIMD_I_SIZE
-  srsran_simd_aligned int   indexes_buffer[SRSRAN_SIMD_I_SIZE] = {0};
-  srsran_simd_aligned float values_buffer[SRSRAN_SIMD_I_SIZE]  = {0};
-
-  for (int k = 0; k < SRSRAN_SIMD_I_SIZE; k++)
-    indexes_buffer[k] = k;
-  simd_i_t simd_inc         = srsran_simd_i_set1(SRSRAN_SIMD_I_SIZE);
-  simd_i_t simd_indexes     = srsran_simd_i_load(indexes_buffer);
-  simd_i_t simd_max_indexes = srsran_simd_i_set1(0);
-
-  simd_f_t simd_max_values = srsran_simd_f_set1(-INFINITY);
-
-  if (SRSRAN_IS_ALIGNED(x)) {
-    for (; i < len - SRSRAN_SIMD_I_SIZE + 1; i += SRSRAN_SIMD_I_SIZE) {
-      simd_f_t x1 = srsran_simd_f_load((float*)&x[i]);
-      simd_f_t x2 = srsran_simd_f_load((float*)&x[i + SRSRAN_SIMD_F_SIZE / 2]);
-
-      simd_f_t mul1 = srsran_simd_f_mul(x1, x1);
-      simd_f_t mul2 = srsran_simd_f_mul(x2, x2);
-
-      simd_f_t z1 = srsran_simd_f_hadd(mul1, mul2);
-
-      simd_sel_t res = srsran_simd_f_max(z1, simd_max_values);
-
-      simd_max_indexes = srsran_simd_i_select(simd_max_indexes, simd_indexes, res);
-      simd_max_values  = srsran_simd_f_select(simd_max_values, z1, res);
-      simd_indexes     = srsran_simd_i_add(simd_indexes, simd_inc);
-    }
-  } else {
-    for (; i < len - SRSRAN_SIMD_I_SIZE + 1; i += SRSRAN_SIMD_I_SIZE) {
-      simd_f_t x1 = srsran_simd_f_loadu((float*)&x[i]);
-      simd_f_t x2 = srsran_simd_f_loadu((float*)&x[i + SRSRAN_SIMD_F_SIZE / 2]);
-
-      simd_f_t mul1 = srsran_simd_f_mul(x1, x1);
-      simd_f_t mul2 = srsran_simd_f_mul(x2, x2);
-
-      simd_f_t z1 = srsran_simd_f_hadd(mul1, mul2);
-
-      simd_sel_t res = srsran_simd_f_max(z1, simd_max_values);
-
-      simd_max_indexes = srsran_simd_i_select(simd_max_indexes, simd_indexes, res);
-      simd_max_values  = srsran_simd_f_select(simd_max_values, z1, res);
-      simd_indexes     = srsran_simd_i_add(simd_indexes, simd_inc);
-    }
-  }
-
-  srsran_simd_i_store(indexes_buffer, simd_max_indexes);
-  srsran_simd_f_store(values_buffer, simd_max_values);
-
-  for (int k = 0; k < SRSRAN_SIMD_I_SIZE; k++) {
-    if (values_buffer[k] > max_value) {
-      max_value = values_buffer[k];
-      max_index = (uint32_t)indexes_buffer[k];
-    }
-  }
-#endif /* SRSRAN_SIMD_I_SIZE */
-
-  for (; i < len; i++) {
-    cf_t  a    = x[i];
-    float abs2 = __real__ a * __real__ a + __imag__ a * __imag__ a;
-    if (abs2 > max_value) {
-      max_value = abs2;
-      max_index = (uint32_t)i;
-    }
-  }
-
-  return max_index;
-}
-
 void srsran_vec_interleave_simd(const cf_t* x, const cf_t* y, cf_t* z, const int len)
 {
   uint32_t i = 0, k = 0;
@@ -0,0 +1,64 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file vector_simd_dispatch.h
+ * \brief Table of the vector kernels that are selected at runtime from the CPU features.
+ *
+ * Every instruction set the library carries a version of the kernels for provides one table. The table of the build
+ * instruction set is always present and points to the `_simd` functions, the rest only exist when the library is
+ * configured with ENABLE_SIMD_DISPATCH.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#ifndef SRSRAN_VECTOR_SIMD_DISPATCH_H
+#define SRSRAN_VECTOR_SIMD_DISPATCH_H
+
+#include "srsran/config.h"
+#include <stdint.h>
+
+typedef struct {
+  const char* name;
+  void (*convert_if)(const int16_t* x, float* z, const float scale, const int len);
+  void (*convert_fi)(const float* x, int16_t* z, const float scale, const int len);
+  void (*convert_conj_sc)(const int16_t* x, cf_t* z, const float scale, const int len);
+  void (*prod_ccc)(const cf_t* x, const cf_t* y, cf_t* z, const int len);
+  void (*sc_prod_ccc)(const cf_t* x, const cf_t h, cf_t* z, const int len);
+  void (*sc_prod_cfc)(const cf_t* x, const float h, cf_t* z, const int len);
+  void (*abs_square_cf)(const cf_t* x, float* z, const int len);
+  uint32_t (*max_fi)(const float* x, const int len);
+  uint32_t (*max_abs_fi)(const float* x, const int len);
+  uint32_t (*max_ci)(const cf_t* x, const int len);
+} srsran_vec_simd_kernels_t;
+
+extern const srsran_vec_simd_kernels_t srsran_vec_simd_kernels_simd;
+
+#ifdef SRSRAN_VEC_DISPATCH_AVX2
+extern const srsran_vec_simd_kernels_t srsran_vec_simd_kernels_avx2;
+#endif /* SRSRAN_VEC_DISPATCH_AVX2 */
+
+#ifdef SRSRAN_VEC_DISPATCH_AVX512
+extern const srsran_vec_simd_kernels_t srsran_vec_simd_kernels_avx512;
+#endif /* SRSRAN_VEC_DISPATCH_AVX512 */
+
+#endif // SRSRAN_VECTOR_SIMD_DISPATCH_H
@@ -0,0 +1,534 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file vector_simd_kernels.h
+ * \brief Vector kernels that can be built for several instruction sets.
+ *
+ * The file is included by one source file per instruction set, after simd.h has been included with the matching
+ * LV_HAVE_* definitions. SRSRAN_VEC_KERNEL(NAME) appends the instruction set suffix to every function name and the file
+ * ends with the srsran_vec_simd_kernels_t table pointing to them.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#ifndef SRSRAN_VEC_KERNEL
+#error "SRSRAN_VEC_KERNEL(NAME) must be defined before including vector_simd_kernels.h"
+#endif /* SRSRAN_VEC_KERNEL */
+
+#include "vector_simd_dispatch.h"
+
+#include <complex.h>
+#include <math.h>
+
+#if defined(LV_HAVE_AVX512)
+#define SRSRAN_VEC_KERNEL_ISA "avx512"
+#elif defined(LV_HAVE_AVX2)
+#define SRSRAN_VEC_KERNEL_ISA "avx2"
+#elif defined(LV_HAVE_AVX)
+#define SRSRAN_VEC_KERNEL_ISA "avx"
+#elif defined(LV_HAVE_SSE)
+#define SRSRAN_VEC_KERNEL_ISA "sse"
+#elif defined(HAVE_NEON)
+#define SRSRAN_VEC_KERNEL_ISA "neon"
+#else
+#define SRSRAN_VEC_KERNEL_ISA "generic"
+#endif
+
+void SRSRAN_VEC_KERNEL(srsran_vec_convert_if)(const int16_t* x, float* z, const float scale, const int len)
+{
+  int         i    = 0;
+  const float gain = 1.0f / scale;
+
+#if SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE
+  simd_f_t g = srsran_simd_f_set1(gain);
+  if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(z)) {
+    for (; i < len - SRSRAN_SIMD_S_SIZE + 1; i += SRSRAN_SIMD_S_SIZE) {
+      simd_f_t a, b;
+      srsran_simd_convert_s_2f(srsran_simd_s_load(&x[i]), &a, &b);
+
+      srsran_simd_f_store(&z[i], srsran_simd_f_mul(a, g));
+      srsran_simd_f_store(&z[i + SRSRAN_SIMD_F_SIZE], srsran_simd_f_mul(b, g));
+    }
+  } else {
+    for (; i < len - SRSRAN_SIMD_S_SIZE + 1; i += SRSRAN_SIMD_S_SIZE) {
+      simd_f_t a, b;
+      srsran_simd_convert_s_2f(srsran_simd_s_loadu(&x[i]), &a, &b);
+
+      srsran_simd_f_storeu(&z[i], srsran_simd_f_mul(a, g));
+      srsran_simd_f_storeu(&z[i + SRSRAN_SIMD_F_SIZE], srsran_simd_f_mul(b, g));
+    }
+  }
+#endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE */
+
+  for (; i < len; i++) {
+    z[i] = ((float)x[i]) * gain;
+  }
+}
+
+void SRSRAN_VEC_KERNEL(srsran_vec_convert_conj_sc)(const int16_t* x, cf_t* z_, const float scale, const int len_)
+{
+  int         i    = 0;
+  float*      z    = (float*)z_;
+  const int   len  = len_ * 2;
+  const float gain = 1.0f / scale;
+
+#if SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE
+  // The conjugate is applied with the gain, the imaginary parts are scaled by its opposite
+  srsran_simd_aligned float gain_v[SRSRAN_SIMD_F_SIZE];
+  for (uint32_t j = 0; j < SRSRAN_SIMD_F_SIZE; j++) {
+    gain_v[j] = (j % 2 == 0) ? +gain : -gain;
+  }
+
+  simd_f_t g = srsran_simd_f_load(gain_v);
+  if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(z)) {
+    for (; i < len - SRSRAN_SIMD_S_SIZE + 1; i += SRSRAN_SIMD_S_SIZE) {
+      simd_f_t a, b;
+      srsran_simd_convert_s_2f(srsran_simd_s_load(&x[i]), &a, &b);
+
+      srsran_simd_f_store(&z[i], srsran_simd_f_mul(a, g));
+      srsran_simd_f_store(&z[i + SRSRAN_SIMD_F_SIZE], srsran_simd_f_mul(b, g));
+    }
+  } else {
+    for (; i < len - SRSRAN_SIMD_S_SIZE + 1; i += SRSRAN_SIMD_S_SIZE) {
+      simd_f_t a, b;
+      srsran_simd_convert_s_2f(srsran_simd_s_loadu(&x[i]), &a, &b);
+
+      srsran_simd_f_storeu(&z[i], srsran_simd_f_mul(a, g));
+      srsran_simd_f_storeu(&z[i + SRSRAN_SIMD_F_SIZE], srsran_simd_f_mul(b, g));
+    }
+  }
+#endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE */
+
+  for (; i < len; i += 2) {
+    z[i]     = ((float)x[i]) * gain;
+    z[i + 1] = ((float)x[i + 1]) * -gain;
+  }
+}
+
+void SRSRAN_VEC_KERNEL(srsran_vec_convert_fi)(const float* x, int16_t* z, const float scale, const int len)
+{
+  int i = 0;
+
+#if SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE
+  simd_f_t s = srsran_simd_f_set1(scale);
+  if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(z)) {
+    for (; i < len - SRSRAN_SIMD_S_SIZE + 1; i += SRSRAN_SIMD_S_SIZE) {
+      simd_f_t a = srsran_simd_f_load(&x[i]);
+      simd_f_t b = srsran_simd_f_load(&x[i + SRSRAN_SIMD_F_SIZE]);
+
+      simd_f_t sa = srsran_simd_f_mul(a, s);
+      simd_f_t sb = srsran_simd_f_mul(b, s);
+
+      simd_s_t i16 = srsran_simd_convert_2f_s(sa, sb);
+
+      srsran_simd_s_store(&z[i], i16);
+    }
+  } else {
+    for (; i < len - SRSRAN_SIMD_S_SIZE + 1; i += SRSRAN_SIMD_S_SIZE) {
+      simd_f_t a = srsran_simd_f_loadu(&x[i]);
+      simd_f_t b = srsran_simd_f_loadu(&x[i + SRSRAN_SIMD_F_SIZE]);
+
+      simd_f_t sa = srsran_simd_f_mul(a, s);
+      simd_f_t sb = srsran_simd_f_mul(b, s);
+
+      simd_s_t i16 = srsran_simd_convert_2f_s(sa, sb);
+
+      srsran_simd_s_storeu(&z[i], i16);
+    }
+  }
+#endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE */
+
+  for (; i < len; i++) {
+    z[i] = (int16_t)(x[i] * scale);
+  }
+}
+
+void SRSRAN_VEC_KERNEL(srsran_vec_prod_ccc)(const cf_t* x, const cf_t* y, cf_t* z, const int len)
+{
+  int i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(y) && SRSRAN_IS_ALIGNED(z)) {
+    for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+      simd_cf_t a = srsran_simd_cfi_load(&x[i]);
+      simd_cf_t b = srsran_simd_cfi_load(&y[i]);
+
+      simd_cf_t r = srsran_simd_cf_prod(a, b);
+
+      srsran_simd_cfi_store(&z[i], r);
+    }
+  } else {
+    for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+      simd_cf_t a = srsran_simd_cfi_loadu(&x[i]);
+      simd_cf_t b = srsran_simd_cfi_loadu(&y[i]);
+
+      simd_cf_t r = srsran_simd_cf_prod(a, b);
+
+      srsran_simd_cfi_storeu(&z[i], r);
+    }
+  }
+#endif
+
+  for (; i < len; i++) {
+    z[i] = x[i] * y[i];
+  }
+}
+
+#ifdef HAVE_NEON
+static int srsran_vec_sc_prod_ccc_simd2(const cf_t* x, const cf_t h, cf_t* z, const int len)
+{
+  int                i     = 0;
+  const unsigned int loops = len / 4;
+#ifdef HAVE_NEON
+  simd_cf_t h_vec;
+  h_vec.val[0] = srsran_simd_f_set1(__real__ h);
+  h_vec.val[1] = srsran_simd_f_set1(__imag__ h);
+  for (; i < loops; i++) {
+    simd_cf_t in   = srsran_simd_cfi_load(&x[i * 4]);
+    simd_cf_t temp = srsran_simd_cf_prod(in, h_vec);
+    srsran_simd_cfi_store(&z[i * 4], temp);
+  }
+
+#endif
+  i = loops * 4;
+  return i;
+}
+#endif /* HAVE_NEON */
+
+void SRSRAN_VEC_KERNEL(srsran_vec_sc_prod_ccc)(const cf_t* x, const cf_t h, cf_t* z, const int len)
+{
+  int i = 0;
+
+#if SRSRAN_SIMD_F_SIZE
+
+#ifdef HAVE_NEON
+  i = srsran_vec_sc_prod_ccc_simd2(x, h, z, len);
+#else
+  const simd_f_t hre = srsran_simd_f_set1(__real__ h);
+  const simd_f_t him = srsran_simd_f_set1(__imag__ h);
+
+  if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(z)) {
+    for (; i < len - SRSRAN_SIMD_F_SIZE / 2 + 1; i += SRSRAN_SIMD_F_SIZE / 2) {
+      simd_f_t temp = srsran_simd_f_load((float*)&x[i]);
+
+      simd_f_t m1 = srsran_simd_f_mul(hre, temp);
+      simd_f_t sw = srsran_simd_f_swap(temp);
+      simd_f_t m2 = srsran_simd_f_mul(him, sw);
+      simd_f_t r  = srsran_simd_f_addsub(m1, m2);
+      srsran_simd_f_store((float*)&z[i], r);
+    }
+  } else {
+    for (; i < len - SRSRAN_SIMD_F_SIZE / 2 + 1; i += SRSRAN_SIMD_F_SIZE / 2) {
+      simd_f_t temp = srsran_simd_f_loadu((float*)&x[i]);
+
+      simd_f_t m1 = srsran_simd_f_mul(hre, temp);
+      simd_f_t sw = srsran_simd_f_swap(temp);
+      simd_f_t m2 = srsran_simd_f_mul(him, sw);
+      simd_f_t r  = srsran_simd_f_addsub(m1, m2);
+
+      srsran_simd_f_storeu((float*)&z[i], r);
+    }
+  }
+#endif
+#endif
+  for (; i < len; i++) {
+    z[i] = x[i] * h;
+  }
+}
+
+void SRSRAN_VEC_KERNEL(srsran_vec_abs_square_cf)(const cf_t* x, float* z, const int len)
+{
+  int i = 0;
+
+#if SRSRAN_SIMD_F_SIZE
+  if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(z)) {
+    for (; i < len - SRSRAN_SIMD_F_SIZE + 1; i += SRSRAN_SIMD_F_SIZE) {
+      simd_f_t x1 = srsran_simd_f_load((float*)&x[i]);
+      simd_f_t x2 = srsran_simd_f_load((float*)&x[i + SRSRAN_SIMD_F_SIZE / 2]);
+
+      simd_f_t mul1 = srsran_simd_f_mul(x1, x1);
+      simd_f_t mul2 = srsran_simd_f_mul(x2, x2);
+
+      simd_f_t z1 = srsran_simd_f_hadd(mul1, mul2);
+
+      srsran_simd_f_store(&z[i], z1);
+    }
+  } else {
+    for (; i < len - SRSRAN_SIMD_F_SIZE + 1; i += SRSRAN_SIMD_F_SIZE) {
+      simd_f_t x1 = srsran_simd_f_loadu((float*)&x[i]);
+      simd_f_t x2 = srsran_simd_f_loadu((float*)&x[i + SRSRAN_SIMD_F_SIZE / 2]);
+
+      simd_f_t mul1 = srsran_simd_f_mul(x1, x1);
+      simd_f_t mul2 = srsran_simd_f_mul(x2, x2);
+
+      simd_f_t z1 = srsran_simd_f_hadd(mul1, mul2);
+
+      srsran_simd_f_storeu(&z[i], z1);
+    }
+  }
+#endif
+
+  for (; i < len; i++) {
+    z[i] = __real__(x[i]) * __real__(x[i]) + __imag__(x[i]) * __imag__(x[i]);
+  }
+}
+
+void SRSRAN_VEC_KERNEL(srsran_vec_sc_prod_cfc)(const cf_t* x, const float h, cf_t* z, const int len)
+{
+  int i = 0;
+
+#if SRSRAN_SIMD_F_SIZE
+  const simd_f_t tap = srsran_simd_f_set1(h);
+
+  if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(z)) {
+    for (; i < len - SRSRAN_SIMD_F_SIZE / 2 + 1; i += SRSRAN_SIMD_F_SIZE / 2) {
+      simd_f_t temp = srsran_simd_f_load((float*)&x[i]);
+
+      temp = srsran_simd_f_mul(tap, temp);
+
+      srsran_simd_f_store((float*)&z[i], temp);
+    }
+  } else {
+    for (; i < len - SRSRAN_SIMD_F_SIZE / 2 + 1; i += SRSRAN_SIMD_F_SIZE / 2) {
+      simd_f_t temp = srsran_simd_f_loadu((float*)&x[i]);
+
+      temp = srsran_simd_f_mul(tap, temp);
+
+      srsran_simd_f_storeu((float*)&z[i], temp);
+    }
+  }
+#endif
+
+  for (; i < len; i++) {
+    z[i] = x[i] * h;
+  }
+}
+
+uint32_t SRSRAN_VEC_KERNEL(srsran_vec_max_fi)(const float* x, const int len)
+{
+  int i = 0;
+
+  float    max_value = -INFINITY;
+  uint32_t max_index = 0;
+
+#if SRSRAN_SIMD_I_SIZE
+  srsran_simd_aligned int   indexes_buffer[SRSRAN_SIMD_I_SIZE] = {0};
+  srsran_simd_aligned float values_buffer[SRSRAN_SIMD_I_SIZE]  = {0};
+
+  for (int k = 0; k < SRSRAN_SIMD_I_SIZE; k++)
+    indexes_buffer[k] = k;
+  simd_i_t simd_inc         = srsran_simd_i_set1(SRSRAN_SIMD_I_SIZE);
+  simd_i_t simd_indexes     = srsran_simd_i_load(indexes_buffer);
+  simd_i_t simd_max_indexes = srsran_simd_i_set1(0);
+
+  simd_f_t simd_max_values = srsran_simd_f_set1(-INFINITY);
+
+  if (SRSRAN_IS_ALIGNED(x)) {
+    for (; i < len - SRSRAN_SIMD_I_SIZE + 1; i += SRSRAN_SIMD_I_SIZE) {
+      simd_f_t   a     = srsran_simd_f_load(&x[i]);
+      simd_sel_t res   = srsran_simd_f_max(a, simd_max_values);
+      simd_max_indexes = srsran_simd_i_select(simd_max_indexes, simd_indexes, res);
+      simd_max_values  = srsran_simd_f_select(simd_max_values, a, res);
+      simd_indexes     = srsran_simd_i_add(simd_indexes, simd_inc);
+    }
+  } else {
+    for (; i < len - SRSRAN_SIMD_I_SIZE + 1; i += SRSRAN_SIMD_I_SIZE) {
+      simd_f_t   a     = srsran_simd_f_loadu(&x[i]);
+      simd_sel_t res   = srsran_simd_f_max(a, simd_max_values);
+      simd_max_indexes = srsran_simd_i_select(simd_max_indexes, simd_indexes, res);
+      simd_max_values  = srsran_simd_f_select(simd_max_values, a, res);
+      simd_indexes     = srsran_simd_i_add(simd_indexes, simd_inc);
+    }
+  }
+
+  srsran_simd_i_store(indexes_buffer, simd_max_indexes);
+  srsran_simd_f_store(values_buffer, simd_max_values);
+
+  for (int k = 0; k < SRSRAN_SIMD_I_SIZE; k++) {
+    if (values_buffer[k] > max_value) {
+      max_value = values_buffer[k];
+      max_index = (uint32_t)indexes_buffer[k];
+    }
+  }
+#endif /* SRSRAN_SIMD_I_SIZE */
+
+  for (; i < len; i++) {
+    if (x[i] > max_value) {
+      max_value = x[i];
+      max_index = (uint32_t)i;
+    }
+  }
+
+  return max_index;
+}
+
+uint32_t SRSRAN_VEC_KERNEL(srsran_vec_max_abs_fi)(const float* x, const int len)
+{
+  int i = 0;
+
+  float    max_value = -INFINITY;
+  uint32_t max_index = 0;
+
+#if SRSRAN_SIMD_I_SIZE
+  srsran_simd_aligned int   indexes_buffer[SRSRAN_SIMD_I_SIZE] = {0};
+  srsran_simd_aligned float values_buffer[SRSRAN_SIMD_I_SIZE]  = {0};
+
+  for (int k = 0; k < SRSRAN_SIMD_I_SIZE; k++)
+    indexes_buffer[k] = k;
+  simd_i_t simd_inc         = srsran_simd_i_set1(SRSRAN_SIMD_I_SIZE);
+  simd_i_t simd_indexes     = srsran_simd_i_load(indexes_buffer);
+  simd_i_t simd_max_indexes = srsran_simd_i_set1(0);
+
+  simd_f_t simd_max_values = srsran_simd_f_set1(-INFINITY);
+
+  if (SRSRAN_IS_ALIGNED(x)) {
+    for (; i < len - SRSRAN_SIMD_I_SIZE + 1; i += SRSRAN_SIMD_I_SIZE) {
+      simd_f_t   a     = srsran_simd_f_abs(srsran_simd_f_load(&x[i]));
+      simd_sel_t res   = srsran_simd_f_max(a, simd_max_values);
+      simd_max_indexes = srsran_simd_i_select(simd_max_indexes, simd_indexes, res);
+      simd_max_values  = srsran_simd_f_select(simd_max_values, a, res);
+      simd_indexes     = srsran_simd_i_add(simd_indexes, simd_inc);
+    }
+  } else {
+    for (; i < len - SRSRAN_SIMD_I_SIZE + 1; i += SRSRAN_SIMD_I_SIZE) {
+      simd_f_t   a     = srsran_simd_f_abs(srsran_simd_f_loadu(&x[i]));
+      simd_sel_t res   = srsran_simd_f_max(a, simd_max_values);
+      simd_max_indexes = srsran_simd_i_select(simd_max_indexes, simd_indexes, res);
+      simd_max_values  = srsran_simd_f_select(simd_max_values, a, res);
+      simd_indexes     = srsran_simd_i_add(simd_indexes, simd_inc);
+    }
+  }
+
+  srsran_simd_i_store(indexes_buffer, simd_max_indexes);
+  srsran_simd_f_store(values_buffer, simd_max_values);
+
+  for (int k = 0; k < SRSRAN_SIMD_I_SIZE; k++) {
+    if (values_buffer[k] > max_value) {
+      max_value = values_buffer[k];
+      max_index = (uint32_t)indexes_buffer[k];
+    }
+  }
+#endif /* SRSRAN_SIMD_I_SIZE */
+
+  for (; i < len; i++) {
+    float a = fabsf(x[i]);
+    if (a > max_value) {
+      max_value = a;
+      max_index = (uint32_t)i;
+    }
+  }
+
+  return max_index;
+}
+
+uint32_t SRSRAN_VEC_KERNEL(srsran_vec_max_ci)(const cf_t* x, const int len)
+{
+  int i = 0;
+
+  float    max_value = -INFINITY;
+  uint32_t max_index = 0;
+
+#if SRSRAN_SIMD_I_SIZE
+  srsran_simd_aligned int   indexes_buffer[SRSRAN_SIMD_I_SIZE] = {0};
+  srsran_simd_aligned float values_buffer[SRSRAN_SIMD_I_SIZE]  = {0};
+
+  for (int k = 0; k < SRSRAN_SIMD_I_SIZE; k++)
+    indexes_buffer[k] = k;
+  simd_i_t simd_inc         = srsran_simd_i_set1(SRSRAN_SIMD_I_SIZE);
+  simd_i_t simd_indexes     = srsran_simd_i_load(indexes_buffer);
+  simd_i_t simd_max_indexes = srsran_simd_i_set1(0);
+
+  simd_f_t simd_max_values = srsran_simd_f_set1(-INFINITY);
+
+  if (SRSRAN_IS_ALIGNED(x)) {
+    for (; i < len - SRSRAN_SIMD_I_SIZE + 1; i += SRSRAN_SIMD_I_SIZE) {
+      simd_f_t x1 = srsran_simd_f_load((float*)&x[i]);
+      simd_f_t x2 = srsran_simd_f_load((float*)&x[i + SRSRAN_SIMD_F_SIZE / 2]);
+
+      simd_f_t mul1 = srsran_simd_f_mul(x1, x1);
+      simd_f_t mul2 = srsran_simd_f_mul(x2, x2);
+
+      simd_f_t z1 = srsran_simd_f_hadd(mul1, mul2);
+
+      simd_sel_t res = srsran_simd_f_max(z1, simd_max_values);
+
+      simd_max_indexes = srsran_simd_i_select(simd_max_indexes, simd_indexes, res);
+      simd_max_values  = srsran_simd_f_select(simd_max_values, z1, res);
+      simd_indexes     = srsran_simd_i_add(simd_indexes, simd_inc);
+    }
+  } else {
+    for (; i < len - SRSRAN_SIMD_I_SIZE + 1; i += SRSRAN_SIMD_I_SIZE) {
+      simd_f_t x1 = srsran_simd_f_loadu((float*)&x[i]);
+      simd_f_t x2 = srsran_simd_f_loadu((float*)&x[i + SRSRAN_SIMD_F_SIZE / 2]);
+
+      simd_f_t mul1 = srsran_simd_f_mul(x1, x1);
+      simd_f_t mul2 = srsran_simd_f_mul(x2, x2);
+
+      simd_f_t z1 = srsran_simd_f_hadd(mul1, mul2);
+
+      simd_sel_t res = srsran_simd_f_max(z1, simd_max_values);
+
+      simd_max_indexes = srsran_simd_i_select(simd_max_indexes, simd_indexes, res);
+      simd_max_values  = srsran_simd_f_select(simd_max_values, z1, res);
+      simd_indexes     = srsran_simd_i_add(simd_indexes, simd_inc);
+    }
+  }
+
+  srsran_simd_i_store(indexes_buffer, simd_max_indexes);
+  srsran_simd_f_store(values_buffer, simd_max_values);
+
+  for (int k = 0; k < SRSRAN_SIMD_I_SIZE; k++) {
+    if (values_buffer[k] > max_value) {
+      max_value = values_buffer[k];
+      max_index = (uint32_t)indexes_buffer[k];
+    }
+  }
+#endif /* SRSRAN_SIMD_I_SIZE */
+
+  for (; i < len; i++) {
+    cf_t  a    = x[i];
+    float abs2 = __real__ a * __real__ a + __imag__ a * __imag__ a;
+    if (abs2 > max_value) {
+      max_value = abs2;
+      max_index = (uint32_t)i;
+    }
+  }
+
+  return max_index;
+}
+
+const srsran_vec_simd_kernels_t SRSRAN_VEC_KERNEL(srsran_vec_simd_kernels) = {
+    .name            = SRSRAN_VEC_KERNEL_ISA,
+    .convert_if      = SRSRAN_VEC_KERNEL(srsran_vec_convert_if),
+    .convert_fi      = SRSRAN_VEC_KERNEL(srsran_vec_convert_fi),
+    .convert_conj_sc = SRSRAN_VEC_KERNEL(srsran_vec_convert_conj_sc),
+    .prod_ccc        = SRSRAN_VEC_KERNEL(srsran_vec_prod_ccc),
+    .sc_prod_ccc     = SRSRAN_VEC_KERNEL(srsran_vec_sc_prod_ccc),
+    .sc_prod_cfc     = SRSRAN_VEC_KERNEL(srsran_vec_sc_prod_cfc),
+    .abs_square_cf   = SRSRAN_VEC_KERNEL(srsran_vec_abs_square_cf),
+    .max_fi          = SRSRAN_VEC_KERNEL(srsran_vec_max_fi),
+    .max_abs_fi      = SRSRAN_VEC_KERNEL(srsran_vec_max_abs_fi),
+    .max_ci          = SRSRAN_VEC_KERNEL(srsran_vec_max_ci),
+};
+
+#undef SRSRAN_VEC_KERNEL_ISA
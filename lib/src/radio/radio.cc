@@ -40,6 +40,15 @@ radio::radio()
 
 radio::~radio()
 {
+  for (std::unique_ptr<rx_dev_worker>& w : rx_workers) {
+    w->stop();
+  }
+
+  if (tx_queue_thread != nullptr) {
+    tx_pending.stop();
+    tx_queue_thread->wait_thread_finish();
+  }
+
   for (srsran_resampler_fft_t& q : interpolators) {
     srsran_resampler_fft_free(&q);
   }
@@ -47,6 +56,14 @@ radio::~radio()
   for (srsran_resampler_fft_t& q : decimators) {
     srsran_resampler_fft_free(&q);
   }
+
+  for (srsran_resampler_poly_t& q : poly_interpolators) {
+    srsran_resampler_poly_free(&q);
+  }
+
+  for (srsran_resampler_poly_t& q : poly_decimators) {
+    srsran_resampler_poly_free(&q);
+  }
 }
 
 int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
@@ -138,6 +155,16 @@ int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
     }
   }
 
+  // Receive from every device after the first in a worker of its own
+  for (uint32_t device_idx = 1; device_idx < (uint32_t)rf_devices.size(); device_idx++) {
+    std::unique_ptr<rx_dev_worker> w(new rx_dev_worker(*this, device_idx));
+    if (not w->start(rx_worker_prio)) {
+      logger.error("Error starting Rx thread of RF device %d", device_idx);
+      return SRSRAN_ERROR;
+    }
+    rx_workers.push_back(std::move(w));
+  }
+
   is_start_of_burst = true;
   is_initialized    = true;
 
@@ -222,6 +249,28 @@ int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
   // Frequency offset
   freq_offset = args.freq_offset;
 
+  // Allocate the Tx queue slots for a subframe at the maximum rate, or the resampling buffer size if it is larger
+  if (args.tx_queue_size > 0) {
+    size_t slot_sz = std::max((size_t)SRSRAN_SF_LEN_MAX, tx_buffer[0].size());
+    tx_free_slots.set_size(args.tx_queue_size);
+    tx_pending.set_size(args.tx_queue_size);
+    for (uint32_t i = 0; i < args.tx_queue_size; i++) {
+      std::unique_ptr<tx_slot_t> slot(new tx_slot_t);
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        slot->samples[ch].resize(slot_sz);
+      }
+      tx_free_slots.try_push(slot.get());
+      tx_slots.push_back(std::move(slot));
+    }
+
+    tx_queue_thread.reset(new tx_queue_worker(*this));
+    if (not tx_queue_thread->start(tx_queue_prio)) {
+      logger.error("Error starting Tx queue thread");
+      tx_queue_thread = nullptr;
+      return SRSRAN_ERROR;
+    }
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -232,6 +281,19 @@ bool radio::is_init()
 
 void radio::stop()
 {
+  for (std::unique_ptr<rx_dev_worker>& w : rx_workers) {
+    w->stop();
+  }
+  rx_workers.clear();
+
+  // The queued transmissions are discarded
+  if (tx_queue_thread != nullptr) {
+    tx_free_slots.stop();
+    tx_pending.stop();
+    tx_queue_thread->wait_thread_finish();
+    tx_queue_thread = nullptr;
+  }
+
   // Stop Rx streams as soon as possible to avoid Overflows
   if (radio_is_streaming) {
     for (srsran_rf_t& rf_device : rf_devices) {
@@ -296,24 +358,31 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
   // Extract decimation ratio. As the decimation may take some time to set a new ratio, deactivate the decimation and
   // keep receiving samples to avoid stalling the RX stream
   uint32_t ratio = 1; // No decimation by default
+  bool     poly  = false;
   if (decimator_busy) {
     lock.unlock();
   } else if (decimators[0].ratio > 1) {
     ratio = decimators[0].ratio;
+  } else if (poly_decimators[0].bank != nullptr) {
+    poly = true;
   }
 
   // Calculate number of samples, considering the decimation ratio
   uint32_t nof_samples = buffer.get_nof_samples() * ratio;
+  if (poly) {
+    nof_samples = srsran_resampler_poly_get_nof_input(&poly_decimators[0], buffer.get_nof_samples());
+  }
+  bool decimate = ratio > 1 || poly;
 
   // Check decimation buffer protection
-  if (ratio > 1 && nof_samples > rx_buffer[0].size()) {
+  if (decimate && nof_samples > rx_buffer[0].size()) {
     // This is a corner case that could happen during sample rate change transitions, as it does not have a negative
     // impact, log it as info.
     fmt::memory_buffer buff;
     fmt::format_to(buff,
                    "Rx number of samples ({}/{}) exceeds buffer size ({})",
                    buffer.get_nof_samples(),
-                   buffer.get_nof_samples() * ratio,
+                   nof_samples,
                    rx_buffer[0].size());
     logger.info("%s", to_c_str(buff));
 
@@ -327,7 +396,7 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
   // If the interpolator have been set, interpolate
   for (uint32_t ch = 0; ch < nof_channels; ch++) {
     // Use rx buffer if decimator is required
-    buffer_rx.set(ch, ratio > 1 ? rx_buffer[ch].data() : buffer.get(ch));
+    buffer_rx.set(ch, decimate ? rx_buffer[ch].data() : buffer.get(ch));
   }
 
   if (not radio_is_streaming) {
@@ -344,16 +413,62 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
     }
   }
 
-  for (uint32_t device_idx = 0; device_idx < (uint32_t)rf_devices.size(); device_idx++) {
-    ret &= rx_dev(device_idx, buffer_rx, rxd_time.get_ptr(device_idx));
+  // Every logical channel is decimated with the device receiving it, the unallocated ones with the first device
+  rx_job_t job  = {};
+  job.buffer    = &buffer;
+  job.buffer_rx = &buffer_rx;
+  job.rxd_time  = &rxd_time;
+  job.ratio     = ratio;
+  job.poly      = poly;
+  for (uint32_t ch = 0; ch < nof_channels; ch++) {
+    uint32_t carrier_idx = ch / nof_antennas;
+    if (rx_channel_mapping.is_allocated(carrier_idx)) {
+      uint32_t device_idx = rx_channel_mapping.get_device_mapping(carrier_idx, ch % nof_antennas).device_idx;
+      job.ch_device[ch]   = (device_idx < rf_devices.size()) ? device_idx : 0;
+    }
   }
 
-  // Perform decimation
-  if (ratio > 1) {
-    for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      if (buffer.get(ch) and buffer_rx.get(ch)) {
-        srsran_resampler_fft_run(&decimators[ch], buffer_rx.get(ch), buffer.get(ch), buffer_rx.get_nof_samples());
-      }
+  // The first device is received in this thread while the workers receive the others
+  for (std::unique_ptr<rx_dev_worker>& w : rx_workers) {
+    w->start_rx(job);
+  }
+  ret &= rx_dev_decimate(0, job);
+  for (std::unique_ptr<rx_dev_worker>& w : rx_workers) {
+    ret &= w->wait_rx();
+  }
+
+  // The end of the reception is the radio time the queued transmissions are compared with
+  if (tx_queue_thread != nullptr and std::isnormal(cur_rx_srate)) {
+    srsran_timestamp_t rx_end = rxd_time.get(0);
+    srsran_timestamp_add(&rx_end, 0, (double)buffer_rx.get_nof_samples() / cur_rx_srate);
+
+    std::lock_guard<std::mutex> queue_lock(tx_queue_mutex);
+    tx_queue_rx_time       = rx_end;
+    tx_queue_rx_time_valid = true;
+  }
+
+  return ret;
+}
+
+bool radio::rx_dev_decimate(uint32_t device_idx, const rx_job_t& job)
+{
+  bool ret = rx_dev(device_idx, *job.buffer_rx, job.rxd_time->get_ptr(device_idx));
+
+  for (uint32_t ch = 0; ch < nof_channels; ch++) {
+    if (job.ch_device[ch] != device_idx) {
+      continue;
+    }
+
+    // Perform decimation
+    if (job.ratio > 1 and job.buffer->get(ch) and job.buffer_rx->get(ch)) {
+      srsran_resampler_fft_run(
+          &decimators[ch], job.buffer_rx->get(ch), job.buffer->get(ch), job.buffer_rx->get_nof_samples());
+    }
+
+    // Perform fractional decimation, all channels run to keep the same internal state
+    if (job.poly) {
+      srsran_resampler_poly_run(
+          &poly_decimators[ch], job.buffer_rx->get(ch), job.buffer->get(ch), job.buffer_rx->get_nof_samples());
     }
   }
 
@@ -371,9 +486,10 @@ bool radio::rx_dev(const uint32_t& device_idx, const rf_buffer_interface& buffer
 
   void* radio_buffers[SRSRAN_MAX_CHANNELS] = {};
 
-  // Discard channels not allocated, need to point to valid buffer
+  // Discard channels not allocated, need to point to valid buffer. Each device discards into its own buffers, as the
+  // devices receive concurrently
   for (uint32_t i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
-    radio_buffers[i] = dummy_buffers[i].data();
+    radio_buffers[i] = dummy_buffers[(device_idx * nof_channels_x_dev + i) % SRSRAN_MAX_CHANNELS].data();
   }
 
   if (not map_channels(rx_channel_mapping, device_idx, 0, buffer, radio_buffers)) {
@@ -419,9 +535,119 @@ bool radio::rx_dev(const uint32_t& device_idx, const rf_buffer_interface& buffer
 
 bool radio::tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_time)
 {
-  bool                         ret = true;
+  // Hand over the transmission to the Tx thread if the queue is enabled
+  if (tx_queue_thread != nullptr) {
+    return tx_enqueue(buffer, tx_time);
+  }
+
   std::unique_lock<std::mutex> lock(tx_mutex);
-  uint32_t                     ratio = interpolators[0].ratio;
+  return tx_nolock(buffer, tx_time);
+}
+
+bool radio::tx_enqueue(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_time)
+{
+  tx_slot_t* slot = nullptr;
+
+  // Never wait for the Tx thread, drop the transmission if it is not keeping up
+  if (not tx_free_slots.try_pop(slot)) {
+    logger.info("Tx queue full, dropping transmission of %d samples", buffer.get_nof_samples());
+    std::lock_guard<std::mutex> lock(metrics_mutex);
+    rf_metrics.tx_queue_drop++;
+    rf_metrics.rf_error = true;
+    return false;
+  }
+
+  // Limit number of samples to the slot size
+  uint32_t nof_samples = buffer.get_nof_samples();
+  if (nof_samples > slot->samples[0].size()) {
+    logger.info("Tx number of samples (%d) exceeds queue slot size (%zd)", nof_samples, slot->samples[0].size());
+    nof_samples = slot->samples[0].size();
+  }
+
+  // Copy the samples, the caller reuses its buffers as soon as this returns
+  for (uint32_t ch = 0; ch < nof_channels; ch++) {
+    cf_t* ptr = buffer.get(ch);
+    if (ptr != nullptr) {
+      srsran_vec_cf_copy(slot->samples[ch].data(), ptr, nof_samples);
+      ptr = slot->samples[ch].data();
+    }
+    slot->buffer.set(ch, ptr);
+  }
+  slot->buffer.set_nof_samples(nof_samples);
+  slot->tx_time.copy(tx_time);
+  slot->end_of_burst = false;
+
+  // There are as many pending places as slots, it does not block
+  if (not tx_pending.try_push(slot)) {
+    tx_free_slots.try_push(slot);
+    return false;
+  }
+
+  // Track the queue depth
+  uint32_t depth = tx_pending.size();
+  {
+    std::lock_guard<std::mutex> lock(metrics_mutex);
+    rf_metrics.tx_queue_max = SRSRAN_MAX(rf_metrics.tx_queue_max, depth);
+  }
+
+  return true;
+}
+
+void radio::tx_queue_run()
+{
+  while (true) {
+    bool       success = false;
+    tx_slot_t* slot    = tx_pending.pop_blocking(&success);
+    if (not success) {
+      // Stopped
+      break;
+    }
+
+    if (slot->end_of_burst) {
+      std::unique_lock<std::mutex> lock(tx_mutex);
+      tx_end_nolock();
+      tx_free_slots.try_push(slot);
+      continue;
+    }
+
+    // Time left until the transmission is due, measured from the end of the last reception
+    bool   valid    = false;
+    double slack_us = 0.0;
+    {
+      std::lock_guard<std::mutex> lock(tx_queue_mutex);
+      if (tx_queue_rx_time_valid) {
+        srsran_timestamp_t slack = slot->tx_time.get(0);
+        srsran_timestamp_sub(&slack, tx_queue_rx_time.full_secs, tx_queue_rx_time.frac_secs);
+        slack_us = srsran_timestamp_real(&slack) * 1e6;
+        valid    = true;
+
+        tx_slack_min_us = (tx_slack_count == 0) ? slack_us : SRSRAN_MIN(tx_slack_min_us, slack_us);
+        tx_slack_sum_us += slack_us;
+        tx_slack_count++;
+      }
+    }
+
+    if (valid and slack_us < 0.0) {
+      // The radio has already passed the transmission time, sending it would only delay the next ones
+      logger.info("Tx queue dropping late transmission (%.1f us)", -slack_us);
+      std::lock_guard<std::mutex> lock(metrics_mutex);
+      rf_metrics.tx_queue_late++;
+      rf_metrics.rf_error = true;
+    } else {
+      std::unique_lock<std::mutex> lock(tx_mutex);
+      if (not tx_nolock(slot->buffer, slot->tx_time)) {
+        logger.info("Error transmitting queued samples");
+      }
+    }
+
+    tx_free_slots.try_push(slot);
+  }
+}
+
+bool radio::tx_nolock(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_time)
+{
+  bool     ret   = true;
+  uint32_t ratio = interpolators[0].ratio;
 
   // Get number of samples at the low rate
   uint32_t nof_samples = buffer.get_nof_samples();
@@ -454,6 +680,21 @@ bool radio::tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_tim
 
     // Set buffer size after applying the interpolation
     buffer.set_nof_samples(nof_samples * ratio);
+  } else if (poly_interpolators[0].bank != nullptr) {
+    const srsran_resampler_poly_t& q = poly_interpolators[0];
+
+    // Limit number of samples to transmit, the fractional interpolator produces at most one extra sample
+    nof_samples = SRSRAN_MIN(nof_samples, (uint32_t)((tx_buffer[0].size() - 1) * q.decim / q.interp));
+
+    // The number of output samples depends on the interpolator state, which is the same in all channels
+    uint32_t nof_out = 0;
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      nof_out = srsran_resampler_poly_run(&poly_interpolators[ch], buffer.get(ch), tx_buffer[ch].data(), nof_samples);
+      buffer.set(ch, tx_buffer[ch].data());
+    }
+
+    // Set buffer size after applying the interpolation
+    buffer.set_nof_samples(nof_out);
   }
 
   for (uint32_t device_idx = 0; device_idx < (uint32_t)rf_devices.size(); device_idx++) {
@@ -627,6 +868,17 @@ bool radio::tx_dev(const uint32_t& device_idx, rf_buffer_interface& buffer, cons
 
 void radio::tx_end()
 {
+  // The end of burst is queued after the pending transmissions, it waits for a free slot if there is none
+  if (tx_queue_thread != nullptr) {
+    bool       success = false;
+    tx_slot_t* slot    = tx_free_slots.pop_blocking(&success);
+    if (success) {
+      slot->end_of_burst = true;
+      tx_pending.try_push(slot);
+    }
+    return;
+  }
+
   std::unique_lock<std::mutex> lock(tx_mutex);
   tx_end_nolock();
 }
@@ -746,17 +998,31 @@ void radio::set_rx_srate(const double& srate)
       }
     }
 
-    // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_rx_srate % (uint32_t)srate) == 0,
-                  "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
+    // Assert the radio rate is not lower than the requested rate
+    srsran_assert(cur_rx_srate >= srate,
+                  "The sampling rate ratio is lower than one (%.2f MHz / %.2f MHz = %.3f)",
                   cur_rx_srate / 1e6,
                   srate / 1e6,
                   cur_rx_srate / srate);
 
-    // Update decimators
-    uint32_t ratio = (uint32_t)ceil(cur_rx_srate / srate);
-    for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+    if (((uint32_t)cur_rx_srate % (uint32_t)srate) == 0) {
+      // Update decimators
+      uint32_t ratio = (uint32_t)ceil(cur_rx_srate / srate);
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_poly_free(&poly_decimators[ch]);
+        srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+      }
+    } else {
+      // Fractional ratio, disable the FFT decimators and use the polyphase ones
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, 1);
+        int err = srsran_resampler_poly_init(&poly_decimators[ch], (uint32_t)srate, (uint32_t)cur_rx_srate);
+        srsran_assert(err == SRSRAN_SUCCESS,
+                      "Unsupported sampling rate ratio (%.2f MHz / %.2f MHz = %.3f)",
+                      cur_rx_srate / 1e6,
+                      srate / 1e6,
+                      cur_rx_srate / srate);
+      }
     }
 
     decimator_busy = false;
@@ -1002,17 +1268,31 @@ void radio::set_tx_srate(const double& srate)
       }
     }
 
-    // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_tx_srate % (uint32_t)srate) == 0,
-                  "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
-                  cur_rx_srate / 1e6,
+    // Assert the radio rate is not lower than the requested rate
+    srsran_assert(cur_tx_srate >= srate,
+                  "The sampling rate ratio is lower than one (%.2f MHz / %.2f MHz = %.3f)",
+                  cur_tx_srate / 1e6,
                   srate / 1e6,
-                  cur_rx_srate / srate);
-
-    // Update interpolators
-    uint32_t ratio = (uint32_t)ceil(cur_tx_srate / srate);
-    for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+                  cur_tx_srate / srate);
+
+    if (((uint32_t)cur_tx_srate % (uint32_t)srate) == 0) {
+      // Update interpolators
+      uint32_t ratio = (uint32_t)ceil(cur_tx_srate / srate);
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_poly_free(&poly_interpolators[ch]);
+        srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+      }
+    } else {
+      // Fractional ratio, disable the FFT interpolators and use the polyphase ones
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, 1);
+        int err = srsran_resampler_poly_init(&poly_interpolators[ch], (uint32_t)cur_tx_srate, (uint32_t)srate);
+        srsran_assert(err == SRSRAN_SUCCESS,
+                      "Unsupported sampling rate ratio (%.2f MHz / %.2f MHz = %.3f)",
+                      cur_tx_srate / 1e6,
+                      srate / 1e6,
+                      cur_tx_srate / srate);
+      }
     }
   } else {
     for (srsran_rf_t& rf_device : rf_devices) {
@@ -1042,6 +1322,16 @@ bool radio::get_metrics(rf_metrics_t* metrics)
   std::lock_guard<std::mutex> lock(metrics_mutex);
   *metrics   = rf_metrics;
   rf_metrics = {};
+
+  // Slack of the transmissions taken by the Tx thread since the last call
+  std::lock_guard<std::mutex> queue_lock(tx_queue_mutex);
+  if (tx_slack_count > 0) {
+    metrics->tx_slack_min_us = (float)tx_slack_min_us;
+    metrics->tx_slack_avg_us = (float)(tx_slack_sum_us / tx_slack_count);
+  }
+  tx_slack_min_us = 0.0;
+  tx_slack_sum_us = 0.0;
+  tx_slack_count  = 0;
   return true;
 }
 
@@ -1163,4 +1453,55 @@ bool radio::config_rf_channels(const rf_args_t& args)
   return true;
 }
 
+radio::rx_dev_worker::rx_dev_worker(radio& parent_, uint32_t device_idx_) :
+  srsran::thread("RADIO_RX" + std::to_string(device_idx_)), parent(parent_), device_idx(device_idx_)
+{}
+
+void radio::rx_dev_worker::stop()
+{
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    running = false;
+  }
+  cvar.notify_all();
+  wait_thread_finish();
+}
+
+void radio::rx_dev_worker::start_rx(const rx_job_t& job_)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  job  = &job_;
+  done = false;
+  cvar.notify_all();
+}
+
+bool radio::rx_dev_worker::wait_rx()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  cvar.wait(lock, [this]() { return done or not running; });
+  return done and ret;
+}
+
+void radio::rx_dev_worker::run_thread()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while (running) {
+    if (job == nullptr) {
+      cvar.wait(lock);
+      continue;
+    }
+
+    // Receive without holding the lock, the job stays valid until wait_rx returns
+    const rx_job_t* current = job;
+    lock.unlock();
+    bool r = parent.rx_dev_decimate(device_idx, *current);
+    lock.lock();
+
+    job  = nullptr;
+    ret  = r;
+    done = true;
+    cvar.notify_all();
+  }
+}
+
 } // namespace srsran
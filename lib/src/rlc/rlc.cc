@@ -20,6 +20,7 @@
  */
 
 #include "srsran/rlc/rlc.h"
+#include "srsran/common/common_lte.h"
 #include "srsran/common/rwlock_guard.h"
 #include "srsran/rlc/rlc_am_base.h"
 #include "srsran/rlc/rlc_tm.h"
@@ -74,6 +75,7 @@ void rlc::reset_metrics()
 {
   for (rlc_map_t::iterator it = rlc_array.begin(); it != rlc_array.end(); ++it) {
     it->second->reset_metrics();
+    it->second->reset_latency_metrics();
   }
 
   for (rlc_map_t::iterator it = rlc_array_mrb.begin(); it != rlc_array_mrb.end(); ++it) {
@@ -99,6 +101,7 @@ void rlc::get_metrics(rlc_metrics_t& m, const uint32_t nof_tti)
 
   for (rlc_map_t::iterator it = rlc_array.begin(); it != rlc_array.end(); ++it) {
     rlc_bearer_metrics_t metrics = it->second->get_metrics();
+    it->second->get_latency_metrics(metrics);
 
     // Rx/Tx rate based on real time
     double rx_rate_mbps_real_time = (metrics.num_rx_pdu_bytes * 8 / (double)1e6) / secs.count();
@@ -190,6 +193,7 @@ void rlc::write_sdu(uint32_t lcid, unique_byte_buffer_t sdu)
   }
 
   if (valid_lcid(lcid)) {
+    sdu->md.queue_tp.set_timestamp();
     rlc_array.at(lcid)->write_sdu_s(std::move(sdu));
     update_bsr(lcid);
   } else {
@@ -197,6 +201,31 @@ void rlc::write_sdu(uint32_t lcid, unique_byte_buffer_t sdu)
   }
 }
 
+void rlc::write_sdus(uint32_t lcid, span<unique_byte_buffer_t> sdus)
+{
+  if (not valid_lcid(lcid)) {
+    logger.warning("RLC LCID %d doesn't exist. Deallocating %zd SDUs", lcid, sdus.size());
+    return;
+  }
+
+  // Drop the too long SDUs and keep the others in order
+  size_t nof_sdus = 0;
+  for (size_t i = 0; i < sdus.size(); ++i) {
+    if (sdus[i]->N_bytes > RLC_MAX_SDU_SIZE) {
+      logger.warning("Dropping too long SDU of size %d B (Max. size %d B).", sdus[i]->N_bytes, RLC_MAX_SDU_SIZE);
+      continue;
+    }
+    sdus[i]->md.queue_tp.set_timestamp();
+    if (i != nof_sdus) {
+      sdus[nof_sdus] = std::move(sdus[i]);
+    }
+    nof_sdus++;
+  }
+
+  rlc_array.at(lcid)->write_sdus_s(sdus.first(nof_sdus));
+  update_bsr(lcid);
+}
+
 void rlc::write_sdu_mch(uint32_t lcid, unique_byte_buffer_t sdu)
 {
   if (valid_lcid_mrb(lcid)) {
@@ -325,6 +354,12 @@ void rlc::write_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
   }
 }
 
+void rlc::write_pdu_locked(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
+{
+  rwlock_read_guard lock(rwlock);
+  write_pdu(lcid, payload, nof_bytes);
+}
+
 // Pass directly to PDCP, no DL througput counting done
 void rlc::write_pdu_bcch_bch(srsran::unique_byte_buffer_t pdu)
 {
@@ -449,6 +484,11 @@ int rlc::add_bearer(uint32_t lcid, const rlc_config_t& cnfg)
 
   rlc_entity->set_bsr_callback(bsr_callback);
 
+  // The SRBs are left out of the UE budget, so that the signalling is not dropped behind the user data
+  if (tx_budget.get_max_bytes() > 0 and is_lte_drb(lcid)) {
+    rlc_entity->set_tx_budget(&tx_budget);
+  }
+
   if (not rlc_array.insert(rlc_map_pair_t(lcid, std::move(rlc_entity))).second) {
     logger.error("Error inserting RLC entity in to array.");
     return SRSRAN_ERROR;
@@ -136,9 +136,18 @@ void rlc_am::write_sdu(unique_byte_buffer_t sdu)
 {
   uint32_t nof_bytes = sdu->N_bytes;
   if (tx_base->write_sdu(std::move(sdu)) == SRSRAN_SUCCESS) {
-    std::lock_guard<std::mutex> lock(metrics_mutex);
-    metrics.num_tx_sdus++;
-    metrics.num_tx_sdu_bytes += nof_bytes;
+    num_tx_sdus.fetch_add(1, std::memory_order_relaxed);
+    num_tx_sdu_bytes.fetch_add(nof_bytes, std::memory_order_relaxed);
+  }
+}
+
+void rlc_am::write_sdus(span<unique_byte_buffer_t> sdus)
+{
+  uint32_t nof_sdus = 0, nof_bytes = 0;
+  tx_base->write_sdus(sdus, nof_sdus, nof_bytes);
+  if (nof_sdus > 0) {
+    num_tx_sdus.fetch_add(nof_sdus, std::memory_order_relaxed);
+    num_tx_sdu_bytes.fetch_add(nof_bytes, std::memory_order_relaxed);
   }
 }
 
@@ -155,6 +164,11 @@ bool rlc_am::sdu_queue_is_full()
   return tx_base->sdu_queue_is_full();
 }
 
+void rlc_am::set_tx_budget(byte_buffer_budget* budget)
+{
+  tx_base->set_tx_budget(budget);
+}
+
 /****************************************************************************
  * MAC interface
  ***************************************************************************/
@@ -177,10 +191,10 @@ void rlc_am::get_buffer_state(uint32_t& n_bytes_newtx, uint32_t& n_bytes_prio)
 uint32_t rlc_am::read_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   uint32_t read_bytes = tx_base->read_pdu(payload, nof_bytes);
-
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  metrics.num_tx_pdus += read_bytes > 0 ? 1 : 0;
-  metrics.num_tx_pdu_bytes += read_bytes;
+  if (read_bytes > 0) {
+    num_tx_pdus.fetch_add(1, std::memory_order_relaxed);
+    num_tx_pdu_bytes.fetch_add(read_bytes, std::memory_order_relaxed);
+  }
   return read_bytes;
 }
 
@@ -205,13 +219,24 @@ rlc_bearer_metrics_t rlc_am::get_metrics()
   std::lock_guard<std::mutex> lock(metrics_mutex);
   metrics.rx_latency_ms     = latency;
   metrics.rx_buffered_bytes = buffered_bytes;
-  return metrics;
+
+  rlc_bearer_metrics_t ret = metrics;
+  ret.mem_bytes            = sizeof(*this) + tx_base->get_memory_usage() + rx_base->get_memory_usage();
+  ret.num_tx_sdus += num_tx_sdus.load(std::memory_order_relaxed);
+  ret.num_tx_sdu_bytes += num_tx_sdu_bytes.load(std::memory_order_relaxed);
+  ret.num_tx_pdus += num_tx_pdus.load(std::memory_order_relaxed);
+  ret.num_tx_pdu_bytes += num_tx_pdu_bytes.load(std::memory_order_relaxed);
+  return ret;
 }
 
 void rlc_am::reset_metrics()
 {
   std::lock_guard<std::mutex> lock(metrics_mutex);
   metrics = {};
+  num_tx_sdus.store(0, std::memory_order_relaxed);
+  num_tx_sdu_bytes.store(0, std::memory_order_relaxed);
+  num_tx_pdus.store(0, std::memory_order_relaxed);
+  num_tx_pdu_bytes.store(0, std::memory_order_relaxed);
 }
 
 /****************************************************************************
@@ -234,7 +259,28 @@ int rlc_am::rlc_am_base_tx::write_sdu(unique_byte_buffer_t sdu)
   if (!tx_enabled) {
     return SRSRAN_ERROR;
   }
+  return queue_sdu(std::move(sdu));
+}
+
+// Enqueues the burst of SDUs holding the TX lock once
+void rlc_am::rlc_am_base_tx::write_sdus(span<unique_byte_buffer_t> sdus, uint32_t& nof_sdus, uint32_t& nof_bytes)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if (!tx_enabled) {
+    return;
+  }
+  for (unique_byte_buffer_t& sdu : sdus) {
+    uint32_t sdu_bytes = sdu != nullptr ? sdu->N_bytes : 0;
+    if (queue_sdu(std::move(sdu)) == SRSRAN_SUCCESS) {
+      nof_sdus++;
+      nof_bytes += sdu_bytes;
+    }
+  }
+}
 
+int rlc_am::rlc_am_base_tx::queue_sdu(unique_byte_buffer_t sdu)
+{
   if (sdu.get() == nullptr) {
     RlcWarning("NULL SDU pointer in write_sdu()");
     return SRSRAN_ERROR;
@@ -293,6 +339,11 @@ bool rlc_am::rlc_am_base_tx::sdu_queue_is_full()
   return tx_sdu_queue.is_full();
 }
 
+void rlc_am::rlc_am_base_tx::set_tx_budget(byte_buffer_budget* budget)
+{
+  tx_sdu_queue.set_budget(budget);
+}
+
 void rlc_am::rlc_am_base_tx::set_bsr_callback(bsr_callback_t callback)
 {
   bsr_callback = callback;
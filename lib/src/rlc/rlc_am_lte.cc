@@ -45,6 +45,7 @@ rlc_am_lte_tx::rlc_am_lte_tx(rlc_am* parent_) :
   pool(byte_buffer_pool::get_instance()),
   poll_retx_timer(parent_->timers->get_unique_timer()),
   status_prohibit_timer(parent_->timers->get_unique_timer()),
+  deferred_work_timer(parent_->timers->get_unique_timer()),
   rlc_am_base_tx(parent_->logger)
 {
   rx = dynamic_cast<rlc_am_lte_rx*>(parent->rx_base.get());
@@ -67,7 +68,7 @@ bool rlc_am_lte_tx::configure(const rlc_config_t& cfg_)
   cfg = cfg_.am;
 
   // check timers
-  if (not poll_retx_timer.is_valid() or not status_prohibit_timer.is_valid()) {
+  if (not poll_retx_timer.is_valid() or not status_prohibit_timer.is_valid() or not deferred_work_timer.is_valid()) {
     RlcError("Configuring RLC AM TX: timers not configured");
     return false;
   }
@@ -82,9 +83,13 @@ bool rlc_am_lte_tx::configure(const rlc_config_t& cfg_)
     poll_retx_timer.set(static_cast<uint32_t>(cfg.t_poll_retx), [this](uint32_t timerid) { timer_expired(timerid); });
   }
 
+  // the work left by other threads runs in the next tick of the timers
+  deferred_work_timer.set(1, [this](uint32_t timerid) { timer_expired(timerid); });
+
   // make sure Tx queue is empty before attempting to resize
   empty_queue_nolock();
-  tx_sdu_queue.resize(cfg_.tx_queue_length);
+  tx_sdu_ring.resize(cfg_.tx_queue_length);
+  discard_queue.set_size(cfg_.tx_queue_length);
 
   tx_enabled = true;
 
@@ -111,6 +116,15 @@ void rlc_am_lte_tx::stop_nolock()
     status_prohibit_timer.stop();
   }
 
+  // Drop the deferred work
+  unique_byte_buffer_t status_pdu;
+  while (status_pdu_queue.try_pop(status_pdu)) {
+  }
+  uint32_t discard_sn;
+  while (discard_queue.try_pop(discard_sn)) {
+  }
+  poll_retx_expired = false;
+
   vt_a    = 0;
   vt_ms   = RLC_AM_WINDOW_SIZE;
   vt_s    = 0;
@@ -119,8 +133,9 @@ void rlc_am_lte_tx::stop_nolock()
   pdu_without_poll  = 0;
   byte_without_poll = 0;
 
-  // Drop all messages in TX window
+  // Drop all messages in TX window and the SDUs they refer to
   tx_window.clear();
+  tx_sdu_stream.clear();
 
   // Drop all messages in RETX queue
   retx_queue.clear();
@@ -138,15 +153,15 @@ void rlc_am_lte_tx::empty_queue()
 void rlc_am_lte_tx::empty_queue_nolock()
 {
   // deallocate all SDUs in transmit queue
-  while (tx_sdu_queue.size() > 0) {
-    unique_byte_buffer_t buf = tx_sdu_queue.read();
+  unique_byte_buffer_t buf;
+  while (tx_sdu_ring.try_read(&buf)) {
   }
 
-  // deallocate SDU that is currently processed
-  if (tx_sdu != nullptr) {
-    undelivered_sdu_info_queue.clear_pdcp_sdu(tx_sdu->md.pdcp_sn);
+  // drop the rest of the SDU that is currently processed
+  if (tx_sdu_stream.pending_bytes() > 0) {
+    undelivered_sdu_info_queue.clear_pdcp_sdu(tx_sdu_stream.last_sdu().md.pdcp_sn);
+    tx_sdu_stream.drop_pending();
   }
-  tx_sdu.reset();
 }
 
 void rlc_am_lte_tx::reestablish()
@@ -156,6 +171,82 @@ void rlc_am_lte_tx::reestablish()
   tx_enabled = true;
 }
 
+/*
+ * SDU ingress. The SDUs are written by a single thread (the stack thread) without taking the Tx mutex, and are only
+ * read by the holder of the mutex
+ */
+int rlc_am_lte_tx::write_sdu(unique_byte_buffer_t sdu)
+{
+  if (!tx_enabled) {
+    return SRSRAN_ERROR;
+  }
+  return push_sdu(std::move(sdu));
+}
+
+void rlc_am_lte_tx::write_sdus(span<unique_byte_buffer_t> sdus, uint32_t& nof_sdus, uint32_t& nof_bytes)
+{
+  if (!tx_enabled) {
+    return;
+  }
+  for (unique_byte_buffer_t& sdu : sdus) {
+    uint32_t sdu_bytes = sdu != nullptr ? sdu->N_bytes : 0;
+    if (push_sdu(std::move(sdu)) == SRSRAN_SUCCESS) {
+      nof_sdus++;
+      nof_bytes += sdu_bytes;
+    }
+  }
+}
+
+int rlc_am_lte_tx::push_sdu(unique_byte_buffer_t sdu)
+{
+  if (sdu.get() == nullptr) {
+    RlcWarning("NULL SDU pointer in write_sdu()");
+    return SRSRAN_ERROR;
+  }
+
+  // Only the reader frees slots, so a ring that is not full now can't become full before the write. The SDU is logged
+  // before the write, since it may be read and freed right after it
+  uint32_t sdu_pdcp_sn = sdu->md.pdcp_sn;
+  if (tx_sdu_ring.is_full() or not tx_sdu_ring.fits(sdu->N_bytes)) {
+    RlcHexWarning(sdu->msg,
+                  sdu->N_bytes,
+                  "[Dropped SDU] Tx SDU (%d B, PDCP_SN=%ld, tx_sdu_queue_len=%d)",
+                  sdu->N_bytes,
+                  sdu_pdcp_sn,
+                  tx_sdu_ring.size());
+    return SRSRAN_ERROR;
+  }
+  RlcHexInfo(sdu->msg,
+             sdu->N_bytes,
+             "Tx SDU (%d B, PDCP_SN=%ld tx_sdu_queue_len=%d)",
+             sdu->N_bytes,
+             sdu_pdcp_sn,
+             tx_sdu_ring.size() + 1);
+  return tx_sdu_ring.try_write(std::move(sdu)) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+}
+
+void rlc_am_lte_tx::discard_sdu(uint32_t discard_sn)
+{
+  if (!tx_enabled) {
+    return;
+  }
+  if (not discard_queue.try_push(std::move(discard_sn))) {
+    RlcWarning("Discard queue is full. Couldn't discard PDU with PDCP_SN=%d", discard_sn);
+    return;
+  }
+  run_deferred_work();
+}
+
+bool rlc_am_lte_tx::sdu_queue_is_full()
+{
+  return tx_sdu_ring.is_full();
+}
+
+void rlc_am_lte_tx::set_tx_budget(byte_buffer_budget* budget)
+{
+  tx_sdu_ring.set_budget(budget);
+}
+
 bool rlc_am_lte_tx::do_status()
 {
   return rx->get_do_status();
@@ -166,8 +257,9 @@ bool rlc_am_lte_tx::has_data()
 {
   return (((do_status() && not status_prohibit_timer.is_running())) || // if we have a status PDU to transmit
           (not retx_queue.empty()) ||                                  // if we have a retransmission
-          (tx_sdu != nullptr) ||                                       // if we are currently transmitting a SDU
-          (tx_sdu_queue.get_n_sdus() != 0)); // or if there is a SDU queued up for transmission
+          (tx_sdu_stream.pending_bytes() > 0) ||                       // if we are currently transmitting a SDU
+          (tx_sdu_ring.get_n_sdus() != 0) ||                           // if there is a SDU queued up for transmission
+          (not status_pdu_queue.empty())); // or if a status PDU, which may trigger retransmissions, waits
 }
 
 /**
@@ -204,7 +296,14 @@ uint32_t rlc_am_lte_tx::get_buffer_state()
 
 void rlc_am_lte_tx::get_buffer_state(uint32_t& n_bytes_newtx, uint32_t& n_bytes_prio)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+  if (not lock.owns_lock()) {
+    // Report the last buffer state and refresh it in the next tick, instead of waiting for the PDU reader
+    n_bytes_newtx = last_bytes_newtx.load(std::memory_order_relaxed);
+    n_bytes_prio  = last_bytes_prio.load(std::memory_order_relaxed);
+    deferred_work_timer.run();
+    return;
+  }
   get_buffer_state_nolock(n_bytes_newtx, n_bytes_prio);
 }
 
@@ -252,11 +351,11 @@ void rlc_am_lte_tx::get_buffer_state_nolock(uint32_t& n_bytes_newtx, uint32_t& n
 
   // Bytes needed for tx SDUs
   if (not window_full()) {
-    n_sdus = tx_sdu_queue.get_n_sdus();
-    n_bytes_newtx += tx_sdu_queue.size_bytes();
-    if (tx_sdu != NULL) {
+    n_sdus = tx_sdu_ring.get_n_sdus();
+    n_bytes_newtx += tx_sdu_ring.size_bytes();
+    if (tx_sdu_stream.pending_bytes() > 0) {
       n_sdus++;
-      n_bytes_newtx += tx_sdu->N_bytes;
+      n_bytes_newtx += tx_sdu_stream.pending_bytes();
     }
   }
 
@@ -270,6 +369,8 @@ void rlc_am_lte_tx::get_buffer_state_nolock(uint32_t& n_bytes_newtx, uint32_t& n
     n_bytes_newtx += 2; // Two bytes for fixed header with SN length = 10
     RlcDebug("Total buffer state - %d SDUs (%d B)", n_sdus, n_bytes_newtx);
   }
+  last_bytes_newtx.store(n_bytes_newtx, std::memory_order_relaxed);
+  last_bytes_prio.store(n_bytes_prio, std::memory_order_relaxed);
 
   if (bsr_callback) {
     RlcDebug("Calling BSR callback - %d new_tx, %d prio bytes", n_bytes_newtx, n_bytes_prio);
@@ -279,8 +380,24 @@ void rlc_am_lte_tx::get_buffer_state_nolock(uint32_t& n_bytes_newtx, uint32_t& n
 
 uint32_t rlc_am_lte_tx::read_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  uint32_t pdu_len       = 0;
+  bool     pending_notif = false;
+  {
+    // The other threads never hold the mutex for long, as they leave their work to the PDU reader when it is taken
+    std::lock_guard<std::mutex> lock(mutex);
+    process_deferred_work_nolock();
+    pdu_len       = read_pdu_nolock(payload, nof_bytes);
+    pending_notif = not notify_info_vec.empty();
+  }
+  if (pending_notif) {
+    // PDCP is notified from the stack thread, in the next tick
+    deferred_work_timer.run();
+  }
+  return pdu_len;
+}
 
+uint32_t rlc_am_lte_tx::read_pdu_nolock(uint8_t* payload, uint32_t nof_bytes)
+{
   if (not tx_enabled) {
     return 0;
   }
@@ -317,22 +434,62 @@ uint32_t rlc_am_lte_tx::read_pdu(uint8_t* payload, uint32_t nof_bytes)
 
 void rlc_am_lte_tx::timer_expired(uint32_t timeout_id)
 {
-  std::unique_lock<std::mutex> lock(mutex);
   if (poll_retx_timer.is_valid() && poll_retx_timer.id() == timeout_id) {
     RlcDebug("Poll retx timer expired after %dms", poll_retx_timer.duration());
+    poll_retx_expired = true;
+  } else if (status_prohibit_timer.is_valid() && status_prohibit_timer.id() == timeout_id) {
+    RlcDebug("Status prohibit timer expired after %dms", status_prohibit_timer.duration());
+  }
+  run_deferred_work();
+
+  if (bsr_callback) {
+    uint32_t new_tx_queue = 0, prio_tx_queue = 0;
+    get_buffer_state(new_tx_queue, prio_tx_queue);
+  }
+}
+
+// Runs the queued work if no other thread holds the TX state. Otherwise, it is left to the holder
+void rlc_am_lte_tx::run_deferred_work()
+{
+  std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+  if (not lock.owns_lock()) {
+    deferred_work_timer.run();
+    return;
+  }
+  process_deferred_work_nolock();
+  if (notify_info_vec.empty()) {
+    return;
+  }
+  pdcp_sn_vector_t notify_sns = notify_info_vec;
+  notify_info_vec.clear();
+  lock.unlock();
+
+  // Notify PDCP without holding Tx mutex
+  parent->pdcp->notify_delivery(parent->lcid, notify_sns);
+}
+
+void rlc_am_lte_tx::process_deferred_work_nolock()
+{
+  uint32_t discard_sn;
+  while (discard_queue.try_pop(discard_sn)) {
+    bool discarded = tx_sdu_ring.discard_first(
+        [discard_sn](const unique_byte_buffer_t& sdu) { return sdu->md.pdcp_sn == discard_sn; });
+    // Discard fails when the PDCP PDU is already in Tx window.
+    RlcInfo("%s PDU with PDCP_SN=%d", discarded ? "Discarding" : "Couldn't discard", discard_sn);
+  }
+
+  if (poll_retx_expired.exchange(false)) {
     // Section 5.2.2.3 in TS 36.322, schedule PDU for retransmission if
     // (a) both tx and retx buffer are empty (excluding tx'ed PDU waiting for ack), or
     // (b) no new data PDU can be transmitted (tx window is full)
-    if ((retx_queue.empty() && tx_sdu_queue.size() == 0) || window_full()) {
+    if ((retx_queue.empty() && tx_sdu_ring.get_n_sdus() == 0) || window_full()) {
       retransmit_pdu(vt_a); // TODO: TS says to send vt_s - 1 here
     }
-  } else if (status_prohibit_timer.is_valid() && status_prohibit_timer.id() == timeout_id) {
-    RlcDebug("Status prohibit timer expired after %dms", status_prohibit_timer.duration());
   }
 
-  if (bsr_callback) {
-    uint32_t new_tx_queue = 0, prio_tx_queue = 0;
-    get_buffer_state_nolock(new_tx_queue, prio_tx_queue);
+  unique_byte_buffer_t status_pdu;
+  while (status_pdu_queue.try_pop(status_pdu)) {
+    handle_status_pdu_nolock(status_pdu->msg, status_pdu->N_bytes);
   }
 }
 
@@ -360,7 +517,7 @@ void rlc_am_lte_tx::retransmit_pdu(uint32_t sn)
   rlc_amd_retx_lte_t& retx = retx_queue.push();
   retx.is_segment          = false;
   retx.so_start            = 0;
-  retx.so_end              = pdu.buf->N_bytes;
+  retx.so_end              = pdu.data_len;
   retx.sn                  = pdu.rlc_sn;
 }
 
@@ -404,7 +561,7 @@ bool rlc_am_lte_tx::poll_required()
     return true;
   }
 
-  if (tx_sdu_queue.size() == 0 && retx_queue.empty()) {
+  if (tx_sdu_ring.get_n_sdus() == 0 && retx_queue.empty()) {
     RlcDebug("Poll required. Cause: Empty TX and ReTX queues.");
     return true;
   }
@@ -491,7 +648,7 @@ int rlc_am_lte_tx::build_retx_pdu(uint8_t* payload, uint32_t nof_bytes)
 
   // Set poll bit
   pdu_without_poll++;
-  byte_without_poll += (tx_window[retx.sn].buf->N_bytes + rlc_am_packed_length(&new_header));
+  byte_without_poll += (tx_window[retx.sn].data_len + rlc_am_packed_length(&new_header));
   RlcInfo("pdu_without_poll: %d", pdu_without_poll);
   RlcInfo("byte_without_poll: %d", byte_without_poll);
   if (poll_required()) {
@@ -508,32 +665,32 @@ int rlc_am_lte_tx::build_retx_pdu(uint8_t* payload, uint32_t nof_bytes)
 
   uint8_t* ptr = payload;
   rlc_am_write_data_pdu_header(&new_header, &ptr);
-  memcpy(ptr, tx_window[retx.sn].buf->msg, tx_window[retx.sn].buf->N_bytes);
+  tx_sdu_stream.copy(tx_window[retx.sn].sdu_offset, tx_window[retx.sn].data_len, ptr);
 
   retx_queue.pop();
 
   RlcHexInfo(payload,
-             tx_window[retx.sn].buf->N_bytes,
+             tx_window[retx.sn].data_len,
              "Tx PDU SN=%d (%d B) (attempt %d/%d)",
              retx.sn,
-             tx_window[retx.sn].buf->N_bytes,
+             tx_window[retx.sn].data_len,
              tx_window[retx.sn].retx_count + 1,
              cfg.max_retx_thresh);
   log_rlc_amd_pdu_header_to_string(logger.debug, rb_name, "Tx PDU - %s", new_header);
 
   debug_state();
-  return (ptr - payload) + tx_window[retx.sn].buf->N_bytes;
+  return (ptr - payload) + tx_window[retx.sn].data_len;
 }
 
 int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_retx_lte_t retx)
 {
-  if (tx_window[retx.sn].buf == NULL) {
-    RlcError("In build_segment: retx.sn=%d has null buffer", retx.sn);
+  if (tx_window[retx.sn].data_len == 0) {
+    RlcError("In build_segment: retx.sn=%d has no data", retx.sn);
     return 0;
   }
   if (!retx.is_segment) {
     retx.so_start = 0;
-    retx.so_end   = tx_window[retx.sn].buf->N_bytes;
+    retx.so_end   = tx_window[retx.sn].data_len;
   }
 
   // Construct new header
@@ -541,7 +698,7 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
   rlc_amd_pdu_header_t old_header = tx_window[retx.sn].header;
 
   pdu_without_poll++;
-  byte_without_poll += (tx_window[retx.sn].buf->N_bytes + rlc_am_packed_length(&new_header));
+  byte_without_poll += (tx_window[retx.sn].data_len + rlc_am_packed_length(&new_header));
   RlcInfo("pdu_without_poll: %d, byte_without_poll: %d", pdu_without_poll, byte_without_poll);
 
   new_header.dc   = RLC_DC_FIELD_DATA_PDU;
@@ -641,7 +798,7 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
   srsran_expect(head_len + (retx.so_end - retx.so_start) <= nof_bytes, "The provided buffer was overflown.");
 
   // Update retx_queue
-  if (tx_window[retx.sn].buf->N_bytes == retx.so_end) {
+  if (tx_window[retx.sn].data_len == retx.so_end) {
     retx_queue.pop();
     new_header.lsf = 1;
     if (rlc_am_end_aligned(old_header.fi)) {
@@ -669,9 +826,8 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
   // Write header and pdu
   uint8_t* ptr = payload;
   rlc_am_write_data_pdu_header(&new_header, &ptr);
-  uint8_t* data = &tx_window[retx.sn].buf->msg[retx.so_start];
-  uint32_t len  = retx.so_end - retx.so_start;
-  memcpy(ptr, data, len);
+  uint32_t len = retx.so_end - retx.so_start;
+  tx_sdu_stream.copy(tx_window[retx.sn].sdu_offset + retx.so_start, len, ptr);
 
   debug_state();
   int pdu_len = (ptr - payload) + len;
@@ -698,7 +854,7 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
 
 int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
-  if (tx_sdu == NULL && tx_sdu_queue.is_empty()) {
+  if (tx_sdu_stream.pending_bytes() == 0 && tx_sdu_ring.get_n_sdus() == 0) {
     RlcInfo("No data available to be sent");
     return 0;
   }
@@ -716,23 +872,6 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
     return 0;
   }
 
-  unique_byte_buffer_t pdu = srsran::make_byte_buffer();
-  if (pdu == NULL) {
-#ifdef RLC_AM_BUFFER_DEBUG
-    srsran::console("Fatal Error: Could not allocate PDU in build_data_pdu()\n");
-    srsran::console("tx_window size: %zd PDUs\n", tx_window.size());
-    srsran::console("vt_a = %d, vt_ms = %d, vt_s = %d, poll_sn = %d\n", vt_a, vt_ms, vt_s, poll_sn);
-    srsran::console("retx_queue size: %zd PDUs\n", retx_queue.size());
-    std::map<uint32_t, rlc_amd_tx_pdu>::iterator txit;
-    for (txit = tx_window.begin(); txit != tx_window.end(); txit++) {
-      srsran::console("tx_window - SN=%d\n", txit->first);
-    }
-    exit(-1);
-#else
-    RlcError("Fatal Error: Couldn't allocate PDU in build_data_pdu().");
-    return 0;
-#endif
-  }
   rlc_amd_pdu_header_t header = {};
   header.dc                   = RLC_DC_FIELD_DATA_PDU;
   header.fi                   = RLC_FI_FIELD_START_AND_END_ALIGNED;
@@ -746,44 +885,40 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
   // insert newly assigned SN into window and use reference for in-place operations
   // NOTE: from now on, we can't return from this function anymore before increasing vt_s
   rlc_amd_tx_pdu_lte& tx_pdu = tx_window.add_pdu(header.sn);
+  tx_pdu.sdu_offset          = tx_sdu_stream.get_read_offset();
 
+  // The data field is the next range of the SDU stream, which is only copied once the header is written. The PDU size
+  // stays within a byte buffer, where the receiver stores it
   uint32_t head_len  = rlc_am_packed_length(&header);
   uint32_t to_move   = 0;
   uint32_t last_li   = 0;
-  uint32_t pdu_space = SRSRAN_MIN(nof_bytes, pdu->get_tailroom());
-  uint8_t* pdu_ptr   = pdu->msg;
+  uint32_t data_len  = 0;
+  uint32_t pdu_space = SRSRAN_MIN(nof_bytes, SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET);
 
   RlcDebug("Building PDU - pdu_space: %d, head_len: %d ", pdu_space, head_len);
 
   // Check for SDU segment
-  if (tx_sdu != nullptr) {
-    to_move = ((pdu_space - head_len) >= tx_sdu->N_bytes) ? tx_sdu->N_bytes : pdu_space - head_len;
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
+  if (tx_sdu_stream.pending_bytes() > 0) {
+    uint32_t pdcp_sn = tx_sdu_stream.last_sdu().md.pdcp_sn;
+    to_move          = SRSRAN_MIN(tx_sdu_stream.pending_bytes(), pdu_space - head_len);
+    tx_sdu_stream.read(to_move);
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
-    if (undelivered_sdu_info_queue.has_pdcp_sn(tx_sdu->md.pdcp_sn)) {
-      pdcp_pdu_info_lte& pdcp_pdu = undelivered_sdu_info_queue[tx_sdu->md.pdcp_sn];
+    data_len += to_move;
+    if (undelivered_sdu_info_queue.has_pdcp_sn(pdcp_sn)) {
+      pdcp_pdu_info_lte& pdcp_pdu = undelivered_sdu_info_queue[pdcp_sn];
       segment_pool.make_segment(tx_pdu, pdcp_pdu);
-      if (tx_sdu->N_bytes == 0) {
+      if (tx_sdu_stream.pending_bytes() == 0) {
         pdcp_pdu.fully_txed = true;
       }
     } else {
       // PDCP SNs for the RLC SDU has been removed from the queue
-      RlcWarning("Couldn't find PDCP_SN=%d in SDU info queue (segment)", tx_sdu->md.pdcp_sn);
+      RlcWarning("Couldn't find PDCP_SN=%d in SDU info queue (segment)", pdcp_sn);
     }
 
-    if (tx_sdu->N_bytes == 0) {
+    if (tx_sdu_stream.pending_bytes() == 0) {
       RlcDebug("Complete SDU scheduled for tx.");
-      tx_sdu.reset();
-    }
-    if (pdu_space > to_move) {
-      pdu_space -= SRSRAN_MIN(to_move, pdu->get_tailroom());
-    } else {
-      pdu_space = 0;
     }
+    pdu_space -= to_move;
     header.fi |= RLC_FI_FIELD_NOT_START_ALIGNED; // First byte does not correspond to first byte of SDU
 
     RlcDebug("Building PDU - added SDU segment from previous PDU (len:%d) - pdu_space: %d, head_len: %d header_sn=%d",
@@ -794,10 +929,10 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
   }
 
   // Pull SDUs from queue
-  while (pdu_space > head_len && tx_sdu_queue.get_n_sdus() > 0 && header.N_li < MAX_SDUS_PER_PDU) {
+  while (pdu_space > head_len && tx_sdu_ring.get_n_sdus() > 0 && header.N_li < MAX_SDUS_PER_PDU) {
     if (not segment_pool.has_segments()) {
       RlcInfo("Can't build a PDU segment - No segment resources available");
-      if (pdu_ptr != pdu->msg) {
+      if (data_len > 0) {
         break; // continue with the segments created up to this point
       }
       tx_window.remove_pdu(tx_pdu.rlc_sn);
@@ -815,64 +950,56 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
       break;
     }
 
-    do {
-      tx_sdu = tx_sdu_queue.read();
-    } while (tx_sdu == nullptr && tx_sdu_queue.size() != 0);
-    if (tx_sdu == nullptr) {
+    // skip the slots of the discarded SDUs
+    unique_byte_buffer_t sdu;
+    while (tx_sdu_ring.try_read(&sdu) && sdu == nullptr) {
+    }
+    if (sdu == nullptr) {
       if (header.N_li > 0) {
         header.N_li--;
       }
       break;
     }
 
+    parent->tx_sdu_dequeued(*sdu);
+
     // store sdu info
-    if (undelivered_sdu_info_queue.has_pdcp_sn(tx_sdu->md.pdcp_sn)) {
-      RlcWarning("PDCP_SN=%d already marked as undelivered", tx_sdu->md.pdcp_sn);
+    uint32_t pdcp_sn = sdu->md.pdcp_sn;
+    if (undelivered_sdu_info_queue.has_pdcp_sn(pdcp_sn)) {
+      RlcWarning("PDCP_SN=%d already marked as undelivered", pdcp_sn);
     } else {
-      RlcDebug("marking pdcp_sn=%d as undelivered (queue_len=%ld)",
-               tx_sdu->md.pdcp_sn,
-               undelivered_sdu_info_queue.nof_sdus());
-      undelivered_sdu_info_queue.add_pdcp_sdu(tx_sdu->md.pdcp_sn);
+      RlcDebug("marking pdcp_sn=%d as undelivered (queue_len=%ld)", pdcp_sn, undelivered_sdu_info_queue.nof_sdus());
+      undelivered_sdu_info_queue.add_pdcp_sdu(pdcp_sn);
     }
-    pdcp_pdu_info_lte& pdcp_pdu = undelivered_sdu_info_queue[tx_sdu->md.pdcp_sn];
+    pdcp_pdu_info_lte& pdcp_pdu = undelivered_sdu_info_queue[pdcp_sn];
 
-    to_move = ((pdu_space - head_len) >= tx_sdu->N_bytes) ? tx_sdu->N_bytes : pdu_space - head_len;
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
+    to_move = SRSRAN_MIN(sdu->N_bytes, pdu_space - head_len);
+    tx_sdu_stream.push(std::move(sdu));
+    tx_sdu_stream.read(to_move);
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
+    data_len += to_move;
     segment_pool.make_segment(tx_pdu, pdcp_pdu);
-    if (tx_sdu->N_bytes == 0) {
+    if (tx_sdu_stream.pending_bytes() == 0) {
       pdcp_pdu.fully_txed = true;
+      RlcDebug("Complete SDU scheduled for tx. PDCP SN=%d", pdcp_sn);
     }
-
-    if (tx_sdu->N_bytes == 0) {
-      RlcDebug("Complete SDU scheduled for tx. PDCP SN=%d", tx_sdu->md.pdcp_sn);
-      tx_sdu.reset();
-    }
-    if (pdu_space > to_move) {
-      pdu_space -= to_move;
-    } else {
-      pdu_space = 0;
-    }
+    pdu_space -= to_move;
 
     RlcDebug("Building PDU - added SDU segment (len:%d) - pdu_space: %d, head_len: %d ", to_move, pdu_space, head_len);
   }
 
   // Make sure, at least one SDU (segment) has been added until this point
-  if (pdu->N_bytes == 0) {
+  if (data_len == 0) {
     RlcError("Generated empty RLC PDU.");
   }
 
-  if (tx_sdu != NULL) {
+  if (tx_sdu_stream.pending_bytes() > 0) {
     header.fi |= RLC_FI_FIELD_NOT_END_ALIGNED; // Last byte does not correspond to last byte of SDU
   }
 
   // Set Poll bit
   pdu_without_poll++;
-  byte_without_poll += (pdu->N_bytes + head_len);
+  byte_without_poll += (data_len + head_len);
   RlcDebug("pdu_without_poll: %d", pdu_without_poll);
   RlcDebug("byte_without_poll: %d", byte_without_poll);
   if (poll_required()) {
@@ -889,15 +1016,14 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
   // Update Tx window
   vt_s = (vt_s + 1) % MOD;
 
-  // Write final header and TX
-  tx_pdu.buf                      = std::move(pdu);
-  tx_pdu.header                   = header;
-  const byte_buffer_t* buffer_ptr = tx_pdu.buf.get();
+  // Write final header and TX. The data is copied from the SDUs, which the PDU refers to for the retransmissions
+  tx_pdu.data_len = data_len;
+  tx_pdu.header   = header;
 
   uint8_t* ptr = payload;
   rlc_am_write_data_pdu_header(&header, &ptr);
-  memcpy(ptr, buffer_ptr->msg, buffer_ptr->N_bytes);
-  int total_len = (ptr - payload) + buffer_ptr->N_bytes;
+  tx_sdu_stream.copy(tx_pdu.sdu_offset, data_len, ptr);
+  int total_len = (ptr - payload) + data_len;
   RlcHexInfo(payload, total_len, "Tx PDU SN=%d (%d B)", header.sn, total_len);
   log_rlc_amd_pdu_header_to_string(logger.debug, rb_name, "%s", header);
   debug_state();
@@ -911,51 +1037,59 @@ void rlc_am_lte_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
     return;
   }
 
-  // Local variables for handling Status PDU will be updated with lock
-  rlc_status_pdu_t status     = {};
-  uint32_t         i          = 0;
-  uint32_t         vt_s_local = 0;
-
-  {
-    std::lock_guard<std::mutex> lock(mutex);
+  // The Status PDU is handled by the holder of the Tx state, which may be the PDU reader
+  unique_byte_buffer_t status_pdu = make_byte_buffer();
+  if (status_pdu == nullptr || status_pdu->get_tailroom() < nof_bytes) {
+    RlcWarning("Couldn't allocate buffer for Rx control PDU (%d B). Dropping PDU.", nof_bytes);
+    return;
+  }
+  memcpy(status_pdu->msg, payload, nof_bytes);
+  status_pdu->N_bytes = nof_bytes;
+  if (not status_pdu_queue.try_push(std::move(status_pdu))) {
+    RlcWarning("Rx control PDU queue is full. Dropping PDU.");
+    return;
+  }
+  run_deferred_work();
+}
 
-    RlcHexDebug(payload, nof_bytes, "Rx control PDU");
+void rlc_am_lte_tx::handle_status_pdu_nolock(uint8_t* payload, uint32_t nof_bytes)
+{
+  rlc_status_pdu_t status = {};
 
-    rlc_am_read_status_pdu(payload, nof_bytes, &status);
+  RlcHexDebug(payload, nof_bytes, "Rx control PDU");
 
-    log_rlc_am_status_pdu_to_string(logger.info, rb_name, "Rx Status PDU %s", &status);
+  rlc_am_read_status_pdu(payload, nof_bytes, &status);
 
-    // make sure ACK_SN is within our Tx window
-    if (((MOD + status.ack_sn - vt_a) % MOD > RLC_AM_WINDOW_SIZE) ||
-        ((MOD + vt_s - status.ack_sn) % MOD > RLC_AM_WINDOW_SIZE)) {
-      RlcWarning("Received invalid status PDU (ack_sn=%d, vt_a=%d, vt_s=%d). Dropping PDU.", status.ack_sn, vt_a, vt_s);
-      return;
-    }
+  log_rlc_am_status_pdu_to_string(logger.info, rb_name, "Rx Status PDU %s", &status);
 
-    // Sec 5.2.2.2, stop poll reTx timer if status PDU comprises a positive _or_ negative acknowledgement
-    // for the RLC data PDU with sequence number poll_sn
-    if (poll_retx_timer.is_valid() && (TX_MOD_BASE(poll_sn) < TX_MOD_BASE(status.ack_sn))) {
-      RlcDebug("Stopping pollRetx timer");
-      poll_retx_timer.stop();
-    }
+  // make sure ACK_SN is within our Tx window
+  if (((MOD + status.ack_sn - vt_a) % MOD > RLC_AM_WINDOW_SIZE) ||
+      ((MOD + vt_s - status.ack_sn) % MOD > RLC_AM_WINDOW_SIZE)) {
+    RlcWarning("Received invalid status PDU (ack_sn=%d, vt_a=%d, vt_s=%d). Dropping PDU.", status.ack_sn, vt_a, vt_s);
+    return;
+  }
 
-    // flush retx queue to avoid unordered SNs, we expect the Rx to request lost PDUs again
-    if (status.N_nack > 0) {
-      retx_queue.clear();
-    }
+  // Sec 5.2.2.2, stop poll reTx timer if status PDU comprises a positive _or_ negative acknowledgement
+  // for the RLC data PDU with sequence number poll_sn
+  if (poll_retx_timer.is_valid() && (TX_MOD_BASE(poll_sn) < TX_MOD_BASE(status.ack_sn))) {
+    RlcDebug("Stopping pollRetx timer");
+    poll_retx_timer.stop();
+  }
 
-    i          = vt_a;
-    vt_s_local = vt_s;
+  // flush retx queue to avoid unordered SNs, we expect the Rx to request lost PDUs again
+  if (status.N_nack > 0) {
+    retx_queue.clear();
   }
 
-  bool update_vt_a = true;
+  uint32_t i           = vt_a;
+  uint32_t vt_s_local  = vt_s;
+  bool     update_vt_a = true;
   while (TX_MOD_BASE(i) < TX_MOD_BASE(status.ack_sn) && TX_MOD_BASE(i) < TX_MOD_BASE(vt_s_local)) {
     bool nack = false;
     for (uint32_t j = 0; j < status.N_nack; j++) {
       if (status.nacks[j].nack_sn == i) {
         nack        = true;
         update_vt_a = false;
-        std::lock_guard<std::mutex> lock(mutex);
         if (tx_window.has_sn(i)) {
           auto& pdu = tx_window[i];
 
@@ -970,24 +1104,24 @@ void rlc_am_lte_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
             retx.sn         = i;
             retx.is_segment = false;
             retx.so_start   = 0;
-            retx.so_end     = pdu.buf->N_bytes;
+            retx.so_end     = pdu.data_len;
 
             if (status.nacks[j].has_so) {
               // sanity check
-              if (status.nacks[j].so_start >= pdu.buf->N_bytes) {
+              if (status.nacks[j].so_start >= pdu.data_len) {
                 // print error but try to send original PDU again
-                RlcInfo("SO_start is larger than original PDU (%d >= %d)", status.nacks[j].so_start, pdu.buf->N_bytes);
+                RlcInfo("SO_start is larger than original PDU (%d >= %d)", status.nacks[j].so_start, pdu.data_len);
                 status.nacks[j].so_start = 0;
               }
 
               // check for special SO_end value
               if (status.nacks[j].so_end == 0x7FFF) {
-                status.nacks[j].so_end = pdu.buf->N_bytes;
+                status.nacks[j].so_end = pdu.data_len;
               } else {
                 retx.so_end = status.nacks[j].so_end + 1;
               }
 
-              if (status.nacks[j].so_start < pdu.buf->N_bytes && status.nacks[j].so_end <= pdu.buf->N_bytes) {
+              if (status.nacks[j].so_start < pdu.data_len && status.nacks[j].so_end <= pdu.data_len) {
                 retx.is_segment = true;
                 retx.so_start   = status.nacks[j].so_start;
               } else {
@@ -995,7 +1129,7 @@ void rlc_am_lte_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
                            i,
                            status.nacks[j].so_start,
                            status.nacks[j].so_end,
-                           pdu.buf->N_bytes);
+                           pdu.data_len);
               }
             }
           } else {
@@ -1009,7 +1143,6 @@ void rlc_am_lte_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
 
     if (!nack) {
       // ACKed SNs get marked and removed from tx_window so PDCP get's only notified once
-      std::lock_guard<std::mutex> lock(mutex);
       if (tx_window.has_sn(i)) {
         update_notification_ack_info(i);
         RlcDebug("Tx PDU SN=%zd being removed from tx window", i);
@@ -1024,22 +1157,20 @@ void rlc_am_lte_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
     i = (i + 1) % MOD;
   }
 
-  {
-    // Make sure vt_a points to valid SN
-    std::lock_guard<std::mutex> lock(mutex);
-    if (not tx_window.empty() && not tx_window.has_sn(vt_a)) {
-      RlcError("vt_a=%d points to invalid position in Tx window.", vt_a);
-      parent->rrc->protocol_failure();
-    }
+  // Make sure vt_a points to valid SN
+  if (not tx_window.empty() && not tx_window.has_sn(vt_a)) {
+    RlcError("vt_a=%d points to invalid position in Tx window.", vt_a);
+    parent->rrc->protocol_failure();
   }
 
-  debug_state();
-
-  // Notify PDCP without holding Tx mutex
-  if (not notify_info_vec.empty()) {
-    parent->pdcp->notify_delivery(parent->lcid, notify_info_vec);
+  // Free the SDUs whose bytes were all ACKed, i.e. that precede the first unACKed PDU
+  if (tx_window.has_sn(vt_a)) {
+    tx_sdu_stream.release(tx_window[vt_a].sdu_offset);
+  } else if (tx_window.empty()) {
+    tx_sdu_stream.release(tx_sdu_stream.get_read_offset());
   }
-  notify_info_vec.clear();
+
+  debug_state();
 }
 
 /*
@@ -1093,10 +1224,10 @@ int rlc_am_lte_tx::required_buffer_size(const rlc_amd_retx_lte_t& retx)
 {
   if (!retx.is_segment) {
     if (tx_window.has_sn(retx.sn)) {
-      if (tx_window[retx.sn].buf) {
-        return rlc_am_packed_length(&tx_window[retx.sn].header) + tx_window[retx.sn].buf->N_bytes;
+      if (tx_window[retx.sn].data_len > 0) {
+        return rlc_am_packed_length(&tx_window[retx.sn].header) + tx_window[retx.sn].data_len;
       } else {
-        RlcWarning("retx.sn=%d has null ptr in required_buffer_size()", retx.sn);
+        RlcWarning("retx.sn=%d has no data in required_buffer_size()", retx.sn);
         return -1;
       }
     } else {
@@ -1154,7 +1285,7 @@ int rlc_am_lte_tx::required_buffer_size(const rlc_amd_retx_lte_t& retx)
     lower += old_header.li[i];
   }
 
-  //  if(tx_window[retx.sn].buf->N_bytes != retx.so_end) {
+  //  if(tx_window[retx.sn].data_len != retx.so_end) {
   //    if(new_header.N_li > 0)
   //      new_header.N_li--; // No li for last segment
   //  }
@@ -1223,6 +1354,7 @@ void rlc_am_lte_rx::stop()
 
   // Drop all messages in RX window
   rx_window.clear();
+  rx_sn_bitmap.clear();
 }
 
 /** Called from stack thread when MAC has received a new RLC PDU
@@ -1305,6 +1437,7 @@ void rlc_am_lte_rx::handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, r
 #endif
   }
   pdu.buf->set_timestamp();
+  rx_sn_bitmap.set(header.sn);
 
   // check available space for payload
   if (nof_bytes > pdu.buf->get_tailroom()) {
@@ -1600,6 +1733,7 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
       it->second.segments.clear();
     }
     rx_window.remove_pdu(vr_r);
+    rx_sn_bitmap.reset(vr_r);
     vr_r  = (vr_r + 1) % MOD;
     vr_mr = (vr_mr + 1) % MOD;
   }
@@ -1671,39 +1805,45 @@ int rlc_am_lte_rx::get_status_pdu(rlc_status_pdu_t* status, const uint32_t max_p
   status->ack_sn = vr_r; // start with lower edge of the rx window
 
   // We don't use segment NACKs - just NACK the full PDU
+  if (rlc_am_packed_length(status) > max_pdu_size) {
+    RlcWarning("Failed to generate small enough status PDU (packed_len=%d, max_pdu_size=%d, status->N_nack=%d)",
+               rlc_am_packed_length(status),
+               max_pdu_size,
+               status->N_nack);
+    return 0;
+  }
+
+  // Only the missing SNs are visited, the runs of received SNs are skipped a bitmap word at a time
   uint32_t i = vr_r;
-  while (RX_MOD_BASE(i) <= RX_MOD_BASE(vr_ms) && status->N_nack < RLC_AM_WINDOW_SIZE) {
-    if (rx_window.has_sn(i) || i == vr_ms) {
-      // only update ACK_SN if this SN has been received, or if we reached the maximum possible SN
-      status->ack_sn = i;
-    } else {
-      status->nacks[status->N_nack].nack_sn = i;
-      status->N_nack++;
+  while (status->N_nack < RLC_AM_WINDOW_SIZE) {
+    uint32_t nack_sn = rx_sn_bitmap.find_next(i, vr_ms, false);
+    if (nack_sn == vr_ms) {
+      // we reached the maximum possible SN
+      status->ack_sn = vr_ms;
+      break;
     }
+    if (nack_sn != i) {
+      // only update ACK_SN if this SN has been received
+      status->ack_sn = (nack_sn + MOD - 1) % MOD;
+    }
+    status->nacks[status->N_nack].nack_sn = nack_sn;
+    status->N_nack++;
 
     // make sure we don't exceed grant size
     if (rlc_am_packed_length(status) > max_pdu_size) {
       RlcDebug("Status PDU too big (%d > %d)", rlc_am_packed_length(status), max_pdu_size);
-      if (status->N_nack >= 1 && status->N_nack < RLC_AM_WINDOW_SIZE) {
-        RlcDebug("Removing last NACK SN=%d", status->nacks[status->N_nack].nack_sn);
-        status->N_nack--;
-        // make sure we don't have the current ACK_SN in the NACK list
-        if (rlc_am_is_valid_status_pdu(*status, vr_r) == false) {
-          // No space to send any NACKs, play safe and just ack lower edge
-          RlcWarning("Resetting ACK_SN and N_nack to initial state");
-          status->ack_sn = vr_r;
-          status->N_nack = 0;
-        }
-      } else {
-        RlcWarning("Failed to generate small enough status PDU (packed_len=%d, max_pdu_size=%d, status->N_nack=%d)",
-                   rlc_am_packed_length(status),
-                   max_pdu_size,
-                   status->N_nack);
-        return 0;
+      status->N_nack--;
+      RlcDebug("Removing last NACK SN=%d", status->nacks[status->N_nack].nack_sn);
+      // make sure we don't have the current ACK_SN in the NACK list
+      if (rlc_am_is_valid_status_pdu(*status, vr_r) == false) {
+        // No space to send any NACKs, play safe and just ack lower edge
+        RlcWarning("Resetting ACK_SN and N_nack to initial state");
+        status->ack_sn = vr_r;
+        status->N_nack = 0;
       }
       break;
     }
-    i = (i + 1) % MOD;
+    i = (nack_sn + 1) % MOD;
   }
 
   // valid PDU could be generated
@@ -1721,13 +1861,7 @@ int rlc_am_lte_rx::get_status_pdu_length()
   }
   rlc_status_pdu_t status = {};
   status.ack_sn           = vr_ms;
-  uint32_t i              = vr_r;
-  while (RX_MOD_BASE(i) < RX_MOD_BASE(vr_ms) && status.N_nack < RLC_AM_WINDOW_SIZE) {
-    if (not rx_window.has_sn(i)) {
-      status.N_nack++;
-    }
-    i = (i + 1) % MOD;
-  }
+  status.N_nack           = std::min(rx_sn_bitmap.count_missing(vr_r, vr_ms), (uint32_t)RLC_AM_WINDOW_SIZE);
   return rlc_am_packed_length(&status);
 }
 
@@ -200,6 +200,7 @@ uint32_t rlc_am_nr_tx::build_new_pdu(uint8_t* payload, uint32_t nof_bytes)
 
   if (tx_sdu != nullptr) {
     RlcDebug("Read RLC SDU - RLC_SN=%d, PDCP_SN=%d, %d bytes", st.tx_next, tx_sdu->md.pdcp_sn, tx_sdu->N_bytes);
+    parent->tx_sdu_dequeued(*tx_sdu);
   } else {
     RlcDebug("No SDUs left in the tx queue.");
     return 0;
@@ -1031,6 +1032,12 @@ uint32_t rlc_am_nr_tx::get_buffer_state()
   return tx_queue + prio_tx_queue;
 }
 
+size_t rlc_am_nr_tx::get_memory_usage()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return sizeof(*this) + (tx_window != nullptr ? tx_window->memory_usage() : 0);
+}
+
 void rlc_am_nr_tx::get_buffer_state(uint32_t& n_bytes_new, uint32_t& n_bytes_prio)
 {
   std::lock_guard<std::mutex> lock(mutex);
@@ -1391,6 +1398,8 @@ bool rlc_am_nr_rx::configure(const rlc_config_t& cfg_)
   }
 
   mod_nr = cardinality(cfg.rx_sn_field_length);
+  rx_sdus_present.resize(mod_nr);
+  rx_sdus_complete.resize(mod_nr);
   switch (cfg.rx_sn_field_length) {
     case rlc_am_nr_sn_size_t::size12bits:
       rx_window = std::unique_ptr<rlc_ringbuffer_base<rlc_amd_rx_sdu_nr_t> >(
@@ -1428,6 +1437,8 @@ void rlc_am_nr_rx::stop()
 
   // Drop all messages in RX window
   rx_window->clear();
+  rx_sdus_present.clear();
+  rx_sdus_complete.clear();
 }
 
 void rlc_am_nr_rx::reestablish()
@@ -1473,24 +1484,15 @@ void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 
   // Section 5.2.3.2.2, discard segments with overlapping bytes
   if (rx_window->has_sn(header.sn) && header.si != rlc_nr_si_field_t::full_sdu) {
-    for (const auto& segm : (*rx_window)[header.sn].segments) {
-      uint32_t segm_last_byte = segm.header.so + segm.buf->N_bytes - 1;
-      uint32_t pdu_last_byte  = header.so + nof_bytes - hdr_len - 1;
-      if ((header.so >= segm.header.so && header.so <= segm_last_byte) ||
-          (pdu_last_byte >= segm.header.so && pdu_last_byte <= segm_last_byte)) {
-        RlcInfo("Got SDU segment with duplicate bytes. Discarding.");
-        RlcInfo("Discarded SDU segment. SN=%d, SO=%d, last_byte=%d, payload=%d",
-                header.sn,
-                header.so,
-                header.so + (nof_bytes - hdr_len),
-                (nof_bytes - hdr_len));
-        RlcInfo("Overlaping with SDU segment with SN=%d, SO=%d, last_byte=%d, payload=%d",
-                header.sn,
-                segm.header.so,
-                segm_last_byte,
-                segm.buf->N_bytes);
-        return;
-      }
+    uint32_t payload_len = nof_bytes - hdr_len;
+    if ((*rx_window)[header.sn].segments.overlaps(header.so, payload_len)) {
+      RlcInfo("Got SDU segment with duplicate bytes. Discarding.");
+      RlcInfo("Discarded SDU segment. SN=%d, SO=%d, last_byte=%d, payload=%d",
+              header.sn,
+              header.so,
+              header.so + payload_len,
+              payload_len);
+      return;
     }
   }
 
@@ -1534,20 +1536,10 @@ void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
      * all bytes have been received.
      */
     if (rx_mod_base_nr(header.sn) == rx_mod_base_nr(st.rx_highest_status)) {
-      uint32_t sn_upd = 0;
-      for (sn_upd = (st.rx_highest_status + 1) % mod_nr; rx_mod_base_nr(sn_upd) < rx_mod_base_nr(st.rx_next_highest);
-           sn_upd = (sn_upd + 1) % mod_nr) {
-        if (rx_window->has_sn(sn_upd)) {
-          if (not(*rx_window)[sn_upd].fully_received) {
-            break; // first SDU not fully received
-          }
-        } else {
-          break; // first SDU not fully received
-        }
-      }
       // Update to the SN of the first SDU with missing bytes.
       // If it not exists, update to the end of the rx_window.
-      st.rx_highest_status = sn_upd;
+      st.rx_highest_status =
+          rx_sdus_complete.find_next((st.rx_highest_status + 1) % mod_nr, st.rx_next_highest, false);
     }
     /*
      * - if x = RX_Next:
@@ -1565,7 +1557,7 @@ void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
           }
           // RX_Next serves as the lower edge of the receiving window
           // As such, we remove any SDU from the window if we update this value
-          rx_window->remove_pdu(sn_upd);
+          remove_rx_sdu(sn_upd);
         } else {
           break; // first SDU not fully received
         }
@@ -1635,11 +1627,11 @@ int rlc_am_nr_rx::handle_full_data_sdu(const rlc_am_nr_pdu_header_t& header, con
 {
   uint32_t hdr_len = rlc_am_nr_packed_length(header);
   // Full SDU received. Add SDU to Rx Window and copy full PDU into SDU buffer.
-  rlc_amd_rx_sdu_nr_t& rx_sdu = rx_window->add_pdu(header.sn);
+  rlc_amd_rx_sdu_nr_t& rx_sdu = add_rx_sdu(header.sn);
   rx_sdu.buf                  = srsran::make_byte_buffer();
   if (rx_sdu.buf == nullptr) {
     RlcError("fatal error. Couldn't allocate PDU in %s.", __FUNCTION__);
-    rx_window->remove_pdu(header.sn);
+    remove_rx_sdu(header.sn);
     return SRSRAN_ERROR;
   }
   rx_sdu.buf->set_timestamp();
@@ -1647,13 +1639,14 @@ int rlc_am_nr_rx::handle_full_data_sdu(const rlc_am_nr_pdu_header_t& header, con
   // check available space for payload
   if (nof_bytes > rx_sdu.buf->get_tailroom()) {
     RlcError("discarding SN=%d of size %d B (available space %d B)", header.sn, nof_bytes, rx_sdu.buf->get_tailroom());
-    rx_window->remove_pdu(header.sn);
+    remove_rx_sdu(header.sn);
     return SRSRAN_ERROR;
   }
   memcpy(rx_sdu.buf->msg, payload + hdr_len, nof_bytes - hdr_len); // Don't copy header
   rx_sdu.buf->N_bytes   = nof_bytes - hdr_len;
   rx_sdu.fully_received = true;
   rx_sdu.has_gap        = false;
+  rx_sdus_complete.set(header.sn);
   return SRSRAN_SUCCESS;
 }
 
@@ -1678,37 +1671,49 @@ int rlc_am_nr_rx::handle_segment_data_sdu(const rlc_am_nr_pdu_header_t& header,
   }
 
   // Add a new SDU to the RX window if necessary
-  rlc_amd_rx_sdu_nr_t& rx_sdu = rx_window->has_sn(header.sn) ? (*rx_window)[header.sn] : rx_window->add_pdu(header.sn);
+  rlc_amd_rx_sdu_nr_t& rx_sdu = rx_window->has_sn(header.sn) ? (*rx_window)[header.sn] : add_rx_sdu(header.sn);
 
-  // Create PDU segment info, to be stored later
-  rlc_amd_rx_pdu_nr pdu_segment = {};
-  pdu_segment.header            = header;
-  pdu_segment.buf               = srsran::make_byte_buffer();
-  if (pdu_segment.buf == nullptr) {
-    RlcError("fatal error. Couldn't allocate PDU in %s.", __FUNCTION__);
+  // The SDU is reassembled in place, as the segments arrive
+  if (rx_sdu.buf == nullptr) {
+    rx_sdu.buf = srsran::make_byte_buffer();
+    if (rx_sdu.buf == nullptr) {
+      RlcError("fatal error. Couldn't allocate PDU in %s.", __FUNCTION__);
+      remove_rx_sdu(header.sn);
+      return SRSRAN_ERROR;
+    }
+    rx_sdu.buf->set_timestamp();
+  }
+
+  // check available space for payload
+  uint32_t payload_len = nof_bytes - hdr_len;
+  if (header.so + payload_len > rx_sdu.buf->get_tailroom()) {
+    RlcError("discarding SN=%d segment with SO=%d of size %d B (available space %d B)",
+             header.sn,
+             header.so,
+             payload_len,
+             rx_sdu.buf->get_tailroom());
+    if (rx_sdu.segments.empty()) {
+      remove_rx_sdu(header.sn);
+    }
     return SRSRAN_ERROR;
   }
-  memcpy(pdu_segment.buf->msg, payload + hdr_len, nof_bytes - hdr_len); // Don't copy header
-  pdu_segment.buf->N_bytes = nof_bytes - hdr_len;
 
-  // Store SDU segment. Sort by SO and check for duplicate bytes.
-  insert_received_segment(std::move(pdu_segment), rx_sdu.segments);
+  // Store SDU segment
+  if (not rx_sdu.segments.add(header.so, payload_len)) {
+    RlcInfo("Too many gaps in SDU. Discarding segment SN=%d, SO=%d, payload=%d", header.sn, header.so, payload_len);
+    return SRSRAN_ERROR;
+  }
+  memcpy(rx_sdu.buf->msg + header.so, payload + hdr_len, payload_len); // Don't copy header
+  if (header.si == rlc_nr_si_field_t::last_segment) {
+    rx_sdu.sdu_len = header.so + payload_len;
+  }
 
   // Check weather all segments have been received
   update_segment_inventory(rx_sdu);
   if (rx_sdu.fully_received) {
     RlcInfo("Fully received segmented SDU. SN=%d.", header.sn);
-    rx_sdu.buf = srsran::make_byte_buffer();
-    if (rx_sdu.buf == nullptr) {
-      RlcError("fatal error. Couldn't allocate PDU in %s.", __FUNCTION__);
-      rx_window->remove_pdu(header.sn);
-      return SRSRAN_ERROR;
-    }
-    // Assemble SDU from segments
-    for (const auto& it : rx_sdu.segments) {
-      memcpy(&rx_sdu.buf->msg[rx_sdu.buf->N_bytes], it.buf->msg, it.buf->N_bytes);
-      rx_sdu.buf->N_bytes += it.buf->N_bytes;
-    }
+    rx_sdu.buf->N_bytes = rx_sdu.sdu_len;
+    rx_sdus_complete.set(header.sn);
   }
   return SRSRAN_SUCCESS;
 }
@@ -1732,75 +1737,62 @@ uint32_t rlc_am_nr_rx::get_status_pdu(rlc_am_nr_status_pdu_t* status, uint32_t m
    *   PDU(s) indicated by lower layer:
    */
   RlcDebug("Generating status PDU");
-  for (uint32_t i = st.rx_next; rx_mod_base_nr(i) < rx_mod_base_nr(st.rx_highest_status); i = (i + 1) % mod_nr) {
-    if ((rx_window->has_sn(i) && (*rx_window)[i].fully_received)) {
-      RlcDebug("SDU SN=%d is fully received", i);
-    } else {
-      if (not rx_window->has_sn(i)) {
-        // No segment received, NACK the whole SDU
-        RlcDebug("Adding NACK for full SDU. NACK SN=%d", i);
+  // Only the SDUs not fully received are visited. The runs of received SDUs, and of SDUs of which no segment was
+  // received, are skipped a bitmap word at a time
+  uint32_t i = rx_sdus_complete.find_next(st.rx_next, st.rx_highest_status, false);
+  while (i != st.rx_highest_status) {
+    if (not rx_sdus_present.test(i)) {
+      // No segment received, NACK the whole SDUs up to the next one with segments
+      uint32_t run_end = rx_sdus_present.find_next(i, st.rx_highest_status, true);
+      uint32_t run_len = (run_end + mod_nr - i) % mod_nr;
+      RlcDebug("Adding NACK for %d full SDUs. NACK SN=%d", run_len, i);
+      while (run_len > 0) {
+        uint32_t          range = std::min(run_len, (uint32_t)std::numeric_limits<uint8_t>::max());
         rlc_status_nack_t nack;
-        nack.nack_sn = i;
-        nack.has_so  = false;
+        nack.nack_sn        = i;
+        nack.has_so         = false;
+        nack.has_nack_range = range > 1;
+        nack.nack_range     = range > 1 ? range : 0;
         status->push_nack(nack);
-      } else if (not(*rx_window)[i].fully_received) {
-        // Some segments were received, but not all.
-        // NACK non consecutive missing bytes
-        RlcDebug("Adding NACKs for segmented SDU. NACK SN=%d", i);
-        uint32_t last_so         = 0;
-        bool     last_segment_rx = false;
-        for (auto segm = (*rx_window)[i].segments.begin(); segm != (*rx_window)[i].segments.end(); segm++) {
-          if (segm->header.so != last_so) {
-            // Some bytes were not received
-            rlc_status_nack_t nack;
-            nack.nack_sn  = i;
-            nack.has_so   = true;
-            nack.so_start = last_so;
-            nack.so_end   = segm->header.so - 1; // set to last missing byte
-            status->push_nack(nack);
-            if (nack.so_start > nack.so_end) {
-              // Print segment list
-              for (auto segm_it = (*rx_window)[i].segments.begin(); segm_it != (*rx_window)[i].segments.end();
-                   segm_it++) {
-                RlcError("Segment: segm.header.so=%d, segm.buf.N_bytes=%d", segm_it->header.so, segm_it->buf->N_bytes);
-              }
-              RlcError("Error: SO_start=%d > SO_end=%d. NACK_SN=%d. SO_start=%d, SO_end=%d, seg.so=%d",
-                       nack.so_start,
-                       nack.so_end,
-                       nack.nack_sn,
-                       nack.so_start,
-                       nack.so_end,
-                       segm->header.so);
-              srsran_assert(nack.so_start <= nack.so_end,
-                            "Error: SO_start=%d > SO_end=%d. NACK_SN=%d",
-                            nack.so_start,
-                            nack.so_end,
-                            nack.nack_sn);
-            } else {
-              RlcDebug("First/middle segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d",
-                       nack.nack_sn,
-                       nack.so_start,
-                       nack.so_end);
-            }
-          }
-          if (segm->header.si == rlc_nr_si_field_t::last_segment) {
-            last_segment_rx = true;
-          }
-          last_so = segm->header.so + segm->buf->N_bytes;
-        } // Segment loop
-        if (not last_segment_rx) {
+        i = (i + range) % mod_nr;
+        run_len -= range;
+      }
+    } else {
+      // Some segments were received, but not all.
+      // NACK non consecutive missing bytes
+      RlcDebug("Adding NACKs for segmented SDU. NACK SN=%d", i);
+      const rlc_amd_rx_sdu_nr_t& rx_sdu  = (*rx_window)[i];
+      uint32_t                   last_so = 0;
+      for (const auto& range : rx_sdu.segments) {
+        if (range.start() != last_so) {
+          // Some bytes were not received
           rlc_status_nack_t nack;
           nack.nack_sn  = i;
           nack.has_so   = true;
           nack.so_start = last_so;
-          nack.so_end   = rlc_status_nack_t::so_end_of_sdu;
+          nack.so_end   = range.start() - 1; // set to last missing byte
           status->push_nack(nack);
-          RlcDebug(
-              "Final segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d", nack.nack_sn, nack.so_start, nack.so_end);
-          srsran_assert(nack.so_start <= nack.so_end, "Error: SO_start > SO_end. NACK_SN=%d", nack.nack_sn);
+          RlcDebug("First/middle segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d",
+                   nack.nack_sn,
+                   nack.so_start,
+                   nack.so_end);
         }
+        last_so = range.stop();
       }
+      if (rx_sdu.sdu_len == 0) {
+        // Last segment not received
+        rlc_status_nack_t nack;
+        nack.nack_sn  = i;
+        nack.has_so   = true;
+        nack.so_start = last_so;
+        nack.so_end   = rlc_status_nack_t::so_end_of_sdu;
+        status->push_nack(nack);
+        RlcDebug(
+            "Final segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d", nack.nack_sn, nack.so_start, nack.so_end);
+      }
+      i = (i + 1) % mod_nr;
     }
+    i = rx_sdus_complete.find_next(i, st.rx_highest_status, false);
   } // NACK loop
 
   /*
@@ -1867,14 +1859,7 @@ void rlc_am_nr_rx::timer_expired(uint32_t timeout_id)
      *   - start t-Reassembly;
      *   - set RX_Next_Status_Trigger to RX_Next_Highest.
      */
-    uint32_t sn_upd = {};
-    for (sn_upd = st.rx_next_status_trigger; rx_mod_base_nr(sn_upd) < rx_mod_base_nr(st.rx_next_highest);
-         sn_upd = (sn_upd + 1) % mod_nr) {
-      if (not rx_window->has_sn(sn_upd) || (rx_window->has_sn(sn_upd) && not(*rx_window)[sn_upd].fully_received)) {
-        break;
-      }
-    }
-    st.rx_highest_status = sn_upd;
+    st.rx_highest_status = rx_sdus_complete.find_next(st.rx_next_status_trigger, st.rx_next_highest, false);
     if (not valid_ack_sn(st.rx_highest_status)) {
       RlcError("Rx_Highest_Status not inside RX window");
       debug_state();
@@ -1919,12 +1904,6 @@ void rlc_am_nr_rx::write_to_upper_layers(uint32_t lcid, unique_byte_buffer_t sdu
 /*
  * Segment Helpers
  */
-void rlc_am_nr_rx::insert_received_segment(rlc_amd_rx_pdu_nr                                   segment,
-                                           std::set<rlc_amd_rx_pdu_nr, rlc_amd_rx_pdu_nr_cmp>& segment_list) const
-{
-  segment_list.insert(std::move(segment));
-}
-
 void rlc_am_nr_rx::update_segment_inventory(rlc_amd_rx_sdu_nr_t& rx_sdu) const
 {
   if (rx_sdu.segments.empty()) {
@@ -1933,31 +1912,28 @@ void rlc_am_nr_rx::update_segment_inventory(rlc_amd_rx_sdu_nr_t& rx_sdu) const
     return;
   }
 
-  // Check for gaps and if all segments have been received
-  uint32_t next_byte = 0;
-  for (const auto& it : rx_sdu.segments) {
-    if (it.header.so != next_byte) {
-      // Found gap: set flags and return
-      rx_sdu.has_gap        = true;
-      rx_sdu.fully_received = false;
-      return;
-    }
-    if (it.header.si == rlc_nr_si_field_t::last_segment) {
-      // Reached last segment without any gaps: set flags and return
-      rx_sdu.has_gap        = false;
-      rx_sdu.fully_received = true;
-      return;
-    }
-    next_byte += it.buf->N_bytes;
-  }
-  // No gaps, but last segment not yet received
-  rx_sdu.has_gap        = false;
-  rx_sdu.fully_received = false;
+  // The received bytes are merged into ranges, so any range beyond the first one, or a first one not starting at the
+  // beginning of the SDU, means a gap. The SDU is complete when the single range reaches the end of the last segment
+  rx_sdu.has_gap        = rx_sdu.segments.size() > 1 || rx_sdu.segments.front().start() != 0;
+  rx_sdu.fully_received = not rx_sdu.has_gap && rx_sdu.sdu_len != 0 && rx_sdu.segments.front().stop() == rx_sdu.sdu_len;
 }
 
 /*
  * Window Helpers
  */
+rlc_amd_rx_sdu_nr_t& rlc_am_nr_rx::add_rx_sdu(uint32_t sn)
+{
+  rx_sdus_present.set(sn);
+  return rx_window->add_pdu(sn);
+}
+
+void rlc_am_nr_rx::remove_rx_sdu(uint32_t sn)
+{
+  rx_window->remove_pdu(sn);
+  rx_sdus_present.reset(sn);
+  rx_sdus_complete.reset(sn);
+}
+
 uint32_t rlc_am_nr_rx::rx_mod_base_nr(uint32_t sn) const
 {
   return (sn - st.rx_next) % mod_nr;
@@ -2019,4 +1995,10 @@ uint32_t rlc_am_nr_rx::get_rx_buffered_bytes()
 {
   return 0;
 }
+
+size_t rlc_am_nr_rx::get_memory_usage()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return sizeof(*this) + (rx_window != nullptr ? rx_window->memory_usage() : 0);
+}
 } // namespace srsran
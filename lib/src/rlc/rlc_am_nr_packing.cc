@@ -59,6 +59,12 @@ bool rlc_am_nr_status_pdu_t::is_continuous_sequence(const rlc_status_nack_t& lef
     return false;
   }
 
+  // The joint NACK range must fit into its 8 bit field
+  uint32_t range = (left.has_nack_range ? left.nack_range : 1) + (right.has_nack_range ? right.nack_range : 1);
+  if (range > std::numeric_limits<uint8_t>::max()) {
+    return false;
+  }
+
   return true;
 }
 
@@ -144,7 +144,9 @@ void rlc_tm::get_buffer_state(uint32_t& newtx_queue, uint32_t& prio_tx_queue)
 rlc_bearer_metrics_t rlc_tm::get_metrics()
 {
   std::lock_guard<std::mutex> lock(metrics_mutex);
-  return metrics;
+  rlc_bearer_metrics_t        ret = metrics;
+  ret.mem_bytes                   = sizeof(*this);
+  return ret;
 }
 
 void rlc_tm::reset_metrics()
@@ -162,6 +164,7 @@ uint32_t rlc_tm::read_pdu(uint8_t* payload, uint32_t nof_bytes)
   }
   unique_byte_buffer_t buf;
   if (ul_queue.try_read(&buf)) {
+    tx_sdu_dequeued(*buf);
     pdu_size = buf->N_bytes;
     memcpy(payload, buf->msg, buf->N_bytes);
     RlcDebug("Complete SDU scheduled for tx. Stack latency: %" PRIu64 " us", (uint64_t)buf->get_latency_us().count());
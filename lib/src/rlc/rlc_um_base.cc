@@ -123,6 +123,13 @@ bool rlc_um_base::sdu_queue_is_full()
   return tx->sdu_queue_is_full();
 }
 
+void rlc_um_base::set_tx_budget(byte_buffer_budget* budget)
+{
+  if (tx != nullptr) {
+    tx->set_tx_budget(budget);
+  }
+}
+
 /****************************************************************************
  * MAC interface
  ***************************************************************************/
@@ -181,7 +188,9 @@ void rlc_um_base::write_pdu(uint8_t* payload, uint32_t nof_bytes)
 rlc_bearer_metrics_t rlc_um_base::get_metrics()
 {
   std::lock_guard<std::mutex> lock(metrics_mutex);
-  return metrics;
+  rlc_bearer_metrics_t        ret = metrics;
+  ret.mem_bytes                   = sizeof(*this);
+  return ret;
 }
 
 void rlc_um_base::reset_metrics()
@@ -326,9 +335,13 @@ bool rlc_um_base::rlc_um_base_tx::sdu_queue_is_full()
   return tx_sdu_queue.is_full();
 }
 
+void rlc_um_base::rlc_um_base_tx::set_tx_budget(byte_buffer_budget* budget)
+{
+  tx_sdu_queue.set_budget(budget);
+}
+
 uint32_t rlc_um_base::rlc_um_base_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
-  unique_byte_buffer_t pdu;
   {
     std::lock_guard<std::mutex> lock(mutex);
     RlcDebug("MAC opportunity - %d bytes", nof_bytes);
@@ -337,14 +350,8 @@ uint32_t rlc_um_base::rlc_um_base_tx::build_data_pdu(uint8_t* payload, uint32_t
       RlcInfo("No data available to be sent");
       return 0;
     }
-
-    pdu = make_byte_buffer();
-    if (!pdu || pdu->N_bytes != 0) {
-      RlcError("Failed to allocate PDU buffer");
-      return 0;
-    }
   }
-  return build_data_pdu(std::move(pdu), payload, nof_bytes);
+  return pack_data_pdu(payload, nof_bytes);
 }
 
 } // namespace srsran
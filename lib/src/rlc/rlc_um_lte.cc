@@ -27,6 +27,9 @@
 
 namespace srsran {
 
+// The PDUs do not exceed a byte buffer, where the receiving side stores them before reassembly
+static const uint32_t max_pdu_size = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+
 rlc_um_lte::rlc_um_lte(srslog::basic_logger&      logger,
                        uint32_t                   lcid_,
                        srsue::pdcp_interface_rlc* pdcp_,
@@ -121,7 +124,7 @@ bool rlc_um_lte::rlc_um_lte_tx::configure(const rlc_config_t& cnfg_, std::string
   return true;
 }
 
-uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes)
+uint32_t rlc_um_lte::rlc_um_lte_tx::pack_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   std::lock_guard<std::mutex> lock(mutex);
   rlc_umd_pdu_header_t        header = {};
@@ -132,45 +135,38 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
 
   uint32_t to_move = 0;
   uint32_t last_li = 0;
-  uint8_t* pdu_ptr = pdu->msg;
 
   int head_len  = rlc_um_packed_length(&header);
-  int pdu_space = SRSRAN_MIN(nof_bytes, pdu->get_tailroom());
+  int pdu_space = SRSRAN_MIN(nof_bytes, max_pdu_size);
 
   if (pdu_space <= head_len + 1) {
     RlcInfo("Cannot build a PDU - %d bytes available, %d bytes required for header", nof_bytes, head_len);
     return 0;
   }
 
+  // The header size is only known once the segmentation is decided, so the SDUs that fit entirely are set aside and
+  // only copied once the header has been written in front of them
+  pdu_sdus.clear();
+  uint32_t partial_len = 0;
+
   // Check for SDU segment
   if (tx_sdu) {
     uint32_t space = pdu_space - head_len;
     to_move        = space >= tx_sdu->N_bytes ? tx_sdu->N_bytes : space;
     RlcDebug("adding remainder of SDU segment - %d bytes of %d remaining", to_move, tx_sdu->N_bytes);
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
-    if (tx_sdu->N_bytes == 0) {
-#ifdef ENABLE_TIMESTAMP
-      auto latency_us = tx_sdu->get_latency_us().count();
-      mean_pdu_latency_us.push(latency_us);
-      RlcDebug("Complete SDU scheduled for tx. Stack latency (last/average): %" PRIu64 "/%ld us",
-               (uint64_t)latency_us,
-               (long)mean_pdu_latency_us.value());
-#else
-      RlcDebug("%s Complete SDU scheduled for tx.", rb_name.c_str());
-#endif
-      tx_sdu.reset();
+    if (to_move == tx_sdu->N_bytes) {
+      pdu_sdus.push_back(std::move(tx_sdu));
+    } else {
+      partial_len = to_move;
     }
-    pdu_space -= SRSRAN_MIN(to_move, pdu->get_tailroom());
+    pdu_space -= to_move;
     header.fi |= RLC_FI_FIELD_NOT_START_ALIGNED; // First byte does not correspond to first byte of SDU
   }
 
   // Pull SDUs from queue
-  while (pdu_space > head_len + 1 && tx_sdu_queue.size() > 0) {
+  while (tx_sdu == nullptr && pdu_space > head_len + 1 && tx_sdu_queue.size() > 0 &&
+         header.N_li < RLC_AM_WINDOW_SIZE) {
     RlcDebug("pdu_space=%d, head_len=%d", pdu_space, head_len);
     if (last_li > 0) {
       header.li[header.N_li++] = last_li;
@@ -182,26 +178,15 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
       header.N_li--;
       break;
     }
-    tx_sdu  = tx_sdu_queue.read();
+    tx_sdu = tx_sdu_queue.read();
+    parent->tx_sdu_dequeued(*tx_sdu);
     to_move = (space >= tx_sdu->N_bytes) ? tx_sdu->N_bytes : space;
     RlcDebug("adding new SDU segment - %d bytes of %d remaining", to_move, tx_sdu->N_bytes);
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
-    if (tx_sdu->N_bytes == 0) {
-#ifdef ENABLE_TIMESTAMP
-      auto latency_us = tx_sdu->get_latency_us().count();
-      mean_pdu_latency_us.push(latency_us);
-      RlcDebug("Complete SDU scheduled for tx. Stack latency (last/average): %" PRIu64 "/%ld us",
-               (uint64_t)latency_us,
-               (long)mean_pdu_latency_us.value());
-#else
-      RlcDebug("Complete SDU scheduled for tx.");
-#endif
-      tx_sdu.reset();
+    if (to_move == tx_sdu->N_bytes) {
+      pdu_sdus.push_back(std::move(tx_sdu));
+    } else {
+      partial_len = to_move;
     }
     pdu_space -= to_move;
   }
@@ -214,15 +199,35 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
   header.sn = vt_us;
   vt_us     = (vt_us + 1) % cfg.um.tx_mod;
 
-  // Add header and TX
-  rlc_um_write_data_pdu_header(&header, pdu.get());
-  memcpy(payload, pdu->msg, pdu->N_bytes);
+  // Write header and data in the MAC payload
+  uint8_t* pdu_ptr = payload + rlc_um_write_data_pdu_header(&header, payload);
+  for (unique_byte_buffer_t& sdu : pdu_sdus) {
+    memcpy(pdu_ptr, sdu->msg, sdu->N_bytes);
+    pdu_ptr += sdu->N_bytes;
+#ifdef ENABLE_TIMESTAMP
+    auto latency_us = sdu->get_latency_us().count();
+    mean_pdu_latency_us.push(latency_us);
+    RlcDebug("Complete SDU scheduled for tx. Stack latency (last/average): %" PRIu64 "/%ld us",
+             (uint64_t)latency_us,
+             (long)mean_pdu_latency_us.value());
+#else
+    RlcDebug("Complete SDU scheduled for tx.");
+#endif
+  }
+  pdu_sdus.clear();
+  if (partial_len > 0) {
+    memcpy(pdu_ptr, tx_sdu->msg, partial_len);
+    pdu_ptr += partial_len;
+    tx_sdu->N_bytes -= partial_len;
+    tx_sdu->msg += partial_len;
+  }
+  uint32_t pdu_len = pdu_ptr - payload;
 
-  RlcHexInfo(payload, pdu->N_bytes, "Tx PDU SN=%d (%d B)", header.sn, pdu->N_bytes);
+  RlcHexInfo(payload, pdu_len, "Tx PDU SN=%d (%d B)", header.sn, pdu_len);
 
   debug_state();
 
-  return pdu->N_bytes;
+  return pdu_len;
 }
 
 void rlc_um_lte::rlc_um_lte_tx::debug_state()
@@ -760,13 +765,17 @@ void rlc_um_read_data_pdu_header(uint8_t*              payload,
 }
 
 void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* pdu)
+{
+  // Make room for the header
+  pdu->msg -= rlc_um_packed_length(header);
+  pdu->N_bytes += rlc_um_write_data_pdu_header(header, pdu->msg);
+}
+
+uint32_t rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, uint8_t* payload)
 {
   uint32_t i;
   uint8_t  ext = (header->N_li > 0) ? 1 : 0;
-  // Make room for the header
-  uint32_t len = rlc_um_packed_length(header);
-  pdu->msg -= len;
-  uint8_t* ptr = pdu->msg;
+  uint8_t* ptr = payload;
 
   // Fixed part
   if (header->sn_size == rlc_umd_sn_size_t::size5bits) {
@@ -806,7 +815,7 @@ void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* p
   if (header->N_li % 2 == 1)
     ptr++;
 
-  pdu->N_bytes += ptr - pdu->msg;
+  return ptr - payload;
 }
 
 uint32_t rlc_um_packed_length(rlc_umd_pdu_header_t* header)
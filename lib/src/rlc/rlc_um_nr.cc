@@ -27,6 +27,9 @@
 
 namespace srsran {
 
+// Largest PDU, bounded by the byte buffer the peer reassembles it in
+static const uint32_t max_pdu_size = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+
 rlc_um_nr::rlc_um_nr(srslog::basic_logger&      logger,
                      uint32_t                   lcid_,
                      srsue::pdcp_interface_rlc* pdcp_,
@@ -136,7 +139,7 @@ bool rlc_um_nr::rlc_um_nr_tx::configure(const rlc_config_t& cnfg_, std::string r
   return true;
 }
 
-uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes)
+uint32_t rlc_um_nr::rlc_um_nr_tx::pack_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   // Sanity check (we need at least 2B for a SDU)
   if (nof_bytes < 2) {
@@ -150,7 +153,7 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8
   header.sn                          = TX_Next;
   header.sn_size                     = cfg.um_nr.sn_field_length;
 
-  uint32_t pdu_space = SRSRAN_MIN(nof_bytes, pdu->get_tailroom());
+  uint32_t pdu_space = SRSRAN_MIN(nof_bytes, max_pdu_size);
 
   // Select segmentation information and header size
   if (tx_sdu == nullptr) {
@@ -162,6 +165,7 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8
       RlcDebug("Cannot build any PDU, tx_sdu_queue has no non-null SDU.");
       return 0;
     }
+    parent->tx_sdu_dequeued(*tx_sdu);
     next_so = 0;
 
     // Check for full SDU case
@@ -194,11 +198,10 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8
   // Log
   RlcDebug("adding %s - (%d/%d)", to_string(header.si).c_str(), to_move, tx_sdu->N_bytes);
 
-  // Move data from SDU to PDU
-  uint8_t* pdu_ptr = pdu->msg;
+  // Write header and data in the MAC payload
+  uint8_t* pdu_ptr = payload + rlc_um_nr_write_data_pdu_header(header, payload);
   memcpy(pdu_ptr, tx_sdu->msg, to_move);
   pdu_ptr += to_move;
-  pdu->N_bytes += to_move;
   tx_sdu->N_bytes -= to_move;
   tx_sdu->msg += to_move;
 
@@ -215,11 +218,7 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8
     TX_Next = (TX_Next + 1) % mod;
     next_so = 0;
   }
-
-  // Add header and TX
-  rlc_um_nr_write_data_pdu_header(header, pdu.get());
-  memcpy(payload, pdu->msg, pdu->N_bytes);
-  uint32_t ret = pdu->N_bytes;
+  uint32_t ret = pdu_ptr - payload;
 
   // Assert number of bytes
   srsran_expect(
@@ -227,9 +226,9 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8
 
   if (header.si == rlc_nr_si_field_t::full_sdu) {
     // log without SN
-    RlcHexInfo(payload, ret, "Tx PDU (%d B)", pdu->N_bytes);
+    RlcHexInfo(payload, ret, "Tx PDU (%d B)", ret);
   } else {
-    RlcHexInfo(payload, ret, "Tx PDU SN=%d (%d B)", header.sn, pdu->N_bytes);
+    RlcHexInfo(payload, ret, "Tx PDU SN=%d (%d B)", header.sn, ret);
   }
 
   debug_state();
@@ -711,7 +710,14 @@ uint32_t rlc_um_nr_write_data_pdu_header(const rlc_um_nr_pdu_header_t& header, b
   // Make room for the header
   uint32_t len = rlc_um_nr_packed_length(header);
   pdu->msg -= len;
-  uint8_t* ptr = pdu->msg;
+  pdu->N_bytes += rlc_um_nr_write_data_pdu_header(header, pdu->msg);
+
+  return len;
+}
+
+uint32_t rlc_um_nr_write_data_pdu_header(const rlc_um_nr_pdu_header_t& header, uint8_t* payload)
+{
+  uint8_t* ptr = payload;
 
   // write SI field
   *ptr = (header.si & 0x03) << 6; // 2 bits SI
@@ -740,9 +746,7 @@ uint32_t rlc_um_nr_write_data_pdu_header(const rlc_um_nr_pdu_header_t& header, b
     }
   }
 
-  pdu->N_bytes += ptr - pdu->msg;
-
-  return len;
+  return ptr - payload;
 }
 
 } // namespace srsran
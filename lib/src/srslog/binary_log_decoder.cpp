@@ -0,0 +1,73 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/// Renders a log written with the srslog binary formatter as text or JSON.
+
+#include "formatters/binary_formatter.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+int main(int argc, char** argv)
+{
+  if (argc < 2 || (argc == 3 && std::strcmp(argv[2], "--json") != 0) || argc > 3) {
+    fprintf(stderr, "Usage: %s <binary log file> [--json]\n", argv[0]);
+    return -1;
+  }
+  bool json = argc == 3;
+
+  int fd = ::open(argv[1], O_RDONLY);
+  if (fd < 0) {
+    perror("open");
+    return -1;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) < 0) {
+    perror("fstat");
+    ::close(fd);
+    return -1;
+  }
+  if (st.st_size == 0) {
+    ::close(fd);
+    return 0;
+  }
+
+  void* data = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    perror("mmap");
+    return -1;
+  }
+
+  fmt::memory_buffer buffer;
+  bool               ok = srslog::decode_binary_log(static_cast<const uint8_t*>(data), st.st_size, buffer, json);
+  ::munmap(data, st.st_size);
+
+  fwrite(buffer.data(), 1, buffer.size(), stdout);
+  if (!ok) {
+    fprintf(stderr, "%s: malformed binary log record, the output is truncated\n", argv[1]);
+    return -1;
+  }
+
+  return 0;
+}
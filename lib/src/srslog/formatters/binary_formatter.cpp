@@ -0,0 +1,427 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "binary_formatter.h"
+#include "json_formatter.h"
+#include "srsran/srslog/detail/log_entry_metadata.h"
+#include <cstring>
+
+using namespace srslog;
+
+namespace {
+
+/// Record types.
+enum : uint8_t { record_definition = 'D', record_entry = 'E', record_text = 'T' };
+
+/// Argument types.
+enum arg_type : uint8_t {
+  arg_unsupported = 0,
+  arg_int,
+  arg_uint,
+  arg_long_long,
+  arg_ulong_long,
+  arg_bool,
+  arg_char,
+  arg_float,
+  arg_double,
+  arg_long_double,
+  arg_string,
+  arg_pointer
+};
+
+/// Value of the number of args for format strings that take no args.
+const uint8_t no_arg_store = 0xff;
+
+/// Appends the raw bytes of the specified value into the buffer.
+template <typename T>
+void write_raw(const T& value, fmt::memory_buffer& buffer)
+{
+  const char* p = reinterpret_cast<const char*>(&value);
+  buffer.append(p, p + sizeof(T));
+}
+
+/// Appends the specified string, prefixed with its length, into the buffer.
+void write_string(fmt::string_view str, fmt::memory_buffer& buffer)
+{
+  write_raw<uint32_t>(str.size(), buffer);
+  buffer.append(str.data(), str.data() + str.size());
+}
+
+/// Writes each format argument as its type followed by its raw value.
+struct arg_writer {
+  fmt::memory_buffer& buffer;
+
+  void write(arg_type type) { buffer.push_back(static_cast<char>(type)); }
+
+  void operator()(int v)
+  {
+    write(arg_int);
+    write_raw(v, buffer);
+  }
+  void operator()(unsigned v)
+  {
+    write(arg_uint);
+    write_raw(v, buffer);
+  }
+  void operator()(long long v)
+  {
+    write(arg_long_long);
+    write_raw(v, buffer);
+  }
+  void operator()(unsigned long long v)
+  {
+    write(arg_ulong_long);
+    write_raw(v, buffer);
+  }
+  void operator()(bool v)
+  {
+    write(arg_bool);
+    write_raw<uint8_t>(v, buffer);
+  }
+  void operator()(char v)
+  {
+    write(arg_char);
+    buffer.push_back(v);
+  }
+  void operator()(float v)
+  {
+    write(arg_float);
+    write_raw(v, buffer);
+  }
+  void operator()(double v)
+  {
+    write(arg_double);
+    write_raw(v, buffer);
+  }
+  void operator()(long double v)
+  {
+    write(arg_long_double);
+    write_raw<double>(v, buffer);
+  }
+  void operator()(const char* v)
+  {
+    write(arg_string);
+    write_string(v, buffer);
+  }
+  void operator()(fmt::string_view v)
+  {
+    write(arg_string);
+    write_string(v, buffer);
+  }
+  void operator()(const void* v)
+  {
+    write(arg_pointer);
+    write_raw<uint64_t>(reinterpret_cast<uintptr_t>(v), buffer);
+  }
+  /// Custom and 128 bit types can not be stored raw.
+  template <typename T>
+  void operator()(T)
+  {
+    write(arg_unsupported);
+  }
+};
+
+} // namespace
+
+std::unique_ptr<log_formatter> binary_formatter::clone() const
+{
+  // Every sink writes its own definitions.
+  return std::unique_ptr<log_formatter>(new binary_formatter);
+}
+
+uint32_t binary_formatter::write_definition(fmt::string_view str, fmt::memory_buffer& buffer)
+{
+  uint32_t id = next_id++;
+  buffer.push_back(static_cast<char>(record_definition));
+  write_raw(id, buffer);
+  write_string(str, buffer);
+  return id;
+}
+
+uint32_t binary_formatter::get_fmtstring_id(const char* fmtstring, fmt::memory_buffer& buffer)
+{
+  auto it = fmtstring_ids.find(fmtstring);
+  if (it != fmtstring_ids.end()) {
+    return it->second;
+  }
+  uint32_t id = write_definition(fmtstring, buffer);
+  fmtstring_ids.emplace(fmtstring, id);
+  return id;
+}
+
+uint32_t binary_formatter::get_name_id(const std::string& name, fmt::memory_buffer& buffer)
+{
+  auto it = name_ids.find(name);
+  if (it != name_ids.end()) {
+    return it->second;
+  }
+  uint32_t id = write_definition(name, buffer);
+  name_ids.emplace(name, id);
+  return id;
+}
+
+void binary_formatter::format(detail::log_entry_metadata&& metadata, fmt::memory_buffer& buffer)
+{
+  if (!metadata.fmtstring) {
+    return;
+  }
+
+  // Definitions go before the entry that uses them.
+  uint32_t name_id = get_name_id(metadata.log_name, buffer);
+  uint32_t fmt_id  = get_fmtstring_id(metadata.fmtstring, buffer);
+
+  buffer.push_back(static_cast<char>(record_entry));
+  write_raw<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(metadata.tp.time_since_epoch()).count(),
+                      buffer);
+  write_raw(name_id, buffer);
+  buffer.push_back(metadata.log_tag);
+  buffer.push_back(static_cast<char>(metadata.context.enabled));
+  write_raw(metadata.context.value, buffer);
+  write_raw(fmt_id, buffer);
+
+  if (metadata.store) {
+    fmt::basic_format_args<fmt::basic_printf_context_t<char> > args(*metadata.store);
+    uint8_t                                                    nof_args = 0;
+    while (args.get(nof_args) && nof_args < no_arg_store - 1) {
+      ++nof_args;
+    }
+    buffer.push_back(static_cast<char>(nof_args));
+    arg_writer writer{buffer};
+    for (uint8_t i = 0; i != nof_args; ++i) {
+      fmt::visit_format_arg(writer, args.get(i));
+    }
+  } else {
+    buffer.push_back(static_cast<char>(no_arg_store));
+  }
+
+  write_raw<uint32_t>(metadata.hex_dump.size(), buffer);
+  buffer.append(metadata.hex_dump.data(), metadata.hex_dump.data() + metadata.hex_dump.size());
+}
+
+void binary_formatter::format_context_begin(const detail::log_entry_metadata& md,
+                                            fmt::string_view                  ctx_name,
+                                            unsigned                          size,
+                                            fmt::memory_buffer&               buffer)
+{
+  // The length of the text record is filled in once the context is rendered.
+  buffer.push_back(static_cast<char>(record_text));
+  text_len_pos = buffer.size();
+  write_raw<uint32_t>(0, buffer);
+  txt.format_context_begin(md, ctx_name, size, buffer);
+}
+
+void binary_formatter::format_context_end(const detail::log_entry_metadata& md,
+                                          fmt::string_view                  ctx_name,
+                                          fmt::memory_buffer&               buffer)
+{
+  txt.format_context_end(md, ctx_name, buffer);
+  uint32_t len = buffer.size() - text_len_pos - sizeof(uint32_t);
+  std::memcpy(buffer.data() + text_len_pos, &len, sizeof(len));
+}
+
+namespace {
+
+/// Reads the fields of a binary log, checking that they fit in the data.
+class record_reader
+{
+public:
+  record_reader(const uint8_t* data, size_t len) : ptr(data), end(data + len) {}
+
+  bool   empty() const { return ptr == end; }
+  size_t remaining() const { return end - ptr; }
+
+  template <typename T>
+  bool read(T& value)
+  {
+    if (remaining() < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, ptr, sizeof(T));
+    ptr += sizeof(T);
+    return true;
+  }
+
+  bool read_bytes(size_t len, const uint8_t*& bytes)
+  {
+    if (remaining() < len) {
+      return false;
+    }
+    bytes = ptr;
+    ptr += len;
+    return true;
+  }
+
+  bool read_string(std::string& str)
+  {
+    uint32_t       len;
+    const uint8_t* bytes;
+    if (!read(len) || !read_bytes(len, bytes)) {
+      return false;
+    }
+    str.assign(reinterpret_cast<const char*>(bytes), len);
+    return true;
+  }
+
+private:
+  const uint8_t* ptr;
+  const uint8_t* end;
+};
+
+/// Reads an argument and pushes it into the store.
+bool decode_arg(record_reader& reader, fmt::dynamic_format_arg_store<fmt::printf_context>& store)
+{
+  uint8_t type;
+  if (!reader.read(type)) {
+    return false;
+  }
+
+  switch (type) {
+    case arg_unsupported:
+      store.push_back("<?>");
+      return true;
+    case arg_int: {
+      int v;
+      return reader.read(v) && (store.push_back(v), true);
+    }
+    case arg_uint: {
+      unsigned v;
+      return reader.read(v) && (store.push_back(v), true);
+    }
+    case arg_long_long: {
+      long long v;
+      return reader.read(v) && (store.push_back(v), true);
+    }
+    case arg_ulong_long: {
+      unsigned long long v;
+      return reader.read(v) && (store.push_back(v), true);
+    }
+    case arg_bool: {
+      uint8_t v;
+      return reader.read(v) && (store.push_back(v != 0), true);
+    }
+    case arg_char: {
+      char v;
+      return reader.read(v) && (store.push_back(v), true);
+    }
+    case arg_float: {
+      float v;
+      return reader.read(v) && (store.push_back(v), true);
+    }
+    case arg_double: {
+      double v;
+      return reader.read(v) && (store.push_back(v), true);
+    }
+    case arg_long_double: {
+      double v;
+      return reader.read(v) && (store.push_back(static_cast<long double>(v)), true);
+    }
+    case arg_string: {
+      std::string v;
+      return reader.read_string(v) && (store.push_back(v), true);
+    }
+    case arg_pointer: {
+      uint64_t v;
+      return reader.read(v) && (store.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(v))), true);
+    }
+    default:
+      return false;
+  }
+}
+
+} // namespace
+
+bool srslog::decode_binary_log(const uint8_t* data, size_t len, fmt::memory_buffer& buffer, bool json)
+{
+  std::unordered_map<uint32_t, std::string> definitions;
+  record_reader                             reader(data, len);
+  text_formatter                            txt;
+  json_formatter                            js;
+  log_formatter&                            formatter = json ? static_cast<log_formatter&>(js) : txt;
+
+  while (!reader.empty()) {
+    uint8_t type;
+    reader.read(type);
+
+    switch (type) {
+      case record_definition: {
+        uint32_t id;
+        if (!reader.read(id) || !reader.read_string(definitions[id])) {
+          return false;
+        }
+        break;
+      }
+      case record_text: {
+        uint32_t       text_len;
+        const uint8_t* text;
+        if (!reader.read(text_len) || !reader.read_bytes(text_len, text)) {
+          return false;
+        }
+        buffer.append(text, text + text_len);
+        break;
+      }
+      case record_entry: {
+        uint64_t ns;
+        uint32_t name_id, fmt_id, hex_len;
+        uint8_t  tag, ctx_enabled, nof_args;
+        uint32_t ctx_value;
+        if (!reader.read(ns) || !reader.read(name_id) || !reader.read(tag) || !reader.read(ctx_enabled) ||
+            !reader.read(ctx_value) || !reader.read(fmt_id) || !reader.read(nof_args)) {
+          return false;
+        }
+        auto name_it = definitions.find(name_id);
+        auto fmt_it  = definitions.find(fmt_id);
+        if (name_it == definitions.end() || fmt_it == definitions.end()) {
+          return false;
+        }
+
+        fmt::dynamic_format_arg_store<fmt::printf_context> store;
+        if (nof_args != no_arg_store) {
+          for (uint8_t i = 0; i != nof_args; ++i) {
+            if (!decode_arg(reader, store)) {
+              return false;
+            }
+          }
+        }
+
+        const uint8_t* hex;
+        if (!reader.read(hex_len) || !reader.read_bytes(hex_len, hex)) {
+          return false;
+        }
+
+        using tp_ty = std::chrono::high_resolution_clock::time_point;
+        detail::log_entry_metadata metadata{
+            tp_ty(std::chrono::duration_cast<tp_ty::duration>(std::chrono::nanoseconds(ns))),
+            {ctx_value, ctx_enabled != 0},
+            fmt_it->second.c_str(),
+            nof_args != no_arg_store ? &store : nullptr,
+            name_it->second,
+            static_cast<char>(tag),
+            detail::hex_dump_buffer(hex, hex + hex_len)};
+        formatter.format(std::move(metadata), buffer);
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+
+  return true;
+}
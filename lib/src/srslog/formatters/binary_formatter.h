@@ -0,0 +1,127 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSLOG_BINARY_FORMATTER_H
+#define SRSLOG_BINARY_FORMATTER_H
+
+#include "text_formatter.h"
+#include <unordered_map>
+
+namespace srslog {
+
+/// Binary formatter class implementation.
+/// Log entries are not rendered: each one is written as a compact record with
+/// the format string ID, the raw arguments and the hex dump, which is much
+/// cheaper for the backend than formatting text. Format strings and log names
+/// are written once as definition records, and referenced by ID afterwards.
+/// Context entries are rendered as text records. The output is decoded later
+/// with decode_binary_log().
+///
+/// Records start with a one byte type, and their fields are in host byte order:
+///   'D': u32 id, u32 length, string bytes.
+///   'E': u64 ns since epoch, u32 name id, u8 tag, u8 context enabled,
+///        u32 context value, u32 format string id, u8 number of args (0xff
+///        when the format string takes no args), args, u32 hex dump length,
+///        hex dump bytes. Each arg is a u8 type followed by its value.
+///   'T': u32 length, text bytes.
+///
+/// NOTE: the definitions are only written once per formatter, so a binary log
+/// must go into a single file sink, without a maximum file size.
+class binary_formatter : public log_formatter
+{
+public:
+  std::unique_ptr<log_formatter> clone() const override;
+
+  void format(detail::log_entry_metadata&& metadata, fmt::memory_buffer& buffer) override;
+
+private:
+  void format_context_begin(const detail::log_entry_metadata& md,
+                            fmt::string_view                  ctx_name,
+                            unsigned                          size,
+                            fmt::memory_buffer&               buffer) override;
+
+  void format_context_end(const detail::log_entry_metadata& md,
+                          fmt::string_view                  ctx_name,
+                          fmt::memory_buffer&               buffer) override;
+
+  void format_metric_set_begin(fmt::string_view    set_name,
+                               unsigned            size,
+                               unsigned            level,
+                               fmt::memory_buffer& buffer) override
+  {
+    txt.format_metric_set_begin(set_name, size, level, buffer);
+  }
+
+  void format_metric_set_end(fmt::string_view set_name, unsigned level, fmt::memory_buffer& buffer) override
+  {
+    txt.format_metric_set_end(set_name, level, buffer);
+  }
+
+  void format_list_begin(fmt::string_view list_name, unsigned size, unsigned level, fmt::memory_buffer& buffer) override
+  {
+    txt.format_list_begin(list_name, size, level, buffer);
+  }
+
+  void format_list_end(fmt::string_view list_name, unsigned level, fmt::memory_buffer& buffer) override
+  {
+    txt.format_list_end(list_name, level, buffer);
+  }
+
+  void format_metric(fmt::string_view    metric_name,
+                     fmt::string_view    metric_value,
+                     fmt::string_view    metric_units,
+                     metric_kind         kind,
+                     unsigned            level,
+                     fmt::memory_buffer& buffer) override
+  {
+    txt.format_metric(metric_name, metric_value, metric_units, kind, level, buffer);
+  }
+
+  /// Returns the ID of the specified format string, writing its definition
+  /// into the buffer the first time it is seen.
+  uint32_t get_fmtstring_id(const char* fmtstring, fmt::memory_buffer& buffer);
+
+  /// Returns the ID of the specified log name, writing its definition into the
+  /// buffer the first time it is seen.
+  uint32_t get_name_id(const std::string& name, fmt::memory_buffer& buffer);
+
+  /// Writes a definition record into the buffer.
+  uint32_t write_definition(fmt::string_view str, fmt::memory_buffer& buffer);
+
+private:
+  /// Format strings are literals, so they are looked up by address.
+  std::unordered_map<const char*, uint32_t> fmtstring_ids;
+  std::unordered_map<std::string, uint32_t> name_ids;
+  uint32_t                                  next_id = 0;
+  /// Renders the context entries.
+  text_formatter txt;
+  /// Position in the buffer of the length of the text record being written.
+  size_t text_len_pos = 0;
+};
+
+/// Decodes the records of a binary log, rendering each log entry with the
+/// text formatter, or the JSON formatter when json is true. Returns false when
+/// the data is not a well formed binary log.
+bool decode_binary_log(const uint8_t* data, size_t len, fmt::memory_buffer& buffer, bool json = false);
+
+} // namespace srslog
+
+#endif // SRSLOG_BINARY_FORMATTER_H
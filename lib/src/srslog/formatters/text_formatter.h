@@ -37,6 +37,9 @@ public:
   void format(detail::log_entry_metadata&& metadata, fmt::memory_buffer& buffer) override;
 
 private:
+  /// The binary formatter renders the context entries as text.
+  friend class binary_formatter;
+
   void format_context_begin(const detail::log_entry_metadata& md,
                             fmt::string_view                  ctx_name,
                             unsigned                          size,
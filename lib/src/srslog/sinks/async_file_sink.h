@@ -0,0 +1,246 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSLOG_ASYNC_FILE_SINK_H
+#define SRSLOG_ASYNC_FILE_SINK_H
+
+#include "file_utils.h"
+#include "srsran/srslog/detail/support/thread_utils.h"
+#include "srsran/srslog/sink.h"
+#include <thread>
+#include <vector>
+
+namespace srslog {
+
+/// This sink implementation writes to files from a dedicated writer thread, so
+/// that the caller never waits for the disk. Incoming data is appended into an
+/// active buffer, which is handed over to the writer thread once it holds
+/// chunk_size bytes, or after one second, while a second buffer keeps taking
+/// new data. When the writer falls behind and the active buffer reaches
+/// max_pending bytes, new data is discarded.
+/// Includes the optional feature of file rotation: a new file is created when
+/// file size exceeds an established threshold.
+class async_file_sink : public sink
+{
+public:
+  async_file_sink(std::string                    name,
+                  size_t                         max_size,
+                  size_t                         chunk_size,
+                  std::unique_ptr<log_formatter> f) :
+    sink(std::move(f)),
+    max_size((max_size == 0) ? 0 : std::max<size_t>(max_size, 4 * 1024)),
+    chunk_size(std::max<size_t>(chunk_size, 4 * 1024)),
+    max_pending(8 * this->chunk_size),
+    base_filename(std::move(name))
+  {
+    active.reserve(this->chunk_size);
+    pending.reserve(this->chunk_size);
+    writer = std::thread([this]() { run_writer(); });
+  }
+
+  ~async_file_sink() override
+  {
+    flush();
+    cvar.lock();
+    running = false;
+    cvar.broadcast();
+    cvar.unlock();
+    writer.join();
+  }
+
+  async_file_sink(const async_file_sink& other) = delete;
+  async_file_sink& operator=(const async_file_sink& other) = delete;
+
+  detail::error_string write(detail::memory_buffer buffer) override
+  {
+    cvar.lock();
+
+    // Report the errors of the writer thread.
+    if (writer_err) {
+      auto err = std::move(writer_err);
+      writer_err = {};
+      cvar.unlock();
+      return err;
+    }
+
+    // Never wait for the writer thread, discard the data instead.
+    if (active.size() + buffer.size() > max_pending) {
+      bool first_drop = nof_dropped_bytes == 0;
+      nof_dropped_bytes += buffer.size();
+      cvar.unlock();
+      if (first_drop) {
+        return fmt::format("Log file sink \"{}\" can not keep up with the incoming data, discarding it",
+                           base_filename);
+      }
+      return {};
+    }
+    nof_dropped_bytes = 0;
+
+    // Mark the point where a new file starts.
+    current_size += buffer.size();
+    if (max_size && current_size >= max_size) {
+      current_size = buffer.size();
+      active_splits.push_back(active.size());
+    }
+
+    active.insert(active.end(), buffer.begin(), buffer.end());
+    if (active.size() >= chunk_size) {
+      hand_over_active();
+    }
+
+    cvar.unlock();
+    return {};
+  }
+
+  detail::error_string flush() override
+  {
+    cvar.lock();
+    wait_writer();
+    flush_requested = true;
+    hand_over_active();
+    wait_writer();
+    auto err   = std::move(writer_err);
+    writer_err = {};
+    cvar.unlock();
+    return err;
+  }
+
+protected:
+  /// Returns the current file index.
+  uint32_t get_file_index() const { return file_index; }
+
+private:
+  /// Hands the active buffer over to the writer thread, unless it is still
+  /// writing the previous one.
+  /// NOTE: must be called with the mutex held.
+  void hand_over_active()
+  {
+    if (writer_busy || (active.empty() && !flush_requested)) {
+      return;
+    }
+    std::swap(active, pending);
+    std::swap(active_splits, pending_splits);
+    writer_busy = true;
+    cvar.broadcast();
+  }
+
+  /// Waits until the writer thread is idle.
+  /// NOTE: must be called with the mutex held.
+  void wait_writer()
+  {
+    while (writer_busy) {
+      cvar.wait();
+    }
+  }
+
+  /// Creates a new file and increments the file index counter.
+  detail::error_string create_file()
+  {
+    return handler.create(file_utils::build_filename_with_index(base_filename, file_index++));
+  }
+
+  /// Writes the pending buffer into the files.
+  detail::error_string write_pending(bool do_flush)
+  {
+    // Create a new file the first time data is written.
+    if (file_index == 0 && !pending.empty()) {
+      if (auto err = create_file()) {
+        return err;
+      }
+    }
+
+    size_t offset = 0;
+    for (size_t split : pending_splits) {
+      if (auto err = handler.write(detail::memory_buffer(pending.data() + offset, split - offset))) {
+        return err;
+      }
+      if (auto err = create_file()) {
+        return err;
+      }
+      offset = split;
+    }
+    if (auto err = handler.write(detail::memory_buffer(pending.data() + offset, pending.size() - offset))) {
+      return err;
+    }
+
+    // Hand the data over to the kernel with every chunk.
+    if (do_flush || !pending.empty()) {
+      return handler.flush();
+    }
+    return {};
+  }
+
+  void run_writer()
+  {
+    cvar.lock();
+    while (true) {
+      while (!writer_busy && running) {
+        // Write the buffered data at least once per second.
+        if (cvar.wait(cvar.build_timeout(1000)) && !active.empty()) {
+          hand_over_active();
+        }
+      }
+      if (!writer_busy) {
+        break;
+      }
+      bool do_flush   = flush_requested;
+      flush_requested = false;
+      cvar.unlock();
+
+      // The pending buffer belongs to the writer thread while it is busy.
+      auto err = write_pending(do_flush);
+      pending.clear();
+      pending_splits.clear();
+
+      cvar.lock();
+      if (err) {
+        writer_err = std::move(err);
+      }
+      writer_busy = false;
+      cvar.broadcast();
+    }
+    cvar.unlock();
+  }
+
+private:
+  const size_t               max_size;
+  const size_t               chunk_size;
+  const size_t               max_pending;
+  const std::string          base_filename;
+  file_utils::file           handler;
+  size_t                     current_size = 0;
+  uint32_t                   file_index   = 0;
+  std::vector<char>          active;
+  std::vector<char>          pending;
+  std::vector<size_t>        active_splits;
+  std::vector<size_t>        pending_splits;
+  detail::condition_variable cvar;
+  detail::error_string       writer_err;
+  size_t                     nof_dropped_bytes = 0;
+  bool                       writer_busy       = false;
+  bool                       flush_requested   = false;
+  bool                       running           = true;
+  std::thread                writer;
+};
+
+} // namespace srslog
+
+#endif // SRSLOG_ASYNC_FILE_SINK_H
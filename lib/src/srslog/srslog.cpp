@@ -20,7 +20,9 @@
  */
 
 #include "srsran/srslog/srslog.h"
+#include "formatters/binary_formatter.h"
 #include "formatters/json_formatter.h"
+#include "sinks/async_file_sink.h"
 #include "sinks/file_sink.h"
 #include "sinks/syslog_sink.h"
 #include "srslog_instance.h"
@@ -105,6 +107,11 @@ std::unique_ptr<log_formatter> srslog::create_json_formatter()
   return std::unique_ptr<log_formatter>(new json_formatter);
 }
 
+std::unique_ptr<log_formatter> srslog::create_binary_formatter()
+{
+  return std::unique_ptr<log_formatter>(new binary_formatter);
+}
+
 ///
 /// Sink management function implementations.
 ///
@@ -178,6 +185,27 @@ sink& srslog::fetch_file_sink(const std::string&             path,
   return *s;
 }
 
+sink& srslog::fetch_async_file_sink(const std::string&             path,
+                                    size_t                         max_size,
+                                    size_t                         chunk_size,
+                                    std::unique_ptr<log_formatter> f)
+{
+  assert(!path.empty() && "Empty path string");
+
+  if (auto* s = find_sink(path)) {
+    return *s;
+  }
+
+  //: TODO: GCC5 or lower versions emits an error if we use the new() expression
+  // directly, use redundant piecewise_construct instead.
+  auto& s = srslog_instance::get().get_sink_repo().emplace(
+      std::piecewise_construct,
+      std::forward_as_tuple(path),
+      std::forward_as_tuple(new async_file_sink(path, max_size, chunk_size, std::move(f))));
+
+  return *s;
+}
+
 sink& srslog::fetch_syslog_sink(const std::string&             preamble_,
                                 syslog_local_type              log_local_,
                                 std::unique_ptr<log_formatter> f)
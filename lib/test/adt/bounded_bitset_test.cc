@@ -278,6 +278,54 @@ void test_bitset_find()
   }
 }
 
+template <bool reversed>
+void test_bitset_fit()
+{
+  {
+    srsran::bounded_bitset<25, reversed> bitset(10);
+
+    // 0b0000000000
+    TESTASSERT(bitset.find_first_fit(10, 0, 10, false) == 0);
+    TESTASSERT(bitset.find_first_fit(1, 0, 10) == -1);
+    TESTASSERT(bitset.find_best_fit(1, 0, 10) == -1);
+    TESTASSERT(bitset.count(0, 10) == 0);
+
+    // 0b0001001000
+    bitset.set(3);
+    bitset.set(6);
+    TESTASSERT(bitset.find_first_fit(3, 0, 10, false) == 0);
+    TESTASSERT(bitset.find_first_fit(3, 1, 10, false) == 7);
+    TESTASSERT(bitset.find_first_fit(4, 0, 10, false) == -1);
+    TESTASSERT(bitset.find_best_fit(2, 0, 10, false) == 4);
+    TESTASSERT(bitset.find_best_fit(3, 0, 10, false) == 0);
+    TESTASSERT(bitset.find_best_fit(5, 0, 10, false) == 0);
+    TESTASSERT(bitset.find_best_fit(2, 5, 10, false) == 7);
+    TESTASSERT(bitset.count(0, 10) == 2);
+    TESTASSERT(bitset.count(3, 6) == 1);
+    TESTASSERT(bitset.count(4, 6) == 0);
+  }
+  {
+    srsran::bounded_bitset<100, reversed> bitset(100);
+
+    // runs of ones at [10, 20), [60, 70) and [75, 100), crossing the word boundary at 64
+    bitset.fill(10, 20);
+    bitset.fill(60, 70);
+    bitset.fill(75, 100);
+    TESTASSERT(bitset.find_first_fit(10, 0, 100) == 10);
+    TESTASSERT(bitset.find_first_fit(10, 11, 100) == 60);
+    TESTASSERT(bitset.find_first_fit(20, 0, 100) == 75);
+    TESTASSERT(bitset.find_first_fit(30, 0, 100) == -1);
+    TESTASSERT(bitset.find_best_fit(11, 0, 100) == 75);
+    TESTASSERT(bitset.find_best_fit(30, 0, 100) == 75);
+    TESTASSERT(bitset.find_best_fit(30, 0, 90) == 75);
+    TESTASSERT(bitset.find_best_fit(30, 0, 80) == 10);
+    TESTASSERT(bitset.find_first_fit(40, 20, 60, false) == 20);
+    TESTASSERT(bitset.count(0, 100) == 45);
+    TESTASSERT(bitset.count(62, 66) == 4);
+    TESTASSERT(bitset.count(15, 80) == 20);
+  }
+}
+
 int main()
 {
   test_bit_operations();
@@ -289,6 +337,8 @@ int main()
   TESTASSERT(test_bitset_resize() == SRSRAN_SUCCESS);
   test_bitset_find<false>();
   test_bitset_find<true>();
+  test_bitset_fit<false>();
+  test_bitset_fit<true>();
   printf("Success\n");
   return 0;
 }
@@ -90,6 +90,35 @@ void test_id_map_wraparound()
   TESTASSERT(mymap.full());
 }
 
+void test_id_map_generation()
+{
+  static_circular_map<uint32_t, std::string, 4> mymap;
+
+  TESTASSERT(mymap.generation(1) == 0);
+  TESTASSERT(mymap.insert(1, "1"));
+  uint32_t gen = mymap.generation(1);
+  TESTASSERT(gen == 1 and mymap.generation(5) == gen);
+
+  // TEST: Failed insertions and insertions in other slots do not change the generation
+  TESTASSERT(not mymap.insert(5, "5"));
+  TESTASSERT(mymap.insert(2, "2"));
+  TESTASSERT(mymap.generation(1) == gen);
+
+  // TEST: The generation changes when the slot is reused, even by the same ID
+  TESTASSERT(mymap.erase(1));
+  TESTASSERT(mymap.generation(1) == gen);
+  TESTASSERT(mymap.insert(1, "1"));
+  TESTASSERT(mymap.generation(1) != gen);
+  gen = mymap.generation(1);
+  TESTASSERT(mymap.erase(1));
+  TESTASSERT(mymap.insert(5, "5"));
+  TESTASSERT(mymap.generation(1) != gen);
+
+  // TEST: The generations are kept across moves
+  static_circular_map<uint32_t, std::string, 4> mymap2 = std::move(mymap);
+  TESTASSERT(mymap2.generation(5) == gen + 1);
+}
+
 struct C {
   C() { count++; }
   ~C() { count--; }
@@ -140,6 +169,46 @@ void test_correct_destruction()
   TESTASSERT(C::count == 0);
 }
 
+void test_dyn_circular_map()
+{
+  dyn_circular_map<uint32_t, std::unique_ptr<int> > window(8);
+  TESTASSERT(window.capacity() == 8 and window.empty());
+
+  // The keys of a window of 8 consecutive values use distinct slots
+  for (uint32_t id = 5; id < 13; ++id) {
+    if (id != 7) {
+      TESTASSERT(window.insert(id, std::unique_ptr<int>(new int(id))));
+    }
+  }
+  TESTASSERT(window.size() == 7 and not window.full());
+  std::unique_ptr<int> dup(new int(0));
+  TESTASSERT(not window.insert(5, std::move(dup)));
+  TESTASSERT(dup != nullptr);
+  TESTASSERT(not window.insert(13, std::move(dup)));
+  TESTASSERT(not window.contains(7) and window.has_space(7));
+
+  // In-order flush
+  uint32_t next = 5;
+  while (window.contains(next)) {
+    TESTASSERT(*window.pop(next) == (int)next);
+    next++;
+  }
+  TESTASSERT(next == 7 and window.size() == 5);
+  TESTASSERT(window.insert(13, std::move(dup)));
+  TESTASSERT(window.contains(13) and *window[13] == 0);
+
+  uint32_t count = 0;
+  window.for_each([&count](uint32_t id, const std::unique_ptr<int>& obj) {
+    TESTASSERT(id == 13 or *obj == (int)id);
+    count++;
+  });
+  TESTASSERT(count == 6);
+
+  TESTASSERT(window.erase(8) and not window.erase(8));
+  window.clear();
+  TESTASSERT(window.empty() and not window.contains(9));
+}
+
 } // namespace srsran
 
 int main(int argc, char** argv)
@@ -151,7 +220,9 @@ int main(int argc, char** argv)
 
   srsran::test_id_map();
   srsran::test_id_map_wraparound();
+  srsran::test_id_map_generation();
   srsran::test_correct_destruction();
+  srsran::test_dyn_circular_map();
 
   printf("Success\n");
   return SRSRAN_SUCCESS;
@@ -117,6 +117,7 @@ void test_fixedsize_pool()
     }
     std::unique_ptr<BigObj> obj(new (std::nothrow) BigObj());
     TESTASSERT(obj == nullptr);
+    TESTASSERT(fixed_pool->get_stats().nof_alloc_failures == 1);
     vec.clear();
     obj = std::unique_ptr<BigObj>(new (std::nothrow) BigObj());
     TESTASSERT(obj != nullptr);
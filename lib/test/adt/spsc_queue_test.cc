@@ -0,0 +1,110 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/spsc_queue.h"
+#include "srsran/common/test_common.h"
+#include <memory>
+#include <thread>
+
+namespace srsran {
+
+void test_spsc_queue_api()
+{
+  spsc_queue<std::unique_ptr<int> > queue(4);
+  TESTASSERT(queue.max_size() == 4);
+  TESTASSERT(queue.empty() and not queue.full() and queue.size() == 0);
+
+  // push until full
+  for (int i = 0; i < 4; ++i) {
+    TESTASSERT(queue.try_push(std::unique_ptr<int>(new int(i))));
+    TESTASSERT(queue.size() == (size_t)i + 1);
+  }
+  TESTASSERT(queue.full());
+
+  // a failed push leaves the element untouched
+  std::unique_ptr<int> elem(new int(4));
+  TESTASSERT(not queue.try_push(std::move(elem)));
+  TESTASSERT(elem != nullptr and *elem == 4);
+
+  // modify in place
+  TESTASSERT(queue.apply_first([](std::unique_ptr<int>& e) {
+    if (*e == 2) {
+      e.reset();
+      return true;
+    }
+    return false;
+  }));
+  TESTASSERT(not queue.apply_first([](std::unique_ptr<int>& e) { return e != nullptr and *e == 2; }));
+
+  // pop in order, wrapping around the slots
+  TESTASSERT(*queue.front() == 0);
+  std::unique_ptr<int> out;
+  TESTASSERT(queue.try_pop(out) and *out == 0);
+  TESTASSERT(queue.try_push(std::move(elem)));
+  TESTASSERT(queue.try_pop(out) and *out == 1);
+  TESTASSERT(queue.try_pop(out) and out == nullptr);
+  TESTASSERT(queue.try_pop(out) and *out == 3);
+  TESTASSERT(queue.try_pop(out) and *out == 4);
+  TESTASSERT(queue.empty() and not queue.try_pop(out));
+
+  // resize
+  queue.set_size(10);
+  TESTASSERT(queue.max_size() == 10 and queue.empty());
+}
+
+void test_spsc_queue_threads()
+{
+  spsc_queue<int> queue(16);
+  const int       nof_elems = 100000;
+
+  std::thread t([&queue, nof_elems]() {
+    for (int i = 0; i < nof_elems; ++i) {
+      while (not queue.try_push(std::move(i))) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  int val = 0;
+  for (int i = 0; i < nof_elems; ++i) {
+    while (not queue.try_pop(val)) {
+      std::this_thread::yield();
+    }
+    TESTASSERT(val == i);
+  }
+  TESTASSERT(queue.empty());
+  t.join();
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  srsran::test_spsc_queue_api();
+  srsran::test_spsc_queue_threads();
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/asn1/rrc/dl_dcch_msg.h"
+#include "srsran/asn1/s1ap.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <cstdlib>
+
+using namespace asn1;
+
+/// Measures the time taken to unpack and pack again a message, and checks that the packed bytes are stable
+template <typename Msg>
+int run_benchmark(const char* name, const uint8_t* msg, uint32_t msg_len, uint32_t nof_iters)
+{
+  uint8_t buffer[1024], buffer2[1024];
+  Msg     pdu, pdu2;
+
+  auto     tic           = std::chrono::high_resolution_clock::now();
+  uint32_t nof_bytes_out = 0;
+  for (uint32_t i = 0; i < nof_iters; ++i) {
+    pdu = Msg{};
+    cbit_ref bref(msg, msg_len);
+    TESTASSERT(pdu.unpack(bref) == SRSASN_SUCCESS);
+  }
+  auto tac = std::chrono::high_resolution_clock::now();
+  for (uint32_t i = 0; i < nof_iters; ++i) {
+    bit_ref bref(buffer, sizeof(buffer));
+    TESTASSERT(pdu.pack(bref) == SRSASN_SUCCESS);
+    nof_bytes_out = bref.distance_bytes();
+  }
+  auto toc = std::chrono::high_resolution_clock::now();
+
+  cbit_ref bref(buffer, nof_bytes_out);
+  TESTASSERT(pdu2.unpack(bref) == SRSASN_SUCCESS);
+  bit_ref bref2(buffer2, sizeof(buffer2));
+  TESTASSERT(pdu2.pack(bref2) == SRSASN_SUCCESS);
+  TESTASSERT(bref2.distance_bytes() == (int)nof_bytes_out);
+  TESTASSERT(memcmp(buffer, buffer2, nof_bytes_out) == 0);
+
+  double unpack_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(tac - tic).count() / (double)nof_iters;
+  double pack_ns   = std::chrono::duration_cast<std::chrono::nanoseconds>(toc - tac).count() / (double)nof_iters;
+  printf("%-28s %4d bytes: unpack=%8.1f ns, pack=%8.1f ns\n", name, msg_len, unpack_ns, pack_ns);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  uint32_t nof_iters = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+
+  // S1AP InitialContextSetupRequest
+  uint8_t s1ap_ctxt_setup[] = {
+      0x00, 0x09, 0x00, 0x80, 0xc6, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x02, 0x00, 0x64, 0x00, 0x08, 0x00, 0x02, 0x00,
+      0x01, 0x00, 0x42, 0x00, 0x0a, 0x18, 0x3b, 0x9a, 0xca, 0x00, 0x60, 0x3b, 0x9a, 0xca, 0x00, 0x00, 0x18, 0x00, 0x78,
+      0x00, 0x00, 0x34, 0x00, 0x73, 0x45, 0x00, 0x09, 0x3c, 0x0f, 0x80, 0x0a, 0x00, 0x21, 0xf0, 0xb7, 0x36, 0x1c, 0x56,
+      0x64, 0x27, 0x3e, 0x5b, 0x04, 0xb7, 0x02, 0x07, 0x42, 0x02, 0x3e, 0x06, 0x00, 0x09, 0xf1, 0x07, 0x00, 0x07, 0x00,
+      0x37, 0x52, 0x66, 0xc1, 0x01, 0x09, 0x1b, 0x07, 0x74, 0x65, 0x73, 0x74, 0x31, 0x32, 0x33, 0x06, 0x6d, 0x6e, 0x63,
+      0x30, 0x37, 0x30, 0x06, 0x6d, 0x63, 0x63, 0x39, 0x30, 0x31, 0x04, 0x67, 0x70, 0x72, 0x73, 0x05, 0x01, 0xc0, 0xa8,
+      0x03, 0x02, 0x27, 0x0e, 0x80, 0x80, 0x21, 0x0a, 0x03, 0x00, 0x00, 0x0a, 0x81, 0x06, 0x08, 0x08, 0x08, 0x08, 0x50,
+      0x0b, 0xf6, 0x09, 0xf1, 0x07, 0x80, 0x01, 0x01, 0xf6, 0x7e, 0x72, 0x69, 0x13, 0x09, 0xf1, 0x07, 0x00, 0x01, 0x23,
+      0x05, 0xf4, 0xf6, 0x7e, 0x72, 0x69, 0x00, 0x6b, 0x00, 0x05, 0x18, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x49, 0x00, 0x20,
+      0x45, 0x25, 0xe4, 0x9a, 0x77, 0xc8, 0xd5, 0xcf, 0x26, 0x33, 0x63, 0xeb, 0x5b, 0xb9, 0xc3, 0x43, 0x9b, 0x9e, 0xb3,
+      0x86, 0x1f, 0xa8, 0xa7, 0xcf, 0x43, 0x54, 0x07, 0xae, 0x42, 0x2b, 0x63, 0xb9};
+
+  // S1AP UEContextReleaseCommand
+  uint8_t s1ap_ctxt_release[] = {0x00, 0x17, 0x00, 0x10, 0x00, 0x00, 0x02, 0x00, 0x63, 0x00, 0x04,
+                                 0x00, 0x02, 0x00, 0x01, 0x00, 0x02, 0x40, 0x01, 0x20};
+
+  // RRC Connection Reconfiguration with mobility control info
+  uint8_t rrc_reconf_ho[] = {0x20, 0x1b, 0x3f, 0x80, 0x00, 0x00, 0x00, 0x01, 0xa9, 0x08, 0x80, 0x00, 0x00, 0x29, 0x00,
+                             0x97, 0x80, 0x00, 0x00, 0x00, 0x01, 0x04, 0x22, 0x14, 0x00, 0xf8, 0x02, 0x0a, 0xc0, 0x60,
+                             0x00, 0xa0, 0x0c, 0x80, 0x42, 0x02, 0x9f, 0x43, 0x07, 0xda, 0xbc, 0xf8, 0x4b, 0x32, 0x18,
+                             0x34, 0xc0, 0x00, 0x2d, 0x68, 0x08, 0x5e, 0x18, 0x00, 0x16, 0x80, 0x00};
+
+  TESTASSERT(run_benchmark<s1ap::s1ap_pdu_c>(
+                 "S1AP InitialContextSetup", s1ap_ctxt_setup, sizeof(s1ap_ctxt_setup), nof_iters) == SRSRAN_SUCCESS);
+  TESTASSERT(run_benchmark<s1ap::s1ap_pdu_c>(
+                 "S1AP UEContextRelease", s1ap_ctxt_release, sizeof(s1ap_ctxt_release), nof_iters) == SRSRAN_SUCCESS);
+  TESTASSERT(run_benchmark<rrc::dl_dcch_msg_s>(
+                 "RRC ConnReconfiguration", rrc_reconf_ho, sizeof(rrc_reconf_ho), nof_iters) == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
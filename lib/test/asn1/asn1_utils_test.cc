@@ -195,6 +195,68 @@ int test_bit_ref()
   return 0;
 }
 
+int test_bit_ref_word_access()
+{
+  // Random fields, packed both by bit_ref and one bit at a time, must give the same bytes and unpack to the same values
+  const uint32_t nof_fields = 1000;
+  uint8_t        buf[8000], ref_buf[8000];
+  memset(buf, 0xff, sizeof(buf));
+  memset(ref_buf, 0xff, sizeof(ref_buf));
+
+  std::uniform_int_distribution<uint32_t> width_dist(0, 63);
+  std::vector<uint32_t>                   widths(nof_fields);
+  std::vector<uint64_t>                   values(nof_fields);
+  uint32_t                                nof_bits = 0;
+  bit_ref                                 bref(buf, sizeof(buf));
+  for (uint32_t i = 0; i < nof_fields; ++i) {
+    widths[i] = width_dist(g);
+    values[i] = (((uint64_t)g() << 32u) | g()) & (widths[i] == 0 ? 0 : (~0ull >> (64u - widths[i])));
+    TESTASSERT(bref.pack(values[i], widths[i]) == SRSASN_SUCCESS);
+    for (uint32_t b = 0; b < widths[i]; ++b, ++nof_bits) {
+      uint8_t bit  = (values[i] >> (widths[i] - 1 - b)) & 1u;
+      uint8_t mask = 0x80u >> (nof_bits % 8);
+      ref_buf[nof_bits / 8] = bit ? (ref_buf[nof_bits / 8] | mask) : (ref_buf[nof_bits / 8] & ~mask);
+    }
+    // The bits following the field in its last byte are zeroed, and the next bytes are left untouched
+    if (nof_bits % 8 != 0) {
+      ref_buf[nof_bits / 8] &= (uint8_t)(0xff00u >> (nof_bits % 8));
+    }
+    TESTASSERT(bref.distance(buf) == (int)nof_bits);
+  }
+  TESTASSERT(memcmp(buf, ref_buf, sizeof(buf)) == 0);
+
+  cbit_ref cbref(buf, bref.distance_bytes());
+  for (uint32_t i = 0; i < nof_fields; ++i) {
+    uint64_t val;
+    TESTASSERT(cbref.unpack(val, widths[i]) == SRSASN_SUCCESS);
+    TESTASSERT(val == values[i]);
+  }
+  TESTASSERT(cbref.distance() == (int)nof_bits);
+
+  // Octets at unaligned positions, across the word boundaries and the end of the buffer
+  for (uint32_t nof_bytes = 1; nof_bytes < 20; ++nof_bytes) {
+    uint8_t octets[20], octets2[20], small_buf[24] = {};
+    for (uint32_t i = 0; i < nof_bytes; ++i) {
+      octets[i] = g();
+    }
+    bit_ref bref2(small_buf, nof_bytes + 2);
+    TESTASSERT(bref2.pack(1, 3) == SRSASN_SUCCESS);
+    TESTASSERT(bref2.pack_bytes(octets, nof_bytes) == SRSASN_SUCCESS);
+    TESTASSERT(bref2.pack(5, 5) == SRSASN_SUCCESS);
+    TESTASSERT(bref2.distance() == (int)(8 * nof_bytes + 8));
+
+    cbit_ref cbref2(small_buf, nof_bytes + 2);
+    uint8_t  head, tail;
+    TESTASSERT(cbref2.unpack(head, 3) == SRSASN_SUCCESS);
+    TESTASSERT(cbref2.unpack_bytes(octets2, nof_bytes) == SRSASN_SUCCESS);
+    TESTASSERT(cbref2.unpack(tail, 5) == SRSASN_SUCCESS);
+    TESTASSERT(head == 1 and tail == 5);
+    TESTASSERT(memcmp(octets, octets2, nof_bytes) == 0);
+  }
+
+  return 0;
+}
+
 int test_oct_string()
 {
   uint8_t  buf[1024];
@@ -527,6 +589,63 @@ int test_copy_ptr()
   return 0;
 }
 
+int test_decode_arena()
+{
+  decode_arena arena(256);
+
+  // Outside of the scope, the arrays are allocated in the heap
+  dyn_array<uint32_t> heap_array(4);
+  TESTASSERT(arena.size() == 0);
+
+  {
+    dyn_array<uint32_t> list(4);
+    for (uint32_t i = 0; i < list.size(); ++i) {
+      list[i] = i;
+    }
+    uint8_t buf[64] = {};
+    bit_ref b(&buf[0], sizeof(buf));
+    TESTASSERT(pack_dyn_seq_of(b, list, 0, 8, integer_packer<uint32_t>(0, 15)) == SRSASN_SUCCESS);
+
+    dyn_array<dyn_array<uint8_t> > nested;
+    dyn_array<uint32_t>            list2;
+    dyn_array<uint8_t>             large;
+    {
+      decode_arena_scope scope(arena);
+      cbit_ref           b2(&buf[0], sizeof(buf));
+      TESTASSERT(unpack_dyn_seq_of(list2, b2, 0, 8, integer_packer<uint32_t>(0, 15)) == SRSASN_SUCCESS);
+      TESTASSERT(list2 == list);
+      nested.resize(2);
+      nested[1].resize(3);
+      TESTASSERT(arena.nof_live_arrays() == 3);
+      TESTASSERT(arena.size() > 0 and arena.size() <= arena.capacity());
+
+      // When the arena is exhausted, the allocation falls back to the heap
+      size_t used = arena.size();
+      large.resize(1024);
+      TESTASSERT(arena.size() == used);
+      TESTASSERT(arena.nof_live_arrays() == 3);
+    }
+
+    // The copies done outside of the scope are allocated in the heap
+    dyn_array<uint32_t> list3 = list2;
+    TESTASSERT(list3 == list);
+    TESTASSERT(arena.nof_live_arrays() == 3);
+
+    // Growing an array outside of the scope moves it to the heap
+    nested[1].resize(10);
+    TESTASSERT(arena.nof_live_arrays() == 2);
+
+    // The arena cannot be reset while arrays allocated from it are alive
+    TESTASSERT(not arena.reset());
+    TESTASSERT(arena.size() > 0);
+  }
+  TESTASSERT(arena.nof_live_arrays() == 0);
+  TESTASSERT(arena.reset());
+  TESTASSERT(arena.size() == 0);
+
+  return 0;
+}
+
 class EnumTest
 {
 public:
@@ -690,10 +809,12 @@ int main()
 
   TESTASSERT(test_arrays() == 0);
   TESTASSERT(test_bit_ref() == 0);
+  TESTASSERT(test_bit_ref_word_access() == 0);
   TESTASSERT(test_oct_string() == 0);
   TESTASSERT(test_bitstring() == 0);
   TESTASSERT(test_seq_of() == 0);
   TESTASSERT(test_copy_ptr() == 0);
+  TESTASSERT(test_decode_arena() == 0);
   TESTASSERT(test_enum() == 0);
   TESTASSERT(test_big_integers() == 0);
   test_varlength_field_pack();
@@ -362,6 +362,72 @@ int test_paging()
   return SRSRAN_SUCCESS;
 }
 
+int test_protocol_ie_index()
+{
+  s1ap_pdu_c tx_pdu;
+  tx_pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_UL_NAS_TRANSPORT);
+  ul_nas_transport_s& ul_nas = tx_pdu.init_msg().value.ul_nas_transport();
+  ul_nas->mme_ue_s1ap_id.value = 4000000000;
+  ul_nas->enb_ue_s1ap_id.value = 70000;
+  // Long enough for a two-byte length determinant
+  ul_nas->nas_pdu.value.resize(200);
+  for (uint32_t i = 0; i < ul_nas->nas_pdu.value.size(); ++i) {
+    ul_nas->nas_pdu.value[i] = i;
+  }
+  ul_nas->tai.value.tac.from_number(7);
+
+  uint8_t buffer[1024];
+  bit_ref bref(buffer, sizeof(buffer));
+  TESTASSERT(tx_pdu.pack(bref) == SRSASN_SUCCESS);
+
+  protocol_ie_index index;
+  TESTASSERT(index.index(buffer, bref.distance_bytes()) == SRSASN_SUCCESS);
+  TESTASSERT(index.pdu_type() == s1ap_pdu_c::types_opts::init_msg);
+  TESTASSERT(index.proc_code() == ASN1_S1AP_ID_UL_NAS_TRANSPORT);
+  TESTASSERT(not index.ext());
+  TESTASSERT(index.nof_ies() == 5);
+  TESTASSERT(index.find_ie(ASN1_S1AP_ID_LHN_ID) == nullptr);
+
+  mme_ue_s1ap_id_t mme_ue_s1ap_id;
+  enb_ue_s1ap_id_t enb_ue_s1ap_id;
+  tai_s            tai;
+  TESTASSERT(index.unpack_ie(ASN1_S1AP_ID_MME_UE_S1AP_ID, mme_ue_s1ap_id) == SRSASN_SUCCESS);
+  TESTASSERT(index.unpack_ie(ASN1_S1AP_ID_ENB_UE_S1AP_ID, enb_ue_s1ap_id) == SRSASN_SUCCESS);
+  TESTASSERT(index.unpack_ie(ASN1_S1AP_ID_TAI, tai) == SRSASN_SUCCESS);
+  TESTASSERT(mme_ue_s1ap_id.value == 4000000000);
+  TESTASSERT(enb_ue_s1ap_id.value == 70000);
+  TESTASSERT(tai.tac.to_number() == 7);
+
+  // The NAS-PDU is read in place
+  const uint8_t* nas_pdu;
+  uint32_t       nas_pdu_len;
+  TESTASSERT(index.get_octstring_ie(ASN1_S1AP_ID_NAS_PDU, nas_pdu, nas_pdu_len) == SRSASN_SUCCESS);
+  TESTASSERT(nas_pdu_len == ul_nas->nas_pdu.value.size());
+  TESTASSERT(nas_pdu > buffer and nas_pdu + nas_pdu_len <= buffer + bref.distance_bytes());
+  TESTASSERT(memcmp(nas_pdu, ul_nas->nas_pdu.value.data(), nas_pdu_len) == 0);
+
+  // A truncated PDU is rejected
+  TESTASSERT(index.index(buffer, bref.distance_bytes() - 1) != SRSASN_SUCCESS);
+
+  // Same IEs as the full unpack, for a PDU captured from a network
+  uint8_t s1ap_msg[] = {0x00, 0x12, 0x40, 0x15, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x02, 0x00, 0x01,
+                        0x00, 0x08, 0x00, 0x02, 0x00, 0x01, 0x00, 0x02, 0x40, 0x02, 0x02, 0x80};
+  cbit_ref   bref2(s1ap_msg, sizeof(s1ap_msg));
+  s1ap_pdu_c rx_pdu;
+  TESTASSERT(rx_pdu.unpack(bref2) == SRSASN_SUCCESS);
+  const ue_context_release_request_s& rel_req = rx_pdu.init_msg().value.ue_context_release_request();
+  TESTASSERT(index.index(s1ap_msg, sizeof(s1ap_msg)) == SRSASN_SUCCESS);
+  TESTASSERT(index.proc_code() == rx_pdu.init_msg().proc_code);
+  TESTASSERT(index.nof_ies() == 3);
+  TESTASSERT(index.unpack_ie(ASN1_S1AP_ID_MME_UE_S1AP_ID, mme_ue_s1ap_id) == SRSASN_SUCCESS);
+  TESTASSERT(mme_ue_s1ap_id.value == rel_req->mme_ue_s1ap_id.value.value);
+  cause_c cause;
+  TESTASSERT(index.unpack_ie(ASN1_S1AP_ID_CAUSE, cause) == SRSASN_SUCCESS);
+  TESTASSERT(cause.type() == rel_req->cause.value.type());
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   // Setup the log spy to intercept error and warning log entries.
@@ -397,6 +463,7 @@ int main()
   TESTASSERT(test_initial_ctxt_setup_response() == 0);
   TESTASSERT(test_eci_pack() == 0);
   TESTASSERT(test_paging() == 0);
+  TESTASSERT(test_protocol_ie_index() == 0);
 
   srslog::flush();
 
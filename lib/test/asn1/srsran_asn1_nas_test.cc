@@ -196,6 +196,84 @@ int downlink_generic_nas_transport_with_add_info_packing_test()
   return SRSRAN_SUCCESS;
 }
 
+int attach_request_view_test(uint8 sec_hdr_type)
+{
+  LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT  pdn_con_req = {};
+  LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT            attach_req  = {};
+  LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT            unpacked    = {};
+  LIBLTE_MME_ATTACH_REQUEST_VIEW_STRUCT           attach_view = {};
+  LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_VIEW_STRUCT pdn_view    = {};
+  LIBLTE_BYTE_MSG_STRUCT                          buf         = {};
+
+  pdn_con_req.eps_bearer_id                  = 0;
+  pdn_con_req.proc_transaction_id            = 1;
+  pdn_con_req.request_type                   = LIBLTE_MME_REQUEST_TYPE_INITIAL_REQUEST;
+  pdn_con_req.pdn_type                       = LIBLTE_MME_PDN_TYPE_IPV4;
+  pdn_con_req.esm_info_transfer_flag_present = true;
+  pdn_con_req.esm_info_transfer_flag         = LIBLTE_MME_ESM_INFO_TRANSFER_FLAG_REQUIRED;
+  pdn_con_req.apn_present                    = true;
+  strcpy(pdn_con_req.apn.apn, "srsapn");
+  TESTASSERT(liblte_mme_pack_pdn_connectivity_request_msg(&pdn_con_req, &attach_req.esm_msg) == LIBLTE_SUCCESS);
+
+  attach_req.eps_attach_type          = LIBLTE_MME_EPS_ATTACH_TYPE_EPS_ATTACH;
+  attach_req.nas_ksi.tsc_flag         = LIBLTE_MME_TYPE_OF_SECURITY_CONTEXT_FLAG_NATIVE;
+  attach_req.nas_ksi.nas_ksi          = LIBLTE_MME_NAS_KEY_SET_IDENTIFIER_NO_KEY_AVAILABLE;
+  attach_req.eps_mobile_id.type_of_id = LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI;
+  for (uint32_t i = 0; i < 15; ++i) {
+    attach_req.eps_mobile_id.imsi[i] = (i * 7) % 10;
+  }
+  attach_req.ue_network_cap.eea[0]  = true;
+  attach_req.ue_network_cap.eea[2]  = true;
+  attach_req.ue_network_cap.eia[1]  = true;
+  attach_req.ue_network_cap.eia[2]  = true;
+  attach_req.drx_param_present      = true;
+  attach_req.ms_network_cap_present = true;
+  attach_req.ms_network_cap.gea[1]  = true;
+  attach_req.ms_network_cap.epc     = true;
+  attach_req.tmsi_status_present    = true;
+  attach_req.tmsi_status            = LIBLTE_MME_TMSI_STATUS_VALID_TMSI;
+  TESTASSERT(liblte_mme_pack_attach_request_msg(&attach_req, sec_hdr_type, 5, &buf) == LIBLTE_SUCCESS);
+
+  // The view must carry the same content as the full unpacking
+  TESTASSERT(liblte_mme_unpack_attach_request_msg(&buf, &unpacked) == LIBLTE_SUCCESS);
+  TESTASSERT(liblte_mme_parse_attach_request_msg(buf.msg, buf.N_bytes, &attach_view) == LIBLTE_SUCCESS);
+  TESTASSERT(attach_view.eps_attach_type == unpacked.eps_attach_type);
+  TESTASSERT(attach_view.nas_ksi.nas_ksi == unpacked.nas_ksi.nas_ksi);
+  TESTASSERT(attach_view.eps_mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI);
+  TESTASSERT(memcmp(attach_view.eps_mobile_id.imsi, attach_req.eps_mobile_id.imsi, 15) == 0);
+  TESTASSERT(memcmp(&attach_view.ue_network_cap, &unpacked.ue_network_cap, sizeof(unpacked.ue_network_cap)) == 0);
+  TESTASSERT(attach_view.ms_network_cap_present);
+  TESTASSERT(memcmp(&attach_view.ms_network_cap, &unpacked.ms_network_cap, sizeof(unpacked.ms_network_cap)) == 0);
+  TESTASSERT(attach_view.esm_msg_len == unpacked.esm_msg.N_bytes);
+  TESTASSERT(memcmp(attach_view.esm_msg, unpacked.esm_msg.msg, attach_view.esm_msg_len) == 0);
+
+  TESTASSERT(liblte_mme_parse_pdn_connectivity_request_msg(attach_view.esm_msg, attach_view.esm_msg_len, &pdn_view) ==
+             LIBLTE_SUCCESS);
+  TESTASSERT(pdn_view.eps_bearer_id == pdn_con_req.eps_bearer_id);
+  TESTASSERT(pdn_view.proc_transaction_id == pdn_con_req.proc_transaction_id);
+  TESTASSERT(pdn_view.request_type == pdn_con_req.request_type);
+  TESTASSERT(pdn_view.pdn_type == pdn_con_req.pdn_type);
+  TESTASSERT(pdn_view.esm_info_transfer_flag_present);
+  TESTASSERT(pdn_view.esm_info_transfer_flag == LIBLTE_MME_ESM_INFO_TRANSFER_FLAG_REQUIRED);
+  TESTASSERT(pdn_view.apn_present && pdn_view.apn_len == strlen("srsapn") + 1);
+  TESTASSERT(not pdn_view.protocol_cnfg_opts_present);
+
+  // Truncated messages and IEs running past the end of the message are rejected
+  uint32_t esm_end = attach_view.esm_msg + attach_view.esm_msg_len - buf.msg;
+  for (uint32_t len = 0; len < esm_end; ++len) {
+    TESTASSERT(liblte_mme_parse_attach_request_msg(buf.msg, len, &attach_view) != LIBLTE_SUCCESS);
+  }
+  buf.msg[esm_end - attach_view.esm_msg_len - 2] = 0xff;
+  TESTASSERT(liblte_mme_parse_attach_request_msg(buf.msg, buf.N_bytes, &attach_view) != LIBLTE_SUCCESS);
+  for (uint32_t len = 0; len < 4; ++len) {
+    TESTASSERT(liblte_mme_parse_pdn_connectivity_request_msg(unpacked.esm_msg.msg, len, &pdn_view) != LIBLTE_SUCCESS);
+  }
+  TESTASSERT(liblte_mme_parse_pdn_connectivity_request_msg(
+                 unpacked.esm_msg.msg, unpacked.esm_msg.N_bytes - 1, &pdn_view) != LIBLTE_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   auto& asn1_logger = srslog::fetch_basic_logger("ASN1", false);
@@ -209,6 +287,8 @@ int main(int argc, char** argv)
   TESTASSERT(downlink_generic_nas_transport_packing_test() == SRSRAN_SUCCESS);
   TESTASSERT(downlink_generic_nas_transport_with_add_info_unpacking_test() == SRSRAN_SUCCESS);
   TESTASSERT(downlink_generic_nas_transport_with_add_info_packing_test() == SRSRAN_SUCCESS);
+  TESTASSERT(attach_request_view_test(LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS) == SRSRAN_SUCCESS);
+  TESTASSERT(attach_request_view_test(LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY) == SRSRAN_SUCCESS);
 
   return SRSRAN_SUCCESS;
 }
@@ -22,6 +22,7 @@
 #define NMSGS 1000000
 
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
 #include "srsran/upper/byte_buffer_queue.h"
 #include <stdio.h>
 
@@ -80,7 +81,69 @@ int test_concurrent_writeread()
   return result;
 }
 
+unique_byte_buffer_t make_sdu(uint32_t nof_bytes)
+{
+  unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+  sdu->N_bytes             = nof_bytes;
+  return sdu;
+}
+
+int test_shared_budget()
+{
+  byte_buffer_budget budget;
+  budget.set_max_bytes(1000);
+  {
+    byte_buffer_queue      q1;
+    byte_buffer_spsc_queue q2;
+    q1.set_budget(&budget);
+    q2.set_budget(&budget);
+
+    TESTASSERT(q1.try_write(make_sdu(600)).has_value());
+    TESTASSERT(budget.get_used_bytes() == 600);
+    TESTASSERT(not q1.is_full());
+    TESTASSERT(not q1.try_write(make_sdu(500)).has_value());
+    TESTASSERT(q1.size() == 1);
+
+    // An empty queue always accepts an SDU, so that no bearer is locked out by the other ones
+    TESTASSERT(q2.fits(500));
+    TESTASSERT(q2.try_write(make_sdu(500)).has_value());
+    TESTASSERT(budget.get_used_bytes() == 1100);
+    TESTASSERT(q1.is_full());
+    TESTASSERT(q2.is_full());
+    TESTASSERT(not q2.try_write(make_sdu(1)).has_value());
+
+    // The bytes are given back on read and discard
+    unique_byte_buffer_t sdu;
+    TESTASSERT(q1.try_read(&sdu));
+    TESTASSERT(budget.get_used_bytes() == 500);
+    TESTASSERT(q2.try_write(make_sdu(400)).has_value());
+    TESTASSERT(budget.get_used_bytes() == 900);
+    TESTASSERT(q2.discard_first([](const unique_byte_buffer_t& b) { return b->N_bytes == 400; }));
+    TESTASSERT(budget.get_used_bytes() == 500);
+    TESTASSERT(q1.try_write(make_sdu(100)).has_value());
+    TESTASSERT(budget.get_used_bytes() == 600);
+  }
+  // and when the queues are destroyed
+  TESTASSERT(budget.get_used_bytes() == 0);
+
+  // Without limit, the budget only counts the bytes
+  budget.set_max_bytes(0);
+  byte_buffer_queue q;
+  q.set_budget(&budget);
+  for (uint32_t i = 0; i < 10; ++i) {
+    TESTASSERT(q.try_write(make_sdu(1000)).has_value());
+  }
+  TESTASSERT(budget.get_used_bytes() == 10000);
+  TESTASSERT(not q.is_full());
+  q.queue.clear();
+  TESTASSERT(budget.get_used_bytes() == 0);
+
+  printf("Passed\n");
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
+  TESTASSERT(test_shared_budget() == SRSRAN_SUCCESS);
   return test_concurrent_writeread();
 }
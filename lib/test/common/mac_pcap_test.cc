@@ -0,0 +1,111 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/common.h"
+#include "srsran/common/mac_pcap.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static const char*    pcap_filename       = "mac_pcap_test.pcap";
+static const uint32_t num_threads         = 4;
+static const uint32_t num_pdus_per_thread = 2000;
+static const uint32_t num_pdus_per_tti    = 10;
+static const uint32_t pdu_len             = 1500;
+
+// Write #num_pdus LTE and NR MAC PDUs using PCAP handle, a few of them every TTI
+void write_pcap_thread_function(srsran::mac_pcap* pcap_handle, const std::vector<uint8_t>& pdu, uint32_t num_pdus)
+{
+  for (uint32_t i = 0; i < num_pdus; i++) {
+    if (i % num_pdus_per_tti == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (i % 2 == 0) {
+      pcap_handle->write_ul_crnti(const_cast<uint8_t*>(pdu.data()), pdu.size(), 0x1001, true, i, 0);
+    } else {
+      pcap_handle->write_dl_crnti_nr(const_cast<uint8_t*>(pdu.data()), pdu.size(), 0x1001, 0, i);
+    }
+  }
+}
+
+int mac_pcap_file_test(uint32_t snaplen)
+{
+  std::vector<uint8_t> tv(pdu_len);
+  for (uint32_t i = 0; i < pdu_len; i++) {
+    tv[i] = i % 251;
+  }
+
+  std::unique_ptr<srsran::mac_pcap> pcap_handle = std::unique_ptr<srsran::mac_pcap>(new srsran::mac_pcap());
+  pcap_handle->set_snaplen(snaplen);
+  TESTASSERT(pcap_handle->open(pcap_filename) == SRSRAN_SUCCESS);
+
+  auto                     t_start = std::chrono::steady_clock::now();
+  std::vector<std::thread> writer_threads;
+  for (uint32_t i = 0; i < num_threads; i++) {
+    writer_threads.push_back(std::thread(write_pcap_thread_function, pcap_handle.get(), tv, num_pdus_per_thread));
+  }
+  for (std::thread& thread : writer_threads) {
+    thread.join();
+  }
+  TESTASSERT(pcap_handle->close() == SRSRAN_SUCCESS);
+  auto t_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t_start);
+  std::cout << "Captured " << num_threads * num_pdus_per_thread << " PDUs with snaplen " << snaplen << " in "
+            << t_us.count() << " us\n";
+
+  // Read back the records, the captured part of every PDU must be intact
+  FILE* f = fopen(pcap_filename, "r");
+  TESTASSERT(f != nullptr);
+  pcap_hdr_t file_header = {};
+  TESTASSERT(fread(&file_header, sizeof(file_header), 1, f) == 1);
+  TESTASSERT(file_header.network == UDP_DLT);
+
+  uint32_t             captured_len = (snaplen > 0) ? std::min(snaplen, pdu_len) : pdu_len;
+  uint32_t             nof_records  = 0;
+  pcaprec_hdr_t        record       = {};
+  std::vector<uint8_t> data;
+  while (fread(&record, sizeof(record), 1, f) == 1) {
+    TESTASSERT(record.incl_len >= captured_len);
+    TESTASSERT(record.orig_len - record.incl_len == pdu_len - captured_len);
+    data.resize(record.incl_len);
+    TESTASSERT(fread(data.data(), 1, data.size(), f) == data.size());
+    TESTASSERT(memcmp(&data[record.incl_len - captured_len], tv.data(), captured_len) == 0);
+    nof_records++;
+  }
+  fclose(f);
+  TESTASSERT(nof_records == num_threads * num_pdus_per_thread);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  auto& mac_logger = srslog::fetch_basic_logger("MAC", false);
+  mac_logger.set_level(srslog::basic_levels::info);
+  srslog::init();
+
+  TESTASSERT(mac_pcap_file_test(0) == SRSRAN_SUCCESS);
+  TESTASSERT(mac_pcap_file_test(64) == SRSRAN_SUCCESS);
+
+  remove(pcap_filename);
+  return SRSRAN_SUCCESS;
+}
@@ -306,6 +306,62 @@ int test_multiqueue_threading4()
   return 0;
 }
 
+int test_multiqueue_threading5()
+{
+  std::cout << "\n===== TEST multiqueue threading test 5: start =====\n";
+  // Description: several producers push with blocking into small queues, some of them shared, while the consumer
+  //              goes to sleep and wakes up. No task may be lost or popped twice
+
+  uint32_t                        nof_producers = 4, nof_pushes = 20000;
+  multiqueue_handler<int>         multiqueue(1);
+  std::vector<queue_handle<int> > qids;
+  qids.push_back(multiqueue.add_queue());
+  qids.push_back(multiqueue.add_queue(3));
+  qids.push_back(multiqueue.add_queue(16));
+
+  std::vector<int> counts(nof_producers * nof_pushes, 0);
+  std::thread      consumer([&multiqueue, &counts]() {
+    int number = 0;
+    while (multiqueue.wait_pop(&number)) {
+      counts[number]++;
+    }
+  });
+
+  std::vector<std::thread> producers;
+  for (uint32_t p = 0; p < nof_producers; ++p) {
+    producers.emplace_back([&qids, p, nof_pushes]() {
+      queue_handle<int>& qid = qids[p % qids.size()];
+      for (uint32_t i = 0; i < nof_pushes; ++i) {
+        qid.push(p * nof_pushes + i);
+        if (i % 1000 == 0) {
+          // let the consumer go to sleep
+          usleep(200);
+        }
+      }
+    });
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+
+  // wait for the consumer to empty the queues
+  for (auto& qid : qids) {
+    while (not qid.empty()) {
+      usleep(100);
+    }
+  }
+  multiqueue.stop();
+  consumer.join();
+  for (int c : counts) {
+    TESTASSERT(c == 1);
+  }
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+
+  return 0;
+}
+
 int test_task_thread_pool()
 {
   std::cout << "\n====== TEST task thread pool test 1: start ======\n";
@@ -410,6 +466,76 @@ int test_task_thread_pool3()
   return 0;
 }
 
+int test_task_thread_pool4()
+{
+  std::cout << "\n====== TEST task thread pool test 4: start ======\n";
+  // Description: check that the tasks with the same affinity key stay in one worker while it keeps up, and that the
+  //              tasks queued behind a busy worker are stolen by the idle ones
+
+  uint32_t         nof_workers = 4, nof_runs = 1000;
+  task_thread_pool thread_pool(nof_workers);
+
+  // push the tasks one at a time, so that the worker of the key is never busy
+  std::map<std::thread::id, int> count_worker;
+  for (uint32_t i = 0; i < nof_runs; ++i) {
+    std::atomic<bool> done{false};
+    thread_pool.push_task(5, [&count_worker, &done]() {
+      count_worker[std::this_thread::get_id()]++;
+      done = true;
+    });
+    while (not done) {
+      usleep(10);
+    }
+  }
+  int max_count = 0;
+  for (auto& w : count_worker) {
+    max_count = std::max(max_count, w.second);
+  }
+  TESTASSERT(max_count >= int(nof_runs * 9 / 10));
+
+  // a long task queues tasks with its own key, which the other workers have to steal
+  struct parent_state_t {
+    task_thread_pool*     pool;
+    uint32_t              nof_childs = 100;
+    std::atomic<uint32_t> nof_childs_done{0};
+    std::atomic<bool>     child_in_parent{false};
+    std::atomic<bool>     parent_done{false};
+    std::thread::id       parent_id;
+  } state;
+  state.pool          = &thread_pool;
+  uint64_t nof_stolen = thread_pool.get_metrics().nof_stolen_tasks;
+  thread_pool.push_task(1, [&state]() {
+    state.parent_id = std::this_thread::get_id();
+    for (uint32_t i = 0; i < state.nof_childs; ++i) {
+      state.pool->push_task(1, [&state]() {
+        if (std::this_thread::get_id() == state.parent_id) {
+          state.child_in_parent = true;
+        }
+        state.nof_childs_done++;
+      });
+    }
+    while (state.nof_childs_done < state.nof_childs) {
+      usleep(100);
+    }
+    state.parent_done = true;
+  });
+  while (not state.parent_done) {
+    usleep(100);
+  }
+  TESTASSERT(not state.child_in_parent);
+
+  task_thread_pool_metrics_t metrics = thread_pool.get_metrics();
+  TESTASSERT(metrics.nof_tasks == nof_runs + state.nof_childs + 1);
+  TESTASSERT(metrics.nof_stolen_tasks - nof_stolen == state.nof_childs);
+  TESTASSERT(metrics.nof_pending_tasks == 0);
+  TESTASSERT(metrics.queue_len.size() == nof_workers);
+  thread_pool.stop();
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+  return 0;
+}
+
 struct C {
   std::unique_ptr<int> val{new int{5}};
 };
@@ -499,10 +625,12 @@ int main()
   TESTASSERT(test_multiqueue_threading2() == 0);
   TESTASSERT(test_multiqueue_threading3() == 0);
   TESTASSERT(test_multiqueue_threading4() == 0);
+  TESTASSERT(test_multiqueue_threading5() == 0);
 
   TESTASSERT(test_task_thread_pool() == 0);
   TESTASSERT(test_task_thread_pool2() == 0);
   TESTASSERT(test_task_thread_pool3() == 0);
+  TESTASSERT(test_task_thread_pool4() == 0);
 
   TESTASSERT(test_inplace_task() == 0);
 }
@@ -148,6 +148,79 @@ int test_sctp_bind_error()
   return SRSRAN_SUCCESS;
 }
 
+int test_sctp_tx_worker()
+{
+  auto& logger = srslog::fetch_basic_logger("S1AP", false);
+
+  srsran::unique_socket server_socket, client_socket;
+  int                   server_port = 36413;
+  const char*           server_addr = "127.0.100.1";
+  const int             nof_streams = 4;
+  using namespace srsran::net_utils;
+
+  TESTASSERT(server_socket.open_socket(addr_family::ipv4, socket_type::seqpacket, protocol_type::SCTP));
+  TESTASSERT(server_socket.sctp_subscribe_to_events());
+  TESTASSERT(server_socket.sctp_set_nof_streams(nof_streams));
+  TESTASSERT(server_socket.bind_addr(server_addr, server_port));
+  TESTASSERT(server_socket.start_listen());
+  timeval rx_timeout = {3, 0};
+  TESTASSERT(setsockopt(server_socket.fd(), SOL_SOCKET, SO_RCVTIMEO, &rx_timeout, sizeof(rx_timeout)) == 0);
+
+  sockaddr_in server_addrin = {};
+  TESTASSERT(client_socket.open_socket(addr_family::ipv4, socket_type::seqpacket, protocol_type::SCTP));
+  TESTASSERT(client_socket.sctp_set_nof_streams(nof_streams));
+  TESTASSERT(client_socket.bind_addr("127.0.0.1", 0));
+  TESTASSERT(client_socket.connect_to(server_addr, server_port, &server_addrin));
+
+  // Send more messages than fit in a batch, on the non UE stream and on the UE streams
+  srsran::sctp_tx_worker tx_worker(logger, "SCTP_TX");
+  tx_worker.set_socket(client_socket.fd(), server_addrin, (uint32_t)ppid_values::S1AP);
+  const uint32_t nof_msgs = srsran::sctp_tx_worker::max_batch_size + 8;
+  for (uint32_t i = 0; i < nof_msgs; ++i) {
+    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+    TESTASSERT(pdu != nullptr);
+    pdu->msg[0]  = i;
+    pdu->N_bytes = 1;
+
+    uint16_t stream_id = (i % 5 == 0) ? 0 : sctp_ue_stream_id(i, nof_streams);
+    TESTASSERT(stream_id < nof_streams);
+    tx_worker.push(std::move(pdu), stream_id);
+  }
+  tx_worker.flush();
+  TESTASSERT(tx_worker.empty());
+
+  // The messages of each stream arrive in order
+  uint32_t nof_rx      = 0;
+  uint32_t stream_mask = 0;
+  int      last_msg[nof_streams];
+  std::fill(last_msg, last_msg + nof_streams, -1);
+  while (nof_rx < nof_msgs) {
+    uint8_t         buf[128] = {};
+    sockaddr_in     from     = {};
+    socklen_t       fromlen  = sizeof(from);
+    sctp_sndrcvinfo sri      = {};
+    int             flags    = 0;
+    ssize_t         n_recv   =
+        sctp_recvmsg(server_socket.fd(), buf, sizeof(buf), (struct sockaddr*)&from, &fromlen, &sri, &flags);
+    TESTASSERT(n_recv > 0);
+    if (flags & MSG_NOTIFICATION) {
+      continue;
+    }
+    TESTASSERT(n_recv == 1);
+    TESTASSERT(sri.sinfo_ppid == htonl((uint32_t)ppid_values::S1AP));
+    TESTASSERT(sri.sinfo_stream < nof_streams);
+    TESTASSERT(last_msg[sri.sinfo_stream] < buf[0]);
+    last_msg[sri.sinfo_stream] = buf[0];
+    stream_mask |= 1U << sri.sinfo_stream;
+    nof_rx++;
+  }
+  TESTASSERT(stream_mask == (1U << nof_streams) - 1);
+
+  tx_worker.clear_socket();
+  tx_worker.stop();
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   auto& logger = srslog::fetch_basic_logger("S1AP", false);
@@ -158,6 +231,7 @@ int main()
 
   TESTASSERT(test_socket_handler() == 0);
   TESTASSERT(test_sctp_bind_error() == 0);
+  TESTASSERT(test_sctp_tx_worker() == SRSRAN_SUCCESS);
 
   return 0;
 }
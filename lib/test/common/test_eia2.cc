@@ -0,0 +1,91 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+#include <random>
+
+/*
+ * Tests
+ *
+ * Document Reference: 33.401 V14.6.0 Annex C.2
+ *
+ */
+
+int test_set_1()
+{
+  uint8_t  key[]     = {0xd3, 0xc5, 0xd5, 0x92, 0x32, 0x7f, 0xb1, 0x1c, 0x40, 0x35, 0xc6, 0x68, 0x0a, 0xf8, 0xc6, 0xd1};
+  uint32_t count     = 0x398a59b4;
+  uint8_t  bearer    = 0x1a;
+  uint8_t  direction = 1;
+  uint32_t len_bits = 64, len_bytes = (len_bits + 7) / 8;
+  uint8_t  msg[] = {0x48, 0x45, 0x83, 0xd5, 0xaf, 0xe0, 0x82, 0xae};
+  uint8_t  mt[]  = {0xb9, 0x37, 0x87, 0xe6};
+
+  uint8_t mac[4];
+
+  // gen mac
+  srsran::security_128_eia2(key, count, bearer, direction, msg, len_bytes, mac);
+  for (int i = 0; i < 4; i++) {
+    TESTASSERT(mac[i] == mt[i]);
+  }
+
+  // gen mac with the expanded key
+  srsran::security_aes_key_t aes_key;
+  TESTASSERT(srsran::security_128_eia2(aes_key, count, bearer, direction, msg, len_bytes, mac) != SRSRAN_SUCCESS);
+  aes_key.set_key(key);
+  TESTASSERT(srsran::security_128_eia2(aes_key, count, bearer, direction, msg, len_bytes, mac) == SRSRAN_SUCCESS);
+  for (int i = 0; i < 4; i++) {
+    TESTASSERT(mac[i] == mt[i]);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/// The MAC with the expanded key matches the per-message key for all the lengths around the CMAC block boundaries
+int test_expanded_key()
+{
+  std::mt19937 rgen(0);
+  uint8_t      key[16];
+  uint8_t      msg[100];
+  for (uint8_t& b : key) {
+    b = rgen();
+  }
+  for (uint8_t& b : msg) {
+    b = rgen();
+  }
+
+  srsran::security_aes_key_t aes_key;
+  aes_key.set_key(key);
+  for (uint32_t len = 0; len <= sizeof(msg); ++len) {
+    uint8_t mac[4], mac_exp[4];
+    srsran::security_128_eia2(key, 0x1234 + len, 3, len % 2, msg, len, mac_exp);
+    srsran::security_128_eia2(aes_key, 0x1234 + len, 3, len % 2, msg, len, mac);
+    TESTASSERT(memcmp(mac, mac_exp, sizeof(mac)) == 0);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char* argv[])
+{
+  TESTASSERT(test_set_1() == SRSRAN_SUCCESS);
+  TESTASSERT(test_expanded_key() == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
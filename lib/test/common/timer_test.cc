@@ -448,6 +448,58 @@ void timers_test7()
   TESTASSERT(timers.nof_running_timers() == 1 and timers.nof_timers() == 3);
 }
 
+/**
+ * Tests specific to the hierarchical time wheel:
+ * - timers with durations around the limits of the wheel levels expire in the right tic
+ * - a timer started by a callback with duration 1 expires in the next tic
+ */
+void timers_test8()
+{
+  timer_handler timers;
+  size_t        wheel_size = timer_handler::get_wheel_size();
+
+  // move the wheel away from the start of the level turns
+  for (size_t i = 0; i < wheel_size / 2 + 3; ++i) {
+    timers.step_all();
+  }
+
+  std::vector<uint32_t>                   durations = {1, 2, 255, 256, 257, 16383, 16384, 16385, 70000};
+  std::mt19937                            mt19937(8);
+  std::uniform_int_distribution<uint32_t> dist(1, 100000);
+  for (uint32_t i = 0; i < 200; ++i) {
+    durations.push_back(dist(mt19937));
+  }
+
+  uint32_t                  tic = 0;
+  std::vector<uint32_t>     expiry_tics(durations.size(), 0);
+  std::vector<unique_timer> utimers;
+  for (size_t i = 0; i < durations.size(); ++i) {
+    utimers.push_back(timers.get_unique_timer());
+    utimers.back().set(durations[i], [&expiry_tics, &tic, i](uint32_t tid) { expiry_tics[i] = tic; });
+    utimers.back().run();
+  }
+
+  // timer restarted by its own callback
+  uint32_t     nof_restarts = 0;
+  unique_timer t            = timers.get_unique_timer();
+  t.set(1, [&t, &nof_restarts](uint32_t tid) {
+    if (++nof_restarts < 3) {
+      t.run();
+    }
+  });
+  t.run();
+
+  while (timers.nof_running_timers() > 0) {
+    ++tic;
+    timers.step_all();
+    TESTASSERT(nof_restarts == std::min(tic, 3U));
+  }
+  for (size_t i = 0; i < durations.size(); ++i) {
+    TESTASSERT(expiry_tics[i] == durations[i]);
+    TESTASSERT(utimers[i].is_expired());
+  }
+}
+
 int main()
 {
   timers_test1();
@@ -457,6 +509,7 @@ int main()
   timers_test5();
   timers_test6();
   timers_test7();
+  timers_test8();
   printf("Success\n");
   return 0;
 }
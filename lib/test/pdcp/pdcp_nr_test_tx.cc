@@ -68,6 +68,59 @@ public:
     srsran::unique_byte_buffer_t pdu_act = srsran::make_byte_buffer();
     pdcp_hlp_tx.rlc.get_last_sdu(pdu_act);
 
+    TESTASSERT(pdcp_hlp_tx.rlc.rx_count == n_pdus_exp);
+    TESTASSERT(compare_two_packets(pdu_act, pdu_exp) == 0);
+    return 0;
+  }
+  int test_tx_burst(uint32_t                     n_packets,
+                    const pdcp_initial_state&    init_state,
+                    uint64_t                     n_pdus_exp,
+                    srsran::unique_byte_buffer_t pdu_exp)
+  {
+    pdcp_hlp_tx.set_pdcp_initial_state(init_state);
+
+    // Run test
+    std::vector<srsran::unique_byte_buffer_t> sdus(n_packets);
+    for (srsran::unique_byte_buffer_t& sdu : sdus) {
+      sdu = srsran::make_byte_buffer();
+      sdu->append_bytes(sdu1, sizeof(sdu1));
+    }
+    pdcp_hlp_tx.pdcp.write_sdus(sdus);
+
+    srsran::unique_byte_buffer_t pdu_act = srsran::make_byte_buffer();
+    pdcp_hlp_tx.rlc.get_last_sdu(pdu_act);
+
+    TESTASSERT(pdcp_hlp_tx.rlc.rx_count == n_pdus_exp);
+    TESTASSERT(compare_two_packets(pdu_act, pdu_exp) == 0);
+    return 0;
+  }
+  int test_tx_offload(uint32_t                     n_packets,
+                      const pdcp_initial_state&    init_state,
+                      uint64_t                     n_pdus_exp,
+                      srsran::unique_byte_buffer_t pdu_exp)
+  {
+    srsran::task_thread_pool crypto_workers(4);
+    pdcp_hlp_tx.set_pdcp_initial_state(init_state);
+    pdcp_hlp_tx.pdcp.set_crypto_workers(&crypto_workers);
+
+    // Run test
+    for (uint32_t i = 0; i < n_packets; ++i) {
+      srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+      sdu->append_bytes(sdu1, sizeof(sdu1));
+      pdcp_hlp_tx.pdcp.write_sdu(std::move(sdu));
+    }
+
+    // The PDUs reach RLC once the workers are done and the task scheduler runs their notifications
+    while (pdcp_hlp_tx.rlc.rx_count < n_pdus_exp) {
+      stack.run_pending_tasks();
+      std::this_thread::yield();
+    }
+    pdcp_hlp_tx.pdcp.set_crypto_workers(nullptr);
+    crypto_workers.stop();
+
+    srsran::unique_byte_buffer_t pdu_act = srsran::make_byte_buffer();
+    pdcp_hlp_tx.rlc.get_last_sdu(pdu_act);
+
     TESTASSERT(pdcp_hlp_tx.rlc.rx_count == n_pdus_exp);
     TESTASSERT(compare_two_packets(pdu_act, pdu_exp) == 0);
     return 0;
@@ -221,6 +274,43 @@ int test_tx_all(srslog::basic_logger& logger)
     tx_helper.pdcp_tx.notify_delivery({0});
     TESTASSERT(tx_helper.pdcp_tx.nof_discard_timers() == 0);
   }
+
+  /*
+   * TX Test 10: PDCP Entity with SN LEN = 12
+   * Burst of SDUs written at once, ending at TX_NEXT = 2048.
+   * Input: 16 x {0x18, 0xE2}
+   * Output: {0x88, 0x00, 0x8d, 0x2c, 0xe5, 0x38, 0xc0, 0x42}
+   */
+  {
+    srsran::test_delimit_logger delimiter("TX burst up to COUNT 2048, 12 bit SN");
+    test_tx_helper              tx_helper(srsran::PDCP_SN_LEN_12, logger);
+    n_packets                                            = 16;
+    pdcp_initial_state           burst_init_state        = {};
+    burst_init_state.tx_next                             = 2048 - (n_packets - 1);
+    srsran::unique_byte_buffer_t pdu_exp_count2048_len12 = srsran::make_byte_buffer();
+    pdu_exp_count2048_len12->append_bytes(pdu1_count2048_snlen12, sizeof(pdu1_count2048_snlen12));
+    TESTASSERT(tx_helper.test_tx_burst(n_packets, burst_init_state, n_packets, std::move(pdu_exp_count2048_len12)) ==
+               0);
+    TESTASSERT(tx_helper.pdcp_tx.nof_discard_timers() == n_packets);
+  }
+
+  /*
+   * TX Test 11: PDCP Entity with SN LEN = 12
+   * PDUs ciphered by the crypto workers, ending at TX_NEXT = 2048.
+   * Input: 64 x {0x18, 0xE2}
+   * Output: {0x88, 0x00, 0x8d, 0x2c, 0xe5, 0x38, 0xc0, 0x42}
+   */
+  {
+    srsran::test_delimit_logger delimiter("TX with crypto workers up to COUNT 2048, 12 bit SN");
+    test_tx_helper              tx_helper(srsran::PDCP_SN_LEN_12, logger);
+    n_packets                                            = 64;
+    pdcp_initial_state           offload_init_state      = {};
+    offload_init_state.tx_next                           = 2048 - (n_packets - 1);
+    srsran::unique_byte_buffer_t pdu_exp_count2048_len12 = srsran::make_byte_buffer();
+    pdu_exp_count2048_len12->append_bytes(pdu1_count2048_snlen12, sizeof(pdu1_count2048_snlen12));
+    TESTASSERT(tx_helper.test_tx_offload(
+                   n_packets, offload_init_state, n_packets, std::move(pdu_exp_count2048_len12)) == 0);
+  }
   return SRSRAN_SUCCESS;
 }
 
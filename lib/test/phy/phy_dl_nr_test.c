@@ -40,10 +40,11 @@ static srsran_dmrs_sch_type_t    dmrs_type                        = srsran_dmrs_
 static srsran_dmrs_sch_add_pos_t dmrs_add_pos                     = srsran_dmrs_sch_add_pos_2;
 static bool                      interleaved_pdcch                = false;
 static uint32_t                  nof_dmrs_cdm_groups_without_data = 1;
+static char*                     json_filename                    = NULL; // Benchmark report, not written if NULL
 
 static void usage(char* prog)
 {
-  printf("Usage: %s [rRPdpmnTILDCv] \n", prog);
+  printf("Usage: %s [rRPdpmnTILDCjv] \n", prog);
   printf("\t-P Number of BWP (Carrier) PRB [Default %d]\n", carrier.nof_prb);
   printf("\t-p Number of grant PRB, set to 0 for steering [Default %d]\n", n_prb);
   printf("\t-n Number of slots to simulate [Default %d]\n", nof_slots);
@@ -57,13 +58,14 @@ static void usage(char* prog)
   printf("\t-L Provide number of layers [Default %d]\n", carrier.max_mimo_layers);
   printf("\t-D Delay signal an integer number of samples [Default %d samples]\n", delay_n);
   printf("\t-C Frequency shift (CFO) signal in Hz [Default %+.0f Hz]\n", cfo_hz);
+  printf("\t-j Append a JSON benchmark record to the given file [Default %s]\n", json_filename ? json_filename : "none");
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 static int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "rRIPdpmnTLDCv")) != -1) {
+  while ((opt = getopt(argc, argv, "rRIPdpmnTLDCjv")) != -1) {
     switch (opt) {
       case 'P':
         carrier.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -138,6 +140,9 @@ static int parse_args(int argc, char** argv)
       case 'C':
         cfo_hz = strtof(argv[optind], NULL);
         break;
+      case 'j':
+        json_filename = argv[optind];
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -218,6 +223,64 @@ static int work_ue_dl(srsran_ue_dl_nr_t* ue_dl, srsran_slot_cfg_t* slot, srsran_
   return SRSRAN_SUCCESS;
 }
 
+static int compare_u32(const void* a, const void* b)
+{
+  uint32_t arg1 = *(const uint32_t*)a;
+  uint32_t arg2 = *(const uint32_t*)b;
+  return (arg1 > arg2) - (arg1 < arg2);
+}
+
+// Sorts the slot times and writes their mean, percentiles and the processed rate as JSON members
+static void json_print_times(FILE* f, const char* name, uint32_t* times_us, uint64_t count, uint64_t nof_bits)
+{
+  uint64_t total_us = 0;
+  for (uint64_t i = 0; i < count; i++) {
+    total_us += times_us[i];
+  }
+  qsort(times_us, count, sizeof(uint32_t), compare_u32);
+
+  fprintf(f,
+          "\"%s\":{\"us_per_slot\":%.1f,\"p50_us\":%u,\"p90_us\":%u,\"p99_us\":%u,\"max_us\":%u,\"mbps\":%.1f}",
+          name,
+          (double)total_us / (double)count,
+          times_us[count / 2],
+          times_us[(count * 9) / 10],
+          times_us[(count * 99) / 100],
+          times_us[count - 1],
+          total_us ? (double)nof_bits / (double)total_us : 0.0);
+}
+
+static int json_write(uint32_t* encode_us, uint32_t* decode_us, uint64_t count, uint64_t nof_bits)
+{
+  if (count == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  FILE* f = fopen(json_filename, "a");
+  if (f == NULL) {
+    ERROR("Error opening %s", json_filename);
+    return SRSRAN_ERROR;
+  }
+
+  fprintf(f,
+          "{\"test\":\"phy_dl_nr\",\"nof_prb\":%d,\"grant_prb\":%d,\"mcs\":%d,\"mcs_table\":\"%s\",\"layers\":%d,"
+          "\"slots\":%" PRIu64 ",\"granted_mbps\":%.1f,",
+          carrier.nof_prb,
+          n_prb,
+          mcs,
+          srsran_mcs_table_to_str(pdsch_cfg.sch_cfg.mcs_table),
+          carrier.max_mimo_layers,
+          count,
+          (double)nof_bits / (double)count / 1000.0);
+  json_print_times(f, "gnb", encode_us, count, nof_bits);
+  fprintf(f, ",");
+  json_print_times(f, "ue", decode_us, count, nof_bits);
+  fprintf(f, "}\n");
+  fclose(f);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   int                   ret             = SRSRAN_ERROR;
@@ -230,6 +293,8 @@ int main(int argc, char** argv)
   uint64_t              pdsch_encode_us = 0;
   uint64_t              pdsch_decode_us = 0;
   uint64_t              nof_bits        = 0;
+  uint32_t*             encode_us_vec   = NULL;
+  uint32_t*             decode_us_vec   = NULL;
 
   uint8_t* data_tx[SRSRAN_MAX_TB]        = {};
   uint8_t* data_rx[SRSRAN_MAX_CODEWORDS] = {};
@@ -388,6 +453,17 @@ int main(int argc, char** argv)
     mcs_end   = SRSRAN_MIN(mcs + 1, mcs_end);
   }
 
+  // Keep every slot time for the percentiles
+  if (json_filename != NULL) {
+    uint64_t max_count = (uint64_t)nof_slots * (n_prb_end - n_prb_start) * (mcs_end - mcs_start);
+    encode_us_vec      = calloc(max_count, sizeof(uint32_t));
+    decode_us_vec      = calloc(max_count, sizeof(uint32_t));
+    if (encode_us_vec == NULL || decode_us_vec == NULL) {
+      ERROR("Error malloc");
+      goto clean_exit;
+    }
+  }
+
   uint64_t slot_count = 0;
   for (slot.idx = 0; slot.idx < nof_slots; slot.idx++) {
     for (n_prb = n_prb_start; n_prb < n_prb_end; n_prb++) {
@@ -434,6 +510,9 @@ int main(int argc, char** argv)
         gettimeofday(&t[2], NULL);
         get_time_interval(t);
         pdsch_encode_us += (size_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+        if (encode_us_vec != NULL) {
+          encode_us_vec[slot_count] = (uint32_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+        }
 
         // Emulate channel delay
         if (delay_n >= sf_len) {
@@ -464,6 +543,9 @@ int main(int argc, char** argv)
         gettimeofday(&t[2], NULL);
         get_time_interval(t);
         pdsch_decode_us += (size_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+        if (decode_us_vec != NULL) {
+          decode_us_vec[slot_count] = (uint32_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+        }
 
         if (pdsch_res.evm[0] > 0.02f) {
           ERROR("Error PDSCH EVM is too high %f", pdsch_res.evm[0]);
@@ -514,9 +596,24 @@ int main(int argc, char** argv)
          (double)nof_bits / (double)slot_count / 1000.0f,
          (double)nof_bits / pdsch_decode_us);
 
+  if (json_filename != NULL) {
+    // Report the swept grant as the last simulated one only if it was fixed by arguments
+    n_prb = n_prb_end - n_prb_start == 1 ? n_prb_start : 0;
+    mcs   = mcs_end - mcs_start == 1 ? mcs_start : 0;
+    if (json_write(encode_us_vec, decode_us_vec, slot_count, nof_bits) < SRSRAN_SUCCESS) {
+      goto clean_exit;
+    }
+  }
+
   ret = SRSRAN_SUCCESS;
 
 clean_exit:
+  if (encode_us_vec) {
+    free(encode_us_vec);
+  }
+  if (decode_us_vec) {
+    free(decode_us_vec);
+  }
   srsran_random_free(rand_gen);
   srsran_gnb_dl_free(&gnb_dl);
   srsran_ue_dl_nr_free(&ue_dl);
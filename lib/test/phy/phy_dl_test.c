@@ -44,11 +44,12 @@ static bool     print_dci_table;
 static uint32_t mcs                     = 20;
 static int      cross_carrier_indicator = -1;
 static bool     enable_256qam           = false;
-static float    snr_db                  = NAN; // SNR in dB
+static float    snr_db                  = NAN;  // SNR in dB
+static char*    json_filename           = NULL; // Benchmark report, not written if NULL
 
 void usage(char* prog)
 {
-  printf("Usage: %s [cfpndvs]\n", prog);
+  printf("Usage: %s [cfpndvsj]\n", prog);
   printf("\t-c cell id [Default %d]\n", cell.id);
   printf("\t-E  extended Cyclic prefix [Default %d]\n", cell.cp);
   printf("\t-f cfi [Default %d]\n", cfi);
@@ -58,6 +59,7 @@ void usage(char* prog)
   printf("\t-t Transmission mode: 1,2,3,4 [Default %d]\n", transmission_mode + 1);
   printf("\t-m mcs [Default %d]\n", mcs);
   printf("\t-S SNR in dB [Default %+.2f]\n", snr_db);
+  printf("\t-j Append a JSON benchmark record to the given file [Default %s]\n", json_filename ? json_filename : "none");
   printf("\tAdvanced parameters:\n");
   if (cross_carrier_indicator >= 0) {
     printf("\t\t-a carrier-indicator [Default %d]\n", cross_carrier_indicator);
@@ -96,7 +98,7 @@ void parse_args(int argc, char** argv)
     nof_rx_ant     = 2;
   }
 
-  while ((opt = getopt(argc, argv, "cfapndvqstmES")) != -1) {
+  while ((opt = getopt(argc, argv, "cfapndvqstmESj")) != -1) {
     switch (opt) {
       case 't':
         transmission_mode = (uint32_t)strtol(argv[optind], NULL, 10) - 1;
@@ -126,6 +128,9 @@ void parse_args(int argc, char** argv)
       case 'S':
         snr_db = strtof(argv[optind], NULL);
         break;
+      case 'j':
+        json_filename = argv[optind];
+        break;
       case 'E':
         cell.cp = ((uint32_t)strtol(argv[optind], NULL, 10)) ? SRSRAN_CP_EXT : SRSRAN_CP_NORM;
         break;
@@ -316,6 +321,64 @@ static int check_evm(srsran_enb_dl_t* enb_dl, srsran_ue_dl_t* ue_dl, srsran_ue_d
   return ret;
 }
 
+static int compare_u32(const void* a, const void* b)
+{
+  uint32_t arg1 = *(const uint32_t*)a;
+  uint32_t arg2 = *(const uint32_t*)b;
+  return (arg1 > arg2) - (arg1 < arg2);
+}
+
+// Sorts the subframe times and writes their mean, percentiles and the processed rate as JSON members
+static void json_print_times(FILE* f, const char* name, uint32_t* times_us, uint32_t count, size_t nof_bits)
+{
+  uint64_t total_us = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    total_us += times_us[i];
+  }
+  qsort(times_us, count, sizeof(uint32_t), compare_u32);
+
+  fprintf(f,
+          "\"%s\":{\"us_per_tti\":%.1f,\"p50_us\":%u,\"p90_us\":%u,\"p99_us\":%u,\"max_us\":%u,\"mbps\":%.1f}",
+          name,
+          (double)total_us / (double)count,
+          times_us[count / 2],
+          times_us[(count * 9) / 10],
+          times_us[(count * 99) / 100],
+          times_us[count - 1],
+          total_us ? (double)nof_bits / (double)total_us : 0.0);
+}
+
+static int json_write(uint32_t* encode_us, uint32_t* decode_us, size_t tx_nof_bits, size_t rx_nof_bits, float bler)
+{
+  if (nof_subframes == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  FILE* f = fopen(json_filename, "a");
+  if (f == NULL) {
+    ERROR("Error opening %s", json_filename);
+    return SRSRAN_ERROR;
+  }
+
+  fprintf(f,
+          "{\"test\":\"phy_dl\",\"nof_prb\":%d,\"tm\":%d,\"mcs\":%d,\"256qam\":%s,\"subframes\":%d,"
+          "\"granted_mbps\":%.1f,\"bler\":%.4f,",
+          cell.nof_prb,
+          transmission_mode + 1,
+          mcs,
+          enable_256qam ? "true" : "false",
+          nof_subframes,
+          (double)tx_nof_bits / (double)nof_subframes / 1000.0,
+          bler);
+  json_print_times(f, "enb", encode_us, nof_subframes, rx_nof_bits);
+  fprintf(f, ",");
+  json_print_times(f, "ue", decode_us, nof_subframes, rx_nof_bits);
+  fprintf(f, "}\n");
+  fclose(f);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   srsran_enb_dl_t*        enb_dl      = srsran_vec_malloc(sizeof(srsran_enb_dl_t));
@@ -332,6 +395,8 @@ int main(int argc, char** argv)
   size_t                  pdsch_encode_us = 0;
   srsran_channel_awgn_t   awgn            = {};
   float                   snr_db_avg      = 0.0;
+  uint32_t*               encode_us_vec   = NULL;
+  uint32_t*               decode_us_vec   = NULL;
 
   int ret = -1;
 
@@ -450,6 +515,16 @@ int main(int argc, char** argv)
     nof_subframes = location_counter;
   }
 
+  // Keep every subframe time for the percentiles
+  if (json_filename != NULL) {
+    encode_us_vec = calloc(nof_subframes, sizeof(uint32_t));
+    decode_us_vec = calloc(nof_subframes, sizeof(uint32_t));
+    if (encode_us_vec == NULL || decode_us_vec == NULL) {
+      ERROR("Error malloc");
+      goto quit;
+    }
+  }
+
   /*
    *  DCI Configuration
    */
@@ -564,6 +639,9 @@ int main(int argc, char** argv)
     gettimeofday(&t[2], NULL);
     get_time_interval(t);
     pdsch_encode_us += (size_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+    if (encode_us_vec != NULL) {
+      encode_us_vec[sf_idx] = (uint32_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+    }
 
     // MIMO perfect crossed channel
     if (transmission_mode > 1) {
@@ -624,6 +702,9 @@ int main(int argc, char** argv)
     gettimeofday(&t[2], NULL);
     get_time_interval(t);
     pdsch_decode_us += (size_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+    if (decode_us_vec != NULL) {
+      decode_us_vec[sf_idx] = (uint32_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+    }
 
     snr_db_avg += ue_dl->chest_res.snr_db;
 
@@ -675,7 +756,20 @@ int main(int argc, char** argv)
     printf("SNR Real: %+.2f; estimated: %+.2f\n", snr_db, snr_db_avg / nof_subframes);
   }
 
+  if (json_filename != NULL) {
+    float bler = count_tbs ? (float)count_failures / (float)count_tbs : 0.0f;
+    if (json_write(encode_us_vec, decode_us_vec, tx_nof_bits, rx_nof_bits, bler) < SRSRAN_SUCCESS) {
+      ret = SRSRAN_ERROR;
+    }
+  }
+
 quit:
+  if (encode_us_vec) {
+    free(encode_us_vec);
+  }
+  if (decode_us_vec) {
+    free(decode_us_vec);
+  }
   srsran_enb_dl_free(enb_dl);
   srsran_ue_dl_free(ue_dl);
   srsran_random_free(random);
@@ -0,0 +1,615 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Microbenchmarks of the PHY hot kernels with canonical inputs. Each kernel is timed over repetitions of a calibrated
+ * number of iterations and the median is reported. The results are written in the JSON format of Google Benchmark
+ * and can be compared against a stored baseline, failing when a kernel is slower than the tolerance allows.
+ *
+ * A baseline is recorded with:
+ *   srsran_perf -c 2 -j baseline.json
+ * and checked with:
+ *   srsran_perf -c 2 -b baseline.json -T 10
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "srsran/srsran.h"
+
+#include "srsran/common/threads.h"
+#include "srsran/phy/utils/random.h"
+
+// One LTE subframe of 100 PRB
+#define PERF_NOF_RE (SRSRAN_NRE * 100 * SRSRAN_CP_NORM_NSYMB * 2)
+#define PERF_DFT_SIZE 2048
+#define PERF_TURBO_CB 6144
+#define PERF_TURBO_ITERATIONS 4
+#define PERF_LDPC_LS 384
+#define PERF_MAX_KERNELS 32
+#define PERF_NAME_LEN 64
+
+static double   min_time_ms       = 200.0; // Minimum duration of each repetition
+static uint32_t repetitions       = 5;
+static char*    cpu_list          = NULL; // CPUs the benchmark is pinned to, not pinned if NULL
+static char*    kernel_filter     = NULL; // Only the kernels whose name contains it are run, all if NULL
+static char*    json_filename     = NULL; // Report, not written if NULL
+static char*    baseline_filename = NULL; // Baseline report, not compared if NULL
+static double   tolerance_pc      = 10.0; // Slowdown against the baseline that fails the run
+
+void usage(char* prog)
+{
+  printf("Usage: %s [trckjbT]\n", prog);
+  printf("\t-t Minimum time of each repetition in ms [Default %.0f]\n", min_time_ms);
+  printf("\t-r Number of repetitions, the median is reported [Default %d]\n", repetitions);
+  printf("\t-c CPU list the benchmark is pinned to, e.g. 2 or 2-3 [Default %s]\n", cpu_list ? cpu_list : "none");
+  printf("\t-k Only run the kernels whose name contains the given string [Default %s]\n",
+         kernel_filter ? kernel_filter : "all");
+  printf("\t-j Write the results in the Google Benchmark JSON format to the given file [Default %s]\n",
+         json_filename ? json_filename : "none");
+  printf("\t-b Compare the results against the given baseline JSON file [Default %s]\n",
+         baseline_filename ? baseline_filename : "none");
+  printf("\t-T Tolerated slowdown against the baseline in %% [Default %.1f]\n", tolerance_pc);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "trckjbT")) != -1) {
+    switch (opt) {
+      case 't':
+        min_time_ms = strtod(argv[optind], NULL);
+        break;
+      case 'r':
+        repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'c':
+        cpu_list = argv[optind];
+        break;
+      case 'k':
+        kernel_filter = argv[optind];
+        break;
+      case 'j':
+        json_filename = argv[optind];
+        break;
+      case 'b':
+        baseline_filename = argv[optind];
+        break;
+      case 'T':
+        tolerance_pc = strtod(argv[optind], NULL);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  if (repetitions == 0 || min_time_ms <= 0.0 || tolerance_pc < 0.0) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+/*
+ * Kernels
+ */
+typedef struct {
+  const char* name;
+  const char* item;      // What items_per_second counts
+  uint32_t    nof_items; // Items processed by one call of run()
+  int (*init)(void);
+  void (*run)(void);
+  void (*free)(void);
+} perf_kernel_t;
+
+// Inputs shared by the kernels, filled once with random values
+static cf_t*    cf_a = NULL;
+static cf_t*    cf_b = NULL;
+static cf_t*    cf_c = NULL;
+static cf_t*    cf_d = NULL;
+static float*   f_a  = NULL;
+static float*   f_b  = NULL;
+static int16_t* s_a  = NULL;
+static int8_t*  c_a  = NULL;
+static uint8_t* u8_a = NULL;
+
+static srsran_crc_t          crc;
+static srsran_tdec_t         tdec;
+static srsran_ldpc_decoder_t ldpc_dec;
+static srsran_dft_plan_t     dft_plan;
+
+static int inputs_init(void)
+{
+  uint32_t max_llr = SRSRAN_MAX(6 * PERF_NOF_RE, 66 * PERF_LDPC_LS);
+
+  cf_a = srsran_vec_cf_malloc(PERF_NOF_RE);
+  cf_b = srsran_vec_cf_malloc(PERF_NOF_RE);
+  cf_c = srsran_vec_cf_malloc(PERF_NOF_RE);
+  cf_d = srsran_vec_cf_malloc(PERF_NOF_RE);
+  f_a  = srsran_vec_f_malloc(PERF_NOF_RE);
+  f_b  = srsran_vec_f_malloc(PERF_NOF_RE);
+  s_a  = srsran_vec_i16_malloc(max_llr);
+  c_a  = srsran_vec_i8_malloc(max_llr);
+  u8_a = srsran_vec_u8_malloc(max_llr);
+  if (!cf_a || !cf_b || !cf_c || !cf_d || !f_a || !f_b || !s_a || !c_a || !u8_a) {
+    return SRSRAN_ERROR;
+  }
+
+  // Fixed seed, so every run processes the same inputs
+  srsran_random_t random_gen = srsran_random_init(0x1234);
+  srsran_random_uniform_complex_dist_vector(random_gen, cf_a, PERF_NOF_RE, -1.0f, 1.0f);
+  srsran_random_uniform_complex_dist_vector(random_gen, cf_b, PERF_NOF_RE, -1.0f, 1.0f);
+  srsran_random_uniform_complex_dist_vector(random_gen, cf_c, PERF_NOF_RE, -1.0f, 1.0f);
+  srsran_random_uniform_complex_dist_vector(random_gen, cf_d, PERF_NOF_RE, -1.0f, 1.0f);
+  for (uint32_t i = 0; i < PERF_NOF_RE; i++) {
+    f_a[i] = srsran_random_uniform_real_dist(random_gen, -1.0f, 1.0f);
+  }
+  for (uint32_t i = 0; i < max_llr; i++) {
+    s_a[i] = (int16_t)srsran_random_uniform_int_dist(random_gen, -100, 100);
+    c_a[i] = (int8_t)srsran_random_uniform_int_dist(random_gen, -31, 31);
+  }
+  srsran_random_byte_vector(random_gen, u8_a, max_llr);
+  srsran_random_free(random_gen);
+
+  return SRSRAN_SUCCESS;
+}
+
+static void inputs_free(void)
+{
+  free(cf_a);
+  free(cf_b);
+  free(cf_c);
+  free(cf_d);
+  free(f_a);
+  free(f_b);
+  free(s_a);
+  free(c_a);
+  free(u8_a);
+}
+
+static void run_vec_prod_ccc(void)
+{
+  srsran_vec_prod_ccc(cf_a, cf_b, cf_c, PERF_NOF_RE);
+}
+
+static void run_vec_prod_conj_ccc(void)
+{
+  srsran_vec_prod_conj_ccc(cf_a, cf_b, cf_c, PERF_NOF_RE);
+}
+
+static void run_vec_dot_prod_conj_ccc(void)
+{
+  cf_c[0] = srsran_vec_dot_prod_conj_ccc(cf_a, cf_b, PERF_NOF_RE);
+}
+
+static void run_vec_abs_square_cf(void)
+{
+  srsran_vec_abs_square_cf(cf_a, f_b, PERF_NOF_RE);
+}
+
+static void run_vec_sc_prod_cfc(void)
+{
+  srsran_vec_sc_prod_cfc(cf_a, 0.5f, cf_c, PERF_NOF_RE);
+}
+
+static void run_vec_convert_fi(void)
+{
+  srsran_vec_convert_fi(f_a, 1000.0f, s_a, PERF_NOF_RE);
+}
+
+static int init_crc24a(void)
+{
+  return srsran_crc_init(&crc, SRSRAN_LTE_CRC24A, 24);
+}
+
+static void run_crc24a(void)
+{
+  srsran_crc_checksum_byte(&crc, u8_a, PERF_TURBO_CB);
+}
+
+static int init_turbo_dec(void)
+{
+  return srsran_tdec_init(&tdec, PERF_TURBO_CB);
+}
+
+static void run_turbo_dec(void)
+{
+  srsran_tdec_run_all(&tdec, s_a, u8_a, PERF_TURBO_ITERATIONS, PERF_TURBO_CB);
+}
+
+static void free_turbo_dec(void)
+{
+  srsran_tdec_free(&tdec);
+}
+
+static int init_ldpc_dec(void)
+{
+  srsran_ldpc_decoder_args_t args = {};
+#if defined(LV_HAVE_AVX512)
+  args.type = SRSRAN_LDPC_DECODER_C_AVX512;
+#elif defined(LV_HAVE_AVX2)
+  args.type = SRSRAN_LDPC_DECODER_C_AVX2;
+#else
+  args.type = SRSRAN_LDPC_DECODER_C;
+#endif
+  args.bg           = BG1;
+  args.ls           = PERF_LDPC_LS;
+  args.scaling_fctr = 0.8f;
+  return srsran_ldpc_decoder_init(&ldpc_dec, &args);
+}
+
+static void run_ldpc_dec(void)
+{
+  // The random LLRs never satisfy the parity checks, so every call runs the maximum number of iterations
+  srsran_ldpc_decoder_decode_c(&ldpc_dec, c_a, u8_a, ldpc_dec.liftN - 2 * PERF_LDPC_LS);
+}
+
+static void free_ldpc_dec(void)
+{
+  srsran_ldpc_decoder_free(&ldpc_dec);
+}
+
+static void run_demod_64qam_s(void)
+{
+  srsran_demod_soft_demodulate_s(SRSRAN_MOD_64QAM, cf_a, s_a, PERF_NOF_RE);
+}
+
+static void run_demod_256qam_b(void)
+{
+  srsran_demod_soft_demodulate_b(SRSRAN_MOD_256QAM, cf_a, c_a, PERF_NOF_RE / 2);
+}
+
+static void run_precoding_cdd(void)
+{
+  cf_t* x[SRSRAN_MAX_LAYERS] = {cf_a, cf_b};
+  cf_t* y[SRSRAN_MAX_PORTS]  = {cf_c, cf_d};
+  srsran_precoding_type(x, y, 2, 2, 0, PERF_NOF_RE, 1.0f, SRSRAN_TXSCHEME_CDD);
+}
+
+static int init_predecoding_mmse(void)
+{
+  srsran_predecoding_set_mimo_decoder(SRSRAN_MIMO_DECODER_MMSE);
+  return SRSRAN_SUCCESS;
+}
+
+static void run_predecoding_mmse(void)
+{
+  // Half a subframe per layer, so that the four channel estimates fit in the shared inputs
+  uint32_t nof_re                                = PERF_NOF_RE / 2;
+  cf_t*    y[SRSRAN_MAX_PORTS]                   = {cf_a, cf_b};
+  cf_t*    h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS] = {{cf_a + nof_re, cf_b + nof_re}, {cf_c + nof_re, cf_d + nof_re}};
+  cf_t*    x[SRSRAN_MAX_LAYERS]                  = {cf_c, cf_d};
+  float*   csi[SRSRAN_MAX_CODEWORDS]             = {f_a, f_b};
+  srsran_predecoding_type(y, h, x, csi, 2, 2, 2, 1, nof_re, SRSRAN_TXSCHEME_SPATIALMUX, 1.0f, 0.01f);
+}
+
+static int init_dft(void)
+{
+  return srsran_dft_plan_c(&dft_plan, PERF_DFT_SIZE, SRSRAN_DFT_FORWARD);
+}
+
+static void run_dft(void)
+{
+  srsran_dft_run_c(&dft_plan, cf_a, cf_c);
+}
+
+static void free_dft(void)
+{
+  srsran_dft_plan_free(&dft_plan);
+}
+
+static perf_kernel_t kernels[] = {
+    {"vec_prod_ccc/16800", "sample", PERF_NOF_RE, NULL, run_vec_prod_ccc, NULL},
+    {"vec_prod_conj_ccc/16800", "sample", PERF_NOF_RE, NULL, run_vec_prod_conj_ccc, NULL},
+    {"vec_dot_prod_conj_ccc/16800", "sample", PERF_NOF_RE, NULL, run_vec_dot_prod_conj_ccc, NULL},
+    {"vec_abs_square_cf/16800", "sample", PERF_NOF_RE, NULL, run_vec_abs_square_cf, NULL},
+    {"vec_sc_prod_cfc/16800", "sample", PERF_NOF_RE, NULL, run_vec_sc_prod_cfc, NULL},
+    {"vec_convert_fi/16800", "sample", PERF_NOF_RE, NULL, run_vec_convert_fi, NULL},
+    {"dft_c/2048", "sample", PERF_DFT_SIZE, init_dft, run_dft, free_dft},
+    {"crc24a_byte/6144", "bit", PERF_TURBO_CB, init_crc24a, run_crc24a, NULL},
+    {"turbo_dec/6144/4it", "bit", PERF_TURBO_CB, init_turbo_dec, run_turbo_dec, free_turbo_dec},
+    {"ldpc_dec_c/bg1/384", "bit", 22 * PERF_LDPC_LS, init_ldpc_dec, run_ldpc_dec, free_ldpc_dec},
+    {"demod_soft_s/64qam/16800", "symbol", PERF_NOF_RE, NULL, run_demod_64qam_s, NULL},
+    {"demod_soft_b/256qam/8400", "symbol", PERF_NOF_RE / 2, NULL, run_demod_256qam_b, NULL},
+    {"precoding_cdd/2x2/16800", "re", PERF_NOF_RE, NULL, run_precoding_cdd, NULL},
+    {"predecoding_mmse/2x2/8400", "re", PERF_NOF_RE / 2, init_predecoding_mmse, run_predecoding_mmse, NULL},
+};
+
+#define PERF_NOF_KERNELS (sizeof(kernels) / sizeof(perf_kernel_t))
+
+/*
+ * Measurement
+ */
+typedef struct {
+  uint64_t iterations;
+  double   real_ns; // Median wall time per iteration
+  double   cpu_ns;  // Median CPU time per iteration
+} perf_result_t;
+
+static double time_ns(clockid_t clock)
+{
+  struct timespec ts;
+  clock_gettime(clock, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int compare_double(const void* a, const void* b)
+{
+  double arg1 = *(const double*)a;
+  double arg2 = *(const double*)b;
+  return (arg1 > arg2) - (arg1 < arg2);
+}
+
+static double run_iterations(const perf_kernel_t* k, uint64_t iterations, double* cpu_ns)
+{
+  double t0     = time_ns(CLOCK_MONOTONIC);
+  double t0_cpu = time_ns(CLOCK_THREAD_CPUTIME_ID);
+  for (uint64_t i = 0; i < iterations; i++) {
+    k->run();
+  }
+  *cpu_ns = time_ns(CLOCK_THREAD_CPUTIME_ID) - t0_cpu;
+  return time_ns(CLOCK_MONOTONIC) - t0;
+}
+
+static void measure(const perf_kernel_t* k, perf_result_t* res)
+{
+  double min_time_ns = min_time_ms * 1e6;
+  double cpu_ns      = 0.0;
+
+  // Grow the iterations until a run lasts the minimum time, the first run also warms up the caches
+  uint64_t iterations = 1;
+  double   elapsed    = run_iterations(k, iterations, &cpu_ns);
+  while (elapsed < min_time_ns) {
+    double factor = (elapsed > 0.0) ? SRSRAN_MIN(SRSRAN_MAX(1.4 * min_time_ns / elapsed, 2.0), 10.0) : 10.0;
+    iterations    = (uint64_t)((double)iterations * factor);
+    elapsed       = run_iterations(k, iterations, &cpu_ns);
+  }
+
+  double real_ns[repetitions];
+  double cpu_ns_v[repetitions];
+  for (uint32_t r = 0; r < repetitions; r++) {
+    real_ns[r]  = run_iterations(k, iterations, &cpu_ns_v[r]) / (double)iterations;
+    cpu_ns_v[r] = cpu_ns_v[r] / (double)iterations;
+  }
+  qsort(real_ns, repetitions, sizeof(double), compare_double);
+  qsort(cpu_ns_v, repetitions, sizeof(double), compare_double);
+
+  res->iterations = iterations;
+  res->real_ns    = real_ns[repetitions / 2];
+  res->cpu_ns     = cpu_ns_v[repetitions / 2];
+}
+
+/*
+ * Report
+ */
+static const char* simd_name(void)
+{
+#if defined(LV_HAVE_AVX512)
+  return "avx512";
+#elif defined(LV_HAVE_AVX2)
+  return "avx2";
+#elif defined(LV_HAVE_AVX)
+  return "avx";
+#elif defined(LV_HAVE_SSE)
+  return "sse";
+#elif defined(HAVE_NEON)
+  return "neon";
+#else
+  return "none";
+#endif
+}
+
+static int json_write(const char* executable, const perf_result_t* results, const bool* enabled)
+{
+  FILE* f = fopen(json_filename, "w");
+  if (f == NULL) {
+    ERROR("Error opening %s", json_filename);
+    return SRSRAN_ERROR;
+  }
+
+  char      date[32] = {};
+  time_t    now      = time(NULL);
+  struct tm tm_now;
+  strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime_r(&now, &tm_now));
+
+  fprintf(f, "{\n  \"context\": {\n");
+  fprintf(f, "    \"date\": \"%s\",\n", date);
+  fprintf(f, "    \"executable\": \"%s\",\n", executable);
+  fprintf(f, "    \"num_cpus\": %ld,\n", sysconf(_SC_NPROCESSORS_ONLN));
+  fprintf(f, "    \"cpu_list\": \"%s\",\n", cpu_list ? cpu_list : "");
+  fprintf(f, "    \"simd\": \"%s\",\n", simd_name());
+  fprintf(f, "    \"min_time_ms\": %.1f,\n", min_time_ms);
+  fprintf(f, "    \"repetitions\": %d\n", repetitions);
+  fprintf(f, "  },\n  \"benchmarks\": [");
+
+  // One benchmark per line, which the baseline parser relies on
+  bool first = true;
+  for (uint32_t i = 0; i < PERF_NOF_KERNELS; i++) {
+    if (!enabled[i]) {
+      continue;
+    }
+    const perf_result_t* r = &results[i];
+    fprintf(f,
+            "%s\n    {\"name\": \"%s\", \"run_type\": \"iteration\", \"repetitions\": %d, \"iterations\": %lu, "
+            "\"real_time\": %.1f, \"cpu_time\": %.1f, \"time_unit\": \"ns\", \"items_per_second\": %.1f, "
+            "\"item\": \"%s\"}",
+            first ? "" : ",",
+            kernels[i].name,
+            repetitions,
+            (unsigned long)r->iterations,
+            r->real_ns,
+            r->cpu_ns,
+            (r->real_ns > 0.0) ? (double)kernels[i].nof_items * 1e9 / r->real_ns : 0.0,
+            kernels[i].item);
+    first = false;
+  }
+  fprintf(f, "\n  ]\n}\n");
+  fclose(f);
+
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * Baseline comparison
+ */
+typedef struct {
+  char   name[PERF_NAME_LEN];
+  double real_ns;
+} perf_baseline_t;
+
+// Reads the name and real_time members of the benchmarks of a Google Benchmark JSON file
+static int baseline_read(perf_baseline_t* baseline, uint32_t max_entries)
+{
+  FILE* f = fopen(baseline_filename, "r");
+  if (f == NULL) {
+    ERROR("Error opening %s", baseline_filename);
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t nof_entries = 0;
+  char     line[1024];
+  while (fgets(line, sizeof(line), f) != NULL && nof_entries < max_entries) {
+    const char* name = strstr(line, "\"name\": \"");
+    const char* time = strstr(line, "\"real_time\": ");
+    if (name == NULL || time == NULL) {
+      continue;
+    }
+    name += strlen("\"name\": \"");
+    const char* name_end = strchr(name, '"');
+    if (name_end == NULL || name_end - name >= PERF_NAME_LEN) {
+      continue;
+    }
+    perf_baseline_t* b = &baseline[nof_entries++];
+    memcpy(b->name, name, name_end - name);
+    b->name[name_end - name] = '\0';
+    b->real_ns               = strtod(time + strlen("\"real_time\": "), NULL);
+  }
+  fclose(f);
+
+  return (int)nof_entries;
+}
+
+// Prints the change of every kernel against the baseline and returns the number of regressions
+static int baseline_compare(const perf_result_t* results, const bool* enabled)
+{
+  perf_baseline_t baseline[PERF_MAX_KERNELS] = {};
+  int             nof_baseline               = baseline_read(baseline, PERF_MAX_KERNELS);
+  if (nof_baseline < 0) {
+    return SRSRAN_ERROR;
+  }
+
+  int nof_regressions = 0;
+  printf("\nComparison against %s (tolerance %.1f%%):\n", baseline_filename, tolerance_pc);
+  printf("%-30s %14s %14s %9s  %s\n", "kernel", "baseline ns", "current ns", "change", "status");
+  for (uint32_t i = 0; i < PERF_NOF_KERNELS; i++) {
+    if (!enabled[i]) {
+      continue;
+    }
+    const perf_baseline_t* b = NULL;
+    for (int j = 0; j < nof_baseline; j++) {
+      if (strcmp(baseline[j].name, kernels[i].name) == 0) {
+        b = &baseline[j];
+        break;
+      }
+    }
+    if (b == NULL || b->real_ns <= 0.0) {
+      printf("%-30s %14s %14.1f %9s  new\n", kernels[i].name, "-", results[i].real_ns, "-");
+      continue;
+    }
+
+    double      change_pc = 100.0 * (results[i].real_ns - b->real_ns) / b->real_ns;
+    const char* status    = "ok";
+    if (change_pc > tolerance_pc) {
+      status = "REGRESSION";
+      nof_regressions++;
+    } else if (change_pc < -tolerance_pc) {
+      status = "improved";
+    }
+    printf("%-30s %14.1f %14.1f %+8.1f%%  %s\n", kernels[i].name, b->real_ns, results[i].real_ns, change_pc, status);
+  }
+
+  return nof_regressions;
+}
+
+int main(int argc, char** argv)
+{
+  int           ret                       = SRSRAN_ERROR;
+  perf_result_t results[PERF_NOF_KERNELS] = {};
+  bool          enabled[PERF_NOF_KERNELS] = {};
+
+  parse_args(argc, argv);
+
+  // Pinning the benchmark to a fixed, isolated CPU keeps the runs comparable
+  if (cpu_list != NULL && !threads_set_self_cpu_list(cpu_list)) {
+    return SRSRAN_ERROR;
+  }
+
+  if (inputs_init() < SRSRAN_SUCCESS) {
+    ERROR("Error allocating the inputs");
+    goto clean_exit;
+  }
+
+  printf("%-30s %14s %14s %12s %16s\n", "kernel", "real ns/op", "cpu ns/op", "iterations", "Mitems/s");
+  for (uint32_t i = 0; i < PERF_NOF_KERNELS; i++) {
+    const perf_kernel_t* k = &kernels[i];
+    if (kernel_filter != NULL && strstr(k->name, kernel_filter) == NULL) {
+      continue;
+    }
+    if (k->init != NULL && k->init() < SRSRAN_SUCCESS) {
+      ERROR("Error initialising %s", k->name);
+      goto clean_exit;
+    }
+    measure(k, &results[i]);
+    if (k->free != NULL) {
+      k->free();
+    }
+    enabled[i] = true;
+
+    printf("%-30s %14.1f %14.1f %12lu %9.1f %s/s\n",
+           k->name,
+           results[i].real_ns,
+           results[i].cpu_ns,
+           (unsigned long)results[i].iterations,
+           (double)k->nof_items * 1e3 / results[i].real_ns,
+           k->item);
+  }
+
+  if (json_filename != NULL && json_write(argv[0], results, enabled) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+  if (baseline_filename != NULL) {
+    int nof_regressions = baseline_compare(results, enabled);
+    if (nof_regressions != 0) {
+      if (nof_regressions > 0) {
+        printf("%d kernel(s) slower than the baseline\n", nof_regressions);
+      }
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+clean_exit:
+  inputs_free();
+  return ret;
+}
@@ -231,6 +231,71 @@ int test5()
   return SRSRAN_SUCCESS;
 }
 
+// Byte ranges of an SDU under reassembly, received out of order
+int test6()
+{
+  rlc_am_rx_byte_ranges<3> ranges;
+  TESTASSERT(ranges.empty());
+
+  TESTASSERT(ranges.add(100, 50)); // [100, 150)
+  TESTASSERT(ranges.add(0, 50));   // [0, 50) [100, 150)
+  TESTASSERT(ranges.size() == 2);
+  TESTASSERT(ranges.overlaps(120, 10));
+  TESTASSERT(ranges.overlaps(40, 70));
+  TESTASSERT(ranges.overlaps(149, 1));
+  TESTASSERT(not ranges.overlaps(50, 50));
+  TESTASSERT(not ranges.overlaps(150, 10));
+
+  TESTASSERT(ranges.add(200, 10)); // [0, 50) [100, 150) [200, 210)
+  TESTASSERT(not ranges.add(170, 10));
+  TESTASSERT(ranges.size() == 3);
+
+  // ranges that touch are merged
+  TESTASSERT(ranges.add(150, 20)); // [0, 50) [100, 170) [200, 210)
+  TESTASSERT(ranges.size() == 3);
+  TESTASSERT(ranges.add(50, 50)); // [0, 170) [200, 210)
+  TESTASSERT(ranges.size() == 2);
+  TESTASSERT(ranges.front().start() == 0 and ranges.front().stop() == 170);
+  TESTASSERT(ranges.add(170, 30)); // [0, 210)
+  TESTASSERT(ranges.size() == 1);
+  TESTASSERT(ranges.front().start() == 0 and ranges.front().stop() == 210);
+
+  ranges.clear();
+  TESTASSERT(ranges.empty() and not ranges.overlaps(0, 210));
+
+  return SRSRAN_SUCCESS;
+}
+
+int test7()
+{
+  rlc_am_rx_sn_bitmap<1024> sns(1024);
+  sns.set(10);
+  sns.set(11);
+  sns.set(200);
+  sns.set(1020);
+
+  TESTASSERT(sns.find_next(0, 1024, true) == 10);
+  TESTASSERT(sns.find_next(10, 1024, false) == 12);
+  TESTASSERT(sns.find_next(12, 1024, true) == 200);
+  TESTASSERT(sns.find_next(12, 200, true) == 200); // none found
+  TESTASSERT(sns.count_missing(10, 12) == 0);
+  TESTASSERT(sns.count_missing(0, 201) == 198);
+
+  // the search and the count wrap around the SN space
+  TESTASSERT(sns.find_next(1021, 20, true) == 10);
+  TESTASSERT(sns.find_next(1015, 20, true) == 1020);
+  TESTASSERT(sns.find_next(1020, 12, false) == 1021);
+  TESTASSERT(sns.count_missing(1000, 12) == 33);
+
+  sns.reset(10);
+  TESTASSERT(not sns.test(10) and sns.test(11));
+  TESTASSERT(sns.find_next(1021, 20, true) == 11);
+  sns.clear();
+  TESTASSERT(sns.find_next(0, 1024, true) == 1024);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   srslog::init();
@@ -240,6 +305,8 @@ int main(int argc, char** argv)
   TESTASSERT(test3() == SRSRAN_SUCCESS);
   TESTASSERT(test4() == SRSRAN_SUCCESS);
   TESTASSERT(test5() == SRSRAN_SUCCESS);
+  TESTASSERT(test6() == SRSRAN_SUCCESS);
+  TESTASSERT(test7() == SRSRAN_SUCCESS);
 
   return SRSRAN_SUCCESS;
 }
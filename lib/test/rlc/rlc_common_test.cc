@@ -204,6 +204,55 @@ int meas_obj_test()
   return 0;
 }
 
+int tx_latency_metrics_test()
+{
+  rlc_tester            tester;
+  srsran::timer_handler timers(1);
+
+  rlc rlc1("RLC_1");
+  rlc1.init(&tester, &tester, &timers, 0);
+
+  uint32_t lcid = 1;
+  rlc1.add_bearer(lcid, rlc_config_t::default_rlc_um_config(10));
+
+  // Only the first SDUs carry an ingress timestamp, as the ones coming from GTP-U
+  uint32_t nof_stamped = 2;
+  for (uint32_t i = 0; i < NBUFS; i++) {
+    unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    sdu->N_bytes             = 1;
+    if (i < nof_stamped) {
+      sdu->set_timestamp();
+    }
+    rlc1.write_sdu(lcid, std::move(sdu));
+  }
+
+  // Every SDU is accounted once, when its first byte is read
+  byte_buffer_t pdu;
+  for (int i = 0; i < NBUFS; i++) {
+    TESTASSERT(rlc1.read_pdu(lcid, pdu.msg, 4) > 0);
+  }
+  TESTASSERT(0 == rlc1.get_buffer_state(lcid));
+
+  rlc_metrics_t metrics = {};
+  rlc1.get_metrics(metrics, 1);
+  uint32_t nof_queued = 0, nof_proc = 0;
+  for (uint32_t i = 0; i < latency_hist_len; i++) {
+    nof_queued += metrics.bearer[lcid].tx_queue_latency_hist[i];
+    nof_proc += metrics.bearer[lcid].tx_proc_latency_hist[i];
+  }
+  TESTASSERT(nof_queued == NBUFS);
+  TESTASSERT(nof_proc == nof_stamped);
+
+  // The histograms restart with every metrics report
+  rlc1.get_metrics(metrics, 1);
+  for (uint32_t i = 0; i < latency_hist_len; i++) {
+    TESTASSERT(metrics.bearer[lcid].tx_queue_latency_hist[i] == 0);
+    TESTASSERT(metrics.bearer[lcid].tx_proc_latency_hist[i] == 0);
+  }
+
+  return 0;
+}
+
 int main(int argc, char** argv)
 {
   srslog::init();
@@ -211,4 +260,8 @@ int main(int argc, char** argv)
   if (meas_obj_test()) {
     return -1;
   }
+
+  if (tx_latency_metrics_test()) {
+    return -1;
+  }
 }
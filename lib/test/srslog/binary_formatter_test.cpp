@@ -0,0 +1,188 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "src/srslog/formatters/binary_formatter.h"
+#include "srsran/srslog/detail/log_entry_metadata.h"
+#include "testing_helpers.h"
+#include <cstring>
+#include <numeric>
+
+using namespace srslog;
+
+/// Helper to build a log entry.
+static detail::log_entry_metadata build_log_entry_metadata(fmt::dynamic_format_arg_store<fmt::printf_context>* store)
+{
+  // Create a time point 50000us from epoch.
+  using tp_ty = std::chrono::time_point<std::chrono::high_resolution_clock>;
+  tp_ty tp(std::chrono::microseconds(50000));
+
+  if (store) {
+    store->push_back(88);
+    store->push_back(-3ll);
+    store->push_back(2.5);
+    store->push_back('c');
+    store->push_back(std::string("str"));
+    store->push_back("cstr");
+    store->push_back(true);
+  }
+
+  return {tp, {10, true}, "Text %d %lld %.2f %c %s %s %d", store, "ABC", 'Z'};
+}
+
+/// Decodes the binary buffer into text.
+static std::string decode(const fmt::memory_buffer& buffer, bool json = false)
+{
+  fmt::memory_buffer out;
+  if (!decode_binary_log(reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size(), out, json)) {
+    return "decoding error";
+  }
+  return fmt::to_string(out);
+}
+
+static bool when_log_entry_is_decoded_then_text_matches_text_formatter()
+{
+  fmt::dynamic_format_arg_store<fmt::printf_context> store;
+  auto                                               entry = build_log_entry_metadata(&store);
+  entry.hex_dump.resize(20);
+  std::iota(entry.hex_dump.begin(), entry.hex_dump.end(), 0);
+
+  fmt::dynamic_format_arg_store<fmt::printf_context> text_store;
+  auto                                               text_entry = build_log_entry_metadata(&text_store);
+  text_entry.hex_dump                                           = entry.hex_dump;
+
+  fmt::memory_buffer buffer;
+  binary_formatter{}.format(std::move(entry), buffer);
+  fmt::memory_buffer expected;
+  text_formatter{}.format(std::move(text_entry), expected);
+
+  ASSERT_EQ(decode(buffer), fmt::to_string(expected));
+
+  return true;
+}
+
+static bool when_log_entry_is_decoded_as_json_then_text_matches_json_formatter()
+{
+  fmt::dynamic_format_arg_store<fmt::printf_context> store;
+  fmt::memory_buffer                                 buffer;
+  binary_formatter{}.format(build_log_entry_metadata(&store), buffer);
+
+  std::string expected = "{\n"
+                         "  \"log_entry\": \"Text 88 -3 2.50 c str cstr 1\"\n"
+                         "}\n";
+
+  ASSERT_EQ(decode(buffer, true), expected);
+
+  return true;
+}
+
+static bool when_log_entry_has_no_arguments_then_format_string_is_kept_verbatim()
+{
+  auto entry      = build_log_entry_metadata(nullptr);
+  entry.fmtstring = "100% done";
+
+  fmt::memory_buffer buffer;
+  binary_formatter{}.format(std::move(entry), buffer);
+
+  ASSERT_EQ(decode(buffer), "1970-01-01T00:00:00.050000 [ABC    ] [Z] [   10] 100% done\n");
+
+  return true;
+}
+
+static bool when_format_string_is_repeated_then_it_is_only_defined_once()
+{
+  binary_formatter   formatter;
+  fmt::memory_buffer buffer;
+
+  fmt::dynamic_format_arg_store<fmt::printf_context> store1;
+  formatter.format(build_log_entry_metadata(&store1), buffer);
+  size_t first_size = buffer.size();
+
+  fmt::dynamic_format_arg_store<fmt::printf_context> store2;
+  formatter.format(build_log_entry_metadata(&store2), buffer);
+  size_t second_size = buffer.size() - first_size;
+
+  // The second entry carries no definitions.
+  ASSERT_EQ(first_size - second_size,
+            (1 + 4 + 4 + 3) + (1 + 4 + 4 + std::strlen("Text %d %lld %.2f %c %s %s %d")));
+
+  std::string text = decode(buffer);
+  ASSERT_EQ(text.substr(0, text.size() / 2), text.substr(text.size() / 2));
+
+  return true;
+}
+
+namespace {
+DECLARE_METRIC("SNR", snr_t, float, "dB");
+DECLARE_METRIC("PWR", pwr_t, int, "dBm");
+DECLARE_METRIC_SET("RF", myset1, snr_t, pwr_t);
+
+using basic_ctx_t = srslog::build_context_type<myset1>;
+} // namespace
+
+static bool when_context_is_decoded_then_text_matches_text_formatter()
+{
+  basic_ctx_t ctx("UL Context");
+  ctx.get<myset1>().write<snr_t>(-55.1);
+  ctx.get<myset1>().write<pwr_t>(-10);
+
+  for (bool with_message : {false, true}) {
+    fmt::dynamic_format_arg_store<fmt::printf_context> store, text_store;
+    auto entry      = build_log_entry_metadata(with_message ? &store : nullptr);
+    auto text_entry = build_log_entry_metadata(with_message ? &text_store : nullptr);
+    if (!with_message) {
+      entry.fmtstring      = nullptr;
+      text_entry.fmtstring = nullptr;
+    }
+
+    fmt::memory_buffer buffer;
+    binary_formatter{}.format_ctx(ctx, std::move(entry), buffer);
+    fmt::memory_buffer expected;
+    text_formatter{}.format_ctx(ctx, std::move(text_entry), expected);
+
+    ASSERT_EQ(decode(buffer), fmt::to_string(expected));
+  }
+
+  return true;
+}
+
+static bool when_binary_log_is_truncated_then_decoding_fails()
+{
+  fmt::dynamic_format_arg_store<fmt::printf_context> store;
+  fmt::memory_buffer                                 buffer;
+  binary_formatter{}.format(build_log_entry_metadata(&store), buffer);
+
+  fmt::memory_buffer out;
+  ASSERT_EQ(decode_binary_log(reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size() - 1, out), false);
+
+  return true;
+}
+
+int main()
+{
+  TEST_FUNCTION(when_log_entry_is_decoded_then_text_matches_text_formatter);
+  TEST_FUNCTION(when_log_entry_is_decoded_as_json_then_text_matches_json_formatter);
+  TEST_FUNCTION(when_log_entry_has_no_arguments_then_format_string_is_kept_verbatim);
+  TEST_FUNCTION(when_format_string_is_repeated_then_it_is_only_defined_once);
+  TEST_FUNCTION(when_context_is_decoded_then_text_matches_text_formatter);
+  TEST_FUNCTION(when_binary_log_is_truncated_then_decoding_fails);
+
+  return 0;
+}
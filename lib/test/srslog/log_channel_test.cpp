@@ -75,7 +75,7 @@ public:
   {
     e = std::move(entry);
     ++count;
-    return true;
+    return !full;
   }
 
   bool is_running() const override { return true; }
@@ -86,7 +86,11 @@ public:
 
   const detail::log_entry& last_entry() const { return e; }
 
+  /// Makes the backend reject the pushed log entries, as if its queue was full.
+  void set_full(bool f) { full = f; }
+
 private:
+  bool                                               full  = false;
   unsigned                                           count = 0;
   detail::log_entry                                  e;
   fmt::dynamic_format_arg_store<fmt::printf_context> store;
@@ -121,6 +125,25 @@ static bool when_logging_in_disabled_log_channel_then_log_entry_is_ignored()
   return true;
 }
 
+static bool when_backend_rejects_log_entries_then_dropped_entries_are_counted()
+{
+  backend_spy              backend;
+  test_dummies::sink_dummy s;
+  log_channel              log("id", s, backend);
+
+  log("test", 42, "Hello");
+  ASSERT_EQ(log.get_nof_dropped(), 0);
+
+  backend.set_full(true);
+  log("test", 42, "Hello");
+  log("test", 43, "Hello");
+
+  ASSERT_EQ(backend.push_invocation_count(), 3);
+  ASSERT_EQ(log.get_nof_dropped(), 2);
+
+  return true;
+}
+
 static bool when_logging_then_filled_in_log_entry_is_pushed_into_the_backend()
 {
   backend_spy              backend;
@@ -208,6 +231,37 @@ static bool when_hex_array_length_is_less_than_hex_log_max_size_then_array_lengt
   return true;
 }
 
+static bool when_hex_dump_sampling_is_set_then_one_in_n_hex_dumps_is_captured()
+{
+  backend_spy              backend;
+  test_dummies::sink_dummy s;
+
+  log_channel log("id", s, backend);
+
+  log.set_hex_dump_max_size(-1);
+  log.set_hex_dump_sampling(3);
+  uint8_t hex[100] = {};
+  hex[99]          = 7;
+
+  unsigned nof_captured = 0;
+  for (unsigned i = 0; i != 9; ++i) {
+    log(hex, sizeof(hex), "test");
+    const detail::log_entry& entry = backend.last_entry();
+    ASSERT_EQ(entry.metadata.fmtstring, std::string("test"));
+    if (!entry.metadata.hex_dump.empty()) {
+      // Payloads above the inline capacity are kept whole.
+      ASSERT_EQ(entry.metadata.hex_dump.size(), sizeof(hex));
+      ASSERT_EQ(entry.metadata.hex_dump.data()[99], 7);
+      ++nof_captured;
+    }
+  }
+
+  ASSERT_EQ(backend.push_invocation_count(), 9);
+  ASSERT_EQ(nof_captured, 3);
+
+  return true;
+}
+
 namespace {
 
 DECLARE_METRIC("SNR", snr_t, int, "dB");
@@ -286,9 +340,11 @@ int main()
   TEST_FUNCTION(when_log_channel_is_enabled_then_enabled_returns_true);
   TEST_FUNCTION(when_logging_in_log_channel_then_log_entry_is_pushed_into_the_backend);
   TEST_FUNCTION(when_logging_in_disabled_log_channel_then_log_entry_is_ignored);
+  TEST_FUNCTION(when_backend_rejects_log_entries_then_dropped_entries_are_counted);
   TEST_FUNCTION(when_logging_then_filled_in_log_entry_is_pushed_into_the_backend);
   TEST_FUNCTION(when_logging_with_hex_dump_then_filled_in_log_entry_is_pushed_into_the_backend);
   TEST_FUNCTION(when_hex_array_length_is_less_than_hex_log_max_size_then_array_length_is_used);
+  TEST_FUNCTION(when_hex_dump_sampling_is_set_then_one_in_n_hex_dumps_is_captured);
   TEST_FUNCTION(when_logging_with_context_then_filled_in_log_entry_is_pushed_into_the_backend);
   TEST_FUNCTION(when_logging_with_context_and_message_then_filled_in_log_entry_is_pushed_into_the_backend);
 
@@ -84,6 +84,7 @@ struct log_args_t {
   int         all_hex_limit;
   int         file_max_size;
   std::string filename;
+  std::string file_format;
 };
 
 struct gui_args_t {
@@ -95,6 +96,10 @@ struct general_args_t {
   float       metrics_period_secs;
   bool        metrics_csv_enable;
   std::string metrics_csv_filename;
+  bool        metrics_prometheus_enable;
+  std::string metrics_prometheus_addr;
+  int         metrics_prometheus_port;
+  uint32_t    metrics_prometheus_max_ues;
   bool        report_json_enable;
   std::string report_json_filename;
   bool        report_json_asn1_oct;
@@ -103,6 +108,7 @@ struct general_args_t {
   bool        print_buffer_state;
   bool        tracing_enable;
   std::size_t tracing_buffcapacity;
+  bool        phy_stage_prof;
   std::string tracing_filename;
   std::string eia_pref_list;
   std::string eea_pref_list;
@@ -110,6 +116,8 @@ struct general_args_t {
   uint32_t    max_mac_ul_kos;
   uint32_t    gtpu_indirect_tunnel_timeout;
   uint32_t    rlf_release_timer_ms;
+  std::string mem_profile;
+  uint32_t    byte_buffer_pool_size;
 };
 
 struct all_args_t {
@@ -162,6 +170,8 @@ private:
 
   int parse_args(const all_args_t& args_, rrc_cfg_t& rrc_cfg_, rrc_nr_cfg_t& rrc_cfg_nr_);
 
+  void get_mem_metrics(enb_metrics_t& m);
+
   srslog::sink&         log_sink;
   srslog::basic_logger& enb_log;
 
@@ -0,0 +1,93 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        metrics_prometheus.h
+ * Description: Metrics class serving the last report over HTTP in the
+ *              OpenMetrics text format, to be scraped by Prometheus.
+ *****************************************************************************/
+
+#ifndef SRSENB_METRICS_PROMETHEUS_H
+#define SRSENB_METRICS_PROMETHEUS_H
+
+#include "srsran/common/network_utils.h"
+#include "srsran/interfaces/enb_metrics_interface.h"
+#include "srsran/srslog/bundled/fmt/format.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace srsenb {
+
+class metrics_prometheus : public srsran::metrics_listener<enb_metrics_t>
+{
+public:
+  /// Per UE series are only exported for the first max_ues UEs of the report, the rest only count in the cell totals.
+  metrics_prometheus(enb_metrics_interface* enb_, uint32_t max_ues_);
+  ~metrics_prometheus();
+
+  /// Starts serving the metrics over HTTP in the given address and port.
+  bool start(const std::string& bind_addr, int port);
+
+  void set_metrics(const enb_metrics_t& m, const uint32_t period_usec) override;
+  void stop() override;
+
+  /// Renders the metrics in the OpenMetrics text format, appending them to the buffer.
+  void render(const enb_metrics_t& m, fmt::memory_buffer& buffer);
+
+private:
+  void run_server();
+  void serve_client(int fd);
+  void accumulate_histograms(const enb_metrics_t& m);
+
+  void render_cells(const enb_metrics_t& m, fmt::memory_buffer& buffer);
+  void render_ues(const enb_metrics_t& m, fmt::memory_buffer& buffer);
+  void render_memory(const enb_metrics_t& m, fmt::memory_buffer& buffer);
+  void render_tti_deadline(fmt::memory_buffer& buffer);
+  void render_phy_stages(fmt::memory_buffer& buffer);
+
+  enb_metrics_interface* enb;
+  const uint32_t         max_ues;
+
+  // The report is rendered into back_buffer by the metrics thread and swapped into front_buffer, which the HTTP
+  // thread copies into send_buffer. The three buffers keep their capacity, so rendering does not allocate after the
+  // first reports.
+  std::mutex            mutex;
+  fmt::memory_buffer    back_buffer;
+  fmt::memory_buffer    front_buffer;
+  fmt::memory_buffer    send_buffer;
+  std::vector<uint32_t> ue_idxs;
+
+  // The histograms are cumulative since startup, as OpenMetrics requires.
+  uint64_t                    nof_tti  = 0;
+  uint64_t                    nof_late = 0;
+  uint64_t                    slack_hist[tti_nof_stages][tti_slack_hist_len] = {};
+  srsran_stage_prof_metrics_t phy_stages[SRSRAN_STAGE_PROF_NOF]              = {};
+  uint64_t                    phy_stage_hist[SRSRAN_STAGE_PROF_NOF][SRSRAN_STAGE_PROF_HIST_LEN] = {};
+
+  srsran::unique_socket listen_socket;
+  std::thread           server;
+  std::atomic<bool>     running{false};
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_METRICS_PROMETHEUS_H
@@ -46,6 +46,11 @@ public:
 
   virtual void get_metrics(std::vector<phy_metrics_t>& m) = 0;
 
+  /// Memory allocated by the PHY workers for each cell, in bytes
+  virtual void get_mem_metrics(std::vector<uint64_t>& cell_bytes) = 0;
+
+  virtual void get_tti_deadline_metrics(tti_deadline_metrics_t& m) = 0;
+
   virtual void cmd_cell_gain(uint32_t cell_idx, float gain_db) = 0;
 
   virtual void cmd_cell_measure() = 0;
@@ -22,9 +22,12 @@
 #ifndef SRSENB_CC_WORKER_H
 #define SRSENB_CC_WORKER_H
 
+#include <functional>
+#include <memory>
 #include <string.h>
 
 #include "../phy_common.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/srslog/srslog.h"
 
 #define LOG_EXECTIME
@@ -55,23 +58,45 @@ public:
   int  read_pucch_d(cf_t* pusch_d);
   void start_plot();
 
+  /// PMCH symbols encoded in this subframe by the first cell of the MBSFN area. The MCH payload is the same in all the
+  /// cells of the area, so cells with the same bandwidth map these symbols instead of encoding the MCH again.
+  struct pmch_symbols_t {
+    const cf_t* symbols = nullptr;
+    uint32_t    nof_prb = 0;
+    uint32_t    nof_re  = 0;
+  };
+
   void work_ul(const srsran_ul_sf_cfg_t& ul_sf, stack_interface_phy_lte::ul_sched_t& ul_grants);
   void work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                stack_interface_phy_lte::dl_sched_t& dl_grants,
                stack_interface_phy_lte::ul_sched_t& ul_grants,
-               srsran_mbsfn_cfg_t*                  mbsfn_cfg);
+               srsran_mbsfn_cfg_t*                  mbsfn_cfg,
+               pmch_symbols_t&                      pmch_symbols);
 
   uint32_t get_metrics(std::vector<phy_metrics_t>& metrics);
 
+  /// Memory allocated by the carrier when it was initialised
+  void     set_mem_bytes(uint64_t nof_bytes) { mem_bytes = nof_bytes; }
+  uint64_t get_mem_bytes() const { return mem_bytes; }
+
 private:
   constexpr static float PUSCH_RL_SNR_DB_TH = 1.0f;
   constexpr static float PUCCH_RL_CORR_TH   = 0.15f;
+  constexpr static int   GRANT_THREAD_PRIO  = 2; ///< Same as the PHY workers the grant lanes help
 
   int  encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants);
-  int  encode_pmch(stack_interface_phy_lte::dl_sched_grant_t* grant, srsran_mbsfn_cfg_t* mbsfn_cfg);
-  bool decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
+  int  encode_pmch(stack_interface_phy_lte::dl_sched_grant_t* grant,
+                   srsran_mbsfn_cfg_t*                        mbsfn_cfg,
+                   pmch_symbols_t&                            pmch_symbols);
+  bool prepare_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
+                          srsran_ul_cfg_t&                           ul_cfg,
+                          bool&                                      uci_required);
+  bool decode_pusch_rnti(uint32_t lane, srsran_ul_cfg_t& ul_cfg, srsran_pusch_res_t& pusch_res);
+  void report_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
                          srsran_ul_cfg_t&                           ul_cfg,
-                         srsran_pusch_res_t&                        pusch_res);
+                         srsran_pusch_res_t&                        pusch_res,
+                         const srsran_chest_ul_res_t&               chest_res,
+                         bool                                       uci_required);
   void decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch);
   int  encode_phich(stack_interface_phy_lte::ul_sched_ack_t* acks, uint32_t nof_acks);
   int  encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants);
@@ -82,6 +107,7 @@ private:
   srslog::basic_logger& logger;
   phy_common*           phy       = nullptr;
   bool                  initiated = false;
+  uint64_t              mem_bytes = 0;
 
   cf_t*    signal_buffer_rx[SRSRAN_MAX_PORTS] = {};
   cf_t*    signal_buffer_tx[SRSRAN_MAX_PORTS] = {};
@@ -117,6 +143,43 @@ private:
     phy_metrics_t metrics = {};
   };
 
+  // PUSCH grants waiting for the deferred turbo decoding
+  struct pusch_pending_t {
+    stack_interface_phy_lte::ul_sched_grant_t* ul_grant     = nullptr;
+    srsran_ul_cfg_t                            ul_cfg       = {};
+    srsran_pusch_res_t                         pusch_res    = {};
+    srsran_chest_ul_res_t                      chest_res    = {};
+    bool                                       uci_required = false;
+    bool                                       decoded      = false;
+  };
+  std::vector<pusch_pending_t> pending_pusch;
+
+  // PDSCH grants of the subframe, encoded once all of them are configured
+  struct pdsch_pending_t {
+    stack_interface_phy_lte::dl_sched_grant_t* dl_grant = nullptr;
+    srsran_dl_cfg_t                            dl_cfg   = {};
+    int                                        ret      = SRSRAN_SUCCESS;
+  };
+  std::vector<pdsch_pending_t> pending_pdsch;
+
+  // SNR, TA and CQI measurements of the UL subframe, reported to MAC in one batch
+  std::vector<stack_interface_phy_lte::ue_meas_t> ue_meas;
+
+  // Additional PDSCH encoder and PUSCH decoder, lane 0 is the one in enb_dl and enb_ul
+  struct grant_lane_t {
+    srsran_pdsch_t        pdsch     = {};
+    srsran_pusch_t        pusch     = {};
+    srsran_chest_ul_t     chest     = {};
+    srsran_chest_ul_res_t chest_res = {};
+    ~grant_lane_t();
+  };
+  bool init_grant_lanes(uint32_t nof_lanes, srsran_cell_t cell, uint32_t nof_prb);
+  void run_grant_lanes(uint32_t                                      nof_grants,
+                       const std::function<void(uint32_t, uint32_t)>& process,
+                       const std::function<void(uint32_t)>&           finish);
+  std::vector<std::unique_ptr<grant_lane_t> > grant_lanes;
+  std::unique_ptr<srsran::task_thread_pool>  grant_pool;
+
   // Component carrier index
   uint32_t cc_idx = 0;
 
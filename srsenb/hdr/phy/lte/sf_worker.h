@@ -22,6 +22,7 @@
 #ifndef SRSENB_PHCH_WORKER_H
 #define SRSENB_PHCH_WORKER_H
 
+#include <chrono>
 #include <mutex>
 #include <string.h>
 
@@ -57,9 +58,11 @@ public:
   void     start_plot();
 
   uint32_t get_metrics(std::vector<phy_metrics_t>& metrics);
+  void     get_mem_metrics(std::vector<uint64_t>& cell_bytes);
 
 private:
   void work_imp() final;
+  void set_stage_deadline(tti_stage_t stage);
 
   /* Common objects */
   srslog::basic_logger& logger;
@@ -72,6 +75,11 @@ private:
   std::vector<std::unique_ptr<cc_worker> >       cc_workers;
   srsran::phy_common_interface::worker_context_t context = {};
 
+  // The subframe must be handed to the radio before its transmission time, which is the end of the reception plus
+  // FDD_HARQ_DELAY_UL_MS - 1 subframes
+  std::chrono::steady_clock::time_point tti_deadline                = {};
+  float                                 tti_slack_us[tti_nof_stages] = {};
+
   srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
 };
 
@@ -0,0 +1,113 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_NR_PUSCH_DECODER_POOL_H
+#define SRSENB_NR_PUSCH_DECODER_POOL_H
+
+#include "srsran/common/threads.h"
+#include "srsran/srsran.h"
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace srsenb {
+namespace nr {
+
+/**
+ * The pusch_decoder_pool class decodes the PUSCH transmissions of all the slot workers with a set of threads shared by
+ * them.
+ *
+ * A slot worker hands over the PUSCH transmissions of its slot as a batch and decodes them too, with its own gNb UL
+ * object. Every thread of the pool has a PUSCH decoder of its own and takes the next transmission of the batch with the
+ * most pending ones, whatever its slot and carrier. The threads left idle by the light slots help the heavy ones.
+ */
+class pusch_decoder_pool
+{
+public:
+  struct args_t {
+    uint32_t                nof_threads      = 0;
+    uint32_t                nof_max_prb      = SRSRAN_MAX_PRB_NR;
+    uint32_t                nof_rx_ports     = 1;
+    uint32_t                pusch_max_its    = 10;
+    float                   pusch_min_snr_dB = -10.0f;
+    srsran_ldpc_rm_cache_t* ldpc_rm_cache    = nullptr; ///< LDPC rate dematching cache shared by all the decoders
+    int32_t                 prio             = -1;
+    std::string             cpus             = {}; ///< CPUs of the threads, one per thread
+  };
+
+  /**
+   * @brief Decodes the task_idx-th PUSCH transmission of a batch with the given decoder
+   */
+  using task_t = std::function<void(srsran_gnb_ul_t& decoder, uint32_t task_idx)>;
+
+  pusch_decoder_pool() = default;
+  ~pusch_decoder_pool();
+
+  bool init(const args_t& args);
+  void stop();
+
+  /**
+   * @brief Runs the tasks of a batch in the pool threads and in the calling thread, which uses its own decoder
+   * @param decoder gNb UL object of the calling thread, it holds the demodulated resource grid of the batch
+   * @param nof_tasks Number of tasks of the batch
+   * @param task Task to run for each index of the batch
+   * @note Returns once all the tasks have finished, the tasks of batches with a single task are run in place
+   */
+  void run(srsran_gnb_ul_t& decoder, uint32_t nof_tasks, const task_t& task);
+
+private:
+  struct batch_t {
+    const task_t* task      = nullptr;
+    uint32_t      nof_tasks = 0;
+    uint32_t      next      = 0; ///< Next task to take
+    uint32_t      nof_done  = 0; ///< Number of finished tasks
+  };
+
+  class decoder_thread final : public srsran::thread
+  {
+  public:
+    decoder_thread(pusch_decoder_pool& parent_) : thread("PUSCH_DEC"), parent(parent_) {}
+    ~decoder_thread() { srsran_gnb_ul_free(&decoder); }
+
+    srsran_gnb_ul_t decoder = {};
+
+  private:
+    void                run_thread() override { parent.run_decoder(decoder); }
+    pusch_decoder_pool& parent;
+  };
+
+  uint32_t take_task(batch_t& batch);
+  void     run_decoder(srsran_gnb_ul_t& decoder);
+
+  std::mutex                                    mutex;
+  std::condition_variable                       cvar_pending;
+  std::condition_variable                       cvar_done;
+  std::vector<batch_t*>                         batches; ///< Batches with tasks yet to be taken
+  bool                                          running = false;
+  std::vector<std::unique_ptr<decoder_thread> > threads;
+};
+
+} // namespace nr
+} // namespace srsenb
+
+#endif // SRSENB_NR_PUSCH_DECODER_POOL_H
@@ -22,6 +22,7 @@
 #ifndef SRSENB_NR_SLOT_WORKER_H
 #define SRSENB_NR_SLOT_WORKER_H
 
+#include "pusch_decoder_pool.h"
 #include "srsran/common/thread_pool.h"
 #include "srsran/interfaces/gnb_interfaces.h"
 #include "srsran/interfaces/phy_common_interface.h"
@@ -68,6 +69,8 @@ public:
     uint32_t                    pusch_max_its    = 10;
     float                       pusch_min_snr_dB = -10.0f;
     double                      srate_hz         = 0.0;
+    srsran_ldpc_rm_cache_t*     ldpc_rm_cache    = nullptr; ///< LDPC rate dematching cache shared by all workers
+    pusch_decoder_pool*         pusch_pool       = nullptr; ///< Threads helping with the PUSCH, optional
   };
 
   slot_worker(srsran::phy_common_interface& common_,
@@ -78,9 +81,10 @@ public:
 
   bool init(const args_t& args);
 
-  bool set_common_cfg(const srsran_carrier_nr_t&   carrier,
-                      const srsran_pdcch_cfg_nr_t& pdcch_cfg_,
-                      const srsran_ssb_cfg_t&      ssb_cfg_);
+  bool set_common_cfg(const srsran_carrier_nr_t&       carrier,
+                      const srsran_pdcch_cfg_nr_t&     pdcch_cfg_,
+                      const srsran_ssb_cfg_t&          ssb_cfg_,
+                      const srsran_duplex_config_nr_t& duplex_);
 
   /* Functions used by main PHY thread */
   cf_t*    get_buffer_rx(uint32_t antenna_idx);
@@ -118,10 +122,21 @@ private:
   srsran_slot_cfg_t                              ul_slot_cfg = {};
   srsran::phy_common_interface::worker_context_t context     = {};
   srsran_pdcch_cfg_nr_t                          pdcch_cfg   = {};
+  srsran_duplex_config_nr_t                      duplex      = {}; ///< FDD until the common configuration is set
+  bool                                           tx_zero     = false; ///< The Tx buffers hold zeros from a UL slot
   srsran_gnb_dl_t                                gnb_dl      = {};
   srsran_gnb_ul_t                                gnb_ul      = {};
   std::vector<cf_t*>                             tx_buffer; ///< Baseband transmit buffers
   std::vector<cf_t*>                             rx_buffer; ///< Baseband receive buffers
+  pusch_decoder_pool*                            pusch_pool = nullptr;
+
+  // PUSCH transmissions of the slot, decoded by any thread of the pool and reported to the stack in order
+  struct pusch_pending_t {
+    stack_interface_phy_nr::pusch_info_t info = {};
+    int                                  ret  = SRSRAN_SUCCESS;
+    std::array<char, 512>                str  = {}; ///< Decoding summary, filled if the info logs are enabled
+  };
+  std::vector<pusch_pending_t> pending_pusch;
   std::mutex mutex; ///< Protect concurrent access from workers (and main process that inits the class)
 };
 
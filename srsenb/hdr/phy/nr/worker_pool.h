@@ -70,6 +70,7 @@ private:
     }
     int snr_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, float snr_db, ul_channel_t ch) override { return 0; }
     int ta_info(uint32_t tti, uint16_t rnti, float ta_us) override { return 0; }
+    int meas_info(uint32_t tti, srsran::const_span<ue_meas_t> meas) override { return 0; }
     int ack_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t tb_idx, bool ack) override { return 0; }
     int crc_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t nof_bytes, bool crc_res) override { return 0; }
     int push_pdu(uint32_t tti_rx,
@@ -98,13 +99,17 @@ private:
   prach_stack_adaptor_t                      prach_stack_adaptor;
   uint32_t                                   nof_prach_workers = 0;
   double                                     srate_hz          = 0.0; ///< Current sampling rate in Hz
+  srsran_ldpc_rm_cache_t                     ldpc_rm_cache     = {};  ///< LDPC rate dematching maps of all workers
+  pusch_decoder_pool                         pusch_pool;                ///< PUSCH decoding threads of all workers
 
 public:
   struct args_t {
     double                 srate_hz          = 0.0;
     uint32_t               nof_phy_threads   = 3;
+    uint32_t               nof_pusch_threads = 0;
     uint32_t               nof_prach_workers = 0;
     uint32_t               prio              = 52;
+    std::string            cpus              = {}; // CPUs of the workers, one per worker
     uint32_t               pusch_max_its     = 10;
     float                  pusch_min_snr_dB  = -10;
     srsran::phy_log_args_t log               = {};
@@ -115,6 +120,7 @@ public:
               stack_interface_phy_nr&       stack,
               srslog::sink&                 log_sink,
               uint32_t                      max_workers);
+  ~worker_pool();
   bool         init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_list);
   slot_worker* wait_worker(uint32_t tti);
   slot_worker* wait_worker_id(uint32_t id);
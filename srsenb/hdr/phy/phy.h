@@ -73,6 +73,8 @@ public:
   void complete_config(uint16_t rnti) override;
 
   void get_metrics(std::vector<phy_metrics_t>& metrics) override;
+  void get_mem_metrics(std::vector<uint64_t>& cell_bytes) override;
+  void get_tti_deadline_metrics(tti_deadline_metrics_t& metrics) override;
 
   void cmd_cell_gain(uint32_t cell_id, float gain_db) override;
   void cmd_cell_measure() override;
@@ -299,6 +299,18 @@ public:
   void set_ul_grants(uint32_t tti, const stack_interface_phy_lte::ul_sched_list_t& ul_grants);
   void clear_grants(uint16_t rnti);
 
+  /**
+   * Accumulates the slack left before the transmission time of a TTI at the end of each of its processing stages
+   *
+   * @param slack_us slack in microseconds per stage, negative if the stage completed after the transmission time
+   */
+  void set_tti_deadline(const float (&slack_us)[tti_nof_stages]);
+
+  /**
+   * Gets the TTI deadline metrics accumulated since the previous call and resets them
+   */
+  void get_tti_deadline_metrics(tti_deadline_metrics_t& m);
+
 private:
   // Common objects for scheduling grants
   srsran::circular_array<stack_interface_phy_lte::ul_sched_list_t, TTIMOD_SZ> ul_grants   = {};
@@ -308,6 +320,9 @@ private:
   phy_cell_cfg_list_nr_t cell_list_nr;
   std::mutex             cell_gain_mutex;
 
+  tti_deadline_metrics_t deadline_metrics = {};
+  std::mutex             deadline_mutex;
+
   bool                    have_mtch_stop   = false;
   std::mutex              mtch_mutex;
   std::condition_variable mtch_cvar;
@@ -47,12 +47,13 @@ struct phy_cell_cfg_t {
 typedef std::vector<phy_cell_cfg_t> phy_cell_cfg_list_t;
 
 struct cfr_args_t {
-  bool              enable           = false;
-  srsran_cfr_mode_t mode             = SRSRAN_CFR_THR_MANUAL;
-  float             manual_thres     = 0.5f;
-  float             strength         = 1.0f;
-  float             auto_target_papr = 8.0f;
-  float             ema_alpha        = 1.0f / (float)SRSRAN_CP_NORM_NSYMB;
+  bool                enable           = false;
+  srsran_cfr_mode_t   mode             = SRSRAN_CFR_THR_MANUAL;
+  float               manual_thres     = 0.5f;
+  float               strength         = 1.0f;
+  float               auto_target_papr = 8.0f;
+  float               ema_alpha        = 1.0f / (float)SRSRAN_CP_NORM_NSYMB;
+  srsran_cfr_filter_t filter           = SRSRAN_CFR_FILTER_FFT;
 };
 
 struct phy_args_t {
@@ -64,8 +65,12 @@ struct phy_args_t {
   uint32_t                pusch_max_its       = 10;
   uint32_t                nr_pusch_max_its    = 10;
   bool                    pusch_8bit_decoder  = false;
+  bool                    pusch_early_stop    = false;
+  bool                    pusch_snr_max_its   = false;
   float                   tx_amplitude        = 1.0f;
   uint32_t                nof_phy_threads     = 1;
+  uint32_t                nof_grant_threads   = 0;
+  uint32_t                nr_pusch_threads    = 0;
   std::string             equalizer_mode      = "mmse";
   float                   estimator_fil_w     = 1.0f;
   bool                    pusch_meas_epre     = true;
@@ -73,7 +78,13 @@ struct phy_args_t {
   bool                    pusch_meas_ta       = true;
   bool                    pucch_meas_ta       = true;
   uint32_t                nof_prach_threads   = 1;
+  uint32_t                prach_corr_threads  = 0;
   bool                    extended_cp         = false;
+  uint32_t                hugepage_min_kb     = 0; // PHY buffers of at least this size in huge pages, 0 disables
+  std::string             txrx_cpus;      // CPUs of the radio thread, empty to let the OS schedule it
+  std::string             worker_cpus;    // CPUs of the LTE workers, one per worker
+  std::string             nr_worker_cpus; // CPUs of the NR workers, one per worker
+  std::string             prach_cpus;     // CPUs of the PRACH workers, one per carrier
   srsran::channel::args_t dl_channel_args;
   srsran::channel::args_t ul_channel_args;
   cfr_args_t              cfr_args;
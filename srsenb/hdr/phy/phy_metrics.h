@@ -22,24 +22,29 @@
 #ifndef SRSENB_PHY_METRICS_H
 #define SRSENB_PHY_METRICS_H
 
+#include <cstdint>
 #include <limits>
 
 namespace srsenb {
 
+// Number of bins of the turbo decoder iterations histogram, the last bin also counts longer decodings
+constexpr uint32_t turbo_iters_hist_len = 16;
+
 // PHY metrics per user
 
 struct ul_metrics_t {
-  float   n;
-  float   pusch_sinr;
-  float   pusch_rssi;
-  int64_t pusch_tpc;
-  float   pucch_sinr;
-  float   pucch_rssi;
-  float   pucch_ni;
-  float   turbo_iters;
-  float   mcs;
-  int     n_samples;
-  int     n_samples_pucch;
+  float    n;
+  float    pusch_sinr;
+  float    pusch_rssi;
+  int64_t  pusch_tpc;
+  float    pucch_sinr;
+  float    pucch_rssi;
+  float    pucch_ni;
+  float    turbo_iters;
+  uint32_t turbo_iters_hist[turbo_iters_hist_len]; // PUSCH transport blocks per average number of (half) iterations
+  float    mcs;
+  int      n_samples;
+  int      n_samples_pucch;
 };
 
 struct dl_metrics_t {
@@ -53,6 +58,30 @@ struct phy_metrics_t {
   ul_metrics_t ul;
 };
 
+// TTI deadline metrics, common to all the users
+
+// Processing stages of a TTI, timed by the deadline monitor of the PHY workers
+enum class tti_stage_t { ul = 0, stack, dl, tx, nof_stages };
+
+constexpr uint32_t tti_nof_stages = static_cast<uint32_t>(tti_stage_t::nof_stages);
+
+// Number of bins of the slack histograms: the first bin counts the late TTIs, the next ones are tti_slack_hist_bin_us
+// wide and the last bin also counts any larger slack
+constexpr uint32_t tti_slack_hist_len    = 16;
+constexpr uint32_t tti_slack_hist_bin_us = 250;
+
+struct tti_stage_metrics_t {
+  float    slack_min_us;
+  float    slack_avg_us;
+  uint32_t slack_hist[tti_slack_hist_len]; // TTIs per slack left before the transmission when the stage completes
+};
+
+struct tti_deadline_metrics_t {
+  uint32_t            nof_tti;
+  uint32_t            nof_late; // TTIs handed to the radio after their transmission time
+  tti_stage_metrics_t stage[tti_nof_stages];
+};
+
 } // namespace srsenb
 
 #endif // SRSENB_PHY_METRICS_H
@@ -25,7 +25,9 @@
 #include "phy_interfaces.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/interfaces/enb_phy_interfaces.h"
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <srsran/adt/circular_array.h>
 
@@ -81,37 +83,84 @@ private:
   } cell_state_t;
 
   /**
-   * Cell information for the UE database
+   * Cell information for the UE database, only modified by the stack
    */
   struct cell_info_t {
-    cell_state_t state      = cell_state_none; ///< Configuration state
-    uint32_t     enb_cc_idx = 0;               ///< Corresponding eNb cell/carrier index
-    uint8_t      last_ri    = 0;               ///< Last reported rank indicator
-    srsran::circular_array<srsran_ra_tb_t, SRSRAN_MAX_HARQ_PROC> last_tb =
-        {}; ///< Stores last PUSCH Resource allocation
-    bool                                    stash_use_tbs_index_alt = false;
-    srsran::phy_cfg_t                       phy_cfg;            ///< Configuration, it has a default constructor
-    srsran::circular_array<bool, TTIMOD_SZ> is_grant_available; ///< Indicates whether there is an available grant
+    cell_state_t      state                   = cell_state_none; ///< Configuration state
+    uint32_t          enb_cc_idx              = 0;               ///< Corresponding eNb cell/carrier index
+    bool              stash_use_tbs_index_alt = false;
+    srsran::phy_cfg_t phy_cfg; ///< Configuration, it has a default constructor
   };
 
   /**
-   * UE object stored in the PHY common database
+   * Cell feedback written and read by the workers, each TTI (or HARQ process) entry is only accessed by the worker
+   * processing it
    */
-  struct common_ue {
-    bool                                                  stashed_multiple_csi_request_enabled = false;
+  struct cell_feedback_t {
+    /// Last reported rank indicator, written by the worker decoding the report
+    std::atomic<uint8_t> last_ri = {0};
+    /// Stores last PUSCH Resource allocation
+    srsran::circular_array<srsran_ra_tb_t, SRSRAN_MAX_HARQ_PROC> last_tb = {};
+    /// Indicates whether there is an available grant
+    srsran::circular_array<bool, TTIMOD_SZ> is_grant_available = {};
+  };
+
+  /**
+   * UE feedback, it is shared by all the configuration versions of the UE
+   */
+  struct ue_feedback_t {
     srsran::circular_array<srsran_pdsch_ack_t, TTIMOD_SZ> pdsch_ack = {}; ///< Pending acknowledgements for this Cell
-    std::array<cell_info_t, SRSRAN_MAX_CARRIERS>          cell_info = {}; ///< Cell information, indexed by ue_cell_idx
+    std::array<cell_feedback_t, SRSRAN_MAX_CARRIERS>      cell      = {}; ///< Cell feedback, indexed by ue_cell_idx
   };
 
   /**
-   * UE database indexed by RNTI
+   * UE object stored in the PHY common database. Once published it is never modified, the stack modifies a copy
    */
-  std::map<uint16_t, common_ue> ue_db;
+  struct common_ue {
+    bool                                         stashed_multiple_csi_request_enabled = false;
+    std::array<cell_info_t, SRSRAN_MAX_CARRIERS> cell_info = {}; ///< Cell information, indexed by ue_cell_idx
+    std::shared_ptr<ue_feedback_t>               feedback;       ///< Feedback, shared with the previous versions
+  };
 
   /**
-   * Concurrency protection mutex, allowed modifications from const methods.
+   * UE database indexed by RNTI. The UE entries are shared between versions and only the modified ones are copied
    */
-  mutable std::mutex mutex;
+  typedef std::map<uint16_t, std::shared_ptr<const common_ue> > ue_db_t;
+
+  /**
+   * Read-copy-update protection of the database. The workers read the current version without locking, the stack
+   * copies it, modifies the copy, publishes it and releases the previous version once no worker reads it.
+   *
+   * The readers register in the counter of the current epoch parity. Publishing a version flips the epoch and waits
+   * for the readers of the previous parity, which are the only ones that may hold the previous version.
+   */
+  std::atomic<const ue_db_t*>                  ue_db       = {nullptr};
+  std::atomic<uint32_t>                        epoch       = {0};
+  mutable std::array<std::atomic<uint32_t>, 2> nof_readers = {};
+
+  /**
+   * Serialises the stack modifications of the database
+   */
+  std::mutex write_mutex;
+
+  /**
+   * Read side critical section, it keeps the version of the database read at construction alive during its lifetime
+   */
+  class read_guard
+  {
+  public:
+    explicit read_guard(const phy_ue_db& parent_);
+    ~read_guard();
+    read_guard(const read_guard&) = delete;
+    read_guard& operator=(const read_guard&) = delete;
+
+    const ue_db_t& operator*() const { return *db; }
+
+  private:
+    const phy_ue_db& parent;
+    uint32_t         parity = 0;
+    const ue_db_t*   db     = nullptr;
+  };
 
   /**
    * Stack interface
@@ -129,20 +178,38 @@ private:
   const phy_cell_cfg_list_t* cell_cfg_list = nullptr;
 
   /**
-   * Internal RNTI addition, it is not thread safe protected
+   * Publishes a new version of the database and deletes the previous one once no worker reads it. It shall be called
+   * with the write mutex taken.
+   *
+   * @param db the new version, the database takes its ownership
+   */
+  void _publish(const ue_db_t* db);
+
+  /**
+   * Gets a modifiable copy of a UE in a new version of the database, the copy replaces the UE in the given version
+   *
+   * @param db the new version of the database (requires the RNTI to exist)
+   * @param rnti identifier of the UE
+   * @return the modifiable UE copy
+   */
+  static common_ue& _modify_rnti(ue_db_t& db, uint16_t rnti);
+
+  /**
+   * Internal RNTI addition to a new version of the database
    *
+   * @param db the new version of the database
    * @param rnti identifier of the UE
    * @return SRSRAN_SUCCESS if the RNTI is not duplicated and is added successfully, SRSRAN_ERROR code if it exists
    */
-  inline int _add_rnti(uint16_t rnti);
+  inline int _add_rnti(ue_db_t& db, uint16_t rnti);
 
   /**
-   * Internal pending ACK clear for a given RNTI and TTI, it is not thread safe protected
+   * Internal pending ACK clear for a given UE and TTI, only the worker processing the TTI shall call it
    *
    * @param tti is the given TTI (requires assertion prior to call)
-   * @param rnti identifier of the UE (requires assertion prior to call)
+   * @param ue the UE
    */
-  inline void _clear_tti_pending_rnti(uint32_t tti, uint16_t rnti);
+  static inline void _clear_tti_pending_rnti(uint32_t tti, const common_ue& ue);
 
   /**
    * Helper method to set the constant attributes of a given RNTI after the configuration is set, it does not modify
@@ -154,14 +221,14 @@ private:
   inline void _set_common_config_rnti(uint16_t rnti, srsran::phy_cfg_t& phy_cfg) const;
 
   /**
-   * Gets the SCell index for a given RNTI and a eNb cell/carrier. It returns the SCell index (0 if PCell) if the cc_idx
+   * Gets the SCell index for a given UE and a eNb cell/carrier. It returns the SCell index (0 if PCell) if the cc_idx
    * is found among the configured cells/carriers. Otherwise, it returns SRSRAN_MAX_CARRIERS.
    *
-   * @param rnti identifier of the UE (requires assertion prior to call)
+   * @param ue the UE
    * @param enb_cc_idx the eNb cell/carrier index to look for in the RNTI.
    * @return the SCell index as described above.
    */
-  inline uint32_t _get_ue_cc_idx(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline uint32_t _get_ue_cc_idx(const common_ue& ue, uint32_t enb_cc_idx);
 
   /**
    * Gets the eNb Cell/Carrier index in which the UCI shall be carried. This corresponds to the serving cell with lowest
@@ -170,49 +237,54 @@ private:
    * If no grant is available in the indicated TTI, it returns the number of the eNb Cells/Carriers.
    *
    * @param tti The UL processing TTI
-   * @param rnti Temporal UE ID
+   * @param ue the UE
    * @return the eNb Cell/Carrier with lowest serving cell index that has an UL grant
    */
-  uint32_t _get_uci_enb_cc_idx(uint32_t tti, uint16_t rnti) const;
+  uint32_t _get_uci_enb_cc_idx(uint32_t tti, const common_ue& ue) const;
 
   /**
-   * Checks if a given RNTI exists in the database
+   * Finds a given RNTI in a version of the database
+   * @param db version of the database
    * @param rnti provides UE identifier
-   * @return SRSRAN_SUCCESS if the indicated RNTI exists, otherwise it returns SRSRAN_ERROR
+   * @return the UE if the indicated RNTI exists, otherwise it returns nullptr
    */
-  inline int _assert_rnti(uint16_t rnti) const;
+  static inline const common_ue* _find_rnti(const ue_db_t& db, uint16_t rnti);
 
   /**
-   * Checks if an RNTI is configured to use an specified eNb cell/carrier as PCell or SCell
+   * Finds an RNTI configured to use an specified eNb cell/carrier as PCell or SCell
+   * @param db version of the database
    * @param rnti provides UE identifier
    * @param enb_cc_idx provides eNb cell/carrier
-   * @return SRSRAN_SUCCESS if the indicated RNTI exists, otherwise it returns SRSRAN_ERROR
+   * @return the UE if the indicated RNTI exists and uses the cell/carrier, otherwise it returns nullptr
    */
-  inline int _assert_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline const common_ue* _find_enb_cc(const ue_db_t& db, uint16_t rnti, uint32_t enb_cc_idx);
 
   /**
    * Checks if an RNTI uses a given eNb cell/carrier as PCell
+   * @param db version of the database
    * @param rnti provides UE identifier
    * @param enb_cc_idx provides eNb cell/carrier index
    * @return SRSRAN_SUCCESS if the indicated eNb cell/carrier of the RNTI is a PCell, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_enb_pcell(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline int _assert_enb_pcell(const ue_db_t& db, uint16_t rnti, uint32_t enb_cc_idx);
 
   /**
    * Checks if an RNTI is configured to use an specified UE cell/carrier as PCell or SCell
+   * @param db version of the database
    * @param rnti provides UE identifier
    * @param ue_cc_idx UE cell/carrier index that is asserted
    * @return SRSRAN_SUCCESS if the indicated cell/carrier index is valid, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_ue_cc(uint16_t rnti, uint32_t ue_cc_idx) const;
+  static inline int _assert_ue_cc(const ue_db_t& db, uint16_t rnti, uint32_t ue_cc_idx);
 
   /**
-   * Checks if an RNTI is configured to use an specified eNb cell/carrier as PCell or SCell and it is active
+   * Finds an RNTI configured to use an specified eNb cell/carrier as PCell or SCell and it is active
+   * @param db version of the database
    * @param rnti provides UE identifier
    * @param enb_cc_idx UE cell/carrier index that is asserted
-   * @return SRSRAN_SUCCESS if the indicated eNb cell/carrier is active, otherwise it returns SRSRAN_ERROR
+   * @return the UE if the indicated eNb cell/carrier is active, otherwise it returns nullptr
    */
-  inline int _assert_active_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline const common_ue* _find_active_enb_cc(const ue_db_t& db, uint16_t rnti, uint32_t enb_cc_idx);
 
   /**
    * Internal eNb stack assertion
@@ -229,22 +301,27 @@ private:
   /**
    * Internal eNb general configuration getter, returns default configuration if the UE does not exist in the given cell
    *
+   * @param db version of the database
    * @param rnti provides UE identifier
    * @param enb_cc_idx eNb cell index
    * @param[out] phy_cfg The PHY configuration of the indicated UE for the indicated eNb carrier/call index.
    * @return SRSRAN_SUCCESS if provided context is correct, SRSRAN_ERROR code otherwise
    */
-  inline int _get_rnti_config(uint16_t rnti, uint32_t enb_cc_idx, srsran::phy_cfg_t& phy_cfg) const;
+  static inline int
+  _get_rnti_config(const ue_db_t& db, uint16_t rnti, uint32_t enb_cc_idx, srsran::phy_cfg_t& phy_cfg);
 
   /**
    * Count number of configured secondary serving cells
    *
-   * @param rnti provides UE identifier
+   * @param ue the UE
    * @return The number of configured secondary cells
    */
-  inline uint32_t _count_nof_configured_scell(uint16_t rnti);
+  static inline uint32_t _count_nof_configured_scell(const common_ue& ue);
 
 public:
+  phy_ue_db();
+  ~phy_ue_db();
+
   /**
    * Initialises the UE database with the stack and cell list
    * @param stack_ptr points to the stack (read/write)
@@ -384,22 +461,25 @@ public:
    * @param rnti is the UE identifier
    * @param uci_cfg is the UCI configuration
    * @param uci_value is the UCI received value
+   * @param meas_list if not null, the wideband CQI is appended to it instead of being sent to MAC
    * @return SRSRAN_SUCCESS if provided RNTI exists in the given cell, SRSRAN_ERROR code otherwise
    */
-  int send_uci_data(uint32_t                  tti,
-                    uint16_t                  rnti,
-                    uint32_t                  enb_cc_idx,
-                    const srsran_uci_cfg_t&   uci_cfg,
-                    const srsran_uci_value_t& uci_value);
-
-  static void send_cqi_data(uint32_t                       tti,
-                            uint16_t                       rnti,
-                            uint32_t                       cqi_cc_idx,
-                            const srsran_cqi_cfg_t&        cqi_cfg,
-                            const srsran_cqi_value_t&      cqi_value,
-                            const srsran_cqi_report_cfg_t& cqi_report_cfg,
-                            const srsran_cell_t&           cell,
-                            stack_interface_phy_lte*       stack);
+  int send_uci_data(uint32_t                                         tti,
+                    uint16_t                                         rnti,
+                    uint32_t                                         enb_cc_idx,
+                    const srsran_uci_cfg_t&                          uci_cfg,
+                    const srsran_uci_value_t&                        uci_value,
+                    std::vector<stack_interface_phy_lte::ue_meas_t>* meas_list = nullptr);
+
+  static void send_cqi_data(uint32_t                                         tti,
+                            uint16_t                                         rnti,
+                            uint32_t                                         cqi_cc_idx,
+                            const srsran_cqi_cfg_t&                          cqi_cfg,
+                            const srsran_cqi_value_t&                        cqi_value,
+                            const srsran_cqi_report_cfg_t&                   cqi_report_cfg,
+                            const srsran_cell_t&                             cell,
+                            stack_interface_phy_lte*                         stack,
+                            std::vector<stack_interface_phy_lte::ue_meas_t>* meas_list = nullptr);
 
   /**
    * Set the latest UL Transport Block resource allocation for a given RNTI, eNb cell/carrier and UL HARQ process
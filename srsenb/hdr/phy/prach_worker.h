@@ -53,7 +53,9 @@ public:
             const srsran_prach_cfg_t& prach_cfg_,
             stack_interface_phy_lte*  mac,
             int                       priority,
-            uint32_t                  nof_workers);
+            uint32_t                  nof_workers,
+            uint32_t                  nof_corr_workers,
+            const std::string&        cpu_list);
   int  new_tti(uint32_t tti, cf_t* buffer);
   void set_max_prach_offset_us(float delay_us);
   void stop();
@@ -123,14 +125,16 @@ public:
             stack_interface_phy_lte*  mac,
             srslog::basic_logger&     logger,
             int                       priority,
-            uint32_t                  nof_workers_x_cc)
+            uint32_t                  nof_workers_x_cc,
+            uint32_t                  nof_corr_workers_x_cc,
+            const std::string&        cpu_list)
   {
     // Create PRACH worker if required
     while (cc_idx >= prach_vec.size()) {
       prach_vec.push_back(std::unique_ptr<prach_worker>(new prach_worker(prach_vec.size(), logger)));
     }
 
-    prach_vec[cc_idx]->init(cell_, prach_cfg_, mac, priority, nof_workers_x_cc);
+    prach_vec[cc_idx]->init(cell_, prach_cfg_, mac, priority, nof_workers_x_cc, nof_corr_workers_x_cc, cpu_list);
   }
 
   void set_max_prach_offset_us(float delay_us)
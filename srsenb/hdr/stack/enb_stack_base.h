@@ -33,6 +33,7 @@ namespace srsenb {
 typedef struct {
   bool        enable;
   std::string filename;
+  uint32_t    snaplen; // Captured bytes per PDU, 0 captures the whole PDUs
 } pcap_args_t;
 
 typedef struct {
@@ -50,6 +51,15 @@ typedef struct {
   uint16_t    mcs;
 } embms_args_t;
 
+typedef struct {
+  bool        enable;
+  std::string dl_flows;           // List of eps_bearer_id:profile:rate_kbps, profile being cbr, burst or sawtooth
+  uint32_t    sdu_size;           // Bytes of each generated DL SDU
+  uint32_t    burst_period_ms;    // Period of the burst flows
+  uint32_t    burst_on_ms;        // Time of each period in which the burst flows send
+  uint32_t    sawtooth_period_ms; // Time in which the sawtooth flows ramp up from half to full rate
+} traffic_gen_args_t;
+
 typedef struct {
   std::string mac_level;
   std::string rlc_level;
@@ -69,15 +79,22 @@ typedef struct {
 } stack_log_args_t;
 
 typedef struct {
-  uint32_t         sync_queue_size; // Max allowed difference between PHY and Stack clocks (in TTI)
-  uint32_t         gtpu_indirect_tunnel_timeout_msec;
-  mac_args_t       mac;
-  s1ap_args_t      s1ap;
-  pcap_args_t      mac_pcap;
-  pcap_net_args_t  mac_pcap_net;
-  pcap_args_t      s1ap_pcap;
-  stack_log_args_t log;
-  embms_args_t     embms;
+  uint32_t           sync_queue_size; // Max allowed difference between PHY and Stack clocks (in TTI)
+  uint32_t           gtpu_indirect_tunnel_timeout_msec;
+  // Number of threads running the PDCP of the UEs, sharded by RNTI (0 for stack thread)
+  uint32_t           nof_pdcp_shards;
+  // Number of threads ciphering the DRB PDUs (0 for the PDCP threads)
+  uint32_t           nof_pdcp_crypto_workers;
+  uint32_t           rlc_ue_tx_budget_kb; // Max KB queued for TX across the DRBs of a UE (0 for no limit)
+  mac_args_t         mac;
+  s1ap_args_t        s1ap;
+  pcap_args_t        mac_pcap;
+  pcap_net_args_t    mac_pcap_net;
+  pcap_args_t        s1ap_pcap;
+  stack_log_args_t   log;
+  embms_args_t       embms;
+  traffic_gen_args_t traffic_gen;
+  std::string        cpus; // CPUs of the stack thread, empty to let the OS schedule it
 } stack_args_t;
 
 struct stack_metrics_t;
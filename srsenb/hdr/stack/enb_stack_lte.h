@@ -34,6 +34,7 @@
 #include "upper/gtpu.h"
 #include "upper/pdcp.h"
 #include "upper/rlc.h"
+#include "upper/traffic_gen.h"
 
 #include "enb_stack_base.h"
 #include "srsran/common/bearer_manager.h"
@@ -87,6 +88,7 @@ public:
     return mac.snr_info(tti_rx, rnti, cc_idx, snr_db, ch);
   }
   int ta_info(uint32_t tti, uint16_t rnti, float ta_us) override { return mac.ta_info(tti, rnti, ta_us); }
+  int meas_info(uint32_t tti, srsran::const_span<ue_meas_t> meas) final { return mac.meas_info(tti, meas); }
   int ack_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack) final
   {
     return mac.ack_info(tti, rnti, enb_cc_idx, tb_idx, ack);
@@ -173,11 +175,13 @@ private:
 
   // task handling
   srsran::task_scheduler    task_sched;
-  srsran::task_queue_handle enb_task_queue, sync_task_queue, metrics_task_queue, x2_task_queue;
+  srsran::task_queue_handle enb_task_queue, sync_task_queue, metrics_task_queue, x2_task_queue, pdcp_task_queue,
+      upper_task_queue;
 
   // bearer management
   enb_bearer_manager                 bearers; // helper to manage mapping between EPS and radio bearers
   std::unique_ptr<gtpu_pdcp_adapter> gtpu_adapter;
+  std::unique_ptr<traffic_gen>       tgen; // replaces the GTPU user plane when enabled
 
   srsenb::mac  mac;
   srsenb::rlc  rlc;
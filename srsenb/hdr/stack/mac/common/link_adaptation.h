@@ -0,0 +1,60 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_LINK_ADAPTATION_H
+#define SRSRAN_LINK_ADAPTATION_H
+
+#include <cstdint>
+
+namespace srsenb {
+
+/**
+ * Outer loop link adaptation (OLLA) state of a {rnti, carrier, direction}, shared by the LTE and NR schedulers.
+ * It keeps an offset that is added to the channel quality reported by the UE (CQI in DL, SNR in UL) before the MCS is
+ * derived. Each ACK raises the offset by delta_up and each NACK lowers it by delta_down = delta_up (1 - BLER) / BLER,
+ * so that the offset converges when the BLER of the transmissions reaches the target BLER.
+ */
+class olla_controller
+{
+public:
+  olla_controller() = default;
+
+  /// A target_bler of zero disables the adaptation, leaving the offset at zero
+  olla_controller(float target_bler, float step_size, float max_offset);
+
+  bool  enabled() const { return delta_up > 0; }
+  float get_offset() const { return offset; }
+  void  reset() { offset = 0; }
+
+  /// Updates the offset with the HARQ feedback of a TB transmitted with the given MCS. The offset is not pushed further
+  /// when the MCS was already at its limits
+  void harq_feedback(bool ack, int mcs, int max_mcs);
+
+private:
+  float delta_up   = 0;
+  float delta_down = 0;
+  float max_offset = 0;
+  float offset     = 0;
+};
+
+} // namespace srsenb
+
+#endif // SRSRAN_LINK_ADAPTATION_H
@@ -57,6 +57,9 @@ struct mac_ue_metrics_t {
   int   dl_mcs_samples;
   float ul_mcs;
   int   ul_mcs_samples;
+
+  // Memory held by the HARQ soft-buffers of the UE, summed over its carriers
+  uint64_t softbuffer_bytes;
 };
 /// MAC misc information for each cc.
 struct mac_cc_info_t {
@@ -31,6 +31,7 @@
 #include "srsran/common/mac_pcap.h"
 #include "srsran/common/mac_pcap_net.h"
 #include "srsran/common/task_scheduler.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/common/threads.h"
 #include "srsran/common/tti_sync_cv.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
@@ -68,6 +69,7 @@ public:
   int sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t sb_idx, uint32_t cqi_value) override;
   int snr_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, float snr, ul_channel_t ch) override;
   int ta_info(uint32_t tti, uint16_t rnti, float ta_us) override;
+  int meas_info(uint32_t tti, srsran::const_span<ue_meas_t> meas) override;
   int ack_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack) override;
   int crc_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t nof_bytes, bool crc_res) override;
   int push_pdu(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t nof_bytes, bool crc_res, uint32_t ul_nof_prbs)
@@ -147,6 +149,9 @@ private:
   // derived from args
   srsran::task_multiqueue::queue_handle stack_task_queue;
 
+  // UL PDU workers. The PDUs of an UE always go to the same worker, so that they are processed in order
+  std::vector<std::unique_ptr<srsran::task_worker> > ul_pdu_workers;
+
   bool started = false;
 
   /* Scheduler unit */
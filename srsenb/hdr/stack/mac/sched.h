@@ -26,7 +26,10 @@
 #include "sched_interface.h"
 #include "sched_ue.h"
 #include "srsenb/hdr/common/common_enb.h"
+#include "srsran/adt/move_callback.h"
+#include "srsran/common/thread_pool.h"
 #include <atomic>
+#include <condition_variable>
 #include <map>
 #include <mutex>
 
@@ -93,8 +96,32 @@ public:
   class carrier_sched;
 
 protected:
+  /// UE feedback pushed by the PHY and stack threads, applied to the UE database at the start of every TTI
+  struct ue_event_t {
+    uint16_t                               rnti;
+    const char*                            event_name;
+    srsran::move_callback<void(sched_ue&)> callback;
+    ue_event_t(uint16_t rnti_, const char* event_name_, srsran::move_callback<void(sched_ue&)> c) :
+      rnti(rnti_), event_name(event_name_), callback(std::move(c))
+    {
+    }
+  };
+  /// The producers only hold the queue mutex to append an event, never while the scheduler runs
+  struct ue_event_queue {
+    std::mutex              mutex;
+    std::vector<ue_event_t> next_events;
+    std::vector<ue_event_t> current_events;
+  };
+
   void new_tti(srsran::tti_point tti_rx);
+  void generate_parallel_tti_results(srsran::tti_point tti_rx);
+  void run_carrier_tasks(srsran::tti_point tti_rx);
   bool is_generated(srsran::tti_point, uint32_t enb_cc_idx) const;
+  void enqueue_ue_event(ue_event_queue&                        queue,
+                        const char*                            event_name,
+                        uint16_t                               rnti,
+                        srsran::move_callback<void(sched_ue&)> callback);
+  void process_ue_events(ue_event_queue& queue);
   // Helper methods
   template <typename Func>
   int ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name = nullptr, bool log_fail = true);
@@ -112,6 +139,21 @@ protected:
   // Storage of past scheduling results
   sched_result_ringbuffer sched_results;
 
+  // Pending UE feedback, UE-wide events (e.g. BSR, SR) and the ones of each carrier (e.g. ACKs, CQI)
+  ue_event_queue                                  ue_events;
+  std::array<ue_event_queue, SRSRAN_MAX_CARRIERS> cc_ue_events;
+
+  // Parallel generation of the carrier results. A carrier only starts once the lower carriers it shares a CA UE with
+  // are done, so each CA UE is claimed by its carriers one at a time and in the same order as a sequential run
+  std::unique_ptr<srsran::task_thread_pool> cc_workers;
+  std::mutex                                cc_mutex;
+  std::condition_variable                   cc_cvar;
+  std::array<uint32_t, SRSRAN_MAX_CARRIERS> cc_deps         = {}; ///< Carriers that must be done before each one
+  uint32_t                                  cc_all_mask     = 0;
+  uint32_t                                  cc_started_mask = 0;
+  uint32_t                                  cc_done_mask    = 0;
+  uint32_t                                  nof_cc_helpers  = 0;
+
   srsran::tti_point last_tti;
   std::mutex        sched_mutex;
   bool              configured;
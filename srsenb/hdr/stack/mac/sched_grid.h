@@ -53,8 +53,8 @@ struct sf_sched_result {
     assert(enb_cc_idx < enb_cc_list.size());
     return &enb_cc_list[enb_cc_idx];
   }
-  bool is_ul_alloc(uint16_t rnti) const;
-  bool is_dl_alloc(uint16_t rnti) const;
+  bool is_ul_alloc(const sched_ue& user) const;
+  bool is_dl_alloc(const sched_ue& user) const;
 };
 
 struct sched_result_ringbuffer {
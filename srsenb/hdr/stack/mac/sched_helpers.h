@@ -47,8 +47,6 @@ inline uint32_t get_nof_retx(uint32_t rv_idx)
   return nof_retxs[rv_idx % 4];
 }
 
-cce_frame_position_table generate_cce_location_table(uint16_t rnti, const sched_cell_params_t& cell_cfg);
-
 /**
  * Generate possible CCE locations a user can use to allocate DCIs
  * @param regs Regs data for the given cell configuration
@@ -78,8 +78,10 @@ public:
     float       ul_snr_avg_alpha          = 0.05;
     int         init_ul_snr_value         = 5;
     int         init_dl_cqi               = 5;
+    uint32_t    dl_sb_cqi_max_age         = 0; ///< Age in ms after which a subband CQI report is ignored (0 to disable)
     float       max_sib_coderate          = 0.8;
     int         pdcch_cqi_offset          = 0;
+    uint32_t    nof_cc_workers            = 0; ///< Threads that generate carrier results next to the MAC thread
   };
 
   struct cell_cfg_t {
@@ -51,6 +51,40 @@ using cce_sf_position_table = std::array<std::array<cce_position_list, NOF_AGGR_
 /// Map {sf, cfi, L} -> list of CCE positions
 using cce_frame_position_table = std::array<cce_sf_position_table, SRSRAN_NOF_SF_X_FRAME>;
 
+/**
+ * Bounded LRU cache of the UE-specific PDCCH candidates of a cell. The candidates only depend on the CFI and on the
+ * hash Yk of the RNTI and subframe index (TS 36.213 9.1.1), so the UEs with the same Yk share one table, and the
+ * tables are only generated when first used. An entry is only evicted after CACHE_SIZE other keys were used, so the
+ * tables returned while scheduling a TTI stay valid for the whole TTI
+ */
+class cce_ue_location_cache
+{
+public:
+  const static uint32_t CACHE_SIZE  = 512;
+  const static uint32_t NOF_BUCKETS = 1024;
+
+  void                          reset(srsran_regs_t* regs_);
+  const cce_cfi_position_table& get(uint16_t rnti, uint32_t sf_idx, uint32_t cfix);
+
+private:
+  struct entry {
+    uint32_t               key         = 0;
+    int16_t                prev        = -1;
+    int16_t                next        = -1;
+    int16_t                bucket_next = -1;
+    cce_cfi_position_table table;
+  };
+
+  void lru_unlink(int16_t idx);
+  void lru_push_front(int16_t idx);
+
+  srsran_regs_t*                   regs     = nullptr;
+  uint32_t                         nof_used = 0;
+  int16_t                          lru_head = -1, lru_tail = -1;
+  std::array<int16_t, NOF_BUCKETS> buckets;
+  std::array<entry, CACHE_SIZE>    entries;
+};
+
 /// structs to bundle together all the sched arguments, and share them with all the sched sub-components
 class sched_cell_params_t
 {
@@ -75,6 +109,8 @@ public:
   std::unique_ptr<srsran_regs_t, regs_deleter> regs;
   cce_sf_position_table                        common_locations = {};
   cce_frame_position_table                     rar_locations    = {};
+  /// UE-specific PDCCH candidates, only accessed by the scheduler of this cell
+  mutable cce_ue_location_cache                ue_locations;
   std::array<uint32_t, SRSRAN_NOF_CFI>         nof_cce_table    = {}; ///< map cfix -> nof cces in PDCCH
   uint32_t                                     P                = 0;
   uint32_t                                     nof_rbgs         = 0;
@@ -34,6 +34,10 @@ class sf_cch_allocator
 {
 public:
   const static uint32_t MAX_CFI = 3;
+  /// Maximum number of DFS nodes visited per DCI allocation before falling back to a greedy CCE assignment
+  const static uint32_t MAX_DFS_NODES = 128;
+  /// Number of DFS states that failed to fit the remaining DCIs remembered within a TTI
+  const static uint32_t MAX_FAILED_STATES = 32;
   struct tree_node {
     int8_t                pucch_n_prb = -1; ///< this PUCCH resource identifier
     uint16_t              rnti        = SRSRAN_INVALID_RNTI;
@@ -77,11 +81,26 @@ private:
     alloc_type_t alloc_type;
     sched_ue*    user;
   };
+  /// DFS state from which the DCIs [depth, nof_records) could not be allocated
+  struct failed_state {
+    uint32_t     cfix;
+    uint32_t     depth;
+    uint32_t     nof_records;
+    pdcch_mask_t total_mask;
+    prbmask_t    total_pucch_mask;
+  };
   const cce_cfi_position_table* get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user, uint32_t cfix) const;
 
   // PDCCH allocation algorithm
   bool alloc_dfs_node(const alloc_record& record, uint32_t start_child_idx);
+  bool fill_dfs_node(const alloc_record& record, const tree_node* parent, tree_node& node);
   bool get_next_dfs();
+  bool alloc_greedy(const alloc_record& record, uint32_t start_cfix);
+
+  // Memory of failed DFS states
+  bool is_failed_state(uint32_t depth, const tree_node& node) const;
+  void save_failed_state(uint32_t depth, const tree_node* parent);
+  void clear_failed_states(uint32_t nof_records);
 
   // consts
   const sched_cell_params_t* cc_cfg = nullptr;
@@ -94,6 +113,11 @@ private:
   uint32_t                  current_max_cfix = 0;
   std::vector<tree_node>    last_dci_dfs, temp_dci_dfs;
   std::vector<alloc_record> dci_record_list; ///< Keeps a record of all the PDCCH allocations done so far
+  std::vector<failed_state> failed_states;
+  uint32_t                  next_failed_state = 0;
+  uint32_t                  dfs_target        = 0; ///< Number of DCIs that the current DFS needs to fit
+  uint32_t                  dfs_nof_nodes     = 0;
+  std::vector<uint32_t>     greedy_order, greedy_pos;
 };
 
 // Helper methods
@@ -85,6 +85,10 @@ public:
   void                      ul_buffer_add(uint8_t lcid, uint32_t bytes);
   void                      metrics_read(mac_ue_metrics_t& metrics);
 
+  /// Counter incremented whenever the UE state that the scheduler metrics depend on may have changed
+  uint32_t get_state_version() const { return state_version; }
+  void     bump_state_version() { state_version++; }
+
   /*******************************************************
    * Functions used by scheduler metric objects
    *******************************************************/
@@ -215,7 +219,15 @@ private:
   uint16_t rnti            = 0;
   uint32_t max_msg3retx    = 0;
 
-  bool phy_config_dedicated_enabled = false;
+  bool     phy_config_dedicated_enabled = false;
+  uint32_t state_version                = 0;
+
+  /* DL HARQ feedback counters, reported and reset by metrics_read() */
+  struct {
+    int tx_pkts;
+    int tx_errors;
+    int tx_brate;
+  } tx_metrics = {};
 
   tti_point                  current_tti;
   std::vector<sched_ue_cell> cells; ///< List of eNB cells that may be configured/activated/deactivated for the UE
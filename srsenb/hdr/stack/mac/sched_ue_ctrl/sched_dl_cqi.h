@@ -36,14 +36,18 @@ namespace srsenb {
  * - The cell bandwidth is divided into J parts. J = f(nof_cell_prbs)
  * - UE reports wideband CQI every H.Np msec, where Np is the CQI period and H=JK + 1, where K is configured in RRC
  * - Thus, for K==0, only wideband CQI is active
+ * - If max_sb_age_ms > 0, a subband CQI is kept as a difference to the wideband CQI at the time of the report. The
+ *   difference fades linearly with the age of the report, so that an old subband report converges to the latest
+ *   wideband CQI and no longer steers the RBG selection after max_sb_age_ms
  */
 class sched_dl_cqi
 {
 public:
-  sched_dl_cqi(uint32_t cell_nof_prb_, uint32_t K_, uint32_t init_dl_cqi) :
+  sched_dl_cqi(uint32_t cell_nof_prb_, uint32_t K_, uint32_t init_dl_cqi, uint32_t max_sb_age_ms_ = 0) :
     cell_nof_prb(cell_nof_prb_),
     cell_nof_rbg(cell_nof_prb_to_rbg(cell_nof_prb_)),
     K(K_),
+    max_sb_age_ms(max_sb_age_ms_),
     wb_cqi_avg(init_dl_cqi),
     bp_list(nof_bandwidth_parts(cell_nof_prb_), bandwidth_part_context(init_dl_cqi)),
     subband_cqi(std::max(1, srsran_cqi_hl_get_no_subbands(cell_nof_prb)), 0)
@@ -60,6 +64,9 @@ public:
     K = K_;
   }
 
+  /// Update the current TTI, used to age the subband CQI reports
+  void new_tti(tti_point tti) { current_tti = tti; }
+
   /// Update wideband CQI
   void cqi_wb_info(tti_point tti, uint32_t cqi_value)
   {
@@ -82,6 +89,7 @@ public:
     bp_list[bp_idx].last_feedback_tti    = tti;
     bp_list[bp_idx].last_cqi_subband_idx = sb_index;
     bp_list[bp_idx].cqi_val              = static_cast<float>(cqi_value);
+    bp_list[bp_idx].wb_cqi_val           = wb_cqi_avg;
 
     // just cap all sub-bands in the same bandwidth part
     srsran::interval<uint32_t> interv = get_bp_sb_indexes(bp_idx);
@@ -180,7 +188,7 @@ public:
     if (not subband_cqi_enabled()) {
       return get_wb_cqi_info();
     }
-    return bp_list[get_bp_index(subband_index)].last_feedback_tti.is_valid() ? subband_cqi[subband_index] : wb_cqi_avg;
+    return static_cast<int>(get_subband_cqi_(subband_index));
   }
 
 private:
@@ -217,24 +225,41 @@ private:
 
   float get_subband_cqi_(uint32_t sb_idx) const
   {
-    return bp_list[get_bp_index(sb_idx)].last_feedback_tti.is_valid() ? subband_cqi[sb_idx] : wb_cqi_avg;
+    const bandwidth_part_context& bp = bp_list[get_bp_index(sb_idx)];
+    if (not bp.last_feedback_tti.is_valid()) {
+      return wb_cqi_avg;
+    }
+    if (max_sb_age_ms == 0) {
+      return subband_cqi[sb_idx];
+    }
+    int age = current_tti.is_valid() ? std::max(current_tti - bp.last_feedback_tti, 0) : 0;
+    if (age >= (int)max_sb_age_ms) {
+      return wb_cqi_avg;
+    }
+    float weight = 1.0f - static_cast<float>(age) / max_sb_age_ms;
+    float cqi    = wb_cqi_avg + (subband_cqi[sb_idx] - bp.wb_cqi_val) * weight;
+    return std::min(std::max(cqi, 0.0f), 15.0f);
   }
 
   uint32_t cell_nof_prb;
   uint32_t cell_nof_rbg;
   uint32_t K; ///< set in RRC
+  uint32_t max_sb_age_ms;
 
   /// context of bandwidth part
   struct bandwidth_part_context {
     tti_point last_feedback_tti{};
     uint32_t  last_cqi_subband_idx;
     float     cqi_val;
+    float     wb_cqi_val; ///< wideband CQI when the subband CQI was reported
 
-    explicit bandwidth_part_context(uint32_t init_dl_cqi) : cqi_val(init_dl_cqi), last_cqi_subband_idx(max_nof_subbands)
+    explicit bandwidth_part_context(uint32_t init_dl_cqi) :
+      cqi_val(init_dl_cqi), wb_cqi_val(init_dl_cqi), last_cqi_subband_idx(max_nof_subbands)
     {}
   };
 
   tti_point last_pos_cqi_tti;
+  tti_point current_tti;
 
   tti_point last_wb_tti;
   float     wb_cqi_avg;
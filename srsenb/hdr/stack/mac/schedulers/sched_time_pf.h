@@ -25,7 +25,7 @@
 #include "sched_base.h"
 #include "srsenb/hdr/common/common_enb.h"
 #include "srsran/adt/circular_map.h"
-#include <queue>
+#include <vector>
 
 namespace srsenb {
 
@@ -39,57 +39,93 @@ public:
   void sched_ul_users(sched_ue_list& ue_db, sf_sched* tti_sched) override;
 
 private:
-  void new_tti(sched_ue_list& ue_db, sf_sched* tti_sched);
+  enum direction { DL = 0, UL = 1 };
 
-  const sched_cell_params_t* cc_cfg         = nullptr;
-  float                      fairness_coeff = 1;
+  /// Average rate of a UE, with one sample per TTI. The TTIs without allocation are applied lazily, as they scale the
+  /// averages of all the UEs by the same factor (after the fast start) and, hence, do not change their PF order
+  class rate_average
+  {
+  public:
+    float    value(uint64_t tti_count);
+    uint32_t count() const { return nof_samples; }
+    void     add_sample(uint64_t tti_count, uint32_t alloc_bytes);
 
-  srsran::tti_point current_tti_rx;
+  private:
+    void advance(uint64_t tti_count);
+
+    float    avg_rate    = 0;
+    uint32_t nof_samples = 0;
+    uint64_t last_tti    = 0;
+  };
 
   struct ue_ctxt {
     ue_ctxt(uint16_t rnti_, float fairness_coeff_) : rnti(rnti_), fairness_coeff(fairness_coeff_) {}
-    float    dl_avg_rate() const { return dl_nof_samples == 0 ? 0 : dl_avg_rate_; }
-    float    ul_avg_rate() const { return ul_nof_samples == 0 ? 0 : ul_avg_rate_; }
-    uint32_t dl_count() const { return dl_nof_samples; }
-    uint32_t ul_count() const { return ul_nof_samples; }
-    void     new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched);
-    void     save_dl_alloc(uint32_t alloc_bytes, float alpha);
-    void     save_ul_alloc(uint32_t alloc_bytes, float alpha);
+    void refresh(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched, uint64_t tti_count);
+    void save_alloc(direction dir, uint32_t alloc_bytes, uint64_t tti_count);
 
     const uint16_t rnti;
     const float    fairness_coeff;
 
-    int                 ue_cc_idx  = 0;
-    float               dl_prio    = 0;
-    float               ul_prio    = 0;
-    const dl_harq_proc* dl_retx_h  = nullptr;
-    const dl_harq_proc* dl_newtx_h = nullptr;
-    const ul_harq_proc* ul_h       = nullptr;
+    int          ue_cc_idx       = -1;
+    uint32_t     state_version   = 0;
+    uint64_t     last_alloc_tti  = 0;
+    bool         has_data[2]     = {};
+    float        exp_rate[2]     = {}; ///< Expected rate in bytes per TTI with all the cell resources
+    double       prio_key[2]     = {}; ///< PF priority in a log domain that does not drift with the TTIs
+    int          heap_pos[2]     = {-1, -1};
+    rate_average avg_rate[2];
+
+    // Candidates of the current TTI
+    const dl_harq_proc* dl_retx_h = nullptr;
+    const ul_harq_proc* ul_h      = nullptr;
 
   private:
-    float    dl_avg_rate_   = 0;
-    float    ul_avg_rate_   = 0;
-    uint32_t dl_nof_samples = 0;
-    uint32_t ul_nof_samples = 0;
+    void update_prio(direction dir, uint64_t tti_count);
   };
 
-  rnti_map_t<ue_ctxt> ue_history_db;
+  /// Binary max-heap over the PF priority keys, where each UE knows its position so that it can be re-keyed or removed
+  /// in O(log N) when its metrics change
+  class ue_heap
+  {
+  public:
+    explicit ue_heap(direction dir_) : dir(dir_) { heap.reserve(SRSENB_MAX_UES); }
+    void     update(ue_ctxt* u);
+    void     erase(ue_ctxt* u);
+    size_t   size() const { return heap.size(); }
+    ue_ctxt* operator[](size_t pos) const { return heap[pos]; }
+    bool     higher(size_t lhs, size_t rhs) const { return heap[lhs]->prio_key[dir] > heap[rhs]->prio_key[dir]; }
 
-  struct ue_dl_prio_compare {
-    bool operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const;
-  };
-  struct ue_ul_prio_compare {
-    bool operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const;
+  private:
+    void swap_pos(size_t lhs, size_t rhs);
+    void sift_up(size_t pos);
+    void sift_down(size_t pos);
+
+    const direction       dir;
+    std::vector<ue_ctxt*> heap;
   };
 
-  using ue_dl_queue_t = std::priority_queue<ue_ctxt*, std::vector<ue_ctxt*>, ue_dl_prio_compare>;
-  using ue_ul_queue_t = std::priority_queue<ue_ctxt*, std::vector<ue_ctxt*>, ue_ul_prio_compare>;
+  void new_tti(sched_ue_list& ue_db, sf_sched* tti_sched);
+  void update_heaps(ue_ctxt& ue);
+  template <typename Func>
+  void for_each_by_prio(direction dir, Func&& f);
+
+  const sched_cell_params_t* cc_cfg         = nullptr;
+  float                      fairness_coeff = 1;
+
+  srsran::tti_point current_tti_rx;
+  uint64_t          tti_count = 0;
+
+  rnti_map_t<ue_ctxt> ue_history_db;
 
-  ue_dl_queue_t dl_queue;
-  ue_ul_queue_t ul_queue;
+  ue_heap               dl_heap{DL};
+  ue_heap               ul_heap{UL};
+  std::vector<ue_ctxt*> dl_retx_list;
+  std::vector<ue_ctxt*> ul_retx_list;
+  std::vector<size_t>   heap_frontier;
+  std::vector<ue_ctxt*> allocated_ues;
 
-  uint32_t try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched);
-  uint32_t try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched);
+  uint32_t try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, const dl_harq_proc* h, sf_sched* tti_sched);
+  uint32_t try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, const ul_harq_proc* h, sf_sched* tti_sched);
 };
 
 } // namespace srsenb
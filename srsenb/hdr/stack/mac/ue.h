@@ -30,6 +30,7 @@
 #include "srsran/common/block_queue.h"
 #include "srsran/common/mac_pcap.h"
 #include "srsran/common/mac_pcap_net.h"
+#include "srsran/common/multiqueue.h"
 #include "srsran/common/tti_point.h"
 #include "srsran/mac/pdu.h"
 #include "srsran/mac/pdu_queue.h"
@@ -57,8 +58,8 @@ struct ue_cc_softbuffers {
   cc_softbuffer_tx_list_t softbuffer_tx_list;
   cc_softbuffer_rx_list_t softbuffer_rx_list;
 
-  ue_cc_softbuffers(uint32_t nof_prb, uint32_t nof_tx_harq_proc_, uint32_t nof_rx_harq_proc_);
-  ue_cc_softbuffers(ue_cc_softbuffers&&) noexcept = default;
+  /// With on_demand, the code blocks are only allocated for the transport blocks actually scheduled, see reserve_tx()
+  ue_cc_softbuffers(uint32_t nof_prb, uint32_t nof_tx_harq_proc_, uint32_t nof_rx_harq_proc_, bool on_demand = false);
   ~ue_cc_softbuffers();
   void clear();
 
@@ -67,6 +68,17 @@ struct ue_cc_softbuffers {
     return softbuffer_tx_list.at(pid * SRSRAN_MAX_TB + tb_idx);
   }
   srsran_softbuffer_rx_t& get_rx(uint32_t tti) { return softbuffer_rx_list.at(tti % nof_rx_harq_proc); }
+
+  /// Makes sure the code blocks of a transport block of tbs bytes are allocated in the soft-buffer
+  bool reserve_tx(uint32_t pid, uint32_t tb_idx, uint32_t tbs);
+  bool reserve_rx(uint32_t tti, uint32_t tbs);
+
+  /// Memory allocated by the soft-buffers, in bytes
+  uint64_t get_mem_bytes() const { return mem_bytes.load(std::memory_order_relaxed); }
+
+private:
+  // Updated by the PHY workers that reserve code blocks, read by the metrics
+  std::atomic<uint64_t> mem_bytes{0};
 };
 
 /// Class to manage the allocation, deallocation & access to pending UL HARQ buffers
@@ -111,6 +123,12 @@ public:
     return cc_softbuffers->get_tx(pid, tb_idx);
   }
   srsran_softbuffer_rx_t& get_rx_softbuffer(uint32_t tti) { return cc_softbuffers->get_rx(tti); }
+  bool                    reserve_tx_softbuffer(uint32_t pid, uint32_t tb_idx, uint32_t tbs)
+  {
+    return cc_softbuffers->reserve_tx(pid, tb_idx, tbs);
+  }
+  bool     reserve_rx_softbuffer(uint32_t tti, uint32_t tbs) { return cc_softbuffers->reserve_rx(tti, tbs); }
+  uint64_t get_softbuffer_mem_bytes() const { return empty() ? 0 : cc_softbuffers->get_mem_bytes(); }
   srsran::byte_buffer_t*  get_tx_payload_buffer(size_t harq_pid, size_t tb)
   {
     return tx_payload_buffer[harq_pid][tb].get();
@@ -139,7 +157,8 @@ public:
      phy_interface_stack_lte*                 phy_,
      srslog::basic_logger&                    logger,
      uint32_t                                 nof_cells_,
-     srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool);
+     srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool,
+     srsran::task_queue_handle*               stack_task_queue_ = nullptr);
 
   virtual ~ue();
   void reset();
@@ -168,23 +187,23 @@ public:
                             uint32_t                             nof_pdu_elems,
                             uint32_t                             grant_size);
 
-  srsran_softbuffer_tx_t* get_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq_process, uint32_t tb_idx);
-  srsran_softbuffer_rx_t* get_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti);
+  /// Return the soft-buffers for a transport block of tbs bytes, nullptr if they can not be provided
+  srsran_softbuffer_tx_t* get_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq_process, uint32_t tb_idx, uint32_t tbs);
+  srsran_softbuffer_rx_t* get_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti, uint32_t tbs);
 
   uint8_t* request_buffer(uint32_t tti, uint32_t enb_cc_idx, uint32_t len);
   void     process_pdu(srsran::unique_byte_buffer_t pdu, uint32_t ue_cc_idx, uint32_t grant_nof_prbs);
   srsran::unique_byte_buffer_t release_pdu(uint32_t tti, uint32_t enb_cc_idx);
   void                         clear_old_buffers(uint32_t tti);
 
-  std::mutex metrics_mutex = {};
-  void       metrics_read(mac_ue_metrics_t* metrics_);
-  void       metrics_rx(bool crc, uint32_t tbs);
-  void       metrics_tx(bool crc, uint32_t tbs);
-  void       metrics_phr(float phr);
-  void       metrics_dl_ri(uint32_t dl_cqi);
-  void       metrics_dl_pmi(uint32_t dl_cqi);
-  void       metrics_dl_cqi(uint32_t dl_cqi);
-  void       metrics_cnt();
+  void metrics_read(mac_ue_metrics_t* metrics_);
+  void metrics_rx(bool crc, uint32_t tbs);
+  void metrics_tx(bool crc, uint32_t tbs);
+  void metrics_phr(float phr);
+  void metrics_dl_ri(uint32_t dl_cqi);
+  void metrics_dl_pmi(uint32_t dl_cqi);
+  void metrics_dl_cqi(uint32_t dl_cqi);
+  void metrics_cnt();
 
   uint32_t read_pdu(uint32_t lcid, uint8_t* payload, uint32_t requested_bytes) final;
 
@@ -192,6 +211,7 @@ private:
   void allocate_sdu(srsran::sch_pdu* pdu, uint32_t lcid, uint32_t sdu_len);
   bool process_ce(srsran::sch_subh* subh, uint32_t grant_nof_prbs);
   void allocate_ce(srsran::sch_pdu* pdu, uint32_t lcid);
+  void take_metrics_snapshot(mac_ue_metrics_t& metrics_);
 
   rlc_interface_mac*       rlc = nullptr;
   rrc_interface_mac*       rrc = nullptr;
@@ -208,14 +228,32 @@ private:
 
   std::atomic<bool> active_state{true};
 
-  uint32_t         phr_counter    = 0;
-  uint32_t         dl_cqi_counter = 0;
-  uint32_t         dl_ri_counter  = 0;
-  uint32_t         dl_pmi_counter = 0;
-  mac_ue_metrics_t ue_metrics     = {};
+  /// Metrics updated concurrently by the PHY workers and the stack thread. The hot path only does relaxed atomic
+  /// updates and metrics_read() takes the snapshot by swapping every counter out, so neither side ever blocks.
+  /// Averages are kept as sum and count, and resolved when read.
+  struct metrics_counters {
+    std::atomic<uint32_t> nof_tti{0};
+    std::atomic<int>      tx_pkts{0};
+    std::atomic<int>      tx_errors{0};
+    std::atomic<int>      tx_brate{0};
+    std::atomic<int>      rx_pkts{0};
+    std::atomic<int>      rx_errors{0};
+    std::atomic<int>      rx_brate{0};
+    std::atomic<float>    phr_sum{0};
+    std::atomic<uint32_t> phr_count{0};
+    std::atomic<float>    dl_cqi_sum{0};
+    std::atomic<uint32_t> dl_cqi_count{0};
+    std::atomic<float>    dl_pmi_sum{0};
+    std::atomic<uint32_t> dl_pmi_count{0};
+    std::atomic<float>    dl_ri{0};
+  };
+  metrics_counters ue_metrics;
 
   srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool = nullptr;
 
+  // Set when the UL PDUs are processed outside the stack thread, to defer the RRC calls that are not thread-safe
+  srsran::task_queue_handle* stack_task_queue = nullptr;
+
   srsran::block_queue<uint32_t> pending_ta_commands;
   ta                            ta_fsm;
 
@@ -27,6 +27,7 @@
 #include "srsenb/hdr/stack/mac/sched_interface.h"
 #include "srsran/interfaces/rrc_interface_types.h"
 #include <bitset>
+#include <memory>
 
 namespace srsenb {
 
@@ -76,8 +77,9 @@ public:
   void update_mac();
 
 private:
-  int  apply_basic_conn_cfg(const asn1::rrc::rr_cfg_ded_s& rr_cfg);
-  void apply_current_bearers_cfg();
+  int       apply_basic_conn_cfg(const asn1::rrc::rr_cfg_ded_s& rr_cfg);
+  void      apply_current_bearers_cfg();
+  ue_cfg_t& start_next_sched_ue_cfg();
 
   srslog::basic_logger&       logger;
   uint16_t                    rnti;
@@ -89,9 +91,10 @@ private:
 
   /// UE configuration currently present at the MAC, including any transient disabling of bearers/scells
   ue_cfg_t current_sched_ue_cfg = {};
-  /// UE configuration once the RRC config procedure (e.g. Reconfiguration) is complete
-  ue_cfg_t next_sched_ue_cfg = {};
-  bool     crnti_set         = false;
+  /// UE configuration once the RRC config procedure (e.g. Reconfiguration) is complete. Only allocated while the
+  /// procedure is ongoing, as most connected UEs have no reconfiguration in flight
+  std::unique_ptr<ue_cfg_t> next_sched_ue_cfg;
+  bool                      crnti_set = false;
 };
 
 } // namespace srsenb
@@ -25,6 +25,8 @@
 #include "rrc_bearer_cfg.h"
 #include "rrc_cell_cfg.h"
 #include "rrc_metrics.h"
+#include "ue_cap_cache.h"
+#include "ue_rr_cfg.h"
 #include "srsenb/hdr/common/common_enb.h"
 #include "srsenb/hdr/common/rnti_pool.h"
 #include "srsran/adt/circular_buffer.h"
@@ -184,11 +186,13 @@ private:
 
   // derived params
   std::unique_ptr<enb_cell_common_list> cell_common_list;
+  rrc_conn_setup_template               conn_setup_tmpl;
 
   // state
   std::unique_ptr<freq_res_common_list>    cell_res_list;
-  std::map<uint16_t, unique_rnti_ptr<ue> > users; // NOTE: has to have fixed addr
+  rnti_map_t<unique_rnti_ptr<ue> >         users; // NOTE: has to have fixed addr
   std::unique_ptr<paging_manager>          pending_paging;
+  ue_cap_cache                             cap_cache;
 
   void     process_release_complete(uint16_t rnti);
   void     rem_user(uint16_t rnti);
@@ -44,6 +44,7 @@ typedef enum {
 struct rrc_ue_metrics_t {
   rrc_state_t                                 state;
   std::vector<std::pair<uint32_t, uint32_t> > drb_qci_map;
+  uint64_t                                    mem_bytes; ///< Size of the UE context, with its ASN.1 configuration
 };
 
 struct rrc_metrics_t {
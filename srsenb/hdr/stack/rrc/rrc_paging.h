@@ -78,6 +78,7 @@ private:
     tti_point                    tti_tx_dl;
     asn1::rrc::pcch_msg_s        pcch_msg;
     srsran::unique_byte_buffer_t pdu;
+    uint32_t                     nof_bits = 0; ///< length of the encoded PCCH message without the padding bits
 
     bool is_tx() const { return tti_tx_dl.is_valid(); }
     bool empty() const { return pdu == nullptr; }
@@ -86,11 +87,13 @@ private:
       tti_tx_dl = tti_point();
       pcch_msg.msg.c1().paging().paging_record_list.clear();
       pdu.reset();
+      nof_bits = 0;
     }
   };
   const static size_t nof_paging_subframes = 4;
 
   bool add_paging_record(uint32_t ueid, const asn1::rrc::paging_record_s& paging_record);
+  bool pack_paging_record(pcch_info& pcch);
 
   static int get_sf_idx_key(uint32_t sf_idx)
   {
@@ -188,13 +191,40 @@ bool paging_manager::add_paging_record(uint32_t ueid, const asn1::rrc::paging_re
 
   record_list.push_back(paging_record);
 
-  asn1::bit_ref bref(pending_pcch.pdu->msg, pending_pcch.pdu->get_tailroom());
-  if (pending_pcch.pcch_msg.pack(bref) == asn1::SRSASN_ERROR_ENCODE_FAIL) {
+  if (not pack_paging_record(pending_pcch)) {
     logger.error("Failed to pack PCCH message");
     pending_pcch.clear();
     return false;
   }
-  pending_pcch.pdu->N_bytes = (uint32_t)bref.distance_bytes();
+
+  return true;
+}
+
+/// Encodes the last paging record of the PCCH message, without re-encoding the records that were already packed
+bool paging_manager::pack_paging_record(pcch_info& pcch)
+{
+  auto&         record_list = pcch.pcch_msg.msg.c1().paging().paging_record_list;
+  asn1::bit_ref bref(pcch.pdu->msg, pcch.pdu->get_tailroom());
+
+  if (record_list.size() == 1) {
+    if (pcch.pcch_msg.msg.pack(bref) != asn1::SRSASN_SUCCESS) {
+      return false;
+    }
+  } else {
+    // The records are appended at the end of the previous encoding, overwriting its padding bits
+    if (bref.advance_bits(pcch.nof_bits) != asn1::SRSASN_SUCCESS or
+        record_list.back().pack(bref) != asn1::SRSASN_SUCCESS) {
+      return false;
+    }
+    // The size of the record list (4 bits, coded as size - 1) follows the PCCH-MessageType choice (1 bit) and the
+    // presence bitmap of the Paging message (4 bits)
+    uint8_t size_field = static_cast<uint8_t>(record_list.size() - 1);
+    pcch.pdu->msg[0]   = (pcch.pdu->msg[0] & 0xf8u) | (size_field >> 1u);
+    pcch.pdu->msg[1]   = (pcch.pdu->msg[1] & 0x7fu) | ((size_field & 0x1u) << 7u);
+  }
+  pcch.nof_bits = (uint32_t)bref.distance();
+  bref.align_bytes_zero();
+  pcch.pdu->N_bytes = (uint32_t)bref.distance_bytes();
 
   return true;
 }
@@ -150,9 +150,11 @@ public:
 
   /**
    * Sends the CCCH message to the underlying layer and optionally encodes it as an octet string if a valid string
-   * pointer is passed.
+   * pointer is passed. If a PDU is passed, it already holds the packed message.
    */
-  void send_dl_ccch(asn1::rrc::dl_ccch_msg_s* dl_ccch_msg, std::string* octet_str = nullptr);
+  void send_dl_ccch(asn1::rrc::dl_ccch_msg_s*    dl_ccch_msg,
+                    std::string*                 octet_str = nullptr,
+                    srsran::unique_byte_buffer_t pdu       = srsran::unique_byte_buffer_t());
 
   /**
    * Sends the DCCH message to the underlying layer and optionally encodes it as an octet string if a valid string
@@ -201,8 +203,7 @@ private:
   bool                                         rlf_info_pending     = false;
 
   asn1::s1ap::ue_aggregate_maximum_bitrate_s bitrates;
-  bool                                       eutra_capabilities_unpacked = false;
-  asn1::rrc::ue_eutra_cap_s                  eutra_capabilities;
+  std::shared_ptr<const ue_eutra_cap_t>      eutra_capabilities; ///< nullptr until the UE capabilities are known
   srsran::rrc_ue_capabilities_t              ue_capabilities;
 
   const static uint32_t UE_PCELL_CC_IDX = 0;
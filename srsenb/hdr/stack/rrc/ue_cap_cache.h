@@ -0,0 +1,74 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSENB_UE_CAP_CACHE_H
+#define SRSENB_UE_CAP_CACHE_H
+
+#include "srsran/adt/span.h"
+#include "srsran/asn1/rrc.h"
+#include "srsran/interfaces/rrc_interface_types.h"
+#include <memory>
+#include <vector>
+
+namespace srsenb {
+
+/// UE-EUTRA-Capability container, as received from the UE, and its decoded content
+struct ue_eutra_cap_t {
+  std::vector<uint8_t>          blob;
+  asn1::rrc::ue_eutra_cap_s     caps;
+  srsran::rrc_ue_capabilities_t summary;
+};
+
+/**
+ * Bounded cache of decoded UE-EUTRA-Capability containers, keyed by the hash of the container bytes.
+ * UEs of the same model send byte-identical containers, so they share the same decoded capabilities instead of each
+ * unpacking them. The entries are immutable and shared with the UEs, so evicting one does not affect the UEs using it.
+ */
+class ue_cap_cache
+{
+public:
+  explicit ue_cap_cache(uint32_t max_size_ = 64) : max_size(max_size_) {}
+
+  /// Returns the decoded capabilities of the container, unpacking it on a miss. Returns nullptr if unpacking fails
+  std::shared_ptr<const ue_eutra_cap_t> get(srsran::const_byte_span blob);
+
+  size_t   size() const { return entries.size(); }
+  uint32_t nof_hits() const { return hits; }
+
+private:
+  struct entry_t {
+    uint64_t                              hash;
+    uint64_t                              last_used;
+    std::shared_ptr<const ue_eutra_cap_t> cap;
+  };
+
+  static uint64_t hash_blob(srsran::const_byte_span blob);
+
+  uint32_t             max_size;
+  uint64_t             clock = 0;
+  uint32_t             hits  = 0;
+  std::vector<entry_t> entries;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_UE_CAP_CACHE_H
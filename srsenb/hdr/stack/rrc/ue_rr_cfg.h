@@ -44,7 +44,10 @@
 #define SRSENB_UE_RR_CFG_H
 
 #include "srsran/asn1/rrc.h"
+#include "srsran/common/byte_buffer.h"
 #include "srsran/interfaces/rrc_interface_types.h"
+#include <array>
+#include <vector>
 
 namespace srsenb {
 
@@ -75,6 +78,45 @@ void apply_rr_cfg_ded_diff(asn1::rrc::rr_cfg_ded_s&       current_rr_cfg_ded,
 void apply_scells_to_add_diff(asn1::rrc::scell_to_add_mod_list_r10_l&   current_scells,
                               const asn1::rrc::rrc_conn_recfg_r8_ies_s& recfg_r8);
 
+/**
+ * RRCConnectionSetup DL-CCCH message packed once from the eNB config. Only the transaction id and the SR/CQI PUCCH
+ * resources vary between UEs, and they are encoded as fixed-width fields, so each UE gets a copy of the packed bytes
+ * with those fields overwritten, rather than a new pack of the whole message
+ */
+class rrc_conn_setup_template
+{
+public:
+  /// Packs the message and finds the bit positions of the UE-specific fields. Returns false if that isn't possible
+  bool init(const rrc_cfg_t& enb_cfg);
+  bool is_valid() const { return not msg.empty(); }
+
+  /// Fill RadioResourceConfigDedicated with the same content as fill_rr_cfg_ded_setup, from a copy of the template
+  int fill_rr_cfg_ded(asn1::rrc::rr_cfg_ded_s& rr_cfg,
+                      const rrc_cfg_t&         enb_cfg,
+                      const ue_cell_ded_list&  ue_cell_list) const;
+
+  /// Writes the packed message with the transaction id and with the SR/CQI resources set in rr_cfg
+  int pack(uint8_t transaction_id, const asn1::rrc::rr_cfg_ded_s& rr_cfg, srsran::byte_buffer_t& pdu) const;
+
+private:
+  enum field_id { transaction_id, sr_pucch_res_idx, sr_cfg_idx, cqi_pucch_res_idx, cqi_pmi_cfg_idx, nof_fields };
+  struct field_pos_t {
+    uint32_t bit_pos = 0;
+    uint32_t n_bits  = 0;
+  };
+  using field_values_t = std::array<uint32_t, nof_fields>;
+
+  static int  pack_msg(asn1::rrc::dl_ccch_msg_s& dl_ccch_msg, const field_values_t& values, std::vector<uint8_t>& out);
+  static void set_values(asn1::rrc::dl_ccch_msg_s& dl_ccch_msg, const field_values_t& values);
+  static field_values_t get_values(uint8_t transaction_id, const asn1::rrc::rr_cfg_ded_s& rr_cfg);
+  void                  patch(uint8_t* buf, const field_values_t& values) const;
+
+  asn1::rrc::rr_cfg_ded_s             rr_cfg_tmpl;
+  std::vector<uint8_t>                msg;
+  std::array<field_pos_t, nof_fields> fields;
+  bool                                cqi_periodic = false;
+};
+
 } // namespace srsenb
 
 #endif // SRSENB_UE_RR_CFG_H
@@ -137,13 +137,14 @@ private:
   srsran::task_queue_handle   mme_task_queue;
   srsran::socket_manager_itf* rx_socket_handler;
 
-  srsran::unique_socket mme_socket;
-  struct sockaddr_in    mme_addr            = {}; // MME address
-  bool                  mme_connected       = false;
-  bool                  running             = false;
-  uint32_t              next_enb_ue_s1ap_id = 1; // Next ENB-side UE identifier
-  uint16_t              next_ue_stream_id   = 1; // Next UE SCTP stream identifier
-  srsran::unique_timer  mme_connect_timer, s1setup_timeout;
+  srsran::unique_socket  mme_socket;
+  srsran::sctp_tx_worker mme_tx;                   // Sends the S1AP PDUs batched during each stack task
+  struct sockaddr_in     mme_addr            = {}; // MME address
+  bool                   mme_connected       = false;
+  bool                   running             = false;
+  uint32_t               next_enb_ue_s1ap_id = 1; // Next ENB-side UE identifier
+  uint16_t               nof_mme_streams     = 2; // Outbound SCTP streams, updated once the association is up
+  srsran::unique_timer   mme_connect_timer, s1setup_timeout;
 
   // Protocol IEs sent with every UL S1AP message
   asn1::s1ap::tai_s        tai;
@@ -152,6 +153,9 @@ private:
   // PCAP
   srsran::s1ap_pcap* pcap = nullptr;
 
+  // Storage of the received PDUs while they are handled
+  asn1::decode_arena rx_arena;
+
   asn1::s1ap::s1_setup_resp_s s1setupresponse;
 
   void build_tai_cgi();
@@ -160,6 +164,7 @@ private:
   bool sctp_send_s1ap_pdu(const asn1::s1ap::s1ap_pdu_c& tx_pdu, uint32_t rnti, const char* procedure_name);
 
   bool handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu);
+  bool handle_s1ap_rx_pdu_fast(srsran::byte_buffer_t* pdu);
   bool handle_initiatingmessage(const asn1::s1ap::init_msg_s& msg);
   bool handle_successfuloutcome(const asn1::s1ap::successful_outcome_s& msg);
   bool handle_unsuccessfuloutcome(const asn1::s1ap::unsuccessful_outcome_s& msg);
@@ -168,6 +173,7 @@ private:
   bool handle_s1setupresponse(const asn1::s1ap::s1_setup_resp_s& msg);
 
   bool handle_dlnastransport(const asn1::s1ap::dl_nas_transport_s& msg);
+  bool handle_dlnastransport(uint32_t enb_ue_s1ap_id, uint32_t mme_ue_s1ap_id, srsran::const_span<uint8_t> nas_pdu);
   bool handle_initialctxtsetuprequest(const asn1::s1ap::init_context_setup_request_s& msg);
   bool handle_uectxtreleasecommand(const asn1::s1ap::ue_context_release_cmd_s& msg);
   bool handle_s1setupfailure(const asn1::s1ap::s1_setup_fail_s& msg);
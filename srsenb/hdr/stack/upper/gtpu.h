@@ -20,10 +20,10 @@
  */
 
 #include <map>
-#include <unordered_map>
 #include <string.h>
 
 #include "srsenb/hdr/common/common_enb.h"
+#include "srsenb/hdr/stack/upper/gtpu_metrics.h"
 #include "srsran/adt/bounded_vector.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/common/buffer_pool.h"
@@ -33,20 +33,24 @@
 #include "srsran/interfaces/enb_gtpu_interfaces.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/srslog/srslog.h"
+#include "srsran/upper/gtpu.h"
 
+#include <array>
 #include <netinet/in.h>
 
 #ifndef SRSENB_GTPU_H
 #define SRSENB_GTPU_H
 
-namespace srsran {
-struct gtpu_header_t;
-}
-
 namespace srsenb {
 
 class pdcp_interface_gtpu;
 
+/// Smallest power of two that is not lower than n
+constexpr size_t round_up_pow2(size_t n, size_t pow2 = 1)
+{
+  return pow2 >= n ? pow2 : round_up_pow2(n, pow2 * 2);
+}
+
 class gtpu_tunnel_manager
 {
   // Buffer used to store SDUs while PDCP is still getting configured during handover.
@@ -59,9 +63,12 @@ class gtpu_tunnel_manager
 public:
   // A UE should have <= 3 DRBs active, and each DRB should have two tunnels active at the same time at most
   const static size_t MAX_TUNNELS_PER_UE = 10;
+  const static int    GTPU_PORT          = 2152;
 
   enum class tunnel_state { pdcp_active, buffering, forward_to, forwarded_from, inactive };
 
+  // Fields read for every Tx/Rx PDU. The handover-only state lives in tunnel_ho_ctxt, so that it does not dilute the
+  // cache lines touched by the datapath
   struct tunnel {
     uint16_t rnti          = SRSRAN_INVALID_RNTI;
     uint32_t eps_bearer_id = srsran::INVALID_EPS_BEARER_ID;
@@ -69,21 +76,23 @@ public:
     uint32_t teid_out      = 0;
     uint32_t spgw_addr     = 0;
 
-    tunnel_state                                    state = tunnel_state::pdcp_active;
-    srsran::unique_timer                            rx_timer;
-    srsran::byte_buffer_pool_ptr<buffered_sdu_list> buffer;
-    tunnel*                                         fwd_tunnel = nullptr; ///< forward Rx SDUs to this TEID
-    srsran::move_callback<void()>                   on_removal;
+    // G-PDU header and destination of the Tx PDUs, computed once when the tunnel is added
+    std::array<uint8_t, GTPU_BASE_HEADER_LEN> tx_header = {};
+    sockaddr_in                               tx_addr   = {};
 
-    tunnel()                  = default;
-    tunnel(tunnel&&) noexcept = default;
-    tunnel& operator=(tunnel&&) noexcept = default;
-    ~tunnel()
-    {
-      if (not on_removal.is_empty()) {
-        on_removal();
-      }
-    }
+    tunnel_state state      = tunnel_state::pdcp_active;
+    tunnel*      fwd_tunnel = nullptr; ///< forward Rx SDUs to this TEID
+  };
+
+  // Traffic counters of a tunnel. They are only updated and read from the stack thread, hence plain integers
+  struct tunnel_counters {
+    uint64_t dl_bytes      = 0;
+    uint64_t dl_pkts       = 0;
+    uint64_t ul_bytes      = 0;
+    uint64_t ul_pkts       = 0;
+    uint64_t dropped_pkts  = 0;
+    uint64_t fwd_pkts      = 0;
+    uint64_t buffered_pkts = 0;
   };
 
   struct bearer_teid_pair {
@@ -106,6 +115,7 @@ public:
 
   bool                           has_teid(uint32_t teid) const { return tunnels.contains(teid); }
   const tunnel*                  find_tunnel(uint32_t teid);
+  tunnel_counters&               get_counters(uint32_t teid) { return counters[teid % MAX_TUNNELS]; }
   ue_bearer_tunnel_list*         find_rnti_tunnels(uint16_t rnti);
   srsran::span<bearer_teid_pair> find_rnti_bearer_tunnels(uint16_t rnti, uint32_t eps_bearer_id);
 
@@ -123,17 +133,34 @@ public:
   bool remove_tunnel(uint32_t teid);
   bool remove_rnti(uint16_t rnti);
 
+  void get_metrics(gtpu_metrics_t& m);
+
 private:
-  using tunnel_list_t  = srsran::static_id_obj_pool<uint32_t, tunnel, SRSENB_MAX_UES * MAX_TUNNELS_PER_UE>;
+  // Rounded up to a power of two, so that the pool slot of a TEID is given by its low bits. The remaining bits of the
+  // TEID, which keeps increasing as tunnels are created, tell apart the successive tunnels of the same slot
+  const static size_t MAX_TUNNELS = round_up_pow2(SRSENB_MAX_UES * MAX_TUNNELS_PER_UE);
+
+  // Handover-only state of a tunnel, stored in the slot of its TEID
+  struct tunnel_ho_ctxt {
+    srsran::unique_timer                            rx_timer;
+    srsran::byte_buffer_pool_ptr<buffered_sdu_list> buffer;
+    srsran::move_callback<void()>                   on_removal;
+  };
+
+  using tunnel_list_t  = srsran::static_id_obj_pool<uint32_t, tunnel, MAX_TUNNELS>;
   using tunnel_ctxt_it = typename tunnel_list_t::iterator;
 
+  tunnel_ho_ctxt& get_ho_ctxt(uint32_t teid) { return ho_ctxts[teid % MAX_TUNNELS]; }
+
   srsran::task_sched_handle task_sched;
   const gtpu_args_t*        gtpu_args = nullptr;
   pdcp_interface_gtpu*      pdcp      = nullptr;
   srslog::basic_logger&     logger;
 
-  std::unordered_map<uint16_t, ue_bearer_tunnel_list> ue_teidin_db;
-  tunnel_list_t                     tunnels;
+  rnti_map_t<ue_bearer_tunnel_list>        ue_teidin_db;
+  tunnel_list_t                            tunnels;
+  std::array<tunnel_ho_ctxt, MAX_TUNNELS>  ho_ctxts;
+  std::array<tunnel_counters, MAX_TUNNELS> counters;
 };
 
 using gtpu_tunnel_state = gtpu_tunnel_manager::tunnel_state;
@@ -167,10 +194,13 @@ public:
 
   // stack interface
   void handle_gtpu_s1u_rx_packet(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr);
+  void handle_gtpu_s1u_rx_batch(srsran::datagram_batch& batch);
   void handle_gtpu_m1u_rx_packet(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr);
+  void tic();
+  void get_metrics(gtpu_metrics_t& m);
 
 private:
-  static const int GTPU_PORT = 2152;
+  static const int GTPU_PORT = gtpu_tunnel_manager::GTPU_PORT;
 
   void rem_tunnel(uint32_t teidin);
 
@@ -219,12 +249,23 @@ private:
   // Socket file descriptor
   int fd = -1;
 
+  // G-PDUs pending to be sent, which are flushed at every stack tick
+  srsran::datagram_tx_batch tx_batch;
+
+  // G-PDUs of the same bearer received in a batch, which are handed to PDCP in a single call
+  using rx_burst_t = srsran::bounded_vector<srsran::unique_byte_buffer_t, srsran::datagram_batch::max_size>;
+  bool       rx_batch_active        = false;
+  uint16_t   rx_burst_rnti          = SRSRAN_INVALID_RNTI;
+  uint32_t   rx_burst_eps_bearer_id = 0;
+  rx_burst_t rx_burst;
+
   void send_pdu_to_tunnel(const gtpu_tunnel& tx_tun, srsran::unique_byte_buffer_t pdu, int pdcp_sn = -1);
 
   void echo_response(in_addr_t addr, in_port_t port, uint16_t seq);
   void error_indication(in_addr_t addr, in_port_t port, uint32_t err_teid);
   bool send_end_marker(uint32_t teidin);
 
+  void flush_rx_burst();
   void handle_end_marker(const gtpu_tunnel& rx_tunnel);
   void handle_msg_data_pdu(const srsran::gtpu_header_t& header,
                            const gtpu_tunnel&           rx_tunnel,
@@ -0,0 +1,51 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_GTPU_METRICS_H
+#define SRSENB_GTPU_METRICS_H
+
+#include <cstdint>
+#include <vector>
+
+namespace srsenb {
+
+/// Counters of a GTP-U tunnel since its creation. DL refers to the PDUs received from the S1-U, UL to the ones sent
+struct gtpu_tunnel_metrics_t {
+  uint16_t rnti;
+  uint32_t eps_bearer_id;
+  uint32_t teid_in;
+  uint32_t teid_out;
+  uint64_t dl_bytes;
+  uint64_t dl_pkts;
+  uint64_t ul_bytes;
+  uint64_t ul_pkts;
+  uint64_t dropped_pkts;  ///< PDUs discarded in either direction
+  uint64_t fwd_pkts;      ///< DL PDUs forwarded to another tunnel during handover
+  uint64_t buffered_pkts; ///< DL PDUs held while the tunnel is suspended, to be delivered in PDCP SN order
+};
+
+struct gtpu_metrics_t {
+  std::vector<gtpu_tunnel_metrics_t> tunnels;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_GTPU_METRICS_H
@@ -39,9 +39,16 @@ public:
     logger(logger_), pdcp_lte_obj(pdcp_lte), pdcp_nr_obj(pdcp_nr), gtpu_obj(gtpu_), bearers(&bearers_)
   {}
 
+  /// Hands the UL PDUs to the given sink instead of GTPU, e.g. the traffic generator
+  void set_ul_sink(gtpu_interface_pdcp* ul_sink_) { ul_sink = ul_sink_; }
+
   /// Converts LCID to EPS-BearerID and sends corresponding PDU to GTPU
   void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override
   {
+    if (ul_sink != nullptr) {
+      ul_sink->write_pdu(rnti, lcid, std::move(pdu));
+      return;
+    }
     auto bearer = bearers->get_lcid_bearer(rnti, lcid);
     if (not bearer.is_valid()) {
       logger.error("Bearer rnti=0x%x, lcid=%d not found", rnti, lcid);
@@ -61,7 +68,19 @@ public:
       logger.warning("Can't deliver SDU for EPS bearer %d. Dropping it.", eps_bearer_id);
     }
   }
-  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t eps_bearer_id) override
+  void write_sdus(uint16_t rnti, uint32_t eps_bearer_id, srsran::span<srsran::unique_byte_buffer_t> sdus) override
+  {
+    auto bearer = bearers->get_radio_bearer(rnti, eps_bearer_id);
+    // route SDUs to PDCP entity
+    if (bearer.rat == srsran::srsran_rat_t::lte) {
+      pdcp_lte_obj->write_sdus(rnti, bearer.lcid, sdus);
+    } else if (bearer.rat == srsran::srsran_rat_t::nr) {
+      pdcp_nr_obj->write_sdus(rnti, bearer.lcid, sdus);
+    } else {
+      logger.warning("Can't deliver %zd SDUs for EPS bearer %d. Dropping them.", sdus.size(), eps_bearer_id);
+    }
+  }
+  srsran::pdcp_sdu_list_t get_buffered_pdus(uint16_t rnti, uint32_t eps_bearer_id) override
   {
     auto bearer = bearers->get_radio_bearer(rnti, eps_bearer_id);
     // route SDU to PDCP entity
@@ -80,6 +99,7 @@ private:
   pdcp_interface_gtpu*  pdcp_lte_obj = nullptr;
   pdcp_interface_gtpu*  pdcp_nr_obj  = nullptr;
   enb_bearer_manager*   bearers      = nullptr;
+  gtpu_interface_pdcp*  ul_sink      = nullptr;
 };
 
 } // namespace srsenb
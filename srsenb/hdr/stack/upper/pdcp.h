@@ -19,7 +19,11 @@
  *
  */
 
+#include "srsenb/hdr/common/common_enb.h"
 #include "srsenb/hdr/common/rnti_pool.h"
+#include "srsran/common/task_scheduler.h"
+#include "srsran/common/thread_pool.h"
+#include "srsran/common/threads.h"
 #include "srsran/common/timers.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/interfaces/enb_pdcp_interfaces.h"
@@ -43,11 +47,18 @@ class pdcp : public pdcp_interface_rlc, public pdcp_interface_gtpu, public pdcp_
 public:
   pdcp(srsran::task_sched_handle task_sched_, srslog::basic_logger& logger);
   virtual ~pdcp() {}
-  void init(rlc_interface_pdcp* rlc_, rrc_interface_pdcp* rrc_, gtpu_interface_pdcp* gtpu_);
+  void init(rlc_interface_pdcp*        rlc_,
+            rrc_interface_pdcp*        rrc_,
+            gtpu_interface_pdcp*       gtpu_,
+            uint32_t                   nof_shards_         = 0,
+            srsran::task_queue_handle* stack_task_queue_   = nullptr,
+            uint32_t                   nof_crypto_workers_ = 0);
   void stop();
+  void tic();
 
   // pdcp_interface_rlc
   void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu) override;
+  void write_pdus(uint16_t rnti, uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> pdus) override;
   void notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sn) override;
   void notify_failure(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sn) override;
   void write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t sdu) {}
@@ -58,6 +69,7 @@ public:
   void add_user(uint16_t rnti) override;
   void rem_user(uint16_t rnti) override;
   void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn = -1) override;
+  void write_sdus(uint16_t rnti, uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus) override;
   void add_bearer(uint16_t rnti, uint32_t lcid, const srsran::pdcp_config_t& cnfg) override;
   void del_bearer(uint16_t rnti, uint32_t lcid) override;
   void config_security(uint16_t rnti, uint32_t lcid, const srsran::as_security_config_t& cfg_sec) override;
@@ -70,7 +82,7 @@ public:
   void reestablish(uint16_t rnti) override;
 
   // pdcp_interface_gtpu
-  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) override;
+  srsran::pdcp_sdu_list_t get_buffered_pdus(uint16_t rnti, uint32_t lcid) override;
 
   // Metrics
   void get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti);
@@ -83,6 +95,7 @@ private:
     srsenb::rlc_interface_pdcp* rlc;
     // rlc_interface_pdcp
     void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu);
+    void write_sdus(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus);
     void discard_sdu(uint32_t lcid, uint32_t discard_sn);
     bool rb_is_um(uint32_t lcid);
     bool sdu_queue_is_full(uint32_t lcid);
@@ -94,6 +107,7 @@ private:
   public:
     uint16_t                     rnti;
     srsenb::gtpu_interface_pdcp* gtpu;
+    srsran::task_queue_handle*   stack_task_queue;
     // gw_interface_pdcp
     void write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu);
     void write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t sdu) {}
@@ -104,6 +118,7 @@ private:
   public:
     uint16_t                    rnti;
     srsenb::rrc_interface_pdcp* rrc;
+    srsran::task_queue_handle*  stack_task_queue;
     // rrc_interface_pdcp
     void        write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu);
     void        write_pdu_bcch_bch(srsran::unique_byte_buffer_t pdu);
@@ -123,9 +138,41 @@ private:
     unique_rnti_ptr<srsran::pdcp> pdcp;
   };
 
-  void clear_user(user_interface* ue);
+  using user_map_t = rnti_map_t<user_interface>;
 
-  std::map<uint32_t, user_interface> users;
+  /// Thread that owns the PDCP entities of the UEs with rnti % nof_shards == idx, with its own tasks and timers
+  class pdcp_shard final : public srsran::thread
+  {
+  public:
+    explicit pdcp_shard(uint32_t idx);
+    void start_shard();
+    void stop();
+
+    srsran::task_scheduler    task_sched;
+    srsran::task_queue_handle task_queue;
+    user_map_t                users;
+
+  private:
+    void run_thread() override;
+
+    std::atomic<bool> running{false};
+  };
+
+  void        clear_user(user_interface* ue);
+  user_map_t& get_users(uint16_t rnti);
+  template <typename F>
+  void defer_user_task(uint16_t rnti, F&& task);
+  template <typename R, typename F>
+  R run_user_task(uint16_t rnti, F&& task);
+
+  user_map_t users;
+
+  // Sharding of the PDCP entities. When empty, they are owned by the stack thread
+  std::vector<std::unique_ptr<pdcp_shard> > shards;
+  srsran::task_queue_handle*                stack_task_queue = nullptr;
+
+  // Workers ciphering the DRB PDUs of all UEs. When null, the ciphering is done by the thread owning the entity
+  std::unique_ptr<srsran::task_thread_pool> crypto_workers;
 
   rlc_interface_pdcp*       rlc  = nullptr;
   rrc_interface_pdcp*       rrc  = nullptr;
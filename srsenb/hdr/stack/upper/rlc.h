@@ -19,13 +19,14 @@
  *
  */
 
+#include "srsenb/hdr/common/common_enb.h"
 #include "srsenb/hdr/common/rnti_pool.h"
+#include "srsran/common/multiqueue.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
 #include "srsran/interfaces/ue_interfaces.h"
 #include "srsran/rlc/rlc.h"
 #include "srsran/srslog/srslog.h"
-#include <map>
 
 #ifndef SRSENB_RLC_H
 #define SRSENB_RLC_H
@@ -47,11 +48,17 @@ class rlc : public rlc_interface_mac, public rlc_interface_rrc, public rlc_inter
 {
 public:
   explicit rlc(srslog::basic_logger& logger) : logger(logger) {}
-  void
-  init(pdcp_interface_rlc* pdcp_, rrc_interface_rlc* rrc_, mac_interface_rlc* mac_, srsran::timer_handler* timers_);
+  void init(pdcp_interface_rlc*        pdcp_,
+            rrc_interface_rlc*         rrc_,
+            mac_interface_rlc*         mac_,
+            srsran::timer_handler*     timers_,
+            srsran::task_queue_handle* pdcp_task_queue_ = nullptr);
   void stop();
   void get_metrics(rlc_metrics_t& m, const uint32_t nof_tti);
 
+  /// Bounds the bytes queued for TX in the DRBs of each UE added from now on (0 for no bound)
+  void set_ue_tx_budget(uint32_t max_bytes) { ue_tx_budget_bytes = max_bytes; }
+
   // rlc_interface_rrc
   void clear_buffer(uint16_t rnti);
   void add_user(uint16_t rnti);
@@ -67,6 +74,7 @@ public:
 
   // rlc_interface_pdcp
   void        write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu);
+  void        write_sdus(uint16_t rnti, uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus) override;
   void        discard_sdu(uint16_t rnti, uint32_t lcid, uint32_t discard_sn);
   bool        rb_is_um(uint16_t rnti, uint32_t lcid);
   const char* get_rb_name(uint32_t lcid);
@@ -102,14 +110,20 @@ private:
 
   pthread_rwlock_t rwlock;
 
-  std::map<uint32_t, user_interface> users;
-  std::vector<mch_service_t>         mch_services;
+  rnti_map_t<user_interface> users;
+  std::vector<mch_service_t> mch_services;
 
   mac_interface_rlc*     mac  = nullptr;
   pdcp_interface_rlc*    pdcp = nullptr;
   rrc_interface_rlc*     rrc  = nullptr;
   srslog::basic_logger&  logger;
   srsran::timer_handler* timers = nullptr;
+
+  uint32_t ue_tx_budget_bytes = 0;
+
+  // Set when the UL PDUs are processed in the MAC workers, to hand the SDUs and delivery notifications over to PDCP in
+  // the stack thread, in the order they were generated
+  srsran::task_queue_handle* pdcp_task_queue = nullptr;
 };
 
 } // namespace srsenb
@@ -0,0 +1,111 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+/******************************************************************************
+ * File:        traffic_gen.h
+ * Description: Traffic source and sink at the GTP-U/PDCP boundary, for
+ *              capacity tests without the user plane of the core network.
+ *****************************************************************************/
+
+#ifndef SRSENB_TRAFFIC_GEN_H
+#define SRSENB_TRAFFIC_GEN_H
+
+#include "srsenb/hdr/stack/enb_stack_base.h"
+#include "srsenb/hdr/stack/upper/traffic_gen_metrics.h"
+#include "srsran/common/bearer_manager.h"
+#include "srsran/interfaces/enb_gtpu_interfaces.h"
+#include "srsran/interfaces/enb_pdcp_interfaces.h"
+#include "srsran/srslog/logger.h"
+#include <unordered_map>
+#include <vector>
+
+namespace srsenb {
+
+/**
+ * Generates the DL SDUs of the configured EPS bearers and absorbs the UL PDUs of all of them, in place of GTP-U.
+ * The DL flow of a bearer follows one of these profiles of the configured rate:
+ * - cbr: constant rate.
+ * - burst: the flow sends during burst_on_ms of every burst_period_ms, at the rate that keeps the configured mean.
+ * - sawtooth: like the congestion window of TCP, the rate grows linearly from half the configured rate to the full
+ *   rate during sawtooth_period_ms, and then drops back to half.
+ * The SDUs of a flow are generated from the cumulative bit count of its profile since the flow started, so the byte
+ * count of a run only depends on its length. All methods are called from the stack thread.
+ */
+class traffic_gen final : public gtpu_interface_pdcp
+{
+public:
+  enum class profile_t { none, cbr, burst, sawtooth };
+
+  traffic_gen(srslog::basic_logger& logger_, enb_bearer_manager& bearers_);
+
+  int init(const traffic_gen_args_t& args_, pdcp_interface_gtpu* pdcp_);
+
+  /// Generates the DL SDUs of the last ms, starting and ending the flows of the added and removed bearers
+  void tic();
+
+  /// Absorbs the UL PDUs of the DRBs
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override;
+
+  void get_metrics(traffic_gen_metrics_t& m) const;
+
+  /// Bits that a flow of the given profile sends in its first t_ms
+  static uint64_t
+  profile_bits(profile_t profile, uint64_t rate_kbps, uint64_t t_ms, uint64_t period_ms, uint64_t on_ms);
+
+private:
+  struct flow_cfg_t {
+    uint32_t  eps_bearer_id = 0;
+    profile_t profile       = profile_t::none;
+    uint32_t  rate_kbps     = 0;
+  };
+  struct flow_t {
+    flow_cfg_t                 cfg;
+    uint64_t                   t_ms          = 0;
+    uint64_t                   offered_bytes = 0; ///< Bytes of the SDUs of the profile, including the dropped ones
+    uint32_t                   seq           = 0;
+    bool                       active        = true;
+    traffic_gen_flow_metrics_t metrics       = {};
+  };
+
+  static uint32_t flow_key(uint16_t rnti, uint32_t eps_bearer_id) { return (uint32_t)rnti << 8u | eps_bearer_id; }
+
+  flow_t& start_flow(uint16_t rnti, uint32_t eps_bearer_id);
+  void    end_flow(const flow_t& flow);
+  void    generate(uint16_t rnti, flow_t& flow);
+  void    fill_sdu(srsran::byte_buffer_t& sdu, uint32_t seq) const;
+
+  srslog::basic_logger& logger;
+  enb_bearer_manager&   bearers;
+  pdcp_interface_gtpu*  pdcp = nullptr;
+  traffic_gen_args_t    args = {};
+
+  std::vector<flow_cfg_t>                   flow_cfgs;
+  std::unordered_map<uint32_t, flow_t>      flows;
+  traffic_gen_flow_metrics_t                ended = {}; ///< Sum of the counters of the ended flows
+  std::vector<srsran::unique_byte_buffer_t> burst;
+};
+
+const char* to_string(traffic_gen::profile_t profile);
+
+} // namespace srsenb
+
+#endif // SRSENB_TRAFFIC_GEN_H
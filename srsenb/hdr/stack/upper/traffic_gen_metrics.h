@@ -0,0 +1,49 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSENB_TRAFFIC_GEN_METRICS_H
+#define SRSENB_TRAFFIC_GEN_METRICS_H
+
+#include <cstdint>
+#include <vector>
+
+namespace srsenb {
+
+/// Counters of a traffic generator flow since its start. DL refers to the generated SDUs, UL to the absorbed PDUs
+struct traffic_gen_flow_metrics_t {
+  uint16_t rnti;
+  uint32_t eps_bearer_id;
+  uint64_t dl_bytes;
+  uint64_t dl_pkts;
+  uint64_t dl_dropped_pkts; ///< DL SDUs of the profile that could not be allocated
+  uint64_t ul_bytes;
+  uint64_t ul_pkts;
+};
+
+struct traffic_gen_metrics_t {
+  traffic_gen_flow_metrics_t              total; ///< Sum of all the flows since startup, including the finished ones
+  std::vector<traffic_gen_flow_metrics_t> flows;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_TRAFFIC_GEN_METRICS_H
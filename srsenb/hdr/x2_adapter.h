@@ -133,7 +133,14 @@ public:
     }
     nr_stack->write_sdu(rnti, lcid, std::move(sdu), pdcp_sn);
   }
-  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) override
+  void write_sdus(uint16_t rnti, uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus) override
+  {
+    if (nr_stack == nullptr) {
+      return;
+    }
+    nr_stack->write_sdus(rnti, lcid, sdus);
+  }
+  srsran::pdcp_sdu_list_t get_buffered_pdus(uint16_t rnti, uint32_t lcid) override
   {
     if (nr_stack == nullptr) {
       return {};
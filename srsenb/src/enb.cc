@@ -25,6 +25,7 @@
 #include "srsenb/src/enb_cfg_parser.h"
 #include "srsgnb/hdr/stack/gnb_stack_nr.h"
 #include "srsran/build_info.h"
+#include "srsran/common/buffer_pool.h"
 #include "srsran/common/enb_events.h"
 #include "srsran/radio/radio_null.h"
 #include <iostream>
@@ -212,6 +213,8 @@ bool enb::get_metrics(enb_metrics_t* m)
   }
   radio->get_metrics(&m->rf);
   phy->get_metrics(m->phy);
+  phy->get_tti_deadline_metrics(m->phy_deadline);
+  srsran_stage_prof_get(m->phy_stages);
   if (eutra_stack) {
     eutra_stack->get_metrics(&m->stack);
   }
@@ -220,9 +223,40 @@ bool enb::get_metrics(enb_metrics_t* m)
   }
   m->running = true;
   m->sys     = sys_proc.get_metrics();
+  get_mem_metrics(*m);
   return true;
 }
 
+void enb::get_mem_metrics(enb_metrics_t& m)
+{
+  mem_metrics_t& mem = m.mem;
+  mem                = {};
+
+  phy->get_mem_metrics(mem.cell_phy_bytes);
+  mem.phy_bytes              = srsran_mem_get_usage(SRSRAN_MEM_TAG_PHY);
+  mem.softbuffer_bytes       = srsran_mem_get_usage(SRSRAN_MEM_TAG_SOFTBUFFER);
+  mem.byte_buffer_pool_bytes = srsran::byte_buffer_pool::get_instance()->size() * sizeof(srsran::byte_buffer_t);
+
+  // The UE metrics of the stack layers are reported in the same order
+  const stack_metrics_t& stack = m.stack;
+  mem.ues.resize(stack.mac.ues.size());
+  for (size_t i = 0; i < mem.ues.size(); i++) {
+    mem_ue_metrics_t& ue = mem.ues[i];
+    ue.rnti              = stack.mac.ues[i].rnti;
+    ue.softbuffer_bytes  = stack.mac.ues[i].softbuffer_bytes;
+    if (i < stack.rlc.ues.size()) {
+      for (const srsran::rlc_bearer_metrics_t& bearer : stack.rlc.ues[i].bearer) {
+        ue.rlc_bytes += bearer.mem_bytes;
+      }
+    }
+    if (i < stack.rrc.ues.size()) {
+      ue.rrc_bytes = stack.rrc.ues[i].mem_bytes;
+    }
+    mem.rlc_bytes += ue.rlc_bytes;
+    mem.rrc_bytes += ue.rrc_bytes;
+  }
+}
+
 void enb::cmd_cell_gain(uint32_t cell_id, float gain)
 {
   phy->cmd_cell_gain(cell_id, gain);
@@ -1717,6 +1717,7 @@ int parse_cfr_args(all_args_t* args, srsran_cfr_cfg_t* cfr_config)
   cfr_config->manual_thr  = args->phy.cfr_args.manual_thres;
   cfr_config->max_papr_db = args->phy.cfr_args.auto_target_papr;
   cfr_config->ema_alpha   = args->phy.cfr_args.ema_alpha;
+  cfr_config->filter      = args->phy.cfr_args.filter;
 
   if (!srsran_cfr_params_valid(cfr_config)) {
     fprintf(stderr,
@@ -1832,6 +1833,7 @@ int parse_cfg_files(all_args_t* args_, rrc_cfg_t* rrc_cfg_, rrc_nr_cfg_t* rrc_nr
       args_->nr_stack.ngap.gtp_advertise_addr = args_->stack.s1ap.gtp_advertise_addr;
       args_->nr_stack.ngap.amf_addr           = args_->stack.s1ap.mme_addr;
       args_->nr_stack.ngap.ngc_bind_addr      = args_->stack.s1ap.gtp_bind_addr;
+      args_->nr_stack.ngap.sctp_nof_streams   = args_->stack.s1ap.sctp_nof_streams;
 
       // Parse NIA/NEA preference list (use same as LTE for now)
       for (uint32_t i = 0; i < rrc_cfg_->eea_preference_list.size(); i++) {
@@ -2176,6 +2178,12 @@ int set_derived_args_nr(all_args_t* args_, rrc_nr_cfg_t* rrc_nr_cfg_, phy_cfg_t*
   // MAC-NR PCAP options
   args_->nr_stack.mac.pcap.enable = args_->stack.mac_pcap.enable;
   args_->nr_stack.log             = args_->stack.log;
+  args_->nr_stack.traffic_gen     = args_->stack.traffic_gen;
+
+  // The NR DL adaptive link uses the same parameters as the LTE one
+  args_->nr_stack.mac.sched_cfg.target_bler               = args_->stack.mac.sched.target_bler;
+  args_->nr_stack.mac.sched_cfg.max_delta_dl_cqi          = args_->stack.mac.sched.max_delta_dl_cqi;
+  args_->nr_stack.mac.sched_cfg.adaptive_dl_mcs_step_size = args_->stack.mac.sched.adaptive_dl_mcs_step_size;
 
   // Sanity check for unsupported/untested configuration
   for (auto& cfg : rrc_nr_cfg_->cell_list) {
@@ -26,10 +26,12 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include "srsran/common/buffer_pool.h"
 #include "srsran/common/common_helper.h"
 #include "srsran/common/config_file.h"
 #include "srsran/common/crash_handler.h"
 #include "srsran/common/tsan_options.h"
+#include "srsran/phy/utils/stage_prof.h"
 #include "srsran/srslog/event_trace.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/support/emergency_handlers.h"
@@ -45,6 +47,7 @@
 #include "srsenb/hdr/enb.h"
 #include "srsenb/hdr/metrics_csv.h"
 #include "srsenb/hdr/metrics_json.h"
+#include "srsenb/hdr/metrics_prometheus.h"
 #include "srsenb/hdr/metrics_stdout.h"
 #include "srsran/common/enb_events.h"
 
@@ -66,6 +69,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   string mnc;
   string enb_id;
   string cfr_mode;
+  string cfr_filter;
   bool   use_standard_lte_rates = false;
 
   // Command line only options
@@ -112,6 +116,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("rf.device_name",       bpo::value<string>(&args->rf.device_name)->default_value("auto"),       "Front-end device name")
     ("rf.device_args",       bpo::value<string>(&args->rf.device_args)->default_value("auto"),       "Front-end device arguments")
     ("rf.time_adv_nsamples", bpo::value<string>(&args->rf.time_adv_nsamples)->default_value("auto"), "Transmission time advance")
+    ("rf.tx_queue_size",     bpo::value<uint32_t>(&args->rf.tx_queue_size)->default_value(0), "Number of subframes queued for the Tx thread, 0 disables it")
 
     ("gui.enable",        bpo::value<bool>(&args->gui.enable)->default_value(false),          "Enable GUI plots")
 
@@ -140,10 +145,12 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 
     ("log.filename",      bpo::value<string>(&args->log.filename)->default_value("/tmp/ue.log"),"Log filename")
     ("log.file_max_size", bpo::value<int>(&args->log.file_max_size)->default_value(-1), "Maximum file size (in kilobytes). When passed, multiple files are created. Default -1 (single file)")
+    ("log.file_format",   bpo::value<string>(&args->log.file_format)->default_value("text"), "Log file format (text or binary). Binary logs are rendered offline with srslog_decoder")
 
     /* PCAP */
     ("pcap.enable",    bpo::value<bool>(&args->stack.mac_pcap.enable)->default_value(false),         "Enable MAC packet captures for wireshark")
     ("pcap.filename",  bpo::value<string>(&args->stack.mac_pcap.filename)->default_value("/tmp/enb_mac.pcap"), "MAC layer capture filename")
+    ("pcap.snaplen",   bpo::value<uint32_t>(&args->stack.mac_pcap.snaplen)->default_value(0),         "Truncate the captured MAC PDUs to this number of bytes (0 captures the whole PDUs)")
     ("pcap.nr_filename",  bpo::value<string>(&args->nr_stack.mac.pcap.filename)->default_value("/tmp/enb_mac_nr.pcap"), "NR MAC layer capture filename")
     ("pcap.s1ap_enable",   bpo::value<bool>(&args->stack.s1ap_pcap.enable)->default_value(false),         "Enable S1AP packet captures for wireshark")
     ("pcap.s1ap_filename", bpo::value<string>(&args->stack.s1ap_pcap.filename)->default_value("/tmp/enb_s1ap.pcap"), "S1AP layer capture filename")
@@ -178,13 +185,16 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("scheduler.ul_snr_avg_alpha", bpo::value<float>(&args->stack.mac.sched.ul_snr_avg_alpha)->default_value(0.05), "Exponential Average alpha coefficient used in estimation of UL SNR")
     ("scheduler.init_ul_snr_value", bpo::value<int>(&args->stack.mac.sched.init_ul_snr_value)->default_value(5), "Initial UL SNR value used for computing MCS in the first UL grant")
     ("scheduler.init_dl_cqi", bpo::value<int>(&args->stack.mac.sched.init_dl_cqi)->default_value(5), "DL CQI value used before any CQI report is available to the eNB")
+    ("scheduler.dl_sb_cqi_max_age", bpo::value<uint32_t>(&args->stack.mac.sched.dl_sb_cqi_max_age)->default_value(0), "Age in ms over which subband CQI reports fade into the wideband CQI (0 to keep them until the next report)")
     ("scheduler.max_sib_coderate", bpo::value<float>(&args->stack.mac.sched.max_sib_coderate)->default_value(0.8), "Upper bound on SIB and RAR grants coderate")
     ("scheduler.pdcch_cqi_offset", bpo::value<int>(&args->stack.mac.sched.pdcch_cqi_offset)->default_value(0), "CQI offset in derivation of PDCCH aggregation level")
+    ("scheduler.nof_cc_workers", bpo::value<uint32_t>(&args->stack.mac.sched.nof_cc_workers)->default_value(0), "Number of extra threads generating the LTE carrier results in parallel (0 for sequential)")
 
 
 
     /* Downlink Channel emulator section */
     ("channel.dl.enable",            bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false),               "Enable/Disable internal Downlink channel emulator")
+    ("channel.dl.nof_threads",       bpo::value<uint32_t>(&args->phy.dl_channel_args.nof_threads)->default_value(1),          "Number of threads sharing the channel emulator antennas")
     ("channel.dl.awgn.enable",       bpo::value<bool>(&args->phy.dl_channel_args.awgn_enable)->default_value(false),          "Enable/Disable AWGN simulator")
     ("channel.dl.awgn.snr",          bpo::value<float>(&args->phy.dl_channel_args.awgn_snr_dB)->default_value(30.0f),         "Target SNR in dB")
     ("channel.dl.fading.enable",     bpo::value<bool>(&args->phy.dl_channel_args.fading_enable)->default_value(false),        "Enable/Disable Fading model")
@@ -204,6 +214,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Uplink Channel emulator section */
     ("channel.ul.enable",            bpo::value<bool>(&args->phy.ul_channel_args.enable)->default_value(false),                  "Enable/Disable internal Downlink channel emulator")
+    ("channel.ul.nof_threads",       bpo::value<uint32_t>(&args->phy.ul_channel_args.nof_threads)->default_value(1),             "Number of threads sharing the channel emulator antennas")
     ("channel.ul.awgn.enable",       bpo::value<bool>(&args->phy.ul_channel_args.awgn_enable)->default_value(false),             "Enable/Disable AWGN simulator")
     ("channel.ul.awgn.signal_power", bpo::value<float>(&args->phy.ul_channel_args.awgn_signal_power_dBfs)->default_value(30.0f), "Received signal power in decibels full scale (dBfs)")
     ("channel.ul.awgn.snr",          bpo::value<float>(&args->phy.ul_channel_args.awgn_snr_dB)->default_value(30.0f),            "Noise level in decibels full scale (dBfs)")
@@ -229,17 +240,33 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("cfr.strength", bpo::value<float>(&args->phy.cfr_args.strength)->default_value(args->phy.cfr_args.strength), "CFR ratio between amplitude-limited vs original signal (0 to 1)")
     ("cfr.auto_target_papr", bpo::value<float>(&args->phy.cfr_args.auto_target_papr)->default_value(args->phy.cfr_args.auto_target_papr), "Signal PAPR target (in dB) in CFR auto modes")
     ("cfr.ema_alpha", bpo::value<float>(&args->phy.cfr_args.ema_alpha)->default_value(args->phy.cfr_args.ema_alpha), "Alpha coefficient for the power average in auto_ema mode (0 to 1)")
+    ("cfr.filter", bpo::value<string>(&cfr_filter)->default_value("fft"), "CFR peak filter: fft or window")
 
       /* Expert section */
     ("expert.metrics_period_secs", bpo::value<float>(&args->general.metrics_period_secs)->default_value(1.0), "Periodicity for metrics in seconds.")
     ("expert.metrics_csv_enable",  bpo::value<bool>(&args->general.metrics_csv_enable)->default_value(false), "Write metrics to CSV file.")
     ("expert.metrics_csv_filename", bpo::value<string>(&args->general.metrics_csv_filename)->default_value("/tmp/enb_metrics.csv"), "Metrics CSV filename.")
+    ("expert.metrics_prometheus_enable", bpo::value<bool>(&args->general.metrics_prometheus_enable)->default_value(false), "Serve the metrics over HTTP in the OpenMetrics format.")
+    ("expert.metrics_prometheus_addr", bpo::value<string>(&args->general.metrics_prometheus_addr)->default_value("127.0.0.1"), "Bind address of the OpenMetrics HTTP endpoint.")
+    ("expert.metrics_prometheus_port", bpo::value<int>(&args->general.metrics_prometheus_port)->default_value(9464), "Port of the OpenMetrics HTTP endpoint.")
+    ("expert.metrics_prometheus_max_ues", bpo::value<uint32_t>(&args->general.metrics_prometheus_max_ues)->default_value(64), "Maximum number of UEs with per UE OpenMetrics series, the rest only count in the cell totals.")
     ("expert.pusch_max_its", bpo::value<uint32_t>(&args->phy.pusch_max_its)->default_value(8), "Maximum number of turbo decoder iterations for LTE.")
     ("expert.pusch_8bit_decoder", bpo::value<bool>(&args->phy.pusch_8bit_decoder)->default_value(false), "Use 8-bit for LLR representation and turbo decoder trellis computation (Experimental).")
+    ("expert.pusch_early_stop", bpo::value<bool>(&args->phy.pusch_early_stop)->default_value(false), "Stop the turbo decoder when the hard decision does not change between iterations.")
+    ("expert.pusch_snr_max_its", bpo::value<bool>(&args->phy.pusch_snr_max_its)->default_value(false), "Reduce the maximum number of turbo decoder iterations when the PUSCH SNR is well above the MCS needs.")
     ("expert.pusch_meas_evm", bpo::value<bool>(&args->phy.pusch_meas_evm)->default_value(false), "Enable/Disable PUSCH EVM measure.")
     ("expert.tx_amplitude", bpo::value<float>(&args->phy.tx_amplitude)->default_value(0.6), "Transmit amplitude factor.")
     ("expert.nof_phy_threads", bpo::value<uint32_t>(&args->phy.nof_phy_threads)->default_value(3), "Number of PHY threads.")
+    ("expert.nof_grant_threads", bpo::value<uint32_t>(&args->phy.nof_grant_threads)->default_value(0), "Number of extra threads of each PHY thread and carrier encoding PDSCH and decoding PUSCH grants in parallel.")
+    ("expert.nr_pusch_threads", bpo::value<uint32_t>(&args->phy.nr_pusch_threads)->default_value(0), "Number of extra threads shared by the NR PHY threads decoding the PUSCH of any slot.")
     ("expert.nof_prach_threads", bpo::value<uint32_t>(&args->phy.nof_prach_threads)->default_value(1), "Number of PRACH workers per carrier. Only 1 or 0 is supported.")
+    ("expert.prach_corr_threads", bpo::value<uint32_t>(&args->phy.prach_corr_threads)->default_value(0), "Number of extra threads of each PRACH worker correlating the preamble root sequences in parallel.")
+    ("expert.txrx_cpus", bpo::value<string>(&args->phy.txrx_cpus)->default_value(""), "CPUs of the radio thread, e.g. 1 or 1-2 (default: any CPU).")
+    ("expert.phy_cpus", bpo::value<string>(&args->phy.worker_cpus)->default_value(""), "CPUs of the LTE PHY threads, each thread runs on one CPU of the list, e.g. 2-4 (default: any CPU).")
+    ("expert.phy_hugepage_min_kb", bpo::value<uint32_t>(&args->phy.hugepage_min_kb)->default_value(0), "Allocate the PHY buffers of at least this size in KB in whole 2 MB transparent huge pages (default: 0, disabled).")
+    ("expert.nr_phy_cpus", bpo::value<string>(&args->phy.nr_worker_cpus)->default_value(""), "CPUs of the NR PHY threads, each thread runs on one CPU of the list (default: any CPU).")
+    ("expert.prach_cpus", bpo::value<string>(&args->phy.prach_cpus)->default_value(""), "CPUs of the PRACH workers, each carrier worker runs on one CPU of the list (default: any CPU).")
+    ("expert.stack_cpus", bpo::value<string>(&args->stack.cpus)->default_value(""), "CPUs of the stack thread (default: any CPU).")
     ("expert.max_prach_offset_us", bpo::value<float>(&args->phy.max_prach_offset_us)->default_value(30), "Maximum allowed RACH offset (in us).")
     ("expert.equalizer_mode", bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"), "Equalizer mode.")
     ("expert.estimator_fil_w", bpo::value<float>(&args->phy.estimator_fil_w)->default_value(0.1), "Chooses the coefficients for the 3-tap channel estimator centered filter.")
@@ -252,15 +279,22 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.tracing_enable",  bpo::value<bool>(&args->general.tracing_enable)->default_value(false), "Events tracing.")
     ("expert.tracing_filename", bpo::value<string>(&args->general.tracing_filename)->default_value("/tmp/enb_tracing.log"), "Tracing events filename.")
     ("expert.tracing_buffcapacity", bpo::value<std::size_t>(&args->general.tracing_buffcapacity)->default_value(1000000), "Tracing buffer capcity.")
+    ("expert.phy_stage_prof", bpo::value<bool>(&args->general.phy_stage_prof)->default_value(false), "Time the PHY processing stages and report them in the metrics (toggled at runtime with the prof command).")
     ("expert.stdout_ts_enable", bpo::value<bool>(&stdout_ts_enable)->default_value(false), "Prints once per second the timestamp into stdout.")
     ("expert.rrc_inactivity_timer", bpo::value<uint32_t>(&args->general.rrc_inactivity_timer)->default_value(30000), "Inactivity timer in ms.")
     ("expert.print_buffer_state", bpo::value<bool>(&args->general.print_buffer_state)->default_value(false), "Prints on the console the buffer state every 10 seconds.")
     ("expert.eea_pref_list", bpo::value<string>(&args->general.eea_pref_list)->default_value("EEA0, EEA2, EEA1"), "Ordered preference list for the selection of encryption algorithm (EEA) (default: EEA0, EEA2, EEA1).")
     ("expert.eia_pref_list", bpo::value<string>(&args->general.eia_pref_list)->default_value("EIA2, EIA1, EIA0"), "Ordered preference list for the selection of integrity algorithm (EIA) (default: EIA2, EIA1, EIA0).")
     ("expert.nof_prealloc_ues", bpo::value<uint32_t>(&args->stack.mac.nof_prealloc_ues)->default_value(8), "Number of UE resources to preallocate during eNB initialization.")
+    ("expert.nof_ul_pdu_workers", bpo::value<uint32_t>(&args->stack.mac.nof_ul_pdu_workers)->default_value(0), "Number of threads processing the UL MAC PDUs and RLC, sharded by UE (0 for the stack thread)")
+    ("expert.mem_profile", bpo::value<string>(&args->general.mem_profile)->default_value("default"), "Memory profile: default or compact (soft-buffers allocated on demand and a smaller buffer pool)")
+    ("expert.byte_buffer_pool_size", bpo::value<uint32_t>(&args->general.byte_buffer_pool_size)->default_value(0), "Number of byte buffers of the pool (0 for the memory profile default)")
     ("expert.lcid_padding", bpo::value<int>(&args->stack.mac.lcid_padding)->default_value(3), "LCID on which to put MAC padding")
     ("expert.max_mac_dl_kos", bpo::value<uint32_t>(&args->general.max_mac_dl_kos)->default_value(100), "Maximum number of consecutive KOs in DL before triggering the UE's release (default 100).")
     ("expert.max_mac_ul_kos", bpo::value<uint32_t>(&args->general.max_mac_ul_kos)->default_value(100), "Maximum number of consecutive KOs in UL before triggering the UE's release (default 100).")
+    ("expert.nof_pdcp_shards", bpo::value<uint32_t>(&args->stack.nof_pdcp_shards)->default_value(0), "Number of threads running the PDCP of the UEs, sharded by RNTI (0 to use the stack thread)")
+    ("expert.nof_pdcp_crypto_workers", bpo::value<uint32_t>(&args->stack.nof_pdcp_crypto_workers)->default_value(0), "Number of threads ciphering the PDCP PDUs of the DRBs (0 to cipher in the PDCP threads)")
+    ("expert.rlc_ue_tx_budget_kb", bpo::value<uint32_t>(&args->stack.rlc_ue_tx_budget_kb)->default_value(0), "Max KB queued in the RLC TX queues of the DRBs of a UE (0 for no limit)")
     ("expert.gtpu_tunnel_timeout", bpo::value<uint32_t>(&args->stack.gtpu_indirect_tunnel_timeout_msec)->default_value(0), "Maximum time that GTPU takes to release indirect forwarding tunnel since the last received GTPU PDU (0 for infinity).")
     ("expert.rlf_release_timer_ms", bpo::value<uint32_t>(&args->general.rlf_release_timer_ms)->default_value(4000), "Time taken by eNB to release UE context after it detects an RLF.")
     ("expert.extended_cp", bpo::value<bool>(&args->phy.extended_cp)->default_value(false), "Use extended cyclic prefix")
@@ -274,6 +308,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.sctp_rto_max", bpo::value<int32_t>(&args->stack.s1ap.sctp_rto_max)->default_value(6000), "SCTP maximum RTO.")
     ("expert.sctp_init_max_attempts", bpo::value<int32_t>(&args->stack.s1ap.sctp_init_max_attempts)->default_value(3), "Maximum SCTP init attempts.")
     ("expert.sctp_max_init_timeo)", bpo::value<int32_t>(&args->stack.s1ap.sctp_max_init_timeo)->default_value(5000), "Maximum SCTP init timeout.")
+    ("expert.sctp_nof_streams", bpo::value<int32_t>(&args->stack.s1ap.sctp_nof_streams)->default_value(16), "Number of outbound SCTP streams requested for S1-C/NG-C, UE signalling is spread over all but stream 0.")
     ("expert.rx_gain_offset", bpo::value<float>(&args->phy.rx_gain_offset)->default_value(62), "RX Gain offset to add to rx_gain to calibrate RSRP readings")
     ("expert.mac_prach_bi", bpo::value<uint32_t>(&args->stack.mac.prach_bi)->default_value(0), "Backoff Indicator to reduce contention in the PRACH channel")
 
@@ -283,9 +318,20 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("embms.m1u_if_addr", bpo::value<string>(&args->stack.embms.m1u_if_addr)->default_value("127.0.1.201"), "IP address of the interface the eNB will listen for M1-U traffic.")
     ("embms.mcs", bpo::value<uint16_t>(&args->stack.embms.mcs)->default_value(20), "Modulation and Coding scheme of MBMS traffic.")
 
+    // Traffic generator section
+    ("traffic_gen.enable", bpo::value<bool>(&args->stack.traffic_gen.enable)->default_value(false), "Generate the DL traffic and absorb the UL traffic of the DRBs in place of GTP-U")
+    ("traffic_gen.dl_flows", bpo::value<string>(&args->stack.traffic_gen.dl_flows)->default_value(""), "DL flows as a comma separated list of eps_bearer_id:profile:rate_kbps, profile being cbr, burst or sawtooth")
+    ("traffic_gen.sdu_size", bpo::value<uint32_t>(&args->stack.traffic_gen.sdu_size)->default_value(1400), "Bytes of each generated DL SDU")
+    ("traffic_gen.burst_period_ms", bpo::value<uint32_t>(&args->stack.traffic_gen.burst_period_ms)->default_value(100), "Period of the burst flows in ms")
+    ("traffic_gen.burst_on_ms", bpo::value<uint32_t>(&args->stack.traffic_gen.burst_on_ms)->default_value(20), "Time of each period in which the burst flows send, in ms")
+    ("traffic_gen.sawtooth_period_ms", bpo::value<uint32_t>(&args->stack.traffic_gen.sawtooth_period_ms)->default_value(2000), "Time in which the sawtooth flows ramp up from half to full rate, in ms")
+
     // NR section
     ("scheduler.nr_pdsch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_dl_mcs)->default_value(28), "Fixed NR DL MCS (-1 for dynamic).")
     ("scheduler.nr_pusch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_ul_mcs)->default_value(28), "Fixed NR UL MCS (-1 for dynamic).")
+    ("scheduler.nr_nof_cc_workers", bpo::value<uint32_t>(&args->nr_stack.mac.sched_cfg.nof_cc_workers)->default_value(0), "Number of threads generating the NR carrier results in parallel (0 for sequential)")
+    ("scheduler.nr_policy", bpo::value<string>(&args->nr_stack.mac.sched_cfg.sched_policy)->default_value("time_rr"), "NR DL and UL data scheduling policy (E.g. time_rr, time_pf)")
+    ("scheduler.nr_policy_args", bpo::value<string>(&args->nr_stack.mac.sched_cfg.sched_policy_args)->default_value(""), "NR scheduler policy-specific arguments")
     ("expert.nr_pusch_max_its", bpo::value<uint32_t>(&args->phy.nr_pusch_max_its)->default_value(10),     "Maximum number of LDPC iterations for NR.")
   ;
 
@@ -374,6 +420,18 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     }
   }
 
+  // Check log file format
+  if (args->log.file_format != "text" and args->log.file_format != "binary") {
+    fprintf(stderr,
+            "log.file_format = %s. Value is not supported, only text or binary are allowed\n",
+            args->log.file_format.c_str());
+    exit(1);
+  }
+  if (args->log.file_format == "binary" and args->log.file_max_size > 0) {
+    fprintf(stderr, "log.file_max_size is ignored with binary log files, which are written into a single file\n");
+    args->log.file_max_size = -1;
+  }
+
   // Check PRACH workers
   if (args->phy.nof_prach_threads > 1) {
     fprintf(stderr,
@@ -401,6 +459,28 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     cout << "Error, invalid CFR mode: " << cfr_mode << endl;
     exit(1);
   }
+  args->phy.cfr_args.filter = srsran_cfr_str2filter(cfr_filter.c_str());
+  if (args->phy.cfr_args.filter == SRSRAN_CFR_NOF_FILTERS) {
+    cout << "Error, invalid CFR filter: " << cfr_filter << endl;
+    exit(1);
+  }
+
+  // Apply the memory profile
+  if (args->general.mem_profile == "compact") {
+    args->stack.mac.softbuffers_on_demand = true;
+    if (args->general.byte_buffer_pool_size == 0) {
+      // Dimension the pool for the preallocated UEs instead of the worst case
+      args->general.byte_buffer_pool_size = std::min(std::max(args->stack.mac.nof_prealloc_ues * 128U, 1024U), 4096U);
+    }
+  } else if (args->general.mem_profile == "default") {
+    args->stack.mac.softbuffers_on_demand = false;
+    if (args->general.byte_buffer_pool_size == 0) {
+      args->general.byte_buffer_pool_size = 4096;
+    }
+  } else {
+    cout << "Error, invalid memory profile: " << args->general.mem_profile << endl;
+    exit(1);
+  }
 
   // Apply all_level to any unset layers
   if (vm.count("log.all_level")) {
@@ -540,6 +620,10 @@ static void execute_cmd(metrics_stdout* metrics, srsenb::enb_command_interface*
     }
     srslog::flush();
     cout << "Flushed log file buffers" << endl;
+  } else if (cmd[0] == "prof") {
+    bool enable = !srsran_stage_prof_is_enabled();
+    srsran_stage_prof_set_enabled(enable);
+    cout << "PHY stage timers " << (enable ? "enabled" : "disabled") << endl;
   } else {
     cout << "Available commands: " << endl;
     cout << "          t: starts console trace" << endl;
@@ -549,6 +633,7 @@ static void execute_cmd(metrics_stdout* metrics, srsenb::enb_command_interface*
     cout << "      sleep: pauses the commmand line operation for a given time in seconds" << endl;
     cout << "          p: starts MAC padding" << endl;
     cout << "      flush: flushes the buffers for the log file" << endl;
+    cout << "       prof: starts/stops the PHY stage timers" << endl;
     cout << endl;
   }
 }
@@ -614,10 +699,14 @@ int main(int argc, char* argv[])
   parse_args(&args, argc, argv);
 
   // Setup the default log sink.
-  srslog::set_default_sink(
-      (args.log.filename == "stdout")
-          ? srslog::fetch_stdout_sink()
-          : srslog::fetch_file_sink(args.log.filename, fixup_log_file_maxsize(args.log.file_max_size)));
+  if (args.log.filename == "stdout") {
+    srslog::set_default_sink(srslog::fetch_stdout_sink());
+  } else if (args.log.file_format == "binary") {
+    srslog::set_default_sink(srslog::fetch_file_sink(args.log.filename, 0, false, srslog::create_binary_formatter()));
+  } else {
+    srslog::set_default_sink(
+        srslog::fetch_file_sink(args.log.filename, fixup_log_file_maxsize(args.log.file_max_size)));
+  }
 
   // Alarms log channel creation.
   srslog::sink&        alarm_sink     = srslog::fetch_file_sink(args.general.alarms_filename, 0, true);
@@ -632,6 +721,8 @@ int main(int argc, char* argv[])
   }
 #endif
 
+  srsran_stage_prof_set_enabled(args.general.phy_stage_prof);
+
   // Start the log backend.
   srslog::init();
 
@@ -659,6 +750,9 @@ int main(int argc, char* argv[])
     srsran::console("Failed to `mlockall`: {}", errno);
   }
 
+  // Create the byte buffer pool with the configured size before any layer fetches it
+  srsran::byte_buffer_pool::get_instance(args.general.byte_buffer_pool_size);
+
   // Create eNB
   unique_ptr<srsenb::enb> enb{new srsenb::enb(srslog::get_default_sink())};
   if (enb->init(args) != SRSRAN_SUCCESS) {
@@ -681,6 +775,17 @@ int main(int argc, char* argv[])
     metricshub.add_listener(&json_metrics);
   }
 
+  srsenb::metrics_prometheus prometheus_metrics(enb.get(), args.general.metrics_prometheus_max_ues);
+  if (args.general.metrics_prometheus_enable) {
+    if (prometheus_metrics.start(args.general.metrics_prometheus_addr, args.general.metrics_prometheus_port)) {
+      metricshub.add_listener(&prometheus_metrics);
+    } else {
+      srsran::console("Failed to serve the metrics in {}:{}\n",
+                      args.general.metrics_prometheus_addr,
+                      args.general.metrics_prometheus_port);
+    }
+  }
+
   // create input thread
   std::thread input(&input_loop, &metrics_screen, (enb_command_interface*)enb.get());
 
@@ -26,6 +26,10 @@ using namespace srsenb;
 
 namespace {
 
+/// Packet latency histogram bin, the bins are the powers of two of the latency in microseconds (see latency_hist_bin).
+DECLARE_METRIC("nof_pkts", metric_bin_nof_pkts, uint32_t, "");
+DECLARE_METRIC_SET("latency_bin", mset_latency_bin, metric_bin_nof_pkts);
+
 /// Bearer container metrics.
 DECLARE_METRIC("bearer_id", metric_bearer_id, uint32_t, "");
 DECLARE_METRIC("qci", metric_qci, uint32_t, "");
@@ -35,6 +39,9 @@ DECLARE_METRIC("dl_latency", metric_dl_latency, float, "");
 DECLARE_METRIC("ul_latency", metric_ul_latency, float, "");
 DECLARE_METRIC("dl_buffered_bytes", metric_dl_buffered_bytes, uint32_t, "");
 DECLARE_METRIC("ul_buffered_bytes", metric_ul_buffered_bytes, uint32_t, "");
+DECLARE_METRIC_LIST("dl_queue_latency_hist", mlist_dl_queue_latency_hist, std::vector<mset_latency_bin>);
+DECLARE_METRIC_LIST("dl_proc_latency_hist", mlist_dl_proc_latency_hist, std::vector<mset_latency_bin>);
+DECLARE_METRIC_LIST("ul_latency_hist", mlist_ul_latency_hist, std::vector<mset_latency_bin>);
 DECLARE_METRIC_SET("bearer_container",
                    mset_bearer_container,
                    metric_bearer_id,
@@ -44,7 +51,10 @@ DECLARE_METRIC_SET("bearer_container",
                    metric_dl_latency,
                    metric_ul_latency,
                    metric_dl_buffered_bytes,
-                   metric_ul_buffered_bytes);
+                   metric_ul_buffered_bytes,
+                   mlist_dl_queue_latency_hist,
+                   mlist_dl_proc_latency_hist,
+                   mlist_ul_latency_hist);
 
 /// UE container metrics.
 DECLARE_METRIC("ue_rnti", metric_ue_rnti, uint32_t, "");
@@ -95,16 +105,137 @@ DECLARE_METRIC("nof_rach", metric_nof_rach, uint32_t, "");
 DECLARE_METRIC_LIST("ue_list", mlist_ues, std::vector<mset_ue_container>);
 DECLARE_METRIC_SET("cell_container", mset_cell_container, metric_carrier_id, metric_pci, metric_nof_rach, mlist_ues);
 
+/// TTI stage container metrics.
+DECLARE_METRIC("nof_tti", metric_bin_nof_tti, uint32_t, "");
+DECLARE_METRIC_SET("slack_bin", mset_slack_bin, metric_bin_nof_tti);
+DECLARE_METRIC("stage", metric_stage, std::string, "");
+DECLARE_METRIC("slack_min", metric_slack_min, float, "");
+DECLARE_METRIC("slack_avg", metric_slack_avg, float, "");
+DECLARE_METRIC_LIST("slack_hist", mlist_slack_hist, std::vector<mset_slack_bin>);
+DECLARE_METRIC_SET("stage_container",
+                   mset_stage_container,
+                   metric_stage,
+                   metric_slack_min,
+                   metric_slack_avg,
+                   mlist_slack_hist);
+
+/// TTI deadline metrics.
+DECLARE_METRIC("nof_tti", metric_nof_tti, uint32_t, "");
+DECLARE_METRIC("nof_late", metric_nof_late, uint32_t, "");
+DECLARE_METRIC("slack_hist_bin", metric_slack_hist_bin, uint32_t, "");
+DECLARE_METRIC_LIST("stage_list", mlist_stages, std::vector<mset_stage_container>);
+DECLARE_METRIC_SET("tti_deadline",
+                   mset_tti_deadline,
+                   metric_nof_tti,
+                   metric_nof_late,
+                   metric_slack_hist_bin,
+                   mlist_stages);
+
+/// PHY stage timer metrics.
+DECLARE_METRIC("nof_meas", metric_bin_nof_meas, uint64_t, "");
+DECLARE_METRIC_SET("time_bin", mset_time_bin, metric_bin_nof_meas);
+DECLARE_METRIC("nof_meas", metric_nof_meas, uint64_t, "");
+DECLARE_METRIC("time_avg", metric_time_avg, double, "");
+DECLARE_METRIC("time_max", metric_time_max, double, "");
+DECLARE_METRIC_LIST("time_hist", mlist_time_hist, std::vector<mset_time_bin>);
+DECLARE_METRIC_SET("phy_stage_container",
+                   mset_phy_stage_container,
+                   metric_stage,
+                   metric_nof_meas,
+                   metric_time_avg,
+                   metric_time_max,
+                   mlist_time_hist);
+DECLARE_METRIC_LIST("phy_stage_list", mlist_phy_stages, std::vector<mset_phy_stage_container>);
+
+/// GTP-U tunnel container metrics.
+DECLARE_METRIC("teid_in", metric_teid_in, uint32_t, "");
+DECLARE_METRIC("teid_out", metric_teid_out, uint32_t, "");
+DECLARE_METRIC("dl_bytes", metric_tunnel_dl_bytes, uint64_t, "");
+DECLARE_METRIC("dl_pkts", metric_tunnel_dl_pkts, uint64_t, "");
+DECLARE_METRIC("ul_bytes", metric_tunnel_ul_bytes, uint64_t, "");
+DECLARE_METRIC("ul_pkts", metric_tunnel_ul_pkts, uint64_t, "");
+DECLARE_METRIC("dropped_pkts", metric_tunnel_dropped_pkts, uint64_t, "");
+DECLARE_METRIC("fwd_pkts", metric_tunnel_fwd_pkts, uint64_t, "");
+DECLARE_METRIC("buffered_pkts", metric_tunnel_buffered_pkts, uint64_t, "");
+DECLARE_METRIC_SET("gtpu_tunnel_container",
+                   mset_gtpu_tunnel_container,
+                   metric_ue_rnti,
+                   metric_bearer_id,
+                   metric_teid_in,
+                   metric_teid_out,
+                   metric_tunnel_dl_bytes,
+                   metric_tunnel_dl_pkts,
+                   metric_tunnel_ul_bytes,
+                   metric_tunnel_ul_pkts,
+                   metric_tunnel_dropped_pkts,
+                   metric_tunnel_fwd_pkts,
+                   metric_tunnel_buffered_pkts);
+DECLARE_METRIC_LIST("gtpu_tunnel_list", mlist_gtpu_tunnels, std::vector<mset_gtpu_tunnel_container>);
+
+/// Traffic generator flow container metrics.
+DECLARE_METRIC_SET("traffic_gen_flow_container",
+                   mset_traffic_gen_flow_container,
+                   metric_ue_rnti,
+                   metric_bearer_id,
+                   metric_tunnel_dl_bytes,
+                   metric_tunnel_dl_pkts,
+                   metric_tunnel_ul_bytes,
+                   metric_tunnel_ul_pkts,
+                   metric_tunnel_dropped_pkts);
+DECLARE_METRIC_LIST("traffic_gen_flow_list", mlist_traffic_gen_flows, std::vector<mset_traffic_gen_flow_container>);
+
+/// Memory metrics.
+DECLARE_METRIC("phy_bytes", metric_mem_phy_bytes, uint64_t, "");
+DECLARE_METRIC("softbuffer_bytes", metric_mem_softbuffer_bytes, uint64_t, "");
+DECLARE_METRIC("byte_buffer_pool_bytes", metric_mem_pool_bytes, uint64_t, "");
+DECLARE_METRIC("rlc_bytes", metric_mem_rlc_bytes, uint64_t, "");
+DECLARE_METRIC("rrc_bytes", metric_mem_rrc_bytes, uint64_t, "");
+DECLARE_METRIC_SET("mem_cell_container", mset_mem_cell_container, metric_carrier_id, metric_mem_phy_bytes);
+DECLARE_METRIC_LIST("cell_list", mlist_mem_cells, std::vector<mset_mem_cell_container>);
+DECLARE_METRIC_SET("mem_ue_container",
+                   mset_mem_ue_container,
+                   metric_ue_rnti,
+                   metric_mem_softbuffer_bytes,
+                   metric_mem_rlc_bytes,
+                   metric_mem_rrc_bytes);
+DECLARE_METRIC_LIST("ue_list", mlist_mem_ues, std::vector<mset_mem_ue_container>);
+DECLARE_METRIC_SET("memory",
+                   mset_memory,
+                   metric_mem_phy_bytes,
+                   metric_mem_softbuffer_bytes,
+                   metric_mem_pool_bytes,
+                   metric_mem_rlc_bytes,
+                   metric_mem_rrc_bytes,
+                   mlist_mem_cells,
+                   mlist_mem_ues);
+
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
 DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
 DECLARE_METRIC_LIST("cell_list", mlist_cell, std::vector<mset_cell_container>);
 
 /// Metrics context.
-using metric_context_t = srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell>;
+using metric_context_t = srslog::build_context_type<metric_type_tag,
+                                                    metric_timestamp_tag,
+                                                    mlist_cell,
+                                                    mset_tti_deadline,
+                                                    mlist_phy_stages,
+                                                    mlist_gtpu_tunnels,
+                                                    mlist_traffic_gen_flows,
+                                                    mset_memory>;
 
 } // namespace
 
+/// Fill a packet latency histogram list from the bins of the metrics.
+template <typename List>
+static void fill_latency_hist(List& list, const uint32_t* hist)
+{
+  list.resize(srsran::latency_hist_len);
+  for (uint32_t i = 0; i != srsran::latency_hist_len; ++i) {
+    list[i].template write<metric_bin_nof_pkts>(hist[i]);
+  }
+}
+
 /// Fill the metrics for the i'th UE in the enb metrics struct.
 static void fill_ue_metrics(mset_ue_container& ue, const enb_metrics_t& m, unsigned i)
 {
@@ -171,6 +302,128 @@ static void fill_ue_metrics(mset_ue_container& ue, const enb_metrics_t& m, unsig
     bearer_container.write<metric_ul_latency>(rlc_bearer[drb.first].rx_latency_ms / 1e3);
     bearer_container.write<metric_dl_buffered_bytes>(pdcp_bearer[drb.first].num_tx_buffered_pdus_bytes);
     bearer_container.write<metric_ul_buffered_bytes>(rlc_bearer[drb.first].rx_buffered_bytes);
+    // Latency histograms: DL RLC queueing, DL upper stack processing up to the RLC queue and UL RLC to GTP-U.
+    fill_latency_hist(bearer_container.get<mlist_dl_queue_latency_hist>(), rlc_bearer[drb.first].tx_queue_latency_hist);
+    fill_latency_hist(bearer_container.get<mlist_dl_proc_latency_hist>(), rlc_bearer[drb.first].tx_proc_latency_hist);
+    fill_latency_hist(bearer_container.get<mlist_ul_latency_hist>(), pdcp_bearer[drb.first].rx_latency_hist);
+  }
+}
+
+/// Fill the TTI deadline metrics of the PHY workers, the slacks are in microseconds.
+static void fill_tti_deadline_metrics(mset_tti_deadline& deadline, const tti_deadline_metrics_t& m)
+{
+  static const char* stage_names[tti_nof_stages] = {"ul", "stack", "dl", "tx"};
+
+  deadline.write<metric_nof_tti>(m.nof_tti);
+  deadline.write<metric_nof_late>(m.nof_late);
+  deadline.write<metric_slack_hist_bin>(tti_slack_hist_bin_us);
+
+  auto& stage_list = deadline.get<mlist_stages>();
+  stage_list.resize(tti_nof_stages);
+  for (uint32_t i = 0; i != tti_nof_stages; ++i) {
+    auto& stage = stage_list[i];
+    stage.write<metric_stage>(stage_names[i]);
+    if (m.nof_tti > 0) {
+      stage.write<metric_slack_min>(m.stage[i].slack_min_us);
+      stage.write<metric_slack_avg>(m.stage[i].slack_avg_us);
+    }
+    auto& hist = stage.get<mlist_slack_hist>();
+    hist.resize(tti_slack_hist_len);
+    for (uint32_t j = 0; j != tti_slack_hist_len; ++j) {
+      hist[j].write<metric_bin_nof_tti>(m.stage[i].slack_hist[j]);
+    }
+  }
+}
+
+/// Fill the PHY stage timer metrics, the times are in microseconds and the histogram bins are powers of two of them.
+static void fill_phy_stage_metrics(mlist_phy_stages& stage_list, const srsran_stage_prof_metrics_t* m)
+{
+  // Nothing is reported while the stage timers are disabled
+  if (!srsran_stage_prof_is_enabled()) {
+    stage_list.clear();
+    return;
+  }
+
+  stage_list.resize(SRSRAN_STAGE_PROF_NOF);
+  for (uint32_t i = 0; i != SRSRAN_STAGE_PROF_NOF; ++i) {
+    auto& stage = stage_list[i];
+    stage.write<metric_stage>(srsran_stage_prof_name(static_cast<srsran_stage_prof_t>(i)));
+    stage.write<metric_nof_meas>(m[i].count);
+    if (m[i].count > 0) {
+      stage.write<metric_time_avg>(m[i].total_us / m[i].count);
+      stage.write<metric_time_max>(m[i].max_us);
+    }
+    auto& hist = stage.get<mlist_time_hist>();
+    hist.resize(SRSRAN_STAGE_PROF_HIST_LEN);
+    for (uint32_t j = 0; j != SRSRAN_STAGE_PROF_HIST_LEN; ++j) {
+      hist[j].write<metric_bin_nof_meas>(m[i].hist[j]);
+    }
+  }
+}
+
+/// Fill the counters of the GTP-U tunnels.
+static void fill_gtpu_tunnel_metrics(mlist_gtpu_tunnels& tunnel_list, const gtpu_metrics_t& m)
+{
+  tunnel_list.resize(m.tunnels.size());
+  for (size_t i = 0; i != m.tunnels.size(); ++i) {
+    const gtpu_tunnel_metrics_t& tun       = m.tunnels[i];
+    auto&                        container = tunnel_list[i];
+    container.write<metric_ue_rnti>(tun.rnti);
+    container.write<metric_bearer_id>(tun.eps_bearer_id);
+    container.write<metric_teid_in>(tun.teid_in);
+    container.write<metric_teid_out>(tun.teid_out);
+    container.write<metric_tunnel_dl_bytes>(tun.dl_bytes);
+    container.write<metric_tunnel_dl_pkts>(tun.dl_pkts);
+    container.write<metric_tunnel_ul_bytes>(tun.ul_bytes);
+    container.write<metric_tunnel_ul_pkts>(tun.ul_pkts);
+    container.write<metric_tunnel_dropped_pkts>(tun.dropped_pkts);
+    container.write<metric_tunnel_fwd_pkts>(tun.fwd_pkts);
+    container.write<metric_tunnel_buffered_pkts>(tun.buffered_pkts);
+  }
+}
+
+/// Fill the counters of the traffic generator flows of both stacks.
+static void fill_traffic_gen_metrics(mlist_traffic_gen_flows& flow_list, const enb_metrics_t& m)
+{
+  flow_list.clear();
+  for (const traffic_gen_metrics_t* tgen : {&m.stack.traffic_gen, &m.nr_stack.traffic_gen}) {
+    for (const traffic_gen_flow_metrics_t& flow : tgen->flows) {
+      flow_list.emplace_back();
+      auto& container = flow_list.back();
+      container.write<metric_ue_rnti>(flow.rnti);
+      container.write<metric_bearer_id>(flow.eps_bearer_id);
+      container.write<metric_tunnel_dl_bytes>(flow.dl_bytes);
+      container.write<metric_tunnel_dl_pkts>(flow.dl_pkts);
+      container.write<metric_tunnel_ul_bytes>(flow.ul_bytes);
+      container.write<metric_tunnel_ul_pkts>(flow.ul_pkts);
+      container.write<metric_tunnel_dropped_pkts>(flow.dl_dropped_pkts);
+    }
+  }
+}
+
+/// Fill the memory held by each subsystem, cell and UE.
+static void fill_mem_metrics(mset_memory& mem, const mem_metrics_t& m)
+{
+  mem.write<metric_mem_phy_bytes>(m.phy_bytes);
+  mem.write<metric_mem_softbuffer_bytes>(m.softbuffer_bytes);
+  mem.write<metric_mem_pool_bytes>(m.byte_buffer_pool_bytes);
+  mem.write<metric_mem_rlc_bytes>(m.rlc_bytes);
+  mem.write<metric_mem_rrc_bytes>(m.rrc_bytes);
+
+  auto& cell_list = mem.get<mlist_mem_cells>();
+  cell_list.resize(m.cell_phy_bytes.size());
+  for (uint32_t i = 0; i != cell_list.size(); ++i) {
+    cell_list[i].write<metric_carrier_id>(i);
+    cell_list[i].write<metric_mem_phy_bytes>(m.cell_phy_bytes[i]);
+  }
+
+  auto& ue_list = mem.get<mlist_mem_ues>();
+  ue_list.resize(m.ues.size());
+  for (uint32_t i = 0; i != ue_list.size(); ++i) {
+    ue_list[i].write<metric_ue_rnti>(m.ues[i].rnti);
+    ue_list[i].write<metric_mem_softbuffer_bytes>(m.ues[i].softbuffer_bytes);
+    ue_list[i].write<metric_mem_rlc_bytes>(m.ues[i].rlc_bytes);
+    ue_list[i].write<metric_mem_rrc_bytes>(m.ues[i].rrc_bytes);
   }
 }
 
@@ -238,6 +491,12 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     }
   }
 
+  fill_tti_deadline_metrics(ctx.get<mset_tti_deadline>(), m.phy_deadline);
+  fill_phy_stage_metrics(ctx.get<mlist_phy_stages>(), m.phy_stages);
+  fill_gtpu_tunnel_metrics(ctx.get<mlist_gtpu_tunnels>(), m.stack.gtpu);
+  fill_traffic_gen_metrics(ctx.get<mlist_traffic_gen_flows>(), m);
+  fill_mem_metrics(ctx.get<mset_memory>(), m.mem);
+
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
   log_c(ctx);
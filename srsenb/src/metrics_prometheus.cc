@@ -0,0 +1,384 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/metrics_prometheus.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace srsenb;
+
+// Expected size of a rendered report, the buffers grow beyond it if needed
+static const size_t report_reserve_size = 256 * 1024;
+
+static const char* tti_stage_names[tti_nof_stages] = {"ul", "stack", "dl", "tx"};
+
+metrics_prometheus::metrics_prometheus(enb_metrics_interface* enb_, uint32_t max_ues_) : enb(enb_), max_ues(max_ues_)
+{
+  back_buffer.reserve(report_reserve_size);
+  front_buffer.reserve(report_reserve_size);
+  send_buffer.reserve(report_reserve_size);
+  ue_idxs.reserve(max_ues);
+
+  // Valid empty report until the first metrics arrive
+  fmt::format_to(front_buffer, "# EOF\n");
+}
+
+metrics_prometheus::~metrics_prometheus()
+{
+  stop();
+}
+
+bool metrics_prometheus::start(const std::string& bind_addr, int port)
+{
+  if (not listen_socket.open_socket(srsran::net_utils::addr_family::ipv4,
+                                    srsran::net_utils::socket_type::stream,
+                                    srsran::net_utils::protocol_type::TCP)) {
+    return false;
+  }
+  if (not listen_socket.reuse_addr() or not listen_socket.bind_addr(bind_addr.c_str(), port) or
+      not listen_socket.start_listen()) {
+    listen_socket.close();
+    return false;
+  }
+
+  running = true;
+  server  = std::thread([this]() { run_server(); });
+  return true;
+}
+
+void metrics_prometheus::stop()
+{
+  if (not running.exchange(false)) {
+    return;
+  }
+  // Unblock the accept() of the server thread
+  ::shutdown(listen_socket.fd(), SHUT_RDWR);
+  server.join();
+  listen_socket.close();
+}
+
+void metrics_prometheus::set_metrics(const enb_metrics_t& m, const uint32_t period_usec)
+{
+  if (!enb) {
+    return;
+  }
+
+  accumulate_histograms(m);
+
+  back_buffer.clear();
+  render(m, back_buffer);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  std::swap(back_buffer, front_buffer);
+}
+
+void metrics_prometheus::accumulate_histograms(const enb_metrics_t& m)
+{
+  nof_tti += m.phy_deadline.nof_tti;
+  nof_late += m.phy_deadline.nof_late;
+  for (uint32_t i = 0; i != tti_nof_stages; ++i) {
+    for (uint32_t j = 0; j != tti_slack_hist_len; ++j) {
+      slack_hist[i][j] += m.phy_deadline.stage[i].slack_hist[j];
+    }
+  }
+
+  for (uint32_t i = 0; i != SRSRAN_STAGE_PROF_NOF; ++i) {
+    phy_stages[i].count += m.phy_stages[i].count;
+    phy_stages[i].total_us += m.phy_stages[i].total_us;
+    phy_stages[i].max_us = std::max(phy_stages[i].max_us, m.phy_stages[i].max_us);
+    for (uint32_t j = 0; j != SRSRAN_STAGE_PROF_HIST_LEN; ++j) {
+      phy_stage_hist[i][j] += m.phy_stages[i].hist[j];
+    }
+  }
+}
+
+/// Writes the metadata lines of a metric family.
+static void render_family(fmt::memory_buffer& buffer, const char* name, const char* type, const char* help)
+{
+  fmt::format_to(buffer, "# TYPE {} {}\n# HELP {} {}\n", name, type, name, help);
+}
+
+void metrics_prometheus::render(const enb_metrics_t& m, fmt::memory_buffer& buffer)
+{
+  render_cells(m, buffer);
+  render_ues(m, buffer);
+  render_memory(m, buffer);
+  render_tti_deadline(buffer);
+  render_phy_stages(buffer);
+  fmt::format_to(buffer, "# EOF\n");
+}
+
+void metrics_prometheus::render_cells(const enb_metrics_t& m, fmt::memory_buffer& buffer)
+{
+  const auto& cc_info = m.stack.mac.cc_info;
+  const auto& ues     = m.stack.mac.ues;
+
+  render_family(buffer, "srsenb_cell_rach", "gauge", "RACH attempts in the last report period.");
+  for (uint32_t cc = 0; cc != cc_info.size(); ++cc) {
+    fmt::format_to(buffer,
+                   "srsenb_cell_rach{{cell=\"{}\",pci=\"{}\"}} {}\n",
+                   cc,
+                   cc_info[cc].pci,
+                   cc_info[cc].cc_rach_counter);
+  }
+
+  // The cell totals include every UE, also the ones left out of the per UE series
+  render_family(buffer, "srsenb_cell_ues", "gauge", "Connected UEs.");
+  for (uint32_t cc = 0; cc != cc_info.size(); ++cc) {
+    auto nof_ues = std::count_if(ues.begin(), ues.end(), [cc](const mac_ue_metrics_t& u) { return u.cc_idx == cc; });
+    fmt::format_to(buffer, "srsenb_cell_ues{{cell=\"{}\",pci=\"{}\"}} {}\n", cc, cc_info[cc].pci, nof_ues);
+  }
+
+  const char* dir_names[2] = {"dl", "ul"};
+  render_family(buffer, "srsenb_cell_bitrate_bps", "gauge", "MAC throughput of all the UEs in the cell.");
+  for (uint32_t cc = 0; cc != cc_info.size(); ++cc) {
+    double brate[2] = {};
+    for (const mac_ue_metrics_t& u : ues) {
+      if (u.cc_idx == cc and u.nof_tti > 0) {
+        brate[0] += u.tx_brate / (u.nof_tti * 0.001);
+        brate[1] += u.rx_brate / (u.nof_tti * 0.001);
+      }
+    }
+    for (uint32_t d = 0; d != 2; ++d) {
+      fmt::format_to(buffer,
+                     "srsenb_cell_bitrate_bps{{cell=\"{}\",pci=\"{}\",dir=\"{}\"}} {:.0f}\n",
+                     cc,
+                     cc_info[cc].pci,
+                     dir_names[d],
+                     brate[d]);
+    }
+  }
+}
+
+void metrics_prometheus::render_ues(const enb_metrics_t& m, fmt::memory_buffer& buffer)
+{
+  const auto& ues = m.stack.mac.ues;
+
+  // Select the UEs with per UE series, keeping the label cardinality bounded
+  ue_idxs.clear();
+  for (uint32_t i = 0; i != ues.size() and ue_idxs.size() < max_ues; ++i) {
+    if (i < m.phy.size()) {
+      ue_idxs.push_back(i);
+    }
+  }
+
+  // Samples of the same family must be contiguous, so each family loops over the selected UEs
+  auto render_ue_family = [&](const char* name, const char* help, auto&& get_value) {
+    render_family(buffer, name, "gauge", help);
+    for (uint32_t i : ue_idxs) {
+      double value = get_value(i);
+      if (std::isnan(value)) {
+        continue;
+      }
+      fmt::format_to(buffer, "{}{{cell=\"{}\",rnti=\"0x{:x}\"}} {}\n", name, ues[i].cc_idx, ues[i].rnti, value);
+    }
+  };
+
+  render_ue_family("srsenb_ue_dl_cqi", "Average DL CQI.", [&](uint32_t i) { return ues[i].dl_cqi; });
+  render_ue_family("srsenb_ue_dl_mcs", "Average DL MCS.", [&](uint32_t i) { return m.phy[i].dl.mcs; });
+  render_ue_family("srsenb_ue_dl_bitrate_bps", "DL MAC throughput.", [&](uint32_t i) {
+    return (ues[i].nof_tti > 0) ? ues[i].tx_brate / (ues[i].nof_tti * 0.001) : 0.0;
+  });
+  render_ue_family("srsenb_ue_dl_bler_ratio", "DL block error ratio.", [&](uint32_t i) {
+    return (ues[i].tx_pkts > 0) ? (double)ues[i].tx_errors / ues[i].tx_pkts : 0.0;
+  });
+  render_ue_family("srsenb_ue_ul_snr_db", "Average PUSCH SINR.", [&](uint32_t i) { return m.phy[i].ul.pusch_sinr; });
+  render_ue_family("srsenb_ue_ul_mcs", "Average UL MCS.", [&](uint32_t i) { return m.phy[i].ul.mcs; });
+  render_ue_family("srsenb_ue_ul_bitrate_bps", "UL MAC throughput.", [&](uint32_t i) {
+    return (ues[i].nof_tti > 0) ? ues[i].rx_brate / (ues[i].nof_tti * 0.001) : 0.0;
+  });
+  render_ue_family("srsenb_ue_ul_bler_ratio", "UL block error ratio.", [&](uint32_t i) {
+    return (ues[i].rx_pkts > 0) ? (double)ues[i].rx_errors / ues[i].rx_pkts : 0.0;
+  });
+  render_ue_family("srsenb_ue_ul_phr_db", "Average power headroom.", [&](uint32_t i) { return ues[i].phr; });
+  render_ue_family("srsenb_ue_ul_bsr_bytes", "UL buffer status.", [&](uint32_t i) { return ues[i].ul_buffer; });
+  render_ue_family("srsenb_ue_dl_buffer_bytes", "DL RLC buffer occupancy.", [&](uint32_t i) {
+    return ues[i].dl_buffer;
+  });
+
+  // The memory metrics of the UEs follow the order of the MAC ones
+  const auto& mem_ues = m.mem.ues;
+  render_ue_family("srsenb_ue_softbuffer_bytes", "Memory of the HARQ soft-buffers.", [&](uint32_t i) {
+    return (i < mem_ues.size()) ? (double)mem_ues[i].softbuffer_bytes : NAN;
+  });
+  render_ue_family("srsenb_ue_rlc_memory_bytes", "Memory of the RLC bearers.", [&](uint32_t i) {
+    return (i < mem_ues.size()) ? (double)mem_ues[i].rlc_bytes : NAN;
+  });
+  render_ue_family("srsenb_ue_rrc_memory_bytes", "Memory of the RRC context.", [&](uint32_t i) {
+    return (i < mem_ues.size()) ? (double)mem_ues[i].rrc_bytes : NAN;
+  });
+}
+
+void metrics_prometheus::render_memory(const enb_metrics_t& m, fmt::memory_buffer& buffer)
+{
+  const mem_metrics_t& mem = m.mem;
+
+  render_family(buffer, "srsenb_memory_bytes", "gauge", "Memory held by each subsystem.");
+  const std::pair<const char*, uint64_t> subsystems[] = {{"phy", mem.phy_bytes},
+                                                         {"softbuffer", mem.softbuffer_bytes},
+                                                         {"byte_buffer_pool", mem.byte_buffer_pool_bytes},
+                                                         {"rlc", mem.rlc_bytes},
+                                                         {"rrc", mem.rrc_bytes}};
+  for (const auto& s : subsystems) {
+    fmt::format_to(buffer, "srsenb_memory_bytes{{subsystem=\"{}\"}} {}\n", s.first, s.second);
+  }
+
+  render_family(buffer, "srsenb_cell_phy_memory_bytes", "gauge", "Memory of the PHY worker buffers of the cell.");
+  for (uint32_t cc = 0; cc != mem.cell_phy_bytes.size(); ++cc) {
+    fmt::format_to(buffer, "srsenb_cell_phy_memory_bytes{{cell=\"{}\"}} {}\n", cc, mem.cell_phy_bytes[cc]);
+  }
+}
+
+void metrics_prometheus::render_tti_deadline(fmt::memory_buffer& buffer)
+{
+  render_family(buffer, "srsenb_tti", "counter", "TTIs processed by the PHY workers.");
+  fmt::format_to(buffer, "srsenb_tti_total {}\n", nof_tti);
+  render_family(buffer, "srsenb_tti_late", "counter", "TTIs handed to the radio after their transmission time.");
+  fmt::format_to(buffer, "srsenb_tti_late_total {}\n", nof_late);
+
+  // The first bin counts the late TTIs, bin j > 0 the slacks below j bin widths. There is no _sum, as the late TTIs
+  // are negative observations
+  render_family(buffer,
+                "srsenb_tti_slack_microseconds",
+                "histogram",
+                "Time left before the transmission when each TTI processing stage completes.");
+  for (uint32_t i = 0; i != tti_nof_stages; ++i) {
+    uint64_t cumulative = 0;
+    for (uint32_t j = 0; j != tti_slack_hist_len; ++j) {
+      cumulative += slack_hist[i][j];
+      if (j + 1 == tti_slack_hist_len) {
+        fmt::format_to(buffer,
+                       "srsenb_tti_slack_microseconds_bucket{{stage=\"{}\",le=\"+Inf\"}} {}\n",
+                       tti_stage_names[i],
+                       cumulative);
+      } else {
+        fmt::format_to(buffer,
+                       "srsenb_tti_slack_microseconds_bucket{{stage=\"{}\",le=\"{}.0\"}} {}\n",
+                       tti_stage_names[i],
+                       j * tti_slack_hist_bin_us,
+                       cumulative);
+      }
+    }
+    fmt::format_to(buffer, "srsenb_tti_slack_microseconds_count{{stage=\"{}\"}} {}\n", tti_stage_names[i], cumulative);
+  }
+}
+
+void metrics_prometheus::render_phy_stages(fmt::memory_buffer& buffer)
+{
+  // Nothing is reported while the stage timers are disabled
+  if (!srsran_stage_prof_is_enabled()) {
+    return;
+  }
+
+  // The first bin counts the times below 1 us, bin i > 0 the ones below 2^i us
+  render_family(buffer, "srsenb_phy_stage_microseconds", "histogram", "Processing time of the PHY stages.");
+  for (uint32_t i = 0; i != SRSRAN_STAGE_PROF_NOF; ++i) {
+    const char* name       = srsran_stage_prof_name(static_cast<srsran_stage_prof_t>(i));
+    uint64_t    cumulative = 0;
+    for (uint32_t j = 0; j != SRSRAN_STAGE_PROF_HIST_LEN; ++j) {
+      cumulative += phy_stage_hist[i][j];
+      if (j + 1 == SRSRAN_STAGE_PROF_HIST_LEN) {
+        fmt::format_to(
+            buffer, "srsenb_phy_stage_microseconds_bucket{{stage=\"{}\",le=\"+Inf\"}} {}\n", name, cumulative);
+      } else {
+        fmt::format_to(
+            buffer, "srsenb_phy_stage_microseconds_bucket{{stage=\"{}\",le=\"{}.0\"}} {}\n", name, 1u << j, cumulative);
+      }
+    }
+    fmt::format_to(buffer, "srsenb_phy_stage_microseconds_count{{stage=\"{}\"}} {}\n", name, phy_stages[i].count);
+    fmt::format_to(buffer, "srsenb_phy_stage_microseconds_sum{{stage=\"{}\"}} {:.1f}\n", name, phy_stages[i].total_us);
+  }
+
+  render_family(buffer, "srsenb_phy_stage_max_microseconds", "gauge", "Longest processing time of the PHY stages.");
+  for (uint32_t i = 0; i != SRSRAN_STAGE_PROF_NOF; ++i) {
+    fmt::format_to(buffer,
+                   "srsenb_phy_stage_max_microseconds{{stage=\"{}\"}} {:.1f}\n",
+                   srsran_stage_prof_name(static_cast<srsran_stage_prof_t>(i)),
+                   phy_stages[i].max_us);
+  }
+}
+
+void metrics_prometheus::run_server()
+{
+  while (running) {
+    int fd = ::accept(listen_socket.fd(), nullptr, nullptr);
+    if (fd < 0) {
+      continue;
+    }
+    serve_client(fd);
+    ::close(fd);
+  }
+}
+
+/// Sends the whole buffer, returns false on error.
+static bool send_all(int fd, const char* data, size_t len)
+{
+  while (len > 0) {
+    ssize_t n = ::send(fd, data, len, MSG_NOSIGNAL);
+    if (n <= 0) {
+      return false;
+    }
+    data += n;
+    len -= n;
+  }
+  return true;
+}
+
+void metrics_prometheus::serve_client(int fd)
+{
+  // Do not let a stalled client block the scrapes of the others
+  struct timeval tv = {1, 0};
+  ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+  // Only the request line matters, the rest of the request is ignored
+  char    request[1024];
+  ssize_t n = ::recv(fd, request, sizeof(request) - 1, 0);
+  if (n <= 0) {
+    return;
+  }
+  request[n] = '\0';
+
+  if (strncmp(request, "GET ", 4) != 0) {
+    const char* reply = "HTTP/1.1 405 Method Not Allowed\r\n"
+                        "Allow: GET\r\n"
+                        "Content-Length: 0\r\n"
+                        "Connection: close\r\n\r\n";
+    send_all(fd, reply, strlen(reply));
+    return;
+  }
+
+  send_buffer.clear();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    fmt::format_to(send_buffer,
+                   "HTTP/1.1 200 OK\r\n"
+                   "Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n"
+                   "Content-Length: {}\r\n"
+                   "Connection: close\r\n\r\n",
+                   front_buffer.size());
+    send_buffer.append(front_buffer.data(), front_buffer.data() + front_buffer.size());
+  }
+  send_all(fd, send_buffer.data(), send_buffer.size());
+}
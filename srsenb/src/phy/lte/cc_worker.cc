@@ -19,7 +19,10 @@
  *
  */
 
+#include <atomic>
+#include <condition_variable>
 #include <iomanip>
+#include <mutex>
 
 #include "srsran/common/threads.h"
 #include "srsran/srsran.h"
@@ -61,8 +64,24 @@ cc_worker::cc_worker(srslog::basic_logger& logger) : logger(logger)
   reset();
 }
 
+cc_worker::grant_lane_t::~grant_lane_t()
+{
+  srsran_pdsch_free(&pdsch);
+  srsran_pusch_free(&pusch);
+  srsran_chest_ul_free(&chest);
+  if (chest_res.ce) {
+    free(chest_res.ce);
+  }
+}
+
 cc_worker::~cc_worker()
 {
+  // The helpers shall not be running while their lanes are released
+  if (grant_pool) {
+    grant_pool->stop();
+  }
+  grant_lanes.clear();
+
   srsran_softbuffer_tx_free(&temp_mbsfn_softbuffer);
   srsran_enb_dl_free(&enb_dl);
   srsran_enb_ul_free(&enb_ul);
@@ -155,6 +174,17 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
   if (phy->params.pusch_8bit_decoder) {
     enb_ul.pusch.llr_is_8bit        = true;
     enb_ul.pusch.ul_sch.llr_is_8bit = true;
+
+    // Decode the code blocks of all the PUSCH grants together
+    if (srsran_enb_ul_enable_deferred_pusch(&enb_ul, true)) {
+      ERROR("Error enabling deferred PUSCH decoding");
+      exit(-1);
+    }
+  }
+
+  if (not init_grant_lanes(phy->params.nof_grant_threads, cell, nof_prb)) {
+    ERROR("Error initiating the PDSCH/PUSCH grant lanes");
+    exit(-1);
   }
   initiated = true;
 
@@ -163,6 +193,86 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
 #endif
 }
 
+bool cc_worker::init_grant_lanes(uint32_t nof_lanes, srsran_cell_t cell, uint32_t nof_prb)
+{
+  for (uint32_t i = 0; i < nof_lanes; i++) {
+    std::unique_ptr<grant_lane_t> lane(new grant_lane_t);
+
+    if (srsran_pdsch_init_enb(&lane->pdsch, nof_prb) < SRSRAN_SUCCESS or
+        srsran_pdsch_set_cell(&lane->pdsch, cell) < SRSRAN_SUCCESS) {
+      return false;
+    }
+    if (srsran_pusch_init_enb(&lane->pusch, nof_prb) < SRSRAN_SUCCESS or
+        srsran_pusch_set_cell(&lane->pusch, cell) < SRSRAN_SUCCESS) {
+      return false;
+    }
+    if (srsran_chest_ul_init(&lane->chest, nof_prb) < SRSRAN_SUCCESS or
+        srsran_chest_ul_set_cell(&lane->chest, cell) < SRSRAN_SUCCESS) {
+      return false;
+    }
+    srsran_chest_ul_pregen(&lane->chest, &phy->dmrs_pusch_cfg, nullptr);
+
+    lane->chest_res.ce = srsran_vec_cf_malloc(SRSRAN_SF_LEN_RE(nof_prb, SRSRAN_CP_NORM));
+    if (lane->chest_res.ce == nullptr) {
+      return false;
+    }
+
+    // Same decoder options as the PUSCH in enb_ul
+    lane->pusch.llr_is_8bit        = enb_ul.pusch.llr_is_8bit;
+    lane->pusch.ul_sch.llr_is_8bit = enb_ul.pusch.ul_sch.llr_is_8bit;
+    if (phy->params.pusch_8bit_decoder and srsran_sch_enable_deferred_decoding(&lane->pusch.ul_sch, true)) {
+      return false;
+    }
+
+    grant_lanes.push_back(std::move(lane));
+  }
+
+  if (nof_lanes > 0) {
+    grant_pool.reset(new srsran::task_thread_pool(nof_lanes, false, GRANT_THREAD_PRIO));
+  }
+
+  return true;
+}
+
+void cc_worker::run_grant_lanes(uint32_t                                      nof_grants,
+                                const std::function<void(uint32_t, uint32_t)>& process,
+                                const std::function<void(uint32_t)>&           finish)
+{
+  struct context_t {
+    std::atomic<uint32_t>   next        = {0};
+    uint32_t                nof_running = 0;
+    std::mutex              mutex;
+    std::condition_variable cvar;
+  } ctx;
+
+  // Every lane takes the next grant until all of them are processed
+  auto work = [&ctx, &process, &finish, nof_grants](uint32_t lane) {
+    for (uint32_t i = ctx.next++; i < nof_grants; i = ctx.next++) {
+      process(lane, i);
+    }
+    finish(lane);
+  };
+
+  // The worker takes lane 0, so the helpers are only woken up when there is more than one grant
+  uint32_t nof_helpers = std::min((uint32_t)grant_lanes.size(), nof_grants > 1 ? nof_grants - 1 : 0);
+  ctx.nof_running      = nof_helpers;
+  for (uint32_t lane = 1; lane <= nof_helpers; lane++) {
+    grant_pool->push_task([&ctx, &work, lane]() {
+      work(lane);
+
+      // Notify while holding the lock, the context is released as soon as the worker sees the count reaching zero
+      std::lock_guard<std::mutex> lock(ctx.mutex);
+      ctx.nof_running--;
+      ctx.cvar.notify_one();
+    });
+  }
+
+  work(0);
+
+  std::unique_lock<std::mutex> lock(ctx.mutex);
+  ctx.cvar.wait(lock, [&ctx]() { return ctx.nof_running == 0; });
+}
+
 void cc_worker::reset()
 {
   initiated = false;
@@ -222,16 +332,23 @@ void cc_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy
   srsran_enb_ul_fft(&enb_ul);
 
   // Decode pending UL grants for the tti they were scheduled
+  ue_meas.clear();
   decode_pusch(ul_grants.pusch, ul_grants.nof_grants);
 
   // Decode remaining PUCCH ACKs not associated with PUSCH transmission and SR signals
   decode_pucch();
+
+  // Report the measurements of all the UEs at once
+  if (not ue_meas.empty()) {
+    phy->stack->meas_info(ul_sf.tti, ue_meas);
+  }
 }
 
 void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                         stack_interface_phy_lte::dl_sched_t& dl_grants,
                         stack_interface_phy_lte::ul_sched_t& ul_grants,
-                        srsran_mbsfn_cfg_t*                  mbsfn_cfg)
+                        srsran_mbsfn_cfg_t*                  mbsfn_cfg,
+                        pmch_symbols_t&                      pmch_symbols)
 {
   std::lock_guard<std::mutex> lock(mutex);
   dl_sf = dl_sf_cfg;
@@ -245,7 +362,7 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
     encode_pdsch(dl_grants.pdsch, dl_grants.nof_grants);
   } else {
     if (mbsfn_cfg->enable) {
-      encode_pmch(dl_grants.pdsch, mbsfn_cfg);
+      encode_pmch(dl_grants.pdsch, mbsfn_cfg, pmch_symbols);
     }
   }
 
@@ -283,9 +400,9 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
   }
 }
 
-bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
-                                  srsran_ul_cfg_t&                           ul_cfg,
-                                  srsran_pusch_res_t&                        pusch_res)
+bool cc_worker::prepare_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
+                                   srsran_ul_cfg_t&                           ul_cfg,
+                                   bool&                                      uci_required)
 {
   uint16_t rnti = ul_grant.dci.rnti;
 
@@ -307,8 +424,7 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
   }
 
   // Fill UCI configuration
-  bool uci_required =
-      phy->ue_db.fill_uci_cfg(tti_rx, cc_idx, rnti, ul_grant.dci.cqi_request, true, ul_cfg.pusch.uci_cfg);
+  uci_required = phy->ue_db.fill_uci_cfg(tti_rx, cc_idx, rnti, ul_grant.dci.cqi_request, true, ul_cfg.pusch.uci_cfg);
 
   // Compute UL grant
   srsran_pusch_grant_t& grant = ul_cfg.pusch.grant;
@@ -338,75 +454,133 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
     Error("Error setting last UL TB for RNTI %x, CC %d, PID %d", rnti, cc_idx, ul_grant.pid);
   }
 
-  // Run PUSCH decoder
-  ul_cfg.pusch.softbuffers.rx = ul_grant.softbuffer_rx;
-  pusch_res.data              = ul_grant.data;
-  if (pusch_res.data) {
-    if (srsran_enb_ul_get_pusch(&enb_ul, &ul_sf, &ul_cfg.pusch, &pusch_res)) {
-      Error("Decoding PUSCH for RNTI %x", rnti);
-      return false;
-    }
-  }
   // Save PHICH scheduling for this user. Each user can have just 1 PUSCH dci per TTI
   ue_db[rnti]->phich_grant.n_prb_lowest = grant.n_prb_tilde[0];
   ue_db[rnti]->phich_grant.n_dmrs       = ul_grant.dci.n_dmrs;
 
-  float snr_db = enb_ul.chest_res.snr_db;
+  ul_cfg.pusch.softbuffers.rx = ul_grant.softbuffer_rx;
+
+  return true;
+}
+
+bool cc_worker::decode_pusch_rnti(uint32_t lane, srsran_ul_cfg_t& ul_cfg, srsran_pusch_res_t& pusch_res)
+{
+  // Lane 0 keeps using enb_ul, so its channel estimates remain available to the plots
+  if (lane == 0) {
+    return srsran_enb_ul_get_pusch(&enb_ul, &ul_sf, &ul_cfg.pusch, &pusch_res) == SRSRAN_SUCCESS;
+  }
+
+  // The other lanes estimate and decode from the resource grid demodulated by enb_ul
+  grant_lane_t& l = *grant_lanes[lane - 1];
+  srsran_chest_ul_estimate_pusch(&l.chest, &ul_sf, &ul_cfg.pusch, enb_ul.sf_symbols, &l.chest_res);
+  return srsran_pusch_decode(&l.pusch, &ul_sf, &ul_cfg.pusch, &l.chest_res, enb_ul.sf_symbols, &pusch_res) ==
+         SRSRAN_SUCCESS;
+}
+
+void cc_worker::report_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
+                                  srsran_ul_cfg_t&                           ul_cfg,
+                                  srsran_pusch_res_t&                        pusch_res,
+                                  const srsran_chest_ul_res_t&               chest_res,
+                                  bool                                       uci_required)
+{
+  uint16_t rnti   = ul_grant.dci.rnti;
+  float    snr_db = chest_res.snr_db;
 
   // Notify MAC of RL status
   if (snr_db >= PUSCH_RL_SNR_DB_TH) {
     // Notify MAC UL channel quality
-    phy->stack->snr_info(ul_sf.tti, rnti, cc_idx, snr_db, mac_interface_phy_lte::PUSCH);
+    ue_meas.emplace_back();
+    ue_meas.back().rnti   = rnti;
+    ue_meas.back().cc_idx = cc_idx;
+    ue_meas.back().ch     = mac_interface_phy_lte::PUSCH;
+    ue_meas.back().snr_db = snr_db;
 
     // Notify MAC of Time Alignment only if it enabled and valid measurement, ignore value otherwise
-    if (ul_cfg.pusch.meas_ta_en and not std::isnan(enb_ul.chest_res.ta_us) and not std::isinf(enb_ul.chest_res.ta_us)) {
-      phy->stack->ta_info(ul_sf.tti, rnti, enb_ul.chest_res.ta_us);
+    if (ul_cfg.pusch.meas_ta_en and not std::isnan(chest_res.ta_us) and not std::isinf(chest_res.ta_us)) {
+      ue_meas.back().ta_us = chest_res.ta_us;
     }
   }
 
   // Send UCI data to MAC
   if (uci_required) {
-    phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pusch.uci_cfg, pusch_res.uci);
-  }
-
-  // Save statistics only if data was provided
-  if (ul_grant.data != nullptr) {
-    // Save metrics stats
-    ue_db[rnti]->metrics_ul(ul_grant.dci.tb.mcs_idx,
-                            enb_ul.chest_res.epre_dBfs - phy->params.rx_gain_offset,
-                            enb_ul.chest_res.snr_db,
-                            pusch_res.avg_iterations_block);
+    phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pusch.uci_cfg, pusch_res.uci, &ue_meas);
   }
-  return true;
 }
 
 void cc_worker::decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch)
 {
-  // Iterate over all the grants, all the grants need to report MAC the CRC status
+  // The results must stay in place until the deferred transport blocks are decoded
+  pending_pusch.resize(nof_pusch);
+
+  // Configure all the grants first, the configuration stops at the first grant that can not be decoded
+  uint32_t nof_pending = 0;
   for (uint32_t i = 0; i < nof_pusch; i++) {
-    // Get grant itself and RNTI
-    stack_interface_phy_lte::ul_sched_grant_t& ul_grant = grants[i];
-    uint16_t                                   rnti     = ul_grant.dci.rnti;
+    pusch_pending_t& pending = pending_pusch[nof_pending];
+    pending                  = {};
+    pending.ul_grant         = &grants[i];
 
-    srsran_pusch_res_t pusch_res = {};
-    srsran_ul_cfg_t    ul_cfg    = {};
+    if (!prepare_pusch_rnti(grants[i], pending.ul_cfg, pending.uci_required)) {
+      break;
+    }
+    pending.pusch_res.data = grants[i].data;
+    nof_pending++;
+  }
+
+  // Estimate and decode the grants in parallel, each lane runs the turbo decoder of its grants at once at the end
+  run_grant_lanes(
+      nof_pending,
+      [this](uint32_t lane, uint32_t i) {
+        pusch_pending_t& pending = pending_pusch[i];
+        if (pending.pusch_res.data == nullptr) {
+          pending.decoded = true;
+          return;
+        }
+        pending.decoded = decode_pusch_rnti(lane, pending.ul_cfg, pending.pusch_res);
+
+        // Keep the measurements of this grant, the estimator is reused for the next one
+        pending.chest_res = (lane == 0) ? enb_ul.chest_res : grant_lanes[lane - 1]->chest_res;
+      },
+      [this](uint32_t lane) {
+        int ret = (lane == 0) ? srsran_enb_ul_decode_deferred_pusch(&enb_ul)
+                              : srsran_sch_decode_deferred(&grant_lanes[lane - 1]->pusch.ul_sch);
+        if (ret < SRSRAN_SUCCESS) {
+          Error("Decoding deferred PUSCH");
+        }
+      });
 
-    // Decodes PUSCH for the given grant
-    if (!decode_pusch_rnti(ul_grant, ul_cfg, pusch_res)) {
-      return;
+  for (uint32_t i = 0; i < nof_pending; i++) {
+    pusch_pending_t&                           pending  = pending_pusch[i];
+    stack_interface_phy_lte::ul_sched_grant_t& ul_grant = *pending.ul_grant;
+    uint16_t                                   rnti     = ul_grant.dci.rnti;
+
+    if (!pending.decoded) {
+      Error("Decoding PUSCH for RNTI %x", rnti);
+      continue;
     }
 
+    report_pusch_rnti(ul_grant, pending.ul_cfg, pending.pusch_res, pending.chest_res, pending.uci_required);
+
     // Notify MAC new received data and HARQ Indication value
     if (ul_grant.data != nullptr) {
+      // Save metrics stats
+      ue_db[rnti]->metrics_ul(ul_grant.dci.tb.mcs_idx,
+                              pending.chest_res.epre_dBfs - phy->params.rx_gain_offset,
+                              pending.chest_res.snr_db,
+                              pending.pusch_res.avg_iterations_block);
+
       // Inform MAC about the CRC result
-      phy->stack->crc_info(tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc);
+      phy->stack->crc_info(tti_rx, rnti, cc_idx, pending.ul_cfg.pusch.grant.tb.tbs / 8, pending.pusch_res.crc);
       // Push PDU buffer
-      phy->stack->push_pdu(
-          tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc, ul_cfg.pusch.grant.L_prb);
+      phy->stack->push_pdu(tti_rx,
+                           rnti,
+                           cc_idx,
+                           pending.ul_cfg.pusch.grant.tb.tbs / 8,
+                           pending.pusch_res.crc,
+                           pending.ul_cfg.pusch.grant.L_prb);
       // Logging
       if (logger.info.enabled()) {
         char str[512];
-        srsran_pusch_rx_info(&ul_cfg.pusch, &pusch_res, &enb_ul.chest_res, str, sizeof(str));
+        srsran_pusch_rx_info(&pending.ul_cfg.pusch, &pending.pusch_res, &pending.chest_res, str, sizeof(str));
         logger.info("PUSCH: cc=%d, %s", cc_idx, str);
       }
     }
@@ -445,14 +619,19 @@ int cc_worker::decode_pucch()
         }
 
         // Send UCI data to MAC
-        if (phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pucch.uci_cfg, pucch_res.uci_data) < SRSRAN_SUCCESS) {
+        if (phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pucch.uci_cfg, pucch_res.uci_data, &ue_meas) <
+            SRSRAN_SUCCESS) {
           Error("Error sending UCI data for RNTI %x, CC %d", rnti, cc_idx);
           continue;
         }
 
         if (pucch_res.detected and pucch_res.ta_valid) {
-          phy->stack->ta_info(tti_rx, rnti, pucch_res.ta_us);
-          phy->stack->snr_info(tti_rx, rnti, cc_idx, pucch_res.snr_db, mac_interface_phy_lte::PUCCH);
+          ue_meas.emplace_back();
+          ue_meas.back().rnti   = rnti;
+          ue_meas.back().cc_idx = cc_idx;
+          ue_meas.back().ch     = mac_interface_phy_lte::PUCCH;
+          ue_meas.back().snr_db = pucch_res.snr_db;
+          ue_meas.back().ta_us  = pucch_res.ta_us;
         }
 
         // Logging
@@ -563,7 +742,9 @@ int cc_worker::encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants
   return 0;
 }
 
-int cc_worker::encode_pmch(stack_interface_phy_lte::dl_sched_grant_t* grant, srsran_mbsfn_cfg_t* mbsfn_cfg)
+int cc_worker::encode_pmch(stack_interface_phy_lte::dl_sched_grant_t* grant,
+                           srsran_mbsfn_cfg_t*                        mbsfn_cfg,
+                           pmch_symbols_t&                            pmch_symbols)
 {
   srsran_pmch_cfg_t pmch_cfg;
   ZERO_OBJECT(pmch_cfg);
@@ -573,10 +754,23 @@ int cc_worker::encode_pmch(stack_interface_phy_lte::dl_sched_grant_t* grant, srs
   // Set soft buffer
   pmch_cfg.pdsch_cfg.softbuffers.tx[0] = &temp_mbsfn_softbuffer;
 
-  // Encode PMCH
-  if (srsran_enb_dl_put_pmch(&enb_dl, &pmch_cfg, grant->data[0])) {
-    Error("Error putting PMCH");
-    return SRSRAN_ERROR;
+  // Map the PMCH symbols of another cell of the MBSFN area, if they fit this cell, otherwise encode the PMCH
+  if (pmch_symbols.symbols != nullptr && pmch_symbols.nof_prb == enb_dl.cell.nof_prb &&
+      pmch_symbols.nof_re == pmch_cfg.pdsch_cfg.grant.nof_re) {
+    if (srsran_enb_dl_put_pmch_symbols(&enb_dl, &pmch_cfg, pmch_symbols.symbols)) {
+      Error("Error putting PMCH");
+      return SRSRAN_ERROR;
+    }
+  } else {
+    if (srsran_enb_dl_put_pmch(&enb_dl, &pmch_cfg, grant->data[0])) {
+      Error("Error putting PMCH");
+      return SRSRAN_ERROR;
+    }
+    if (pmch_symbols.symbols == nullptr) {
+      pmch_symbols.symbols = enb_dl.pmch.d;
+      pmch_symbols.nof_prb = enb_dl.cell.nof_prb;
+      pmch_symbols.nof_re  = pmch_cfg.pdsch_cfg.grant.nof_re;
+    }
   }
 
   // Logging
@@ -597,11 +791,18 @@ int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, u
 {
   /* Scales the Resources Elements affected by the power allocation (p_b) */
   // srsran_enb_dl_prepare_power_allocation(&enb_dl);
+  pending_pdsch.resize(nof_grants);
+
+  // Configure all the grants first
+  uint32_t nof_pending = 0;
   for (uint32_t i = 0; i < nof_grants; i++) {
     uint16_t rnti = grants[i].dci.rnti;
 
     if (rnti && ue_db.count(rnti)) {
-      srsran_dl_cfg_t dl_cfg = {};
+      pdsch_pending_t& pending = pending_pdsch[nof_pending];
+      pending                  = {};
+      pending.dl_grant         = &grants[i];
+      srsran_dl_cfg_t& dl_cfg  = pending.dl_cfg;
 
       if (phy->ue_db.get_dl_config(rnti, cc_idx, dl_cfg) < SRSRAN_SUCCESS) {
         Error("Error retrieving DCI DL configuration for RNTI %x, CC %d", grants[i].dci.rnti, cc_idx);
@@ -619,31 +820,55 @@ int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, u
       for (uint32_t j = 0; j < SRSRAN_MAX_CODEWORDS; j++) {
         dl_cfg.pdsch.softbuffers.tx[j] = grants[i].softbuffer_tx[j];
       }
+      nof_pending++;
+    } else {
+      Error("User rnti=0x%x not found in cc_worker=%d", rnti, cc_idx);
+    }
+  }
 
-      // Encode PDSCH
-      if (srsran_enb_dl_put_pdsch(&enb_dl, &dl_cfg.pdsch, grants[i].data)) {
-        Error("Error putting PDSCH %d", i);
-        return SRSRAN_ERROR;
-      }
+  // Encode the grants in parallel, each one is mapped to its own PRB in the resource grid. The DCI of every grant has
+  // been put already, so enb_dl does not take the subframe for one carrying base signals only.
+  run_grant_lanes(
+      nof_pending,
+      [this](uint32_t lane, uint32_t i) {
+        pdsch_pending_t& pending = pending_pdsch[i];
+        if (lane == 0) {
+          pending.ret = srsran_enb_dl_put_pdsch(&enb_dl, &pending.dl_cfg.pdsch, pending.dl_grant->data);
+        } else {
+          pending.ret = srsran_pdsch_encode(&grant_lanes[lane - 1]->pdsch,
+                                            &enb_dl.dl_sf,
+                                            &pending.dl_cfg.pdsch,
+                                            pending.dl_grant->data,
+                                            enb_dl.sf_symbols);
+        }
+      },
+      [](uint32_t lane) {});
 
-      // Save pending ACK
-      if (SRSRAN_RNTI_ISUSER(rnti)) {
-        // Push whole DCI
-        phy->ue_db.set_ack_pending(tti_tx_ul, cc_idx, grants[i].dci);
-      }
+  for (uint32_t i = 0; i < nof_pending; i++) {
+    pdsch_pending_t&                           pending  = pending_pdsch[i];
+    stack_interface_phy_lte::dl_sched_grant_t& dl_grant = *pending.dl_grant;
+    uint16_t                                   rnti     = dl_grant.dci.rnti;
 
-      if (LOG_THIS(rnti) and logger.info.enabled()) {
-        // Logging
-        char str[512];
-        srsran_pdsch_tx_info(&dl_cfg.pdsch, str, 512);
-        logger.info("PDSCH: cc=%d, %s, tti_tx_dl=%d", cc_idx, str, tti_tx_dl);
-      }
+    if (pending.ret) {
+      Error("Error putting PDSCH %d", (int)(pending.dl_grant - grants));
+      return SRSRAN_ERROR;
+    }
 
-      // Save metrics stats
-      ue_db[rnti]->metrics_dl(grants[i].dci.tb[0].mcs_idx);
-    } else {
-      Error("User rnti=0x%x not found in cc_worker=%d", rnti, cc_idx);
+    // Save pending ACK
+    if (SRSRAN_RNTI_ISUSER(rnti)) {
+      // Push whole DCI
+      phy->ue_db.set_ack_pending(tti_tx_ul, cc_idx, dl_grant.dci);
+    }
+
+    if (LOG_THIS(rnti) and logger.info.enabled()) {
+      // Logging
+      char str[512];
+      srsran_pdsch_tx_info(&pending.dl_cfg.pdsch, str, 512);
+      logger.info("PDSCH: cc=%d, %s, tti_tx_dl=%d", cc_idx, str, tti_tx_dl);
     }
+
+    // Save metrics stats
+    ue_db[rnti]->metrics_dl(dl_grant.dci.tb[0].mcs_idx);
   }
 
   // srsran_enb_dl_apply_power_allocation(&enb_dl);
@@ -689,6 +914,7 @@ void cc_worker::ue::metrics_ul(uint32_t mcs, float rssi, float sinr, float turbo
   metrics.ul.pusch_sinr  = SRSRAN_VEC_CMA((float)sinr, metrics.ul.pusch_sinr, metrics.ul.n_samples);
   metrics.ul.pusch_rssi  = SRSRAN_VEC_CMA((float)rssi, metrics.ul.pusch_rssi, metrics.ul.n_samples);
   metrics.ul.turbo_iters = SRSRAN_VEC_CMA((float)turbo_iters, metrics.ul.turbo_iters, metrics.ul.n_samples);
+  metrics.ul.turbo_iters_hist[std::min((uint32_t)std::ceil(turbo_iters), turbo_iters_hist_len - 1)]++;
   metrics.ul.n_samples++;
 }
 
@@ -81,8 +81,12 @@ void sf_worker::init(phy_common* phy_)
     // Create pointer
     auto q = new cc_worker(logger);
 
-    // Initialise
+    // Initialise, accounting the buffers of the carrier to the PHY
+    srsran_mem_tag_t prev_tag = srsran_vec_set_mem_tag(SRSRAN_MEM_TAG_PHY);
+    uint64_t         prev_mem = srsran_vec_get_thread_mem_usage();
     q->init(phy, i);
+    q->set_mem_bytes(srsran_vec_get_thread_mem_usage() - prev_mem);
+    srsran_vec_set_mem_tag(prev_tag);
 
     // Create unique pointer
     cc_workers.push_back(std::unique_ptr<cc_worker>(q));
@@ -118,6 +122,9 @@ void sf_worker::set_context(const srsran::phy_common_interface::worker_context_t
 
   context.copy(w_ctx);
 
+  // The context is set as soon as the subframe is received
+  tti_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(FDD_HARQ_DELAY_UL_MS - 1);
+
   for (auto& w : cc_workers) {
     w->set_tti(w_ctx.sf_idx);
   }
@@ -147,6 +154,12 @@ uint32_t sf_worker::get_nof_rnti()
   return cc_workers[0]->get_nof_rnti();
 }
 
+void sf_worker::set_stage_deadline(tti_stage_t stage)
+{
+  tti_slack_us[static_cast<uint32_t>(stage)] =
+      std::chrono::duration<float, std::micro>(tti_deadline - std::chrono::steady_clock::now()).count();
+}
+
 void sf_worker::work_imp()
 {
   std::lock_guard<std::mutex> lock(work_mutex);
@@ -192,6 +205,7 @@ void sf_worker::work_imp()
   for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
     cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
   }
+  set_stage_deadline(tti_stage_t::ul);
 
   // Get DL scheduling for the TX TTI from MAC
   if (sf_type == SRSRAN_SF_NORM) {
@@ -201,7 +215,9 @@ void sf_worker::work_imp()
       return;
     }
   } else {
-    dl_grants[0].cfi = mbsfn_cfg.non_mbsfn_region_length;
+    for (auto& grants : dl_grants) {
+      grants.cfi = mbsfn_cfg.non_mbsfn_region_length;
+    }
     if (stack->get_mch_sched(tti_tx_dl, mbsfn_cfg.is_mcch, dl_grants)) {
       Error("Getting MCH packets from MAC");
       phy->worker_end(context, true, tx_buffer);
@@ -215,6 +231,7 @@ void sf_worker::work_imp()
     phy->worker_end(context, true, tx_buffer);
     return;
   }
+  set_stage_deadline(tti_stage_t::stack);
 
   // Configure DL subframe
   dl_sf.tti              = tti_tx_dl;
@@ -224,14 +241,15 @@ void sf_worker::work_imp()
   // Prepare for receive ACK for DL grants in t_tx_dl+4
   phy->ue_db.clear_tti_pending_ack(tti_tx_ul);
 
-  // Process DL
+  // Process DL. The PMCH of an MBSFN subframe is encoded once and shared by the cells
+  cc_worker::pmch_symbols_t pmch_symbols;
   for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
     // Select CFI and make sure it is in the right range
     dl_sf.cfi = dl_grants[cc].cfi;
     dl_sf.cfi = SRSRAN_MAX(dl_sf.cfi, 1);
     dl_sf.cfi = SRSRAN_MIN(dl_sf.cfi, 3);
 
-    cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg);
+    cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg, pmch_symbols);
   }
 
   // Save grants
@@ -243,9 +261,12 @@ void sf_worker::work_imp()
       tx_buffer.set_combine(phy->get_rf_port(cc), ant, phy->get_nof_ports(0), cc_workers[cc]->get_buffer_tx(ant));
     }
   }
+  set_stage_deadline(tti_stage_t::dl);
 
   Debug("Sending to radio");
   phy->worker_end(context, true, tx_buffer);
+  set_stage_deadline(tti_stage_t::tx);
+  phy->set_tti_deadline(tti_slack_us);
 
 #ifdef DEBUG_WRITE_FILE
   fwrite(signal_buffer_tx, SRSRAN_SF_LEN_PRB(phy->cell.nof_prb) * sizeof(cf_t), 1, f);
@@ -267,6 +288,14 @@ void sf_worker::work_imp()
 }
 
 /************ METRICS interface ********************/
+void sf_worker::get_mem_metrics(std::vector<uint64_t>& cell_bytes)
+{
+  cell_bytes.resize(std::max(cell_bytes.size(), cc_workers.size()));
+  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+    cell_bytes[cc] += cc_workers[cc]->get_mem_bytes();
+  }
+}
+
 uint32_t sf_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
 {
   uint32_t                   cnt = 0;
@@ -290,6 +319,9 @@ uint32_t sf_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
       m->ul.pucch_ni =
           SRSRAN_VEC_SAFE_PMA(m->ul.pucch_ni, m->ul.n_samples_pucch, m_->ul.pucch_ni, m_->ul.n_samples_pucch);
       m->ul.turbo_iters = SRSRAN_VEC_SAFE_PMA(m->ul.turbo_iters, m->ul.n_samples, m_->ul.turbo_iters, m_->ul.n_samples);
+      for (uint32_t i = 0; i < turbo_iters_hist_len; i++) {
+        m->ul.turbo_iters_hist[i] += m_->ul.turbo_iters_hist[i];
+      }
       m->ul.n_samples += m_->ul.n_samples;
       m->ul.n_samples_pucch += m_->ul.n_samples_pucch;
     }
@@ -19,6 +19,7 @@
  *
  */
 #include "srsenb/hdr/phy/lte/worker_pool.h"
+#include <thread>
 
 namespace srsenb {
 namespace lte {
@@ -27,17 +28,35 @@ worker_pool::worker_pool(uint32_t max_workers) : pool(max_workers) {}
 
 bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink& log_sink, int prio)
 {
-  // Add workers to workers pool and start threads.
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
     auto& log = srslog::fetch_basic_logger(fmt::format("PHY{}", i), log_sink);
     log.set_level(log_level);
     log.set_hex_dump_max_size(args.log.phy_hex_limit);
 
-    auto w = std::unique_ptr<lte::sf_worker>(new sf_worker(log));
-    w->init(common);
-    pool.init_worker(i, w.get(), prio);
-    workers.push_back(std::move(w));
+    workers.push_back(std::unique_ptr<lte::sf_worker>(new sf_worker(log)));
+  }
+
+  // The workers allocate their buffers and plan their FFTs independently of each other, which takes most of the PHY
+  // startup time with several carriers, so they are initialised in parallel. Each one is initialised on the CPU of
+  // its worker, so that the buffers are first touched, and placed, in the NUMA node where they are used
+  std::vector<std::thread> init_threads;
+  init_threads.reserve(workers.size());
+  for (uint32_t i = 0; i < workers.size(); i++) {
+    sf_worker*  w_ptr = workers[i].get();
+    std::string cpu   = srsran::select_cpu(args.worker_cpus, i);
+    init_threads.emplace_back([w_ptr, common, cpu]() {
+      threads_set_self_cpu_list(cpu.c_str());
+      w_ptr->init(common);
+    });
+  }
+  for (auto& t : init_threads) {
+    t.join();
+  }
+
+  // Add workers to workers pool and start threads.
+  for (uint32_t i = 0; i < workers.size(); i++) {
+    pool.init_worker(i, workers[i].get(), prio, srsran::select_cpu(args.worker_cpus, i));
   }
 
   return true;
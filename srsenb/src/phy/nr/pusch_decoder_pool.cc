@@ -0,0 +1,148 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/phy/nr/pusch_decoder_pool.h"
+#include <algorithm>
+
+namespace srsenb {
+namespace nr {
+
+pusch_decoder_pool::~pusch_decoder_pool()
+{
+  stop();
+}
+
+bool pusch_decoder_pool::init(const args_t& args)
+{
+  srsran_gnb_ul_args_t ul_args   = {};
+  ul_args.pusch.measure_time     = true;
+  ul_args.pusch.measure_evm      = true;
+  ul_args.pusch.max_layers       = args.nof_rx_ports;
+  ul_args.pusch.sch.max_nof_iter = args.pusch_max_its;
+  ul_args.pusch.sch.rm_cache     = args.ldpc_rm_cache;
+  ul_args.pusch.max_prb          = args.nof_max_prb;
+  ul_args.nof_max_prb            = args.nof_max_prb;
+  ul_args.pusch_min_snr_dB       = args.pusch_min_snr_dB;
+
+  running = true;
+
+  for (uint32_t i = 0; i < args.nof_threads; i++) {
+    std::unique_ptr<decoder_thread> t(new decoder_thread(*this));
+    if (srsran_gnb_ul_init_pusch_decoder(&t->decoder, &ul_args) < SRSRAN_SUCCESS) {
+      ERROR("Error initialising PUSCH decoder %d", i);
+      return false;
+    }
+    if (not t->start_cpu_list(args.prio, srsran::select_cpu(args.cpus, i))) {
+      return false;
+    }
+    threads.push_back(std::move(t));
+  }
+
+  return true;
+}
+
+void pusch_decoder_pool::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (not running) {
+      return;
+    }
+    running = false;
+  }
+  cvar_pending.notify_all();
+
+  for (auto& t : threads) {
+    t->wait_thread_finish();
+  }
+  threads.clear();
+}
+
+uint32_t pusch_decoder_pool::take_task(batch_t& batch)
+{
+  uint32_t task_idx = batch.next++;
+
+  // Nothing is left to take from the batch once its last task is taken
+  if (batch.next == batch.nof_tasks) {
+    batches.erase(std::find(batches.begin(), batches.end(), &batch));
+  }
+
+  return task_idx;
+}
+
+void pusch_decoder_pool::run(srsran_gnb_ul_t& decoder, uint32_t nof_tasks, const task_t& task)
+{
+  if (threads.empty() || nof_tasks <= 1) {
+    for (uint32_t i = 0; i < nof_tasks; i++) {
+      task(decoder, i);
+    }
+    return;
+  }
+
+  batch_t batch   = {};
+  batch.task      = &task;
+  batch.nof_tasks = nof_tasks;
+
+  std::unique_lock<std::mutex> lock(mutex);
+  batches.push_back(&batch);
+  cvar_pending.notify_all();
+
+  // The calling thread takes the tasks of its own batch, until the pool threads have taken the rest
+  while (batch.next < batch.nof_tasks) {
+    uint32_t task_idx = take_task(batch);
+    lock.unlock();
+    task(decoder, task_idx);
+    lock.lock();
+    batch.nof_done++;
+  }
+
+  // Wait for the tasks taken by the pool threads
+  cvar_done.wait(lock, [&batch]() { return batch.nof_done == batch.nof_tasks; });
+}
+
+void pusch_decoder_pool::run_decoder(srsran_gnb_ul_t& decoder)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while (running) {
+    if (batches.empty()) {
+      cvar_pending.wait(lock);
+      continue;
+    }
+
+    // Help the batch with the most pending tasks
+    batch_t* batch = *std::max_element(batches.begin(), batches.end(), [](const batch_t* a, const batch_t* b) {
+      return a->nof_tasks - a->next < b->nof_tasks - b->next;
+    });
+
+    uint32_t task_idx = take_task(*batch);
+    lock.unlock();
+    (*batch->task)(decoder, task_idx);
+    lock.lock();
+
+    batch->nof_done++;
+    if (batch->nof_done == batch->nof_tasks) {
+      cvar_done.notify_all();
+    }
+  }
+}
+
+} // namespace nr
+} // namespace srsenb
@@ -52,6 +52,7 @@ bool slot_worker::init(const args_t& args)
   // Copy common configurations
   cell_index = args.cell_index;
   rf_port    = args.rf_port;
+  pusch_pool = args.pusch_pool;
 
   // Allocate Tx buffers
   tx_buffer.resize(args.nof_tx_ports);
@@ -94,6 +95,7 @@ bool slot_worker::init(const args_t& args)
   ul_args.pusch.measure_evm      = true;
   ul_args.pusch.max_layers       = args.nof_rx_ports;
   ul_args.pusch.sch.max_nof_iter = args.pusch_max_its;
+  ul_args.pusch.sch.rm_cache     = args.ldpc_rm_cache;
   ul_args.pusch.max_prb          = args.nof_max_prb;
   ul_args.nof_max_prb            = args.nof_max_prb;
   ul_args.pusch_min_snr_dB       = args.pusch_min_snr_dB;
@@ -177,8 +179,25 @@ bool slot_worker::work_ul()
     return true;
   }
 
+  // Find the symbols spanned by the scheduled PUCCH and PUSCH, the rest of the slot is not demodulated
+  uint32_t first_symbol = SRSRAN_NSYMB_PER_SLOT_NR;
+  uint32_t last_symbol  = 0;
+  for (const stack_interface_phy_nr::pucch_t& pucch : ul_sched->pucch) {
+    for (const stack_interface_phy_nr::pucch_candidate_t& candidate : pucch.candidates) {
+      first_symbol = std::min(first_symbol, candidate.resource.start_symbol_idx);
+      last_symbol  = std::max(last_symbol, candidate.resource.start_symbol_idx + candidate.resource.nof_symbols);
+    }
+  }
+  for (const stack_interface_phy_nr::pusch_t& pusch : ul_sched->pusch) {
+    first_symbol = std::min(first_symbol, pusch.sch.grant.S);
+    last_symbol  = std::max(last_symbol, pusch.sch.grant.S + pusch.sch.grant.L);
+  }
+  last_symbol = std::min(last_symbol, SRSRAN_NSYMB_PER_SLOT_NR);
+
   // Demodulate
-  if (srsran_gnb_ul_fft(&gnb_ul) < SRSRAN_SUCCESS) {
+  int ret = (first_symbol < last_symbol) ? srsran_gnb_ul_fft_symbols(&gnb_ul, first_symbol, last_symbol - first_symbol)
+                                         : srsran_gnb_ul_fft(&gnb_ul);
+  if (ret < SRSRAN_SUCCESS) {
     logger.error("Error in demodulation");
     return false;
   }
@@ -234,48 +253,76 @@ bool slot_worker::work_ul()
     }
   }
 
-  // For each PUSCH...
-  for (stack_interface_phy_nr::pusch_t& pusch : ul_sched->pusch) {
-    // Prepare PUSCH
-    stack_interface_phy_nr::pusch_info_t pusch_info = {};
-    pusch_info.uci_cfg                              = pusch.sch.uci;
-    pusch_info.pid                                  = pusch.pid;
-    pusch_info.rnti                                 = pusch.sch.grant.rnti;
-    pusch_info.pdu                                  = srsran::make_byte_buffer();
+  // Prepare every PUSCH
+  pending_pusch.resize(ul_sched->pusch.size());
+  for (uint32_t i = 0; i < (uint32_t)ul_sched->pusch.size(); i++) {
+    stack_interface_phy_nr::pusch_t&      pusch      = ul_sched->pusch[i];
+    stack_interface_phy_nr::pusch_info_t& pusch_info = pending_pusch[i].info;
+
+    pusch_info         = {};
+    pusch_info.uci_cfg = pusch.sch.uci;
+    pusch_info.pid     = pusch.pid;
+    pusch_info.rnti    = pusch.sch.grant.rnti;
+    pusch_info.pdu     = srsran::make_byte_buffer();
     if (pusch_info.pdu == nullptr) {
       logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
       return false;
     }
     pusch_info.pdu->N_bytes             = pusch.sch.grant.tb[0].tbs / 8;
     pusch_info.pusch_data.tb[0].payload = pusch_info.pdu->data();
+  }
 
-    // Decode PUSCH
-    if (srsran_gnb_ul_get_pusch(&gnb_ul, &ul_slot_cfg, &pusch.sch, &pusch.sch.grant, &pusch_info.pusch_data) <
-        SRSRAN_SUCCESS) {
-      logger.error("Error getting PUSCH");
-      return false;
+  // Decode every PUSCH, with the help of the pool threads if any
+  auto decode_pusch = [this, ul_sched](srsran_gnb_ul_t& decoder, uint32_t i) {
+    stack_interface_phy_nr::pusch_t& pusch = ul_sched->pusch[i];
+    pusch_pending_t&                 p     = pending_pusch[i];
+
+    p.ret = srsran_gnb_ul_get_pusch_grid(
+        &decoder, &gnb_ul, &ul_slot_cfg, &pusch.sch, &pusch.sch.grant, &p.info.pusch_data);
+    if (p.ret < SRSRAN_SUCCESS) {
+      return;
     }
 
     // Extract DMRS information
-    pusch_info.csi = gnb_ul.dmrs.csi;
+    p.info.csi = decoder.dmrs.csi;
+
+    // The decoding summary holds the measurements of the decoder
+    if (logger.info.enabled()) {
+      srsran_gnb_ul_pusch_info(&decoder, &pusch.sch, &p.info.pusch_data, p.str.data(), (uint32_t)p.str.size());
+    }
+  };
+  if (pusch_pool != nullptr) {
+    pusch_pool->run(gnb_ul, (uint32_t)ul_sched->pusch.size(), decode_pusch);
+  } else {
+    for (uint32_t i = 0; i < (uint32_t)ul_sched->pusch.size(); i++) {
+      decode_pusch(gnb_ul, i);
+    }
+  }
+
+  // For each PUSCH...
+  for (uint32_t i = 0; i < (uint32_t)ul_sched->pusch.size(); i++) {
+    stack_interface_phy_nr::pusch_t& pusch = ul_sched->pusch[i];
+    pusch_pending_t&                 p     = pending_pusch[i];
+
+    if (p.ret < SRSRAN_SUCCESS) {
+      logger.error("Error getting PUSCH");
+      return false;
+    }
 
     // Inform stack
-    if (stack.pusch_info(ul_slot_cfg, pusch_info) < SRSRAN_SUCCESS) {
+    if (stack.pusch_info(ul_slot_cfg, p.info) < SRSRAN_SUCCESS) {
       logger.error("Error pushing PUSCH information to stack");
       return false;
     }
 
     // Log PUSCH decoding
     if (logger.info.enabled()) {
-      std::array<char, 512> str;
-      srsran_gnb_ul_pusch_info(&gnb_ul, &pusch.sch, &pusch_info.pusch_data, str.data(), (uint32_t)str.size());
-
       if (logger.debug.enabled()) {
         std::array<char, 1024> str_extra = {};
         srsran_sch_cfg_nr_info(&pusch.sch, str_extra.data(), (uint32_t)str_extra.size());
-        logger.info("PUSCH: %s\n%s", str.data(), str_extra.data());
+        logger.info("PUSCH: %s\n%s", p.str.data(), str_extra.data());
       } else {
-        logger.info("PUSCH: %s", str.data());
+        logger.info("PUSCH: %s", p.str.data());
       }
     }
   }
@@ -299,6 +346,25 @@ bool slot_worker::work_dl()
     return false;
   }
 
+  // A slot without DL symbols carries no signal, skip the resource grid and the OFDM modulation
+  srsran_duplex_nr_slot_t slot_type = srsran_duplex_nr_slot_type(&duplex, 0, dl_slot_cfg.idx);
+  if (slot_type != SRSRAN_DUPLEX_NR_SLOT_DL and slot_type != SRSRAN_DUPLEX_NR_SLOT_DL_UL) {
+    if (not dl_sched_ptr->pdcch_dl.empty() or not dl_sched_ptr->pdcch_ul.empty() or not dl_sched_ptr->pdsch.empty() or
+        not dl_sched_ptr->nzp_csi_rs.empty() or not dl_sched_ptr->ssb.empty()) {
+      logger.warning("DL transmissions scheduled in slot without DL symbols tti_tx=%d", dl_slot_cfg.idx);
+    }
+
+    // The buffers are clear while they are not used by a DL slot
+    if (not tx_zero) {
+      for (cf_t* b : tx_buffer) {
+        srsran_vec_cf_zero(b, sf_len);
+      }
+      tx_zero = true;
+    }
+    return true;
+  }
+  tx_zero = false;
+
   if (srsran_gnb_dl_base_zero(&gnb_dl) < SRSRAN_SUCCESS) {
     logger.error("Error zeroing RE grid");
     return false;
@@ -442,9 +508,10 @@ void slot_worker::work_imp()
 #endif
 }
 
-bool slot_worker::set_common_cfg(const srsran_carrier_nr_t&   carrier,
-                                 const srsran_pdcch_cfg_nr_t& pdcch_cfg_,
-                                 const srsran_ssb_cfg_t&      ssb_cfg_)
+bool slot_worker::set_common_cfg(const srsran_carrier_nr_t&       carrier,
+                                 const srsran_pdcch_cfg_nr_t&     pdcch_cfg_,
+                                 const srsran_ssb_cfg_t&          ssb_cfg_,
+                                 const srsran_duplex_config_nr_t& duplex_)
 {
   std::lock_guard<std::mutex> lock(mutex);
   // Set gNb DL carrier
@@ -469,6 +536,8 @@ bool slot_worker::set_common_cfg(const srsran_carrier_nr_t&   carrier,
   }
 
   pdcch_cfg = pdcch_cfg_;
+  duplex    = duplex_;
+  tx_zero   = false;
 
   // Update subframe length
   sf_len = SRSRAN_SF_LEN_PRB_NR(carrier.nof_prb);
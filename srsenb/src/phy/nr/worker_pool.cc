@@ -21,6 +21,9 @@
 #include "srsenb/hdr/phy/nr/worker_pool.h"
 #include "srsran/common/band_helper.h"
 
+/// Maximum number of LDPC rate dematching index maps kept by the workers
+#define LDPC_RM_CACHE_MAX_ENTRIES 256
+
 namespace srsenb {
 namespace nr {
 
@@ -38,6 +41,12 @@ worker_pool::worker_pool(srsran::phy_common_interface& common_,
   // Do nothing
 }
 
+worker_pool::~worker_pool()
+{
+  // The workers are stopped at this point
+  srsran_ldpc_rm_cache_free(&ldpc_rm_cache);
+}
+
 bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_list)
 {
   nof_prach_workers = args.nof_prach_workers;
@@ -53,6 +62,29 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
   logger.set_level(log_level);
 
+  // Initialise the LDPC rate dematching cache shared by all workers
+  if (ldpc_rm_cache.entries == nullptr && srsran_ldpc_rm_cache_init(&ldpc_rm_cache, LDPC_RM_CACHE_MAX_ENTRIES) < 0) {
+    logger.error("Error initialising LDPC rate dematching cache");
+    return false;
+  }
+
+  // Start the PUSCH decoding threads shared by all workers, they take the CPUs of the list after the workers ones
+  pusch_decoder_pool::args_t pusch_args = {};
+  pusch_args.nof_threads                = args.nof_pusch_threads;
+  pusch_args.nof_max_prb                = cell_list[0].carrier.nof_prb;
+  pusch_args.nof_rx_ports               = cell_list[0].carrier.max_mimo_layers;
+  pusch_args.pusch_max_its              = args.pusch_max_its;
+  pusch_args.pusch_min_snr_dB           = args.pusch_min_snr_dB;
+  pusch_args.ldpc_rm_cache              = &ldpc_rm_cache;
+  pusch_args.prio                       = args.prio;
+  for (uint32_t i = 0; i < args.nof_pusch_threads && not args.cpus.empty(); i++) {
+    pusch_args.cpus += (i == 0 ? "" : ",") + srsran::select_cpu(args.cpus, args.nof_phy_threads + i);
+  }
+  if (not pusch_pool.init(pusch_args)) {
+    logger.error("Error starting the PUSCH decoding threads");
+    return false;
+  }
+
   // Add workers to workers pool and start threads
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
     auto& log = srslog::fetch_basic_logger(fmt::format("{}PHY{}-NR", args.log.id_preamble, i), log_sink);
@@ -60,7 +92,7 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
     log.set_hex_dump_max_size(args.log.phy_hex_limit);
 
     auto w = new slot_worker(common, stack, *this, log);
-    pool.init_worker(i, w, args.prio);
+    pool.init_worker(i, w, args.prio, srsran::select_cpu(args.cpus, i));
     workers.push_back(std::unique_ptr<slot_worker>(w));
 
     slot_worker::args_t w_args     = {};
@@ -73,6 +105,8 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
     w_args.srate_hz                = srate_hz;
     w_args.pusch_max_its           = args.pusch_max_its;
     w_args.pusch_min_snr_dB        = args.pusch_min_snr_dB;
+    w_args.ldpc_rm_cache           = &ldpc_rm_cache;
+    w_args.pusch_pool              = &pusch_pool;
 
     if (not w->init(w_args)) {
       return false;
@@ -113,6 +147,7 @@ slot_worker* worker_pool::wait_worker_id(uint32_t id)
 void worker_pool::stop()
 {
   pool.stop();
+  pusch_pool.stop();
   prach.stop();
 }
 
@@ -138,7 +173,7 @@ int worker_pool::set_common_cfg(const phy_interface_rrc_nr::common_cfg_t& common
   prach_cfg.tdd_config.configured = (common_cfg.duplex_mode == SRSRAN_DUPLEX_MODE_TDD);
 
   // Set the PRACH configuration
-  prach.init(0, cell, prach_cfg, &prach_stack_adaptor, logger, 0, nof_prach_workers);
+  prach.init(0, cell, prach_cfg, &prach_stack_adaptor, logger, 0, nof_prach_workers, 0, "");
   prach.set_max_prach_offset_us(1000);
 
   // Setup SSB sampling rate and scaling
@@ -164,7 +199,7 @@ int worker_pool::set_common_cfg(const phy_interface_rrc_nr::common_cfg_t& common
     }
 
     // Setup worker common configuration
-    if (not w->set_common_cfg(common_cfg.carrier, common_cfg.pdcch, ssb_cfg)) {
+    if (not w->set_common_cfg(common_cfg.carrier, common_cfg.pdcch, ssb_cfg, common_cfg.duplex)) {
       return SRSRAN_ERROR;
     }
 
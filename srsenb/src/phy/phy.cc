@@ -23,6 +23,7 @@
 #include "srsran/common/band_helper.h"
 #include "srsran/common/phy_cfg_nr_default.h"
 #include "srsran/common/threads.h"
+#include <cinttypes>
 #include <pthread.h>
 #include <sstream>
 #include <string.h>
@@ -119,7 +120,10 @@ int phy::init(const phy_args_t&            args,
     return SRSRAN_ERROR;
   }
 
-  tx_rx.init(enb_, radio, &lte_workers, &workers_common, &prach, SF_RECV_THREAD_PRIO);
+  if (not tx_rx.init(enb_, radio, &lte_workers, &workers_common, &prach, SF_RECV_THREAD_PRIO)) {
+    phy_log.error("Couldn't start the radio thread on CPUs %s", args.txrx_cpus.c_str());
+    return SRSRAN_ERROR;
+  }
   initialized = true;
 
   return SRSRAN_SUCCESS;
@@ -136,7 +140,10 @@ int phy::init(const phy_args_t&            args,
     return SRSRAN_ERROR;
   }
 
-  tx_rx.init(enb_, radio, &lte_workers, &workers_common, &prach, SF_RECV_THREAD_PRIO);
+  if (not tx_rx.init(enb_, radio, &lte_workers, &workers_common, &prach, SF_RECV_THREAD_PRIO)) {
+    phy_log.error("Couldn't start the radio thread on CPUs %s", args.txrx_cpus.c_str());
+    return SRSRAN_ERROR;
+  }
   initialized = true;
 
   return SRSRAN_SUCCESS;
@@ -171,6 +178,9 @@ int phy::init_lte(const phy_args_t&            args,
   radio       = radio_;
   nof_workers = cfg.phy_cell_cfg.empty() ? 0 : args.nof_phy_threads;
 
+  // Large buffers, like the RF and resource grid ones, in huge pages to reduce the TLB misses
+  srsran_vec_set_hugepage_min_size(args.hugepage_min_kb * 1024);
+
   workers_common.params = args;
 
   workers_common.init(cfg.phy_cell_cfg, cfg.phy_cell_cfg_nr, radio, stack_lte_);
@@ -185,6 +195,12 @@ int phy::init_lte(const phy_args_t&            args,
     lte_workers.init(args, &workers_common, log_sink, WORKERS_THREAD_PRIO);
   }
 
+  if (args.hugepage_min_kb > 0) {
+    uint64_t nof_allocs = 0, nof_bytes = 0;
+    srsran_vec_get_hugepage_usage(&nof_allocs, &nof_bytes);
+    phy_log.info("Allocated %" PRIu64 " PHY buffers in %" PRIu64 " MB of huge pages", nof_allocs, nof_bytes >> 20);
+  }
+
   // For each carrier, initialise PRACH worker
   for (uint32_t cc = 0; cc < cfg.phy_cell_cfg.size(); cc++) {
     prach_cfg.root_seq_idx = cfg.phy_cell_cfg[cc].root_seq_idx;
@@ -194,7 +210,9 @@ int phy::init_lte(const phy_args_t&            args,
                stack_lte_,
                phy_log,
                PRACH_WORKER_THREAD_PRIO,
-               args.nof_prach_threads);
+               args.nof_prach_threads,
+               args.prach_corr_threads,
+               srsran::select_cpu(args.prach_cpus, cc));
   }
   prach.set_max_prach_offset_us(args.max_prach_offset_us);
 
@@ -267,6 +285,9 @@ void phy::get_metrics(std::vector<phy_metrics_t>& metrics)
       metrics[j].ul.pucch_ni += metrics_tmp[j].ul.n_samples_pucch * metrics_tmp[j].ul.pucch_ni;
       metrics[j].ul.pucch_sinr += metrics_tmp[j].ul.n_samples_pucch * metrics_tmp[j].ul.pucch_sinr;
       metrics[j].ul.turbo_iters += metrics_tmp[j].ul.n_samples * metrics_tmp[j].ul.turbo_iters;
+      for (uint32_t k = 0; k < turbo_iters_hist_len; k++) {
+        metrics[j].ul.turbo_iters_hist[k] += metrics_tmp[j].ul.turbo_iters_hist[k];
+      }
     }
   }
   for (uint32_t j = 0; j < metrics.size(); j++) {
@@ -286,6 +307,19 @@ void phy::get_metrics(std::vector<phy_metrics_t>& metrics)
   }
 }
 
+void phy::get_mem_metrics(std::vector<uint64_t>& cell_bytes)
+{
+  cell_bytes.clear();
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    lte_workers[i]->get_mem_metrics(cell_bytes);
+  }
+}
+
+void phy::get_tti_deadline_metrics(tti_deadline_metrics_t& metrics)
+{
+  workers_common.get_tti_deadline_metrics(metrics);
+}
+
 void phy::cmd_cell_gain(uint32_t cell_id, float gain_db)
 {
   Info("set_cell_gain: cell_id=%d, gain_db=%.2f", cell_id, gain_db);
@@ -376,6 +410,8 @@ int phy::init_nr(const phy_args_t& args, const phy_cfg_t& cfg, stack_interface_p
   worker_args.log.phy_level           = args.log.phy_level;
   worker_args.log.phy_hex_limit       = args.log.phy_hex_limit;
   worker_args.pusch_max_its           = args.nr_pusch_max_its;
+  worker_args.cpus                    = args.nr_worker_cpus;
+  worker_args.nof_pusch_threads       = args.nr_pusch_threads;
 
   if (not nr_workers->init(worker_args, cfg.phy_cell_cfg_nr)) {
     return SRSRAN_ERROR;
@@ -111,6 +111,37 @@ void phy_common::set_ul_grants(uint32_t tti, const stack_interface_phy_lte::ul_s
   ul_grants[tti] = ul_grant_list;
 }
 
+void phy_common::set_tti_deadline(const float (&slack_us)[tti_nof_stages])
+{
+  std::lock_guard<std::mutex> lock(deadline_mutex);
+
+  for (uint32_t i = 0; i < tti_nof_stages; i++) {
+    tti_stage_metrics_t& m = deadline_metrics.stage[i];
+
+    m.slack_min_us = (deadline_metrics.nof_tti == 0) ? slack_us[i] : SRSRAN_MIN(m.slack_min_us, slack_us[i]);
+    m.slack_avg_us = SRSRAN_VEC_CMA(slack_us[i], m.slack_avg_us, deadline_metrics.nof_tti);
+
+    // Late stages go to the first bin, the last bin also counts the largest slacks
+    uint32_t bin = 0;
+    if (slack_us[i] >= 0.0f) {
+      bin = SRSRAN_MIN(1 + (uint32_t)(slack_us[i] / tti_slack_hist_bin_us), tti_slack_hist_len - 1);
+    }
+    m.slack_hist[bin]++;
+  }
+
+  if (slack_us[static_cast<uint32_t>(tti_stage_t::tx)] < 0.0f) {
+    deadline_metrics.nof_late++;
+  }
+  deadline_metrics.nof_tti++;
+}
+
+void phy_common::get_tti_deadline_metrics(tti_deadline_metrics_t& m)
+{
+  std::lock_guard<std::mutex> lock(deadline_mutex);
+  m                = deadline_metrics;
+  deadline_metrics = {};
+}
+
 /* The transmission of UL subframes must be in sequence. The correct sequence is guaranteed by a chain of N semaphores,
  * one per TTI%nof_workers. Each threads waits for the semaphore for the current thread and after transmission allows
  * next TTI to be transmitted
@@ -20,9 +20,38 @@
  */
 
 #include "srsenb/hdr/phy/phy_ue_db.h"
+#include <thread>
 
 using namespace srsenb;
 
+phy_ue_db::phy_ue_db() : ue_db(new ue_db_t) {}
+
+phy_ue_db::~phy_ue_db()
+{
+  delete ue_db.load();
+}
+
+phy_ue_db::read_guard::read_guard(const phy_ue_db& parent_) : parent(parent_)
+{
+  // Register in the counter of the current epoch, retry if the epoch flipped meanwhile as the writer may not wait for
+  // this reader
+  do {
+    parity = parent.epoch.load() & 1U;
+    parent.nof_readers[parity]++;
+    if ((parent.epoch.load() & 1U) == parity) {
+      break;
+    }
+    parent.nof_readers[parity]--;
+  } while (true);
+
+  db = parent.ue_db.load();
+}
+
+phy_ue_db::read_guard::~read_guard()
+{
+  parent.nof_readers[parity]--;
+}
+
 void phy_ue_db::init(stack_interface_phy_lte*   stack_ptr,
                      const phy_args_t&          phy_args_,
                      const phy_cell_cfg_list_t& cell_cfg_list_)
@@ -32,46 +61,64 @@ void phy_ue_db::init(stack_interface_phy_lte*   stack_ptr,
   cell_cfg_list = &cell_cfg_list_;
 }
 
-inline int phy_ue_db::_add_rnti(uint16_t rnti)
+void phy_ue_db::_publish(const ue_db_t* db)
+{
+  // Private function, the write mutex must be taken
+  const ue_db_t* old_db = ue_db.exchange(db);
+
+  // Flip the epoch, new readers get the new version and the ones of the previous epoch might hold the old one
+  uint32_t old_parity = epoch.fetch_add(1) & 1U;
+  while (nof_readers[old_parity].load() != 0) {
+    std::this_thread::yield();
+  }
+
+  delete old_db;
+}
+
+phy_ue_db::common_ue& phy_ue_db::_modify_rnti(ue_db_t& db, uint16_t rnti)
+{
+  std::shared_ptr<common_ue> ue = std::make_shared<common_ue>(*db.at(rnti));
+  db[rnti]                      = ue;
+  return *ue;
+}
+
+inline int phy_ue_db::_add_rnti(ue_db_t& db, uint16_t rnti)
 {
   // Private function not mutexed
 
   // Assert RNTI does NOT exist
-  if (ue_db.count(rnti)) {
+  if (db.count(rnti)) {
     return SRSRAN_ERROR;
   }
 
-  // Create new UE by accesing it
-  ue_db[rnti].cell_info[0] = {};
-
-  // Get UE
-  common_ue& ue = ue_db[rnti];
+  // Create new UE
+  std::shared_ptr<common_ue> ue = std::make_shared<common_ue>();
+  ue->feedback                  = std::make_shared<ue_feedback_t>();
 
   // Load default values to PCell
-  ue.cell_info[0].phy_cfg.set_defaults();
+  ue->cell_info[0].phy_cfg.set_defaults();
 
   // Set constant configuration fields
-  _set_common_config_rnti(rnti, ue.cell_info[0].phy_cfg);
+  _set_common_config_rnti(rnti, ue->cell_info[0].phy_cfg);
 
   // Configure as PCell
-  ue.cell_info[0].state = cell_state_primary;
+  ue->cell_info[0].state = cell_state_primary;
 
-  // Iterate all pending ACK
+  // Iterate all pending ACK, no worker can access the UE before it is published
   for (uint32_t tti = 0; tti < TTIMOD_SZ; tti++) {
-    _clear_tti_pending_rnti(tti, rnti);
+    _clear_tti_pending_rnti(tti, *ue);
   }
 
+  db[rnti] = ue;
+
   return SRSRAN_SUCCESS;
 }
 
-inline void phy_ue_db::_clear_tti_pending_rnti(uint32_t tti, uint16_t rnti)
+inline void phy_ue_db::_clear_tti_pending_rnti(uint32_t tti, const common_ue& ue)
 {
   // Private function not mutexed, no need to assert RNTI or TTI
 
-  // Get UE
-  common_ue& ue = ue_db[rnti];
-
-  srsran_pdsch_ack_t& pdsch_ack = ue.pdsch_ack[tti];
+  srsran_pdsch_ack_t& pdsch_ack = ue.feedback->pdsch_ack[tti];
 
   // Reset ACK information
   pdsch_ack = {};
@@ -101,6 +148,8 @@ inline void phy_ue_db::_set_common_config_rnti(uint16_t rnti, srsran::phy_cfg_t&
   phy_cfg.ul_cfg.pusch.meas_ta_en                    = phy_args->pusch_meas_ta;
   phy_cfg.ul_cfg.pusch.meas_evm_en                   = phy_args->pusch_meas_evm;
   phy_cfg.ul_cfg.pusch.max_nof_iterations            = phy_args->pusch_max_its;
+  phy_cfg.ul_cfg.pusch.max_nof_iterations_snr        = phy_args->pusch_snr_max_its;
+  phy_cfg.ul_cfg.pusch.early_termination             = phy_args->pusch_early_stop;
   phy_cfg.ul_cfg.pucch.threshold_format1             = SRSRAN_PUCCH_DEFAULT_THRESHOLD_FORMAT1;
   phy_cfg.ul_cfg.pucch.threshold_data_valid_format1a = SRSRAN_PUCCH_DEFAULT_THRESHOLD_FORMAT1A;
   phy_cfg.ul_cfg.pucch.threshold_data_valid_format2  = SRSRAN_PUCCH_DEFAULT_THRESHOLD_FORMAT2;
@@ -109,10 +158,9 @@ inline void phy_ue_db::_set_common_config_rnti(uint16_t rnti, srsran::phy_cfg_t&
   phy_cfg.ul_cfg.pucch.meas_ta_en                    = phy_args->pucch_meas_ta;
 }
 
-inline uint32_t phy_ue_db::_get_ue_cc_idx(uint16_t rnti, uint32_t enb_cc_idx) const
+inline uint32_t phy_ue_db::_get_ue_cc_idx(const common_ue& ue, uint32_t enb_cc_idx)
 {
-  uint32_t         ue_cc_idx = 0;
-  const common_ue& ue        = ue_db.at(rnti);
+  uint32_t ue_cc_idx = 0;
 
   for (; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
     const cell_info_t& scell_info = ue.cell_info[ue_cc_idx];
@@ -125,55 +173,59 @@ inline uint32_t phy_ue_db::_get_ue_cc_idx(uint16_t rnti, uint32_t enb_cc_idx) co
   return ue_cc_idx;
 }
 
-uint32_t phy_ue_db::_get_uci_enb_cc_idx(uint32_t tti, uint16_t rnti) const
+uint32_t phy_ue_db::_get_uci_enb_cc_idx(uint32_t tti, const common_ue& ue) const
 {
   // Find the lowest index available PUSCH grant
-  for (const cell_info_t& cell_info : ue_db.at(rnti).cell_info) {
-    if (cell_info.is_grant_available[tti]) {
-      return cell_info.enb_cc_idx;
+  for (uint32_t ue_cc_idx = 0; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
+    if (ue.feedback->cell[ue_cc_idx].is_grant_available[tti]) {
+      return ue.cell_info[ue_cc_idx].enb_cc_idx;
     }
   }
 
   return (uint32_t)cell_cfg_list->size();
 }
 
-inline int phy_ue_db::_assert_rnti(uint16_t rnti) const
+inline const phy_ue_db::common_ue* phy_ue_db::_find_rnti(const ue_db_t& db, uint16_t rnti)
 {
-  if (not ue_db.count(rnti)) {
-    return SRSRAN_ERROR;
+  auto it = db.find(rnti);
+  if (it == db.end()) {
+    return nullptr;
   }
 
-  return SRSRAN_SUCCESS;
+  return it->second.get();
 }
 
-inline int phy_ue_db::_assert_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const
+inline const phy_ue_db::common_ue* phy_ue_db::_find_enb_cc(const ue_db_t& db, uint16_t rnti, uint32_t enb_cc_idx)
 {
   // Assert RNTI exist
-  if (_assert_rnti(rnti) != SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
+  const common_ue* ue = _find_rnti(db, rnti);
+  if (ue == nullptr) {
+    return nullptr;
   }
 
   // Check Component Carrier is part of UE SCell map
-  if (_get_ue_cc_idx(rnti, enb_cc_idx) == SRSRAN_MAX_CARRIERS) {
-    return SRSRAN_ERROR;
+  if (_get_ue_cc_idx(*ue, enb_cc_idx) == SRSRAN_MAX_CARRIERS) {
+    return nullptr;
   }
 
-  return SRSRAN_SUCCESS;
+  return ue;
 }
 
 bool phy_ue_db::ue_has_cell(uint16_t rnti, uint32_t enb_cc_idx) const
 {
-  return _assert_enb_cc(rnti, enb_cc_idx) == SRSRAN_SUCCESS;
+  read_guard db(*this);
+  return _find_enb_cc(*db, rnti, enb_cc_idx) != nullptr;
 }
 
-inline int phy_ue_db::_assert_enb_pcell(uint16_t rnti, uint32_t enb_cc_idx) const
+inline int phy_ue_db::_assert_enb_pcell(const ue_db_t& db, uint16_t rnti, uint32_t enb_cc_idx)
 {
-  if (_assert_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  const common_ue* ue = _find_enb_cc(db, rnti, enb_cc_idx);
+  if (ue == nullptr) {
     return SRSRAN_ERROR;
   }
 
   // Check cell is PCell
-  const cell_info_t& cell_info = ue_db.at(rnti).cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)];
+  const cell_info_t& cell_info = ue->cell_info[_get_ue_cc_idx(*ue, enb_cc_idx)];
   if (cell_info.state != cell_state_primary) {
     return SRSRAN_ERROR;
   }
@@ -181,9 +233,10 @@ inline int phy_ue_db::_assert_enb_pcell(uint16_t rnti, uint32_t enb_cc_idx) cons
   return SRSRAN_SUCCESS;
 }
 
-inline int phy_ue_db::_assert_ue_cc(uint16_t rnti, uint32_t ue_cc_idx) const
+inline int phy_ue_db::_assert_ue_cc(const ue_db_t& db, uint16_t rnti, uint32_t ue_cc_idx)
 {
-  if (_assert_rnti(rnti) != SRSRAN_SUCCESS) {
+  const common_ue* ue = _find_rnti(db, rnti);
+  if (ue == nullptr) {
     return SRSRAN_ERROR;
   }
 
@@ -192,7 +245,7 @@ inline int phy_ue_db::_assert_ue_cc(uint16_t rnti, uint32_t ue_cc_idx) const
     return SRSRAN_ERROR;
   }
 
-  const cell_info_t& cell_info = ue_db.at(rnti).cell_info.at(ue_cc_idx);
+  const cell_info_t& cell_info = ue->cell_info.at(ue_cc_idx);
   if (cell_info.state == cell_state_none) {
     return SRSRAN_ERROR;
   }
@@ -200,19 +253,21 @@ inline int phy_ue_db::_assert_ue_cc(uint16_t rnti, uint32_t ue_cc_idx) const
   return SRSRAN_SUCCESS;
 }
 
-inline int phy_ue_db::_assert_active_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const
+inline const phy_ue_db::common_ue*
+phy_ue_db::_find_active_enb_cc(const ue_db_t& db, uint16_t rnti, uint32_t enb_cc_idx)
 {
-  if (_assert_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
+  const common_ue* ue = _find_enb_cc(db, rnti, enb_cc_idx);
+  if (ue == nullptr) {
+    return nullptr;
   }
 
   // Check SCell is active, ignore PCell state
-  const cell_info_t& cell_info = ue_db.at(rnti).cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)];
+  const cell_info_t& cell_info = ue->cell_info[_get_ue_cc_idx(*ue, enb_cc_idx)];
   if (cell_info.state != cell_state_primary and cell_info.state != cell_state_secondary_active) {
-    return SRSRAN_ERROR;
+    return nullptr;
   }
 
-  return SRSRAN_SUCCESS;
+  return ue;
 }
 
 inline int phy_ue_db::_assert_stack() const
@@ -233,52 +288,53 @@ inline int phy_ue_db::_assert_cell_list_cfg() const
   return SRSRAN_SUCCESS;
 }
 
-inline int phy_ue_db::_get_rnti_config(uint16_t rnti, uint32_t enb_cc_idx, srsran::phy_cfg_t& phy_cfg) const
+inline int
+phy_ue_db::_get_rnti_config(const ue_db_t& db, uint16_t rnti, uint32_t enb_cc_idx, srsran::phy_cfg_t& phy_cfg)
 {
-  srsran::phy_cfg_t default_cfg = {};
-  default_cfg.set_defaults();
-  default_cfg.dl_cfg.pdsch.rnti = rnti;
-  default_cfg.ul_cfg.pucch.rnti = rnti;
-  default_cfg.ul_cfg.pusch.rnti = rnti;
-
   // Use default configuration for non-user C-RNTI
   if (not SRSRAN_RNTI_ISUSER(rnti)) {
-    phy_cfg = default_cfg;
+    phy_cfg = {};
+    phy_cfg.set_defaults();
+    phy_cfg.dl_cfg.pdsch.rnti = rnti;
+    phy_cfg.ul_cfg.pucch.rnti = rnti;
+    phy_cfg.ul_cfg.pusch.rnti = rnti;
     return SRSRAN_SUCCESS;
   }
 
   // Make sure the C-RNTI exists and the cell/carrier is configured
-  if (_assert_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  const common_ue* ue = _find_enb_cc(db, rnti, enb_cc_idx);
+  if (ue == nullptr) {
     return SRSRAN_ERROR;
   }
 
   // Write the current configuration
-  uint32_t ue_cc_idx = _get_ue_cc_idx(rnti, enb_cc_idx);
-  phy_cfg            = ue_db.at(rnti).cell_info.at(ue_cc_idx).phy_cfg;
+  uint32_t ue_cc_idx = _get_ue_cc_idx(*ue, enb_cc_idx);
+  phy_cfg            = ue->cell_info.at(ue_cc_idx).phy_cfg;
   return SRSRAN_SUCCESS;
 }
 
 void phy_ue_db::clear_tti_pending_ack(uint32_t tti)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  read_guard db(*this);
 
   // Iterate all UEs
-  for (auto& iter : ue_db) {
-    _clear_tti_pending_rnti(TTIMOD(tti), iter.first);
+  for (auto& iter : *db) {
+    _clear_tti_pending_rnti(TTIMOD(tti), *iter.second);
   }
 }
 
 void phy_ue_db::addmod_rnti(uint16_t rnti, const phy_interface_rrc_lte::phy_rrc_cfg_list_t& phy_cfg_list)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(write_mutex);
+  ue_db_t*                    db = new ue_db_t(*ue_db.load());
 
   // Create new user if did not exist
-  if (ue_db.count(rnti) == 0) {
-    _add_rnti(rnti);
+  if (db->count(rnti) == 0) {
+    _add_rnti(*db, rnti);
   }
 
-  // Get UE by reference
-  common_ue& ue = ue_db[rnti];
+  // Get UE copy by reference
+  common_ue& ue = _modify_rnti(*db, rnti);
 
   // During a reconfiguration, all parameters in phy_cfg_t shall be applied immediately except:
   // - Multiple CSI request field in DCI (phy_cfg_t.dl_cfg.dci.multiple_csi_request_enabled)
@@ -289,7 +345,7 @@ void phy_ue_db::addmod_rnti(uint16_t rnti, const phy_interface_rrc_lte::phy_rrc_
   // and the reception of the reconfigurationComplete, the values before the reconfiguration shall be used
 
   // Store the current values for CSI and extended TBS in temporary variables
-  ue.stashed_multiple_csi_request_enabled = (_count_nof_configured_scell(rnti) > 0);
+  ue.stashed_multiple_csi_request_enabled = (_count_nof_configured_scell(ue) > 0);
   for (uint32_t i = 0; i < SRSRAN_MAX_CARRIERS; i++) {
     ue.cell_info[i].stash_use_tbs_index_alt = ue.cell_info[i].phy_cfg.dl_cfg.pdsch.use_tbs_index_alt;
   }
@@ -340,29 +396,33 @@ void phy_ue_db::addmod_rnti(uint16_t rnti, const phy_interface_rrc_lte::phy_rrc_
 
   // Enable/Disable extended CSI field in DCI according to 3GPP 36.212 R10 5.3.3.1.1 Format 0
   for (uint32_t ue_cc_idx = 0; ue_cc_idx < nof_cc; ue_cc_idx++) {
-    ue.cell_info[ue_cc_idx].phy_cfg.dl_cfg.dci.multiple_csi_request_enabled = (_count_nof_configured_scell(rnti) > 0);
+    ue.cell_info[ue_cc_idx].phy_cfg.dl_cfg.dci.multiple_csi_request_enabled = (_count_nof_configured_scell(ue) > 0);
   }
+
+  _publish(db);
 }
 
 int phy_ue_db::rem_rnti(uint16_t rnti)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(write_mutex);
 
-  if (ue_db.count(rnti) == 0) {
+  if (ue_db.load()->count(rnti) == 0) {
     return SRSRAN_ERROR;
   }
 
-  ue_db.erase(rnti);
+  ue_db_t* db = new ue_db_t(*ue_db.load());
+  db->erase(rnti);
+  _publish(db);
 
   return SRSRAN_SUCCESS;
 }
 
-uint32_t phy_ue_db::_count_nof_configured_scell(uint16_t rnti)
+uint32_t phy_ue_db::_count_nof_configured_scell(const common_ue& ue)
 {
   uint32_t nof_configured_scell = 0;
   for (uint32_t ue_cc_idx = 0; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
-    if (ue_db[rnti].cell_info[ue_cc_idx].state == cell_state_t::cell_state_secondary_inactive ||
-        ue_db[rnti].cell_info[ue_cc_idx].state == cell_state_t::cell_state_secondary_active) {
+    if (ue.cell_info[ue_cc_idx].state == cell_state_t::cell_state_secondary_inactive ||
+        ue.cell_info[ue_cc_idx].state == cell_state_t::cell_state_secondary_active) {
       nof_configured_scell++;
     }
   }
@@ -371,70 +431,78 @@ uint32_t phy_ue_db::_count_nof_configured_scell(uint16_t rnti)
 
 int phy_ue_db::complete_config(uint16_t rnti)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(write_mutex);
 
   // Makes sure the RNTI exists
-  if (_assert_rnti(rnti) != SRSRAN_SUCCESS) {
+  if (_find_rnti(*ue_db.load(), rnti) == nullptr) {
     return SRSRAN_ERROR;
   }
 
+  ue_db_t*   db = new ue_db_t(*ue_db.load());
+  common_ue& ue = _modify_rnti(*db, rnti);
+
   // Once the reconfiguration is complete, the temporary parameters become the new ones
 
   // Update temporary multiple CSI DCI field with the new value
-  ue_db[rnti].stashed_multiple_csi_request_enabled = (_count_nof_configured_scell(rnti) > 0);
+  ue.stashed_multiple_csi_request_enabled = (_count_nof_configured_scell(ue) > 0);
   // Update temporary alternate TBS value with the new one
   for (uint32_t ue_cc_idx = 0; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
-    ue_db[rnti].cell_info[ue_cc_idx].stash_use_tbs_index_alt =
-        ue_db[rnti].cell_info[ue_cc_idx].phy_cfg.dl_cfg.pdsch.use_tbs_index_alt;
+    ue.cell_info[ue_cc_idx].stash_use_tbs_index_alt = ue.cell_info[ue_cc_idx].phy_cfg.dl_cfg.pdsch.use_tbs_index_alt;
   }
 
+  _publish(db);
+
   return SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::activate_deactivate_scell(uint16_t rnti, uint32_t ue_cc_idx, bool activate)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(write_mutex);
 
   // Assert RNTI and SCell are valid
-  if (_assert_ue_cc(rnti, ue_cc_idx) != SRSRAN_SUCCESS) {
+  if (_assert_ue_cc(*ue_db.load(), rnti, ue_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_SUCCESS;
   }
 
-  cell_info_t& cell_info = ue_db[rnti].cell_info[ue_cc_idx];
-
   // If scell is default only complain
-  if (activate and cell_info.state == cell_state_none) {
+  if (activate and ue_db.load()->at(rnti)->cell_info[ue_cc_idx].state == cell_state_none) {
     return SRSRAN_ERROR;
   }
 
+  ue_db_t*     db        = new ue_db_t(*ue_db.load());
+  cell_info_t& cell_info = _modify_rnti(*db, rnti).cell_info[ue_cc_idx];
+
   // Set scell state
   cell_info.state = (activate) ? cell_state_secondary_active : cell_state_secondary_inactive;
 
+  _publish(db);
+
   return SRSRAN_SUCCESS;
 }
 
 bool phy_ue_db::is_pcell(uint16_t rnti, uint32_t enb_cc_idx) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  return _assert_enb_pcell(rnti, enb_cc_idx) == SRSRAN_SUCCESS;
+  read_guard db(*this);
+  return _assert_enb_pcell(*db, rnti, enb_cc_idx) == SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::get_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dl_cfg_t& dl_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  read_guard        db(*this);
+  srsran::phy_cfg_t phy_cfg = {};
 
-  if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
+  if (_get_rnti_config(*db, rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
   dl_cfg = phy_cfg.dl_cfg;
 
   // The DL configuration must overwrite the use_tbs_index_alt value (for 256QAM) with the temporary value
   // in case we are in the middle of a reconfiguration
-  if (ue_db.count(rnti) && SRSRAN_RNTI_ISUSER(rnti)) {
-    uint32_t ue_cc_idx = _get_ue_cc_idx(rnti, enb_cc_idx);
+  const common_ue* ue = _find_rnti(*db, rnti);
+  if (ue != nullptr && SRSRAN_RNTI_ISUSER(rnti)) {
+    uint32_t ue_cc_idx = _get_ue_cc_idx(*ue, enb_cc_idx);
     if (ue_cc_idx == 0) {
-      dl_cfg.pdsch.use_tbs_index_alt = ue_db.at(rnti).cell_info[ue_cc_idx].stash_use_tbs_index_alt;
+      dl_cfg.pdsch.use_tbs_index_alt = ue->cell_info[ue_cc_idx].stash_use_tbs_index_alt;
     }
   }
   return SRSRAN_SUCCESS;
@@ -442,20 +510,21 @@ int phy_ue_db::get_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dl_cfg_t
 
 int phy_ue_db::get_dci_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_cfg_t& dci_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  read_guard        db(*this);
+  srsran::phy_cfg_t phy_cfg = {};
 
-  if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
+  if (_get_rnti_config(*db, rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
   dci_cfg = phy_cfg.dl_cfg.dci;
 
   // The DCI configuration used for DL grants must overwrite the multiple_csi_request_enabled value with the
   // temporary value in case we are in the middle of a reconfiguration
-  if (ue_db.count(rnti) && SRSRAN_RNTI_ISUSER(rnti)) {
-    uint32_t ue_cc_idx = _get_ue_cc_idx(rnti, enb_cc_idx);
+  const common_ue* ue = _find_rnti(*db, rnti);
+  if (ue != nullptr && SRSRAN_RNTI_ISUSER(rnti)) {
+    uint32_t ue_cc_idx = _get_ue_cc_idx(*ue, enb_cc_idx);
     if (ue_cc_idx == 0) {
-      dci_cfg.multiple_csi_request_enabled = ue_db.at(rnti).stashed_multiple_csi_request_enabled;
+      dci_cfg.multiple_csi_request_enabled = ue->stashed_multiple_csi_request_enabled;
     }
   }
   return SRSRAN_SUCCESS;
@@ -463,10 +532,10 @@ int phy_ue_db::get_dci_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_
 
 int phy_ue_db::get_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_ul_cfg_t& ul_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  read_guard        db(*this);
+  srsran::phy_cfg_t phy_cfg = {};
 
-  if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
+  if (_get_rnti_config(*db, rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
   ul_cfg = phy_cfg.ul_cfg;
@@ -476,10 +545,10 @@ int phy_ue_db::get_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_ul_cfg_t
 
 int phy_ue_db::get_dci_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_cfg_t& dci_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  read_guard        db(*this);
+  srsran::phy_cfg_t phy_cfg = {};
 
-  if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
+  if (_get_rnti_config(*db, rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
   dci_cfg = phy_cfg.dl_cfg.dci;
@@ -489,17 +558,17 @@ int phy_ue_db::get_dci_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_
 
 bool phy_ue_db::set_ack_pending(uint32_t tti, uint32_t enb_cc_idx, const srsran_dci_dl_t& dci)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  read_guard db(*this);
 
   // Assert rnti and cell exits and it is active
-  if (_assert_active_enb_cc(dci.rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  const common_ue* ue = _find_active_enb_cc(*db, dci.rnti, enb_cc_idx);
+  if (ue == nullptr) {
     return false;
   }
 
-  common_ue& ue        = ue_db.at(dci.rnti);
-  uint32_t   ue_cc_idx = _get_ue_cc_idx(dci.rnti, enb_cc_idx);
+  uint32_t ue_cc_idx = _get_ue_cc_idx(*ue, enb_cc_idx);
 
-  srsran_pdsch_ack_cc_t& pdsch_ack_cc = ue.pdsch_ack[tti].cc[ue_cc_idx];
+  srsran_pdsch_ack_cc_t& pdsch_ack_cc = ue->feedback->pdsch_ack[tti].cc[ue_cc_idx];
   pdsch_ack_cc.M                      = 1; ///< Hardcoded for FDD
 
   // Fill PDSCH ACK information
@@ -530,7 +599,7 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
                             bool              is_pusch_available,
                             srsran_uci_cfg_t& uci_cfg)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  read_guard db(*this);
 
   // Reset UCI CFG, avoid returning carrying cached information
   uci_cfg = {};
@@ -541,12 +610,14 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
   }
 
   // Assert eNb Cell/Carrier for the given RNTI
-  if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  const common_ue* ue_ptr = _find_active_enb_cc(*db, rnti, enb_cc_idx);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
+  const common_ue& ue = *ue_ptr;
 
   // Get the eNb cell/carrier index with lowest serving cell index (ue_cc_idx) that has an available grant.
-  uint32_t uci_enb_cc_id         = _get_uci_enb_cc_idx(tti, rnti);
+  uint32_t uci_enb_cc_id         = _get_uci_enb_cc_idx(tti, ue);
   bool     pusch_grant_available = (uci_enb_cc_id < (uint32_t)cell_cfg_list->size());
 
   // There is a PUSCH grant available for the provided RNTI in at least one serving cell and this call is for PUCCH
@@ -560,11 +631,10 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
   }
 
   // No PUSCH grant for this TTI and cell and no enb_cc_idx is not the PCell
-  if (not pusch_grant_available and _get_ue_cc_idx(rnti, enb_cc_idx) != 0) {
+  if (not pusch_grant_available and _get_ue_cc_idx(ue, enb_cc_idx) != 0) {
     return SRSRAN_SUCCESS;
   }
 
-  common_ue&               ue           = ue_db.at(rnti);
   const srsran::phy_cfg_t& pcell_cfg    = ue.cell_info[0].phy_cfg;
   bool                     uci_required = false;
 
@@ -587,7 +657,8 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
       const srsran_cell_t& cell = cell_cfg_list->at(cell_info.enb_cc_idx).cell;
 
       // Check if CQI report is required
-      periodic_cqi_required = srsran_enb_dl_gen_cqi_periodic(&cell, &dl_cfg, tti, cell_info.last_ri, &uci_cfg.cqi);
+      periodic_cqi_required =
+          srsran_enb_dl_gen_cqi_periodic(&cell, &dl_cfg, tti, ue.feedback->cell[cell_idx].last_ri, &uci_cfg.cqi);
 
       // Save SCell index for using it after
       uci_cfg.cqi.scell_index = cell_idx;
@@ -600,13 +671,13 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
     // Aperiodic only supported for PCell
     const srsran_dl_cfg_t& dl_cfg = pcell_info.phy_cfg.dl_cfg;
 
-    uci_required = srsran_enb_dl_gen_cqi_aperiodic(&pcell, &dl_cfg, pcell_info.last_ri, &uci_cfg.cqi);
+    uci_required = srsran_enb_dl_gen_cqi_aperiodic(&pcell, &dl_cfg, ue.feedback->cell[0].last_ri, &uci_cfg.cqi);
   }
 
   // Get pending ACKs from PDSCH
   srsran_dl_sf_cfg_t dl_sf_cfg  = {};
   dl_sf_cfg.tti                 = tti;
-  srsran_pdsch_ack_t& pdsch_ack = ue.pdsch_ack[tti];
+  srsran_pdsch_ack_t& pdsch_ack = ue.feedback->pdsch_ack[tti];
   pdsch_ack.is_pusch_available  = is_pusch_available;
   srsran_enb_dl_gen_ack(&pcell, &dl_sf_cfg, &pdsch_ack, &uci_cfg);
   uci_required |= (srsran_uci_cfg_total_ack(&uci_cfg) > 0);
@@ -615,20 +686,33 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
   return uci_required ? 1 : SRSRAN_SUCCESS;
 }
 
-void phy_ue_db::send_cqi_data(uint32_t                      tti,
-                             uint16_t                       rnti,
-                             uint32_t                       cqi_cc_idx,
-                             const srsran_cqi_cfg_t&        cqi_cfg,
-                             const srsran_cqi_value_t&      cqi_value,
-                             const srsran_cqi_report_cfg_t& cqi_report_cfg,
-                             const srsran_cell_t&           cell,
-                             stack_interface_phy_lte*       stack)
-{
+void phy_ue_db::send_cqi_data(uint32_t                                         tti,
+                              uint16_t                                         rnti,
+                              uint32_t                                         cqi_cc_idx,
+                              const srsran_cqi_cfg_t&                          cqi_cfg,
+                              const srsran_cqi_value_t&                        cqi_value,
+                              const srsran_cqi_report_cfg_t&                   cqi_report_cfg,
+                              const srsran_cell_t&                             cell,
+                              stack_interface_phy_lte*                         stack,
+                              std::vector<stack_interface_phy_lte::ue_meas_t>* meas_list)
+{
+  // Wideband CQI, reported in the measurement batch when there is one
+  auto send_wideband_cqi = [&](uint32_t cqi) {
+    if (meas_list == nullptr) {
+      stack->cqi_info(tti, rnti, cqi_cc_idx, cqi);
+      return;
+    }
+    meas_list->emplace_back();
+    meas_list->back().rnti   = rnti;
+    meas_list->back().cc_idx = cqi_cc_idx;
+    meas_list->back().cqi    = cqi;
+  };
+
   uint8_t  stack_value = 0;
   switch (cqi_cfg.type) {
     case SRSRAN_CQI_TYPE_WIDEBAND:
       stack_value = cqi_value.wideband.wideband_cqi;
-      stack->cqi_info(tti, rnti, cqi_cc_idx, stack_value);
+      send_wideband_cqi(stack_value);
       break;
     case SRSRAN_CQI_TYPE_SUBBAND_UE:
       stack_value = cqi_value.subband_ue.subband_cqi;
@@ -641,7 +725,7 @@ void phy_ue_db::send_cqi_data(uint32_t                      tti,
     case SRSRAN_CQI_TYPE_SUBBAND_HL:
       stack_value = cqi_value.subband_hl.wideband_cqi_cw0;
       // Todo: change interface
-      stack->cqi_info(tti, rnti, cqi_cc_idx, stack_value);
+      send_wideband_cqi(stack_value);
       break;
     case SRSRAN_CQI_TYPE_SUBBAND_UE_DIFF:
       stack_value = cqi_value.subband_ue_diff.wideband_cqi;
@@ -654,16 +738,18 @@ void phy_ue_db::send_cqi_data(uint32_t                      tti,
   }
 }
 
-int phy_ue_db::send_uci_data(uint32_t                  tti,
-                             uint16_t                  rnti,
-                             uint32_t                  enb_cc_idx,
-                             const srsran_uci_cfg_t&   uci_cfg,
-                             const srsran_uci_value_t& uci_value)
+int phy_ue_db::send_uci_data(uint32_t                                         tti,
+                             uint16_t                                         rnti,
+                             uint32_t                                         enb_cc_idx,
+                             const srsran_uci_cfg_t&                          uci_cfg,
+                             const srsran_uci_value_t&                        uci_value,
+                             std::vector<stack_interface_phy_lte::ue_meas_t>* meas_list)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  read_guard db(*this);
 
   // Assert UE RNTI database entry and eNb cell/carrier must be active
-  if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  const common_ue* ue_ptr = _find_active_enb_cc(*db, rnti, enb_cc_idx);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
@@ -678,10 +764,10 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
   }
 
   // Get UE
-  common_ue& ue = ue_db.at(rnti);
+  const common_ue& ue = *ue_ptr;
 
   // Get ACK info
-  srsran_pdsch_ack_t& pdsch_ack = ue.pdsch_ack[tti];
+  srsran_pdsch_ack_t&  pdsch_ack = ue.feedback->pdsch_ack[tti];
   const srsran_cell_t& cell      = cell_cfg_list->at(ue.cell_info[0].enb_cc_idx).cell;
   srsran_enb_dl_get_ack(&cell, &uci_cfg, &uci_value, &pdsch_ack);
 
@@ -700,19 +786,27 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
   }
 
   // Assert the SCell exists and it is active
-  if (_assert_ue_cc(rnti, uci_cfg.cqi.scell_index) != SRSRAN_SUCCESS) {
+  if (_assert_ue_cc(*db, rnti, uci_cfg.cqi.scell_index) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // Get CQI carrier index
-  cell_info_t& cqi_scell_info = ue_db.at(rnti).cell_info[uci_cfg.cqi.scell_index];
-  uint32_t     cqi_cc_idx     = cqi_scell_info.enb_cc_idx;
+  const cell_info_t& cqi_scell_info = ue.cell_info[uci_cfg.cqi.scell_index];
+  uint32_t           cqi_cc_idx     = cqi_scell_info.enb_cc_idx;
 
   // Notify CQI only if CRC is valid
   if (uci_value.cqi.data_crc) {
     // Channel quality indicator itself
     if (uci_cfg.cqi.data_enable) {
-      send_cqi_data(tti, rnti, cqi_cc_idx, uci_cfg.cqi, uci_value.cqi, ue.cell_info[0].phy_cfg.dl_cfg.cqi_report, cell, stack);
+      send_cqi_data(tti,
+                    rnti,
+                    cqi_cc_idx,
+                    uci_cfg.cqi,
+                    uci_value.cqi,
+                    ue.cell_info[0].phy_cfg.dl_cfg.cqi_report,
+                    cell,
+                    stack,
+                    meas_list);
     }
 
     // Precoding Matrix indicator (TM4)
@@ -736,7 +830,7 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
   // Rank indicator (TM3 and TM4)
   if (uci_cfg.cqi.ri_len) {
     stack->ri_info(tti, rnti, cqi_cc_idx, uci_value.ri);
-    cqi_scell_info.last_ri = uci_value.ri;
+    ue.feedback->cell[uci_cfg.cqi.scell_index].last_ri = uci_value.ri;
   }
 
   return SRSRAN_SUCCESS;
@@ -744,43 +838,45 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
 
 int phy_ue_db::set_last_ul_tb(uint16_t rnti, uint32_t enb_cc_idx, uint32_t pid, srsran_ra_tb_t tb)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  read_guard db(*this);
 
   // Assert UE DB entry
-  if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  const common_ue* ue = _find_active_enb_cc(*db, rnti, enb_cc_idx);
+  if (ue == nullptr) {
     return SRSRAN_ERROR;
   }
 
   // Save resource allocation
-  ue_db.at(rnti).cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)].last_tb[pid] = tb;
+  ue->feedback->cell[_get_ue_cc_idx(*ue, enb_cc_idx)].last_tb[pid] = tb;
 
   return SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::get_last_ul_tb(uint16_t rnti, uint32_t enb_cc_idx, uint32_t pid, srsran_ra_tb_t& ra_tb) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  read_guard db(*this);
 
   // Assert UE DB entry
-  if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  const common_ue* ue = _find_active_enb_cc(*db, rnti, enb_cc_idx);
+  if (ue == nullptr) {
     return SRSRAN_ERROR;
   }
 
   // writes the latest stored UL transmission grant
-  ra_tb = ue_db.at(rnti).cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)].last_tb[pid];
+  ra_tb = ue->feedback->cell[_get_ue_cc_idx(*ue, enb_cc_idx)].last_tb[pid];
 
   return SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::set_ul_grant_available(uint32_t tti, const stack_interface_phy_lte::ul_sched_list_t& ul_sched_list)
 {
-  int                         ret = SRSRAN_SUCCESS;
-  std::lock_guard<std::mutex> lock(mutex);
+  int        ret = SRSRAN_SUCCESS;
+  read_guard db(*this);
 
   // Reset all available grants flags for the given TTI
-  for (auto& ue : ue_db) {
-    for (cell_info_t& cell_info : ue.second.cell_info) {
-      cell_info.is_grant_available[tti] = false;
+  for (auto& ue : *db) {
+    for (cell_feedback_t& cell_feedback : ue.second->feedback->cell) {
+      cell_feedback.is_grant_available[tti] = false;
     }
   }
 
@@ -791,13 +887,14 @@ int phy_ue_db::set_ul_grant_available(uint32_t tti, const stack_interface_phy_lt
       const stack_interface_phy_lte::ul_sched_grant_t& ul_sched_grant = ul_sched.pusch[i];
       uint16_t                                         rnti           = ul_sched_grant.dci.rnti;
       // Check that eNb Cell/Carrier is active for the given RNTI
-      if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+      const common_ue* ue = _find_active_enb_cc(*db, rnti, enb_cc_idx);
+      if (ue == nullptr) {
         ret = SRSRAN_ERROR;
         srslog::fetch_basic_logger("PHY").info("Error setting grant for rnti=0x%x, cc=%d", rnti, enb_cc_idx);
         continue;
       }
       // Rise Grant available flag
-      ue_db[rnti].cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)].is_grant_available[tti] = true;
+      ue->feedback->cell[_get_ue_cc_idx(*ue, enb_cc_idx)].is_grant_available[tti] = true;
     }
   }
 
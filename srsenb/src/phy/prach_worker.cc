@@ -29,7 +29,9 @@ int prach_worker::init(const srsran_cell_t&      cell_,
                        const srsran_prach_cfg_t& prach_cfg_,
                        stack_interface_phy_lte*  stack_,
                        int                       priority,
-                       uint32_t                  nof_workers_)
+                       uint32_t                  nof_workers_,
+                       uint32_t                  nof_corr_workers,
+                       const std::string&        cpu_list)
 {
   stack       = stack_;
   prach_cfg   = prach_cfg_;
@@ -42,6 +44,12 @@ int prach_worker::init(const srsran_cell_t&      cell_,
     return -1;
   }
 
+  // The root sequences are correlated by the extra threads in parallel with the PRACH worker
+  if (srsran_prach_set_nof_workers(&prach, nof_corr_workers)) {
+    ERROR("Error starting PRACH correlation workers");
+    return -1;
+  }
+
   if (srsran_prach_set_cfg(&prach, &prach_cfg, cell.nof_prb)) {
     ERROR("Error initiating PRACH");
     return -1;
@@ -51,8 +59,8 @@ int prach_worker::init(const srsran_cell_t&      cell_,
 
   nof_sf = (uint32_t)ceilf(prach.T_tot * 1000);
 
-  if (nof_workers > 0) {
-    start(priority);
+  if (nof_workers > 0 && not start_cpu_list(priority, cpu_list)) {
+    return -1;
   }
 
   initiated = true;
@@ -68,8 +68,7 @@ bool txrx::init(enb_time_interface*          enb_,
         new srsran::channel(worker_com->params.ul_channel_args, worker_com->get_nof_rf_channels(), logger));
   }
 
-  start(prio_);
-  return true;
+  return start_cpu_list(prio_, worker_com->params.txrx_cpus);
 }
 
 bool txrx::set_nr_workers(nr::worker_pool* nr_workers_)
@@ -100,6 +100,7 @@ int enb_stack_lte::init(const stack_args_t&      args_,
 
   // Set up pcap and trace
   if (args.mac_pcap.enable) {
+    mac_pcap.set_snaplen(args.mac_pcap.snaplen);
     mac_pcap.open(args.mac_pcap.filename);
     mac.start_pcap(&mac_pcap);
   }
@@ -127,14 +128,35 @@ int enb_stack_lte::init(const stack_args_t&      args_,
 
   // setup bearer managers
   gtpu_adapter.reset(new gtpu_pdcp_adapter(stack_logger, &pdcp, x2_, &gtpu, bearers));
+  if (args.traffic_gen.enable) {
+    tgen.reset(new traffic_gen(stack_logger, bearers));
+    if (tgen->init(args.traffic_gen, gtpu_adapter.get()) != SRSRAN_SUCCESS) {
+      stack_logger.error("Couldn't initialize the traffic generator");
+      return SRSRAN_ERROR;
+    }
+    gtpu_adapter->set_ul_sink(tgen.get());
+  }
 
   // Init all LTE layers
   if (!mac.init(args.mac, rrc_cfg.cell_list, phy, &rlc, &rrc)) {
     stack_logger.error("Couldn't initialize MAC");
     return SRSRAN_ERROR;
   }
-  rlc.init(&pdcp, &rrc, &mac, task_sched.get_timer_handler());
-  pdcp.init(&rlc, &rrc, gtpu_adapter.get());
+  rlc.set_ue_tx_budget(args.rlc_ue_tx_budget_kb * 1024);
+  if (args.mac.nof_ul_pdu_workers > 0 and args.nof_pdcp_shards == 0) {
+    // PDCP and GTP-U stay in the stack thread, while MAC and RLC process the UL PDUs in the MAC workers
+    pdcp_task_queue = task_sched.make_task_queue();
+    rlc.init(&pdcp, &rrc, &mac, task_sched.get_timer_handler(), &pdcp_task_queue);
+  } else {
+    rlc.init(&pdcp, &rrc, &mac, task_sched.get_timer_handler());
+  }
+  if (args.nof_pdcp_shards > 0) {
+    // The PDCP shards hand their UL PDUs for GTP-U and their events for RRC back to the stack thread
+    upper_task_queue = task_sched.make_task_queue();
+    pdcp.init(&rlc, &rrc, gtpu_adapter.get(), args.nof_pdcp_shards, &upper_task_queue, args.nof_pdcp_crypto_workers);
+  } else {
+    pdcp.init(&rlc, &rrc, gtpu_adapter.get(), 0, nullptr, args.nof_pdcp_crypto_workers);
+  }
   if (rrc.init(rrc_cfg, phy, &mac, &rlc, &pdcp, &s1ap, &gtpu, x2_) != SRSRAN_SUCCESS) {
     stack_logger.error("Couldn't initialize RRC");
     return SRSRAN_ERROR;
@@ -157,7 +179,10 @@ int enb_stack_lte::init(const stack_args_t&      args_,
   }
 
   started = true;
-  start(STACK_MAIN_THREAD_PRIO);
+  if (not start_cpu_list(STACK_MAIN_THREAD_PRIO, args.cpus)) {
+    stack_logger.error("Couldn't start the stack thread on CPUs %s", args.cpus.c_str());
+    return SRSRAN_ERROR;
+  }
 
   return SRSRAN_SUCCESS;
 }
@@ -172,7 +197,12 @@ void enb_stack_lte::tti_clock()
 void enb_stack_lte::tti_clock_impl()
 {
   task_sched.tic();
+  pdcp.tic();
   rrc.tti_clock();
+  gtpu.tic();
+  if (tgen != nullptr) {
+    tgen->tic();
+  }
 }
 
 void enb_stack_lte::stop()
@@ -224,6 +254,10 @@ bool enb_stack_lte::get_metrics(stack_metrics_t* metrics)
     }
     rrc.get_metrics(metrics.rrc);
     s1ap.get_metrics(metrics.s1ap);
+    gtpu.get_metrics(metrics.gtpu);
+    if (tgen != nullptr) {
+      tgen->get_metrics(metrics.traffic_gen);
+    }
     if (not pending_stack_metrics.try_push(metrics)) {
       stack_logger.error("Unable to push metrics to queue");
     }
@@ -0,0 +1,46 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/common/link_adaptation.h"
+#include <algorithm>
+
+namespace srsenb {
+
+olla_controller::olla_controller(float target_bler, float step_size, float max_offset_) : max_offset(max_offset_)
+{
+  if (target_bler > 0 and target_bler < 1 and step_size > 0) {
+    delta_up   = step_size;
+    delta_down = (1 - target_bler) * step_size / target_bler;
+  }
+}
+
+void olla_controller::harq_feedback(bool ack, int mcs, int max_mcs)
+{
+  if (not enabled()) {
+    return;
+  }
+  float delta_down_eff = mcs <= 0 ? 0 : delta_down;
+  float delta_up_eff   = mcs >= max_mcs ? 0 : delta_up;
+  offset += ack ? delta_up_eff : -delta_down_eff;
+  offset = std::min(std::max(-max_offset, offset), max_offset);
+}
+
+} // namespace srsenb
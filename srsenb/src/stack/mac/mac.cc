@@ -81,8 +81,9 @@ bool mac::init(const mac_args_t&        args_,
 
   // Initiate common pool of softbuffers
   uint32_t nof_prb          = args.nof_prb;
-  auto     init_softbuffers = [nof_prb](void* ptr) {
-    new (ptr) ue_cc_softbuffers(nof_prb, SRSRAN_FDD_NOF_HARQ, SRSRAN_FDD_NOF_HARQ);
+  bool     on_demand        = args.softbuffers_on_demand;
+  auto     init_softbuffers = [nof_prb, on_demand](void* ptr) {
+    new (ptr) ue_cc_softbuffers(nof_prb, SRSRAN_FDD_NOF_HARQ, SRSRAN_FDD_NOF_HARQ, on_demand);
   };
   auto recycle_softbuffers = [](ue_cc_softbuffers& softbuffers) { softbuffers.clear(); };
   softbuffer_pool.reset(new srsran::background_obj_pool<ue_cc_softbuffers>(
@@ -90,12 +91,22 @@ bool mac::init(const mac_args_t&        args_,
 
   detected_rachs.resize(cells.size());
 
+  for (uint32_t i = 0; i < args.nof_ul_pdu_workers; ++i) {
+    ul_pdu_workers.emplace_back(new srsran::task_worker(fmt::format("MAC_UL{}", i), 512));
+  }
+
   started = true;
   return true;
 }
 
 void mac::stop()
 {
+  // The UL PDU tasks take the UE DB lock
+  for (auto& w : ul_pdu_workers) {
+    w->stop();
+  }
+  ul_pdu_workers.clear();
+
   srsran::rwlock_write_guard lock(rwlock);
   if (started) {
     started = false;
@@ -246,14 +257,15 @@ void mac::get_metrics(mac_metrics_t& metrics)
   srsran::rwlock_read_guard lock(rwlock);
   metrics.ues.reserve(ue_db.size());
   for (auto& u : ue_db) {
-    if (not scheduler.ue_exists(u.first)) {
-      continue;
-    }
     metrics.ues.emplace_back();
     auto& ue_metrics = metrics.ues.back();
 
+    // A single scheduler lookup per UE, which also tells whether the UE exists in the scheduler
     u.second->metrics_read(&ue_metrics);
-    scheduler.metrics_read(u.first, ue_metrics);
+    if (scheduler.metrics_read(u.first, ue_metrics) != SRSRAN_SUCCESS) {
+      metrics.ues.pop_back();
+      continue;
+    }
     ue_metrics.pci = (ue_metrics.cc_idx < cell_config.size()) ? cell_config[ue_metrics.cc_idx].cell.id : 0;
   }
   metrics.cc_info.resize(detected_rachs.size());
@@ -294,8 +306,8 @@ int mac::ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
     return SRSRAN_ERROR;
   }
 
-  int nof_bytes = scheduler.dl_ack_info(tti_rx, rnti, enb_cc_idx, tb_idx, ack);
-  ue_db[rnti]->metrics_tx(ack, nof_bytes);
+  // The transmitted bytes are accounted by the scheduler once the ACK is processed
+  scheduler.dl_ack_info(tti_rx, rnti, enb_cc_idx, tb_idx, ack);
 
   rrc_h->set_radiolink_dl_state(rnti, ack);
 
@@ -348,15 +360,21 @@ int mac::push_pdu(uint32_t tti_rx,
                   tti_rx,
                   nof_bytes,
                   (int)pdu->size());
-    auto process_pdu_task = [this, rnti, enb_cc_idx, ul_nof_prbs](srsran::unique_byte_buffer_t& pdu) {
+    // The generation detects if the UE was removed and its slot reused before the PDU is processed
+    uint32_t ue_gen           = ue_db.generation(rnti);
+    auto     process_pdu_task = [this, rnti, ue_gen, enb_cc_idx, ul_nof_prbs](srsran::unique_byte_buffer_t& pdu) {
       srsran::rwlock_read_guard lock(rwlock);
-      if (check_ue_active(rnti)) {
+      if (ue_db.generation(rnti) == ue_gen and check_ue_active(rnti)) {
         ue_db[rnti]->process_pdu(std::move(pdu), enb_cc_idx, ul_nof_prbs);
       } else {
         logger.debug("Discarding PDU rnti=0x%x", rnti);
       }
     };
-    stack_task_queue.try_push(std::bind(process_pdu_task, std::move(pdu)));
+    if (ul_pdu_workers.empty()) {
+      stack_task_queue.try_push(std::bind(process_pdu_task, std::move(pdu)));
+    } else {
+      ul_pdu_workers[rnti % ul_pdu_workers.size()]->push_task(std::bind(process_pdu_task, std::move(pdu)));
+    }
   } else {
     logger.debug("Discarding PDU rnti=0x%x, tti_rx=%d, nof_bytes=%d", rnti, tti_rx, nof_bytes);
   }
@@ -450,6 +468,37 @@ int mac::ta_info(uint32_t tti, uint16_t rnti, float ta_us)
   return SRSRAN_SUCCESS;
 }
 
+int mac::meas_info(uint32_t tti, srsran::const_span<ue_meas_t> meas)
+{
+  logger.set_context(tti);
+  srsran::rwlock_read_guard lock(rwlock);
+
+  int ret = SRSRAN_SUCCESS;
+  for (const ue_meas_t& m : meas) {
+    if (not check_ue_active(m.rnti)) {
+      ret = SRSRAN_ERROR;
+      continue;
+    }
+    ue* user = ue_db[m.rnti].get();
+
+    if (m.cqi >= 0) {
+      scheduler.dl_cqi_info(tti, m.rnti, m.cc_idx, m.cqi);
+      user->metrics_dl_cqi(m.cqi);
+    }
+    if (not std::isnan(m.snr_db)) {
+      rrc_h->set_radiolink_ul_state(m.rnti, m.snr_db >= args.rlf_min_ul_snr_estim);
+      scheduler.ul_snr_info(tti, m.rnti, m.cc_idx, m.snr_db, (uint32_t)m.ch);
+    }
+    if (not std::isnan(m.ta_us)) {
+      uint32_t nof_ta_count = user->set_ta_us(m.ta_us);
+      if (nof_ta_count > 0) {
+        scheduler.dl_mac_buffer_state(m.rnti, (uint32_t)srsran::dl_sch_lcid::TA_CMD, nof_ta_count);
+      }
+    }
+  }
+  return ret;
+}
+
 int mac::sr_detected(uint32_t tti, uint16_t rnti)
 {
   logger.set_context(tti);
@@ -497,8 +546,17 @@ uint16_t mac::allocate_ue(uint32_t enb_cc_idx)
     }
 
     // Allocate and initialize UE object
-    unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(
-        rnti, rnti, enb_cc_idx, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pool.get());
+    unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(rnti,
+                                                   rnti,
+                                                   enb_cc_idx,
+                                                   &scheduler,
+                                                   rrc_h,
+                                                   rlc_h,
+                                                   phy_h,
+                                                   logger,
+                                                   cells.size(),
+                                                   softbuffer_pool.get(),
+                                                   ul_pdu_workers.empty() ? nullptr : &stack_task_queue);
 
     // Add UE to rnti map
     srsran::rwlock_write_guard rw_lock(rwlock);
@@ -667,8 +725,8 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
         dl_sched_res->pdsch[n].dci = sched_result.data[i].dci;
 
         for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
-          dl_sched_res->pdsch[n].softbuffer_tx[tb] =
-              ue_db[rnti]->get_tx_softbuffer(enb_cc_idx, sched_result.data[i].dci.pid, tb);
+          dl_sched_res->pdsch[n].softbuffer_tx[tb] = ue_db[rnti]->get_tx_softbuffer(
+              enb_cc_idx, sched_result.data[i].dci.pid, tb, sched_result.data[i].tbs[tb]);
 
           // If the Rx soft-buffer is not given, abort transmission
           if (dl_sched_res->pdsch[n].softbuffer_tx[tb] == nullptr) {
@@ -997,7 +1055,8 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
           phy_ul_sched_res->pusch[n].pid           = TTI_RX(tti_tx_ul) % SRSRAN_FDD_NOF_HARQ;
           phy_ul_sched_res->pusch[n].needs_pdcch   = sched_result.pusch[i].needs_pdcch;
           phy_ul_sched_res->pusch[n].dci           = sched_result.pusch[i].dci;
-          phy_ul_sched_res->pusch[n].softbuffer_rx = ue_db[rnti]->get_rx_softbuffer(enb_cc_idx, tti_tx_ul);
+          phy_ul_sched_res->pusch[n].softbuffer_rx =
+              ue_db[rnti]->get_rx_softbuffer(enb_cc_idx, tti_tx_ul, sched_result.pusch[i].tbs);
 
           // If the Rx soft-buffer is not given, abort reception
           if (phy_ul_sched_res->pusch[n].softbuffer_rx == nullptr) {
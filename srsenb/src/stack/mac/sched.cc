@@ -29,6 +29,7 @@
 
 #define Console(fmt, ...) srsran::console(fmt, ##__VA_ARGS__)
 #define Error(fmt, ...) srslog::fetch_basic_logger("MAC").error(fmt, ##__VA_ARGS__)
+#define Warning(fmt, ...) srslog::fetch_basic_logger("MAC").warning(fmt, ##__VA_ARGS__)
 
 using srsran::tti_point;
 
@@ -42,7 +43,12 @@ namespace srsenb {
 
 sched::sched() {}
 
-sched::~sched() {}
+sched::~sched()
+{
+  if (cc_workers != nullptr) {
+    cc_workers->stop();
+  }
+}
 
 void sched::init(rrc_interface_mac* rrc_, const sched_args_t& sched_cfg_)
 {
@@ -52,6 +58,10 @@ void sched::init(rrc_interface_mac* rrc_, const sched_args_t& sched_cfg_)
   // Initialize first carrier scheduler
   carrier_schedulers.emplace_back(new carrier_sched{rrc, &ue_db, 0, &sched_results});
 
+  if (sched_cfg.nof_cc_workers > 0) {
+    cc_workers.reset(new srsran::task_thread_pool(sched_cfg.nof_cc_workers));
+  }
+
   reset();
 }
 
@@ -62,6 +72,16 @@ int sched::reset()
     c->reset();
   }
   ue_db.clear();
+
+  // Drop the feedback of the removed UEs
+  auto clear_queue = [](ue_event_queue& q) {
+    std::lock_guard<std::mutex> ev_lock(q.mutex);
+    q.next_events.clear();
+  };
+  clear_queue(ue_events);
+  for (ue_event_queue& q : cc_ue_events) {
+    clear_queue(q);
+  }
   return 0;
 }
 
@@ -109,6 +129,7 @@ int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
     auto                        it = ue_db.find(rnti);
     if (it != ue_db.end()) {
       it->second->set_cfg(ue_cfg);
+      it->second->bump_state_version();
       return SRSRAN_SUCCESS;
     }
   }
@@ -176,53 +197,85 @@ uint32_t sched::get_ul_buffer(uint16_t rnti)
 
 int sched::dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t prio_tx_queue)
 {
-  return ue_db_access_locked(rnti, [&](sched_ue& ue) { ue.dl_buffer_state(lc_id, tx_queue, prio_tx_queue); });
+  enqueue_ue_event(ue_events, "dl_rlc_buffer_state", rnti, [lc_id, tx_queue, prio_tx_queue](sched_ue& ue) {
+    ue.dl_buffer_state(lc_id, tx_queue, prio_tx_queue);
+  });
+  return SRSRAN_SUCCESS;
 }
 
 int sched::dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmds)
 {
-  return ue_db_access_locked(rnti, [ce_code, nof_cmds](sched_ue& ue) { ue.mac_buffer_state(ce_code, nof_cmds); });
+  enqueue_ue_event(ue_events, "dl_mac_buffer_state", rnti, [ce_code, nof_cmds](sched_ue& ue) {
+    ue.mac_buffer_state(ce_code, nof_cmds);
+  });
+  return SRSRAN_SUCCESS;
 }
 
 int sched::dl_ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)
 {
-  int ret = -1;
-  ue_db_access_locked(
-      rnti,
-      [&](sched_ue& ue) { ret = ue.set_ack_info(tti_point{tti_rx}, enb_cc_idx, tb_idx, ack); },
-      __PRETTY_FUNCTION__);
-  return ret;
+  if (enb_cc_idx >= cc_ue_events.size()) {
+    return SRSRAN_ERROR;
+  }
+  enqueue_ue_event(cc_ue_events[enb_cc_idx], "dl_ack_info", rnti, [tti_rx, enb_cc_idx, tb_idx, ack](sched_ue& ue) {
+    ue.set_ack_info(tti_point{tti_rx}, enb_cc_idx, tb_idx, ack);
+  });
+  return SRSRAN_SUCCESS;
 }
 
 int sched::ul_crc_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, bool crc)
 {
-  return ue_db_access_locked(
-      rnti, [tti_rx, enb_cc_idx, crc](sched_ue& ue) { ue.set_ul_crc(tti_point{tti_rx}, enb_cc_idx, crc); });
+  if (enb_cc_idx >= cc_ue_events.size()) {
+    return SRSRAN_ERROR;
+  }
+  enqueue_ue_event(cc_ue_events[enb_cc_idx], "ul_crc_info", rnti, [tti_rx, enb_cc_idx, crc](sched_ue& ue) {
+    ue.set_ul_crc(tti_point{tti_rx}, enb_cc_idx, crc);
+  });
+  return SRSRAN_SUCCESS;
 }
 
 int sched::dl_ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_value)
 {
-  return ue_db_access_locked(
-      rnti, [tti, enb_cc_idx, ri_value](sched_ue& ue) { ue.set_dl_ri(tti_point{tti}, enb_cc_idx, ri_value); });
+  if (enb_cc_idx >= cc_ue_events.size()) {
+    return SRSRAN_ERROR;
+  }
+  enqueue_ue_event(cc_ue_events[enb_cc_idx], "dl_ri_info", rnti, [tti, enb_cc_idx, ri_value](sched_ue& ue) {
+    ue.set_dl_ri(tti_point{tti}, enb_cc_idx, ri_value);
+  });
+  return SRSRAN_SUCCESS;
 }
 
 int sched::dl_pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi_value)
 {
-  return ue_db_access_locked(
-      rnti, [tti, enb_cc_idx, pmi_value](sched_ue& ue) { ue.set_dl_pmi(tti_point{tti}, enb_cc_idx, pmi_value); });
+  if (enb_cc_idx >= cc_ue_events.size()) {
+    return SRSRAN_ERROR;
+  }
+  enqueue_ue_event(cc_ue_events[enb_cc_idx], "dl_pmi_info", rnti, [tti, enb_cc_idx, pmi_value](sched_ue& ue) {
+    ue.set_dl_pmi(tti_point{tti}, enb_cc_idx, pmi_value);
+  });
+  return SRSRAN_SUCCESS;
 }
 
 int sched::dl_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi_value)
 {
-  return ue_db_access_locked(
-      rnti, [tti, enb_cc_idx, cqi_value](sched_ue& ue) { ue.set_dl_cqi(tti_point{tti}, enb_cc_idx, cqi_value); });
+  if (enb_cc_idx >= cc_ue_events.size()) {
+    return SRSRAN_ERROR;
+  }
+  enqueue_ue_event(cc_ue_events[enb_cc_idx], "dl_cqi_info", rnti, [tti, enb_cc_idx, cqi_value](sched_ue& ue) {
+    ue.set_dl_cqi(tti_point{tti}, enb_cc_idx, cqi_value);
+  });
+  return SRSRAN_SUCCESS;
 }
 
 int sched::dl_sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t sb_idx, uint32_t cqi_value)
 {
-  return ue_db_access_locked(rnti, [tti, enb_cc_idx, cqi_value, sb_idx](sched_ue& ue) {
-    ue.set_dl_sb_cqi(tti_point{tti}, enb_cc_idx, sb_idx, cqi_value);
-  });
+  if (enb_cc_idx >= cc_ue_events.size()) {
+    return SRSRAN_ERROR;
+  }
+  enqueue_ue_event(
+      cc_ue_events[enb_cc_idx], "dl_sb_cqi_info", rnti, [tti, enb_cc_idx, cqi_value, sb_idx](sched_ue& ue) {
+        ue.set_dl_sb_cqi(tti_point{tti}, enb_cc_idx, sb_idx, cqi_value);
+      });
+  return SRSRAN_SUCCESS;
 }
 
 int sched::dl_rach_info(uint32_t enb_cc_idx, dl_sched_rar_info_t rar_info)
@@ -233,30 +286,38 @@ int sched::dl_rach_info(uint32_t enb_cc_idx, dl_sched_rar_info_t rar_info)
 
 int sched::ul_snr_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, float snr, uint32_t ul_ch_code)
 {
-  return ue_db_access_locked(rnti,
-                             [&](sched_ue& ue) { ue.set_ul_snr(tti_point{tti_rx}, enb_cc_idx, snr, ul_ch_code); });
+  if (enb_cc_idx >= cc_ue_events.size()) {
+    return SRSRAN_ERROR;
+  }
+  enqueue_ue_event(
+      cc_ue_events[enb_cc_idx], "ul_snr_info", rnti, [tti_rx, enb_cc_idx, snr, ul_ch_code](sched_ue& ue) {
+        ue.set_ul_snr(tti_point{tti_rx}, enb_cc_idx, snr, ul_ch_code);
+      });
+  return SRSRAN_SUCCESS;
 }
 
 int sched::ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)
 {
-  return ue_db_access_locked(rnti, [lcg_id, bsr](sched_ue& ue) { ue.ul_buffer_state(lcg_id, bsr); });
+  enqueue_ue_event(ue_events, "ul_bsr", rnti, [lcg_id, bsr](sched_ue& ue) { ue.ul_buffer_state(lcg_id, bsr); });
+  return SRSRAN_SUCCESS;
 }
 
 int sched::ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes)
 {
-  return ue_db_access_locked(rnti, [lcid, bytes](sched_ue& ue) { ue.ul_buffer_add(lcid, bytes); });
+  enqueue_ue_event(ue_events, "ul_buffer_add", rnti, [lcid, bytes](sched_ue& ue) { ue.ul_buffer_add(lcid, bytes); });
+  return SRSRAN_SUCCESS;
 }
 
 int sched::ul_phr(uint16_t rnti, int phr, uint32_t ul_nof_prb)
 {
-  return ue_db_access_locked(
-      rnti, [phr, ul_nof_prb](sched_ue& ue) { ue.ul_phr(phr, ul_nof_prb); }, __PRETTY_FUNCTION__);
+  enqueue_ue_event(ue_events, "ul_phr", rnti, [phr, ul_nof_prb](sched_ue& ue) { ue.ul_phr(phr, ul_nof_prb); });
+  return SRSRAN_SUCCESS;
 }
 
 int sched::ul_sr_info(uint32_t tti, uint16_t rnti)
 {
-  return ue_db_access_locked(
-      rnti, [](sched_ue& ue) { ue.set_sr(); }, __PRETTY_FUNCTION__);
+  enqueue_ue_event(ue_events, "ul_sr_info", rnti, [](sched_ue& ue) { ue.set_sr(); });
+  return SRSRAN_SUCCESS;
 }
 
 void sched::set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs)
@@ -361,6 +422,17 @@ void sched::new_tti(tti_point tti_rx)
 {
   last_tti = std::max(last_tti, tti_rx);
 
+  // Apply the UE feedback received since the last call, the UE-wide events first
+  process_ue_events(ue_events);
+  for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+    process_ue_events(cc_ue_events[cc_idx]);
+  }
+
+  if (cc_workers != nullptr and carrier_schedulers.size() > 1) {
+    generate_parallel_tti_results(tti_rx);
+    return;
+  }
+
   // Generate sched results for all CCs, if not yet generated
   for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
     if (not is_generated(tti_rx, cc_idx)) {
@@ -370,16 +442,152 @@ void sched::new_tti(tti_point tti_rx)
   }
 }
 
+/// Generate the missing CC results of tti_rx with the MAC thread and the CC workers
+void sched::generate_parallel_tti_results(tti_point tti_rx)
+{
+  // Set up the state that the first carrier of the TTI would otherwise initialize
+  for (auto& u : ue_db) {
+    u.second->new_subframe(tti_rx, 0);
+  }
+  if (not sched_results.has_sf(tti_rx)) {
+    sched_results.new_tti(tti_rx);
+  }
+  if (not sched_results.has_sf(tti_rx + MSG3_DELAY_MS)) {
+    sched_results.new_tti(tti_rx + MSG3_DELAY_MS);
+  }
+
+  // Each carrier waits for the lower carriers of its CA UEs
+  cc_deps.fill(0);
+  for (auto& u : ue_db) {
+    const auto& cc_list = u.second->get_ue_cfg().supported_cc_list;
+    if (cc_list.size() <= 1) {
+      continue;
+    }
+    uint32_t ue_cc_mask = 0;
+    for (const auto& cc : cc_list) {
+      ue_cc_mask |= 1U << cc.enb_cc_idx;
+    }
+    for (const auto& cc : cc_list) {
+      cc_deps[cc.enb_cc_idx] |= ue_cc_mask & ((1U << cc.enb_cc_idx) - 1U);
+    }
+  }
+
+  uint32_t nof_tasks = 0;
+  {
+    std::lock_guard<std::mutex> lock(cc_mutex);
+    cc_all_mask     = (1U << carrier_schedulers.size()) - 1U;
+    cc_started_mask = 0;
+    for (uint32_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+      if (is_generated(tti_rx, cc_idx)) {
+        cc_started_mask |= 1U << cc_idx;
+      } else {
+        nof_tasks++;
+      }
+    }
+    cc_done_mask   = cc_started_mask;
+    nof_cc_helpers = std::min(nof_tasks, (uint32_t)cc_workers->nof_workers() + 1) - 1;
+  }
+
+  for (uint32_t i = 0; i < nof_cc_helpers; ++i) {
+    cc_workers->push_task([this, tti_rx]() {
+      run_carrier_tasks(tti_rx);
+      std::lock_guard<std::mutex> lock(cc_mutex);
+      nof_cc_helpers--;
+      cc_cvar.notify_all();
+    });
+  }
+  run_carrier_tasks(tti_rx);
+
+  // The helpers must be out of the carrier loop before the next TTI resets it
+  std::unique_lock<std::mutex> lock(cc_mutex);
+  while (cc_done_mask != cc_all_mask or nof_cc_helpers > 0) {
+    cc_cvar.wait(lock);
+  }
+}
+
+/// Generate carrier results until none is left, taking the lowest carrier whose dependencies are done
+void sched::run_carrier_tasks(tti_point tti_rx)
+{
+  std::unique_lock<std::mutex> lock(cc_mutex);
+  while (cc_started_mask != cc_all_mask) {
+    int next_cc = -1;
+    for (uint32_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+      if ((cc_started_mask & (1U << cc_idx)) == 0 and (cc_done_mask & cc_deps[cc_idx]) == cc_deps[cc_idx]) {
+        next_cc = cc_idx;
+        break;
+      }
+    }
+    if (next_cc < 0) {
+      // The pending carriers share CA UEs with carriers still running
+      cc_cvar.wait(lock);
+      continue;
+    }
+
+    cc_started_mask |= 1U << next_cc;
+    lock.unlock();
+    carrier_schedulers[next_cc]->generate_tti_result(tti_rx);
+    lock.lock();
+    cc_done_mask |= 1U << next_cc;
+    cc_cvar.notify_all();
+  }
+}
+
 /// Check if TTI result is generated
 bool sched::is_generated(srsran::tti_point tti_rx, uint32_t enb_cc_idx) const
 {
   return sched_results.has_sf(tti_rx) and sched_results.get_sf(tti_rx)->is_generated(enb_cc_idx);
 }
 
+void sched::enqueue_ue_event(ue_event_queue&                        queue,
+                             const char*                            event_name,
+                             uint16_t                               rnti,
+                             srsran::move_callback<void(sched_ue&)> callback)
+{
+  std::lock_guard<std::mutex> ev_lock(queue.mutex);
+  queue.next_events.emplace_back(rnti, event_name, std::move(callback));
+}
+
+/// Swap the pending events out of the queue and apply them. The queue mutex is released before any UE is updated
+void sched::process_ue_events(ue_event_queue& queue)
+{
+  queue.current_events.clear();
+  {
+    std::lock_guard<std::mutex> ev_lock(queue.mutex);
+    queue.next_events.swap(queue.current_events);
+  }
+
+  for (ue_event_t& ev : queue.current_events) {
+    auto it = ue_db.find(ev.rnti);
+    if (it == ue_db.end()) {
+      Warning("SCHED: \"%s\" called for unknown rnti=0x%x.", ev.event_name, ev.rnti);
+      continue;
+    }
+    ev.callback(*it->second);
+    it->second->bump_state_version();
+  }
+}
+
 int sched::metrics_read(uint16_t rnti, mac_ue_metrics_t& metrics)
 {
   return ue_db_access_locked(
-      rnti, [&metrics](sched_ue& ue) { ue.metrics_read(metrics); }, "metrics_read");
+      rnti,
+      [this, &metrics](sched_ue& ue) {
+        ue.metrics_read(metrics);
+        metrics.dl_buffer = ue.get_pending_dl_rlc_data();
+        metrics.ul_buffer = ue.get_pending_ul_new_data(to_tx_ul(last_tti), -1);
+
+        // Sector of the PCell
+        metrics.cc_idx = SRSRAN_MAX_CARRIERS;
+        for (size_t enb_cc_idx = 0; enb_cc_idx < carrier_schedulers.size(); ++enb_cc_idx) {
+          const sched_ue_cell* cc_ue = ue.find_ue_carrier(enb_cc_idx);
+          if (cc_ue != nullptr and cc_ue->get_ue_cc_idx() == 0) {
+            metrics.cc_idx = enb_cc_idx;
+            break;
+          }
+        }
+      },
+      nullptr,
+      false);
 }
 
 // Common way to access ue_db elements in a read locking way
@@ -390,6 +598,7 @@ int sched::ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name, b
   auto                        it = ue_db.find(rnti);
   if (it != ue_db.end()) {
     f(*it->second);
+    it->second->bump_state_version();
   } else {
     if (log_fail) {
       if (func_name != nullptr) {
@@ -34,22 +34,29 @@ void sf_sched_result::new_tti(tti_point tti_rx_)
   }
 }
 
-bool sf_sched_result::is_ul_alloc(uint16_t rnti) const
+// Only the carriers configured for the UE are looked up, the other ones may be scheduled concurrently
+bool sf_sched_result::is_ul_alloc(const sched_ue& user) const
 {
-  for (const auto& cc : enb_cc_list) {
-    for (const auto& pusch : cc.ul_sched_result.pusch) {
-      if (pusch.dci.rnti == rnti) {
+  for (const auto& ue_cc : user.get_ue_cfg().supported_cc_list) {
+    if (ue_cc.enb_cc_idx >= enb_cc_list.size()) {
+      continue;
+    }
+    for (const auto& pusch : enb_cc_list[ue_cc.enb_cc_idx].ul_sched_result.pusch) {
+      if (pusch.dci.rnti == user.get_rnti()) {
         return true;
       }
     }
   }
   return false;
 }
-bool sf_sched_result::is_dl_alloc(uint16_t rnti) const
+bool sf_sched_result::is_dl_alloc(const sched_ue& user) const
 {
-  for (const auto& cc : enb_cc_list) {
-    for (const auto& data : cc.dl_sched_result.data) {
-      if (data.dci.rnti == rnti) {
+  for (const auto& ue_cc : user.get_ue_cfg().supported_cc_list) {
+    if (ue_cc.enb_cc_idx >= enb_cc_list.size()) {
+      continue;
+    }
+    for (const auto& data : enb_cc_list[ue_cc.enb_cc_idx].dl_sched_result.data) {
+      if (data.dci.rnti == user.get_rnti()) {
         return true;
       }
     }
@@ -280,21 +287,18 @@ alloc_result sf_grid_t::reserve_ul_prbs(const prbmask_t& prbmask, bool strict)
  */
 bool sf_grid_t::find_ul_alloc(uint32_t L, prb_interval* alloc) const
 {
-  *alloc = {};
-  for (uint32_t n = 0; n < ul_mask.size() && alloc->length() < L; n++) {
-    if (not ul_mask.test(n) && alloc->length() == 0) {
-      alloc->displace_to(n);
-    }
-    if (not ul_mask.test(n)) {
-      alloc->resize_by(1);
-    } else if (alloc->length() > 0) {
-      // avoid edges
-      if (n < 3) {
-        *alloc = {};
-      } else {
-        break;
-      }
+  *alloc  = {};
+  int pos = ul_mask.find_lowest(0, ul_mask.size(), false);
+  while (pos >= 0) {
+    int stop = ul_mask.find_lowest(pos, ul_mask.size(), true);
+    stop     = stop < 0 ? ul_mask.size() : stop;
+    alloc->set(pos, std::min((uint32_t)stop, pos + L));
+    // avoid edges
+    if (alloc->length() == L or stop >= 3 or stop == (int)ul_mask.size()) {
+      break;
     }
+    *alloc = {};
+    pos    = ul_mask.find_lowest(stop, ul_mask.size(), false);
   }
   if (alloc->length() == 0) {
     return false;
@@ -538,7 +542,7 @@ alloc_result sf_sched::alloc_dl_user(sched_ue* user, const rbgmask_t& user_mask,
     }
   }
 
-  bool has_pusch_grant = is_ul_alloc(user->get_rnti()) or cc_results->is_ul_alloc(user->get_rnti());
+  bool has_pusch_grant = is_ul_alloc(user->get_rnti()) or cc_results->is_ul_alloc(*user);
 
   // Check if there is space in the PUCCH for HARQ ACKs
   const sched_interface::ue_cfg_t& ue_cfg    = user->get_ue_cfg();
@@ -822,12 +826,16 @@ uci_pusch_t is_uci_included(const sf_sched*        sf_sched,
   }
 
   for (uint32_t enbccidx = 0; enbccidx < other_cc_results.enb_cc_list.size(); ++enbccidx) {
+    // Skip the carriers not active for the UE before reading their results, they may be scheduled concurrently
+    auto p = user->get_active_cell_index(enbccidx);
+    if (not p.first) {
+      continue;
+    }
     for (uint32_t j = 0; j < other_cc_results.enb_cc_list[enbccidx].ul_sched_result.pusch.size(); ++j) {
       // Checks all the UL grants already allocated for the given rnti
       if (other_cc_results.enb_cc_list[enbccidx].ul_sched_result.pusch[j].dci.rnti == user->get_rnti()) {
-        auto p = user->get_active_cell_index(enbccidx);
         // If the UE CC Idx is the lowest so far
-        if (p.first and p.second < ue_cc_idx) {
+        if (p.second < ue_cc_idx) {
           ue_cc_idx      = p.second;
           sel_enb_cc_idx = enbccidx;
         }
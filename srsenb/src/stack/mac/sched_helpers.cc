@@ -283,6 +283,9 @@ bool sched_cell_params_t::set_cfg(uint32_t                             enb_cc_id
     return false;
   }
 
+  // The UE-specific locations are generated on demand
+  ue_locations.reset(regs.get());
+
   // Compute UE locations for RA-RNTI
   for (uint32_t cfi = 0; cfi < SRSRAN_NOF_CFI; cfi++) {
     for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
@@ -352,16 +355,89 @@ sched_cell_params_t::get_dl_nof_res(srsran::tti_point tti_tx_dl, const srsran_dc
   return nof_re;
 }
 
-cce_frame_position_table generate_cce_location_table(uint16_t rnti, const sched_cell_params_t& cell_cfg)
+/// Hash Yk of the UE-specific search space for a given RNTI and subframe index. See TS 36.213 9.1.1
+static uint32_t get_ue_cce_hash(uint16_t rnti, uint32_t sf_idx)
 {
-  cce_frame_position_table dci_locations = {};
-  // Generate allowed CCE locations
-  for (int cfi = 0; cfi < SRSRAN_NOF_CFI; cfi++) {
-    for (int sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
-      generate_cce_location(cell_cfg.regs.get(), dci_locations[sf_idx][cfi], cfi + 1, sf_idx, rnti);
+  uint32_t Yk = rnti;
+  for (uint32_t m = 0; m < sf_idx + 1; m++) {
+    Yk = (39827 * Yk) % 65537;
+  }
+  return Yk;
+}
+
+void cce_ue_location_cache::reset(srsran_regs_t* regs_)
+{
+  regs     = regs_;
+  nof_used = 0;
+  lru_head = -1;
+  lru_tail = -1;
+  buckets.fill(-1);
+}
+
+const cce_cfi_position_table& cce_ue_location_cache::get(uint16_t rnti, uint32_t sf_idx, uint32_t cfix)
+{
+  uint32_t key    = get_ue_cce_hash(rnti, sf_idx) * SRSRAN_NOF_CFI + cfix;
+  uint32_t bucket = key % NOF_BUCKETS;
+  for (int16_t idx = buckets[bucket]; idx >= 0; idx = entries[idx].bucket_next) {
+    if (entries[idx].key == key) {
+      if (idx != lru_head) {
+        lru_unlink(idx);
+        lru_push_front(idx);
+      }
+      return entries[idx].table;
+    }
+  }
+
+  // Cache miss. Take an unused entry or evict the least recently used one
+  int16_t idx;
+  if (nof_used < CACHE_SIZE) {
+    idx = nof_used++;
+  } else {
+    idx = lru_tail;
+    lru_unlink(idx);
+    int16_t* prev_link = &buckets[entries[idx].key % NOF_BUCKETS];
+    while (*prev_link != idx) {
+      prev_link = &entries[*prev_link].bucket_next;
     }
+    *prev_link = entries[idx].bucket_next;
+  }
+  entry& e        = entries[idx];
+  e.key           = key;
+  e.bucket_next   = buckets[bucket];
+  buckets[bucket] = idx;
+  lru_push_front(idx);
+  generate_cce_location(regs, e.table, cfix + 1, sf_idx, rnti);
+  return e.table;
+}
+
+void cce_ue_location_cache::lru_unlink(int16_t idx)
+{
+  entry& e = entries[idx];
+  if (e.prev >= 0) {
+    entries[e.prev].next = e.next;
+  } else {
+    lru_head = e.next;
+  }
+  if (e.next >= 0) {
+    entries[e.next].prev = e.prev;
+  } else {
+    lru_tail = e.prev;
+  }
+  e.prev = -1;
+  e.next = -1;
+}
+
+void cce_ue_location_cache::lru_push_front(int16_t idx)
+{
+  entries[idx].prev = -1;
+  entries[idx].next = lru_head;
+  if (lru_head >= 0) {
+    entries[lru_head].prev = idx;
+  }
+  lru_head = idx;
+  if (lru_tail < 0) {
+    lru_tail = idx;
   }
-  return dci_locations;
 }
 
 void generate_cce_location(srsran_regs_t*          regs_,
@@ -51,26 +51,17 @@ template <typename RBMask,
               typename std::conditional<std::is_same<RBMask, prbmask_t>::value, prb_interval, rbg_interval>::type>
 RBInterval find_contiguous_interval(const RBMask& in_mask, uint32_t max_size)
 {
-  RBInterval max_interv;
-
-  for (size_t n = 0; n < in_mask.size();) {
-    int pos = in_mask.find_lowest(n, in_mask.size(), false);
-    if (pos < 0) {
-      break;
-    }
-
-    size_t     max_pos = std::min(in_mask.size(), (size_t)pos + max_size);
-    int        pos2    = in_mask.find_lowest(pos + 1, max_pos, true);
-    RBInterval interv(pos, pos2 < 0 ? max_pos : pos2);
-    if (interv.length() >= max_size) {
-      return interv;
-    }
-    if (interv.length() > max_interv.length()) {
-      max_interv = interv;
-    }
-    n = interv.stop();
+  // first empty interval with max_size RBs or, if there is none, the largest empty interval
+  int pos = in_mask.find_first_fit(max_size, 0, in_mask.size(), false);
+  if (pos >= 0) {
+    return RBInterval(pos, pos + max_size);
+  }
+  pos = in_mask.find_best_fit(max_size, 0, in_mask.size(), false);
+  if (pos < 0) {
+    return RBInterval();
   }
-  return max_interv;
+  int stop = in_mask.find_lowest(pos, in_mask.size(), true);
+  return RBInterval(pos, stop < 0 ? in_mask.size() : stop);
 }
 
 rbgmask_t find_available_rbgmask(const rbgmask_t& in_mask, uint32_t max_size)
@@ -83,13 +74,15 @@ rbgmask_t find_available_rbgmask(const rbgmask_t& in_mask, uint32_t max_size)
     return localmask;
   }
 
-  uint32_t i = 0, nof_alloc = 0;
-  for (; i < localmask.size() and nof_alloc < max_size; ++i) {
-    if (localmask.test(i)) {
-      nof_alloc++;
-    }
+  // walk the free intervals until max_size RBGs are accumulated
+  size_t pos = 0, nof_alloc = 0;
+  while (nof_alloc < max_size) {
+    int start = localmask.find_lowest(pos, localmask.size(), true);
+    int stop  = localmask.find_lowest(start, localmask.size(), false);
+    pos       = stop < 0 ? localmask.size() : stop;
+    nof_alloc += pos - start;
   }
-  localmask.fill(i, localmask.size(), false);
+  localmask.fill(pos - (nof_alloc - max_size), localmask.size(), false);
   return localmask;
 }
 
@@ -22,6 +22,7 @@
 #include "srsenb/hdr/stack/mac/sched_phy_ch/sf_cch_allocator.h"
 #include "srsenb/hdr/stack/mac/sched_grid.h"
 #include "srsran/srslog/bundled/fmt/format.h"
+#include <algorithm>
 
 namespace srsenb {
 
@@ -40,6 +41,9 @@ void sf_cch_allocator::init(const sched_cell_params_t& cell_params_)
   dci_record_list.reserve(16);
   last_dci_dfs.reserve(16);
   temp_dci_dfs.reserve(16);
+  failed_states.reserve(MAX_FAILED_STATES);
+  greedy_order.reserve(16);
+  greedy_pos.reserve(16);
 }
 
 void sf_cch_allocator::new_tti(tti_point tti_rx_)
@@ -48,6 +52,8 @@ void sf_cch_allocator::new_tti(tti_point tti_rx_)
 
   dci_record_list.clear();
   last_dci_dfs.clear();
+  failed_states.clear();
+  next_failed_state = 0;
   current_cfix     = cc_cfg->sched_cfg->min_nof_ctrl_symbols - 1;
   current_max_cfix = cc_cfg->sched_cfg->max_nof_ctrl_symbols - 1;
 }
@@ -101,32 +107,51 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
 
   // Try to allocate grant. If it fails, attempt the same grant, but using a different permutation of past grant DCI
   // positions
+  uint32_t dfs_start_cfix = current_cfix;
+  dfs_target              = dci_record_list.size() + 1;
+  dfs_nof_nodes           = 0;
+  bool success            = false;
   do {
-    bool success = alloc_dfs_node(record, 0);
+    success = alloc_dfs_node(record, 0);
     if (success) {
-      // DCI record allocation successful
-      dci_record_list.push_back(record);
-
-      if (is_dl_ctrl_alloc(alloc_type)) {
-        // Dynamic CFI not yet supported for DL control allocations, as coderate can be exceeded
-        current_max_cfix = current_cfix;
-      }
-      return true;
+      break;
     }
     if (temp_dci_dfs.empty()) {
       temp_dci_dfs = last_dci_dfs;
     }
   } while (get_next_dfs());
 
+  if (not success and dfs_nof_nodes >= MAX_DFS_NODES) {
+    // The search budget was exhausted before the DFS finished. Bound the time spent in this TTI
+    logger.debug("SCHED: PDCCH DFS search budget exceeded for %d DCIs. Falling back to greedy CCE allocation",
+                 dfs_target);
+    success = alloc_greedy(record, dfs_start_cfix);
+  }
+
+  if (success) {
+    // DCI record allocation successful
+    dci_record_list.push_back(record);
+
+    if (is_dl_ctrl_alloc(alloc_type)) {
+      // Dynamic CFI not yet supported for DL control allocations, as coderate can be exceeded
+      current_max_cfix = current_cfix;
+    }
+    return true;
+  }
+
   // Revert steps to initial state, before dci record allocation was attempted
   last_dci_dfs.swap(temp_dci_dfs);
   current_cfix = start_cfix;
+  clear_failed_states(dci_record_list.size());
   return false;
 }
 
 bool sf_cch_allocator::get_next_dfs()
 {
   do {
+    if (dfs_nof_nodes >= MAX_DFS_NODES) {
+      return false;
+    }
     uint32_t start_child_idx = 0;
     if (last_dci_dfs.empty()) {
       // If we reach root, increase CFI
@@ -149,79 +174,205 @@ bool sf_cch_allocator::get_next_dfs()
   return true;
 }
 
+/// Adds to the DFS path the first DCI position, starting at start_dci_idx, that does not collide with the path and
+/// that does not lead to a state already known to fail. The positions below start_dci_idx were already explored, so a
+/// failure means that no allocation of the remaining DCIs exists from the current path
 bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start_dci_idx)
 {
+  dfs_nof_nodes++;
+  uint32_t         depth  = last_dci_dfs.size();
+  const tree_node* parent = last_dci_dfs.empty() ? nullptr : &last_dci_dfs.back();
+
   // Get DCI Location Table
   const cce_cfi_position_table* dci_locs = get_cce_loc_table(record.alloc_type, record.user, current_cfix);
-  if (dci_locs == nullptr or (*dci_locs)[record.aggr_idx].empty()) {
-    return false;
-  }
-  const cce_position_list& dci_pos_list = (*dci_locs)[record.aggr_idx];
-  if (start_dci_idx >= dci_pos_list.size()) {
-    return false;
+  if (dci_locs != nullptr) {
+    const cce_position_list& dci_pos_list = (*dci_locs)[record.aggr_idx];
+
+    tree_node node;
+    node.dci_pos.L = record.aggr_idx;
+    node.rnti      = record.user != nullptr ? record.user->get_rnti() : SRSRAN_INVALID_RNTI;
+    for (node.dci_pos_idx = start_dci_idx; node.dci_pos_idx < dci_pos_list.size(); ++node.dci_pos_idx) {
+      node.dci_pos.ncce = dci_pos_list[node.dci_pos_idx];
+      if (not fill_dfs_node(record, parent, node)) {
+        continue;
+      }
+      if (depth + 1 < dfs_target and is_failed_state(depth + 1, node)) {
+        // the remaining DCIs were already found not to fit after this allocation
+        continue;
+      }
+
+      // Allocation successful
+      last_dci_dfs.push_back(node);
+      return true;
+    }
   }
 
-  tree_node node;
-  node.dci_pos_idx = start_dci_idx;
-  node.dci_pos.L   = record.aggr_idx;
-  node.rnti        = record.user != nullptr ? record.user->get_rnti() : SRSRAN_INVALID_RNTI;
-  node.current_mask.resize(nof_cces());
+  save_failed_state(depth, parent);
+  return false;
+}
+
+/// Computes the PDCCH and PUCCH masks of a DCI at node.dci_pos, on top of the allocations of the parent node
+/// \return false if the DCI position collides with the parent allocations
+bool sf_cch_allocator::fill_dfs_node(const alloc_record& record, const tree_node* parent, tree_node& node)
+{
+  node.pucch_n_prb = -1;
   // get cumulative pdcch & pucch masks
-  if (not last_dci_dfs.empty()) {
-    node.total_mask       = last_dci_dfs.back().total_mask;
-    node.total_pucch_mask = last_dci_dfs.back().total_pucch_mask;
+  if (parent != nullptr) {
+    node.total_mask       = parent->total_mask;
+    node.total_pucch_mask = parent->total_pucch_mask;
   } else {
-    node.total_mask.resize(nof_cces());
-    node.total_pucch_mask.resize(cc_cfg->nof_prb());
+    node.total_mask       = pdcch_mask_t(nof_cces());
+    node.total_pucch_mask = prbmask_t(cc_cfg->nof_prb());
   }
 
-  for (; node.dci_pos_idx < dci_pos_list.size(); ++node.dci_pos_idx) {
-    node.dci_pos.ncce = dci_pos_list[node.dci_pos_idx];
+  if (record.alloc_type == alloc_type_t::DL_DATA and not record.pusch_uci) {
+    // The UE needs to allocate space in PUCCH for HARQ-ACK
+    pucch_cfg_common.n_pucch = node.dci_pos.ncce + pucch_cfg_common.N_pucch_1;
 
-    if (record.alloc_type == alloc_type_t::DL_DATA and not record.pusch_uci) {
-      // The UE needs to allocate space in PUCCH for HARQ-ACK
-      pucch_cfg_common.n_pucch = node.dci_pos.ncce + pucch_cfg_common.N_pucch_1;
+    if (is_pucch_sr_collision(record.user->get_ue_cfg().pucch_cfg, to_tx_dl_ack(tti_rx), pucch_cfg_common.n_pucch)) {
+      // avoid collision of HARQ-ACK with own SR n(1)_pucch
+      return false;
+    }
 
-      if (is_pucch_sr_collision(record.user->get_ue_cfg().pucch_cfg, to_tx_dl_ack(tti_rx), pucch_cfg_common.n_pucch)) {
-        // avoid collision of HARQ-ACK with own SR n(1)_pucch
-        continue;
-      }
+    node.pucch_n_prb = srsran_pucch_n_prb(&cc_cfg->cfg.cell, &pucch_cfg_common, 0);
+    if (not cc_cfg->sched_cfg->pucch_mux_enabled and node.total_pucch_mask.test(node.pucch_n_prb)) {
+      // PUCCH allocation would collide with other PUCCH/PUSCH grants. Try another CCE position
+      return false;
+    }
+    int low_rb = node.pucch_n_prb < (int)cc_cfg->cfg.cell.nof_prb / 2 ? node.pucch_n_prb
+                                                                      : cc_cfg->cfg.cell.nof_prb - node.pucch_n_prb - 1;
+    if (cc_cfg->sched_cfg->pucch_harq_max_rb > 0 && low_rb >= cc_cfg->sched_cfg->pucch_harq_max_rb) {
+      // PUCCH allocation would fall outside the maximum allowed PUCCH HARQ region. Try another CCE position
+      logger.info("Skipping PDCCH allocation for CCE=%d due to PUCCH HARQ falling outside region\n",
+                  node.dci_pos.ncce);
+      return false;
+    }
+  }
 
-      node.pucch_n_prb = srsran_pucch_n_prb(&cc_cfg->cfg.cell, &pucch_cfg_common, 0);
-      if (not cc_cfg->sched_cfg->pucch_mux_enabled and node.total_pucch_mask.test(node.pucch_n_prb)) {
-        // PUCCH allocation would collide with other PUCCH/PUSCH grants. Try another CCE position
-        continue;
+  node.current_mask.resize(nof_cces());
+  node.current_mask.reset();
+  node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
+  if ((node.total_mask & node.current_mask).any()) {
+    // there is a PDCCH collision. Try another CCE position
+    return false;
+  }
+
+  node.total_mask |= node.current_mask;
+  if (node.pucch_n_prb >= 0) {
+    node.total_pucch_mask.set(node.pucch_n_prb);
+  }
+  return true;
+}
+
+/// Assigns the DCIs one by one, most constrained first, to their first position without collisions. As the PDCCH and
+/// PUCCH collisions do not depend on the allocation order, the result is then stored as a DFS path
+bool sf_cch_allocator::alloc_greedy(const alloc_record& record, uint32_t start_cfix)
+{
+  uint32_t nof_records = dci_record_list.size() + 1;
+  auto     get_record  = [this, &record, nof_records](uint32_t i) -> const alloc_record& {
+    return i + 1 < nof_records ? dci_record_list[i] : record;
+  };
+
+  for (current_cfix = start_cfix; current_cfix <= current_max_cfix; ++current_cfix) {
+    // greedy_pos holds the number of candidate positions of each DCI, until its position is chosen
+    greedy_order.resize(nof_records);
+    greedy_pos.resize(nof_records);
+    for (uint32_t i = 0; i < nof_records; ++i) {
+      const alloc_record&           rec      = get_record(i);
+      const cce_cfi_position_table* dci_locs = get_cce_loc_table(rec.alloc_type, rec.user, current_cfix);
+      greedy_order[i]                        = i;
+      greedy_pos[i]                          = dci_locs == nullptr ? 0 : (*dci_locs)[rec.aggr_idx].size();
+    }
+    std::stable_sort(greedy_order.begin(), greedy_order.end(), [this](uint32_t lhs, uint32_t rhs) {
+      return greedy_pos[lhs] < greedy_pos[rhs];
+    });
+
+    tree_node acc, node;
+    acc.total_mask       = pdcch_mask_t(nof_cces());
+    acc.total_pucch_mask = prbmask_t(cc_cfg->nof_prb());
+    bool success         = true;
+    for (uint32_t i : greedy_order) {
+      const alloc_record& rec      = get_record(i);
+      uint32_t            nof_locs = greedy_pos[i];
+      if (nof_locs == 0) {
+        success = false;
+        break;
       }
-      int low_rb = node.pucch_n_prb < (int)cc_cfg->cfg.cell.nof_prb / 2
-                       ? node.pucch_n_prb
-                       : cc_cfg->cfg.cell.nof_prb - node.pucch_n_prb - 1;
-      if (cc_cfg->sched_cfg->pucch_harq_max_rb > 0 && low_rb >= cc_cfg->sched_cfg->pucch_harq_max_rb) {
-        // PUCCH allocation would fall outside the maximum allowed PUCCH HARQ region. Try another CCE position
-        logger.info("Skipping PDCCH allocation for CCE=%d due to PUCCH HARQ falling outside region\n",
-                    node.dci_pos.ncce);
-        continue;
+      const cce_cfi_position_table& dci_locs     = *get_cce_loc_table(rec.alloc_type, rec.user, current_cfix);
+      const cce_position_list&      dci_pos_list = dci_locs[rec.aggr_idx];
+      for (greedy_pos[i] = 0; greedy_pos[i] < nof_locs; ++greedy_pos[i]) {
+        node.dci_pos.ncce = dci_pos_list[greedy_pos[i]];
+        if (fill_dfs_node(rec, &acc, node)) {
+          acc.total_mask       = node.total_mask;
+          acc.total_pucch_mask = node.total_pucch_mask;
+          break;
+        }
+      }
+      if (greedy_pos[i] == nof_locs) {
+        success = false;
+        break;
       }
     }
-
-    node.current_mask.reset();
-    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
-    if ((node.total_mask & node.current_mask).any()) {
-      // there is a PDCCH collision. Try another CCE position
+    if (not success) {
       continue;
     }
 
-    // Allocation successful
-    node.total_mask |= node.current_mask;
-    if (node.pucch_n_prb >= 0) {
-      node.total_pucch_mask.set(node.pucch_n_prb);
+    // Store the assignment as a DFS path, in order of allocation
+    dfs_target = 0;
+    last_dci_dfs.clear();
+    for (uint32_t i = 0; i < nof_records; ++i) {
+      alloc_dfs_node(get_record(i), greedy_pos[i]);
     }
-    last_dci_dfs.push_back(node);
     return true;
   }
+  return false;
+}
 
+bool sf_cch_allocator::is_failed_state(uint32_t depth, const tree_node& node) const
+{
+  for (const failed_state& st : failed_states) {
+    if (st.cfix == current_cfix and st.depth == depth and st.nof_records <= dfs_target and
+        st.total_mask == node.total_mask and st.total_pucch_mask == node.total_pucch_mask) {
+      return true;
+    }
+  }
   return false;
 }
 
+void sf_cch_allocator::save_failed_state(uint32_t depth, const tree_node* parent)
+{
+  if (dfs_target == 0) {
+    return;
+  }
+  if (failed_states.size() < MAX_FAILED_STATES) {
+    failed_states.emplace_back();
+  }
+  failed_state& st = failed_states[next_failed_state];
+  next_failed_state = (next_failed_state + 1) % MAX_FAILED_STATES;
+
+  st.cfix        = current_cfix;
+  st.depth       = depth;
+  st.nof_records = dfs_target;
+  if (parent != nullptr) {
+    st.total_mask       = parent->total_mask;
+    st.total_pucch_mask = parent->total_pucch_mask;
+  } else {
+    st.total_mask       = pdcch_mask_t(nof_cces());
+    st.total_pucch_mask = prbmask_t(cc_cfg->nof_prb());
+  }
+}
+
+/// Forgets the failed states that involve DCIs beyond the first nof_records, which are no longer allocated
+void sf_cch_allocator::clear_failed_states(uint32_t nof_records)
+{
+  failed_states.erase(
+      std::remove_if(failed_states.begin(),
+                     failed_states.end(),
+                     [nof_records](const failed_state& st) { return st.nof_records > nof_records; }),
+      failed_states.end());
+  next_failed_state = failed_states.size() % MAX_FAILED_STATES;
+}
+
 void sf_cch_allocator::rem_last_dci()
 {
   assert(not dci_record_list.empty());
@@ -229,6 +380,7 @@ void sf_cch_allocator::rem_last_dci()
   // Remove DCI record
   last_dci_dfs.pop_back();
   dci_record_list.pop_back();
+  clear_failed_states(dci_record_list.size());
 }
 
 void sf_cch_allocator::get_allocs(alloc_result_t* vec, pdcch_mask_t* tot_mask, size_t idx) const
@@ -178,6 +178,11 @@ void sched_ue::metrics_read(mac_ue_metrics_t& metrics)
   sched_ue_cell& pcell  = cells[cfg.supported_cc_list[0].enb_cc_idx];
   metrics.ul_snr_offset = pcell.get_ul_snr_offset();
   metrics.dl_cqi_offset = pcell.get_dl_cqi_offset();
+
+  metrics.tx_pkts += tx_metrics.tx_pkts;
+  metrics.tx_errors += tx_metrics.tx_errors;
+  metrics.tx_brate += tx_metrics.tx_brate;
+  tx_metrics = {};
 }
 
 tti_point prev_meas_gap_start(tti_point tti, uint32_t period, uint32_t offset)
@@ -261,7 +266,16 @@ bool sched_ue::phich_enabled(tti_point tti_rx, uint32_t enb_cc_idx) const
 
 int sched_ue::set_ack_info(tti_point tti_rx, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)
 {
-  return cells[enb_cc_idx].set_ack_info(tti_rx, tb_idx, ack);
+  int tbs_acked = cells[enb_cc_idx].set_ack_info(tti_rx, tb_idx, ack);
+  if (tbs_acked >= 0) {
+    if (ack) {
+      tx_metrics.tx_brate += tbs_acked * 8;
+    } else {
+      tx_metrics.tx_errors++;
+    }
+    tx_metrics.tx_pkts++;
+  }
+  return tbs_acked;
 }
 
 void sched_ue::set_ul_crc(tti_point tti_rx, uint32_t enb_cc_idx, bool crc_res)
@@ -365,6 +379,7 @@ int sched_ue::generate_dl_dci_format(uint32_t                          pid,
 {
   srsran_dci_format_t dci_format = get_dci_format();
   int                 tbs_bytes  = 0;
+  state_version++;
 
   // Set common DCI fields
   srsran_dci_dl_t* dci = &data->dci;
@@ -599,6 +614,7 @@ int sched_ue::generate_format0(sched_interface::ul_sched_data_t* data,
 {
   ul_harq_proc*    h   = get_ul_harq(tti_tx_ul, enb_cc_idx);
   srsran_dci_ul_t* dci = &data->dci;
+  state_version++;
 
   bool cqi_request = needs_cqi(tti_tx_ul.to_uint(), enb_cc_idx, true);
 
@@ -1044,11 +1060,12 @@ srsran_dci_format_t sched_ue::get_dci_format()
 
 const cce_cfi_position_table* sched_ue::get_locations(uint32_t enb_cc_idx, uint32_t cfi, uint32_t sf_idx) const
 {
+  cce_ue_location_cache& locations = cells[enb_cc_idx].cell_cfg->ue_locations;
   if (cfi > 0 && cfi <= 3) {
-    return &cells[enb_cc_idx].dci_locations[sf_idx][cfi - 1];
+    return &locations.get(rnti, sf_idx, cfi - 1);
   } else {
     logger.error("SCHED: Invalid CFI=%d", cfi);
-    return &cells[enb_cc_idx].dci_locations[sf_idx][0];
+    return &locations.get(rnti, sf_idx, 0);
   }
 }
 
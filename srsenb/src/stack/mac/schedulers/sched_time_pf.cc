@@ -20,12 +20,27 @@
  */
 
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_pf.h"
-#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace srsenb {
 
 using srsran::tti_point;
 
+namespace {
+
+/// Coefficient of the exponential average of the allocated rates
+constexpr float pf_avg_alpha = 0.01;
+/// Number of samples averaged arithmetically before switching to the exponential average
+constexpr uint32_t pf_fast_start_len = 100;
+/// TTIs after an allocation during which a UE is re-evaluated every TTI, to cover its HARQ retransmissions
+constexpr uint64_t pf_harq_window = 64;
+/// Period in TTIs of the refresh of the UEs with no other changes, e.g. for time-dependent conditions
+constexpr uint64_t pf_refresh_period = 32;
+
+} // namespace
+
 sched_time_pf::sched_time_pf(const sched_cell_params_t& cell_params_, const sched_interface::sched_args_t& sched_args)
 {
   cc_cfg = &cell_params_;
@@ -33,44 +48,108 @@ sched_time_pf::sched_time_pf(const sched_cell_params_t& cell_params_, const sche
     fairness_coeff = std::stof(sched_args.sched_policy_args);
   }
 
-  std::vector<ue_ctxt*> dl_storage;
-  dl_storage.reserve(SRSENB_MAX_UES);
-  dl_queue = ue_dl_queue_t(ue_dl_prio_compare{}, std::move(dl_storage));
-
-  std::vector<ue_ctxt*> ul_storage;
-  ul_storage.reserve(SRSENB_MAX_UES);
-  ul_queue = ue_ul_queue_t(ue_ul_prio_compare{}, std::move(ul_storage));
+  dl_retx_list.reserve(SRSENB_MAX_UES);
+  ul_retx_list.reserve(SRSENB_MAX_UES);
+  heap_frontier.reserve(SRSENB_MAX_UES);
+  allocated_ues.reserve(SRSENB_MAX_UES);
 }
 
 void sched_time_pf::new_tti(sched_ue_list& ue_db, sf_sched* tti_sched)
 {
-  while (not dl_queue.empty()) {
-    dl_queue.pop();
-  }
-  while (not ul_queue.empty()) {
-    ul_queue.pop();
-  }
   current_tti_rx = tti_point{tti_sched->get_tti_rx()};
+  tti_count++;
+
   // remove deleted users from history
   for (auto it = ue_history_db.begin(); it != ue_history_db.end();) {
     if (not ue_db.contains(it->first)) {
+      dl_heap.erase(&it->second);
+      ul_heap.erase(&it->second);
       it = ue_history_db.erase(it);
     } else {
       ++it;
     }
   }
-  // add new users to history db, and update priority queues
+
+  // add new users to history db, and re-evaluate only the users whose state may have changed
+  dl_retx_list.clear();
+  ul_retx_list.clear();
   for (auto& u : ue_db) {
-    auto it = ue_history_db.find(u.first);
+    sched_ue& ue     = *u.second;
+    bool      is_new = false;
+    auto      it     = ue_history_db.find(u.first);
     if (it == ue_history_db.end()) {
-      it = ue_history_db.insert(u.first, ue_ctxt{u.first, fairness_coeff}).value();
+      it                        = ue_history_db.insert(u.first, ue_ctxt{u.first, fairness_coeff}).value();
+      it->second.last_alloc_tti = tti_count;
+      is_new                    = true;
     }
-    it->second.new_tti(*cc_cfg, *u.second, tti_sched);
-    if (it->second.dl_newtx_h != nullptr or it->second.dl_retx_h != nullptr) {
-      dl_queue.push(&it->second);
+    ue_ctxt& ctxt = it->second;
+
+    bool recent  = tti_count - ctxt.last_alloc_tti <= pf_harq_window;
+    bool refresh = is_new or recent or ctxt.state_version != ue.get_state_version() or
+                   (tti_count + ctxt.rnti) % pf_refresh_period == 0;
+    ctxt.dl_retx_h = nullptr;
+    ctxt.ul_h      = nullptr;
+    if (not refresh) {
+      continue;
     }
-    if (it->second.ul_h != nullptr) {
-      ul_queue.push(&it->second);
+    ctxt.refresh(*cc_cfg, ue, tti_sched, tti_count);
+    update_heaps(ctxt);
+
+    // Retransmissions only happen for UEs that were allocated or received feedback recently
+    if (ctxt.ue_cc_idx >= 0) {
+      ctxt.dl_retx_h = get_dl_retx_harq(ue, tti_sched);
+      if (ctxt.dl_retx_h != nullptr) {
+        dl_retx_list.push_back(&ctxt);
+      }
+      ctxt.ul_h = get_ul_retx_harq(ue, tti_sched);
+      if (ctxt.ul_h != nullptr) {
+        ul_retx_list.push_back(&ctxt);
+      }
+    }
+  }
+
+  auto dl_cmp = [](const ue_ctxt* lhs, const ue_ctxt* rhs) { return lhs->prio_key[DL] > rhs->prio_key[DL]; };
+  auto ul_cmp = [](const ue_ctxt* lhs, const ue_ctxt* rhs) { return lhs->prio_key[UL] > rhs->prio_key[UL]; };
+  std::sort(dl_retx_list.begin(), dl_retx_list.end(), dl_cmp);
+  std::sort(ul_retx_list.begin(), ul_retx_list.end(), ul_cmp);
+}
+
+void sched_time_pf::update_heaps(ue_ctxt& ue)
+{
+  if (ue.ue_cc_idx >= 0 and ue.has_data[DL]) {
+    dl_heap.update(&ue);
+  } else {
+    dl_heap.erase(&ue);
+  }
+  if (ue.ue_cc_idx >= 0 and ue.has_data[UL]) {
+    ul_heap.update(&ue);
+  } else {
+    ul_heap.erase(&ue);
+  }
+}
+
+/// Visits the UEs of a heap from the highest to the lowest priority until "f" returns false. Only the visited UEs and
+/// their children are touched, so stopping after k UEs costs O(k log k)
+template <typename Func>
+void sched_time_pf::for_each_by_prio(direction dir, Func&& f)
+{
+  const ue_heap& heap = dir == DL ? dl_heap : ul_heap;
+  auto           cmp  = [&heap](size_t lhs, size_t rhs) { return heap.higher(rhs, lhs); };
+
+  heap_frontier.clear();
+  if (heap.size() > 0) {
+    heap_frontier.push_back(0);
+  }
+  while (not heap_frontier.empty()) {
+    std::pop_heap(heap_frontier.begin(), heap_frontier.end(), cmp);
+    size_t pos = heap_frontier.back();
+    heap_frontier.pop_back();
+    if (not f(*heap[pos])) {
+      return;
+    }
+    for (size_t child = 2 * pos + 1; child <= 2 * pos + 2 and child < heap.size(); ++child) {
+      heap_frontier.push_back(child);
+      std::push_heap(heap_frontier.begin(), heap_frontier.end(), cmp);
     }
   }
 }
@@ -86,30 +165,55 @@ void sched_time_pf::sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched)
     new_tti(ue_db, tti_sched);
   }
 
-  while (not dl_queue.empty()) {
-    ue_ctxt& ue = *dl_queue.top();
-    ue.save_dl_alloc(try_dl_alloc(ue, *ue_db[ue.rnti], tti_sched), 0.01);
-    dl_queue.pop();
+  // Retransmissions go first
+  for (ue_ctxt* ue : dl_retx_list) {
+    uint32_t alloc_bytes = try_dl_alloc(*ue, *ue_db[ue->rnti], ue->dl_retx_h, tti_sched);
+    if (alloc_bytes > 0) {
+      ue->save_alloc(DL, alloc_bytes, tti_count);
+      update_heaps(*ue);
+    }
+  }
+
+  // New transmissions, until the RBGs or the grants run out
+  allocated_ues.clear();
+  for_each_by_prio(DL, [this, &ue_db, tti_sched](ue_ctxt& ue) {
+    if (tti_sched->get_dl_mask().all()) {
+      return false;
+    }
+    if (tti_sched->is_dl_alloc(ue.rnti)) {
+      return true;
+    }
+    sched_ue&           user = *ue_db[ue.rnti];
+    const dl_harq_proc* h    = get_dl_newtx_harq(user, tti_sched);
+    if (h == nullptr) {
+      return true;
+    }
+    uint32_t alloc_bytes = try_dl_alloc(ue, user, h, tti_sched);
+    if (alloc_bytes > 0) {
+      allocated_ues.push_back(&ue);
+      ue.save_alloc(DL, alloc_bytes, tti_count);
+    }
+    return true;
+  });
+
+  // The heap was only read while being walked
+  for (ue_ctxt* ue : allocated_ues) {
+    update_heaps(*ue);
   }
 }
 
-uint32_t sched_time_pf::try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched)
+uint32_t sched_time_pf::try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, const dl_harq_proc* h, sf_sched* tti_sched)
 {
-  alloc_result code = alloc_result::other_cause;
-  if (ue_ctxt.dl_retx_h != nullptr) {
-    code = try_dl_retx_alloc(*tti_sched, ue, *ue_ctxt.dl_retx_h);
-    if (code == alloc_result::success) {
-      return ue_ctxt.dl_retx_h->get_tbs(0) + ue_ctxt.dl_retx_h->get_tbs(1);
-    }
+  if (h == ue_ctxt.dl_retx_h) {
+    alloc_result code = try_dl_retx_alloc(*tti_sched, ue, *h);
+    return code == alloc_result::success ? h->get_tbs(0) + h->get_tbs(1) : 0;
   }
 
   // There is space in PDCCH and an available DL HARQ
-  if (code != alloc_result::no_cch_space and ue_ctxt.dl_newtx_h != nullptr) {
-    rbgmask_t alloc_mask;
-    code = try_dl_newtx_alloc_greedy(*tti_sched, ue, *ue_ctxt.dl_newtx_h, &alloc_mask);
-    if (code == alloc_result::success) {
-      return ue.get_expected_dl_bitrate(cc_cfg->enb_cc_idx, alloc_mask.count()) * tti_duration_ms / 8;
-    }
+  rbgmask_t    alloc_mask;
+  alloc_result code = try_dl_newtx_alloc_greedy(*tti_sched, ue, *h, &alloc_mask);
+  if (code == alloc_result::success) {
+    return ue.get_expected_dl_bitrate(cc_cfg->enb_cc_idx, alloc_mask.count()) * tti_duration_ms / 8;
   }
   return 0;
 }
@@ -125,29 +229,52 @@ void sched_time_pf::sched_ul_users(sched_ue_list& ue_db, sf_sched* tti_sched)
     new_tti(ue_db, tti_sched);
   }
 
-  while (not ul_queue.empty()) {
-    ue_ctxt& ue = *ul_queue.top();
-    ue.save_ul_alloc(try_ul_alloc(ue, *ue_db[ue.rnti], tti_sched), 0.01);
-    ul_queue.pop();
+  // Retransmissions go first
+  for (ue_ctxt* ue : ul_retx_list) {
+    uint32_t alloc_bytes = try_ul_alloc(*ue, *ue_db[ue->rnti], ue->ul_h, tti_sched);
+    if (alloc_bytes > 0) {
+      ue->save_alloc(UL, alloc_bytes, tti_count);
+      update_heaps(*ue);
+    }
+  }
+
+  // New transmissions, until the PRBs run out
+  allocated_ues.clear();
+  for_each_by_prio(UL, [this, &ue_db, tti_sched](ue_ctxt& ue) {
+    if (tti_sched->get_ul_mask().all()) {
+      return false;
+    }
+    sched_ue&           user = *ue_db[ue.rnti];
+    const ul_harq_proc* h    = get_ul_newtx_harq(user, tti_sched);
+    if (h == nullptr) {
+      return true;
+    }
+    uint32_t alloc_bytes = try_ul_alloc(ue, user, h, tti_sched);
+    if (alloc_bytes > 0) {
+      allocated_ues.push_back(&ue);
+      ue.save_alloc(UL, alloc_bytes, tti_count);
+    }
+    return true;
+  });
+
+  // The heap was only read while being walked
+  for (ue_ctxt* ue : allocated_ues) {
+    update_heaps(*ue);
   }
 }
 
-uint32_t sched_time_pf::try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched)
+uint32_t sched_time_pf::try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, const ul_harq_proc* h, sf_sched* tti_sched)
 {
-  if (ue_ctxt.ul_h == nullptr) {
-    // In case the UL HARQ could not be allocated (e.g. meas gap occurrence)
-    return 0;
-  }
   if (tti_sched->is_ul_alloc(ue_ctxt.rnti)) {
     // NOTE: An UL grant could have been previously allocated for UCI
-    return ue_ctxt.ul_h->get_pending_data();
+    return h->get_pending_data();
   }
 
   alloc_result code;
   uint32_t     estim_tbs_bytes = 0;
-  if (ue_ctxt.ul_h->has_pending_retx()) {
-    code            = try_ul_retx_alloc(*tti_sched, ue, *ue_ctxt.ul_h);
-    estim_tbs_bytes = code == alloc_result::success ? ue_ctxt.ul_h->get_pending_data() : 0;
+  if (h->has_pending_retx()) {
+    code            = try_ul_retx_alloc(*tti_sched, ue, *h);
+    estim_tbs_bytes = code == alloc_result::success ? h->get_pending_data() : 0;
   } else {
     // Note: h->is_empty check is required, in case CA allocated a small UL grant for UCI
     uint32_t pending_data = ue.get_pending_ul_new_data(tti_sched->get_tti_tx_ul(), cc_cfg->enb_cc_idx);
@@ -172,74 +299,164 @@ uint32_t sched_time_pf::try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* t
  *                          UE history
  *****************************************************************/
 
-void sched_time_pf::ue_ctxt::new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched)
+void sched_time_pf::ue_ctxt::refresh(const sched_cell_params_t& cell,
+                                     sched_ue&                  ue,
+                                     sf_sched*                  tti_sched,
+                                     uint64_t                   tti_count)
 {
-  dl_retx_h  = nullptr;
-  dl_newtx_h = nullptr;
-  ul_h       = nullptr;
-  dl_prio    = 0;
-  ue_cc_idx  = ue.enb_to_ue_cc_idx(cell.enb_cc_idx);
+  state_version = ue.get_state_version();
+  has_data[DL]  = false;
+  has_data[UL]  = false;
+  ue_cc_idx     = ue.enb_to_ue_cc_idx(cell.enb_cc_idx);
   if (ue_cc_idx < 0) {
     // not active
     return;
   }
 
-  // Calculate DL priority
-  dl_retx_h  = get_dl_retx_harq(ue, tti_sched);
-  dl_newtx_h = get_dl_newtx_harq(ue, tti_sched);
-  if (dl_retx_h != nullptr or dl_newtx_h != nullptr) {
-    // calculate DL PF priority
-    float r = ue.get_expected_dl_bitrate(cell.enb_cc_idx) / 8;
-    float R = dl_avg_rate();
-    dl_prio = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+  has_data[DL] = ue.get_requested_dl_bytes(cell.enb_cc_idx).stop() > 0;
+  has_data[UL] = ue.get_pending_ul_new_data(tti_sched->get_tti_tx_ul(), cell.enb_cc_idx) > 0;
+  exp_rate[DL] = ue.get_expected_dl_bitrate(cell.enb_cc_idx) / 8;
+  exp_rate[UL] = ue.get_expected_ul_bitrate(cell.enb_cc_idx) / 8;
+
+  // The averages include up to the previous TTI, as the current one has not been allocated yet
+  update_prio(DL, tti_count - 1);
+  update_prio(UL, tti_count - 1);
+}
+
+void sched_time_pf::ue_ctxt::save_alloc(direction dir, uint32_t alloc_bytes, uint64_t tti_count)
+{
+  avg_rate[dir].add_sample(tti_count, alloc_bytes);
+  last_alloc_tti = tti_count;
+  update_prio(dir, tti_count);
+}
+
+/// The PF priority r / R^c at TTI t is stored as log(r) - c * log(R(t0)) + c * t0 * log(1 - alpha), where t0 is the
+/// last TTI included in the average R. The term -c * t * log(1 - alpha) that is common to all UEs is left out, so
+/// the keys of the UEs that are not allocated keep their order without being updated
+void sched_time_pf::ue_ctxt::update_prio(direction dir, uint64_t tti_count)
+{
+  float r = exp_rate[dir];
+  float R = avg_rate[dir].value(tti_count);
+  if (r == 0) {
+    prio_key[dir] = -std::numeric_limits<double>::infinity();
+  } else if (avg_rate[dir].count() == 0 or R == 0) {
+    prio_key[dir] = std::numeric_limits<double>::infinity();
+  } else {
+    prio_key[dir] = std::log((double)r) - fairness_coeff * std::log((double)R) +
+                    fairness_coeff * (double)tti_count * std::log(1.0 - pf_avg_alpha);
+  }
+}
+
+float sched_time_pf::rate_average::value(uint64_t tti_count)
+{
+  advance(tti_count);
+  return nof_samples == 0 ? 0 : avg_rate;
+}
+
+/// Applies the zero samples of the TTIs without allocation up to tti_count. The TTIs before the first allocation are
+/// not counted, so that the first allocations still go through the fast start
+void sched_time_pf::rate_average::advance(uint64_t tti_count)
+{
+  if (tti_count <= last_tti) {
+    return;
+  }
+  uint64_t nof_zeros = tti_count - last_tti;
+  last_tti           = tti_count;
+  if (nof_samples == 0) {
+    return;
   }
 
-  // Calculate UL priority
-  ul_h = get_ul_retx_harq(ue, tti_sched);
-  if (ul_h == nullptr) {
-    ul_h = get_ul_newtx_harq(ue, tti_sched);
+  if (nof_samples < pf_fast_start_len) {
+    // fast start, the arithmetic average of n samples times n / (n + k)
+    uint32_t nof_fast = std::min<uint64_t>(nof_zeros, pf_fast_start_len - nof_samples);
+    avg_rate          = avg_rate * nof_samples / (nof_samples + nof_fast);
+    nof_samples += nof_fast;
+    nof_zeros -= nof_fast;
   }
-  if (ul_h != nullptr) {
-    float r = ue.get_expected_ul_bitrate(cell.enb_cc_idx) / 8;
-    float R = ul_avg_rate();
-    ul_prio = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+  if (nof_zeros > 0) {
+    avg_rate *= std::pow(1 - pf_avg_alpha, (float)nof_zeros);
   }
 }
 
-void sched_time_pf::ue_ctxt::save_dl_alloc(uint32_t alloc_bytes, float exp_avg_alpha)
+void sched_time_pf::rate_average::add_sample(uint64_t tti_count, uint32_t alloc_bytes)
 {
-  if (dl_nof_samples < 1 / exp_avg_alpha) {
+  advance(tti_count - 1);
+  if (nof_samples < pf_fast_start_len) {
     // fast start
-    dl_avg_rate_ = dl_avg_rate_ + (alloc_bytes - dl_avg_rate_) / (dl_nof_samples + 1);
+    avg_rate = avg_rate + (alloc_bytes - avg_rate) / (nof_samples + 1);
+    nof_samples++;
   } else {
-    dl_avg_rate_ = (1 - exp_avg_alpha) * dl_avg_rate_ + (exp_avg_alpha)*alloc_bytes;
+    avg_rate = (1 - pf_avg_alpha) * avg_rate + (pf_avg_alpha)*alloc_bytes;
   }
-  dl_nof_samples++;
+  last_tti = tti_count;
 }
 
-void sched_time_pf::ue_ctxt::save_ul_alloc(uint32_t alloc_bytes, float exp_avg_alpha)
+/*****************************************************************
+ *                        UE priority heap
+ *****************************************************************/
+
+void sched_time_pf::ue_heap::update(ue_ctxt* u)
 {
-  if (ul_nof_samples < 1 / exp_avg_alpha) {
-    // fast start
-    ul_avg_rate_ = ul_avg_rate_ + (alloc_bytes - ul_avg_rate_) / (ul_nof_samples + 1);
-  } else {
-    ul_avg_rate_ = (1 - exp_avg_alpha) * ul_avg_rate_ + (exp_avg_alpha)*alloc_bytes;
+  if (u->heap_pos[dir] < 0) {
+    heap.push_back(u);
+    u->heap_pos[dir] = heap.size() - 1;
+  }
+  sift_up(u->heap_pos[dir]);
+  sift_down(u->heap_pos[dir]);
+}
+
+void sched_time_pf::ue_heap::erase(ue_ctxt* u)
+{
+  if (u->heap_pos[dir] < 0) {
+    return;
   }
-  ul_nof_samples++;
+  size_t pos  = u->heap_pos[dir];
+  size_t last = heap.size() - 1;
+  if (pos != last) {
+    swap_pos(pos, last);
+  }
+  heap.pop_back();
+  u->heap_pos[dir] = -1;
+  if (pos < heap.size()) {
+    sift_up(pos);
+    sift_down(heap[pos]->heap_pos[dir]);
+  }
+}
+
+void sched_time_pf::ue_heap::swap_pos(size_t lhs, size_t rhs)
+{
+  std::swap(heap[lhs], heap[rhs]);
+  heap[lhs]->heap_pos[dir] = lhs;
+  heap[rhs]->heap_pos[dir] = rhs;
 }
 
-bool sched_time_pf::ue_dl_prio_compare::operator()(const sched_time_pf::ue_ctxt* lhs,
-                                                   const sched_time_pf::ue_ctxt* rhs) const
+void sched_time_pf::ue_heap::sift_up(size_t pos)
 {
-  bool is_retx1 = lhs->dl_retx_h != nullptr, is_retx2 = rhs->dl_retx_h != nullptr;
-  return (not is_retx1 and is_retx2) or (is_retx1 == is_retx2 and lhs->dl_prio < rhs->dl_prio);
+  while (pos > 0) {
+    size_t parent = (pos - 1) / 2;
+    if (not higher(pos, parent)) {
+      break;
+    }
+    swap_pos(pos, parent);
+    pos = parent;
+  }
 }
 
-bool sched_time_pf::ue_ul_prio_compare::operator()(const sched_time_pf::ue_ctxt* lhs,
-                                                   const sched_time_pf::ue_ctxt* rhs) const
+void sched_time_pf::ue_heap::sift_down(size_t pos)
 {
-  bool is_retx1 = lhs->ul_h->has_pending_retx(), is_retx2 = rhs->ul_h->has_pending_retx();
-  return (not is_retx1 and is_retx2) or (is_retx1 == is_retx2 and lhs->ul_prio < rhs->ul_prio);
+  while (true) {
+    size_t best = pos;
+    for (size_t child = 2 * pos + 1; child <= 2 * pos + 2 and child < heap.size(); ++child) {
+      if (higher(child, best)) {
+        best = child;
+      }
+    }
+    if (best == pos) {
+      break;
+    }
+    swap_pos(pos, best);
+    pos = best;
+  }
 }
 
 } // namespace srsenb
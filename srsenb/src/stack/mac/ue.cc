@@ -32,20 +32,37 @@
 
 namespace srsenb {
 
-ue_cc_softbuffers::ue_cc_softbuffers(uint32_t nof_prb, uint32_t nof_tx_harq_proc_, uint32_t nof_rx_harq_proc_) :
+ue_cc_softbuffers::ue_cc_softbuffers(uint32_t nof_prb,
+                                     uint32_t nof_tx_harq_proc_,
+                                     uint32_t nof_rx_harq_proc_,
+                                     bool     on_demand) :
   nof_tx_harq_proc(nof_tx_harq_proc_), nof_rx_harq_proc(nof_rx_harq_proc_)
 {
+  uint64_t nof_bytes = 0;
+
   // Create and init Rx buffers
   softbuffer_rx_list.resize(nof_rx_harq_proc);
   for (srsran_softbuffer_rx_t& buffer : softbuffer_rx_list) {
-    srsran_softbuffer_rx_init(&buffer, nof_prb);
+    if (on_demand) {
+      srsran_softbuffer_rx_init_on_demand(&buffer, nof_prb);
+    } else {
+      srsran_softbuffer_rx_init(&buffer, nof_prb);
+    }
+    nof_bytes += srsran_softbuffer_rx_mem_bytes(&buffer);
   }
 
   // Create and init Tx buffers
   softbuffer_tx_list.resize(nof_tx_harq_proc * SRSRAN_MAX_TB);
   for (auto& buffer : softbuffer_tx_list) {
-    srsran_softbuffer_tx_init(&buffer, nof_prb);
+    if (on_demand) {
+      srsran_softbuffer_tx_init_on_demand(&buffer, nof_prb);
+    } else {
+      srsran_softbuffer_tx_init(&buffer, nof_prb);
+    }
+    nof_bytes += srsran_softbuffer_tx_mem_bytes(&buffer);
   }
+
+  mem_bytes.store(nof_bytes, std::memory_order_relaxed);
 }
 
 ue_cc_softbuffers::~ue_cc_softbuffers()
@@ -63,6 +80,7 @@ ue_cc_softbuffers::~ue_cc_softbuffers()
 
 void ue_cc_softbuffers::clear()
 {
+  // The Rx reset only zeroes the code blocks written since the previous reset, clearing idle HARQs is cheap
   for (auto& buffer : softbuffer_rx_list) {
     srsran_softbuffer_rx_reset(&buffer);
   }
@@ -71,6 +89,28 @@ void ue_cc_softbuffers::clear()
   }
 }
 
+bool ue_cc_softbuffers::reserve_tx(uint32_t pid, uint32_t tb_idx, uint32_t tbs)
+{
+  srsran_softbuffer_tx_t& buffer = get_tx(pid, tb_idx);
+  uint64_t                before = srsran_softbuffer_tx_mem_bytes(&buffer);
+  if (srsran_softbuffer_tx_reserve_tbs(&buffer, tbs * 8) < SRSRAN_SUCCESS) {
+    return false;
+  }
+  mem_bytes.fetch_add(srsran_softbuffer_tx_mem_bytes(&buffer) - before, std::memory_order_relaxed);
+  return true;
+}
+
+bool ue_cc_softbuffers::reserve_rx(uint32_t tti, uint32_t tbs)
+{
+  srsran_softbuffer_rx_t& buffer = get_rx(tti);
+  uint64_t                before = srsran_softbuffer_rx_mem_bytes(&buffer);
+  if (srsran_softbuffer_rx_reserve_tbs(&buffer, tbs * 8) < SRSRAN_SUCCESS) {
+    return false;
+  }
+  mem_bytes.fetch_add(srsran_softbuffer_rx_mem_bytes(&buffer) - before, std::memory_order_relaxed);
+  return true;
+}
+
 cc_used_buffers_map::cc_used_buffers_map() : logger(&srslog::fetch_basic_logger("MAC")) {}
 
 cc_used_buffers_map::~cc_used_buffers_map()
@@ -192,7 +232,8 @@ ue::ue(uint16_t                                 rnti_,
        phy_interface_stack_lte*                 phy_,
        srslog::basic_logger&                    logger_,
        uint32_t                                 nof_cells_,
-       srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool_) :
+       srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool_,
+       srsran::task_queue_handle*               stack_task_queue_) :
   rnti(rnti_),
   sched(sched_),
   rrc(rrc_),
@@ -204,6 +245,7 @@ ue::ue(uint16_t                                 rnti_,
   mac_msg_ul(20, logger_),
   ta_fsm(this),
   softbuffer_pool(softbuffer_pool_),
+  stack_task_queue(stack_task_queue_),
   cc_buffers(nof_cells_)
 {
   // Allocate buffer for PCell
@@ -214,10 +256,8 @@ ue::~ue() {}
 
 void ue::reset()
 {
-  {
-    std::lock_guard<std::mutex> lock(metrics_mutex);
-    ue_metrics = {};
-  }
+  mac_ue_metrics_t discarded = {};
+  take_metrics_snapshot(discarded);
   nof_failures = 0;
 
   for (auto& cc : cc_buffers) {
@@ -245,22 +285,31 @@ void ue::ue_cfg(const sched_interface::ue_cfg_t& ue_cfg)
   }
 }
 
-srsran_softbuffer_rx_t* ue::get_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti)
+srsran_softbuffer_rx_t* ue::get_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti, uint32_t tbs)
 {
   if ((size_t)enb_cc_idx >= cc_buffers.size() or cc_buffers[enb_cc_idx].empty()) {
     ERROR("eNB CC Index (%d/%zd) out-of-range", enb_cc_idx, cc_buffers.size());
     return nullptr;
   }
+  if (tbs > 0 and not cc_buffers[enb_cc_idx].reserve_rx_softbuffer(tti, tbs)) {
+    logger.error("Failed to allocate the Rx soft-buffer of rnti=0x%x for a TBS of %d bytes", rnti, tbs);
+    return nullptr;
+  }
 
   return &cc_buffers[enb_cc_idx].get_rx_softbuffer(tti);
 }
 
-srsran_softbuffer_tx_t* ue::get_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq_process, uint32_t tb_idx)
+srsran_softbuffer_tx_t*
+ue::get_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq_process, uint32_t tb_idx, uint32_t tbs)
 {
   if ((size_t)enb_cc_idx >= cc_buffers.size() or cc_buffers[enb_cc_idx].empty()) {
     ERROR("eNB CC Index (%d/%zd) out-of-range", enb_cc_idx, cc_buffers.size());
     return nullptr;
   }
+  if (tbs > 0 and not cc_buffers[enb_cc_idx].reserve_tx_softbuffer(harq_process, tb_idx, tbs)) {
+    logger.error("Failed to allocate the Tx soft-buffer of rnti=0x%x for a TBS of %d bytes", rnti, tbs);
+    return nullptr;
+  }
 
   return &cc_buffers[enb_cc_idx].get_tx_softbuffer(harq_process, tb_idx);
 }
@@ -423,7 +472,13 @@ bool ue::process_ce(srsran::sch_subh* subh, uint32_t grant_nof_prbs)
     case srsran::ul_sch_lcid::CRNTI:
       old_rnti = subh->get_c_rnti();
       if (sched->ue_exists(old_rnti)) {
-        rrc->upd_user(rnti, old_rnti);
+        if (stack_task_queue != nullptr) {
+          rrc_interface_mac* rrc_     = rrc;
+          uint16_t           new_rnti = rnti;
+          stack_task_queue->push([rrc_, new_rnti, old_rnti]() { rrc_->upd_user(new_rnti, old_rnti); });
+        } else {
+          rrc->upd_user(rnti, old_rnti);
+        }
         rnti = old_rnti;
       } else {
         logger.warning("Updating user C-RNTI: rnti=0x%x already released.", old_rnti);
@@ -606,86 +661,100 @@ uint8_t* ue::generate_mch_pdu(uint32_t                             harq_pid,
 }
 
 /******* METRICS interface ***************/
-void ue::metrics_read(mac_ue_metrics_t* metrics_)
+/// Adds a value to an atomic float, which has no native fetch_add in C++14.
+static void atomic_float_add(std::atomic<float>& sum, float value)
 {
-  uint32_t ul_buffer = sched->get_ul_buffer(rnti);
-  uint32_t dl_buffer = sched->get_dl_buffer(rnti);
-
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  ue_metrics.rnti      = rnti;
-  ue_metrics.ul_buffer = ul_buffer;
-  ue_metrics.dl_buffer = dl_buffer;
+  float cur = sum.load(std::memory_order_relaxed);
+  while (not sum.compare_exchange_weak(cur, cur + value, std::memory_order_relaxed)) {
+  }
+}
 
-  // set PCell sector id
-  std::array<int, SRSRAN_MAX_CARRIERS> cc_list = sched->get_enb_ue_cc_map(rnti);
-  auto                                 it      = std::find(cc_list.begin(), cc_list.end(), 0);
-  ue_metrics.cc_idx                            = std::distance(cc_list.begin(), it);
+/// Returns the average of the accumulated samples and restarts the accumulation.
+static float take_average(std::atomic<float>& sum, std::atomic<uint32_t>& count)
+{
+  uint32_t n     = count.exchange(0, std::memory_order_relaxed);
+  float    total = sum.exchange(0, std::memory_order_relaxed);
+  return (n > 0) ? total / n : 0.0f;
+}
 
-  *metrics_ = ue_metrics;
+/// Moves the metrics accumulated since the last call into the given struct. The buffer occupancy and the PCell index
+/// are filled by the scheduler, see sched::metrics_read().
+void ue::take_metrics_snapshot(mac_ue_metrics_t& metrics_)
+{
+  metrics_.nof_tti   = ue_metrics.nof_tti.exchange(0, std::memory_order_relaxed);
+  metrics_.tx_pkts   = ue_metrics.tx_pkts.exchange(0, std::memory_order_relaxed);
+  metrics_.tx_errors = ue_metrics.tx_errors.exchange(0, std::memory_order_relaxed);
+  metrics_.tx_brate  = ue_metrics.tx_brate.exchange(0, std::memory_order_relaxed);
+  metrics_.rx_pkts   = ue_metrics.rx_pkts.exchange(0, std::memory_order_relaxed);
+  metrics_.rx_errors = ue_metrics.rx_errors.exchange(0, std::memory_order_relaxed);
+  metrics_.rx_brate  = ue_metrics.rx_brate.exchange(0, std::memory_order_relaxed);
+  metrics_.phr       = take_average(ue_metrics.phr_sum, ue_metrics.phr_count);
+  metrics_.dl_cqi    = take_average(ue_metrics.dl_cqi_sum, ue_metrics.dl_cqi_count);
+  metrics_.dl_pmi    = take_average(ue_metrics.dl_pmi_sum, ue_metrics.dl_pmi_count);
+  metrics_.dl_ri     = ue_metrics.dl_ri.exchange(0, std::memory_order_relaxed);
+}
 
-  phr_counter    = 0;
-  dl_cqi_counter = 0;
-  ue_metrics     = {};
+void ue::metrics_read(mac_ue_metrics_t* metrics_)
+{
+  *metrics_      = {};
+  metrics_->rnti = rnti;
+  take_metrics_snapshot(*metrics_);
+  for (const auto& cc : cc_buffers) {
+    metrics_->softbuffer_bytes += cc.get_softbuffer_mem_bytes();
+  }
 }
 
 void ue::metrics_phr(float phr)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  ue_metrics.phr = SRSRAN_VEC_CMA(phr, ue_metrics.phr, phr_counter);
-  phr_counter++;
+  atomic_float_add(ue_metrics.phr_sum, phr);
+  ue_metrics.phr_count.fetch_add(1, std::memory_order_relaxed);
 }
 
 void ue::metrics_dl_ri(uint32_t dl_ri)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  if (ue_metrics.dl_ri == 0.0f) {
-    ue_metrics.dl_ri = (float)dl_ri + 1.0f;
-  } else {
-    ue_metrics.dl_ri = SRSRAN_VEC_EMA((float)dl_ri + 1.0f, ue_metrics.dl_ri, 0.5f);
-  }
-  dl_ri_counter++;
+  float value = (float)dl_ri + 1.0f;
+  float cur   = ue_metrics.dl_ri.load(std::memory_order_relaxed);
+  float next;
+  do {
+    next = (cur == 0.0f) ? value : SRSRAN_VEC_EMA(value, cur, 0.5f);
+  } while (not ue_metrics.dl_ri.compare_exchange_weak(cur, next, std::memory_order_relaxed));
 }
 
 void ue::metrics_dl_pmi(uint32_t dl_ri)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  ue_metrics.dl_pmi = SRSRAN_VEC_CMA((float)dl_ri, ue_metrics.dl_pmi, dl_pmi_counter);
-  dl_pmi_counter++;
+  atomic_float_add(ue_metrics.dl_pmi_sum, (float)dl_ri);
+  ue_metrics.dl_pmi_count.fetch_add(1, std::memory_order_relaxed);
 }
 
 void ue::metrics_dl_cqi(uint32_t dl_cqi)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  ue_metrics.dl_cqi = SRSRAN_VEC_CMA((float)dl_cqi, ue_metrics.dl_cqi, dl_cqi_counter);
-  dl_cqi_counter++;
+  atomic_float_add(ue_metrics.dl_cqi_sum, (float)dl_cqi);
+  ue_metrics.dl_cqi_count.fetch_add(1, std::memory_order_relaxed);
 }
 
 void ue::metrics_rx(bool crc, uint32_t tbs)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
   if (crc) {
-    ue_metrics.rx_brate += tbs * 8;
+    ue_metrics.rx_brate.fetch_add(tbs * 8, std::memory_order_relaxed);
   } else {
-    ue_metrics.rx_errors++;
+    ue_metrics.rx_errors.fetch_add(1, std::memory_order_relaxed);
   }
-  ue_metrics.rx_pkts++;
+  ue_metrics.rx_pkts.fetch_add(1, std::memory_order_relaxed);
 }
 
 void ue::metrics_tx(bool crc, uint32_t tbs)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
   if (crc) {
-    ue_metrics.tx_brate += tbs * 8;
+    ue_metrics.tx_brate.fetch_add(tbs * 8, std::memory_order_relaxed);
   } else {
-    ue_metrics.tx_errors++;
+    ue_metrics.tx_errors.fetch_add(1, std::memory_order_relaxed);
   }
-  ue_metrics.tx_pkts++;
+  ue_metrics.tx_pkts.fetch_add(1, std::memory_order_relaxed);
 }
 
 void ue::metrics_cnt()
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  ue_metrics.nof_tti++;
+  ue_metrics.nof_tti.fetch_add(1, std::memory_order_relaxed);
 }
 
 void ue::tic()
@@ -132,8 +132,13 @@ void mac_controller::handle_con_reject()
 /// Called in case of intra-eNB Handover to activate the new PCell for the reception of the RRC Reconf Complete message
 int mac_controller::handle_crnti_ce(uint32_t temp_crnti)
 {
+  if (next_sched_ue_cfg == nullptr) {
+    logger.error("rnti=0x%x: C-RNTI CE received without a Handover in progress", rnti);
+    return SRSRAN_ERROR;
+  }
+
   // Change PCell and add SCell configurations to MAC/Scheduler
-  current_sched_ue_cfg = next_sched_ue_cfg;
+  current_sched_ue_cfg = *next_sched_ue_cfg;
 
   // Disable SCells, until RRCReconfComplete is received, otherwise the SCell Act MAC CE is sent too early
   set_scell_activation({0});
@@ -143,7 +148,7 @@ int mac_controller::handle_crnti_ce(uint32_t temp_crnti)
 
   // Re-activate SRBs UL (needed for ReconfComplete)
   for (uint32_t i = srb_to_lcid(lte_srb::srb1); i <= srb_to_lcid(lte_srb::srb2); ++i) {
-    current_sched_ue_cfg.ue_bearers[i] = next_sched_ue_cfg.ue_bearers[i];
+    current_sched_ue_cfg.ue_bearers[i] = next_sched_ue_cfg->ue_bearers[i];
   }
 
   // keep SRB2 disabled until RRCReconfComplete is received
@@ -216,9 +221,9 @@ void mac_controller::handle_con_reconf(const asn1::rrc::rrc_conn_recfg_r8_ies_s&
   ue_cfg_apply_conn_reconf(current_sched_ue_cfg, conn_recfg, *rrc_cfg);
 
   // Store MAC updates that are applied once RRCReconfigurationComplete is received
-  next_sched_ue_cfg = current_sched_ue_cfg;
-  ue_cfg_apply_capabilities(next_sched_ue_cfg, *rrc_cfg, uecaps);
-  ue_cfg_apply_reconf_complete_updates(next_sched_ue_cfg, conn_recfg, ue_cell_list);
+  ue_cfg_t& next_cfg = start_next_sched_ue_cfg();
+  ue_cfg_apply_capabilities(next_cfg, *rrc_cfg, uecaps);
+  ue_cfg_apply_reconf_complete_updates(next_cfg, conn_recfg, ue_cell_list);
 
   // Temporarily freeze new allocations for DRBs (SRBs are needed to send RRC Reconf Message)
   set_drb_activation(false);
@@ -230,7 +235,10 @@ void mac_controller::handle_con_reconf(const asn1::rrc::rrc_conn_recfg_r8_ies_s&
 
 void mac_controller::handle_con_reconf_complete()
 {
-  current_sched_ue_cfg = next_sched_ue_cfg;
+  if (next_sched_ue_cfg != nullptr) {
+    current_sched_ue_cfg = *next_sched_ue_cfg;
+    next_sched_ue_cfg.reset();
+  }
 
   // Setup SRB2
   set_srb2_activation(true);
@@ -267,9 +275,9 @@ void mac_controller::handle_target_enb_ho_cmd(const asn1::rrc::rrc_conn_recfg_r8
 {
   ue_cfg_apply_conn_reconf(current_sched_ue_cfg, conn_recfg, *rrc_cfg);
 
-  next_sched_ue_cfg = current_sched_ue_cfg;
-  ue_cfg_apply_capabilities(next_sched_ue_cfg, *rrc_cfg, uecaps);
-  ue_cfg_apply_reconf_complete_updates(next_sched_ue_cfg, conn_recfg, ue_cell_list);
+  ue_cfg_t& next_cfg = start_next_sched_ue_cfg();
+  ue_cfg_apply_capabilities(next_cfg, *rrc_cfg, uecaps);
+  ue_cfg_apply_reconf_complete_updates(next_cfg, conn_recfg, ue_cell_list);
 
   // Temporarily freeze SRB2 and DRBs. SRB1 is needed to send
   // RRC Reconfiguration and receive RRC Reconfiguration Complete
@@ -284,15 +292,15 @@ void mac_controller::handle_target_enb_ho_cmd(const asn1::rrc::rrc_conn_recfg_r8
 void mac_controller::handle_intraenb_ho_cmd(const asn1::rrc::rrc_conn_recfg_r8_ies_s& conn_recfg,
                                             const srsran::rrc_ue_capabilities_t&      uecaps)
 {
-  next_sched_ue_cfg = current_sched_ue_cfg;
-  next_sched_ue_cfg.supported_cc_list[0].enb_cc_idx =
+  ue_cfg_t& next_cfg = start_next_sched_ue_cfg();
+  next_cfg.supported_cc_list[0].enb_cc_idx =
       cell_common_list.get_pci(conn_recfg.mob_ctrl_info.target_pci)->enb_cc_idx;
-  for (uint32_t i = 0; i < next_sched_ue_cfg.supported_cc_list.size(); ++i) {
-    next_sched_ue_cfg.supported_cc_list[0].active = true;
+  for (uint32_t i = 0; i < next_cfg.supported_cc_list.size(); ++i) {
+    next_cfg.supported_cc_list[0].active = true;
   }
-  ue_cfg_apply_conn_reconf(next_sched_ue_cfg, conn_recfg, *rrc_cfg);
-  ue_cfg_apply_capabilities(next_sched_ue_cfg, *rrc_cfg, uecaps);
-  ue_cfg_apply_reconf_complete_updates(next_sched_ue_cfg, conn_recfg, ue_cell_list);
+  ue_cfg_apply_conn_reconf(next_cfg, conn_recfg, *rrc_cfg);
+  ue_cfg_apply_capabilities(next_cfg, *rrc_cfg, uecaps);
+  ue_cfg_apply_reconf_complete_updates(next_cfg, conn_recfg, ue_cell_list);
 
   // Freeze SCells
   // NOTE: this avoids that the UE receives an HOCmd retx from target cell and do an incorrect RLC-level concatenation
@@ -310,6 +318,17 @@ void mac_controller::handle_intraenb_ho_cmd(const asn1::rrc::rrc_conn_recfg_r8_i
   mac->phy_config_enabled(rnti, false);
 }
 
+/// Starts the UE configuration to apply once the ongoing RRC procedure completes, from the current one
+mac_controller::ue_cfg_t& mac_controller::start_next_sched_ue_cfg()
+{
+  if (next_sched_ue_cfg == nullptr) {
+    next_sched_ue_cfg = std::make_unique<ue_cfg_t>(current_sched_ue_cfg);
+  } else {
+    *next_sched_ue_cfg = current_sched_ue_cfg;
+  }
+  return *next_sched_ue_cfg;
+}
+
 void mac_controller::handle_ho_prep(const asn1::rrc::ho_prep_info_r8_ies_s& ho_prep)
 {
   // TODO: Apply configuration in ho_prep as a base
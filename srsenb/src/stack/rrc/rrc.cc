@@ -103,6 +103,11 @@ int32_t rrc::init(const rrc_cfg_t&       cfg_,
   }
   config_mac();
 
+  // RRCConnectionSetup is packed once, and only its UE-specific fields are written for each new UE
+  if (not conn_setup_tmpl.init(cfg)) {
+    logger.warning("Couldn't pre-encode RRCConnectionSetup. It will be packed for each UE");
+  }
+
   // Check valid inactivity timeout config
   uint32_t t310 = cfg.sibs[1].sib2().ue_timers_and_consts.t310.to_number();
   uint32_t t311 = cfg.sibs[1].sib2().ue_timers_and_consts.t311.to_number();
@@ -243,7 +248,10 @@ int rrc::add_user(uint16_t rnti, const sched_interface::ue_cfg_t& sched_ue_cfg)
         logger.error("Adding user rnti=0x%x - Failed to allocate user resources", rnti);
         return SRSRAN_ERROR;
       }
-      users.insert(std::make_pair(rnti, std::move(u)));
+      if (not users.insert(rnti, std::move(u))) {
+        logger.error("Adding user rnti=0x%x - The slot of the UE table is in use", rnti);
+        return SRSRAN_ERROR;
+      }
     }
     rlc->add_user(rnti);
     pdcp->add_user(rnti);
@@ -560,7 +568,7 @@ void rrc::ho_preparation_complete(uint16_t                     rnti,
                                   const asn1::s1ap::ho_cmd_s&  msg,
                                   srsran::unique_byte_buffer_t rrc_container)
 {
-  users.at(rnti)->mobility_handler->handle_ho_preparation_complete(result, msg, std::move(rrc_container));
+  users[rnti]->mobility_handler->handle_ho_preparation_complete(result, msg, std::move(rrc_container));
 }
 
 void rrc::set_erab_status(uint16_t rnti, const asn1::s1ap::bearers_subject_to_status_transfer_list_l& erabs)
@@ -319,7 +319,7 @@ bool rrc::ue::rrc_mobility::start_ho_preparation(uint32_t target_eci,
   /*** Fill HO Preparation Info ***/
   asn1::rrc::ho_prep_info_s         hoprep;
   asn1::rrc::ho_prep_info_r8_ies_s& hoprep_r8 = hoprep.crit_exts.set_c1().set_ho_prep_info_r8();
-  if (not rrc_ue->eutra_capabilities_unpacked) {
+  if (rrc_ue->eutra_capabilities == nullptr) {
     // TODO: temporary. Made up something to please target eNB. (there must be at least one capability in this packet)
     hoprep_r8.ue_radio_access_cap_info.resize(1);
     hoprep_r8.ue_radio_access_cap_info[0].rat_type = asn1::rrc::rat_type_e::eutra;
@@ -351,21 +351,12 @@ bool rrc::ue::rrc_mobility::start_ho_preparation(uint32_t target_eci,
     }
     Debug("UE RA Category: %d", capitem.ue_category);
   } else {
+    // Forward the container as received from the UE
+    const std::vector<uint8_t>& blob = rrc_ue->eutra_capabilities->blob;
     hoprep_r8.ue_radio_access_cap_info.resize(1);
     hoprep_r8.ue_radio_access_cap_info[0].rat_type = asn1::rrc::rat_type_e::eutra;
-
-    srsran::unique_byte_buffer_t buffer = srsran::make_byte_buffer();
-    if (buffer == nullptr) {
-      logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
-      return false;
-    }
-    asn1::bit_ref bref(buffer->msg, buffer->get_tailroom());
-    if (rrc_ue->eutra_capabilities.pack(bref) == asn1::SRSASN_ERROR_ENCODE_FAIL) {
-      logger.error("Failed to pack UE EUTRA Capability");
-      return false;
-    }
-    hoprep_r8.ue_radio_access_cap_info[0].ue_cap_rat_container.resize(bref.distance_bytes());
-    memcpy(&hoprep_r8.ue_radio_access_cap_info[0].ue_cap_rat_container[0], buffer->msg, bref.distance_bytes());
+    hoprep_r8.ue_radio_access_cap_info[0].ue_cap_rat_container.resize(blob.size());
+    std::copy(blob.begin(), blob.end(), hoprep_r8.ue_radio_access_cap_info[0].ue_cap_rat_container.data());
   }
   /*** fill AS-Config ***/
   hoprep_r8.as_cfg_present       = true;
@@ -996,18 +987,19 @@ bool rrc::ue::rrc_mobility::apply_ho_prep_cfg(const ho_prep_info_r8_ies_s&
   // Save UE Capabilities
   for (const auto& cap : ho_prep.ue_radio_access_cap_info) {
     if (cap.rat_type.value == rat_type_opts::eutra) {
-      asn1::cbit_ref bref(cap.ue_cap_rat_container.data(), cap.ue_cap_rat_container.size());
-      if (rrc_ue->eutra_capabilities.unpack(bref) != asn1::SRSASN_SUCCESS) {
+      std::shared_ptr<const ue_eutra_cap_t> caps = rrc_enb->cap_cache.get(
+          srsran::const_byte_span(cap.ue_cap_rat_container.data(), cap.ue_cap_rat_container.size()));
+      if (caps == nullptr) {
         logger.warning("Failed to unpack UE EUTRA Capability");
         continue;
       }
       if (logger.debug.enabled()) {
         asn1::json_writer js{};
-        rrc_ue->eutra_capabilities.to_json(js);
+        caps->caps.to_json(js);
         logger.debug("New rnti=0x%x EUTRA capabilities: %s", rrc_ue->rnti, js.to_string().c_str());
       }
-      rrc_ue->ue_capabilities             = srsran::make_rrc_ue_capabilities(rrc_ue->eutra_capabilities);
-      rrc_ue->eutra_capabilities_unpacked = true;
+      rrc_ue->ue_capabilities    = caps->summary;
+      rrc_ue->eutra_capabilities = std::move(caps);
     }
   }
 
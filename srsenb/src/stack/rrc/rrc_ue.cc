@@ -110,6 +110,7 @@ rrc_state_t rrc::ue::get_state()
 void rrc::ue::get_metrics(rrc_ue_metrics_t& ue_metrics) const
 {
   ue_metrics.state      = state;
+  ue_metrics.mem_bytes  = sizeof(*this);
   const auto& drb_list  = bearer_list.get_established_drbs();
   const auto& erab_list = bearer_list.get_erabs();
   ue_metrics.drb_qci_map.reserve(drb_list.size());
@@ -501,12 +502,27 @@ void rrc::ue::send_connection_setup()
   rrc_conn_setup_r8_ies_s& setup_r8 = rrc_setup.crit_exts.set_c1().set_rrc_conn_setup_r8();
   rr_cfg_ded_s&            rr_cfg   = setup_r8.rr_cfg_ded;
 
-  // Fill RR config dedicated
-  if (fill_rr_cfg_ded_setup(rr_cfg, parent->cfg, ue_cell_list)) {
+  // Fill RR config dedicated, from the pre-encoded message when available
+  const rrc_conn_setup_template& setup_tmpl = parent->conn_setup_tmpl;
+  if (setup_tmpl.is_valid() ? setup_tmpl.fill_rr_cfg_ded(rr_cfg, parent->cfg, ue_cell_list)
+                            : fill_rr_cfg_ded_setup(rr_cfg, parent->cfg, ue_cell_list)) {
     parent->logger.error("Generating ConnectionSetup. Aborting");
     return;
   }
 
+  // Write the UE-specific fields into a copy of the pre-encoded message
+  srsran::unique_byte_buffer_t pdu;
+  if (setup_tmpl.is_valid()) {
+    pdu = srsran::make_byte_buffer();
+    if (pdu == nullptr) {
+      parent->logger.error("Allocating pdu");
+      return;
+    }
+    if (setup_tmpl.pack(rrc_setup.rrc_transaction_id, rr_cfg, *pdu) != SRSRAN_SUCCESS) {
+      pdu = nullptr;
+    }
+  }
+
   // Apply ConnectionSetup Configuration to MAC scheduler
   mac_ctrl.handle_con_setup(setup_r8);
 
@@ -519,17 +535,19 @@ void rrc::ue::send_connection_setup()
   apply_setup_phy_config_dedicated(rr_cfg.phys_cfg_ded); // It assumes SCell has not been set before
 
   std::string octet_str;
-  send_dl_ccch(&dl_ccch_msg, &octet_str);
+  send_dl_ccch(&dl_ccch_msg, event_logger::is_enabled() ? &octet_str : nullptr, std::move(pdu));
 
   // Log event.
-  asn1::json_writer json_writer;
-  dl_ccch_msg.to_json(json_writer);
-  event_logger::get().log_rrc_event(ue_cell_list.get_ue_cc_idx(UE_PCELL_CC_IDX)->cell_common->enb_cc_idx,
-                                    octet_str,
-                                    json_writer.to_string(),
-                                    static_cast<unsigned>(rrc_event_type::con_setup),
-                                    static_cast<unsigned>(procedure_result_code::none),
-                                    rnti);
+  if (event_logger::is_enabled()) {
+    asn1::json_writer json_writer;
+    dl_ccch_msg.to_json(json_writer);
+    event_logger::get().log_rrc_event(ue_cell_list.get_ue_cc_idx(UE_PCELL_CC_IDX)->cell_common->enb_cc_idx,
+                                      octet_str,
+                                      json_writer.to_string(),
+                                      static_cast<unsigned>(rrc_event_type::con_setup),
+                                      static_cast<unsigned>(procedure_result_code::none),
+                                      rnti);
+  }
 
   apply_rr_cfg_ded_diff(current_ue_cfg.rr_cfg, rr_cfg);
 }
@@ -712,12 +730,11 @@ void rrc::ue::handle_rrc_con_reest_req(rrc_conn_reest_request_s* msg)
   }
 
   // Make sure UE capabilities are copied over to new RNTI
-  eutra_capabilities          = old_ue->eutra_capabilities;
-  eutra_capabilities_unpacked = old_ue->eutra_capabilities_unpacked;
-  ue_capabilities             = old_ue->ue_capabilities;
-  if (parent->logger.debug.enabled()) {
+  eutra_capabilities = old_ue->eutra_capabilities;
+  ue_capabilities    = old_ue->ue_capabilities;
+  if (eutra_capabilities != nullptr and parent->logger.debug.enabled()) {
     asn1::json_writer js{};
-    eutra_capabilities.to_json(js);
+    eutra_capabilities->caps.to_json(js);
     parent->logger.debug("rnti=0x%x EUTRA capabilities: %s", rnti, js.to_string().c_str());
   }
   if (endc_handler) {
@@ -725,10 +742,12 @@ void rrc::ue::handle_rrc_con_reest_req(rrc_conn_reest_request_s* msg)
       // In case of Reestablishment due to ReconfFailure, avoid re-enabling NR EN-DC, otherwise
       // the eNB and UE may enter in a reconfiguration + reestablishment loop.
       endc_handler->trigger(rrc_endc::disable_endc_ev{});
-    } else {
+    } else if (eutra_capabilities != nullptr) {
       // In case of Reestablishment with cause other than ReconfFailure, recompute whether
       // the new RNTI supports NR EN-DC.
-      endc_handler->handle_eutra_capabilities(eutra_capabilities);
+      endc_handler->handle_eutra_capabilities(eutra_capabilities->caps);
+    } else {
+      endc_handler->trigger(rrc_endc::disable_endc_ev{});
     }
   }
 
@@ -1064,28 +1083,30 @@ int rrc::ue::handle_ue_cap_info(ue_cap_info_s* msg)
       // Not handling UE capability information for RATs other than EUTRA
       continue;
     }
-    asn1::cbit_ref bref(msg_r8->ue_cap_rat_container_list[i].ue_cap_rat_container.data(),
-                        msg_r8->ue_cap_rat_container_list[i].ue_cap_rat_container.size());
-    if (eutra_capabilities.unpack(bref) != asn1::SRSASN_SUCCESS) {
+    // Identical UEs send identical containers, which are only unpacked once
+    const auto&                           container = msg_r8->ue_cap_rat_container_list[i].ue_cap_rat_container;
+    std::shared_ptr<const ue_eutra_cap_t> caps =
+        parent->cap_cache.get(srsran::const_byte_span(container.data(), container.size()));
+    if (caps == nullptr) {
       parent->logger.error("Failed to unpack EUTRA capabilities message");
       return SRSRAN_ERROR;
     }
+    eutra_capabilities = std::move(caps);
     if (parent->logger.debug.enabled()) {
       asn1::json_writer js{};
-      eutra_capabilities.to_json(js);
+      eutra_capabilities->caps.to_json(js);
       parent->logger.debug("rnti=0x%x EUTRA capabilities: %s", rnti, js.to_string().c_str());
     }
-    eutra_capabilities_unpacked = true;
-    ue_capabilities             = srsran::make_rrc_ue_capabilities(eutra_capabilities);
+    ue_capabilities = eutra_capabilities->summary;
 
-    parent->logger.info("UE rnti: 0x%x category: %d", rnti, eutra_capabilities.ue_category);
+    parent->logger.info("UE rnti: 0x%x category: %d", rnti, eutra_capabilities->caps.ue_category);
 
     if (endc_handler != nullptr) {
-      endc_handler->handle_eutra_capabilities(eutra_capabilities);
+      endc_handler->handle_eutra_capabilities(eutra_capabilities->caps);
     }
   }
 
-  if (eutra_capabilities_unpacked) {
+  if (eutra_capabilities != nullptr) {
     srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
     if (pdu == nullptr) {
       parent->logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
@@ -1270,15 +1291,15 @@ void rrc::ue::update_scells()
   const enb_cell_common* pcell_cfg = pcell->cell_common;
 
   // Check whether UE supports CA
-  if (eutra_capabilities.access_stratum_release.to_number() < 10) {
+  if (eutra_capabilities == nullptr or eutra_capabilities->caps.access_stratum_release.to_number() < 10) {
     parent->logger.info("UE doesn't support CA. Skipping SCell activation");
     return;
   }
-  if (not eutra_capabilities.non_crit_ext_present or not eutra_capabilities.non_crit_ext.non_crit_ext_present or
-      not eutra_capabilities.non_crit_ext.non_crit_ext.non_crit_ext_present or
-      not eutra_capabilities.non_crit_ext.non_crit_ext.non_crit_ext.rf_params_v1020_present or
-      eutra_capabilities.non_crit_ext.non_crit_ext.non_crit_ext.rf_params_v1020.supported_band_combination_r10.size() ==
-          0) {
+  const asn1::rrc::ue_eutra_cap_s& caps = eutra_capabilities->caps;
+  if (not caps.non_crit_ext_present or not caps.non_crit_ext.non_crit_ext_present or
+      not caps.non_crit_ext.non_crit_ext.non_crit_ext_present or
+      not caps.non_crit_ext.non_crit_ext.non_crit_ext.rf_params_v1020_present or
+      caps.non_crit_ext.non_crit_ext.non_crit_ext.rf_params_v1020.supported_band_combination_r10.size() == 0) {
     parent->logger.info("UE doesn't support CA. Skipping SCell activation");
     return;
   }
@@ -1297,31 +1318,33 @@ void rrc::ue::update_scells()
 
 /********************** HELPERS ***************************/
 
-void rrc::ue::send_dl_ccch(dl_ccch_msg_s* dl_ccch_msg, std::string* octet_str)
+void rrc::ue::send_dl_ccch(dl_ccch_msg_s* dl_ccch_msg, std::string* octet_str, srsran::unique_byte_buffer_t pdu)
 {
-  // Allocate a new PDU buffer, pack the message and send to PDCP
-  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
-  if (pdu) {
+  // Allocate a new PDU buffer and pack the message, unless it was packed already
+  if (pdu == nullptr) {
+    pdu = srsran::make_byte_buffer();
+    if (pdu == nullptr) {
+      parent->logger.error("Allocating pdu");
+      return;
+    }
     asn1::bit_ref bref(pdu->msg, pdu->get_tailroom());
     if (dl_ccch_msg->pack(bref) != asn1::SRSASN_SUCCESS) {
       parent->logger.error(pdu->msg, pdu->N_bytes, "Failed to pack DL-CCCH-Msg:");
       return;
     }
     pdu->N_bytes = (uint32_t)bref.distance_bytes();
+  }
 
-    // Log Tx message
-    parent->log_rrc_message(
-        Tx, rnti, srb_to_lcid(lte_srb::srb0), *pdu, *dl_ccch_msg, dl_ccch_msg->msg.c1().type().to_string());
-
-    // Encode the pdu as an octet string if the user passed a valid pointer.
-    if (octet_str) {
-      *octet_str = asn1::octstring_to_string(pdu->msg, pdu->N_bytes);
-    }
+  // Log Tx message
+  parent->log_rrc_message(
+      Tx, rnti, srb_to_lcid(lte_srb::srb0), *pdu, *dl_ccch_msg, dl_ccch_msg->msg.c1().type().to_string());
 
-    parent->rlc->write_sdu(rnti, srb_to_lcid(lte_srb::srb0), std::move(pdu));
-  } else {
-    parent->logger.error("Allocating pdu");
+  // Encode the pdu as an octet string if the user passed a valid pointer.
+  if (octet_str) {
+    *octet_str = asn1::octstring_to_string(pdu->msg, pdu->N_bytes);
   }
+
+  parent->rlc->write_sdu(rnti, srb_to_lcid(lte_srb::srb0), std::move(pdu));
 }
 
 bool rrc::ue::send_dl_dcch(const dl_dcch_msg_s* dl_dcch_msg, srsran::unique_byte_buffer_t pdu, std::string* octet_str)
@@ -0,0 +1,75 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsenb/hdr/stack/rrc/ue_cap_cache.h"
+#include "srsran/asn1/rrc_utils.h"
+#include <algorithm>
+
+namespace srsenb {
+
+/// FNV-1a
+uint64_t ue_cap_cache::hash_blob(srsran::const_byte_span blob)
+{
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (uint8_t b : blob) {
+    h = (h ^ b) * 0x100000001b3ULL;
+  }
+  return h;
+}
+
+std::shared_ptr<const ue_eutra_cap_t> ue_cap_cache::get(srsran::const_byte_span blob)
+{
+  uint64_t hash = hash_blob(blob);
+  for (entry_t& e : entries) {
+    if (e.hash == hash and e.cap->blob.size() == blob.size() and
+        std::equal(blob.begin(), blob.end(), e.cap->blob.begin())) {
+      e.last_used = ++clock;
+      hits++;
+      return e.cap;
+    }
+  }
+
+  // Miss. Unpack the container
+  std::shared_ptr<ue_eutra_cap_t> cap = std::make_shared<ue_eutra_cap_t>();
+  asn1::cbit_ref                  bref(blob.data(), blob.size());
+  if (cap->caps.unpack(bref) != asn1::SRSASN_SUCCESS) {
+    return nullptr;
+  }
+  cap->blob.assign(blob.begin(), blob.end());
+  cap->summary = srsran::make_rrc_ue_capabilities(cap->caps);
+
+  // Store it, replacing the least recently used entry if the cache is full
+  if (entries.size() < max_size) {
+    entries.push_back(entry_t{hash, ++clock, cap});
+  } else if (max_size > 0) {
+    entry_t* lru = &entries[0];
+    for (entry_t& e : entries) {
+      if (e.last_used < lru->last_used) {
+        lru = &e;
+      }
+    }
+    *lru = entry_t{hash, ++clock, cap};
+  }
+  return cap;
+}
+
+} // namespace srsenb
@@ -612,4 +612,146 @@ int apply_reconf_updates(asn1::rrc::rrc_conn_recfg_r8_ies_s&  recfg_r8,
   return SRSRAN_SUCCESS;
 }
 
+/***********************************
+ *   RRCConnectionSetup template
+ **********************************/
+
+bool rrc_conn_setup_template::init(const rrc_cfg_t& enb_cfg)
+{
+  msg.clear();
+  fields = {};
+
+  // Same content as fill_rr_cfg_ded_setup, without the UE SR/CQI resources
+  fill_rr_cfg_ded_enb_cfg(rr_cfg_tmpl, enb_cfg);
+  rr_cfg_tmpl.srb_to_add_mod_list_present = true;
+  add_srb(rr_cfg_tmpl.srb_to_add_mod_list, 1, enb_cfg.srb1_cfg.rlc_cfg);
+  cqi_periodic = rr_cfg_tmpl.phys_cfg_ded.cqi_report_cfg.cqi_report_periodic_present;
+
+  dl_ccch_msg_s dl_ccch_msg;
+  dl_ccch_msg.msg.set_c1().set_rrc_conn_setup().crit_exts.set_c1().set_rrc_conn_setup_r8().rr_cfg_ded = rr_cfg_tmpl;
+
+  // Each field starts at the first bit that changes when its value goes from the lower to the upper bound
+  const field_values_t max_values = {3, 2047, 157, 1185, 1023};
+  std::vector<uint8_t> base, probe;
+  if (pack_msg(dl_ccch_msg, field_values_t{}, base) != SRSRAN_SUCCESS) {
+    return false;
+  }
+  uint32_t nof_ue_fields = cqi_periodic ? (uint32_t)nof_fields : (uint32_t)cqi_pucch_res_idx;
+  for (uint32_t i = 0; i < nof_ue_fields; ++i) {
+    field_values_t values = {};
+    values[i]             = max_values[i];
+    if (pack_msg(dl_ccch_msg, values, probe) != SRSRAN_SUCCESS or probe.size() != base.size()) {
+      return false;
+    }
+    uint32_t pos = 0;
+    while (pos < base.size() * 8 and ((base[pos / 8] ^ probe[pos / 8]) & (0x80u >> (pos % 8))) == 0) {
+      pos++;
+    }
+    if (pos == base.size() * 8) {
+      return false;
+    }
+    fields[i].bit_pos = pos;
+    while ((max_values[i] >> fields[i].n_bits) != 0) {
+      fields[i].n_bits++;
+    }
+  }
+
+  // Check that the patched fields reproduce the packed message
+  const field_values_t test_values = {2, 1234, 77, 1000, 555};
+  if (pack_msg(dl_ccch_msg, test_values, probe) != SRSRAN_SUCCESS or probe.size() != base.size()) {
+    return false;
+  }
+  patch(base.data(), test_values);
+  if (base != probe) {
+    return false;
+  }
+  msg = std::move(base);
+  return true;
+}
+
+int rrc_conn_setup_template::fill_rr_cfg_ded(rr_cfg_ded_s&           rr_cfg,
+                                             const rrc_cfg_t&        enb_cfg,
+                                             const ue_cell_ded_list& ue_cell_list) const
+{
+  rr_cfg = rr_cfg_tmpl;
+  if (fill_sr_cfg_setup(rr_cfg.phys_cfg_ded.sched_request_cfg, ue_cell_list)) {
+    return SRSRAN_ERROR;
+  }
+  return fill_cqi_report_setup(rr_cfg.phys_cfg_ded.cqi_report_cfg, enb_cfg, ue_cell_list);
+}
+
+int rrc_conn_setup_template::pack(uint8_t transaction_id, const rr_cfg_ded_s& rr_cfg, srsran::byte_buffer_t& pdu) const
+{
+  if (not is_valid() or msg.size() > pdu.get_tailroom()) {
+    return SRSRAN_ERROR;
+  }
+  memcpy(pdu.msg, msg.data(), msg.size());
+  pdu.N_bytes = msg.size();
+  patch(pdu.msg, get_values(transaction_id, rr_cfg));
+  return SRSRAN_SUCCESS;
+}
+
+int rrc_conn_setup_template::pack_msg(dl_ccch_msg_s&        dl_ccch_msg,
+                                      const field_values_t& values,
+                                      std::vector<uint8_t>& out)
+{
+  set_values(dl_ccch_msg, values);
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  if (pdu == nullptr) {
+    return SRSRAN_ERROR;
+  }
+  asn1::bit_ref bref(pdu->msg, pdu->get_tailroom());
+  if (dl_ccch_msg.pack(bref) != asn1::SRSASN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  out.assign(pdu->msg, pdu->msg + bref.distance_bytes());
+  return SRSRAN_SUCCESS;
+}
+
+void rrc_conn_setup_template::set_values(dl_ccch_msg_s& dl_ccch_msg, const field_values_t& values)
+{
+  rrc_conn_setup_s& rrc_setup  = dl_ccch_msg.msg.c1().rrc_conn_setup();
+  rrc_setup.rrc_transaction_id = values[transaction_id];
+
+  phys_cfg_ded_s&                phy_cfg = rrc_setup.crit_exts.c1().rrc_conn_setup_r8().rr_cfg_ded.phys_cfg_ded;
+  sched_request_cfg_c::setup_s_& sr      = phy_cfg.sched_request_cfg.setup();
+  sr.sr_pucch_res_idx                    = values[sr_pucch_res_idx];
+  sr.sr_cfg_idx                          = values[sr_cfg_idx];
+  if (phy_cfg.cqi_report_cfg.cqi_report_periodic_present) {
+    phy_cfg.cqi_report_cfg.cqi_report_periodic.setup().cqi_pucch_res_idx = values[cqi_pucch_res_idx];
+    phy_cfg.cqi_report_cfg.cqi_report_periodic.setup().cqi_pmi_cfg_idx   = values[cqi_pmi_cfg_idx];
+  }
+}
+
+rrc_conn_setup_template::field_values_t rrc_conn_setup_template::get_values(uint8_t             trans_id,
+                                                                            const rr_cfg_ded_s& rr_cfg)
+{
+  const sched_request_cfg_c::setup_s_& sr = rr_cfg.phys_cfg_ded.sched_request_cfg.setup();
+  field_values_t                       values = {};
+  values[transaction_id]                      = trans_id;
+  values[sr_pucch_res_idx]                    = sr.sr_pucch_res_idx;
+  values[sr_cfg_idx]                          = sr.sr_cfg_idx;
+  if (rr_cfg.phys_cfg_ded.cqi_report_cfg.cqi_report_periodic_present) {
+    const auto& cqi           = rr_cfg.phys_cfg_ded.cqi_report_cfg.cqi_report_periodic.setup();
+    values[cqi_pucch_res_idx] = cqi.cqi_pucch_res_idx;
+    values[cqi_pmi_cfg_idx]   = cqi.cqi_pmi_cfg_idx;
+  }
+  return values;
+}
+
+void rrc_conn_setup_template::patch(uint8_t* buf, const field_values_t& values) const
+{
+  for (uint32_t i = 0; i < nof_fields; ++i) {
+    for (uint32_t b = 0; b < fields[i].n_bits; ++b) {
+      uint32_t pos  = fields[i].bit_pos + b;
+      uint8_t  mask = 0x80u >> (pos % 8);
+      if ((values[i] >> (fields[i].n_bits - 1 - b)) & 1u) {
+        buf[pos / 8] |= mask;
+      } else {
+        buf[pos / 8] &= ~mask;
+      }
+    }
+  }
+}
+
 } // namespace srsenb
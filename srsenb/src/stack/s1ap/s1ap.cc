@@ -304,6 +304,7 @@ void s1ap::s1_setup_proc_t::then(const srsran::proc_state_t& result)
     srsran::console("Failed to initiate S1 connection. Attempting reconnection in %d seconds\n",
                     s1ap_ptr->mme_connect_timer.duration() / 1000);
     s1ap_ptr->rx_socket_handler->remove_socket(s1ap_ptr->mme_socket.get_socket());
+    s1ap_ptr->mme_tx.clear_socket();
     s1ap_ptr->mme_socket.close();
     procInfo("S1AP socket closed.");
     s1ap_ptr->mme_connect_timer.run();
@@ -328,7 +329,8 @@ s1ap::s1ap(srsran::task_sched_handle   task_sched_,
   logger(logger),
   task_sched(task_sched_),
   rx_socket_handler(rx_socket_handler_),
-  alarms_channel(srslog::fetch_log_channel("alarms"))
+  alarms_channel(srslog::fetch_log_channel("alarms")),
+  mme_tx(logger, "S1AP_TX")
 {
   mme_task_queue = task_sched.make_task_queue();
 }
@@ -371,6 +373,8 @@ int s1ap::init(const s1ap_args_t& args_, rrc_interface_s1ap* rrc_)
 void s1ap::stop()
 {
   running = false;
+  mme_tx.flush();
+  mme_tx.stop();
   mme_socket.close();
 }
 
@@ -549,6 +553,11 @@ bool s1ap::connect_mme()
     return false;
   }
 
+  // Request one stream per group of UEs, besides the non UE-associated one
+  if (not mme_socket.sctp_set_nof_streams(args.sctp_nof_streams)) {
+    return false;
+  }
+
   // Bind socket
   if (not mme_socket.bind_addr(args.s1c_bind_addr.c_str(), args.s1c_bind_port)) {
     mme_socket.close();
@@ -561,6 +570,7 @@ bool s1ap::connect_mme()
     return false;
   }
   logger.info("SCTP socket connected with MME. fd=%d", mme_socket.fd());
+  mme_tx.set_socket(mme_socket.fd(), mme_addr, PPID);
 
   // Assign a handler to rx MME packets
   auto rx_callback =
@@ -639,6 +649,10 @@ bool s1ap::handle_mme_rx_msg(srsran::unique_byte_buffer_t pdu,
       logger.info("SCTP remote error. Association: %d", sri.sinfo_assoc_id);
       srsran::console("SCTP remote error. Association: %d\n", sri.sinfo_assoc_id);
       restart_s1 = true;
+    } else if (notification->sn_header.sn_type == SCTP_ASSOC_CHANGE &&
+               notification->sn_assoc_change.sac_state == SCTP_COMM_UP) {
+      nof_mme_streams = notification->sn_assoc_change.sac_outbound_streams;
+      logger.info("SCTP association up. Association: %d, outbound streams: %d", sri.sinfo_assoc_id, nof_mme_streams);
     } else if (notification->sn_header.sn_type == SCTP_ASSOC_CHANGE) {
       logger.info("SCTP association changed. Association: %d", sri.sinfo_assoc_id);
       srsran::console("SCTP association changed. Association: %d\n", sri.sinfo_assoc_id);
@@ -647,6 +661,7 @@ bool s1ap::handle_mme_rx_msg(srsran::unique_byte_buffer_t pdu,
       logger.info("Restarting S1 connection");
       srsran::console("Restarting S1 connection\n");
       rx_socket_handler->remove_socket(mme_socket.get_socket());
+      mme_tx.clear_socket();
       mme_socket.close();
       while (users.size() != 0) {
         std::unordered_map<uint32_t, std::unique_ptr<ue> >::iterator it   = users.begin();
@@ -658,6 +673,7 @@ bool s1ap::handle_mme_rx_msg(srsran::unique_byte_buffer_t pdu,
     }
   } else if (pdu->N_bytes == 0) {
     logger.error("SCTP return 0 bytes. Closing socket");
+    mme_tx.clear_socket();
     mme_socket.close();
   }
 
@@ -686,10 +702,22 @@ bool s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu)
     pcap->write_s1ap(pdu->msg, pdu->N_bytes);
   }
 
-  s1ap_pdu_c     rx_pdu;
-  asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
+  if (handle_s1ap_rx_pdu_fast(pdu)) {
+    return true;
+  }
 
-  if (rx_pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+  // The previous PDU is gone, so its storage can be reused. Only the unpacking takes place within the arena scope
+  rx_arena.reset();
+
+  s1ap_pdu_c        rx_pdu;
+  asn1::cbit_ref    bref(pdu->msg, pdu->N_bytes);
+  asn1::SRSASN_CODE unpack_code;
+  {
+    asn1::decode_arena_scope arena_scope(rx_arena);
+    unpack_code = rx_pdu.unpack(bref);
+  }
+
+  if (unpack_code != asn1::SRSASN_SUCCESS) {
     logger.error(pdu->msg, pdu->N_bytes, "Failed to unpack received PDU");
     cause_c cause;
     cause.set_protocol().value = cause_protocol_opts::transfer_syntax_error;
@@ -713,6 +741,32 @@ bool s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu)
   return true;
 }
 
+bool s1ap::handle_s1ap_rx_pdu_fast(srsran::byte_buffer_t* pdu)
+{
+  // Downlink NAS Transports with just the UE S1AP IDs and the NAS-PDU are handled from an index of their IEs, with the
+  // NAS-PDU read in place. The ones with optional IEs are fully unpacked
+  asn1::protocol_ie_index index;
+  if (index.index(pdu->msg, pdu->N_bytes) != asn1::SRSASN_SUCCESS or
+      index.pdu_type() != s1ap_pdu_c::types_opts::init_msg or index.proc_code() != ASN1_S1AP_ID_DL_NAS_TRANSPORT or
+      index.ext() or index.nof_ies() != 3) {
+    return false;
+  }
+  mme_ue_s1ap_id_t mme_ue_s1ap_id;
+  enb_ue_s1ap_id_t enb_ue_s1ap_id;
+  const uint8_t*   nas_pdu;
+  uint32_t         nas_pdu_len;
+  if (index.unpack_ie(ASN1_S1AP_ID_MME_UE_S1AP_ID, mme_ue_s1ap_id) != asn1::SRSASN_SUCCESS or
+      index.unpack_ie(ASN1_S1AP_ID_ENB_UE_S1AP_ID, enb_ue_s1ap_id) != asn1::SRSASN_SUCCESS or
+      index.get_octstring_ie(ASN1_S1AP_ID_NAS_PDU, nas_pdu, nas_pdu_len) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+
+  s1ap_elem_procs_o::init_msg_c::types msg_type = s1ap_elem_procs_o::init_msg_c::types_opts::dl_nas_transport;
+  logger.info(pdu->msg, pdu->N_bytes, "Rx S1AP SDU - %s", msg_type.to_string());
+  return handle_dlnastransport(
+      enb_ue_s1ap_id.value, mme_ue_s1ap_id.value, srsran::const_span<uint8_t>(nas_pdu, nas_pdu_len));
+}
+
 bool s1ap::handle_initiatingmessage(const init_msg_s& msg)
 {
   switch (msg.value.type().value) {
@@ -792,11 +846,6 @@ bool s1ap::handle_dlnastransport(const dl_nas_transport_s& msg)
   if (msg.ext) {
     logger.warning("Not handling S1AP message extension");
   }
-  ue* u = handle_s1apmsg_ue_id(msg->enb_ue_s1ap_id.value.value, msg->mme_ue_s1ap_id.value.value);
-  if (u == nullptr) {
-    return false;
-  }
-
   if (msg->ho_restrict_list_present) {
     logger.warning("Not handling HandoverRestrictionList");
   }
@@ -804,13 +853,29 @@ bool s1ap::handle_dlnastransport(const dl_nas_transport_s& msg)
     logger.warning("Not handling SubscriberProfileIDforRFP");
   }
 
+  return handle_dlnastransport(msg->enb_ue_s1ap_id.value.value,
+                               msg->mme_ue_s1ap_id.value.value,
+                               srsran::const_span<uint8_t>(msg->nas_pdu.value.data(), msg->nas_pdu.value.size()));
+}
+
+bool s1ap::handle_dlnastransport(uint32_t enb_ue_s1ap_id, uint32_t mme_ue_s1ap_id, srsran::const_span<uint8_t> nas_pdu)
+{
+  ue* u = handle_s1apmsg_ue_id(enb_ue_s1ap_id, mme_ue_s1ap_id);
+  if (u == nullptr) {
+    return false;
+  }
+
   srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
   if (pdu == nullptr) {
     logger.error("Fatal Error: Couldn't allocate buffer in s1ap::run_thread().");
     return false;
   }
-  memcpy(pdu->msg, msg->nas_pdu.value.data(), msg->nas_pdu.value.size());
-  pdu->N_bytes = msg->nas_pdu.value.size();
+  if (nas_pdu.size() > pdu->get_tailroom()) {
+    logger.error("Couldn't store the downlink NAS PDU of %zd bytes", nas_pdu.size());
+    return false;
+  }
+  memcpy(pdu->msg, nas_pdu.data(), nas_pdu.size());
+  pdu->N_bytes = nas_pdu.size();
   rrc->write_dl_info(u->ctxt.rnti, std::move(pdu));
   return true;
 }
@@ -2032,17 +2097,7 @@ bool s1ap::sctp_send_s1ap_pdu(const asn1::s1ap::s1ap_pdu_c& tx_pdu, uint32_t rnt
   }
   uint16_t streamid = rnti == SRSRAN_INVALID_RNTI ? NONUE_STREAM_ID : users.find_ue_rnti(rnti)->stream_id;
 
-  ssize_t n_sent = sctp_sendmsg(mme_socket.fd(),
-                                buf->msg,
-                                buf->N_bytes,
-                                (struct sockaddr*)&mme_addr,
-                                sizeof(struct sockaddr_in),
-                                htonl(PPID),
-                                0,
-                                streamid,
-                                0,
-                                0);
-  if (n_sent == -1) {
+  if (not mme_socket.is_open()) {
     if (rnti != SRSRAN_INVALID_RNTI) {
       logger.error("Error: Failure at Tx S1AP SDU, %s, rnti=0x%x", procedure_name, rnti);
     } else {
@@ -2050,6 +2105,12 @@ bool s1ap::sctp_send_s1ap_pdu(const asn1::s1ap::s1ap_pdu_c& tx_pdu, uint32_t rnt
     }
     return false;
   }
+
+  // The PDUs sent during a stack task are handed to the SCTP Tx thread as one batch once the task completes
+  if (mme_tx.empty()) {
+    task_sched.defer_task([this]() { mme_tx.flush(); });
+  }
+  mme_tx.push(std::move(buf), streamid);
   return true;
 }
 
@@ -2150,7 +2211,7 @@ s1ap::ue::ue(s1ap* s1ap_ptr_) : s1ap_ptr(s1ap_ptr_), ho_prep_proc(this), logger(
   ctxt.enb_ue_s1ap_id = s1ap_ptr->next_enb_ue_s1ap_id++;
   gettimeofday(&ctxt.init_timestamp, nullptr);
 
-  stream_id = s1ap_ptr->next_ue_stream_id;
+  stream_id = srsran::net_utils::sctp_ue_stream_id(ctxt.enb_ue_s1ap_id, s1ap_ptr->nof_mme_streams);
 
   // initialize timers
   ts1_reloc_prep = s1ap_ptr->task_sched.get_unique_timer();
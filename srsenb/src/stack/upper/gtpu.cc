@@ -21,6 +21,7 @@
 
 #include "srsran/upper/gtpu.h"
 #include "srsenb/hdr/stack/upper/gtpu.h"
+#include "srsran/common/int_helpers.h"
 #include "srsran/common/network_utils.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/string_helpers.h"
@@ -60,7 +61,7 @@ const gtpu_tunnel_manager::tunnel* gtpu_tunnel_manager::find_tunnel(uint32_t tei
 gtpu_tunnel_manager::ue_bearer_tunnel_list* gtpu_tunnel_manager::find_rnti_tunnels(uint16_t rnti)
 {
   auto it = ue_teidin_db.find(rnti);
-  return it != ue_teidin_db.end() ? &ue_teidin_db[rnti] : nullptr;
+  return it != ue_teidin_db.end() ? &it->second : nullptr;
 }
 
 srsran::span<gtpu_tunnel_manager::bearer_teid_pair>
@@ -99,9 +100,16 @@ gtpu_tunnel_manager::add_tunnel(uint16_t rnti, uint32_t eps_bearer_id, uint32_t
   tun->teid_out      = teidout;
   tun->spgw_addr     = spgw_addr;
 
-  if (ue_teidin_db.find(rnti) == ue_teidin_db.end()) {
-    auto ret = ue_teidin_db.emplace(rnti, ue_bearer_tunnel_list());
-    if (!ret.second) {
+  tun->tx_header[0]            = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
+  tun->tx_header[1]            = GTPU_MSG_DATA_PDU;
+  tun->tx_addr.sin_family      = AF_INET;
+  tun->tx_addr.sin_addr.s_addr = htonl(spgw_addr);
+  tun->tx_addr.sin_port        = htons(GTPU_PORT);
+  srsran::uint32_to_uint8(teidout, &tun->tx_header[4]);
+  get_counters(tun->teid_in) = {};
+
+  if (not ue_teidin_db.contains(rnti)) {
+    if (not ue_teidin_db.insert(rnti, ue_bearer_tunnel_list())) {
       logger.error("Failed to allocate rnti=0x%x", rnti);
       return nullptr;
     }
@@ -140,7 +148,7 @@ bool gtpu_tunnel_manager::update_rnti(uint16_t old_rnti, uint16_t new_rnti)
   logger.info("Modifying bearer rnti. Old rnti: 0x%x, new rnti: 0x%x", old_rnti, new_rnti);
 
   // create new RNTI and update TEIDs of old rnti to reflect new rnti
-  if (new_rnti_ptr == nullptr and not ue_teidin_db.insert({new_rnti, ue_bearer_tunnel_list()}).second) {
+  if (new_rnti_ptr == nullptr and not ue_teidin_db.insert(new_rnti, ue_bearer_tunnel_list())) {
     logger.error("Failure to create new rnti=0x%x", new_rnti);
     return false;
   }
@@ -188,6 +196,15 @@ bool gtpu_tunnel_manager::remove_tunnel(uint32_t teidin)
 
   logger.info("Removed rnti=0x%x,eps-BearerID=%d tunnel with " TEID_IN_FMT, tun.rnti, tun.eps_bearer_id, teidin);
   tunnels.erase(teidin);
+
+  // The slot is left clean for the next tunnel before calling on_removal, which may remove other tunnels
+  tunnel_ho_ctxt&               ho_ctxt    = get_ho_ctxt(teidin);
+  srsran::move_callback<void()> on_removal = std::move(ho_ctxt.on_removal);
+  ho_ctxt.rx_timer.release();
+  ho_ctxt.buffer.reset();
+  if (not on_removal.is_empty()) {
+    on_removal();
+  }
   return true;
 }
 
@@ -212,7 +229,8 @@ bool gtpu_tunnel_manager::remove_rnti(uint16_t rnti)
 
 void gtpu_tunnel_manager::activate_tunnel(uint32_t teid)
 {
-  tunnel& tun = tunnels[teid];
+  tunnel&         tun     = tunnels[teid];
+  tunnel_ho_ctxt& ho_ctxt = get_ho_ctxt(teid);
   if (tun.state == tunnel_state::pdcp_active) {
     // nothing happens
     return;
@@ -221,18 +239,18 @@ void gtpu_tunnel_manager::activate_tunnel(uint32_t teid)
   logger.info("Activating GTPU tunnel rnti=0x%x, " TEID_IN_FMT ". %d SDUs currently buffered",
               tun.rnti,
               tun.teid_in,
-              tun.buffer->size());
+              ho_ctxt.buffer->size());
   // Forward buffered SDUs to lower layers and delete buffer
   auto lower_sn = [](const std::pair<uint32_t, srsran::unique_byte_buffer_t>& lhs,
                      const std::pair<uint32_t, srsran::unique_byte_buffer_t>& rhs) { return lhs.first < rhs.first; };
-  std::stable_sort(tun.buffer->begin(), tun.buffer->end(), lower_sn);
+  std::stable_sort(ho_ctxt.buffer->begin(), ho_ctxt.buffer->end(), lower_sn);
 
-  for (auto& sdu_pair : *tun.buffer) {
+  for (auto& sdu_pair : *ho_ctxt.buffer) {
     uint32_t pdcp_sn = sdu_pair.first;
     pdcp->write_sdu(
         tun.rnti, tun.eps_bearer_id, std::move(sdu_pair.second), pdcp_sn == undefined_pdcp_sn ? -1 : pdcp_sn);
   }
-  tun.buffer.reset();
+  ho_ctxt.buffer.reset();
   tun.state = tunnel_state::pdcp_active;
 }
 
@@ -244,7 +262,7 @@ void gtpu_tunnel_manager::suspend_tunnel(uint32_t teid)
     return;
   }
   // Create a container for buffering SDUs
-  tun.buffer.emplace();
+  get_ho_ctxt(teid).buffer.emplace();
   tun.state = tunnel_state::buffering;
 }
 
@@ -269,12 +287,12 @@ void gtpu_tunnel_manager::deactivate_tunnel(uint32_t teid)
 
 void gtpu_tunnel_manager::set_tunnel_priority(uint32_t before_teid, uint32_t after_teid)
 {
-  tunnel& before_tun = tunnels[before_teid];
+  tunnel_ho_ctxt& before_ho_ctxt = get_ho_ctxt(before_teid);
 
   // GTPU should not forward SDUs from main tunnel until the SeNB-TeNB tunnel has been flushed
   suspend_tunnel(after_teid);
 
-  before_tun.on_removal = [this, after_teid]() {
+  before_ho_ctxt.on_removal = [this, after_teid]() {
     if (tunnels.contains(after_teid)) {
       // In Handover, TeNB switches paths, and flushes PDUs that have been buffered
       activate_tunnel(after_teid);
@@ -286,43 +304,46 @@ void gtpu_tunnel_manager::set_tunnel_priority(uint32_t before_teid, uint32_t aft
   //             resource. However, the release of the data forwarding resource is implementation dependent and could
   //             also be based on other mechanisms (e.g. timer-based mechanism).
   if (gtpu_args->indirect_tunnel_timeout_msec > 0) {
-    before_tun.rx_timer = task_sched.get_unique_timer();
-    before_tun.rx_timer.set(gtpu_args->indirect_tunnel_timeout_msec, [this, before_teid](uint32_t tid) {
+    before_ho_ctxt.rx_timer = task_sched.get_unique_timer();
+    before_ho_ctxt.rx_timer.set(gtpu_args->indirect_tunnel_timeout_msec, [this, before_teid](uint32_t tid) {
       // Note: This will self-destruct the callback object
       logger.info("Forwarding tunnel " TEID_IN_FMT "being closed after timeout=%d msec",
                   before_teid,
                   gtpu_args->indirect_tunnel_timeout_msec);
       remove_tunnel(before_teid);
     });
-    before_tun.rx_timer.run();
+    before_ho_ctxt.rx_timer.run();
   }
 }
 
 void gtpu_tunnel_manager::handle_rx_pdcp_sdu(uint32_t teid)
 {
-  tunnel& rx_tun = tunnels[teid];
+  tunnel_ho_ctxt& rx_ho_ctxt = get_ho_ctxt(teid);
 
   // Reset Rx timer when a PDCP SDU is received
-  if (rx_tun.rx_timer.is_valid() and rx_tun.rx_timer.is_running()) {
-    rx_tun.rx_timer.run();
+  if (rx_ho_ctxt.rx_timer.is_valid() and rx_ho_ctxt.rx_timer.is_running()) {
+    rx_ho_ctxt.rx_timer.run();
   }
 }
 
 void gtpu_tunnel_manager::buffer_pdcp_sdu(uint32_t teid, uint32_t pdcp_sn, srsran::unique_byte_buffer_t sdu)
 {
-  tunnel& rx_tun = tunnels[teid];
+  tunnel&         rx_tun     = tunnels[teid];
+  tunnel_ho_ctxt& rx_ho_ctxt = get_ho_ctxt(teid);
 
   srsran_assert(rx_tun.state == tunnel_state::buffering, "Buffering of PDCP SDUs only enabled when PDCP is not active");
-  if (not rx_tun.buffer->full()) {
-    rx_tun.buffer->push_back(std::make_pair(pdcp_sn, std::move(sdu)));
+  if (not rx_ho_ctxt.buffer->full()) {
+    rx_ho_ctxt.buffer->push_back(std::make_pair(pdcp_sn, std::move(sdu)));
+    get_counters(teid).buffered_pkts++;
   } else {
+    get_counters(teid).dropped_pkts++;
     fmt::memory_buffer str_buffer;
     if (pdcp_sn != undefined_pdcp_sn) {
       fmt::format_to(str_buffer, " PDCP SN={}", pdcp_sn);
     }
     logger.warning("GTPU tunnel " TEID_IN_FMT " internal buffer of size=%zd is full. Discarding SDU%s.",
                    teid,
-                   rx_tun.buffer->size(),
+                   rx_ho_ctxt.buffer->size(),
                    to_c_str(str_buffer));
   }
 }
@@ -337,7 +358,7 @@ void gtpu_tunnel_manager::setup_forwarding(uint32_t rx_teid, uint32_t tx_teid)
   tx_tun.state      = tunnel_state::forwarded_from;
 
   // Auto-removes indirect tunnel when the main tunnel is removed
-  rx_tun.on_removal = [this, tx_teid]() {
+  get_ho_ctxt(rx_teid).on_removal = [this, tx_teid]() {
     if (tunnels.contains(tx_teid)) {
       remove_tunnel(tx_teid);
     }
@@ -354,6 +375,27 @@ void gtpu_tunnel_manager::setup_forwarding(uint32_t rx_teid, uint32_t tx_teid)
               srsran::to_c_str(addrbuf));
 }
 
+void gtpu_tunnel_manager::get_metrics(gtpu_metrics_t& m)
+{
+  m.tunnels.clear();
+  m.tunnels.reserve(tunnels.size());
+  for (auto& tun_pair : tunnels) {
+    const tunnel&          tun = tun_pair.second;
+    const tunnel_counters& c   = get_counters(tun.teid_in);
+    m.tunnels.push_back(gtpu_tunnel_metrics_t{tun.rnti,
+                                              tun.eps_bearer_id,
+                                              tun.teid_in,
+                                              tun.teid_out,
+                                              c.dl_bytes,
+                                              c.dl_pkts,
+                                              c.ul_bytes,
+                                              c.ul_pkts,
+                                              c.dropped_pkts,
+                                              c.fwd_pkts,
+                                              c.buffered_pkts});
+  }
+}
+
 /********************
  *    GTPU class
  *******************/
@@ -365,7 +407,8 @@ gtpu::gtpu(srsran::task_sched_handle   task_sched_,
   task_sched(task_sched_),
   logger(logger),
   tunnels(task_sched_, logger),
-  rx_socket_handler(rx_socket_handler_)
+  rx_socket_handler(rx_socket_handler_),
+  tx_batch(logger)
 {
   gtpu_queue = task_sched.make_task_queue();
 }
@@ -411,11 +454,11 @@ int gtpu::init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_)
     return SRSRAN_ERROR;
   }
 
-  // Assign a handler to rx S1U packets
-  auto rx_callback = [this](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
-    handle_gtpu_s1u_rx_packet(std::move(pdu), from);
-  };
-  rx_socket_handler->add_socket_handler(fd, srsran::make_sdu_handler(logger, gtpu_queue, rx_callback));
+  tx_batch.set_fd(fd);
+
+  // Assign a handler to rx S1U packets, which are read in batches
+  auto rx_callback = [this](srsran::datagram_batch& batch) { handle_gtpu_s1u_rx_batch(batch); };
+  rx_socket_handler->add_socket_handler(fd, srsran::make_batch_sdu_handler(logger, gtpu_queue, rx_callback));
 
   // Start MCH socket if enabled
   if (args.embms_enable) {
@@ -428,6 +471,7 @@ int gtpu::init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_)
 
 void gtpu::stop()
 {
+  tx_batch.flush();
   if (fd > 0) {
     close(fd);
     fd = -1;
@@ -449,41 +493,60 @@ void gtpu::write_pdu(uint16_t rnti, uint32_t eps_bearer_id, srsran::unique_byte_
 
 void gtpu::send_pdu_to_tunnel(const gtpu_tunnel& tx_tun, srsran::unique_byte_buffer_t pdu, int pdcp_sn)
 {
+  gtpu_tunnel_manager::tunnel_counters& counters = tunnels.get_counters(tx_tun.teid_in);
+
   // Check valid IP version
   struct iphdr* ip_pkt = (struct iphdr*)pdu->msg;
   if (ip_pkt->version != 4 && ip_pkt->version != 6) {
     logger.error("Invalid IP version to SPGW");
+    counters.dropped_pkts++;
     return;
   }
-
-  gtpu_header_t header;
-  header.flags        = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
-  header.message_type = GTPU_MSG_DATA_PDU;
-  header.length       = pdu->N_bytes;
-  header.teid         = tx_tun.teid_out;
+  counters.ul_pkts++;
+  counters.ul_bytes += pdu->N_bytes;
 
   if (pdcp_sn >= 0) {
-    header.flags |= GTPU_FLAGS_EXTENDED_HDR;
+    gtpu_header_t header;
+    header.flags             = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL | GTPU_FLAGS_EXTENDED_HDR;
+    header.message_type      = GTPU_MSG_DATA_PDU;
+    header.length            = pdu->N_bytes;
+    header.teid              = tx_tun.teid_out;
     header.next_ext_hdr_type = GTPU_EXT_HEADER_PDCP_PDU_NUMBER;
     header.ext_buffer.resize(4u);
     header.ext_buffer[0] = 0x01u;
     header.ext_buffer[1] = (pdcp_sn >> 8u) & 0xffu;
     header.ext_buffer[2] = pdcp_sn & 0xffu;
     header.ext_buffer[3] = 0;
+    if (!gtpu_write_header(&header, pdu.get(), logger)) {
+      logger.error("Error writing GTP-U Header. Flags 0x%x, Message Type 0x%x", header.flags, header.message_type);
+      counters.dropped_pkts++;
+      return;
+    }
+  } else {
+    // Only the length field of the precomputed header depends on the PDU
+    if (pdu->get_headroom() < GTPU_BASE_HEADER_LEN) {
+      logger.error("Error writing GTP-U Header. No room in PDU for header");
+      counters.dropped_pkts++;
+      return;
+    }
+    uint16_t length = pdu->N_bytes;
+    pdu->msg -= GTPU_BASE_HEADER_LEN;
+    pdu->N_bytes += GTPU_BASE_HEADER_LEN;
+    memcpy(pdu->msg, tx_tun.tx_header.data(), GTPU_BASE_HEADER_LEN);
+    srsran::uint16_to_uint8(length, &pdu->msg[2]);
   }
 
-  struct sockaddr_in servaddr;
-  servaddr.sin_family      = AF_INET;
-  servaddr.sin_addr.s_addr = htonl(tx_tun.spgw_addr);
-  servaddr.sin_port        = htons(GTPU_PORT);
+  tx_batch.push(std::move(pdu), tx_tun.tx_addr);
+}
 
-  if (!gtpu_write_header(&header, pdu.get(), logger)) {
-    logger.error("Error writing GTP-U Header. Flags 0x%x, Message Type 0x%x", header.flags, header.message_type);
-    return;
-  }
-  if (sendto(fd, pdu->msg, pdu->N_bytes, MSG_EOR, (struct sockaddr*)&servaddr, sizeof(struct sockaddr_in)) < 0) {
-    perror("sendto");
-  }
+void gtpu::tic()
+{
+  tx_batch.flush();
+}
+
+void gtpu::get_metrics(gtpu_metrics_t& m)
+{
+  tunnels.get_metrics(m);
 }
 
 srsran::expected<uint32_t> gtpu::add_bearer(uint16_t            rnti,
@@ -624,6 +687,11 @@ void gtpu::handle_gtpu_s1u_rx_packet(srsran::unique_byte_buffer_t pdu, const soc
     return;
   }
 
+  if (header.message_type != GTPU_MSG_DATA_PDU) {
+    // Keep the order of the G-PDUs buffered so far with respect to the other messages
+    flush_rx_burst();
+  }
+
   if (header.message_type == GTPU_MSG_ECHO_REQUEST) {
     // Echo request - send response
     echo_response(addr.sin_addr.s_addr, addr.sin_port, header.seq_number);
@@ -649,6 +717,10 @@ void gtpu::handle_gtpu_s1u_rx_packet(srsran::unique_byte_buffer_t pdu, const soc
   switch (header.message_type) {
     case GTPU_MSG_DATA_PDU: {
       handle_msg_data_pdu(header, *tun_ptr, std::move(pdu));
+      if (not rx_batch_active) {
+        // SDUs forwarded during handover are sent right away, instead of waiting for the stack tick
+        tx_batch.flush();
+      }
     } break;
     case GTPU_MSG_END_MARKER:
       handle_end_marker(*tun_ptr);
@@ -659,13 +731,37 @@ void gtpu::handle_gtpu_s1u_rx_packet(srsran::unique_byte_buffer_t pdu, const soc
   }
 }
 
+void gtpu::handle_gtpu_s1u_rx_batch(srsran::datagram_batch& batch)
+{
+  rx_batch_active = true;
+  for (size_t i = 0; i < batch.pdus.size(); ++i) {
+    handle_gtpu_s1u_rx_packet(std::move(batch.pdus[i]), batch.addrs[i]);
+  }
+  flush_rx_burst();
+  tx_batch.flush();
+  rx_batch_active = false;
+}
+
+void gtpu::flush_rx_burst()
+{
+  if (not rx_burst.empty()) {
+    pdcp->write_sdus(rx_burst_rnti, rx_burst_eps_bearer_id, rx_burst);
+    rx_burst.clear();
+  }
+}
+
 void gtpu::handle_msg_data_pdu(const gtpu_header_t&         header,
                                const gtpu_tunnel&           rx_tunnel,
                                srsran::unique_byte_buffer_t pdu)
 {
+  gtpu_tunnel_manager::tunnel_counters& counters = tunnels.get_counters(rx_tunnel.teid_in);
+  counters.dl_pkts++;
+  counters.dl_bytes += pdu->N_bytes;
+
   struct iphdr* ip_pkt = (struct iphdr*)pdu->msg;
   if (ip_pkt->version != 4 && ip_pkt->version != 6) {
     logger.error("Received SDU with invalid IP version=%d", (int)ip_pkt->version);
+    counters.dropped_pkts++;
     return;
   }
 
@@ -685,6 +781,7 @@ void gtpu::handle_msg_data_pdu(const gtpu_header_t&         header,
   switch (rx_tunnel.state) {
     case gtpu_tunnel_manager::tunnel_state::forward_to: {
       // Forward SDU to direct/indirect tunnel during Handover
+      counters.fwd_pkts++;
       send_pdu_to_tunnel(*rx_tunnel.fwd_tunnel, std::move(pdu));
       break;
     }
@@ -693,12 +790,24 @@ void gtpu::handle_msg_data_pdu(const gtpu_header_t&         header,
       break;
     }
     case gtpu_tunnel_manager::tunnel_state::pdcp_active: {
+      if (rx_batch_active and pdcp_sn == undefined_pdcp_sn) {
+        // Consecutive G-PDUs of a bearer in a batch are written to PDCP in one go
+        if (rx_burst.full() or rnti != rx_burst_rnti or eps_bearer_id != rx_burst_eps_bearer_id) {
+          flush_rx_burst();
+          rx_burst_rnti          = rnti;
+          rx_burst_eps_bearer_id = eps_bearer_id;
+        }
+        rx_burst.push_back(std::move(pdu));
+        break;
+      }
+      flush_rx_burst();
       pdcp->write_sdu(rnti, eps_bearer_id, std::move(pdu), pdcp_sn == undefined_pdcp_sn ? -1 : (int)pdcp_sn);
       break;
     }
     case gtpu_tunnel_manager::tunnel_state::forwarded_from:
     default:
       logger.error(TEID_IN_FMT " found in invalid state", rx_tunnel.teid_in);
+      counters.dropped_pkts++;
       break;
   }
 }
@@ -721,12 +830,13 @@ int gtpu::create_dl_fwd_tunnel(uint32_t rx_teid_in, uint32_t tx_teid_in)
   tunnels.setup_forwarding(rx_teid_in, tx_teid_in);
 
   // Get all buffered PDCP PDUs, and forward them through tx tunnel
-  std::map<uint32_t, srsran::unique_byte_buffer_t> pdus = pdcp->get_buffered_pdus(rx_tun->rnti, rx_tun->eps_bearer_id);
+  srsran::pdcp_sdu_list_t pdus = pdcp->get_buffered_pdus(rx_tun->rnti, rx_tun->eps_bearer_id);
   for (auto& pdu_pair : pdus) {
     uint32_t pdcp_sn = pdu_pair.first;
     log_message(*tx_tun, false, srsran::make_span(pdu_pair.second), pdcp_sn);
     send_pdu_to_tunnel(*tx_tun, std::move(pdu_pair.second), pdcp_sn);
   }
+  tx_batch.flush();
 
   return SRSRAN_SUCCESS;
 }
@@ -825,6 +935,9 @@ bool gtpu::send_end_marker(uint32_t teidin)
 
   gtpu_write_header(&header, pdu.get(), logger);
 
+  // The End Marker must follow the G-PDUs still pending in the tunnel
+  tx_batch.flush();
+
   struct sockaddr_in servaddr = {};
   servaddr.sin_family         = AF_INET;
   servaddr.sin_addr.s_addr    = htonl(tx_tun->spgw_addr);
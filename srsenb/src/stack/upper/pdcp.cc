@@ -24,6 +24,7 @@
 #include "srsran/interfaces/enb_gtpu_interfaces.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
 #include "srsran/interfaces/enb_rrc_interface_pdcp.h"
+#include <future>
 
 namespace srsenb {
 
@@ -31,34 +32,134 @@ pdcp::pdcp(srsran::task_sched_handle task_sched_, srslog::basic_logger& logger_)
   task_sched(task_sched_), logger(logger_)
 {}
 
-void pdcp::init(rlc_interface_pdcp* rlc_, rrc_interface_pdcp* rrc_, gtpu_interface_pdcp* gtpu_)
-{
-  rlc  = rlc_;
-  rrc  = rrc_;
-  gtpu = gtpu_;
+void pdcp::init(rlc_interface_pdcp*        rlc_,
+                rrc_interface_pdcp*        rrc_,
+                gtpu_interface_pdcp*       gtpu_,
+                uint32_t                   nof_shards_,
+                srsran::task_queue_handle* stack_task_queue_,
+                uint32_t                   nof_crypto_workers_)
+{
+  rlc              = rlc_;
+  rrc              = rrc_;
+  gtpu             = gtpu_;
+  stack_task_queue = stack_task_queue_;
+
+  srsran_assert(nof_shards_ == 0 or stack_task_queue != nullptr, "PDCP shards require a queue to the stack thread");
+  for (uint32_t i = 0; i < nof_shards_; ++i) {
+    shards.emplace_back(new pdcp_shard(i));
+    shards.back()->start_shard();
+  }
+  if (nof_crypto_workers_ > 0) {
+    crypto_workers.reset(new srsran::task_thread_pool(nof_crypto_workers_));
+  }
 }
 
 void pdcp::stop()
 {
-  for (std::map<uint32_t, user_interface>::iterator iter = users.begin(); iter != users.end(); ++iter) {
-    clear_user(&iter->second);
+  for (auto& shard : shards) {
+    shard->stop();
+    for (auto& user : shard->users) {
+      clear_user(&user.second);
+    }
+  }
+  for (auto& user : users) {
+    clear_user(&user.second);
   }
+  // The workers may still be notifying the task schedulers of the shards
+  if (crypto_workers != nullptr) {
+    crypto_workers->stop();
+  }
+  shards.clear();
   users.clear();
 }
 
+void pdcp::tic()
+{
+  for (auto& shard : shards) {
+    pdcp_shard* s = shard.get();
+    if (not s->task_queue.try_push([s]() { s->task_sched.tic(); })) {
+      logger.warning("Failed to push timer tick to PDCP shard");
+    }
+  }
+}
+
+pdcp::user_map_t& pdcp::get_users(uint16_t rnti)
+{
+  return shards.empty() ? users : shards[rnti % shards.size()]->users;
+}
+
+/// Runs the task over the UE in the thread that owns its PDCP entity, in order with the other tasks of the UE
+template <typename F>
+void pdcp::defer_user_task(uint16_t rnti, F&& task)
+{
+  if (shards.empty()) {
+    auto it = users.find(rnti);
+    if (it != users.end()) {
+      task(it->second);
+    }
+    return;
+  }
+  pdcp_shard* shard = shards[rnti % shards.size()].get();
+  shard->task_queue.push([shard, rnti, task = std::forward<F>(task)]() mutable {
+    auto it = shard->users.find(rnti);
+    if (it != shard->users.end()) {
+      task(it->second);
+    }
+  });
+}
+
+/// Runs the task over the UE in the thread that owns its PDCP entity and waits for its result
+template <typename R, typename F>
+R pdcp::run_user_task(uint16_t rnti, F&& task)
+{
+  if (shards.empty()) {
+    auto it = users.find(rnti);
+    return it != users.end() ? task(it->second) : R{};
+  }
+  pdcp_shard* shard = shards[rnti % shards.size()].get();
+  if (not shard->task_queue.active()) {
+    return R{};
+  }
+  std::promise<R> result;
+  std::future<R>  future = result.get_future();
+  shard->task_queue.push([shard, rnti, &task, &result]() {
+    auto it = shard->users.find(rnti);
+    result.set_value(it != shard->users.end() ? task(it->second) : R{});
+  });
+  return future.get();
+}
+
 void pdcp::add_user(uint16_t rnti)
 {
-  if (users.count(rnti) == 0) {
-    unique_rnti_ptr<srsran::pdcp> obj = make_rnti_obj<srsran::pdcp>(rnti, task_sched, logger.id().c_str());
-    obj->init(&users[rnti].rlc_itf, &users[rnti].rrc_itf, &users[rnti].gtpu_itf);
-    users[rnti].rlc_itf.rnti  = rnti;
-    users[rnti].gtpu_itf.rnti = rnti;
-    users[rnti].rrc_itf.rnti  = rnti;
-
-    users[rnti].rrc_itf.rrc   = rrc;
-    users[rnti].rlc_itf.rlc   = rlc;
-    users[rnti].gtpu_itf.gtpu = gtpu;
-    users[rnti].pdcp          = std::move(obj);
+  auto add_task = [this, rnti]() {
+    user_map_t& user_db = get_users(rnti);
+    if (not user_db.contains(rnti)) {
+      if (not user_db.insert(rnti, user_interface{})) {
+        logger.error("Adding rnti=0x%x. The slot of the UE table is in use", rnti);
+        return;
+      }
+      srsran::task_sched_handle ue_task_sched =
+          shards.empty() ? task_sched : srsran::task_sched_handle(&shards[rnti % shards.size()]->task_sched);
+      unique_rnti_ptr<srsran::pdcp> obj = make_rnti_obj<srsran::pdcp>(rnti, ue_task_sched, logger.id().c_str());
+      user_interface&               ue  = user_db[rnti];
+      obj->init(&ue.rlc_itf, &ue.rrc_itf, &ue.gtpu_itf);
+      obj->set_crypto_workers(crypto_workers.get());
+      ue.rlc_itf.rnti  = rnti;
+      ue.gtpu_itf.rnti = rnti;
+      ue.rrc_itf.rnti  = rnti;
+
+      ue.rrc_itf.rrc               = rrc;
+      ue.rrc_itf.stack_task_queue  = stack_task_queue;
+      ue.rlc_itf.rlc               = rlc;
+      ue.gtpu_itf.gtpu             = gtpu;
+      ue.gtpu_itf.stack_task_queue = stack_task_queue;
+      ue.pdcp                      = std::move(obj);
+    }
+  };
+  if (shards.empty()) {
+    add_task();
+  } else {
+    shards[rnti % shards.size()]->task_queue.push(add_task);
   }
 }
 
@@ -71,144 +172,165 @@ void pdcp::clear_user(user_interface* ue)
 
 void pdcp::rem_user(uint16_t rnti)
 {
-  if (users.count(rnti)) {
-    clear_user(&users[rnti]);
-    users.erase(rnti);
+  auto rem_task = [this, rnti]() {
+    user_map_t& user_db = get_users(rnti);
+    if (user_db.contains(rnti)) {
+      clear_user(&user_db[rnti]);
+      user_db.erase(rnti);
+    }
+  };
+  if (shards.empty()) {
+    rem_task();
+  } else {
+    shards[rnti % shards.size()]->task_queue.push(rem_task);
   }
 }
 
 void pdcp::add_bearer(uint16_t rnti, uint32_t lcid, const srsran::pdcp_config_t& cfg)
 {
-  if (users.count(rnti)) {
+  defer_user_task(rnti, [rnti, lcid, cfg](user_interface& ue) {
     if (rnti != SRSRAN_MRNTI) {
-      users[rnti].pdcp->add_bearer(lcid, cfg);
+      ue.pdcp->add_bearer(lcid, cfg);
     } else {
-      users[rnti].pdcp->add_bearer_mrb(lcid, cfg);
+      ue.pdcp->add_bearer_mrb(lcid, cfg);
     }
-  }
+  });
 }
 
 void pdcp::del_bearer(uint16_t rnti, uint32_t lcid)
 {
-  if (users.count(rnti)) {
-    users[rnti].pdcp->del_bearer(lcid);
-  }
+  defer_user_task(rnti, [lcid](user_interface& ue) { ue.pdcp->del_bearer(lcid); });
 }
 
 void pdcp::set_enabled(uint16_t rnti, uint32_t lcid, bool enabled)
 {
-  if (users.count(rnti)) {
-    users[rnti].pdcp->set_enabled(lcid, enabled);
-  }
+  defer_user_task(rnti, [lcid, enabled](user_interface& ue) { ue.pdcp->set_enabled(lcid, enabled); });
 }
 
 void pdcp::reset(uint16_t rnti)
 {
-  if (users.count(rnti)) {
-    users[rnti].pdcp->reset();
-  }
+  defer_user_task(rnti, [](user_interface& ue) { ue.pdcp->reset(); });
 }
 
 void pdcp::config_security(uint16_t rnti, uint32_t lcid, const srsran::as_security_config_t& sec_cfg)
 {
-  if (users.count(rnti)) {
-    users[rnti].pdcp->config_security(lcid, sec_cfg);
-  }
+  defer_user_task(rnti, [lcid, sec_cfg](user_interface& ue) { ue.pdcp->config_security(lcid, sec_cfg); });
 }
 
 void pdcp::enable_integrity(uint16_t rnti, uint32_t lcid)
 {
-  users[rnti].pdcp->enable_integrity(lcid, srsran::DIRECTION_TXRX);
+  defer_user_task(rnti, [lcid](user_interface& ue) { ue.pdcp->enable_integrity(lcid, srsran::DIRECTION_TXRX); });
 }
 
 void pdcp::enable_encryption(uint16_t rnti, uint32_t lcid)
 {
-  users[rnti].pdcp->enable_encryption(lcid, srsran::DIRECTION_TXRX);
+  defer_user_task(rnti, [lcid](user_interface& ue) { ue.pdcp->enable_encryption(lcid, srsran::DIRECTION_TXRX); });
 }
 
 bool pdcp::get_bearer_state(uint16_t rnti, uint32_t lcid, srsran::pdcp_lte_state_t* state)
 {
-  if (users.count(rnti) == 0) {
-    return false;
-  }
-  return users[rnti].pdcp->get_bearer_state(lcid, state);
+  return run_user_task<bool>(rnti,
+                             [lcid, state](user_interface& ue) { return ue.pdcp->get_bearer_state(lcid, state); });
 }
 
 bool pdcp::set_bearer_state(uint16_t rnti, uint32_t lcid, const srsran::pdcp_lte_state_t& state)
 {
-  if (users.count(rnti) == 0) {
-    return false;
-  }
-  return users[rnti].pdcp->set_bearer_state(lcid, state);
+  return run_user_task<bool>(rnti,
+                             [lcid, &state](user_interface& ue) { return ue.pdcp->set_bearer_state(lcid, state); });
 }
 
 void pdcp::reestablish(uint16_t rnti)
 {
-  if (users.count(rnti) == 0) {
-    return;
-  }
-  users[rnti].pdcp->reestablish();
+  defer_user_task(rnti, [](user_interface& ue) { ue.pdcp->reestablish(); });
 }
 
 void pdcp::send_status_report(uint16_t rnti)
 {
-  if (users.count(rnti) == 0) {
-    return;
-  }
-  users[rnti].pdcp->send_status_report();
+  defer_user_task(rnti, [](user_interface& ue) { ue.pdcp->send_status_report(); });
 }
 
 void pdcp::notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
 {
-  if (users.count(rnti)) {
-    users[rnti].pdcp->notify_delivery(lcid, pdcp_sns);
-  }
+  defer_user_task(rnti, [lcid, pdcp_sns](user_interface& ue) { ue.pdcp->notify_delivery(lcid, pdcp_sns); });
 }
 
 void pdcp::notify_failure(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
 {
-  if (users.count(rnti)) {
-    users[rnti].pdcp->notify_failure(lcid, pdcp_sns);
-  }
+  defer_user_task(rnti, [lcid, pdcp_sns](user_interface& ue) { ue.pdcp->notify_failure(lcid, pdcp_sns); });
 }
 
 void pdcp::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn)
 {
-  if (users.count(rnti)) {
+  defer_user_task(rnti, [rnti, lcid, pdcp_sn, sdu = std::move(sdu)](user_interface& ue) mutable {
     if (rnti != SRSRAN_MRNTI) {
       // TODO: Handle PDCP SN coming from GTPU
-      users[rnti].pdcp->write_sdu(lcid, std::move(sdu), pdcp_sn);
+      ue.pdcp->write_sdu(lcid, std::move(sdu), pdcp_sn);
     } else {
-      users[rnti].pdcp->write_sdu_mch(lcid, std::move(sdu));
+      ue.pdcp->write_sdu_mch(lcid, std::move(sdu));
     }
+  });
+}
+
+void pdcp::write_sdus(uint16_t rnti, uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus)
+{
+  if (rnti == SRSRAN_MRNTI) {
+    for (srsran::unique_byte_buffer_t& sdu : sdus) {
+      write_sdu(rnti, lcid, std::move(sdu));
+    }
+    return;
   }
+  // The whole burst is handed over to the UE in a single task
+  std::vector<srsran::unique_byte_buffer_t> burst(std::make_move_iterator(sdus.begin()),
+                                                  std::make_move_iterator(sdus.end()));
+  defer_user_task(rnti, [lcid, burst = std::move(burst)](user_interface& ue) mutable {
+    ue.pdcp->write_sdus(lcid, burst);
+  });
 }
 
 void pdcp::send_status_report(uint16_t rnti, uint32_t lcid)
 {
-  if (users.count(rnti)) {
-    users[rnti].pdcp->send_status_report(lcid);
-  }
+  defer_user_task(rnti, [lcid](user_interface& ue) { ue.pdcp->send_status_report(lcid); });
 }
 
-std::map<uint32_t, srsran::unique_byte_buffer_t> pdcp::get_buffered_pdus(uint16_t rnti, uint32_t lcid)
+srsran::pdcp_sdu_list_t pdcp::get_buffered_pdus(uint16_t rnti, uint32_t lcid)
 {
-  if (users.count(rnti)) {
-    return users[rnti].pdcp->get_buffered_pdus(lcid);
-  }
-  return {};
+  return run_user_task<srsran::pdcp_sdu_list_t>(rnti,
+                                                [lcid](user_interface& ue) { return ue.pdcp->get_buffered_pdus(lcid); });
 }
 
 void pdcp::write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu)
 {
-  if (users.count(rnti)) {
-    users[rnti].pdcp->write_pdu(lcid, std::move(sdu));
-  }
+  defer_user_task(rnti, [lcid, sdu = std::move(sdu)](user_interface& ue) mutable {
+    ue.pdcp->write_pdu(lcid, std::move(sdu));
+  });
+}
+
+void pdcp::write_pdus(uint16_t rnti, uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> pdus)
+{
+  std::vector<srsran::unique_byte_buffer_t> burst(std::make_move_iterator(pdus.begin()),
+                                                  std::make_move_iterator(pdus.end()));
+  defer_user_task(rnti, [lcid, burst = std::move(burst)](user_interface& ue) mutable {
+    ue.pdcp->write_pdus(lcid, burst);
+  });
 }
 
 void pdcp::user_interface_gtpu::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
 {
-  gtpu->write_pdu(rnti, lcid, std::move(pdu));
+  if (stack_task_queue == nullptr) {
+    gtpu->write_pdu(rnti, lcid, std::move(pdu));
+    return;
+  }
+  // GTPU is not thread-safe, so the PDUs of the PDCP shards are handed to the stack thread
+  srsenb::gtpu_interface_pdcp* gtpu_ = gtpu;
+  uint16_t                     rnti_ = rnti;
+
+  auto task = [gtpu_, rnti_, lcid](srsran::unique_byte_buffer_t& pdu) {
+    gtpu_->write_pdu(rnti_, lcid, std::move(pdu));
+  };
+  if (not stack_task_queue->try_push(std::bind(task, std::move(pdu)))) {
+    srslog::fetch_basic_logger("PDCP", false)
+        .warning("Discarding UL PDU of rnti=0x%x, lcid=%d. Cause: Stack task queue is full", rnti, lcid);
+  }
 }
 
 void pdcp::user_interface_rlc::write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu)
@@ -216,6 +338,11 @@ void pdcp::user_interface_rlc::write_sdu(uint32_t lcid, srsran::unique_byte_buff
   rlc->write_sdu(rnti, lcid, std::move(sdu));
 }
 
+void pdcp::user_interface_rlc::write_sdus(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus)
+{
+  rlc->write_sdus(rnti, lcid, sdus);
+}
+
 void pdcp::user_interface_rlc::discard_sdu(uint32_t lcid, uint32_t discard_sn)
 {
   rlc->discard_sdu(rnti, lcid, discard_sn);
@@ -243,7 +370,18 @@ void pdcp::user_interface_rrc::write_pdu(uint32_t lcid, srsran::unique_byte_buff
 
 void pdcp::user_interface_rrc::notify_pdcp_integrity_error(uint32_t lcid)
 {
-  rrc->notify_pdcp_integrity_error(rnti, lcid);
+  if (stack_task_queue == nullptr) {
+    rrc->notify_pdcp_integrity_error(rnti, lcid);
+    return;
+  }
+  srsenb::rrc_interface_pdcp* rrc_  = rrc;
+  uint16_t                    rnti_ = rnti;
+
+  auto task = [rrc_, rnti_, lcid]() { rrc_->notify_pdcp_integrity_error(rnti_, lcid); };
+  if (not stack_task_queue->try_push(std::move(task))) {
+    srslog::fetch_basic_logger("PDCP", false)
+        .warning("Discarding integrity error of rnti=0x%x, lcid=%d. Cause: Stack task queue is full", rnti, lcid);
+  }
 }
 
 void pdcp::user_interface_rrc::write_pdu_bcch_bch(srsran::unique_byte_buffer_t pdu)
@@ -268,11 +406,61 @@ const char* pdcp::user_interface_rrc::get_rb_name(uint32_t lcid)
 
 void pdcp::get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti)
 {
-  m.ues.resize(users.size());
-  size_t count = 0;
-  for (auto& user : users) {
-    user.second.pdcp->get_metrics(m.ues[count], nof_tti);
-    count++;
+  if (shards.empty()) {
+    m.ues.resize(users.size());
+    size_t count = 0;
+    for (auto& user : users) {
+      user.second.pdcp->get_metrics(m.ues[count], nof_tti);
+      count++;
+    }
+    return;
+  }
+
+  // The metrics are reported in the order of the UE table, as in the MAC and RLC metrics
+  rnti_map_t<srsran::pdcp_metrics_t> ue_metrics;
+  for (auto& shard : shards) {
+    pdcp_shard*        s = shard.get();
+    std::promise<void> done;
+    std::future<void>  future = done.get_future();
+    s->task_queue.push([s, nof_tti, &ue_metrics, &done]() {
+      for (auto& user : s->users) {
+        ue_metrics.insert(user.first, srsran::pdcp_metrics_t{});
+        user.second.pdcp->get_metrics(ue_metrics[user.first], nof_tti);
+      }
+      done.set_value();
+    });
+    future.wait();
+  }
+  m.ues.clear();
+  for (auto& ue : ue_metrics) {
+    m.ues.push_back(ue.second);
+  }
+}
+
+pdcp::pdcp_shard::pdcp_shard(uint32_t idx) : thread("PDCP" + std::to_string(idx)), task_sched(512, 128)
+{
+  task_queue = task_sched.make_task_queue();
+}
+
+void pdcp::pdcp_shard::start_shard()
+{
+  running = true;
+  start();
+}
+
+void pdcp::pdcp_shard::stop()
+{
+  if (running) {
+    task_queue.push([this]() { running = false; });
+    wait_thread_finish();
+    task_sched.stop();
+  }
+}
+
+void pdcp::pdcp_shard::run_thread()
+{
+  while (running.load(std::memory_order_relaxed)) {
+    task_sched.run_next_task();
   }
 }
 
@@ -27,15 +27,17 @@
 
 namespace srsenb {
 
-void rlc::init(pdcp_interface_rlc*    pdcp_,
-               rrc_interface_rlc*     rrc_,
-               mac_interface_rlc*     mac_,
-               srsran::timer_handler* timers_)
+void rlc::init(pdcp_interface_rlc*        pdcp_,
+               rrc_interface_rlc*         rrc_,
+               mac_interface_rlc*         mac_,
+               srsran::timer_handler*     timers_,
+               srsran::task_queue_handle* pdcp_task_queue_)
 {
-  pdcp   = pdcp_;
-  rrc    = rrc_;
-  mac    = mac_;
-  timers = timers_;
+  pdcp            = pdcp_;
+  rrc             = rrc_;
+  mac             = mac_;
+  timers          = timers_;
+  pdcp_task_queue = pdcp_task_queue_;
 
   pthread_rwlock_init(&rwlock, nullptr);
 }
@@ -64,20 +66,27 @@ void rlc::get_metrics(rlc_metrics_t& m, const uint32_t nof_tti)
 void rlc::add_user(uint16_t rnti)
 {
   pthread_rwlock_wrlock(&rwlock);
-  if (users.count(rnti) == 0) {
-    auto obj = make_rnti_obj<srsran::rlc>(rnti, logger.id().c_str());
-    obj->init(&users[rnti],
-              &users[rnti],
+  if (not users.contains(rnti)) {
+    if (not users.insert(rnti, user_interface{})) {
+      logger.error("Adding rnti=0x%x. The slot of the UE table is in use", rnti);
+      pthread_rwlock_unlock(&rwlock);
+      return;
+    }
+    user_interface& user = users[rnti];
+    auto            obj  = make_rnti_obj<srsran::rlc>(rnti, logger.id().c_str());
+    obj->set_tx_byte_budget(ue_tx_budget_bytes);
+    obj->init(&user,
+              &user,
               timers,
               srb_to_lcid(lte_srb::srb0),
               [rnti, this](uint32_t lcid, uint32_t tx_queue, uint32_t retx_queue) {
                 update_bsr(rnti, lcid, tx_queue, retx_queue);
               });
-    users[rnti].rnti   = rnti;
-    users[rnti].pdcp   = pdcp;
-    users[rnti].rrc    = rrc;
-    users[rnti].rlc    = std::move(obj);
-    users[rnti].parent = this;
+    user.rnti   = rnti;
+    user.pdcp   = pdcp;
+    user.rrc    = rrc;
+    user.rlc    = std::move(obj);
+    user.parent = this;
   }
   pthread_rwlock_unlock(&rwlock);
 }
@@ -85,7 +94,7 @@ void rlc::add_user(uint16_t rnti)
 void rlc::rem_user(uint16_t rnti)
 {
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->stop();
   } else {
     logger.error("Removing rnti=0x%x. Already removed", rnti);
@@ -100,7 +109,7 @@ void rlc::rem_user(uint16_t rnti)
 void rlc::clear_buffer(uint16_t rnti)
 {
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->empty_queue();
     for (int i = 0; i < SRSRAN_N_RADIO_BEARERS; i++) {
       if (users[rnti].rlc->has_bearer(i)) {
@@ -115,7 +124,7 @@ void rlc::clear_buffer(uint16_t rnti)
 void rlc::add_bearer(uint16_t rnti, uint32_t lcid, const srsran::rlc_config_t& cnfg)
 {
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->add_bearer(lcid, cnfg);
   }
   pthread_rwlock_unlock(&rwlock);
@@ -124,7 +133,7 @@ void rlc::add_bearer(uint16_t rnti, uint32_t lcid, const srsran::rlc_config_t& c
 void rlc::add_bearer_mrb(uint16_t rnti, uint32_t lcid)
 {
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->add_bearer_mrb(lcid);
   }
   pthread_rwlock_unlock(&rwlock);
@@ -134,7 +143,7 @@ bool rlc::has_bearer(uint16_t rnti, uint32_t lcid)
 {
   pthread_rwlock_rdlock(&rwlock);
   bool result = false;
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     result = users[rnti].rlc->has_bearer(lcid);
   }
   pthread_rwlock_unlock(&rwlock);
@@ -144,7 +153,7 @@ bool rlc::has_bearer(uint16_t rnti, uint32_t lcid)
 void rlc::del_bearer(uint16_t rnti, uint32_t lcid)
 {
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->del_bearer(lcid);
   }
   pthread_rwlock_unlock(&rwlock);
@@ -154,7 +163,7 @@ bool rlc::suspend_bearer(uint16_t rnti, uint32_t lcid)
 {
   pthread_rwlock_rdlock(&rwlock);
   bool result = false;
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->suspend_bearer(lcid);
     result = true;
   }
@@ -166,7 +175,7 @@ bool rlc::is_suspended(uint16_t rnti, uint32_t lcid)
 {
   pthread_rwlock_rdlock(&rwlock);
   bool result = false;
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     result = users[rnti].rlc->is_suspended(lcid);
   }
   pthread_rwlock_unlock(&rwlock);
@@ -177,7 +186,7 @@ bool rlc::resume_bearer(uint16_t rnti, uint32_t lcid)
 {
   pthread_rwlock_rdlock(&rwlock);
   bool result = false;
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->resume_bearer(lcid);
     result = true;
   }
@@ -188,7 +197,7 @@ bool rlc::resume_bearer(uint16_t rnti, uint32_t lcid)
 void rlc::reestablish(uint16_t rnti)
 {
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->reestablish();
   }
   pthread_rwlock_unlock(&rwlock);
@@ -207,7 +216,7 @@ int rlc::read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_b
   int ret;
 
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     if (rnti != SRSRAN_MRNTI) {
       ret = users[rnti].rlc->read_pdu(lcid, payload, nof_bytes);
     } else {
@@ -223,7 +232,7 @@ int rlc::read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_b
 void rlc::write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->write_pdu(lcid, payload, nof_bytes);
   }
   pthread_rwlock_unlock(&rwlock);
@@ -232,7 +241,7 @@ void rlc::write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof
 void rlc::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu)
 {
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     if (rnti != SRSRAN_MRNTI) {
       users[rnti].rlc->write_sdu(lcid, std::move(sdu));
     } else {
@@ -242,10 +251,25 @@ void rlc::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t s
   pthread_rwlock_unlock(&rwlock);
 }
 
+void rlc::write_sdus(uint16_t rnti, uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus)
+{
+  pthread_rwlock_rdlock(&rwlock);
+  if (users.contains(rnti)) {
+    if (rnti != SRSRAN_MRNTI) {
+      users[rnti].rlc->write_sdus(lcid, sdus);
+    } else {
+      for (srsran::unique_byte_buffer_t& sdu : sdus) {
+        users[rnti].rlc->write_sdu_mch(lcid, std::move(sdu));
+      }
+    }
+  }
+  pthread_rwlock_unlock(&rwlock);
+}
+
 void rlc::discard_sdu(uint16_t rnti, uint32_t lcid, uint32_t discard_sn)
 {
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->discard_sdu(lcid, discard_sn);
   }
   pthread_rwlock_unlock(&rwlock);
@@ -255,7 +279,7 @@ bool rlc::rb_is_um(uint16_t rnti, uint32_t lcid)
 {
   bool ret = false;
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     ret = users[rnti].rlc->rb_is_um(lcid);
   }
   pthread_rwlock_unlock(&rwlock);
@@ -266,7 +290,7 @@ bool rlc::sdu_queue_is_full(uint16_t rnti, uint32_t lcid)
 {
   bool ret = false;
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     ret = users[rnti].rlc->sdu_queue_is_full(lcid);
   }
   pthread_rwlock_unlock(&rwlock);
@@ -287,6 +311,16 @@ void rlc::user_interface::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t
 {
   if (lcid == srb_to_lcid(lte_srb::srb0)) {
     rrc->write_pdu(rnti, lcid, std::move(sdu));
+  } else if (parent->pdcp_task_queue != nullptr) {
+    srsenb::pdcp_interface_rlc* pdcp_ = pdcp;
+    uint16_t                    rnti_ = rnti;
+
+    auto task = [pdcp_, rnti_, lcid](srsran::unique_byte_buffer_t& sdu) {
+      pdcp_->write_pdu(rnti_, lcid, std::move(sdu));
+    };
+    if (not parent->pdcp_task_queue->try_push(std::bind(task, std::move(sdu)))) {
+      parent->logger.warning("Discarding UL SDU of rnti=0x%x, lcid=%d. Cause: PDCP task queue is full", rnti, lcid);
+    }
   } else {
     pdcp->write_pdu(rnti, lcid, std::move(sdu));
   }
@@ -294,12 +328,36 @@ void rlc::user_interface::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t
 
 void rlc::user_interface::notify_delivery(uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
 {
-  pdcp->notify_delivery(rnti, lcid, pdcp_sns);
+  if (parent->pdcp_task_queue != nullptr) {
+    srsenb::pdcp_interface_rlc* pdcp_ = pdcp;
+    uint16_t                    rnti_ = rnti;
+
+    auto task = [pdcp_, rnti_, lcid, pdcp_sns]() { pdcp_->notify_delivery(rnti_, lcid, pdcp_sns); };
+    if (not parent->pdcp_task_queue->try_push(std::move(task))) {
+      parent->logger.warning("Discarding delivery notification of rnti=0x%x, lcid=%d. Cause: PDCP task queue is full",
+                             rnti,
+                             lcid);
+    }
+  } else {
+    pdcp->notify_delivery(rnti, lcid, pdcp_sns);
+  }
 }
 
 void rlc::user_interface::notify_failure(uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
 {
-  pdcp->notify_failure(rnti, lcid, pdcp_sns);
+  if (parent->pdcp_task_queue != nullptr) {
+    srsenb::pdcp_interface_rlc* pdcp_ = pdcp;
+    uint16_t                    rnti_ = rnti;
+
+    auto task = [pdcp_, rnti_, lcid, pdcp_sns]() { pdcp_->notify_failure(rnti_, lcid, pdcp_sns); };
+    if (not parent->pdcp_task_queue->try_push(std::move(task))) {
+      parent->logger.warning("Discarding failure notification of rnti=0x%x, lcid=%d. Cause: PDCP task queue is full",
+                             rnti,
+                             lcid);
+    }
+  } else {
+    pdcp->notify_failure(rnti, lcid, pdcp_sns);
+  }
 }
 
 void rlc::user_interface::write_pdu_bcch_bch(srsran::unique_byte_buffer_t sdu)
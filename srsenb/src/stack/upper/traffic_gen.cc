@@ -0,0 +1,291 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsenb/hdr/stack/upper/traffic_gen.h"
+#include "srsran/common/int_helpers.h"
+#include "srsran/common/string_helpers.h"
+#include <algorithm>
+#include <cinttypes>
+
+namespace srsenb {
+
+const char* to_string(traffic_gen::profile_t profile)
+{
+  switch (profile) {
+    case traffic_gen::profile_t::cbr:
+      return "cbr";
+    case traffic_gen::profile_t::burst:
+      return "burst";
+    case traffic_gen::profile_t::sawtooth:
+      return "sawtooth";
+    default:
+      break;
+  }
+  return "none";
+}
+
+static traffic_gen::profile_t profile_from_string(const std::string& str)
+{
+  for (auto profile : {traffic_gen::profile_t::cbr, traffic_gen::profile_t::burst, traffic_gen::profile_t::sawtooth}) {
+    if (str == to_string(profile)) {
+      return profile;
+    }
+  }
+  return traffic_gen::profile_t::none;
+}
+
+traffic_gen::traffic_gen(srslog::basic_logger& logger_, enb_bearer_manager& bearers_) :
+  logger(logger_), bearers(bearers_)
+{}
+
+int traffic_gen::init(const traffic_gen_args_t& args_, pdcp_interface_gtpu* pdcp_)
+{
+  args = args_;
+  pdcp = pdcp_;
+
+  // Room for the IPv4 and UDP headers and the sequence number of the flow
+  if (args.sdu_size < 32 or args.sdu_size > 1500) {
+    logger.error("Traffic generator: the SDU size must be between 32 and 1500 bytes, got %d", args.sdu_size);
+    return SRSRAN_ERROR;
+  }
+  if (args.burst_period_ms == 0 or args.burst_on_ms == 0 or args.burst_on_ms > args.burst_period_ms) {
+    logger.error("Traffic generator: invalid burst of %d ms every %d ms", args.burst_on_ms, args.burst_period_ms);
+    return SRSRAN_ERROR;
+  }
+  if (args.sawtooth_period_ms == 0) {
+    logger.error("Traffic generator: the sawtooth period must be larger than 0 ms");
+    return SRSRAN_ERROR;
+  }
+
+  std::string flows_str = args.dl_flows;
+  flows_str.erase(std::remove(flows_str.begin(), flows_str.end(), ' '), flows_str.end());
+  std::vector<std::string> flow_strs;
+  srsran::string_parse_list(flows_str, ',', flow_strs);
+  for (const std::string& flow_str : flow_strs) {
+    std::vector<std::string> fields = srsran::split_string(flow_str, ':');
+    if (fields.size() != 3) {
+      logger.error("Traffic generator: invalid flow \"%s\", expected eps_bearer_id:profile:rate_kbps",
+                   flow_str.c_str());
+      return SRSRAN_ERROR;
+    }
+    flow_cfg_t cfg;
+    cfg.eps_bearer_id = srsran::string_cast<uint32_t>(fields[0]);
+    cfg.profile       = profile_from_string(fields[1]);
+    cfg.rate_kbps     = srsran::string_cast<uint32_t>(fields[2]);
+    if (cfg.eps_bearer_id < 5 or cfg.eps_bearer_id > 15 or cfg.profile == profile_t::none or cfg.rate_kbps == 0) {
+      logger.error("Traffic generator: invalid flow \"%s\"", flow_str.c_str());
+      return SRSRAN_ERROR;
+    }
+    flow_cfgs.push_back(cfg);
+    logger.info("Traffic generator: %s flow of %d kbps for eps-BearerID=%d",
+                to_string(cfg.profile),
+                cfg.rate_kbps,
+                cfg.eps_bearer_id);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+uint64_t
+traffic_gen::profile_bits(profile_t profile, uint64_t rate_kbps, uint64_t t_ms, uint64_t period_ms, uint64_t on_ms)
+{
+  // A rate of rate_kbps sends rate_kbps bits per ms
+  uint64_t n_periods = t_ms / period_ms;
+  uint64_t t_period  = t_ms % period_ms;
+  switch (profile) {
+    case profile_t::cbr:
+      return rate_kbps * t_ms;
+    case profile_t::burst:
+      return n_periods * rate_kbps * period_ms + rate_kbps * period_ms * std::min(t_period, on_ms) / on_ms;
+    case profile_t::sawtooth:
+      // In the k-th ms of a period of T ms the rate is r/2 + r*k/(2T), so the first t ms of a period send
+      // r*t/2 + r*t*(t-1)/(4T) bits and a whole period r*T*(3T-1)/(4T) bits
+      return (n_periods * rate_kbps * period_ms * (3 * period_ms - 1) +
+              rate_kbps * t_period * (2 * period_ms + t_period - 1)) /
+             (4 * period_ms);
+    default:
+      break;
+  }
+  return 0;
+}
+
+void traffic_gen::tic()
+{
+  // Follow the DRBs established and released by RRC
+  for (auto& flow : flows) {
+    flow.second.active = false;
+  }
+  bearers.for_each_bearer([this](uint16_t rnti, const enb_bearer_manager::radio_bearer_t& rb) {
+    auto it = flows.find(flow_key(rnti, rb.eps_bearer_id));
+    if (it != flows.end()) {
+      it->second.active = true;
+    } else {
+      start_flow(rnti, rb.eps_bearer_id);
+    }
+  });
+
+  for (auto it = flows.begin(); it != flows.end();) {
+    if (not it->second.active) {
+      end_flow(it->second);
+      it = flows.erase(it);
+      continue;
+    }
+    generate(it->second.metrics.rnti, it->second);
+    ++it;
+  }
+}
+
+traffic_gen::flow_t& traffic_gen::start_flow(uint16_t rnti, uint32_t eps_bearer_id)
+{
+  flow_t& flow               = flows[flow_key(rnti, eps_bearer_id)];
+  flow.metrics.rnti          = rnti;
+  flow.metrics.eps_bearer_id = eps_bearer_id;
+  for (const flow_cfg_t& cfg : flow_cfgs) {
+    if (cfg.eps_bearer_id == eps_bearer_id) {
+      flow.cfg = cfg;
+    }
+  }
+  if (flow.cfg.profile == profile_t::none) {
+    logger.info("Traffic generator: starting UL only flow of rnti=0x%x, eps-BearerID=%d", rnti, eps_bearer_id);
+  } else {
+    logger.info("Traffic generator: starting %s flow of %d kbps of rnti=0x%x, eps-BearerID=%d",
+                to_string(flow.cfg.profile),
+                flow.cfg.rate_kbps,
+                rnti,
+                eps_bearer_id);
+  }
+  return flow;
+}
+
+void traffic_gen::end_flow(const flow_t& flow)
+{
+  const traffic_gen_flow_metrics_t& m = flow.metrics;
+  logger.info("Traffic generator: ending flow of rnti=0x%x, eps-BearerID=%d after %" PRIu64
+              " ms. DL: %" PRIu64 " bytes, %" PRIu64 " dropped SDUs. UL: %" PRIu64 " bytes",
+              m.rnti,
+              m.eps_bearer_id,
+              flow.t_ms,
+              m.dl_bytes,
+              m.dl_dropped_pkts,
+              m.ul_bytes);
+  ended.dl_bytes += m.dl_bytes;
+  ended.dl_pkts += m.dl_pkts;
+  ended.dl_dropped_pkts += m.dl_dropped_pkts;
+  ended.ul_bytes += m.ul_bytes;
+  ended.ul_pkts += m.ul_pkts;
+}
+
+void traffic_gen::generate(uint16_t rnti, flow_t& flow)
+{
+  flow.t_ms++;
+  if (flow.cfg.profile == profile_t::none) {
+    return;
+  }
+  uint64_t period_ms = flow.cfg.profile == profile_t::burst ? args.burst_period_ms : args.sawtooth_period_ms;
+  uint64_t bits      = profile_bits(flow.cfg.profile, flow.cfg.rate_kbps, flow.t_ms, period_ms, args.burst_on_ms);
+
+  burst.clear();
+  while ((flow.offered_bytes + args.sdu_size) * 8 <= bits) {
+    flow.offered_bytes += args.sdu_size;
+    uint32_t                     seq = flow.seq++;
+    srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    if (sdu == nullptr) {
+      flow.metrics.dl_dropped_pkts++;
+      continue;
+    }
+    fill_sdu(*sdu, seq);
+    flow.metrics.dl_bytes += sdu->N_bytes;
+    flow.metrics.dl_pkts++;
+    burst.push_back(std::move(sdu));
+  }
+  if (not burst.empty()) {
+    pdcp->write_sdus(rnti, flow.cfg.eps_bearer_id, burst);
+  }
+}
+
+void traffic_gen::fill_sdu(srsran::byte_buffer_t& sdu, uint32_t seq) const
+{
+  uint8_t* ptr = sdu.msg;
+  sdu.N_bytes  = args.sdu_size;
+  memset(ptr, 0, args.sdu_size);
+
+  // IPv4 header from 192.0.2.1 (TEST-NET-1) to the broadcast address, so that the UE discards the packets
+  static const uint8_t ip_addrs[8] = {192, 0, 2, 1, 255, 255, 255, 255};
+
+  ptr[0] = 0x45;
+  ptr[2] = (args.sdu_size >> 8u) & 0xffu;
+  ptr[3] = args.sdu_size & 0xffu;
+  ptr[4] = (seq >> 8u) & 0xffu;
+  ptr[5] = seq & 0xffu;
+  ptr[8] = 64;
+  ptr[9] = 17;
+  memcpy(&ptr[12], ip_addrs, sizeof(ip_addrs));
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < 20; i += 2) {
+    sum += (uint32_t)ptr[i] << 8u | ptr[i + 1];
+  }
+  while (sum >> 16u) {
+    sum = (sum & 0xffffu) + (sum >> 16u);
+  }
+  ptr[10] = (~sum >> 8u) & 0xffu;
+  ptr[11] = ~sum & 0xffu;
+
+  // UDP header to the discard port, without checksum
+  uint32_t udp_len = args.sdu_size - 20;
+  ptr[21]          = 9;
+  ptr[23]          = 9;
+  ptr[24]          = (udp_len >> 8u) & 0xffu;
+  ptr[25]          = udp_len & 0xffu;
+
+  // Sequence number of the flow, to count the lost SDUs at the UE
+  srsran::uint32_to_uint8(seq, &ptr[28]);
+}
+
+void traffic_gen::write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu)
+{
+  auto rb = bearers.get_lcid_bearer(rnti, lcid);
+  if (not rb.is_valid()) {
+    logger.warning("Traffic generator: bearer rnti=0x%x, lcid=%d not found", rnti, lcid);
+    return;
+  }
+  auto    it   = flows.find(flow_key(rnti, rb.eps_bearer_id));
+  flow_t& flow = it != flows.end() ? it->second : start_flow(rnti, rb.eps_bearer_id);
+  flow.metrics.ul_bytes += pdu->N_bytes;
+  flow.metrics.ul_pkts++;
+}
+
+void traffic_gen::get_metrics(traffic_gen_metrics_t& m) const
+{
+  m.total = ended;
+  m.flows.clear();
+  for (const auto& flow : flows) {
+    const traffic_gen_flow_metrics_t& f = flow.second.metrics;
+    m.flows.push_back(f);
+    m.total.dl_bytes += f.dl_bytes;
+    m.total.dl_pkts += f.dl_pkts;
+    m.total.dl_dropped_pkts += f.dl_dropped_pkts;
+    m.total.ul_bytes += f.ul_bytes;
+    m.total.ul_pkts += f.ul_pkts;
+  }
+}
+
+} // namespace srsenb
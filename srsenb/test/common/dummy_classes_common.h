@@ -64,7 +64,7 @@ public:
   void reestablish(uint16_t rnti) override {}
   void send_status_report(uint16_t rnti) override {}
   void send_status_report(uint16_t rnti, uint32_t lcid) override {}
-  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) override
+  srsran::pdcp_sdu_list_t get_buffered_pdus(uint16_t rnti, uint32_t lcid) override
   {
     return {};
   }
@@ -20,8 +20,10 @@
  */
 
 #include "srsenb/hdr/metrics_csv.h"
+#include "srsenb/hdr/metrics_prometheus.h"
 #include "srsenb/hdr/metrics_stdout.h"
 #include "srsran/common/metrics_hub.h"
+#include "srsran/common/test_common.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/srsran.h"
 #include <iostream>
@@ -153,6 +155,8 @@ public:
     metrics[3].phy.resize(0); // no PHY metrics for this UE
   }
 
+  const enb_metrics_t& get_first_metrics() const { return metrics[0]; }
+
   bool get_metrics(enb_metrics_t* m)
   {
     // fill dummy values
@@ -193,6 +197,34 @@ void parse_args(int argc, char** argv)
   }
 }
 
+/// Checks the OpenMetrics rendering of the first entry, which has two UEs.
+static int test_prometheus_render(enb_dummy& enb)
+{
+  // Only the first UE gets per UE series.
+  metrics_prometheus metrics_prom(&enb, 1);
+  enb_metrics_t      m = enb.get_first_metrics();
+  m.stack.mac.cc_info.resize(1);
+  m.stack.mac.cc_info[0].pci = 1;
+  m.mem.softbuffer_bytes     = 1000;
+  m.mem.cell_phy_bytes       = {2048};
+  m.mem.ues.resize(m.stack.mac.ues.size());
+  m.mem.ues[0].softbuffer_bytes = 4096;
+
+  fmt::memory_buffer buffer;
+  metrics_prom.render(m, buffer);
+  std::string text = fmt::to_string(buffer);
+
+  TESTASSERT(text.size() > 6 && text.compare(text.size() - 6, 6, "# EOF\n") == 0);
+  TESTASSERT(text.find("srsenb_cell_ues{cell=\"0\",pci=\"1\"} 2\n") != std::string::npos);
+  TESTASSERT(text.find("srsenb_ue_dl_mcs{cell=\"0\",rnti=\"0x46\"} 28.0\n") != std::string::npos);
+  TESTASSERT(text.find("rnti=\"0x0\"") == std::string::npos);
+  TESTASSERT(text.find("srsenb_memory_bytes{subsystem=\"softbuffer\"} 1000\n") != std::string::npos);
+  TESTASSERT(text.find("srsenb_cell_phy_memory_bytes{cell=\"0\"} 2048\n") != std::string::npos);
+  TESTASSERT(text.find("srsenb_ue_softbuffer_bytes{cell=\"0\",rnti=\"0x46\"} 4096.0\n") != std::string::npos);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   float     period = 1.0;
@@ -205,6 +237,8 @@ int main(int argc, char** argv)
 
   parse_args(argc, argv);
 
+  TESTASSERT(test_prometheus_render(enb) == SRSRAN_SUCCESS);
+
   // the default metrics type for stdout output
   metrics_stdout metrics_screen;
   metrics_screen.set_handle(&enb);
@@ -218,6 +252,10 @@ int main(int argc, char** argv)
   metricshub.add_listener(&metrics_screen);
   metricshub.add_listener(&metrics_file);
 
+  // the OpenMetrics renderer, without serving the reports
+  metrics_prometheus metrics_prom(&enb, 1);
+  metricshub.add_listener(&metrics_prom);
+
   // enable printing
   metrics_screen.toggle_print(true);
 
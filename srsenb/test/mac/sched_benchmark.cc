@@ -19,11 +19,13 @@
  *
  */
 
+#include "sched_common_test_suite.h"
 #include "sched_test_common.h"
 #include "srsenb/hdr/stack/mac/sched.h"
 #include "srsran/adt/accumulators.h"
 #include "srsran/common/common_lte.h"
 #include <chrono>
+#include <random>
 
 namespace srsenb {
 
@@ -92,6 +94,8 @@ public:
     srsran::rolling_average<float>  mean_dl_tbs, mean_ul_tbs, avg_dl_mcs, avg_ul_mcs;
     srsran::rolling_average<double> avg_latency;
     std::vector<uint32_t>           latency_samples;
+    std::vector<uint32_t>           tti_latency_samples; ///< Time taken to schedule all the cells of a TTI
+    uint64_t                        dl_data_prbs = 0, ul_data_prbs = 0, nof_cell_prbs = 0;
   };
   throughput_stats total_stats;
 
@@ -101,6 +105,7 @@ public:
     mac_logger.set_context(tti_rx.to_uint());
     new_tti(tti_rx);
 
+    uint64_t tti_latency_ns = 0;
     for (uint32_t cc = 0; cc < get_cell_params().size(); ++cc) {
       std::chrono::time_point<std::chrono::steady_clock> tp = std::chrono::steady_clock::now();
       TESTASSERT(sched_ptr->dl_sched(to_tx_dl(tti_rx).to_uint(), cc, dl_result[cc]) == SRSRAN_SUCCESS);
@@ -109,7 +114,9 @@ public:
       std::chrono::nanoseconds tdur = std::chrono::duration_cast<std::chrono::nanoseconds>(tp2 - tp);
       total_stats.avg_latency.push(tdur.count());
       total_stats.latency_samples.push_back(tdur.count());
+      tti_latency_ns += tdur.count();
     }
+    total_stats.tti_latency_samples.push_back(tti_latency_ns);
 
     sf_output_res_t sf_out{get_cell_params(), tti_rx, ul_result, dl_result};
     update(sf_out);
@@ -143,6 +150,12 @@ public:
         dl_tbs += data.tbs[1];
         dl_mcs = std::max(dl_mcs, data.dci.tb[0].mcs_idx);
       }
+      for (const auto& data : sf_out.dl_cc_result[cc].data) {
+        srsran::bounded_bitset<100, true> prb_mask;
+        if (extract_dl_prbmask(get_cell_params()[cc].cfg.cell, data.dci, prb_mask) == SRSRAN_SUCCESS) {
+          total_stats.dl_data_prbs += prb_mask.count();
+        }
+      }
       total_stats.mean_dl_tbs.push(dl_tbs);
       if (not sf_out.dl_cc_result[cc].data.empty()) {
         total_stats.avg_dl_mcs.push(dl_mcs);
@@ -150,7 +163,11 @@ public:
       for (const auto& pusch : sf_out.ul_cc_result[cc].pusch) {
         ul_tbs += pusch.tbs;
         ul_mcs = std::max(ul_mcs, pusch.dci.tb.mcs_idx);
+        uint32_t L, RBstart, nof_prb = get_cell_params()[cc].nof_prb();
+        srsran_ra_type2_from_riv(pusch.dci.type2_alloc.riv, &L, &RBstart, nof_prb, nof_prb);
+        total_stats.ul_data_prbs += L;
       }
+      total_stats.nof_cell_prbs += get_cell_params()[cc].nof_prb();
       total_stats.mean_ul_tbs.push(ul_tbs);
       if (not sf_out.ul_cc_result[cc].pusch.empty()) {
         total_stats.avg_ul_mcs.push(ul_mcs);
@@ -394,6 +411,199 @@ int run_benchmark()
   return SRSRAN_SUCCESS;
 }
 
+/*****************************************************************
+ *                  Scheduler scale benchmark
+ *****************************************************************/
+
+struct scale_params {
+  uint32_t    nof_cells    = 4;
+  uint32_t    nof_prbs     = 100;
+  uint32_t    nof_ues      = SRSENB_MAX_UES;
+  uint32_t    nof_ttis     = 20000;
+  float       bler         = 0.1;
+  const char* sched_policy = "time_pf";
+};
+
+/// Tester with a mix of full-buffer, bursty and low-rate UEs, random-walk CQI/SNR traces and HARQ NACKs
+class scale_tester : public sched_tester
+{
+public:
+  enum class traffic_type { full_buffer, bursty, low_rate };
+
+  scale_tester(sched*                                          sched_obj_,
+               const sched_interface::sched_args_t&            sched_args,
+               const std::vector<sched_interface::cell_cfg_t>& cell_cfg_list,
+               const scale_params&                             params_) :
+    sched_tester(sched_obj_, sched_args, cell_cfg_list), params(params_)
+  {}
+
+  void set_external_tti_events(const sim_ue_ctxt_t& ue_ctxt, ue_tti_events& pending_events) override
+  {
+    if (not ue_ctxt.conres_rx) {
+      return;
+    }
+    ue_channel& ch = channels[ue_ctxt.rnti];
+    if (not ch.init) {
+      ch.init    = true;
+      ch.traffic = static_cast<traffic_type>(ue_ctxt.rnti % 3);
+      ch.cqi     = std::uniform_int_distribution<int>{2, 15}(rand_gen);
+      ch.snr     = std::uniform_int_distribution<int>{5, 40}(rand_gen);
+    }
+    uint32_t tti = get_tti_rx().to_uint();
+
+    // Traffic model
+    switch (ch.traffic) {
+      case traffic_type::full_buffer:
+        sched_ptr->ul_bsr(ue_ctxt.rnti, 1, 100000);
+        sched_ptr->dl_rlc_buffer_state(ue_ctxt.rnti, 3, 100000, 0);
+        break;
+      case traffic_type::bursty:
+        if (std::bernoulli_distribution{0.02}(rand_gen)) {
+          uint32_t burst = 1500 * std::uniform_int_distribution<uint32_t>{1, 20}(rand_gen);
+          sched_ptr->ul_bsr(ue_ctxt.rnti, 1, burst / 4);
+          sched_ptr->dl_rlc_buffer_state(ue_ctxt.rnti, 3, burst, 0);
+        }
+        break;
+      case traffic_type::low_rate:
+        if ((tti + ue_ctxt.rnti) % 20 == 0) {
+          sched_ptr->ul_bsr(ue_ctxt.rnti, 1, 40);
+          sched_ptr->dl_rlc_buffer_state(ue_ctxt.rnti, 3, 40, 0);
+        }
+        break;
+    }
+
+    // CQI and SNR traces
+    if ((tti + ue_ctxt.rnti) % 5 == 0) {
+      ch.cqi = std::max(1, std::min(15, ch.cqi + std::uniform_int_distribution<int>{-1, 1}(rand_gen)));
+      ch.snr = std::max(0, std::min(40, ch.snr + std::uniform_int_distribution<int>{-2, 2}(rand_gen)));
+      for (auto& cc : pending_events.cc_list) {
+        cc.dl_cqi = ch.cqi;
+        cc.ul_snr = ch.snr;
+      }
+    }
+
+    // HARQ feedback
+    for (auto& cc : pending_events.cc_list) {
+      if (cc.dl_pid >= 0 and std::bernoulli_distribution{params.bler}(rand_gen)) {
+        cc.dl_ack = false;
+      }
+      if (cc.ul_pid >= 0 and std::bernoulli_distribution{params.bler}(rand_gen)) {
+        cc.ul_ack = false;
+      }
+    }
+  }
+
+private:
+  struct ue_channel {
+    bool         init    = false;
+    traffic_type traffic = traffic_type::full_buffer;
+    int          cqi     = 15;
+    int          snr     = 40;
+  };
+
+  const scale_params&            params;
+  std::mt19937                   rand_gen{0};
+  std::map<uint16_t, ue_channel> channels;
+};
+
+struct scale_run_data {
+  uint32_t tti_usec_p50;
+  uint32_t tti_usec_p99;
+  uint32_t tti_usec_max;
+  float    dl_prb_efficiency;
+  float    ul_prb_efficiency;
+};
+
+int run_scale_scenario(const scale_params& params, scale_run_data& result)
+{
+  std::vector<sched_interface::cell_cfg_t> cell_list(params.nof_cells, generate_default_cell_cfg(params.nof_prbs));
+  for (uint32_t cc = 0; cc < params.nof_cells; ++cc) {
+    cell_list[cc].cell.id = cc + 1;
+  }
+  sched_interface::ue_cfg_t     ue_cfg_default = generate_default_ue_cfg();
+  sched_interface::sched_args_t sched_args     = {};
+  sched_args.sched_policy                      = params.sched_policy;
+
+  sched     sched_obj;
+  rrc_dummy rrc{};
+  sched_obj.init(&rrc, sched_args);
+  scale_tester tester(&sched_obj, sched_args, cell_list, params);
+
+  // The UEs are spread across the cells, each one added at a PRACH opportunity of its cell
+  for (uint32_t ue_idx = 0; ue_idx < params.nof_ues; ++ue_idx) {
+    uint16_t rnti                                   = 0x46 + ue_idx;
+    ue_cfg_default.supported_cc_list[0].enb_cc_idx = ue_idx % params.nof_cells;
+    while (not srsran_prach_tti_opportunity_config_fdd(
+        tester.get_cell_params()[ue_cfg_default.supported_cc_list[0].enb_cc_idx].cfg.prach_config,
+        tester.get_tti_rx().to_uint(),
+        -1)) {
+      TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+    }
+    TESTASSERT(tester.add_user(rnti, ue_cfg_default, ue_idx % 64) == SRSRAN_SUCCESS);
+    TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+  }
+
+  // Ignore stats of the first TTIs until all UEs DRB1 are created
+  auto ue_db_ctxt = tester.get_enb_ctxt().ue_db;
+  while (not std::all_of(ue_db_ctxt.begin(), ue_db_ctxt.end(), [](std::pair<uint16_t, const sim_ue_ctxt_t*> p) {
+    return p.second->conres_rx;
+  })) {
+    tester.advance_tti();
+    ue_db_ctxt = tester.get_enb_ctxt().ue_db;
+  }
+
+  // Run benchmark
+  tester.total_stats = {};
+  tester.total_stats.latency_samples.reserve(params.nof_ttis * params.nof_cells);
+  tester.total_stats.tti_latency_samples.reserve(params.nof_ttis);
+  for (uint32_t count = 0; count < params.nof_ttis; ++count) {
+    tester.advance_tti();
+  }
+
+  std::vector<uint32_t>& samples = tester.total_stats.tti_latency_samples;
+  std::sort(samples.begin(), samples.end());
+  result.tti_usec_p50      = samples[samples.size() / 2] / 1000;
+  result.tti_usec_p99      = samples[static_cast<size_t>(samples.size() * 0.99)] / 1000;
+  result.tti_usec_max      = samples.back() / 1000;
+  result.dl_prb_efficiency = tester.total_stats.dl_data_prbs / (float)tester.total_stats.nof_cell_prbs;
+  result.ul_prb_efficiency = tester.total_stats.ul_data_prbs / (float)tester.total_stats.nof_cell_prbs;
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Runs the scale scenario and prints its results as "key=value" pairs. If max_p99_usec > 0, the run fails when the
+/// p99 of the TTI scheduling time exceeds it, so that the benchmark can be used for regression gating
+int run_scale_benchmark(uint32_t max_p99_usec)
+{
+  scale_params   params{};
+  scale_run_data result{};
+
+  fmt::print("Running scale benchmark with {} UEs over {} cells of {} PRBs\n",
+             params.nof_ues,
+             params.nof_cells,
+             params.nof_prbs);
+  TESTASSERT(run_scale_scenario(params, result) == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  fmt::print("sched_benchmark: policy={} nof_cells={} nof_ues={} nof_ttis={} tti_usec_p50={} tti_usec_p99={} "
+             "tti_usec_max={} dl_prb_eff={:.3f} ul_prb_eff={:.3f}\n",
+             params.sched_policy,
+             params.nof_cells,
+             params.nof_ues,
+             params.nof_ttis,
+             result.tti_usec_p50,
+             result.tti_usec_p99,
+             result.tti_usec_max,
+             result.dl_prb_efficiency,
+             result.ul_prb_efficiency);
+
+  if (max_p99_usec > 0 and result.tti_usec_p99 > max_p99_usec) {
+    fmt::print("TTI scheduling time p99 above the limit ({} > {}) usec\n", result.tti_usec_p99, max_p99_usec);
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
 } // namespace srsenb
 
 int main(int argc, char* argv[])
@@ -424,6 +634,9 @@ int main(int argc, char* argv[])
     TESTASSERT(srsenb::run_rate_test() == SRSRAN_SUCCESS);
   } else if (strcmp(argv[1], "benchmark") == 0) {
     TESTASSERT(srsenb::run_benchmark() == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "scale") == 0) {
+    uint32_t max_p99_usec = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 0;
+    TESTASSERT(srsenb::run_scale_benchmark(max_p99_usec) == SRSRAN_SUCCESS);
   } else {
     TESTASSERT(srsenb::run_all() == SRSRAN_SUCCESS);
   }
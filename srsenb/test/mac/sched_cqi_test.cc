@@ -19,6 +19,7 @@
  *
  */
 
+#include "srsenb/hdr/stack/mac/common/link_adaptation.h"
 #include "srsenb/hdr/stack/mac/sched_ue_ctrl/sched_dl_cqi.h"
 #include "srsran/common/test_common.h"
 
@@ -89,6 +90,73 @@ void test_sched_cqi_wideband_cqi()
   }
 }
 
+void test_sched_cqi_subband_aging()
+{
+  // 50 PRBs, K=4, subband reports fade over 100 msec
+  sched_dl_cqi ue_cqi(50, 4, 0, 100);
+
+  ue_cqi.cqi_wb_info(tti_point(0), 5);
+  ue_cqi.cqi_sb_info(tti_point(0), 0, 10);
+
+  // TEST: A new subband report is used as is
+  ue_cqi.new_tti(tti_point(0));
+  TESTASSERT_EQ(10, ue_cqi.get_rbg_cqi(0));
+  TESTASSERT_EQ(5, ue_cqi.get_rbg_cqi(cell_nof_prb_to_rbg(50) - 1));
+
+  // TEST: The subband report is applied relative to the latest wideband report
+  ue_cqi.cqi_wb_info(tti_point(10), 8);
+  ue_cqi.new_tti(tti_point(10));
+  TESTASSERT_EQ(12, ue_cqi.get_rbg_cqi(0));
+
+  // TEST: The difference to the wideband CQI fades with the age of the report
+  ue_cqi.new_tti(tti_point(50));
+  TESTASSERT_EQ(10, ue_cqi.get_rbg_cqi(0));
+  ue_cqi.new_tti(tti_point(100));
+  TESTASSERT_EQ(8, ue_cqi.get_rbg_cqi(0));
+  TESTASSERT_EQ(8, ue_cqi.get_grant_avg_cqi(rbg_interval(0, 1)));
+
+  // TEST: A new report of the bandwidth part is fresh again
+  ue_cqi.cqi_sb_info(tti_point(100), 1, 3);
+  TESTASSERT_EQ(3, ue_cqi.get_subband_cqi(0));
+  TESTASSERT_EQ(3, ue_cqi.get_subband_cqi(1));
+}
+
+void test_olla_controller()
+{
+  // delta_up = 0.1, delta_down = 0.9
+  olla_controller olla(0.1, 0.1, 2);
+  TESTASSERT(olla.enabled());
+
+  // TEST: The offset is stable when the BLER matches the target
+  for (uint32_t i = 0; i < 9; ++i) {
+    olla.harq_feedback(true, 10, 28);
+  }
+  olla.harq_feedback(false, 10, 28);
+  TESTASSERT(std::abs(olla.get_offset()) < 1e-4);
+
+  // TEST: The offset is bounded
+  for (uint32_t i = 0; i < 100; ++i) {
+    olla.harq_feedback(true, 10, 28);
+  }
+  TESTASSERT_EQ(2.0f, olla.get_offset());
+  for (uint32_t i = 0; i < 10; ++i) {
+    olla.harq_feedback(false, 10, 28);
+  }
+  TESTASSERT_EQ(-2.0f, olla.get_offset());
+
+  // TEST: The offset is not pushed beyond the MCS limits
+  olla.reset();
+  olla.harq_feedback(true, 28, 28);
+  olla.harq_feedback(false, 0, 28);
+  TESTASSERT_EQ(0.0f, olla.get_offset());
+
+  // TEST: A zero target BLER disables the adaptation
+  olla_controller disabled(0, 0.1, 2);
+  TESTASSERT(not disabled.enabled());
+  disabled.harq_feedback(false, 10, 28);
+  TESTASSERT_EQ(0.0f, disabled.get_offset());
+}
+
 } // namespace srsenb
 
 int main(int argc, char** argv)
@@ -97,6 +165,8 @@ int main(int argc, char** argv)
 
   srsenb::test_sched_cqi_one_subband_cqi();
   srsenb::test_sched_cqi_wideband_cqi();
+  srsenb::test_sched_cqi_subband_aging();
+  srsenb::test_olla_controller();
 
   return SRSRAN_SUCCESS;
 }
@@ -489,6 +489,21 @@ public:
     notify_ta_info();
     return 0;
   }
+  int meas_info(uint32_t tti, srsran::const_span<ue_meas_t> meas) override
+  {
+    for (const ue_meas_t& m : meas) {
+      if (m.cqi >= 0) {
+        cqi_info(tti, m.rnti, m.cc_idx, m.cqi);
+      }
+      if (not std::isnan(m.snr_db)) {
+        snr_info(tti, m.rnti, m.cc_idx, m.snr_db, m.ch);
+      }
+      if (not std::isnan(m.ta_us)) {
+        ta_info(tti, m.rnti, m.ta_us);
+      }
+    }
+    return SRSRAN_SUCCESS;
+  }
   int ack_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t tb_idx, bool ack) override
   {
     std::lock_guard<std::mutex> lock(phy_mac_mutex);
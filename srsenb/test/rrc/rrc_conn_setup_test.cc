@@ -0,0 +1,124 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/enb.h"
+#include "srsenb/test/rrc/test_helpers.h"
+#include "srsran/common/test_common.h"
+#include <set>
+
+using namespace asn1::rrc;
+
+/// The RRCConnectionSetup written from the pre-encoded message must match the one packed from its content
+int test_conn_setup_template(srsran::log_sink_spy& spy)
+{
+  printf("\n===== TEST: test_conn_setup_template()  =====\n");
+
+  srsran::task_scheduler task_sched;
+  srsenb::all_args_t     args;
+  rrc_cfg_t              cfg;
+  TESTASSERT(test_helpers::parse_default_cfg(&cfg, args) == SRSRAN_SUCCESS);
+
+  spy.reset_counters();
+  auto& logger = srslog::fetch_basic_logger("RRC", false);
+  logger.set_level(srslog::basic_levels::info);
+
+  enb_bearer_manager                bearers;
+  srsenb::rrc                       rrc{&task_sched, bearers};
+  mac_dummy                         mac;
+  test_dummies::rlc_mobility_dummy  rlc;
+  test_dummies::pdcp_mobility_dummy pdcp;
+  phy_dummy                         phy;
+  test_dummies::s1ap_mobility_dummy s1ap;
+  gtpu_dummy                        gtpu;
+  rrc.init(cfg, &phy, &mac, &rlc, &pdcp, &s1ap, &gtpu);
+
+  std::set<uint32_t> sr_resources;
+  for (uint16_t rnti = 0x46; rnti < 0x46 + 8; ++rnti) {
+    sched_interface::ue_cfg_t ue_cfg = {};
+    ue_cfg.supported_cc_list.resize(1);
+    ue_cfg.supported_cc_list[0].active     = true;
+    ue_cfg.supported_cc_list[0].enb_cc_idx = 0;
+    rrc.add_user(rnti, ue_cfg);
+
+    // Send RRCConnectionRequest
+    srsran::unique_byte_buffer_t pdu;
+    uint8_t                      rrc_conn_request[] = {0x40, 0x12, 0xf6, 0xfb, 0xe2, 0xc6};
+    copy_msg_to_buffer(pdu, rrc_conn_request);
+    rrc.write_pdu(rnti, 0, std::move(pdu));
+    task_sched.get_timer_handler()->step_all();
+    rrc.tti_clock();
+
+    // RRCConnectionSetup is sent over SRB0
+    TESTASSERT(rlc.ue_db[rnti].last_lcid == 0);
+    srsran::unique_byte_buffer_t& setup_pdu = rlc.ue_db[rnti].last_sdu;
+    TESTASSERT(setup_pdu != nullptr);
+    dl_ccch_msg_s dl_ccch_msg;
+    TESTASSERT(test_helpers::unpack_asn1(dl_ccch_msg, *setup_pdu));
+    TESTASSERT(dl_ccch_msg.msg.c1().type().value == dl_ccch_msg_type_c::c1_c_::types_opts::rrc_conn_setup);
+
+    uint8_t       buffer[1024];
+    asn1::bit_ref bref(buffer, sizeof(buffer));
+    TESTASSERT(dl_ccch_msg.pack(bref) == asn1::SRSASN_SUCCESS);
+    TESTASSERT((uint32_t)bref.distance_bytes() == setup_pdu->N_bytes);
+    TESTASSERT(memcmp(buffer, setup_pdu->msg, setup_pdu->N_bytes) == 0);
+
+    const auto& setup_r8 = dl_ccch_msg.msg.c1().rrc_conn_setup().crit_exts.c1().rrc_conn_setup_r8();
+    const auto& sr_cfg   = setup_r8.rr_cfg_ded.phys_cfg_ded.sched_request_cfg.setup();
+    sr_resources.insert(sr_cfg.sr_cfg_idx * 2048u + sr_cfg.sr_pucch_res_idx);
+  }
+  // Each UE got its own SR resources written into the message
+  TESTASSERT(sr_resources.size() == 8);
+  TESTASSERT(spy.get_error_counter() == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  // Setup the log spy to intercept error and warning log entries.
+  if (!srslog::install_custom_sink(
+          srsran::log_sink_spy::name(),
+          std::unique_ptr<srsran::log_sink_spy>(new srsran::log_sink_spy(srslog::get_default_log_formatter())))) {
+    return SRSRAN_ERROR;
+  }
+
+  auto* spy = static_cast<srsran::log_sink_spy*>(srslog::find_sink(srsran::log_sink_spy::name()));
+  if (!spy) {
+    return SRSRAN_ERROR;
+  }
+  srslog::set_default_sink(*spy);
+
+  // Start the log backend.
+  srslog::init();
+
+  if (argc < 3) {
+    argparse::usage(argv[0]);
+    return -1;
+  }
+  argparse::parse_args(argc, argv);
+  TESTASSERT(test_conn_setup_template(*spy) == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  printf("\nSuccess\n");
+
+  return SRSRAN_SUCCESS;
+}
@@ -51,7 +51,49 @@ void test_paging()
   }
 }
 
+/// The PCCH message encoded record by record must match the encoding of the whole message
+void test_paging_record_aggregation()
+{
+  unsigned       paging_cycle = 32;
+  paging_manager pcch_manager{paging_cycle, 1};
+
+  unsigned ue_id  = 4780;
+  uint8_t  imsi[] = {0x0, 0x0, 0x1, 0x0, 0x1, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8, 0x9, 0x9};
+  // PO in subframe 9 of the PF given by ue_id % N, as in test_paging()
+  tti_point t{10 * (ue_id % paging_cycle) + 9};
+  for (unsigned i = 0; i < ASN1_RRC_MAX_PAGE_REC; ++i) {
+    if (i % 3 == 0) {
+      TESTASSERT(pcch_manager.add_imsi_paging(ue_id, srsran::const_byte_span{imsi, 6 + i % 10}));
+    } else {
+      uint8_t m_tmsi[] = {0x64, 0x04, 0x00, (uint8_t)i};
+      TESTASSERT(pcch_manager.add_tmsi_paging(ue_id, i, m_tmsi));
+    }
+
+    bool is_read = false;
+    pcch_manager.read_pdu_pcch(
+        t, [i, &is_read](srsran::const_byte_span pdu, const asn1::rrc::pcch_msg_s& msg, bool is_first_tx) {
+          TESTASSERT_EQ(i + 1, msg.msg.c1().paging().paging_record_list.size());
+          uint8_t       buffer[1024];
+          asn1::bit_ref bref(buffer, sizeof(buffer));
+          TESTASSERT(msg.pack(bref) == asn1::SRSASN_SUCCESS);
+          TESTASSERT_EQ((size_t)bref.distance_bytes(), pdu.size());
+          TESTASSERT(std::equal(pdu.begin(), pdu.end(), buffer));
+
+          asn1::rrc::pcch_msg_s unpacked;
+          asn1::cbit_ref        bref2(pdu.data(), pdu.size());
+          TESTASSERT(unpacked.unpack(bref2) == asn1::SRSASN_SUCCESS);
+          TESTASSERT_EQ(i + 1, unpacked.msg.c1().paging().paging_record_list.size());
+          is_read = true;
+          return false;
+        });
+    TESTASSERT(is_read);
+  }
+  uint8_t m_tmsi[] = {0x64, 0x04, 0x00, 0x02};
+  TESTASSERT(not pcch_manager.add_tmsi_paging(ue_id, 1, m_tmsi));
+}
+
 int main()
 {
   test_paging();
+  test_paging_record_aggregation();
 }
\ No newline at end of file
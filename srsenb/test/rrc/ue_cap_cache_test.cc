@@ -0,0 +1,96 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsenb/hdr/stack/rrc/ue_cap_cache.h"
+#include "srsran/common/test_common.h"
+
+using namespace asn1::rrc;
+
+std::vector<uint8_t> make_cap_blob(uint32_t ue_category, uint32_t band)
+{
+  ue_eutra_cap_s cap;
+  cap.access_stratum_release = access_stratum_release_e::rel8;
+  cap.ue_category            = ue_category;
+  cap.rf_params.supported_band_list_eutra.resize(1);
+  cap.rf_params.supported_band_list_eutra[0].band_eutra = band;
+  cap.meas_params.band_list_eutra.resize(1);
+  cap.meas_params.band_list_eutra[0].inter_freq_band_list.resize(1);
+
+  uint8_t       buffer[128];
+  asn1::bit_ref bref(buffer, sizeof(buffer));
+  srsran_assert(cap.pack(bref) == asn1::SRSASN_SUCCESS, "Failed to pack UE capabilities");
+  return std::vector<uint8_t>(buffer, buffer + bref.distance_bytes());
+}
+
+int test_ue_cap_cache()
+{
+  srsenb::ue_cap_cache cache(2);
+
+  std::vector<uint8_t> cat4 = make_cap_blob(4, 7), cat5 = make_cap_blob(5, 7), cat4_b3 = make_cap_blob(4, 3);
+
+  // First UE with the capabilities unpacks them
+  std::shared_ptr<const srsenb::ue_eutra_cap_t> ue1 = cache.get(cat4);
+  TESTASSERT(ue1 != nullptr);
+  TESTASSERT_EQ(4, ue1->caps.ue_category);
+  TESTASSERT_EQ(4, ue1->summary.category);
+  TESTASSERT(ue1->blob == cat4);
+  TESTASSERT_EQ(0, cache.nof_hits());
+
+  // Following UEs with the same capabilities share the decoded ones
+  std::shared_ptr<const srsenb::ue_eutra_cap_t> ue2 = cache.get(cat4);
+  TESTASSERT(ue2 == ue1);
+  TESTASSERT_EQ(1, cache.nof_hits());
+
+  std::shared_ptr<const srsenb::ue_eutra_cap_t> ue3 = cache.get(cat5);
+  TESTASSERT(ue3 != nullptr and ue3 != ue1);
+  TESTASSERT_EQ(5, ue3->caps.ue_category);
+  TESTASSERT_EQ(5, ue3->summary.category);
+  TESTASSERT_EQ(2, cache.size());
+
+  // The cache is full. The least recently used entry (cat5) is replaced, while the UEs keep their capabilities
+  TESTASSERT(cache.get(cat4) == ue1);
+  std::shared_ptr<const srsenb::ue_eutra_cap_t> ue4 = cache.get(cat4_b3);
+  TESTASSERT(ue4 != nullptr);
+  TESTASSERT_EQ(3, ue4->caps.rf_params.supported_band_list_eutra[0].band_eutra);
+  TESTASSERT_EQ(2, cache.size());
+  TESTASSERT(cache.get(cat4) == ue1);
+  TESTASSERT(cache.get(cat5) != ue3);
+  TESTASSERT_EQ(5, ue3->caps.ue_category);
+
+  // Containers that cannot be unpacked are not stored
+  std::vector<uint8_t> truncated(cat4.begin(), cat4.begin() + 1);
+  TESTASSERT(cache.get(truncated) == nullptr);
+  TESTASSERT(cache.get(truncated) == nullptr);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(test_ue_cap_cache() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
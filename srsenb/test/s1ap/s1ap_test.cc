@@ -27,7 +27,8 @@
 using namespace srsenb;
 
 struct mme_dummy {
-  mme_dummy(const char* addr_str_, int port_) : addr_str(addr_str_), port(port_)
+  mme_dummy(const char* addr_str_, int port_, srsran::task_scheduler* task_sched_) :
+    addr_str(addr_str_), port(port_), task_sched(task_sched_)
   {
     srsran::net_utils::set_sockaddr(&mme_sockaddr, addr_str, port);
     {
@@ -50,6 +51,9 @@ struct mme_dummy {
 
   srsran::unique_byte_buffer_t read_msg(sockaddr_in* sockfrom = nullptr)
   {
+    // The S1AP PDUs are handed to the SCTP Tx thread by a deferred stack task
+    task_sched->run_pending_tasks();
+
     srsran::unique_byte_buffer_t pdu     = srsran::make_byte_buffer();
     sockaddr_in                  from    = {};
     socklen_t                    fromlen = sizeof(from);
@@ -67,6 +71,7 @@ struct mme_dummy {
 
   const char*                  addr_str;
   int                          port;
+  srsran::task_scheduler*      task_sched;
   struct sockaddr_in           mme_sockaddr = {};
   int                          fd;
   srsran::unique_byte_buffer_t last_sdu;
@@ -220,7 +225,7 @@ void test_s1ap_erab_setup(test_event event)
 
   const char*    mme_addr_str = "127.0.0.1";
   const uint32_t MME_PORT     = 36412;
-  mme_dummy      mme(mme_addr_str, MME_PORT);
+  mme_dummy      mme(mme_addr_str, MME_PORT, &task_sched);
 
   s1ap_args_t args   = {};
   args.cell_id       = 0x01;
@@ -45,14 +45,24 @@ public:
     last_rnti          = rnti;
     last_eps_bearer_id = eps_bearer_id;
   }
-  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t eps_bearer_id) override
+  void write_sdus(uint16_t rnti, uint32_t eps_bearer_id, srsran::span<srsran::unique_byte_buffer_t> sdus) override
+  {
+    burst_sizes.push_back(sdus.size());
+    for (srsran::unique_byte_buffer_t& sdu : sdus) {
+      write_sdu(rnti, eps_bearer_id, std::move(sdu), -1);
+    }
+  }
+  srsran::pdcp_sdu_list_t get_buffered_pdus(uint16_t rnti, uint32_t eps_bearer_id) override
   {
     return std::move(buffered_pdus);
   }
   void send_status_report(uint16_t rnti) override {}
   void send_status_report(uint16_t rnti, uint32_t eps_bearer_id) override {}
 
-  void push_buffered_pdu(uint32_t sn, srsran::unique_byte_buffer_t pdu) { buffered_pdus[sn] = std::move(pdu); }
+  void push_buffered_pdu(uint32_t sn, srsran::unique_byte_buffer_t pdu)
+  {
+    buffered_pdus.emplace_back(sn, std::move(pdu));
+  }
 
   void clear()
   {
@@ -60,9 +70,11 @@ public:
     last_pdcp_sn       = -1;
     last_eps_bearer_id = 0;
     last_rnti          = SRSRAN_INVALID_RNTI;
+    burst_sizes.clear();
   }
 
-  std::map<uint32_t, srsran::unique_byte_buffer_t> buffered_pdus;
+  std::vector<size_t>                              burst_sizes;
+  srsran::pdcp_sdu_list_t buffered_pdus;
   srsran::unique_byte_buffer_t                     last_sdu;
   int                                              last_pdcp_sn       = -1;
   uint16_t                                         last_rnti          = SRSRAN_INVALID_RNTI;
@@ -381,6 +393,113 @@ int test_gtpu_direct_tunneling(tunnel_test_event event)
   return SRSRAN_SUCCESS;
 }
 
+void test_gtpu_rx_batch()
+{
+  uint16_t           rnti = 0x46;
+  uint32_t           drb1_bearer_id = 5, drb2_bearer_id = 6;
+  const char *       sgw_addr_str = "127.0.0.1", *enb_addr_str = "127.0.1.1";
+  struct sockaddr_in enb_sockaddr = {}, sgw_sockaddr = {};
+  srsran::net_utils::set_sockaddr(&enb_sockaddr, enb_addr_str, GTPU_PORT);
+  srsran::net_utils::set_sockaddr(&sgw_sockaddr, sgw_addr_str, GTPU_PORT);
+  uint32_t sgw_addr = ntohl(sgw_sockaddr.sin_addr.s_addr);
+
+  srsran::task_scheduler task_sched;
+  dummy_socket_manager   rx_sockets;
+  srsenb::gtpu           gtpu(&task_sched, srslog::fetch_basic_logger("GTPU1"), &rx_sockets);
+  pdcp_tester            pdcp;
+  gtpu_args_t            gtpu_args;
+  gtpu_args.gtp_bind_addr = enb_addr_str;
+  gtpu_args.mme_addr      = sgw_addr_str;
+  TESTASSERT(gtpu.init(gtpu_args, &pdcp) == SRSRAN_SUCCESS);
+  uint32_t addr_in;
+  uint32_t teid_in1 = gtpu.add_bearer(rnti, drb1_bearer_id, sgw_addr, 1, addr_in).value();
+  uint32_t teid_in2 = gtpu.add_bearer(rnti, drb2_bearer_id, sgw_addr, 2, addr_in).value();
+
+  // TEST: the consecutive G-PDUs of a bearer in a batch reach PDCP in a single call, in order
+  std::vector<uint8_t>   data(10);
+  srsran::datagram_batch batch;
+  for (uint32_t teid : {teid_in1, teid_in1, teid_in1, teid_in2, teid_in2, teid_in1}) {
+    std::fill(data.begin(), data.end(), batch.pdus.size());
+    batch.pdus.push_back(encode_gtpu_packet(data, teid, sgw_sockaddr, enb_sockaddr));
+    batch.addrs.push_back(sgw_sockaddr);
+  }
+  gtpu.handle_gtpu_s1u_rx_batch(batch);
+  TESTASSERT(pdcp.burst_sizes == std::vector<size_t>({3, 2, 1}));
+  TESTASSERT(pdcp.last_rnti == rnti and pdcp.last_eps_bearer_id == drb1_bearer_id);
+  TESTASSERT(pdcp.last_sdu->N_bytes == PDU_HEADER_SIZE + data.size() and pdcp.last_sdu->msg[PDU_HEADER_SIZE] == 5);
+
+  // TEST: PDUs handled one at a time do not use the burst path
+  pdcp.clear();
+  gtpu.handle_gtpu_s1u_rx_packet(encode_gtpu_packet(data, teid_in2, sgw_sockaddr, enb_sockaddr), sgw_sockaddr);
+  TESTASSERT(pdcp.burst_sizes.empty() and pdcp.last_eps_bearer_id == drb2_bearer_id);
+
+  // TEST: the DL PDUs are accounted in the counters of their tunnel
+  gtpu_metrics_t metrics;
+  gtpu.get_metrics(metrics);
+  TESTASSERT(metrics.tunnels.size() == 2);
+  TESTASSERT(metrics.tunnels[0].teid_in == teid_in1 and metrics.tunnels[0].dl_pkts == 4);
+  TESTASSERT(metrics.tunnels[1].teid_in == teid_in2 and metrics.tunnels[1].dl_pkts == 3);
+  TESTASSERT(metrics.tunnels[1].dl_bytes == 3 * (PDU_HEADER_SIZE + data.size()));
+  TESTASSERT(metrics.tunnels[0].ul_pkts == 0 and metrics.tunnels[0].dropped_pkts == 0);
+}
+
+void test_gtpu_tx_batch()
+{
+  uint16_t           rnti = 0x46;
+  uint32_t           drb1_bearer_id = 5, sgw_teidout = 3;
+  const char *       sgw_addr_str = "127.0.2.2", *enb_addr_str = "127.0.2.1";
+  struct sockaddr_in enb_sockaddr = {}, sgw_sockaddr = {};
+  srsran::net_utils::set_sockaddr(&enb_sockaddr, enb_addr_str, GTPU_PORT);
+  srsran::net_utils::set_sockaddr(&sgw_sockaddr, sgw_addr_str, GTPU_PORT);
+  uint32_t sgw_addr = ntohl(sgw_sockaddr.sin_addr.s_addr);
+
+  srsran::unique_socket sgw_socket;
+  TESTASSERT(sgw_socket.open_socket(srsran::net_utils::addr_family::ipv4,
+                                    srsran::net_utils::socket_type::datagram,
+                                    srsran::net_utils::protocol_type::UDP));
+  TESTASSERT(sgw_socket.bind_addr(sgw_addr_str, GTPU_PORT));
+
+  srsran::task_scheduler task_sched;
+  dummy_socket_manager   rx_sockets;
+  srsenb::gtpu           gtpu(&task_sched, srslog::fetch_basic_logger("GTPU1"), &rx_sockets);
+  pdcp_tester            pdcp;
+  gtpu_args_t            gtpu_args;
+  gtpu_args.gtp_bind_addr = enb_addr_str;
+  gtpu_args.mme_addr      = sgw_addr_str;
+  TESTASSERT(gtpu.init(gtpu_args, &pdcp) == SRSRAN_SUCCESS);
+  uint32_t addr_in;
+  TESTASSERT(gtpu.add_bearer(rnti, drb1_bearer_id, sgw_addr, sgw_teidout, addr_in).has_value());
+
+  // TEST: the UL PDUs are held until the stack tick
+  std::vector<uint8_t> data(10);
+  for (uint32_t i = 0; i < 3; ++i) {
+    std::fill(data.begin(), data.end(), i);
+    gtpu.write_pdu(rnti, drb1_bearer_id, encode_ipv4_packet(data, 0, enb_sockaddr, sgw_sockaddr));
+  }
+  uint8_t buf[64];
+  TESTASSERT(recv(sgw_socket.fd(), buf, sizeof(buf), MSG_DONTWAIT) < 0);
+
+  // TEST: the tick sends them in order, with the tunnel header and the length of each PDU
+  gtpu.tic();
+  for (uint32_t i = 0; i < 3; ++i) {
+    srsran::unique_byte_buffer_t pdu = read_socket(sgw_socket.fd());
+    srsran::gtpu_header_t        header;
+    TESTASSERT(gtpu_read_header(pdu.get(), &header, srslog::fetch_basic_logger("GTPU")));
+    TESTASSERT(header.message_type == GTPU_MSG_DATA_PDU and header.teid == sgw_teidout);
+    TESTASSERT(header.length == PDU_HEADER_SIZE + data.size() and pdu->N_bytes == header.length);
+    TESTASSERT(pdu->msg[PDU_HEADER_SIZE] == i);
+  }
+  TESTASSERT(recv(sgw_socket.fd(), buf, sizeof(buf), MSG_DONTWAIT) < 0);
+
+  // TEST: the UL PDUs are accounted in the counters of the tunnel
+  gtpu_metrics_t metrics;
+  gtpu.get_metrics(metrics);
+  TESTASSERT(metrics.tunnels.size() == 1);
+  TESTASSERT(metrics.tunnels[0].teid_out == sgw_teidout and metrics.tunnels[0].ul_pkts == 3);
+  TESTASSERT(metrics.tunnels[0].ul_bytes == 3 * (PDU_HEADER_SIZE + data.size()));
+  TESTASSERT(metrics.tunnels[0].dl_pkts == 0 and metrics.tunnels[0].dropped_pkts == 0);
+}
+
 } // namespace srsenb
 
 int main(int argc, char** argv)
@@ -394,6 +513,8 @@ int main(int argc, char** argv)
   srsran::test_init(argc, argv);
 
   srsenb::test_gtpu_tunnel_manager();
+  srsenb::test_gtpu_rx_batch();
+  srsenb::test_gtpu_tx_batch();
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::success) == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::wait_end_marker_timeout) == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::ue_removal_no_marker) == SRSRAN_SUCCESS);
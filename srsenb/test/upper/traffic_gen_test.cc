@@ -0,0 +1,185 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsenb/hdr/stack/upper/traffic_gen.h"
+#include "srsran/common/test_common.h"
+
+namespace srsenb {
+
+class pdcp_sink : public pdcp_interface_gtpu
+{
+public:
+  void write_sdu(uint16_t rnti, uint32_t eps_bearer_id, srsran::unique_byte_buffer_t sdu, int pdcp_sn) override
+  {
+    TESTASSERT(sdu != nullptr);
+    last_rnti          = rnti;
+    last_eps_bearer_id = eps_bearer_id;
+    nof_bytes += sdu->N_bytes;
+    nof_sdus++;
+  }
+  srsran::pdcp_sdu_list_t get_buffered_pdus(uint16_t rnti, uint32_t eps_bearer_id) override { return {}; }
+
+  uint16_t last_rnti          = SRSRAN_INVALID_RNTI;
+  uint32_t last_eps_bearer_id = 0;
+  uint64_t nof_bytes          = 0;
+  uint64_t nof_sdus           = 0;
+};
+
+static traffic_gen_args_t default_args()
+{
+  traffic_gen_args_t args = {};
+  args.enable             = true;
+  args.dl_flows           = "5:cbr:10000";
+  args.sdu_size           = 1250;
+  args.burst_period_ms    = 100;
+  args.burst_on_ms        = 20;
+  args.sawtooth_period_ms = 1000;
+  return args;
+}
+
+int test_traffic_gen_profiles()
+{
+  using profile_t = traffic_gen::profile_t;
+
+  // cbr
+  TESTASSERT(traffic_gen::profile_bits(profile_t::cbr, 1000, 0, 100, 20) == 0);
+  TESTASSERT(traffic_gen::profile_bits(profile_t::cbr, 1000, 1000, 100, 20) == 1000000);
+
+  // burst: all the bits of a period are sent in the on time, keeping the mean rate
+  TESTASSERT(traffic_gen::profile_bits(profile_t::burst, 1000, 10, 100, 20) == 50000);
+  TESTASSERT(traffic_gen::profile_bits(profile_t::burst, 1000, 20, 100, 20) == 100000);
+  TESTASSERT(traffic_gen::profile_bits(profile_t::burst, 1000, 99, 100, 20) == 100000);
+  TESTASSERT(traffic_gen::profile_bits(profile_t::burst, 1000, 1000, 100, 20) == 1000000);
+
+  // sawtooth: the rate ramps up from half to full rate, so a period sends ~3/4 of the cbr bits
+  TESTASSERT(traffic_gen::profile_bits(profile_t::sawtooth, 1000, 1, 1000, 20) == 500);
+  TESTASSERT(traffic_gen::profile_bits(profile_t::sawtooth, 1000, 1000, 1000, 20) == 749750);
+  TESTASSERT(traffic_gen::profile_bits(profile_t::sawtooth, 1000, 3000, 1000, 20) == 3 * 749750);
+  uint64_t prev_bits = 0, prev_delta = 0;
+  for (uint64_t t = 1; t <= 1000; ++t) {
+    uint64_t bits = traffic_gen::profile_bits(profile_t::sawtooth, 1000, t, 1000, 20);
+    TESTASSERT(bits >= prev_bits);
+    TESTASSERT(bits - prev_bits + 1 >= prev_delta);
+    prev_delta = bits - prev_bits;
+    prev_bits  = bits;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_traffic_gen_args()
+{
+  auto&              logger = srslog::fetch_basic_logger("STCK", false);
+  enb_bearer_manager bearers;
+  pdcp_sink          pdcp;
+
+  traffic_gen_args_t args = default_args();
+  args.dl_flows           = "5:cbr:10000, 6:burst:2000,7:sawtooth:5000";
+  TESTASSERT(traffic_gen(logger, bearers).init(args, &pdcp) == SRSRAN_SUCCESS);
+
+  for (const char* flows : {"5:cbr", "5:tcp:1000", "4:cbr:1000", "5:cbr:0"}) {
+    args.dl_flows = flows;
+    TESTASSERT(traffic_gen(logger, bearers).init(args, &pdcp) == SRSRAN_ERROR);
+  }
+
+  args          = default_args();
+  args.sdu_size = 20;
+  TESTASSERT(traffic_gen(logger, bearers).init(args, &pdcp) == SRSRAN_ERROR);
+  args             = default_args();
+  args.burst_on_ms = 200;
+  TESTASSERT(traffic_gen(logger, bearers).init(args, &pdcp) == SRSRAN_ERROR);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_traffic_gen_flows()
+{
+  auto&              logger = srslog::fetch_basic_logger("STCK", false);
+  enb_bearer_manager bearers;
+  pdcp_sink          pdcp;
+  traffic_gen        tgen(logger, bearers);
+  uint16_t           rnti = 0x46;
+
+  TESTASSERT(tgen.init(default_args(), &pdcp) == SRSRAN_SUCCESS);
+
+  // No flows before the DRBs are established
+  tgen.tic();
+  traffic_gen_metrics_t m;
+  tgen.get_metrics(m);
+  TESTASSERT(m.flows.empty() and pdcp.nof_sdus == 0);
+
+  // The DL of the configured bearer follows the profile exactly, the other bearer only absorbs UL traffic
+  bearers.add_eps_bearer(rnti, 5, srsran::srsran_rat_t::lte, 3);
+  bearers.add_eps_bearer(rnti, 6, srsran::srsran_rat_t::lte, 4);
+  for (uint32_t i = 0; i < 1000; ++i) {
+    tgen.tic();
+  }
+  TESTASSERT(pdcp.last_rnti == rnti and pdcp.last_eps_bearer_id == 5);
+  TESTASSERT(pdcp.nof_sdus == 1000 and pdcp.nof_bytes == 1250000);
+
+  for (uint32_t lcid : {3, 4, 4, 9}) {
+    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+    TESTASSERT(pdu != nullptr);
+    pdu->N_bytes = 100;
+    tgen.write_pdu(rnti, lcid, std::move(pdu));
+  }
+
+  tgen.get_metrics(m);
+  TESTASSERT(m.flows.size() == 2);
+  for (const traffic_gen_flow_metrics_t& flow : m.flows) {
+    TESTASSERT(flow.rnti == rnti);
+    if (flow.eps_bearer_id == 5) {
+      TESTASSERT(flow.dl_bytes == 1250000 and flow.dl_pkts == 1000 and flow.dl_dropped_pkts == 0);
+      TESTASSERT(flow.ul_bytes == 100 and flow.ul_pkts == 1);
+    } else {
+      TESTASSERT(flow.eps_bearer_id == 6);
+      TESTASSERT(flow.dl_bytes == 0 and flow.ul_bytes == 200 and flow.ul_pkts == 2);
+    }
+  }
+
+  // The counters of the released bearers are kept in the totals
+  bearers.rem_user(rnti);
+  tgen.tic();
+  tgen.get_metrics(m);
+  TESTASSERT(m.flows.empty());
+  TESTASSERT(m.total.dl_bytes == 1250000 and m.total.dl_pkts == 1000);
+  TESTASSERT(m.total.ul_bytes == 300 and m.total.ul_pkts == 3);
+  TESTASSERT(pdcp.nof_sdus == 1000);
+
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  srslog::fetch_basic_logger("STCK", false).set_level(srslog::basic_levels::info);
+  srsran::test_init(argc, argv);
+
+  TESTASSERT(srsenb::test_traffic_gen_profiles() == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_traffic_gen_args() == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_traffic_gen_flows() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
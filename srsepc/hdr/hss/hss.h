@@ -30,11 +30,15 @@
 
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/threads.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
+#include <condition_variable>
 #include <cstddef>
-
+#include <deque>
 #include <map>
+#include <memory>
+#include <mutex>
 
 #define LTE_FDD_ENB_IND_HE_N_BITS 5
 #define LTE_FDD_ENB_IND_HE_MASK 0x1FUL
@@ -47,10 +51,18 @@ struct hss_args_t {
   std::string db_file;
   uint16_t    mcc;
   uint16_t    mnc;
+  uint32_t    nof_auth_vectors = 0; ///< Authentication vectors generated ahead per UE. 0 disables the worker
 };
 
 enum hss_auth_algo { HSS_ALGO_XOR, HSS_ALGO_MILENAGE };
 
+struct hss_auth_vector_t {
+  uint8_t k_asme[32];
+  uint8_t autn[16];
+  uint8_t rand[16];
+  uint8_t xres[16];
+};
+
 struct hss_ue_ctx_t {
   // Members
   std::string        name;
@@ -66,6 +78,11 @@ struct hss_ue_ctx_t {
   uint8_t            last_rand[16];
   std::string        static_ip_addr;
 
+  // Vectors generated ahead by the auth vector worker, in SQN order. The SQN above is the one after the last vector
+  std::deque<hss_auth_vector_t> auth_vectors;
+  uint32_t                      auth_vectors_epoch   = 0; ///< Bumped when the queued and in-flight vectors are stale
+  bool                          auth_vectors_pending = false;
+
   // Helper getters/setters
   void set_sqn(const uint8_t* sqn_);
   void set_last_rand(const uint8_t* rand_);
@@ -92,6 +109,16 @@ private:
   virtual ~hss();
   static hss* m_instance;
 
+  class auth_vector_worker : public srsran::thread
+  {
+  public:
+    explicit auth_vector_worker(hss& parent_) : thread("HSS_AUTH"), parent(parent_) {}
+
+  private:
+    void run_thread() override { parent.run_auth_vector_worker(); }
+    hss& parent;
+  };
+
   std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> > m_imsi_to_ue_ctx;
 
   void gen_rand(uint8_t rand_[16]);
@@ -105,6 +132,10 @@ private:
 
   void                     get_uint_vec_from_hex_str(const std::string& key_str, uint8_t* key, uint len);
 
+  void request_auth_vectors(hss_ue_ctx_t* ue_ctx);
+  void run_auth_vector_worker();
+  void stop_auth_vector_worker();
+
   void increment_ue_sqn(hss_ue_ctx_t* ue_ctx);
   void increment_seq_after_resync(hss_ue_ctx_t* ue_ctx);
   void increment_sqn(uint8_t* sqn, uint8_t* next_sqn);
@@ -112,12 +143,29 @@ private:
   bool          set_auth_algo(std::string auth_algo);
   bool          read_db_file(std::string db_file);
   bool          write_db_file(std::string db_file);
+  bool          open_sqn_journal(const std::string& journal_file);
+  void          journal_ue_sqn(const hss_ue_ctx_t* ue_ctx);
+  void          close_sqn_journal(bool db_file_written);
   hss_ue_ctx_t* get_ue_ctx(uint64_t imsi);
 
   std::string hex_string(uint8_t* hex, int size);
 
   std::string db_file;
 
+  // Append-only log of the SQN updates since the DB file was last written. It is replayed on startup, so that the SQNs
+  // survive a crash of the EPC
+  std::string sqn_journal_file;
+  int         sqn_journal_fd = -1;
+
+  // Generation of the authentication vectors ahead of the attach, away from the MME thread. The mutex protects the SQN,
+  // the last RAND and the vectors of the UEs, and the SQN journal
+  uint32_t                            nof_auth_vectors = 0;
+  std::mutex                          auth_mutex;
+  std::condition_variable             auth_cvar;
+  std::deque<uint64_t>                auth_refill_queue;
+  bool                                auth_worker_running = false;
+  std::unique_ptr<auth_vector_worker> auth_worker;
+
   /*Logs*/
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("HSS");
 
@@ -29,15 +29,20 @@
 #define SRSEPC_MME_H
 
 #include "s1ap.h"
+#include "srsran/common/block_queue.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/threads.h"
 #include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
 
 namespace srsepc {
 
 typedef struct {
   s1ap_args_t s1ap_args;
+  uint32_t    nof_s1ap_workers; // Threads unpacking the S1AP PDUs. 0 unpacks them in the MME thread
   // diameter_args_t diameter_args;
   // gtpc_args_t gtpc_args;
 } mme_args_t;
@@ -80,6 +85,38 @@ private:
   // Timer Methods
   void handle_timer_expire(int timer_fd);
 
+  // S1AP PDU received from an eNB. The notifications follow the same path as the data, so that the order within an
+  // SCTP association is kept
+  struct s1ap_rx_pdu_t {
+    srsran::unique_byte_buffer_t pdu;
+    struct sctp_sndrcvinfo       sri          = {};
+    bool                         notification = false;
+    bool                         decoded      = false;
+    s1ap_pdu_t                   msg;
+  };
+  using s1ap_rx_pdu_ptr = std::unique_ptr<s1ap_rx_pdu_t>;
+
+  // Unpacks the PDUs of the SCTP associations assigned to it, and hands them back to the MME thread
+  class s1ap_decoder : public srsran::thread
+  {
+  public:
+    explicit s1ap_decoder(mme& parent_) : thread("MME_S1AP"), parent(parent_) {}
+    srsran::block_queue<s1ap_rx_pdu_ptr> queue;
+
+  private:
+    void run_thread() override;
+    mme& parent;
+  };
+
+  void handle_s1ap_rx_pdu(s1ap_rx_pdu_t& rx_pdu);
+  void handle_decoded_s1ap_pdus();
+  void stop_s1ap_decoders();
+
+  std::vector<std::unique_ptr<s1ap_decoder> > s1ap_decoders;
+  std::mutex                                  decoded_mutex;
+  std::deque<s1ap_rx_pdu_ptr>                 decoded_pdus;
+  int                                         decoded_event_fd = -1;
+
   // Logs
   srslog::basic_logger& m_s1ap_logger = srslog::fetch_basic_logger("S1AP");
 };
@@ -168,37 +168,37 @@ public:
                                     const nas_init_t&       args,
                                     const nas_if_t&         itf);
 
-  static bool handle_imsi_attach_request_unknown_ue(uint32_t                                    enb_ue_s1ap_id,
-                                                    struct sctp_sndrcvinfo*                     enb_sri,
-                                                    const LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT& attach_req,
-                                                    const LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT& pdn_con_req,
-                                                    const nas_init_t&                                     args,
-                                                    const nas_if_t&                                       itf);
-
-  static bool handle_imsi_attach_request_known_ue(nas*                                                  nas_ctx,
-                                                  uint32_t                                              enb_ue_s1ap_id,
-                                                  struct sctp_sndrcvinfo*                               enb_sri,
-                                                  const LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT&           attach_req,
-                                                  const LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT& pdn_con_req,
-                                                  srsran::byte_buffer_t*                                nas_rx,
-                                                  const nas_init_t&                                     args,
-                                                  const nas_if_t&                                       itf);
-
-  static bool handle_guti_attach_request_unknown_ue(uint32_t                                    enb_ue_s1ap_id,
-                                                    struct sctp_sndrcvinfo*                     enb_sri,
-                                                    const LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT& attach_req,
-                                                    const LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT& pdn_con_req,
-                                                    const nas_init_t&                                     args,
-                                                    const nas_if_t&                                       itf);
-
-  static bool handle_guti_attach_request_known_ue(nas*                                                  nas_ctx,
-                                                  uint32_t                                              enb_ue_s1ap_id,
-                                                  struct sctp_sndrcvinfo*                               enb_sri,
-                                                  const LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT&           attach_req,
-                                                  const LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT& pdn_con_req,
-                                                  srsran::byte_buffer_t*                                nas_rx,
-                                                  const nas_init_t&                                     args,
-                                                  const nas_if_t&                                       itf);
+  static bool handle_imsi_attach_request_unknown_ue(uint32_t                                     enb_ue_s1ap_id,
+                                                    struct sctp_sndrcvinfo*                      enb_sri,
+                                                    const LIBLTE_MME_ATTACH_REQUEST_VIEW_STRUCT& attach_req,
+                                                    const LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_VIEW_STRUCT& pdn_con_req,
+                                                    const nas_init_t&                                      args,
+                                                    const nas_if_t&                                        itf);
+
+  static bool handle_imsi_attach_request_known_ue(nas*                                                   nas_ctx,
+                                                  uint32_t                                               enb_ue_s1ap_id,
+                                                  struct sctp_sndrcvinfo*                                enb_sri,
+                                                  const LIBLTE_MME_ATTACH_REQUEST_VIEW_STRUCT&           attach_req,
+                                                  const LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_VIEW_STRUCT& pdn_con_req,
+                                                  srsran::byte_buffer_t*                                 nas_rx,
+                                                  const nas_init_t&                                      args,
+                                                  const nas_if_t&                                        itf);
+
+  static bool handle_guti_attach_request_unknown_ue(uint32_t                                     enb_ue_s1ap_id,
+                                                    struct sctp_sndrcvinfo*                      enb_sri,
+                                                    const LIBLTE_MME_ATTACH_REQUEST_VIEW_STRUCT& attach_req,
+                                                    const LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_VIEW_STRUCT& pdn_con_req,
+                                                    const nas_init_t&                                      args,
+                                                    const nas_if_t&                                        itf);
+
+  static bool handle_guti_attach_request_known_ue(nas*                                                   nas_ctx,
+                                                  uint32_t                                               enb_ue_s1ap_id,
+                                                  struct sctp_sndrcvinfo*                                enb_sri,
+                                                  const LIBLTE_MME_ATTACH_REQUEST_VIEW_STRUCT&           attach_req,
+                                                  const LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_VIEW_STRUCT& pdn_con_req,
+                                                  srsran::byte_buffer_t*                                 nas_rx,
+                                                  const nas_init_t&                                      args,
+                                                  const nas_if_t&                                        itf);
 
   // Service request messages
   static bool handle_service_request(uint32_t                m_tmsi,
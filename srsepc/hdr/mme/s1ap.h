@@ -41,6 +41,7 @@
 #include <map>
 #include <netinet/sctp.h>
 #include <set>
+#include <unordered_map>
 #include <strings.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -67,7 +68,13 @@ public:
   void delete_enb_ctx(int32_t assoc_id);
 
   bool s1ap_tx_pdu(const s1ap_pdu_t& pdu, struct sctp_sndrcvinfo* enb_sri);
+  /// Sends an already encoded S1AP PDU, e.g. one that is sent to several eNBs
+  bool s1ap_tx_pdu(const srsran::byte_buffer_t& pdu, struct sctp_sndrcvinfo* enb_sri);
   void handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri);
+  /// Handles the PDUs of the most frequent procedures from an index of their IEs. Returns false for the other PDUs
+  bool handle_s1ap_rx_pdu_fast(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri);
+  /// Handles a PDU unpacked off the MME thread. A null rx_pdu means that it could not be unpacked
+  void handle_s1ap_decoded_pdu(srsran::byte_buffer_t* pdu, const s1ap_pdu_t* rx_pdu, struct sctp_sndrcvinfo* enb_sri);
   void handle_initiating_message(const asn1::s1ap::init_msg_s& msg, struct sctp_sndrcvinfo* enb_sri);
   void handle_successful_outcome(const asn1::s1ap::successful_outcome_s& msg);
 
@@ -105,8 +112,8 @@ public:
   s1ap_erab_mngmt_proc* m_s1ap_erab_mngmt_proc;
   s1ap_paging*          m_s1ap_paging;
 
-  std::map<uint32_t, uint64_t>   m_tmsi_to_imsi;
-  std::map<uint16_t, enb_ctx_t*> m_active_enbs;
+  std::unordered_map<uint32_t, uint64_t> m_tmsi_to_imsi;
+  std::map<uint16_t, enb_ctx_t*>         m_active_enbs;
 
   // Interfaces
   virtual bool send_initial_context_setup_request(uint64_t imsi, uint16_t erab_to_setup);
@@ -141,8 +148,8 @@ private:
   std::map<int32_t, uint16_t>            m_sctp_to_enb_id;
   std::map<int32_t, std::set<uint32_t> > m_enb_assoc_to_ue_ids;
 
-  std::map<uint64_t, nas*> m_imsi_to_nas_ctx;
-  std::map<uint32_t, nas*> m_mme_ue_s1ap_id_to_nas_ctx;
+  std::unordered_map<uint64_t, nas*> m_imsi_to_nas_ctx;
+  std::unordered_map<uint32_t, nas*> m_mme_ue_s1ap_id_to_nas_ctx;
 
   uint32_t m_next_mme_ue_s1ap_id;
   uint32_t m_next_m_tmsi;
@@ -153,6 +160,9 @@ private:
   // PCAP
   bool              m_pcap_enable;
   srsran::s1ap_pcap m_pcap;
+
+  // Storage of the PDUs unpacked in the MME thread while they are handled
+  asn1::decode_arena m_rx_arena;
 };
 
 inline uint32_t s1ap::get_plmn()
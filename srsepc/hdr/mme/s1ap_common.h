@@ -53,6 +53,8 @@ typedef struct {
   srsran::INTEGRITY_ALGORITHM_ID_ENUM integrity_algo;
   bool                                request_imeisv;
   uint16_t                            lac;
+  uint32_t                            max_attach_rate;    // Attach Requests admitted per second (0 for no limit)
+  uint32_t                            max_pending_attach; // Attach Requests held back before signalling overload
 } s1ap_args_t;
 
 typedef struct {
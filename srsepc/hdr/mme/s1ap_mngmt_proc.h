@@ -46,6 +46,10 @@ public:
   bool send_s1_setup_failure(asn1::s1ap::cause_misc_opts::options cause, struct sctp_sndrcvinfo* enb_sri);
   bool send_s1_setup_response(const s1ap_args_t& s1ap_args, struct sctp_sndrcvinfo* enb_sri);
 
+  // Overload control towards all the connected eNBs
+  bool send_overload_start(asn1::s1ap::overload_action_opts::options action);
+  bool send_overload_stop();
+
 private:
   s1ap_mngmt_proc();
   virtual ~s1ap_mngmt_proc();
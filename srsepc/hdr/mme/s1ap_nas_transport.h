@@ -26,7 +26,10 @@
 #include "srsepc/hdr/hss/hss.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/asn1/s1ap.h"
+#include "srsran/adt/span.h"
 #include "srsran/common/buffer_pool.h"
+#include <chrono>
+#include <deque>
 
 namespace srsepc {
 
@@ -40,21 +43,46 @@ public:
 
   bool handle_initial_ue_message(const asn1::s1ap::init_ue_msg_s& init_ue, struct sctp_sndrcvinfo* enb_sri);
   bool handle_uplink_nas_transport(const asn1::s1ap::ul_nas_transport_s& ul_xport, struct sctp_sndrcvinfo* enb_sri);
+  bool handle_uplink_nas_transport(uint32_t                    enb_ue_s1ap_id,
+                                   uint32_t                    mme_ue_s1ap_id,
+                                   srsran::const_span<uint8_t> nas_pdu,
+                                   struct sctp_sndrcvinfo*     enb_sri);
   bool send_downlink_nas_transport(uint32_t               enb_ue_s1ap_id,
                                    uint32_t               mme_ue_s1ap_id,
                                    srsran::byte_buffer_t* nas_msg,
                                    struct sctp_sndrcvinfo enb_sri);
 
+  /// Handles the Attach Requests held back by the admission control, as far as the admission rate allows.
+  /// Returns the time in ms until the next one can be admitted, or -1 when none is pending
+  int  handle_pending_attach_requests();
+  void drop_pending_attach_requests(int32_t enb_assoc);
+
 private:
   s1ap_nas_transport();
   virtual ~s1ap_nas_transport();
 
+  struct pending_attach_request_t {
+    asn1::s1ap::init_ue_msg_s init_ue;
+    struct sctp_sndrcvinfo    enb_sri;
+  };
+
+  bool process_initial_ue_message(const asn1::s1ap::init_ue_msg_s& init_ue, struct sctp_sndrcvinfo* enb_sri);
+  bool admit_attach_request();
+  void update_overload_state();
+
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("S1AP");
 
   s1ap* m_s1ap;
 
   nas_init_t m_nas_init;
   nas_if_t   m_nas_if;
+
+  // Attach admission control. The tokens refill at max_attach_rate per second, and the eNBs are asked to reject
+  // new RRC connections while the queue of Attach Requests waiting for a token is full
+  std::deque<pending_attach_request_t>  m_pending_attach;
+  double                                m_attach_tokens = 0;
+  std::chrono::steady_clock::time_point m_attach_tokens_tp;
+  bool                                  m_overload = false;
 };
 
 } // namespace srsepc
@@ -27,6 +27,7 @@
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
 
+#include <mutex>
 #include <set>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -73,6 +74,7 @@ public:
   bool               delete_gtpc_ctx(uint32_t ctrl_teid);
 
   bool free_all_queued_packets(spgw_tunnel_ctx_t* tunnel_ctx);
+  void release_paging_queue(spgw_tunnel_ctx_t* tunnel_ctx);
 
   spgw*                m_spgw;
   gtpu_interface_gtpc* m_gtpu;
@@ -84,6 +86,10 @@ public:
   uint64_t m_next_ctrl_teid;
   uint64_t m_next_user_teid;
   uint32_t m_max_paging_queue;
+  uint32_t m_max_paging_queue_bytes;
+
+  // Serializes the S11 handling with the paging requests of the user plane thread
+  std::mutex m_mutex;
 
   std::map<uint64_t, uint32_t> m_imsi_to_ctr_teid;           // IMSI to control TEID map. Important to check if UE
                                                              // is previously connected
@@ -25,20 +25,31 @@
 #include "srsepc/hdr/spgw/spgw.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/network_utils.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/threads.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include <cstddef>
-#include <queue>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace srsepc {
 
+/**
+ * User plane of the SPGW. It runs in a set of worker threads, each of them serving one queue of the multi-queue SGi
+ * interface and one of the SO_REUSEPORT S1-U sockets, so that the kernel spreads the flows across them. The GTP-C
+ * thread only updates the tunnels through gtpu_interface_gtpc
+ */
 class spgw::gtpu : public gtpu_interface_gtpc
 {
 public:
   gtpu();
   virtual ~gtpu();
   int  init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc);
+  void start();
   void stop();
 
   int init_sgi(spgw_args_t* args);
@@ -46,34 +57,70 @@ public:
   int get_sgi();
   int get_s1u();
 
-  void handle_sgi_pdu(srsran::unique_byte_buffer_t msg);
-  void handle_s1u_pdu(srsran::byte_buffer_t* msg);
-  void send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg);
+  /// Tunnel lookup tables. GTP-C replaces them as a whole, so that the workers read a snapshot without locking
+  struct tunnel_table {
+    std::unordered_map<in_addr_t, srsran::gtp_fteid_t> ip_to_usr_teid; // Map IP to User-plane TEID for downlink traffic
+    std::unordered_map<in_addr_t, uint32_t>            ip_to_ctr_teid; // IP to control TEID map. Important to check if
+                                                                       // UE is attached without an active user-plane
+                                                                       // for downlink notifications.
+  };
+
+  void handle_sgi_pdu(srsran::unique_byte_buffer_t msg,
+                      const tunnel_table&          tunnels,
+                      srsran::datagram_tx_batch&   tx_batch);
+  void handle_s1u_pdu(srsran::byte_buffer_t* msg, int sgi);
+  void send_s1u_pdu(srsran::gtp_fteid_t          enb_fteid,
+                    srsran::unique_byte_buffer_t msg,
+                    srsran::datagram_tx_batch&   tx_batch);
 
   virtual in_addr_t get_s1u_addr();
 
   virtual bool modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtp_fteid_t dw_user_fteid, uint32_t up_ctr_fteid);
   virtual bool delete_gtpu_tunnel(in_addr_t ue_ipv4);
   virtual bool delete_gtpc_tunnel(in_addr_t ue_ipv4);
-  virtual void send_all_queued_packets(srsran::gtp_fteid_t                       dw_user_fteid,
-                                       std::queue<srsran::unique_byte_buffer_t>& pkt_queue);
+  virtual void send_all_queued_packets(srsran::gtp_fteid_t                                        dw_user_fteid,
+                                       srsran::dyn_circular_buffer<srsran::unique_byte_buffer_t>& pkt_queue);
+
+  /// User plane thread, which serves one queue of the SGi interface and one S1-U socket
+  class worker : public srsran::thread
+  {
+  public:
+    worker(gtpu* parent_, uint32_t id, int sgi_, int s1u_);
+    void stop();
+
+  private:
+    void run_thread() override;
+
+    gtpu*                     parent;
+    int                       sgi;
+    int                       s1u;
+    bool                      running = false;
+    srsran::datagram_tx_batch tx_batch;
+  };
 
   spgw*                m_spgw;
   gtpc_interface_gtpu* m_gtpc;
 
-  bool m_sgi_up;
-  int  m_sgi;
+  uint32_t m_nof_workers = 1;
+
+  bool             m_sgi_up;
+  int              m_sgi;
+  std::vector<int> m_sgi_queues; // One TUN queue per worker, the first of them being m_sgi
 
-  bool        m_s1u_up;
-  int         m_s1u;
-  sockaddr_in m_s1u_addr;
+  bool             m_s1u_up;
+  int              m_s1u;
+  std::vector<int> m_s1u_socks; // One S1-U socket per worker, the first of them being m_s1u
+  sockaddr_in      m_s1u_addr;
 
-  std::map<in_addr_t, srsran::gtp_fteid_t> m_ip_to_usr_teid; // Map IP to User-plane TEID for downlink traffic
-  std::map<in_addr_t, uint32_t>            m_ip_to_ctr_teid; // IP to control TEID map. Important to check if
-                                                             // UE is attached without an active user-plane
-                                                             // for downlink notifications.
+  std::vector<std::unique_ptr<worker>> m_workers;
+
+  std::mutex                          m_tunnel_mutex; // Serializes the updates of the tunnel table
+  std::shared_ptr<const tunnel_table> m_tunnels;      // Accessed with std::atomic_load/std::atomic_store
 
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("GTPU");
+
+  // The packets queued during paging are sent from the GTP-C thread, through their own batch
+  srsran::datagram_tx_batch m_paging_tx_batch{m_logger};
 };
 
 inline int spgw::gtpu::get_sgi()
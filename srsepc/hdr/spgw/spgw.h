@@ -28,12 +28,12 @@
 #ifndef SRSEPC_SPGW_H
 #define SRSEPC_SPGW_H
 
+#include "srsran/adt/circular_buffer.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/threads.h"
 #include "srsran/srslog/srslog.h"
 #include <cstddef>
-#include <queue>
 
 namespace srsepc {
 
@@ -46,18 +46,22 @@ typedef struct {
   std::string sgi_if_addr;
   std::string sgi_if_name;
   uint32_t    max_paging_queue;
+  uint32_t    max_paging_queue_bytes;
+  uint32_t    nof_workers;
 } spgw_args_t;
 
 typedef struct spgw_tunnel_ctx {
-  uint64_t                                 imsi;
-  in_addr_t                                ue_ipv4;
-  uint8_t                                  ebi;
-  srsran::gtp_fteid_t                      up_ctrl_fteid;
-  srsran::gtp_fteid_t                      up_user_fteid;
-  srsran::gtp_fteid_t                      dw_ctrl_fteid;
-  srsran::gtp_fteid_t                      dw_user_fteid;
-  bool                                     paging_pending;
-  std::queue<srsran::unique_byte_buffer_t> paging_queue;
+  uint64_t            imsi;
+  in_addr_t           ue_ipv4;
+  uint8_t             ebi;
+  srsran::gtp_fteid_t up_ctrl_fteid;
+  srsran::gtp_fteid_t up_user_fteid;
+  srsran::gtp_fteid_t dw_ctrl_fteid;
+  srsran::gtp_fteid_t dw_user_fteid;
+  bool                paging_pending;
+  // Downlink packets held while the UE is paged. The ring is only allocated while paging is pending
+  srsran::dyn_circular_buffer<srsran::unique_byte_buffer_t> paging_queue;
+  uint32_t                                                  paging_queue_bytes;
 } spgw_tunnel_ctx_t;
 
 class spgw : public srsran::thread
@@ -22,15 +22,24 @@
 #include "srsran/common/security.h"
 #include "srsran/common/string_helpers.h"
 #include <arpa/inet.h>
+#include <fcntl.h>
 #include <inttypes.h> // for printing uint64_t
 #include <iomanip>
 #include <sstream>
 #include <stdlib.h> /* srand, rand */
 #include <string>
 #include <time.h>
+#include <unistd.h>
 
 namespace srsepc {
 
+/// Record of the SQN journal. The journal is a plain sequence of these records, in host byte order
+struct sqn_journal_record_t {
+  uint64_t imsi;
+  uint8_t  sqn[6];
+  uint8_t  reserved[2];
+};
+
 hss*            hss::m_instance    = NULL;
 pthread_mutex_t hss_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
@@ -79,6 +88,19 @@ int hss::init(hss_args_t* hss_args)
 
   db_file = hss_args->db_file;
 
+  /*Recover the SQNs of the last run, if it did not write the DB file*/
+  if (not open_sqn_journal(db_file + ".sqn")) {
+    srsran::console("Error opening SQN journal %s.sqn\n", db_file.c_str());
+    return -1;
+  }
+
+  nof_auth_vectors = hss_args->nof_auth_vectors;
+  if (nof_auth_vectors > 0) {
+    auth_worker_running = true;
+    auth_worker.reset(new auth_vector_worker(*this));
+    auth_worker->start();
+  }
+
   m_logger.info("HSS Initialized. DB file %s, MCC: %d, MNC: %d", hss_args->db_file.c_str(), mcc, mnc);
   srsran::console("HSS Initialized.\n");
   return 0;
@@ -86,10 +108,73 @@ int hss::init(hss_args_t* hss_args)
 
 void hss::stop()
 {
-  write_db_file(db_file);
+  stop_auth_vector_worker();
+  close_sqn_journal(write_db_file(db_file));
   return;
 }
 
+bool hss::open_sqn_journal(const std::string& journal_file)
+{
+  sqn_journal_file = journal_file;
+
+  // Replay the updates of the last run
+  uint32_t nof_restored = 0;
+  int      fd           = open(sqn_journal_file.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    sqn_journal_record_t record;
+    while (read(fd, &record, sizeof(record)) == sizeof(record)) {
+      hss_ue_ctx_t* ue_ctx = get_ue_ctx(record.imsi);
+      if (ue_ctx != nullptr) {
+        ue_ctx->set_sqn(record.sqn);
+        nof_restored++;
+      }
+    }
+    close(fd);
+  }
+
+  // Once the restored SQNs are in the DB file, the journal starts over
+  int flags = O_WRONLY | O_CREAT | O_APPEND;
+  if (nof_restored > 0) {
+    m_logger.info("Restored %d SQN updates from %s", nof_restored, sqn_journal_file.c_str());
+    srsran::console("Restored %d SQN updates from %s\n", nof_restored, sqn_journal_file.c_str());
+    if (write_db_file(db_file)) {
+      flags |= O_TRUNC;
+    }
+  }
+  sqn_journal_fd = open(sqn_journal_file.c_str(), flags, 0644);
+  if (sqn_journal_fd < 0) {
+    m_logger.error("Error opening SQN journal %s: %s", sqn_journal_file.c_str(), strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+void hss::journal_ue_sqn(const hss_ue_ctx_t* ue_ctx)
+{
+  if (sqn_journal_fd < 0) {
+    return;
+  }
+  sqn_journal_record_t record = {};
+  record.imsi                 = ue_ctx->imsi;
+  memcpy(record.sqn, ue_ctx->sqn, sizeof(record.sqn));
+  if (write(sqn_journal_fd, &record, sizeof(record)) != sizeof(record)) {
+    m_logger.error("Error writing SQN journal %s: %s", sqn_journal_file.c_str(), strerror(errno));
+  }
+}
+
+void hss::close_sqn_journal(bool db_file_written)
+{
+  if (sqn_journal_fd < 0) {
+    return;
+  }
+  // The journal is only needed while the DB file lags behind
+  if (db_file_written and ftruncate(sqn_journal_fd, 0) != 0) {
+    m_logger.error("Error clearing SQN journal %s: %s", sqn_journal_file.c_str(), strerror(errno));
+  }
+  close(sqn_journal_fd);
+  sqn_journal_fd = -1;
+}
+
 bool hss::read_db_file(std::string db_filename)
 {
   std::ifstream m_db_file;
@@ -265,18 +350,116 @@ bool hss::gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, ui
     return false;
   }
 
-  switch (ue_ctx->algo) {
-    case HSS_ALGO_XOR:
-      gen_auth_info_answer_xor(ue_ctx, k_asme, autn, rand, xres);
-      break;
-    case HSS_ALGO_MILENAGE:
-      gen_auth_info_answer_milenage(ue_ctx, k_asme, autn, rand, xres);
-      break;
+  std::lock_guard<std::mutex> lock(auth_mutex);
+  if (not ue_ctx->auth_vectors.empty()) {
+    const hss_auth_vector_t& vec = ue_ctx->auth_vectors.front();
+    memcpy(k_asme, vec.k_asme, sizeof(vec.k_asme));
+    memcpy(autn, vec.autn, sizeof(vec.autn));
+    memcpy(rand, vec.rand, sizeof(vec.rand));
+    memcpy(xres, vec.xres, sizeof(vec.xres));
+    ue_ctx->set_last_rand(vec.rand);
+    ue_ctx->auth_vectors.pop_front();
+    m_logger.debug("Using pre-generated AUTH info, %zd left", ue_ctx->auth_vectors.size());
+  } else {
+    switch (ue_ctx->algo) {
+      case HSS_ALGO_XOR:
+        gen_auth_info_answer_xor(ue_ctx, k_asme, autn, rand, xres);
+        break;
+      case HSS_ALGO_MILENAGE:
+        gen_auth_info_answer_milenage(ue_ctx, k_asme, autn, rand, xres);
+        break;
+    }
+    increment_ue_sqn(ue_ctx);
+    journal_ue_sqn(ue_ctx);
+    // The vectors in flight now have an older SQN than the one just used
+    ue_ctx->auth_vectors_epoch++;
   }
-  increment_ue_sqn(ue_ctx);
+  request_auth_vectors(ue_ctx);
   return true;
 }
 
+void hss::request_auth_vectors(hss_ue_ctx_t* ue_ctx)
+{
+  // Refill once half of the vectors are used
+  if (nof_auth_vectors == 0 or ue_ctx->auth_vectors_pending or ue_ctx->auth_vectors.size() > nof_auth_vectors / 2) {
+    return;
+  }
+  ue_ctx->auth_vectors_pending = true;
+  auth_refill_queue.push_back(ue_ctx->imsi);
+  auth_cvar.notify_one();
+}
+
+void hss::run_auth_vector_worker()
+{
+  std::unique_lock<std::mutex> lock(auth_mutex);
+  while (true) {
+    auth_cvar.wait(lock, [this]() { return not auth_worker_running or not auth_refill_queue.empty(); });
+    if (not auth_worker_running) {
+      return;
+    }
+    hss_ue_ctx_t* ue_ctx = get_ue_ctx(auth_refill_queue.front());
+    auth_refill_queue.pop_front();
+    ue_ctx->auth_vectors_pending = false;
+    if (ue_ctx->auth_vectors.size() >= nof_auth_vectors) {
+      continue;
+    }
+    uint32_t nof_new = nof_auth_vectors - ue_ctx->auth_vectors.size();
+    uint32_t epoch   = ue_ctx->auth_vectors_epoch;
+
+    // Reserve the SQNs of the new vectors. They are journaled, so that they are never reused, even after a crash
+    hss_ue_ctx_t gen_ctx;
+    gen_ctx.imsi = ue_ctx->imsi;
+    gen_ctx.algo = ue_ctx->algo;
+    memcpy(gen_ctx.key, ue_ctx->key, sizeof(gen_ctx.key));
+    memcpy(gen_ctx.opc, ue_ctx->opc, sizeof(gen_ctx.opc));
+    memcpy(gen_ctx.amf, ue_ctx->amf, sizeof(gen_ctx.amf));
+    gen_ctx.set_sqn(ue_ctx->sqn);
+    for (uint32_t i = 0; i < nof_new; ++i) {
+      increment_sqn(ue_ctx->sqn, ue_ctx->sqn);
+    }
+    journal_ue_sqn(ue_ctx);
+
+    // The AES rounds run without the lock, so that the MME is not held back
+    lock.unlock();
+    std::vector<hss_auth_vector_t> vectors(nof_new);
+    for (hss_auth_vector_t& vec : vectors) {
+      switch (gen_ctx.algo) {
+        case HSS_ALGO_XOR:
+          gen_auth_info_answer_xor(&gen_ctx, vec.k_asme, vec.autn, vec.rand, vec.xres);
+          break;
+        case HSS_ALGO_MILENAGE:
+          gen_auth_info_answer_milenage(&gen_ctx, vec.k_asme, vec.autn, vec.rand, vec.xres);
+          break;
+      }
+      increment_sqn(gen_ctx.sqn, gen_ctx.sqn);
+    }
+    lock.lock();
+
+    // A resync or an on-demand vector overtook these SQNs
+    if (epoch != ue_ctx->auth_vectors_epoch) {
+      m_logger.debug("Discarding %d stale AUTH vectors -- IMSI: %015" PRIu64 "", nof_new, gen_ctx.imsi);
+      request_auth_vectors(ue_ctx);
+      continue;
+    }
+    ue_ctx->auth_vectors.insert(ue_ctx->auth_vectors.end(), vectors.begin(), vectors.end());
+    m_logger.debug("Generated %d AUTH vectors -- IMSI: %015" PRIu64 "", nof_new, gen_ctx.imsi);
+  }
+}
+
+void hss::stop_auth_vector_worker()
+{
+  if (auth_worker == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(auth_mutex);
+    auth_worker_running = false;
+  }
+  auth_cvar.notify_one();
+  auth_worker->wait_thread_finish();
+  auth_worker.reset();
+}
+
 void hss::gen_auth_info_answer_milenage(hss_ue_ctx_t* ue_ctx,
                                         uint8_t*      k_asme,
                                         uint8_t*      autn,
@@ -462,6 +645,7 @@ bool hss::resync_sqn(uint64_t imsi, uint8_t* auts)
     return false;
   }
 
+  std::lock_guard<std::mutex> lock(auth_mutex);
   switch (ue_ctx->algo) {
     case HSS_ALGO_XOR:
       resync_sqn_xor(ue_ctx, auts);
@@ -472,6 +656,12 @@ bool hss::resync_sqn(uint64_t imsi, uint8_t* auts)
   }
 
   increment_seq_after_resync(ue_ctx);
+  journal_ue_sqn(ue_ctx);
+
+  // The vectors generated ahead were built with the SQN the UE rejected
+  ue_ctx->auth_vectors.clear();
+  ue_ctx->auth_vectors_epoch++;
+  request_auth_vectors(ue_ctx);
   return true;
 }
 
@@ -85,8 +85,10 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   string   mme_apn;
   string   encryption_algo;
   string   integrity_algo;
-  uint16_t paging_timer     = 0;
-  uint32_t max_paging_queue = 0;
+  uint16_t paging_timer           = 0;
+  uint32_t max_paging_queue       = 0;
+  uint32_t max_paging_queue_bytes = 0;
+  uint32_t spgw_nof_workers       = 0;
   string   spgw_bind_addr;
   string   sgi_if_addr;
   string   sgi_if_name;
@@ -95,6 +97,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   string   short_net_name;
   bool     request_imeisv;
   string   hss_db_file;
+  uint32_t hss_nof_auth_vectors;
   string   hss_auth_algo;
   string   log_filename;
   string   lac;
@@ -126,11 +129,17 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("mme.paging_timer",    bpo::value<uint16_t>(&paging_timer)->default_value(2),           "Set paging timer value in seconds (T3413)")
     ("mme.request_imeisv",  bpo::value<bool>(&request_imeisv)->default_value(false),         "Enable IMEISV request in Security mode command")
     ("mme.lac",             bpo::value<string>(&lac)->default_value("0x01"),                 "Location Area Code")
+    ("mme.nof_s1ap_workers", bpo::value<uint32_t>(&args->mme_args.nof_s1ap_workers)->default_value(0), "Threads unpacking the S1AP PDUs (0 to unpack them in the MME thread)")
+    ("mme.max_attach_rate",    bpo::value<uint32_t>(&args->mme_args.s1ap_args.max_attach_rate)->default_value(0),     "Attach Requests admitted per second (0 for no limit)")
+    ("mme.max_pending_attach", bpo::value<uint32_t>(&args->mme_args.s1ap_args.max_pending_attach)->default_value(256), "Attach Requests waiting for admission before sending Overload Start to the eNBs")
     ("hss.db_file",         bpo::value<string>(&hss_db_file)->default_value("ue_db.csv"),    ".csv file that stores UE's keys")
+    ("hss.nof_auth_vectors", bpo::value<uint32_t>(&hss_nof_auth_vectors)->default_value(0),  "Authentication vectors generated ahead per UE (0 to disable)")
     ("spgw.gtpu_bind_addr", bpo::value<string>(&spgw_bind_addr)->default_value("127.0.0.1"), "IP address of SP-GW for the S1-U connection")
     ("spgw.sgi_if_addr",    bpo::value<string>(&sgi_if_addr)->default_value("176.16.0.1"),   "IP address of TUN interface for the SGi connection")
     ("spgw.sgi_if_name",    bpo::value<string>(&sgi_if_name)->default_value("srs_spgw_sgi"), "Name of TUN interface for the SGi connection")
     ("spgw.max_paging_queue", bpo::value<uint32_t>(&max_paging_queue)->default_value(100), "Max number of packets in paging queue")
+    ("spgw.max_paging_queue_bytes", bpo::value<uint32_t>(&max_paging_queue_bytes)->default_value(150000), "Max number of bytes in paging queue")
+    ("spgw.nof_workers",      bpo::value<uint32_t>(&spgw_nof_workers)->default_value(1),   "Number of user plane threads of the SP-GW")
 
     ("pcap.enable",   bpo::value<bool>(&args->mme_args.s1ap_args.pcap_enable)->default_value(false),         "Enable S1AP PCAP")
     ("pcap.filename", bpo::value<string>(&args->mme_args.s1ap_args.pcap_filename)->default_value("/tmp/epc.pcap"), "PCAP filename")
@@ -295,7 +304,10 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   args->spgw_args.sgi_if_addr             = sgi_if_addr;
   args->spgw_args.sgi_if_name             = sgi_if_name;
   args->spgw_args.max_paging_queue        = max_paging_queue;
+  args->spgw_args.max_paging_queue_bytes  = max_paging_queue_bytes;
+  args->spgw_args.nof_workers             = spgw_nof_workers;
   args->hss_args.db_file                  = hss_db_file;
+  args->hss_args.nof_auth_vectors         = hss_nof_auth_vectors;
 
   // Apply all_level to any unset layers
   if (vm.count("log.all_level")) {
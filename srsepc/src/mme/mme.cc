@@ -23,6 +23,7 @@
 #include <arpa/inet.h>
 #include <inttypes.h> // for printing uint64_t
 #include <netinet/sctp.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 
@@ -77,6 +78,19 @@ int mme::init(mme_args_t* args)
     exit(-1);
   }
 
+  /*Start the S1AP decoders*/
+  if (args->nof_s1ap_workers > 0) {
+    decoded_event_fd = eventfd(0, EFD_CLOEXEC);
+    if (decoded_event_fd < 0) {
+      m_s1ap_logger.error("Error creating the S1AP decoders event fd: %s", strerror(errno));
+      return -1;
+    }
+    for (uint32_t i = 0; i < args->nof_s1ap_workers; ++i) {
+      s1ap_decoders.emplace_back(new s1ap_decoder(*this));
+      s1ap_decoders.back()->start();
+    }
+  }
+
   /*Log successful initialization*/
   m_s1ap_logger.info("MME Initialized. MCC: 0x%x, MNC: 0x%x", args->s1ap_args.mcc, args->s1ap_args.mnc);
   srsran::console("MME Initialized. MCC: 0x%x, MNC: 0x%x\n", args->s1ap_args.mcc, args->s1ap_args.mnc);
@@ -92,9 +106,86 @@ void mme::stop()
     thread_cancel();
     wait_thread_finish();
   }
+  stop_s1ap_decoders();
   return;
 }
 
+void mme::stop_s1ap_decoders()
+{
+  // A null PDU tells the decoder to exit
+  for (std::unique_ptr<s1ap_decoder>& decoder : s1ap_decoders) {
+    decoder->queue.push(nullptr);
+    decoder->wait_thread_finish();
+  }
+  s1ap_decoders.clear();
+  decoded_pdus.clear();
+  if (decoded_event_fd >= 0) {
+    close(decoded_event_fd);
+    decoded_event_fd = -1;
+  }
+}
+
+void mme::s1ap_decoder::run_thread()
+{
+  while (true) {
+    s1ap_rx_pdu_ptr rx_pdu = queue.wait_pop();
+    if (rx_pdu == nullptr) {
+      return;
+    }
+    if (not rx_pdu->notification) {
+      asn1::cbit_ref bref(rx_pdu->pdu->msg, rx_pdu->pdu->N_bytes);
+      rx_pdu->decoded = rx_pdu->msg.unpack(bref) == asn1::SRSASN_SUCCESS;
+    }
+    {
+      std::lock_guard<std::mutex> lock(parent.decoded_mutex);
+      parent.decoded_pdus.push_back(std::move(rx_pdu));
+    }
+    uint64_t event = 1;
+    if (write(parent.decoded_event_fd, &event, sizeof(event)) != sizeof(event)) {
+      parent.m_s1ap_logger.error("Error waking up the MME thread: %s", strerror(errno));
+    }
+  }
+}
+
+void mme::handle_decoded_s1ap_pdus()
+{
+  uint64_t nof_events;
+  if (read(decoded_event_fd, &nof_events, sizeof(nof_events)) != sizeof(nof_events)) {
+    m_s1ap_logger.error("Error reading the S1AP decoders event fd: %s", strerror(errno));
+  }
+  std::deque<s1ap_rx_pdu_ptr> pdus;
+  {
+    std::lock_guard<std::mutex> lock(decoded_mutex);
+    pdus.swap(decoded_pdus);
+  }
+  for (s1ap_rx_pdu_ptr& rx_pdu : pdus) {
+    handle_s1ap_rx_pdu(*rx_pdu);
+  }
+}
+
+void mme::handle_s1ap_rx_pdu(s1ap_rx_pdu_t& rx_pdu)
+{
+  if (rx_pdu.notification) {
+    // Received notification
+    union sctp_notification* notification = (union sctp_notification*)rx_pdu.pdu->msg;
+    m_s1ap_logger.debug("SCTP Notification %d", notification->sn_header.sn_type);
+    if (notification->sn_header.sn_type == SCTP_SHUTDOWN_EVENT) {
+      m_s1ap_logger.info("SCTP Association Shutdown. Association: %d", rx_pdu.sri.sinfo_assoc_id);
+      srsran::console("SCTP Association Shutdown. Association: %d\n", rx_pdu.sri.sinfo_assoc_id);
+      m_s1ap->delete_enb_ctx(rx_pdu.sri.sinfo_assoc_id);
+    }
+    return;
+  }
+
+  // Received data
+  m_s1ap_logger.info("Received S1AP msg. Size: %d", rx_pdu.pdu->N_bytes);
+  if (s1ap_decoders.empty()) {
+    m_s1ap->handle_s1ap_rx_pdu(rx_pdu.pdu.get(), &rx_pdu.sri);
+  } else {
+    m_s1ap->handle_s1ap_decoded_pdu(rx_pdu.pdu.get(), rx_pdu.decoded ? &rx_pdu.msg : nullptr, &rx_pdu.sri);
+  }
+}
+
 void mme::run_thread()
 {
   srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer("mme::run_thread");
@@ -119,12 +210,25 @@ void mme::run_thread()
   int s11   = m_mme_gtpc->get_s11();
 
   while (m_running) {
+    if (pdu == nullptr) {
+      // The last one was handed over to the S1AP decoders
+      pdu = srsran::make_byte_buffer("mme::run_thread");
+      if (pdu == nullptr) {
+        m_s1ap_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+        usleep(1000);
+        continue;
+      }
+    }
     pdu->clear();
     int max_fd = std::max(s1mme, s11);
 
     FD_ZERO(&m_set);
     FD_SET(s1mme, &m_set);
     FD_SET(s11, &m_set);
+    if (decoded_event_fd >= 0) {
+      FD_SET(decoded_event_fd, &m_set);
+      max_fd = std::max(max_fd, decoded_event_fd);
+    }
 
     // Add timers to select
     for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end(); ++it) {
@@ -133,8 +237,12 @@ void mme::run_thread()
       m_s1ap_logger.debug("Adding Timer fd %d to fd_set", it->fd);
     }
 
+    // Wake up in time to admit the Attach Requests held back by the admission control
+    int            attach_wait_ms = m_s1ap->m_s1ap_nas_transport->handle_pending_attach_requests();
+    struct timeval attach_wait    = {attach_wait_ms / 1000, (attach_wait_ms % 1000) * 1000};
+
     m_s1ap_logger.debug("Waiting for S1-MME or S11 Message");
-    int n = select(max_fd + 1, &m_set, NULL, NULL, NULL);
+    int n = select(max_fd + 1, &m_set, NULL, NULL, attach_wait_ms < 0 ? NULL : &attach_wait);
     if (n == -1) {
       m_s1ap_logger.error("Error from select");
     } else if (n) {
@@ -146,23 +254,24 @@ void mme::run_thread()
         } else if (rd_sz == -1 && errno == EAGAIN) {
           m_s1ap_logger.debug("Socket timeout reached");
         } else {
-          if (msg_flags & MSG_NOTIFICATION) {
-            // Received notification
-            union sctp_notification* notification = (union sctp_notification*)pdu->msg;
-            m_s1ap_logger.debug("SCTP Notification %d", notification->sn_header.sn_type);
-            if (notification->sn_header.sn_type == SCTP_SHUTDOWN_EVENT) {
-              m_s1ap_logger.info("SCTP Association Shutdown. Association: %d", sri.sinfo_assoc_id);
-              srsran::console("SCTP Association Shutdown. Association: %d\n", sri.sinfo_assoc_id);
-              m_s1ap->delete_enb_ctx(sri.sinfo_assoc_id);
-            }
+          pdu->N_bytes           = rd_sz;
+          s1ap_rx_pdu_ptr rx_pdu = s1ap_rx_pdu_ptr(new s1ap_rx_pdu_t);
+          rx_pdu->pdu            = std::move(pdu);
+          rx_pdu->sri            = sri;
+          rx_pdu->notification   = (msg_flags & MSG_NOTIFICATION) != 0;
+          if (s1ap_decoders.empty()) {
+            handle_s1ap_rx_pdu(*rx_pdu);
+            pdu = std::move(rx_pdu->pdu);
           } else {
-            // Received data
-            pdu->N_bytes = rd_sz;
-            m_s1ap_logger.info("Received S1AP msg. Size: %d", pdu->N_bytes);
-            m_s1ap->handle_s1ap_rx_pdu(pdu.get(), &sri);
+            // All the PDUs of an association go through the same decoder, so that they are handled in order
+            s1ap_decoders[sri.sinfo_assoc_id % s1ap_decoders.size()]->queue.push(std::move(rx_pdu));
           }
         }
       }
+      // Handle the S1AP PDUs unpacked by the decoders
+      if (decoded_event_fd >= 0 && FD_ISSET(decoded_event_fd, &m_set)) {
+        handle_decoded_s1ap_pdus();
+      }
       // Handle S11
       if (FD_ISSET(s11, &m_set)) {
         pdu->N_bytes = recvfrom(s11, pdu->msg, sz, 0, NULL, NULL);
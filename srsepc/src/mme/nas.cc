@@ -80,11 +80,11 @@ bool nas::handle_attach_request(uint32_t                enb_ue_s1ap_id,
                                 const nas_init_t&       args,
                                 const nas_if_t&         itf)
 {
-  uint32_t                                       m_tmsi      = 0;
-  uint64_t                                       imsi        = 0;
-  LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT           attach_req  = {};
-  LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT pdn_con_req = {};
-  auto&                                          nas_logger  = srslog::fetch_basic_logger("NAS");
+  uint32_t                                        m_tmsi      = 0;
+  uint64_t                                        imsi        = 0;
+  LIBLTE_MME_ATTACH_REQUEST_VIEW_STRUCT           attach_req  = {};
+  LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_VIEW_STRUCT pdn_con_req = {};
+  auto&                                           nas_logger  = srslog::fetch_basic_logger("NAS");
 
   // Interfaces
   s1ap_interface_nas* s1ap = itf.s1ap;
@@ -92,13 +92,13 @@ bool nas::handle_attach_request(uint32_t                enb_ue_s1ap_id,
   gtpc_interface_nas* gtpc = itf.gtpc;
 
   // Get NAS Attach Request and PDN connectivity request messages
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_attach_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &attach_req);
+  LIBLTE_ERROR_ENUM err = liblte_mme_parse_attach_request_msg(nas_rx->msg, nas_rx->N_bytes, &attach_req);
   if (err != LIBLTE_SUCCESS) {
     nas_logger.error("Error unpacking NAS attach request. Error: %s", liblte_error_text[err]);
     return false;
   }
   // Get PDN Connectivity Request*/
-  err = liblte_mme_unpack_pdn_connectivity_request_msg(&attach_req.esm_msg, &pdn_con_req);
+  err = liblte_mme_parse_pdn_connectivity_request_msg(attach_req.esm_msg, attach_req.esm_msg_len, &pdn_con_req);
   if (err != LIBLTE_SUCCESS) {
     nas_logger.error("Error unpacking NAS PDN Connectivity Request. Error: %s", liblte_error_text[err]);
     return false;
@@ -202,12 +202,12 @@ bool nas::handle_attach_request(uint32_t                enb_ue_s1ap_id,
   return true;
 }
 
-bool nas::handle_imsi_attach_request_unknown_ue(uint32_t                                              enb_ue_s1ap_id,
-                                                struct sctp_sndrcvinfo*                               enb_sri,
-                                                const LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT&           attach_req,
-                                                const LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT& pdn_con_req,
-                                                const nas_init_t&                                     args,
-                                                const nas_if_t&                                       itf)
+bool nas::handle_imsi_attach_request_unknown_ue(uint32_t                                               enb_ue_s1ap_id,
+                                                struct sctp_sndrcvinfo*                                enb_sri,
+                                                const LIBLTE_MME_ATTACH_REQUEST_VIEW_STRUCT&           attach_req,
+                                                const LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_VIEW_STRUCT& pdn_con_req,
+                                                const nas_init_t&                                      args,
+                                                const nas_if_t&                                        itf)
 {
   nas*                         nas_ctx;
   srsran::unique_byte_buffer_t nas_tx;
@@ -302,14 +302,14 @@ bool nas::handle_imsi_attach_request_unknown_ue(uint32_t
   return true;
 }
 
-bool nas::handle_imsi_attach_request_known_ue(nas*                                                  nas_ctx,
-                                              uint32_t                                              enb_ue_s1ap_id,
-                                              struct sctp_sndrcvinfo*                               enb_sri,
-                                              const LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT&           attach_req,
-                                              const LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT& pdn_con_req,
-                                              srsran::byte_buffer_t*                                nas_rx,
-                                              const nas_init_t&                                     args,
-                                              const nas_if_t&                                       itf)
+bool nas::handle_imsi_attach_request_known_ue(nas*                                                   nas_ctx,
+                                              uint32_t                                               enb_ue_s1ap_id,
+                                              struct sctp_sndrcvinfo*                                enb_sri,
+                                              const LIBLTE_MME_ATTACH_REQUEST_VIEW_STRUCT&           attach_req,
+                                              const LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_VIEW_STRUCT& pdn_con_req,
+                                              srsran::byte_buffer_t*                                 nas_rx,
+                                              const nas_init_t&                                      args,
+                                              const nas_if_t&                                        itf)
 {
   bool  err;
   auto& nas_logger = srslog::fetch_basic_logger("NAS");
@@ -334,12 +334,12 @@ bool nas::handle_imsi_attach_request_known_ue(nas*
   return err;
 }
 
-bool nas::handle_guti_attach_request_unknown_ue(uint32_t                                              enb_ue_s1ap_id,
-                                                struct sctp_sndrcvinfo*                               enb_sri,
-                                                const LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT&           attach_req,
-                                                const LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT& pdn_con_req,
-                                                const nas_init_t&                                     args,
-                                                const nas_if_t&                                       itf)
+bool nas::handle_guti_attach_request_unknown_ue(uint32_t                                               enb_ue_s1ap_id,
+                                                struct sctp_sndrcvinfo*                                enb_sri,
+                                                const LIBLTE_MME_ATTACH_REQUEST_VIEW_STRUCT&           attach_req,
+                                                const LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_VIEW_STRUCT& pdn_con_req,
+                                                const nas_init_t&                                      args,
+                                                const nas_if_t&                                        itf)
 
 {
   nas*                         nas_ctx;
@@ -411,14 +411,14 @@ bool nas::handle_guti_attach_request_unknown_ue(uint32_t
   return true;
 }
 
-bool nas::handle_guti_attach_request_known_ue(nas*                                                  nas_ctx,
-                                              uint32_t                                              enb_ue_s1ap_id,
-                                              struct sctp_sndrcvinfo*                               enb_sri,
-                                              const LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT&           attach_req,
-                                              const LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT& pdn_con_req,
-                                              srsran::byte_buffer_t*                                nas_rx,
-                                              const nas_init_t&                                     args,
-                                              const nas_if_t&                                       itf)
+bool nas::handle_guti_attach_request_known_ue(nas*                                                   nas_ctx,
+                                              uint32_t                                               enb_ue_s1ap_id,
+                                              struct sctp_sndrcvinfo*                                enb_sri,
+                                              const LIBLTE_MME_ATTACH_REQUEST_VIEW_STRUCT&           attach_req,
+                                              const LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_VIEW_STRUCT& pdn_con_req,
+                                              srsran::byte_buffer_t*                                 nas_rx,
+                                              const nas_init_t&                                      args,
+                                              const nas_if_t&                                        itf)
 {
   bool                         msg_valid = false;
   srsran::unique_byte_buffer_t nas_tx;
@@ -861,19 +861,19 @@ bool nas::handle_tracking_area_update_request(uint32_t                m_tmsi,
  ***************************************/
 bool nas::handle_attach_request(srsran::byte_buffer_t* nas_rx)
 {
-  uint32_t                                       m_tmsi      = 0;
-  uint64_t                                       imsi        = 0;
-  LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT           attach_req  = {};
-  LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT pdn_con_req = {};
+  uint32_t                                        m_tmsi      = 0;
+  uint64_t                                        imsi        = 0;
+  LIBLTE_MME_ATTACH_REQUEST_VIEW_STRUCT           attach_req  = {};
+  LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_VIEW_STRUCT pdn_con_req = {};
 
   // Get NAS Attach Request and PDN connectivity request messages
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_attach_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &attach_req);
+  LIBLTE_ERROR_ENUM err = liblte_mme_parse_attach_request_msg(nas_rx->msg, nas_rx->N_bytes, &attach_req);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error unpacking NAS attach request. Error: %s", liblte_error_text[err]);
     return false;
   }
   // Get PDN Connectivity Request*/
-  err = liblte_mme_unpack_pdn_connectivity_request_msg(&attach_req.esm_msg, &pdn_con_req);
+  err = liblte_mme_parse_pdn_connectivity_request_msg(attach_req.esm_msg, attach_req.esm_msg_len, &pdn_con_req);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error unpacking NAS PDN Connectivity Request. Error: %s", liblte_error_text[err]);
     return false;
@@ -116,7 +116,7 @@ void s1ap::stop()
     m_active_enbs.erase(enb_it++);
   }
 
-  std::map<uint64_t, nas*>::iterator ue_it = m_imsi_to_nas_ctx.begin();
+  std::unordered_map<uint64_t, nas*>::iterator ue_it = m_imsi_to_nas_ctx.begin();
   while (ue_it != m_imsi_to_nas_ctx.end()) {
     m_logger.info("Deleting UE EMM context. IMSI: %015" PRIu64 "", ue_it->first);
     srsran::console("Deleting UE EMM context. IMSI: %015" PRIu64 "\n", ue_it->first);
@@ -215,7 +215,12 @@ bool s1ap::s1ap_tx_pdu(const asn1::s1ap::s1ap_pdu_c& pdu, struct sctp_sndrcvinfo
   }
   buf->N_bytes = bref.distance_bytes();
 
-  ssize_t n_sent = sctp_send(m_s1mme, buf->msg, buf->N_bytes, enb_sri, MSG_NOSIGNAL);
+  return s1ap_tx_pdu(*buf, enb_sri);
+}
+
+bool s1ap::s1ap_tx_pdu(const srsran::byte_buffer_t& pdu, struct sctp_sndrcvinfo* enb_sri)
+{
+  ssize_t n_sent = sctp_send(m_s1mme, pdu.msg, pdu.N_bytes, enb_sri, MSG_NOSIGNAL);
   if (n_sent == -1) {
     srsran::console("Failed to send S1AP PDU. Error: %s\n", strerror(errno));
     m_logger.error("Failed to send S1AP PDU. Error: %s ", strerror(errno));
@@ -223,7 +228,7 @@ bool s1ap::s1ap_tx_pdu(const asn1::s1ap::s1ap_pdu_c& pdu, struct sctp_sndrcvinfo
   }
 
   if (m_pcap_enable) {
-    m_pcap.write_s1ap(buf->msg, buf->N_bytes);
+    m_pcap.write_s1ap(pdu.msg, pdu.N_bytes);
   }
 
   return true;
@@ -231,34 +236,82 @@ bool s1ap::s1ap_tx_pdu(const asn1::s1ap::s1ap_pdu_c& pdu, struct sctp_sndrcvinfo
 
 void s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri)
 {
-  // Save PCAP
-  if (m_pcap_enable) {
-    m_pcap.write_s1ap(pdu->msg, pdu->N_bytes);
+  if (handle_s1ap_rx_pdu_fast(pdu, enb_sri)) {
+    return;
   }
 
+  // The previous PDU is gone, so its storage can be reused. What is copied out of the PDU while it is handled is
+  // allocated in the heap, as only the unpacking takes place within the arena scope
+  m_rx_arena.reset();
+
   // Get PDU type
   s1ap_pdu_t     rx_pdu;
   asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
-  if (rx_pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+  bool           decoded;
+  {
+    asn1::decode_arena_scope arena_scope(m_rx_arena);
+    decoded = rx_pdu.unpack(bref) == asn1::SRSASN_SUCCESS;
+  }
+  handle_s1ap_decoded_pdu(pdu, decoded ? &rx_pdu : nullptr, enb_sri);
+}
+
+bool s1ap::handle_s1ap_rx_pdu_fast(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri)
+{
+  // Uplink NAS Transports only need the UE S1AP IDs and the NAS-PDU, which is read in place
+  asn1::protocol_ie_index index;
+  if (index.index(pdu->msg, pdu->N_bytes) != asn1::SRSASN_SUCCESS ||
+      index.pdu_type() != s1ap_pdu_t::types_opts::init_msg || index.proc_code() != ASN1_S1AP_ID_UL_NAS_TRANSPORT) {
+    return false;
+  }
+  asn1::s1ap::mme_ue_s1ap_id_t mme_ue_s1ap_id;
+  asn1::s1ap::enb_ue_s1ap_id_t enb_ue_s1ap_id;
+  const uint8_t*               nas_pdu;
+  uint32_t                     nas_pdu_len;
+  if (index.unpack_ie(ASN1_S1AP_ID_MME_UE_S1AP_ID, mme_ue_s1ap_id) != asn1::SRSASN_SUCCESS ||
+      index.unpack_ie(ASN1_S1AP_ID_ENB_UE_S1AP_ID, enb_ue_s1ap_id) != asn1::SRSASN_SUCCESS ||
+      index.get_octstring_ie(ASN1_S1AP_ID_NAS_PDU, nas_pdu, nas_pdu_len) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+
+  if (m_pcap_enable) {
+    m_pcap.write_s1ap(pdu->msg, pdu->N_bytes);
+  }
+  m_logger.info("Received Initiating PDU");
+  m_logger.info("Received Uplink NAS Transport Message.");
+  m_s1ap_nas_transport->handle_uplink_nas_transport(
+      enb_ue_s1ap_id.value, mme_ue_s1ap_id.value, srsran::const_span<uint8_t>(nas_pdu, nas_pdu_len), enb_sri);
+  return true;
+}
+
+void s1ap::handle_s1ap_decoded_pdu(srsran::byte_buffer_t*  pdu,
+                                   const s1ap_pdu_t*       rx_pdu,
+                                   struct sctp_sndrcvinfo* enb_sri)
+{
+  // Save PCAP
+  if (m_pcap_enable) {
+    m_pcap.write_s1ap(pdu->msg, pdu->N_bytes);
+  }
+
+  if (rx_pdu == nullptr) {
     m_logger.error("Failed to unpack received PDU");
     return;
   }
 
-  switch (rx_pdu.type().value) {
+  switch (rx_pdu->type().value) {
     case s1ap_pdu_t::types_opts::init_msg:
       m_logger.info("Received Initiating PDU");
-      handle_initiating_message(rx_pdu.init_msg(), enb_sri);
+      handle_initiating_message(rx_pdu->init_msg(), enb_sri);
       break;
     case s1ap_pdu_t::types_opts::successful_outcome:
       m_logger.info("Received Succeseful Outcome PDU");
-      handle_successful_outcome(rx_pdu.successful_outcome());
+      handle_successful_outcome(rx_pdu->successful_outcome());
       break;
     case s1ap_pdu_t::types_opts::unsuccessful_outcome:
       m_logger.info("Received Unsucceseful Outcome PDU");
       // TODO handle_unsuccessfuloutcome(&rx_pdu.choice.unsuccessfulOutcome);
       break;
     default:
-      m_logger.warning("Unhandled PDU type %d", rx_pdu.type().value);
+      m_logger.warning("Unhandled PDU type %d", rx_pdu->type().value);
   }
 }
 
@@ -348,6 +401,7 @@ void s1ap::delete_enb_ctx(int32_t assoc_id)
 
   // Delete connected UEs ctx
   release_ues_ecm_ctx_in_enb(assoc_id);
+  m_s1ap_nas_transport->drop_pending_attach_requests(assoc_id);
 
   // Delete eNB
   delete it_ctx->second;
@@ -359,13 +413,13 @@ void s1ap::delete_enb_ctx(int32_t assoc_id)
 // UE Context Management
 bool s1ap::add_nas_ctx_to_imsi_map(nas* nas_ctx)
 {
-  std::map<uint64_t, nas*>::iterator ctx_it = m_imsi_to_nas_ctx.find(nas_ctx->m_emm_ctx.imsi);
+  std::unordered_map<uint64_t, nas*>::iterator ctx_it = m_imsi_to_nas_ctx.find(nas_ctx->m_emm_ctx.imsi);
   if (ctx_it != m_imsi_to_nas_ctx.end()) {
     m_logger.error("UE Context already exists. IMSI %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
     return false;
   }
   if (nas_ctx->m_ecm_ctx.mme_ue_s1ap_id != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+    auto ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
     if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
       m_logger.error("Context identified with IMSI does not match context identified by MME UE S1AP Id.");
       return false;
@@ -382,13 +436,13 @@ bool s1ap::add_nas_ctx_to_mme_ue_s1ap_id_map(nas* nas_ctx)
     m_logger.error("Could not add UE context to MME UE S1AP map. MME UE S1AP ID 0 is not valid.");
     return false;
   }
-  std::map<uint32_t, nas*>::iterator ctx_it = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+  auto ctx_it = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
   if (ctx_it != m_mme_ue_s1ap_id_to_nas_ctx.end()) {
     m_logger.error("UE Context already exists. MME UE S1AP Id %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
     return false;
   }
   if (nas_ctx->m_emm_ctx.imsi != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+    auto ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
     if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
       m_logger.error("Context identified with MME UE S1AP Id does not match context identified by IMSI.");
       return false;
@@ -418,7 +472,7 @@ bool s1ap::add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)
 
 nas* s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
 {
-  std::map<uint32_t, nas*>::iterator it = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
+  std::unordered_map<uint32_t, nas*>::iterator it = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
   if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
     return NULL;
   } else {
@@ -428,7 +482,7 @@ nas* s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
 
 nas* s1ap::find_nas_ctx_from_imsi(uint64_t imsi)
 {
-  std::map<uint64_t, nas*>::iterator it = m_imsi_to_nas_ctx.find(imsi);
+  std::unordered_map<uint64_t, nas*>::iterator it = m_imsi_to_nas_ctx.find(imsi);
   if (it == m_imsi_to_nas_ctx.end()) {
     return NULL;
   } else {
@@ -445,7 +499,7 @@ void s1ap::release_ues_ecm_ctx_in_enb(int32_t enb_assoc)
     srsran::console("No UEs to be released\n");
   } else {
     while (ue_id != ues_in_enb->second.end()) {
-      std::map<uint32_t, nas*>::iterator nas_ctx = m_mme_ue_s1ap_id_to_nas_ctx.find(*ue_id);
+      std::unordered_map<uint32_t, nas*>::iterator nas_ctx = m_mme_ue_s1ap_id_to_nas_ctx.find(*ue_id);
       emm_ctx_t*                         emm_ctx = &nas_ctx->second->m_emm_ctx;
       ecm_ctx_t*                         ecm_ctx = &nas_ctx->second->m_ecm_ctx;
 
@@ -520,14 +574,14 @@ bool s1ap::delete_ue_ctx(uint64_t imsi)
 // UE Bearer Managment
 void s1ap::activate_eps_bearer(uint64_t imsi, uint8_t ebi)
 {
-  std::map<uint64_t, nas*>::iterator ue_ctx_it = m_imsi_to_nas_ctx.find(imsi);
+  std::unordered_map<uint64_t, nas*>::iterator ue_ctx_it = m_imsi_to_nas_ctx.find(imsi);
   if (ue_ctx_it == m_imsi_to_nas_ctx.end()) {
     m_logger.error("Could not activate EPS bearer: Could not find UE context");
     return;
   }
   // Make sure NAS is active
   uint32_t                           mme_ue_s1ap_id = ue_ctx_it->second->m_ecm_ctx.mme_ue_s1ap_id;
-  std::map<uint32_t, nas*>::iterator it             = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
+  std::unordered_map<uint32_t, nas*>::iterator it             = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
   if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
     m_logger.error("Could not activate EPS bearer: ECM context seems to be missing");
     return;
@@ -567,7 +621,7 @@ uint32_t s1ap::allocate_m_tmsi(uint64_t imsi)
 
 uint64_t s1ap::find_imsi_from_m_tmsi(uint32_t m_tmsi)
 {
-  std::map<uint32_t, uint64_t>::iterator it = m_tmsi_to_imsi.find(m_tmsi);
+  std::unordered_map<uint32_t, uint64_t>::iterator it = m_tmsi_to_imsi.find(m_tmsi);
   if (it != m_tmsi_to_imsi.end()) {
     m_logger.debug("Found IMSI %015" PRIu64 " from M-TMSI 0x%x", it->second, m_tmsi);
     return it->second;
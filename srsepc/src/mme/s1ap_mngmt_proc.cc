@@ -233,4 +233,39 @@ bool s1ap_mngmt_proc::send_s1_setup_response(const s1ap_args_t& s1ap_args, struc
   return true;
 }
 
+bool s1ap_mngmt_proc::send_overload_start(asn1::s1ap::overload_action_opts::options action)
+{
+  s1ap_pdu_t tx_pdu;
+  tx_pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_OVERLOAD_START);
+
+  asn1::s1ap::overload_start_s& overload_start                 = tx_pdu.init_msg().value.overload_start();
+  overload_start->overload_resp.value.overload_action().value = action;
+
+  bool ret = true;
+  for (std::map<uint16_t, enb_ctx_t*>::iterator it = m_s1ap->m_active_enbs.begin(); it != m_s1ap->m_active_enbs.end();
+       it++) {
+    if (!m_s1ap->s1ap_tx_pdu(tx_pdu, &it->second->sri)) {
+      m_logger.error("Error sending Overload Start. eNB Id: 0x%x", it->second->enb_id);
+      ret = false;
+    }
+  }
+  return ret;
+}
+
+bool s1ap_mngmt_proc::send_overload_stop()
+{
+  s1ap_pdu_t tx_pdu;
+  tx_pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_OVERLOAD_STOP);
+
+  bool ret = true;
+  for (std::map<uint16_t, enb_ctx_t*>::iterator it = m_s1ap->m_active_enbs.begin(); it != m_s1ap->m_active_enbs.end();
+       it++) {
+    if (!m_s1ap->s1ap_tx_pdu(tx_pdu, &it->second->sri)) {
+      m_logger.error("Error sending Overload Stop. eNB Id: 0x%x", it->second->enb_id);
+      ret = false;
+    }
+  }
+  return ret;
+}
+
 } // namespace srsepc
@@ -92,6 +92,104 @@ void s1ap_nas_transport::init()
 
 bool s1ap_nas_transport::handle_initial_ue_message(const asn1::s1ap::init_ue_msg_s& init_ue,
                                                    struct sctp_sndrcvinfo*          enb_sri)
+{
+  if (m_s1ap->m_s1ap_args.max_attach_rate == 0) {
+    return process_initial_ue_message(init_ue, enb_sri);
+  }
+
+  // Only the Attach Requests go through the admission control, the other procedures concern already attached UEs
+  uint8_t                      pd, msg_type;
+  srsran::unique_byte_buffer_t nas_msg = srsran::make_byte_buffer();
+  if (nas_msg == nullptr) {
+    m_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+    return false;
+  }
+  memcpy(nas_msg->msg, init_ue->nas_pdu.value.data(), init_ue->nas_pdu.value.size());
+  nas_msg->N_bytes = init_ue->nas_pdu.value.size();
+  liblte_mme_parse_msg_header((LIBLTE_BYTE_MSG_STRUCT*)nas_msg.get(), &pd, &msg_type);
+  if (msg_type != LIBLTE_MME_MSG_TYPE_ATTACH_REQUEST || (m_pending_attach.empty() && admit_attach_request())) {
+    return process_initial_ue_message(init_ue, enb_sri);
+  }
+
+  // The UE retries the attach when T3410 expires, if its Attach Request gets dropped
+  if (m_pending_attach.size() >= m_s1ap->m_s1ap_args.max_pending_attach) {
+    m_logger.warning("Dropping Attach Request, %zd are waiting for admission. eNB-UE S1AP Id: %d",
+                     m_pending_attach.size(),
+                     init_ue->enb_ue_s1ap_id.value.value);
+    return false;
+  }
+  m_logger.info("Holding back Attach Request, %zd are waiting for admission. eNB-UE S1AP Id: %d",
+                m_pending_attach.size(),
+                init_ue->enb_ue_s1ap_id.value.value);
+  m_pending_attach.emplace_back();
+  m_pending_attach.back().init_ue = init_ue;
+  m_pending_attach.back().enb_sri = *enb_sri;
+  update_overload_state();
+  return true;
+}
+
+int s1ap_nas_transport::handle_pending_attach_requests()
+{
+  while (!m_pending_attach.empty() && admit_attach_request()) {
+    pending_attach_request_t req = std::move(m_pending_attach.front());
+    m_pending_attach.pop_front();
+    process_initial_ue_message(req.init_ue, &req.enb_sri);
+  }
+  update_overload_state();
+  if (m_pending_attach.empty()) {
+    return -1;
+  }
+  // Time until the next token is available
+  return std::max(1, (int)std::ceil((1 - m_attach_tokens) * 1000 / m_s1ap->m_s1ap_args.max_attach_rate));
+}
+
+void s1ap_nas_transport::drop_pending_attach_requests(int32_t enb_assoc)
+{
+  for (std::deque<pending_attach_request_t>::iterator it = m_pending_attach.begin(); it != m_pending_attach.end();) {
+    if (it->enb_sri.sinfo_assoc_id == enb_assoc) {
+      it = m_pending_attach.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  update_overload_state();
+}
+
+bool s1ap_nas_transport::admit_attach_request()
+{
+  uint32_t                              rate = m_s1ap->m_s1ap_args.max_attach_rate;
+  std::chrono::steady_clock::time_point now  = std::chrono::steady_clock::now();
+
+  // Bursts of up to 100 ms worth of Attach Requests are admitted at once
+  double elapsed     = std::chrono::duration<double>(now - m_attach_tokens_tp).count();
+  m_attach_tokens    = std::min(m_attach_tokens + elapsed * rate, std::max(1.0, rate / 10.0));
+  m_attach_tokens_tp = now;
+  if (m_attach_tokens < 1) {
+    return false;
+  }
+  m_attach_tokens -= 1;
+  return true;
+}
+
+void s1ap_nas_transport::update_overload_state()
+{
+  uint32_t max_pending = m_s1ap->m_s1ap_args.max_pending_attach;
+  if (!m_overload && max_pending > 0 && m_pending_attach.size() >= max_pending) {
+    srsran::console("MME overloaded, asking the eNBs to reject new RRC connections\n");
+    m_logger.warning("MME overloaded, %zd Attach Requests are waiting for admission. Sending Overload Start",
+                     m_pending_attach.size());
+    m_s1ap->m_s1ap_mngmt_proc->send_overload_start(asn1::s1ap::overload_action_opts::reject_rrc_cr_sig);
+    m_overload = true;
+  } else if (m_overload && m_pending_attach.size() <= max_pending / 2) {
+    srsran::console("MME no longer overloaded\n");
+    m_logger.info("MME no longer overloaded. Sending Overload Stop");
+    m_s1ap->m_s1ap_mngmt_proc->send_overload_stop();
+    m_overload = false;
+  }
+}
+
+bool s1ap_nas_transport::process_initial_ue_message(const asn1::s1ap::init_ue_msg_s& init_ue,
+                                                    struct sctp_sndrcvinfo*          enb_sri)
 {
   bool                         err, mac_valid;
   uint8_t                      pd, msg_type, sec_hdr_type;
@@ -143,10 +241,18 @@ bool s1ap_nas_transport::handle_initial_ue_message(const asn1::s1ap::init_ue_msg
 
 bool s1ap_nas_transport::handle_uplink_nas_transport(const asn1::s1ap::ul_nas_transport_s& ul_xport,
                                                      struct sctp_sndrcvinfo*               enb_sri)
+{
+  srsran::const_span<uint8_t> nas_pdu(ul_xport->nas_pdu.value.data(), ul_xport->nas_pdu.value.size());
+  return handle_uplink_nas_transport(
+      ul_xport->enb_ue_s1ap_id.value.value, ul_xport->mme_ue_s1ap_id.value.value, nas_pdu, enb_sri);
+}
+
+bool s1ap_nas_transport::handle_uplink_nas_transport(uint32_t                    enb_ue_s1ap_id,
+                                                     uint32_t                    mme_ue_s1ap_id,
+                                                     srsran::const_span<uint8_t> nas_pdu,
+                                                     struct sctp_sndrcvinfo*     enb_sri)
 {
   uint8_t  pd, msg_type, sec_hdr_type;
-  uint32_t enb_ue_s1ap_id      = ul_xport->enb_ue_s1ap_id.value.value;
-  uint32_t mme_ue_s1ap_id      = ul_xport->mme_ue_s1ap_id.value.value;
   bool     mac_valid           = false;
   bool     increase_ul_nas_cnt = true;
 
@@ -164,8 +270,12 @@ bool s1ap_nas_transport::handle_uplink_nas_transport(const asn1::s1ap::ul_nas_tr
 
   // Parse NAS message header
   srsran::unique_byte_buffer_t nas_msg = srsran::make_byte_buffer();
-  memcpy(nas_msg->msg, ul_xport->nas_pdu.value.data(), ul_xport->nas_pdu.value.size());
-  nas_msg->N_bytes   = ul_xport->nas_pdu.value.size();
+  if (nas_msg == nullptr || nas_pdu.size() > nas_msg->get_tailroom()) {
+    m_logger.error("Couldn't store the uplink NAS PDU of %zd bytes", nas_pdu.size());
+    return false;
+  }
+  memcpy(nas_msg->msg, nas_pdu.data(), nas_pdu.size());
+  nas_msg->N_bytes   = nas_pdu.size();
   bool msg_encrypted = false;
 
   // Parse the message security header
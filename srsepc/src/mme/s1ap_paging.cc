@@ -85,10 +85,23 @@ bool s1ap_paging::send_paging(uint64_t imsi, uint16_t erab_to_setup)
     return false;
   }
 
+  // The Paging PDU is the same for all the eNBs, so it is only encoded once
+  srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+  if (buf == nullptr) {
+    m_logger.error("Fatal Error: Couldn't allocate buffer for S1AP Paging.");
+    return false;
+  }
+  asn1::bit_ref bref(buf->msg, buf->get_tailroom());
+  if (tx_pdu.pack(bref) != asn1::SRSASN_SUCCESS) {
+    m_logger.error("Could not pack S1AP Paging correctly.");
+    return false;
+  }
+  buf->N_bytes = bref.distance_bytes();
+
   for (std::map<uint16_t, enb_ctx_t*>::iterator it = m_s1ap->m_active_enbs.begin(); it != m_s1ap->m_active_enbs.end();
        it++) {
     enb_ctx_t* enb_ctx = it->second;
-    if (!m_s1ap->s1ap_tx_pdu(tx_pdu, &enb_ctx->sri)) {
+    if (!m_s1ap->s1ap_tx_pdu(*buf, &enb_ctx->sri)) {
       m_logger.error("Error paging to eNB. eNB Id: 0x%x.", enb_ctx->enb_id);
       return false;
     }
@@ -41,7 +41,8 @@ namespace srsepc {
  * comminication with the MME
  *
  **********************************************/
-spgw::gtpc::gtpc() : m_h_next_ue_ip(0), m_next_ctrl_teid(1), m_next_user_teid(1), m_max_paging_queue(0)
+spgw::gtpc::gtpc() :
+  m_h_next_ue_ip(0), m_next_ctrl_teid(1), m_next_user_teid(1), m_max_paging_queue(0), m_max_paging_queue_bytes(0)
 {
   return;
 }
@@ -77,7 +78,8 @@ int spgw::gtpc::init(spgw_args_t*                           args,
   }
 
   // Limit paging queue
-  m_max_paging_queue = args->max_paging_queue;
+  m_max_paging_queue       = args->max_paging_queue;
+  m_max_paging_queue_bytes = args->max_paging_queue_bytes;
 
   m_logger.info("SPGW S11 Initialized.");
   srsran::console("SPGW S11 Initialized.\n");
@@ -150,6 +152,7 @@ bool spgw::gtpc::send_s11_pdu(const srsran::gtpc_pdu& pdu)
 
 void spgw::gtpc::handle_s11_pdu(srsran::byte_buffer_t* msg)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
   // TODO add deserialization code here
   srsran::gtpc_pdu* pdu = (srsran::gtpc_pdu*)msg->msg;
   srsran::console("Received GTP-C PDU. Message type: %s\n", srsran::gtpc_msg_type_to_str(pdu->header.type));
@@ -277,6 +280,7 @@ void spgw::gtpc::handle_modify_bearer_request(const struct srsran::gtpc_header&
     m_logger.debug("Modify Bearer Request received after Downling Data Notification was sent");
     srsran::console("Modify Bearer Request received after Downling Data Notification was sent\n");
     m_gtpu->send_all_queued_packets(tunnel_ctx->dw_user_fteid, tunnel_ctx->paging_queue);
+    release_paging_queue(tunnel_ctx);
   }
 
   // Setting up Modify bearer response PDU
@@ -336,6 +340,7 @@ void spgw::gtpc::handle_release_access_bearers_request(const srsran::gtpc_header
 
 bool spgw::gtpc::send_downlink_data_notification(uint32_t spgw_ctr_teid)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
   m_logger.debug("Sending Downlink Notification Request");
 
   struct srsran::gtpc_pdu dl_not_pdu;
@@ -358,6 +363,8 @@ bool spgw::gtpc::send_downlink_data_notification(uint32_t spgw_ctr_teid)
   }
 
   tunnel_ctx->paging_pending = true;
+  tunnel_ctx->paging_queue.set_size(m_max_paging_queue);
+  tunnel_ctx->paging_queue_bytes = 0;
   srsran::console("Found UE for Downlink Notification \n");
   srsran::console("MME Ctr TEID 0x%x, IMSI: %015" PRIu64 "\n", tunnel_ctx->dw_ctrl_fteid.teid, tunnel_ctx->imsi);
 
@@ -495,6 +502,7 @@ bool spgw::gtpc::delete_gtpc_ctx(uint32_t ctrl_teid)
  */
 bool spgw::gtpc::queue_downlink_packet(uint32_t ctrl_teid, srsran::unique_byte_buffer_t msg)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
   spgw_tunnel_ctx_t* tunnel_ctx;
   if (!m_teid_to_tunnel_ctx.count(ctrl_teid)) {
     m_logger.error("Could not find GTP context to queue.");
@@ -506,13 +514,19 @@ bool spgw::gtpc::queue_downlink_packet(uint32_t ctrl_teid, srsran::unique_byte_b
     goto pkt_discard;
   }
 
-  if (tunnel_ctx->paging_queue.size() < m_max_paging_queue) {
+  if (not tunnel_ctx->paging_queue.full() and
+      tunnel_ctx->paging_queue_bytes + msg->N_bytes <= m_max_paging_queue_bytes) {
+    tunnel_ctx->paging_queue_bytes += msg->N_bytes;
     tunnel_ctx->paging_queue.push(std::move(msg));
-    m_logger.debug(
-        "Queued packet. IMSI %" PRIu64 ", Packets in Queue %zd", tunnel_ctx->imsi, tunnel_ctx->paging_queue.size());
+    m_logger.debug("Queued packet. IMSI %" PRIu64 ", Packets in Queue %zd, Bytes in Queue %d",
+                   tunnel_ctx->imsi,
+                   tunnel_ctx->paging_queue.size(),
+                   tunnel_ctx->paging_queue_bytes);
   } else {
-    m_logger.debug(
-        "Paging queue full. IMSI %" PRIu64 ", Packets in Queue %zd", tunnel_ctx->imsi, tunnel_ctx->paging_queue.size());
+    m_logger.debug("Paging queue full. IMSI %" PRIu64 ", Packets in Queue %zd, Bytes in Queue %d",
+                   tunnel_ctx->imsi,
+                   tunnel_ctx->paging_queue.size(),
+                   tunnel_ctx->paging_queue_bytes);
     goto pkt_discard;
   }
   return true;
@@ -528,13 +542,20 @@ bool spgw::gtpc::free_all_queued_packets(spgw_tunnel_ctx_t* tunnel_ctx)
   }
 
   while (!tunnel_ctx->paging_queue.empty()) {
-    srsran::unique_byte_buffer_t pkt = std::move(tunnel_ctx->paging_queue.front());
-    m_logger.debug("Dropping packet. Bytes %d", pkt->N_bytes);
+    m_logger.debug("Dropping packet. Bytes %d", tunnel_ctx->paging_queue.top()->N_bytes);
     tunnel_ctx->paging_queue.pop();
   }
+  release_paging_queue(tunnel_ctx);
   return true;
 }
 
+void spgw::gtpc::release_paging_queue(spgw_tunnel_ctx_t* tunnel_ctx)
+{
+  // Give the storage of the ring back, so that idle UEs do not hold on to it
+  srsran::dyn_circular_buffer<srsran::unique_byte_buffer_t>().swap(tunnel_ctx->paging_queue);
+  tunnel_ctx->paging_queue_bytes = 0;
+}
+
 int spgw::gtpc::init_ue_ip(spgw_args_t* args, const std::map<std::string, uint64_t>& ip_to_imsi)
 {
   std::map<std::string, uint64_t>::const_iterator iter = ip_to_imsi.find(args->sgi_if_addr);
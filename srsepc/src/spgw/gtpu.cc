@@ -33,6 +33,7 @@
 #include <linux/ip.h>
 #include <netinet/in.h>
 #include <sys/ioctl.h>
+#include <sys/select.h>
 #include <sys/socket.h>
 
 namespace srsepc {
@@ -44,7 +45,7 @@ namespace srsepc {
  *
  **************************************/
 
-spgw::gtpu::gtpu() : m_sgi_up(false), m_s1u_up(false)
+spgw::gtpu::gtpu() : m_sgi_up(false), m_s1u_up(false), m_tunnels(std::make_shared<tunnel_table>())
 {
   return;
 }
@@ -59,8 +60,9 @@ int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc)
   int err;
 
   // Store interfaces
-  m_spgw = spgw;
-  m_gtpc = gtpc;
+  m_spgw        = spgw;
+  m_gtpc        = gtpc;
+  m_nof_workers = std::max(args->nof_workers, 1u);
 
   // Init SGi interface
   err = init_sgi(args);
@@ -81,15 +83,32 @@ int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc)
   return SRSRAN_SUCCESS;
 }
 
+void spgw::gtpu::start()
+{
+  for (uint32_t i = 0; i < m_nof_workers; ++i) {
+    m_workers.emplace_back(new worker(this, i, m_sgi_queues[i], m_s1u_socks[i]));
+    m_workers.back()->start();
+  }
+}
+
 void spgw::gtpu::stop()
 {
+  for (std::unique_ptr<worker>& w : m_workers) {
+    w->stop();
+  }
+  m_workers.clear();
+
   // Clean up SGi interface
   if (m_sgi_up) {
-    close(m_sgi);
+    for (int sgi : m_sgi_queues) {
+      close(sgi);
+    }
   }
-  // Clean up S1-U socket
+  // Clean up S1-U sockets
   if (m_s1u_up) {
-    close(m_s1u);
+    for (int s1u : m_s1u_socks) {
+      close(s1u);
+    }
   }
 }
 
@@ -102,8 +121,8 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
     return SRSRAN_ERROR_ALREADY_STARTED;
   }
 
-  // Construct the TUN device
-  m_sgi = open("/dev/net/tun", O_RDWR);
+  // Construct the TUN device. It is read until empty on every wake-up, so that the PDUs of a burst are sent together
+  m_sgi = open("/dev/net/tun", O_RDWR | O_NONBLOCK);
   m_logger.info("TUN file descriptor = %d", m_sgi);
   if (m_sgi < 0) {
     m_logger.error("Failed to open TUN device: %s", strerror(errno));
@@ -111,7 +130,7 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
   }
 
   memset(&ifr, 0, sizeof(ifr));
-  ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
+  ifr.ifr_flags = IFF_TUN | IFF_NO_PI | (m_nof_workers > 1 ? IFF_MULTI_QUEUE : 0);
   strncpy(
       ifr.ifr_ifrn.ifrn_name, args->sgi_if_name.c_str(), std::min(args->sgi_if_name.length(), (size_t)(IFNAMSIZ - 1)));
   ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = '\0';
@@ -121,6 +140,7 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
     close(m_sgi);
     return SRSRAN_ERROR_CANT_START;
   }
+  struct ifreq queue_ifr = ifr;
 
   // Bring up the interface
   sgi_sock = socket(AF_INET, SOCK_DGRAM, 0);
@@ -168,6 +188,25 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
   }
 
   close(sgi_sock);
+
+  // Attach the remaining queues of the interface, one per worker
+  m_sgi_queues.push_back(m_sgi);
+  for (uint32_t i = 1; i < m_nof_workers; ++i) {
+    int queue_fd = open("/dev/net/tun", O_RDWR | O_NONBLOCK);
+    if (queue_fd < 0 or ioctl(queue_fd, TUNSETIFF, &queue_ifr) < 0) {
+      m_logger.error("Failed to attach queue %d of the TUN device: %s", i, strerror(errno));
+      if (queue_fd >= 0) {
+        close(queue_fd);
+      }
+      for (int sgi : m_sgi_queues) {
+        close(sgi);
+      }
+      m_sgi_queues.clear();
+      return SRSRAN_ERROR_CANT_START;
+    }
+    m_sgi_queues.push_back(queue_fd);
+  }
+
   m_sgi_up = true;
   m_logger.info("Initialized SGi interface");
   return SRSRAN_SUCCESS;
@@ -175,27 +214,39 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
 
 int spgw::gtpu::init_s1u(spgw_args_t* args)
 {
-  // Open S1-U socket
-  m_s1u = socket(AF_INET, SOCK_DGRAM, 0);
-  if (m_s1u == -1) {
-    m_logger.error("Failed to open socket: %s", strerror(errno));
-    return SRSRAN_ERROR_CANT_START;
-  }
-  m_s1u_up = true;
-
-  // Bind the socket
-  m_s1u_addr.sin_family      = AF_INET;
+  // Set the S1-U address
+  m_s1u_addr.sin_family = AF_INET;
   if (inet_pton(m_s1u_addr.sin_family, args->gtpu_bind_addr.c_str(), &m_s1u_addr.sin_addr.s_addr) != 1) {
     m_logger.error("Invalid gtpu_bind_addr: %s", args->gtpu_bind_addr.c_str());
     srsran::console("Invalid gtpu_bind_addr: %s\n", args->gtpu_bind_addr.c_str());
     return SRSRAN_ERROR_CANT_START;
   }
-  m_s1u_addr.sin_port        = htons(GTPU_RX_PORT);
-
-  if (bind(m_s1u, (struct sockaddr*)&m_s1u_addr, sizeof(struct sockaddr_in))) {
-    m_logger.error("Failed to bind socket: %s", strerror(errno));
-    return SRSRAN_ERROR_CANT_START;
+  m_s1u_addr.sin_port = htons(GTPU_RX_PORT);
+
+  // Open one S1-U socket per worker. They share the address, so that the kernel spreads the eNB flows across them
+  for (uint32_t i = 0; i < m_nof_workers; ++i) {
+    int s1u = socket(AF_INET, SOCK_DGRAM, 0);
+    if (s1u == -1) {
+      m_logger.error("Failed to open socket: %s", strerror(errno));
+      return SRSRAN_ERROR_CANT_START;
+    }
+    m_s1u_socks.push_back(s1u);
+    m_s1u_up = true;
+
+    int enable = 1;
+    if (m_nof_workers > 1 and setsockopt(s1u, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(int)) < 0) {
+      m_logger.error("Failed to set SO_REUSEPORT: %s", strerror(errno));
+      return SRSRAN_ERROR_CANT_START;
+    }
+
+    // Bind the socket
+    if (bind(s1u, (struct sockaddr*)&m_s1u_addr, sizeof(struct sockaddr_in))) {
+      m_logger.error("Failed to bind socket: %s", strerror(errno));
+      return SRSRAN_ERROR_CANT_START;
+    }
   }
+  m_s1u = m_s1u_socks[0];
+  m_paging_tx_batch.set_fd(m_s1u);
   m_logger.info("S1-U socket = %d", m_s1u);
   m_logger.info("S1-U IP = %s, Port = %d ", inet_ntoa(m_s1u_addr.sin_addr), ntohs(m_s1u_addr.sin_port));
 
@@ -203,16 +254,120 @@ int spgw::gtpu::init_s1u(spgw_args_t* args)
   return SRSRAN_SUCCESS;
 }
 
-void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
+/*
+ * User plane workers
+ */
+spgw::gtpu::worker::worker(gtpu* parent_, uint32_t id, int sgi_, int s1u_) :
+  thread("SPGW-U" + std::to_string(id)), parent(parent_), sgi(sgi_), s1u(s1u_), tx_batch(parent_->m_logger)
+{
+  tx_batch.set_fd(s1u);
+}
+
+void spgw::gtpu::worker::stop()
+{
+  if (running) {
+    running = false;
+    thread_cancel();
+    wait_thread_finish();
+  }
+  tx_batch.flush();
+}
+
+void spgw::gtpu::worker::run_thread()
+{
+  srslog::basic_logger& logger = parent->m_logger;
+
+  // Mark the thread as running
+  running = true;
+
+  // The S1-U PDUs are read in batches into a set of buffers, which are reused since the PDUs are written to the SGi
+  // interface right away
+  const size_t batch_size = srsran::datagram_batch::max_size;
+  std::array<srsran::unique_byte_buffer_t, batch_size> s1u_msgs;
+  std::array<mmsghdr, batch_size>                      s1u_hdrs;
+  std::array<iovec, batch_size>                        s1u_iovs;
+  for (srsran::unique_byte_buffer_t& s1u_msg : s1u_msgs) {
+    s1u_msg = srsran::make_byte_buffer("spgw::gtpu::run_thread::s1u");
+    if (s1u_msg == nullptr) {
+      logger.error("Could not allocate the S1-U buffers");
+      return;
+    }
+  }
+
+  size_t buf_len = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+
+  fd_set set;
+  int    max_fd = std::max(s1u, sgi);
+  while (running) {
+    FD_ZERO(&set);
+    FD_SET(s1u, &set);
+    FD_SET(sgi, &set);
+
+    int n = select(max_fd + 1, &set, NULL, NULL, NULL);
+    if (n == -1) {
+      logger.error("Error from select");
+    } else if (n) {
+      if (FD_ISSET(sgi, &set)) {
+        /*
+         * SGi messages may need to be queued when waiting for UE Paging procedure.
+         * For this reason, buffers for SGi pdus are allocated here and deallocated
+         * when the S1-U batch is flushed, at handle_sgi_pdu() when the PDU is dropped or at
+         * gtpc::free_all_queued_packets, which is called when the Downlink Data Notification
+         * procedure fails (see handle_downlink_data_notification_acknowledgment and
+         * handle_downlink_data_notification_failure)
+         */
+        logger.debug("Message received at SPGW: SGi Message");
+        // The non-blocking SGi queue is drained, so that the resulting S1-U PDUs are sent in a single batch. The
+        // tunnel table snapshot is taken once for the whole burst
+        std::shared_ptr<const tunnel_table> tunnels = std::atomic_load(&parent->m_tunnels);
+        for (size_t nof_pdus = 0; nof_pdus < batch_size; ++nof_pdus) {
+          srsran::unique_byte_buffer_t sgi_msg = srsran::make_byte_buffer("spgw::gtpu::run_thread::sgi");
+          if (sgi_msg == nullptr) {
+            break;
+          }
+          ssize_t nof_bytes = read(sgi, sgi_msg->msg, buf_len);
+          if (nof_bytes <= 0) {
+            break;
+          }
+          sgi_msg->N_bytes = nof_bytes;
+          parent->handle_sgi_pdu(std::move(sgi_msg), *tunnels, tx_batch);
+        }
+      }
+      if (FD_ISSET(s1u, &set)) {
+        logger.debug("Message received at SPGW: S1-U Message");
+        for (size_t i = 0; i < batch_size; ++i) {
+          s1u_msgs[i]->clear();
+          s1u_iovs[i].iov_base           = s1u_msgs[i]->msg;
+          s1u_iovs[i].iov_len            = buf_len;
+          s1u_hdrs[i]                    = {};
+          s1u_hdrs[i].msg_hdr.msg_iov    = &s1u_iovs[i];
+          s1u_hdrs[i].msg_hdr.msg_iovlen = 1;
+        }
+        int nof_msgs = recvmmsg(s1u, s1u_hdrs.data(), batch_size, MSG_DONTWAIT, nullptr);
+        for (int i = 0; i < nof_msgs; ++i) {
+          s1u_msgs[i]->N_bytes = s1u_hdrs[i].msg_len;
+          parent->handle_s1u_pdu(s1u_msgs[i].get(), sgi);
+        }
+      }
+      tx_batch.flush();
+    } else {
+      logger.debug("No data from select.");
+    }
+  }
+}
+
+void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg,
+                                const tunnel_table&          tunnels,
+                                srsran::datagram_tx_batch&   tx_batch)
 {
   bool usr_found = false;
   bool ctr_found = false;
 
-  std::map<uint32_t, srsran::gtpc_f_teid_ie>::iterator gtpu_fteid_it;
-  std::map<in_addr_t, uint32_t>::iterator              gtpc_teid_it;
-  srsran::gtpc_f_teid_ie                               enb_fteid;
-  uint32_t                                             spgw_teid;
-  struct iphdr*                                        iph = (struct iphdr*)msg->msg;
+  std::unordered_map<in_addr_t, srsran::gtpc_f_teid_ie>::const_iterator gtpu_fteid_it;
+  std::unordered_map<in_addr_t, uint32_t>::const_iterator               gtpc_teid_it;
+  srsran::gtpc_f_teid_ie                                                enb_fteid;
+  uint32_t                                                              spgw_teid;
+  struct iphdr*                                                         iph = (struct iphdr*)msg->msg;
   m_logger.debug("Received SGi PDU. Bytes %d", msg->N_bytes);
 
   if (iph->version != 4) {
@@ -234,13 +389,13 @@ void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
   m_logger.debug("SGi PDU -- IP dst addr %s", srsran::to_c_str(buffer));
 
   // Find user and control tunnel
-  gtpu_fteid_it = m_ip_to_usr_teid.find(iph->daddr);
-  if (gtpu_fteid_it != m_ip_to_usr_teid.end()) {
+  gtpu_fteid_it = tunnels.ip_to_usr_teid.find(iph->daddr);
+  if (gtpu_fteid_it != tunnels.ip_to_usr_teid.end()) {
     usr_found = true;
     enb_fteid = gtpu_fteid_it->second;
   }
-  gtpc_teid_it = m_ip_to_ctr_teid.find(iph->daddr);
-  if (gtpc_teid_it != m_ip_to_ctr_teid.end()) {
+  gtpc_teid_it = tunnels.ip_to_ctr_teid.find(iph->daddr);
+  if (gtpc_teid_it != tunnels.ip_to_ctr_teid.end()) {
     ctr_found = true;
     spgw_teid = gtpc_teid_it->second;
   }
@@ -257,18 +412,18 @@ void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
   } else if (usr_found == true && ctr_found == false) {
     m_logger.error("User plane tunnel found without a control plane tunnel present.");
   } else {
-    send_s1u_pdu(enb_fteid, msg.get());
+    send_s1u_pdu(enb_fteid, std::move(msg), tx_batch);
   }
 }
 
-void spgw::gtpu::handle_s1u_pdu(srsran::byte_buffer_t* msg)
+void spgw::gtpu::handle_s1u_pdu(srsran::byte_buffer_t* msg, int sgi)
 {
   srsran::gtpu_header_t header;
   srsran::gtpu_read_header(msg, &header, m_logger);
 
   m_logger.debug("Received PDU from S1-U. Bytes=%d", msg->N_bytes);
   m_logger.debug("TEID 0x%x. Bytes=%d", header.teid, msg->N_bytes);
-  int n = write(m_sgi, msg->msg, msg->N_bytes);
+  int n = write(sgi, msg->msg, msg->N_bytes);
   if (n < 0) {
     m_logger.error("Could not write to TUN interface.");
   } else {
@@ -277,7 +432,9 @@ void spgw::gtpu::handle_s1u_pdu(srsran::byte_buffer_t* msg)
   return;
 }
 
-void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg)
+void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t          enb_fteid,
+                              srsran::unique_byte_buffer_t msg,
+                              srsran::datagram_tx_batch&   tx_batch)
 {
   // Set eNB destination address
   struct sockaddr_in enb_addr;
@@ -296,34 +453,24 @@ void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer
   m_logger.debug("eNB F-TEID -- eNB IP %s, eNB TEID 0x%x.", inet_ntoa(enb_addr.sin_addr), enb_fteid.teid);
 
   // Write header into packet
-  int n;
-  if (!srsran::gtpu_write_header(&header, msg, m_logger)) {
+  if (!srsran::gtpu_write_header(&header, msg.get(), m_logger)) {
     m_logger.error("Error writing GTP-U header on PDU");
-    goto out;
-  }
-
-  // Send packet to destination
-  n = sendto(m_s1u, msg->msg, msg->N_bytes, 0, (struct sockaddr*)&enb_addr, sizeof(enb_addr));
-  if (n < 0) {
-    m_logger.error("Error sending packet to eNB");
-  } else if ((unsigned int)n != msg->N_bytes) {
-    m_logger.error("Mis-match between packet bytes and sent bytes: Sent: %d/%d", n, msg->N_bytes);
+    return;
   }
 
-out:
-  m_logger.debug("Deallocating packet after sending S1-U message");
-  return;
+  // The packet is sent along with the rest of the PDUs of the burst
+  tx_batch.push(std::move(msg), enb_addr);
 }
 
-void spgw::gtpu::send_all_queued_packets(srsran::gtp_fteid_t                       dw_user_fteid,
-                                         std::queue<srsran::unique_byte_buffer_t>& pkt_queue)
+void spgw::gtpu::send_all_queued_packets(srsran::gtp_fteid_t                                        dw_user_fteid,
+                                         srsran::dyn_circular_buffer<srsran::unique_byte_buffer_t>& pkt_queue)
 {
   m_logger.debug("Sending all queued packets");
   while (!pkt_queue.empty()) {
-    srsran::unique_byte_buffer_t msg = std::move(pkt_queue.front());
-    send_s1u_pdu(dw_user_fteid, msg.get());
+    send_s1u_pdu(dw_user_fteid, std::move(pkt_queue.top()), m_paging_tx_batch);
     pkt_queue.pop();
   }
+  m_paging_tx_batch.flush();
   return;
 }
 
@@ -340,16 +487,22 @@ bool spgw::gtpu::modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtpc_f_teid_ie dw
   srsran::gtpu_ntoa(buffer, dw_user_fteid.ipv4);
   m_logger.info("Downlink eNB addr %s, U-TEID 0x%x", srsran::to_c_str(buffer), dw_user_fteid.teid);
   m_logger.info("Uplink C-TEID: 0x%x", up_ctrl_teid);
-  m_ip_to_usr_teid[ue_ipv4] = dw_user_fteid;
-  m_ip_to_ctr_teid[ue_ipv4] = up_ctrl_teid;
+  std::lock_guard<std::mutex>   lock(m_tunnel_mutex);
+  std::shared_ptr<tunnel_table> tunnels = std::make_shared<tunnel_table>(*std::atomic_load(&m_tunnels));
+  tunnels->ip_to_usr_teid[ue_ipv4]      = dw_user_fteid;
+  tunnels->ip_to_ctr_teid[ue_ipv4]      = up_ctrl_teid;
+  std::atomic_store(&m_tunnels, std::shared_ptr<const tunnel_table>(std::move(tunnels)));
   return true;
 }
 
 bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 {
   // Remove GTP-U connections, if any.
-  if (m_ip_to_usr_teid.count(ue_ipv4)) {
-    m_ip_to_usr_teid.erase(ue_ipv4);
+  std::lock_guard<std::mutex> lock(m_tunnel_mutex);
+  if (m_tunnels->ip_to_usr_teid.count(ue_ipv4)) {
+    std::shared_ptr<tunnel_table> tunnels = std::make_shared<tunnel_table>(*m_tunnels);
+    tunnels->ip_to_usr_teid.erase(ue_ipv4);
+    std::atomic_store(&m_tunnels, std::shared_ptr<const tunnel_table>(std::move(tunnels)));
   } else {
     m_logger.error("Could not find GTP-U Tunnel to delete.");
     return false;
@@ -360,8 +513,11 @@ bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 bool spgw::gtpu::delete_gtpc_tunnel(in_addr_t ue_ipv4)
 {
   // Remove Ctrl TEID from IP mapping.
-  if (m_ip_to_ctr_teid.count(ue_ipv4)) {
-    m_ip_to_ctr_teid.erase(ue_ipv4);
+  std::lock_guard<std::mutex> lock(m_tunnel_mutex);
+  if (m_tunnels->ip_to_ctr_teid.count(ue_ipv4)) {
+    std::shared_ptr<tunnel_table> tunnels = std::make_shared<tunnel_table>(*m_tunnels);
+    tunnels->ip_to_ctr_teid.erase(ue_ipv4);
+    std::atomic_store(&m_tunnels, std::shared_ptr<const tunnel_table>(std::move(tunnels)));
   } else {
     m_logger.error("Could not find GTP-C Tunnel info to delete.");
     return false;
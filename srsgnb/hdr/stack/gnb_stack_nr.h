@@ -44,12 +44,14 @@ class ngap;
 class gtpu;
 class enb_bearer_manager;
 class gtpu_pdcp_adapter;
+class traffic_gen;
 
 struct gnb_stack_args_t {
-  stack_log_args_t log;
-  mac_nr_args_t    mac;
-  ngap_args_t      ngap;
-  pcap_args_t      ngap_pcap;
+  stack_log_args_t   log;
+  mac_nr_args_t      mac;
+  ngap_args_t        ngap;
+  pcap_args_t        ngap_pcap;
+  traffic_gen_args_t traffic_gen;
 };
 
 class gnb_stack_nr final : public srsenb::enb_stack_base,
@@ -120,7 +122,18 @@ public:
     };
     gtpu_task_queue.push(std::bind(task, std::move(sdu)));
   }
-  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) final
+  /// Hands a whole burst of SDUs over to the NR stack in a single task, instead of one task per SDU.
+  void write_sdus(uint16_t rnti, uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus) final
+  {
+    if (sdus.empty()) {
+      return;
+    }
+    std::vector<srsran::unique_byte_buffer_t> burst(std::make_move_iterator(sdus.begin()),
+                                                    std::make_move_iterator(sdus.end()));
+    gtpu_task_queue.push(
+        [this, rnti, lcid, burst = std::move(burst)]() mutable { pdcp.write_sdus(rnti, lcid, burst); });
+  }
+  srsran::pdcp_sdu_list_t get_buffered_pdus(uint16_t rnti, uint32_t lcid) final
   {
     // TODO: make it thread-safe. For now, this function is unused
     return pdcp.get_buffered_pdus(rnti, lcid);
@@ -166,6 +179,7 @@ private:
 
   std::unique_ptr<enb_bearer_manager> bearer_manager;
   std::unique_ptr<gtpu_pdcp_adapter>  gtpu_adapter;
+  std::unique_ptr<traffic_gen>        tgen; // replaces the GTPU user plane when enabled (SA only)
 
   // state
   std::atomic<bool> running = {false};
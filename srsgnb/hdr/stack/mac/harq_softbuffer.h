@@ -33,14 +33,21 @@ extern "C" {
 
 namespace srsenb {
 
+/// Maximum number of LDPC code blocks of a transmission over nof_prb PRBs, assuming a rate of 1.0
+inline uint32_t harq_softbuffer_max_nof_cb(uint32_t nof_prb)
+{
+  uint32_t nof_bits = nof_prb * SRSRAN_MAX_NRE_NR * SRSRAN_MAX_QM;
+  uint32_t nof_cb   = (nof_bits + (SRSRAN_LDPC_MAX_LEN_CB - 24 - 1)) / (SRSRAN_LDPC_MAX_LEN_CB - 24);
+  return SRSRAN_MAX(1, SRSRAN_MIN(nof_cb, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC));
+}
+
 class tx_harq_softbuffer
 {
 public:
   tx_harq_softbuffer() { bzero(&buffer, sizeof(buffer)); }
   explicit tx_harq_softbuffer(uint32_t nof_prb_)
   {
-    // Note: for now we use same size regardless of nof_prb_
-    srsran_softbuffer_tx_init_guru(&buffer, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB);
+    srsran_softbuffer_tx_init_guru(&buffer, harq_softbuffer_max_nof_cb(nof_prb_), SRSRAN_LDPC_MAX_LEN_ENCODED_CB);
   }
   tx_harq_softbuffer(const tx_harq_softbuffer&) = delete;
   tx_harq_softbuffer(tx_harq_softbuffer&& other) noexcept
@@ -81,8 +88,7 @@ public:
   rx_harq_softbuffer() { bzero(&buffer, sizeof(buffer)); }
   explicit rx_harq_softbuffer(uint32_t nof_prb_)
   {
-    // Note: for now we use same size regardless of nof_prb_
-    srsran_softbuffer_rx_init_guru(&buffer, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB);
+    srsran_softbuffer_rx_init_guru(&buffer, harq_softbuffer_max_nof_cb(nof_prb_), SRSRAN_LDPC_MAX_LEN_ENCODED_CB);
   }
   rx_harq_softbuffer(const rx_harq_softbuffer&) = delete;
   rx_harq_softbuffer(rx_harq_softbuffer&& other) noexcept
@@ -102,6 +108,7 @@ public:
   }
   ~rx_harq_softbuffer() { destroy(); }
 
+  /// Only the code blocks written since the last reset are zeroed
   void reset() { srsran_softbuffer_rx_reset(&buffer); }
   void reset(uint32_t tbs_bits) { srsran_softbuffer_rx_reset_tbs(&buffer, tbs_bits); }
 
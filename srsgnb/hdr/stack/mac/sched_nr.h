@@ -29,10 +29,18 @@
 #include "srsran/adt/pool/circular_stack_pool.h"
 #include "srsran/common/slot_point.h"
 #include <array>
+#include <condition_variable>
+#include <mutex>
 extern "C" {
 #include "srsran/config.h"
 }
 
+namespace srsran {
+
+class task_thread_pool;
+
+} // namespace srsran
+
 namespace srsenb {
 
 namespace sched_nr_impl {
@@ -62,7 +70,8 @@ public:
   void dl_mac_ce(uint16_t rnti, uint32_t ce_lcid) override;
   void dl_cqi_info(uint16_t rnti, uint32_t cc, uint32_t cqi_value);
 
-  /// Called once per slot in a non-concurrent fashion
+  /// Called once per slot in a non-concurrent fashion. If carrier workers are configured, it also starts the
+  /// generation of the carrier results, which get_dl_sched() then collects
   void      slot_indication(slot_point slot_tx) override;
   dl_res_t* get_dl_sched(slot_point pdsch_tti, uint32_t cc) override;
   ul_res_t* get_ul_sched(slot_point pusch_tti, uint32_t cc) override;
@@ -73,6 +82,8 @@ private:
   int ue_cfg_impl(uint16_t rnti, const ue_cfg_t& cfg);
   int add_ue_impl(uint16_t rnti, sched_nr_impl::unique_ue_ptr u);
 
+  dl_res_t* run_cc_slot(uint32_t cc);
+
   // args
   sched_nr_impl::sched_params_t cfg;
   srslog::basic_logger*         logger = nullptr;
@@ -84,6 +95,13 @@ private:
   using slot_cc_worker = sched_nr_impl::cc_worker;
   std::vector<std::unique_ptr<sched_nr_impl::cc_worker> > cc_workers;
 
+  // parallel generation of the carrier results of a slot
+  std::unique_ptr<srsran::task_thread_pool> cc_worker_pool;
+  std::mutex                                cc_mutex;
+  std::condition_variable                   cc_cvar;
+  std::vector<slot_point>                   cc_done_slots;
+  std::vector<dl_res_t*>                    cc_results;
+
   // UE Database
   std::unique_ptr<srsran::circular_stack_pool<SRSENB_MAX_UES> > ue_pool;
   using ue_map_t = sched_nr_impl::ue_map_t;
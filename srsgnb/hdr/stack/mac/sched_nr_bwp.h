@@ -25,7 +25,7 @@
 #include "sched_nr_cfg.h"
 #include "sched_nr_grant_allocator.h"
 #include "sched_nr_signalling.h"
-#include "sched_nr_time_rr.h"
+#include "sched_nr_time_pf.h"
 #include "srsran/adt/pool/cached_alloc.h"
 
 namespace srsenb {
@@ -82,6 +82,9 @@ struct bwp_res_grid {
 
   const bwp_params_t* cfg = nullptr;
 
+  /// TBS of the UE grants, used to search MCS without generating a grant for each of them
+  sch_tbs_cache tbs_cache;
+
 private:
   // TTIMOD_SZ is the longest allocation in the future
   srsran::bounded_vector<bwp_slot_grid, TTIMOD_SZ> slots;
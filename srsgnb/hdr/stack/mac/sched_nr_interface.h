@@ -117,12 +117,18 @@ public:
 
   ///// Configuration /////
   struct sched_args_t {
-    bool        pdsch_enabled      = true;
-    bool        pusch_enabled      = true;
-    bool        auto_refill_buffer = false;
-    int         fixed_dl_mcs       = 28;
-    int         fixed_ul_mcs       = 28;
-    std::string logger_name        = "MAC-NR";
+    bool        pdsch_enabled             = true;
+    bool        pusch_enabled             = true;
+    bool        auto_refill_buffer        = false;
+    int         fixed_dl_mcs              = 28;
+    int         fixed_ul_mcs              = 28;
+    float       target_bler               = 0.05;  ///< Target BLER of the DL adaptive link, 0 to disable it
+    float       max_delta_dl_cqi          = 5;     ///< Maximum CQI offset of the DL adaptive link
+    float       adaptive_dl_mcs_step_size = 0.001; ///< CQI offset increase of the DL adaptive link for each ACK
+    std::string logger_name               = "MAC-NR";
+    std::string sched_policy              = "time_rr";
+    std::string sched_policy_args; ///< Fairness coefficient of the "time_pf" policy
+    uint32_t    nof_cc_workers            = 0; ///< Threads that generate the carrier results after slot_indication()
   };
 
   using ue_cc_cfg_t = sched_nr_ue_cc_cfg_t;
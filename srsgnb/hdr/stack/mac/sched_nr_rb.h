@@ -255,22 +255,19 @@ find_next_empty_interval(const prb_bitmap& mask, size_t start_prb_idx = 0, size_
 
 inline prb_interval find_empty_interval_of_length(const prb_bitmap& mask, size_t nof_prbs, uint32_t start_prb_idx = 0)
 {
-  prb_interval max_interv;
-  do {
-    prb_interval interv = find_next_empty_interval(mask, start_prb_idx, mask.size());
-    if (interv.empty()) {
-      break;
-    }
-    if (interv.length() >= nof_prbs) {
-      max_interv.set(interv.start(), interv.start() + nof_prbs);
-      break;
-    }
-    if (interv.length() > max_interv.length()) {
-      max_interv = interv;
-    }
-    start_prb_idx = interv.stop() + 1;
-  } while (start_prb_idx < mask.size());
-  return max_interv;
+  if (start_prb_idx >= mask.size()) {
+    return {};
+  }
+  int pos = mask.find_first_fit(nof_prbs, start_prb_idx, mask.size(), false);
+  if (pos >= 0) {
+    return {(uint32_t)pos, (uint32_t)(pos + nof_prbs)};
+  }
+  // no interval is long enough, return the largest
+  pos = mask.find_best_fit(nof_prbs, start_prb_idx, mask.size(), false);
+  if (pos < 0) {
+    return {};
+  }
+  return find_next_empty_interval(mask, pos, mask.size());
 }
 
 } // namespace sched_nr_impl
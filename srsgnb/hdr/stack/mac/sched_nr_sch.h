@@ -186,6 +186,54 @@ private:
   bwp_rb_bitmap ul_prbs;
 };
 
+/**
+ * Cache of the TBS of the UE SCH grants of a BWP, indexed by number of PRBs and MCS. It holds one table per grant
+ * configuration, given by the REs per PRB, the number of layers and the selected MCS table. The TBS of every MCS for a
+ * number of PRBs is computed with the formula of TS 38.214 5.1.3.2 the first time that number of PRBs is looked up.
+ * Only valid for grants without TB scaling, which is only used by P-RNTI and RA-RNTI grants.
+ */
+class sch_tbs_cache
+{
+public:
+  struct entry_t {
+    uint32_t tbs          = 0; ///< TBS in bits, 0 for invalid MCS
+    uint32_t tbs_crc_bits = 0; ///< TBS plus the TB and code block CRC bits
+    uint32_t Qm           = 0; ///< Modulation order
+  };
+  static const uint32_t MAX_MCS = 32;
+
+  explicit sch_tbs_cache(uint32_t nof_prb_) : nof_prb(nof_prb_) {}
+
+  /// Returns the entries of all MCS for the grant configuration of sch_cfg and the given number of PRBs
+  srsran::span<const entry_t> get(const srsran_sch_cfg_nr_t& sch_cfg, uint32_t nof_grant_prb);
+
+  /// Highest MCS, up to max_mcs, for which the effective code rate of the grant in sch_cfg stays below max_R.
+  /// Returns -1 if there is none
+  int find_max_mcs(const srsran_sch_cfg_nr_t& sch_cfg, uint32_t max_mcs, double max_R);
+
+  /// Minimum number of PRBs whose TBS at the given MCS carries nof_bytes, with the grant configuration of sch_cfg.
+  /// Returns 0 if not even the whole BWP does
+  uint32_t find_min_prbs(const srsran_sch_cfg_nr_t& sch_cfg, uint32_t mcs, uint32_t nof_bytes);
+
+private:
+  struct table_t {
+    srsran_mcs_table_t         mcs_table;
+    srsran_dci_format_nr_t     dci_format;
+    srsran_search_space_type_t ss_type;
+    srsran_rnti_type_t         rnti_type;
+    uint32_t                   nof_re_per_prb;
+    uint32_t                   nof_layers;
+    std::vector<bool>          row_ready;
+    std::vector<entry_t>       entries;
+  };
+
+  table_t& get_table(const srsran_sch_cfg_nr_t& sch_cfg);
+  void     fill_row(table_t& table, uint32_t nof_grant_prb);
+
+  const uint32_t       nof_prb;
+  std::vector<table_t> tables;
+};
+
 } // namespace sched_nr_impl
 
 } // namespace srsenb
@@ -0,0 +1,116 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_NR_TIME_PF_H
+#define SRSRAN_SCHED_NR_TIME_PF_H
+
+#include "sched_nr_time_rr.h"
+#include <vector>
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/**
+ * Proportional-fair scheduler. The UEs with data are kept in one DL and one UL max-heap ordered by r / R^c, where r is
+ * the spectral efficiency of the last CQI, R the average allocated bytes per slot and c the fairness coefficient.
+ * Only the UEs that are allocated or whose CQI or data state changes are re-keyed
+ */
+class sched_nr_time_pf : public sched_nr_base
+{
+public:
+  explicit sched_nr_time_pf(const bwp_params_t& bwp_cfg);
+
+  void sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
+  void sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
+
+private:
+  enum direction { DL = 0, UL = 1 };
+
+  /// Average of the allocated bytes per slot. The slots without allocation are applied lazily
+  class rate_average
+  {
+  public:
+    float    value(uint64_t slot_count);
+    uint32_t count() const { return nof_samples; }
+    void     add_sample(uint64_t slot_count, uint32_t alloc_bytes);
+
+  private:
+    void advance(uint64_t slot_count);
+
+    float    avg_rate    = 0;
+    uint32_t nof_samples = 0;
+    uint64_t last_slot   = 0;
+  };
+
+  struct ue_ctxt {
+    explicit ue_ctxt(uint16_t rnti_) : rnti(rnti_) {}
+
+    const uint16_t rnti;
+    bool           has_data[2] = {};
+    float          exp_rate[2] = {}; ///< Spectral efficiency of the last CSI report
+    double         prio_key[2] = {}; ///< PF priority in a log domain that does not drift with the slots
+    int            heap_pos[2] = {-1, -1};
+    rate_average   avg_rate[2];
+  };
+
+  /// Binary max-heap over the PF keys, where each UE knows its position to be re-keyed or removed in O(log N)
+  class ue_heap
+  {
+  public:
+    explicit ue_heap(direction dir_) : dir(dir_) {}
+    void     update(ue_ctxt* u);
+    void     erase(ue_ctxt* u);
+    size_t   size() const { return heap.size(); }
+    ue_ctxt* operator[](size_t pos) const { return heap[pos]; }
+    bool     higher(size_t lhs, size_t rhs) const { return heap[lhs]->prio_key[dir] > heap[rhs]->prio_key[dir]; }
+
+  private:
+    void swap_pos(size_t lhs, size_t rhs);
+    void sift_up(size_t pos);
+    void sift_down(size_t pos);
+
+    const direction       dir;
+    std::vector<ue_ctxt*> heap;
+  };
+
+  void new_slot(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc);
+  void update_prio(ue_ctxt& u, direction dir, uint64_t count);
+  void set_data(ue_ctxt& u, direction dir, bool has_data);
+  void save_alloc(ue_ctxt& u, direction dir, uint32_t alloc_bytes);
+  template <typename Func>
+  void for_each_by_prio(direction dir, Func&& f);
+
+  float fairness_coeff = 1;
+
+  slot_point current_slot;
+  uint64_t   slot_count = 0;
+
+  rnti_map_t<ue_ctxt>   ue_history_db;
+  ue_heap               dl_heap{DL};
+  ue_heap               ul_heap{UL};
+  std::vector<ue_ctxt*> dl_retx_list, ul_retx_list;
+  std::vector<size_t>   heap_frontier;
+};
+
+} // namespace sched_nr_impl
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_NR_TIME_PF_H
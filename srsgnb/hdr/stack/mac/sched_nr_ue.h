@@ -27,6 +27,7 @@
 #include "sched_nr_interface.h"
 #include "sched_ue/ue_cfg_manager.h"
 #include "srsenb/hdr/stack/mac/common/base_ue_buffer_manager.h"
+#include "srsenb/hdr/stack/mac/common/link_adaptation.h"
 #include "srsenb/hdr/stack/mac/common/mac_metrics.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/move_callback.h"
@@ -107,8 +108,12 @@ public:
   const cell_config_manager& cell_params;
 
   // Channel state
-  uint32_t dl_cqi = 1;
-  uint32_t ul_cqi = 0;
+  uint32_t        dl_cqi = 1;
+  uint32_t        ul_cqi = 0;
+  olla_controller dl_olla;
+
+  /// DL CQI reported by the UE, corrected by the offset of the DL adaptive link
+  uint32_t get_dl_cqi() const;
 
   harq_entity harq_ent;
 
@@ -198,7 +203,7 @@ public:
   bool get_pending_bytes(uint32_t lcid) const { return ue->pdu_builder.pending_bytes(lcid); }
 
   /// Channel Information Getters
-  uint32_t dl_cqi() const { return ue->dl_cqi; }
+  uint32_t dl_cqi() const { return ue->get_dl_cqi(); }
   uint32_t ul_cqi() const { return ue->ul_cqi; }
 
   // UE parameters common to all sectors
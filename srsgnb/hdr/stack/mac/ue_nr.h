@@ -106,7 +106,6 @@ private:
   std::vector<srsran::unique_byte_buffer_t> ue_tx_buffer;
   srsran::block_queue<srsran::unique_byte_buffer_t>
                                ue_rx_pdu_queue; ///< currently only DCH PDUs supported (add BCH, PCH, etc)
-  srsran::unique_byte_buffer_t ue_rlc_buffer;
 
   srsran::unique_byte_buffer_t last_msg3; ///< holds UE ID received in Msg3 for ConRes CE
 
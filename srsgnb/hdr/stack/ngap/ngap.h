@@ -35,6 +35,7 @@
 #include "srsran/common/stack_procedure.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/task_scheduler.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/common/threads.h"
 #include "srsran/interfaces/enb_gtpu_interfaces.h"
 #include "srsran/interfaces/gnb_ngap_interfaces.h"
@@ -111,13 +112,13 @@ private:
   srsran::task_queue_handle   amf_task_queue;
   srsran::socket_manager_itf* rx_socket_handler;
 
-  srsran::unique_socket amf_socket;
-  struct sockaddr_in    amf_addr            = {}; // AMF address
-  bool                  amf_connected       = false;
-  bool                  running             = false;
-  uint32_t              next_gnb_ue_ngap_id = 1; // Next GNB-side UE identifier
-  uint16_t              next_ue_stream_id   = 1; // Next UE SCTP stream identifier
-  srsran::unique_timer  amf_connect_timer, ngsetup_timeout;
+  srsran::unique_socket  amf_socket;
+  srsran::sctp_tx_worker amf_tx;               // Sends the NGAP PDUs batched during each stack task
+  struct sockaddr_in     amf_addr        = {}; // AMF address
+  bool                   amf_connected   = false;
+  bool                   running         = false;
+  uint16_t               nof_amf_streams = 2; // Outbound SCTP streams, updated once the association is up
+  srsran::unique_timer   amf_connect_timer, ngsetup_timeout;
 
   // Protocol IEs sent with every UL NGAP message
   asn1::ngap::tai_s    tai;
@@ -130,13 +131,17 @@ private:
   bool setup_ng();
   bool sctp_send_ngap_pdu(const asn1::ngap::ngap_pdu_c& tx_pdu, uint32_t rnti, const char* procedure_name);
 
+  void dispatch_amf_rx_pdu(srsran::unique_byte_buffer_t pdu);
   bool handle_ngap_rx_pdu(srsran::byte_buffer_t* pdu);
+  bool handle_ngap_rx_pdu_fast(srsran::byte_buffer_t* pdu);
+  bool handle_ngap_decoded_pdu(srsran::byte_buffer_t* pdu, const asn1::ngap::ngap_pdu_c* rx_pdu);
   bool handle_successful_outcome(const asn1::ngap::successful_outcome_s& msg);
   bool handle_unsuccessful_outcome(const asn1::ngap::unsuccessful_outcome_s& msg);
   bool handle_initiating_message(const asn1::ngap::init_msg_s& msg);
 
   // TS 38.413 - Section 8.6.2 - Downlink NAS Transport
   bool handle_dl_nas_transport(const asn1::ngap::dl_nas_transport_s& msg);
+  bool handle_dl_nas_transport(uint32_t ran_ue_ngap_id, uint64_t amf_ue_ngap_id, srsran::const_span<uint8_t> nas_pdu);
   // TS 38.413 - Section 9.2.6.2 - NG Setup Response
   bool handle_ng_setup_response(const asn1::ngap::ng_setup_resp_s& msg);
   // TS 38.413 - Section 9.2.6.3 - NG Setup Failure
@@ -153,19 +158,33 @@ private:
   // PCAP
   srsran::ngap_pcap* pcap = nullptr;
 
+  // Storage of the received PDUs while they are handled
+  asn1::decode_arena rx_arena;
+
+  // The AMF PDUs that need a full unpack are decoded in this worker, away from the stack thread. Their handling is
+  // deferred back to the stack thread in the order of reception
+  std::unique_ptr<srsran::task_worker> rx_worker;
+  uint32_t                             nof_rx_pdus_in_worker = 0;
+
+  /// UE contexts, kept in a dense table indexed by RAN UE NGAP ID. The RNTI and the AMF UE NGAP ID are mapped to the
+  /// RAN UE NGAP ID, so that all lookups are O(1)
   class user_list
   {
+    using table_t = srsran::static_circular_map<uint32_t, std::unique_ptr<ue>, SRSENB_MAX_UES>;
+
   public:
     using value_type     = std::unique_ptr<ue>;
-    using iterator       = std::unordered_map<uint32_t, value_type>::iterator;
-    using const_iterator = std::unordered_map<uint32_t, value_type>::const_iterator;
-    using pair_type      = std::unordered_map<uint32_t, value_type>::value_type;
+    using iterator       = table_t::iterator;
+    using const_iterator = table_t::const_iterator;
+    using pair_type      = table_t::value_type;
 
     ue*            find_ue_rnti(uint16_t rnti);
     ue*            find_ue_gnbid(uint32_t gnbid);
     ue*            find_ue_amfid(uint64_t amfid);
     ue*            add_user(value_type user);
     void           erase(ue* ue_ptr);
+    uint32_t       alloc_ran_ue_ngap_id();
+    void           set_amf_ue_ngap_id(ue* ue_ptr, uint64_t amf_id);
     iterator       begin() { return users.begin(); }
     iterator       end() { return users.end(); }
     const_iterator cbegin() const { return users.begin(); }
@@ -173,7 +192,10 @@ private:
     size_t         size() const { return users.size(); }
 
   private:
-    std::unordered_map<uint32_t, std::unique_ptr<ue> > users; // maps ran_ue_ngap_id to user
+    table_t                                users; // maps ran_ue_ngap_id to user
+    std::unordered_map<uint16_t, uint32_t> rnti_to_ran_id;
+    std::unordered_map<uint64_t, uint32_t> amf_id_to_ran_id;
+    uint32_t                               next_ran_ue_ngap_id = 1; // Next GNB-side UE identifier
   };
   user_list users;
 
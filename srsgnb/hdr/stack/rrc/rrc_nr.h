@@ -77,6 +77,7 @@ public:
   void    config_phy();
   void    config_mac();
   int32_t generate_sibs();
+  int     generate_setup_cell_group();
   int     read_pdu_bcch_bch(const uint32_t tti, srsran::byte_buffer_t& buffer) final;
   int     read_pdu_bcch_dlsch(uint32_t sib_index, srsran::byte_buffer_t& buffer) final;
 
@@ -158,6 +159,9 @@ private:
     std::vector<srsran::unique_byte_buffer_t>             sib_buffer;
     std::unique_ptr<const asn1::rrc_nr::cell_group_cfg_s> master_cell_group;
     srsran::phy_cfg_nr_t                                  default_phy_ue_cfg_nr;
+    /// MasterCellGroup sent in every RRCSetup (cell baseline + SRB1), and its encoding, computed once at start
+    std::unique_ptr<const asn1::rrc_nr::cell_group_cfg_s> setup_cell_group;
+    srsran::unique_byte_buffer_t                          setup_cell_group_buffer;
   };
   std::unique_ptr<cell_ctxt_t>     cell_ctxt;
   rnti_map_t<std::unique_ptr<ue> > users;
@@ -41,6 +41,7 @@ public:
 
   // Interface for GTPU
   void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) final;
+  void write_sdus(uint16_t rnti, uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus) final;
 
 private:
   gtpu_interface_sdap_nr*   m_gtpu = nullptr;
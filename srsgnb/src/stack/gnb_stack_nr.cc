@@ -22,6 +22,7 @@
 #include "srsgnb/hdr/stack/gnb_stack_nr.h"
 #include "srsenb/hdr/stack/upper/gtpu.h"
 #include "srsenb/hdr/stack/upper/gtpu_pdcp_adapter.h"
+#include "srsenb/hdr/stack/upper/traffic_gen.h"
 #include "srsgnb/hdr/stack/ngap/ngap.h"
 #include "srsran/common/network_utils.h"
 #include "srsran/srsran.h"
@@ -123,6 +124,15 @@ int gnb_stack_nr::init(const gnb_stack_args_t& args_,
     gtpu_args.mme_addr      = args.ngap.amf_addr;
     gtpu_args.gtp_bind_addr = args.ngap.gtp_bind_addr;
     gtpu->init(gtpu_args, gtpu_adapter.get());
+
+    if (args.traffic_gen.enable) {
+      tgen.reset(new traffic_gen(stack_logger, *bearer_manager));
+      if (tgen->init(args.traffic_gen, gtpu_adapter.get()) != SRSRAN_SUCCESS) {
+        stack_logger.error("Couldn't initialize the traffic generator");
+        return SRSRAN_ERROR;
+      }
+      gtpu_adapter->set_ul_sink(tgen.get());
+    }
   } else {
     pdcp.init(&rlc, &rrc, x2_);
   }
@@ -180,6 +190,12 @@ void gnb_stack_nr::tti_clock_impl()
 {
   //  m_ngap->run_tti();
   task_sched.tic();
+  if (gtpu != nullptr) {
+    gtpu->tic();
+  }
+  if (tgen != nullptr) {
+    tgen->tic();
+  }
 }
 
 void gnb_stack_nr::process_pdus() {}
@@ -197,6 +213,9 @@ bool gnb_stack_nr::get_metrics(srsenb::stack_metrics_t* metrics)
   // use stack thread to query RRC metrics
   auto ret = metrics_task_queue.try_push([this, metrics, &metrics_ready]() {
     rrc.get_metrics(metrics->rrc);
+    if (tgen != nullptr) {
+      tgen->get_metrics(metrics->traffic_gen);
+    }
     {
       std::lock_guard<std::mutex> lock(metrics_mutex);
       metrics_ready = true;
@@ -272,11 +272,12 @@ private:
     }
     for (mac_ue_metrics_t& ue_metric : pending_metrics->ues) {
       if (ues.contains(ue_metric.rnti) and ues[ue_metric.rnti]->carriers[0] != nullptr) {
-        auto& ue_cc         = *ues[ue_metric.rnti]->carriers[0];
-        ue_metric.tx_brate  = ue_cc.metrics.tx_brate;
-        ue_metric.tx_errors = ue_cc.metrics.tx_errors;
-        ue_metric.tx_pkts   = ue_cc.metrics.tx_pkts;
-        ue_cc.metrics       = {};
+        auto& ue_cc             = *ues[ue_metric.rnti]->carriers[0];
+        ue_metric.tx_brate      = ue_cc.metrics.tx_brate;
+        ue_metric.tx_errors     = ue_cc.metrics.tx_errors;
+        ue_metric.tx_pkts       = ue_cc.metrics.tx_pkts;
+        ue_metric.dl_cqi_offset = ue_cc.dl_olla.get_offset();
+        ue_cc.metrics           = {};
       }
     }
     pending_metrics = nullptr;
@@ -302,6 +303,9 @@ sched_nr::~sched_nr()
 void sched_nr::stop()
 {
   metrics_handler->stop();
+  if (cc_worker_pool != nullptr) {
+    cc_worker_pool->stop();
+  }
 }
 
 int sched_nr::config(const sched_args_t& sched_cfg, srsran::const_span<sched_nr_cell_cfg_t> cell_list)
@@ -326,6 +330,13 @@ int sched_nr::config(const sched_args_t& sched_cfg, srsran::const_span<sched_nr_
     cc_workers[cc].reset(new slot_cc_worker{cfg.cells[cc]});
   }
 
+  // Carriers are only generated in parallel if there is more than one
+  if (sched_cfg.nof_cc_workers > 0 and cfg.cells.size() > 1) {
+    cc_worker_pool.reset(new srsran::task_thread_pool(sched_cfg.nof_cc_workers));
+    cc_done_slots.resize(cfg.cells.size());
+    cc_results.resize(cfg.cells.size(), nullptr);
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -390,6 +401,22 @@ void sched_nr::slot_indication(slot_point slot_tx)
 
   // If UE metrics were externally requested, store the current UE state
   metrics_handler->save_metrics();
+
+  if (cc_worker_pool != nullptr) {
+    // Generate the carrier results in the pool, while the caller carries on with the rest of the slot processing.
+    // The carriers only share the UE state through the slot_ue objects, which are created per carrier
+    for (uint32_t cc = 0; cc < cfg.cells.size(); ++cc) {
+      cc_worker_pool->push_task([this, cc, slot_tx]() {
+        dl_res_t* res = run_cc_slot(cc);
+        {
+          std::lock_guard<std::mutex> lock(cc_mutex);
+          cc_results[cc]    = res;
+          cc_done_slots[cc] = slot_tx;
+        }
+        cc_cvar.notify_all();
+      });
+    }
+  }
 }
 
 /// Generate {pdcch_slot,cc} scheduling decision
@@ -397,6 +424,17 @@ sched_nr::dl_res_t* sched_nr::get_dl_sched(slot_point pdsch_tti, uint32_t cc)
 {
   srsran_assert(pdsch_tti == current_slot_tx, "Unexpected pdsch_tti slot received");
 
+  if (cc_worker_pool != nullptr) {
+    // Wait for the carrier result started in slot_indication()
+    std::unique_lock<std::mutex> lock(cc_mutex);
+    cc_cvar.wait(lock, [this, cc, pdsch_tti]() { return cc_done_slots[cc] == pdsch_tti; });
+    return cc_results[cc];
+  }
+  return run_cc_slot(cc);
+}
+
+sched_nr::dl_res_t* sched_nr::run_cc_slot(uint32_t cc)
+{
   // process non-cc specific feedback if pending (e.g. SRs, buffer state updates, UE config) for non-CA UEs
   pending_events->process_cc_events(ue_db, cc);
 
@@ -408,7 +446,7 @@ sched_nr::dl_res_t* sched_nr::get_dl_sched(slot_point pdsch_tti, uint32_t cc)
   }
 
   // Process pending CC-specific feedback, generate {slot_idx,cc} scheduling decision
-  sched_nr::dl_res_t* ret = cc_workers[cc]->run_slot(pdsch_tti, ue_db);
+  sched_nr::dl_res_t* ret = cc_workers[cc]->run_slot(current_slot_tx, ue_db);
 
   // decrement the number of active workers
   int rem_workers = worker_count.fetch_sub(1, std::memory_order_release) - 1;
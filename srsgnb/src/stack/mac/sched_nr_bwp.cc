@@ -170,9 +170,15 @@ int ra_sched::dl_rach_info(const dl_sched_rar_info_t& rar_info)
   return SRSRAN_SUCCESS;
 }
 
-bwp_manager::bwp_manager(const bwp_params_t& bwp_cfg) :
-  cfg(&bwp_cfg), ra(bwp_cfg), si(bwp_cfg), grid(bwp_cfg), data_sched(new sched_nr_time_rr())
-{}
+bwp_manager::bwp_manager(const bwp_params_t& bwp_cfg) : cfg(&bwp_cfg), ra(bwp_cfg), si(bwp_cfg), grid(bwp_cfg)
+{
+  if (bwp_cfg.sched_cfg.sched_policy == "time_pf") {
+    data_sched.reset(new sched_nr_time_pf(bwp_cfg));
+    bwp_cfg.logger.info("SCHED: Using time-domain PF scheduling policy for cc=%d", bwp_cfg.cc);
+  } else {
+    data_sched.reset(new sched_nr_time_rr());
+  }
+}
 
 } // namespace sched_nr_impl
 } // namespace srsenb
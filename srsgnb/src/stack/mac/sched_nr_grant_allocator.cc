@@ -108,7 +108,7 @@ void bwp_slot_grid::reset()
   pending_acks.clear();
 }
 
-bwp_res_grid::bwp_res_grid(const bwp_params_t& bwp_cfg_) : cfg(&bwp_cfg_)
+bwp_res_grid::bwp_res_grid(const bwp_params_t& bwp_cfg_) : cfg(&bwp_cfg_), tbs_cache(bwp_cfg_.nof_prb)
 {
   for (uint32_t sl = 0; sl < slots.capacity(); ++sl) {
     slots.emplace_back(*cfg, sl % static_cast<uint32_t>(SRSRAN_NSLOTS_PER_FRAME_NR(bwp_cfg_.cell_cfg.carrier.scs)));
@@ -371,24 +371,26 @@ alloc_result bwp_slot_allocator::alloc_pdsch(slot_ue& ue, uint32_t ss_id, const
   slot_cfg.idx = ue.pdsch_slot.to_uint();
   // Value 0.95 is from TS 38.214 v15.14.00, Section 5.1.3, page 17
   const static float max_R = 0.95;
-  double             R_prime;
-  // The purpose of the internal loop is to decrease the MCS if the effective coderate is too high. This loop
-  // only affects the high MCS values
-  while (true) {
-    // Generate PDSCH
-    bool success = ue->phy().get_pdsch_cfg(slot_cfg, pdcch.dci, pdsch.sch);
+
+  // Generate PDSCH
+  bool success = ue->phy().get_pdsch_cfg(slot_cfg, pdcch.dci, pdsch.sch);
+  srsran_assert(success, "Error converting DCI to grant");
+  if (ue.h_dl->nof_retx() != 0) {
+    srsran_assert(pdsch.sch.grant.tb[0].tbs == (int)ue.h_dl->tbs(), "The TBS did not remain constant in retx");
+  }
+  double R_prime = pdsch.sch.grant.tb[0].R_prime;
+
+  // Decrease the MCS of a first transmission if the effective coderate is too high. The cached TBS of the grant give
+  // the highest MCS that fits, so the PDSCH is only generated once more. This only affects the high MCS values
+  bool pending_ccch = ue.get_pending_bytes(srsran::mac_sch_subpdu_nr::nr_lcid_sch_t::CCCH) > 0;
+  if (ue.h_dl->nof_retx() == 0 and R_prime >= max_R and mcs > 0 and not(pending_ccch and mcs <= min_MCS_ccch)) {
+    int max_mcs = bwp_grid.tbs_cache.find_max_mcs(pdsch.sch, mcs - 1, max_R);
+    mcs         = std::max(max_mcs, pending_ccch ? min_MCS_ccch : 0);
+
+    pdcch.dci.mcs = mcs;
+    success       = ue->phy().get_pdsch_cfg(slot_cfg, pdcch.dci, pdsch.sch);
     srsran_assert(success, "Error converting DCI to grant");
-    if (ue.h_dl->nof_retx() != 0) {
-      srsran_assert(pdsch.sch.grant.tb[0].tbs == (int)ue.h_dl->tbs(), "The TBS did not remain constant in retx");
-    }
     R_prime = pdsch.sch.grant.tb[0].R_prime;
-    if (ue.h_dl->nof_retx() > 0 or R_prime < max_R or mcs <= 0 or
-        (ue.get_pending_bytes(srsran::mac_sch_subpdu_nr::nr_lcid_sch_t::CCCH) and mcs <= min_MCS_ccch)) {
-      break;
-    }
-    // Decrease MCS if first tx and rate is too high
-    mcs--;
-    pdcch.dci.mcs = mcs;
   }
   if (R_prime >= max_R and mcs == 0) {
     logger.warning("Couldn't find mcs that leads to R<0.95");
@@ -410,7 +412,7 @@ alloc_result bwp_slot_allocator::alloc_pdsch(slot_ue& ue, uint32_t ss_id, const
   // Generate PUCCH
   bwp_uci_slot.pending_acks.emplace_back();
   bwp_uci_slot.pending_acks.back().phy_cfg = &ue->phy();
-  bool success = ue->phy().get_pdsch_ack_resource(pdcch.dci, bwp_uci_slot.pending_acks.back().res);
+  success = ue->phy().get_pdsch_ack_resource(pdcch.dci, bwp_uci_slot.pending_acks.back().res);
   srsran_assert(success, "Error getting ack resource");
 
   return alloc_result::success;
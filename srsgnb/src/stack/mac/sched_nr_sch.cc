@@ -21,6 +21,8 @@
 
 #include "srsgnb/hdr/stack/mac/sched_nr_sch.h"
 #include "srsran/common/string_helpers.h"
+#include "srsran/phy/phch/ra_nr.h"
+#include <cmath>
 
 namespace srsenb {
 namespace sched_nr_impl {
@@ -367,5 +369,105 @@ void pusch_allocator::cancel_last_pusch()
   puschs.pop_back();
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+srsran::span<const sch_tbs_cache::entry_t> sch_tbs_cache::get(const srsran_sch_cfg_nr_t& sch_cfg,
+                                                              uint32_t                   nof_grant_prb)
+{
+  srsran_assert(nof_grant_prb > 0 and nof_grant_prb <= nof_prb, "Invalid number of PRBs=%d", nof_grant_prb);
+  table_t& table = get_table(sch_cfg);
+  if (not table.row_ready[nof_grant_prb - 1]) {
+    fill_row(table, nof_grant_prb);
+  }
+  return {&table.entries[(nof_grant_prb - 1) * MAX_MCS], MAX_MCS};
+}
+
+int sch_tbs_cache::find_max_mcs(const srsran_sch_cfg_nr_t& sch_cfg, uint32_t max_mcs, double max_R)
+{
+  const srsran_sch_tb_t&      tb      = sch_cfg.grant.tb[0];
+  srsran::span<const entry_t> entries = get(sch_cfg, sch_cfg.grant.nof_prb);
+
+  // The number of REs of the grant, which does not depend on the MCS, sets the effective code rate of each TBS
+  for (int mcs = std::min(max_mcs, MAX_MCS - 1); mcs >= 0; --mcs) {
+    const entry_t& e = entries[mcs];
+    if (e.tbs > 0 and (double)e.tbs_crc_bits < max_R * (double)(tb.nof_re * e.Qm)) {
+      return mcs;
+    }
+  }
+  return -1;
+}
+
+uint32_t sch_tbs_cache::find_min_prbs(const srsran_sch_cfg_nr_t& sch_cfg, uint32_t mcs, uint32_t nof_bytes)
+{
+  srsran_assert(mcs < MAX_MCS, "Invalid MCS=%d", mcs);
+  table_t& table = get_table(sch_cfg);
+
+  // The TBS does not decrease with the number of PRBs
+  uint32_t lo = 1, hi = nof_prb + 1;
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    if (not table.row_ready[mid - 1]) {
+      fill_row(table, mid);
+    }
+    if (table.entries[(mid - 1) * MAX_MCS + mcs].tbs >= nof_bytes * 8) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return lo <= nof_prb ? lo : 0;
+}
+
+sch_tbs_cache::table_t& sch_tbs_cache::get_table(const srsran_sch_cfg_nr_t& sch_cfg)
+{
+  const srsran_sch_grant_nr_t& grant = sch_cfg.grant;
+  srsran_assert(grant.nof_prb > 0, "The grant has no PRBs");
+
+  // REs per PRB and layers of the first codeword used in the TBS calculation, see TS 38.214 5.1.3.2
+  int nof_re = srsran_ra_dl_nr_slot_nof_re(&sch_cfg, &grant);
+  srsran_assert(nof_re > 0, "Invalid number of RE (%d)", nof_re);
+  uint32_t nof_re_per_prb = (uint32_t)nof_re / grant.nof_prb;
+  uint32_t nof_layers     = grant.nof_layers / (grant.nof_layers < 5 ? 1 : 2);
+
+  for (table_t& table : tables) {
+    if (table.nof_re_per_prb == nof_re_per_prb and table.nof_layers == nof_layers and
+        table.mcs_table == sch_cfg.sch_cfg.mcs_table and table.dci_format == grant.dci_format and
+        table.ss_type == grant.dci_search_space and table.rnti_type == grant.rnti_type) {
+      return table;
+    }
+  }
+
+  tables.emplace_back();
+  table_t& table       = tables.back();
+  table.mcs_table      = sch_cfg.sch_cfg.mcs_table;
+  table.dci_format     = grant.dci_format;
+  table.ss_type        = grant.dci_search_space;
+  table.rnti_type      = grant.rnti_type;
+  table.nof_re_per_prb = nof_re_per_prb;
+  table.nof_layers     = nof_layers;
+  table.row_ready.resize(nof_prb, false);
+  table.entries.resize(nof_prb * MAX_MCS);
+  return table;
+}
+
+void sch_tbs_cache::fill_row(table_t& table, uint32_t nof_grant_prb)
+{
+  entry_t* row = &table.entries[(nof_grant_prb - 1) * MAX_MCS];
+  for (uint32_t mcs = 0; mcs < MAX_MCS; ++mcs) {
+    double R = srsran_ra_nr_R_from_mcs(table.mcs_table, table.dci_format, table.ss_type, table.rnti_type, mcs);
+    srsran_mod_t mod =
+        srsran_ra_nr_mod_from_mcs(table.mcs_table, table.dci_format, table.ss_type, table.rnti_type, mcs);
+    if (not std::isnormal(R) or mod >= SRSRAN_MOD_NITEMS) {
+      row[mcs] = {};
+      continue;
+    }
+    uint32_t Qm           = srsran_mod_bits_x_symbol(mod);
+    row[mcs].Qm           = Qm;
+    row[mcs].tbs          = srsran_ra_nr_tbs(table.nof_re_per_prb * nof_grant_prb, 1.0, R, Qm, table.nof_layers);
+    row[mcs].tbs_crc_bits = row[mcs].tbs + srsran_ra_nr_nof_crc_bits(row[mcs].tbs, R);
+  }
+  table.row_ready[nof_grant_prb - 1] = true;
+}
+
 } // namespace sched_nr_impl
 } // namespace srsenb
\ No newline at end of file
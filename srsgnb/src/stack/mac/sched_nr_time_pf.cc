@@ -0,0 +1,372 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsgnb/hdr/stack/mac/sched_nr_time_pf.h"
+#include "srsran/phy/phch/ra_nr.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+namespace {
+
+/// Coefficient of the exponential average of the allocated rates
+constexpr float pf_avg_alpha = 0.01;
+/// Number of samples averaged arithmetically before switching to the exponential average
+constexpr uint32_t pf_fast_start_len = 100;
+
+} // namespace
+
+sched_nr_time_pf::sched_nr_time_pf(const bwp_params_t& bwp_cfg)
+{
+  if (not bwp_cfg.sched_cfg.sched_policy_args.empty()) {
+    fairness_coeff = std::stof(bwp_cfg.sched_cfg.sched_policy_args);
+  }
+
+  dl_retx_list.reserve(SRSENB_MAX_UES);
+  ul_retx_list.reserve(SRSENB_MAX_UES);
+  heap_frontier.reserve(SRSENB_MAX_UES);
+}
+
+void sched_nr_time_pf::new_slot(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  current_slot = slot_alloc.get_pdcch_tti();
+  slot_count++;
+
+  // remove deleted users from history
+  for (auto it = ue_history_db.begin(); it != ue_history_db.end();) {
+    if (not ue_db.contains(it->first)) {
+      dl_heap.erase(&it->second);
+      ul_heap.erase(&it->second);
+      it = ue_history_db.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  // add new users to history db, and re-key only the users whose CQI or data state changed
+  dl_retx_list.clear();
+  ul_retx_list.clear();
+  for (auto& u : ue_db) {
+    slot_ue& ue = u.second;
+    auto     it = ue_history_db.find(u.first);
+    if (it == ue_history_db.end()) {
+      it = ue_history_db.insert(u.first, ue_ctxt{u.first}).value();
+    }
+    ue_ctxt& ctxt = it->second;
+
+    // The UL MCS is fixed, so only the DL expected rate depends on the channel
+    float dl_rate = 0;
+    if (ue.dl_cqi() > 0) {
+      dl_rate = srsran_ra_nr_cqi_to_se(ue.dl_cqi(), ue.cfg().phy().csi.reports->cqi_table);
+    }
+    bool rate_changed = dl_rate != ctxt.exp_rate[DL] or ctxt.exp_rate[UL] == 0;
+    if (rate_changed) {
+      ctxt.exp_rate[DL] = dl_rate;
+      ctxt.exp_rate[UL] = 1;
+      update_prio(ctxt, DL, slot_count - 1);
+      update_prio(ctxt, UL, slot_count - 1);
+      if (ctxt.heap_pos[DL] >= 0) {
+        dl_heap.update(&ctxt);
+      }
+      if (ctxt.heap_pos[UL] >= 0) {
+        ul_heap.update(&ctxt);
+      }
+    }
+    set_data(ctxt, DL, ue.dl_bytes > 0 and ue.h_dl != nullptr and ue.h_dl->empty());
+    set_data(ctxt, UL, ue.ul_bytes > 0 and ue.h_ul != nullptr and ue.h_ul->empty());
+
+    if (ue.h_dl != nullptr and ue.h_dl->has_pending_retx(slot_alloc.get_tti_rx())) {
+      dl_retx_list.push_back(&ctxt);
+    }
+    if (ue.h_ul != nullptr and ue.h_ul->has_pending_retx(slot_alloc.get_tti_rx())) {
+      ul_retx_list.push_back(&ctxt);
+    }
+  }
+
+  auto dl_cmp = [](const ue_ctxt* lhs, const ue_ctxt* rhs) { return lhs->prio_key[DL] > rhs->prio_key[DL]; };
+  auto ul_cmp = [](const ue_ctxt* lhs, const ue_ctxt* rhs) { return lhs->prio_key[UL] > rhs->prio_key[UL]; };
+  std::sort(dl_retx_list.begin(), dl_retx_list.end(), dl_cmp);
+  std::sort(ul_retx_list.begin(), ul_retx_list.end(), ul_cmp);
+}
+
+void sched_nr_time_pf::set_data(ue_ctxt& u, direction dir, bool has_data)
+{
+  if (u.has_data[dir] == has_data) {
+    return;
+  }
+  u.has_data[dir] = has_data;
+  ue_heap& heap   = dir == DL ? dl_heap : ul_heap;
+  if (has_data) {
+    heap.update(&u);
+  } else {
+    heap.erase(&u);
+  }
+}
+
+/// Visits the UEs of a heap from the highest to the lowest priority until "f" returns false. Only the visited UEs and
+/// their children are touched, so stopping after k UEs costs O(k log k)
+template <typename Func>
+void sched_nr_time_pf::for_each_by_prio(direction dir, Func&& f)
+{
+  const ue_heap& heap = dir == DL ? dl_heap : ul_heap;
+  auto           cmp  = [&heap](size_t lhs, size_t rhs) { return heap.higher(rhs, lhs); };
+
+  heap_frontier.clear();
+  if (heap.size() > 0) {
+    heap_frontier.push_back(0);
+  }
+  while (not heap_frontier.empty()) {
+    std::pop_heap(heap_frontier.begin(), heap_frontier.end(), cmp);
+    size_t pos = heap_frontier.back();
+    heap_frontier.pop_back();
+    if (not f(*heap[pos])) {
+      return;
+    }
+    for (size_t child = 2 * pos + 1; child <= 2 * pos + 2 and child < heap.size(); ++child) {
+      heap_frontier.push_back(child);
+      std::push_heap(heap_frontier.begin(), heap_frontier.end(), cmp);
+    }
+  }
+}
+
+/*****************************************************************
+ *                         Dowlink
+ *****************************************************************/
+
+void sched_nr_time_pf::sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  if (current_slot != slot_alloc.get_pdcch_tti()) {
+    new_slot(ue_db, slot_alloc);
+  }
+
+  // Retransmissions go first
+  for (ue_ctxt* u : dl_retx_list) {
+    slot_ue&     ue  = ue_db[u->rnti];
+    alloc_result res = slot_alloc.alloc_pdsch(ue, ue->find_ss_id(srsran_dci_format_nr_1_0), ue.h_dl->prbs());
+    if (res == alloc_result::success) {
+      save_alloc(*u, DL, ue.h_dl->tbs() / 8);
+    }
+  }
+
+  // New transmissions take the whole empty PRB interval, so the first successful UE ends the walk. The walk only reads
+  // the heap, so the key is updated afterwards
+  ue_ctxt* allocated = nullptr;
+  for_each_by_prio(DL, [&ue_db, &slot_alloc, &allocated](ue_ctxt& u) {
+    slot_ue& ue    = ue_db[u.rnti];
+    int      ss_id = ue->find_ss_id(srsran_dci_format_nr_1_0);
+    if (ss_id < 0) {
+      return true;
+    }
+    prb_grant prbs = find_optimal_dl_grant(slot_alloc, ue, ss_id);
+    if (prbs.is_alloc_type1() and prbs.prbs().empty()) {
+      return false;
+    }
+    if (slot_alloc.alloc_pdsch(ue, ss_id, prbs) == alloc_result::success) {
+      allocated = &u;
+      return false;
+    }
+    return true;
+  });
+  if (allocated != nullptr) {
+    save_alloc(*allocated, DL, ue_db[allocated->rnti].h_dl->tbs() / 8);
+  }
+}
+
+/*****************************************************************
+ *                         Uplink
+ *****************************************************************/
+
+void sched_nr_time_pf::sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  if (current_slot != slot_alloc.get_pdcch_tti()) {
+    new_slot(ue_db, slot_alloc);
+  }
+
+  // Retransmissions go first
+  for (ue_ctxt* u : ul_retx_list) {
+    slot_ue&     ue  = ue_db[u->rnti];
+    alloc_result res = slot_alloc.alloc_pusch(ue, ue.h_ul->prbs());
+    if (res == alloc_result::success) {
+      save_alloc(*u, UL, ue.h_ul->tbs() / 8);
+    }
+  }
+
+  // New transmissions take the whole BWP, so the first successful UE ends the walk
+  ue_ctxt* allocated = nullptr;
+  for_each_by_prio(UL, [&ue_db, &slot_alloc, &allocated](ue_ctxt& u) {
+    slot_ue& ue = ue_db[u.rnti];
+    if (slot_alloc.alloc_pusch(ue, prb_interval{0, slot_alloc.cfg.cfg.rb_width}) == alloc_result::success) {
+      allocated = &u;
+      return false;
+    }
+    return true;
+  });
+  if (allocated != nullptr) {
+    save_alloc(*allocated, UL, ue_db[allocated->rnti].h_ul->tbs() / 8);
+  }
+}
+
+/*****************************************************************
+ *                          UE history
+ *****************************************************************/
+
+void sched_nr_time_pf::save_alloc(ue_ctxt& u, direction dir, uint32_t alloc_bytes)
+{
+  u.avg_rate[dir].add_sample(slot_count, alloc_bytes);
+  update_prio(u, dir, slot_count);
+  // The allocated HARQ is no longer empty
+  set_data(u, dir, false);
+}
+
+/// The PF priority r / R^c at slot t is stored as log(r) - c * log(R(t0)) + c * t0 * log(1 - alpha), where t0 is the
+/// last slot included in the average R. The term -c * t * log(1 - alpha) that is common to all UEs is left out, so
+/// the keys of the UEs that are not allocated keep their order without being updated
+void sched_nr_time_pf::update_prio(ue_ctxt& u, direction dir, uint64_t count)
+{
+  float r = u.exp_rate[dir];
+  float R = u.avg_rate[dir].value(count);
+  if (r == 0) {
+    u.prio_key[dir] = -std::numeric_limits<double>::infinity();
+  } else if (u.avg_rate[dir].count() == 0 or R == 0) {
+    u.prio_key[dir] = std::numeric_limits<double>::infinity();
+  } else {
+    u.prio_key[dir] = std::log((double)r) - fairness_coeff * std::log((double)R) +
+                      fairness_coeff * (double)count * std::log(1.0 - pf_avg_alpha);
+  }
+}
+
+float sched_nr_time_pf::rate_average::value(uint64_t slot_count)
+{
+  advance(slot_count);
+  return nof_samples == 0 ? 0 : avg_rate;
+}
+
+/// Applies the zero samples of the slots without allocation up to slot_count. The slots before the first allocation
+/// are not counted, so that the first allocations still go through the fast start
+void sched_nr_time_pf::rate_average::advance(uint64_t slot_count)
+{
+  if (slot_count <= last_slot) {
+    return;
+  }
+  uint64_t nof_zeros = slot_count - last_slot;
+  last_slot          = slot_count;
+  if (nof_samples == 0) {
+    return;
+  }
+
+  if (nof_samples < pf_fast_start_len) {
+    // fast start, the arithmetic average of n samples times n / (n + k)
+    uint32_t nof_fast = std::min<uint64_t>(nof_zeros, pf_fast_start_len - nof_samples);
+    avg_rate          = avg_rate * nof_samples / (nof_samples + nof_fast);
+    nof_samples += nof_fast;
+    nof_zeros -= nof_fast;
+  }
+  if (nof_zeros > 0) {
+    avg_rate *= std::pow(1 - pf_avg_alpha, (float)nof_zeros);
+  }
+}
+
+void sched_nr_time_pf::rate_average::add_sample(uint64_t slot_count, uint32_t alloc_bytes)
+{
+  advance(slot_count - 1);
+  if (nof_samples < pf_fast_start_len) {
+    // fast start
+    avg_rate = avg_rate + (alloc_bytes - avg_rate) / (nof_samples + 1);
+    nof_samples++;
+  } else {
+    avg_rate = (1 - pf_avg_alpha) * avg_rate + (pf_avg_alpha)*alloc_bytes;
+  }
+  last_slot = slot_count;
+}
+
+/*****************************************************************
+ *                        UE priority heap
+ *****************************************************************/
+
+void sched_nr_time_pf::ue_heap::update(ue_ctxt* u)
+{
+  if (u->heap_pos[dir] < 0) {
+    heap.push_back(u);
+    u->heap_pos[dir] = heap.size() - 1;
+  }
+  sift_up(u->heap_pos[dir]);
+  sift_down(u->heap_pos[dir]);
+}
+
+void sched_nr_time_pf::ue_heap::erase(ue_ctxt* u)
+{
+  if (u->heap_pos[dir] < 0) {
+    return;
+  }
+  size_t pos  = u->heap_pos[dir];
+  size_t last = heap.size() - 1;
+  if (pos != last) {
+    swap_pos(pos, last);
+  }
+  heap.pop_back();
+  u->heap_pos[dir] = -1;
+  if (pos < heap.size()) {
+    sift_up(pos);
+    sift_down(heap[pos]->heap_pos[dir]);
+  }
+}
+
+void sched_nr_time_pf::ue_heap::swap_pos(size_t lhs, size_t rhs)
+{
+  std::swap(heap[lhs], heap[rhs]);
+  heap[lhs]->heap_pos[dir] = lhs;
+  heap[rhs]->heap_pos[dir] = rhs;
+}
+
+void sched_nr_time_pf::ue_heap::sift_up(size_t pos)
+{
+  while (pos > 0) {
+    size_t parent = (pos - 1) / 2;
+    if (not higher(pos, parent)) {
+      break;
+    }
+    swap_pos(pos, parent);
+    pos = parent;
+  }
+}
+
+void sched_nr_time_pf::ue_heap::sift_down(size_t pos)
+{
+  while (true) {
+    size_t best = pos;
+    for (size_t child = 2 * pos + 1; child <= 2 * pos + 2 and child < heap.size(); ++child) {
+      if (higher(child, best)) {
+        best = child;
+      }
+    }
+    if (best == pos) {
+      break;
+    }
+    swap_pos(pos, best);
+    pos = best;
+  }
+}
+
+} // namespace sched_nr_impl
+} // namespace srsenb
@@ -122,7 +122,10 @@ ue_carrier::ue_carrier(uint16_t                              rnti_,
   cell_params(cell_params_),
   pdu_builder(pdu_builder_),
   common_ctxt(ctxt),
-  harq_ent(rnti_, cell_params_.nof_prb(), SCHED_NR_MAX_HARQ, cell_params_.bwps[0].logger)
+  harq_ent(rnti_, cell_params_.nof_prb(), SCHED_NR_MAX_HARQ, cell_params_.bwps[0].logger),
+  dl_olla(cell_params_.sched_args.target_bler,
+          cell_params_.sched_args.adaptive_dl_mcs_step_size,
+          cell_params_.sched_args.max_delta_dl_cqi)
 {}
 
 void ue_carrier::set_cfg(const ue_cfg_manager& ue_cfg)
@@ -143,9 +146,30 @@ int ue_carrier::dl_ack_info(uint32_t pid, uint32_t tb_idx, bool ack)
     metrics.tx_errors++;
   }
   metrics.tx_pkts++;
+
+  // Adapt DL MCS based on BLER
+  if (dl_olla.enabled() and bwp_cfg.fixed_pdsch_mcs() < 0) {
+    int mcs     = harq_ent.dl_harq(pid).mcs();
+    int max_mcs = bwp_cfg.phy().pdsch.mcs_table == srsran_mcs_table_256qam ? 27 : 28;
+    dl_olla.harq_feedback(ack, mcs, max_mcs);
+    logger.info("SCHED: DL adaptive link: rnti=0x%x, cqi=%d, last_mcs=%d, cqi_offset=%f",
+                rnti,
+                dl_cqi,
+                mcs,
+                dl_olla.get_offset());
+  }
   return tbs;
 }
 
+uint32_t ue_carrier::get_dl_cqi() const
+{
+  if (dl_cqi == 0) {
+    // Out of range CQI reports are not corrected
+    return 0;
+  }
+  return std::max(1, (int)std::min(static_cast<float>(dl_cqi) + dl_olla.get_offset(), 15.0f));
+}
+
 int ue_carrier::ul_crc_info(uint32_t pid, bool crc)
 {
   int ret = harq_ent.ul_crc_info(pid, crc);
@@ -0,0 +1,259 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_nr_cfg_generators.h"
+#include "sched_nr_sim_ue.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <random>
+
+namespace srsenb {
+
+/// Logical channel and LCG of the UE traffic
+const static uint32_t bench_lcid = 4, bench_lcg = 1;
+
+struct bench_params {
+  uint32_t    nof_cells    = 4;
+  uint32_t    nof_ues      = SRSENB_MAX_UES;
+  uint32_t    nof_slots    = 2000;
+  float       bler         = 0.1;
+  std::string sched_policy = "time_rr";
+};
+
+struct bench_results {
+  uint32_t slot_usec_p50     = 0;
+  uint32_t slot_usec_p99     = 0;
+  uint32_t slot_usec_max     = 0;
+  float    dl_prb_efficiency = 0;
+  float    ul_prb_efficiency = 0;
+};
+
+/// Tester with a mix of full-buffer, bursty and low-rate UEs, random-walk CQI traces and HARQ NACKs
+class sched_nr_bench_tester : public sched_nr_base_test_bench
+{
+public:
+  enum class traffic_type { full_buffer, bursty, low_rate };
+
+  sched_nr_bench_tester(const bench_params&                     params_,
+                        const sched_nr_interface::sched_args_t& sched_args,
+                        const std::vector<sched_nr_cell_cfg_t>& cells_cfg) :
+    sched_nr_base_test_bench(sched_args, cells_cfg, "Scheduler benchmark"), params(params_)
+  {}
+
+  void set_external_slot_events(const sim_nr_ue_ctxt_t& ue_ctxt, ue_nr_slot_events& pending_events) override
+  {
+    ue_channel& ch = channels[ue_ctxt.rnti];
+    if (not ch.init) {
+      ch.init    = true;
+      ch.traffic = static_cast<traffic_type>(ue_ctxt.rnti % 3);
+      ch.cqi     = std::uniform_int_distribution<int>{2, 15}(rand_gen);
+    }
+    uint32_t slot = pending_events.slot_rx.to_uint();
+
+    // Traffic model
+    uint32_t dl_newtx = 0;
+    switch (ch.traffic) {
+      case traffic_type::full_buffer: {
+        uint32_t unacked = gnb_ue_db[ue_ctxt.rnti].logical_channels[bench_lcid].rlc_unacked;
+        dl_newtx         = unacked < 100000 ? 100000 - unacked : 0;
+        sched_ptr->ul_bsr(ue_ctxt.rnti, bench_lcg, 100000);
+      } break;
+      case traffic_type::bursty:
+        if (std::bernoulli_distribution{0.02}(rand_gen)) {
+          dl_newtx = 1500 * std::uniform_int_distribution<uint32_t>{1, 20}(rand_gen);
+          sched_ptr->ul_bsr(ue_ctxt.rnti, bench_lcg, dl_newtx / 4);
+        }
+        break;
+      case traffic_type::low_rate:
+        if ((slot + ue_ctxt.rnti) % 20 == 0) {
+          dl_newtx = 40;
+          sched_ptr->ul_bsr(ue_ctxt.rnti, bench_lcg, 40);
+        }
+        break;
+    }
+    if (dl_newtx > 0) {
+      add_rlc_dl_bytes(ue_ctxt.rnti, bench_lcid, dl_newtx);
+    }
+
+    // CQI trace
+    if ((slot + ue_ctxt.rnti) % 5 == 0) {
+      ch.cqi = std::max(1, std::min(15, ch.cqi + std::uniform_int_distribution<int>{-1, 1}(rand_gen)));
+      for (auto& cc : pending_events.cc_list) {
+        if (cc.configured) {
+          cc.cqi = ch.cqi;
+        }
+      }
+    }
+
+    // HARQ feedback
+    for (auto& cc : pending_events.cc_list) {
+      for (auto& ack : cc.dl_acks) {
+        ack.ack = not std::bernoulli_distribution{params.bler}(rand_gen);
+      }
+      for (auto& ack : cc.ul_acks) {
+        ack.ack = not std::bernoulli_distribution{params.bler}(rand_gen);
+      }
+    }
+  }
+
+  void process_slot_result(const sim_nr_enb_ctxt_t& slot_ctxt, srsran::const_span<cc_result_t> cc_list) override
+  {
+    // The CC results are generated one after the other, so the latest one marks the end of the slot
+    latency_samples.push_back(
+        std::max_element(cc_list.begin(), cc_list.end(), [](const cc_result_t& lhs, const cc_result_t& rhs) {
+          return lhs.cc_latency_ns < rhs.cc_latency_ns;
+        })->cc_latency_ns.count());
+
+    for (auto& cc_out : cc_list) {
+      const sched_nr_impl::bwp_params_t& bwp      = cell_params[cc_out.res.cc].bwps[0];
+      uint32_t                          slot_idx = cc_out.res.slot.slot_idx();
+      if (bwp.slots[slot_idx].is_dl) {
+        dl_cell_prbs += bwp.nof_prb;
+        for (auto& pdsch : cc_out.res.dl->phy.pdsch) {
+          dl_data_prbs += pdsch.sch.grant.nof_prb;
+        }
+      }
+      if (bwp.slots[slot_idx].is_ul) {
+        ul_cell_prbs += bwp.nof_prb;
+        for (auto& pusch : cc_out.res.ul->pusch) {
+          ul_data_prbs += pusch.sch.grant.nof_prb;
+        }
+      }
+    }
+  }
+
+  bench_results get_results()
+  {
+    bench_results r{};
+    if (latency_samples.empty()) {
+      return r;
+    }
+    std::sort(latency_samples.begin(), latency_samples.end());
+    r.slot_usec_p50     = latency_samples[latency_samples.size() / 2] / 1000;
+    r.slot_usec_p99     = latency_samples[static_cast<size_t>(latency_samples.size() * 0.99)] / 1000;
+    r.slot_usec_max     = latency_samples.back() / 1000;
+    r.dl_prb_efficiency = dl_cell_prbs > 0 ? dl_data_prbs / (float)dl_cell_prbs : 0;
+    r.ul_prb_efficiency = ul_cell_prbs > 0 ? ul_data_prbs / (float)ul_cell_prbs : 0;
+    return r;
+  }
+
+  void reset_stats()
+  {
+    latency_samples.clear();
+    dl_data_prbs = dl_cell_prbs = ul_data_prbs = ul_cell_prbs = 0;
+  }
+
+private:
+  struct ue_channel {
+    bool         init    = false;
+    traffic_type traffic = traffic_type::full_buffer;
+    int          cqi     = 15;
+  };
+
+  const bench_params&            params;
+  std::mt19937                   rand_gen{0};
+  std::map<uint16_t, ue_channel> channels;
+
+  std::vector<uint64_t> latency_samples;
+  uint64_t              dl_data_prbs = 0, dl_cell_prbs = 0, ul_data_prbs = 0, ul_cell_prbs = 0;
+};
+
+bench_results run_sched_nr_benchmark(const bench_params& params)
+{
+  sched_nr_interface::sched_args_t cfg;
+  cfg.sched_policy                           = params.sched_policy;
+  std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(params.nof_cells);
+
+  sched_nr_bench_tester tester(params, cfg, cells_cfg);
+
+  // The UEs are spread across the cells, one carrier each
+  uint32_t warmup_slots = 100;
+  for (uint32_t nof_slots = 0; nof_slots < warmup_slots + params.nof_slots; ++nof_slots) {
+    slot_point slot_rx(0, nof_slots % 10240);
+    slot_point slot_tx = slot_rx + TX_ENB_DELAY;
+    if (nof_slots == 9) {
+      for (uint32_t ue_idx = 0; ue_idx < params.nof_ues; ++ue_idx) {
+        sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(1);
+        uecfg.carriers[0].cc               = ue_idx % params.nof_cells;
+        uecfg.lc_ch_to_add.emplace_back();
+        uecfg.lc_ch_to_add.back().lcid          = bench_lcid;
+        uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
+        uecfg.lc_ch_to_add.back().cfg.group     = bench_lcg;
+        tester.user_cfg(0x4601 + ue_idx, uecfg);
+      }
+    }
+    if (nof_slots == warmup_slots) {
+      tester.reset_stats();
+    }
+    tester.run_slot(slot_tx);
+  }
+  tester.stop();
+
+  return tester.get_results();
+}
+
+} // namespace srsenb
+
+/// Usage: sched_nr_benchmark [nof_slots] [max_p99_usec]. When max_p99_usec > 0, the run fails if the p99 of the slot
+/// scheduling time exceeds it, so that the benchmark can be used for regression gating
+int main(int argc, char** argv)
+{
+  auto& test_logger = srslog::fetch_basic_logger("TEST");
+  test_logger.set_level(srslog::basic_levels::warning);
+  auto& mac_nr_logger = srslog::fetch_basic_logger("MAC-NR");
+  mac_nr_logger.set_level(srslog::basic_levels::warning);
+  auto& mac_logger = srslog::fetch_basic_logger("MAC");
+  mac_logger.set_level(srslog::basic_levels::warning);
+
+  // Start the log backend.
+  srslog::init();
+
+  srsenb::bench_params params{};
+  if (argc > 1) {
+    params.nof_slots = std::strtoul(argv[1], nullptr, 10);
+  }
+  uint32_t max_p99_usec = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 0;
+
+  bool success = true;
+  for (const char* policy : {"time_rr", "time_pf"}) {
+    params.sched_policy          = policy;
+    srsenb::bench_results result = srsenb::run_sched_nr_benchmark(params);
+
+    srslog::flush();
+    fmt::print("sched_nr_benchmark: policy={} nof_cells={} nof_ues={} nof_slots={} slot_usec_p50={} slot_usec_p99={} "
+               "slot_usec_max={} dl_prb_eff={:.3f} ul_prb_eff={:.3f}\n",
+               params.sched_policy,
+               params.nof_cells,
+               params.nof_ues,
+               params.nof_slots,
+               result.slot_usec_p50,
+               result.slot_usec_p99,
+               result.slot_usec_max,
+               result.dl_prb_efficiency,
+               result.ul_prb_efficiency);
+    if (max_p99_usec > 0 and result.slot_usec_p99 > max_p99_usec) {
+      fmt::print("Slot scheduling time p99 above the limit ({} > {}) usec\n", result.slot_usec_p99, max_p99_usec);
+      success = false;
+    }
+  }
+
+  return success ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+}
@@ -25,6 +25,7 @@
 #include "srsran/common/test_common.h"
 extern "C" {
 #include "srsran/phy/common/sliv.h"
+#include "srsran/phy/phch/ra_nr.h"
 }
 
 namespace srsenb {
@@ -473,6 +474,68 @@ void test_multi_pusch()
   fmt::print("C-RNTI allocated in Common SearchSpace. Occupied PRBs:\n{:b} -> {:b}\n", last_prb_bitmap, used_prbs_ue2);
 }
 
+void test_tbs_cache()
+{
+  srsran::test_delimit_logger delimiter{"Test SCH TBS cache"};
+
+  // Create Cell and UE configs
+  sched_nr_interface::sched_args_t   sched_args;
+  sched_nr_cell_cfg_t                cellcfg = get_cell_cfg();
+  sched_nr_impl::cell_config_manager cell_params{0, get_cell_cfg(), sched_args};
+  sched_nr_impl::ue_cfg_manager      uecfg{get_ue_cfg(cellcfg)};
+  const bwp_params_t&                bwp_params = cell_params.bwps[0];
+  ue_carrier_params_t                ue_cc{0x4601, bwp_params, uecfg};
+
+  pdsch_list_t    pdschs;
+  pdsch_allocator pdsch_sched(bwp_params, 0, pdschs);
+  sch_tbs_cache   tbs_cache(bwp_params.nof_prb);
+
+  pdcch_dl_t pdcch;
+  pdcch.dci.ctx = generate_dci_ctx(bwp_params.cfg.pdcch, 2, srsran_rnti_type_c, 0x4601);
+
+  prb_interval       grant{0, bwp_params.nof_prb};
+  pdsch_alloc_result alloc_res = pdsch_sched.alloc_ue_pdsch(2, srsran_dci_format_nr_1_0, grant, ue_cc, pdcch.dci);
+  TESTASSERT(alloc_res.has_value());
+  srsran_slot_cfg_t   slot_cfg = {};
+  srsran_sch_cfg_nr_t sch      = {};
+  TESTASSERT(ue_cc.phy().get_pdsch_cfg(slot_cfg, pdcch.dci, sch));
+  auto set_grant_prbs = [&sch](uint32_t nof_prb) {
+    sch.grant.nof_prb = nof_prb;
+    for (uint32_t i = 0; i < SRSRAN_MAX_PRB_NR; ++i) {
+      sch.grant.prb_idx[i] = i < nof_prb;
+    }
+  };
+
+  // The cached TBS matches the one derived for the grant by the PHY
+  for (uint32_t nof_prb = 1; nof_prb <= bwp_params.nof_prb; ++nof_prb) {
+    set_grant_prbs(nof_prb);
+    srsran::span<const sch_tbs_cache::entry_t> entries = tbs_cache.get(sch, nof_prb);
+    for (uint32_t mcs = 0; mcs < sch_tbs_cache::MAX_MCS; ++mcs) {
+      srsran_sch_tb_t tb = {};
+      if (srsran_ra_nr_fill_tb(&sch, &sch.grant, mcs, &tb) < SRSRAN_SUCCESS) {
+        TESTASSERT_EQ(0, entries[mcs].tbs);
+        continue;
+      }
+      TESTASSERT_EQ((uint32_t)tb.tbs, entries[mcs].tbs);
+      TESTASSERT_EQ(srsran_mod_bits_x_symbol(tb.mod), entries[mcs].Qm);
+    }
+  }
+
+  // The minimum number of PRBs is the first whose TBS carries the bytes
+  for (uint32_t mcs : {0, 9, 27}) {
+    for (uint32_t nof_bytes : {1, 100, 1000, 100000}) {
+      uint32_t expected = 0;
+      for (uint32_t nof_prb = 1; nof_prb <= bwp_params.nof_prb and expected == 0; ++nof_prb) {
+        set_grant_prbs(nof_prb);
+        if (tbs_cache.get(sch, nof_prb)[mcs].tbs >= nof_bytes * 8) {
+          expected = nof_prb;
+        }
+      }
+      TESTASSERT_EQ(expected, tbs_cache.find_min_prbs(sch, mcs, nof_bytes));
+    }
+  }
+}
+
 } // namespace srsenb
 
 int main()
@@ -493,4 +556,5 @@ int main()
   srsenb::test_pdsch_fail();
   srsenb::test_multi_pdsch();
   srsenb::test_multi_pusch();
+  srsenb::test_tbs_cache();
 }
\ No newline at end of file
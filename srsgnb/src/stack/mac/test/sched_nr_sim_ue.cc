@@ -34,7 +34,8 @@ sched_nr_ue_sim::sched_nr_ue_sim(uint16_t rnti_, const sched_nr_ue_cfg_t& ue_cfg
   ctxt.ue_cfg.apply_config_request(ue_cfg_);
   ctxt.preamble_idx = -1;
 
-  ctxt.cc_list.resize(ue_cfg_.carriers.size());
+  // The CC contexts are indexed by the cell index, so that UEs can be configured in any cell
+  ctxt.cc_list.resize(SCHED_NR_MAX_CARRIERS);
   for (auto& cc : ctxt.cc_list) {
     for (size_t pid = 0; pid < SCHED_NR_MAX_HARQ; ++pid) {
       cc.ul_harqs[pid].pid = pid;
@@ -444,7 +445,15 @@ int sched_nr_base_test_bench::set_default_slot_events(const sim_nr_ue_ctxt_t& ue
   for (uint32_t enb_cc_idx = 0; enb_cc_idx < pending_events.cc_list.size(); ++enb_cc_idx) {
     auto& cc_feedback = pending_events.cc_list[enb_cc_idx];
 
-    cc_feedback.configured = true;
+    auto& ue_carriers      = ue_ctxt.ue_cfg.carriers;
+    cc_feedback.configured =
+        std::any_of(ue_carriers.begin(), ue_carriers.end(), [enb_cc_idx](const sched_nr_ue_cc_cfg_t& c) {
+          return c.active and c.cc == enb_cc_idx;
+        });
+    if (not cc_feedback.configured) {
+      continue;
+    }
+
     for (uint32_t pid = 0; pid < SCHED_NR_MAX_HARQ; ++pid) {
       auto& dl_h = ue_ctxt.cc_list[enb_cc_idx].dl_harqs[pid];
       auto& ul_h = ue_ctxt.cc_list[enb_cc_idx].ul_harqs[pid];
@@ -172,7 +172,7 @@ void test_sched_nr_no_data(sim_args_t args)
   TESTASSERT_EQ(1, tester.ue_metrics[rnti].nof_ul_txs);
 }
 
-void test_sched_nr_data(sim_args_t args)
+void test_sched_nr_data(sim_args_t args, const std::string& sched_policy)
 {
   uint32_t nof_sectors = 1;
   uint16_t rnti        = 0x4601;
@@ -181,9 +181,10 @@ void test_sched_nr_data(sim_args_t args)
 
   sched_nr_interface::sched_args_t cfg;
   cfg.auto_refill_buffer                     = false;
+  cfg.sched_policy                           = sched_policy;
   std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(nof_sectors);
 
-  std::string  test_name = "Test with data";
+  std::string  test_name = "Test with data, policy=" + sched_policy;
   sched_tester tester(args, cfg, cells_cfg, test_name);
 
   /* Set events */
@@ -328,7 +329,8 @@ int main(int argc, char** argv)
       (void*)&args);
 
   srsenb::test_sched_nr_no_data(args);
-  srsenb::test_sched_nr_data(args);
+  srsenb::test_sched_nr_data(args, "time_rr");
+  srsenb::test_sched_nr_data(args, "time_pf");
 
   fmt::print("TEST: Random Seed was {}", args.rand_seed);
 }
@@ -43,8 +43,7 @@ ue_nr::ue_nr(uint16_t                rnti_,
   rrc(rrc_),
   rlc(rlc_),
   phy(phy_),
-  logger(logger_),
-  ue_rlc_buffer(srsran::make_byte_buffer())
+  logger(logger_)
 {}
 
 ue_nr::~ue_nr() {}
@@ -105,41 +104,31 @@ int ue_nr::generate_pdu(srsran::byte_buffer_t* pdu, uint32_t grant_size, srsran:
     } else {
       // add SDUs for given LCID
       while (remaining_len >= MIN_RLC_PDU_LEN) {
-        // clear read buffer
-        ue_rlc_buffer->clear();
-
         // Determine space for RLC
         remaining_len -= remaining_len >= srsran::mac_sch_subpdu_nr::MAC_SUBHEADER_LEN_THRESHOLD ? 3 : 2;
 
-        // read RLC PDU
-        int pdu_len = rlc->read_pdu(rnti, lcid, ue_rlc_buffer->msg, remaining_len);
-
-        if (pdu_len > remaining_len) {
-          logger.error("Can't add SDU of %d B. Available space %d B", pdu_len, remaining_len);
+        // Let RLC write its PDU straight into the MAC PDU
+        int pdu_len = mac_pdu_dl.add_sdu(lcid, remaining_len, this);
+        if (pdu_len < 0) {
+          logger.error("Error packing MAC PDU");
+          break;
+        }
+        // Add SDU if RLC has something to tx
+        if (pdu_len == 0) {
           break;
-        } else {
-          // Add SDU if RLC has something to tx
-          if (pdu_len > 0) {
-            ue_rlc_buffer->N_bytes = pdu_len;
-            logger.debug(ue_rlc_buffer->msg, ue_rlc_buffer->N_bytes, "Read %d B from RLC", ue_rlc_buffer->N_bytes);
-
-            // add to MAC PDU and pack
-            if (mac_pdu_dl.add_sdu(lcid, ue_rlc_buffer->msg, ue_rlc_buffer->N_bytes) != SRSRAN_SUCCESS) {
-              logger.error("Error packing MAC PDU");
-              break;
-            }
-
-            // set DRB activity flag but only notify RRC once
-            if (lcid > 3) {
-              drb_activity = true;
-            }
-          } else {
-            break;
-          }
-
-          remaining_len -= pdu_len;
-          logger.debug("%d B remaining PDU", remaining_len);
         }
+        if (logger.debug.enabled()) {
+          const srsran::mac_sch_subpdu_nr& subpdu = mac_pdu_dl.get_subpdu(mac_pdu_dl.get_num_subpdus() - 1);
+          logger.debug(subpdu.get_sdu(), pdu_len, "Read %d B from RLC", pdu_len);
+        }
+
+        // set DRB activity flag but only notify RRC once
+        if (lcid > 3) {
+          drb_activity = true;
+        }
+
+        remaining_len -= pdu_len;
+        logger.debug("%d B remaining PDU", remaining_len);
       }
     }
   }
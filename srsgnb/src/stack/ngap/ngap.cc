@@ -101,6 +101,7 @@ void ngap::ng_setup_proc_t::then(const srsran::proc_state_t& result) const
     srsran::console("Failed to initiate NG connection. Attempting reconnection in %d seconds\n",
                     ngap_ptr->amf_connect_timer.duration() / 1000);
     ngap_ptr->rx_socket_handler->remove_socket(ngap_ptr->amf_socket.get_socket());
+    ngap_ptr->amf_tx.clear_socket();
     ngap_ptr->amf_socket.close();
     procInfo("NGAP socket closed.");
     ngap_ptr->amf_connect_timer.run();
@@ -115,7 +116,11 @@ void ngap::ng_setup_proc_t::then(const srsran::proc_state_t& result) const
 ngap::ngap(srsran::task_sched_handle   task_sched_,
            srslog::basic_logger&       logger,
            srsran::socket_manager_itf* rx_socket_handler_) :
-  ngsetup_proc(this), logger(logger), task_sched(task_sched_), rx_socket_handler(rx_socket_handler_)
+  ngsetup_proc(this),
+  logger(logger),
+  task_sched(task_sched_),
+  rx_socket_handler(rx_socket_handler_),
+  amf_tx(logger, "NGAP_TX")
 {
   amf_task_queue = task_sched.make_task_queue();
 }
@@ -149,6 +154,8 @@ int ngap::init(const ngap_args_t& args_, rrc_interface_ngap_nr* rrc_, gtpu_inter
     ngsetup_proc.trigger(res);
   });
 
+  rx_worker.reset(new srsran::task_worker("NGAP", 512));
+
   running = true;
   // starting AMF connection
   if (not ngsetup_proc.launch()) {
@@ -161,7 +168,12 @@ int ngap::init(const ngap_args_t& args_, rrc_interface_ngap_nr* rrc_, gtpu_inter
 void ngap::stop()
 {
   running = false;
+  amf_tx.flush();
+  amf_tx.stop();
   amf_socket.close();
+  if (rx_worker != nullptr) {
+    rx_worker->stop();
+  }
 }
 
 void ngap::get_metrics(ngap_metrics_t& m)
@@ -300,9 +312,8 @@ ngap::ue* ngap::user_list::find_ue_rnti(uint16_t rnti)
   if (rnti == SRSRAN_INVALID_RNTI) {
     return nullptr;
   }
-  auto it = std::find_if(
-      users.begin(), users.end(), [rnti](const user_list::pair_type& v) { return v.second->ctxt.rnti == rnti; });
-  return it != users.end() ? it->second.get() : nullptr;
+  auto it = rnti_to_ran_id.find(rnti);
+  return it != rnti_to_ran_id.end() ? find_ue_gnbid(it->second) : nullptr;
 }
 
 ngap::ue* ngap::user_list::find_ue_gnbid(uint32_t gnbid)
@@ -313,10 +324,26 @@ ngap::ue* ngap::user_list::find_ue_gnbid(uint32_t gnbid)
 
 ngap::ue* ngap::user_list::find_ue_amfid(uint64_t amfid)
 {
-  auto it = std::find_if(users.begin(), users.end(), [amfid](const user_list::pair_type& v) {
-    return v.second->ctxt.amf_ue_ngap_id == amfid;
-  });
-  return it != users.end() ? it->second.get() : nullptr;
+  auto it = amf_id_to_ran_id.find(amfid);
+  return it != amf_id_to_ran_id.end() ? find_ue_gnbid(it->second) : nullptr;
+}
+
+uint32_t ngap::user_list::alloc_ran_ue_ngap_id()
+{
+  // Skip the IDs whose slot in the table is still taken by a UE
+  for (uint32_t i = 0; i < SRSENB_MAX_UES and not users.has_space(next_ran_ue_ngap_id); ++i) {
+    next_ran_ue_ngap_id++;
+  }
+  return next_ran_ue_ngap_id++;
+}
+
+void ngap::user_list::set_amf_ue_ngap_id(ue* ue_ptr, uint64_t amf_id)
+{
+  if (ue_ptr->ctxt.amf_ue_ngap_id.has_value()) {
+    amf_id_to_ran_id.erase(ue_ptr->ctxt.amf_ue_ngap_id.value());
+  }
+  ue_ptr->ctxt.amf_ue_ngap_id = amf_id;
+  amf_id_to_ran_id[amf_id]    = ue_ptr->ctxt.ran_ue_ngap_id;
 }
 
 ngap::ue* ngap::user_list::add_user(std::unique_ptr<ngap::ue> user)
@@ -335,8 +362,20 @@ ngap::ue* ngap::user_list::add_user(std::unique_ptr<ngap::ue> user)
     logger.error("The user to be added with amf id=%d already exists", user->ctxt.amf_ue_ngap_id.value());
     return nullptr;
   }
-  auto p = users.insert(std::make_pair(user->ctxt.ran_ue_ngap_id, std::move(user)));
-  return p.second ? p.first->second.get() : nullptr;
+  if (not users.has_space(user->ctxt.ran_ue_ngap_id)) {
+    logger.error("No space to add the user with ran ue ngap id=%d", user->ctxt.ran_ue_ngap_id);
+    return nullptr;
+  }
+  ue*      u      = user.get();
+  uint32_t ran_id = u->ctxt.ran_ue_ngap_id;
+  users.insert(ran_id, std::move(user));
+  if (u->ctxt.rnti != SRSRAN_INVALID_RNTI) {
+    rnti_to_ran_id[u->ctxt.rnti] = ran_id;
+  }
+  if (u->ctxt.amf_ue_ngap_id.has_value()) {
+    amf_id_to_ran_id[u->ctxt.amf_ue_ngap_id.value()] = ran_id;
+  }
+  return u;
 }
 
 void ngap::user_list::erase(ue* ue_ptr)
@@ -347,6 +386,10 @@ void ngap::user_list::erase(ue* ue_ptr)
     logger.error("User to be erased does not exist");
     return;
   }
+  rnti_to_ran_id.erase(ue_ptr->ctxt.rnti);
+  if (ue_ptr->ctxt.amf_ue_ngap_id.has_value()) {
+    amf_id_to_ran_id.erase(ue_ptr->ctxt.amf_ue_ngap_id.value());
+  }
   users.erase(it);
 }
 
@@ -367,16 +410,23 @@ bool ngap::handle_amf_rx_msg(srsran::unique_byte_buffer_t pdu,
       logger.info("SCTP Association Shutdown. Association: %d", sri.sinfo_assoc_id);
       srsran::console("SCTP Association Shutdown. Association: %d\n", sri.sinfo_assoc_id);
       rx_socket_handler->remove_socket(amf_socket.get_socket());
+      amf_tx.clear_socket();
       amf_socket.close();
     } else if (notification->sn_header.sn_type == SCTP_PEER_ADDR_CHANGE &&
                notification->sn_paddr_change.spc_state == SCTP_ADDR_UNREACHABLE) {
       logger.info("SCTP peer addres unreachable. Association: %d", sri.sinfo_assoc_id);
       srsran::console("SCTP peer address unreachable. Association: %d\n", sri.sinfo_assoc_id);
       rx_socket_handler->remove_socket(amf_socket.get_socket());
+      amf_tx.clear_socket();
       amf_socket.close();
+    } else if (notification->sn_header.sn_type == SCTP_ASSOC_CHANGE &&
+               notification->sn_assoc_change.sac_state == SCTP_COMM_UP) {
+      nof_amf_streams = notification->sn_assoc_change.sac_outbound_streams;
+      logger.info("SCTP association up. Association: %d, outbound streams: %d", sri.sinfo_assoc_id, nof_amf_streams);
     }
   } else if (pdu->N_bytes == 0) {
     logger.error("SCTP return 0 bytes. Closing socket");
+    amf_tx.clear_socket();
     amf_socket.close();
   }
 
@@ -402,11 +452,70 @@ bool ngap::handle_ngap_rx_pdu(srsran::byte_buffer_t* pdu)
     pcap->write_ngap(pdu->msg, pdu->N_bytes);
   }
 
-  // Unpack
-  ngap_pdu_c     rx_pdu;
-  asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
+  // The debug log dumps the whole message, which requires unpacking it
+  if (not logger.debug.enabled() and handle_ngap_rx_pdu_fast(pdu)) {
+    return true;
+  }
+
+  // Unpack. The previous PDU is gone, so its storage can be reused
+  rx_arena.reset();
+  ngap_pdu_c        rx_pdu;
+  asn1::cbit_ref    bref(pdu->msg, pdu->N_bytes);
+  asn1::SRSASN_CODE unpack_code;
+  {
+    asn1::decode_arena_scope arena_scope(rx_arena);
+    unpack_code = rx_pdu.unpack(bref);
+  }
+
+  return handle_ngap_decoded_pdu(pdu, unpack_code == asn1::SRSASN_SUCCESS ? &rx_pdu : nullptr);
+}
+
+/**
+ * Handles an AMF PDU received from the socket. The PDUs that cannot take the fast path are unpacked in the NGAP
+ * worker, so that the stack thread, which also runs the user plane, does not stall during signalling bursts. The
+ * decoded PDU is then handled back in the stack thread. While a PDU is in the worker, the ones received after it
+ * also go through the worker, so that their order is kept
+ * @param pdu received NGAP PDU
+ */
+void ngap::dispatch_amf_rx_pdu(srsran::unique_byte_buffer_t pdu)
+{
+  // Save message to PCAP
+  if (pcap != nullptr) {
+    pcap->write_ngap(pdu->msg, pdu->N_bytes);
+  }
+
+  if (nof_rx_pdus_in_worker == 0 and not logger.debug.enabled() and handle_ngap_rx_pdu_fast(pdu.get())) {
+    return;
+  }
+
+  nof_rx_pdus_in_worker++;
+  rx_worker->push_task([this, pdu = std::move(pdu)]() mutable {
+    // The decoded PDU outlives the arena of the stack thread, so its arrays are taken from the heap
+    std::unique_ptr<ngap_pdu_c> rx_pdu(new ngap_pdu_c);
+    asn1::cbit_ref              bref(pdu->msg, pdu->N_bytes);
+    if (rx_pdu->unpack(bref) != asn1::SRSASN_SUCCESS) {
+      rx_pdu.reset();
+    }
+    amf_task_queue.push([this, pdu = std::move(pdu), rx_pdu = std::move(rx_pdu)]() {
+      nof_rx_pdus_in_worker--;
+      if (not amf_socket.is_open()) {
+        logger.info("Discarding AMF PDU received before the SCTP association was closed");
+        return;
+      }
+      handle_ngap_decoded_pdu(pdu.get(), rx_pdu.get());
+    });
+  });
+}
 
-  if (rx_pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+/**
+ * Handles an unpacked AMF PDU
+ * @param pdu received NGAP PDU
+ * @param rx_pdu unpacked NGAP PDU, or nullptr if the unpacking failed
+ * @return true if the PDU was successfully handled
+ */
+bool ngap::handle_ngap_decoded_pdu(srsran::byte_buffer_t* pdu, const asn1::ngap::ngap_pdu_c* rx_pdu)
+{
+  if (rx_pdu == nullptr) {
     logger.error(pdu->msg, pdu->N_bytes, "Failed to unpack received PDU");
     cause_c cause;
     cause.set_protocol().value = cause_protocol_opts::transfer_syntax_error;
@@ -415,18 +524,18 @@ bool ngap::handle_ngap_rx_pdu(srsran::byte_buffer_t* pdu)
   }
 
   // Logging
-  log_ngap_message(rx_pdu, Rx, srsran::make_span(*pdu));
+  log_ngap_message(*rx_pdu, Rx, srsran::make_span(*pdu));
 
   // Handle the NGAP message
-  switch (rx_pdu.type().value) {
+  switch (rx_pdu->type().value) {
     case ngap_pdu_c::types_opts::init_msg:
-      return handle_initiating_message(rx_pdu.init_msg());
+      return handle_initiating_message(rx_pdu->init_msg());
     case ngap_pdu_c::types_opts::successful_outcome:
-      return handle_successful_outcome(rx_pdu.successful_outcome());
+      return handle_successful_outcome(rx_pdu->successful_outcome());
     case ngap_pdu_c::types_opts::unsuccessful_outcome:
-      return handle_unsuccessful_outcome(rx_pdu.unsuccessful_outcome());
+      return handle_unsuccessful_outcome(rx_pdu->unsuccessful_outcome());
     default:
-      logger.warning("Unhandled PDU type %d", rx_pdu.type().value);
+      logger.warning("Unhandled PDU type %d", rx_pdu->type().value);
       return false;
   }
 
@@ -494,19 +603,37 @@ bool ngap::handle_ng_setup_failure(const asn1::ngap::ng_setup_fail_s& msg)
   return true;
 }
 
+bool ngap::handle_ngap_rx_pdu_fast(srsran::byte_buffer_t* pdu)
+{
+  // Downlink NAS Transports with just the UE NGAP IDs and the NAS-PDU are handled from an index of their IEs, with the
+  // NAS-PDU read in place. The ones with optional IEs are fully unpacked
+  asn1::protocol_ie_index index;
+  if (index.index(pdu->msg, pdu->N_bytes) != asn1::SRSASN_SUCCESS or
+      index.pdu_type() != ngap_pdu_c::types_opts::init_msg or index.proc_code() != ASN1_NGAP_ID_DL_NAS_TRANSPORT or
+      index.ext() or index.nof_ies() != 3) {
+    return false;
+  }
+  amf_ue_ngap_id_t amf_ue_ngap_id;
+  ran_ue_ngap_id_t ran_ue_ngap_id;
+  const uint8_t*   nas_pdu;
+  uint32_t         nas_pdu_len;
+  if (index.unpack_ie(ASN1_NGAP_ID_AMF_UE_NGAP_ID, amf_ue_ngap_id) != asn1::SRSASN_SUCCESS or
+      index.unpack_ie(ASN1_NGAP_ID_RAN_UE_NGAP_ID, ran_ue_ngap_id) != asn1::SRSASN_SUCCESS or
+      index.get_octstring_ie(ASN1_NGAP_ID_NAS_PDU, nas_pdu, nas_pdu_len) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+
+  ngap_elem_procs_o::init_msg_c::types msg_type = ngap_elem_procs_o::init_msg_c::types_opts::dl_nas_transport;
+  logger.info(pdu->msg, pdu->N_bytes, "Rx - %s (%d B)", msg_type.to_string(), pdu->N_bytes);
+  return handle_dl_nas_transport(
+      ran_ue_ngap_id.value, amf_ue_ngap_id.value, srsran::const_span<uint8_t>(nas_pdu, nas_pdu_len));
+}
+
 bool ngap::handle_dl_nas_transport(const asn1::ngap::dl_nas_transport_s& msg)
 {
   if (msg.ext) {
     logger.warning("Not handling NGAP message extension");
   }
-  ue* u = handle_ngapmsg_ue_id(msg->ran_ue_ngap_id.value.value, msg->amf_ue_ngap_id.value.value);
-
-  if (u == nullptr) {
-    logger.warning("Couldn't find user with ran_ue_ngap_id %d and %d",
-                   msg->ran_ue_ngap_id.value.value,
-                   msg->amf_ue_ngap_id.value.value);
-    return false;
-  }
 
   if (msg->old_amf_present) {
     logger.warning("Not handling OldAMF");
@@ -532,13 +659,33 @@ bool ngap::handle_dl_nas_transport(const asn1::ngap::dl_nas_transport_s& msg)
     logger.warning("Not handling AllowedNSSAI");
   }
 
+  return handle_dl_nas_transport(msg->ran_ue_ngap_id.value.value,
+                                 msg->amf_ue_ngap_id.value.value,
+                                 srsran::const_span<uint8_t>(msg->nas_pdu.value.data(), msg->nas_pdu.value.size()));
+}
+
+bool ngap::handle_dl_nas_transport(uint32_t                    ran_ue_ngap_id,
+                                   uint64_t                    amf_ue_ngap_id,
+                                   srsran::const_span<uint8_t> nas_pdu)
+{
+  ue* u = handle_ngapmsg_ue_id(ran_ue_ngap_id, amf_ue_ngap_id);
+
+  if (u == nullptr) {
+    logger.warning("Couldn't find user with ran_ue_ngap_id %d and %d", ran_ue_ngap_id, amf_ue_ngap_id);
+    return false;
+  }
+
   srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
   if (pdu == nullptr) {
     logger.error("Fatal Error: Couldn't allocate buffer in ngap::run_thread().");
     return false;
   }
-  memcpy(pdu->msg, msg->nas_pdu.value.data(), msg->nas_pdu.value.size());
-  pdu->N_bytes = msg->nas_pdu.value.size();
+  if (nas_pdu.size() > pdu->get_tailroom()) {
+    logger.error("Couldn't store the downlink NAS PDU of %zd bytes", nas_pdu.size());
+    return false;
+  }
+  memcpy(pdu->msg, nas_pdu.data(), nas_pdu.size());
+  pdu->N_bytes = nas_pdu.size();
   rrc->write_dl_info(u->ctxt.rnti, std::move(pdu));
   return true;
 }
@@ -664,6 +811,11 @@ bool ngap::connect_amf()
     return false;
   }
 
+  // Request one stream per group of UEs, besides the non UE-associated one
+  if (not amf_socket.sctp_set_nof_streams(args.sctp_nof_streams)) {
+    return false;
+  }
+
   // Bind socket
   if (not amf_socket.bind_addr(args.ngc_bind_addr.c_str(), 0)) {
     amf_socket.close();
@@ -675,11 +827,16 @@ bool ngap::connect_amf()
     return false;
   }
   logger.info("SCTP socket connected with AMF. fd=%d", amf_socket.fd());
+  amf_tx.set_socket(amf_socket.fd(), amf_addr, PPID);
 
   // Assign a handler to rx AMF packets
   auto rx_callback =
       [this](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from, const sctp_sndrcvinfo& sri, int flags) {
         // Defer the handling of AMF packet to eNB stack main thread
+        if ((flags & MSG_NOTIFICATION) == 0 and pdu->N_bytes > 0 and rx_worker != nullptr) {
+          dispatch_amf_rx_pdu(std::move(pdu));
+          return;
+        }
         handle_amf_rx_msg(std::move(pdu), from, sri, flags);
       };
   rx_socket_handler->add_socket_handler(amf_socket.fd(),
@@ -762,17 +919,7 @@ bool ngap::sctp_send_ngap_pdu(const asn1::ngap::ngap_pdu_c& tx_pdu, uint32_t rnt
 
   uint16_t streamid = rnti == SRSRAN_INVALID_RNTI ? NONUE_STREAM_ID : users.find_ue_rnti(rnti)->stream_id;
 
-  ssize_t n_sent = sctp_sendmsg(amf_socket.fd(),
-                                buf->msg,
-                                buf->N_bytes,
-                                (struct sockaddr*)&amf_addr,
-                                sizeof(struct sockaddr_in),
-                                htonl(PPID),
-                                0,
-                                streamid,
-                                0,
-                                0);
-  if (n_sent == -1) {
+  if (not amf_socket.is_open()) {
     if (rnti != SRSRAN_INVALID_RNTI) {
       logger.error("Error: Failure at Tx NGAP SDU, %s, rnti=0x%x", procedure_name, rnti);
     } else {
@@ -780,6 +927,12 @@ bool ngap::sctp_send_ngap_pdu(const asn1::ngap::ngap_pdu_c& tx_pdu, uint32_t rnt
     }
     return false;
   }
+
+  // The PDUs sent during a stack task are handed to the SCTP Tx thread as one batch once the task completes
+  if (amf_tx.empty()) {
+    task_sched.defer_task([this]() { amf_tx.flush(); });
+  }
+  amf_tx.push(std::move(buf), streamid);
   return true;
 }
 
@@ -802,7 +955,7 @@ ngap::ue* ngap::handle_ngapmsg_ue_id(uint32_t gnb_id, uint64_t amf_id)
 
     user_amf_ptr = users.find_ue_amfid(amf_id);
     if (not user_ptr->ctxt.amf_ue_ngap_id.has_value() and user_amf_ptr == nullptr) {
-      user_ptr->ctxt.amf_ue_ngap_id = amf_id;
+      users.set_amf_ue_ngap_id(user_ptr, amf_id);
       return user_ptr;
     }
 
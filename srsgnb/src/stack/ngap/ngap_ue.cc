@@ -43,9 +43,9 @@ ngap::ue::ue(ngap*                  ngap_ptr_,
   ue_context_release_proc(this, rrc_ptr_, &ctxt, &bearer_manager, logger_),
   ue_pdu_session_res_setup_proc(this, rrc_ptr_, &ctxt, &bearer_manager, logger_)
 {
-  ctxt.ran_ue_ngap_id = ngap_ptr->next_gnb_ue_ngap_id++;
+  ctxt.ran_ue_ngap_id = ngap_ptr->users.alloc_ran_ue_ngap_id();
   gettimeofday(&ctxt.init_timestamp, nullptr);
-  stream_id = ngap_ptr->next_ue_stream_id;
+  stream_id = srsran::net_utils::sctp_ue_stream_id(ctxt.ran_ue_ngap_id, ngap_ptr->nof_amf_streams);
 }
 
 ngap::ue::~ue() {}
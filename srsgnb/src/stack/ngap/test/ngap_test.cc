@@ -26,7 +26,8 @@
 using namespace srsenb;
 
 struct amf_dummy {
-  amf_dummy(const char* addr_str_, int port_) : addr_str(addr_str_), port(port_)
+  amf_dummy(const char* addr_str_, int port_, srsran::task_scheduler* task_sched_) :
+    addr_str(addr_str_), port(port_), task_sched(task_sched_)
   {
     srsran::net_utils::set_sockaddr(&amf_sockaddr, addr_str, port);
     {
@@ -49,6 +50,9 @@ struct amf_dummy {
 
   srsran::unique_byte_buffer_t read_msg(sockaddr_in* sockfrom = nullptr)
   {
+    // The NGAP PDUs are handed to the SCTP Tx thread by a deferred stack task
+    task_sched->run_pending_tasks();
+
     srsran::unique_byte_buffer_t pdu     = srsran::make_byte_buffer();
     sockaddr_in                  from    = {};
     socklen_t                    fromlen = sizeof(from);
@@ -66,6 +70,7 @@ struct amf_dummy {
 
   const char*                  addr_str;
   int                          port;
+  srsran::task_scheduler*      task_sched;
   struct sockaddr_in           amf_sockaddr = {};
   int                          fd;
   srsran::unique_byte_buffer_t last_sdu;
@@ -298,7 +303,7 @@ int main(int argc, char** argv)
 
   const char*    amf_addr_str = "127.0.0.1";
   const uint32_t AMF_PORT     = 38412;
-  amf_dummy      amf(amf_addr_str, AMF_PORT);
+  amf_dummy      amf(amf_addr_str, AMF_PORT, &task_sched);
 
   ngap_args_t args   = {};
   args.cell_id       = 0x01;
@@ -90,6 +90,10 @@ int rrc_nr::init(const rrc_nr_cfg_t&         cfg_,
   int                               ret               = fill_master_cell_cfg_from_enb_cfg(cfg, 0, *master_cell_group);
   srsran_assert(ret == SRSRAN_SUCCESS, "Failed to configure MasterCellGroup");
   cell_ctxt->master_cell_group = std::move(master_cell_group);
+  if (cfg.is_standalone and generate_setup_cell_group() != SRSRAN_SUCCESS) {
+    logger.error("Couldn't generate the RRCSetup MasterCellGroup.");
+    return SRSRAN_ERROR;
+  }
 
   // derived
   slot_dur_ms = 1;
@@ -300,7 +304,12 @@ void rrc_nr::config_phy()
                             cfg.cell_list[0].duplex_mode,
                             &common_cfg.prach);
   common_cfg.duplex_mode = cfg.cell_list[0].duplex_mode;
-  ret                    = srsran::fill_phy_ssb_cfg(
+  common_cfg.duplex.mode = SRSRAN_DUPLEX_MODE_FDD;
+  if (du_cfg->cell(0).serv_cell_cfg_common().tdd_ul_dl_cfg_common_present) {
+    ret = srsran::make_phy_tdd_cfg(du_cfg->cell(0).serv_cell_cfg_common().tdd_ul_dl_cfg_common, &common_cfg.duplex);
+    srsran_assert(ret, "Failed to generate TDD PHY config");
+  }
+  ret = srsran::fill_phy_ssb_cfg(
       cfg.cell_list[0].phy_cell.carrier, du_cfg->cell(0).serv_cell_cfg_common(), &common_cfg.ssb);
   srsran_assert(ret, "Failed to generate PHY config");
   if (phy->set_common_cfg(common_cfg) < SRSRAN_SUCCESS) {
@@ -434,6 +443,29 @@ int32_t rrc_nr::generate_sibs()
   return SRSRAN_SUCCESS;
 }
 
+/// The MasterCellGroup of the RRCSetup only depends on the cell config and SRB1, so it is the same for every UE and
+/// can be filled and packed once, instead of for each RRCSetupRequest
+int rrc_nr::generate_setup_cell_group()
+{
+  radio_bearer_cfg_s srb1_bearers;
+  srb1_bearers.srb_to_add_mod_list.resize(1);
+  srb1_bearers.srb_to_add_mod_list[0].srb_id = 1;
+
+  std::unique_ptr<cell_group_cfg_s> setup_cell_group =
+      std::make_unique<cell_group_cfg_s>(*cell_ctxt->master_cell_group);
+  if (fill_cellgroup_with_radio_bearer_cfg(cfg, SRSRAN_INVALID_RNTI, *bearer_mapper, srb1_bearers, *setup_cell_group) !=
+      SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  srsran::unique_byte_buffer_t pdu = pack_into_pdu(*setup_cell_group, __FUNCTION__);
+  if (pdu == nullptr) {
+    return SRSRAN_ERROR;
+  }
+  cell_ctxt->setup_cell_group        = std::move(setup_cell_group);
+  cell_ctxt->setup_cell_group_buffer = std::move(pdu);
+  return SRSRAN_SUCCESS;
+}
+
 /*******************************************************************************
   MAC interface
 *******************************************************************************/
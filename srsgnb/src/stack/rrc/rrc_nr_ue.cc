@@ -1010,23 +1010,36 @@ void rrc_nr::ue::send_rrc_setup()
   compute_diff_radio_bearer_cfg(parent->cfg, radio_bearer_cfg, next_radio_bearer_cfg, setup_ies.radio_bearer_cfg);
 
   // - Setup masterCellGroup
-  // - Derive master cell group config bearers
-  if (fill_cellgroup_with_radio_bearer_cfg(
-          parent->cfg, rnti, *parent->bearer_mapper, setup_ies.radio_bearer_cfg, next_cell_group_cfg) !=
-      SRSRAN_SUCCESS) {
-    logger.error("Couldn't fill cellGroupCfg during RRC Setup");
-    send_rrc_reject(max_wait_time_secs);
-    return;
-  }
+  const cell_ctxt_t&        cell      = *parent->cell_ctxt;
+  const radio_bearer_cfg_s& setup_rbs = setup_ies.radio_bearer_cfg;
+  bool                      only_srb1 = setup_rbs.srb_to_add_mod_list.size() == 1 and
+                     setup_rbs.drb_to_add_mod_list.size() == 0 and setup_rbs.drb_to_release_list.size() == 0;
+  if (only_srb1 and cell.setup_cell_group != nullptr) {
+    // - Use the masterCellGroup pre-encoded at start, as it is common to all UEs
+    next_cell_group_cfg = *cell.setup_cell_group;
+    setup_ies.master_cell_group.resize(cell.setup_cell_group_buffer->N_bytes);
+    memcpy(setup_ies.master_cell_group.data(),
+           cell.setup_cell_group_buffer->data(),
+           cell.setup_cell_group_buffer->N_bytes);
+  } else {
+    // - Derive master cell group config bearers
+    if (fill_cellgroup_with_radio_bearer_cfg(
+            parent->cfg, rnti, *parent->bearer_mapper, setup_ies.radio_bearer_cfg, next_cell_group_cfg) !=
+        SRSRAN_SUCCESS) {
+      logger.error("Couldn't fill cellGroupCfg during RRC Setup");
+      send_rrc_reject(max_wait_time_secs);
+      return;
+    }
 
-  // - Pack masterCellGroup into container
-  srsran::unique_byte_buffer_t pdu = parent->pack_into_pdu(next_cell_group_cfg, __FUNCTION__);
-  if (pdu == nullptr) {
-    send_rrc_reject(max_wait_time_secs);
-    return;
+    // - Pack masterCellGroup into container
+    srsran::unique_byte_buffer_t pdu = parent->pack_into_pdu(next_cell_group_cfg, __FUNCTION__);
+    if (pdu == nullptr) {
+      send_rrc_reject(max_wait_time_secs);
+      return;
+    }
+    setup_ies.master_cell_group.resize(pdu->N_bytes);
+    memcpy(setup_ies.master_cell_group.data(), pdu->data(), pdu->N_bytes);
   }
-  setup_ies.master_cell_group.resize(pdu->N_bytes);
-  memcpy(setup_ies.master_cell_group.data(), pdu->data(), pdu->N_bytes);
   if (logger.debug.enabled()) {
     asn1::json_writer js;
     next_cell_group_cfg.to_json(js);
@@ -78,6 +78,21 @@ void test_rrc_nr_connection_establishment(srsran::task_scheduler& task_sched,
 
   const srb_to_add_mod_s& srb1 = setup_ies.radio_bearer_cfg.srb_to_add_mod_list[0];
   TESTASSERT_EQ(srsran::srb_to_lcid(srsran::nr_srb::srb1), srb1.srb_id);
+  // Test if the (pre-encoded) masterCellGroup carries the SRB1 RLC bearer and is a canonical encoding
+  cell_group_cfg_s master_cell_group;
+  {
+    asn1::cbit_ref bref{setup_ies.master_cell_group.data(), setup_ies.master_cell_group.size()};
+    TESTASSERT_SUCCESS(master_cell_group.unpack(bref));
+  }
+  TESTASSERT_EQ(1, master_cell_group.rlc_bearer_to_add_mod_list.size());
+  TESTASSERT_EQ(srb1.srb_id, master_cell_group.rlc_bearer_to_add_mod_list[0].served_radio_bearer.srb_id());
+  {
+    uint8_t       buffer[1024];
+    asn1::bit_ref bref{buffer, sizeof(buffer)};
+    TESTASSERT_SUCCESS(master_cell_group.pack(bref));
+    TESTASSERT_EQ(setup_ies.master_cell_group.size(), (uint32_t)bref.distance_bytes());
+    TESTASSERT(memcmp(buffer, setup_ies.master_cell_group.data(), setup_ies.master_cell_group.size()) == 0);
+  }
   // Test UE context in MAC
   TESTASSERT_EQ(rnti, mac.last_ue_cfg_rnti);
   // Only LCID=1 is added
@@ -57,4 +57,10 @@ void sdap::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t
   m_pdcp->write_sdu(rnti, lcid, std::move(pdu));
 }
 
+void sdap::write_sdus(uint16_t rnti, uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus)
+{
+  // The burst is handed to PDCP in a single call
+  m_pdcp->write_sdus(rnti, lcid, sdus);
+}
+
 } // namespace srsenb
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSUE_CELL_CACHE_H
+#define SRSUE_CELL_CACHE_H
+
+#include "srsran/srslog/srslog.h"
+#include <string>
+#include <vector>
+
+namespace srsue {
+
+/**
+ * Cells the UE camped on, most recent first. The list is kept in memory and, if a file name is given, it is stored every
+ * time a new cell is added so the cell search after a restart can probe the known cells before scanning.
+ *
+ * It is not thread safe, the SYNC calls it from the RRC procedures only.
+ */
+class cell_cache
+{
+public:
+  struct entry_t {
+    uint32_t earfcn = 0;
+    uint32_t pci    = 0;
+  };
+
+  explicit cell_cache(srslog::basic_logger& logger_) : logger(logger_) {}
+
+  /**
+   * Loads the cells stored in the given file. An empty file name keeps the cache in memory only
+   * @param filename_ File the cells are read from and stored to
+   */
+  void init(const std::string& filename_);
+
+  /**
+   * Adds a cell as the most recent one, replacing any previous cell in the same EARFCN, and stores the list
+   */
+  void add(uint32_t earfcn, uint32_t pci);
+
+  /**
+   * @return the cell known in the given EARFCN, or nullptr if there is none
+   */
+  const entry_t* find(uint32_t earfcn) const;
+
+  /**
+   * @return the cell the UE camped on last, or nullptr if the cache is empty
+   */
+  const entry_t* last() const { return entries.empty() ? nullptr : &entries.front(); }
+
+private:
+  static const uint32_t max_entries = 16;
+
+  srslog::basic_logger& logger;
+  std::string           filename;
+  std::vector<entry_t>  entries;
+
+  void save() const;
+};
+
+} // namespace srsue
+
+#endif // SRSUE_CELL_CACHE_H
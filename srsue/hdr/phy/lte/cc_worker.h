@@ -51,6 +51,7 @@ public:
   void set_tdd_config_nolock(srsran_tdd_config_t config);
   void set_config_nolock(const srsran::phy_cfg_t& phy_cfg);
   void upd_config_dci_nolock(const srsran_dci_cfg_t& dci_cfg);
+  bool is_cif_present_nolock() const { return ue_dl_cfg.cfg.dci.cif_present; }
 
   void set_uci_periodic_cqi(srsran_uci_data_t* uci_data);
 
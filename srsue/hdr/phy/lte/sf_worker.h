@@ -34,7 +34,8 @@ namespace lte {
 /**
  * The sf_worker class handles the PHY processing, UL and DL procedures associated with 1 subframe.
  * It contains multiple cc_worker objects, one for each component carrier which may be executed in
- * one or multiple threads.
+ * one or multiple threads. When a carrier pool is provided, the secondary carriers DL is processed in the pool while
+ * the worker thread processes the primary carrier.
  *
  * A sf_worker object is executed by a thread within the thread_pool.
  */
@@ -42,7 +43,10 @@ namespace lte {
 class sf_worker : public srsran::thread_pool::worker
 {
 public:
-  sf_worker(uint32_t max_prb, phy_common* phy_, srslog::basic_logger& logger);
+  sf_worker(uint32_t                  max_prb,
+            phy_common*               phy_,
+            srslog::basic_logger&     logger,
+            srsran::task_thread_pool* cc_pool_ = nullptr);
   virtual ~sf_worker();
 
   void reset_cell_nolock(uint32_t cc_idx);
@@ -78,11 +82,17 @@ private:
   /* Inherited from thread_pool::worker. Function called every subframe to run the DL/UL processing */
   void work_imp() final;
 
+  bool work_dl(uint32_t tti);
   void update_measurements();
   void reset_uci(srsran_uci_data_t* uci_data);
 
   std::vector<cc_worker*> cc_workers;
 
+  srsran::task_thread_pool* cc_pool = nullptr; ///< Processes the SCells DL, shared by all the workers
+  std::mutex                cc_mutex;
+  std::condition_variable   cc_cvar;
+  uint32_t                  cc_pending = 0; ///< Number of SCells being processed in the carrier pool
+
   phy_common* phy = nullptr;
 
   srslog::basic_logger& logger;
@@ -44,6 +44,12 @@ public:
   bool work_dl();
   bool work_ul();
 
+  /**
+   * @brief Tells whether the last work_ul() left a signal to transmit in the Tx buffer, it is false in slots without UL
+   * symbols so the Tx chain does not combine nor send them
+   */
+  bool is_tx_enabled() const { return tx_enabled; }
+
   int read_pdsch_d(cf_t* pdsch_d);
 
 private:
@@ -58,6 +64,7 @@ private:
   std::array<cf_t*, SRSRAN_MAX_PORTS> rx_buffer   = {};
   std::array<cf_t*, SRSRAN_MAX_PORTS> tx_buffer   = {};
   uint32_t                            buffer_sz   = 0;
+  bool                                tx_enabled  = false;
   state&                              phy;
   srsran::phy_cfg_nr_t                cfg;
   srsran_ssb_t                        ssb   = {};
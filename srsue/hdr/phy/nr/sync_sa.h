@@ -24,6 +24,7 @@
 
 #include "cell_search.h"
 #include "slot_sync.h"
+#include "srsran/adt/circular_buffer.h"
 #include "srsran/common/threads.h"
 #include "srsran/interfaces/radio_interfaces.h"
 #include "srsran/interfaces/ue_nr_interfaces.h"
@@ -54,6 +55,7 @@ public:
     float                       pbch_dmrs_thr   = 0.0f; ///< PBCH DMRS correlation detection threshold (0 means auto)
     float                       cfo_alpha       = 0.0f; ///< CFO averaging alpha (0 means auto)
     int                         thread_priority = 1;
+    uint32_t                    rx_queue_size   = 0; ///< Slots buffered between reception and workers, 0 disables it
 
     cell_search::args_t get_cell_search() const
     {
@@ -123,12 +125,42 @@ private:
   // Time Aligment Controller, internal thread safe
   ta_control ta;
 
+  /**
+   * Slot received and tracked while camping, waiting in the Rx queue for a worker. The slots are allocated at init
+   */
+  struct rx_slot_t {
+    cf_t*                  buffer = nullptr; ///< Baseband samples of the slot
+    uint32_t               tti    = 0;
+    srsran::rf_timestamp_t tx_time;          ///< Transmission time with the current TA applied
+  };
+
+  /**
+   * Takes the queued slots in order and hands them to the workers, so the reception never waits for a free worker
+   */
+  class dispatch_worker : public srsran::thread
+  {
+  public:
+    explicit dispatch_worker(sync_sa& parent_) : srsran::thread("SYNC_DISPATCH"), parent(parent_) {}
+
+  private:
+    sync_sa& parent;
+
+    void run_thread() override { parent.run_dispatch(); }
+  };
+  std::vector<rx_slot_t>                 rx_slots;           ///< Empty if the Rx queue is disabled
+  srsran::dyn_blocking_queue<rx_slot_t*> rx_free_slots{1};   ///< Slots available for reception
+  srsran::dyn_blocking_queue<rx_slot_t*> rx_pending{1};      ///< Received slots in order, for the dispatch thread
+  std::atomic<uint32_t>                  rx_nof_inflight{0}; ///< Slots queued and not yet handed to a worker
+  std::unique_ptr<dispatch_worker>       dispatch_thread;    ///< Null if the Rx queue is disabled
+
   // FSM States
   bool wait_idle();
   void run_state_idle();
   void run_state_cell_search();
   void run_state_sfn_sync();
   void run_state_cell_camping();
+  void run_state_cell_camping_queued();
+  void run_dispatch();
 
   int  radio_recv_fnc(srsran::rf_buffer_t& data, srsran_timestamp_t* rx_time);
   void run_stack_tti();
@@ -224,6 +224,7 @@ public:
   srsran::radio_interface_phy* get_radio();
 
   void set_dl_metrics(uint32_t cc_idx, const dl_metrics_t& m);
+  void set_dl_skipped_tb(uint32_t cc_idx, uint32_t nof_tb);
   void get_dl_metrics(dl_metrics_t::array_t& m);
 
   void set_ch_metrics(uint32_t cc_idx, const ch_metrics_t& m);
@@ -120,9 +120,10 @@ private:
 struct dl_metrics_t {
   typedef std::array<dl_metrics_t, SRSRAN_MAX_CARRIERS> array_t;
 
-  float fec_iters = 0.0;
-  float mcs       = 0.0;
-  float evm       = 0.0;
+  float    fec_iters      = 0.0;
+  float    mcs            = 0.0;
+  float    evm            = 0.0;
+  uint32_t nof_skipped_tb = 0; ///< Retransmitted TBs not decoded because they were already decoded
 
   void set(const dl_metrics_t& other)
   {
@@ -132,12 +133,15 @@ struct dl_metrics_t {
     PHY_METRICS_SET(evm);
   }
 
+  void add_skipped_tb(uint32_t nof_tb) { nof_skipped_tb += nof_tb; }
+
   void reset()
   {
-    count     = 0;
-    fec_iters = 0.0f;
-    mcs       = 0.0f;
-    evm       = 0.0f;
+    count          = 0;
+    fec_iters      = 0.0f;
+    mcs            = 0.0f;
+    evm            = 0.0f;
+    nof_skipped_tb = 0;
   }
 
 private:
@@ -22,6 +22,8 @@
 #define SRSUE_INTRA_MEASURE_BASE_H
 
 #include "srsran/interfaces/ue_phy_interfaces.h"
+#include "srsran/phy/resampling/resampler.h"
+#include <array>
 #include <condition_variable>
 #include <mutex>
 #include <srsran/common/common.h>
@@ -43,8 +45,8 @@ class intra_measure_base : public srsran::thread
    *          except quit can transition to idle.
    *  - wait: waits for the TTI trigger to transition to receive
    *  - receive: captures base-band samples for intra_freq_meas_len_ms and goes to measure.
-   *  - measure: enables the inner thread to start the measuring function. The asynchronous buffer will transition to
-   *             wait as soon as it has read the data from the buffer.
+   *  - measure: enables the inner thread to start the measuring function. The asynchronous thread will transition to
+   *             wait as soon as it has taken the received buffer, the next samples are received in the other buffer.
    *  - quit: stops the inner thread and quits. Transition from any state measure state.
    *
    * FSM abstraction:
@@ -141,11 +143,24 @@ protected:
     uint32_t           meas_period_ms     = 200; ///< Minimum time between measurements
     uint32_t           trigger_tti_period = 0;   ///< Measurement TTI trigger period
     uint32_t           trigger_tti_offset = 0;   ///< Measurement TTI trigger offset
+    uint32_t           search_decimation  = 1;   ///< Cell search buffer decimation ratio, 1 disables it
     meas_itf&          new_cell_itf;
 
     explicit measure_context_t(meas_itf& new_cell_itf_) : new_cell_itf(new_cell_itf_) {}
   };
 
+  /**
+   * @brief Describes a measurement buffer. The samples are written linearly from the beginning of the buffer, so the
+   * asynchronous thread measures them in place
+   */
+  struct meas_buffer_t {
+    std::vector<cf_t> samples;               ///< Full rate baseband samples
+    std::vector<cf_t> search;                ///< Baseband samples filtered and decimated on reception for the search
+    uint32_t          nof_samples       = 0; ///< Number of received full rate samples
+    uint32_t          nof_search        = 0; ///< Number of decimated samples
+    uint32_t          search_decimation = 1; ///< Decimation ratio of the search samples, 1 if they are not available
+  };
+
   std::atomic<float> rx_gain_offset_db = {0.0f}; ///< Current gain offset
 
   /**
@@ -175,6 +190,18 @@ protected:
     context.sf_len = new_sf_len;
   }
 
+  /**
+   * @brief Cell search decimation setter. When the ratio is greater than 1, the received samples are also filtered and
+   * decimated as they are written, so the inherited class can search cells at the reduced rate
+   * @note The ratio is applied from the next measurement window
+   * @param ratio New decimation ratio, it shall divide the subframe length
+   */
+  void set_search_decimation(uint32_t ratio)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    context.search_decimation = SRSRAN_MAX(ratio, 1);
+  }
+
 private:
   /**
    * @brief Describes the internal state class, provides thread safe state management
@@ -187,7 +214,7 @@ private:
       idle,        ///< Internal thread runs, it does not capture data
       wait_first,  ///< Wait for the TTI trigger (if configured)
       wait,        ///< Wait for the period time to pass
-      receive,     ///< Accumulate samples in ring buffer
+      receive,     ///< Accumulate samples in the measurement buffer
       measure,     ///< Module is busy measuring
       quit         ///< Quit thread, no transitions are allowed
     } state_t;
@@ -259,7 +286,12 @@ private:
   }
 
   /**
-   * @brief Writes baseband data in the internal soft-buffer
+   * @brief Selects the buffer for the next measurement window, it is never the buffer being measured
+   */
+  void start_receive();
+
+  /**
+   * @brief Writes baseband data in the current measurement buffer
    * @param data Provides baseband data
    * @param nsamples Number of samples to write
    */
@@ -274,13 +306,13 @@ private:
   /**
    * @brief Pure virtual function to perform measurements
    * @note The context is pass-by-value to protect it from concurrency. However, the buffer is pass-by-reference
-   * as it is protected by the state.
+   * as it is not written until the measurement finishes.
    * @param context Provides current measurement context
-   * @param buffer Provides current measurement context
+   * @param buffer Provides the received measurement buffer
    * @param rx_gain_offset Provides last received rx_gain_offset
    * @return True if the measurement functions are executed without errors, otherwise false
    */
-  virtual bool measure_rat(const measure_context_t& context, std::vector<cf_t>& buffer, float rx_gain_offset) = 0;
+  virtual bool measure_rat(const measure_context_t& context, meas_buffer_t& buffer, float rx_gain_offset) = 0;
 
   /**
    * @brief Measurement process helper method. Encapsulates the neighbour cell measurement functionality
@@ -309,8 +341,12 @@ private:
   uint32_t              last_measure_tti = 0;
   measure_context_t     context;
 
-  std::vector<cf_t>   search_buffer;
-  srsran_ringbuffer_t ring_buffer = {};
+  std::array<meas_buffer_t, 2> buffers   = {};
+  uint32_t                     write_idx = 0;  ///< Buffer being received, only accessed by the writer
+  int                          ready_idx = -1; ///< Received buffer waiting for the measurement, -1 if none
+  int                          busy_idx  = -1; ///< Buffer being measured, -1 if none
+  std::mutex                   buffer_mutex;   ///< Protects ready_idx and busy_idx
+  srsran_resampler_fft_t       decimator = {}; ///< Cell search decimator, only accessed by the writer
 };
 
 } // namespace scell
@@ -79,7 +79,7 @@ private:
    * @param rx_gain_offset Provides last received rx_gain_offset
    * @return True if no error happens, otherwise false
    */
-  bool measure_rat(const measure_context_t& context, std::vector<cf_t>& buffer, float rx_gain_offset) override;
+  bool measure_rat(const measure_context_t& context, meas_buffer_t& buffer, float rx_gain_offset) override;
 
   srslog::basic_logger& logger;
   srsran_cell_t         serving_cell   = {};  ///< Current serving cell in the EARFCN, to avoid reporting it
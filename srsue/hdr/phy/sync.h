@@ -27,6 +27,7 @@
 #include <mutex>
 #include <pthread.h>
 
+#include "cell_cache.h"
 #include "phy_common.h"
 #include "prach.h"
 #include "scell/intra_measure_lte.h"
@@ -57,6 +58,7 @@ public:
   sync(srslog::basic_logger& phy_logger, srslog::basic_logger& phy_lib_logger) :
     thread("SYNC"),
     search_p(phy_logger),
+    known_cells(phy_logger),
     sfn_p(phy_logger),
     phy_logger(phy_logger),
     phy_lib_logger(phy_lib_logger),
@@ -213,6 +215,7 @@ private:
 
   // Objects for internal use
   search                                                  search_p;
+  cell_cache                                              known_cells; ///< Cells probed first by the cell search
   sfn_sync                                                sfn_p;
   std::vector<std::unique_ptr<scell::intra_measure_lte> > intra_freq_meas;
   std::mutex                                              intra_freq_cfg_mutex;
@@ -366,6 +369,7 @@ private:
   float    ul_dl_factor            = NAN;
   int      current_earfcn          = 0;
   uint32_t cellsearch_earfcn_index = 0;
+  bool     known_cell_probed       = false; ///< The last camped cell was searched in the current EARFCN set round
 
   float dl_freq = -1;
   float ul_freq = -1;
@@ -28,6 +28,7 @@
 #include "srsran/mac/pdu.h"
 #include "srsran/mac/pdu_queue.h"
 #include "srsran/srslog/srslog.h"
+#include <atomic>
 
 /* Logical Channel Demultiplexing and MAC CE dissassemble */
 
@@ -68,6 +69,10 @@ public:
   void process_pdu(uint8_t* pdu, uint32_t nof_bytes, srsran::pdu_queue::channel_t channel, int ul_nof_prbs);
   void mch_start_rx(uint32_t lcid);
 
+  /// When enabled, push_pdu() passes the SDUs of the DRBs to RLC right away. Only the PDUs carrying SDUs of the SRBs
+  /// are queued for the stack thread.
+  void set_data_fast_path(bool enable) { data_fast_path = enable; }
+
 private:
   const static int MAX_PDU_LEN      = 150 * 1024 / 8; // ~ 150 Mbps
   const static int MAX_BCCH_PDU_LEN = 1024;
@@ -83,13 +88,15 @@ private:
   srsran::mch_pdu mch_mac_msg;
   srsran::sch_pdu pending_mac_msg;
   uint8_t         mch_lcids[SRSRAN_N_MCH_LCIDS] = {};
-  void            process_sch_pdu_rt(uint8_t* buff, uint32_t nof_bytes, uint32_t tti);
+  bool            process_sch_pdu_rt(uint8_t* buff, uint32_t nof_bytes, uint32_t tti);
   void            process_sch_pdu(srsran::sch_pdu* pdu);
+  void            route_sdu(srsran::sch_subh* subh, bool from_phy_worker);
   void            process_mch_pdu(srsran::mch_pdu* pdu);
   bool            process_ce(srsran::sch_subh* subheader, uint32_t tti);
   void            parse_ta_cmd(srsran::sch_subh* subh, uint32_t tti);
 
-  bool is_uecrid_successful = false;
+  bool              is_uecrid_successful = false;
+  std::atomic<bool> data_fast_path{false};
 
   srsran::timer_handler::unique_timer* time_alignment_timer = nullptr;
 
@@ -100,6 +100,9 @@ public:
 
   void start_pcap(srsran::mac_pcap* pcap);
 
+  /// When enabled, the DL SDUs of the DRBs are passed to RLC by the PHY worker that decoded them.
+  void set_dl_data_fast_path(bool enable) { demux_unit.set_data_fast_path(enable); }
+
   // Timer callback interface
   void timer_expired(uint32_t timer_id);
 
@@ -63,6 +63,11 @@ public:
 
   void print_logical_channel_state(const std::string& info)
   {
+    srslog::basic_logger& logger = srslog::fetch_basic_logger("MAC");
+    if (not logger.debug.enabled()) {
+      // called for every MAC PDU, do not build the log line for nothing
+      return;
+    }
     std::string logline = info;
 
     for (auto& channel : logical_channels) {
@@ -84,7 +89,7 @@ public:
       logline += ", sched_len=";
       logline += std::to_string(channel.sched_len);
     }
-    srslog::fetch_basic_logger("MAC").debug("%s", logline.c_str());
+    logger.debug("%s", logline.c_str());
   }
 
 protected:
@@ -50,6 +50,7 @@ public:
   void ho_reest_actions(const uint32_t src_earfcn, const uint32_t dst_earfcn);
   void run_tti();
   void update_phy();
+  void cell_meas_updated(srsran::srsran_rat_t rat);
   float rsrp_filter(const float new_value, const float avg_value);
   float rsrq_filter(const float new_value, const float avg_value);
 
@@ -120,6 +121,7 @@ private:
     std::list<meas_obj_to_add_mod_s> get_active_objects();
     void                             ho_reest_finish(const uint32_t src_earfcn, const uint32_t dst_earfcn);
     bool parse_meas_config(const meas_cfg_s* meas_config, bool is_ho_reest, uint32_t src_earfcn);
+    void cell_meas_updated(srsran::srsran_rat_t rat);
     void eval_triggers();
     void report_triggers();
 
@@ -163,17 +165,35 @@ private:
     void report_triggers_interrat_check_leaving(int32_t meas_id, report_cfg_inter_rat_s& report_cfg);
     void report_triggers_interrat_removing_trigger(int32_t meas_id);
 
+    // Entering and leaving conditions of a cell for a measId. The timeToTrigger of each condition runs in the timer
+    // wheel, so that the state only needs to be updated when the condition changes.
     class cell_trigger_state
     {
     public:
-      void event_condition(const bool enter, const bool exit);
-      bool is_enter_equal(const uint32_t nof_tti);
-      bool is_exit_equal(const uint32_t nof_tti);
+      cell_trigger_state(uint32_t pci_, srsran::unique_timer enter_timer_, srsran::unique_timer exit_timer_) :
+        pci(pci_), enter_timer(std::move(enter_timer_)), exit_timer(std::move(exit_timer_))
+      {}
+      uint32_t get_pci() const { return pci; }
+      void     event_condition(const bool enter, const bool exit, const uint32_t time_to_trigger);
+      bool     is_enter_equal(const uint32_t time_to_trigger) const;
+      bool     is_exit_equal(const uint32_t time_to_trigger) const;
+
+      bool evaluated = false; // condition evaluated in the last pass of eval_triggers()
 
     private:
-      uint32_t nof_tti_enter = 0;
-      uint32_t nof_tti_exit  = 0;
+      uint32_t             pci;
+      bool                 enter_cond = false;
+      bool                 exit_cond  = false;
+      srsran::unique_timer enter_timer;
+      srsran::unique_timer exit_timer;
     };
+    // Trigger state of the cells of a measId, sorted by PCI
+    typedef std::vector<cell_trigger_state> cell_trigger_list_t;
+
+    cell_trigger_state& get_trigger_state(cell_trigger_list_t& list, uint32_t pci);
+    static cell_trigger_state* find_trigger_state(cell_trigger_list_t& list, uint32_t pci);
+    static void                begin_trigger_eval(cell_trigger_list_t& list);
+    static void                end_trigger_eval(cell_trigger_list_t& list);
 
     // varMeasConfig data
     std::map<uint32_t, meas_id_to_add_mod_s>    measIdList;       // Uses MeasId as key
@@ -183,11 +203,15 @@ private:
     phy_quant_t filter_a = {1.0, 1.0}; // disable filtering until quantityConfig is received (see Sec. 5.5.3.2 Note 2)
     float       s_measure_value = 0.0;
 
-    // trigger counters. First key is measId, second key is cell id (pci)
-    // It is safe to use [] operator in this double-map because all members are uint32_t
-    std::map<uint32_t, std::map<uint32_t, cell_trigger_state> > trigger_state;
+    // trigger state of each cell, indexed by measId
+    std::array<cell_trigger_list_t, ASN1_RRC_MAX_MEAS_ID + 1> trigger_state;
+    std::array<cell_trigger_list_t, ASN1_RRC_MAX_MEAS_ID + 1> trigger_state_nr;
 
-    std::map<uint32_t, std::map<uint32_t, cell_trigger_state> > trigger_state_nr;
+    // The triggers of a RAT are only evaluated again when its cells have new measurements, or when the configuration
+    // or the serving cell change
+    bool       eutra_meas_updated = true;
+    bool       nr_meas_updated    = true;
+    phy_cell_t last_serving_cell  = {};
 
     var_meas_report_list* meas_report = nullptr;
     srslog::basic_logger& logger;
@@ -75,6 +75,7 @@ typedef struct {
   gw_args_t        gw;
   uint32_t         sync_queue_size; // Max allowed difference between PHY and Stack clocks (in TTI)
   bool             have_tti_time_stats;
+  bool             mac_dl_data_fast_path; // Deliver the DL SDUs of the DRBs to RLC from the PHY workers
   bool             sa_mode;
 } stack_args_t;
 
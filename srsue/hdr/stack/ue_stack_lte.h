@@ -64,6 +64,10 @@ public:
   {
     parent_pdcp->write_sdu(lcid, std::move(pdu));
   }
+  void write_sdus(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus) final
+  {
+    parent_pdcp->write_sdus(lcid, sdus);
+  }
   void write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu) final
   {
     parent_sdap->write_pdu(lcid, std::move(pdu));
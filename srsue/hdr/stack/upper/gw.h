@@ -31,9 +31,11 @@
 #include "srsran/srslog/srslog.h"
 #include "tft_packet_filter.h"
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <net/if.h>
 #include <netinet/in.h>
+#include <vector>
 
 namespace srsue {
 
@@ -47,6 +49,7 @@ struct gw_args_t {
   std::string netns;
   std::string tun_dev_name;
   std::string tun_dev_netmask;
+  uint32_t    nof_tun_queues = 1;
 };
 
 class gw : public gw_interface_stack, public srsran::thread
@@ -76,6 +79,19 @@ public:
 private:
   static const int GW_THREAD_PRIO = -1;
 
+  /// Reads the UL packets of one of the additional queues of a multi-queue TUN device
+  class tun_queue_reader : public srsran::thread
+  {
+  public:
+    tun_queue_reader(gw& parent_, int32_t fd_) : thread("GW_QUEUE"), parent(parent_), fd(fd_) {}
+
+  private:
+    void run_thread() override { parent.run_tun_reader(fd); }
+
+    gw&     parent;
+    int32_t fd;
+  };
+
   stack_interface_gw* stack = nullptr;
 
   gw_args_t args = {};
@@ -88,6 +104,10 @@ private:
   int32_t           sock       = 0;
   std::atomic<bool> if_up      = {false};
 
+  // Additional queues of a multi-queue TUN device, besides tun_fd, and their reader threads
+  std::vector<int32_t>                            tun_queue_fds;
+  std::vector<std::unique_ptr<tun_queue_reader> > tun_queue_readers;
+
   static const int NOT_ASSIGNED          = -1;
   int32_t          default_eps_bearer_id = NOT_ASSIGNED;
   std::mutex       gw_mutex;
@@ -102,6 +122,9 @@ private:
   std::chrono::high_resolution_clock::time_point metrics_tp; // stores time when last metrics have been taken
 
   void run_thread();
+  void run_tun_reader(int32_t fd);
+  void start_tun_queue_readers();
+  void stop_tun_queue_readers();
   int  init_if(char* err_str);
   int  setup_if_addr4(uint32_t ip_addr, char* err_str);
   int  setup_if_addr6(uint8_t* ipv6_if_id, char* err_str);
@@ -40,14 +40,34 @@ public:
 
   // Interface for GW
   void write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu) final;
+  void write_pdus(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> pdus) final;
 
   // Interface for PDCP
   void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu) final;
+  void write_sdus(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus) final;
 
   // Interface for RRC
   bool set_bearer_cfg(uint32_t lcid, const sdap_interface_rrc::bearer_cfg_t& cfg) final;
 
+  /// Returns the LCID of the DRB the QoS flow is mapped to, or MAX_NR_NOF_BEARERS if it is not mapped
+  uint32_t get_lcid(uint32_t qfi) const
+  {
+    return qfi < qfi_to_lcid.size() ? qfi_to_lcid[qfi] : srsran::MAX_NR_NOF_BEARERS;
+  }
+
+  static const uint32_t max_qfi = 63;
+
 private:
+  // The header of each bearer is precomputed at configuration, so that it is written into the buffer headroom
+  struct bearer_ctxt_t {
+    bool    add_ul_hdr  = false;
+    bool    has_dl_hdr  = false;
+    uint8_t ul_hdr_byte = 0;
+  };
+
+  void add_ul_header(const bearer_ctxt_t& bearer, srsran::byte_buffer_t& pdu);
+  bool remove_dl_header(uint32_t lcid, const bearer_ctxt_t& bearer, srsran::byte_buffer_t& pdu);
+
   pdcp_interface_sdap_nr* m_pdcp = nullptr;
   gw_interface_pdcp*      m_gw   = nullptr;
 
@@ -55,7 +75,8 @@ private:
   bool running = false;
 
   // configuration
-  std::array<sdap_interface_rrc::bearer_cfg_t, srsran::MAX_NR_NOF_BEARERS> bearers = {};
+  std::array<bearer_ctxt_t, srsran::MAX_NR_NOF_BEARERS> bearers = {};
+  std::array<uint8_t, max_qfi + 1>                      qfi_to_lcid;
 
   srslog::basic_logger& logger;
 };
@@ -22,10 +22,13 @@
 #ifndef SRSUE_PACKET_FILTER_H
 #define SRSUE_PACKET_FILTER_H
 
+#include "srsran/adt/span.h"
 #include "srsran/asn1/liblte_mme.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/srslog/srslog.h"
+#include <cstring>
 #include <mutex>
+#include <unordered_map>
 
 namespace srsue {
 
@@ -106,8 +109,37 @@ public:
   bool match_port(const srsran::unique_byte_buffer_t& pdu);
 };
 
+/// Fields of an outgoing IP packet that the packet filters look at. The ports are kept in network byte order
+struct tft_flow_key_t {
+  uint8_t  version;
+  uint8_t  protocol;
+  uint8_t  type_of_service;
+  uint8_t  reserved;
+  uint16_t local_port;
+  uint16_t remote_port;
+  uint8_t  local_addr[IPV6_ADDR_SIZE];
+  uint8_t  remote_addr[IPV6_ADDR_SIZE];
+
+  bool operator==(const tft_flow_key_t& other) const { return memcmp(this, &other, sizeof(tft_flow_key_t)) == 0; }
+};
+
+struct tft_flow_key_hash {
+  size_t operator()(const tft_flow_key_t& key) const
+  {
+    // FNV-1a over the key bytes
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&key);
+    size_t         h     = 14695981039346656037ULL;
+    for (size_t i = 0; i < sizeof(tft_flow_key_t); ++i) {
+      h = (h ^ bytes[i]) * 1099511628211ULL;
+    }
+    return h;
+  }
+};
+
 /**
  * TFT PDU matcher class used by GW and TTCN3 DUT testloop handler
+ * The result of the match is cached per flow, so that the packet filters are only evaluated for the first packet of
+ * each flow. The cache is flushed whenever the TFTs change
  */
 class tft_pdu_matcher
 {
@@ -115,18 +147,36 @@ public:
   explicit tft_pdu_matcher(srslog::basic_logger& logger) : logger(logger) {}
   ~tft_pdu_matcher(){};
 
+  /// Maximum number of PDUs matched at once
+  static const size_t max_burst_size = 32;
+
   void reset();
 
   int     check_tft_filter_match(const srsran::unique_byte_buffer_t& pdu, uint8_t& eps_bearer_id);
+  /// Matches a burst of PDUs, leaving untouched the EPS bearer ID of those that match no filter. Each filter is
+  /// evaluated over the PDUs not matched yet, with a single lock of the filter list for the whole burst
+  void    check_tft_filter_match(srsran::span<const srsran::unique_byte_buffer_t> pdus,
+                                 srsran::span<uint8_t>                            eps_bearer_ids);
   int     apply_traffic_flow_template(const uint8_t&                                 erab_id,
                                       const LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT* tft);
   void    delete_tft_for_eps_bearer(const uint8_t eps_bearer_id);
 
+  size_t nof_cached_flows();
+
 private:
+  /// Above this number of flows, the cache is flushed
+  static const size_t max_cached_flows = 1024;
+  /// Cached result of the flows that match no packet filter
+  static const uint8_t no_match_flow = 0xff;
+
+  bool match_unprotected(const srsran::unique_byte_buffer_t& pdu, uint8_t& eps_bearer_id);
+
   srslog::basic_logger&                           logger;
   std::mutex                                      tft_mutex;
   typedef std::map<uint16_t, tft_packet_filter_t> tft_filter_map_t;
   tft_filter_map_t                                tft_filter_map;
+  typedef std::unordered_map<tft_flow_key_t, uint8_t, tft_flow_key_hash> tft_flow_cache_t;
+  tft_flow_cache_t                                                      flow_cache;
 };
 
 } // namespace srsue
@@ -75,6 +75,9 @@ typedef struct {
   bool        tracing_enable;
   std::string tracing_filename;
   std::size_t tracing_buffcapacity;
+  bool        phy_stage_prof;
+  uint32_t    nof_ues;
+  uint32_t    ue_port_stride;
 } general_args_t;
 
 typedef struct {
@@ -90,6 +93,10 @@ typedef struct {
   general_args_t general;
 } all_args_t;
 
+/// Adapts the arguments of a process hosting several UEs to the UE with index ue_idx, so that each one has its own
+/// IMSI, IMEI, TUN device, capture files and ZMQ ports.
+void set_multi_ue_args(all_args_t& args, uint32_t ue_idx);
+
 /*******************************************************************************
   Main UE class
 *******************************************************************************/
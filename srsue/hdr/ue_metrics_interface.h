@@ -26,6 +26,7 @@
 
 #include "phy/phy_metrics.h"
 #include "srsran/common/metrics_hub.h"
+#include "srsran/phy/utils/stage_prof.h"
 #include "srsran/radio/radio_metrics.h"
 #include "srsran/rlc/rlc_metrics.h"
 #include "srsran/system/sys_metrics.h"
@@ -48,12 +49,13 @@ typedef struct {
 } stack_metrics_t;
 
 typedef struct {
-  srsran::rf_metrics_t  rf;
-  phy_metrics_t         phy;
-  phy_metrics_t         phy_nr;
-  gw_metrics_t          gw;
-  stack_metrics_t       stack;
-  srsran::sys_metrics_t sys;
+  srsran::rf_metrics_t        rf;
+  phy_metrics_t               phy;
+  phy_metrics_t               phy_nr;
+  gw_metrics_t                gw;
+  stack_metrics_t             stack;
+  srsran::sys_metrics_t       sys;
+  srsran_stage_prof_metrics_t phy_stages[SRSRAN_STAGE_PROF_NOF];
 } ue_metrics_t;
 
 // UE interface
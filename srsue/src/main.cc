@@ -25,6 +25,7 @@
 #include "srsran/common/metrics_hub.h"
 #include "srsran/common/multiqueue.h"
 #include "srsran/common/tsan_options.h"
+#include "srsran/phy/utils/stage_prof.h"
 #include "srsran/srslog/event_trace.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
@@ -208,9 +209,11 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("gw.netns", bpo::value<string>(&args->gw.netns)->default_value(""), "Network namespace to for TUN device (empty for default netns)")
     ("gw.ip_devname", bpo::value<string>(&args->gw.tun_dev_name)->default_value("tun_srsue"), "Name of the tun_srsue device")
     ("gw.ip_netmask", bpo::value<string>(&args->gw.tun_dev_netmask)->default_value("255.255.255.0"), "Netmask of the tun_srsue device")
+    ("gw.nof_tun_queues", bpo::value<uint32_t>(&args->gw.nof_tun_queues)->default_value(1), "Number of queues (and reader threads) of the tun_srsue device")
 
     /* Downlink Channel emulator section */
     ("channel.dl.enable",            bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false),                 "Enable/Disable internal Downlink channel emulator")
+    ("channel.dl.nof_threads",       bpo::value<uint32_t>(&args->phy.dl_channel_args.nof_threads)->default_value(1),            "Number of threads sharing the channel emulator antennas")
     ("channel.dl.awgn.enable",       bpo::value<bool>(&args->phy.dl_channel_args.awgn_enable)->default_value(false),            "Enable/Disable AWGN simulator")
     ("channel.dl.awgn.snr",          bpo::value<float>(&args->phy.dl_channel_args.awgn_snr_dB)->default_value(30.0f),           "SNR in dB")
     ("channel.dl.awgn.signal_power", bpo::value<float>(&args->phy.dl_channel_args.awgn_signal_power_dBfs)->default_value(0.0f), "Received signal power in decibels full scale (dBfs)")
@@ -231,6 +234,7 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Uplink Channel emulator section */
     ("channel.ul.enable",            bpo::value<bool>(&args->phy.ul_channel_args.enable)->default_value(false),                  "Enable/Disable internal Downlink channel emulator")
+    ("channel.ul.nof_threads",       bpo::value<uint32_t>(&args->phy.ul_channel_args.nof_threads)->default_value(1),             "Number of threads sharing the channel emulator antennas")
     ("channel.ul.awgn.enable",       bpo::value<bool>(&args->phy.ul_channel_args.awgn_enable)->default_value(false),             "Enable/Disable AWGN simulator")
     ("channel.ul.awgn.snr",          bpo::value<float>(&args->phy.ul_channel_args.awgn_snr_dB)->default_value(30.0f),            "Noise level in decibels full scale (dBfs)")
     ("channel.ul.awgn.signal_power", bpo::value<float>(&args->phy.ul_channel_args.awgn_signal_power_dBfs)->default_value(30.0f), "Transmitted signal power in decibels full scale (dBfs)")
@@ -286,6 +290,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<uint32_t>(&args->phy.sfo_correct_period)->default_value(DEFAULT_SAMPLE_OFFSET_CORRECT_PERIOD),
      "Period in ms to correct sample time")
 
+    ("phy.pss_track_period",
+     bpo::value<uint32_t>(&args->phy.pss_track_period)->default_value(0),
+     "Once the timing is stable, track one PSS every this number of PSS (Default 0, track every PSS)")
+
     ("phy.sfo_emma",
      bpo::value<float>(&args->phy.sfo_ema)->default_value(DEFAULT_SFO_EMA_COEFF),
      "EMA coefficient to average sample offsets used to compute SFO")
@@ -310,6 +318,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<uint32_t>(&args->phy.nof_phy_threads)->default_value(3),
      "Number of PHY threads")
 
+    ("phy.parallel_cc",
+     bpo::value<bool>(&args->phy.parallel_cc)->default_value(false),
+     "Process the DL of the secondary carriers in parallel to the primary carrier")
+
     ("phy.equalizer_mode",
      bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"),
      "Equalizer mode")
@@ -385,10 +397,18 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<uint32_t>(&args->phy.estimator_fil_order)->default_value(4),
      "Sets the channel estimator smooth gaussian filter order (even values perform better).")
 
+    ("phy.estimator_sf_avg",
+     bpo::value<uint32_t>(&args->phy.estimator_sf_avg)->default_value(0),
+     "Averages the channel estimator pilots over the last N subframes (0 or 1 disables).")
+
     ("phy.snr_to_cqi_offset",
      bpo::value<float>(&args->phy.snr_to_cqi_offset)->default_value(0),
      "Sets an offset in the SNR to CQI table. This is used to adjust the reported CQI.")
 
+    ("phy.pmi_decimation",
+     bpo::value<uint32_t>(&args->phy.pmi_decimation)->default_value(0),
+     "Uses one every N resource elements for the PMI selection (0 uses all of them).")
+
     ("phy.sss_algorithm",
      bpo::value<string>(&args->phy.sss_algorithm)->default_value("full"),
      "Selects the SSS estimation algorithm.")
@@ -437,11 +457,19 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<int>(&args->phy.force_N_id_1)->default_value(-1),
      "Force using a specific SSS (set to -1 to allow all SSSs).")
 
+    ("phy.cell_cache_file",
+     bpo::value<string>(&args->phy.cell_cache_file)->default_value(""),
+     "File storing the cells camped on, probed first by the cell search. Empty keeps them in memory only.")
+
     // PHY NR args
     ("phy.nr.store_pdsch_ko",
       bpo::value<bool>(&args->phy.nr_store_pdsch_ko)->default_value(false),
       "Dumps the PDSCH baseband samples into a file on KO reception.")
 
+    ("phy.nr.rx_queue_size",
+      bpo::value<uint32_t>(&args->phy.nr_rx_queue_size)->default_value(0),
+      "Number of received slots queued for the SA workers, 0 receives into the worker buffers")
+
     // UE simulation args
     ("sim.airplane_t_on_ms",
      bpo::value<int>(&args->stack.nas.sim.airplane_t_on_ms)->default_value(-1),
@@ -492,10 +520,27 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
            bpo::value<std::size_t>(&args->general.tracing_buffcapacity)->default_value(1000000),
            "Tracing buffer capcity")
 
+    ("general.phy_stage_prof",
+           bpo::value<bool>(&args->general.phy_stage_prof)->default_value(false),
+           "Time the PHY processing stages and report them in the metrics (toggled at runtime with the prof command)")
+
+    ("general.nof_ues",
+           bpo::value<uint32_t>(&args->general.nof_ues)->default_value(1),
+           "Number of UEs hosted by this process")
+
+    ("general.ue_port_stride",
+           bpo::value<uint32_t>(&args->general.ue_port_stride)->default_value(10),
+           "Offset between the ZMQ ports of consecutive UEs when hosting several UEs")
+
     ("stack.have_tti_time_stats",
         bpo::value<bool>(&args->stack.have_tti_time_stats)->default_value(true),
         "Calculate TTI execution statistics")
 
+    ("stack.mac_dl_data_fast_path",
+        bpo::value<bool>(&args->stack.mac_dl_data_fast_path)->default_value(false),
+        "Demultiplex the DL SDUs of the data bearers in the PHY workers and pass them to RLC, PDCP and GW there "
+        "instead of in the stack thread (experimental)")
+
     ;
 
   // Positional options - config file location
@@ -687,6 +732,10 @@ static void* input_loop(void*)
       } else if (key == "flush") {
         srslog::flush();
         cout << "Flushed log file buffers" << endl;
+      } else if (key == "prof") {
+        bool enable = !srsran_stage_prof_is_enabled();
+        srsran_stage_prof_set_enabled(enable);
+        cout << "PHY stage timers " << (enable ? "enabled" : "disabled") << endl;
       } else if (key == "q") {
         // let the signal handler do the job
         raise(SIGTERM);
@@ -749,6 +798,8 @@ int main(int argc, char* argv[])
   }
 #endif
 
+  srsran_stage_prof_set_enabled(args.general.phy_stage_prof);
+
   // Start the log backend.
   srslog::init();
 
@@ -761,13 +812,26 @@ int main(int argc, char* argv[])
     fprintf(stderr, "Failed to `mlockall`: %d", errno);
   }
 
-  // Create UE instance.
-  srsue::ue ue;
-  if (ue.init(args)) {
-    ue.stop();
-    return SRSRAN_SUCCESS;
+  if (args.general.nof_ues == 0) {
+    cout << "Error: general.nof_ues must be at least 1" << endl;
+    return SRSRAN_ERROR;
   }
 
+  // Create the UE instances. The metrics and the GUI are only provided for the first one.
+  std::vector<std::unique_ptr<srsue::ue> > ues;
+  for (uint32_t i = 0; i < args.general.nof_ues; i++) {
+    all_args_t ue_args = args;
+    set_multi_ue_args(ue_args, i);
+    ues.emplace_back(new srsue::ue);
+    if (ues.back()->init(ue_args)) {
+      for (auto& u : ues) {
+        u->stop();
+      }
+      return SRSRAN_SUCCESS;
+    }
+  }
+  srsue::ue& ue = *ues.front();
+
   srsran::metrics_hub<ue_metrics_t> metricshub;
   metrics_stdout                    _metrics_screen;
 
@@ -801,7 +865,9 @@ int main(int argc, char* argv[])
   pthread_create(&input, nullptr, &input_loop, &args);
 
   cout << "Attaching UE..." << endl;
-  ue.switch_on();
+  for (auto& u : ues) {
+    u->switch_on();
+  }
 
   if (args.gui.enable) {
     ue.start_plot();
@@ -811,12 +877,16 @@ int main(int argc, char* argv[])
     sleep(1);
   }
 
-  ue.switch_off();
+  for (auto& u : ues) {
+    u->switch_off();
+  }
   pthread_cancel(input);
   pthread_join(input, nullptr);
   metricshub.stop();
   metrics_file.stop();
-  ue.stop();
+  for (auto& u : ues) {
+    u->stop();
+  }
   cout << "---  exiting  ---" << endl;
 
   return SRSRAN_SUCCESS;
@@ -56,6 +56,7 @@ DECLARE_METRIC("pathloss", metric_pathloss, float, "");
 DECLARE_METRIC("cfo", metric_cfo, float, "");
 DECLARE_METRIC("dl_snr", metric_dl_snr, float, "");
 DECLARE_METRIC("dl_mcs", metric_dl_mcs, float, "");
+DECLARE_METRIC("dl_skipped_tb", metric_dl_skipped_tb, uint32_t, "");
 DECLARE_METRIC("ul_mcs", metric_ul_mcs, float, "");
 DECLARE_METRIC("ul_ta", metric_ul_ta, float, "");
 DECLARE_METRIC("distance_km", metric_distance_km, float, "");
@@ -69,6 +70,7 @@ DECLARE_METRIC_SET("carrier_container",
                    metric_cfo,
                    metric_dl_snr,
                    metric_dl_mcs,
+                   metric_dl_skipped_tb,
                    metric_ul_mcs,
                    metric_ul_ta,
                    metric_distance_km,
@@ -121,6 +123,23 @@ DECLARE_METRIC_SET("sys_cpu_container",
                    metric_thread_count,
                    mlist_cpu_core_list);
 
+/// PHY stage timer metrics.
+DECLARE_METRIC("stage", metric_stage, std::string, "");
+DECLARE_METRIC("nof_meas", metric_nof_meas, uint64_t, "");
+DECLARE_METRIC("time_avg", metric_time_avg, double, "");
+DECLARE_METRIC("time_max", metric_time_max, double, "");
+DECLARE_METRIC("nof_meas", metric_bin_nof_meas, uint64_t, "");
+DECLARE_METRIC_SET("time_bin", mset_time_bin, metric_bin_nof_meas);
+DECLARE_METRIC_LIST("time_hist", mlist_time_hist, std::vector<mset_time_bin>);
+DECLARE_METRIC_SET("phy_stage_container",
+                   mset_phy_stage_container,
+                   metric_stage,
+                   metric_nof_meas,
+                   metric_time_avg,
+                   metric_time_max,
+                   mlist_time_hist);
+DECLARE_METRIC_LIST("phy_stage_list", mlist_phy_stages, std::vector<mset_phy_stage_container>);
+
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
 DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
@@ -135,7 +154,8 @@ using metric_context_t = srslog::build_context_type<metric_type_tag,
                                                     mset_nas_container,
                                                     mset_rf_container,
                                                     mset_sys_mem_container,
-                                                    mset_sys_cpu_container>;
+                                                    mset_sys_cpu_container,
+                                                    mlist_phy_stages>;
 
 } // namespace
 
@@ -179,6 +199,7 @@ void metrics_json::set_metrics(const ue_metrics_t& metrics, const uint32_t perio
 
     carrier.write<metric_dl_snr>(metrics.phy.ch[i].sinr);
     carrier.write<metric_dl_mcs>(metrics.phy.dl[i].mcs);
+    carrier.write<metric_dl_skipped_tb>(metrics.phy.dl[i].nof_skipped_tb);
     carrier.write<metric_ul_mcs>(metrics.phy.ul[i].mcs);
     carrier.write<metric_ul_ta>(metrics.phy.sync[i].ta_us);
     carrier.write<metric_distance_km>(metrics.phy.sync[i].distance_km);
@@ -238,6 +259,26 @@ void metrics_json::set_metrics(const ue_metrics_t& metrics, const uint32_t perio
     core_list[i].write<metric_proc_core_usage>(metrics.sys.cpu_load[i]);
   }
 
+  // Fill PHY stage timers, nothing is reported while they are disabled.
+  auto& stage_list = ctx.get<mlist_phy_stages>();
+  if (srsran_stage_prof_is_enabled()) {
+    stage_list.resize(SRSRAN_STAGE_PROF_NOF);
+    for (uint32_t i = 0; i != SRSRAN_STAGE_PROF_NOF; ++i) {
+      const srsran_stage_prof_metrics_t& m = metrics.phy_stages[i];
+      stage_list[i].write<metric_stage>(srsran_stage_prof_name(static_cast<srsran_stage_prof_t>(i)));
+      stage_list[i].write<metric_nof_meas>(m.count);
+      if (m.count > 0) {
+        stage_list[i].write<metric_time_avg>(m.total_us / m.count);
+        stage_list[i].write<metric_time_max>(m.max_us);
+      }
+      auto& hist = stage_list[i].get<mlist_time_hist>();
+      hist.resize(SRSRAN_STAGE_PROF_HIST_LEN);
+      for (uint32_t j = 0; j != SRSRAN_STAGE_PROF_HIST_LEN; ++j) {
+        hist[j].write<metric_bin_nof_meas>(m.hist[j]);
+      }
+    }
+  }
+
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
   log_c(ctx);
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsue/hdr/phy/cell_cache.h"
+#include "srsran/phy/common/phy_common.h"
+#include <fstream>
+
+namespace srsue {
+
+void cell_cache::init(const std::string& filename_)
+{
+  filename = filename_;
+  entries.clear();
+
+  if (filename.empty()) {
+    return;
+  }
+
+  // Every line holds the EARFCN and the PCI of a cell, most recent first
+  std::ifstream file(filename, std::ios::in);
+  if (not file.is_open()) {
+    logger.info("Cell cache: no cells stored in %s", filename.c_str());
+    return;
+  }
+
+  entry_t e = {};
+  while (entries.size() < max_entries and file >> e.earfcn >> e.pci) {
+    if (not srsran_cellid_isvalid(e.pci) or find(e.earfcn) != nullptr) {
+      logger.warning("Cell cache: skipping invalid entry EARFCN=%d PCI=%d", e.earfcn, e.pci);
+      continue;
+    }
+    entries.push_back(e);
+  }
+
+  logger.info("Cell cache: loaded %zd cells from %s", entries.size(), filename.c_str());
+}
+
+void cell_cache::add(uint32_t earfcn, uint32_t pci)
+{
+  // Nothing to store if it is already the most recent cell
+  if (not entries.empty() and entries.front().earfcn == earfcn and entries.front().pci == pci) {
+    return;
+  }
+
+  for (auto it = entries.begin(); it != entries.end(); ++it) {
+    if (it->earfcn == earfcn) {
+      entries.erase(it);
+      break;
+    }
+  }
+
+  entry_t e = {};
+  e.earfcn  = earfcn;
+  e.pci     = pci;
+  entries.insert(entries.begin(), e);
+  if (entries.size() > max_entries) {
+    entries.pop_back();
+  }
+
+  save();
+}
+
+const cell_cache::entry_t* cell_cache::find(uint32_t earfcn) const
+{
+  for (const entry_t& e : entries) {
+    if (e.earfcn == earfcn) {
+      return &e;
+    }
+  }
+  return nullptr;
+}
+
+void cell_cache::save() const
+{
+  if (filename.empty()) {
+    return;
+  }
+
+  std::ofstream file(filename, std::ios::out | std::ios::trunc);
+  if (not file.is_open()) {
+    logger.warning("Cell cache: can not open %s for writing", filename.c_str());
+    return;
+  }
+
+  for (const entry_t& e : entries) {
+    file << e.earfcn << " " << e.pci << std::endl;
+  }
+}
+
+} // namespace srsue
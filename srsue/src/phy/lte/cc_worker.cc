@@ -475,6 +475,7 @@ int cc_worker::decode_pdsch(srsran_pdsch_ack_resource_t            ack_resource,
 
   // Generate ACKs for MAC and PUCCH
   uint32_t nof_tb                             = 0;
+  uint32_t nof_skipped_tb                     = 0;
   uint8_t  pending_acks[SRSRAN_MAX_CODEWORDS] = {};
   for (uint32_t tb = 0; tb < SRSRAN_MAX_CODEWORDS; tb++) {
     // For MAC, set to true if it's a duplicate
@@ -486,9 +487,18 @@ int cc_worker::decode_pdsch(srsran_pdsch_ack_resource_t            ack_resource,
 
     if (tb_enable[tb]) {
       nof_tb++;
+
+      // The HARQ process already decoded this TB, it is acknowledged without decoding it again
+      if (not action->tb[tb].enabled) {
+        nof_skipped_tb++;
+      }
     }
   }
 
+  if (nof_skipped_tb > 0) {
+    phy->set_dl_skipped_tb(cc_idx, nof_skipped_tb);
+  }
+
   if (action->generate_ack && nof_tb > 0) {
     phy->set_dl_pending_ack(&sf_cfg_dl, cc_idx, pending_acks, ack_resource);
   }
@@ -56,7 +56,11 @@ static bool      plot_nr_enable = false;
 namespace srsue {
 namespace lte {
 
-sf_worker::sf_worker(uint32_t max_prb, phy_common* phy_, srslog::basic_logger& logger) : logger(logger)
+sf_worker::sf_worker(uint32_t                  max_prb,
+                     phy_common*               phy_,
+                     srslog::basic_logger&     logger,
+                     srsran::task_thread_pool* cc_pool_) :
+  logger(logger), cc_pool(cc_pool_)
 {
   phy = phy_;
 
@@ -170,22 +174,9 @@ void sf_worker::work_imp()
 
   /***** Downlink Processing *******/
 
-  // Loop through all carriers. carrier_idx=0 is PCell
-  for (uint32_t carrier_idx = 0; carrier_idx < cc_workers.size(); carrier_idx++) {
-    // Process all DL and special subframes
-    if (srsran_sfidx_tdd_type(tdd_config, tti % 10) != SRSRAN_TDD_SF_U || cell.frame_type == SRSRAN_FDD) {
-      srsran_mbsfn_cfg_t mbsfn_cfg;
-      ZERO_OBJECT(mbsfn_cfg);
-
-      if (carrier_idx == 0 && phy->is_mbsfn_sf(&mbsfn_cfg, tti)) {
-        rx_signal_ok =
-            cc_workers[0]->work_dl_mbsfn(mbsfn_cfg); // Don't do chest_ok in mbsfn since it trigger measurements
-      } else {
-        if (phy->cell_state.is_configured(carrier_idx)) {
-          rx_signal_ok = cc_workers[carrier_idx]->work_dl_regular();
-        }
-      }
-    }
+  // Process all DL and special subframes
+  if (srsran_sfidx_tdd_type(tdd_config, tti % 10) != SRSRAN_TDD_SF_U || cell.frame_type == SRSRAN_FDD) {
+    rx_signal_ok = work_dl(tti);
   }
   tx_signal_ptr.set_nof_samples(nof_samples);
 
@@ -245,6 +236,71 @@ void sf_worker::work_imp()
 #endif
 }
 
+bool sf_worker::work_dl(uint32_t tti)
+{
+  std::array<bool, SRSRAN_MAX_CARRIERS> processed = {};
+  std::array<bool, SRSRAN_MAX_CARRIERS> chest_ok  = {};
+
+  // The SCells can be processed in parallel unless a carrier schedules others, as the grants it decodes are pending
+  // for the rest of carriers of this subframe
+  bool parallel = cc_pool != nullptr;
+  for (uint32_t carrier_idx = 0; carrier_idx < cc_workers.size() and parallel; carrier_idx++) {
+    parallel = not cc_workers[carrier_idx]->is_cif_present_nolock();
+  }
+
+  // Dispatch the SCells to the carrier pool first, so they are processed while this worker processes the PCell
+  for (uint32_t carrier_idx = 1; carrier_idx < cc_workers.size() and parallel; carrier_idx++) {
+    if (phy->cell_state.is_configured(carrier_idx)) {
+      processed[carrier_idx] = true;
+      {
+        std::lock_guard<std::mutex> lock(cc_mutex);
+        cc_pending++;
+      }
+      cc_pool->push_task([this, carrier_idx, &chest_ok]() {
+        chest_ok[carrier_idx] = cc_workers[carrier_idx]->work_dl_regular();
+
+        std::lock_guard<std::mutex> lock(cc_mutex);
+        cc_pending--;
+        cc_cvar.notify_one();
+      });
+    }
+  }
+
+  // Loop through all carriers not dispatched. carrier_idx=0 is PCell
+  uint32_t nof_inline_cc = parallel ? 1 : (uint32_t)cc_workers.size();
+  for (uint32_t carrier_idx = 0; carrier_idx < nof_inline_cc; carrier_idx++) {
+    srsran_mbsfn_cfg_t mbsfn_cfg;
+    ZERO_OBJECT(mbsfn_cfg);
+
+    if (carrier_idx == 0 && phy->is_mbsfn_sf(&mbsfn_cfg, tti)) {
+      // Don't do chest_ok in mbsfn since it trigger measurements
+      processed[0] = true;
+      chest_ok[0]  = cc_workers[0]->work_dl_mbsfn(mbsfn_cfg);
+    } else if (phy->cell_state.is_configured(carrier_idx)) {
+      processed[carrier_idx] = true;
+      chest_ok[carrier_idx]  = cc_workers[carrier_idx]->work_dl_regular();
+    }
+  }
+
+  // Wait for the SCells before the UL generation, it requires the acknowledgements of all the carriers
+  {
+    std::unique_lock<std::mutex> lock(cc_mutex);
+    while (cc_pending > 0) {
+      cc_cvar.wait(lock);
+    }
+  }
+
+  // As in the sequential processing, the measurements are updated if the last processed carrier estimated the channel
+  bool rx_signal_ok = false;
+  for (uint32_t carrier_idx = 0; carrier_idx < cc_workers.size(); carrier_idx++) {
+    if (processed[carrier_idx]) {
+      rx_signal_ok = chest_ok[carrier_idx];
+    }
+  }
+
+  return rx_signal_ok;
+}
+
 /********************* Uplink common control functions ****************************/
 
 void sf_worker::reset_uci(srsran_uci_data_t* uci_data)
@@ -54,13 +54,20 @@ worker_pool::worker_pool(uint32_t max_workers) :
 
 bool worker_pool::init(phy_common* common, int prio)
 {
+  // Every worker can have all its SCells in process at the same time
+  if (common->args->parallel_cc and common->args->nof_lte_carriers > 1) {
+    uint32_t nof_cc_threads = (common->args->nof_lte_carriers - 1) * common->args->nof_phy_threads;
+    uint32_t mask           = common->args->worker_cpu_mask < 0 ? 255 : (uint32_t)common->args->worker_cpu_mask;
+    cc_pool.reset(new srsran::task_thread_pool(nof_cc_threads, false, prio, mask));
+  }
+
   // Add workers to workers pool and start threads
   for (uint32_t i = 0; i < common->args->nof_phy_threads; i++) {
     srslog::basic_logger& log = srslog::fetch_basic_logger(fmt::format("PHY{}", i));
     log.set_level(srslog::str_to_basic_level(common->args->log.phy_level));
     log.set_hex_dump_max_size(common->args->log.phy_hex_limit);
 
-    auto w = std::unique_ptr<lte::sf_worker>(new lte::sf_worker(SRSRAN_MAX_PRB, common, log));
+    auto w = std::unique_ptr<lte::sf_worker>(new lte::sf_worker(SRSRAN_MAX_PRB, common, log, cc_pool.get()));
     pool.init_worker(i, w.get(), prio, common->args->worker_cpu_mask);
     workers.push_back(std::move(w));
   }
@@ -101,7 +108,11 @@ sf_worker* worker_pool::wait_worker_id(uint32_t id)
 
 void worker_pool::stop()
 {
+  // The workers might be waiting for their SCells, stop them before the carrier pool
   pool.stop();
+  if (cc_pool) {
+    cc_pool->stop();
+  }
 }
 
 void worker_pool::set_config(uint32_t cc_idx, const srsran::phy_cfg_t& phy_cfg)
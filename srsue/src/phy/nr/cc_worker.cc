@@ -512,8 +512,9 @@ bool cc_worker::work_dl()
     return true;
   }
 
-  // Check if it is a DL slot, if not skip
-  if (!srsran_duplex_nr_is_dl(&cfg.duplex, 0, dl_slot_cfg.idx)) {
+  // Skip the whole DL chain if the slot has no DL symbols
+  srsran_duplex_nr_slot_t slot_type = srsran_duplex_nr_slot_type(&cfg.duplex, 0, dl_slot_cfg.idx);
+  if (slot_type != SRSRAN_DUPLEX_NR_SLOT_DL and slot_type != SRSRAN_DUPLEX_NR_SLOT_DL_UL) {
     return true;
   }
 
@@ -560,10 +561,11 @@ bool cc_worker::work_ul()
   srsran_pdsch_ack_nr_t pdsch_ack  = {};
   bool                  has_ul_ack = phy.get_pending_ack(ul_slot_cfg.idx, pdsch_ack);
 
-  // Check if it is a UL slot, if not skip
-  if (!srsran_duplex_nr_is_ul(&cfg.duplex, 0, ul_slot_cfg.idx)) {
-    // No NR signal shall be transmitted
-    srsran_vec_cf_zero(tx_buffer[0], ue_ul.ifft.sf_sz);
+  // Skip the whole UL chain if the slot has no UL symbols
+  srsran_duplex_nr_slot_t slot_type = srsran_duplex_nr_slot_type(&cfg.duplex, 0, ul_slot_cfg.idx);
+  tx_enabled                        = (slot_type == SRSRAN_DUPLEX_NR_SLOT_UL or slot_type == SRSRAN_DUPLEX_NR_SLOT_DL_UL);
+  if (not tx_enabled) {
+    // No NR signal shall be transmitted, the Tx buffer is left as it is because it is not sent
 
     // Check if there is any pending ACK for this DL slot...
     if (pdsch_ack.nof_cc > 1) {
@@ -110,8 +110,10 @@ void sf_worker::work_imp()
   }
 
   // Perform UL processing
+  bool tx_enable = false;
   for (auto& w : cc_workers) {
     w.get()->work_ul();
+    tx_enable |= w->is_tx_enabled();
   }
 
   // Set Tx buffers
@@ -120,8 +122,8 @@ void sf_worker::work_imp()
   }
   tx_buffer.set_nof_samples(sf_len);
 
-  // Always call worker_end before returning
-  common.worker_end(context, true, tx_buffer);
+  // Always call worker_end before returning, the slots without UL symbols in any carrier are not transmitted
+  common.worker_end(context, tx_enable, tx_buffer);
 
   // Tell the plotting thread to draw the plots
 #ifdef ENABLE_GUI
@@ -78,6 +78,7 @@ void phy_common::init(phy_args_t*                  _args,
 void phy_common::set_ue_dl_cfg(srsran_ue_dl_cfg_t* ue_dl_cfg)
 {
   ue_dl_cfg->snr_to_cqi_offset = args->snr_to_cqi_offset;
+  ue_dl_cfg->pmi_decimation    = args->pmi_decimation;
 
   srsran_chest_dl_cfg_t* chest_cfg = &ue_dl_cfg->chest_cfg;
 
@@ -106,6 +107,7 @@ void phy_common::set_ue_dl_cfg(srsran_ue_dl_cfg_t* ue_dl_cfg)
       args->interpolate_subframe_enabled ? SRSRAN_ESTIMATOR_ALG_INTERPOLATE : SRSRAN_ESTIMATOR_ALG_AVERAGE;
   chest_cfg->cfo_estimate_enable  = args->cfo_ref_mask != 0;
   chest_cfg->cfo_estimate_sf_mask = args->cfo_ref_mask;
+  chest_cfg->pilot_avg_len        = args->estimator_sf_avg;
 }
 
 void phy_common::set_pdsch_cfg(srsran_pdsch_cfg_t* pdsch_cfg)
@@ -835,6 +837,12 @@ void phy_common::set_dl_metrics(uint32_t cc_idx, const dl_metrics_t& m)
   dl_metrics[cc_idx].set(m);
 }
 
+void phy_common::set_dl_skipped_tb(uint32_t cc_idx, uint32_t nof_tb)
+{
+  std::unique_lock<std::mutex> lock(metrics_mutex);
+  dl_metrics[cc_idx].add_skipped_tb(nof_tb);
+}
+
 void phy_common::get_dl_metrics(dl_metrics_t::array_t& m)
 {
   std::unique_lock<std::mutex> lock(metrics_mutex);
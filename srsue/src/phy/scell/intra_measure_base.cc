@@ -34,7 +34,7 @@ intra_measure_base::intra_measure_base(srslog::basic_logger& logger, meas_itf& n
 
 intra_measure_base::~intra_measure_base()
 {
-  srsran_ringbuffer_free(&ring_buffer);
+  srsran_resampler_fft_free(&decimator);
 }
 
 void intra_measure_base::init_generic(uint32_t cc_idx_, const args_t& args)
@@ -59,20 +59,18 @@ void intra_measure_base::init_generic(uint32_t cc_idx_, const args_t& args)
     return;
   }
 
-  // Calculate the new required bytes
-  int max_required_bytes = (int)(sizeof(cf_t) * context.meas_len_ms * context.sf_len);
+  // Calculate the new required number of samples
+  size_t max_required_samples = (size_t)context.meas_len_ms * (size_t)context.sf_len;
 
-  // Reallocate only if the required capacity exceds the new requirement
-  if (ring_buffer.capacity < max_required_bytes) {
-    search_buffer.resize((size_t)context.meas_len_ms * (size_t)context.sf_len);
-
-    srsran_ringbuffer_free(&ring_buffer);
-
-    // Initialise buffer for the maximum number of PRB
-    if (srsran_ringbuffer_init(&ring_buffer, max_required_bytes) < SRSRAN_SUCCESS) {
-      ERROR("Error initiating ringbuffer");
-      return;
+  // Reallocate only if the required capacity exceds the new requirement. The decimated search samples take, at most,
+  // half of the full rate samples
+  for (meas_buffer_t& buffer : buffers) {
+    if (buffer.samples.size() < max_required_samples) {
+      buffer.samples.resize(max_required_samples);
+      buffer.search.resize(max_required_samples / 2);
     }
+    buffer.nof_samples = 0;
+    buffer.nof_search  = 0;
   }
 
   if (state.get_state() == internal_state::initial) {
@@ -89,8 +87,6 @@ void intra_measure_base::stop()
 
   // Wait for the asynchronous thread to finish
   wait_thread_finish();
-
-  srsran_ringbuffer_stop(&ring_buffer);
 }
 
 void intra_measure_base::set_rx_gain_offset(float rx_gain_offset_db_)
@@ -101,7 +97,7 @@ void intra_measure_base::set_rx_gain_offset(float rx_gain_offset_db_)
 void intra_measure_base::meas_stop()
 {
   // Transition state to idle
-  // Ring-buffer shall not be reset, it will automatically be reset as soon as the FSM transitions to receive
+  // Buffers shall not be reset, a new one will be selected as soon as the FSM transitions to receive
   state.set_state(internal_state::idle);
   Log(info, "Disabled neighbour cell search");
 }
@@ -115,29 +111,65 @@ void intra_measure_base::set_cells_to_meas(const std::set<uint32_t>& pci)
   Log(info, "Received list of %zd neighbour cells to measure", pci.size());
 }
 
+void intra_measure_base::start_receive()
+{
+  mutex.lock();
+  uint32_t ratio = context.search_decimation;
+  mutex.unlock();
+
+  // Discard any received buffer not measured yet and select a buffer not being measured
+  {
+    std::lock_guard<std::mutex> lock(buffer_mutex);
+    ready_idx = -1;
+    write_idx = (busy_idx == 0) ? 1 : 0;
+  }
+
+  // Update the cell search decimator if the ratio has changed, otherwise reset its state
+  if (ratio != decimator.ratio) {
+    srsran_resampler_fft_init(&decimator, SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+  } else if (decimator.ratio > 1) {
+    srsran_resampler_fft_reset_state(&decimator);
+  }
+
+  meas_buffer_t& buffer    = buffers[write_idx];
+  buffer.nof_samples       = 0;
+  buffer.nof_search        = 0;
+  buffer.search_decimation = SRSRAN_MAX(decimator.ratio, 1);
+}
+
 void intra_measure_base::write(cf_t* data, uint32_t nsamples)
 {
-  int nbytes = (int)(nsamples * sizeof(cf_t));
+  meas_buffer_t& buffer = buffers[write_idx];
 
   mutex.lock();
-  int required_nbytes = ((int)context.meas_len_ms * (int)context.sf_len * (int)sizeof(cf_t));
+  uint32_t required_nsamples = context.meas_len_ms * context.sf_len;
   mutex.unlock();
 
-  // As nbytes might not match the sub-frame size, make sure that buffer does not overflow
-  nbytes = SRSRAN_MIN(srsran_ringbuffer_space(&ring_buffer), nbytes);
+  // The required number of samples cannot exceed the buffer capacity
+  required_nsamples = SRSRAN_MIN(required_nsamples, (uint32_t)buffer.samples.size());
 
-  // Try writing in the buffer
-  if (srsran_ringbuffer_write(&ring_buffer, data, nbytes) < nbytes) {
-    Log(warning, "Error writing to ringbuffer");
+  // As nsamples might not match the sub-frame size, make sure that buffer does not overflow
+  nsamples = SRSRAN_MIN(nsamples, required_nsamples - SRSRAN_MIN(buffer.nof_samples, required_nsamples));
+  srsran_vec_cf_copy(&buffer.samples[buffer.nof_samples], data, nsamples);
+  buffer.nof_samples += nsamples;
 
-    // Transition to wait, so it can keep receiving without stopping the component operation
-    state.set_state(internal_state::wait);
-  } else {
-    // As soon as there are enough samples in the buffer, transition to measure
-    if (srsran_ringbuffer_status(&ring_buffer) >= required_nbytes) {
-      Log(debug, "Starting search and measurements");
-      state.set_state(internal_state::measure);
+  // Filter and decimate the samples for the cell search as they are received
+  if (buffer.search_decimation > 1) {
+    uint32_t nof_search = nsamples / buffer.search_decimation;
+    if (buffer.nof_search + nof_search <= (uint32_t)buffer.search.size()) {
+      srsran_resampler_fft_run(&decimator, data, &buffer.search[buffer.nof_search], nsamples);
+      buffer.nof_search += nof_search;
+    }
+  }
+
+  // As soon as there are enough samples in the buffer, transition to measure
+  if (buffer.nof_samples >= required_nsamples) {
+    {
+      std::lock_guard<std::mutex> lock(buffer_mutex);
+      ready_idx = (int)write_idx;
     }
+    Log(debug, "Starting search and measurements");
+    state.set_state(internal_state::measure);
   }
 }
 
@@ -158,7 +190,7 @@ void intra_measure_base::run_tti(uint32_t tti, cf_t* data, uint32_t nsamples)
       if (receive_tti_trigger(tti)) {
         state.set_state(internal_state::receive);
         last_measure_tti = tti;
-        srsran_ringbuffer_reset(&ring_buffer);
+        start_receive();
 
         // Write baseband to ensure measurement starts in the right TTI
         Log(debug, "Start writing");
@@ -177,28 +209,34 @@ void intra_measure_base::measure_proc()
   // Grab a copy of the context and pass it to the measure_rat method.
   measure_context_t context_copy = get_context();
 
-  // Read data from buffer and find cells in it
-  int ret = srsran_ringbuffer_read_timed(&ring_buffer,
-                                         search_buffer.data(),
-                                         ((int)context_copy.meas_len_ms * (int)context_copy.sf_len * (int)sizeof(cf_t)),
-                                         1000);
-
-  // As this function is called once the ring-buffer has enough data to process, it is not expected to fail
-  if (ret < SRSRAN_SUCCESS) {
-    Log(error, "Ringbuffer read returned %d", ret);
-    return;
+  // Take the received buffer, it is measured in place while the next window is received in the other buffer
+  int idx = -1;
+  {
+    std::lock_guard<std::mutex> lock(buffer_mutex);
+    idx       = ready_idx;
+    busy_idx  = ready_idx;
+    ready_idx = -1;
   }
 
   // Go to receive before finishing, so new samples can be enqueued before the thread finishes
   if (state.get_state() == internal_state::measure) {
-    // Prevents transition to wait if state has changed while reading the ring-buffer
+    // Prevents transition to wait if state has changed while taking the buffer
     state.set_state(internal_state::wait);
   }
 
+  // The received buffer has been discarded by a new measurement window
+  if (idx < 0) {
+    return;
+  }
+
   // Perform measurements for the actual RAT
-  if (not measure_rat(std::move(context_copy), search_buffer, rx_gain_offset_db)) {
+  if (not measure_rat(std::move(context_copy), buffers[idx], rx_gain_offset_db)) {
     Log(error, "Error measuring RAT");
   }
+
+  // Release the buffer
+  std::lock_guard<std::mutex> lock(buffer_mutex);
+  busy_idx = -1;
 }
 
 void intra_measure_base::run_thread()
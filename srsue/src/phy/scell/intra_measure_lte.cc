@@ -57,9 +57,18 @@ void intra_measure_lte::set_primary_cell(uint32_t earfcn, srsran_cell_t cell)
   }
   current_earfcn = earfcn;
   set_current_sf_len((uint32_t)SRSRAN_SF_LEN_PRB(cell.nof_prb));
+
+  // Search cells at the rate of the central PRB carrying the PSS/SSS, the refinement stays at the full rate
+  uint32_t symbol_sz        = (uint32_t)srsran_symbol_sz(cell.nof_prb);
+  uint32_t search_symbol_sz = (uint32_t)srsran_symbol_sz(SRSRAN_CS_NOF_PRB);
+  if (symbol_sz % search_symbol_sz == 0) {
+    set_search_decimation(symbol_sz / search_symbol_sz);
+  } else {
+    set_search_decimation(1);
+  }
 }
 
-bool intra_measure_lte::measure_rat(const measure_context_t& context, std::vector<cf_t>& buffer, float rx_gain_offset)
+bool intra_measure_lte::measure_rat(const measure_context_t& context, meas_buffer_t& buffer, float rx_gain_offset)
 {
   std::set<uint32_t> cells_to_measure = context.active_pci;
 
@@ -69,8 +78,14 @@ bool intra_measure_lte::measure_rat(const measure_context_t& context, std::vecto
     serving_cell_copy = serving_cell;
   }
 
-  // Detect new cells using PSS/SSS
-  scell_rx.find_cells(buffer.data(), serving_cell_copy, context.meas_len_ms, cells_to_measure);
+  // Detect new cells using PSS/SSS. They are in the central PRB, so the search runs on the decimated samples if available
+  if (buffer.search_decimation > 1 and buffer.nof_search * buffer.search_decimation == buffer.nof_samples) {
+    srsran_cell_t search_cell = serving_cell_copy;
+    search_cell.nof_prb       = SRSRAN_CS_NOF_PRB;
+    scell_rx.find_cells(buffer.search.data(), search_cell, context.meas_len_ms, cells_to_measure);
+  } else {
+    scell_rx.find_cells(buffer.samples.data(), serving_cell_copy, context.meas_len_ms, cells_to_measure);
+  }
 
   // Initialise empty neighbour cell list
   std::vector<phy_meas_t> neighbour_cells = {};
@@ -91,7 +106,7 @@ bool intra_measure_lte::measure_rat(const measure_context_t& context, std::vecto
       return false;
     }
 
-    if (srsran_refsignal_dl_sync_run(&refsignal_dl_sync, buffer.data(), context.meas_len_ms * context.sf_len) <
+    if (srsran_refsignal_dl_sync_run(&refsignal_dl_sync, buffer.samples.data(), context.meas_len_ms * context.sf_len) <
         SRSRAN_SUCCESS) {
       Log(error, "Error running refsignal DL measurements");
       return false;
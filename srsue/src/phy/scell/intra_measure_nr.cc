@@ -90,14 +90,15 @@ bool intra_measure_nr::set_config(const config_t& cfg)
   return true;
 }
 
-bool intra_measure_nr::measure_rat(const measure_context_t& context, std::vector<cf_t>& buffer, float rx_gain_offset)
+bool intra_measure_nr::measure_rat(const measure_context_t& context, meas_buffer_t& buffer, float rx_gain_offset)
 {
   std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
 
   // Search and measure the best cell
   srsran_csi_trs_measurements_t meas = {};
   uint32_t                      N_id = 0;
-  if (srsran_ssb_csi_search(&ssb, buffer.data(), context.sf_len * context.meas_len_ms, &N_id, &meas) < SRSRAN_SUCCESS) {
+  if (srsran_ssb_csi_search(&ssb, buffer.samples.data(), context.sf_len * context.meas_len_ms, &N_id, &meas) <
+      SRSRAN_SUCCESS) {
     Log(error, "Error searching for SSB");
     return false;
   }
@@ -125,7 +125,22 @@ search::ret_code search::run(srsran_cell_t* cell_, std::array<uint8_t, SRSRAN_BC
     ret           = srsran_ue_cellsearch_scan_N_id_2(&cs, force_N_id_2, &found_cells[force_N_id_2]);
     max_peak_cell = force_N_id_2;
   } else {
-    ret = srsran_ue_cellsearch_scan(&cs, found_cells, &max_peak_cell);
+    // Probe the PSS of the known cell first, scan the three of them if it is not found
+    if (pci_hint >= 0) {
+      uint32_t N_id_2 = (uint32_t)pci_hint % SRSRAN_NOF_NID_2;
+      ret             = srsran_ue_cellsearch_scan_N_id_2(&cs, N_id_2, &found_cells[N_id_2]);
+      if (ret > 0 and found_cells[N_id_2].cell_id == (uint32_t)pci_hint) {
+        Info("SYNC:  Found known cell PCI=%d", pci_hint);
+        max_peak_cell = N_id_2;
+      } else if (ret >= 0) {
+        Info("SYNC:  Known cell PCI=%d not found, scanning all PSS", pci_hint);
+        bzero(found_cells, 3 * sizeof(srsran_ue_cellsearch_result_t));
+        ret = 0;
+      }
+    }
+    if (ret == 0) {
+      ret = srsran_ue_cellsearch_scan(&cs, found_cells, &max_peak_cell);
+    }
   }
 
   if (ret < 0) {
@@ -93,6 +93,7 @@ void sync::init(srsran::radio_interface_phy* _radio,
   // Initialize cell searcher
   search_p.init(sf_buffer, nof_rf_channels, this, worker_com->args->force_N_id_2, worker_com->args->force_N_id_1);
   search_p.set_cp_en(worker_com->args->detect_cp);
+  known_cells.init(worker_com->args->cell_cache_file);
   // Initialize SFN synchronizer, it uses only pcell buffer
   sfn_p.init(&ue_sync, worker_com->args, sf_buffer, sf_buffer.size());
 
@@ -245,7 +246,20 @@ rrc_interface_phy_lte::cell_search_ret_t sync::cell_search_start(phy_cell_t* fou
     Info("SYNC:  Setting Cell Search sampling rate");
   }
 
-  if (earfcn < 0) {
+  // Start every round over the EARFCN set in the last camped cell, if it is in the set. Its EARFCN is searched again
+  // in its turn
+  bool                       probe_known_cell = false;
+  const cell_cache::entry_t* last_cell        = known_cells.last();
+  if (earfcn < 0 and cellsearch_earfcn_index == 0 and not known_cell_probed and last_cell != nullptr) {
+    const std::vector<uint32_t>& earfcn_list = worker_com->args->dl_earfcn_list;
+    probe_known_cell = std::find(earfcn_list.begin(), earfcn_list.end(), last_cell->earfcn) != earfcn_list.end();
+  }
+
+  if (probe_known_cell) {
+    known_cell_probed = true;
+    current_earfcn    = (int)last_cell->earfcn;
+    Info("Cell Search: probing last camped cell EARFCN=%d PCI=%d", current_earfcn, last_cell->pci);
+  } else if (earfcn < 0) {
     try {
       if (current_earfcn != (int)worker_com->args->dl_earfcn_list.at(cellsearch_earfcn_index)) {
         current_earfcn = (int)worker_com->args->dl_earfcn_list[cellsearch_earfcn_index];
@@ -260,6 +274,10 @@ rrc_interface_phy_lte::cell_search_ret_t sync::cell_search_start(phy_cell_t* fou
   Info("Cell Search: changing frequency to EARFCN=%d", current_earfcn);
   set_frequency();
 
+  // Look for the PSS of the cell known in this EARFCN before scanning all of them
+  const cell_cache::entry_t* known_cell = known_cells.find((uint32_t)current_earfcn);
+  search_p.set_pci_hint(known_cell != nullptr ? (int)known_cell->pci : -1);
+
   // Move to CELL SEARCH and wait to finish
   Info("Cell Search: Setting Cell search state");
   phy_state.run_cell_search();
@@ -285,10 +303,18 @@ rrc_interface_phy_lte::cell_search_ret_t sync::cell_search_start(phy_cell_t* fou
       break;
   }
 
+  // The probe does not advance in the EARFCN set
+  if (probe_known_cell) {
+    ret.last_freq  = rrc_interface_phy_lte::cell_search_ret_t::MORE_FREQS;
+    rrc_proc_state = PROC_IDLE;
+    return ret;
+  }
+
   cellsearch_earfcn_index++;
   if (cellsearch_earfcn_index >= worker_com->args->dl_earfcn_list.size() or earfcn < 0) {
     Info("Cell Search: No more frequencies in the current EARFCN set");
     cellsearch_earfcn_index = 0;
+    known_cell_probed       = false;
     ret.last_freq           = rrc_interface_phy_lte::cell_search_ret_t::NO_MORE_FREQS;
   } else {
     ret.last_freq = rrc_interface_phy_lte::cell_search_ret_t::MORE_FREQS;
@@ -385,6 +411,8 @@ bool sync::cell_select_start(phy_cell_t new_cell)
   if (phy_state.is_camping()) {
     Info("Cell Select: SFN synchronized. CAMPING...");
     stack->in_sync();
+    known_cells.add((uint32_t)current_earfcn, cell.get().id);
+    known_cell_probed = false;
     ret = true;
   } else {
     Info("Cell Select: Could not synchronize SFN");
@@ -839,6 +867,9 @@ void sync::set_ue_sync_opts(srsran_ue_sync_t* q, float cfo_)
   srsran_ue_sync_set_sfo_correct_period(q, worker_com->args->sfo_correct_period);
   srsran_ue_sync_set_sfo_ema(q, worker_com->args->sfo_ema);
 
+  // Set adaptive PSS tracking period
+  srsran_ue_sync_set_track_period(q, worker_com->args->pss_track_period);
+
   sss_alg_t sss_alg = SSS_FULL;
   if (!worker_com->args->sss_algorithm.compare("diff")) {
     sss_alg = SSS_DIFF;
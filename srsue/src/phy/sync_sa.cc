@@ -21,6 +21,7 @@
 
 #include "srsue/hdr/phy/nr/sync_sa.h"
 #include "srsran/radio/rf_buffer.h"
+#include <thread>
 
 namespace srsue {
 namespace nr {
@@ -33,6 +34,12 @@ sync_sa::~sync_sa()
   if (rx_buffer != nullptr) {
     free(rx_buffer);
   }
+
+  for (rx_slot_t& slot : rx_slots) {
+    if (slot.buffer != nullptr) {
+      free(slot.buffer);
+    }
+  }
 }
 
 bool sync_sa::init(const args_t& args, stack_interface_phy_nr* stack_, srsran::radio_interface_phy* radio_)
@@ -68,9 +75,28 @@ bool sync_sa::init(const args_t& args, stack_interface_phy_nr* stack_, srsran::r
     return false;
   }
 
+  // Allocate the Rx queue slots, the camping state receives into them instead of into the worker buffers
+  if (args.rx_queue_size > 0) {
+    rx_slots.resize(args.rx_queue_size);
+    rx_free_slots.set_size(args.rx_queue_size);
+    rx_pending.set_size(args.rx_queue_size);
+    for (rx_slot_t& slot : rx_slots) {
+      slot.buffer = srsran_vec_cf_malloc(slot_sz);
+      if (slot.buffer == nullptr) {
+        logger.error("Error allocating Rx queue buffer");
+        return false;
+      }
+      rx_free_slots.try_push(&slot);
+    }
+    dispatch_thread.reset(new dispatch_worker(*this));
+  }
+
   // Thread control
   running = true;
   start(args.thread_priority);
+  if (dispatch_thread != nullptr) {
+    dispatch_thread->start(args.thread_priority);
+  }
 
   // If reached here it was successful
   return true;
@@ -79,6 +105,14 @@ bool sync_sa::init(const args_t& args, stack_interface_phy_nr* stack_, srsran::r
 void sync_sa::stop()
 {
   running = false;
+
+  // The queued slots are discarded
+  if (dispatch_thread != nullptr) {
+    rx_free_slots.stop();
+    rx_pending.stop();
+    dispatch_thread->wait_thread_finish();
+  }
+
   wait_thread_finish();
   radio->reset();
 }
@@ -123,6 +157,11 @@ bool sync_sa::wait_idle()
   // Reset UE sync. Attention: doing this reset when the FSM is NOT IDLE can cause PSS/SSS out-of-sync
   //...
 
+  // Wait for the dispatch thread to hand the queued slots to the workers
+  while (rx_nof_inflight > 0 and running) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+
   // Wait for workers to finish PHY processing
   tti_semaphore.wait_all();
 
@@ -295,6 +334,12 @@ void sync_sa::run_state_sfn_sync()
 
 void sync_sa::run_state_cell_camping()
 {
+  // Leave the worker handling to the dispatch thread if the Rx queue is enabled
+  if (dispatch_thread != nullptr) {
+    run_state_cell_camping_queued();
+    return;
+  }
+
   nr::sf_worker* nr_worker = workers.wait_worker(tti);
   if (nr_worker == nullptr) {
     running = false;
@@ -330,6 +375,84 @@ void sync_sa::run_state_cell_camping()
   tti = TTI_ADD(tti, 1);
 }
 
+void sync_sa::run_state_cell_camping_queued()
+{
+  // Never wait for a free slot, if the workers are not keeping up the samples are still tracked but not processed
+  rx_slot_t* slot   = nullptr;
+  cf_t*      buffer = rx_free_slots.try_pop(slot) ? slot->buffer : rx_buffer;
+
+  // Receive samples and track the SSB
+  srsran::rf_buffer_t rf_buffer = {};
+  rf_buffer.set_nof_samples(slot_sz);
+  rf_buffer.set(0, buffer);
+  if (not slot_synchronizer.run_camping(rf_buffer, last_rx_time)) {
+    logger.error("SYNC: detected out-of-sync... skipping slot ...");
+    is_pending_tx_end = true;
+    if (slot != nullptr) {
+      rx_free_slots.try_push(slot);
+    }
+    return;
+  }
+
+  if (slot == nullptr) {
+    logger.info("SYNC: Rx queue full, dropping slot");
+    is_pending_tx_end = true;
+    tti               = TTI_ADD(tti, 1);
+    return;
+  }
+
+  slot->tti = tti;
+  last_rx_time.add(FDD_HARQ_DELAY_DL_MS * 1e-3);
+  slot->tx_time.copy(last_rx_time);
+  // Apply current TA
+  slot->tx_time.sub((double)ta.get_sec());
+
+  // There are as many pending places as slots, it only fails if the queue is stopped
+  rx_nof_inflight++;
+  if (not rx_pending.try_push(slot)) {
+    rx_nof_inflight--;
+    rx_free_slots.try_push(slot);
+  }
+
+  tti = TTI_ADD(tti, 1);
+}
+
+void sync_sa::run_dispatch()
+{
+  while (running.load(std::memory_order_relaxed)) {
+    bool       success = false;
+    rx_slot_t* slot    = rx_pending.pop_blocking(&success);
+    if (not success) {
+      break;
+    }
+
+    nr::sf_worker* nr_worker = workers.wait_worker(slot->tti);
+    if (nr_worker == nullptr) {
+      rx_nof_inflight--;
+      running = false;
+      break;
+    }
+
+    // The slot goes back to the reception as soon as the samples are in the worker
+    srsran_vec_cf_copy(nr_worker->get_buffer(0, 0), slot->buffer, slot_sz);
+
+    srsran::phy_common_interface::worker_context_t context;
+    context.sf_idx     = slot->tti;
+    context.worker_ptr = nr_worker;
+    context.last       = true; // Set last if standalone
+    context.tx_time.copy(slot->tx_time);
+
+    nr_worker->set_context(context);
+    rx_free_slots.try_push(slot);
+
+    // The slots are dispatched in reception order, so the transmissions keep the TTI order
+    tti_semaphore.push(nr_worker);
+    workers.start_worker(nr_worker);
+
+    rx_nof_inflight--;
+  }
+}
+
 void sync_sa::run_thread()
 {
   while (running.load(std::memory_order_relaxed)) {
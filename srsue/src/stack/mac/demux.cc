@@ -20,6 +20,7 @@
  */
 
 #include "srsue/hdr/stack/mac/demux.h"
+#include "srsran/common/common_lte.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/interfaces/ue_phy_interfaces.h"
@@ -130,7 +131,11 @@ void demux::push_pdu_temp_crnti(uint8_t* buff, uint32_t nof_bytes)
 void demux::push_pdu(uint8_t* buff, uint32_t nof_bytes, uint32_t tti)
 {
   // Process Real-Time PDUs
-  process_sch_pdu_rt(buff, nof_bytes, tti);
+  if (not process_sch_pdu_rt(buff, nof_bytes, tti)) {
+    // Nothing left for the stack thread
+    pdus.deallocate(buff);
+    return;
+  }
 
   return pdus.push(buff, nof_bytes, srsran::pdu_queue::DCH);
 }
@@ -164,7 +169,7 @@ void demux::process_pdu(uint8_t* mac_pdu, uint32_t nof_bytes, srsran::pdu_queue:
       // Unpack DLSCH MAC PDU
       mac_msg.init_rx(nof_bytes);
       mac_msg.parse_packet(mac_pdu);
-      {
+      if (logger.info.enabled()) {
         fmt::memory_buffer buffer;
         mac_msg.to_string(buffer);
         Info("%s", srsran::to_c_str(buffer));
@@ -185,16 +190,26 @@ void demux::process_pdu(uint8_t* mac_pdu, uint32_t nof_bytes, srsran::pdu_queue:
   }
 }
 
-void demux::process_sch_pdu_rt(uint8_t* buff, uint32_t nof_bytes, uint32_t tti)
+/* Processes the MAC CEs and, with the data fast path, the SDUs of the DRBs.
+ * Returns true if the PDU still has to be processed by the stack thread.
+ */
+bool demux::process_sch_pdu_rt(uint8_t* buff, uint32_t nof_bytes, uint32_t tti)
 {
   srsran::sch_pdu mac_msg_rt(20, logger);
+  bool            fast_path    = data_fast_path.load(std::memory_order_relaxed);
+  bool            pending_sdus = false;
 
   mac_msg_rt.init_rx(nof_bytes);
   mac_msg_rt.parse_packet(buff);
 
   while (mac_msg_rt.next()) {
     if (mac_msg_rt.get()->is_sdu()) {
-      // Ignore SDU
+      if (fast_path and srsran::is_lte_drb(mac_msg_rt.get()->get_sdu_lcid())) {
+        route_sdu(mac_msg_rt.get(), true);
+      } else {
+        // SDUs of the SRBs are handled by the stack thread
+        pending_sdus = true;
+      }
     } else {
       // Process MAC Control Element
       if (!process_ce(mac_msg_rt.get(), tti)) {
@@ -202,12 +217,25 @@ void demux::process_sch_pdu_rt(uint8_t* buff, uint32_t nof_bytes, uint32_t tti)
       }
     }
   }
+
+  if (fast_path and not pending_sdus and logger.info.enabled()) {
+    // the stack thread will not see this PDU
+    fmt::memory_buffer buffer;
+    mac_msg_rt.to_string(buffer);
+    Info("%s", srsran::to_c_str(buffer));
+  }
+  return pending_sdus or not fast_path;
 }
 
 void demux::process_sch_pdu(srsran::sch_pdu* pdu_msg)
 {
+  bool fast_path = data_fast_path.load(std::memory_order_relaxed);
   while (pdu_msg->next()) {
     if (pdu_msg->get()->is_sdu()) {
+      if (fast_path and srsran::is_lte_drb(pdu_msg->get()->get_sdu_lcid())) {
+        // already delivered by process_sch_pdu_rt()
+        continue;
+      }
       bool route_pdu = true;
       if (pdu_msg->get()->get_sdu_lcid() == 0) {
         uint8_t* x   = pdu_msg->get()->get_sdu_ptr();
@@ -222,25 +250,32 @@ void demux::process_sch_pdu(srsran::sch_pdu* pdu_msg)
       }
       // Route logical channel
       if (route_pdu) {
-        Debug(
-            "Delivering PDU for lcid=%d, %d bytes", pdu_msg->get()->get_sdu_lcid(), pdu_msg->get()->get_payload_size());
-        if (pdu_msg->get()->get_payload_size() < MAX_PDU_LEN) {
-          rlc->write_pdu(
-              pdu_msg->get()->get_sdu_lcid(), pdu_msg->get()->get_sdu_ptr(), pdu_msg->get()->get_payload_size());
-        } else {
-          char tmp[1024];
-          srsran_vec_sprint_hex(tmp, sizeof(tmp), pdu_msg->get()->get_sdu_ptr(), 32);
-          Error("PDU size %d exceeds maximum PDU buffer size, lcid=%d, hex=[%s]",
-                pdu_msg->get()->get_payload_size(),
-                pdu_msg->get()->get_sdu_lcid(),
-                tmp);
-        }
+        route_sdu(pdu_msg->get(), false);
       }
     } else {
       // Ignore MAC Control Element
     }
   }
 }
+
+void demux::route_sdu(srsran::sch_subh* subh, bool from_phy_worker)
+{
+  Debug("Delivering PDU for lcid=%d, %d bytes", subh->get_sdu_lcid(), subh->get_payload_size());
+  if (subh->get_payload_size() < MAX_PDU_LEN) {
+    if (from_phy_worker) {
+      rlc->write_pdu_locked(subh->get_sdu_lcid(), subh->get_sdu_ptr(), subh->get_payload_size());
+    } else {
+      rlc->write_pdu(subh->get_sdu_lcid(), subh->get_sdu_ptr(), subh->get_payload_size());
+    }
+  } else {
+    char tmp[1024];
+    srsran_vec_sprint_hex(tmp, sizeof(tmp), subh->get_sdu_ptr(), 32);
+    Error("PDU size %d exceeds maximum PDU buffer size, lcid=%d, hex=[%s]",
+          subh->get_payload_size(),
+          subh->get_sdu_lcid(),
+          tmp);
+  }
+}
 void demux::process_mch_pdu(srsran::mch_pdu* mch_msg)
 {
   // disgarding headers that have already been processed
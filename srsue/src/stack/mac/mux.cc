@@ -217,7 +217,9 @@ uint8_t* mux::pdu_get_nolock(srsran::byte_buffer_t* payload, uint32_t pdu_sz)
 
   for (auto& channel : logical_channels) {
     if (channel.sched_len != 0) {
-      uint32_t sdu_len = allocate_sdu(channel.lcid, &pdu_msg, channel.sched_len);
+      // reuse the buffer state read at the start of the LCP instead of querying RLC again for the first SDU
+      int      buffer_state = channel.buffer_len + channel.sched_len;
+      uint32_t sdu_len      = allocate_sdu(channel.lcid, &pdu_msg, channel.sched_len, buffer_state);
 
       // update BSR according to allocation (may be smaller than sched_len)
       bsr.buff_size[channel.lcg] -= sdu_len;
@@ -242,10 +244,12 @@ uint8_t* mux::pdu_get_nolock(srsran::byte_buffer_t* payload, uint32_t pdu_sz)
   bsr_procedure->update_bsr_tti_end(&bsr);
 
   // Generate MAC PDU and save to buffer
-  uint8_t*           ret = pdu_msg.write_packet(logger);
-  fmt::memory_buffer buffer;
-  pdu_msg.to_string(buffer);
-  Info("%s", srsran::to_c_str(buffer));
+  uint8_t* ret = pdu_msg.write_packet(logger);
+  if (logger.info.enabled()) {
+    fmt::memory_buffer buffer;
+    pdu_msg.to_string(buffer);
+    Info("%s", srsran::to_c_str(buffer));
+  }
   Debug("Assembled MAC PDU msg size %d/%d bytes", pdu_msg.get_pdu_len() - pdu_msg.rem_size(), pdu_sz);
 
   return ret;
@@ -282,11 +286,13 @@ bool mux::sched_sdu(logical_channel_config_t* ch, int* sdu_space, int max_sdu_sz
   return false;
 }
 
-uint32_t mux::allocate_sdu(uint32_t lcid, srsran::sch_pdu* pdu_msg, int max_sdu_sz)
+uint32_t mux::allocate_sdu(uint32_t lcid, srsran::sch_pdu* pdu_msg, int max_sdu_sz, int buffer_state)
 {
   uint32_t total_sdu_len = 0;
   int32_t  sdu_space     = max_sdu_sz;
-  int32_t  buffer_state  = rlc->get_buffer_state(lcid);
+  if (buffer_state < 0) {
+    buffer_state = rlc->get_buffer_state(lcid);
+  }
 
   while (buffer_state > 0 && sdu_space > 0) { // there is pending SDU to allocate
     int requested_sdu_len = SRSRAN_MIN(buffer_state, sdu_space);
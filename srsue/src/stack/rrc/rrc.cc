@@ -423,6 +423,7 @@ void rrc::process_new_cell_meas_nr(const std::vector<phy_meas_nr_t>& meas)
   logger.debug("MEAS:  Processing measurement of %zd cells", meas.size());
 
   bool neighbour_added = meas_cells_nr.process_new_cell_meas(meas_lte, filter);
+  measurements->cell_meas_updated(srsran::srsran_rat_t::nr);
 }
 
 void rrc::nr_rrc_con_reconfig_complete(bool status)
@@ -464,6 +465,7 @@ void rrc::process_new_cell_meas(const std::vector<phy_meas_t>& meas)
   logger.debug("MEAS:  Processing measurement of %zd cells", meas.size());
 
   bool neighbour_added = meas_cells.process_new_cell_meas(meas, filter);
+  measurements->cell_meas_updated(srsran::srsran_rat_t::lte);
 
   // Instruct measurements subclass to update phy with new cells to measure based on strongest neighbours
   // Avoid updating PHY while HO procedure is busy
@@ -138,6 +138,12 @@ void rrc::rrc_meas::run_tti()
   meas_cfg.report_triggers();
 }
 
+void rrc::rrc_meas::cell_meas_updated(srsran::srsran_rat_t rat)
+{
+  std::lock_guard<std::mutex> lock(meas_cfg_mutex);
+  meas_cfg.cell_meas_updated(rat);
+}
+
 // For thresholds, the actual value is (field value – 156) dBm, except for field value 127, in which case the actual
 // value is infinity.
 float rrc::rrc_meas::range_to_value_nr(const asn1::rrc::thres_nr_r15_c::types_opts::options type, const uint8_t range)
@@ -533,12 +539,12 @@ void rrc::rrc_meas::var_meas_cfg::report_triggers_eutra_check_new(int32_t
   bool             new_cell_trigger     = false;
   cell_triggered_t cells_triggered_list = meas_report->get_measId_cells(meas_id);
   for (auto& cell : trigger_state[meas_id]) {
-    if (cell.second.is_enter_equal(report_cfg.trigger_type.event().time_to_trigger.to_number())) {
+    if (cell.is_enter_equal(report_cfg.trigger_type.event().time_to_trigger.to_number())) {
       // Do not add if already exists
       if (std::find_if(cells_triggered_list.begin(), cells_triggered_list.end(), [&cell](const phy_cell_t& c) {
-            return cell.first == c.pci;
+            return cell.get_pci() == c.pci;
           }) == cells_triggered_list.end()) {
-        cells_triggered_list.push_back({cell.first, meas_obj.carrier_freq});
+        cells_triggered_list.push_back({cell.get_pci(), meas_obj.carrier_freq});
         new_cell_trigger = true;
       }
     }
@@ -562,7 +568,8 @@ void rrc::rrc_meas::var_meas_cfg::report_triggers_eutra_check_leaving(int32_t me
   // remove the concerned cell(s) in the cellsTriggeredList defined within the VarMeasReportList
   auto it = cells_triggered_list.begin();
   while (it != cells_triggered_list.end()) {
-    if (trigger_state[meas_id][it->pci].is_exit_equal(report_cfg.trigger_type.event().time_to_trigger.to_number())) {
+    cell_trigger_state* cell = find_trigger_state(trigger_state[meas_id], it->pci);
+    if (cell != nullptr && cell->is_exit_equal(report_cfg.trigger_type.event().time_to_trigger.to_number())) {
       it = cells_triggered_list.erase(it);
       meas_report->upd_measId(meas_id, cells_triggered_list);
 
@@ -630,12 +637,12 @@ void rrc::rrc_meas::var_meas_cfg::report_triggers_interrat_check_new(int32_t
   bool             new_cell_trigger     = false;
   cell_triggered_t cells_triggered_list = meas_report->get_measId_cells(meas_id);
   for (auto& cell : trigger_state_nr[meas_id]) {
-    if (cell.second.is_enter_equal(report_cfg.trigger_type.event().time_to_trigger.to_number())) {
+    if (cell.is_enter_equal(report_cfg.trigger_type.event().time_to_trigger.to_number())) {
       // Do not add if already exists
       if (std::find_if(cells_triggered_list.begin(), cells_triggered_list.end(), [&cell](const phy_cell_t& c) {
-            return cell.first == c.pci;
+            return cell.get_pci() == c.pci;
           }) == cells_triggered_list.end()) {
-        cells_triggered_list.push_back({cell.first, meas_obj.carrier_freq_r15});
+        cells_triggered_list.push_back({cell.get_pci(), meas_obj.carrier_freq_r15});
         new_cell_trigger = true;
       }
     }
@@ -659,7 +666,8 @@ void rrc::rrc_meas::var_meas_cfg::report_triggers_interrat_check_leaving(int32_t
   // remove the concerned cell(s) in the cellsTriggeredList defined within the VarMeasReportList
   auto it = cells_triggered_list.begin();
   while (it != cells_triggered_list.end()) {
-    if (trigger_state_nr[meas_id][it->pci].is_exit_equal(report_cfg.trigger_type.event().time_to_trigger.to_number())) {
+    cell_trigger_state* cell = find_trigger_state(trigger_state_nr[meas_id], it->pci);
+    if (cell != nullptr && cell->is_exit_equal(report_cfg.trigger_type.event().time_to_trigger.to_number())) {
       it = cells_triggered_list.erase(it);
       meas_report->upd_measId(meas_id, cells_triggered_list);
 
@@ -772,8 +780,12 @@ void rrc::rrc_meas::var_meas_cfg::eval_triggers_eutra(uint32_t            meas_i
       return quant_rsrq;
     }
   };
+  auto thres_value = [&report_cfg, &asn1_quant_convert](const thres_eutra_c& thres) {
+    uint8_t range = (thres.type() == thres_eutra_c::types::thres_rsrp) ? thres.thres_rsrp() : thres.thres_rsrq();
+    return rrc_range_to_value(asn1_quant_convert(report_cfg.trigger_quant.value), range);
+  };
 
-  eutra_event_s::event_id_c_ event_id = report_cfg.trigger_type.event().event_id;
+  const eutra_event_s::event_id_c_& event_id = report_cfg.trigger_type.event().event_id;
 
   // For A1/A2 events, get serving cell from current carrier
   if (event_id.type().value < eutra_event_s::event_id_c_::types::event_a3 &&
@@ -799,34 +811,26 @@ void rrc::rrc_meas::var_meas_cfg::eval_triggers_eutra(uint32_t            meas_i
   }
 
   if (report_cfg.trigger_type.type() == report_cfg_eutra_s::trigger_type_c_::types::event) {
+    uint32_t             ttt   = report_cfg.trigger_type.event().time_to_trigger.to_number();
+    cell_trigger_list_t& cells = trigger_state[meas_id];
+    begin_trigger_eval(cells);
+
     // A1 & A2 are for serving cell only
     if (event_id.type().value < eutra_event_s::event_id_c_::types::event_a3) {
       float thresh          = 0.0;
       bool  enter_condition = false;
       bool  exit_condition  = false;
       if (event_id.type() == eutra_event_s::event_id_c_::types::event_a1) {
-        if (event_id.event_a1().a1_thres.type().value == thres_eutra_c::types::thres_rsrp) {
-          thresh = rrc_range_to_value(asn1_quant_convert(report_cfg.trigger_quant),
-                                      event_id.event_a1().a1_thres.thres_rsrp());
-        } else {
-          thresh = rrc_range_to_value(asn1_quant_convert(report_cfg.trigger_quant),
-                                      event_id.event_a1().a1_thres.thres_rsrq());
-        }
+        thresh          = thres_value(event_id.event_a1().a1_thres);
         enter_condition = Ms - hyst > thresh;
         exit_condition  = Ms + hyst < thresh;
       } else {
-        if (event_id.event_a2().a2_thres.type() == thres_eutra_c::types::thres_rsrp) {
-          thresh = rrc_range_to_value(asn1_quant_convert(report_cfg.trigger_quant),
-                                      event_id.event_a2().a2_thres.thres_rsrp());
-        } else {
-          thresh = rrc_range_to_value(asn1_quant_convert(report_cfg.trigger_quant),
-                                      event_id.event_a2().a2_thres.thres_rsrq());
-        }
+        thresh          = thres_value(event_id.event_a2().a2_thres);
         enter_condition = Ms + hyst < thresh;
         exit_condition  = Ms - hyst > thresh;
       }
 
-      trigger_state[meas_id][serv_cell->get_pci()].event_condition(enter_condition, exit_condition);
+      get_trigger_state(cells, serv_cell->get_pci()).event_condition(enter_condition, exit_condition, ttt);
 
       logger.debug("MEAS:  eventId=%s, Ms=%.2f, hyst=%.2f, Thresh=%.2f, enter_condition=%d, exit_condition=%d",
                    event_id.type().to_string(),
@@ -838,76 +842,72 @@ void rrc::rrc_meas::var_meas_cfg::eval_triggers_eutra(uint32_t            meas_i
 
       // Rest are evaluated for every cell in frequency
     } else {
-      auto cells = rrc_ptr->get_cells(meas_obj.carrier_freq);
-      for (auto& pci : cells) {
-        logger.debug("MEAS:  eventId=%s, pci=%d, earfcn=%d", event_id.type().to_string(), pci, meas_obj.carrier_freq);
-        float Ofn = offset_val(meas_obj);
-        float Ocn = 0;
+      // The event parameters are the same for all the cells of the frequency
+      float  Ofn    = offset_val(meas_obj);
+      double Off    = 0;
+      float  thresh = 0, th1 = 0;
+      switch (event_id.type().value) {
+        case eutra_event_s::event_id_c_::types::event_a3:
+          Off = 0.5 * event_id.event_a3().a3_offset;
+          break;
+        case eutra_event_s::event_id_c_::types::event_a4:
+          thresh = thres_value(event_id.event_a4().a4_thres);
+          break;
+        case eutra_event_s::event_id_c_::types::event_a5:
+          th1    = thres_value(event_id.event_a5().a5_thres1);
+          thresh = thres_value(event_id.event_a5().a5_thres2);
+          break;
+        default:
+          logger.error("Error event %s not implemented", event_id.type().to_string());
+          return;
+      }
+
+      for (auto& c : rrc_ptr->meas_cells) {
+        if (c->get_earfcn() != meas_obj.carrier_freq) {
+          continue;
+        }
+        uint32_t pci = c->get_pci();
+        float    Ocn = 0;
         // If the cell was provided by the configuration, check if it has an individual q_offset
         auto n = find_pci_in_meas_obj(meas_obj, pci);
         if (n != meas_obj.cells_to_add_mod_list.end()) {
           Ocn = n->cell_individual_offset.to_number();
         }
-        float Mn = 0;
-        if (is_rsrp(report_cfg.trigger_quant.value)) {
-          Mn = rrc_ptr->get_cell_rsrp(meas_obj.carrier_freq, pci);
-        } else {
-          Mn = rrc_ptr->get_cell_rsrq(meas_obj.carrier_freq, pci);
-        }
-        double  Off    = 0;
-        float   thresh = 0, th1 = 0, th2 = 0;
-        bool    enter_condition = false;
-        bool    exit_condition  = false;
-        uint8_t range, range2;
+        float Mn              = is_rsrp(report_cfg.trigger_quant.value) ? c->get_rsrp() : c->get_rsrq();
+        bool  enter_condition = false;
+        bool  exit_condition  = false;
         switch (event_id.type().value) {
           case eutra_event_s::event_id_c_::types::event_a3:
-            Off             = 0.5 * event_id.event_a3().a3_offset;
             enter_condition = Mn + Ofn + Ocn - hyst > Ms + Ofs + Ocs + Off;
             exit_condition  = Mn + Ofn + Ocn + hyst < Ms + Ofs + Ocs + Off;
             break;
           case eutra_event_s::event_id_c_::types::event_a4:
-            if (event_id.event_a4().a4_thres.type() == thres_eutra_c::types::thres_rsrp) {
-              range = event_id.event_a4().a4_thres.thres_rsrp();
-            } else {
-              range = event_id.event_a4().a4_thres.thres_rsrq();
-            }
-            thresh          = rrc_range_to_value(asn1_quant_convert(report_cfg.trigger_quant.value), range);
             enter_condition = Mn + Ofn + Ocn - hyst > thresh;
             exit_condition  = Mn + Ofn + Ocn + hyst < thresh;
             break;
-          case eutra_event_s::event_id_c_::types::event_a5:
-            if (event_id.event_a5().a5_thres1.type() == thres_eutra_c::types::thres_rsrp) {
-              range = event_id.event_a5().a5_thres1.thres_rsrp();
-            } else {
-              range = event_id.event_a5().a5_thres1.thres_rsrq();
-            }
-            if (event_id.event_a5().a5_thres2.type() == thres_eutra_c::types::thres_rsrp) {
-              range2 = event_id.event_a5().a5_thres2.thres_rsrp();
-            } else {
-              range2 = event_id.event_a5().a5_thres2.thres_rsrq();
-            }
-            th1             = rrc_range_to_value(asn1_quant_convert(report_cfg.trigger_quant.value), range);
-            th2             = rrc_range_to_value(asn1_quant_convert(report_cfg.trigger_quant.value), range2);
-            enter_condition = (Ms + hyst < th1) && (Mn + Ofn + Ocn - hyst > th2);
-            exit_condition  = (Ms - hyst > th1) && (Mn + Ofn + Ocn + hyst < th2);
-            break;
           default:
-            logger.error("Error event %s not implemented", event_id.type().to_string());
+            enter_condition = (Ms + hyst < th1) && (Mn + Ofn + Ocn - hyst > thresh);
+            exit_condition  = (Ms - hyst > th1) && (Mn + Ofn + Ocn + hyst < thresh);
+            break;
         }
 
-        trigger_state[meas_id][pci].event_condition(enter_condition, exit_condition);
-
-        logger.debug(
-            "MEAS:  eventId=%s, pci=%d, Ms=%.2f, hyst=%.2f, Thresh=%.2f, enter_condition=%d, exit_condition=%d",
-            event_id.type().to_string(),
-            pci,
-            Ms,
-            hyst,
-            thresh,
-            enter_condition,
-            exit_condition);
+        get_trigger_state(cells, pci).event_condition(enter_condition, exit_condition, ttt);
+
+        logger.debug("MEAS:  eventId=%s, pci=%d, earfcn=%d, Ms=%.2f, Mn=%.2f, hyst=%.2f, Thresh=%.2f, "
+                     "enter_condition=%d, exit_condition=%d",
+                     event_id.type().to_string(),
+                     pci,
+                     meas_obj.carrier_freq,
+                     Ms,
+                     Mn,
+                     hyst,
+                     thresh,
+                     enter_condition,
+                     exit_condition);
       }
     }
+
+    end_trigger_eval(cells);
   }
 }
 
@@ -920,42 +920,59 @@ void rrc::rrc_meas::var_meas_cfg::eval_triggers_interrat_nr(uint32_t
     return;
   }
 
-  report_cfg_inter_rat_s::trigger_type_c_::event_s_::event_id_c_ event_id = report_cfg.trigger_type.event().event_id;
+  const report_cfg_inter_rat_s::trigger_type_c_::event_s_::event_id_c_& event_id =
+      report_cfg.trigger_type.event().event_id;
 
-  double hyst = (double)report_cfg.trigger_type.event().hysteresis;
-
-  auto cells = rrc_ptr->get_cells_nr(meas_obj.carrier_freq_r15);
-
-  for (auto& pci : cells) {
-    float thresh          = 0.0;
-    bool  enter_condition = false;
-    bool  exit_condition  = false;
-    float Mn              = 0.0;
+  double   hyst   = (double)report_cfg.trigger_type.event().hysteresis;
+  uint32_t ttt    = report_cfg.trigger_type.event().time_to_trigger.to_number();
+  float    thresh = 0.0;
+  bool     rsrp   = event_id.event_b1_nr_r15().b1_thres_nr_r15.type().value == thres_nr_r15_c::types::nr_rsrp_r15;
+  if (rsrp) {
+    thresh = range_to_value_nr(asn1::rrc::thres_nr_r15_c::types_opts::options::nr_rsrp_r15,
+                               event_id.event_b1_nr_r15().b1_thres_nr_r15.nr_rsrp_r15());
+  } else {
+    logger.warning("Other threshold values are not supported yet!");
+  }
 
-    logger.debug("MEAS:  eventId=%s, pci=%d, earfcn=%d", event_id.type().to_string(), pci, meas_obj.carrier_freq_r15);
+  cell_trigger_list_t& cells = trigger_state_nr[meas_id];
+  begin_trigger_eval(cells);
 
-    if (event_id.event_b1_nr_r15().b1_thres_nr_r15.type().value == thres_nr_r15_c::types::nr_rsrp_r15) {
-      Mn     = rrc_ptr->get_cell_rsrp_nr(meas_obj.carrier_freq_r15, pci);
-      thresh = range_to_value_nr(asn1::rrc::thres_nr_r15_c::types_opts::options::nr_rsrp_r15,
-                                 event_id.event_b1_nr_r15().b1_thres_nr_r15.nr_rsrp_r15());
-    } else {
-      logger.warning("Other threshold values are not supported yet!");
+  for (auto& c : rrc_ptr->meas_cells_nr) {
+    if (c->get_earfcn() != meas_obj.carrier_freq_r15) {
+      continue;
     }
+    uint32_t pci = c->get_pci();
+    float    Mn  = rsrp ? c->get_rsrp() : 0.0;
 
-    enter_condition = Mn - hyst > thresh;
-    exit_condition  = Mn + hyst < thresh;
+    bool enter_condition = Mn - hyst > thresh;
+    bool exit_condition  = Mn + hyst < thresh;
 
-    trigger_state_nr[meas_id][pci].event_condition(enter_condition, exit_condition);
+    get_trigger_state(cells, pci).event_condition(enter_condition, exit_condition, ttt);
 
-    logger.debug("MEAS (NR):  eventId=%s, Mn=%.2f, hyst=%.2f, Thresh=%.2f, enter_condition=%d, exit_condition=%d",
+    logger.debug("MEAS (NR):  eventId=%s, pci=%d, earfcn=%d, Mn=%.2f, hyst=%.2f, Thresh=%.2f, enter_condition=%d, "
+                 "exit_condition=%d",
                  event_id.type().to_string(),
+                 pci,
+                 meas_obj.carrier_freq_r15,
                  Mn,
                  hyst,
                  thresh,
                  enter_condition,
                  exit_condition);
   }
+
+  end_trigger_eval(cells);
+}
+
+void rrc::rrc_meas::var_meas_cfg::cell_meas_updated(srsran::srsran_rat_t rat)
+{
+  if (rat == srsran::srsran_rat_t::nr) {
+    nr_meas_updated = true;
+  } else {
+    eutra_meas_updated = true;
+  }
 }
+
 /* Evaluate event trigger conditions for each cell 5.5.4 */
 void rrc::rrc_meas::var_meas_cfg::eval_triggers()
 {
@@ -969,6 +986,15 @@ void rrc::rrc_meas::var_meas_cfg::eval_triggers()
   uint32_t serving_earfcn = serv_cell->get_earfcn();
   uint32_t serving_pci    = serv_cell->get_pci();
 
+  // The conditions only change with new measurements, the timeToTrigger keeps running in the timer wheel meanwhile
+  if (serving_earfcn != last_serving_cell.earfcn || serving_pci != last_serving_cell.pci) {
+    last_serving_cell  = {serving_pci, serving_earfcn};
+    eutra_meas_updated = true;
+  }
+  if (!eutra_meas_updated && !nr_meas_updated) {
+    return;
+  }
+
   // Obtain serving cell specific offset
   float Ofs = 0;
   float Ocs = 0;
@@ -984,13 +1010,33 @@ void rrc::rrc_meas::var_meas_cfg::eval_triggers()
   }
 
   for (auto& m : measIdList) {
-    if (!reportConfigList.count(m.second.report_cfg_id) || !measObjectsList.count(m.second.meas_obj_id)) {
+    auto report_it = reportConfigList.find(m.second.report_cfg_id);
+    auto obj_it    = measObjectsList.find(m.second.meas_obj_id);
+    if (report_it == reportConfigList.end() || obj_it == measObjectsList.end()) {
       logger.error("MEAS:  Computing report triggers. MeasId=%d has invalid report or object settings", m.first);
       continue;
     }
 
-    report_cfg_to_add_mod_s& report_cfg = reportConfigList.at(m.second.report_cfg_id);
-    meas_obj_to_add_mod_s&   meas_obj   = measObjectsList.at(m.second.meas_obj_id);
+    report_cfg_to_add_mod_s& report_cfg = report_it->second;
+    meas_obj_to_add_mod_s&   meas_obj   = obj_it->second;
+
+    if (meas_obj.meas_obj.type().value == meas_obj_to_add_mod_s::meas_obj_c_::types_opts::meas_obj_eutra &&
+        report_cfg.report_cfg.type().value == report_cfg_to_add_mod_s::report_cfg_c_::types::report_cfg_eutra) {
+      if (!eutra_meas_updated) {
+        continue;
+      }
+    } else if (meas_obj.meas_obj.type().value == meas_obj_to_add_mod_s::meas_obj_c_::types_opts::meas_obj_nr_r15 &&
+               report_cfg.report_cfg.type().value ==
+                   report_cfg_to_add_mod_s::report_cfg_c_::types::report_cfg_inter_rat) {
+      if (!nr_meas_updated) {
+        continue;
+      }
+    } else {
+      logger.error("Unsupported combination of measurement object type %s and report config type %s ",
+                   meas_obj.meas_obj.type().to_string(),
+                   report_cfg.report_cfg.type().to_string());
+      continue;
+    }
 
     logger.debug("MEAS:  Calculating trigger for MeasId=%d, ObjectId=%d (Type %s), ReportId=%d (Type %s)",
                  m.first,
@@ -999,21 +1045,17 @@ void rrc::rrc_meas::var_meas_cfg::eval_triggers()
                  m.second.report_cfg_id,
                  meas_obj.meas_obj.type().to_string());
 
-    if (meas_obj.meas_obj.type().value == meas_obj_to_add_mod_s::meas_obj_c_::types_opts::meas_obj_eutra &&
-        report_cfg.report_cfg.type().value == report_cfg_to_add_mod_s::report_cfg_c_::types::report_cfg_eutra) {
+    if (meas_obj.meas_obj.type().value == meas_obj_to_add_mod_s::meas_obj_c_::types_opts::meas_obj_eutra) {
       eval_triggers_eutra(
           m.first, report_cfg.report_cfg.report_cfg_eutra(), meas_obj.meas_obj.meas_obj_eutra(), serv_cell, Ofs, Ocs);
-    } else if (meas_obj.meas_obj.type().value == meas_obj_to_add_mod_s::meas_obj_c_::types_opts::meas_obj_nr_r15 &&
-               report_cfg.report_cfg.type().value ==
-                   report_cfg_to_add_mod_s::report_cfg_c_::types::report_cfg_inter_rat)
+    } else {
       eval_triggers_interrat_nr(
           m.first, report_cfg.report_cfg.report_cfg_inter_rat(), meas_obj.meas_obj.meas_obj_nr_r15());
-    else {
-      logger.error("Unsupported combination of measurement object type %s and report config type %s ",
-                   meas_obj.meas_obj.type().to_string(),
-                   report_cfg.report_cfg.type().to_string());
     }
   }
+
+  eutra_meas_updated = false;
+  nr_meas_updated    = false;
 }
 
 /***
@@ -1034,6 +1076,8 @@ void rrc::rrc_meas::var_meas_cfg::reset()
   measIdList.clear();
   measObjectsList.clear();
   reportConfigList.clear();
+  eutra_meas_updated = true;
+  nr_meas_updated    = true;
 }
 
 rrc::rrc_meas::phy_quant_t rrc::rrc_meas::var_meas_cfg::get_filter_a()
@@ -1052,8 +1096,8 @@ void rrc::rrc_meas::var_meas_cfg::remove_measId(const uint32_t measId)
 void rrc::rrc_meas::var_meas_cfg::remove_varmeas_report(const uint32_t meas_id)
 {
   meas_report->remove_varmeas_report(meas_id);
-  trigger_state.erase(meas_id);
-  trigger_state_nr.erase(meas_id);
+  trigger_state[meas_id].clear();
+  trigger_state_nr[meas_id].clear();
 }
 
 std::list<meas_obj_to_add_mod_s> rrc::rrc_meas::var_meas_cfg::get_active_objects()
@@ -1161,7 +1205,10 @@ void rrc::rrc_meas::var_meas_cfg::ho_reest_finish(const uint32_t src_earfcn, con
   }
 
   meas_report->remove_all_varmeas_reports();
-  trigger_state.clear();
+  for (auto& l : trigger_state) {
+    l.clear();
+  }
+  eutra_meas_updated = true;
 }
 
 // Measurement object removal 5.5.2.4
@@ -1587,6 +1634,10 @@ bool rrc::rrc_meas::var_meas_cfg::parse_meas_config(const meas_cfg_s* cfg, bool
     }
   }
 
+  // evaluate the triggers again with the new configuration
+  eutra_meas_updated = true;
+  nr_meas_updated    = true;
+
   // According to 5.5.6.1, if the new configuration after a HO/Reest does not configure the target frequency, we need
   // to swap frequencies with source
   if (is_ho_reest) {
@@ -1608,28 +1659,77 @@ bool rrc::rrc_meas::var_meas_cfg::parse_meas_config(const meas_cfg_s* cfg, bool
   return true;
 }
 
-void rrc::rrc_meas::var_meas_cfg::cell_trigger_state::event_condition(const bool enter, const bool exit)
+void rrc::rrc_meas::var_meas_cfg::cell_trigger_state::event_condition(const bool     enter,
+                                                                      const bool     exit,
+                                                                      const uint32_t time_to_trigger)
 {
-  if (enter) {
-    nof_tti_enter++;
-    nof_tti_exit = 0;
-  } else if (exit) {
-    nof_tti_enter = 0;
-    nof_tti_exit++;
-  } else {
-    nof_tti_enter = 0;
-    nof_tti_exit  = 0;
+  evaluated = true;
+  if (enter != enter_cond) {
+    enter_cond = enter;
+    enter_timer.stop();
+    if (enter_cond && time_to_trigger > 0) {
+      enter_timer.set(time_to_trigger);
+      enter_timer.run();
+    }
+  }
+  // The leaving condition is only considered when the entering one is not fulfilled
+  bool new_exit = exit && !enter;
+  if (new_exit != exit_cond) {
+    exit_cond = new_exit;
+    exit_timer.stop();
+    if (exit_cond && time_to_trigger > 0) {
+      exit_timer.set(time_to_trigger);
+      exit_timer.run();
+    }
   }
 }
 
-bool rrc::rrc_meas::var_meas_cfg::cell_trigger_state::is_enter_equal(const uint32_t nof_tti)
+bool rrc::rrc_meas::var_meas_cfg::cell_trigger_state::is_enter_equal(const uint32_t time_to_trigger) const
 {
-  return nof_tti < nof_tti_enter;
+  return enter_cond && (time_to_trigger == 0 || enter_timer.is_expired());
 }
 
-bool rrc::rrc_meas::var_meas_cfg::cell_trigger_state::is_exit_equal(const uint32_t nof_tti)
+bool rrc::rrc_meas::var_meas_cfg::cell_trigger_state::is_exit_equal(const uint32_t time_to_trigger) const
 {
-  return nof_tti < nof_tti_exit;
+  return exit_cond && (time_to_trigger == 0 || exit_timer.is_expired());
+}
+
+rrc::rrc_meas::var_meas_cfg::cell_trigger_state&
+rrc::rrc_meas::var_meas_cfg::get_trigger_state(cell_trigger_list_t& list, uint32_t pci)
+{
+  auto it = std::lower_bound(list.begin(), list.end(), pci, [](const cell_trigger_state& c, uint32_t p) {
+    return c.get_pci() < p;
+  });
+  if (it == list.end() || it->get_pci() != pci) {
+    it = list.emplace(it, pci, rrc_ptr->task_sched.get_unique_timer(), rrc_ptr->task_sched.get_unique_timer());
+  }
+  return *it;
+}
+
+rrc::rrc_meas::var_meas_cfg::cell_trigger_state*
+rrc::rrc_meas::var_meas_cfg::find_trigger_state(cell_trigger_list_t& list, uint32_t pci)
+{
+  auto it = std::lower_bound(list.begin(), list.end(), pci, [](const cell_trigger_state& c, uint32_t p) {
+    return c.get_pci() < p;
+  });
+  return (it != list.end() && it->get_pci() == pci) ? &(*it) : nullptr;
+}
+
+void rrc::rrc_meas::var_meas_cfg::begin_trigger_eval(cell_trigger_list_t& list)
+{
+  for (auto& c : list) {
+    c.evaluated = false;
+  }
+}
+
+// Cells that are not measured anymore do not fulfill any condition
+void rrc::rrc_meas::var_meas_cfg::end_trigger_eval(cell_trigger_list_t& list)
+{
+  for (auto& c : list) {
+    if (!c.evaluated) {
+      c.event_condition(false, false, 0);
+    }
+  }
 }
 
 } // namespace srsue
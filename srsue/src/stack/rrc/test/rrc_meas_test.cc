@@ -1033,6 +1033,67 @@ int a1event_report_test(uint32_t                             a1_rsrp_th,
 }
 
 // Test A3-event reporting and management of report amount and interval
+// Test that the timeToTrigger keeps running in the TTIs without new measurements
+int a1event_ttt_test(uint32_t a1_rsrp_th, time_to_trigger_e time_trigger, uint32_t hyst)
+{
+  auto& rrc_meas_logger = srslog::fetch_basic_logger("RRC_MEAS");
+
+  printf("==========================================================\n");
+  printf("============    Time To Trigger Testing    ===============\n");
+  printf("==========================================================\n");
+
+  stack_test_dummy stack;
+  rrc_test         rrctest(rrc_meas_logger.id(), &stack);
+  rrctest.init();
+  rrctest.connect();
+
+  rrctest.set_serving_cell(1, 1);
+
+  rrc_conn_recfg_r8_ies_s    rrc_conn_recfg = {};
+  eutra_event_s::event_id_c_ event_id       = {};
+
+  event_id.set_event_a1();
+  event_id.event_a1().a1_thres.set_thres_rsrp();
+  event_id.event_a1().a1_thres.thres_rsrp() = a1_rsrp_th;
+
+  config_default_report_test(rrc_conn_recfg,
+                             event_id,
+                             time_trigger,
+                             hyst,
+                             report_cfg_eutra_s::report_amount_opts::r1,
+                             report_interv_opts::ms120);
+  TESTASSERT(rrctest.send_meas_cfg(rrc_conn_recfg));
+
+  meas_results_s meas_res = {};
+  int            ttt      = time_trigger.to_number();
+
+  // A single measurement fulfilling the entering condition, the condition stays until the next measurement
+  enter_condition(rrctest, event_id, hyst, 0, {1});
+  for (int i = 0; i < ttt - 1; i++) {
+    rrctest.run_tti(1);
+    TESTASSERT(!rrctest.get_meas_res(meas_res));
+  }
+  rrctest.run_tti(1);
+  TESTASSERT(rrctest.get_meas_res(meas_res));
+  TESTASSERT(meas_res.meas_id == 1);
+
+  // A measurement not fulfilling the leaving condition stops its timeToTrigger
+  exit_condition(rrctest, event_id, hyst, 0, {1});
+  middle_condition(rrctest, event_id, hyst, 0, {1});
+  for (int i = 0; i < 2 * ttt; i++) {
+    rrctest.run_tti(1);
+  }
+  // Entering again does not generate a report, as the cell was not removed from the triggered list
+  enter_condition(rrctest, event_id, hyst, 0, {1});
+  for (int i = 0; i < 2 * ttt; i++) {
+    rrctest.run_tti(1);
+  }
+  TESTASSERT(!rrctest.get_meas_res(meas_res));
+
+  printf("==========================================================\n");
+  return 0;
+}
+
 int a3event_report_test(uint32_t a3_offset, uint32_t hyst, bool report_on_leave)
 {
   auto& rrc_meas_logger = srslog::fetch_basic_logger("RRC_MEAS");
@@ -1266,6 +1327,7 @@ int main(int argc, char** argv)
       a1event_report_test(
           30, time_to_trigger_opts::ms40, 3, report_cfg_eutra_s::report_amount_opts::r8, report_interv_opts::ms120) ==
       SRSRAN_SUCCESS);
+  TESTASSERT(a1event_ttt_test(30, time_to_trigger_opts::ms40, 3) == SRSRAN_SUCCESS);
   TESTASSERT(a3event_report_test(6, 3, true) == SRSRAN_SUCCESS);
   return SRSRAN_SUCCESS;
 }
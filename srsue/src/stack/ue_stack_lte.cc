@@ -222,6 +222,7 @@ int ue_stack_lte::init(const stack_args_t& args_)
   sync_task_queue = task_sched.make_task_queue(args.sync_queue_size);
 
   mac.init(phy, &rlc, &rrc);
+  mac.set_dl_data_fast_path(args.mac_dl_data_fast_path);
   rlc.init(&pdcp, &rrc, task_sched.get_timer_handler(), 0 /* RB_ID_SRB0 */);
   nas.init(usim.get(), &rrc, gw, args.nas);
 
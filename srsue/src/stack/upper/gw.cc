@@ -32,6 +32,7 @@
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <unistd.h>
@@ -76,6 +77,9 @@ gw::~gw()
   if (tun_fd > 0) {
     close(tun_fd);
   }
+  for (int32_t fd : tun_queue_fds) {
+    close(fd);
+  }
 }
 
 void gw::stop()
@@ -87,6 +91,7 @@ void gw::stop()
       if (running) {
         thread_cancel();
       }
+      stop_tun_queue_readers();
 
       // Wait thread to exit gracefully otherwise might leave a mutex locked
       int cnt = 0;
@@ -206,6 +211,7 @@ int gw::setup_if_addr(uint32_t eps_bearer_id, uint8_t pdn_type, uint32_t ip_addr
     thread_cancel();
     wait_thread_finish();
   }
+  stop_tun_queue_readers();
   if (pdn_type == LIBLTE_MME_PDN_TYPE_IPV4 || pdn_type == LIBLTE_MME_PDN_TYPE_IPV4V6) {
     err = setup_if_addr4(ip_addr, err_str);
     if (err != SRSRAN_SUCCESS) {
@@ -224,6 +230,7 @@ int gw::setup_if_addr(uint32_t eps_bearer_id, uint8_t pdn_type, uint32_t ip_addr
   // Setup a thread to receive packets from the TUN device
   run_enable = true;
   start(GW_THREAD_PRIO);
+  start_tun_queue_readers();
 
   return SRSRAN_SUCCESS;
 }
@@ -274,123 +281,166 @@ void gw::add_mch_port(uint32_t lcid, uint32_t port)
 /********************/
 void gw::run_thread()
 {
-  uint32 idx     = 0;
-  int32  N_bytes = 0;
+  logger.info("GW IP packet receiver thread run_enable");
+
+  running = true;
+  run_tun_reader(tun_fd);
+  running = false;
+  logger.info("GW IP receiver thread exiting.");
+}
 
-  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
-  if (!pdu) {
-    logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
-    return;
+/// Checks that the buffer holds a single and complete IPv4 or IPv6 packet
+static bool is_complete_ip_pdu(const srsran::byte_buffer_t& pdu, srslog::basic_logger& logger)
+{
+  const struct iphdr*   ip_pkt  = (const struct iphdr*)pdu.msg;
+  const struct ipv6hdr* ip6_pkt = (const struct ipv6hdr*)pdu.msg;
+  uint16_t              pkt_len = 0;
+  if (ip_pkt->version == 4) {
+    pkt_len = ntohs(ip_pkt->tot_len);
+  } else if (ip_pkt->version == 6) {
+    pkt_len = ntohs(ip6_pkt->payload_len) + 40;
+  } else {
+    logger.error(pdu.msg, pdu.N_bytes, "Unsupported IP version. Dropping packet.");
+    return false;
   }
+  logger.debug("IPv%d packet total length: %d Bytes", int(ip_pkt->version), pkt_len);
+
+  // The TUN device hands a whole packet per read, so a length mismatch means it did not fit in the buffer
+  if (pkt_len != pdu.N_bytes) {
+    logger.warning(
+        "Entire packet not read from TUN. Total Length %d, N_Bytes %d. Dropping packet.", pkt_len, pdu.N_bytes);
+    return false;
+  }
+  return true;
+}
+
+void gw::run_tun_reader(int32_t fd)
+{
+  // The PDUs of a burst that are not sent to the stack are kept for the next one
+  std::array<srsran::unique_byte_buffer_t, tft_pdu_matcher::max_burst_size> pdus;
+  std::array<uint8_t, tft_pdu_matcher::max_burst_size>                      eps_bearer_ids;
 
   const static uint32_t REGISTER_WAIT_TOUT = 40, SERVICE_WAIT_TOUT = 40; // 4 sec
   uint32_t              register_wait = 0, service_wait = 0;
 
-  logger.info("GW IP packet receiver thread run_enable");
-
-  running = true;
   while (run_enable) {
-    // Read packet from TUN
-    if (SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET > idx) {
-      N_bytes = read(tun_fd, &pdu->msg[idx], SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET - idx);
-    } else {
-      logger.error("GW pdu buffer full - gw receive thread exiting.");
-      srsran::console("GW pdu buffer full - gw receive thread exiting.\n");
+    // Wait for packets in the TUN queue, and then read all of them, up to a burst
+    struct pollfd pfd = {fd, POLLIN, 0};
+    if (poll(&pfd, 1, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      logger.error("Failed to poll TUN interface - gw receive thread exiting.");
+      srsran::console("Failed to poll TUN interface - gw receive thread exiting.\n");
       break;
     }
-    logger.debug("Read %d bytes from TUN fd=%d, idx=%d", N_bytes, tun_fd, idx);
 
-    if (N_bytes <= 0) {
+    size_t nof_pdus = 0;
+    bool   rx_error = false;
+    while (nof_pdus < pdus.size()) {
+      srsran::unique_byte_buffer_t& pdu = pdus[nof_pdus];
+      if (pdu == nullptr) {
+        pdu = srsran::make_byte_buffer();
+        if (pdu == nullptr) {
+          logger.error("Fatal Error: Couldn't allocate PDU in %s().", __FUNCTION__);
+          usleep(100000);
+          break;
+        }
+      }
+      int32_t N_bytes = read(fd, pdu->msg, SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET);
+      if (N_bytes < 0 and (errno == EAGAIN or errno == EWOULDBLOCK)) {
+        break;
+      }
+      if (N_bytes <= 0) {
+        rx_error = true;
+        break;
+      }
+      logger.debug("Read %d bytes from TUN fd=%d", N_bytes, fd);
+      pdu->N_bytes = N_bytes;
+      if (is_complete_ip_pdu(*pdu, logger)) {
+        nof_pdus++;
+      }
+    }
+    if (rx_error) {
       logger.error("Failed to read from TUN interface - gw receive thread exiting.");
       srsran::console("Failed to read from TUN interface - gw receive thread exiting.\n");
       break;
     }
+    if (nof_pdus == 0) {
+      continue;
+    }
 
-    {
-      std::unique_lock<std::mutex> lock(gw_mutex);
-      // Check if IP version makes sense and get packtet length
-      struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
-      struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
-      uint16_t        pkt_len = 0;
-      pdu->N_bytes            = idx + N_bytes;
-      if (ip_pkt->version == 4) {
-        pkt_len = ntohs(ip_pkt->tot_len);
-      } else if (ip_pkt->version == 6) {
-        pkt_len = ntohs(ip6_pkt->payload_len) + 40;
-      } else {
-        logger.error(pdu->msg, pdu->N_bytes, "Unsupported IP version. Dropping packet.");
-        continue;
+    std::unique_lock<std::mutex> lock(gw_mutex);
+
+    // Make sure UE is attached and has default EPS bearer activated
+    while (run_enable && default_eps_bearer_id == NOT_ASSIGNED && register_wait < REGISTER_WAIT_TOUT) {
+      if (!register_wait) {
+        logger.info("UE is not attached, waiting for NAS attach (%d/%d)", register_wait, REGISTER_WAIT_TOUT);
       }
-      logger.debug("IPv%d packet total length: %d Bytes", int(ip_pkt->version), pkt_len);
+      lock.unlock();
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      lock.lock();
+      register_wait++;
+    }
+    register_wait = 0;
 
-      // Check if entire packet was received
-      if (pkt_len == pdu->N_bytes) {
-        logger.info(pdu->msg, pdu->N_bytes, "TX PDU");
+    if (!run_enable) {
+      break;
+    }
 
-        // Make sure UE is attached and has default EPS bearer activated
-        while (run_enable && default_eps_bearer_id == NOT_ASSIGNED && register_wait < REGISTER_WAIT_TOUT) {
-          if (!register_wait) {
-            logger.info("UE is not attached, waiting for NAS attach (%d/%d)", register_wait, REGISTER_WAIT_TOUT);
-          }
-          lock.unlock();
-          std::this_thread::sleep_for(std::chrono::microseconds(100));
-          lock.lock();
-          register_wait++;
-        }
-        register_wait = 0;
+    // If we are still not attached by this stage, drop the burst
+    if (default_eps_bearer_id == NOT_ASSIGNED) {
+      continue;
+    }
 
-        // If we are still not attached by this stage, drop packet
-        if (run_enable && default_eps_bearer_id == NOT_ASSIGNED) {
-          continue;
-        }
+    // Beyond this point we should have a activated default EPS bearer
+    std::fill(eps_bearer_ids.begin(), eps_bearer_ids.begin() + nof_pdus, default_eps_bearer_id);
+    tft_matcher.check_tft_filter_match(srsran::span<const srsran::unique_byte_buffer_t>(pdus.data(), nof_pdus),
+                                       srsran::span<uint8_t>(eps_bearer_ids.data(), nof_pdus));
 
-        if (!run_enable) {
-          break;
-        }
+    for (size_t i = 0; i < nof_pdus and run_enable; ++i) {
+      logger.info(pdus[i]->msg, pdus[i]->N_bytes, "TX PDU");
 
-        // Beyond this point we should have a activated default EPS bearer
-        srsran_assert(default_eps_bearer_id != NOT_ASSIGNED, "Default EPS bearer not activated");
+      // Wait for service request if necessary
+      while (run_enable && !stack->has_active_radio_bearer(eps_bearer_ids[i]) && service_wait < SERVICE_WAIT_TOUT) {
+        if (!service_wait) {
+          logger.info(
+              "UE does not have service, waiting for NAS service request (%d/%d)", service_wait, SERVICE_WAIT_TOUT);
+          stack->start_service_request();
+        }
+        usleep(100000);
+        service_wait++;
+      }
+      service_wait = 0;
 
-        uint8_t eps_bearer_id = default_eps_bearer_id;
-        tft_matcher.check_tft_filter_match(pdu, eps_bearer_id);
+      // Quit before writing packet if necessary
+      if (!run_enable) {
+        break;
+      }
 
-        // Wait for service request if necessary
-        while (run_enable && !stack->has_active_radio_bearer(eps_bearer_id) && service_wait < SERVICE_WAIT_TOUT) {
-          if (!service_wait) {
-            logger.info(
-                "UE does not have service, waiting for NAS service request (%d/%d)", service_wait, SERVICE_WAIT_TOUT);
-            stack->start_service_request();
-          }
-          usleep(100000);
-          service_wait++;
-        }
-        service_wait = 0;
+      // Send PDU directly to PDCP
+      pdus[i]->set_timestamp();
+      ul_tput_bytes += pdus[i]->N_bytes;
+      stack->write_sdu(eps_bearer_ids[i], std::move(pdus[i]));
+    }
+  }
+}
 
-        // Quit before writing packet if necessary
-        if (!run_enable) {
-          break;
-        }
+void gw::start_tun_queue_readers()
+{
+  for (int32_t fd : tun_queue_fds) {
+    tun_queue_readers.emplace_back(new tun_queue_reader(*this, fd));
+    tun_queue_readers.back()->start(GW_THREAD_PRIO);
+  }
+}
 
-        // Send PDU directly to PDCP
-        pdu->set_timestamp();
-        ul_tput_bytes += pdu->N_bytes;
-        stack->write_sdu(eps_bearer_id, std::move(pdu));
-        do {
-          pdu = srsran::make_byte_buffer();
-          if (!pdu) {
-            logger.error("Fatal Error: Couldn't allocate PDU in run_thread().");
-            usleep(100000);
-          }
-        } while (!pdu);
-        idx = 0;
-      } else {
-        idx += N_bytes;
-        logger.debug("Entire packet not read from socket. Total Length %d, N_Bytes %d.", ip_pkt->tot_len, pdu->N_bytes);
-      }
-    } // end of holdering gw_mutex
+void gw::stop_tun_queue_readers()
+{
+  for (auto& reader : tun_queue_readers) {
+    reader->thread_cancel();
+    reader->wait_thread_finish();
   }
-  running = false;
-  logger.info("GW IP receiver thread exiting.");
+  tun_queue_readers.clear();
 }
 
 /**************************/
@@ -430,6 +480,10 @@ int gw::init_if(char* err_str)
 
   memset(&ifr, 0, sizeof(ifr));
   ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
+  if (args.nof_tun_queues > 1) {
+    // Each queue has its own reader thread. The kernel spreads the flows over the queues
+    ifr.ifr_flags |= IFF_MULTI_QUEUE;
+  }
   strncpy(
       ifr.ifr_ifrn.ifrn_name, args.tun_dev_name.c_str(), std::min(args.tun_dev_name.length(), (size_t)(IFNAMSIZ - 1)));
   ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = 0;
@@ -439,6 +493,26 @@ int gw::init_if(char* err_str)
     close(tun_fd);
     return SRSRAN_ERROR_CANT_START;
   }
+  for (uint32_t i = 1; i < args.nof_tun_queues; ++i) {
+    struct ifreq queue_ifr = ifr;
+    int32_t      queue_fd  = open("/dev/net/tun", O_RDWR);
+    if (0 > queue_fd or 0 > ioctl(queue_fd, TUNSETIFF, &queue_ifr)) {
+      err_str = strerror(errno);
+      logger.error("Failed to attach queue %d of the TUN device: %s", i, err_str);
+      if (queue_fd >= 0) {
+        close(queue_fd);
+      }
+      close(tun_fd);
+      return SRSRAN_ERROR_CANT_START;
+    }
+    tun_queue_fds.push_back(queue_fd);
+  }
+
+  // The readers drain the queues in bursts, until there are no packets left
+  fcntl(tun_fd, F_SETFL, fcntl(tun_fd, F_GETFL) | O_NONBLOCK);
+  for (int32_t fd : tun_queue_fds) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  }
 
   // Bring up the interface
   sock = socket(AF_INET, SOCK_DGRAM, 0);
@@ -23,7 +23,10 @@
 
 namespace srsue {
 
-sdap::sdap(const char* logname) : logger(srslog::fetch_basic_logger(logname)) {}
+sdap::sdap(const char* logname) : logger(srslog::fetch_basic_logger(logname))
+{
+  qfi_to_lcid.fill(srsran::MAX_NR_NOF_BEARERS);
+}
 
 bool sdap::init(pdcp_interface_sdap_nr* pdcp_, srsue::gw_interface_pdcp* gw_)
 {
@@ -46,39 +49,108 @@ void sdap::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
   if (!running) {
     return;
   }
+  if (lcid < bearers.size() and not remove_dl_header(lcid, bearers[lcid], *pdu)) {
+    return;
+  }
   m_gw->write_pdu(lcid, std::move(pdu));
 }
 
+void sdap::write_pdus(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> pdus)
+{
+  if (!running) {
+    return;
+  }
+  for (srsran::unique_byte_buffer_t& pdu : pdus) {
+    if (lcid < bearers.size() and not remove_dl_header(lcid, bearers[lcid], *pdu)) {
+      continue;
+    }
+    m_gw->write_pdu(lcid, std::move(pdu));
+  }
+}
+
 void sdap::write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
 {
   if (!running) {
     return;
   }
   if (lcid < bearers.size()) {
-    if (bearers[lcid].add_uplink_header) {
-      if (pdu->get_headroom() > 1) {
-        pdu->msg -= 1;
-        pdu->N_bytes += 1;
-        pdu->msg[0] = ((bearers[lcid].is_data ? 1 : 0) << 7) | (bearers[lcid].qfi & 0x3f);
-      } else {
-        logger.error("Not enough headroom in PDU to add header\n");
-      }
-    }
+    add_ul_header(bearers[lcid], *pdu);
   }
   m_pdcp->write_sdu(lcid, std::move(pdu));
 }
 
+void sdap::write_sdus(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus)
+{
+  if (!running) {
+    return;
+  }
+  if (lcid < bearers.size()) {
+    const bearer_ctxt_t& bearer = bearers[lcid];
+    for (srsran::unique_byte_buffer_t& sdu : sdus) {
+      add_ul_header(bearer, *sdu);
+    }
+  }
+  m_pdcp->write_sdus(lcid, sdus);
+}
+
+/// Writes the UL header into the headroom of the buffer, the payload is not moved
+void sdap::add_ul_header(const bearer_ctxt_t& bearer, srsran::byte_buffer_t& pdu)
+{
+  if (not bearer.add_ul_hdr) {
+    return;
+  }
+  if (pdu.get_headroom() < 1) {
+    logger.error("Not enough headroom in PDU to add header");
+    return;
+  }
+  pdu.msg -= 1;
+  pdu.N_bytes += 1;
+  pdu.msg[0] = bearer.ul_hdr_byte;
+}
+
+/// Skips the DL header of the buffer, the payload is not moved
+bool sdap::remove_dl_header(uint32_t lcid, const bearer_ctxt_t& bearer, srsran::byte_buffer_t& pdu)
+{
+  if (not bearer.has_dl_hdr) {
+    return true;
+  }
+  if (pdu.N_bytes < 1) {
+    logger.warning("Discarding SDAP PDU of lcid=%d. Cause: PDU too short for the header", lcid);
+    return false;
+  }
+  // RDI (1 bit), RQI (1 bit), QFI (6 bits). Reflective QoS is not supported, the flag bits are ignored.
+  uint32_t qfi = pdu.msg[0] & 0x3fU;
+  if (qfi_to_lcid[qfi] != lcid) {
+    logger.warning("Received SDAP PDU of QFI=%d on lcid=%d, which the QoS flow is not mapped to", qfi, lcid);
+  }
+  pdu.msg += 1;
+  pdu.N_bytes -= 1;
+  return true;
+}
+
 bool sdap::set_bearer_cfg(uint32_t lcid, const sdap_interface_rrc::bearer_cfg_t& cfg)
 {
   if (lcid >= bearers.size()) {
-    logger.error("Error setting configuration: invalid lcid=%d\n", lcid);
+    logger.error("Error setting configuration: invalid lcid=%d", lcid);
     return false;
   }
-  if (cfg.add_downlink_header) {
-    logger.error("Error setting configuration: downlink header not supported\n");
+  if (cfg.qfi > max_qfi) {
+    logger.error("Error setting configuration: invalid qfi=%d", cfg.qfi);
     return false;
   }
-  bearers[lcid] = cfg;
+
+  // A DRB carries a single QoS flow in this implementation, so the previous mapping of the DRB is removed
+  for (uint8_t& mapped_lcid : qfi_to_lcid) {
+    if (mapped_lcid == lcid) {
+      mapped_lcid = srsran::MAX_NR_NOF_BEARERS;
+    }
+  }
+  qfi_to_lcid[cfg.qfi] = lcid;
+
+  bearer_ctxt_t& bearer = bearers[lcid];
+  bearer.add_ul_hdr     = cfg.add_uplink_header;
+  bearer.has_dl_hdr     = cfg.add_downlink_header;
+  bearer.ul_hdr_byte    = ((cfg.is_data ? 1 : 0) << 7) | (cfg.qfi & 0x3f);
   return true;
 }
 
@@ -0,0 +1,153 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsue/hdr/stack/upper/sdap.h"
+
+class pdcp_dummy : public srsue::pdcp_interface_sdap_nr
+{
+public:
+  void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu) override { sdus.push_back(std::move(pdu)); }
+  void write_sdus(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus_) override
+  {
+    nof_bursts++;
+    for (srsran::unique_byte_buffer_t& sdu : sdus_) {
+      sdus.push_back(std::move(sdu));
+    }
+  }
+
+  std::vector<srsran::unique_byte_buffer_t> sdus;
+  uint32_t                                  nof_bursts = 0;
+};
+
+class gw_dummy : public srsue::gw_interface_pdcp
+{
+public:
+  void write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu) override { pdus.push_back(std::move(pdu)); }
+  void write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t pdu) override {}
+
+  std::vector<srsran::unique_byte_buffer_t> pdus;
+};
+
+srsran::unique_byte_buffer_t make_pdu(uint8_t first_byte, uint32_t len)
+{
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  if (pdu != nullptr) {
+    for (uint32_t i = 0; i < len; ++i) {
+      pdu->msg[i] = first_byte + i;
+    }
+    pdu->N_bytes = len;
+  }
+  return pdu;
+}
+
+int test_sdap_ul_header()
+{
+  pdcp_dummy     pdcp;
+  gw_dummy       gw;
+  srsue::sdap    sdap("SDAP-NR");
+  const uint32_t lcid = 4;
+  TESTASSERT(sdap.init(&pdcp, &gw));
+
+  sdap_interface_rrc::bearer_cfg_t cfg = {};
+  cfg.is_data                          = true;
+  cfg.add_uplink_header                = true;
+  cfg.qfi                              = 9;
+  TESTASSERT(sdap.set_bearer_cfg(lcid, cfg));
+  TESTASSERT(sdap.get_lcid(9) == lcid);
+  TESTASSERT(sdap.get_lcid(1) == srsran::MAX_NR_NOF_BEARERS);
+
+  // The header is written in front of the payload, which stays in place
+  srsran::unique_byte_buffer_t sdu     = make_pdu(0x10, 20);
+  uint8_t*                     payload = sdu->msg;
+  sdap.write_sdu(lcid, std::move(sdu));
+  TESTASSERT(pdcp.sdus.size() == 1);
+  TESTASSERT(pdcp.sdus[0]->N_bytes == 21);
+  TESTASSERT(pdcp.sdus[0]->msg + 1 == payload);
+  TESTASSERT(pdcp.sdus[0]->msg[0] == 0x89);
+  TESTASSERT(pdcp.sdus[0]->msg[1] == 0x10);
+
+  // A burst reaches PDCP in a single call
+  std::array<srsran::unique_byte_buffer_t, 4> burst;
+  for (uint32_t i = 0; i < burst.size(); ++i) {
+    burst[i] = make_pdu(i, 10);
+  }
+  sdap.write_sdus(lcid, burst);
+  TESTASSERT(pdcp.nof_bursts == 1);
+  TESTASSERT(pdcp.sdus.size() == 1 + burst.size());
+  for (uint32_t i = 0; i < burst.size(); ++i) {
+    TESTASSERT(burst[i] == nullptr);
+    TESTASSERT(pdcp.sdus[1 + i]->N_bytes == 11);
+    TESTASSERT(pdcp.sdus[1 + i]->msg[0] == 0x89);
+    TESTASSERT(pdcp.sdus[1 + i]->msg[1] == i);
+  }
+
+  // Moving the QoS flow to another DRB removes the previous mapping
+  cfg.qfi = 5;
+  TESTASSERT(sdap.set_bearer_cfg(lcid, cfg));
+  TESTASSERT(sdap.get_lcid(9) == srsran::MAX_NR_NOF_BEARERS);
+  TESTASSERT(sdap.get_lcid(5) == lcid);
+
+  cfg.qfi = 64;
+  TESTASSERT(not sdap.set_bearer_cfg(lcid, cfg));
+  return SRSRAN_SUCCESS;
+}
+
+int test_sdap_dl_header()
+{
+  pdcp_dummy     pdcp;
+  gw_dummy       gw;
+  srsue::sdap    sdap("SDAP-NR");
+  const uint32_t lcid = 4;
+  TESTASSERT(sdap.init(&pdcp, &gw));
+
+  sdap_interface_rrc::bearer_cfg_t cfg = {};
+  cfg.is_data                          = true;
+  cfg.add_downlink_header              = true;
+  cfg.qfi                              = 1;
+  TESTASSERT(sdap.set_bearer_cfg(lcid, cfg));
+
+  // The header is skipped without moving the payload
+  srsran::unique_byte_buffer_t pdu     = make_pdu(0x01, 20);
+  uint8_t*                     payload = pdu->msg + 1;
+  sdap.write_pdu(lcid, std::move(pdu));
+  TESTASSERT(gw.pdus.size() == 1);
+  TESTASSERT(gw.pdus[0]->N_bytes == 19);
+  TESTASSERT(gw.pdus[0]->msg == payload);
+  TESTASSERT(gw.pdus[0]->msg[0] == 0x02);
+
+  // PDUs without room for the header are discarded
+  std::array<srsran::unique_byte_buffer_t, 3> burst = {make_pdu(0x01, 8), make_pdu(0x01, 0), make_pdu(0x01, 8)};
+  sdap.write_pdus(lcid, burst);
+  TESTASSERT(gw.pdus.size() == 3);
+  TESTASSERT(gw.pdus[1]->N_bytes == 7);
+  TESTASSERT(gw.pdus[2]->N_bytes == 7);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+
+  TESTASSERT(test_sdap_ul_header() == SRSRAN_SUCCESS);
+  TESTASSERT(test_sdap_dl_header() == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
@@ -409,6 +409,109 @@ int tft_filter_test_ipv4_tos()
   return 0;
 }
 
+int tft_filter_test_batch_match()
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT");
+
+  // Filter 1, highest precedence: single local port 2222, matches IP test message 1
+  // Filter 2: single remote port 9000, matches IP test message 2
+  LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT tft = {};
+  tft.tft_op_code                             = LIBLTE_MME_TFT_OPERATION_CODE_CREATE_NEW_TFT;
+  tft.packet_filter_list_size                 = 2;
+  for (uint32_t i = 0; i < 2; ++i) {
+    LIBLTE_MME_PACKET_FILTER_STRUCT& packet_filter = tft.packet_filter_list[i];
+    packet_filter.dir                              = LIBLTE_MME_TFT_PACKET_FILTER_DIRECTION_BIDIRECTIONAL;
+    packet_filter.id                               = i + 1;
+    packet_filter.eval_precedence                  = i;
+    packet_filter.filter_size                      = 3;
+    packet_filter.filter[0]                        = i == 0 ? SINGLE_LOCAL_PORT_TYPE : SINGLE_REMOTE_PORT_TYPE;
+    srsran::uint16_to_uint8(i == 0 ? 2222 : 9000, &packet_filter.filter[1]);
+  }
+
+  srsue::tft_pdu_matcher matcher(logger);
+  TESTASSERT(matcher.apply_traffic_flow_template(EPS_BEARER_ID, &tft) == SRSRAN_SUCCESS);
+
+  // Burst of message 1, message 2 and an IPv6 packet that matches no filter
+  const uint8_t*               msgs[]     = {ip_tst_message1, ip_tst_message2, ipv6_matched_packet};
+  const uint32_t               msg_lens[] = {ip_message_len1, ip_message_len2, sizeof(ipv6_matched_packet)};
+  srsran::unique_byte_buffer_t pdus[3];
+  uint8_t                      eps_bearer_ids[3] = {};
+  for (uint32_t i = 0; i < 3; ++i) {
+    pdus[i] = make_byte_buffer();
+    TESTASSERT(pdus[i] != nullptr);
+    memcpy(pdus[i]->msg, msgs[i], msg_lens[i]);
+    pdus[i]->N_bytes  = msg_lens[i];
+    eps_bearer_ids[i] = EPS_BEARER_ID - 1;
+  }
+  matcher.check_tft_filter_match(pdus, eps_bearer_ids);
+  TESTASSERT(eps_bearer_ids[0] == EPS_BEARER_ID);
+  TESTASSERT(eps_bearer_ids[1] == EPS_BEARER_ID);
+  TESTASSERT(eps_bearer_ids[2] == EPS_BEARER_ID - 1);
+
+  // The burst must agree with the PDU by PDU match
+  for (uint32_t i = 0; i < 3; ++i) {
+    uint8_t eps_bearer_id = EPS_BEARER_ID - 1;
+    bool    match         = matcher.check_tft_filter_match(pdus[i], eps_bearer_id) == SRSRAN_SUCCESS;
+    TESTASSERT(match == (i < 2));
+    TESTASSERT(eps_bearer_id == eps_bearer_ids[i]);
+  }
+
+  printf("Test TFT filter batch match successfull\n");
+  return 0;
+}
+
+int tft_filter_test_flow_cache()
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT");
+
+  // Single local port 2222, matches IP test message 1
+  LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT tft = {};
+  tft.tft_op_code                             = LIBLTE_MME_TFT_OPERATION_CODE_CREATE_NEW_TFT;
+  tft.packet_filter_list_size                 = 1;
+  tft.packet_filter_list[0].dir               = LIBLTE_MME_TFT_PACKET_FILTER_DIRECTION_BIDIRECTIONAL;
+  tft.packet_filter_list[0].id                = 1;
+  tft.packet_filter_list[0].eval_precedence   = 0;
+  tft.packet_filter_list[0].filter_size       = 3;
+  tft.packet_filter_list[0].filter[0]         = SINGLE_LOCAL_PORT_TYPE;
+  srsran::uint16_to_uint8(2222, &tft.packet_filter_list[0].filter[1]);
+
+  srsran::unique_byte_buffer_t ip_msg1 = make_byte_buffer();
+  TESTASSERT(ip_msg1 != nullptr);
+  memcpy(ip_msg1->msg, ip_tst_message1, ip_message_len1);
+  ip_msg1->N_bytes = ip_message_len1;
+
+  srsue::tft_pdu_matcher matcher(logger);
+  uint8_t                eps_bearer_id = EPS_BEARER_ID - 1;
+  TESTASSERT(matcher.check_tft_filter_match(ip_msg1, eps_bearer_id) == SRSRAN_ERROR);
+  TESTASSERT(matcher.nof_cached_flows() == 1);
+
+  // The new TFT flushes the cached miss
+  TESTASSERT(matcher.apply_traffic_flow_template(EPS_BEARER_ID, &tft) == SRSRAN_SUCCESS);
+  TESTASSERT(matcher.nof_cached_flows() == 0);
+  for (uint32_t i = 0; i < 3; ++i) {
+    eps_bearer_id = EPS_BEARER_ID - 1;
+    TESTASSERT(matcher.check_tft_filter_match(ip_msg1, eps_bearer_id) == SRSRAN_SUCCESS);
+    TESTASSERT(eps_bearer_id == EPS_BEARER_ID);
+    TESTASSERT(matcher.nof_cached_flows() == 1);
+  }
+
+  // Another source port is another flow
+  srsran::uint16_to_uint8(2223, &ip_msg1->msg[20]);
+  eps_bearer_id = EPS_BEARER_ID - 1;
+  TESTASSERT(matcher.check_tft_filter_match(ip_msg1, eps_bearer_id) == SRSRAN_ERROR);
+  TESTASSERT(eps_bearer_id == EPS_BEARER_ID - 1);
+  TESTASSERT(matcher.nof_cached_flows() == 2);
+
+  // Once the TFT is deleted, the flow no longer matches
+  srsran::uint16_to_uint8(2222, &ip_msg1->msg[20]);
+  matcher.delete_tft_for_eps_bearer(EPS_BEARER_ID);
+  TESTASSERT(matcher.nof_cached_flows() == 0);
+  TESTASSERT(matcher.check_tft_filter_match(ip_msg1, eps_bearer_id) == SRSRAN_ERROR);
+
+  printf("Test TFT flow cache successfull\n");
+  return 0;
+}
+
 int main(int argc, char** argv)
 {
   srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT", false);
@@ -435,4 +538,10 @@ int main(int argc, char** argv)
   if (tft_filter_test_ipv6_combined()) {
     return -1;
   }
+  if (tft_filter_test_batch_match()) {
+    return -1;
+  }
+  if (tft_filter_test_flow_cache()) {
+    return -1;
+  }
 }
@@ -389,7 +389,89 @@ bool tft_packet_filter_t::match_port(const srsran::unique_byte_buffer_t& pdu)
 
 void tft_pdu_matcher::reset()
 {
+  std::lock_guard<std::mutex> lock(tft_mutex);
   tft_filter_map.clear();
+  flow_cache.clear();
+}
+
+/// Extracts the fields looked at by the packet filters. Returns false if the PDU is too short to hold them
+static bool get_flow_key(const srsran::unique_byte_buffer_t& pdu, tft_flow_key_t& key)
+{
+  memset(&key, 0, sizeof(key));
+  if (pdu->N_bytes < sizeof(struct iphdr)) {
+    return false;
+  }
+  const struct iphdr*   ip_pkt  = (const struct iphdr*)pdu->msg;
+  const struct ipv6hdr* ip6_pkt = (const struct ipv6hdr*)pdu->msg;
+  uint32_t              l4_offset;
+
+  key.version = ip_pkt->version;
+  if (ip_pkt->version == 4) {
+    key.protocol        = ip_pkt->protocol;
+    key.type_of_service = ip_pkt->tos;
+    memcpy(key.local_addr, &ip_pkt->saddr, IPV4_ADDR_SIZE);
+    memcpy(key.remote_addr, &ip_pkt->daddr, IPV4_ADDR_SIZE);
+    l4_offset = ip_pkt->ihl * 4;
+  } else if (ip_pkt->version == 6) {
+    if (pdu->N_bytes < sizeof(struct ipv6hdr)) {
+      return false;
+    }
+    key.protocol = ip6_pkt->nexthdr;
+    memcpy(key.local_addr, ip6_pkt->saddr.in6_u.u6_addr8, IPV6_ADDR_SIZE);
+    memcpy(key.remote_addr, ip6_pkt->daddr.in6_u.u6_addr8, IPV6_ADDR_SIZE);
+    l4_offset = sizeof(struct ipv6hdr);
+  } else {
+    // The packet filters match no other IP version, whatever the rest of the header
+    return true;
+  }
+
+  if (key.protocol == UDP_PROTOCOL or key.protocol == TCP_PROTOCOL) {
+    // Both the UDP and TCP headers start with the source and destination ports
+    if (pdu->N_bytes < l4_offset + 4) {
+      return false;
+    }
+    memcpy(&key.local_port, &pdu->msg[l4_offset], 2);
+    memcpy(&key.remote_port, &pdu->msg[l4_offset + 2], 2);
+  }
+  return true;
+}
+
+/// Matches the PDU against the cached flows, and evaluates the packet filters in precedence order on a miss
+bool tft_pdu_matcher::match_unprotected(const srsran::unique_byte_buffer_t& pdu, uint8_t& eps_bearer_id)
+{
+  tft_flow_key_t key;
+  bool           cacheable = get_flow_key(pdu, key);
+  if (cacheable) {
+    auto it = flow_cache.find(key);
+    if (it != flow_cache.end()) {
+      if (it->second == no_match_flow) {
+        return false;
+      }
+      eps_bearer_id = it->second;
+      return true;
+    }
+  }
+
+  uint8_t result = no_match_flow;
+  for (std::pair<const uint16_t, tft_packet_filter_t>& filter_pair : tft_filter_map) {
+    if (filter_pair.second.match(pdu)) {
+      result = filter_pair.second.eps_bearer_id;
+      logger.debug("Found filter match -- EPS bearer Id %d", filter_pair.second.eps_bearer_id);
+      break;
+    }
+  }
+
+  if (cacheable) {
+    if (flow_cache.size() >= max_cached_flows) {
+      flow_cache.clear();
+    }
+    flow_cache.emplace(key, result);
+  }
+  if (result == no_match_flow) {
+    return false;
+  }
+  eps_bearer_id = result;
+  return true;
 }
 
 /**
@@ -402,15 +484,24 @@ void tft_pdu_matcher::reset()
 int tft_pdu_matcher::check_tft_filter_match(const srsran::unique_byte_buffer_t& pdu, uint8_t& eps_bearer_id)
 {
   std::lock_guard<std::mutex> lock(tft_mutex);
-  for (std::pair<const uint16_t, tft_packet_filter_t>& filter_pair : tft_filter_map) {
-    bool match = filter_pair.second.match(pdu);
-    if (match) {
-      eps_bearer_id = filter_pair.second.eps_bearer_id;
-      logger.debug("Found filter match -- EPS bearer Id %d", filter_pair.second.eps_bearer_id);
-      return SRSRAN_SUCCESS;
-    }
+  return match_unprotected(pdu, eps_bearer_id) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+}
+
+void tft_pdu_matcher::check_tft_filter_match(srsran::span<const srsran::unique_byte_buffer_t> pdus,
+                                             srsran::span<uint8_t>                            eps_bearer_ids)
+{
+  srsran_assert(pdus.size() <= max_burst_size and pdus.size() == eps_bearer_ids.size(), "Invalid burst of PDUs");
+
+  std::lock_guard<std::mutex> lock(tft_mutex);
+  for (size_t i = 0; i < pdus.size(); ++i) {
+    match_unprotected(pdus[i], eps_bearer_ids[i]);
   }
-  return SRSRAN_ERROR;
+}
+
+size_t tft_pdu_matcher::nof_cached_flows()
+{
+  std::lock_guard<std::mutex> lock(tft_mutex);
+  return flow_cache.size();
 }
 
 /**
@@ -428,6 +519,7 @@ void tft_pdu_matcher::delete_tft_for_eps_bearer(const uint8_t eps_bearer_id)
   if (old_filter != tft_filter_map.end()) {
     logger.debug("Deleting TFT for EPS bearer %d", eps_bearer_id);
     tft_filter_map.erase(old_filter);
+    flow_cache.clear();
   }
 }
 
@@ -435,6 +527,8 @@ int tft_pdu_matcher::apply_traffic_flow_template(const uint8_t&
                                                  const LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT* tft)
 {
   std::lock_guard<std::mutex> lock(tft_mutex);
+  // The cached flows may now match other packet filters
+  flow_cache.clear();
   switch (tft->tft_op_code) {
     case LIBLTE_MME_TFT_OPERATION_CODE_CREATE_NEW_TFT:
       for (int i = 0; i < tft->packet_filter_list_size; i++) {
@@ -91,6 +91,7 @@ int ue::init(const all_args_t& args_)
   phy_args_nr.worker_cpu_mask      = args.phy.worker_cpu_mask;
   phy_args_nr.log                  = args.phy.log;
   phy_args_nr.store_pdsch_ko       = args.phy.nr_store_pdsch_ko;
+  phy_args_nr.slot_rx_queue_size   = args.phy.nr_rx_queue_size;
   phy_args_nr.srate_hz             = args.rf.srate_hz;
 
   // init layers
@@ -389,6 +390,7 @@ bool ue::get_metrics(ue_metrics_t* m)
   stack->get_metrics(&m->stack);
   gw_inst->get_metrics(m->gw, m->stack.mac[0].nof_tti);
   m->sys = sys_proc.get_metrics();
+  srsran_stage_prof_get(m->phy_stages);
   return true;
 }
 
@@ -405,6 +407,68 @@ std::string ue::get_build_info()
   return std::string(srsran_get_build_info());
 }
 
+/// Adds inc to a string of decimal digits, keeping its leading zeros.
+static std::string add_to_digits(const std::string& digits, uint64_t inc)
+{
+  if (digits.empty() or digits.find_first_not_of("0123456789") != std::string::npos) {
+    return digits;
+  }
+  std::string result = std::to_string(std::strtoull(digits.c_str(), nullptr, 10) + inc);
+  if (result.size() < digits.size()) {
+    result.insert(0, digits.size() - result.size(), '0');
+  }
+  return result;
+}
+
+/// Inserts the suffix in a filename, before its extension.
+static std::string add_filename_suffix(const std::string& filename, const std::string& suffix)
+{
+  size_t dot   = filename.rfind('.');
+  size_t slash = filename.rfind('/');
+  if (dot == std::string::npos or (slash != std::string::npos and dot < slash)) {
+    return filename + suffix;
+  }
+  return filename.substr(0, dot) + suffix + filename.substr(dot);
+}
+
+/// Shifts the port of every ZMQ address (tcp://host:port) in the device arguments.
+static std::string shift_zmq_ports(const std::string& device_args, uint32_t offset)
+{
+  std::string result = device_args;
+  size_t      pos    = result.find("tcp://");
+  while (pos != std::string::npos) {
+    size_t colon = result.find(':', pos + 6);
+    if (colon == std::string::npos) {
+      break;
+    }
+    size_t end = result.find_first_not_of("0123456789", colon + 1);
+    end        = (end == std::string::npos) ? result.size() : end;
+    std::string port = add_to_digits(result.substr(colon + 1, end - colon - 1), offset);
+    result.replace(colon + 1, end - colon - 1, port);
+    pos = result.find("tcp://", colon + 1 + port.size());
+  }
+  return result;
+}
+
+void set_multi_ue_args(all_args_t& args, uint32_t ue_idx)
+{
+  if (ue_idx == 0) {
+    return;
+  }
+  std::string suffix = "_" + std::to_string(ue_idx);
+
+  args.stack.usim.imsi = add_to_digits(args.stack.usim.imsi, ue_idx);
+  args.stack.usim.imei = add_to_digits(args.stack.usim.imei, ue_idx);
+  args.gw.tun_dev_name += suffix;
+  args.rf.device_args = shift_zmq_ports(args.rf.device_args, ue_idx * args.general.ue_port_stride);
+
+  args.stack.pkt_trace.mac_pcap.filename    = add_filename_suffix(args.stack.pkt_trace.mac_pcap.filename, suffix);
+  args.stack.pkt_trace.mac_nr_pcap.filename = add_filename_suffix(args.stack.pkt_trace.mac_nr_pcap.filename, suffix);
+  args.stack.pkt_trace.nas_pcap.filename    = add_filename_suffix(args.stack.pkt_trace.nas_pcap.filename, suffix);
+  args.trace.phy_filename                   = add_filename_suffix(args.trace.phy_filename, suffix);
+  args.trace.radio_filename                 = add_filename_suffix(args.trace.radio_filename, suffix);
+}
+
 std::string ue::get_build_string()
 {
   std::stringstream ss;